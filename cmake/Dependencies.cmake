@@ -52,6 +52,19 @@ if (BUILD_NVJPEG2K)
   endif()
 endif (BUILD_NVJPEG2K)
 
+if (BUILD_NVCOMP)
+  find_path(NVCOMP_INCLUDE_DIR nvcomp/lz4.h PATHS ${NVCOMP_ROOT_DIR} PATH_SUFFIXES include)
+  find_library(NVCOMP_LIBRARY nvcomp PATHS ${NVCOMP_ROOT_DIR} PATH_SUFFIXES lib lib64)
+  if (NOT NVCOMP_INCLUDE_DIR OR NOT NVCOMP_LIBRARY)
+    message(WARNING "nvCOMP not found - disabled")
+    set(BUILD_NVCOMP OFF CACHE BOOL INTERNAL)
+    set(BUILD_NVCOMP OFF)
+  else()
+    include_directories(SYSTEM ${NVCOMP_INCLUDE_DIR})
+    list(APPEND DALI_LIBS ${NVCOMP_LIBRARY})
+  endif()
+endif (BUILD_NVCOMP)
+
 # NVIDIA NPP library
 CUDA_find_library(CUDA_nppicc_static_LIBRARY nppicc_static)
 CUDA_find_library(CUDA_nppc_static_LIBRARY nppc_static)
@@ -30,6 +30,15 @@ if (BUILD_OPENCV)
   list(APPEND DALI_EXCLUDES libopencv_core.a;libopencv_imgproc.a;libopencv_highgui.a;libopencv_imgcodecs.a;liblibwebp.a;libittnotify.a;libpng.a;liblibtiff.a;liblibjasper.a;libIlmImf.a;liblibjpeg-turbo.a)
 endif()
 
+##################################################################
+# zlib
+##################################################################
+# used to inflate PNG and TIFF images, which are then reconstructed on the GPU
+find_package(ZLIB REQUIRED)
+include_directories(SYSTEM ${ZLIB_INCLUDE_DIRS})
+list(APPEND DALI_LIBS ${ZLIB_LIBRARIES})
+list(APPEND DALI_EXCLUDES libz.a)
+
 ##################################################################
 #
 # Optional dependencies
@@ -201,6 +210,26 @@ if (BUILD_FFTS)
   list(APPEND DALI_EXCLUDES libffts.a)
 endif()
 
+##################################################################
+# FFTW
+##################################################################
+if (BUILD_FFTW)
+  find_path(FFTW_INCLUDE_DIR fftw3.h
+            PATHS ${CMAKE_SYSTEM_PREFIX_PATH} ${FFTW_ROOT_DIR} "/usr/local"
+            PATH_SUFFIXES include)
+  find_library(fftw_LIBS
+               NAMES fftw3f libfftw3f
+               PATHS ${CMAKE_SYSTEM_PREFIX_PATH} ${FFTW_ROOT_DIR} "/usr/local"
+               PATH_SUFFIXES lib lib64)
+  if(${fftw_LIBS} STREQUAL fftw_LIBS-NOTFOUND OR NOT FFTW_INCLUDE_DIR)
+    message(FATAL_ERROR "FFTW (fftw3f) could not be found. Try to specify it's location with `-DFFTW_ROOT_DIR`.")
+  endif()
+  message(STATUS "Found FFTW: ${fftw_LIBS}")
+  include_directories(SYSTEM ${FFTW_INCLUDE_DIR})
+  list(APPEND DALI_LIBS ${fftw_LIBS})
+  list(APPEND DALI_EXCLUDES libfftw3f.a)
+endif()
+
 ##################################################################
 # CUTLASS
 ##################################################################
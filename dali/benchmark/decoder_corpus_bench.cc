@@ -0,0 +1,191 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dali/benchmark/dali_bench.h"
+#include "dali/pipeline/pipeline.h"
+#include "dali/util/image.h"
+
+namespace dali {
+
+/**
+ * @brief Measures the image decoders on a corpus representative of the production data
+ *
+ * The corpus is a directory given by the DALI_DECODER_BENCH_CORPUS environment variable
+ * (the benchmark images by default). If the directory contains image_list.txt, only the files
+ * listed there are used, so a list can describe a mix of formats and sizes without copying
+ * the files. The files are shuffled once and split into consecutive batches, so each batch
+ * follows the overall mix.
+ *
+ * The batches are decoded one at a time and the time of each is measured, so besides
+ * the throughput, the benchmarks report the median and 99th percentile batch latency.
+ * The mixed decoder also reports how many images per batch went through each of the decoding
+ * paths: the hardware decoder, the hybrid (CUDA) decoder, the host decoder and nvJPEG2k.
+ */
+class DecoderCorpusBench : public benchmark::Fixture {
+ public:
+  static const ImgSetDescr &Corpus() {
+    static ImgSetDescr corpus;
+    static bool loaded = []() {
+      const char *env = std::getenv("DALI_DECODER_BENCH_CORPUS");
+      auto names = ImageList(env ? env : image_folder,
+                             {".jpg", ".jpeg", ".png", ".bmp", ".tif", ".tiff", ".webp",
+                              ".jp2", ".pnm", ".ppm", ".pgm"});
+      std::mt19937 rng(1234);
+      std::shuffle(names.begin(), names.end(), rng);
+      LoadImages(names, &corpus);
+      return true;
+    }();
+    (void)loaded;
+    return corpus;
+  }
+
+  void MakeBatch(TensorList<CPUBackend> *tl, int batch_size, int batch_idx) {
+    const auto &corpus = Corpus();
+    int n = corpus.nImages();
+    DALI_ENFORCE(n > 0, "The decoder benchmark corpus is empty");
+    TensorListShape<> shape(batch_size, 1);
+    for (int i = 0; i < batch_size; i++)
+      shape.set_tensor_shape(i, { corpus.sizes_[(batch_idx * batch_size + i) % n] });
+    tl->set_type<uint8>();
+    tl->Resize(shape);
+    for (int i = 0; i < batch_size; i++) {
+      int idx = (batch_idx * batch_size + i) % n;
+      std::memcpy(tl->template mutable_tensor<uint8>(i), corpus.data_[idx], corpus.sizes_[idx]);
+    }
+  }
+
+  void Run(benchmark::State &st, int batch_size, int num_threads, const std::string &device,
+           OpSpec decoder) {
+    Pipeline pipe(batch_size, num_threads, 0);
+    pipe.AddExternalInput("encoded");
+    pipe.AddOperator(decoder
+      .AddArg("device", device)
+      .AddArg("output_type", DALI_RGB)
+      .AddInput("encoded", "cpu")
+      .AddOutput("images", device == "cpu" ? "cpu" : "gpu"), "decoder");
+    pipe.Build({{"images", device == "cpu" ? "cpu" : "gpu"}});
+
+    // as many batches as needed to go through the corpus once
+    int num_batches = std::max<int>(1, div_ceil(Corpus().nImages(), batch_size));
+    std::vector<TensorList<CPUBackend>> batches(num_batches);
+    for (int b = 0; b < num_batches; b++)
+      MakeBatch(&batches[b], batch_size, b);
+
+    DeviceWorkspace ws;
+    auto run_batch = [&](int b) {
+      pipe.SetExternalInput("encoded", batches[b % num_batches]);
+      pipe.RunCPU();
+      pipe.RunGPU();
+      pipe.Outputs(&ws);
+      if (ws.OutputIsType<GPUBackend>(0))
+        CUDA_CALL(cudaStreamSynchronize(ws.has_stream() ? ws.stream() : 0));
+    };
+
+    // the first pass allocates the memory and selects the decoding methods
+    for (int b = 0; b < num_batches; b++)
+      run_batch(b);
+
+    auto *op = pipe.GetOperatorNode("decoder")->op.get();
+    auto counters = op->GetNumericDiagnostics();
+
+    std::vector<double> latencies;
+    int b = 0;
+    for (auto _ : st) {
+      auto start = std::chrono::high_resolution_clock::now();
+      run_batch(b++);
+      auto end = std::chrono::high_resolution_clock::now();
+      double seconds = std::chrono::duration<double>(end - start).count();
+      st.SetIterationTime(seconds);
+      latencies.push_back(seconds);
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double p) {
+      return latencies[std::min<size_t>(latencies.size() - 1, p * latencies.size())] * 1e3;
+    };
+    st.counters["images/s"] = benchmark::Counter(st.iterations() * batch_size,
+                                                 benchmark::Counter::kIsRate);
+    st.counters["p50_ms"] = percentile(0.5);
+    st.counters["p99_ms"] = percentile(0.99);
+
+    auto after = op->GetNumericDiagnostics();
+    for (const char *path : { "nsamples_hw", "nsamples_cuda", "nsamples_host",
+                              "nsamples_nvjpeg2k" }) {
+      auto it = after.find(path);
+      if (it == after.end())
+        continue;
+      st.counters[path + std::strlen("nsamples_")] =
+          benchmark::Counter(it->second - counters[path], benchmark::Counter::kAvgIterations);
+    }
+  }
+};
+
+static void CorpusCPUArgs(benchmark::internal::Benchmark *b) {
+  for (int batch_size : { 16, 64, 256 }) {
+    for (int num_threads : { 1, 4, 8 }) {
+      b->Args({batch_size, num_threads});
+    }
+  }
+}
+
+BENCHMARK_DEFINE_F(DecoderCorpusBench, ImageDecoder_CPU)(benchmark::State& st) {
+  int batch_size = st.range(0);
+  int num_threads = st.range(1);
+  Run(st, batch_size, num_threads, "cpu", OpSpec("ImageDecoder"));
+}
+
+BENCHMARK_REGISTER_F(DecoderCorpusBench, ImageDecoder_CPU)->Iterations(100)
+->Unit(benchmark::kMillisecond)
+->UseManualTime()
+->Apply(CorpusCPUArgs);
+
+static void CorpusMixedArgs(benchmark::internal::Benchmark *b) {
+  for (int batch_size : { 16, 64, 256 }) {
+    for (int num_threads : { 2, 4, 8 }) {
+      for (int hw_load_percent : { 0, 65, 90 }) {
+        for (int padding_mb : { 0, 16 }) {
+          b->Args({batch_size, num_threads, hw_load_percent, padding_mb});
+        }
+      }
+    }
+  }
+}
+
+BENCHMARK_DEFINE_F(DecoderCorpusBench, ImageDecoder_Mixed)(benchmark::State& st) {
+  int batch_size = st.range(0);
+  int num_threads = st.range(1);
+  float hw_load = st.range(2) / 100.f;
+  int padding = st.range(3) << 20;
+  Run(st, batch_size, num_threads, "mixed", OpSpec("ImageDecoder")
+    .AddArg("hw_decoder_load", hw_load)
+    .AddArg("device_memory_padding", padding)
+    .AddArg("host_memory_padding", padding));
+}
+
+BENCHMARK_REGISTER_F(DecoderCorpusBench, ImageDecoder_Mixed)->Iterations(100)
+->Unit(benchmark::kMillisecond)
+->UseManualTime()
+->Apply(CorpusMixedArgs);
+
+}  // namespace dali
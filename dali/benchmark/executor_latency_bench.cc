@@ -0,0 +1,104 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+#include "dali/pipeline/pipeline.h"
+
+/**
+ * The latency of a single request - a batch of 1 fed to the pipeline, processed by a CPU and
+ * a GPU operator and returned - with different executors:
+ *  - mode 0: async pipelined (the default),
+ *  - mode 1: neither pipelined nor async - all the stages run on the calling thread,
+ *  - mode 2: as 1, with the low latency mode (see Pipeline::EnableLowLatency).
+ *
+ * The latencies are reported as the `latency_p50_us` and `latency_p99_us` counters.
+ */
+
+namespace dali {
+
+namespace {
+
+double Percentile(const std::vector<double> &sorted, double p) {
+  if (sorted.empty())
+    return 0;
+  size_t idx = std::min(sorted.size() - 1, static_cast<size_t>(p * sorted.size()));
+  return sorted[idx];
+}
+
+void ExecutorLatency(benchmark::State &st) {  // NOLINT
+  int mode = st.range(0);
+  bool sync = mode > 0;
+  Pipeline pipe(1, 4, 0, -1, !sync, 1, !sync);
+  pipe.EnableLowLatency(mode == 2);
+  pipe.AddExternalInput("data");
+  pipe.AddOperator(
+      OpSpec("Flip")
+        .AddArg("device", "cpu")
+        .AddArg("horizontal", 1)
+        .AddInput("data", "cpu")
+        .AddOutput("flipped", "cpu"));
+  pipe.AddOperator(
+      OpSpec("Cast")
+        .AddArg("device", "gpu")
+        .AddArg("dtype", DALI_FLOAT)
+        .AddInput("flipped", "gpu")
+        .AddOutput("out", "gpu"));
+  pipe.Build({{"out", "gpu"}});
+
+  TensorList<CPUBackend> data;
+  data.Resize(uniform_list_shape(1, {224, 224, 3}), DALI_UINT8);
+  data.SetLayout("HWC");
+  std::memset(data.raw_mutable_data(), 0x5a, data.nbytes());
+
+  DeviceWorkspace ws;
+  auto request = [&]() {
+    pipe.SetExternalInput("data", data);
+    pipe.RunCPU();
+    pipe.RunGPU();
+    pipe.Outputs(&ws);
+  };
+  for (int i = 0; i < 10; i++)
+    request();
+
+  std::vector<double> latencies;
+  for (auto _ : st) {
+    auto start = std::chrono::steady_clock::now();
+    request();
+    double latency = std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+                         .count();
+    st.SetIterationTime(latency);
+    latencies.push_back(latency);
+  }
+
+  std::sort(latencies.begin(), latencies.end());
+  st.counters["latency_p50_us"] = 1e6 * Percentile(latencies, 0.5);
+  st.counters["latency_p99_us"] = 1e6 * Percentile(latencies, 0.99);
+}
+
+}  // namespace
+
+BENCHMARK(ExecutorLatency)
+    ->ArgName("mode")
+    ->DenseRange(0, 2)
+    ->Iterations(2000)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseManualTime();
+
+}  // namespace dali
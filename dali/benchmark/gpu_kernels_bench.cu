@@ -0,0 +1,366 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+#include "dali/benchmark/dali_bench.h"
+#include "dali/benchmark/gpu_roofline.h"
+#include "dali/core/mm/memory.h"
+#include "dali/kernels/audio/mel_scale/mel_filter_bank_gpu.h"
+#include "dali/kernels/common/copy.h"
+#include "dali/kernels/imgproc/resample.h"
+#include "dali/kernels/imgproc/warp/affine.h"
+#include "dali/kernels/imgproc/warp_gpu.h"
+#include "dali/kernels/reduce/reduce_gpu.h"
+#include "dali/kernels/scratch.h"
+#include "dali/kernels/signal/fft/stft_gpu.h"
+#include "dali/kernels/signal/window/window_functions.h"
+#include "dali/kernels/slice/slice_flip_normalize_permute_pad_gpu.h"
+#include "dali/kernels/transpose/transpose_gpu.h"
+#include "dali/test/tensor_test_utils.h"
+#include "dali/test/test_tensors.h"
+
+namespace dali {
+
+/**
+ * @brief A regression suite of the GPU kernels, reporting their performance against
+ *        the roofline of the device
+ *
+ * Each benchmark runs a kernel on a representative batch and reports the achieved bandwidth
+ * (and the FLOP rate, for the kernels doing a meaningful amount of arithmetic) as absolute
+ * values and as the fraction of the device peak - see RunRoofline. The fractions are
+ * comparable between the GPUs, so they can be tracked over time to detect regressions.
+ *
+ * To run only this suite and store the results:
+ *
+ *     dali_benchmark.bin --benchmark_filter=GPUKernelBench \
+ *                        --benchmark_out=kernels.json --benchmark_out_format=json
+ */
+class GPUKernelBench : public DALIBenchmark {
+ public:
+  kernels::KernelContext ctx;
+
+  GPUKernelBench() {
+    ctx.gpu.stream = 0;
+  }
+
+  /**
+   * @brief Runs the kernel with the scratch memory described by `req` and reports the results
+   */
+  template <typename RunFn>
+  void Measure(benchmark::State &st, const kernels::KernelRequirements &req,
+               double bytes, double flops, RunFn &&run) {
+    kernels::ScratchpadAllocator scratch_alloc;
+    scratch_alloc.Reserve(req.scratch_sizes);
+    RunRoofline(st, ctx.gpu.stream, bytes, flops, [&](cudaStream_t) {
+      auto scratchpad = scratch_alloc.GetScratchpad();
+      ctx.scratchpad = &scratchpad;
+      run();
+    });
+  }
+
+  template <typename T, int ndim>
+  static void RandomFill(kernels::TestTensorList<T, ndim> &tl, T lo, T hi) {
+    std::mt19937_64 rng(1234);
+    UniformRandomFill(tl.cpu(), rng, lo, hi);
+  }
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// Image processing
+
+BENCHMARK_DEFINE_F(GPUKernelBench, Resample)(benchmark::State& st) {
+  int batch_size = st.range(0);
+  int in_size = st.range(1);
+  int out_size = st.range(2);
+
+  kernels::TestTensorList<uint8_t, 3> in, out;
+  in.reshape(uniform_list_shape<3>(batch_size, { in_size, in_size, 3 }));
+  RandomFill<uint8_t>(in, 0, 255);
+  std::vector<kernels::ResamplingParams2D> params(batch_size);
+  for (auto &p : params) {
+    for (int d = 0; d < 2; d++) {
+      p[d].output_size = out_size;
+      p[d].min_filter = kernels::ResamplingFilterType::Triangular;
+      p[d].mag_filter = kernels::ResamplingFilterType::Linear;
+    }
+  }
+
+  kernels::ResampleGPU<uint8_t, uint8_t, 2> kernel;
+  auto in_tv = in.gpu();
+  auto req = kernel.Setup(ctx, in_tv, make_cspan(params));
+  out.reshape(req.output_shapes[0].to_static<3>());
+  auto out_tv = out.gpu();
+
+  double bytes = in_tv.num_elements() + out_tv.num_elements();
+  Measure(st, req, bytes, 0, [&]() {
+    kernel.Run(ctx, out_tv, in_tv, make_cspan(params));
+  });
+}
+
+BENCHMARK_REGISTER_F(GPUKernelBench, Resample)->Iterations(100)
+->Unit(benchmark::kMicrosecond)
+->UseManualTime()
+->Args({16, 1024, 512})
+->Args({16, 512, 1024})
+->Args({256, 256, 224});
+
+BENCHMARK_DEFINE_F(GPUKernelBench, WarpAffine)(benchmark::State& st) {
+  int batch_size = st.range(0);
+  int size = st.range(1);
+  auto interp = static_cast<DALIInterpType>(st.range(2));
+
+  kernels::TestTensorList<uint8_t, 3> in, out;
+  in.reshape(uniform_list_shape<3>(batch_size, { size, size, 3 }));
+  RandomFill<uint8_t>(in, 0, 255);
+
+  // a rotation by 30 degrees around the center of the image
+  float c = std::cos(M_PI / 6), s = std::sin(M_PI / 6), center = size * 0.5f;
+  kernels::AffineMapping2D mapping_cpu = mat2x3{{
+    { c, -s, center - c * center + s * center },
+    { s,  c, center - s * center - c * center }
+  }};
+  std::vector<kernels::AffineMapping2D> mappings_cpu(batch_size, mapping_cpu);
+  auto mapping_mem = mm::alloc_raw_unique<kernels::AffineMapping2D, mm::memory_kind::device>(
+      batch_size);
+  auto mappings = make_tensor_gpu<1>(mapping_mem.get(), { batch_size });
+  kernels::copy(mappings, make_tensor_cpu<1>(mappings_cpu.data(), { batch_size }));
+
+  std::vector<TensorShape<2>> out_sizes(batch_size, TensorShape<2>{ size, size });
+  std::vector<DALIInterpType> interps(batch_size, interp);
+
+  kernels::WarpGPU<kernels::AffineMapping2D, 2, uint8_t, uint8_t, uint8_t> kernel;
+  auto in_tv = in.gpu();
+  auto req = kernel.Setup(ctx, in_tv, mappings, make_cspan(out_sizes), make_cspan(interps), 0);
+  out.reshape(req.output_shapes[0].to_static<3>());
+  auto out_tv = out.gpu();
+
+  double bytes = in_tv.num_elements() + out_tv.num_elements();
+  Measure(st, req, bytes, 0, [&]() {
+    kernel.Run(ctx, out_tv, in_tv, mappings, make_cspan(out_sizes), make_cspan(interps), 0);
+  });
+}
+
+BENCHMARK_REGISTER_F(GPUKernelBench, WarpAffine)->Iterations(100)
+->Unit(benchmark::kMicrosecond)
+->UseManualTime()
+->Args({16, 1024, DALI_INTERP_NN})
+->Args({16, 1024, DALI_INTERP_LINEAR})
+->Args({64, 256, DALI_INTERP_LINEAR});
+
+/**
+ * @brief The crop-mirror-normalize of a typical classification training pipeline:
+ *        a crop of an HWC uint8 image, normalized and permuted to CHW float
+ */
+BENCHMARK_DEFINE_F(GPUKernelBench, CropMirrorNormalize)(benchmark::State& st) {
+  int batch_size = st.range(0);
+  int in_size = st.range(1);
+  int crop = st.range(2);
+  bool mirror = st.range(3);
+
+  kernels::TestTensorList<uint8_t, 3> in;
+  kernels::TestTensorList<float, 3> out;
+  TensorShape<3> in_shape{ in_size, in_size, 3 };
+  in.reshape(uniform_list_shape<3>(batch_size, in_shape));
+  RandomFill<uint8_t>(in, 0, 255);
+
+  using Kernel = kernels::SliceFlipNormalizePermutePadGpu<float, uint8_t, 3>;
+  std::vector<Kernel::Args> args;
+  for (int i = 0; i < batch_size; i++) {
+    Kernel::Args a(TensorShape<3>{ crop, crop, 3 }, in_shape);
+    a.anchor = { (in_size - crop) / 2, (in_size - crop) / 2, 0 };
+    a.flip[1] = mirror;
+    a.permuted_dims = { 2, 0, 1 };
+    a.mean = { 0.485f * 255, 0.456f * 255, 0.406f * 255 };
+    a.inv_stddev = { 1 / (0.229f * 255), 1 / (0.224f * 255), 1 / (0.225f * 255) };
+    a.channel_dim = 2;
+    args.push_back(std::move(a));
+  }
+
+  Kernel kernel;
+  auto in_tv = in.gpu();
+  auto req = kernel.Setup(ctx, in_tv, args);
+  out.reshape(req.output_shapes[0].to_static<3>());
+  auto out_tv = out.gpu();
+
+  // only the cropped part of the input is read
+  double out_elements = out_tv.num_elements();
+  double bytes = out_elements * (sizeof(uint8_t) + sizeof(float));
+  Measure(st, req, bytes, 2 * out_elements, [&]() {
+    kernel.Run(ctx, out_tv, in_tv, args);
+  });
+}
+
+BENCHMARK_REGISTER_F(GPUKernelBench, CropMirrorNormalize)->Iterations(100)
+->Unit(benchmark::kMicrosecond)
+->UseManualTime()
+->Args({256, 256, 224, 0})
+->Args({256, 256, 224, 1})
+->Args({32, 1024, 800, 1});
+
+//////////////////////////////////////////////////////////////////////////////
+// Data movement and reductions
+
+BENCHMARK_DEFINE_F(GPUKernelBench, Transpose)(benchmark::State& st) {
+  int batch_size = st.range(0);
+  int h = st.range(1);
+  int w = st.range(2);
+  int c = st.range(3);
+
+  kernels::TestTensorList<uint8_t> in, out;
+  in.reshape(uniform_list_shape<3>(batch_size, { h, w, c }));
+  RandomFill<uint8_t>(in, 0, 255);
+
+  // HWC -> CHW
+  int perm[] = { 2, 0, 1 };
+  kernels::TransposeGPU kernel;
+  auto in_tv = in.gpu();
+  auto req = kernel.Setup(ctx, in_tv.shape, make_span(perm), sizeof(uint8_t));
+  out.reshape(req.output_shapes[0]);
+  auto out_tv = out.gpu();
+
+  double bytes = 2.0 * in_tv.num_elements();
+  Measure(st, req, bytes, 0, [&]() {
+    kernel.Run(ctx, out_tv, in_tv);
+  });
+}
+
+BENCHMARK_REGISTER_F(GPUKernelBench, Transpose)->Iterations(100)
+->Unit(benchmark::kMicrosecond)
+->UseManualTime()
+->Args({64, 480, 640, 3})
+->Args({16, 1080, 1920, 3})
+->Args({256, 224, 224, 3});
+
+BENCHMARK_DEFINE_F(GPUKernelBench, Sum)(benchmark::State& st) {
+  int batch_size = st.range(0);
+  int outer = st.range(1);
+  int inner = st.range(2);
+  int axis = st.range(3);
+
+  kernels::TestTensorList<float> in, out;
+  in.reshape(uniform_list_shape<2>(batch_size, { outer, inner }));
+  RandomFill<float>(in, -1, 1);
+
+  kernels::SumGPU<float, float> kernel;
+  auto in_tv = in.gpu();
+  int axes[] = { axis };
+  auto req = kernel.Setup(ctx, in_tv.shape, make_span(axes), false, false);
+  out.reshape(req.output_shapes[0]);
+  auto out_tv = out.gpu();
+
+  double elements = in_tv.num_elements();
+  double bytes = (elements + out_tv.num_elements()) * sizeof(float);
+  Measure(st, req, bytes, elements, [&]() {
+    kernel.Run(ctx, out_tv, in_tv);
+  });
+}
+
+BENCHMARK_REGISTER_F(GPUKernelBench, Sum)->Iterations(100)
+->Unit(benchmark::kMicrosecond)
+->UseManualTime()
+->Args({16, 1024, 1024, 0})
+->Args({16, 1024, 1024, 1})
+->Args({64, 224 * 224, 3, 0});
+
+//////////////////////////////////////////////////////////////////////////////
+// Signal processing
+
+BENCHMARK_DEFINE_F(GPUKernelBench, Spectrogram)(benchmark::State& st) {
+  int batch_size = st.range(0);
+  int length = st.range(1);
+  int nfft = st.range(2);
+  int step = st.range(3);
+
+  kernels::TestTensorList<float, 1> in, window;
+  kernels::TestTensorList<float, 2> out;
+  in.reshape(uniform_list_shape<1>(batch_size, { length }));
+  RandomFill<float>(in, -1, 1);
+  window.reshape(uniform_list_shape<1>(1, { nfft }));
+  kernels::signal::HannWindow(make_span(window.cpu()[0].data, nfft));
+
+  kernels::signal::fft::StftArgs args;
+  args.axis = 0;
+  args.spectrum_type = kernels::signal::fft::FFT_SPECTRUM_POWER;
+  args.window_length = nfft;
+  args.window_center = nfft / 2;
+  args.window_step = step;
+  args.time_major_layout = false;
+
+  kernels::signal::fft::SpectrogramGPU kernel;
+  auto in_tv = in.gpu();
+  auto req = kernel.Setup(ctx, in_tv.shape, args);
+  out.reshape(req.output_shapes[0].to_static<2>());
+  auto out_tv = out.gpu();
+  auto window_tv = window.gpu()[0];
+
+  // a real FFT takes about 2.5 N log2(N) FLOPs, the power spectrum 3 FLOPs per bin
+  double num_windows = static_cast<double>(batch_size) * args.num_windows(length);
+  double flops = num_windows * (2.5 * nfft * std::log2(nfft) + 3 * (nfft / 2 + 1));
+  double bytes = (in_tv.num_elements() + out_tv.num_elements()) * sizeof(float);
+  Measure(st, req, bytes, flops, [&]() {
+    kernel.Run(ctx, out_tv, in_tv, window_tv);
+  });
+}
+
+BENCHMARK_REGISTER_F(GPUKernelBench, Spectrogram)->Iterations(100)
+->Unit(benchmark::kMicrosecond)
+->UseManualTime()
+->Args({16, 160000, 512, 128})
+->Args({64, 16000, 400, 160})
+->Args({4, 441000, 2048, 512});
+
+BENCHMARK_DEFINE_F(GPUKernelBench, MelFilterBank)(benchmark::State& st) {
+  int batch_size = st.range(0);
+  int nfft = st.range(1);
+  int num_frames = st.range(2);
+  int nfilter = st.range(3);
+
+  int nbins = nfft / 2 + 1;
+  kernels::TestTensorList<float> in, out;
+  in.reshape(uniform_list_shape<2>(batch_size, { nbins, num_frames }));
+  RandomFill<float>(in, 0, 1);
+
+  kernels::audio::MelFilterBankArgs args;
+  args.sample_rate = 16000;
+  args.freq_high = args.sample_rate / 2;
+  args.nfilter = nfilter;
+  args.axis = 0;
+  args.nfft = nfft;
+
+  kernels::audio::MelFilterBankGpu<float> kernel;
+  auto in_tv = in.gpu();
+  auto req = kernel.Setup(ctx, in_tv, args);
+  out.reshape(req.output_shapes[0]);
+  auto out_tv = out.gpu();
+
+  // each of the bins contributes to (at most) two adjacent filters
+  double flops = 4.0 * in_tv.num_elements();
+  double bytes = (in_tv.num_elements() + out_tv.num_elements()) * sizeof(float);
+  Measure(st, req, bytes, flops, [&]() {
+    kernel.Run(ctx, out_tv, in_tv);
+  });
+}
+
+BENCHMARK_REGISTER_F(GPUKernelBench, MelFilterBank)->Iterations(100)
+->Unit(benchmark::kMicrosecond)
+->UseManualTime()
+->Args({16, 512, 1251, 128})
+->Args({64, 400, 101, 80})
+->Args({4, 2048, 862, 128});
+
+}  // namespace dali
@@ -0,0 +1,142 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_BENCHMARK_GPU_ROOFLINE_H_
+#define DALI_BENCHMARK_GPU_ROOFLINE_H_
+
+#include <benchmark/benchmark.h>
+#include <cuda_runtime.h>
+#include <algorithm>
+#include <string>
+#include "dali/core/cuda_error.h"
+#include "dali/core/cuda_event.h"
+
+namespace dali {
+
+/**
+ * @brief The theoretical peak performance of a GPU, calculated from its properties
+ */
+struct DevicePeak {
+  std::string name;
+  /// DRAM bandwidth, in bytes per second
+  double bandwidth = 0;
+  /// Single precision FMA throughput, in FLOP per second (an FMA counts as 2 FLOPs)
+  double flops = 0;
+
+  /**
+   * @brief The number of FP32 cores in a multiprocessor of the given compute capability
+   */
+  static int CoresPerSM(int major, int minor) {
+    switch (major) {
+      case 3:
+        return 192;
+      case 5:
+        return 128;
+      case 6:
+        return minor == 0 ? 64 : 128;
+      case 7:
+        return 64;
+      case 8:
+        return minor == 0 ? 64 : 128;
+      default:
+        return 128;
+    }
+  }
+
+  static DevicePeak Get(int device_id) {
+    cudaDeviceProp prop;
+    CUDA_CALL(cudaGetDeviceProperties(&prop, device_id));
+    DevicePeak peak;
+    peak.name = prop.name;
+    // memoryClockRate is in kHz; DDR memory transfers twice per clock
+    peak.bandwidth = 2.0 * prop.memoryClockRate * 1e3 * (prop.memoryBusWidth / 8);
+    peak.flops = 2.0 * prop.multiProcessorCount * CoresPerSM(prop.major, prop.minor) *
+                 prop.clockRate * 1e3;
+    return peak;
+  }
+
+  /**
+   * @brief The peak of the current device, calculated once per device
+   */
+  static const DevicePeak &Current() {
+    static DevicePeak peak = []() {
+      int device_id = 0;
+      CUDA_CALL(cudaGetDevice(&device_id));
+      return Get(device_id);
+    }();
+    return peak;
+  }
+};
+
+/**
+ * @brief Times the GPU work of the iterations of a benchmark and reports it against
+ *        the roofline of the device
+ *
+ * The work issued by `run(stream)` is timed with CUDA events, so only the time spent on the GPU
+ * is measured - the benchmarks using it should be registered with `UseManualTime()`.
+ * `bytes` and `flops` describe the work done in a single call; the bytes are the DRAM traffic
+ * the kernel cannot avoid (each input read and each output written once).
+ *
+ * Reported counters:
+ *  - GB/s and %peak_bw - the achieved bandwidth and its fraction of the peak;
+ *  - GFLOP/s and %peak_flops - as above, for the arithmetic (only when `flops` > 0);
+ *  - %roofline - the achieved fraction of the performance attainable at the arithmetic
+ *    intensity of the kernel (flops / bytes), i.e. min(peak FLOP/s, intensity * peak bandwidth);
+ *    for data movement kernels this is the same as %peak_bw.
+ */
+template <typename RunFn>
+void RunRoofline(benchmark::State &st, cudaStream_t stream, double bytes, double flops,
+                 RunFn &&run) {
+  const auto &peak = DevicePeak::Current();
+  auto start = CUDAEvent::Create();
+  auto end = CUDAEvent::Create();
+
+  // the first run may allocate memory or select the launch parameters
+  run(stream);
+  CUDA_CALL(cudaStreamSynchronize(stream));
+
+  double total_time = 0;
+  for (auto _ : st) {
+    CUDA_CALL(cudaEventRecord(start, stream));
+    run(stream);
+    CUDA_CALL(cudaEventRecord(end, stream));
+    CUDA_CALL(cudaEventSynchronize(end));
+    float ms = 0;
+    CUDA_CALL(cudaEventElapsedTime(&ms, start, end));
+    st.SetIterationTime(ms * 1e-3);
+    total_time += ms * 1e-3;
+  }
+  if (total_time <= 0)
+    return;
+
+  double iters = st.iterations();
+  double bw = bytes * iters / total_time;
+  st.counters["GB/s"] = bw * 1e-9;
+  st.counters["%peak_bw"] = 100 * bw / peak.bandwidth;
+  double attainable = peak.bandwidth;
+  double achieved = bw;
+  if (flops > 0) {
+    double fl = flops * iters / total_time;
+    st.counters["GFLOP/s"] = fl * 1e-9;
+    st.counters["%peak_flops"] = 100 * fl / peak.flops;
+    attainable = std::min(peak.flops, flops / bytes * peak.bandwidth);
+    achieved = fl;
+  }
+  st.counters["%roofline"] = 100 * achieved / attainable;
+  st.SetLabel(peak.name);
+}
+
+}  // namespace dali
+
+#endif  // DALI_BENCHMARK_GPU_ROOFLINE_H_
@@ -0,0 +1,322 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "dali/benchmark/dali_bench.h"
+#include "dali/operators/reader/loader/file_label_loader.h"
+#include "dali/operators/reader/loader/indexed_file_loader.h"
+#include "dali/operators/reader/loader/numpy_loader.h"
+#include "dali/operators/reader/loader/recordio_loader.h"
+#include "dali/pipeline/operator/op_spec.h"
+#include "dali/test/dali_test_config.h"
+#if LIBTAR_ENABLED
+#include "dali/operators/reader/loader/webdataset_loader.h"
+#endif
+#if CUFILE_ENABLED
+#include "dali/core/cuda_error.h"
+#include "dali/operators/reader/loader/numpy_loader_gpu.h"
+#endif
+
+namespace dali {
+
+/**
+ * @brief Measures the loaders directly, without the decoding and the rest of the pipeline
+ *
+ * This separates the cost of the I/O (the FileStream backend, the file system and the page
+ * cache) and of the Loader itself (the shuffling buffer, the sharding) from the rest of
+ * the reader. Each iteration reads one batch with ReadOne, timing every call.
+ *
+ * The benchmarks share the arguments:
+ *  - batch size,
+ *  - I/O mode: 0 - regular reads, 1 - mmap, 2 - io_uring (falls back to the regular reads,
+ *    when not available),
+ *  - shuffling: 0 - none, 1 - the shuffling buffer (`initial_fill` = 1024), 2 - shuffled indices,
+ *  - number of shards (shard 0 is read),
+ *  - number of I/O threads of the loader.
+ *
+ * Reported counters: samples/s, MB/s, the percentiles of the read latency (p50_us, p90_us,
+ * p99_us, max_us) and its histogram - `lat_le_<N>us` is the fraction of the reads which
+ * took at most N microseconds (and more than N/2), with N being the powers of 2.
+ *
+ * The data sets are taken from DALI_extra, or from the paths given by the environment variables:
+ *  - DALI_LOADER_BENCH_FILE_ROOT - a directory for FileLabelLoader,
+ *  - DALI_LOADER_BENCH_RECORDIO / _RECORDIO_INDEX - a RecordIO file and its index,
+ *  - DALI_LOADER_BENCH_TFRECORD / _TFRECORD_INDEX - a TFRecord file and its index,
+ *  - DALI_LOADER_BENCH_WDS / _WDS_INDEX - a webdataset archive and its index (no default),
+ *  - DALI_LOADER_BENCH_NUMPY - a directory with .npy files (no default).
+ * The files are read through the page cache, to measure cold reads it must be dropped before
+ * running the benchmark.
+ */
+class LoaderBench : public DALIBenchmark {
+ public:
+  enum IOMode {
+    kRead = 0,
+    kMmap = 1,
+    kIOUring = 2
+  };
+
+  static std::string DataPath(const char *env, const std::string &dali_extra_rel = "") {
+    const char *path = std::getenv(env);
+    if (path)
+      return path;
+    if (dali_extra_rel.empty())
+      return "";
+    return testing::dali_extra_path() + "/" + dali_extra_rel;
+  }
+
+  /**
+   * @brief Creates the spec of the reader with the arguments common to all the benchmarks
+   */
+  static OpSpec ReaderSpec(const std::string &name, const benchmark::State &st) {
+    int batch_size = st.range(0);
+    int io_mode = st.range(1);
+    int shuffle = st.range(2);
+    int num_shards = st.range(3);
+    int num_io_threads = st.range(4);
+    return OpSpec(name)
+        .AddArg("max_batch_size", batch_size)
+        .AddArg("device_id", 0)
+        .AddArg("dont_use_mmap", io_mode != kMmap)
+        .AddArg("use_io_uring", io_mode == kIOUring)
+        .AddArg("random_shuffle", shuffle != 0)
+        .AddArg("shuffle_indices", shuffle == 2)
+        .AddArg("initial_fill", 1024)
+        .AddArg("seed", 1234)
+        .AddArg("num_shards", num_shards)
+        .AddArg("shard_id", 0)
+        .AddArg("num_io_threads", num_io_threads);
+  }
+
+  /**
+   * @brief Reads batches from the loader and reports the statistics
+   *
+   * @param read  reads one sample: `read(is_new_batch)` returns the number of bytes read
+   */
+  template <typename LoaderType, typename ReadFn>
+  void Run(benchmark::State &st, LoaderType &loader, ReadFn &&read) {
+    int batch_size = st.range(0);
+    loader.PrepareMetadata();
+
+    // the first batch fills the shuffling buffer, it's not measured
+    for (int i = 0; i < batch_size; i++)
+      read(i == 0);
+
+    std::vector<double> latencies;
+    int64_t total_bytes = 0;
+    for (auto _ : st) {
+      for (int i = 0; i < batch_size; i++) {
+        auto start = std::chrono::high_resolution_clock::now();
+        total_bytes += read(i == 0);
+        auto end = std::chrono::high_resolution_clock::now();
+        latencies.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+      }
+    }
+
+    st.counters["samples/s"] = benchmark::Counter(st.iterations() * batch_size,
+                                                  benchmark::Counter::kIsRate);
+    st.counters["MB/s"] = benchmark::Counter(total_bytes * 1e-6, benchmark::Counter::kIsRate);
+    ReportLatency(st, latencies);
+  }
+
+  static void ReportLatency(benchmark::State &st, std::vector<double> &latencies) {
+    if (latencies.empty())
+      return;
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double p) {
+      return latencies[std::min<size_t>(latencies.size() - 1, p * latencies.size())];
+    };
+    st.counters["p50_us"] = percentile(0.5);
+    st.counters["p90_us"] = percentile(0.9);
+    st.counters["p99_us"] = percentile(0.99);
+    st.counters["max_us"] = latencies.back();
+
+    // the latencies are sorted, so the buckets are consecutive ranges
+    size_t begin = 0;
+    for (int64_t bucket = 1; begin < latencies.size(); bucket *= 2) {
+      size_t end = std::upper_bound(latencies.begin() + begin, latencies.end(),
+                                    static_cast<double>(bucket)) - latencies.begin();
+      if (end > begin)
+        st.counters["lat_le_" + std::to_string(bucket) + "us"] =
+            static_cast<double>(end - begin) / latencies.size();
+      begin = end;
+    }
+  }
+};
+
+static void LoaderArgs(benchmark::internal::Benchmark *b) {
+  for (int io_mode : { LoaderBench::kRead, LoaderBench::kMmap, LoaderBench::kIOUring }) {
+    for (int shuffle : { 0, 1, 2 }) {
+      for (int num_shards : { 1, 8 }) {
+        b->Args({32, io_mode, shuffle, num_shards, 1});
+      }
+    }
+    b->Args({32, io_mode, 2, 1, 4});
+  }
+}
+
+BENCHMARK_DEFINE_F(LoaderBench, FileLabelLoader)(benchmark::State& st) {
+  auto spec = ReaderSpec("readers__File", st)
+      .AddArg("file_root", DataPath("DALI_LOADER_BENCH_FILE_ROOT", "db/single/jpeg"));
+  FileLabelLoader loader(spec);
+  Run(st, loader, [&](bool is_new_batch) {
+    return loader.ReadOne(is_new_batch)->image.nbytes();
+  });
+}
+
+BENCHMARK_REGISTER_F(LoaderBench, FileLabelLoader)->Iterations(100)
+->Unit(benchmark::kMicrosecond)
+->UseRealTime()
+->Apply(LoaderArgs);
+
+BENCHMARK_DEFINE_F(LoaderBench, RecordIOLoader)(benchmark::State& st) {
+  auto spec = ReaderSpec("readers__MXNet", st)
+      .AddArg("path", std::vector<std::string>{
+          DataPath("DALI_LOADER_BENCH_RECORDIO", "db/recordio/train.rec") })
+      .AddArg("index_path", std::vector<std::string>{
+          DataPath("DALI_LOADER_BENCH_RECORDIO_INDEX", "db/recordio/train.idx") });
+  RecordIOLoader loader(spec);
+  Run(st, loader, [&](bool is_new_batch) {
+    return loader.ReadOne(is_new_batch)->nbytes();
+  });
+}
+
+BENCHMARK_REGISTER_F(LoaderBench, RecordIOLoader)->Iterations(100)
+->Unit(benchmark::kMicrosecond)
+->UseRealTime()
+->Apply(LoaderArgs);
+
+#ifdef DALI_BUILD_PROTO3
+BENCHMARK_DEFINE_F(LoaderBench, TFRecordLoader)(benchmark::State& st) {
+  auto spec = ReaderSpec("readers__TFRecord", st)
+      .AddArg("path", std::vector<std::string>{
+          DataPath("DALI_LOADER_BENCH_TFRECORD", "db/tfrecord/train") })
+      .AddArg("index_path", std::vector<std::string>{
+          DataPath("DALI_LOADER_BENCH_TFRECORD_INDEX", "db/tfrecord/train.idx") });
+  IndexedFileLoader loader(spec);
+  Run(st, loader, [&](bool is_new_batch) {
+    return loader.ReadOne(is_new_batch)->nbytes();
+  });
+}
+
+BENCHMARK_REGISTER_F(LoaderBench, TFRecordLoader)->Iterations(100)
+->Unit(benchmark::kMicrosecond)
+->UseRealTime()
+->Apply(LoaderArgs);
+#endif  // DALI_BUILD_PROTO3
+
+#if LIBTAR_ENABLED
+BENCHMARK_DEFINE_F(LoaderBench, WebdatasetLoader)(benchmark::State& st) {
+  auto path = DataPath("DALI_LOADER_BENCH_WDS");
+  auto index_path = DataPath("DALI_LOADER_BENCH_WDS_INDEX");
+  if (path.empty() || index_path.empty()) {
+    st.SkipWithError("DALI_LOADER_BENCH_WDS and DALI_LOADER_BENCH_WDS_INDEX are not set");
+    return;
+  }
+  auto spec = ReaderSpec("readers__Webdataset", st)
+      .AddArg("paths", std::vector<std::string>{ path })
+      .AddArg("index_paths", std::vector<std::string>{ index_path })
+      .AddArg("ext", std::vector<std::string>{ "jpg;png;jpeg", "cls" });
+  WebdatasetLoader loader(spec);
+  Run(st, loader, [&](bool is_new_batch) {
+    auto sample = loader.ReadOne(is_new_batch);
+    int64_t bytes = 0;
+    for (auto &component : *sample)
+      bytes += component.nbytes();
+    return bytes;
+  });
+}
+
+BENCHMARK_REGISTER_F(LoaderBench, WebdatasetLoader)->Iterations(100)
+->Unit(benchmark::kMicrosecond)
+->UseRealTime()
+->Apply(LoaderArgs);
+#endif  // LIBTAR_ENABLED
+
+BENCHMARK_DEFINE_F(LoaderBench, NumpyLoader)(benchmark::State& st) {
+  auto file_root = DataPath("DALI_LOADER_BENCH_NUMPY");
+  if (file_root.empty()) {
+    st.SkipWithError("DALI_LOADER_BENCH_NUMPY is not set");
+    return;
+  }
+  auto spec = ReaderSpec("readers__Numpy", st).AddArg("file_root", file_root);
+  NumpyLoader loader(spec);
+  Run(st, loader, [&](bool is_new_batch) {
+    return loader.ReadOne(is_new_batch)->data.nbytes();
+  });
+}
+
+BENCHMARK_REGISTER_F(LoaderBench, NumpyLoader)->Iterations(100)
+->Unit(benchmark::kMicrosecond)
+->UseRealTime()
+->Apply(LoaderArgs);
+
+#if CUFILE_ENABLED
+/**
+ * @brief Reads the samples with GPUDirect Storage, to a device buffer
+ *
+ * The I/O mode argument doesn't apply here - the data is read with cuFile.
+ */
+BENCHMARK_DEFINE_F(LoaderBench, NumpyLoaderGPU)(benchmark::State& st) {
+  auto file_root = DataPath("DALI_LOADER_BENCH_NUMPY");
+  if (file_root.empty()) {
+    st.SkipWithError("DALI_LOADER_BENCH_NUMPY is not set");
+    return;
+  }
+  auto spec = ReaderSpec("readers__Numpy", st)
+      .AddArg("device", "gpu")
+      .AddArg("file_root", file_root);
+  NumpyLoaderGPU loader(spec);
+
+  // GPUDirect Storage cannot read to the memory from a pool
+  void *buffer = nullptr;
+  size_t buffer_size = 0;
+  Run(st, loader, [&](bool is_new_batch) -> int64_t {
+    auto sample = loader.ReadOne(is_new_batch);
+    sample->read_meta_f();
+    if (!sample->host_data.empty())
+      return sample->host_data.size();
+    size_t bytes = volume(sample->get_shape()) * TypeTable::GetTypeInfo(sample->get_type()).size();
+    if (bytes > buffer_size) {
+      if (buffer)
+        CUDA_CALL(cudaFree(buffer));
+      CUDA_CALL(cudaMalloc(&buffer, bytes));
+      buffer_size = bytes;
+    }
+    sample->read_sample_f(buffer, 0, bytes);
+    return bytes;
+  });
+  if (buffer)
+    CUDA_CALL(cudaFree(buffer));
+}
+
+static void LoaderGPUArgs(benchmark::internal::Benchmark *b) {
+  for (int shuffle : { 0, 2 }) {
+    for (int num_shards : { 1, 8 }) {
+      b->Args({32, LoaderBench::kRead, shuffle, num_shards, 1});
+    }
+  }
+}
+
+BENCHMARK_REGISTER_F(LoaderBench, NumpyLoaderGPU)->Iterations(100)
+->Unit(benchmark::kMicrosecond)
+->UseRealTime()
+->Apply(LoaderGPUArgs);
+#endif  // CUFILE_ENABLED
+
+}  // namespace dali
@@ -0,0 +1,159 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <vector>
+#include "dali/benchmark/dali_bench.h"
+#include "dali/core/cuda_error.h"
+#include "dali/kernels/imgproc/resample.h"
+#include "dali/kernels/imgproc/resample/separable_impl.h"
+#include "dali/kernels/scratch.h"
+#include "dali/test/tensor_test_utils.h"
+#include "dali/test/test_tensors.h"
+
+namespace dali {
+
+class ResizeBenchGPU : public DALIBenchmark {
+ public:
+  using Kernel = kernels::ResampleGPU<uint8_t, uint8_t, 2>;
+  using Impl = kernels::resampling::SeparableResamplingGPUImpl<uint8_t, uint8_t, 2>;
+
+  kernels::TestTensorList<uint8_t, 3> in_data;
+  kernels::TestTensorList<uint8_t, 3> out_data;
+  std::vector<kernels::ResamplingParams2D> params;
+
+  /**
+   * @brief Prepares a batch with a mix of resolutions - each sample is half the size
+   *        (in both dimensions) of the previous one, cycling through `num_resolutions` sizes;
+   *        the images are downscaled by a factor of 2.
+   */
+  void Setup(int batch_size, int max_size, int num_resolutions) {
+    TensorListShape<3> shape(batch_size);
+    params.resize(batch_size);
+    for (int i = 0; i < batch_size; i++) {
+      int size = std::max(max_size >> (i % num_resolutions), 2);
+      shape.set_tensor_shape(i, { size, size * 4 / 3, 3 });
+      for (int d = 0; d < 2; d++) {
+        params[i][d].output_size = shape.tensor_shape_span(i)[d] / 2;
+        params[i][d].min_filter = kernels::ResamplingFilterType::Triangular;
+        params[i][d].mag_filter = kernels::ResamplingFilterType::Linear;
+      }
+    }
+    in_data.reshape(shape);
+    std::mt19937_64 rng;
+    UniformRandomFill(in_data.cpu(), rng, 0, 255);
+  }
+
+  /**
+   * @brief Estimates the fraction of the block slots which is kept busy during the passes
+   *
+   * The blocks are dispatched, in the order of their indices, to the first free slot
+   * (a block-sized share of a multiprocessor) and cost proportionally to their number
+   * of output elements. This is a model of the block scheduler - the achieved occupancy
+   * can only be measured with a profiler.
+   */
+  static double EstimateOccupancy(Impl &impl) {
+    int device = 0;
+    CUDA_CALL(cudaGetDevice(&device));
+    cudaDeviceProp prop;
+    CUDA_CALL(cudaGetDeviceProperties(&prop, device));
+    const auto &setup = impl.setup;
+    int threads_per_block = setup.block_dim.x * setup.block_dim.y * setup.block_dim.z;
+    int slots = prop.multiProcessorCount *
+                std::max(1, prop.maxThreadsPerMultiProcessor / threads_per_block);
+
+    int total_blocks = 0;
+    for (auto x : setup.total_blocks)
+      total_blocks += x;
+    std::vector<Impl::BlockDesc> blocks(total_blocks);
+    impl.setup.InitializeSampleLookup(make_tensor_cpu<1>(blocks.data(), { total_blocks }));
+
+    double busy = 0, capacity = 0;
+    int pass_start = 0;
+    for (int pass = 0; pass < 2; pass++) {
+      std::priority_queue<double, std::vector<double>, std::greater<double>> slot_end;
+      for (int s = 0; s < slots; s++)
+        slot_end.push(0);
+      double makespan = 0;
+      for (int b = pass_start; b < pass_start + setup.total_blocks[pass]; b++) {
+        auto &blk = blocks[b];
+        double cost = volume(blk.end - blk.start) * setup.sample_descs[blk.sample_idx].channels;
+        double end = slot_end.top() + cost;
+        slot_end.pop();
+        slot_end.push(end);
+        makespan = std::max(makespan, end);
+        busy += cost;
+      }
+      capacity += makespan * slots;
+      pass_start += setup.total_blocks[pass];
+    }
+    return capacity > 0 ? busy / capacity : 0;
+  }
+
+  void RunGPU(benchmark::State& st) {
+    int batch_size = st.range(0);
+    int max_size = st.range(1);
+    int num_resolutions = st.range(2);
+    bool balance = st.range(3);
+    Setup(batch_size, max_size, num_resolutions);
+
+    Kernel kernel;
+    kernel.balance_blocks = balance;
+    kernels::KernelContext ctx;
+    ctx.gpu.stream = 0;
+    auto in_tv = in_data.gpu();
+    auto req = kernel.Setup(ctx, in_tv, make_cspan(params));
+    out_data.reshape(req.output_shapes[0].to_static<3>());
+    auto out_tv = out_data.gpu();
+
+    kernels::ScratchpadAllocator scratch_alloc;
+    scratch_alloc.Reserve(req.scratch_sizes);
+
+    for (auto _ : st) {
+      kernel.Setup(ctx, in_tv, make_cspan(params));
+      auto scratchpad = scratch_alloc.GetScratchpad();
+      ctx.scratchpad = &scratchpad;
+      kernel.Run(ctx, out_tv, in_tv, make_cspan(params));
+      CUDA_CALL(cudaStreamSynchronize(ctx.gpu.stream));
+      st.counters["FPS"] = benchmark::Counter(st.iterations() + 1,
+        benchmark::Counter::kIsRate);
+    }
+
+    auto *impl = dynamic_cast<Impl *>(kernel.pImpl.get());
+    if (impl)
+      st.counters["est_occupancy"] = EstimateOccupancy(*impl);
+  }
+};
+
+static void ResizeKernelArgs_GPU_MixedSizes(benchmark::internal::Benchmark *b) {
+  for (int balance = 0; balance <= 1; balance++) {
+    b->Args({32, 2048, 5, balance});
+    b->Args({32, 4096, 6, balance});
+    b->Args({256, 1024, 4, balance});
+  }
+}
+
+BENCHMARK_DEFINE_F(ResizeBenchGPU, Resize_GPU_MixedSizes)(benchmark::State& st) {
+  this->RunGPU(st);
+}
+
+BENCHMARK_REGISTER_F(ResizeBenchGPU, Resize_GPU_MixedSizes)->Iterations(100)
+->Unit(benchmark::kMicrosecond)
+->UseRealTime()
+->Apply(ResizeKernelArgs_GPU_MixedSizes);
+
+}  // namespace dali
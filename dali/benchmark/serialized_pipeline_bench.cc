@@ -0,0 +1,200 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "dali/core/mm/default_resources.h"
+#include "dali/core/mm/pool_stats.h"
+#include "dali/pipeline/pipeline.h"
+
+/**
+ * End-to-end benchmark of serialized pipelines, e.g. the ones saved with `Pipeline.serialize`
+ * in Python, so the production pipelines can be measured without the Python overhead.
+ *
+ * The benchmark is configured with the environment variables:
+ *  - DALI_BENCH_PIPELINES - the files with the serialized pipelines, separated with `:`;
+ *                           one benchmark is registered for each file,
+ *  - DALI_BENCH_ITERATIONS - the number of the measured iterations (100),
+ *  - DALI_BENCH_WARMUP - the number of the iterations run before the measurement (10),
+ *  - DALI_BENCH_BATCH_SIZE, DALI_BENCH_NUM_THREADS, DALI_BENCH_DEVICE_ID - override the values
+ *    stored in the serialized pipeline,
+ *  - DALI_BENCH_PREFETCH_DEPTH - the prefetch queue depth (2).
+ *
+ * The results are reported as counters, so `--benchmark_format=json` or `--benchmark_out=<file>`
+ * give a machine-readable report:
+ *  - `FPS` - the samples per second,
+ *  - `latency_p50_ms`, `latency_p90_ms`, `latency_p99_ms`, `latency_max_ms` - the time between
+ *    the consecutive outputs, as seen by the consumer,
+ *  - `<stage or operator>_ms` - the average time per iteration from the executor timing
+ *    statistics, e.g. `STAGE_CPU_ms` or `GPU_resize_ms`, `<...>_gpu_ms` - the device time,
+ *  - `peak_device_bytes`, `peak_pinned_bytes` - the peak usage of the memory pools during
+ *    the measurement,
+ *  - `cpu_utilization` - the CPU time of the process per second, divided by the number
+ *    of the worker threads.
+ */
+
+namespace dali {
+
+namespace {
+
+int GetEnvInt(const char *name, int default_value) {
+  const char *value = std::getenv(name);
+  return value && *value ? std::atoi(value) : default_value;
+}
+
+std::vector<std::string> GetPipelineFiles() {
+  std::vector<std::string> files;
+  const char *value = std::getenv("DALI_BENCH_PIPELINES");
+  if (!value)
+    return files;
+  std::stringstream ss(value);
+  std::string file;
+  while (std::getline(ss, file, ':')) {
+    if (!file.empty())
+      files.push_back(file);
+  }
+  return files;
+}
+
+double ProcessCPUTime() {
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+         1e-6 * (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+}
+
+template <typename Resource>
+size_t PeakInUse(const Resource *resource) {
+  mm::pool_stats stats;
+  return mm::get_pool_stats(resource, stats) ? stats.peak_in_use : 0;
+}
+
+void ResetPeaks(int device_id) {
+  mm::reset_pool_peak(mm::GetDefaultDeviceResource(device_id));
+  mm::reset_pool_peak(mm::GetDefaultResource<mm::memory_kind::pinned>());
+}
+
+int OutputBatchSize(const DeviceWorkspace &ws) {
+  if (ws.NumOutput() == 0)
+    return 0;
+  return ws.OutputIsType<CPUBackend>(0) ? ws.Output<CPUBackend>(0).ntensor()
+                                        : ws.Output<GPUBackend>(0).ntensor();
+}
+
+double Percentile(const std::vector<double> &sorted, double p) {
+  if (sorted.empty())
+    return 0;
+  size_t idx = std::min(sorted.size() - 1, static_cast<size_t>(p * sorted.size()));
+  return sorted[idx];
+}
+
+void SerializedPipeline(benchmark::State &st, const std::string &path) {  // NOLINT
+  std::ifstream f(path, std::ios::binary);
+  DALI_ENFORCE(f.good(), make_string("Cannot open the serialized pipeline: ", path));
+  std::string serialized((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+
+  int warmup = GetEnvInt("DALI_BENCH_WARMUP", 10);
+  int depth = GetEnvInt("DALI_BENCH_PREFETCH_DEPTH", 2);
+  Pipeline pipe(serialized,
+                GetEnvInt("DALI_BENCH_BATCH_SIZE", -1),
+                GetEnvInt("DALI_BENCH_NUM_THREADS", -1),
+                GetEnvInt("DALI_BENCH_DEVICE_ID", -1),
+                true, depth, true);
+  pipe.Build();
+
+  DeviceWorkspace ws;
+  auto run = [&]() {
+    pipe.RunCPU();
+    pipe.RunGPU();
+  };
+
+  for (int i = 0; i < depth; i++)
+    run();
+  for (int i = 0; i < warmup; i++) {
+    pipe.Outputs(&ws);
+    run();
+  }
+
+  ResetPeaks(pipe.device_id());
+  pipe.EnableExecutorTimingStats();
+  std::vector<double> latencies;
+  int64_t samples = 0;
+  double cpu_start = ProcessCPUTime();
+  auto start = std::chrono::steady_clock::now();
+  auto last = start;
+  for (auto _ : st) {
+    pipe.Outputs(&ws);
+    auto now = std::chrono::steady_clock::now();
+    double latency = std::chrono::duration<double>(now - last).count();
+    st.SetIterationTime(latency);
+    latencies.push_back(latency);
+    samples += OutputBatchSize(ws);
+    last = now;
+    run();
+  }
+  double total_time = std::chrono::duration<double>(last - start).count();
+  double cpu_time = ProcessCPUTime() - cpu_start;
+  pipe.EnableExecutorTimingStats(false);
+
+  std::sort(latencies.begin(), latencies.end());
+  st.counters["FPS"] = total_time > 0 ? samples / total_time : 0;
+  st.counters["latency_p50_ms"] = 1e3 * Percentile(latencies, 0.5);
+  st.counters["latency_p90_ms"] = 1e3 * Percentile(latencies, 0.9);
+  st.counters["latency_p99_ms"] = 1e3 * Percentile(latencies, 0.99);
+  st.counters["latency_max_ms"] = latencies.empty() ? 0 : 1e3 * latencies.back();
+
+  for (auto &entry : pipe.GetExecutorTimingMeta()) {
+    auto &timing = entry.second;
+    st.counters[entry.first + "_ms"] = 1e3 * timing.total_time / timing.iterations;
+    if (timing.gpu_iterations > 0)
+      st.counters[entry.first + "_gpu_ms"] = 1e3 * timing.gpu_time / timing.gpu_iterations;
+  }
+
+  st.counters["peak_device_bytes"] = PeakInUse(mm::GetDefaultDeviceResource(pipe.device_id()));
+  st.counters["peak_pinned_bytes"] =
+      PeakInUse(mm::GetDefaultResource<mm::memory_kind::pinned>());
+  if (total_time > 0)
+    st.counters["cpu_utilization"] = cpu_time / total_time / pipe.num_threads();
+
+  // collect the iterations still in flight, before the pipeline is destroyed
+  for (int i = 0; i < depth; i++)
+    pipe.Outputs(&ws);
+}
+
+int RegisterSerializedPipelineBenchmarks() {
+  int iterations = GetEnvInt("DALI_BENCH_ITERATIONS", 100);
+  auto files = GetPipelineFiles();
+  for (auto &file : files) {
+    benchmark::RegisterBenchmark(("SerializedPipeline/" + file).c_str(), SerializedPipeline, file)
+        ->Iterations(iterations)
+        ->Unit(benchmark::kMillisecond)
+        ->UseManualTime();
+  }
+  return files.size();
+}
+
+int serialized_pipeline_benchmarks = RegisterSerializedPipelineBenchmarks();
+
+}  // namespace
+
+}  // namespace dali
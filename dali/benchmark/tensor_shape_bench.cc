@@ -0,0 +1,79 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include "dali/core/tensor_shape.h"
+
+namespace dali {
+
+namespace {
+
+TensorListShape<4> RandomShape(int batch_size) {
+  std::mt19937 rng(1234);
+  std::uniform_int_distribution<int64_t> extent(1, 512);
+  TensorListShape<4> shape;
+  shape.resize(batch_size);
+  for (int i = 0; i < batch_size; i++)
+    shape.set_tensor_shape(i, TensorShape<4>{extent(rng), extent(rng), extent(rng), 3});
+  return shape;
+}
+
+}  // namespace
+
+/**
+ * @brief The shape arithmetic of a typical Setup, which creates new shape lists every iteration
+ */
+static void TensorShapeBench_Allocating(benchmark::State &st) {
+  auto in = RandomShape(st.range(0));
+  int perm[] = { 3, 0, 1, 2 };
+  for (auto _ : st) {
+    auto collapsed = collapse_dims<3>(in, {{ 1, 2 }});
+    auto permuted = permute_dims(in, perm);
+    auto inner = in.last(2);
+    auto half = sample_range(in, 0, in.num_samples(), 2);
+    benchmark::DoNotOptimize(collapsed.shapes.data());
+    benchmark::DoNotOptimize(permuted.shapes.data());
+    benchmark::DoNotOptimize(inner.shapes.data());
+    benchmark::DoNotOptimize(half.shapes.data());
+  }
+  st.SetItemsProcessed(st.iterations() * in.num_samples());
+}
+
+/**
+ * @brief The same arithmetic, with the results stored in shape lists reused across iterations
+ */
+static void TensorShapeBench_InPlace(benchmark::State &st) {
+  auto in = RandomShape(st.range(0));
+  int perm[] = { 3, 0, 1, 2 };
+  TensorListShape<3> collapsed;
+  TensorListShape<4> permuted, half;
+  TensorListShape<> inner;
+  for (auto _ : st) {
+    collapse_dims(collapsed, in, {{ 1, 2 }});
+    permute_dims(permuted, in, perm);
+    last_dims(inner, in, 2);
+    sample_range(half, in, 0, in.num_samples(), 2);
+    benchmark::DoNotOptimize(collapsed.shapes.data());
+    benchmark::DoNotOptimize(permuted.shapes.data());
+    benchmark::DoNotOptimize(inner.shapes.data());
+    benchmark::DoNotOptimize(half.shapes.data());
+  }
+  st.SetItemsProcessed(st.iterations() * in.num_samples());
+}
+
+BENCHMARK(TensorShapeBench_Allocating)->Arg(8)->Arg(64)->Arg(256);
+BENCHMARK(TensorShapeBench_InPlace)->Arg(8)->Arg(64)->Arg(256);
+
+}  // namespace dali
@@ -0,0 +1,108 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "dali/operators/reader/parser/example.pb.h"
+#include "dali/operators/reader/parser/tfrecord_wire_format.h"
+
+namespace dali {
+
+namespace {
+
+/**
+ * @brief A serialized example similar to the ImageNet TFRecords: the encoded image,
+ *        a label and the bounding boxes
+ */
+const std::string &TestExample(int image_size) {
+  static std::string serialized;
+  static int size = -1;
+  if (size != image_size) {
+    tensorflow::Example example;
+    auto &features = *example.mutable_features()->mutable_feature();
+    features["image/encoded"].mutable_bytes_list()->add_value(std::string(image_size, 'x'));
+    features["image/class/label"].mutable_int64_list()->add_value(417);
+    features["image/class/text"].mutable_bytes_list()->add_value("balloon");
+    for (const char *coord : {"xmin", "ymin", "xmax", "ymax"}) {
+      auto *list = features[std::string("image/object/bbox/") + coord].mutable_float_list();
+      for (int i = 0; i < 4; i++)
+        list->add_value(0.1f * i);
+    }
+    example.SerializeToString(&serialized);
+    size = image_size;
+  }
+  return serialized;
+}
+
+const std::vector<std::string> kFeatureNames = {
+  "image/encoded", "image/class/label", "image/object/bbox/xmin", "image/object/bbox/ymax"
+};
+
+}  // namespace
+
+static void TFRecordParserBench_Protobuf(benchmark::State &st) {
+  auto &serialized = TestExample(st.range(0));
+  std::vector<uint8_t> image;
+  int64_t label = 0;
+  float bbox[2][16];
+  for (auto _ : st) {
+    tensorflow::Example example;
+    example.ParseFromArray(serialized.data(), serialized.size());
+    auto &feature = example.features().feature();
+    auto &encoded = feature.find(kFeatureNames[0])->second.bytes_list().value(0);
+    image.resize(encoded.size());
+    std::memcpy(image.data(), encoded.data(), encoded.size());
+    label = feature.find(kFeatureNames[1])->second.int64_list().value(0);
+    for (int i = 0; i < 2; i++) {
+      auto &values = feature.find(kFeatureNames[2 + i])->second.float_list().value();
+      std::memcpy(bbox[i], values.data(), values.size() * sizeof(float));
+    }
+    benchmark::DoNotOptimize(image.data());
+    benchmark::DoNotOptimize(label);
+    benchmark::DoNotOptimize(bbox);
+  }
+  st.SetItemsProcessed(st.iterations());
+  st.SetBytesProcessed(st.iterations() * serialized.size());
+}
+
+static void TFRecordParserBench_WireFormat(benchmark::State &st) {
+  auto &serialized = TestExample(st.range(0));
+  auto *data = reinterpret_cast<const uint8_t *>(serialized.data());
+  std::vector<uint8_t> image;
+  int64_t label = 0;
+  float bbox[2][16];
+  tfrecord_wire::FeatureView views[4];
+  for (auto _ : st) {
+    tfrecord_wire::FindFeatures({data, data + serialized.size()}, kFeatureNames, views);
+    bool found = false;
+    auto encoded = tfrecord_wire::FirstBytes(views[0].list, found);
+    image.resize(encoded.size());
+    std::memcpy(image.data(), encoded.data, encoded.size());
+    tfrecord_wire::DecodeInt64(views[1].list, &label);
+    for (int i = 0; i < 2; i++)
+      tfrecord_wire::DecodeFloat(views[2 + i].list, bbox[i]);
+    benchmark::DoNotOptimize(image.data());
+    benchmark::DoNotOptimize(label);
+    benchmark::DoNotOptimize(bbox);
+  }
+  st.SetItemsProcessed(st.iterations());
+  st.SetBytesProcessed(st.iterations() * serialized.size());
+}
+
+BENCHMARK(TFRecordParserBench_Protobuf)->Arg(256)->Arg(16 << 10)->Arg(256 << 10);
+BENCHMARK(TFRecordParserBench_WireFormat)->Arg(256)->Arg(16 << 10)->Arg(256 << 10);
+
+}  // namespace dali
@@ -0,0 +1,86 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <functional>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "dali/core/mm/malloc_resource.h"
+#include "dali/core/mm/pool_resource.h"
+#include "dali/core/mm/thread_cache_resource.h"
+
+namespace dali {
+namespace mm {
+
+namespace {
+
+using host_pool = pool_resource_base<memory_kind::host, any_context, coalescing_free_tree,
+                                     std::mutex>;
+
+host_pool &GetPool() {
+  static host_pool pool(&malloc_memory_resource::instance());
+  return pool;
+}
+
+thread_cache_resource<memory_kind::host> &GetCachedPool() {
+  static thread_cache_resource<memory_kind::host> cache(&GetPool());
+  return cache;
+}
+
+/**
+ * @brief Allocates and frees blocks of random size, keeping up to 64 of them alive
+ */
+void AllocFreeLoop(benchmark::State &st, host_memory_resource &mr) {
+  std::mt19937 rng(std::hash<std::thread::id>()(std::this_thread::get_id()));
+  std::uniform_int_distribution<size_t> size_dist(16, st.range(0));
+  std::vector<std::pair<void *, size_t>> live(64, {nullptr, 0});
+  int64_t n = 0;
+  for (auto _ : st) {
+    auto &blk = live[n++ & 63];
+    if (blk.first)
+      mr.deallocate(blk.first, blk.second);
+    blk.second = size_dist(rng);
+    blk.first = mr.allocate(blk.second);
+    benchmark::DoNotOptimize(blk.first);
+  }
+  for (auto &blk : live)
+    if (blk.first)
+      mr.deallocate(blk.first, blk.second);
+  st.SetItemsProcessed(st.iterations());
+}
+
+}  // namespace
+
+static void ThreadCacheBench_Pool(benchmark::State &st) {
+  AllocFreeLoop(st, GetPool());
+}
+
+static void ThreadCacheBench_ThreadCache(benchmark::State &st) {
+  AllocFreeLoop(st, GetCachedPool());
+}
+
+BENCHMARK(ThreadCacheBench_Pool)
+->Arg(1024)->Arg(16 << 10)
+->ThreadRange(1, 16)
+->UseRealTime();
+
+BENCHMARK(ThreadCacheBench_ThreadCache)
+->Arg(1024)->Arg(16 << 10)
+->ThreadRange(1, 16)
+->UseRealTime();
+
+}  // namespace mm
+}  // namespace dali
@@ -13,9 +13,11 @@
 // limitations under the License.
 
 #include <benchmark/benchmark.h>
+#include <memory>
 #include <numeric>
 #include "dali/kernels/transpose/transpose.h"
 #include "dali/core/mm/memory.h"
+#include "dali/pipeline/util/thread_pool.h"
 
 namespace dali {
 
@@ -48,6 +50,15 @@ static CaseData cases[] = {
     CaseData{{7, 2, 4, 6, 10, 8, 4, 2}, {7, 5, 3, 2, 4, 0, 1, 6}},
 };
 
+// Big samples, processed by multiple threads
+static CaseData big_cases[] = {
+    CaseData{{1080, 1920, 3}, {2, 0, 1}},        // HWC -> CHW
+    CaseData{{3, 1080, 1920}, {1, 2, 0}},        // CHW -> HWC
+    CaseData{{4096, 4096}, {1, 0}},              // 2D
+    CaseData{{64, 256, 256, 4}, {3, 0, 1, 2}},   // DHWC -> CDHW
+    CaseData{{64, 256, 256, 4}, {2, 1, 0, 3}},   // DHWC -> WHDC
+};
+
 std::tuple<TensorShape<>, std::vector<int>> GetCase(int id) {
   return cases[id];
 }
@@ -60,6 +71,14 @@ static void CustomArguments(benchmark::internal::Benchmark* b) {
   }
 }
 
+static void BigCaseArguments(benchmark::internal::Benchmark* b) {
+  for (unsigned int i = 0; i < sizeof(big_cases) / sizeof(*big_cases); i++) {
+    for (int num_threads = 1; num_threads <= 8; num_threads *= 2) {
+      b->Args({i, num_threads});
+    }
+  }
+}
+
 }  // namespace
 
 template <typename T>
@@ -168,4 +187,67 @@ BENCHMARK_REGISTER_F(TransposeFixture, CompactUint16Test)->Apply(CustomArguments
 BENCHMARK_REGISTER_F(TransposeFixture, CompactIntTest)->Apply(CustomArguments);
 BENCHMARK_REGISTER_F(TransposeFixture, CompactDoubleTest)->Apply(CustomArguments);
 
+template <typename T>
+class TransposeBigFixture : public benchmark::Fixture {
+ public:
+  void SetUp(benchmark::State& st) override {
+    auto test_case = big_cases[st.range(0)];
+    src_shape_ = std::get<0>(test_case);
+    perm_ = std::get<1>(test_case);
+    dst_shape_ = permute(src_shape_, perm_);
+    auto total_size = volume(src_shape_);
+    dst_mem_.resize(total_size);
+    src_mem_.resize(total_size);
+    for (int64_t i = 0; i < total_size; i++) {
+      src_mem_[i] = i;
+    }
+    thread_pool_ = std::make_unique<ThreadPool>(st.range(1), CPU_ONLY_DEVICE_ID, false);
+  }
+
+  void TearDown(benchmark::State& st) override {
+    thread_pool_.reset();
+    dst_mem_.clear();
+    dst_mem_.shrink_to_fit();
+    src_mem_.clear();
+    src_mem_.shrink_to_fit();
+  }
+
+  void Run(benchmark::State& st) {
+    TensorView<StorageCPU, const T> src_view(src_mem_.data(), src_shape_);
+    TensorView<StorageCPU, T> dst_view(dst_mem_.data(), dst_shape_);
+    for (auto _ : st) {
+      benchmark::DoNotOptimize(src_mem_.data());
+      kernels::TransposeGrouped(*thread_pool_, dst_view, src_view, make_cspan(perm_));
+      thread_pool_->RunAll();
+      benchmark::DoNotOptimize(dst_mem_.data());
+      benchmark::ClobberMemory();
+    }
+    st.SetBytesProcessed(st.iterations() * 2 * volume(src_shape_) * sizeof(T));
+  }
+
+  std::vector<int> perm_;
+  TensorShape<> src_shape_, dst_shape_;
+  std::vector<T> dst_mem_, src_mem_;
+  std::unique_ptr<ThreadPool> thread_pool_;
+};
+
+BENCHMARK_TEMPLATE_DEFINE_F(TransposeBigFixture, BigUint8Test, uint8_t)(benchmark::State& st) {
+  this->Run(st);
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(TransposeBigFixture, BigUint16Test, uint16_t)(benchmark::State& st) {
+  this->Run(st);
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(TransposeBigFixture, BigFloatTest, float)(benchmark::State& st) {
+  this->Run(st);
+}
+
+BENCHMARK_REGISTER_F(TransposeBigFixture, BigUint8Test)->Apply(BigCaseArguments)
+->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_REGISTER_F(TransposeBigFixture, BigUint16Test)->Apply(BigCaseArguments)
+->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_REGISTER_F(TransposeBigFixture, BigFloatTest)->Apply(BigCaseArguments)
+->Unit(benchmark::kMillisecond)->UseRealTime();
+
 }  // namespace dali
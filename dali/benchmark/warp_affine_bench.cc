@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <benchmark/benchmark.h>
+#include <cmath>
 #include "dali/benchmark/operator_bench.h"
 #include "dali/benchmark/dali_bench.h"
 
@@ -91,4 +92,55 @@ BENCHMARK_REGISTER_F(OperatorBench, WarpAffineGPU)->Iterations(100)
 ->UseRealTime()
 ->Apply(WarpAffineGPUArgs);
 
+
+static void WarpAffineGPUTextureArgs(benchmark::internal::Benchmark *b) {
+  for (int batch_size = 64; batch_size >= 1; batch_size /= 4) {
+    for (int H = 2048; H >= 512; H /= 2) {
+      for (int C : { 3, 4 }) {
+        for (int use_texture = 0; use_texture <= 1; use_texture++) {
+          int W = H;
+          b->Args({batch_size, H, W, C, use_texture});
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief Compares the global memory and the texture sampling paths for a warp with
+ *        a significant rotation, which is where the texture cache helps the most.
+ */
+BENCHMARK_DEFINE_F(OperatorBench, WarpAffineGPUTexture)(benchmark::State& st) {
+  int batch_size = st.range(0);
+  int H = st.range(1);
+  int W = st.range(2);
+  int C = st.range(3);
+  bool use_texture = st.range(4);
+
+  // 30 degree rotation around the image center
+  float c = std::cos(M_PI / 6), s = std::sin(M_PI / 6);
+  float cx = W * 0.5f, cy = H * 0.5f;
+  vector<float> mtx = {
+    c, -s, cx - c * cx + s * cy,
+    s,  c, cy - s * cx - c * cy
+  };
+
+  this->RunGPU<uint8_t>(
+    st,
+    OpSpec("WarpAffine")
+      .AddArg("max_batch_size", batch_size)
+      .AddArg("num_threads", 1)
+      .AddArg("device", "gpu")
+      .AddArg("matrix", mtx)
+      .AddArg("fill_value", 0)
+      .AddArg("interp_type", DALI_INTERP_LINEAR)
+      .AddArg("use_texture", use_texture),
+    batch_size, H, W, C);
+}
+
+BENCHMARK_REGISTER_F(OperatorBench, WarpAffineGPUTexture)->Iterations(100)
+->Unit(benchmark::kMicrosecond)
+->UseRealTime()
+->Apply(WarpAffineGPUTextureArgs);
+
 }  // namespace dali
@@ -0,0 +1,100 @@
+// Copyright (c) 2021, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include "dali/benchmark/dali_bench.h"
+#include "dali/pipeline/util/thread_pool.h"
+#include "dali/pipeline/util/work_stealing_thread_pool.h"
+
+namespace dali {
+
+// Compares ThreadPool and WorkStealingThreadPool when the jobs are so small that
+// the cost of scheduling dominates.
+class ThreadPoolTinyJobsBench : public DALIBenchmark {};
+
+static void TinyJobsArgs(benchmark::internal::Benchmark *b) {
+  int num_jobs = 4096;
+  int work_size = 64;
+  for (int nthreads : {4, 16, 32}) {
+    b->Args({num_jobs, work_size, nthreads});
+  }
+}
+
+template <typename Pool>
+void RunTinyJobs(benchmark::State &st, bool deferred) {
+  int num_jobs = st.range(0);
+  int work_size = st.range(1);
+  int nthreads = st.range(2);
+
+  Pool thread_pool(nthreads, 0, false);
+
+  std::vector<uint8_t> data(work_size, 0xFF);
+  std::atomic<int64_t> total_count(0);
+  while (st.KeepRunning()) {
+    for (int i = 0; i < num_jobs; i++) {
+      thread_pool.AddWork(
+        [&data, &total_count](int thread_id) {
+          int64_t sum = 0;
+          for (auto x : data)
+            sum += x;
+          total_count += sum;
+        }, i, !deferred);
+    }
+    if (deferred)
+      thread_pool.RunAll();
+    else
+      thread_pool.WaitForWork();
+  }
+  st.counters["Jobs"] = benchmark::Counter(
+      static_cast<double>(num_jobs) * st.iterations(), benchmark::Counter::kIsRate);
+  benchmark::DoNotOptimize(total_count.load());
+}
+
+BENCHMARK_DEFINE_F(ThreadPoolTinyJobsBench, ThreadPool)(benchmark::State& st) {
+  RunTinyJobs<ThreadPool>(st, false);
+}
+
+BENCHMARK_REGISTER_F(ThreadPoolTinyJobsBench, ThreadPool)->Iterations(200)
+->Unit(benchmark::kMicrosecond)
+->UseRealTime()
+->Apply(TinyJobsArgs);
+
+BENCHMARK_DEFINE_F(ThreadPoolTinyJobsBench, WorkStealing)(benchmark::State& st) {
+  RunTinyJobs<WorkStealingThreadPool>(st, false);
+}
+
+BENCHMARK_REGISTER_F(ThreadPoolTinyJobsBench, WorkStealing)->Iterations(200)
+->Unit(benchmark::kMicrosecond)
+->UseRealTime()
+->Apply(TinyJobsArgs);
+
+BENCHMARK_DEFINE_F(ThreadPoolTinyJobsBench, ThreadPoolDeferred)(benchmark::State& st) {
+  RunTinyJobs<ThreadPool>(st, true);
+}
+
+BENCHMARK_REGISTER_F(ThreadPoolTinyJobsBench, ThreadPoolDeferred)->Iterations(200)
+->Unit(benchmark::kMicrosecond)
+->UseRealTime()
+->Apply(TinyJobsArgs);
+
+BENCHMARK_DEFINE_F(ThreadPoolTinyJobsBench, WorkStealingDeferred)(benchmark::State& st) {
+  RunTinyJobs<WorkStealingThreadPool>(st, true);
+}
+
+BENCHMARK_REGISTER_F(ThreadPoolTinyJobsBench, WorkStealingDeferred)->Iterations(200)
+->Unit(benchmark::kMicrosecond)
+->UseRealTime()
+->Apply(TinyJobsArgs);
+
+}  // namespace dali
@@ -15,14 +15,23 @@
 #include "dali/c_api.h"  // NOLINT [build/include]
 
 #include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 #include <map>
 
 #include "dali/core/common.h"
+#include "dali/core/cuda_event.h"
 #include "dali/core/cuda_stream.h"
+#include "dali/core/device_guard.h"
 #include "dali/core/format.h"
+#include "dali/core/mm/default_resources.h"
 #include "dali/core/tensor_shape.h"
 #include "dali/pipeline/init.h"
 
@@ -31,6 +40,7 @@
 #include "dali/pipeline/data/tensor_list.h"
 #include "dali/pipeline/data/backend.h"
 #include "dali/pipeline/data/copy_to_external.h"
+#include "dali/pipeline/util/thread_pool.h"
 
 namespace {
 
@@ -78,7 +88,9 @@ dali::ExtSrcNoCopyMode GetExternalSourceCopyMode(unsigned int flags) {
 template <typename Backend>
 void SetExternalInput(daliPipelineHandle *pipe_handle, const char *name, const void *data_ptr,
                       dali_data_type_t data_type, const int64_t *shapes, int sample_dim,
-                      const char *layout_str, cudaStream_t stream = 0, unsigned int flags = 0) {
+                      const char *layout_str, cudaStream_t stream = 0, unsigned int flags = 0,
+                      cudaEvent_t done_event = nullptr,
+                      std::function<void(cudaStream_t)> release_callback = {}) {
   dali::Pipeline *pipeline = reinterpret_cast<dali::Pipeline *>(pipe_handle->pipe);
   auto *bs_map = reinterpret_cast<batch_size_map_t *>(pipe_handle->batch_size_map);
   auto curr_batch_size = PopCurrBatchSize(bs_map, pipeline->max_batch_size(), name);
@@ -98,10 +110,13 @@ void SetExternalInput(daliPipelineHandle *pipe_handle, const char *name, const v
   data.ShareData(const_cast<void *>(data_ptr), tl_shape.num_elements() * elem_sizeof);
   data.Resize(tl_shape, type_id);
   data.SetLayout(layout);
-  pipeline->SetExternalInput(name, data, stream,
-                             flags & DALI_ext_force_sync,
-                             flags & DALI_use_copy_kernel,
-                             GetExternalSourceCopyMode(flags));
+  dali::ExtSrcSettingMode mode;
+  mode.sync = flags & DALI_ext_force_sync;
+  mode.use_copy_kernel = flags & DALI_use_copy_kernel;
+  mode.no_copy_mode = GetExternalSourceCopyMode(flags);
+  mode.done_event = done_event;
+  mode.release_callback = std::move(release_callback);
+  pipeline->SetExternalInputHelper(name, data, stream, std::move(mode));
 }
 
 
@@ -109,7 +124,8 @@ template<typename Backend>
 void SetExternalInputTensors(daliPipelineHandle *pipe_handle, const char *name,
                              const void *const *data_ptr, dali_data_type_t data_type,
                              const int64_t *shapes, int64_t sample_dim, const char *layout_str,
-                             cudaStream_t stream = 0, unsigned int flags = 0) {
+                             cudaStream_t stream = 0, unsigned int flags = 0,
+                             cudaEvent_t done_event = nullptr) {
   dali::Pipeline *pipeline = reinterpret_cast<dali::Pipeline *>(pipe_handle->pipe);
   auto *bs_map = reinterpret_cast<batch_size_map_t *>(pipe_handle->batch_size_map);
   auto curr_batch_size = PopCurrBatchSize(bs_map, pipeline->max_batch_size(), name);
@@ -134,7 +150,8 @@ void SetExternalInputTensors(daliPipelineHandle *pipe_handle, const char *name,
   pipeline->SetExternalInput(name, data, stream,
                              flags & DALI_ext_force_sync,
                              flags & DALI_use_copy_kernel,
-                             GetExternalSourceCopyMode(flags));
+                             GetExternalSourceCopyMode(flags),
+                             done_event);
 }
 
 inline dali::mm::memory_kind_id GetMemKind(device_type_t device_type, bool is_pinned) {
@@ -143,6 +160,215 @@ inline dali::mm::memory_kind_id GetMemKind(device_type_t device_type, bool is_pi
         : (is_pinned ? dali::mm::memory_kind_id::pinned : dali::mm::memory_kind_id::host);
 }
 
+/**
+ * @brief The device memory and the events of other processes, opened with CUDA IPC
+ *
+ * Opening a handle is expensive and the producers typically reuse their buffers, so the handles
+ * are opened once. The memory stays mapped until daliCloseIpcMemHandle, the events are kept
+ * for the lifetime of the process. The maps are keyed by the bytes of the handles.
+ */
+struct IpcMapping {
+  int device_id;
+  void *ptr;
+};
+std::mutex ipc_mutex;
+std::map<std::string, IpcMapping> ipc_mem_mappings;
+std::map<std::string, cudaEvent_t> ipc_events;
+
+template <typename Handle>
+std::string IpcKey(const Handle &handle) {
+  return std::string(reinterpret_cast<const char *>(&handle), sizeof(handle));
+}
+
+void *OpenIpcMemHandle(const cudaIpcMemHandle_t &handle, int device_id) {
+  std::lock_guard<std::mutex> lock(ipc_mutex);
+  auto key = IpcKey(handle);
+  auto it = ipc_mem_mappings.find(key);
+  if (it != ipc_mem_mappings.end())
+    return it->second.ptr;
+  void *ptr = nullptr;
+  CUDA_CALL(cudaIpcOpenMemHandle(&ptr, handle, cudaIpcMemLazyEnablePeerAccess));
+  ipc_mem_mappings[key] = { device_id, ptr };
+  return ptr;
+}
+
+cudaEvent_t OpenIpcEventHandle(const cudaIpcEventHandle_t &handle) {
+  std::lock_guard<std::mutex> lock(ipc_mutex);
+  auto &event = ipc_events[IpcKey(handle)];
+  if (!event)
+    CUDA_CALL(cudaIpcOpenEventHandle(&event, handle));
+  return event;
+}
+
+/**
+ * @brief The threads copying the CPU outputs to the host memory, shared by all pipelines
+ *
+ * The copies are bound by the memory bandwidth, so a few threads are enough. The copies
+ * requested by different threads are serialized with `output_copy_mutex`.
+ */
+constexpr int kMaxOutputCopyThreads = 8;
+std::mutex output_copy_mutex;
+
+dali::ThreadPool &OutputCopyThreadPool() {
+  static dali::ThreadPool pool(
+      std::max(1, std::min<int>(kMaxOutputCopyThreads, std::thread::hardware_concurrency())),
+      dali::CPU_ONLY_DEVICE_ID, false);
+  return pool;
+}
+
+/**
+ * @brief Copies the output `output_idx` to `dst` - one buffer, or a buffer per sample
+ *
+ * The copies to the host memory of the CPU outputs are split between the threads
+ * of OutputCopyThreadPool, the others are batched by the scatter-gather copy.
+ */
+template <typename Dst>
+void OutputCopy(daliPipelineHandle *pipe_handle, Dst dst, int output_idx,
+                device_type_t dst_type, cudaStream_t stream, unsigned int flags,
+                cudaEvent_t done_event) {
+  bool is_pinned = flags & DALI_ext_pinned;
+  bool sync = flags & DALI_ext_force_sync;
+  bool use_copy_kernel = flags & DALI_use_copy_kernel;
+  auto dst_mem_kind = GetMemKind(dst_type, is_pinned);
+
+  dali::DeviceWorkspace *ws = reinterpret_cast<dali::DeviceWorkspace *>(pipe_handle->ws);
+  assert(ws != nullptr);
+
+  if (ws->OutputIsType<dali::CPUBackend>(output_idx)) {
+    auto &output = ws->OutputRef<dali::CPUBackend>(output_idx);
+    if (dst_type == device_type_t::CPU) {
+      std::lock_guard<std::mutex> lock(output_copy_mutex);
+      CopyToExternal(dst, dst_mem_kind, output, stream, use_copy_kernel, &OutputCopyThreadPool());
+    } else {
+      CopyToExternal(dst, dst_mem_kind, output, stream, use_copy_kernel);
+    }
+  } else {
+    CopyToExternal(dst, dst_mem_kind, ws->OutputRef<dali::GPUBackend>(output_idx),
+                   stream, use_copy_kernel);
+  }
+  if (done_event) {
+    CUDA_CALL(cudaEventRecord(done_event, stream));
+  }
+  if (sync) {
+    CUDA_CALL(cudaStreamSynchronize(stream));
+  }
+}
+
+/**
+ * @brief Aggregates the samples of individual requests into batches fed to the pipeline.
+ *
+ * Only the pointers and the metadata of the samples are kept - the data is read when the batch
+ * is fed to the External Sources.
+ */
+class RequestBatcher {
+ public:
+  using clock = std::chrono::steady_clock;
+
+  struct Sample {
+    const void *data = nullptr;
+    device_type_t device = CPU;
+    dali_data_type_t type = DALI_NO_TYPE;
+    std::vector<int64_t> shape;
+    std::string layout;
+  };
+
+  struct Request {
+    int64_t id;
+    std::vector<Sample> samples;  // one per input
+    int num_samples = 0;
+    clock::time_point completed;
+  };
+
+  RequestBatcher(int max_batch_size, std::vector<std::string> input_names,
+                 std::chrono::microseconds max_latency)
+  : max_batch_size_(max_batch_size), input_names_(std::move(input_names)),
+    max_latency_(max_latency) {}
+
+  void AddSample(int64_t request_id, const std::string &name, Sample sample) {
+    auto input_it = std::find(input_names_.begin(), input_names_.end(), name);
+    DALI_ENFORCE(input_it != input_names_.end(),
+                 dali::make_string("The request batcher has no input \"", name, "\"."));
+    int input_idx = input_it - input_names_.begin();
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto it = std::find_if(pending_.begin(), pending_.end(),
+                           [&](const Request &r) { return r.id == request_id; });
+    if (it == pending_.end()) {
+      pending_.push_back({request_id, std::vector<Sample>(input_names_.size())});
+      it = std::prev(pending_.end());
+    }
+    DALI_ENFORCE(it->samples[input_idx].data == nullptr,
+                 dali::make_string("The request ", request_id, " already has a sample for \"",
+                                   name, "\"."));
+    it->samples[input_idx] = std::move(sample);
+    if (++it->num_samples == static_cast<int>(input_names_.size())) {
+      it->completed = clock::now();
+      num_complete_++;
+      cv_.notify_all();
+    }
+  }
+
+  /**
+   * @brief Waits until the batch is full or the oldest complete request exceeded the latency
+   *        budget and removes the complete requests from the pending ones.
+   */
+  std::vector<Request> TakeBatch() {
+    std::unique_lock<std::mutex> lock(mtx_);
+    if (num_complete_ == 0)
+      return {};
+    auto oldest = std::min_element(pending_.begin(), pending_.end(),
+                                   [](const Request &a, const Request &b) {
+      bool a_complete = a.num_samples == static_cast<int>(a.samples.size());
+      bool b_complete = b.num_samples == static_cast<int>(b.samples.size());
+      if (a_complete != b_complete)
+        return a_complete;
+      return a.completed < b.completed;
+    });
+    cv_.wait_until(lock, oldest->completed + max_latency_,
+                   [&]() { return num_complete_ >= max_batch_size_; });
+
+    std::vector<Request> batch;
+    for (auto it = pending_.begin(); it != pending_.end() &&
+         static_cast<int>(batch.size()) < max_batch_size_;) {
+      if (it->num_samples == static_cast<int>(input_names_.size())) {
+        batch.push_back(std::move(*it));
+        it = pending_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    num_complete_ -= batch.size();
+    return batch;
+  }
+
+  void PushRunBatch(std::vector<int64_t> ids) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    in_flight_.push_back(std::move(ids));
+  }
+
+  std::vector<int64_t> PopRunBatch() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    DALI_ENFORCE(!in_flight_.empty(), "There are no request batches in flight.");
+    auto ids = std::move(in_flight_.front());
+    in_flight_.pop_front();
+    return ids;
+  }
+
+  const std::vector<std::string> &input_names() const {
+    return input_names_;
+  }
+
+ private:
+  int max_batch_size_;
+  std::vector<std::string> input_names_;
+  std::chrono::microseconds max_latency_;
+
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  std::deque<Request> pending_;  // in the order of arrival
+  int num_complete_ = 0;
+  std::deque<std::vector<int64_t>> in_flight_;
+};
+
 }  // namespace
 
 
@@ -244,14 +470,24 @@ void daliSetExternalInputAsync(daliPipelineHandle *pipe_handle, const char *name
                                dali_data_type_t data_type, const int64_t *shapes,
                                int sample_dim, const char *layout_str, cudaStream_t stream,
                                unsigned int flags) {
+  daliSetExternalInputAsyncWithEvent(pipe_handle, name, device, data_ptr, data_type, shapes,
+                                     sample_dim, layout_str, stream, nullptr, flags);
+}
+
+void daliSetExternalInputAsyncWithEvent(daliPipelineHandle *pipe_handle, const char *name,
+                                        device_type_t device, const void *data_ptr,
+                                        dali_data_type_t data_type, const int64_t *shapes,
+                                        int sample_dim, const char *layout_str,
+                                        cudaStream_t stream, cudaEvent_t done_event,
+                                        unsigned int flags) {
   switch (device) {
     case device_type_t::CPU:
       SetExternalInput<dali::CPUBackend>(pipe_handle, name, data_ptr, data_type, shapes, sample_dim,
-                                         layout_str, stream, flags);
+                                         layout_str, stream, flags, done_event);
       return;
     case device_type_t::GPU:
       SetExternalInput<dali::GPUBackend>(pipe_handle, name, data_ptr, data_type, shapes, sample_dim,
-                                         layout_str, stream, flags);
+                                         layout_str, stream, flags, done_event);
       return;
     default:
       DALI_FAIL(dali::make_string("Unknown device: ", device));
@@ -259,6 +495,50 @@ void daliSetExternalInputAsync(daliPipelineHandle *pipe_handle, const char *name
 }
 
 
+void daliSetExternalInputIpc(daliPipelineHandle *pipe_handle, const char *name,
+                             const cudaIpcMemHandle_t *mem_handle, size_t offset,
+                             dali_data_type_t data_type, const int64_t *shapes,
+                             int sample_dim, const char *layout_str,
+                             const cudaIpcEventHandle_t *ready_event,
+                             const cudaIpcEventHandle_t *release_event,
+                             cudaStream_t stream, unsigned int flags) {
+  DALI_ENFORCE(mem_handle != nullptr, "The IPC memory handle must not be NULL.");
+  dali::Pipeline *pipeline = reinterpret_cast<dali::Pipeline *>(pipe_handle->pipe);
+  dali::DeviceGuard dg(pipeline->device_id());
+  auto *data = static_cast<const uint8_t *>(OpenIpcMemHandle(*mem_handle, pipeline->device_id()));
+  if (ready_event)
+    CUDA_CALL(cudaStreamWaitEvent(stream, OpenIpcEventHandle(*ready_event), 0));
+  cudaEvent_t release = release_event ? OpenIpcEventHandle(*release_event) : nullptr;
+
+  if (flags & DALI_ext_force_copy) {
+    SetExternalInput<dali::GPUBackend>(pipe_handle, name, data + offset, data_type, shapes,
+                                       sample_dim, layout_str, stream, flags, release);
+    return;
+  }
+  std::function<void(cudaStream_t)> release_callback;
+  if (release) {
+    release_callback = [release](cudaStream_t pipeline_stream) {
+      CUDA_CALL(cudaEventRecord(release, pipeline_stream));
+    };
+  }
+  SetExternalInput<dali::GPUBackend>(pipe_handle, name, data + offset, data_type, shapes,
+                                     sample_dim, layout_str, stream,
+                                     flags | DALI_ext_force_no_copy, nullptr,
+                                     std::move(release_callback));
+}
+
+
+void daliCloseIpcMemHandle(const cudaIpcMemHandle_t *mem_handle) {
+  std::lock_guard<std::mutex> lock(ipc_mutex);
+  auto it = ipc_mem_mappings.find(IpcKey(*mem_handle));
+  if (it == ipc_mem_mappings.end())
+    return;
+  dali::DeviceGuard dg(it->second.device_id);
+  CUDA_CALL(cudaIpcCloseMemHandle(it->second.ptr));
+  ipc_mem_mappings.erase(it);
+}
+
+
 void daliSetExternalInputTensors(daliPipelineHandle *pipe_handle, const char *name,
                                  device_type_t device, const void *const *data_ptr,
                                  dali_data_type_t data_type, const int64_t *shapes,
@@ -274,14 +554,25 @@ void daliSetExternalInputTensorsAsync(daliPipelineHandle *pipe_handle, const cha
                                       dali_data_type_t data_type, const int64_t *shapes,
                                       int64_t sample_dim, const char *layout_str,
                                       cudaStream_t stream, unsigned int flags) {
+  daliSetExternalInputTensorsAsyncWithEvent(pipe_handle, name, device, data_ptr, data_type,
+                                            shapes, sample_dim, layout_str, stream, nullptr,
+                                            flags);
+}
+
+void daliSetExternalInputTensorsAsyncWithEvent(daliPipelineHandle *pipe_handle, const char *name,
+                                               device_type_t device, const void *const *data_ptr,
+                                               dali_data_type_t data_type, const int64_t *shapes,
+                                               int64_t sample_dim, const char *layout_str,
+                                               cudaStream_t stream, cudaEvent_t done_event,
+                                               unsigned int flags) {
   switch (device) {
     case device_type_t::CPU:
       SetExternalInputTensors<dali::CPUBackend>(pipe_handle, name, data_ptr, data_type, shapes,
-                                                sample_dim, layout_str, stream, flags);
+                                                sample_dim, layout_str, stream, flags, done_event);
       return;
     case device_type_t::GPU:
       SetExternalInputTensors<dali::GPUBackend>(pipe_handle, name, data_ptr, data_type, shapes,
-                                                sample_dim, layout_str, stream, flags);
+                                                sample_dim, layout_str, stream, flags, done_event);
       return;
     default:
       DALI_FAIL(dali::make_string("Unknown device: ", device));
@@ -310,11 +601,38 @@ void daliShareOutput(daliPipelineHandle *pipe_handle) {
 }
 
 
+cudaEvent_t daliShareOutputAsync(daliPipelineHandle *pipe_handle) {
+  dali::Pipeline *pipeline = reinterpret_cast<dali::Pipeline *>(pipe_handle->pipe);
+  dali::DeviceWorkspace *ws = reinterpret_cast<dali::DeviceWorkspace *>(pipe_handle->ws);
+  return pipeline->ShareOutputsAsync(ws);
+}
+
+
 void daliOutputRelease(daliPipelineHandle *pipe_handle) {
   dali::Pipeline *pipeline = reinterpret_cast<dali::Pipeline *>(pipe_handle->pipe);
   pipeline->ReleaseOutputs();
 }
 
+
+void daliOutputReleaseWithEvent(daliPipelineHandle *pipe_handle, cudaEvent_t consumer_event) {
+  dali::Pipeline *pipeline = reinterpret_cast<dali::Pipeline *>(pipe_handle->pipe);
+  pipeline->ReleaseOutputs(consumer_event);
+}
+
+
+void daliSetExternalOutputBuffers(daliPipelineHandle *pipe_handle, int output_idx,
+                                  void *const *buffers, const size_t *buffer_sizes,
+                                  int num_buffers) {
+  dali::Pipeline *pipeline = reinterpret_cast<dali::Pipeline *>(pipe_handle->pipe);
+  DALI_ENFORCE(num_buffers >= 0, "The number of buffers must not be negative.");
+  std::vector<dali::ExternalOutputBuffer> external(num_buffers);
+  for (int i = 0; i < num_buffers; i++) {
+    external[i].data = buffers[i];
+    external[i].bytes = buffer_sizes[i];
+  }
+  pipeline->SetExternalOutputBuffers(output_idx, std::move(external));
+}
+
 int64_t daliOutputHasUniformShape(daliPipelineHandle* pipe_handle, int i) {
   dali::DeviceWorkspace* ws = reinterpret_cast<dali::DeviceWorkspace*>(pipe_handle->ws);
   if (ws->OutputIsType<dali::CPUBackend>(i)) {
@@ -470,51 +788,29 @@ device_type_t daliGetOutputDevice(daliPipelineHandle *pipe_handle, int id) {
 void daliOutputCopy(daliPipelineHandle *pipe_handle, void *dst, int output_idx,
                     device_type_t dst_type, cudaStream_t stream, unsigned int flags) {
   dali::DomainTimeRange tr("[DALI][C API] daliOutputCopy", dali::DomainTimeRange::kGreen);
+  OutputCopy(pipe_handle, dst, output_idx, dst_type, stream, flags, nullptr);
+}
 
-  bool is_pinned = flags & DALI_ext_pinned;
-  bool sync = flags & DALI_ext_force_sync;
-  bool use_copy_kernel = flags & DALI_use_copy_kernel;
-  auto dst_mem_kind = GetMemKind(dst_type, is_pinned);
-
-  dali::DeviceWorkspace *ws = reinterpret_cast<dali::DeviceWorkspace *>(pipe_handle->ws);
-  assert(ws != nullptr);
-
-  auto &type_info = dali::TypeTable::GetTypeInfo(dali::DALIDataType::DALI_UINT8);
-  if (ws->OutputIsType<dali::CPUBackend>(output_idx)) {
-    CopyToExternal(dst, dst_mem_kind, ws->OutputRef<dali::CPUBackend>(output_idx),
-                   stream, use_copy_kernel);
-  } else {
-    CopyToExternal(dst, dst_mem_kind, ws->OutputRef<dali::GPUBackend>(output_idx),
-                   stream, use_copy_kernel);
-  }
-  if (sync) {
-    CUDA_CALL(cudaStreamSynchronize(stream));
-  }
+void daliOutputCopyWithEvent(daliPipelineHandle *pipe_handle, void *dst, int output_idx,
+                             device_type_t dst_type, cudaStream_t stream, cudaEvent_t done_event,
+                             unsigned int flags) {
+  dali::DomainTimeRange tr("[DALI][C API] daliOutputCopyWithEvent",
+                           dali::DomainTimeRange::kGreen);
+  OutputCopy(pipe_handle, dst, output_idx, dst_type, stream, flags, done_event);
 }
 
 void daliOutputCopySamples(daliPipelineHandle *pipe_handle, void **dsts, int output_idx,
                            device_type_t dst_type, cudaStream_t stream, unsigned int flags) {
   dali::DomainTimeRange tr("[DALI][C API] daliOutputCopySamples", dali::DomainTimeRange::kGreen);
+  OutputCopy(pipe_handle, dsts, output_idx, dst_type, stream, flags, nullptr);
+}
 
-  bool is_pinned = flags & DALI_ext_pinned;
-  bool sync = flags & DALI_ext_force_sync;
-  bool use_copy_kernel = flags & DALI_use_copy_kernel;
-  auto dst_mem_kind = GetMemKind(dst_type, is_pinned);
-
-  dali::DeviceWorkspace *ws = reinterpret_cast<dali::DeviceWorkspace *>(pipe_handle->ws);
-  assert(ws != nullptr);
-
-  auto &type_info = dali::TypeTable::GetTypeInfo(dali::DALIDataType::DALI_UINT8);
-  if (ws->OutputIsType<dali::CPUBackend>(output_idx)) {
-    CopyToExternal(dsts, dst_mem_kind, ws->OutputRef<dali::CPUBackend>(output_idx),
-                   stream, use_copy_kernel);
-  } else {
-    CopyToExternal(dsts, dst_mem_kind, ws->OutputRef<dali::GPUBackend>(output_idx),
-                   stream, use_copy_kernel);
-  }
-  if (sync) {
-    CUDA_CALL(cudaStreamSynchronize(stream));
-  }
+void daliOutputCopySamplesWithEvent(daliPipelineHandle *pipe_handle, void **dsts, int output_idx,
+                                    device_type_t dst_type, cudaStream_t stream,
+                                    cudaEvent_t done_event, unsigned int flags) {
+  dali::DomainTimeRange tr("[DALI][C API] daliOutputCopySamplesWithEvent",
+                           dali::DomainTimeRange::kGreen);
+  OutputCopy(pipe_handle, dsts, output_idx, dst_type, stream, flags, done_event);
 }
 
 
@@ -589,10 +885,20 @@ dali_backend_t daliGetOperatorBackend(daliPipelineHandle* pipe_handle, const cha
   }
 }
 
+void daliEnableExecutorTimingStats(daliPipelineHandle* pipe_handle, int enable_timing_stats) {
+  dali::Pipeline* pipeline = reinterpret_cast<dali::Pipeline*>(pipe_handle->pipe);
+  pipeline->EnableExecutorTimingStats(enable_timing_stats);
+}
+
 void daliGetExecutorMetadata(daliPipelineHandle* pipe_handle, daliExecutorMetadata **operator_meta,
                              size_t *operator_meta_num) {
   dali::Pipeline* pipeline = reinterpret_cast<dali::Pipeline*>(pipe_handle->pipe);
   auto returned_meta = pipeline->GetExecutorMeta();
+  auto returned_timing = pipeline->GetExecutorTimingMeta();
+  // the entries that have only the timing statistics (e.g. stages) are reported without outputs
+  for (const auto &timing : returned_timing) {
+    returned_meta.emplace(timing.first, std::vector<dali::ExecutorMeta>{});
+  }
   *operator_meta_num = returned_meta.size();
   *operator_meta = static_cast<daliExecutorMetadata*>(malloc(sizeof(daliExecutorMetadata) *
                                                      returned_meta.size()));
@@ -605,12 +911,25 @@ void daliGetExecutorMetadata(daliPipelineHandle* pipe_handle, daliExecutorMetada
     stat.first.copy(op_meta.operator_name, op_name_size);
     op_meta.operator_name[op_name_size] = '\0';
 
+    dali::ExecutorTimingMeta timing;
+    auto timing_it = returned_timing.find(stat.first);
+    if (timing_it != returned_timing.end())
+      timing = timing_it->second;
+    op_meta.iterations = timing.iterations;
+    op_meta.samples = timing.samples;
+    op_meta.total_time = timing.total_time;
+    op_meta.max_time = timing.max_time;
+    op_meta.gpu_iterations = timing.gpu_iterations;
+    op_meta.gpu_time = timing.gpu_time;
+    op_meta.wait_time = timing.wait_time;
+
     auto num_outputs = stat.second.size();
     op_meta.out_num = num_outputs;
     op_meta.real_size = static_cast<size_t*>(malloc(sizeof(size_t) * num_outputs));
     op_meta.max_real_size = static_cast<size_t*>(malloc(sizeof(size_t) * num_outputs));
     op_meta.reserved = static_cast<size_t*>(malloc(sizeof(size_t) * num_outputs));
     op_meta.max_reserved = static_cast<size_t*>(malloc(sizeof(size_t) * num_outputs));
+    op_meta.sample_size_hint = static_cast<size_t*>(malloc(sizeof(size_t) * num_outputs));
 
     for (size_t j = 0; j < num_outputs; ++j) {
       const auto &entry = stat.second[j];
@@ -618,6 +937,7 @@ void daliGetExecutorMetadata(daliPipelineHandle* pipe_handle, daliExecutorMetada
       op_meta.max_real_size[j] = entry.max_real_size;
       op_meta.reserved[j] = entry.reserved;
       op_meta.max_reserved[j] = entry.max_reserved;
+      op_meta.sample_size_hint[j] = entry.sample_size_hint;
     }
     ++i;
   }
@@ -630,6 +950,178 @@ void daliFreeExecutorMetadata(daliExecutorMetadata *operator_meta, size_t operat
     free(operator_meta[i].max_real_size);
     free(operator_meta[i].reserved);
     free(operator_meta[i].max_reserved);
+    free(operator_meta[i].sample_size_hint);
   }
   free(operator_meta);
 }
+
+void daliGetPipelineHealth(daliPipelineHandle* pipe_handle, daliPipelineHealth *health) {
+  dali::Pipeline* pipeline = reinterpret_cast<dali::Pipeline*>(pipe_handle->pipe);
+  auto h = pipeline->GetHealth();
+  health->uptime = h.uptime;
+  const dali::OpType stages[] = { dali::OpType::CPU, dali::OpType::MIXED, dali::OpType::GPU };
+  for (int i = 0; i < 3; i++) {
+    auto &stage = h.stage(stages[i]);
+    health->stage_iterations[i] = stage.iterations;
+    health->stage_wait_time[i] = stage.wait_time;
+    health->stage_stalls[i] = stage.stalls;
+    health->queue_occupancy[i] = stage.output_queue.occupancy;
+    health->queue_capacity[i] = stage.output_queue.capacity;
+    health->queue_mean_occupancy[i] = stage.output_queue.mean_occupancy;
+  }
+  health->outputs = h.outputs;
+  health->consumer_wait_time = h.consumer_wait_time;
+  health->consumer_starved = h.consumer_starved;
+  health->thread_pool_threads = h.thread_pool_threads;
+  health->thread_pool_busy_time = h.thread_pool_busy_time;
+}
+
+char *daliGetPipelineHealthPrometheus(daliPipelineHandle* pipe_handle, const char *labels) {
+  dali::Pipeline* pipeline = reinterpret_cast<dali::Pipeline*>(pipe_handle->pipe);
+  auto text = dali::FormatPrometheus(pipeline->GetHealth(), labels ? labels : "");
+  auto *ret = static_cast<char*>(malloc(text.size() + 1));
+  text.copy(ret, text.size());
+  ret[text.size()] = '\0';
+  return ret;
+}
+
+size_t daliReleaseUnusedMemory(int release_caches) {
+  return dali::mm::ReleaseUnusedMemory(release_caches != 0);
+}
+
+void daliCreateRequestBatcher(daliRequestBatcherHandle *batcher_handle,
+                              daliPipelineHandle *pipe_handle,
+                              const char *const *input_names, int num_inputs,
+                              int64_t max_latency_us) {
+  dali::Pipeline *pipeline = reinterpret_cast<dali::Pipeline *>(pipe_handle->pipe);
+  DALI_ENFORCE(num_inputs > 0, "The request batcher needs at least one input.");
+  DALI_ENFORCE(max_latency_us >= 0, "The latency budget cannot be negative.");
+  std::vector<std::string> names(input_names, input_names + num_inputs);
+  batcher_handle->pipe_handle = pipe_handle;
+  batcher_handle->batcher = new RequestBatcher(pipeline->max_batch_size(), std::move(names),
+                                               std::chrono::microseconds(max_latency_us));
+}
+
+void daliDeleteRequestBatcher(daliRequestBatcherHandle *batcher_handle) {
+  delete reinterpret_cast<RequestBatcher *>(batcher_handle->batcher);
+  batcher_handle->batcher = nullptr;
+  batcher_handle->pipe_handle = nullptr;
+}
+
+void daliAddRequestSample(daliRequestBatcherHandle *batcher_handle, int64_t request_id,
+                          const char *name, device_type_t device, const void *data_ptr,
+                          dali_data_type_t data_type, const int64_t *shape, int sample_dim,
+                          const char *layout_str) {
+  auto *batcher = reinterpret_cast<RequestBatcher *>(batcher_handle->batcher);
+  DALI_ENFORCE(data_ptr != nullptr, "The sample data cannot be NULL.");
+  RequestBatcher::Sample sample;
+  sample.data = data_ptr;
+  sample.device = device;
+  sample.type = data_type;
+  sample.shape.assign(shape, shape + sample_dim);
+  if (layout_str)
+    sample.layout = layout_str;
+  batcher->AddSample(request_id, name, std::move(sample));
+}
+
+int daliRunRequestBatch(daliRequestBatcherHandle *batcher_handle, cudaStream_t stream,
+                        unsigned int flags) {
+  auto *batcher = reinterpret_cast<RequestBatcher *>(batcher_handle->batcher);
+  auto batch = batcher->TakeBatch();
+  if (batch.empty())
+    return 0;
+  int batch_size = batch.size();
+  const auto &input_names = batcher->input_names();
+  std::vector<const void *> data_ptrs(batch_size);
+  std::vector<int64_t> shapes;
+  for (size_t input_idx = 0; input_idx < input_names.size(); input_idx++) {
+    const auto &first = batch[0].samples[input_idx];
+    int sample_dim = first.shape.size();
+    shapes.clear();
+    for (int i = 0; i < batch_size; i++) {
+      const auto &sample = batch[i].samples[input_idx];
+      DALI_ENFORCE(sample.device == first.device && sample.type == first.type &&
+                   static_cast<int>(sample.shape.size()) == sample_dim &&
+                   sample.layout == first.layout,
+                   dali::make_string("The samples for \"", input_names[input_idx], "\" in the "
+                                     "requests ", batch[0].id, " and ", batch[i].id, " differ in "
+                                     "device, type, dimensionality or layout."));
+      data_ptrs[i] = sample.data;
+      shapes.insert(shapes.end(), sample.shape.begin(), sample.shape.end());
+    }
+    const char *name = input_names[input_idx].c_str();
+    daliSetExternalInputBatchSize(batcher_handle->pipe_handle, name, batch_size);
+    daliSetExternalInputTensorsAsync(batcher_handle->pipe_handle, name, first.device,
+                                     data_ptrs.data(), first.type, shapes.data(), sample_dim,
+                                     first.layout.empty() ? nullptr : first.layout.c_str(),
+                                     stream, flags);
+  }
+  std::vector<int64_t> ids(batch_size);
+  for (int i = 0; i < batch_size; i++)
+    ids[i] = batch[i].id;
+  batcher->PushRunBatch(std::move(ids));
+  daliRun(batcher_handle->pipe_handle);
+  return batch_size;
+}
+
+int daliPopRequestBatch(daliRequestBatcherHandle *batcher_handle, int64_t *request_ids) {
+  auto *batcher = reinterpret_cast<RequestBatcher *>(batcher_handle->batcher);
+  auto ids = batcher->PopRunBatch();
+  std::copy(ids.begin(), ids.end(), request_ids);
+  return ids.size();
+}
+
+template <typename Backend>
+static const void *daliOutputSampleDataHelper(dali::DeviceWorkspace *ws, int n, int k) {
+  const auto &out_tensor_list = ws->Output<Backend>(n);
+  DALI_ENFORCE(k >= 0 && k < static_cast<int>(out_tensor_list.ntensor()),
+               dali::make_string("Sample index ", k, " out of range [0, ",
+                                 out_tensor_list.ntensor(), ")."));
+  return out_tensor_list.raw_tensor(k);
+}
+
+const void *daliOutputSampleData(daliPipelineHandle *pipe_handle, int n, int k) {
+  dali::DeviceWorkspace *ws = reinterpret_cast<dali::DeviceWorkspace *>(pipe_handle->ws);
+  if (ws->OutputIsType<dali::CPUBackend>(n)) {
+    return daliOutputSampleDataHelper<dali::CPUBackend>(ws, n, k);
+  } else {
+    return daliOutputSampleDataHelper<dali::GPUBackend>(ws, n, k);
+  }
+}
+
+cudaEvent_t daliAcquireOutputAsync(daliPipelineHandle *pipe_handle,
+                                   daliOutputHandle *out_handle) {
+  dali::Pipeline *pipeline = reinterpret_cast<dali::Pipeline *>(pipe_handle->pipe);
+  auto ws = std::make_unique<dali::DeviceWorkspace>();
+  int output_id;
+  cudaEvent_t ready = pipeline->ShareOutputsAsync(ws.get(), &output_id);
+  out_handle->outputs = *pipe_handle;
+  out_handle->outputs.ws = ws.release();
+  out_handle->outputs.batch_size_map = nullptr;
+  out_handle->output_id = output_id;
+  return ready;
+}
+
+void daliAcquireOutput(daliPipelineHandle *pipe_handle, daliOutputHandle *out_handle) {
+  cudaEvent_t ready = daliAcquireOutputAsync(pipe_handle, out_handle);
+  if (ready)
+    CUDA_CALL(cudaEventSynchronize(ready));
+}
+
+void daliReleaseOutputHandle(daliOutputHandle *out_handle, cudaEvent_t consumer_event) {
+  dali::Pipeline *pipeline = reinterpret_cast<dali::Pipeline *>(out_handle->outputs.pipe);
+  auto *ws = reinterpret_cast<dali::DeviceWorkspace *>(out_handle->outputs.ws);
+  DALI_ENFORCE(pipeline != nullptr && ws != nullptr, "Output handle already released");
+  delete ws;
+  out_handle->outputs.ws = nullptr;
+  out_handle->outputs.pipe = nullptr;
+  pipeline->ReleaseOutputs(out_handle->output_id, consumer_event);
+}
+
+void daliReleaseOutputHandleOnStream(daliOutputHandle *out_handle, cudaStream_t consumer_stream) {
+  dali::Pipeline *pipeline = reinterpret_cast<dali::Pipeline *>(out_handle->outputs.pipe);
+  DALI_ENFORCE(pipeline != nullptr, "Output handle already released");
+  auto consumed = dali::CUDAEvent::CreateWithFlags(cudaEventDisableTiming, pipeline->device_id());
+  CUDA_CALL(cudaEventRecord(consumed, consumer_stream));
+  daliReleaseOutputHandle(out_handle, consumed);
+}
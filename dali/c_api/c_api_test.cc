@@ -13,12 +13,16 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 #include "dali/c_api.h"
+#include "dali/core/cuda_event.h"
+#include "dali/core/cuda_stream.h"
 #include "dali/pipeline/data/buffer.h"
 #include "dali/pipeline/data/tensor_list.h"
 #include "dali/pipeline/data/views.h"
@@ -628,6 +632,71 @@ TYPED_TEST(CApiTest, TestExecutorMeta) {
   daliDeletePipeline(&handle);
 }
 
+TYPED_TEST(CApiTest, TestExecutorTimingMeta) {
+  auto pipe_ptr = GetTestPipeline<TypeParam>(true, this->output_device_);
+  auto serialized = pipe_ptr->SerializeToProtobuf();
+
+  pipe_ptr.reset();
+  daliPipelineHandle handle;
+  daliCreatePipeline(&handle, serialized.c_str(), serialized.size(), batch_size, num_thread,
+                     device_id, false, prefetch_queue_depth, prefetch_queue_depth,
+                     prefetch_queue_depth, false);
+  daliEnableExecutorTimingStats(&handle, true);
+
+  daliRun(&handle);
+  daliOutput(&handle);
+  CUDA_CALL(cudaDeviceSynchronize());
+
+  size_t N;
+  daliExecutorMetadata *meta;
+  daliGetExecutorMetadata(&handle, &meta, &N);
+  bool has_cpu_stage = false;
+  for (size_t i = 0; i < N; ++i) {
+    auto &meta_entry = meta[i];
+    // only the timing statistics are collected
+    EXPECT_EQ(meta_entry.out_num, 0);
+    EXPECT_GT(meta_entry.iterations, 0);
+    EXPECT_EQ(meta_entry.samples, meta_entry.iterations * batch_size);
+    EXPECT_LE(meta_entry.max_time, meta_entry.total_time);
+    if (std::string(meta_entry.operator_name) == "STAGE_CPU")
+      has_cpu_stage = true;
+  }
+  EXPECT_TRUE(has_cpu_stage);
+  daliFreeExecutorMetadata(meta, N);
+  daliDeletePipeline(&handle);
+}
+
+TYPED_TEST(CApiTest, TestPipelineHealth) {
+  auto pipe_ptr = GetTestPipeline<TypeParam>(true, this->output_device_);
+  auto serialized = pipe_ptr->SerializeToProtobuf();
+
+  pipe_ptr.reset();
+  daliPipelineHandle handle;
+  daliCreatePipeline(&handle, serialized.c_str(), serialized.size(), batch_size, num_thread,
+                     device_id, false, prefetch_queue_depth, prefetch_queue_depth,
+                     prefetch_queue_depth, false);
+
+  daliRun(&handle);
+  daliOutput(&handle);
+  CUDA_CALL(cudaDeviceSynchronize());
+
+  daliPipelineHealth health;
+  daliGetPipelineHealth(&handle, &health);
+  for (int stage = 0; stage < 3; stage++) {
+    EXPECT_EQ(health.stage_iterations[stage], 1);
+    EXPECT_EQ(health.queue_capacity[stage], prefetch_queue_depth);
+    EXPECT_EQ(health.queue_occupancy[stage], 0);
+  }
+  EXPECT_EQ(health.outputs, 1);
+  EXPECT_EQ(health.thread_pool_threads, num_thread);
+
+  char *text = daliGetPipelineHealthPrometheus(&handle, "pipeline=\"test\"");
+  EXPECT_NE(std::string(text).find("dali_outputs_total{pipeline=\"test\"} 1\n"),
+            std::string::npos);
+  free(text);
+  daliDeletePipeline(&handle);
+}
+
 TYPED_TEST(CApiTest, UseCopyKernel) {
   TensorListShape<> input_shape = {{37, 23, 3}, {12, 22, 3}, {42, 42, 3}, {8, 8, 3},
                                    {64, 32, 3}, {32, 64, 3}, {20, 20, 3}, {64, 64, 3},
@@ -795,6 +864,157 @@ TYPED_TEST(CApiTest, ForceNoCopy) {
 }
 
 
+TYPED_TEST(CApiTest, ExternalSourceDoneEvent) {
+  TensorListShape<> input_shape = {{37, 23, 3}, {12, 22, 3}, {42, 42, 3}, {8, 8, 3},
+                                   {64, 32, 3}, {32, 64, 3}, {20, 20, 3}, {64, 64, 3},
+                                   {10, 10, 3}, {60, 50, 3}, {10, 15, 3}, {48, 48, 3}};
+  auto num_elems = input_shape.num_elements();
+
+  auto input_cpu = AllocBuffer<CPUBackend>(num_elems * sizeof(uint8_t), false);
+  auto input = AllocBuffer<TypeParam>(num_elems * sizeof(uint8_t), false);
+  auto reference = AllocBuffer<TypeParam>(num_elems * sizeof(uint8_t), false);
+  TensorList<TypeParam> reference_wrapper;
+
+  auto device = backend_to_device_type<TypeParam>::value;
+  auto pipe_ptr = GetExternalSourcePipeline(false, GetDeviceStr(device));
+  auto serialized = pipe_ptr->SerializeToProtobuf();
+
+  pipe_ptr->Build();
+
+  daliPipelineHandle handle;
+  daliCreatePipeline(&handle, serialized.c_str(), serialized.size(), batch_size, num_thread,
+                     device_id, false, prefetch_queue_depth, prefetch_queue_depth,
+                     prefetch_queue_depth, false);
+
+  CUDAStream stream = CUDAStream::Create(true);
+  CUDAEvent done_event = CUDAEvent::Create();
+  for (int i = 0; i < prefetch_queue_depth; i++) {
+    SequentialFill(TensorListView<StorageCPU, uint8_t>(input_cpu.get(), input_shape), 42 * i);
+    // Unnecessary copy in case of CPUBackend, makes the code generic across Backends
+    MemCopy(input.get(), input_cpu.get(), num_elems, stream);
+    daliSetExternalInputAsyncWithEvent(&handle, input_name.c_str(), device, input.get(),
+                                       dali_data_type_t::DALI_UINT8, input_shape.data(),
+                                       input_shape.sample_dim(), nullptr, stream, done_event,
+                                       DALI_ext_default);
+    MemCopy(reference.get(), input_cpu.get(), num_elems, stream);
+    reference_wrapper.ShareData(std::static_pointer_cast<void>(reference), num_elems,
+                                input_shape, DALI_UINT8);
+    pipe_ptr->SetExternalInput(input_name, reference_wrapper, stream, true);
+    // once the event completes, the input buffer can be reused for the next batch
+    CUDA_CALL(cudaEventSynchronize(done_event));
+  }
+
+  for (int i = 0; i < prefetch_queue_depth; i++) {
+    pipe_ptr->RunCPU();
+    pipe_ptr->RunGPU();
+  }
+  daliPrefetchUniform(&handle, prefetch_queue_depth);
+
+  for (int i = 0; i < prefetch_queue_depth; i++) {
+    ComparePipelinesOutputs<TypeParam>(handle, *pipe_ptr);
+  }
+  daliDeletePipeline(&handle);
+}
+
+
+TYPED_TEST(CApiTest, ExternalSourceDoneEventNoCopyFail) {
+  TensorListShape<> input_shape = {{37, 23, 3}, {12, 22, 3}, {42, 42, 3}, {8, 8, 3},
+                                   {64, 32, 3}, {32, 64, 3}, {20, 20, 3}, {64, 64, 3},
+                                   {10, 10, 3}, {60, 50, 3}, {10, 15, 3}, {48, 48, 3}};
+  auto num_elems = input_shape.num_elements();
+  auto input = AllocBuffer<TypeParam>(num_elems * sizeof(uint8_t), false);
+
+  auto device = backend_to_device_type<TypeParam>::value;
+  auto pipe_ptr = GetExternalSourcePipeline(false, GetDeviceStr(device));
+  auto serialized = pipe_ptr->SerializeToProtobuf();
+
+  daliPipelineHandle handle;
+  daliCreatePipeline(&handle, serialized.c_str(), serialized.size(), batch_size, num_thread,
+                     device_id, false, prefetch_queue_depth, prefetch_queue_depth,
+                     prefetch_queue_depth, false);
+
+  // the memory passed without a copy is used until the outputs are consumed,
+  // so there's no point at which the completion event could be recorded
+  CUDAEvent done_event = CUDAEvent::Create();
+  ASSERT_THROW(daliSetExternalInputAsyncWithEvent(
+                    &handle, input_name.c_str(), device, input.get(),
+                    dali_data_type_t::DALI_UINT8, input_shape.data(), input_shape.sample_dim(),
+                    nullptr, cuda_stream, done_event, DALI_ext_force_no_copy),
+               std::runtime_error);
+  daliDeletePipeline(&handle);
+}
+
+
+TYPED_TEST(CApiTest, RequestBatcher) {
+  TensorListShape<> input_shape = {{37, 23, 3}, {12, 22, 3}, {42, 42, 3}, {8, 8, 3},
+                                   {64, 32, 3}, {32, 64, 3}, {20, 20, 3}, {64, 64, 3},
+                                   {10, 10, 3}, {60, 50, 3}, {10, 15, 3}, {48, 48, 3},
+                                   {16, 24, 3}, {24, 16, 3}};
+  int num_requests = input_shape.num_samples();
+  ASSERT_GT(num_requests, batch_size);
+  auto num_elems = input_shape.num_elements();
+
+  auto input_cpu = AllocBuffer<CPUBackend>(num_elems * sizeof(uint8_t), false);
+  auto input = AllocBuffer<TypeParam>(num_elems * sizeof(uint8_t), false);
+  SequentialFill(TensorListView<StorageCPU, uint8_t>(input_cpu.get(), input_shape), 42);
+  // Unnecessary copy in case of CPUBackend, makes the code generic across Backends
+  MemCopy(input.get(), input_cpu.get(), num_elems, cuda_stream);
+  CUDA_CALL(cudaStreamSynchronize(cuda_stream));
+
+  auto device = backend_to_device_type<TypeParam>::value;
+  auto pipe_ptr = GetExternalSourcePipeline(false, GetDeviceStr(device));
+  auto serialized = pipe_ptr->SerializeToProtobuf();
+  pipe_ptr->Build();
+
+  daliPipelineHandle handle;
+  daliCreatePipeline(&handle, serialized.c_str(), serialized.size(), batch_size, num_thread,
+                     device_id, false, prefetch_queue_depth, prefetch_queue_depth,
+                     prefetch_queue_depth, false);
+  daliRequestBatcherHandle batcher;
+  const char *input_names[] = { input_name.c_str() };
+  daliCreateRequestBatcher(&batcher, &handle, input_names, 1, 0);
+
+  EXPECT_EQ(daliRunRequestBatch(&batcher, cuda_stream, DALI_ext_force_sync), 0);
+
+  int64_t offset = 0;
+  for (int i = 0; i < num_requests; i++) {
+    auto sample_shape = input_shape.tensor_shape_span(i);
+    daliAddRequestSample(&batcher, 1000 + i, input_name.c_str(), device, input.get() + offset,
+                         DALI_UINT8, sample_shape.data(), sample_shape.size(), "HWC");
+    offset += input_shape.tensor_size(i);
+  }
+
+  // the requests exceeding the max batch size go to the next batch
+  std::vector<std::pair<int, int>> ranges = {{0, batch_size}, {batch_size, num_requests}};
+  offset = 0;
+  for (auto range : ranges) {
+    int n = range.second - range.first;
+    ASSERT_EQ(daliRunRequestBatch(&batcher, cuda_stream, DALI_ext_force_sync), n);
+
+    auto range_shape = sample_range(input_shape, range.first, range.second);
+    TensorList<TypeParam> input_wrapper;
+    input_wrapper.ShareData(std::shared_ptr<void>(input, input.get() + offset),
+                            range_shape.num_elements(), range_shape, DALI_UINT8);
+    input_wrapper.SetLayout("HWC");
+    offset += range_shape.num_elements();
+    pipe_ptr->SetExternalInput(input_name, input_wrapper, cuda_stream, true);
+    pipe_ptr->RunCPU();
+    pipe_ptr->RunGPU();
+    ComparePipelinesOutputs<TypeParam>(handle, *pipe_ptr, DALI_ext_default, n);
+
+    std::vector<int64_t> request_ids(batch_size);
+    ASSERT_EQ(daliPopRequestBatch(&batcher, request_ids.data()), n);
+    for (int k = 0; k < n; k++) {
+      EXPECT_EQ(request_ids[k], 1000 + range.first + k);
+      EXPECT_NE(daliOutputSampleData(&handle, 0, k), nullptr);
+    }
+  }
+
+  daliDeleteRequestBatcher(&batcher);
+  daliDeletePipeline(&handle);
+}
+
+
 template <typename Backend>
 void Clear(Tensor<Backend>& tensor);
 
@@ -920,6 +1140,239 @@ TYPED_TEST(CApiTest, daliOutputCopySamples) {
   daliDeletePipeline(&handle);
 }
 
+TYPED_TEST(CApiTest, daliOutputCopySamplesWithEvent) {
+  auto pipe_ptr = GetTestPipeline<TypeParam>(true, this->output_device_);
+  auto serialized = pipe_ptr->SerializeToProtobuf();
+
+  daliPipelineHandle handle;
+  daliDeserializeDefault(&handle, serialized.c_str(), serialized.size());
+
+  daliRun(&handle);
+  daliOutput(&handle);
+  CUDAStream stream = CUDAStream::Create(true);
+  CUDAEvent done_event = CUDAEvent::Create();
+  const int num_output = daliGetNumOutput(&handle);
+  for (int out_idx = 0; out_idx < num_output; out_idx++) {
+    DALIDataType type = static_cast<DALIDataType>(daliTypeAt(&handle, out_idx));
+    auto type_info = dali::TypeTable::GetTypeInfo(type);
+    int64_t out_size = daliNumElements(&handle, out_idx);
+    Tensor<TypeParam> output1;
+    output1.Resize({out_size}, type_info.id());
+    daliOutputCopy(&handle, output1.raw_mutable_data(), out_idx,
+                   backend_to_device_type<TypeParam>::value, 0, DALI_ext_force_sync);
+    // Unnecessary copy in case of CPUBackend, makes the code generic across Backends
+    Tensor<CPUBackend> output1_cpu;
+    output1_cpu.Copy(output1, cuda_stream);
+    CUDA_CALL(cudaStreamSynchronize(cuda_stream));
+
+    Tensor<TypeParam> output2;
+    output2.Resize({out_size}, type_info.id());
+    Clear(output2);
+    std::vector<void*> sample_dsts(batch_size);
+    int64_t offset = 0;
+    for (int sample_idx = 0; sample_idx < batch_size; sample_idx++) {
+      sample_dsts[sample_idx] = static_cast<uint8_t*>(output2.raw_mutable_data()) + offset;
+      auto *shape = daliShapeAtSample(&handle, out_idx, sample_idx);
+      int64_t sample_size = 1;
+      for (int d = 0; shape[d] > 0; d++) {
+        sample_size *= shape[d];
+      }
+      free(shape);
+      offset += sample_size * type_info.size();
+    }
+    daliOutputCopySamplesWithEvent(&handle, sample_dsts.data(), out_idx,
+                                   backend_to_device_type<TypeParam>::value, stream, done_event,
+                                   DALI_ext_default);
+    // the data is ready once the event completes, without synchronizing the stream
+    CUDA_CALL(cudaEventSynchronize(done_event));
+
+    // Unnecessary copy in case of CPUBackend, makes the code generic across Backends
+    Tensor<CPUBackend> output2_cpu;
+    output2_cpu.Copy(output2, cuda_stream);
+    CUDA_CALL(cudaStreamSynchronize(cuda_stream));
+    Check(view<uint8_t>(output1_cpu), view<uint8_t>(output2_cpu));
+  }
+  daliDeletePipeline(&handle);
+}
+
+TYPED_TEST(CApiTest, ShareOutputAsync) {
+  auto pipe_ptr = GetTestPipeline<TypeParam>(true, this->output_device_);
+  auto serialized = pipe_ptr->SerializeToProtobuf();
+
+  pipe_ptr->Build();
+  for (int i = 0; i < prefetch_queue_depth; i++) {
+    pipe_ptr->RunCPU();
+    pipe_ptr->RunGPU();
+  }
+
+  daliPipelineHandle handle;
+  daliCreatePipeline(&handle, serialized.c_str(), serialized.size(), batch_size, num_thread,
+                     device_id, false, prefetch_queue_depth, prefetch_queue_depth,
+                     prefetch_queue_depth, false);
+  daliPrefetchUniform(&handle, prefetch_queue_depth);
+
+  auto stream = CUDAStream::Create(true);
+  auto consumed = CUDAEvent::Create();
+  dali::DeviceWorkspace ws;
+  for (int i = 0; i < prefetch_queue_depth + 2; i++) {
+    if (i >= prefetch_queue_depth) {
+      daliRun(&handle);
+      pipe_ptr->RunCPU();
+      pipe_ptr->RunGPU();
+    }
+    pipe_ptr->Outputs(&ws);
+    TensorList<CPUBackend> ref;
+    ref.Copy(ws.Output<TypeParam>(0), cuda_stream);
+    CUDA_CALL(cudaStreamSynchronize(cuda_stream));
+
+    cudaEvent_t ready = daliShareOutputAsync(&handle);
+    EXPECT_EQ(ready != nullptr, (std::is_same<TypeParam, GPUBackend>::value));
+    if (ready)
+      CUDA_CALL(cudaStreamWaitEvent(stream, ready, 0));
+
+    auto num_elems = ref.shape().num_elements();
+    auto cpu_buf = AllocBuffer<CPUBackend>(num_elems * sizeof(uint8_t), true);
+    daliOutputCopy(&handle, cpu_buf.get(), 0, CPU, stream, 0);
+    CUDA_CALL(cudaEventRecord(consumed, stream));
+    // the copy may still be running - the pipeline must not overwrite the buffers before it ends
+    daliOutputReleaseWithEvent(&handle, consumed);
+
+    CUDA_CALL(cudaStreamSynchronize(stream));
+    Check(view<uint8_t>(ref), TensorListView<StorageCPU, uint8_t>(cpu_buf.get(), ref.shape()));
+  }
+  daliDeletePipeline(&handle);
+}
+
+TYPED_TEST(CApiTest, OutputHandles) {
+  auto pipe_ptr = GetTestPipeline<TypeParam>(true, this->output_device_);
+  auto serialized = pipe_ptr->SerializeToProtobuf();
+
+  int num_iters = prefetch_queue_depth + 1;
+  pipe_ptr->Build();
+  std::vector<TensorList<CPUBackend>> refs(num_iters);
+  dali::DeviceWorkspace ws;
+  for (int i = 0; i < num_iters; i++) {
+    pipe_ptr->RunCPU();
+    pipe_ptr->RunGPU();
+    pipe_ptr->Outputs(&ws);
+    refs[i].Copy(ws.Output<TypeParam>(0), cuda_stream);
+  }
+  CUDA_CALL(cudaStreamSynchronize(cuda_stream));
+
+  daliPipelineHandle handle;
+  daliCreatePipeline(&handle, serialized.c_str(), serialized.size(), batch_size, num_thread,
+                     device_id, false, prefetch_queue_depth, prefetch_queue_depth,
+                     prefetch_queue_depth, false);
+  daliPrefetchUniform(&handle, prefetch_queue_depth);
+
+  auto check_output = [&](daliOutputHandle &out, const TensorList<CPUBackend> &ref) {
+    auto num_elems = ref.shape().num_elements();
+    auto cpu_buf = AllocBuffer<CPUBackend>(num_elems * sizeof(uint8_t), true);
+    daliOutputCopy(&out.outputs, cpu_buf.get(), 0, CPU, cuda_stream, DALI_ext_force_sync);
+    Check(view<const uint8_t>(ref),
+          TensorListView<StorageCPU, uint8_t>(cpu_buf.get(), ref.shape()));
+  };
+
+  // all the prefetched outputs can be held at the same time
+  std::vector<daliOutputHandle> outs(prefetch_queue_depth);
+  for (int i = 0; i < prefetch_queue_depth; i++)
+    daliAcquireOutput(&handle, &outs[i]);
+  for (int i = 0; i < prefetch_queue_depth; i++) {
+    EXPECT_NE(outs[i].outputs.ws, handle.ws);
+    check_output(outs[i], refs[i]);
+  }
+
+  // releasing the newest one first, the older ones stay valid
+  for (int i = prefetch_queue_depth - 1; i >= 0; i--) {
+    daliReleaseOutputHandle(&outs[i], nullptr);
+    EXPECT_EQ(outs[i].outputs.ws, nullptr);
+    for (int j = 0; j < i; j++)
+      check_output(outs[j], refs[j]);
+  }
+
+  daliRun(&handle);
+  daliOutputHandle last;
+  daliAcquireOutput(&handle, &last);
+  check_output(last, refs[prefetch_queue_depth]);
+  daliReleaseOutputHandle(&last, nullptr);
+  EXPECT_THROW(daliReleaseOutputHandle(&last, nullptr), std::exception);
+
+  daliDeletePipeline(&handle);
+}
+
+TYPED_TEST(CApiTest, ExternalOutputBuffers) {
+  if (!std::is_same<TypeParam, GPUBackend>::value)
+    GTEST_SKIP() << "Only the GPU outputs can be written to external buffers";
+  auto pipe_ptr = GetTestPipeline<TypeParam>(true, this->output_device_);
+  auto serialized = pipe_ptr->SerializeToProtobuf();
+
+  int num_iters = 2 * prefetch_queue_depth + 2;
+  pipe_ptr->Build();
+  std::vector<TensorList<CPUBackend>> refs(num_iters);
+  dali::DeviceWorkspace ws;
+  for (int i = 0; i < num_iters; i++) {
+    pipe_ptr->RunCPU();
+    pipe_ptr->RunGPU();
+    pipe_ptr->Outputs(&ws);
+    refs[i].Copy(ws.Output<TypeParam>(0), cuda_stream);
+  }
+  CUDA_CALL(cudaStreamSynchronize(cuda_stream));
+
+  daliPipelineHandle handle;
+  daliCreatePipeline(&handle, serialized.c_str(), serialized.size(), batch_size, num_thread,
+                     device_id, false, prefetch_queue_depth, prefetch_queue_depth,
+                     prefetch_queue_depth, false);
+
+  size_t bytes = refs[0].shape().num_elements() * sizeof(uint8_t);
+  std::vector<std::shared_ptr<uint8_t>> buffers;
+  std::vector<void *> ptrs;
+  std::vector<size_t> sizes(prefetch_queue_depth, bytes);
+  for (int i = 0; i < prefetch_queue_depth; i++) {
+    buffers.push_back(AllocBuffer<GPUBackend>(bytes, false));
+    ptrs.push_back(buffers.back().get());
+  }
+  // one buffer per output slot is needed
+  EXPECT_THROW(daliSetExternalOutputBuffers(&handle, 0, ptrs.data(), sizes.data(), 1),
+               std::exception);
+  daliSetExternalOutputBuffers(&handle, 0, ptrs.data(), sizes.data(), prefetch_queue_depth);
+  daliPrefetchUniform(&handle, prefetch_queue_depth);
+
+  auto check_output = [&](const TensorList<CPUBackend> &ref) {
+    auto cpu_buf = AllocBuffer<CPUBackend>(bytes, true);
+    daliOutputCopy(&handle, cpu_buf.get(), 0, CPU, cuda_stream, DALI_ext_force_sync);
+    Check(view<const uint8_t>(ref),
+          TensorListView<StorageCPU, uint8_t>(cpu_buf.get(), ref.shape()));
+  };
+  auto in_buffers = [&]() {
+    const void *data = daliOutputSampleData(&handle, 0, 0);
+    return std::find(ptrs.begin(), ptrs.end(), data) != ptrs.end();
+  };
+
+  int iter = 0;
+  for (; iter < prefetch_queue_depth + 1; iter++) {
+    if (iter >= prefetch_queue_depth)
+      daliRun(&handle);
+    daliShareOutput(&handle);
+    EXPECT_TRUE(in_buffers());
+    check_output(refs[iter]);
+    daliOutputRelease(&handle);
+  }
+
+  // the outputs don't fit anymore - they're stored in DALI's memory
+  std::vector<size_t> small_sizes(prefetch_queue_depth, bytes - 1);
+  daliSetExternalOutputBuffers(&handle, 0, ptrs.data(), small_sizes.data(), prefetch_queue_depth);
+  for (; iter < num_iters; iter++) {
+    daliRun(&handle);
+    daliShareOutput(&handle);
+    // the iterations scheduled before the call still use the buffers
+    if (iter >= 2 * prefetch_queue_depth)
+      EXPECT_FALSE(in_buffers());
+    check_output(refs[iter]);
+    daliOutputRelease(&handle);
+  }
+  daliDeletePipeline(&handle);
+}
+
 TYPED_TEST(CApiTest, CpuOnlyTest) {
   dali::Pipeline pipe(1, 1, dali::CPU_ONLY_DEVICE_ID);
   pipe.AddExternalInput("dummy");
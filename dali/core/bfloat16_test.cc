@@ -0,0 +1,90 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include "dali/core/bfloat16.h"
+#include "dali/core/convert.h"
+
+namespace dali {
+
+TEST(BFloat16, Construction) {
+  bfloat16 a = {};
+  EXPECT_EQ(a.bits, 0);
+  bfloat16 b = 42;
+  EXPECT_EQ(static_cast<float>(b), 42.0f);
+  bfloat16 c = -5.5f;
+  EXPECT_EQ(static_cast<float>(c), -5.5f);
+  bfloat16 d = 0.25;
+  EXPECT_EQ(static_cast<float>(d), 0.25f);
+  EXPECT_EQ(static_cast<float>(-d), -0.25f);
+  EXPECT_EQ(bfloat16::FromBits(0x3f80).bits, bfloat16(1.0f).bits);
+}
+
+TEST(BFloat16, Rounding) {
+  // 1 + 2^-8 is exactly halfway between 1 and the next bfloat16 - ties to even gives 1
+  EXPECT_EQ(static_cast<float>(bfloat16(1.0f + std::ldexp(1.0f, -8))), 1.0f);
+  // ...and 1 + 3 * 2^-8 is between two values, the even one being 1 + 2^-6
+  EXPECT_EQ(static_cast<float>(bfloat16(1.0f + 3 * std::ldexp(1.0f, -8))),
+            1.0f + std::ldexp(1.0f, -6));
+  EXPECT_EQ(static_cast<float>(bfloat16(1.0f + std::ldexp(1.0f, -8) + std::ldexp(1.0f, -20))),
+            1.0f + std::ldexp(1.0f, -7));
+  EXPECT_EQ(static_cast<float>(bfloat16(1.0f + std::ldexp(1.0f, -9))), 1.0f);
+}
+
+TEST(BFloat16, SpecialValues) {
+  float inf = std::numeric_limits<float>::infinity();
+  EXPECT_EQ(static_cast<float>(bfloat16(inf)), inf);
+  EXPECT_EQ(static_cast<float>(bfloat16(-inf)), -inf);
+  EXPECT_TRUE(std::isnan(static_cast<float>(bfloat16(std::nanf("")))));
+  // a NaN with only the low mantissa bits set must not become infinity
+  uint32_t snan_bits = 0x7f800001u;
+  float snan;
+  std::memcpy(&snan, &snan_bits, sizeof(snan));
+  EXPECT_TRUE(std::isnan(static_cast<float>(bfloat16(snan))));
+  // the largest float is rounded to infinity, but clamped to the largest finite bfloat16
+  float fmax = std::numeric_limits<float>::max();
+  EXPECT_EQ(static_cast<float>(bfloat16(fmax)), inf);
+  EXPECT_EQ(clamp<bfloat16>(fmax).bits, 0x7f7f);
+  EXPECT_EQ(clamp<bfloat16>(-fmax).bits, 0xff7f);
+}
+
+TEST(BFloat16, Arithmetic) {
+  bfloat16 a = 3, b = 0.5f;
+  EXPECT_EQ(a + b, 3.5f);
+  EXPECT_EQ(a * b, 1.5f);
+  EXPECT_TRUE(b < a);
+  a += 1;
+  EXPECT_EQ(static_cast<float>(a), 4.0f);
+  a *= b;
+  EXPECT_EQ(static_cast<float>(a), 2.0f);
+}
+
+TEST(BFloat16, Convert) {
+  EXPECT_EQ(static_cast<float>(Convert<bfloat16>(255)), 255.0f);
+  EXPECT_EQ(static_cast<float>(ConvertNorm<bfloat16>(uint8_t(255))), 1.0f);
+  EXPECT_EQ(ConvertSat<uint8_t>(bfloat16(300.0f)), 255);
+  EXPECT_EQ(ConvertSat<int8_t>(bfloat16(-300.0f)), -128);
+  EXPECT_EQ(ConvertSat<int16_t>(bfloat16(-2.5f)), -3);
+  EXPECT_EQ(ConvertSatNorm<uint8_t>(bfloat16(1.0f)), 255);
+  EXPECT_EQ(ConvertSat<float>(bfloat16(0.75f)), 0.75f);
+  EXPECT_EQ(static_cast<float>(clamp<float16>(bfloat16(1e+10f))), 65504.0f);
+  EXPECT_EQ(static_cast<float>(Convert<bfloat16>(float16(0.5f))), 0.5f);
+  EXPECT_EQ(static_cast<float>(clamp<bfloat16>(1e+40)), 3.38953139e+38f);
+  EXPECT_EQ(static_cast<float>(ConvertSat<float16>(bfloat16(0.5f))), 0.5f);
+}
+
+}  // namespace dali
@@ -15,6 +15,7 @@
 #include <cassert>
 #include <mutex>
 #include <utility>
+#include <vector>
 #include "dali/core/cuda_event_pool.h"
 #include "dali/core/cuda_error.h"
 
@@ -90,4 +91,51 @@ CUDAEventPool &CUDAEventPool::instance() {
   return instance;
 }
 
+namespace {
+
+struct ThreadEventCache {
+  ~ThreadEventCache() {
+    for (int dev = 0; dev < static_cast<int>(dev_events.size()); dev++) {
+      for (auto &event : dev_events[dev])
+        CUDAEventPool::instance().Put(std::move(event), dev);
+    }
+  }
+
+  std::vector<CUDAEvent> &events(int device_id) {
+    if (device_id >= static_cast<int>(dev_events.size()))
+      dev_events.resize(device_id + 1);
+    return dev_events[device_id];
+  }
+
+  std::vector<std::vector<CUDAEvent>> dev_events;
+};
+
+thread_local ThreadEventCache thread_event_cache;
+
+}  // namespace
+
+CUDAEvent CUDAEventCache::Get(int device_id) {
+  if (device_id < 0)
+    CUDA_CALL(cudaGetDevice(&device_id));
+  auto &events = thread_event_cache.events(device_id);
+  if (events.empty())
+    return CUDAEventPool::instance().Get(device_id);
+  CUDAEvent ev = std::move(events.back());
+  events.pop_back();
+  return ev;
+}
+
+void CUDAEventCache::Put(CUDAEvent &&event, int device_id) {
+  if (device_id < 0)
+    CUDA_CALL(cudaGetDevice(&device_id));
+  auto &events = thread_event_cache.events(device_id);
+  if (static_cast<int>(events.size()) >= kMaxCachedPerDevice) {
+    CUDAEventPool::instance().Put(std::move(event), device_id);
+    return;
+  }
+  if (events.capacity() == 0)
+    events.reserve(kMaxCachedPerDevice);
+  events.push_back(std::move(event));
+}
+
 }  // namespace dali
@@ -16,6 +16,7 @@
 #include <cuda_runtime.h>
 #include <random>
 #include <thread>
+#include <utility>
 #include <vector>
 #include "dali/core/cuda_error.h"
 #include "dali/core/cuda_event_pool.h"
@@ -58,5 +59,59 @@ TEST(EventPoolTest, PutGet) {
     t.join();
 }
 
+TEST(EventPoolTest, ThreadCache) {
+  int devices = 0;
+  (void)cudaGetDeviceCount(&devices);
+  if (devices == 0) {
+    (void)cudaGetLastError();  // No CUDA devices - we don't care about the error
+    GTEST_SKIP();
+  }
+
+  for (int device_id = 0; device_id < devices; device_id++) {
+    CUDAEvent event = CUDAEventCache::Get(device_id);
+    cudaEvent_t handle = event;
+    CUDAEventCache::Put(std::move(event), device_id);
+    // the event just put back is the first one to be reused by this thread
+    event = CUDAEventCache::Get(device_id);
+    EXPECT_EQ(handle, static_cast<cudaEvent_t>(event));
+    CUDAEventCache::Put(std::move(event), device_id);
+  }
+
+  vector<CUDAStream> streams;
+  for (int i = 0; i < devices; i++) {
+    streams.push_back(CUDAStream::Create(true, i));
+  }
+
+  vector<std::thread> threads;
+  for (int i = 0; i < 10; i++) {
+    threads.emplace_back([&]() {
+      std::mt19937_64 rng;
+      std::uniform_int_distribution<int> dev_dist(0, devices-1);
+      vector<std::pair<CUDAEvent, int>> events;
+      for (int i = 0; i < 10000; i++) {
+        int device_id = dev_dist(rng);
+        CUDAEvent event = CUDAEventCache::Get(device_id);
+        ASSERT_EQ(cudaSuccess, cudaSetDevice(device_id));
+        ASSERT_EQ(cudaSuccess, cudaEventRecord(event, streams[device_id]));
+        events.emplace_back(std::move(event), device_id);
+        // put back in batches, so that the cache overflows to the shared pool
+        if (events.size() == 2 * CUDAEventCache::kMaxCachedPerDevice * devices) {
+          for (auto &e : events) {
+            ASSERT_EQ(cudaSuccess, cudaEventSynchronize(e.first));
+            CUDAEventCache::Put(std::move(e.first), e.second);
+          }
+          events.clear();
+        }
+      }
+      for (auto &e : events) {
+        ASSERT_EQ(cudaSuccess, cudaEventSynchronize(e.first));
+        CUDAEventCache::Put(std::move(e.first), e.second);
+      }
+    });
+  }
+  for (auto &t : threads)
+    t.join();
+}
+
 }  // namespace test
 }  // namespace dali
@@ -351,6 +351,87 @@ TEST(MMAsyncPool, CrossStreamWithHogs) {
   upstream.check_leaks();
 }
 
+TEST(MMAsyncPool, Stats) {
+  GPUHog hog;
+  hog.init();
+  CUDAStream s1 = CUDAStream::Create(true);
+  CUDAStream s2 = CUDAStream::Create(true);
+  test::test_device_resource upstream;
+  {
+    async_pool_resource<memory_kind::device> pool(&upstream);
+    pool_stats stats;
+    ASSERT_TRUE(get_pool_stats(&pool, stats));
+    EXPECT_EQ(stats.reserved, 0u);
+    EXPECT_EQ(stats.in_use, 0u);
+
+    const size_t size = 1 << 20;
+    // the first upstream block is 2 MiB - both allocations use it up
+    void *p1 = pool.allocate_async(size, 256, s1);
+    void *p2 = pool.allocate_async(size, 256, s1);
+    ASSERT_TRUE(get_pool_stats(&pool, stats));
+    EXPECT_EQ(stats.in_use, 2 * size);
+    EXPECT_EQ(stats.peak_in_use, 2 * size);
+    EXPECT_GE(stats.reserved, 2 * size);
+    EXPECT_EQ(stats.largest_free_block, 0u);
+    size_t reserved = stats.reserved;
+
+    // keep the stream busy, so that the deallocation remains pending
+    hog.run(s1, 100);
+    pool.deallocate_async(p1, size, 256, s1);
+    ASSERT_TRUE(get_pool_stats(&pool, stats));
+    EXPECT_EQ(stats.in_use, size);
+    EXPECT_EQ(stats.peak_in_use, 2 * size);
+    EXPECT_EQ(stats.pending_free, size);
+    EXPECT_EQ(stats.num_pending_frees, 1u);
+
+    // the pool must wait for s1 and reclaim p1 for use on s2
+    void *p3 = pool.allocate_async(size, 256, s2);
+    ASSERT_TRUE(get_pool_stats(&pool, stats));
+    EXPECT_EQ(stats.in_use, 2 * size);
+    EXPECT_EQ(stats.reserved, reserved);
+    EXPECT_EQ(stats.pending_free, 0u);
+    EXPECT_EQ(stats.num_pending_frees, 0u);
+    EXPECT_EQ(stats.cross_stream_reclaims, 1u);
+    EXPECT_EQ(stats.pending_free_syncs, 1u);
+
+    pool.deallocate_async(p2, size, 256, s2);
+    pool.deallocate_async(p3, size, 256, s2);
+    ASSERT_TRUE(get_pool_stats(&pool, stats));
+    EXPECT_EQ(stats.in_use, 0u);
+    EXPECT_EQ(stats.pending_free, 2 * size);
+    pool.reset_peak();
+    ASSERT_TRUE(get_pool_stats(&pool, stats));
+    EXPECT_EQ(stats.peak_in_use, 0u);
+    CUDA_CALL(cudaStreamSynchronize(s2));
+  }
+  upstream.check_leaks();
+}
+
+TEST(MMAsyncPool, ReleaseUnused) {
+  CUDAStream s1 = CUDAStream::Create(true);
+  test::test_device_resource upstream;
+  {
+    async_pool_resource<memory_kind::device> pool(&upstream);
+    const size_t size = 1 << 20;
+    void *p1 = pool.allocate_async(size, 256, s1);
+    void *p2 = pool.allocate_async(4 * size, 256, s1);
+    pool.deallocate_async(p2, 4 * size, 256, s1);
+    // p1 is still in use, so its upstream block cannot be released
+    EXPECT_GE(pool.release_unused(), 4 * size);
+    pool_stats stats;
+    ASSERT_TRUE(get_pool_stats(&pool, stats));
+    EXPECT_EQ(stats.pending_free, 0u);
+    EXPECT_GE(stats.reserved, size);
+    EXPECT_LT(stats.reserved, 4 * size);
+    EXPECT_EQ(upstream.get_current_size(), stats.reserved);
+
+    pool.deallocate_async(p1, size, 256, s1);
+    EXPECT_GT(release_unused_memory(&pool), 0u);
+    EXPECT_EQ(upstream.get_current_size(), 0u);
+  }
+  upstream.check_leaks();
+}
+
 #if DALI_USE_CUDA_VM_MAP
 
 TEST(MM_VMAsyncPool, MultiThreadedSingleStreamRandom) {
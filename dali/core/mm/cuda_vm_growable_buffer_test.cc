@@ -0,0 +1,68 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/core/mm/cuda_vm_growable_buffer.h"
+#include <gtest/gtest.h>
+#include <utility>
+#include <vector>
+
+#if DALI_USE_CUDA_VM_MAP
+
+namespace dali {
+namespace mm {
+namespace test {
+
+TEST(MMCudaVMGrowableBuffer, GrowInPlace) {
+  if (!cuvm::IsSupported())
+    GTEST_SKIP() << "CUDA Virtual Memory API not supported on this machine";
+
+  size_t grain = cuvm::GetAddressGranularity();
+  cuda_vm_growable_buffer buf(16 * grain);
+  EXPECT_GE(buf.max_size(), 16 * grain);
+  EXPECT_EQ(buf.capacity(), 0u);
+  void *ptr = buf.data();
+  ASSERT_NE(ptr, nullptr);
+
+  ASSERT_TRUE(buf.reserve(100));
+  EXPECT_EQ(buf.capacity(), grain);
+  CUDA_CALL(cudaMemset(ptr, 1, grain));
+
+  ASSERT_TRUE(buf.reserve(3 * grain + 1));
+  EXPECT_EQ(buf.capacity(), 4 * grain);
+  EXPECT_EQ(buf.data(), ptr);
+  CUDA_CALL(cudaMemset(static_cast<char *>(ptr) + grain, 2, 3 * grain));
+
+  std::vector<char> host(4 * grain);
+  CUDA_CALL(cudaMemcpy(host.data(), ptr, host.size(), cudaMemcpyDeviceToHost));
+  for (size_t i = 0; i < host.size(); i += 997)
+    ASSERT_EQ(host[i], i < grain ? 1 : 2) << " at offset " << i;
+
+  // too large - nothing changes
+  EXPECT_FALSE(buf.reserve(buf.max_size() + 1));
+  EXPECT_EQ(buf.capacity(), 4 * grain);
+
+  cuda_vm_growable_buffer moved = std::move(buf);
+  EXPECT_EQ(moved.data(), ptr);
+  EXPECT_EQ(moved.capacity(), 4 * grain);
+  EXPECT_EQ(buf.data(), nullptr);
+  EXPECT_EQ(buf.capacity(), 0u);
+  moved.reset();
+  EXPECT_EQ(moved.data(), nullptr);
+}
+
+}  // namespace test
+}  // namespace mm
+}  // namespace dali
+
+#endif  // DALI_USE_CUDA_VM_MAP
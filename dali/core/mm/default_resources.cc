@@ -12,16 +12,24 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <cstdlib>
 #include <stdexcept>
 #include <cstring>
+#include <map>
+#include <utility>
+#include <vector>
 #include "dali/core/mm/default_resources.h"
 #include "dali/core/error_handling.h"
 #include "dali/core/format.h"
 #include "dali/core/mm/malloc_resource.h"
+#include "dali/core/mm/numa_resource.h"
+#include "dali/core/mm/hugepage_resource.h"
 #include "dali/core/device_guard.h"
 #include "dali/core/mm/async_pool.h"
 #include "dali/core/mm/composite_resource.h"
 #include "dali/core/mm/cuda_vm_resource.h"
+#include "dali/core/mm/releasable_resource.h"
 
 namespace dali {
 namespace mm {
@@ -164,6 +172,38 @@ bool UseDeferredDealloc() {
   return value;
 }
 
+/**
+ * @brief Reads a size in bytes, optionally with a k, M or G suffix (binary), from
+ *        an environment variable; returns 0 if it's not set.
+ */
+size_t GetEnvSize(const char *name) {
+  const char *env = std::getenv(name);
+  if (!env)
+    return 0;
+  char *suffix = nullptr;
+  size_t size = strtoull(env, &suffix, 10);
+  switch (*suffix) {
+    case 'k': case 'K':
+      return size << 10;
+    case 'm': case 'M':
+      return size << 20;
+    case 'g': case 'G':
+      return size << 30;
+    case '\0':
+      return size;
+    default:
+      DALI_FAIL(make_string("Invalid size in ", name, ": \"", env, "\""));
+  }
+}
+
+/**
+ * @brief The size of the huge pages backing the pinned memory pool; 0 if they're not used.
+ */
+size_t PinnedHugePageSize() {
+  static size_t value = GetEnvSize("DALI_PINNED_HUGE_PAGE_SIZE");
+  return value;
+}
+
 inline std::shared_ptr<device_async_resource> CreateDefaultDeviceResource() {
   static CUDARTLoader CUDAInit;
   if (!UseDeviceMemoryPool()) {
@@ -199,11 +239,24 @@ inline std::shared_ptr<device_async_resource> CreateDefaultDeviceResource() {
 }
 
 inline std::shared_ptr<pinned_async_resource> CreateDefaultPinnedResource() {
+  // The memory is placed on the NUMA node local to the current device, if it's known
+  // (see numa::SetDeviceNode); otherwise it's just allocated with cudaMallocHost.
   if (!UsePinnedMemoryPool()) {
-    static auto upstream = std::make_shared<mm::pinned_malloc_memory_resource>();
+    static auto upstream = std::make_shared<mm::numa_pinned_memory_resource>();
     return upstream;
   }
-  static auto upstream = std::make_shared<pinned_malloc_memory_resource>();
+  std::shared_ptr<pinned_async_resource> upstream;
+  if (size_t page_size = PinnedHugePageSize()) {
+    // The pool grows by mapping huge pages, registered in large chunks - optionally reserved
+    // up front, so that the pool doesn't need to call cudaHostRegister while running.
+    size_t reserve = GetEnvSize("DALI_PINNED_HUGE_PAGE_RESERVE");
+    static auto hugepage_upstream = std::make_shared<hugepage_pinned_memory_resource>(
+        page_size, std::max(page_size, 256_uz << 20), reserve);
+    upstream = hugepage_upstream;
+  } else {
+    static auto numa_upstream = std::make_shared<numa_pinned_memory_resource>();
+    upstream = numa_upstream;
+  }
   if (UseDeferredDealloc()) {
     using resource_type = mm::async_pool_resource<mm::memory_kind::pinned>;
     auto rsrc = std::make_shared<resource_type>(upstream.get());
@@ -396,5 +449,63 @@ device_async_resource *GetDefaultDeviceResource(int device_id) {
   return ShareDefaultDeviceResourceImpl(device_id).get();
 }
 
+namespace {
+
+struct MemoryReleaseCallbacks {
+  static MemoryReleaseCallbacks &instance() {
+    static MemoryReleaseCallbacks callbacks;
+    return callbacks;
+  }
+
+  // held while the callbacks run, so that they can be safely removed
+  std::mutex mtx;
+  std::map<int, MemoryReleaseCallback> callbacks;
+  int next_id = 0;
+};
+
+}  // namespace
+
+DLL_PUBLIC int AddMemoryReleaseCallback(MemoryReleaseCallback callback) {
+  auto &cbs = MemoryReleaseCallbacks::instance();
+  std::lock_guard<std::mutex> lock(cbs.mtx);
+  int id = cbs.next_id++;
+  cbs.callbacks.emplace(id, std::move(callback));
+  return id;
+}
+
+DLL_PUBLIC void RemoveMemoryReleaseCallback(int callback_id) {
+  auto &cbs = MemoryReleaseCallbacks::instance();
+  std::lock_guard<std::mutex> lock(cbs.mtx);
+  cbs.callbacks.erase(callback_id);
+}
+
+DLL_PUBLIC size_t ReleaseUnusedMemory(bool release_caches) {
+  size_t released = 0;
+  if (release_caches) {
+    auto &cbs = MemoryReleaseCallbacks::instance();
+    std::lock_guard<std::mutex> lock(cbs.mtx);
+    for (auto &cb : cbs.callbacks)
+      released += cb.second();
+  }
+
+  // don't keep the lock while flushing the pools - it would block the creation of other resources
+  std::vector<std::shared_ptr<device_async_resource>> device;
+  std::shared_ptr<pinned_async_resource> pinned;
+  {
+    std::lock_guard<std::mutex> lock(g_resources.mtx);
+    device = g_resources.device;
+    pinned = g_resources.pinned_async;
+  }
+  for (int dev = 0; dev < static_cast<int>(device.size()); dev++) {
+    if (device[dev]) {
+      DeviceGuard dg(dev);
+      released += release_unused_memory(device[dev].get());
+    }
+  }
+  if (pinned)
+    released += release_unused_memory(pinned.get());
+  return released;
+}
+
 }  // namespace mm
 }  // namespace dali
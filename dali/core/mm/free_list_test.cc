@@ -229,6 +229,19 @@ TEST(MMCoalescingFreeTree, Contains) {
   EXPECT_FALSE(fl.contains(a + 64, a + 67));
 }
 
+TEST(MMCoalescingFreeTree, LargestBlock) {
+  coalescing_free_tree fl;
+  char a alignas(16)[4000];
+  EXPECT_EQ(fl.largest_block(), 0u);
+  fl.put(a, 100);
+  fl.put(a + 200, 50);
+  EXPECT_EQ(fl.largest_block(), 100u);
+  fl.put(a + 100, 100);  // joins the blocks
+  EXPECT_EQ(fl.largest_block(), 250u);
+  EXPECT_EQ(fl.get(200, 1), a);
+  EXPECT_EQ(fl.largest_block(), 50u);
+}
+
 TEST(MMBestFitFreeTree, Alignment) {
   best_fit_free_tree fl;
   fl.max_padding_ratio = 10;
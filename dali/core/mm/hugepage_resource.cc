@@ -0,0 +1,159 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <sys/mman.h>
+#include <unistd.h>
+#include <algorithm>
+#include <mutex>
+#include <new>
+#include "dali/core/mm/hugepage_resource.h"
+#include "dali/core/mm/numa_resource.h"
+#include "dali/core/mm/detail/align.h"
+#include "dali/core/cuda_error.h"
+#include "dali/core/error_handling.h"
+#include "dali/core/util.h"
+
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+
+namespace dali {
+namespace mm {
+
+namespace {
+
+/**
+ * @brief The end of each chunk is not given out, so that the chunks are never coalesced
+ *        in the free tree, even if they happen to be adjacent - an allocation can't span
+ *        two registered ranges.
+ */
+constexpr size_t kChunkGap = 256;
+
+/**
+ * @brief Maps `size` bytes aligned to `page_size`, preferably with the reserved huge pages.
+ *
+ * @param hugetlb set to true, if the mapping uses the reserved huge pages
+ */
+void *MapChunk(size_t size, size_t page_size, bool &hugetlb) {
+#ifdef MAP_HUGETLB
+  int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (ilog2(page_size) << MAP_HUGE_SHIFT);
+  void *mem = mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+  if (mem != MAP_FAILED) {
+    hugetlb = true;
+    return mem;
+  }
+#endif
+  // no huge pages of this size are available - map more to align the chunk to the page size
+  // and ask for the transparent huge pages
+  hugetlb = false;
+  size_t padded = size + page_size;
+  void *raw = mmap(nullptr, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (raw == MAP_FAILED)
+    throw std::bad_alloc();
+  char *start = static_cast<char *>(raw);
+  char *aligned = detail::align_ptr(start, page_size);
+  char *end = aligned + size;
+  if (aligned > start)
+    munmap(start, aligned - start);
+  if (start + padded > end)
+    munmap(end, start + padded - end);
+#ifdef MADV_HUGEPAGE
+  madvise(aligned, size, MADV_HUGEPAGE);  // just a hint - the pages may still be small
+#endif
+  return aligned;
+}
+
+int CurrentDeviceNode() {
+  int device_id = -1;
+  if (cudaGetDevice(&device_id) != cudaSuccess) {
+    cudaGetLastError();  // clear the error
+    return -1;
+  }
+  return numa::GetDeviceNode(device_id);
+}
+
+}  // namespace
+
+hugepage_pinned_memory_resource::hugepage_pinned_memory_resource(
+      size_t page_size, size_t chunk_size, size_t reserve, int node)
+    : page_size_(page_size), node_(node) {
+  DALI_ENFORCE(is_pow2(page_size) && page_size >= static_cast<size_t>(sysconf(_SC_PAGESIZE)),
+               make_string("The huge page size must be a power of 2, not smaller than the page "
+                           "size; got ", page_size));
+  chunk_size_ = align_up(std::max(chunk_size, page_size), page_size);
+  if (reserve)
+    add_chunk(reserve);
+}
+
+hugepage_pinned_memory_resource::~hugepage_pinned_memory_resource() {
+  for (auto &c : chunks_) {
+    CUDA_DTOR_CALL(cudaHostUnregister(c.ptr));
+    munmap(c.ptr, c.size);
+  }
+}
+
+size_t hugepage_pinned_memory_resource::mapped_size() const {
+  std::lock_guard<std::mutex> guard(mtx_);
+  size_t total = 0;
+  for (auto &c : chunks_)
+    total += c.size;
+  return total;
+}
+
+bool hugepage_pinned_memory_resource::uses_hugetlb() const {
+  std::lock_guard<std::mutex> guard(mtx_);
+  return hugetlb_;
+}
+
+void hugepage_pinned_memory_resource::add_chunk(size_t min_size) {
+  size_t size = align_up(std::max(min_size + kChunkGap, chunk_size_), page_size_);
+  chunks_.reserve(chunks_.size() + 1);
+  bool hugetlb = false;
+  void *mem = MapChunk(size, page_size_, hugetlb);
+  // the pages are not touched yet, so they can still be placed on the node
+  numa::BindMemory(mem, size, node_ >= 0 ? node_ : CurrentDeviceNode());
+  cudaError_t err = cudaHostRegister(mem, size, cudaHostRegisterPortable);
+  if (err != cudaSuccess) {
+    munmap(mem, size);
+    CUDA_CALL(err);
+  }
+  chunks_.push_back({ mem, size });
+  hugetlb_ = hugetlb_ && hugetlb;
+  free_.put(mem, size - kChunkGap);
+}
+
+void *hugepage_pinned_memory_resource::do_allocate(size_t bytes, size_t alignment) {
+  if (bytes == 0)
+    return nullptr;
+  std::lock_guard<std::mutex> guard(mtx_);
+  void *ptr = free_.get(bytes, alignment);
+  if (!ptr) {
+    // the chunks are aligned to the page size
+    add_chunk(alignment <= page_size_ ? bytes : bytes + alignment);
+    ptr = free_.get(bytes, alignment);
+    if (!ptr)
+      throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void hugepage_pinned_memory_resource::do_deallocate(void *ptr, size_t bytes, size_t alignment) {
+  if (!ptr)
+    return;
+  std::lock_guard<std::mutex> guard(mtx_);
+  free_.put(ptr, bytes);
+}
+
+}  // namespace mm
+}  // namespace dali
@@ -0,0 +1,88 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "dali/core/mm/hugepage_resource.h"
+#include "dali/core/mm/pool_resource.h"
+#include "dali/core/mm/detail/align.h"
+#include "dali/core/cuda_error.h"
+
+namespace dali {
+namespace mm {
+namespace test {
+
+TEST(MMHugePages, Reserve) {
+  // the system may have no huge pages reserved - then transparent huge pages are used
+  hugepage_pinned_memory_resource mr(2 << 20, 4 << 20, 6 << 20);
+  EXPECT_EQ(mr.page_size(), 2u << 20);
+  EXPECT_EQ(mr.mapped_size(), 8u << 20);  // the reservation rounded up to whole pages
+  void *a = mr.allocate(3 << 20);
+  void *b = mr.allocate(3 << 20, 4096);
+  ASSERT_NE(a, nullptr);
+  ASSERT_NE(b, nullptr);
+  EXPECT_TRUE(detail::is_aligned(b, 4096));
+  EXPECT_EQ(mr.mapped_size(), 8u << 20);  // served from the reservation
+
+  void *c = mr.allocate(3 << 20);  // needs a new chunk
+  ASSERT_NE(c, nullptr);
+  EXPECT_EQ(mr.mapped_size(), 12u << 20);
+
+  CUDA_CALL(cudaMemset(a, 1, 3 << 20));
+  CUDA_CALL(cudaMemcpy(c, a, 3 << 20, cudaMemcpyDefault));
+  EXPECT_EQ(static_cast<char *>(c)[(3 << 20) - 1], 1);
+
+  mr.deallocate(a, 3 << 20);
+  mr.deallocate(b, 3 << 20, 4096);
+  mr.deallocate(c, 3 << 20);
+  // the freed memory is reused
+  void *d = mr.allocate(7 << 20);
+  EXPECT_EQ(mr.mapped_size(), 12u << 20);
+  mr.deallocate(d, 7 << 20);
+  EXPECT_EQ(mr.allocate(0), nullptr);
+}
+
+TEST(MMHugePages, LargeAlignment) {
+  hugepage_pinned_memory_resource mr(2 << 20, 2 << 20);
+  size_t alignment = 8 << 20;
+  void *mem = mr.allocate(1000, alignment);
+  ASSERT_NE(mem, nullptr);
+  EXPECT_TRUE(detail::is_aligned(mem, alignment));
+  mr.deallocate(mem, 1000, alignment);
+}
+
+TEST(MMHugePages, PoolUpstream) {
+  hugepage_pinned_memory_resource upstream(2 << 20, 16 << 20, 16 << 20);
+  auto opt = default_pool_opts<memory_kind::pinned>();
+  opt.max_block_size = 4 << 20;
+  pool_resource_base<memory_kind::pinned, any_context, coalescing_free_tree, std::mutex>
+      pool(&upstream, opt);
+  std::vector<std::pair<void *, size_t>> allocs;
+  for (size_t size = 1000; size < (4 << 20); size *= 3) {
+    void *mem = pool.allocate(size);
+    ASSERT_NE(mem, nullptr);
+    memset(mem, 0x5a, size);
+    allocs.emplace_back(mem, size);
+  }
+  EXPECT_EQ(upstream.mapped_size(), 16u << 20);
+  for (auto &a : allocs)
+    pool.deallocate(a.first, a.second);
+}
+
+}  // namespace test
+}  // namespace mm
+}  // namespace dali
@@ -68,6 +68,34 @@ TEST(MMTest, MonotonicHostResource) {
   upstream.check_leaks();
 }
 
+TEST(MMTest, MonotonicHostResourceReset) {
+  test_host_resource upstream;
+  {
+    monotonic_host_resource mr(&upstream, 1000);
+    void *m1 = mr.allocate(100);
+    mr.allocate(1500);
+    mr.allocate(5000);
+    EXPECT_EQ(upstream.get_num_allocs(), 3u);
+    // only the last (largest) block is kept and the allocation starts from its beginning
+    mr.reset();
+    EXPECT_EQ(upstream.get_num_deallocs(), 2u);
+    void *m2 = mr.allocate(6000);
+    void *m3 = mr.allocate(100);
+    EXPECT_EQ(upstream.get_num_allocs(), 3u);
+    EXPECT_NE(m2, m1);
+    EXPECT_EQ(static_cast<char *>(m3), static_cast<char *>(m2) + 6000);
+    mr.reset();
+    EXPECT_EQ(mr.allocate(100), m2);
+    EXPECT_EQ(upstream.get_num_deallocs(), 2u);
+    mr.free_all();
+    EXPECT_EQ(upstream.get_num_deallocs(), 3u);
+    // the resource can still be used after freeing the memory
+    mr.allocate(100);
+    EXPECT_EQ(upstream.get_num_allocs(), 4u);
+  }
+  upstream.check_leaks();
+}
+
 TEST(MMTest, MonotonicDeviceResource) {
   test_device_resource upstream;
   {
@@ -0,0 +1,209 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <mutex>
+#include <new>
+#include <vector>
+#include "dali/core/mm/numa_resource.h"
+#include "dali/core/mm/malloc_resource.h"
+#include "dali/core/mm/detail/align.h"
+#include "dali/core/cuda_error.h"
+#include "dali/core/util.h"
+
+#ifndef MPOL_PREFERRED
+#define MPOL_PREFERRED 1
+#endif
+
+namespace dali {
+namespace mm {
+namespace numa {
+
+namespace {
+
+struct DeviceNodes {
+  std::mutex mtx;
+  std::vector<int> nodes;
+
+  static DeviceNodes &instance() {
+    static DeviceNodes inst;
+    return inst;
+  }
+};
+
+}  // namespace
+
+void SetDeviceNode(int device_id, int node) {
+  if (device_id < 0)
+    return;
+  auto &dn = DeviceNodes::instance();
+  std::lock_guard<std::mutex> guard(dn.mtx);
+  if (static_cast<size_t>(device_id) >= dn.nodes.size())
+    dn.nodes.resize(device_id + 1, -1);
+  dn.nodes[device_id] = node < 0 ? -1 : node;
+}
+
+int GetDeviceNode(int device_id) {
+  auto &dn = DeviceNodes::instance();
+  std::lock_guard<std::mutex> guard(dn.mtx);
+  if (device_id < 0 || static_cast<size_t>(device_id) >= dn.nodes.size())
+    return -1;
+  return dn.nodes[device_id];
+}
+
+bool BindMemory(void *addr, size_t bytes, int node) {
+#ifdef SYS_mbind
+  if (node < 0)
+    return false;
+  const size_t bits_per_word = sizeof(unsigned long) * 8;  // NOLINT(runtime/int)
+  std::vector<unsigned long> mask(node / bits_per_word + 1);  // NOLINT(runtime/int)
+  mask[node / bits_per_word] = 1ul << (node % bits_per_word);
+  // the kernel expects the number of bits + 1
+  size_t max_node = mask.size() * bits_per_word + 1;
+  return syscall(SYS_mbind, addr, bytes, MPOL_PREFERRED, mask.data(), max_node, 0) == 0;
+#else
+  return false;
+#endif
+}
+
+}  // namespace numa
+
+namespace detail {
+
+namespace {
+
+size_t PageSize() {
+  static const size_t page_size = sysconf(_SC_PAGESIZE);
+  return page_size;
+}
+
+/**
+ * @brief The mapping is at least one byte larger than requested, so that the blocks are never
+ *        adjacent and can't be accidentally coalesced by a pool.
+ */
+size_t MappingSize(size_t size) {
+  return align_up(size + 1, PageSize());
+}
+
+}  // namespace
+
+int numa_host_allocator::current_node() const {
+  if (node_ >= 0)
+    return node_;
+  int device_id = -1;
+  if (cudaGetDevice(&device_id) != cudaSuccess) {
+    cudaGetLastError();  // clear the error
+    return -1;
+  }
+  return numa::GetDeviceNode(device_id);
+}
+
+void *numa_host_allocator::allocate(size_t bytes, size_t alignment, int node) {
+  if (bytes == 0)
+    return nullptr;
+  bool pin = pin_;
+  auto map = [node, pin](size_t size) {
+    size = MappingSize(size);
+    void *mem = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED)
+      throw std::bad_alloc();
+    numa::BindMemory(mem, size, node);  // if it fails, we just get the default placement
+    if (pin) {
+      cudaError_t err = cudaHostRegister(mem, size, cudaHostRegisterPortable);
+      if (err != cudaSuccess) {
+        munmap(mem, size);
+        CUDA_CALL(err);
+      }
+    }
+    return mem;
+  };
+  // mmap returns page-aligned memory
+  if (alignment <= PageSize())
+    alignment = 1;
+  return detail::aligned_alloc(map, bytes, alignment);
+}
+
+void numa_host_allocator::deallocate(void *ptr, size_t bytes, size_t alignment) {
+  if (!ptr)
+    return;
+  bool pin = pin_;
+  auto unmap = [pin](void *mem, size_t size) {
+    size = MappingSize(size);
+    if (pin)
+      CUDA_DTOR_CALL(cudaHostUnregister(mem));
+    munmap(mem, size);
+  };
+  if (alignment <= PageSize())
+    alignment = 1;
+  detail::aligned_dealloc(unmap, ptr, bytes, alignment);
+}
+
+}  // namespace detail
+
+void *numa_host_memory_resource::do_allocate(size_t bytes, size_t alignment) {
+  return alloc_.allocate(bytes, alignment, alloc_.current_node());
+}
+
+void numa_host_memory_resource::do_deallocate(void *ptr, size_t bytes, size_t alignment) {
+  alloc_.deallocate(ptr, bytes, alignment);
+}
+
+bool numa_host_memory_resource::do_is_equal(const memory_resource &other) const noexcept {
+  // the memory is freed in the same way, regardless of the node
+  return dynamic_cast<const numa_host_memory_resource *>(&other) != nullptr;
+}
+
+void *numa_pinned_memory_resource::do_allocate(size_t bytes, size_t alignment) {
+  if (bytes == 0)
+    return nullptr;
+  int node = alloc_.current_node();
+  if (node >= 0)
+    return alloc_.allocate(bytes, alignment, node);
+
+  void *ptr = pinned_malloc_memory_resource::instance().allocate(bytes, alignment);
+  try {
+    std::lock_guard<std::mutex> guard(mtx_);
+    fallback_blocks_.insert(ptr);
+  } catch (...) {
+    pinned_malloc_memory_resource::instance().deallocate(ptr, bytes, alignment);
+    throw;
+  }
+  return ptr;
+}
+
+void numa_pinned_memory_resource::do_deallocate(void *ptr, size_t bytes, size_t alignment) {
+  if (!ptr)
+    return;
+  {
+    std::lock_guard<std::mutex> guard(mtx_);
+    auto it = fallback_blocks_.find(ptr);
+    if (it != fallback_blocks_.end()) {
+      fallback_blocks_.erase(it);
+      pinned_malloc_memory_resource::instance().deallocate(ptr, bytes, alignment);
+      return;
+    }
+  }
+  alloc_.deallocate(ptr, bytes, alignment);
+}
+
+bool numa_pinned_memory_resource::do_is_equal(
+      const memory_resource<memory_kind> &other) const noexcept {
+  // the fallback blocks are tracked by the instance
+  return this == &other;
+}
+
+}  // namespace mm
+}  // namespace dali
@@ -0,0 +1,80 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include "dali/core/mm/numa_resource.h"
+#include "dali/core/mm/detail/align.h"
+#include "dali/core/cuda_error.h"
+
+namespace dali {
+namespace mm {
+namespace test {
+
+TEST(MMNuma, DeviceNode) {
+  EXPECT_EQ(numa::GetDeviceNode(1000), -1);
+  numa::SetDeviceNode(1000, 1);
+  EXPECT_EQ(numa::GetDeviceNode(1000), 1);
+  numa::SetDeviceNode(1000, -5);
+  EXPECT_EQ(numa::GetDeviceNode(1000), -1);
+  EXPECT_EQ(numa::GetDeviceNode(-1), -1);
+}
+
+TEST(MMNuma, HostResource) {
+  // node 0 always exists; binding may be not permitted (e.g. in a container), but then
+  // the memory is still usable
+  numa_host_memory_resource mr(0);
+  EXPECT_EQ(mr.node(), 0);
+  for (size_t alignment : { 1, 64, 4096, 1 << 16 }) {
+    size_t size = 12345;
+    void *mem = mr.allocate(size, alignment);
+    ASSERT_NE(mem, nullptr);
+    EXPECT_TRUE(detail::is_aligned(mem, alignment));
+    memset(mem, 0x5a, size);
+    mr.deallocate(mem, size, alignment);
+  }
+  EXPECT_EQ(mr.allocate(0), nullptr);
+}
+
+TEST(MMNuma, PinnedResource) {
+  int device_id = 0;
+  CUDA_CALL(cudaGetDevice(&device_id));
+  int prev_node = numa::GetDeviceNode(device_id);
+  numa_pinned_memory_resource mr;
+  size_t size = 1 << 20;
+
+  // no node registered - cudaMallocHost
+  numa::SetDeviceNode(device_id, -1);
+  void *fallback = mr.allocate(size);
+  ASSERT_NE(fallback, nullptr);
+
+  numa::SetDeviceNode(device_id, 0);
+  void *mapped = mr.allocate(size, 256);
+  ASSERT_NE(mapped, nullptr);
+  EXPECT_TRUE(detail::is_aligned(mapped, 256));
+  CUDA_CALL(cudaMemset(mapped, 1, size));
+  CUDA_CALL(cudaMemcpy(fallback, mapped, size, cudaMemcpyDefault));
+  EXPECT_EQ(static_cast<char *>(fallback)[size - 1], 1);
+
+  // the deallocation doesn't depend on the node registered at the moment
+  numa::SetDeviceNode(device_id, -1);
+  mr.deallocate(mapped, size, 256);
+  numa::SetDeviceNode(device_id, 0);
+  mr.deallocate(fallback, size);
+  numa::SetDeviceNode(device_id, prev_node);
+}
+
+}  // namespace test
+}  // namespace mm
+}  // namespace dali
@@ -0,0 +1,85 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <utility>
+#include "dali/core/mm/polymorphic_allocator.h"
+#include "dali/core/mm/monotonic_resource.h"
+#include "dali/core/mm/mm_test_utils.h"
+
+namespace dali {
+namespace mm {
+namespace test {
+
+TEST(MMPolymorphicAllocator, Vector) {
+  test_host_resource upstream;
+  {
+    pmr_vector<int> v(&upstream);
+    for (int i = 0; i < 1000; i++)
+      v.push_back(i);
+    EXPECT_GE(upstream.get_num_allocs(), 1u);
+    EXPECT_GT(upstream.get_current_size(), 0u);
+
+    pmr_vector<int> moved = std::move(v);
+    EXPECT_EQ(moved.get_allocator().resource(), &upstream);
+    for (int i = 0; i < 1000; i++)
+      ASSERT_EQ(moved[i], i);
+  }
+  upstream.check_leaks();
+}
+
+TEST(MMPolymorphicAllocator, Rebind) {
+  test_host_resource upstream;
+  polymorphic_allocator<int> a(&upstream);
+  polymorphic_allocator<double> b(a);
+  EXPECT_EQ(b.resource(), &upstream);
+  EXPECT_TRUE(a == b);
+  EXPECT_TRUE(a != polymorphic_allocator<int>());
+  double *d = b.allocate(10);
+  EXPECT_EQ(upstream.get_current_size(), 10 * sizeof(double));
+  b.deallocate(d, 10);
+  upstream.check_leaks();
+}
+
+TEST(MMPolymorphicAllocator, SmallVectorInArena) {
+  test_host_resource upstream;
+  {
+    monotonic_host_resource arena(&upstream, 1 << 12);
+    pmr_small_vector<int, 4> v(&arena);
+    for (int i = 0; i < 100; i++)
+      v.push_back(i);
+    size_t allocs = upstream.get_num_allocs();
+    EXPECT_GE(allocs, 1u);
+
+    // moving with the allocator - the buffer is taken over
+    pmr_small_vector<int, 4> moved = std::move(v);
+    ASSERT_EQ(moved.size(), 100u);
+    for (int i = 0; i < 100; i++)
+      ASSERT_EQ(moved[i], i);
+
+    // a vector which uses another resource must copy the contents
+    pmr_small_vector<int, 4> on_heap;
+    on_heap = std::move(moved);
+    ASSERT_EQ(on_heap.size(), 100u);
+    EXPECT_TRUE(moved.empty());
+    for (int i = 0; i < 100; i++)
+      ASSERT_EQ(on_heap[i], i);
+    EXPECT_EQ(upstream.get_num_allocs(), allocs);
+  }
+  upstream.check_leaks();
+}
+
+}  // namespace test
+}  // namespace mm
+}  // namespace dali
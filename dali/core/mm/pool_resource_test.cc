@@ -114,6 +114,32 @@ TEST(MMPoolResource, ReturnToUpstream) {
   upstream.check_leaks();
 }
 
+TEST(MMPoolResource, ReleaseUnused) {
+  test_host_resource upstream;
+  {
+    pool_options opts;
+    opts.min_block_size = 1 << 20;
+    opts.growth_factor = 1;
+    pool_resource_base<memory_kind::host, any_context, coalescing_free_tree, detail::dummy_lock>
+      pool(&upstream, opts);
+    void *blocks[3];
+    for (auto &b : blocks)
+      b = pool.allocate(3 << 20);  // each allocation requires a new upstream block
+    EXPECT_EQ(upstream.get_num_allocs(), 3u);
+    pool.deallocate(blocks[0], 3 << 20);
+    pool.deallocate(blocks[2], 3 << 20);
+    size_t reserved = pool.reserved_bytes();
+    size_t released = pool.release_unused();
+    EXPECT_EQ(upstream.get_num_deallocs(), 2u);
+    EXPECT_GE(released, size_t(6 << 20));
+    EXPECT_EQ(pool.reserved_bytes(), reserved - released);
+    // nothing more to release
+    EXPECT_EQ(pool.release_unused(), 0u);
+    pool.deallocate(blocks[1], 3 << 20);
+  }
+  upstream.check_leaks();
+}
+
 TEST(MMPoolResource, TestBulkDeallocate) {
   test_host_resource upstream;
   {
@@ -0,0 +1,243 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include "dali/core/mm/thread_cache_resource.h"
+#include "dali/core/mm/mm_test_utils.h"
+
+namespace dali {
+namespace mm {
+namespace test {
+
+namespace {
+
+/// Makes the (not thread-safe) test resource usable from multiple threads
+class locked_host_resource : public host_memory_resource {
+ public:
+  explicit locked_host_resource(host_memory_resource *upstream) : upstream_(upstream) {}
+
+ private:
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    std::lock_guard<std::mutex> guard(mtx_);
+    return upstream_->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void *ptr, size_t bytes, size_t alignment) override {
+    std::lock_guard<std::mutex> guard(mtx_);
+    upstream_->deallocate(ptr, bytes, alignment);
+  }
+
+  host_memory_resource *upstream_;
+  std::mutex mtx_;
+};
+
+}  // namespace
+
+TEST(MMThreadCache, SizeClasses) {
+  using classes = detail::tcache_size_classes;
+  EXPECT_EQ(classes::class_size(0), 16u);
+  for (int c = 0; c < 60; c++) {
+    size_t size = classes::class_size(c);
+    EXPECT_EQ(classes::class_index(size), c);
+    EXPECT_EQ(classes::class_index(size + 1), c + 1);
+    EXPECT_LT(size, classes::class_size(c + 1));
+  }
+  for (size_t size = 17; size < 100000; size++) {
+    size_t class_size = classes::class_size(classes::class_index(size));
+    ASSERT_GE(class_size, size);
+    ASSERT_LT(class_size, size + size / 4 + 1);
+  }
+}
+
+TEST(MMThreadCache, Reuse) {
+  test_host_resource upstream;
+  {
+    thread_cache_resource<memory_kind::host> cache(&upstream);
+    void *p1 = cache.allocate(100);
+    cache.deallocate(p1, 100);
+    void *p2 = cache.allocate(100);
+    EXPECT_EQ(p1, p2);
+    // the same size class
+    cache.deallocate(p2, 100);
+    void *p3 = cache.allocate(110);
+    EXPECT_EQ(p1, p3);
+    cache.deallocate(p3, 110);
+    EXPECT_EQ(upstream.get_num_allocs(), 1u);
+    EXPECT_EQ(upstream.get_num_deallocs(), 0u);
+
+    // too large or too strictly aligned - not cached
+    void *large = cache.allocate(1 << 20);
+    cache.deallocate(large, 1 << 20);
+    void *aligned = cache.allocate(16, 64);
+    cache.deallocate(aligned, 16, 64);
+    EXPECT_EQ(upstream.get_num_allocs(), 3u);
+    EXPECT_EQ(upstream.get_num_deallocs(), 2u);
+  }
+  upstream.check_leaks();
+}
+
+TEST(MMThreadCache, Depot) {
+  test_host_resource upstream;
+  {
+    // 2 blocks in the thread bin
+    thread_cache_options opt;
+    opt.max_thread_bytes_per_class = 2048;
+    thread_cache_resource<memory_kind::host> cache(&upstream, opt);
+    std::vector<void *> blocks;
+    for (int i = 0; i < 10; i++)
+      blocks.push_back(cache.allocate(1000));
+    for (void *p : blocks)
+      cache.deallocate(p, 1000);
+    EXPECT_EQ(upstream.get_num_deallocs(), 0u);
+
+    // another thread gets the blocks from the depot
+    std::thread t([&]() {
+      std::vector<void *> other;
+      for (int i = 0; i < 8; i++)
+        other.push_back(cache.allocate(1000));
+      EXPECT_EQ(upstream.get_num_allocs(), 10u);
+      for (void *p : other)
+        cache.deallocate(p, 1000);
+    });
+    t.join();
+    EXPECT_EQ(upstream.get_num_allocs(), 10u);
+    EXPECT_EQ(upstream.get_num_deallocs(), 0u);
+  }
+  upstream.check_leaks();
+}
+
+TEST(MMThreadCache, DepotLimit) {
+  test_host_resource upstream;
+  {
+    thread_cache_options opt;
+    opt.max_thread_bytes_per_class = 2048;
+    opt.max_shared_bytes_per_class = 0;
+    thread_cache_resource<memory_kind::host> cache(&upstream, opt);
+    std::vector<void *> blocks;
+    for (int i = 0; i < 10; i++)
+      blocks.push_back(cache.allocate(1000));
+    for (void *p : blocks)
+      cache.deallocate(p, 1000);
+    // only the thread bin holds the blocks
+    EXPECT_EQ(upstream.get_num_deallocs(), 8u);
+  }
+  upstream.check_leaks();
+}
+
+TEST(MMThreadCache, ReleaseUnused) {
+  test_host_resource upstream;
+  {
+    thread_cache_options opt;
+    opt.max_thread_bytes_per_class = 2048;
+    thread_cache_resource<memory_kind::host> cache(&upstream, opt);
+    std::vector<void *> blocks;
+    for (int i = 0; i < 10; i++)
+      blocks.push_back(cache.allocate(1000));
+    for (void *p : blocks)
+      cache.deallocate(p, 1000);
+    EXPECT_EQ(upstream.get_num_deallocs(), 0u);
+    // the blocks in the depot are released, the thread bin is kept
+    size_t released = cache.release_unused();
+    EXPECT_EQ(upstream.get_num_deallocs(), 8u);
+    EXPECT_EQ(released, 8 * detail::tcache_size_classes::class_size(
+                                  detail::tcache_size_classes::class_index(1000)));
+    EXPECT_EQ(release_unused_memory(&cache), 0u);
+  }
+  upstream.check_leaks();
+}
+
+TEST(MMThreadCache, ThreadExit) {
+  test_host_resource upstream;
+  {
+    thread_cache_resource<memory_kind::host> cache(&upstream);
+    std::thread t([&]() {
+      std::vector<void *> blocks;
+      for (int i = 0; i < 4; i++)
+        blocks.push_back(cache.allocate(256));
+      for (void *p : blocks)
+        cache.deallocate(p, 256);
+    });
+    t.join();
+    // the blocks of the finished thread are in the depot
+    std::vector<void *> blocks;
+    for (int i = 0; i < 4; i++)
+      blocks.push_back(cache.allocate(256));
+    EXPECT_EQ(upstream.get_num_allocs(), 4u);
+    for (void *p : blocks)
+      cache.deallocate(p, 256);
+  }
+  upstream.check_leaks();
+}
+
+TEST(MMThreadCache, MultiThreaded) {
+  test_host_resource upstream;
+  {
+    locked_host_resource locked(&upstream);
+    thread_cache_resource<memory_kind::host> cache(&locked);
+    // some of the blocks are freed by other threads
+    std::vector<std::pair<uint8_t *, size_t>> shared;
+    std::mutex shared_mtx;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; t++) {
+      threads.emplace_back([&, t]() {
+        std::mt19937_64 rng(t);
+        std::uniform_int_distribution<size_t> size_dist(1, 100000);
+        std::bernoulli_distribution action(0.5), share(0.1);
+        std::vector<std::pair<uint8_t *, size_t>> blocks;
+        for (int i = 0; i < 10000; i++) {
+          if (blocks.empty() || action(rng)) {
+            size_t size = size_dist(rng);
+            auto *p = static_cast<uint8_t *>(cache.allocate(size));
+            std::memset(p, t, size);
+            blocks.emplace_back(p, size);
+          } else {
+            auto blk = blocks.back();
+            blocks.pop_back();
+            for (size_t j = 0; j < blk.second; j += 97)
+              ASSERT_EQ(blk.first[j], t);
+            if (share(rng)) {
+              std::lock_guard<std::mutex> guard(shared_mtx);
+              shared.push_back(blk);
+            } else {
+              cache.deallocate(blk.first, blk.second);
+            }
+          }
+          if (i % 100 == 0) {
+            std::lock_guard<std::mutex> guard(shared_mtx);
+            for (auto &blk : shared)
+              cache.deallocate(blk.first, blk.second);
+            shared.clear();
+          }
+        }
+        for (auto &blk : blocks)
+          cache.deallocate(blk.first, blk.second);
+      });
+    }
+    for (auto &t : threads)
+      t.join();
+    for (auto &blk : shared)
+      cache.deallocate(blk.first, blk.second);
+  }
+  upstream.check_leaks();
+}
+
+}  // namespace test
+}  // namespace mm
+}  // namespace dali
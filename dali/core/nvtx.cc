@@ -1,4 +1,4 @@
-// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2020-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -12,8 +12,19 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <unistd.h>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
 #include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
 #include "dali/core/nvtx.h"
+#include "dali/core/error_handling.h"
 
 namespace dali {
 
@@ -48,14 +59,221 @@ class DomainTimeRangeImpl : RangeBase {
   nvtxDomainHandle_t dali_domain_;
 };
 
-DLL_PUBLIC DomainTimeRange::DomainTimeRange(const char *name, const uint32_t rgb) {
+#endif  // NVTX_ENABLED
+
+namespace {
+
+const std::pair<const char *, uint32_t> kTraceCategoryNames[] = {
+  { "executor",    kTraceExecutor },
+  { "operator",    kTraceOperator },
+  { "loader",      kTraceLoader },
+  { "thread_pool", kTraceThreadPool },
+  { "other",       kTraceOther },
+  { "all",         kTraceAll },
+};
+
+const char *TraceCategoryName(uint32_t category) {
+  for (auto &entry : kTraceCategoryNames) {
+    if (entry.second == category)
+      return entry.first;
+  }
+  return "other";
+}
+
+uint32_t DefaultTraceCategories() {
+  if (const char *env = std::getenv("DALI_TRACE_CATEGORIES")) {
+    // this runs when the library is loaded, so an invalid value can't be reported by throwing
+    try {
+      return ParseTraceCategories(env);
+    } catch (const std::exception &e) {
+      std::cerr << "Ignoring DALI_TRACE_CATEGORIES: " << e.what() << std::endl;
+    }
+  }
+#if NVTX_ENABLED
+  return kTraceAll;
+#else
+  return 0;
+#endif
+}
+
+std::string EscapeJson(const std::string &str) {
+  std::string ret;
+  ret.reserve(str.size());
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      ret += '\\';
+      ret += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      ret += ' ';
+    } else {
+      ret += c;
+    }
+  }
+  return ret;
+}
+
+/**
+ * @brief Collects the ranges in memory and writes them as a Chrome trace (complete events)
+ */
+class ChromeTracer {
+ public:
+  static ChromeTracer &GetInstance() {
+    static ChromeTracer tracer;
+    return tracer;
+  }
+
+  bool active() const {
+    return active_.load(std::memory_order_relaxed);
+  }
+
+  int64_t Now() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - origin_).count();
+  }
+
+  void Start(uint32_t categories) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (active())
+      return;
+    events_.clear();
+    prev_categories_ = GetTraceCategories();
+    SetTraceCategories(categories);
+    active_ = true;
+  }
+
+  void Stop(const std::string &filename) {
+    std::vector<Event> events;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      DALI_ENFORCE(active(), "The Chrome trace collection was not started.");
+      active_ = false;
+      SetTraceCategories(prev_categories_);
+      events.swap(events_);
+    }
+    std::ofstream out(filename);
+    DALI_ENFORCE(out.good(), make_string("Cannot open the trace file: ", filename));
+    int pid = getpid();
+    out << "{\"traceEvents\":[";
+    for (size_t i = 0; i < events.size(); i++) {
+      auto &e = events[i];
+      out << (i ? ",\n" : "\n")
+          << "{\"name\":\"" << EscapeJson(e.name) << "\",\"cat\":\"" << e.category
+          << "\",\"ph\":\"X\",\"ts\":" << e.start_ns * 1e-3 << ",\"dur\":"
+          << (e.end_ns - e.start_ns) * 1e-3 << ",\"pid\":" << pid << ",\"tid\":" << e.tid << "}";
+    }
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  }
+
+  void Record(std::string &&name, uint32_t category, int64_t start_ns, int64_t end_ns) {
+    static std::atomic<int> next_tid{0};
+    thread_local int tid = next_tid++;
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!active())
+      return;
+    events_.push_back({std::move(name), TraceCategoryName(category), tid, start_ns, end_ns});
+  }
+
+ private:
+  ChromeTracer() : origin_(std::chrono::steady_clock::now()) {
+    if (const char *env = std::getenv("DALI_CHROME_TRACE")) {
+      at_exit_filename_ = env;
+      if (!at_exit_filename_.empty()) {
+        const char *categories = std::getenv("DALI_TRACE_CATEGORIES");
+        Start(categories ? DefaultTraceCategories() : kTraceAll);
+      }
+    }
+  }
+
+  ~ChromeTracer() {
+    if (active() && !at_exit_filename_.empty()) {
+      try {
+        Stop(at_exit_filename_);
+      } catch (...) {}
+    }
+  }
+
+  struct Event {
+    std::string name;
+    const char *category;
+    int tid;
+    int64_t start_ns, end_ns;
+  };
+
+  std::chrono::steady_clock::time_point origin_;
+  std::atomic<bool> active_{false};
+  std::mutex mutex_;
+  std::vector<Event> events_;
+  uint32_t prev_categories_ = 0;
+  std::string at_exit_filename_;
+};
+
+}  // namespace
+
+namespace detail {
+DLL_PUBLIC std::atomic<uint32_t> trace_categories{DefaultTraceCategories()};
+}  // namespace detail
+
+// instantiated at load time, so that DALI_CHROME_TRACE takes effect
+static ChromeTracer &chrome_tracer_instance = ChromeTracer::GetInstance();
+
+DLL_PUBLIC void SetTraceCategories(uint32_t categories) {
+  detail::trace_categories = categories;
+}
+
+DLL_PUBLIC uint32_t GetTraceCategories() {
+  return detail::trace_categories;
+}
+
+DLL_PUBLIC uint32_t ParseTraceCategories(const std::string &names) {
+  uint32_t categories = 0;
+  std::stringstream ss(names);
+  std::string name;
+  while (std::getline(ss, name, ',')) {
+    if (name.empty())
+      continue;
+    bool found = false;
+    for (auto &entry : kTraceCategoryNames) {
+      if (name == entry.first) {
+        categories |= entry.second;
+        found = true;
+        break;
+      }
+    }
+    DALI_ENFORCE(found, make_string("Unknown trace category: \"", name, "\". Valid categories "
+                 "are: executor, operator, loader, thread_pool, other and all."));
+  }
+  return categories;
+}
+
+DLL_PUBLIC void StartChromeTrace(uint32_t categories) {
+  ChromeTracer::GetInstance().Start(categories);
+}
+
+DLL_PUBLIC void StopChromeTrace(const std::string &filename) {
+  ChromeTracer::GetInstance().Stop(filename);
+}
+
+void TraceRange::Start(uint32_t category, const char *name, const uint32_t rgb) {
+  started_ = true;
+#if NVTX_ENABLED
   DomainTimeRangeImpl::GetInstance().Start(name, rgb);
+#endif
+  auto &tracer = ChromeTracer::GetInstance();
+  if (tracer.active()) {
+    category_ = category;
+    name_ = name;
+    start_ns_ = tracer.Now();
+  }
 }
 
-DLL_PUBLIC DomainTimeRange::~DomainTimeRange() {
+void TraceRange::Stop() {
+#if NVTX_ENABLED
   DomainTimeRangeImpl::GetInstance().Stop();
+#endif
+  if (start_ns_ >= 0) {
+    auto &tracer = ChromeTracer::GetInstance();
+    tracer.Record(std::move(name_), category_, start_ns_, tracer.Now());
+  }
 }
 
-#endif  // NVTX_ENABLED
-
 }  // namespace dali
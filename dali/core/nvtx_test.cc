@@ -0,0 +1,65 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "dali/core/nvtx.h"
+
+namespace dali {
+
+TEST(Trace, ParseCategories) {
+  EXPECT_EQ(ParseTraceCategories(""), 0u);
+  EXPECT_EQ(ParseTraceCategories("executor,loader"), kTraceExecutor | kTraceLoader);
+  EXPECT_EQ(ParseTraceCategories("thread_pool,operator,other"),
+            kTraceThreadPool | kTraceOperator | kTraceOther);
+  EXPECT_EQ(ParseTraceCategories("all"), kTraceAll);
+  EXPECT_THROW(ParseTraceCategories("executor,gpu"), std::exception);
+}
+
+TEST(Trace, ChromeTrace) {
+  uint32_t prev_categories = GetTraceCategories();
+  std::string filename = testing::TempDir() + "dali_chrome_trace_test.json";
+  int evaluated = 0;
+  auto name = [&](const char *str) {
+    evaluated++;
+    return std::string(str);
+  };
+
+  StartChromeTrace(kTraceExecutor | kTraceLoader);
+  {
+    DALI_TRACE_RANGE(kTraceExecutor, name("\"executor\" range"), RangeBase::kBlue);
+    DALI_TRACE_RANGE(kTraceOperator, name("operator range"), RangeBase::kBlue);
+    TraceRange loader(kTraceLoader, "loader range");
+  }
+  StopChromeTrace(filename);
+  EXPECT_EQ(GetTraceCategories(), prev_categories);
+  // the names of the disabled ranges are not built
+  EXPECT_EQ(evaluated, 1);
+
+  std::ifstream f(filename);
+  std::stringstream ss;
+  ss << f.rdbuf();
+  std::string trace = ss.str();
+  std::remove(filename.c_str());
+  EXPECT_NE(trace.find("\"traceEvents\""), std::string::npos);
+  EXPECT_NE(trace.find("\"name\":\"\\\"executor\\\" range\",\"cat\":\"executor\""),
+            std::string::npos);
+  EXPECT_NE(trace.find("\"name\":\"loader range\",\"cat\":\"loader\""), std::string::npos);
+  EXPECT_EQ(trace.find("operator range"), std::string::npos);
+}
+
+}  // namespace dali
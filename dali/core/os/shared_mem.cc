@@ -21,6 +21,7 @@
 #include <cstring>
 #include <exception>
 
+#include "dali/core/cuda_error.h"
 #include "dali/core/format.h"
 #include "dali/core/os/shared_mem.h"
 
@@ -131,6 +132,10 @@ SharedMem::SharedMem(shm_handle_t handle, uint64_t size) : size_{size * sizeof(u
   memory_mapping_ = MemoryMapping(shm_handle_, size_);
 }
 
+SharedMem::~SharedMem() {
+  unregister_mapping();
+}
+
 uint64_t SharedMem::size() const {
   return size_;
 }
@@ -144,6 +149,8 @@ uint8_t *SharedMem::get_raw_ptr() {
 }
 
 void SharedMem::resize(uint64_t size, bool trunc) {
+  // the mapping may move, so the old range must not stay registered
+  unregister_mapping();
   size_ = size * sizeof(uint8_t);
   if (trunc) {
     POSIX_CALL_EX(ftruncate(shm_handle_, size_), "Failed to resize shared memory.");
@@ -156,11 +163,52 @@ void SharedMem::resize(uint64_t size, bool trunc) {
     }
     memory_mapping_ = MemoryMapping(shm_handle_, size_);
   }
+  if (pinned_) {
+    register_mapping();
+  }
 }
 
 void SharedMem::close() {
+  unpin();
   memory_mapping_.reset();
   shm_handle_.reset();
 }
 
+void SharedMem::pin() {
+  if (pinned_) {
+    return;
+  }
+  if (!memory_mapping_) {
+    throw std::runtime_error("Cannot pin the memory - no memory has been mapped.");
+  }
+  pinned_ = true;
+  register_mapping();
+}
+
+void SharedMem::unpin() {
+  unregister_mapping();
+  pinned_ = false;
+}
+
+void SharedMem::register_mapping() {
+  if (!memory_mapping_ || size_ == 0) {
+    return;
+  }
+  try {
+    CUDA_CALL(cudaHostRegister(memory_mapping_.get_raw_ptr(), size_, cudaHostRegisterPortable));
+  } catch (...) {
+    pinned_ = false;
+    throw;
+  }
+  registered_ = true;
+}
+
+void SharedMem::unregister_mapping() {
+  if (!registered_) {
+    return;
+  }
+  registered_ = false;
+  CUDA_DTOR_CALL(cudaHostUnregister(memory_mapping_.get_raw_ptr()));
+}
+
 }  // namespace dali
@@ -0,0 +1,76 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include "dali/core/philox.h"
+
+namespace dali {
+
+TEST(Philox4x32_10, KnownAnswer) {
+  // Random123 known answer test: zero key, zero counter
+  Philox4x32_10 rng(0, 0, 0);
+  EXPECT_EQ(rng(), 0x6627e8d5u);
+  EXPECT_EQ(rng(), 0xe169c58du);
+  EXPECT_EQ(rng(), 0xbc57ac4cu);
+  EXPECT_EQ(rng(), 0x9b00dbd8u);
+}
+
+TEST(Philox4x32_10, Skip) {
+  Philox4x32_10 ref(12345, 678);
+  std::vector<uint32_t> values(1000);
+  for (auto &v : values)
+    v = ref();
+
+  for (uint64_t offset : {0, 1, 3, 4, 5, 17, 400, 999}) {
+    Philox4x32_10 rng(12345, 678, offset);
+    EXPECT_EQ(rng(), values[offset]) << "offset " << offset;
+  }
+
+  for (uint64_t pos : {1, 2, 7}) {
+    for (uint64_t n : {0, 1, 3, 4, 9}) {
+      Philox4x32_10 rng(12345, 678);
+      for (uint64_t i = 0; i < pos; i++)
+        rng();
+      rng.skip(n);
+      EXPECT_EQ(rng(), values[pos + n]) << "pos " << pos << " n " << n;
+    }
+  }
+}
+
+TEST(Philox4x32_10, Subsequences) {
+  Philox4x32_10 a(42, 0), b(42, 1), c(43, 0);
+  int same_ab = 0, same_ac = 0;
+  for (int i = 0; i < 100; i++) {
+    uint32_t va = a(), vb = b(), vc = c();
+    same_ab += va == vb;
+    same_ac += va == vc;
+  }
+  EXPECT_LT(same_ab, 3);
+  EXPECT_LT(same_ac, 3);
+}
+
+TEST(Philox4x32_10, StdDistribution) {
+  std::seed_seq seq{1, 2, 3};
+  Philox4x32_10 rng(seq);
+  std::uniform_real_distribution<double> dist(0, 1);
+  double sum = 0;
+  const int n = 100000;
+  for (int i = 0; i < n; i++)
+    sum += dist(rng);
+  EXPECT_NEAR(sum / n, 0.5, 0.01);
+}
+
+}  // namespace dali
@@ -1174,6 +1174,33 @@ TEST(TensorListShapeTest, PermuteDims) {
   EXPECT_EQ(ref, permuted) << "Actual:\n" << permuted << "\nexpected:\n" << ref;
 }
 
+TEST(TensorListShapeTest, InPlaceReusesStorage) {
+  TensorListShape<> tls = {{
+    { 1, 2, 3, 4 }, { 5, 6, 7, 8 }, { 9, 10, 11, 12 }
+  }};
+  TensorListShape<> out;
+  out.reserve(tls.num_samples(), tls.sample_dim());
+  auto *storage = out.shapes.data();
+
+  first_dims(out, tls, 2);
+  EXPECT_EQ(out, (TensorListShape<>{{ { 1, 2 }, { 5, 6 }, { 9, 10 } }}));
+  last_dims(out, tls, 3);
+  EXPECT_EQ(out, (TensorListShape<>{{ { 2, 3, 4 }, { 6, 7, 8 }, { 10, 11, 12 } }}));
+  collapse_dims(out, tls, {{ 1, 2 }});
+  EXPECT_EQ(out, (TensorListShape<>{{ { 1, 6, 4 }, { 5, 42, 8 }, { 9, 110, 12 } }}));
+  int perm[] = { 3, 2, 1, 0 };
+  permute_dims(out, tls, perm);
+  EXPECT_EQ(out, (TensorListShape<>{{ { 4, 3, 2, 1 }, { 8, 7, 6, 5 }, { 12, 11, 10, 9 } }}));
+  sample_range(out, tls, 1, 3);
+  EXPECT_EQ(out, (TensorListShape<>{{ { 5, 6, 7, 8 }, { 9, 10, 11, 12 } }}));
+
+  EXPECT_EQ(out.shapes.data(), storage) << "The in-place variants should not reallocate";
+
+  TensorListShape<2> static_out;
+  last_dims(static_out, tls, 2);
+  EXPECT_EQ(static_out, (TensorListShape<2>{{ { 3, 4 }, { 7, 8 }, { 11, 12 } }}));
+}
+
 TEST(TensorTest, WontCompile) {
   // TensorShape<5> static_shape_less(1, 2, 3, 4);
   // TensorShape<5> static_shape_more(1, 2, 3, 4, 5, 6);
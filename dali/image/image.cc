@@ -37,6 +37,12 @@ std::shared_ptr<uint8_t> Image::GetImage() const {
   return decoded_image_;
 }
 
+std::shared_ptr<uint8_t> Image::AllocateOutput(const Shape &shape) const {
+  if (output_allocator_)
+    return {output_allocator_(shape), [](uint8_t *) {}};
+  return {new uint8_t[volume(shape)], [](uint8_t *data) { delete [] data; }};
+}
+
 Image::Shape Image::PeekShape() const {
   return PeekShapeImpl(encoded_image_, length_);
 }
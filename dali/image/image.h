@@ -33,6 +33,11 @@ namespace dali {
 class Image {
  public:
   using Shape = TensorShape<3>;
+  /**
+   * Provides the memory for the decoded image of the given shape; the memory is not owned
+   * by the image.
+   */
+  using OutputAllocator = std::function<uint8_t *(const Shape &shape)>;
 
   /**
    * Perform image decoding. Actual implementation is defined
@@ -98,6 +103,29 @@ class Image {
     return use_fast_idct_;
   }
 
+  /**
+   * Allows the decoder to reduce the resolution of the image, if it can do so at a lower cost
+   * (e.g. with the DCT scaling of JPEG), as long as the result is at least
+   * `min_height` x `min_width`. A non-positive value means no constraint on that dimension.
+   * It's ignored when a crop window is set.
+   */
+  inline void SetDownscaleHint(int min_height, int min_width) {
+    downscale_hint_ = {min_height, min_width};
+  }
+
+  inline TensorShape<2> DownscaleHint() const {
+    return downscale_hint_;
+  }
+
+  /**
+   * Sets the function providing the memory for the decoded image, so that the decoders
+   * which know the output shape up front can decode directly into it.
+   * The other decoders ignore it - `GetImage` tells where the image was decoded.
+   */
+  inline void SetOutputAllocator(OutputAllocator output_allocator) {
+    output_allocator_ = std::move(output_allocator);
+  }
+
   virtual ~Image() = default;
   DISABLE_COPY_MOVE_ASSIGN(Image);
 
@@ -122,6 +150,11 @@ class Image {
 
   Image(const uint8_t *encoded_buffer, size_t length, DALIImageType image_type);
 
+  /**
+   * Allocates the memory for the decoded image, with the output allocator, if set
+   */
+  DLL_PUBLIC std::shared_ptr<uint8_t> AllocateOutput(const Shape &shape) const;
+
   /**
    * Gets random crop generator
    */
@@ -135,8 +168,10 @@ class Image {
   const DALIImageType image_type_;
   bool decoded_ = false;
   bool use_fast_idct_ = false;
+  TensorShape<2> downscale_hint_ = {0, 0};
   Shape shape_;
   CropWindowGenerator crop_window_generator_;
+  OutputAllocator output_allocator_;
   std::shared_ptr<uint8_t> decoded_image_ = nullptr;
 };
 
@@ -18,9 +18,43 @@
 #include "dali/image/jpeg_mem.h"
 #include "dali/util/ocv.h"
 #include "dali/core/byte_io.h"
+#include "dali/core/util.h"
 
 namespace dali {
 
+int JpegScaleDenominator(int64_t height, int64_t width, int64_t min_height, int64_t min_width) {
+  if (min_height <= 0 && min_width <= 0)
+    return 1;
+  for (int64_t denom : {8, 4, 2}) {
+    if (div_ceil(height, denom) >= min_height && div_ceil(width, denom) >= min_width)
+      return denom;
+  }
+  return 1;
+}
+
+namespace {
+
+/**
+ * @brief Downscales an image decoded at full resolution to the shape it would have,
+ *        if it was decoded with DCT scaling
+ */
+std::pair<std::shared_ptr<uint8_t>, Image::Shape>
+Downscale(std::pair<std::shared_ptr<uint8_t>, Image::Shape> decoded, int denom) {
+  if (denom == 1)
+    return decoded;
+  const auto &shape = decoded.second;
+  int h = shape[0], w = shape[1], c = shape[2];
+  int out_h = div_ceil(h, denom), out_w = div_ceil(w, denom);
+  std::shared_ptr<uint8_t> out(new uint8_t[out_h * out_w * c],
+                               [](uint8_t *data) { delete [] data; });
+  cv::Mat src(h, w, CV_8UC(c), decoded.first.get());
+  cv::Mat dst(out_h, out_w, CV_8UC(c), out.get());
+  cv::resize(src, dst, dst.size(), 0, 0, cv::INTER_AREA);
+  return {out, {out_h, out_w, c}};
+}
+
+}  // namespace
+
 JpegImage::JpegImage(const uint8_t *encoded_buffer,
                      size_t length,
                      DALIImageType image_type)
@@ -74,10 +108,17 @@ JpegImage::DecodeImpl(DALIImageType type, const uint8 *jpeg, size_t length) cons
   DALI_ENFORCE(h > 0);
   DALI_ENFORCE(w > 0);
 
+  auto crop_window_generator = GetCropWindowGenerator();
+  int scale_denom = 1;
+  if (!crop_window_generator) {
+    auto hint = DownscaleHint();
+    scale_denom = JpegScaleDenominator(h, w, hint[0], hint[1]);
+  }
+
 #ifdef DALI_USE_JPEG_TURBO
   // not supported by libjpeg-turbo
   if (type == DALI_YCbCr) {
-    return GenericImage::DecodeImpl(type, jpeg, length);
+    return Downscale(GenericImage::DecodeImpl(type, jpeg, length), scale_denom);
   }
 
   jpeg::UncompressFlags flags;
@@ -85,9 +126,9 @@ JpegImage::DecodeImpl(DALIImageType type, const uint8 *jpeg, size_t length) cons
     flags.dct_method = JDCT_FASTEST;
   }
   flags.components = c;
+  flags.ratio = scale_denom;
 
   flags.crop = false;
-  auto crop_window_generator = GetCropWindowGenerator();
   if (crop_window_generator) {
     flags.crop = true;
     TensorShape<> shape{static_cast<int>(h), static_cast<int>(w)};
@@ -108,10 +149,9 @@ JpegImage::DecodeImpl(DALIImageType type, const uint8 *jpeg, size_t length) cons
   int cropped_w = 0;
   uint8_t* result = jpeg::Uncompress(
     jpeg, length, flags, nullptr /* nwarn */,
-    [&decoded_image, &cropped_h, &cropped_w](int width, int height, int channels) -> uint8* {
-      decoded_image.reset(
-        new uint8_t[height * width * channels],
-        [](uint8_t* data){ delete [] data; } );
+    [this, &decoded_image, &cropped_h, &cropped_w](int width, int height,
+                                                   int channels) -> uint8* {
+      decoded_image = AllocateOutput({height, width, channels});
       cropped_h = height;
       cropped_w = width;
       return decoded_image.get();
@@ -119,12 +159,12 @@ JpegImage::DecodeImpl(DALIImageType type, const uint8 *jpeg, size_t length) cons
 
   if (result == nullptr) {
     // Failed to decode, fallback
-    return GenericImage::DecodeImpl(type, jpeg, length);
+    return Downscale(GenericImage::DecodeImpl(type, jpeg, length), scale_denom);
   }
 
   return {decoded_image, {cropped_h, cropped_w, c}};
 #else  // DALI_USE_JPEG_TURBO
-  return GenericImage::DecodeImpl(type, jpeg, length);
+  return Downscale(GenericImage::DecodeImpl(type, jpeg, length), scale_denom);
 #endif  // DALI_USE_JPEG_TURBO
 }
 
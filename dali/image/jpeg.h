@@ -23,6 +23,16 @@
 
 namespace dali {
 
+/**
+ * @brief Returns the largest JPEG DCT scaling denominator (1, 2, 4 or 8), for which the image
+ *        is still at least `min_height` x `min_width`
+ *
+ * The image decoded with denominator `r` has the shape of `ceil(height / r)` x `ceil(width / r)`.
+ * If both `min_height` and `min_width` are non-positive, there's no hint and 1 is returned.
+ */
+DLL_PUBLIC int JpegScaleDenominator(int64_t height, int64_t width,
+                                    int64_t min_height, int64_t min_width);
+
 class JpegImage final : public GenericImage {
  public:
   JpegImage(const uint8_t *encoded_buffer,
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "dali/image/jpeg.h"
+#include "dali/core/util.h"
 #include "dali/test/dali_test_decoder.h"
 
 namespace dali {
@@ -30,4 +32,30 @@ TYPED_TEST(JpegDecodeTest, DecodeJPEGHost) {
   this->RunTestDecode(this->jpegs_);
 }
 
+TYPED_TEST(JpegDecodeTest, DecodeJPEGHostDownscaled) {
+  const auto &imgs = this->jpegs_;
+  for (size_t img_idx = 0; img_idx < imgs.nImages(); ++img_idx) {
+    auto image = ImageFactory::CreateImage(imgs.data_[img_idx], imgs.sizes_[img_idx],
+                                           this->img_type_);
+    auto full_shape = image->PeekShape();
+    int64_t h = full_shape[0], w = full_shape[1];
+    int denom = JpegScaleDenominator(h, w, div_ceil(h, 4), div_ceil(w, 4));
+    ASSERT_GE(denom, 4);
+    image->SetDownscaleHint(div_ceil(h, 4), div_ceil(w, 4));
+    image->Decode();
+    auto shape = image->GetShape();
+    EXPECT_EQ(shape[0], div_ceil(h, denom));
+    EXPECT_EQ(shape[1], div_ceil(w, denom));
+  }
+}
+
+TEST(JpegScaleDenominator, PicksLargestScale) {
+  EXPECT_EQ(JpegScaleDenominator(3000, 4000, 0, 0), 1);
+  EXPECT_EQ(JpegScaleDenominator(3000, 4000, 224, 224), 8);
+  EXPECT_EQ(JpegScaleDenominator(3000, 4000, 376, 0), 4);
+  EXPECT_EQ(JpegScaleDenominator(3000, 4000, 0, 1000), 4);
+  EXPECT_EQ(JpegScaleDenominator(3000, 4000, 1500, 2001), 1);
+  EXPECT_EQ(JpegScaleDenominator(3001, 4000, 1501, 0), 2);
+}
+
 }  // namespace dali
@@ -60,6 +60,7 @@
 
 #include "dali/image/tiff_libtiff.h"
 #include <tiffio.h>
+#include <algorithm>
 #include <cstring>
 #include <vector>
 #include <string>
@@ -67,6 +68,7 @@
 #include <memory>
 #include "dali/kernels/imgproc/color_manipulation/color_space_conversion_impl.h"
 #include "dali/core/convert.h"
+#include "dali/core/format.h"
 #include "dali/core/span.h"
 
 #define LIBTIFF_CALL_SUCCESS 1
@@ -260,6 +262,16 @@ TiffImage_Libtiff::TiffImage_Libtiff(const uint8_t *encoded_buffer,
     TIFFGetFieldDefaulted(tif_.get(), TIFFTAG_ROWSPERSTRIP, &rows_per_strip_));
   LIBTIFF_CALL(
     TIFFGetFieldDefaulted(tif_.get(), TIFFTAG_COMPRESSION, &compression_));
+  LIBTIFF_CALL(
+    TIFFGetFieldDefaulted(tif_.get(), TIFFTAG_PLANARCONFIG, &planar_config_));
+  if (is_tiled_) {
+    LIBTIFF_CALL(
+      TIFFGetField(tif_.get(), TIFFTAG_TILELENGTH, &tile_height_));
+    LIBTIFF_CALL(
+      TIFFGetField(tif_.get(), TIFFTAG_TILEWIDTH, &tile_width_));
+    DALI_ENFORCE(tile_height_ > 0 && tile_width_ > 0,
+      make_string("Invalid tile size: ", tile_height_, "x", tile_width_));
+  }
 }
 
 Image::Shape TiffImage_Libtiff::PeekShapeImpl(const uint8_t *encoded_buffer,
@@ -309,16 +321,17 @@ TiffImage_Libtiff::DecodeImpl(DALIImageType image_type,
   }
 
   TensorShape<3> decoded_shape = {roi_h, roi_w, out_C};
-  const size_t decoded_size = volume(decoded_shape);
-  std::shared_ptr<uint8_t> decoded_img_ptr{
-    new uint8_t[decoded_size],
-    [](uint8_t* ptr){ delete [] ptr; }
-  };
+  std::shared_ptr<uint8_t> decoded_img_ptr = AllocateOutput(decoded_shape);
 
   // TODO(janton): support different types in ImageDecoder
   using InType = uint8_t;
   using OutType = uint8_t;
 
+  if (is_tiled_) {
+    DecodeTiles(decoded_img_ptr.get(), out_C, roi_y, roi_x, roi_h, roi_w, image_type);
+    return {decoded_img_ptr, decoded_shape};
+  }
+
   // allocate memory for reading tif image
   auto row_nbytes = TIFFScanlineSize(tif_.get());
   DALI_ENFORCE(row_nbytes > 0);
@@ -363,8 +376,46 @@ TiffImage_Libtiff::DecodeImpl(DALIImageType image_type,
   return {decoded_img_ptr, decoded_shape};
 }
 
+void TiffImage_Libtiff::DecodeTiles(uint8_t *out, int64_t out_C, int64_t roi_y, int64_t roi_x,
+                                    int64_t roi_h, int64_t roi_w,
+                                    DALIImageType image_type) const {
+  using InType = uint8_t;
+  using OutType = uint8_t;
+  const int64_t C = shape_[2];
+  const int64_t tile_h = tile_height_, tile_w = tile_width_;
+
+  auto tile_nbytes = TIFFTileSize(tif_.get());
+  DALI_ENFORCE(tile_nbytes > 0);
+  const int64_t tile_row_nbytes = TIFFTileRowSize(tif_.get());
+  DALI_ENFORCE(tile_row_nbytes >= tile_w * C);
+
+  std::unique_ptr<InType, void(*)(void*)> tile_buf{
+    static_cast<InType *>(_TIFFmalloc(tile_nbytes)), _TIFFfree};
+  DALI_ENFORCE(tile_buf.get() != nullptr, "Could not allocate memory");
+
+  const int64_t out_row_stride = roi_w * out_C;
+  const int64_t roi_y_end = roi_y + roi_h, roi_x_end = roi_x + roi_w;
+  // Only the tiles intersecting the ROI are read and decompressed
+  for (int64_t tile_y = roi_y / tile_h * tile_h; tile_y < roi_y_end; tile_y += tile_h) {
+    const int64_t y_begin = std::max(roi_y, tile_y);
+    const int64_t y_end = std::min(roi_y_end, tile_y + tile_h);
+    for (int64_t tile_x = roi_x / tile_w * tile_w; tile_x < roi_x_end; tile_x += tile_w) {
+      const int64_t x_begin = std::max(roi_x, tile_x);
+      const int64_t x_end = std::min(roi_x_end, tile_x + tile_w);
+      DALI_ENFORCE(TIFFReadTile(tif_.get(), tile_buf.get(), tile_x, tile_y, 0, 0) >= 0,
+        make_string("Failed to read the TIFF tile at (", tile_y, ", ", tile_x, ")"));
+      for (int64_t y = y_begin; y < y_end; y++) {
+        const InType *row_in = tile_buf.get() + (y - tile_y) * tile_row_nbytes;
+        OutType *row_out = out + (y - roi_y) * out_row_stride + (x_begin - roi_x) * out_C;
+        detail::ConvertLine(row_out, out_C, row_in, C, x_begin - tile_x, x_end - x_begin,
+                            image_type);
+      }
+    }
+  }
+}
+
 bool TiffImage_Libtiff::CanDecode(DALIImageType image_type) const {
-  return !is_tiled_
+  return (!is_tiled_ || planar_config_ == PLANARCONFIG_CONTIG)
       && bit_depth_ == 8
       && orientation_ == ORIENTATION_TOPLEFT;
 }
@@ -36,6 +36,12 @@ class TiffImage_Libtiff : public GenericImage {
   Image::Shape PeekShapeImpl(const uint8_t *encoded_buffer, size_t length) const override;
 
  private:
+  /**
+   * @brief Decodes the ROI of a tiled image, reading only the tiles which intersect it
+   */
+  void DecodeTiles(uint8_t *out, int64_t out_C, int64_t roi_y, int64_t roi_x,
+                   int64_t roi_h, int64_t roi_w, DALIImageType image_type) const;
+
   span<const uint8_t> buf_;
   size_t buf_pos_;
   std::unique_ptr<TIFF, void (*)(TIFF *)> tif_ = {nullptr, &TIFFClose};
@@ -46,6 +52,9 @@ class TiffImage_Libtiff : public GenericImage {
   uint16_t orientation_ = ORIENTATION_TOPLEFT;
   uint32_t rows_per_strip_ = 0xFFFFFFFF;
   uint16_t compression_ = COMPRESSION_NONE;
+  uint16_t planar_config_ = PLANARCONFIG_CONTIG;
+  uint32_t tile_height_ = 0;
+  uint32_t tile_width_ = 0;
 };
 
 }  // namespace dali
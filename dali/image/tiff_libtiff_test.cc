@@ -0,0 +1,108 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <tiffio.h>
+#include <unistd.h>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "dali/image/tiff_libtiff.h"
+
+namespace dali {
+
+namespace {
+
+uint8_t PixelValue(int64_t y, int64_t x, int64_t c) {
+  return (y * 31 + x * 7 + c * 101) & 0xFF;
+}
+
+/**
+ * @brief Encodes a tiled RGB TIFF with the pixels given by `PixelValue`
+ */
+std::vector<uint8_t> CreateTiledTiff(int height, int width, int tile_size, int compression) {
+  char path[] = "/tmp/dali_tiled_tiff_XXXXXX";
+  int fd = mkstemp(path);
+  EXPECT_GE(fd, 0);
+  close(fd);
+
+  const int C = 3;
+  TIFF *tif = TIFFOpen(path, "w");
+  EXPECT_NE(tif, nullptr);
+  TIFFSetField(tif, TIFFTAG_IMAGEWIDTH, width);
+  TIFFSetField(tif, TIFFTAG_IMAGELENGTH, height);
+  TIFFSetField(tif, TIFFTAG_SAMPLESPERPIXEL, C);
+  TIFFSetField(tif, TIFFTAG_BITSPERSAMPLE, 8);
+  TIFFSetField(tif, TIFFTAG_PHOTOMETRIC, PHOTOMETRIC_RGB);
+  TIFFSetField(tif, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG);
+  TIFFSetField(tif, TIFFTAG_COMPRESSION, compression);
+  TIFFSetField(tif, TIFFTAG_TILEWIDTH, tile_size);
+  TIFFSetField(tif, TIFFTAG_TILELENGTH, tile_size);
+  std::vector<uint8_t> tile(tile_size * tile_size * C);
+  for (int tile_y = 0; tile_y < height; tile_y += tile_size) {
+    for (int tile_x = 0; tile_x < width; tile_x += tile_size) {
+      for (int y = 0; y < tile_size; y++)
+        for (int x = 0; x < tile_size; x++)
+          for (int c = 0; c < C; c++)
+            tile[(y * tile_size + x) * C + c] = PixelValue(tile_y + y, tile_x + x, c);
+      EXPECT_GE(TIFFWriteTile(tif, tile.data(), tile_x, tile_y, 0, 0), 0);
+    }
+  }
+  TIFFClose(tif);
+
+  std::ifstream file(path, std::ios::binary);
+  std::vector<uint8_t> encoded{std::istreambuf_iterator<char>(file),
+                               std::istreambuf_iterator<char>()};
+  std::remove(path);
+  return encoded;
+}
+
+void CheckDecodedRoi(const std::vector<uint8_t> &encoded, DALIImageType image_type,
+                     int roi_y, int roi_x, int roi_h, int roi_w) {
+  TiffImage_Libtiff image(encoded.data(), encoded.size(), image_type);
+  image.SetCropWindowGenerator([=](const TensorShape<> &shape, const TensorLayout &) {
+    CropWindow roi;
+    roi.anchor = {roi_y, roi_x};
+    roi.shape = {roi_h, roi_w};
+    return roi;
+  });
+  image.Decode();
+  auto shape = image.GetShape();
+  ASSERT_EQ(shape, (TensorShape<3>{roi_h, roi_w, 3}));
+  auto decoded = image.GetImage();
+  for (int y = 0; y < roi_h; y++) {
+    for (int x = 0; x < roi_w; x++) {
+      for (int c = 0; c < 3; c++) {
+        int in_c = image_type == DALI_BGR ? 2 - c : c;
+        ASSERT_EQ(decoded.get()[(y * roi_w + x) * 3 + c], PixelValue(roi_y + y, roi_x + x, in_c))
+            << "at (" << y << ", " << x << ", " << c << ")";
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST(TiffLibtiffTest, TiledRoi) {
+  for (int compression : {COMPRESSION_NONE, COMPRESSION_ADOBE_DEFLATE}) {
+    auto encoded = CreateTiledTiff(100, 70, 32, compression);
+    CheckDecodedRoi(encoded, DALI_RGB, 0, 0, 100, 70);  // the whole image
+    CheckDecodedRoi(encoded, DALI_RGB, 5, 3, 20, 10);   // within one tile
+    CheckDecodedRoi(encoded, DALI_BGR, 30, 20, 40, 50);  // spanning tiles and the image edge
+  }
+}
+
+}  // namespace dali
@@ -1,4 +1,4 @@
-// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2019-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -66,6 +66,30 @@ struct MelFilterBankArgs {
   }
 };
 
+/**
+ * @brief Post-processing of the mel spectrogram, fused into the GPU mel filter bank
+ */
+struct LogMelArgs {
+  /// @brief Converts the output to decibels: `multiplier * log10(max(min_ratio, mel / s_ref))`
+  bool to_db = false;
+
+  /// @brief Multiplier of the logarithm
+  float multiplier = 10.0f;
+
+  /// @brief Reference magnitude
+  float s_ref = 1.0f;
+
+  /// @brief Minimum ratio of the magnitude to the reference
+  float min_ratio = 1e-8f;
+
+  /// @brief Normalizes each mel bin of a sample to zero mean and unit variance
+  ///        The statistics are calculated over all other dimensions of the sample.
+  bool normalize_features = false;
+
+  /// @brief Value added to the variance in the normalization
+  float epsilon = 0.0f;
+};
+
 }  // namespace audio
 }  // namespace kernels
 }  // namespace dali
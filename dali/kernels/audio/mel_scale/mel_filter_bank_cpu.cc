@@ -236,6 +236,34 @@ void MelFilterBankCpu<T>::Run(KernelContext &context,
   }
 }
 
+template <typename T>
+void MelFilterBankCpu<T>::RunFrames(KernelContext &context,
+                                    const OutTensorCPU<T> &out,
+                                    const InTensorCPU<T> &in,
+                                    int64_t frame_begin, int64_t frame_end) const {
+  DALI_ENFORCE(impl_ != nullptr);
+  int axis = impl_->Args().axis;
+  int64_t fftbin_size = in.shape[axis];
+  int64_t nfilter = out.shape[axis];
+  // the frame f is at (f / inner, :, f % inner), with the dimensions around the axis collapsed
+  int64_t inner = volume(in.shape.begin() + axis + 1, in.shape.end());
+  if (inner == 1) {
+    for (int64_t f = frame_begin; f < frame_end; f++)
+      impl_->ComputeTimeMajor(out.data + f * nfilter, in.data + f * fftbin_size,
+                              nfilter, fftbin_size);
+    return;
+  }
+  // the frames with the same outer index are adjacent in the rows of the spectrogram
+  for (int64_t f = frame_begin; f < frame_end;) {
+    int64_t outer_idx = f / inner, inner_idx = f % inner;
+    int64_t nwindows = std::min(frame_end - f, inner - inner_idx);
+    impl_->ComputeFreqMajor(out.data + (outer_idx * nfilter * inner + inner_idx),
+                            in.data + (outer_idx * fftbin_size * inner + inner_idx), nwindows,
+                            nfilter, inner, fftbin_size, inner);
+    f += nwindows;
+  }
+}
+
 template class MelFilterBankCpu<float>;
 template class MelFilterBankCpu<double>;
 
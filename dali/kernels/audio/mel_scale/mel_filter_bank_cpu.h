@@ -43,6 +43,18 @@ class DLL_PUBLIC MelFilterBankCpu {
                       const OutTensorCPU<T> &out,
                       const InTensorCPU<T> &in);
 
+  /**
+   * @brief Processes only the frames [frame_begin, frame_end) of the input
+   *
+   * The frames are the spectra along the frequency axis, indexed in the order of the remaining
+   * dimensions. `out` and `in` are the whole tensors. The disjoint ranges of frames can be
+   * processed concurrently.
+   */
+  DLL_PUBLIC void RunFrames(KernelContext &context,
+                            const OutTensorCPU<T> &out,
+                            const InTensorCPU<T> &in,
+                            int64_t frame_begin, int64_t frame_end) const;
+
  private:
   class Impl;
   std::unique_ptr<Impl> impl_;
@@ -150,6 +150,16 @@ TEST_P(MelScaleCpuTest, MelScaleCpuTest) {
     ASSERT_NEAR(expected_out_view.data[idx], out_view.data[idx], 1e-4) <<
       "Output data doesn't match reference (idx=" << idx << ")";
   }
+
+  // the same result, when the frames are processed in separate ranges
+  std::vector<T> out_frames(out_size, -1.0f);
+  OutTensorCPU<T> out_frames_view(out_frames.data(), out_shape);
+  kernel.RunFrames(ctx, out_frames_view, in_view_, nwin / 2, nwin);
+  kernel.RunFrames(ctx, out_frames_view, in_view_, 0, nwin / 2);
+  for (int idx = 0; idx < out_size; idx++) {
+    ASSERT_NEAR(out[idx], out_frames[idx], 1e-5) <<
+      "Output of RunFrames doesn't match Run (idx=" << idx << ")";
+  }
 }
 
 INSTANTIATE_TEST_SUITE_P(MelScaleCpuTest, MelScaleCpuTest, testing::Combine(
@@ -16,13 +16,22 @@
 #include <memory>
 #include "dali/kernels/audio/mel_scale/mel_filter_bank_gpu.h"
 #include "dali/core/tensor_shape_print.h"
+#include "dali/core/fast_div.h"
+#include "dali/kernels/reduce/reduce_common.cuh"
+#include "dali/kernels/reduce/reductions.h"
+#include "dali/kernels/signal/decibel/decibel_calculator.h"
 
 namespace dali {
 namespace kernels {
 namespace audio {
 
 const int kBlockDim2 = 32;
-const int kBlockDim1 = 1024;
+const int kBlockDim1 = 256;
+const int kNormBlockDimY = 8;
+/// @brief Maximum number of windows (spectra) processed by one block in the inner FFT layout
+const int kMaxTileWindows = 16;
+/// @brief Maximum size of the shared memory tile of spectra in the inner FFT layout
+const int kMaxTileBytes = 32 << 10;
 
 template <typename T>
 struct BlockDesc {
@@ -34,44 +43,65 @@ struct BlockDesc {
       int64_t frame_nwindows;
     };
     struct {  // inner-dim fft
-      int64_t block_start;
-      int64_t out_frame_size;
+      int64_t block_start_window;
+      int64_t block_nwindows;
     };
   };
 };
 
+/**
+ * @brief Banded representation of the filter bank matrix
+ *
+ * The filter `m` spans the FFT bins `start[m]` to `start[m] + offset[m+1] - offset[m] - 1`
+ * and its (normalized) weights are stored contiguously in `weights`, starting at `offset[m]`.
+ */
 template <typename T>
-__device__ T calcMel(const T* in_frame, int mel_bin,
-                     const T *weights_down, const int *interval_ends,
-                     int fft_stride, int fft_shift,
-                     T norm_factor) {
+struct MelBands {
+  const T *weights;
+  const int *start;
+  const int *offset;
+};
+
+/**
+ * @brief Calculates one mel bin - a dot product of a band of the spectrum with the filter weights
+ *
+ * @param in      pointer to the spectrum at the first bin of the band
+ * @param stride  distance between consecutive frequency bins in `in`
+ */
+template <typename T>
+__device__ DALI_FORCEINLINE T calcMelBand(const T *in, int64_t stride,
+                                          const T *__restrict__ weights, int len) {
   T out = 0;
-  int fftbin = interval_ends[mel_bin];
-  int fftbin_end = interval_ends[mel_bin + 1];
-  const T *in =  in_frame + fftbin * fft_stride + fft_shift;
-  for (; fftbin < fftbin_end; ++fftbin, in += fft_stride) {
-    auto weight_up = T(1) - weights_down[fftbin];
-    weight_up *= norm_factor;
-    out += *in * weight_up;
-  }
-  fftbin_end = interval_ends[mel_bin + 2];
-  in =  in_frame + fftbin * fft_stride + fft_shift;
-  for (; fftbin < fftbin_end; ++fftbin, in += fft_stride) {
-    auto weight_down = weights_down[fftbin];
-    weight_down *= norm_factor;
-    out += *in * weight_down;
-  }
+  for (int k = 0; k < len; k++, in += stride)
+    out += *in * weights[k];
   return out;
 }
 
+struct NoEpilogue {
+  template <typename T>
+  DALI_HOST_DEV DALI_FORCEINLINE T operator()(T x) const {
+    return x;
+  }
+};
+
+/**
+ * @brief Describes one sample for the feature normalization
+ *
+ * The sample is viewed as `outer x mel_bins x inner`.
+ */
+template <typename T>
+struct FeatureNormDesc {
+  T *data;
+  fast_div<uint64_t> inner;
+  uint64_t size;  // outer * inner
+};
+
 // For layouts where the frequency is not the innermost dimension, data is flattened into
 // 3 dimensions - frame, frequency, time
 // Every frame is treated as independent two-dimensional sample
-template <typename T>
-__global__ void MelFilterBankKernel(const BlockDesc<T> *block_desc,
-                                    const T *weights_down, const int *interval_ends,
-                                    bool normalize, const T *norm_factors,
-                                    int mel_bins) {
+template <typename T, typename Epilogue>
+__global__ void MelFilterBankKernel(const BlockDesc<T> *block_desc, MelBands<T> bands,
+                                    int mel_bins, Epilogue epilogue) {
   auto block_id = blockIdx.x;
   const T *in_frame = block_desc[block_id].in_frame;
   T *out_frame = block_desc[block_id].out_frame;
@@ -87,32 +117,115 @@ __global__ void MelFilterBankKernel(const BlockDesc<T> *block_desc,
     return;
 
   T *out = out_frame + mel_bin * nwindows + window;
-  T norm_factor = (normalize) ? norm_factors[mel_bin] : 1;
-  *out = calcMel(in_frame, mel_bin,
-                 weights_down, interval_ends,
-                 nwindows, window, norm_factor);
+  int band_start = bands.start[mel_bin];
+  int band_offset = bands.offset[mel_bin];
+  int band_len = bands.offset[mel_bin + 1] - band_offset;
+  *out = epilogue(calcMelBand(in_frame + band_start * nwindows + window, nwindows,
+                              bands.weights + band_offset, band_len));
 }
 
-// For layouts with the innermost frequency dimension, data is flattened
-// to two dimensions - time, frequency
+/**
+ * @brief Mel filter bank for layouts with the innermost frequency dimension
+ *
+ * The data is flattened to two dimensions - time, frequency.
+ * The output is a product of the (time x frequency) input and the banded filter bank matrix.
+ * Each block processes up to `kMaxTileWindows` consecutive spectra: the frequency range covered
+ * by the filters is first staged in shared memory with coalesced reads and then each thread
+ * calculates the mel bins from the tile, so that the input is read from global memory only once.
+ *
+ * @param bin_lo    first FFT bin covered by any filter
+ * @param nbins     number of FFT bins covered by the filters
+ * @param use_tile  if false, the spectra are read directly from global memory (used when
+ *                  the tile would not fit in shared memory)
+ *
+ * @remarks Dynamic shared memory size must be at least `block_nwindows * nbins * sizeof(T)`
+ *          when `use_tile` is true.
+ */
+template <typename T, typename Epilogue>
+__global__ void MelFilterBankKernelInnerFft(const BlockDesc<T> *block_desc, MelBands<T> bands,
+                                            int mel_bins, int64_t fftdim, int bin_lo, int nbins,
+                                            bool use_tile, Epilogue epilogue) {
+  extern __shared__ char shm[];
+  auto blk = block_desc[blockIdx.x];
+  int nwindows = blk.block_nwindows;
+  const T *in = blk.in_frame + blk.block_start_window * fftdim + bin_lo;
+  T *out = blk.out_frame + blk.block_start_window * mel_bins;
+
+  const T *spectra = in;
+  int64_t spectrum_stride = fftdim;
+  if (use_tile) {
+    T *tile = reinterpret_cast<T *>(shm);
+    for (int w = 0; w < nwindows; w++) {
+      for (int b = threadIdx.x; b < nbins; b += blockDim.x)
+        tile[w * nbins + b] = in[w * fftdim + b];
+    }
+    __syncthreads();
+    spectra = tile;
+    spectrum_stride = nbins;
+  }
+
+  int nout = nwindows * mel_bins;
+  for (int idx = threadIdx.x; idx < nout; idx += blockDim.x) {
+    int window = idx / mel_bins;
+    int mel_bin = idx - window * mel_bins;
+    int band_start = bands.start[mel_bin] - bin_lo;
+    int band_offset = bands.offset[mel_bin];
+    int band_len = bands.offset[mel_bin + 1] - band_offset;
+    out[idx] = epilogue(calcMelBand(spectra + window * spectrum_stride + band_start, 1,
+                                    bands.weights + band_offset, band_len));
+  }
+}
+
+/**
+ * @brief Normalizes each mel bin of each sample to zero mean and unit variance, in place
+ *
+ * One block processes one mel bin (blockIdx.x) of one sample (blockIdx.y).
+ * The mean and the variance are calculated in two passes over the (cached) data,
+ * which is then normalized in the third pass.
+ *
+ * @remarks blockDim must be (32, kNormBlockDimY)
+ */
 template <typename T>
-__global__ void MelFilterBankKernelInnerFft(const BlockDesc<T> *block_desc,
-                                            const T *weights_down, const int *interval_ends,
-                                            bool normalize, const T *norm_factors,
-                                            int mel_bins, int64_t fftdim) {
-  auto block_id = blockIdx.x;
-  auto idx = block_desc[block_id].block_start + threadIdx.x;
+__global__ void NormalizeFeaturesKernel(const FeatureNormDesc<T> *descs, int mel_bins,
+                                        float epsilon) {
+  __shared__ T shared_stat;
+  const auto &desc = descs[blockIdx.y];
+  uint64_t outer_stride = static_cast<uint64_t>(desc.inner) * mel_bins;
+  T *data = desc.data + blockIdx.x * static_cast<uint64_t>(desc.inner);
+  int tid = threadIdx.y * blockDim.x + threadIdx.x;
+  int nthreads = blockDim.x * blockDim.y;
+  auto offset = [&](uint64_t idx) {
+    uint64_t inner_idx;
+    uint64_t outer_idx = div_mod(inner_idx, idx, desc.inner);
+    return outer_idx * outer_stride + inner_idx;
+  };
+  T n = desc.size;
 
-  if (idx >= block_desc[block_id].out_frame_size)
-    return;
+  T sum = 0;
+  for (uint64_t idx = tid; idx < desc.size; idx += nthreads)
+    sum += data[offset(idx)];
+  if (BlockReduce(sum, reductions::sum()))
+    shared_stat = sum / n;
+  __syncthreads();
+  T mean = shared_stat;
+  __syncthreads();
 
-  auto window = idx / mel_bins;
-  auto mel_bin = idx % mel_bins;
-  const T *in = block_desc[block_id].in_frame;
-  T *out =  block_desc[block_id].out_frame;
-  T norm_factor = (normalize) ? norm_factors[mel_bin] : 1;
-  *(out + idx) = calcMel(in + window * fftdim, mel_bin,
-                         weights_down, interval_ends, 1, 0, norm_factor);
+  T sum_sq = 0;
+  for (uint64_t idx = tid; idx < desc.size; idx += nthreads) {
+    T d = data[offset(idx)] - mean;
+    sum_sq += d * d;
+  }
+  if (BlockReduce(sum_sq, reductions::sum())) {
+    T var = sum_sq / n + epsilon;
+    shared_stat = var ? rsqrt(var) : T(0);
+  }
+  __syncthreads();
+  T inv_stddev = shared_stat;
+
+  for (uint64_t idx = tid; idx < desc.size; idx += nthreads) {
+    T &x = data[offset(idx)];
+    x = (x - mean) * inv_stddev;
+  }
 }
 
 template <typename T>
@@ -129,13 +242,15 @@ class MelFilterBankGpu<T>::Impl : public MelFilterImplBase<T> {
       double freq = mel_scale.mel_to_hz(mel);
       interval_ends_[interval] = std::ceil(freq / hz_step_);
     }
+    BuildBands();
   }
 
-  void Setup(ScratchpadEstimator &se, const TensorListShape<> &in_shape) {
-    se.add<mm::memory_kind::device, int>(interval_ends_.size());
-    se.add<mm::memory_kind::device, T>(weights_down_.size());
-    if (args_.normalize)
-      se.add<mm::memory_kind::device, T>(norm_factors_.size());
+  void Setup(ScratchpadEstimator &se, const TensorListShape<> &in_shape,
+             const LogMelArgs &log_args) {
+    log_args_ = log_args;
+    se.add<mm::memory_kind::device, int>(band_start_.size());
+    se.add<mm::memory_kind::device, int>(band_offset_.size());
+    se.add<mm::memory_kind::device, T>(band_weights_.size());
 
     inner_fft_ = true;
     for (int s = 0; s < in_shape.size(); s++) {
@@ -148,6 +263,8 @@ class MelFilterBankGpu<T>::Impl : public MelFilterImplBase<T> {
     } else {
       SetupBlockDescsOuterFft(se, in_shape);
     }
+    if (log_args_.normalize_features)
+      SetupFeatureNormDescs(se, in_shape);
   }
 
   void Compute(const T* const* in_list, T **out_list, int ndim,
@@ -158,29 +275,90 @@ class MelFilterBankGpu<T>::Impl : public MelFilterImplBase<T> {
       FillBlockDescsOuterFft(in_list, out_list);
     }
     auto block_descs = scratchpad->ToGPU(stream, block_descs_);
-    auto interval_ends = scratchpad->ToGPU(stream, interval_ends_);
-    auto weights_down = scratchpad->ToGPU(stream, weights_down_);
-    T *norm_factors = nullptr;
-    if (args_.normalize)
-      norm_factors = scratchpad->ToGPU(stream, norm_factors_);
+    MelBands<T> bands;
+    bands.start = scratchpad->ToGPU(stream, band_start_);
+    bands.offset = scratchpad->ToGPU(stream, band_offset_);
+    bands.weights = scratchpad->ToGPU(stream, band_weights_);
+    if (log_args_.to_db) {
+      signal::MagnitudeToDecibel<T> to_db(log_args_.multiplier, log_args_.s_ref,
+                                          log_args_.min_ratio);
+      LaunchMel(block_descs, bands, to_db, stream);
+    } else {
+      LaunchMel(block_descs, bands, NoEpilogue(), stream);
+    }
+    CUDA_CALL(cudaGetLastError());
+
+    if (log_args_.normalize_features && !norm_descs_.empty()) {
+      for (size_t i = 0; i < norm_descs_.size(); i++)
+        norm_descs_[i].data = out_list[i];
+      auto norm_descs = scratchpad->ToGPU(stream, norm_descs_);
+      dim3 block(32, kNormBlockDimY);
+      dim3 grid(args_.nfilter, norm_descs_.size());
+      NormalizeFeaturesKernel<<<grid, block, 0, stream>>>(norm_descs, args_.nfilter,
+                                                          log_args_.epsilon);
+      CUDA_CALL(cudaGetLastError());
+    }
+  }
+
+  using MelFilterImplBase<T>::Args;
+
+ private:
+  /**
+   * @brief Converts the triangular filters to the banded layout consumed by the kernels
+   *
+   * The normalization factors are folded into the weights.
+   */
+  void BuildBands() {
+    int nfilter = args_.nfilter;
+    band_start_.resize(nfilter);
+    band_offset_.resize(nfilter + 1);
+    band_weights_.clear();
+    for (int m = 0; m < nfilter; m++) {
+      T norm_factor = args_.normalize ? norm_factors_[m] : T(1);
+      band_start_[m] = interval_ends_[m];
+      band_offset_[m] = band_weights_.size();
+      int fftbin = interval_ends_[m];
+      for (; fftbin < interval_ends_[m + 1]; fftbin++)
+        band_weights_.push_back((T(1) - weights_down_[fftbin]) * norm_factor);
+      for (; fftbin < interval_ends_[m + 2]; fftbin++)
+        band_weights_.push_back(weights_down_[fftbin] * norm_factor);
+    }
+    band_offset_[nfilter] = band_weights_.size();
+    bin_lo_ = interval_ends_[0];
+    nbins_ = std::max(interval_ends_[nfilter + 1] - bin_lo_, 0);
+  }
+
+  template <typename Epilogue>
+  void LaunchMel(const BlockDesc<T> *block_descs, const MelBands<T> &bands,
+                 Epilogue epilogue, cudaStream_t stream) {
     if (inner_fft_) {
+      bool use_tile = tile_windows_ > 0;
+      size_t shm_size = use_tile ? tile_windows_ * nbins_ * sizeof(T) : 0;
       MelFilterBankKernelInnerFft
-          <<<block_descs_.size(), kBlockDim1, 0, stream>>>
-            (block_descs, weights_down, interval_ends, args_.normalize,
-             norm_factors, args_.nfilter, fft_dim_);
+          <<<block_descs_.size(), kBlockDim1, shm_size, stream>>>
+            (block_descs, bands, args_.nfilter, fft_dim_, bin_lo_, nbins_, use_tile, epilogue);
     } else {
       dim3 block(kBlockDim2, std::min(args_.nfilter, kBlockDim2));
       dim3 grid(block_descs_.size(), div_ceil(args_.nfilter, kBlockDim2));
       MelFilterBankKernel
-        <<<grid, block, 0, stream>>>(block_descs, weights_down, interval_ends,
-                                     args_.normalize, norm_factors, args_.nfilter);
+        <<<grid, block, 0, stream>>>(block_descs, bands, args_.nfilter, epilogue);
     }
-    CUDA_CALL(cudaGetLastError());
   }
 
-  using MelFilterImplBase<T>::Args;
+  void SetupFeatureNormDescs(ScratchpadEstimator &se, const TensorListShape<> &in_shape) {
+    int nsamples = in_shape.num_samples();
+    norm_descs_.resize(nsamples);
+    for (int s = 0; s < nsamples; s++) {
+      auto sh = in_shape.tensor_shape_span(s);
+      uint64_t outer = volume(sh.begin(), sh.begin() + args_.axis);
+      uint64_t inner = volume(sh.begin() + args_.axis + 1, sh.end());
+      norm_descs_[s].data = nullptr;
+      norm_descs_[s].inner = inner;
+      norm_descs_[s].size = outer * inner;
+    }
+    se.add<mm::memory_kind::device, FeatureNormDesc<T>>(norm_descs_.size());
+  }
 
- private:
   void SetupBlockDescsOuterFft(ScratchpadEstimator &se, const TensorListShape<> &in_shape) {
     nframes_.clear();
     nwindows_.clear();
@@ -205,13 +383,20 @@ class MelFilterBankGpu<T>::Impl : public MelFilterImplBase<T> {
     nframes_.clear();
     nwindows_.clear();
     block_descs_.clear();
+    int64_t spectrum_bytes = static_cast<int64_t>(nbins_) * sizeof(T);
+    tile_windows_ = spectrum_bytes > 0 && spectrum_bytes <= kMaxTileBytes
+                  ? std::min<int64_t>(kMaxTileBytes / spectrum_bytes, kMaxTileWindows)
+                  : 0;
+    // without the tile, each block still produces the outputs for a group of windows
+    int windows_per_block = tile_windows_ > 0 ? tile_windows_ : kMaxTileWindows;
     auto batch_size = in_shape.num_samples();
     for (int64_t ti = 0; ti < batch_size; ++ti) {
       const auto &tshape = in_shape.tensor_shape(ti);
-      auto sample_size = volume(tshape.begin(), tshape.begin() + args_.axis) * args_.nfilter;
-      auto nblocks = div_ceil(sample_size, kBlockDim1);
-      for (int b = 0; b < nblocks; ++b) {
-        block_descs_.push_back(BlockDesc<T>{nullptr, nullptr, {b * kBlockDim1, sample_size}});
+      int64_t nwindows = volume(tshape.begin(), tshape.begin() + args_.axis);
+      nwindows_.push_back(nwindows);
+      for (int64_t w = 0; w < nwindows; w += windows_per_block) {
+        int64_t count = std::min<int64_t>(windows_per_block, nwindows - w);
+        block_descs_.push_back(BlockDesc<T>{nullptr, nullptr, {w, count}});
       }
     }
     se.add<mm::memory_kind::device, BlockDesc<T>>(block_descs_.size());
@@ -236,23 +421,27 @@ class MelFilterBankGpu<T>::Impl : public MelFilterImplBase<T> {
   }
 
   void FillBlockDescsInnerFft(const T* const* in_list, T **out_list) {
-    int block_id = 0;
-    int sample = 0;
-    while (block_id < static_cast<int>(block_descs_.size())) {
-      auto sample_size = block_descs_[block_id].out_frame_size;
-      auto nblocks = div_ceil(sample_size, kBlockDim1);
-      for (int i = 0; i < nblocks; ++i, ++block_id) {
-        block_descs_[block_id].in_frame = in_list[sample];
-        block_descs_[block_id].out_frame = out_list[sample];
+    int64_t block_id = 0;
+    for (uint64_t ti = 0; ti < nwindows_.size(); ++ti) {
+      for (int64_t w = 0; w < nwindows_[ti]; ++block_id) {
+        auto &blk = block_descs_[block_id];
+        blk.in_frame = in_list[ti];
+        blk.out_frame = out_list[ti];
+        w += blk.block_nwindows;
       }
-      ++sample;
     }
   }
 
   std::vector<int> interval_ends_;
+  std::vector<int> band_start_, band_offset_;
+  std::vector<T> band_weights_;
+  int bin_lo_ = 0, nbins_ = 0;
+  int tile_windows_ = 0;
   std::vector<int64_t> nframes_;
   std::vector<int64_t> nwindows_;
   std::vector<BlockDesc<T>> block_descs_;
+  std::vector<FeatureNormDesc<T>> norm_descs_;
+  LogMelArgs log_args_;
   int64_t fft_dim_ = 0;
   bool inner_fft_ = false;
   USE_MEL_FILTER_IMPL_MEMBERS(T);
@@ -261,7 +450,8 @@ class MelFilterBankGpu<T>::Impl : public MelFilterImplBase<T> {
 template <typename T>
 KernelRequirements MelFilterBankGpu<T>::Setup(KernelContext &context,
                                               const InListGPU<T> &in,
-                                              const MelFilterBankArgs &original_args) {
+                                              const MelFilterBankArgs &original_args,
+                                              const LogMelArgs &log_args) {
   auto args = original_args;
   args.axis = args.axis >= 0 ? args.axis : in.sample_dim() - 2;
   TensorListShape<> out_shape = in.shape;
@@ -291,7 +481,7 @@ KernelRequirements MelFilterBankGpu<T>::Setup(KernelContext &context,
         break;
     }
   }
-  impl_->Setup(se, in.shape);
+  impl_->Setup(se, in.shape, log_args);
   req.scratch_sizes = se.sizes;
   return req;
 }
@@ -1,4 +1,4 @@
-// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2020-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -36,7 +36,8 @@ class DLL_PUBLIC MelFilterBankGpu {
 
   DLL_PUBLIC KernelRequirements Setup(KernelContext &context,
                                       const InListGPU<T> &in,
-                                      const MelFilterBankArgs &args);
+                                      const MelFilterBankArgs &args,
+                                      const LogMelArgs &log_args = {});
 
   DLL_PUBLIC void Run(KernelContext &context,
                       OutListGPU<T> &out,
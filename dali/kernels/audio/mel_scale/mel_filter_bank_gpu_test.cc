@@ -1,4 +1,4 @@
-// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2020-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
 #include <random>
 #include <tuple>
 #include <vector>
@@ -21,6 +23,7 @@
 #include "dali/kernels/audio/mel_scale/mel_filter_bank_gpu.h"
 #include "dali/kernels/audio/mel_scale/mel_filter_bank_test.h"
 #include "dali/kernels/kernel_manager.h"
+#include "dali/kernels/signal/decibel/decibel_calculator.h"
 
 namespace dali {
 namespace kernels {
@@ -61,9 +64,11 @@ class MelScaleGpuTest : public TestBase {
   float sample_rate_ = 16000, freq_low_ = 0, freq_high_ = 8000;
   TestTensorList<float> in_;
   int64_t axis_;
+
+  void RunTest(const LogMelArgs &log_args = {});
 };
 
-TEST_P(MelScaleGpuTest, MelScaleGpuTest) {
+void MelScaleGpuTest::RunTest(const LogMelArgs &log_args) {
   using T = float;
   HtkMelScale<float> mel_scale;
   constexpr int ndim = 4;
@@ -131,6 +136,38 @@ TEST_P(MelScaleGpuTest, MelScaleGpuTest) {
     }
   }
 
+  if (log_args.to_db) {
+    signal::MagnitudeToDecibel<float> to_db(log_args.multiplier, log_args.s_ref,
+                                            log_args.min_ratio);
+    for (auto &sample : expected_out)
+      for (auto &x : sample)
+        x = to_db(x);
+  }
+
+  if (log_args.normalize_features) {
+    for (int b = 0; b < batch_size; ++b) {
+      int64_t n = nframes[b] * nwin[b];
+      for (int j = 0; j < nfilter_; j++) {
+        auto at = [&](int s, int t) -> float & {
+          return expected_out[b][(s * nfilter_ + j) * nwin[b] + t];
+        };
+        double sum = 0, sum_sq = 0;
+        for (int s = 0; s < nframes[b]; ++s)
+          for (int t = 0; t < nwin[b]; t++)
+            sum += at(s, t);
+        double mean = sum / n;
+        for (int s = 0; s < nframes[b]; ++s)
+          for (int t = 0; t < nwin[b]; t++)
+            sum_sq += (at(s, t) - mean) * (at(s, t) - mean);
+        double var = sum_sq / n + log_args.epsilon;
+        double inv_stddev = var ? 1 / std::sqrt(var) : 0;
+        for (int s = 0; s < nframes[b]; ++s)
+          for (int t = 0; t < nwin[b]; t++)
+            at(s, t) = (at(s, t) - mean) * inv_stddev;
+      }
+    }
+  }
+
   KernelContext ctx;
   ctx.gpu.stream = 0;
   kernels::audio::MelFilterBankArgs args;
@@ -148,7 +185,7 @@ TEST_P(MelScaleGpuTest, MelScaleGpuTest) {
   kmgr.Initialize<Kernel>();
   kmgr.Resize<Kernel>(1, 1);
   auto in_view = in_.gpu();
-  auto req = kmgr.Setup<Kernel>(0, ctx, in_view, args);
+  auto req = kmgr.Setup<Kernel>(0, ctx, in_view, args, log_args);
   ASSERT_EQ(out_shape, req.output_shapes[0]);
   TestTensorList<float> out;
   out.reshape(out_shape);
@@ -156,15 +193,32 @@ TEST_P(MelScaleGpuTest, MelScaleGpuTest) {
   auto out_view = out.gpu();
   kmgr.Run<Kernel>(0, 0, ctx, out_view, in_view);
   auto out_view_cpu = out.cpu();
+  float eps = log_args.to_db || log_args.normalize_features ? 1e-3 : 1e-5;
   CUDA_CALL(cudaStreamSynchronize(0));
   for (int b = 0; b < batch_size; ++b) {
     for (int idx = 0; idx < out_sizes[b]; idx++) {
-      ASSERT_NEAR(expected_out[b][idx], out_view_cpu.tensor_data(b)[idx], 1e-5) <<
+      // the error grows with the number of FFT bins covered by a filter
+      float tolerance = eps * std::max(1.0f, std::abs(expected_out[b][idx]));
+      ASSERT_NEAR(expected_out[b][idx], out_view_cpu.tensor_data(b)[idx], tolerance) <<
         "Output data doesn't match in sample " << b << " reference (idx=" << idx << ")";
     }
   }
 }
 
+TEST_P(MelScaleGpuTest, MelScaleGpuTest) {
+  RunTest();
+}
+
+TEST_P(MelScaleGpuTest, LogMel) {
+  LogMelArgs log_args;
+  log_args.to_db = true;
+  log_args.min_ratio = 1e-6f;
+  RunTest(log_args);
+  log_args.normalize_features = true;
+  log_args.epsilon = 1e-6f;
+  RunTest(log_args);
+}
+
 INSTANTIATE_TEST_SUITE_P(MelScaleGpuTestpuTest, MelScaleGpuTest, testing::Combine(
     testing::Values(std::vector<TensorShape<>>{TensorShape<>{10, 4, 6, 12}},
                     std::vector<TensorShape<>>{TensorShape<>{4, 5, 6, 5},
@@ -175,6 +229,17 @@ INSTANTIATE_TEST_SUITE_P(MelScaleGpuTestpuTest, MelScaleGpuTest, testing::Combin
     testing::Values(5000.0f, 8000.0f),  // fmax
     testing::Values(0, 2, 3)));  // axis
 
+// Inner FFT layout with realistic FFT sizes; the largest one doesn't fit in the shared memory tile
+INSTANTIATE_TEST_SUITE_P(MelScaleGpuLargeFftTest, MelScaleGpuTest, testing::Combine(
+    testing::Values(std::vector<TensorShape<>>{TensorShape<>{2, 3, 20, 513},
+                                               TensorShape<>{1, 2, 7, 513}},
+                    std::vector<TensorShape<>>{TensorShape<>{1, 1, 3, 16385}}),  // shape
+    testing::Values(64),  // nfilter
+    testing::Values(16000.0f),  // sample rate
+    testing::Values(0.0f, 300.0f),  // fmin
+    testing::Values(8000.0f),  // fmax
+    testing::Values(3)));  // axis
+
 }  // namespace test
 }  // namespace audio
 }  // namespace kernels
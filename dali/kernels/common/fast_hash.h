@@ -1,4 +1,4 @@
-// Copyright (c) 2021, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -17,8 +17,10 @@
 
 #include <cstdint>
 #include <cstddef>
+#include <cstring>
 #include <functional>
 #include "dali/core/force_inline.h"
+#include "dali/core/host_dev.h"
 
 namespace dali {
 namespace kernels {
@@ -47,11 +49,22 @@ struct fast_hash_t {
   }
 };
 
-DALI_FORCEINLINE
+DALI_HOST_DEV DALI_FORCEINLINE
 constexpr uint32_t rotl(uint32_t x, uint8_t r) {
   return (x << r) | (x >> (32-r));
 }
 
+/**
+ * @brief Loads a 32-bit word from a possibly unaligned address
+ */
+DALI_HOST_DEV DALI_FORCEINLINE
+uint32_t load_u32(const uint8_t *ptr) {
+  uint32_t word;
+  memcpy(&word, ptr, sizeof(word));
+  return word;
+}
+
+DALI_HOST_DEV
 inline void fast_hash(fast_hash_t &hash, const void *data, size_t n) {
   // Loosely based on xxHash 3.
   //
@@ -65,7 +78,10 @@ inline void fast_hash(fast_hash_t &hash, const void *data, size_t n) {
 
   size_t offset = 0;
   for (; offset + 32 <= n; offset += 32) {
-    const uint32_t *data32 = reinterpret_cast<const uint32_t*>(data8 + offset);
+    const uint8_t *block = data8 + offset;
+    uint32_t data32[8];
+    for (int i = 0; i < 8; i++)
+      data32[i] = load_u32(block + 4 * i);
     fast_hash_t prev = hash;
 
     // Hash entries are cycled (see index at prev.data) in order to distribute.
@@ -84,8 +100,7 @@ inline void fast_hash(fast_hash_t &hash, const void *data, size_t n) {
   // proces trailing 32-bit words
   int k = 0;
   for (; offset + 4 <= n; offset += 4, k++) {
-    const uint32_t *data32 = reinterpret_cast<const uint32_t*>(data8 + offset);
-    hash.data[k] += (rotl(hash.data[(k-1) & 7], 13) + *data32 + bias) * prime;
+    hash.data[k] += (rotl(hash.data[(k-1) & 7], 13) + load_u32(data8 + offset) + bias) * prime;
   }
   // Process trailing bytes - make sure that the number of trailing constant values (including 0)
   // changes the output.
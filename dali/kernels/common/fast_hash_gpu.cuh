@@ -0,0 +1,91 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_KERNELS_COMMON_FAST_HASH_GPU_CUH_
+#define DALI_KERNELS_COMMON_FAST_HASH_GPU_CUH_
+
+#include <cuda_runtime.h>
+#include <cstdint>
+#include <vector>
+#include "dali/core/cuda_error.h"
+#include "dali/core/cuda_utils.h"
+#include "dali/core/dev_buffer.h"
+#include "dali/core/util.h"
+#include "dali/kernels/common/fast_hash.h"
+
+namespace dali {
+namespace kernels {
+namespace fast_hash_impl {
+
+static constexpr int64_t kMinChunkSize = 4096;
+static constexpr int64_t kMaxChunks = 1 << 15;
+static constexpr int kBlockSize = 256;
+
+inline int64_t GetChunkSize(int64_t bytes) {
+  // a multiple of 32 bytes, so only the last chunk has a partial block
+  return align_up(cuda_max(kMinChunkSize, div_ceil(bytes, kMaxChunks)), 32);
+}
+
+template <typename T>
+__global__ void ChunkHashKernel(fast_hash_t *hashes, const T *data, int64_t bytes,
+                                int64_t chunk_size, int64_t nchunks) {
+  int64_t chunk = static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+  if (chunk >= nchunks)
+    return;
+  int64_t start = chunk * chunk_size;
+  int64_t end = cuda_min(bytes, start + chunk_size);
+  fast_hash_t hash = {};
+  fast_hash(hash, reinterpret_cast<const uint8_t *>(data) + start, end - start);
+  hashes[chunk] = hash;
+}
+
+}  // namespace fast_hash_impl
+
+/**
+ * @brief Computes a 256-bit hash of `count` elements of `data`, stored in device memory
+ *
+ * The data is split into chunks which are hashed in parallel with `fast_hash`; the hashes of
+ * the chunks are then hashed on the host. The result is different than `fast_hash` of the same
+ * data, so the two should not be mixed.
+ *
+ * @remarks This function synchronizes the stream.
+ *
+ * @param chunk_hashes  device scratch buffer, resized as needed
+ * @param host_hashes   host scratch buffer, resized as needed
+ */
+template <typename T>
+void fast_hash_gpu(fast_hash_t &hash, const T *data, int64_t count,
+                   DeviceBuffer<fast_hash_t> &chunk_hashes,
+                   std::vector<fast_hash_t> &host_hashes,
+                   cudaStream_t stream) {
+  using namespace fast_hash_impl;  // NOLINT
+  int64_t bytes = count * sizeof(T);
+  int64_t chunk_size = GetChunkSize(bytes);
+  int64_t nchunks = div_ceil(bytes, chunk_size);
+  host_hashes.resize(nchunks);
+  if (nchunks > 0) {
+    chunk_hashes.resize(nchunks, stream);
+    ChunkHashKernel<<<div_ceil(nchunks, kBlockSize), kBlockSize, 0, stream>>>(
+        chunk_hashes.data(), data, bytes, chunk_size, nchunks);
+    CUDA_CALL(cudaGetLastError());
+    copyD2H(host_hashes.data(), chunk_hashes.data(), nchunks, stream);
+    CUDA_CALL(cudaStreamSynchronize(stream));
+  }
+  fast_hash(hash, host_hashes.data(), nchunks * sizeof(fast_hash_t));
+}
+
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_COMMON_FAST_HASH_GPU_CUH_
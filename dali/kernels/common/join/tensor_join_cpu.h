@@ -15,6 +15,7 @@
 #ifndef DALI_KERNELS_COMMON_JOIN_TENSOR_JOIN_CPU_H_
 #define DALI_KERNELS_COMMON_JOIN_TENSOR_JOIN_CPU_H_
 
+#include <algorithm>
 #include <vector>
 #include "dali/kernels/kernel.h"
 #include "dali/kernels/common/join/tensor_join_shape.h"
@@ -25,18 +26,15 @@ namespace dali {
 namespace kernels {
 namespace tensor_join {
 
-template<typename T>
-void
-ConcatenateTensors(TensorView<StorageCPU, T> output,
-                   span<const TensorView<StorageCPU, const T>> inputs,
-                   int axis) {
+template <typename OutputIterator, typename T>
+void ConcatenateTensors(OutputIterator out, const TensorShape<> &joined_shape,
+                        span<const TensorView<StorageCPU, const T>> inputs, int axis) {
   SmallVector<int64_t, 64> copy_sizes;
   copy_sizes.resize(inputs.size());
   for (int t = 0; t < inputs.size(); t++) {
     copy_sizes[t] = volume(inputs[t].shape.begin() + axis, inputs[t].shape.end());
   }
-  auto nouter = volume(output.shape.begin(), output.shape.begin() + axis);
-  auto *out = output.data;
+  auto nouter = volume(joined_shape.begin(), joined_shape.begin() + axis);
   for (ptrdiff_t outer = 0; outer < nouter; outer++) {
     for (int t = 0; t < inputs.size(); t++) {
       auto *src = inputs[t].data + outer * copy_sizes[t];
@@ -47,6 +45,72 @@ ConcatenateTensors(TensorView<StorageCPU, T> output,
   }
 }
 
+template<typename T>
+void
+ConcatenateTensors(TensorView<StorageCPU, T> output,
+                   span<const TensorView<StorageCPU, const T>> inputs,
+                   int axis) {
+  ConcatenateTensors(output.data, output.shape, inputs, axis);
+}
+
+/**
+ * @brief An output iterator which visits, in order, the elements of a joined tensor placed at
+ *        the beginning of a larger, padded tensor.
+ */
+template <typename T>
+class PaddedOutputIterator {
+ public:
+  PaddedOutputIterator(T *data, const TensorShape<> &padded_shape,
+                       const TensorShape<> &joined_shape)
+  : ptr_(data), extent_(joined_shape.begin(), joined_shape.end()) {
+    int D = padded_shape.size();
+    pos_.resize(D, 0);
+    skip_.resize(D);
+    int64_t stride = 1;
+    for (int d = D - 1; d >= 0; d--) {
+      skip_[d] = (padded_shape[d] - joined_shape[d]) * stride;
+      stride *= padded_shape[d];
+    }
+  }
+
+  T &operator*() const { return *ptr_; }
+
+  PaddedOutputIterator &operator++() {
+    ptr_++;
+    for (int d = pos_.size() - 1; d >= 0; d--) {
+      if (++pos_[d] < extent_[d])
+        break;
+      pos_[d] = 0;
+      ptr_ += skip_[d];
+    }
+    return *this;
+  }
+
+  PaddedOutputIterator operator++(int) {
+    PaddedOutputIterator ret = *this;
+    ++*this;
+    return ret;
+  }
+
+ private:
+  T *ptr_;
+  SmallVector<int64_t, 6> extent_, pos_, skip_;
+};
+
+/**
+ * @brief Joins the inputs into the beginning of a padded output; the rest is set to `fill_value`
+ */
+template<typename T>
+void
+ConcatenateTensorsPadded(TensorView<StorageCPU, T> output,
+                         const TensorShape<> &joined_shape,
+                         span<const TensorView<StorageCPU, const T>> inputs,
+                         int axis, T fill_value) {
+  std::fill(output.data, output.data + output.num_elements(), fill_value);
+  ConcatenateTensors(PaddedOutputIterator<T>(output.data, output.shape, joined_shape),
+                     joined_shape, inputs, axis);
+}
+
 }  // namespace tensor_join
 
 /**
@@ -161,6 +225,37 @@ struct TensorJoinCPU {
     tensor_join::ConcatenateTensors(out, in, axis_);
   }
 
+  /**
+   * @brief Joins the inputs and pads the result to the shape of `out`
+   *
+   * @param out        output tensor; its extents must not be smaller than that of the joined
+   *                   tensor (as returned by Setup)
+   * @param in         input tensors
+   * @param fill_value the value of the padding
+   */
+  void Run(KernelContext &ctx, OutTensorCPU<T, output_dims> out,
+           span<const InTensorCPU<T>> in, T fill_value) {
+    if (out.shape == output_shape_) {
+      Run(ctx, out, in);
+      return;
+    }
+    if (in.size() != n_input_tensors_) {
+      throw std::invalid_argument(make_string(
+              "Input must have the same number of tensors as was specified in call to Setup.\n"
+              "Expected: ", n_input_tensors_, "\nActual: ", in.size()));
+    }
+    bool fits = out.shape.sample_dim() == output_shape_.sample_dim();
+    for (int d = 0; fits && d < out.shape.sample_dim(); d++)
+      fits = out.shape[d] >= output_shape_[d];
+    if (!fits) {
+      throw std::invalid_argument(
+              make_string("Output is too small for the joined tensor.\nJoined shape: ",
+                          output_shape_, "\nOutput shape: ", out.shape));
+    }
+
+    tensor_join::ConcatenateTensorsPadded(out, output_shape_, in, axis_, fill_value);
+  }
+
 
   int axis_ = -1, n_input_tensors_ = -1;
   TensorShape<dims> output_shape_;
@@ -276,6 +276,46 @@ TEST(TensorJoinCpuTest, ConcatKernelDifferentExtentTest) {
 }
 
 
+TEST(TensorJoinCpuTest, PadToMaxShape) {
+  TensorListShape<> shape = {{2, 5, 3}, {4, 1, 3}, {1, 2, 7}};
+  TensorListShape<> ref = {{4, 5, 7}, {4, 5, 7}, {4, 5, 7}};
+  tensor_join::PadToMaxShape(shape);
+  EXPECT_EQ(shape, ref);
+}
+
+
+TEST(TensorJoinCpuTest, ConcatKernelPaddedTest) {
+  using std::vector;
+  vector<vector<int>> arr = {{1, 2, 3,
+                              4, 5, 6},
+                             {7,
+                              8}};
+  vector<TensorShape<>> sh = {{2, 3},
+                              {2, 1}};
+  vector<TensorView<StorageCPU, const int>> in;
+  for (size_t i = 0; i < arr.size(); i++) {
+    in.emplace_back(arr[i].data(), sh[i]);
+  }
+
+  vector<int> ref = { 1,  2,  3,  7, -1,
+                      4,  5,  6,  8, -1,
+                     -1, -1, -1, -1, -1};
+  vector<int> out(ref.size());
+  TensorShape<> padded_shape = {3, 5};
+
+  TensorConcatCPU<int> kernel;
+  KernelContext ctx;
+  auto req = kernel.Setup(ctx, make_cspan(sh), 1);
+  EXPECT_EQ(req.output_shapes[0][0], TensorShape<>(2, 4));
+  kernel.Run(ctx, {out.data(), padded_shape}, make_cspan(in), -1);
+  EXPECT_EQ(out, ref);
+
+  TensorShape<> too_small = {3, 3};
+  EXPECT_THROW(kernel.Run(ctx, {out.data(), too_small}, make_cspan(in), -1),
+               std::invalid_argument);
+}
+
+
 }  // namespace test
 }  // namespace kernels
 }  // namespace dali
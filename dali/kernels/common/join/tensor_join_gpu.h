@@ -15,6 +15,7 @@
 #ifndef DALI_KERNELS_COMMON_JOIN_TENSOR_JOIN_GPU_H_
 #define DALI_KERNELS_COMMON_JOIN_TENSOR_JOIN_GPU_H_
 
+#include <cstring>
 #include "dali/kernels/kernel.h"
 #include "dali/kernels/common/type_erasure.h"
 #include "dali/kernels/common/join/tensor_join_gpu_impl.h"
@@ -52,6 +53,8 @@ class TensorJoinGPU : public tensor_join::TensorJoinImplGPU<type_of_size<sizeof(
    *                          * 0 to sample_dim when `new_axis` is true
    *                          * 0 to sample_dim - 1 when `new_axis` is false
    *                        where sample_dim is the dimensionality of the inputs.
+   * @param pad             if true, the output tensors are padded to a uniform shape,
+   *                        equal to the maximum extent in each dimension across the batch
    *
    * @remarks Inputs must have the same dimensionality.
    * Respective tensors in the input must have the same shape (if new_axis == `true`) or can
@@ -60,12 +63,13 @@ class TensorJoinGPU : public tensor_join::TensorJoinImplGPU<type_of_size<sizeof(
   KernelRequirements Setup(KernelContext &ctx,
                            const std::function<const TensorListShape<> *(int)> &get_input_shape,
                            int num_inputs,
-                           int axis) {
+                           int axis,
+                           bool pad = false) {
     ScratchpadEstimator se;
     KernelRequirements req;
     req.output_shapes.resize(1);
     se.add<mm::memory_kind::host, const InListU *>(num_inputs);
-    Base::Setup(req.output_shapes[0], se, get_input_shape, num_inputs, axis);
+    Base::Setup(req.output_shapes[0], se, get_input_shape, num_inputs, axis, pad);
     req.scratch_sizes = se.sizes;
     return req;
   }
@@ -80,6 +84,8 @@ class TensorJoinGPU : public tensor_join::TensorJoinImplGPU<type_of_size<sizeof(
    *                          * 0 to sample_dim when `new_axis` is true
    *                          * 0 to sample_dim - 1 when `new_axis` is false
    *                        where sample_dim is the dimensionality of the inputs.
+   * @param pad             if true, the output tensors are padded to a uniform shape,
+   *                        equal to the maximum extent in each dimension across the batch
    *
    * @remarks Inputs must have the same dimensionality.
    * Respective tensors in the input must have the same shape (if new_axis == `true`) or can
@@ -87,8 +93,9 @@ class TensorJoinGPU : public tensor_join::TensorJoinImplGPU<type_of_size<sizeof(
    */
   KernelRequirements Setup(KernelContext &ctx,
                            span<const InListGPU<T>> inputs,
-                           int axis) {
-    return Setup(ctx, [&](int idx){ return &inputs[idx].shape; }, inputs.size(), axis);
+                           int axis,
+                           bool pad = false) {
+    return Setup(ctx, [&](int idx){ return &inputs[idx].shape; }, inputs.size(), axis, pad);
   }
 
   /**
@@ -97,14 +104,16 @@ class TensorJoinGPU : public tensor_join::TensorJoinImplGPU<type_of_size<sizeof(
    * @param ctx       Kernel context (CUDA stream, scratchpad)
    * @param out       Output tensor list
    * @param in_lists  List of pointers to the inputs
+   * @param fill_value The value of the padding, if padding was requested in Setup
    */
   template <int in_ndim>
   void Run(KernelContext &ctx, const OutListGPU<T> &out,
-           span<const InListGPU<T, in_ndim> *const> in_lists) {
+           span<const InListGPU<T, in_ndim> *const> in_lists, const T &fill_value = {}) {
     auto *lists = reinterpret_cast<const InListGPU<U, in_ndim> *const*>(in_lists.data());
     Base::Run(ctx,
         reinterpret_cast<const OutListGPU<U> &>(out),
-        make_span(lists, in_lists.size()));
+        make_span(lists, in_lists.size()),
+        AsU(fill_value));
   }
 
   /**
@@ -113,15 +122,24 @@ class TensorJoinGPU : public tensor_join::TensorJoinImplGPU<type_of_size<sizeof(
    * @param ctx       Kernel context (CUDA stream, scratchpad)
    * @param out       Output tensor list
    * @param in_lists  List of pointers to the inputs
+   * @param fill_value The value of the padding, if padding was requested in Setup
    */
   template <int in_ndim>
   void Run(KernelContext &ctx, const OutListGPU<T> &out,
-           span<const InListGPU<T, in_ndim>> in_lists) {
+           span<const InListGPU<T, in_ndim>> in_lists, const T &fill_value = {}) {
     int njoin = in_lists.size();
     auto *in_list_ptrs = ctx.scratchpad->AllocateHost<const InListU *>(njoin);
     for (int i = 0; i < njoin; i++)
       in_list_ptrs[i] = reinterpret_cast<const InListU *>(&in_lists[i]);
-    Base::Run(ctx, reinterpret_cast<const OutListGPU<U> &>(out), make_span(in_list_ptrs, njoin));
+    Base::Run(ctx, reinterpret_cast<const OutListGPU<U> &>(out), make_span(in_list_ptrs, njoin),
+              AsU(fill_value));
+  }
+
+ private:
+  static U AsU(const T &value) {
+    U u;
+    std::memcpy(&u, &value, sizeof(U));
+    return u;
   }
 };
 
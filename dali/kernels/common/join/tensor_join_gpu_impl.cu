@@ -26,21 +26,30 @@ void TensorJoinImplGPU<T, new_axis>::Setup(
         ScratchpadEstimator &se,
         const std::function<const TensorListShape<> *(int)> &get_input_shape,
         int num_inputs,
-        int axis) {
+        int axis,
+        bool pad) {
   JoinedShape(output_shape, get_input_shape, num_inputs, axis, new_axis);
   int N = output_shape.num_samples();
   se.add<mm::memory_kind::device, OutputDesc<T>>(N);
   se.add<mm::memory_kind::device, InputDesc<T>>(num_inputs * N);
   se.add<mm::memory_kind::host, OutputDesc<T>>(N);
   se.add<mm::memory_kind::host, InputDesc<T>>(num_inputs * N);
+  if (pad) {
+    joined_shape_ = output_shape;
+    PadToMaxShape(output_shape);
+    se.add<mm::memory_kind::device, PadDesc<T>>(N);
+    se.add<mm::memory_kind::host, PadDesc<T>>(N);
+  }
   axis_ = axis;
+  pad_ = pad;
 }
 
 template <typename T, bool new_axis>
 void TensorJoinImplGPU<T, new_axis>::Run(
         KernelContext &ctx,
         const OutListGPU<T> &out,
-        span<const InListGPU<T> *const> in_lists) {
+        span<const InListGPU<T> *const> in_lists,
+        T fill_value) {
   int njoin = in_lists.size();
   int N = out.num_samples();
   int N_in = N * njoin;
@@ -52,16 +61,24 @@ void TensorJoinImplGPU<T, new_axis>::Run(
 
   OutputDesc<T> *out_descs_gpu = nullptr;
   InputDesc<T> *in_descs_gpu = nullptr;
+  PadDesc<T> *pad_descs_gpu = nullptr;
 
-  std::tie(out_descs_gpu, in_descs_gpu) = ctx.scratchpad->ToContiguousGPU(
-    ctx.gpu.stream, output_descs_cpu, input_descs_cpu);
+  if (pad_) {
+    auto pad_descs_cpu = make_span(ctx.scratchpad->AllocateHost<PadDesc<T>>(N), N);
+    FillPadDescs(pad_descs_cpu, joined_shape_, out.shape, fill_value);
+    std::tie(out_descs_gpu, in_descs_gpu, pad_descs_gpu) = ctx.scratchpad->ToContiguousGPU(
+      ctx.gpu.stream, output_descs_cpu, input_descs_cpu, pad_descs_cpu);
+  } else {
+    std::tie(out_descs_gpu, in_descs_gpu) = ctx.scratchpad->ToContiguousGPU(
+      ctx.gpu.stream, output_descs_cpu, input_descs_cpu);
+  }
 
   int64_t avg_size = out.num_elements() / N;
   dim3 grid(std::max(static_cast<int>(avg_size / 2048), 32), N);
   dim3 block(256);  // tuned!
 
   JoinTensorsKernel<<<grid, block, 0, ctx.gpu.stream>>>(
-    out_descs_gpu, in_descs_gpu, njoin);
+    out_descs_gpu, in_descs_gpu, njoin, pad_descs_gpu);
 }
 
 template class TensorJoinImplGPU<type_of_size<1>, false>;
@@ -16,9 +16,13 @@
 #define DALI_KERNELS_COMMON_JOIN_TENSOR_JOIN_GPU_IMPL_CUH_
 
 #include <cuda_runtime.h>
+#include "dali/core/error_handling.h"
 #include "dali/core/fast_div.h"
+#include "dali/core/format.h"
 #include "dali/core/math_util.h"
 #include "dali/core/static_switch.h"
+#include "dali/core/tensor_shape.h"
+#include "dali/core/tensor_shape_print.h"
 
 namespace dali {
 namespace kernels {
@@ -45,6 +49,32 @@ struct OutputDesc {
   uint64_t total_size;
 };
 
+/**
+ * @brief Maximum number of dimensions of a padded output, after collapsing the unpadded ones
+ */
+static constexpr int kMaxPadNDim = 6;
+
+/**
+ * @brief Describes how a joined tensor is placed in a larger, padded output tensor
+ *
+ * The joined tensor occupies the beginning of each padded dimension; the remaining elements
+ * are set to `fill_value`. Dimensions which don't need padding are collapsed with their outer
+ * neighbours.
+ */
+template <typename Element>
+struct PadDesc {
+  // Number of (collapsed) dimensions; 0 if the output doesn't need any padding
+  int ndim;
+
+  // Strides of the padded output; the innermost stride is always 1 and is skipped
+  fast_div<uint64_t> padded_stride[kMaxPadNDim - 1];
+
+  uint64_t joined_stride[kMaxPadNDim - 1];
+  uint64_t joined_extent[kMaxPadNDim];
+
+  Element fill_value;
+};
+
 /**
  * @brief A guided binary search for a tensor at given offset
  *
@@ -132,6 +162,21 @@ DALI_HOST_DEV int FindTensor(uint64_t offset, float guess_tensor_mul,
 }
 
 
+template <int static_njoin, typename Element>
+__device__ __forceinline__ Element GetJoinedElement(uint64_t offset,
+                                                    const OutputDesc<Element> &out,
+                                                    const InputDesc<Element> *__restrict__ in,
+                                                    int njoin) {
+  uint64_t join_offset;
+  uint64_t outer = div_mod(join_offset, offset, out.outer_stride);
+
+  int t = FindTensor(join_offset, out.guess_tensor_mul, in, njoin,
+                      std::integral_constant<int, static_njoin>());
+
+  ptrdiff_t offset_in_tensor = join_offset - in[t].join_offset;
+  return in[t].data[offset_in_tensor + outer * in[t].outer_stride];
+}
+
 template <int static_njoin, typename Element>
 __device__ void JoinTensors(OutputDesc<Element> out,
                             const InputDesc<Element> *__restrict__ in,
@@ -140,23 +185,64 @@ __device__ void JoinTensors(OutputDesc<Element> out,
   uint64_t out_offset = threadIdx.x + block_size * blockIdx.x;
   uint64_t step = block_size * gridDim.x;
   for (; out_offset < out.total_size; out_offset += step) {
-    uint64_t join_offset;
-    uint64_t outer = div_mod(join_offset, out_offset, out.outer_stride);
+    out.data[out_offset] = GetJoinedElement<static_njoin>(out_offset, out, in, njoin);
+  }
+}
 
-    int t = FindTensor(join_offset, out.guess_tensor_mul, in, njoin,
-                        std::integral_constant<int, static_njoin>());
+/**
+ * @brief Translates an offset in the padded output to an offset in the joined tensor
+ *
+ * @return false, if the offset points to the padding
+ */
+template <typename Element>
+DALI_HOST_DEV bool PaddedToJoinedOffset(uint64_t &joined_offset, uint64_t padded_offset,
+                                        const PadDesc<Element> &pad) {
+  joined_offset = 0;
+  int d = 0;
+  for (; d < pad.ndim - 1; d++) {
+    uint64_t idx = div_mod(padded_offset, padded_offset, pad.padded_stride[d]);
+    if (idx >= pad.joined_extent[d])
+      return false;
+    joined_offset += idx * pad.joined_stride[d];
+  }
+  if (padded_offset >= pad.joined_extent[d])
+    return false;
+  joined_offset += padded_offset;
+  return true;
+}
 
-    ptrdiff_t offset_in_tensor = join_offset - in[t].join_offset;
-    out.data[out_offset] = in[t].data[offset_in_tensor + outer * in[t].outer_stride];
+template <int static_njoin, typename Element>
+__device__ void JoinTensorsPadded(OutputDesc<Element> out,
+                                  const PadDesc<Element> &pad,
+                                  const InputDesc<Element> *__restrict__ in,
+                                  int njoin) {
+  uint64_t block_size = static_cast<uint64_t>(blockDim.x);
+  uint64_t out_offset = threadIdx.x + block_size * blockIdx.x;
+  uint64_t step = block_size * gridDim.x;
+  for (; out_offset < out.total_size; out_offset += step) {
+    uint64_t joined_offset;
+    out.data[out_offset] = PaddedToJoinedOffset(joined_offset, out_offset, pad)
+      ? GetJoinedElement<static_njoin>(joined_offset, out, in, njoin)
+      : pad.fill_value;
   }
 }
 
+/**
+ * @param pad padding descriptors, one per sample; if null, the outputs are not padded
+ */
 template <typename Element>
 __global__ void JoinTensorsKernel(const OutputDesc<Element> *__restrict__ out,
                                   const InputDesc<Element> *__restrict__ in,
-                                  int njoin) {
+                                  int njoin,
+                                  const PadDesc<Element> *__restrict__ pad = nullptr) {
   int sample_idx = blockIdx.y;
-  if (out[sample_idx].is_uniform_join) {
+  if (pad && pad[sample_idx].ndim > 0) {
+    VALUE_SWITCH(njoin, static_njoin, (1, 2, 3, 4),
+      (JoinTensorsPadded<static_njoin>(out[sample_idx], pad[sample_idx],
+                                       in + sample_idx * njoin, njoin)),
+      (JoinTensorsPadded<-1>(out[sample_idx], pad[sample_idx],
+                             in + sample_idx * njoin, njoin)));
+  } else if (out[sample_idx].is_uniform_join) {
     // uniform join - it's cheaper to calculate use the multiplier to guess the tensor index
     VALUE_SWITCH(njoin, static_njoin, (1, 2, 3, 4),
       (JoinTensors<static_njoin>(out[sample_idx], in + sample_idx * njoin, njoin)),
@@ -204,10 +290,11 @@ void FillDescs(span<OutputDesc<ElementType>> output_descs,
         is_uniform_join = false;
     }
 
+    // The output may be padded, so the size of the joined slice is taken from the inputs
     auto out_shape = output.tensor_shape_span(i);
     auto &out_desc = output_descs[i];
     out_desc.data = output.data[i];
-    auto join_size = volume(out_shape.begin() + axis, out_shape.end());
+    auto join_size = join_offset;
     out_desc.outer_stride = join_size;
     out_desc.total_size = volume(out_shape);
     out_desc.guess_tensor_mul = 1.0 * njoin / join_size;
@@ -216,6 +303,70 @@ void FillDescs(span<OutputDesc<ElementType>> output_descs,
 }
 
 
+/**
+ * @brief Populates the padding descriptors for joined tensors placed in padded outputs
+ *
+ * The dimensions which are not padded are collapsed with their outer neighbours, so the
+ * padding descriptor typically has much fewer dimensions than the tensors.
+ */
+template <typename ElementType>
+void FillPadDescs(span<PadDesc<ElementType>> pad_descs,
+                  const TensorListShape<> &joined_shape,
+                  const TensorListShape<> &padded_shape,
+                  ElementType fill_value) {
+  int N = padded_shape.num_samples();
+  int D = padded_shape.sample_dim();
+  assert(static_cast<int>(pad_descs.size()) == N);
+  assert(joined_shape.num_samples() == N && joined_shape.sample_dim() == D);
+
+  for (int i = 0; i < N; i++) {
+    auto &desc = pad_descs[i];
+    desc.fill_value = fill_value;
+    auto joined = joined_shape.tensor_shape_span(i);
+    auto padded = padded_shape.tensor_shape_span(i);
+    if (joined_shape[i] == padded_shape[i]) {
+      desc.ndim = 0;
+      continue;
+    }
+
+    // collapse the dimensions, starting from the innermost one
+    int64_t joined_ext[kMaxPadNDim], padded_ext[kMaxPadNDim];
+    int ndim = 0;
+    for (int d = D - 1; d >= 0; d--) {
+      assert(joined[d] <= padded[d]);
+      if (padded[d] == 1 && joined[d] == 1)
+        continue;
+      if (ndim > 0 && joined_ext[ndim - 1] == padded_ext[ndim - 1]) {
+        // the inner group is not padded - merge it with this dimension
+        int64_t inner = joined_ext[ndim - 1];
+        joined_ext[ndim - 1] = inner * joined[d];
+        padded_ext[ndim - 1] = inner * padded[d];
+        continue;
+      }
+      DALI_ENFORCE(ndim < kMaxPadNDim, make_string("Padding is supported in at most ",
+        kMaxPadNDim, " non-adjacent dimensions; got: ", joined_shape[i], " padded to ",
+        padded_shape[i]));
+      joined_ext[ndim] = joined[d];
+      padded_ext[ndim] = padded[d];
+      ndim++;
+    }
+
+    // the collapsed extents were gathered from the innermost; reverse them
+    desc.ndim = ndim;
+    uint64_t joined_stride = 1, padded_stride = 1;
+    for (int d = 0; d < ndim; d++) {
+      int dst = ndim - 1 - d;
+      desc.joined_extent[dst] = joined_ext[d];
+      if (dst < ndim - 1) {
+        desc.joined_stride[dst] = joined_stride;
+        desc.padded_stride[dst] = padded_stride;
+      }
+      joined_stride *= joined_ext[d];
+      padded_stride *= padded_ext[d];
+    }
+  }
+}
+
 }  // namespace tensor_join
 }  // namespace kernels
 }  // namespace dali
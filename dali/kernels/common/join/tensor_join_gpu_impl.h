@@ -47,6 +47,9 @@ class DLL_PUBLIC TensorJoinImplGPU {
    *                          * 0 to sample_dim - 1 when `new_axis` is false
    *                        where sample_dim is the dimensionality of the inputs.
    *
+   * @param pad             if true, the joined tensors are padded to a uniform shape, which
+   *                        is the maximum extent in each dimension across the batch
+   *
    * @remarks Inputs must have the same dimensionality.
    * Respective tensors in the input must have the same shape (if new_axis == `true`) or can
    * differ at index `axis` (if new_axis == `false`).
@@ -55,12 +58,19 @@ class DLL_PUBLIC TensorJoinImplGPU {
              ScratchpadEstimator &se,
              const std::function<const TensorListShape<> *(int)> &get_input_shape,
              int num_inputs,
-             int axis);
+             int axis,
+             bool pad = false);
 
-  void Run(KernelContext &ctx, const OutListGPU<T> &out, span<const InListGPU<T> *const> in_lists);
+  /**
+   * @param fill_value the value of the padding; used only if padding was requested in Setup
+   */
+  void Run(KernelContext &ctx, const OutListGPU<T> &out, span<const InListGPU<T> *const> in_lists,
+           T fill_value = {});
 
  private:
   int axis_  = -1;
+  bool pad_ = false;
+  TensorListShape<> joined_shape_;
 };
 
 }  // namespace tensor_join
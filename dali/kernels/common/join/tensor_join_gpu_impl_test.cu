@@ -32,7 +32,8 @@ namespace dali {
 namespace kernels {
 
 template <typename T>
-void RefTLSJoin(const OutListCPU<T> &out, span<const InListCPU<T> *const> in, int axis) {
+void RefTLSJoin(const OutListCPU<T> &out, span<const InListCPU<T> *const> in, int axis,
+                const TensorListShape<> &joined_shape, T fill_value) {
   SmallVector<InTensorCPU<T>, 8> in_tensors;
   int njoin = in.size();
   in_tensors.resize(njoin);
@@ -42,7 +43,8 @@ void RefTLSJoin(const OutListCPU<T> &out, span<const InListCPU<T> *const> in, in
   for (int i = 0; i < N; i++) {
     for (int t = 0; t < njoin; t++)
       in_tensors[t] = (*in[t])[i];
-    tensor_join::ConcatenateTensors(out[i], make_cspan(in_tensors), axis);
+    tensor_join::ConcatenateTensorsPadded(out[i], joined_shape[i], make_cspan(in_tensors), axis,
+                                          fill_value);
   }
 }
 
@@ -76,10 +78,10 @@ struct TensorJoinGPUTest : public ::testing::Test {
       InitData(stream);
       RunRef();
 
-      KernelRequirements &req = mgr.Setup<Kernel>(0, ctx, make_cspan(in_gpu_tls), axis);
+      KernelRequirements &req = mgr.Setup<Kernel>(0, ctx, make_cspan(in_gpu_tls), axis, pad);
       ASSERT_EQ(req.output_shapes.size(), 1);
       ASSERT_EQ(req.output_shapes[0], out_shape);
-      mgr.Run<Kernel>(0, 0, ctx, out.gpu(stream), make_cspan(in_gpu_tls));
+      mgr.Run<Kernel>(0, 0, ctx, out.gpu(stream), make_cspan(in_gpu_tls), fill_value);
 
       CUDA_CALL(cudaStreamSynchronize(stream));
       CheckResult(stream);
@@ -87,7 +89,7 @@ struct TensorJoinGPUTest : public ::testing::Test {
   }
 
   void RunRef() {
-    RefTLSJoin(ref.cpu(), make_cspan(in_cpu_ptrs), axis);
+    RefTLSJoin(ref.cpu(), make_cspan(in_cpu_ptrs), axis, joined_shape, fill_value);
   }
 
   void CheckResult(cudaStream_t stream) {
@@ -210,15 +212,20 @@ struct TensorJoinGPUTest : public ::testing::Test {
     tensor_join::JoinedShape(out_shape,
                              [&](int i) { return &in_shapes[i]; }, in_shapes.size(),
                              axis, new_axis);
+    joined_shape = out_shape;
+    if (pad)
+      tensor_join::PadToMaxShape(out_shape);
   }
 
 
   int N = 10, ndim = 3, njoin = 256, axis = 1, max_outer_extent = 100, max_inner_extent = 100;
   bool new_axis = true;
+  bool pad = false;
+  T fill_value = 42;
   std::mt19937_64 rng{12345};
 
   vector<TensorListShape<>> in_shapes;
-  TensorListShape<> out_shape;
+  TensorListShape<> out_shape, joined_shape;
   vector<TestTensorList<T>> in;
   TestTensorList<T> out, ref;
 
@@ -425,5 +432,26 @@ TYPED_TEST(TensorJoinGPUTest, StackInterleave) {
   this->TestFullKernel();
 }
 
+TYPED_TEST(TensorJoinGPUTest, ConcatPadded) {
+  this->max_outer_extent = 50;
+  this->max_inner_extent = 50;
+  this->njoin = 3;
+  this->axis = 1;
+  this->new_axis = false;
+  this->pad = true;
+  this->TestFullKernel();
+}
+
+TYPED_TEST(TensorJoinGPUTest, StackPadded) {
+  this->max_outer_extent = 50;
+  this->max_inner_extent = 50;
+  this->njoin = 9;
+  this->ndim = 2;
+  this->axis = 1;
+  this->new_axis = true;
+  this->pad = true;
+  this->TestFullKernel();
+}
+
 }  // namespace kernels
 }  // namespace dali
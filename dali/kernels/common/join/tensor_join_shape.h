@@ -137,6 +137,27 @@ void JoinedShape(TensorListShape<out_ndim> &out,
   assert(out.num_elements() == in_volume);
 }
 
+/**
+ * @brief Replaces each sample shape with the per-dimension maximum extent found in the batch
+ *
+ * This is the shape of a batch of joined tensors padded to a uniform shape.
+ */
+template <int ndim>
+void PadToMaxShape(TensorListShape<ndim> &shape) {
+  int N = shape.num_samples();
+  if (N == 0)
+    return;
+  TensorShape<ndim> max_shape = shape[0];
+  for (int i = 1; i < N; i++) {
+    auto ts = shape.tensor_shape_span(i);
+    for (int d = 0; d < max_shape.size(); d++)
+      if (ts[d] > max_shape[d])
+        max_shape[d] = ts[d];
+  }
+  for (int i = 0; i < N; i++)
+    shape.set_tensor_shape(i, max_shape);
+}
+
 }  // namespace tensor_join
 }  // namespace kernels
 }  // namespace dali
@@ -0,0 +1,208 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <utility>
+#include "dali/core/cuda_error.h"
+#include "dali/core/error_handling.h"
+#include "dali/kernels/common/launch_tuner.h"
+
+namespace dali {
+namespace kernels {
+
+void LaunchTuner::Timer::Stop() {
+  if (!tuner_)
+    return;
+  tuner_->Stop(key_, id_, stream_);
+  tuner_ = nullptr;
+}
+
+LaunchTuner::LaunchTuner(bool enabled, std::string cache_path)
+: enabled_(enabled), cache_path_(std::move(cache_path)) {
+  if (enabled_ && !cache_path_.empty())
+    Load();
+}
+
+LaunchTuner::~LaunchTuner() = default;
+
+LaunchTuner &LaunchTuner::Get() {
+  static LaunchTuner tuner([]() {
+    const char *env = std::getenv("DALI_LAUNCH_TUNING");
+    return env && std::atoi(env) != 0;
+  }(), []() {
+    const char *env = std::getenv("DALI_LAUNCH_TUNING_CACHE");
+    return std::string(env ? env : "");
+  }());
+  return tuner;
+}
+
+std::string LaunchTuner::DeviceKey(const std::string &key) {
+  int device_id = 0;
+  CUDA_CALL(cudaGetDevice(&device_id));
+  auto it = device_suffixes_.find(device_id);
+  if (it == device_suffixes_.end()) {
+    int major = 0, minor = 0, sms = 0;
+    CUDA_CALL(cudaDeviceGetAttribute(&major, cudaDevAttrComputeCapabilityMajor, device_id));
+    CUDA_CALL(cudaDeviceGetAttribute(&minor, cudaDevAttrComputeCapabilityMinor, device_id));
+    CUDA_CALL(cudaDeviceGetAttribute(&sms, cudaDevAttrMultiProcessorCount, device_id));
+    it = device_suffixes_.emplace(device_id, make_string("@sm", major, minor, "x", sms)).first;
+  }
+  return key + it->second;
+}
+
+int LaunchTuner::Choose(const std::string &key, int num_candidates) {
+  if (!enabled_ || num_candidates <= 1)
+    return 0;
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto &entry = entries_[DeviceKey(key)];
+  Update(entry, num_candidates);
+  if (entry.chosen >= 0)
+    return entry.chosen < num_candidates ? entry.chosen : 0;
+
+  // the candidate with the fewest measurements, including the ones in flight
+  std::vector<int> count = entry.runs;
+  for (auto &m : entry.pending)
+    count[m.candidate]++;
+  int best = 0;
+  for (int i = 1; i < num_candidates; i++) {
+    if (count[i] < count[best])
+      best = i;
+  }
+  return best;
+}
+
+LaunchTuner::Timer LaunchTuner::Time(const std::string &key, int candidate, int64_t work,
+                                     cudaStream_t stream) {
+  Timer timer;
+  if (!enabled_ || work <= 0)
+    return timer;
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto device_key = DeviceKey(key);
+  auto it = entries_.find(device_key);
+  if (it == entries_.end() || it->second.chosen >= 0 ||
+      candidate >= static_cast<int>(it->second.runs.size()))
+    return timer;
+  auto &entry = it->second;
+  // don't keep too many launches in flight, if the events are not collected
+  if (entry.pending.size() >= 2 * kRunsPerCandidate * entry.runs.size())
+    return timer;
+
+  Measurement m;
+  m.id = next_id_++;
+  m.candidate = candidate;
+  m.work = work;
+  m.start = CUDAEvent::Create();
+  m.stop = CUDAEvent::Create();
+  CUDA_CALL(cudaEventRecord(m.start, stream));
+  timer.tuner_ = this;
+  timer.key_ = std::move(device_key);
+  timer.id_ = m.id;
+  timer.stream_ = stream;
+  entry.pending.push_back(std::move(m));
+  return timer;
+}
+
+void LaunchTuner::Stop(const std::string &device_key, int64_t id, cudaStream_t stream) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto it = entries_.find(device_key);
+  if (it == entries_.end())
+    return;
+  for (auto &m : it->second.pending) {
+    if (m.id == id) {
+      CUDA_CALL(cudaEventRecord(m.stop, stream));
+      m.stopped = true;
+      break;
+    }
+  }
+}
+
+int LaunchTuner::Chosen(const std::string &key) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto it = entries_.find(DeviceKey(key));
+  return it == entries_.end() ? -1 : it->second.chosen;
+}
+
+void LaunchTuner::Update(Entry &entry, int num_candidates) {
+  if (entry.chosen >= 0)
+    return;
+  if (static_cast<int>(entry.runs.size()) != num_candidates) {
+    entry.runs.assign(num_candidates, 0);
+    entry.time_per_work.assign(num_candidates, 0);
+    entry.pending.clear();
+  }
+  for (size_t i = 0; i < entry.pending.size(); ) {
+    auto &m = entry.pending[i];
+    if (!m.stopped || cudaEventQuery(m.stop) == cudaErrorNotReady) {
+      i++;
+      continue;
+    }
+    float ms = 0;
+    CUDA_CALL(cudaEventElapsedTime(&ms, m.start, m.stop));
+    entry.time_per_work[m.candidate] += ms / m.work;
+    entry.runs[m.candidate]++;
+    entry.pending.erase(entry.pending.begin() + i);
+  }
+
+  for (int runs : entry.runs) {
+    if (runs < kRunsPerCandidate)
+      return;
+  }
+  int best = 0;
+  for (int i = 1; i < num_candidates; i++) {
+    if (entry.time_per_work[i] / entry.runs[i] < entry.time_per_work[best] / entry.runs[best])
+      best = i;
+  }
+  entry.chosen = best;
+  entry.pending.clear();
+  if (!cache_path_.empty())
+    Save();
+}
+
+void LaunchTuner::Load() {
+  std::ifstream f(cache_path_);
+  std::string line;
+  while (std::getline(f, line)) {
+    // the key may contain spaces - the choice is after the last one
+    auto sep = line.find_last_of(' ');
+    if (sep == std::string::npos || sep == 0)
+      continue;
+    entries_[line.substr(0, sep)].chosen = std::atoi(line.c_str() + sep + 1);
+  }
+}
+
+void LaunchTuner::Save() {
+  // the file is replaced at once, so that the other processes never see it partially written
+  std::string tmp_path = cache_path_ + ".tmp" + std::to_string(getpid());
+  bool ok;
+  {
+    std::ofstream f(tmp_path);
+    for (auto &entry : entries_) {
+      if (entry.second.chosen >= 0)
+        f << entry.first << " " << entry.second.chosen << "\n";
+    }
+    f.close();
+    ok = static_cast<bool>(f);
+  }
+  if (!ok || std::rename(tmp_path.c_str(), cache_path_.c_str()) != 0) {
+    std::remove(tmp_path.c_str());
+    DALI_WARN(make_string("Cannot save the launch tuning cache: ", cache_path_));
+  }
+}
+
+}  // namespace kernels
+}  // namespace dali
@@ -0,0 +1,173 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_KERNELS_COMMON_LAUNCH_TUNER_H_
+#define DALI_KERNELS_COMMON_LAUNCH_TUNER_H_
+
+#include <cuda_runtime.h>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include "dali/core/api_helper.h"
+#include "dali/core/common.h"
+#include "dali/core/cuda_event.h"
+
+namespace dali {
+namespace kernels {
+
+/**
+ * @brief Picks the fastest of the candidate launch configurations of a kernel on the current GPU
+ *
+ * The launch geometry which works best depends on the GPU (the number of SMs, the size of L2)
+ * as much as on the kernel, so instead of one hard-coded default, a kernel can provide a few
+ * candidates (the default being the first one) and let the tuner choose.
+ *
+ * The tuning is done online. While a kernel, identified by a key (e.g. its name, data type and
+ * number of dimensions), is being tuned, its launches use the candidates in turn and are timed
+ * with CUDA events. The times are normalized by the amount of work done. When each candidate
+ * has been timed kRunsPerCandidate times, the fastest one is used from then on. No launch is
+ * repeated, so the tuning changes only the geometry, never the results.
+ *
+ * The tuning is enabled by setting the DALI_LAUNCH_TUNING environment variable to 1; otherwise
+ * the first candidate is always used. If DALI_LAUNCH_TUNING_CACHE points to a file, the choices
+ * are read from it and the new ones are stored in it, so that the next processes don't have
+ * to tune again. The keys are suffixed with the compute capability and the number of SMs
+ * of the GPU.
+ */
+class DLL_PUBLIC LaunchTuner {
+ public:
+  static constexpr int kRunsPerCandidate = 3;
+
+  /**
+   * @brief Times a launch of a kernel being tuned; does nothing for the tuned ones
+   */
+  class DLL_PUBLIC Timer {
+   public:
+    Timer() = default;
+    Timer(Timer &&other) {
+      *this = std::move(other);
+    }
+
+    Timer &operator=(Timer &&other) {
+      if (this != &other) {
+        Stop();
+        tuner_ = other.tuner_;
+        key_ = std::move(other.key_);
+        id_ = other.id_;
+        stream_ = other.stream_;
+        other.tuner_ = nullptr;
+      }
+      return *this;
+    }
+
+    ~Timer() {
+      Stop();
+    }
+
+    /**
+     * @brief Marks the end of the timed work - call after the kernel is issued to the stream
+     */
+    void Stop();
+
+   private:
+    friend class LaunchTuner;
+    LaunchTuner *tuner_ = nullptr;
+    std::string key_;
+    int64_t id_ = 0;
+    cudaStream_t stream_ = 0;
+  };
+
+  /**
+   * @brief Creates a tuner; if the cache path is not empty, the choices are loaded from
+   *        and saved to that file
+   */
+  explicit LaunchTuner(bool enabled, std::string cache_path = {});
+
+  ~LaunchTuner();
+
+  DISABLE_COPY_MOVE_ASSIGN(LaunchTuner);
+
+  /**
+   * @brief The process-wide tuner, configured with the environment variables
+   */
+  static LaunchTuner &Get();
+
+  bool Enabled() const noexcept {
+    return enabled_;
+  }
+
+  /**
+   * @brief Returns the index of the candidate, which the next launch of the kernel should use
+   *
+   * @param key            identifies the kernel and the properties of the launch which
+   *                       affect the choice (e.g. the data type and the number of dimensions)
+   * @param num_candidates the number of the candidate configurations; the first one is the
+   *                       default
+   */
+  int Choose(const std::string &key, int num_candidates);
+
+  /**
+   * @brief Starts timing the launch of the kernel, which uses the candidate
+   *
+   * The timing starts when the work preceding the kernel in the stream is done, so the timer
+   * should be started right before the kernel is issued.
+   *
+   * @param work the amount of work done by the launch (e.g. the number of output elements),
+   *             the times are normalized by
+   */
+  Timer Time(const std::string &key, int candidate, int64_t work, cudaStream_t stream);
+
+  /**
+   * @brief Returns the candidate chosen for the kernel on the current GPU or -1, if the kernel
+   *        is not tuned yet
+   */
+  int Chosen(const std::string &key);
+
+ private:
+  struct Measurement {
+    int64_t id;
+    int candidate;
+    int64_t work;
+    CUDAEvent start, stop;
+    bool stopped = false;
+  };
+
+  struct Entry {
+    int chosen = -1;
+    std::vector<double> time_per_work;
+    std::vector<int> runs;
+    std::vector<Measurement> pending;
+  };
+
+  std::string DeviceKey(const std::string &key);
+  void Stop(const std::string &key, int64_t id, cudaStream_t stream);
+  /// Collects the finished measurements and makes the choice, if all candidates are measured
+  void Update(Entry &entry, int num_candidates);
+  void Load();
+  void Save();
+
+  bool enabled_;
+  std::string cache_path_;
+  std::mutex mutex_;
+  std::map<std::string, Entry> entries_;
+  std::map<int, std::string> device_suffixes_;
+  int64_t next_id_ = 1;
+};
+
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_COMMON_LAUNCH_TUNER_H_
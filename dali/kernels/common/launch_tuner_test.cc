@@ -0,0 +1,75 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include "dali/core/cuda_error.h"
+#include "dali/core/cuda_stream.h"
+#include "dali/core/mm/memory.h"
+#include "dali/kernels/common/launch_tuner.h"
+
+namespace dali {
+namespace kernels {
+
+TEST(LaunchTuner, Disabled) {
+  LaunchTuner tuner(false);
+  for (int i = 0; i < 10; i++) {
+    EXPECT_EQ(tuner.Choose("test", 3), 0);
+    auto timer = tuner.Time("test", 0, 100, 0);
+  }
+  EXPECT_EQ(tuner.Chosen("test"), -1);
+}
+
+TEST(LaunchTuner, ChoosesFastestAndCaches) {
+  char cache_path[] = "/tmp/dali_launch_tuning_XXXXXX";
+  int fd = mkstemp(cache_path);
+  ASSERT_GE(fd, 0);
+  close(fd);
+
+  const int kCandidates = 3;
+  const int kFastest = 2;
+  const size_t kSize = 64 << 20;
+  auto mem = mm::alloc_raw_unique<char, mm::memory_kind::device>(kSize);
+  auto stream = CUDAStream::Create(true);
+  {
+    LaunchTuner tuner(true, cache_path);
+    int launches = 0;
+    for (; launches < 100 && tuner.Chosen("test") < 0; launches++) {
+      int candidate = tuner.Choose("test", kCandidates);
+      ASSERT_GE(candidate, 0);
+      ASSERT_LT(candidate, kCandidates);
+      // all the candidates report the same work, but one of them does much less
+      auto timer = tuner.Time("test", candidate, 1000, stream);
+      CUDA_CALL(cudaMemsetAsync(mem.get(), 0, candidate == kFastest ? 1024 : kSize, stream));
+      timer.Stop();
+      CUDA_CALL(cudaStreamSynchronize(stream));
+    }
+    EXPECT_GE(launches, kCandidates * LaunchTuner::kRunsPerCandidate);
+    EXPECT_EQ(tuner.Chosen("test"), kFastest);
+    EXPECT_EQ(tuner.Choose("test", kCandidates), kFastest);
+  }
+
+  // the next tuner doesn't need to measure anything
+  LaunchTuner tuner(true, cache_path);
+  EXPECT_EQ(tuner.Chosen("test"), kFastest);
+  EXPECT_EQ(tuner.Choose("test", kCandidates), kFastest);
+  EXPECT_EQ(tuner.Chosen("other"), -1);
+  std::remove(cache_path);
+}
+
+}  // namespace kernels
+}  // namespace dali
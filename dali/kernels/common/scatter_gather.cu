@@ -61,6 +61,19 @@ size_t Coalesce(span<CopyRange> ranges) {
   return n;
 }
 
+bool PreferMemcpy(span<const CopyRange> ranges) {
+  // Below this average size, the per-call overhead of cudaMemcpyAsync dominates
+  constexpr size_t kMemcpyMinAvgSize = 1 << 20;
+  constexpr size_t kMaxMemcpyRanges = 2;
+  size_t n = ranges.size();
+  if (n <= kMaxMemcpyRanges)
+    return true;
+  size_t total_size = 0;
+  for (auto &r : ranges)
+    total_size += r.size;
+  return total_size >= n * kMemcpyMinAvgSize;
+}
+
 }  // namespace detail
 
 size_t ScatterGatherBase::MakeBlocks(std::vector<CopyRange> &blocks,
@@ -126,10 +139,37 @@ void ScatterGatherCPU::MakeBlocks(size_t blocks_lower_limit) {
 }
 
 
+/**
+ * @brief Each CUDA block copies one of the blocks produced by MakeBlocks
+ *
+ * When the source and destination share the same misalignment, the bulk of the block is moved
+ * in 16-byte vectors; only the unaligned head and tail are copied byte by byte.
+ */
 __global__ void BatchCopy(const ScatterGatherBase::CopyRange *ranges) {
+  using Vec = uint4;
+  constexpr uintptr_t kAlignMask = sizeof(Vec) - 1;
   auto range = ranges[blockIdx.x];
 
-  for (size_t i = threadIdx.x; i < range.size; i += blockDim.x) {
+  uintptr_t src_misalign = reinterpret_cast<uintptr_t>(range.src) & kAlignMask;
+  uintptr_t dst_misalign = reinterpret_cast<uintptr_t>(range.dst) & kAlignMask;
+  size_t start = 0;
+  if (src_misalign == dst_misalign) {
+    size_t head = (sizeof(Vec) - src_misalign) & kAlignMask;
+    if (head > range.size)
+      head = range.size;
+    for (size_t i = threadIdx.x; i < head; i += blockDim.x)
+      range.dst[i] = range.src[i];
+
+    size_t nvec = (range.size - head) / sizeof(Vec);
+    auto *vsrc = reinterpret_cast<const Vec *>(range.src + head);
+    auto *vdst = reinterpret_cast<Vec *>(range.dst + head);
+    for (size_t i = threadIdx.x; i < nvec; i += blockDim.x) {
+      vdst[i] = vsrc[i];
+    }
+    start = head + nvec * sizeof(Vec);
+  }
+
+  for (size_t i = start + threadIdx.x; i < range.size; i += blockDim.x) {
     range.dst[i] = range.src[i];
   }
 }
@@ -141,7 +181,8 @@ void ScatterGatherGPU::Run(cudaStream_t stream, bool reset, ScatterGatherGPU::Me
   // TODO(michalz): Error handling
 
   bool use_memcpy = (method == ScatterGatherGPU::Method::Memcpy) ||
-    (method == ScatterGatherGPU::Method::Default && ranges_.size() <= 2);
+    (method == ScatterGatherGPU::Method::Default &&
+     detail::PreferMemcpy(make_cspan(ranges_)));
 
   if (use_memcpy) {
     for (auto &r : ranges_) {
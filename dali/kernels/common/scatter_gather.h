@@ -36,6 +36,15 @@ struct DLL_PUBLIC CopyRange {
 };
 
 DLL_PUBLIC size_t Coalesce(span<CopyRange> ranges);
+
+/**
+ * @brief Decides whether a batch of (coalesced) ranges is better served by the copy engine
+ *
+ * Each cudaMemcpyAsync has a fixed overhead, so the copy engine is preferred only when there are
+ * very few ranges or when the ranges are, on average, large enough to amortize that overhead.
+ * Otherwise, a single launch of the gather kernel is cheaper.
+ */
+DLL_PUBLIC bool PreferMemcpy(span<const CopyRange> ranges);
 }  // namespace detail
 
 /**
@@ -73,8 +82,8 @@ class DLL_PUBLIC ScatterGatherBase {
   }
 
   enum class Method {
-    Default = 0,  // For GPU, uses scatter-gather kernel, unless there are 2 or fewer single
-                  // effective copy ranges, in that cases cudaMemcpyAsync is used
+    Default = 0,  // For GPU, picks cudaMemcpyAsync or the scatter-gather kernel based on
+                  // the number and sizes of effective copy ranges (see detail::PreferMemcpy)
                   // For CPU, uses memcpy
     Memcpy = 1,   // Always use cudaMemcpyAsync, only for GPU
     Kernel = 2,   // Always use scatter-gather kernel, only for GPU
@@ -15,11 +15,30 @@
 #ifndef DALI_KERNELS_COMMON_SIMD_H_
 #define DALI_KERNELS_COMMON_SIMD_H_
 
-#ifdef __SSE2__
+#if defined(__SSE2__)
 #include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#if defined(__x86_64__) && !defined(__CUDACC__) && defined(__GNUC__)
+#include <immintrin.h>
+/**
+ * @brief Defined, if the code can be compiled for AVX2 (regardless of the build flags)
+ *        and dispatched at run time
+ */
+#define DALI_SIMD_HAS_AVX2 1
+#endif
+
+#if defined(__SSE2__) || (defined(__ARM_NEON) && defined(__aarch64__))
+/**
+ * @brief Defined, if the vectors of 4 floats are available for the build target
+ */
+#define DALI_SIMD_HAS_F32X4 1
 #endif
 
 #include <cstddef>
+#include <cstdint>
 #include <limits>
 #include <type_traits>
 #include "dali/core/force_inline.h"
@@ -28,7 +47,7 @@ namespace dali {
 namespace kernels {
 namespace simd {
 
-#ifdef __SSE2__
+#if defined(__SSE2__)
 
 template <int n>
 struct float4x {
@@ -234,8 +253,10 @@ inline float4x1 load_f(const float *f) {
 inline __m128i saturate_f_i32(__m128 f) {
   // this converts f to int32. Out of range values (and NaN) are stored as -2^31
   __m128i raw = _mm_cvtps_epi32(f);
-  // xor to check where sign disagrees
-  __m128i mask = _mm_xor_si128(_mm_castps_si128(f), raw);
+  __m128i overflow = _mm_cmpeq_epi32(raw, _mm_set1_epi32(0x80000000));
+  // xor to check where sign disagrees - only in the out of range values, since a small negative
+  // value can legitimately be rounded to 0
+  __m128i mask = _mm_and_si128(overflow, _mm_xor_si128(_mm_castps_si128(f), raw));
   __m128i adjust = _mm_srli_epi32(mask, 31);  // move the disagreeing sign bit to LSB and subtract
   // this converts 0x80000000 to 0x7fffffff, which is what we want
   return _mm_sub_epi32(raw, adjust);
@@ -273,19 +294,342 @@ inline void store_f(float *out, float4x1 f) {
   _mm_storeu_ps(out, f.v[0]);
 }
 
+/**
+ * @brief Returns a vector of 4 zeros
+ */
+DALI_FORCEINLINE __m128 zero_f() noexcept {
+  return _mm_setzero_ps();
+}
+
+/**
+ * @brief Returns a vector of 4 copies of `f`
+ */
+DALI_FORCEINLINE __m128 set1_f(float f) noexcept {
+  return _mm_set1_ps(f);
+}
+
+/**
+ * @brief Returns acc + a * b
+ */
+DALI_FORCEINLINE __m128 madd_f(__m128 acc, __m128 a, __m128 b) noexcept {
+  return _mm_add_ps(acc, _mm_mul_ps(a, b));
+}
+
+/**
+ * @brief Returns a + b
+ */
+DALI_FORCEINLINE __m128 add_f(__m128 a, __m128 b) noexcept {
+  return _mm_add_ps(a, b);
+}
+
+/**
+ * @brief Returns a - b
+ */
+DALI_FORCEINLINE __m128 sub_f(__m128 a, __m128 b) noexcept {
+  return _mm_sub_ps(a, b);
+}
+
+/**
+ * @brief Clamps the values to the range [lo, hi]; NaNs are replaced with `lo`
+ */
+DALI_FORCEINLINE __m128 clamp_f(__m128 f, __m128 lo, __m128 hi) noexcept {
+  return _mm_min_ps(_mm_max_ps(f, lo), hi);
+}
+
+/**
+ * @brief Rounds down to int32; `floored` receives the result converted back to float
+ *
+ * The values must be within the range of int32.
+ */
+DALI_FORCEINLINE __m128i floor_i32(__m128 f, __m128 &floored) noexcept {
+  __m128i i = _mm_cvttps_epi32(f);  // rounds towards zero
+  // the mask is all ones (-1) where the negative values were rounded up
+  __m128i adjust = _mm_castps_si128(_mm_cmpgt_ps(_mm_cvtepi32_ps(i), f));
+  i = _mm_add_epi32(i, adjust);
+  floored = _mm_cvtepi32_ps(i);
+  return i;
+}
+
+/**
+ * @brief Converts 4 pixels with 3 interleaved channels, stored in 3 vectors, to 3 planes
+ *
+ * On input: `v0 = a0 b0 c0 a1`, `v1 = b1 c1 a2 b2`, `v2 = c2 a3 b3 c3`;
+ * on output: `v0 = a0 a1 a2 a3`, `v1 = b0 b1 b2 b3`, `v2 = c0 c1 c2 c3`.
+ */
+DALI_FORCEINLINE void deinterleave3_f(__m128 &v0, __m128 &v1, __m128 &v2) noexcept {
+  __m128 a = _mm_shuffle_ps(_mm_shuffle_ps(v0, v0, _MM_SHUFFLE(3, 0, 3, 0)),  // a0 a1 a0 a1
+                            _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(1, 1, 2, 2)),  // a2 a2 a3 a3
+                            _MM_SHUFFLE(2, 0, 1, 0));
+  __m128 b = _mm_shuffle_ps(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(0, 0, 1, 1)),  // b0 b0 b1 b1
+                            _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(2, 2, 3, 3)),  // b2 b2 b3 b3
+                            _MM_SHUFFLE(2, 0, 2, 0));
+  __m128 c = _mm_shuffle_ps(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(1, 1, 2, 2)),  // c0 c0 c1 c1
+                            _mm_shuffle_ps(v2, v2, _MM_SHUFFLE(3, 0, 3, 0)),  // c2 c3 c2 c3
+                            _MM_SHUFFLE(1, 0, 2, 0));
+  v0 = a;
+  v1 = b;
+  v2 = c;
+}
+
+/**
+ * @brief The inverse of deinterleave3_f
+ */
+DALI_FORCEINLINE void interleave3_f(__m128 &v0, __m128 &v1, __m128 &v2) noexcept {
+  __m128 a = v0, b = v1, c = v2;
+  v0 = _mm_shuffle_ps(_mm_unpacklo_ps(a, b),                          // a0 b0 a1 b1
+                      _mm_shuffle_ps(c, a, _MM_SHUFFLE(1, 1, 0, 0)),  // c0 c0 a1 a1
+                      _MM_SHUFFLE(2, 0, 1, 0));
+  v1 = _mm_shuffle_ps(_mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 1, 1)),  // b1 b1 c1 c1
+                      _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 2, 2, 2)),  // a2 a2 b2 b2
+                      _MM_SHUFFLE(2, 0, 2, 0));
+  v2 = _mm_shuffle_ps(_mm_shuffle_ps(c, a, _MM_SHUFFLE(3, 3, 2, 2)),  // c2 c2 a3 a3
+                      _mm_unpackhi_ps(b, c),                          // b2 c2 b3 c3
+                      _MM_SHUFFLE(3, 2, 2, 0));
+}
+
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+
+template <int n>
+struct float4x {
+  float32x4_t v[n];  // NOLINT
+};
+
+template <int n>
+struct i128x {
+  int32x4_t v[n];  // NOLINT
+};
+
+using float4x1 = float4x<1>;
+using float4x2 = float4x<2>;
+using float4x4 = float4x<4>;
+using i128x1 = i128x<1>;
+using i128x2 = i128x<2>;
+using i128x4 = i128x<4>;
+
+/**
+ * @brief Saturate int32x4x4 to int8x16 and store
+ */
+inline void store_i32(int8_t *i8, i128x4 iv) {
+  int16x8_t sv0 = vcombine_s16(vqmovn_s32(iv.v[0]), vqmovn_s32(iv.v[1]));
+  int16x8_t sv1 = vcombine_s16(vqmovn_s32(iv.v[2]), vqmovn_s32(iv.v[3]));
+  vst1q_s8(i8, vcombine_s8(vqmovn_s16(sv0), vqmovn_s16(sv1)));
+}
+
+/**
+ * @brief Saturate int32x4x4 to uint8x16 and store
+ */
+inline void store_i32(uint8_t *u8, i128x4 iv) {
+  int16x8_t sv0 = vcombine_s16(vqmovn_s32(iv.v[0]), vqmovn_s32(iv.v[1]));
+  int16x8_t sv1 = vcombine_s16(vqmovn_s32(iv.v[2]), vqmovn_s32(iv.v[3]));
+  vst1q_u8(u8, vcombine_u8(vqmovun_s16(sv0), vqmovun_s16(sv1)));
+}
+
+/**
+ * @brief Saturate and narrow int32x4x2 to int16x8 and store
+ */
+inline void store_i32(int16_t *i16, i128x2 iv) {
+  vst1q_s16(i16, vcombine_s16(vqmovn_s32(iv.v[0]), vqmovn_s32(iv.v[1])));
+}
+
+/**
+ * @brief Saturate and narrow int32x4x2 to uint16x8 and store
+ */
+inline void store_i32(uint16_t *u16, i128x2 iv) {
+  vst1q_u16(u16, vcombine_u16(vqmovun_s32(iv.v[0]), vqmovun_s32(iv.v[1])));
+}
+
+inline void store_i32(int32_t *i32, i128x1 iv) {
+  vst1q_s32(i32, iv.v[0]);
+}
+
+/**
+ * @brief Load int32x4 and convert to 1 float32x4
+ */
+inline float4x1 load_f(const int32_t *i32) {
+  return {{ vcvtq_f32_s32(vld1q_s32(i32)) }};
+}
+
+/**
+ * @brief Load uint8x16 and convert to 4 float32x4
+ */
+inline float4x4 load_f(const uint8_t *u8) {
+  uint8x16_t in = vld1q_u8(u8);
+  uint16x8_t lo16 = vmovl_u8(vget_low_u8(in));
+  uint16x8_t hi16 = vmovl_u8(vget_high_u8(in));
+  return {{ vcvtq_f32_u32(vmovl_u16(vget_low_u16(lo16))),
+            vcvtq_f32_u32(vmovl_u16(vget_high_u16(lo16))),
+            vcvtq_f32_u32(vmovl_u16(vget_low_u16(hi16))),
+            vcvtq_f32_u32(vmovl_u16(vget_high_u16(hi16))) }};
+}
+
+/**
+ * @brief Load int8x16 and convert to 4 float32x4
+ */
+inline float4x4 load_f(const int8_t *i8) {
+  int8x16_t in = vld1q_s8(i8);
+  int16x8_t lo16 = vmovl_s8(vget_low_s8(in));
+  int16x8_t hi16 = vmovl_s8(vget_high_s8(in));
+  return {{ vcvtq_f32_s32(vmovl_s16(vget_low_s16(lo16))),
+            vcvtq_f32_s32(vmovl_s16(vget_high_s16(lo16))),
+            vcvtq_f32_s32(vmovl_s16(vget_low_s16(hi16))),
+            vcvtq_f32_s32(vmovl_s16(vget_high_s16(hi16))) }};
+}
+
+/**
+ * @brief Load uint16x8 and convert to 2 float32x4
+ */
+inline float4x2 load_f(const uint16_t *u16) {
+  uint16x8_t in = vld1q_u16(u16);
+  return {{ vcvtq_f32_u32(vmovl_u16(vget_low_u16(in))),
+            vcvtq_f32_u32(vmovl_u16(vget_high_u16(in))) }};
+}
+
+/**
+ * @brief Load int16x8 and convert to 2 float32x4
+ */
+inline float4x2 load_f(const int16_t *i16) {
+  int16x8_t in = vld1q_s16(i16);
+  return {{ vcvtq_f32_s32(vmovl_s16(vget_low_s16(in))),
+            vcvtq_f32_s32(vmovl_s16(vget_high_s16(in))) }};
+}
+
+inline float4x1 load_f(const float *f) {
+  return {{ vld1q_f32(f) }};
+}
+
+/**
+ * @brief Converts floating point values to 32-bit signed integers, rounding to nearest,
+ *        with proper clamping
+ *
+ * @remarks NaNs are stored as 0
+ */
+inline int32x4_t saturate_f_i32(float32x4_t f) {
+  return vcvtnq_s32_f32(f);
+}
+
+/**
+ * @brief Convert multiple vectors of float and convert them to Out.
+ */
+template <typename Out>
+inline std::enable_if_t<std::is_integral<Out>::value>
+store_f(Out *out, float4x<sizeof(float)/sizeof(Out)> f) {
+  constexpr int nvec = sizeof(float)/sizeof(Out);
+  i128x<nvec> iv;
+  for (int i = 0; i < nvec; i++)
+    iv.v[i] = saturate_f_i32(f.v[i]);
+  store_i32(out, iv);
+}
+
+/**
+ * @brief Store 1 vector of floats
+ */
+inline void store_f(float *out, float4x1 f) {
+  vst1q_f32(out, f.v[0]);
+}
+
+DALI_FORCEINLINE float32x4_t zero_f() noexcept {
+  return vdupq_n_f32(0);
+}
+
+DALI_FORCEINLINE float32x4_t set1_f(float f) noexcept {
+  return vdupq_n_f32(f);
+}
+
+DALI_FORCEINLINE float32x4_t madd_f(float32x4_t acc, float32x4_t a, float32x4_t b) noexcept {
+  // not fused, to produce the same results as the other architectures
+  return vaddq_f32(acc, vmulq_f32(a, b));
+}
+
+DALI_FORCEINLINE float32x4_t add_f(float32x4_t a, float32x4_t b) noexcept {
+  return vaddq_f32(a, b);
+}
+
+DALI_FORCEINLINE float32x4_t sub_f(float32x4_t a, float32x4_t b) noexcept {
+  return vsubq_f32(a, b);
+}
+
+/**
+ * @brief Clamps the values to the range [lo, hi]; NaNs are replaced with `lo`
+ */
+DALI_FORCEINLINE float32x4_t clamp_f(float32x4_t f, float32x4_t lo, float32x4_t hi) noexcept {
+  return vminnmq_f32(vmaxnmq_f32(f, lo), hi);
+}
+
+/**
+ * @brief Rounds down to int32; `floored` receives the result converted back to float
+ */
+DALI_FORCEINLINE int32x4_t floor_i32(float32x4_t f, float32x4_t &floored) noexcept {
+  int32x4_t i = vcvtmq_s32_f32(f);
+  floored = vcvtq_f32_s32(i);
+  return i;
+}
+
+/**
+ * @brief Converts 4 pixels with 3 interleaved channels, stored in 3 vectors, to 3 planes
+ */
+DALI_FORCEINLINE void deinterleave3_f(float32x4_t &v0, float32x4_t &v1,
+                                      float32x4_t &v2) noexcept {
+  float tmp[12];
+  vst1q_f32(tmp, v0);
+  vst1q_f32(tmp + 4, v1);
+  vst1q_f32(tmp + 8, v2);
+  float32x4x3_t planes = vld3q_f32(tmp);
+  v0 = planes.val[0];
+  v1 = planes.val[1];
+  v2 = planes.val[2];
+}
+
+/**
+ * @brief The inverse of deinterleave3_f
+ */
+DALI_FORCEINLINE void interleave3_f(float32x4_t &v0, float32x4_t &v1, float32x4_t &v2) noexcept {
+  float tmp[12];
+  float32x4x3_t planes = {{ v0, v1, v2 }};
+  vst3q_f32(tmp, planes);
+  v0 = vld1q_f32(tmp);
+  v1 = vld1q_f32(tmp + 4);
+  v2 = vld1q_f32(tmp + 8);
+}
+
+#endif
+
+#ifdef DALI_SIMD_HAS_F32X4
+
+/**
+ * @brief The number of floats in one vector
+ */
+static constexpr int kFloatLanes = 4;
+
+/**
+ * @brief The smallest number of lanes in which multivec can load or store values of type T
+ */
+template <typename T>
+constexpr int storage_lanes() {
+  return 16 / sizeof(T) > 4 ? 16 / sizeof(T) : 4;
+}
+
 template <int num_vecs>
 struct multivec : float4x<num_vecs> {
+  static constexpr int kNumLanes = num_vecs * kFloatLanes;
+
   DALI_FORCEINLINE static multivec zero() noexcept  {
     multivec m;
     for (int i = 0; i < num_vecs; i++)
-      m.v[i] = _mm_setzero_ps();
+      m.v[i] = zero_f();
+    return m;
+  }
+
+  DALI_FORCEINLINE static multivec set1(float f) noexcept  {
+    multivec m;
+    for (int i = 0; i < num_vecs; i++)
+      m.v[i] = set1_f(f);
     return m;
   }
 
   DALI_FORCEINLINE static multivec load(const float *in) noexcept  {
     multivec m;
     for (int i = 0; i < num_vecs; i++)
-      m.v[i] = _mm_loadu_ps(in + 4*i);
+      m.v[i] = load_f(in + 4*i).v[0];
     return m;
   }
 
@@ -298,7 +642,7 @@ struct multivec : float4x<num_vecs> {
       "Total number of lanes is not a multiple of storage lanes.");
     multivec m;
     for (int i = 0; i < num_vecs; i += load_vecs) {
-      auto tmp = simd::load_f(in + i * load_lanes);
+      auto tmp = simd::load_f(in + i * kFloatLanes);
       for (int j = 0; j < load_vecs; j++)
         m.v[i + j] = tmp.v[j];
     }
@@ -322,11 +666,224 @@ DALI_FORCEINLINE static void store(Out *out, multivec<num_vecs> m) noexcept {
     float4x<store_vecs> slice;
     for (int j = 0; j < store_vecs; j++)
       slice.v[j] = m.v[i + j];
-    store_f(out + i * store_lanes, slice);
+    store_f(out + i * kFloatLanes, slice);
+  }
+}
+
+/**
+ * @brief Calculates acc += a * b, lane-wise
+ */
+template <int num_vecs>
+DALI_FORCEINLINE static void madd(multivec<num_vecs> &acc, const multivec<num_vecs> &a,
+                                  const multivec<num_vecs> &b) noexcept {
+  for (int i = 0; i < num_vecs; i++)
+    acc.v[i] = madd_f(acc.v[i], a.v[i], b.v[i]);
+}
+
+/**
+ * @brief Calculates acc += a * b, where `a` is broadcast to all lanes
+ */
+template <int num_vecs>
+DALI_FORCEINLINE static void madd(multivec<num_vecs> &acc, float a,
+                                  const multivec<num_vecs> &b) noexcept {
+  auto va = set1_f(a);
+  for (int i = 0; i < num_vecs; i++)
+    acc.v[i] = madd_f(acc.v[i], va, b.v[i]);
+}
+
+/**
+ * @brief Calculates acc += a, lane-wise
+ */
+template <int num_vecs>
+DALI_FORCEINLINE static void add(multivec<num_vecs> &acc, const multivec<num_vecs> &a) noexcept {
+  for (int i = 0; i < num_vecs; i++)
+    acc.v[i] = add_f(acc.v[i], a.v[i]);
+}
+
+/**
+ * @brief Splits the values of 3 interleaved channels into separate planes
+ *
+ * The lane `i` of `planes[c]` receives the value of lane `3 * i + c` of `interleaved`.
+ */
+template <int num_vecs>
+DALI_FORCEINLINE static void deinterleave3(multivec<num_vecs> (&planes)[3],
+                                           const multivec<3 * num_vecs> &interleaved) noexcept {
+  for (int i = 0; i < num_vecs; i++) {
+    auto v0 = interleaved.v[3 * i], v1 = interleaved.v[3 * i + 1], v2 = interleaved.v[3 * i + 2];
+    deinterleave3_f(v0, v1, v2);
+    planes[0].v[i] = v0;
+    planes[1].v[i] = v1;
+    planes[2].v[i] = v2;
   }
 }
 
-#endif  // __SSE2__
+/**
+ * @brief Merges 3 planes into interleaved channels; the inverse of deinterleave3
+ */
+template <int num_vecs>
+DALI_FORCEINLINE static multivec<3 * num_vecs> interleave3(
+      const multivec<num_vecs> (&planes)[3]) noexcept {
+  multivec<3 * num_vecs> interleaved;
+  for (int i = 0; i < num_vecs; i++) {
+    auto v0 = planes[0].v[i], v1 = planes[1].v[i], v2 = planes[2].v[i];
+    interleave3_f(v0, v1, v2);
+    interleaved.v[3 * i] = v0;
+    interleaved.v[3 * i + 1] = v1;
+    interleaved.v[3 * i + 2] = v2;
+  }
+  return interleaved;
+}
+
+#endif  // DALI_SIMD_HAS_F32X4
+
+/**
+ * @brief Tells whether simd::multivec can load and store (with conversion) the values of type T
+ */
+template <typename T>
+struct is_simd_storage : std::integral_constant<bool,
+    std::is_same<T, uint8_t>::value || std::is_same<T, int8_t>::value ||
+    std::is_same<T, uint16_t>::value || std::is_same<T, int16_t>::value ||
+    std::is_same<T, int32_t>::value || std::is_same<T, float>::value> {};
+
+#ifdef DALI_SIMD_HAS_AVX2
+
+/**
+ * @brief DALI_SIMD_AVX2_BEGIN and DALI_SIMD_AVX2_END delimit a region of code compiled for AVX2
+ *
+ * The functions defined in the region must only be called when avx2::is_supported() is true.
+ */
+#if defined(__clang__)
+#define DALI_SIMD_AVX2_BEGIN \
+  _Pragma("clang attribute push(__attribute__((target(\"avx2\"))), apply_to = function)")
+#define DALI_SIMD_AVX2_END _Pragma("clang attribute pop")
+#else
+#define DALI_SIMD_AVX2_BEGIN _Pragma("GCC push_options") _Pragma("GCC target(\"avx2\")")
+#define DALI_SIMD_AVX2_END _Pragma("GCC pop_options")
+#endif
+
+namespace avx2 {
+
+/**
+ * @brief Checks whether the CPU supports AVX2
+ */
+inline bool is_supported() {
+  static const bool supported = __builtin_cpu_supports("avx2");
+  return supported;
+}
+
+}  // namespace avx2
+
+DALI_SIMD_AVX2_BEGIN
+
+/**
+ * @brief 8-lane vectors, compiled for AVX2, with the interface of simd::multivec
+ *
+ * The values are loaded and stored with the conversion rules of the SSE2 functions,
+ * so the results are identical.
+ */
+namespace avx2 {
+
+static constexpr int kFloatLanes = 8;
+
+template <typename T>
+constexpr int storage_lanes() {
+  return 16 / sizeof(T) > 8 ? 16 / sizeof(T) : 8;
+}
+
+DALI_FORCEINLINE __m256 load8_f(const uint8_t *u8) noexcept {
+  __m128i in = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(u8));
+  return _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(in));
+}
+
+DALI_FORCEINLINE __m256 load8_f(const int8_t *i8) noexcept {
+  __m128i in = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(i8));
+  return _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(in));
+}
+
+DALI_FORCEINLINE __m256 load8_f(const uint16_t *u16) noexcept {
+  __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(u16));
+  return _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(in));
+}
+
+DALI_FORCEINLINE __m256 load8_f(const int16_t *i16) noexcept {
+  __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(i16));
+  return _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(in));
+}
+
+DALI_FORCEINLINE __m256 load8_f(const int32_t *i32) noexcept {
+  return _mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(i32)));
+}
+
+DALI_FORCEINLINE __m256 load8_f(const float *f) noexcept {
+  return _mm256_loadu_ps(f);
+}
+
+template <int num_vecs>
+struct multivec {
+  static constexpr int kNumLanes = num_vecs * kFloatLanes;
+  __m256 v[num_vecs];  // NOLINT
+
+  DALI_FORCEINLINE static multivec zero() noexcept {
+    multivec m;
+    for (int i = 0; i < num_vecs; i++)
+      m.v[i] = _mm256_setzero_ps();
+    return m;
+  }
+
+  template <typename In>
+  DALI_FORCEINLINE static multivec load(const In *in) noexcept {
+    multivec m;
+    for (int i = 0; i < num_vecs; i++)
+      m.v[i] = load8_f(in + i * kFloatLanes);
+    return m;
+  }
+};
+
+/**
+ * @brief Stores multiple vectors of float, converting them to Out
+ *
+ * The vectors are split in halves and stored with the SSE2 conversions.
+ */
+template <int num_vecs, typename Out>
+DALI_FORCEINLINE static void store(Out *out, multivec<num_vecs> m) noexcept {
+  constexpr int store_lanes = 16 / sizeof(Out);
+  constexpr int store_vecs = store_lanes / 4;
+  static_assert(num_vecs * kFloatLanes % store_lanes == 0,
+    "Total number of lanes is not a multiple of storage lanes.");
+  __m128 halves[2 * num_vecs];  // NOLINT
+  for (int i = 0; i < num_vecs; i++) {
+    halves[2 * i] = _mm256_castps256_ps128(m.v[i]);
+    halves[2 * i + 1] = _mm256_extractf128_ps(m.v[i], 1);
+  }
+  for (int i = 0; i < 2 * num_vecs; i += store_vecs) {
+    simd::float4x<store_vecs> slice;
+    for (int j = 0; j < store_vecs; j++)
+      slice.v[j] = halves[i + j];
+    simd::store_f(out + i * 4, slice);
+  }
+}
+
+template <int num_vecs>
+DALI_FORCEINLINE static void madd(multivec<num_vecs> &acc, const multivec<num_vecs> &a,
+                                  const multivec<num_vecs> &b) noexcept {
+  // not fused, to produce the same results as the SSE2 code
+  for (int i = 0; i < num_vecs; i++)
+    acc.v[i] = _mm256_add_ps(acc.v[i], _mm256_mul_ps(a.v[i], b.v[i]));
+}
+
+template <int num_vecs>
+DALI_FORCEINLINE static void madd(multivec<num_vecs> &acc, float a,
+                                  const multivec<num_vecs> &b) noexcept {
+  __m256 va = _mm256_set1_ps(a);
+  for (int i = 0; i < num_vecs; i++)
+    acc.v[i] = _mm256_add_ps(acc.v[i], _mm256_mul_ps(va, b.v[i]));
+}
+
+}  // namespace avx2
+
+DALI_SIMD_AVX2_END
+
+#endif  // DALI_SIMD_HAS_AVX2
 
 }  // namespace simd
 }  // namespace kernels
@@ -0,0 +1,75 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DALI_KERNELS_COMMON_STATIC_NDIM_H_
+#define DALI_KERNELS_COMMON_STATIC_NDIM_H_
+
+#include <cstdint>
+#include "dali/core/fast_div.h"
+#include "dali/core/host_dev.h"
+#include "dali/core/static_switch.h"
+#include "dali/core/tensor_shape.h"
+
+namespace dali {
+namespace kernels {
+
+/**
+ * @brief Pastes `code_` specialized for the (collapsed) dimensionality of 1 to 4
+ *
+ * Inside `code_`, `static_ndim_` is a compile-time constant equal to `ndim_`, or
+ * `DynamicDimensions` for higher dimensionalities, which should then be handled by a generic
+ * code path using the runtime value.
+ *
+ * Usage:
+ * ```
+ * NDIM_SWITCH(desc.ndim, static_ndim, (
+ *   TransposeGeneric<static_ndim>(desc);
+ * ));  // NOLINT
+ * ```
+ */
+#define NDIM_SWITCH(ndim_, static_ndim_, code_)                                     \
+  VALUE_SWITCH(ndim_, static_ndim_, (1, 2, 3, 4), code_, (                          \
+    constexpr int static_ndim_ = ::dali::DynamicDimensions;                         \
+    BOOST_PP_REMOVE_PARENS(code_);                                                  \
+  ))  // NOLINT
+
+/**
+ * @brief Converts a flat offset in one layout to a flat offset in another one
+ *
+ * The offset is decomposed into indices with `src_strides` and recombined with `dst_strides`.
+ * The innermost source stride is assumed to be 1 and is not accessed.
+ *
+ * @tparam static_ndim compile-time dimensionality; if positive, the loop is fully unrolled
+ *                     and `ndim` is ignored; use `DynamicDimensions` to use `ndim`
+ */
+template <int static_ndim, typename DstStride>
+DALI_HOST_DEV DALI_FORCEINLINE uint64_t RemapOffset(uint64_t offset,
+                                                    const fast_div<uint64_t> *src_strides,
+                                                    const DstStride *dst_strides,
+                                                    int ndim = static_ndim) {
+  const int n = static_ndim > 0 ? static_ndim : ndim;
+  uint64_t dst_offset = 0;
+  #pragma unroll
+  for (int d = 0; d < n - 1; d++) {
+    uint64_t idx = div_mod(offset, offset, src_strides[d]);
+    dst_offset += idx * dst_strides[d];
+  }
+  return dst_offset + offset * dst_strides[n - 1];
+}
+
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_COMMON_STATIC_NDIM_H_
@@ -0,0 +1,78 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+#include "dali/kernels/common/static_ndim.h"
+
+namespace dali {
+namespace kernels {
+
+TEST(StaticNDim, Switch) {
+  for (int ndim = 1; ndim <= 6; ndim++) {
+    int result = 0;
+    NDIM_SWITCH(ndim, static_ndim, (
+      result = static_ndim;
+    ));  // NOLINT
+    EXPECT_EQ(result, ndim <= 4 ? ndim : DynamicDimensions);
+  }
+}
+
+template <int static_ndim>
+void TestRemapOffset(const TensorShape<> &shape, const TensorShape<> &perm) {
+  // transposition: decompose the output offset, recombine with the permuted input strides
+  int ndim = shape.size();
+  TensorShape<> in_strides, out_shape = shape;
+  in_strides.resize(ndim);
+  in_strides[ndim - 1] = 1;
+  for (int d = ndim - 2; d >= 0; d--)
+    in_strides[d] = in_strides[d + 1] * shape[d + 1];
+  for (int d = 0; d < ndim; d++)
+    out_shape[d] = shape[perm[d]];
+
+  fast_div<uint64_t> out_strides[6];
+  uint64_t perm_in_strides[6];
+  uint64_t stride = 1;
+  for (int d = ndim - 1; d >= 0; d--) {
+    out_strides[d] = stride;
+    perm_in_strides[d] = in_strides[perm[d]];
+    stride *= out_shape[d];
+  }
+
+  TensorShape<> pos = out_shape;
+  for (int64_t ofs = 0; ofs < volume(out_shape); ofs++) {
+    int64_t r = ofs;
+    for (int d = ndim - 1; d >= 0; d--) {
+      pos[d] = r % out_shape[d];
+      r /= out_shape[d];
+    }
+    uint64_t ref = 0;
+    for (int d = 0; d < ndim; d++)
+      ref += pos[d] * perm_in_strides[d];
+    ASSERT_EQ((RemapOffset<static_ndim>(ofs, out_strides, perm_in_strides, ndim)), ref)
+      << "at offset " << ofs;
+  }
+}
+
+TEST(StaticNDim, RemapOffset) {
+  TestRemapOffset<1>({7}, {0});
+  TestRemapOffset<2>({5, 3}, {1, 0});
+  TestRemapOffset<3>({4, 3, 5}, {2, 0, 1});
+  TestRemapOffset<4>({2, 3, 4, 5}, {3, 1, 0, 2});
+  TestRemapOffset<DynamicDimensions>({2, 3, 2, 4, 3}, {4, 2, 0, 3, 1});
+  TestRemapOffset<DynamicDimensions>({4, 3, 5}, {2, 0, 1});
+}
+
+}  // namespace kernels
+}  // namespace dali
@@ -25,6 +25,7 @@
 #include "dali/core/mm/memory_resource.h"
 #include "dali/core/mm/memory_kind.h"
 #include "dali/core/backend_tags.h"
+#include "dali/kernels/scratch_capture.h"
 
 namespace dali {
 namespace kernels {
@@ -136,7 +137,11 @@ class Scratchpad {
   if_array_like<Collection, T*>
   ToGPU(cudaStream_t stream, const Collection &c) {
     T *ptr = AllocateGPU<T>(size(c));
-    CUDA_CALL(cudaMemcpyAsync(ptr, &c[0], size(c) * sizeof(T), cudaMemcpyHostToDevice, stream));
+    const void *src = &c[0];
+    // the copy may be captured into a CUDA graph, which reads the source when launched
+    if (auto *capture = ScratchpadCapture::Current())
+      src = capture->StageHost(src, size(c) * sizeof(T));
+    CUDA_CALL(cudaMemcpyAsync(ptr, src, size(c) * sizeof(T), cudaMemcpyHostToDevice, stream));
     return ptr;
   }
 
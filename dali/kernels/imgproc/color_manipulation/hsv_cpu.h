@@ -17,6 +17,7 @@
 
 #include <utility>
 #include "dali/core/convert.h"
+#include "dali/kernels/common/simd.h"
 #include "dali/kernels/kernel.h"
 #include "dali/kernels/imgproc/roi.h"
 
@@ -62,8 +63,16 @@ class HsvCpu {
 
     ptrdiff_t row_stride = image_width * num_channels;
     auto *row = in.data + adjusted_roi.lo.y * row_stride;
+    int roi_width = adjusted_roi.hi.x - adjusted_roi.lo.x;
     for (int y = adjusted_roi.lo.y; y < adjusted_roi.hi.y; y++) {
-      for (int x = adjusted_roi.lo.x; x < adjusted_roi.hi.x; x++) {
+      int x = adjusted_roi.lo.x;
+      if (num_channels == hsv::kNchannels) {
+        int vectorized = RunRowSimd(ptr, row + x * num_channels, roi_width,
+                                    hue, saturation, value);
+        ptr += vectorized * hsv::kNchannels;
+        x += vectorized;
+      }
+      for (; x < adjusted_roi.hi.x; x++) {
         auto elem = row + x * num_channels;
         *ptr++ = ConvertSat<OutputType>(*(elem + 0) + hue /*hue hue*/);
         *ptr++ = ConvertSat<OutputType>(*(elem + 1) * saturation);
@@ -72,6 +81,58 @@ class HsvCpu {
       row += row_stride;
     }
   }
+
+ private:
+#ifdef DALI_SIMD_HAS_F32X4
+  static constexpr bool kUseSimd = simd::is_simd_storage<InputType>::value &&
+                                   simd::is_simd_storage<OutputType>::value;
+#else
+  static constexpr bool kUseSimd = false;
+#endif
+
+  /**
+   * @brief Processes the pixels of a row, 16 pixels at a time
+   *
+   * The channels are not deinterleaved - the values are multiplied and offset with vectors
+   * holding the coefficients in the channel order.
+   *
+   * @return the number of pixels processed; the remaining ones are left for the scalar code
+   */
+  template <bool use_simd = kUseSimd>
+  static std::enable_if_t<use_simd, int>
+  RunRowSimd(OutputType *out, const InputType *in, int width,
+             float hue, float saturation, float value) {
+#ifdef DALI_SIMD_HAS_F32X4
+    using interleaved = simd::multivec<12>;
+    constexpr int kPixels = interleaved::kNumLanes / hsv::kNchannels;
+    float offsets[interleaved::kNumLanes], factors[interleaved::kNumLanes];
+    for (int i = 0; i < interleaved::kNumLanes; i += hsv::kNchannels) {
+      offsets[i] = hue;
+      offsets[i + 1] = 0;
+      offsets[i + 2] = 0;
+      factors[i] = 1;
+      factors[i + 1] = saturation;
+      factors[i + 2] = value;
+    }
+    auto offset_vec = interleaved::load(offsets);
+    auto factor_vec = interleaved::load(factors);
+    int x = 0;
+    for (; x + kPixels <= width; x += kPixels) {
+      auto out_vec = offset_vec;
+      simd::madd(out_vec, interleaved::load(in + 3 * x), factor_vec);
+      simd::store(out + 3 * x, out_vec);
+    }
+    return x;
+#else
+    return 0;
+#endif
+  }
+
+  template <bool use_simd = kUseSimd>
+  static std::enable_if_t<!use_simd, int>
+  RunRowSimd(OutputType *, const InputType *, int, float, float, float) {
+    return 0;
+  }
 };
 
 }  // namespace kernels
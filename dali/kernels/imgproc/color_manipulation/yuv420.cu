@@ -0,0 +1,74 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/kernels/imgproc/color_manipulation/yuv420.h"
+#include "dali/core/cuda_error.h"
+
+namespace dali {
+namespace kernels {
+namespace color {
+
+namespace {
+
+__global__ void ToYUV420Kernel(uint8_t *output, const uint8_t *input, YUV420Layout layout,
+                               DALIImageType in_type) {
+  int64_t idx = static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+  if (idx >= layout.chroma_size())
+    return;
+  int64_t by = idx / layout.chroma_width();
+  int64_t bx = idx - by * layout.chroma_width();
+  ToYUV420Block(output, layout, input, in_type, bx, by);
+}
+
+__global__ void FromYUV420Kernel(uint8_t *output, DALIImageType out_type, const uint8_t *input,
+                                 YUV420Layout layout) {
+  int64_t idx = static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+  if (idx >= layout.luma_size())
+    return;
+  int64_t y = idx / layout.width;
+  int64_t x = idx - y * layout.width;
+  FromYUV420Pixel(output, out_type, input, layout, x, y);
+}
+
+}  // namespace
+
+void RunYUV420ConversionKernel(uint8_t *output, const uint8_t *input,
+                               DALIImageType out_type, DALIImageType in_type,
+                               const YUV420Layout &layout, cudaStream_t stream) {
+  auto is_interleaved = [](DALIImageType type) {
+    return type == DALI_RGB || type == DALI_BGR || type == DALI_GRAY || type == DALI_YCbCr;
+  };
+  // each thread produces a chroma sample (and the 2x2 block of luma) or an output pixel
+  int64_t nthreads = 0;
+  if (out_type == DALI_YUV420 && is_interleaved(in_type)) {
+    nthreads = layout.chroma_size();
+  } else if (in_type == DALI_YUV420 && is_interleaved(out_type)) {
+    nthreads = layout.luma_size();
+  } else {
+    DALI_FAIL(make_string("conversion not supported ", in_type, " to ", out_type));
+  }
+  if (nthreads == 0)
+    return;
+  const unsigned int block = nthreads < 256 ? nthreads : 256;
+  const unsigned int grid = (nthreads + block - 1) / block;
+  if (out_type == DALI_YUV420)
+    ToYUV420Kernel<<<grid, block, 0, stream>>>(output, input, layout, in_type);
+  else
+    FromYUV420Kernel<<<grid, block, 0, stream>>>(output, out_type, input, layout);
+  CUDA_CALL(cudaGetLastError());
+}
+
+}  // namespace color
+}  // namespace kernels
+}  // namespace dali
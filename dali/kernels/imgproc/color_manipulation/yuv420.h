@@ -0,0 +1,199 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_KERNELS_IMGPROC_COLOR_MANIPULATION_YUV420_H_
+#define DALI_KERNELS_IMGPROC_COLOR_MANIPULATION_YUV420_H_
+
+#include <cuda_runtime_api.h>
+#include <algorithm>
+#include "dali/core/common.h"
+#include "dali/core/error_handling.h"
+#include "dali/core/tensor_shape.h"
+#include "dali/kernels/imgproc/color_manipulation/color_space_conversion_impl.h"
+
+namespace dali {
+namespace kernels {
+namespace color {
+
+/**
+ * @brief Describes the planes of a YUV 4:2:0 (DALI_YUV420) image stored in a 2D tensor
+ *
+ * The planes are stored one after another: the full resolution Y plane, followed by the Cb (U)
+ * and Cr (V) planes, subsampled 2x in both dimensions (rounding up). The tensor has the width
+ * of the image and as many rows as needed to hold all the planes - for even widths this is
+ * the usual I420 layout with `height + ceil(height / 2)` rows.
+ *
+ * The values follow the YCbCr definition used for DALI_YCbCr (ITU-R BT.601).
+ */
+struct YUV420Layout {
+  int64_t height = 0, width = 0;
+
+  DALI_HOST_DEV constexpr int64_t chroma_height() const { return (height + 1) >> 1; }
+  DALI_HOST_DEV constexpr int64_t chroma_width() const { return (width + 1) >> 1; }
+
+  DALI_HOST_DEV constexpr int64_t luma_size() const { return height * width; }
+  DALI_HOST_DEV constexpr int64_t chroma_size() const { return chroma_height() * chroma_width(); }
+
+  DALI_HOST_DEV constexpr int64_t u_offset() const { return luma_size(); }
+  DALI_HOST_DEV constexpr int64_t v_offset() const { return luma_size() + chroma_size(); }
+
+  /**
+   * @brief Number of rows of the tensor holding the planes
+   */
+  DALI_HOST_DEV constexpr int64_t rows() const {
+    return width > 0 ? height + (2 * chroma_size() + width - 1) / width : 0;
+  }
+
+  TensorShape<2> shape() const {
+    return { rows(), width };
+  }
+
+  /**
+   * @brief Recovers the size of the image from the shape of the tensor holding its planes
+   */
+  static YUV420Layout FromShape(int64_t rows, int64_t width) {
+    YUV420Layout layout;
+    layout.width = width;
+    if (rows == 0 || width == 0)
+      return layout;
+    // the planes take between 1.5 and 2 times the height (plus rounding) - and the number
+    // of rows grows with the height, so the first height that gives enough rows is the only
+    // candidate
+    for (int64_t h = std::max<int64_t>((rows - 1) / 2, 0); h <= rows; h++) {
+      layout.height = h;
+      if (layout.rows() >= rows)
+        break;
+    }
+    DALI_ENFORCE(layout.rows() == rows, make_string("A tensor of shape ", rows, "x", width,
+                 " doesn't hold a valid YUV 4:2:0 image."));
+    return layout;
+  }
+};
+
+/**
+ * @brief Converts a pixel of an interleaved RGB, BGR, GRAY or YCbCr image to YCbCr
+ */
+DALI_HOST_DEV DALI_FORCEINLINE vec<3, uint8_t> PixelToYCbCr(const uint8_t *in,
+                                                            DALIImageType type) {
+  vec<3, uint8_t> out;
+  switch (type) {
+    case DALI_GRAY:
+      out[0] = itu_r_bt_601::gray_to_y<uint8_t>(in[0]);
+      out[1] = 128;
+      out[2] = 128;
+      return out;
+    case DALI_YCbCr:
+      out[0] = in[0];
+      out[1] = in[1];
+      out[2] = in[2];
+      return out;
+    default: {
+      vec<3, uint8_t> rgb;
+      rgb[0] = in[type == DALI_BGR ? 2 : 0];
+      rgb[1] = in[1];
+      rgb[2] = in[type == DALI_BGR ? 0 : 2];
+      out[0] = itu_r_bt_601::rgb_to_y<uint8_t>(rgb);
+      out[1] = itu_r_bt_601::rgb_to_cb<uint8_t>(rgb);
+      out[2] = itu_r_bt_601::rgb_to_cr<uint8_t>(rgb);
+      return out;
+    }
+  }
+}
+
+/**
+ * @brief Converts a YCbCr pixel to an interleaved RGB, BGR, GRAY or YCbCr pixel
+ */
+DALI_HOST_DEV DALI_FORCEINLINE void YCbCrToPixel(uint8_t *out, vec<3, uint8_t> ycbcr,
+                                                 DALIImageType type) {
+  switch (type) {
+    case DALI_GRAY:
+      out[0] = itu_r_bt_601::y_to_gray<uint8_t>(ycbcr[0]);
+      return;
+    case DALI_YCbCr:
+      out[0] = ycbcr[0];
+      out[1] = ycbcr[1];
+      out[2] = ycbcr[2];
+      return;
+    default: {
+      auto rgb = itu_r_bt_601::ycbcr_to_rgb<uint8_t>(ycbcr);
+      out[type == DALI_BGR ? 2 : 0] = rgb[0];
+      out[1] = rgb[1];
+      out[type == DALI_BGR ? 0 : 2] = rgb[2];
+      return;
+    }
+  }
+}
+
+/**
+ * @brief Converts a 2x2 block of an interleaved image to YUV 4:2:0
+ *
+ * The chroma of the block is the average of the chroma of its pixels.
+ *
+ * @param bx, by  coordinates of the block (i.e. of the chroma sample)
+ */
+DALI_HOST_DEV DALI_FORCEINLINE void ToYUV420Block(uint8_t *out, const YUV420Layout &layout,
+                                                  const uint8_t *in, DALIImageType in_type,
+                                                  int64_t bx, int64_t by) {
+  int nchannels = in_type == DALI_GRAY ? 1 : 3;
+  int cb = 0, cr = 0, n = 0;
+  for (int64_t y = 2 * by; y < 2 * by + 2 && y < layout.height; y++) {
+    for (int64_t x = 2 * bx; x < 2 * bx + 2 && x < layout.width; x++) {
+      int64_t idx = y * layout.width + x;
+      auto ycbcr = PixelToYCbCr(in + idx * nchannels, in_type);
+      out[idx] = ycbcr[0];
+      cb += ycbcr[1];
+      cr += ycbcr[2];
+      n++;
+    }
+  }
+  int64_t chroma_idx = by * layout.chroma_width() + bx;
+  out[layout.u_offset() + chroma_idx] = (cb + n / 2) / n;
+  out[layout.v_offset() + chroma_idx] = (cr + n / 2) / n;
+}
+
+/**
+ * @brief Converts a pixel of a YUV 4:2:0 image to an interleaved image
+ *
+ * The chroma is taken from the chroma sample covering the pixel (no interpolation).
+ */
+DALI_HOST_DEV DALI_FORCEINLINE void FromYUV420Pixel(uint8_t *out, DALIImageType out_type,
+                                                    const uint8_t *in, const YUV420Layout &layout,
+                                                    int64_t x, int64_t y) {
+  int nchannels = out_type == DALI_GRAY ? 1 : 3;
+  int64_t idx = y * layout.width + x;
+  int64_t chroma_idx = (y >> 1) * layout.chroma_width() + (x >> 1);
+  vec<3, uint8_t> ycbcr;
+  ycbcr[0] = in[idx];
+  ycbcr[1] = in[layout.u_offset() + chroma_idx];
+  ycbcr[2] = in[layout.v_offset() + chroma_idx];
+  YCbCrToPixel(out + idx * nchannels, ycbcr, out_type);
+}
+
+/**
+ * @brief Converts an interleaved image to YUV 4:2:0 or the other way around on the GPU
+ *
+ * One of `in_type` and `out_type` must be DALI_YUV420; the other one can be DALI_RGB, DALI_BGR,
+ * DALI_GRAY or DALI_YCbCr.
+ *
+ * @param layout  the planes of the YUV 4:2:0 image
+ */
+DLL_PUBLIC void RunYUV420ConversionKernel(uint8_t *output, const uint8_t *input,
+                                          DALIImageType out_type, DALIImageType in_type,
+                                          const YUV420Layout &layout, cudaStream_t stream);
+
+}  // namespace color
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_IMGPROC_COLOR_MANIPULATION_YUV420_H_
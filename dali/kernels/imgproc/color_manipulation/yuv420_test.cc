@@ -0,0 +1,80 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <vector>
+#include "dali/kernels/imgproc/color_manipulation/yuv420.h"
+
+namespace dali {
+namespace kernels {
+namespace color {
+
+TEST(YUV420Layout, FromShape) {
+  for (int64_t height = 1; height < 40; height++) {
+    for (int64_t width = 1; width < 40; width++) {
+      YUV420Layout layout{height, width};
+      EXPECT_GE(layout.rows() * layout.width, layout.v_offset() + layout.chroma_size());
+      auto sh = layout.shape();
+      auto recovered = YUV420Layout::FromShape(sh[0], sh[1]);
+      EXPECT_EQ(recovered.height, height);
+      EXPECT_EQ(recovered.width, width);
+    }
+  }
+  // I420 layout for even widths
+  EXPECT_EQ(YUV420Layout({480, 640}).shape(), TensorShape<2>(720, 640));
+  EXPECT_EQ(YUV420Layout({5, 4}).shape(), TensorShape<2>(8, 4));
+  // 4 rows of width 4 can't hold the planes of any image
+  EXPECT_THROW(YUV420Layout::FromShape(4, 4), std::exception);
+}
+
+TEST(YUV420Conversion, RoundTripRGB) {
+  // the chroma is constant in each 2x2 block, so the conversion loses only the rounding
+  const int64_t height = 7, width = 9;
+  YUV420Layout layout{height, width};
+  std::vector<uint8_t> rgb(height * width * 3), yuv(layout.rows() * width), out(rgb.size());
+  for (int64_t y = 0; y < height; y++) {
+    for (int64_t x = 0; x < width; x++) {
+      uint8_t *px = &rgb[(y * width + x) * 3];
+      px[0] = 40 + 10 * (y / 2);
+      px[1] = 60 + 10 * (x / 2);
+      px[2] = 100;
+    }
+  }
+  for (int64_t by = 0; by < layout.chroma_height(); by++)
+    for (int64_t bx = 0; bx < layout.chroma_width(); bx++)
+      ToYUV420Block(yuv.data(), layout, rgb.data(), DALI_RGB, bx, by);
+  for (int64_t y = 0; y < height; y++)
+    for (int64_t x = 0; x < width; x++)
+      FromYUV420Pixel(out.data(), DALI_RGB, yuv.data(), layout, x, y);
+  for (size_t i = 0; i < rgb.size(); i++)
+    EXPECT_LE(std::abs(out[i] - rgb[i]), 3) << " at " << i;
+}
+
+TEST(YUV420Conversion, ChromaAverage) {
+  YUV420Layout layout{2, 2};
+  // two black and two white pixels - the luma is kept and the chroma is neutral
+  uint8_t gray[4] = { 0, 255, 255, 0 };
+  uint8_t yuv[6];
+  ToYUV420Block(yuv, layout, gray, DALI_GRAY, 0, 0);
+  EXPECT_LT(yuv[0], yuv[1]);
+  EXPECT_EQ(yuv[1], yuv[2]);
+  EXPECT_EQ(yuv[0], yuv[3]);
+  EXPECT_EQ(yuv[4], 128);
+  EXPECT_EQ(yuv[5], 128);
+}
+
+}  // namespace color
+}  // namespace kernels
+}  // namespace dali
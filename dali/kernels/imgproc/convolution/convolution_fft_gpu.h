@@ -0,0 +1,269 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_KERNELS_IMGPROC_CONVOLUTION_CONVOLUTION_FFT_GPU_H_
+#define DALI_KERNELS_IMGPROC_CONVOLUTION_CONVOLUTION_FFT_GPU_H_
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include "dali/core/boundary.h"
+#include "dali/core/convert.h"
+#include "dali/core/format.h"
+#include "dali/core/tensor_view.h"
+#include "dali/core/util.h"
+#include "dali/kernels/imgproc/convolution/fft_convolver_gpu.h"
+#include "dali/kernels/kernel.h"
+
+namespace dali {
+namespace kernels {
+
+namespace conv_fft {
+
+/**
+ * @brief Returns the smallest size, not less than `min_size`, with no prime factors
+ *        greater than 7, for which cuFFT uses its most efficient algorithms.
+ */
+inline int FftSize(int64_t min_size) {
+  for (int64_t n = std::max<int64_t>(min_size, 1); ; n++) {
+    int64_t m = n;
+    for (int f : { 2, 3, 5, 7 })
+      while (m % f == 0)
+        m /= f;
+    if (m == 1) {
+      DALI_ENFORCE(n <= std::numeric_limits<int>::max(), "The FFT size is too big");
+      return n;
+    }
+  }
+}
+
+/**
+ * @brief Places the signals along the convolution axis in the transform buffer,
+ *        padding them with `radius` elements on both sides, with border reflect 101.
+ *
+ * The elements past the padded signal are zeroed.
+ */
+template <typename In>
+__global__ void GatherSignals(float *__restrict__ signals, FftConvolutionLayout layout,
+                              const In *__restrict__ in, int64_t length, int radius) {
+  int64_t total = layout.num_elements();
+  int64_t padded_length = length + 2 * radius;
+  int64_t inner = layout.batch;
+  for (int64_t idx = static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+       idx < total;
+       idx += static_cast<int64_t>(blockDim.x) * gridDim.x) {
+    int64_t plane, i, q;
+    if (layout.interleaved) {
+      int64_t plane_elements = layout.n * inner;
+      plane = idx / plane_elements;
+      int64_t r = idx - plane * plane_elements;
+      i = r / inner;
+      q = r - i * inner;
+    } else {
+      int64_t row = idx / layout.n;
+      i = idx - row * layout.n;
+      plane = row / inner;
+      q = row - plane * inner;
+    }
+    float value = 0;
+    if (i < padded_length) {
+      int64_t x = boundary::idx_reflect_101(i - radius, length);
+      value = static_cast<float>(in[(plane * length + x) * inner + q]);
+    }
+    signals[idx] = value;
+  }
+}
+
+/**
+ * @brief Stores the first `length` elements of the correlated signals in the output
+ */
+template <typename Out>
+__global__ void ScatterSignals(Out *__restrict__ out, int64_t length,
+                               const float *__restrict__ signals, FftConvolutionLayout layout) {
+  int64_t inner = layout.batch;
+  int64_t total = layout.planes * length * inner;
+  for (int64_t idx = static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+       idx < total;
+       idx += static_cast<int64_t>(blockDim.x) * gridDim.x) {
+    int64_t row = idx / inner;
+    int64_t q = idx - row * inner;
+    int64_t plane = row / length;
+    int64_t i = row - plane * length;
+    int64_t src = layout.interleaved
+                ? (plane * layout.n + i) * inner + q
+                : (plane * inner + q) * layout.n + i;
+    out[idx] = ConvertSat<Out>(signals[src]);
+  }
+}
+
+inline int GridSize(int64_t total, int block) {
+  return std::max<int64_t>(1, std::min<int64_t>(div_ceil(total, block), 1024));
+}
+
+}  // namespace conv_fft
+
+/**
+ * @brief Apply a convolution with a 1-channel `window` in the specified axis,
+ *        using Fast Fourier Transform.
+ *
+ * The interface and the results are the same as those of ConvolutionGpu: the window is
+ * centered and the borders are handled with reflect 101. The calculations are done in
+ * single precision, regardless of the input and output types.
+ *
+ * The cost doesn't depend on the window size, which makes this implementation preferable
+ * for long windows; the samples are processed one by one, reusing the temporary buffers.
+ *
+ * Each signal along the convolution axis is padded by the window radius on both sides
+ * and the circular correlation with the window is calculated:
+ * ```
+ * out[i] = sum(padded[i + k] * window[k] for k in [0, window_size))
+ * ```
+ * The transform size is at least `length + window_size - 1`, so that the valid part of the
+ * result is not affected by the wrap-around.
+ */
+template <typename Out, typename In, typename W, int ndim, int axis, bool has_channels = true>
+struct ConvolutionFftGpu {
+  static_assert(0 <= axis && axis < ndim - has_channels,
+                "Selected axis must be in [0, ndim) when there is no channel axis, or in [0, ndim "
+                "- 1) for channel-last input");
+
+  KernelRequirements Setup(KernelContext& ctx, const TensorListShape<ndim>& in_shape,
+                           const TensorListShape<1>& window_size) {
+    DALI_ENFORCE(
+        in_shape.size() == window_size.size(),
+        make_string(
+            "Provided input shape and window sizes should have the same number of samples. Got: ",
+            in_shape.size(), " vs ", window_size.size(), "."));
+    int num_samples = in_shape.size();
+    convolver_.TrimPlans();
+    layouts_.resize(num_samples);
+
+    int64_t max_elements = 0, max_bins = 0, total_window = 0, max_window_bins = 0;
+    size_t max_work = 0;
+    for (int i = 0; i < num_samples; i++) {
+      DALI_ENFORCE(
+          window_size[i][0] % 2 == 1,
+          make_string(
+              "Even or non-centered windows are not supported yet, got window with even length: ",
+              window_size[i][0], " for sample ", i, "."));
+      auto sample_shape = in_shape[i];
+      int64_t length = sample_shape[axis];
+      int64_t inner = volume(sample_shape.begin() + axis + 1, sample_shape.end());
+      DALI_ENFORCE(inner <= std::numeric_limits<int>::max(),
+                   make_string("The sample ", i, " is too big for the FFT convolution."));
+      auto &layout = layouts_[i];
+      layout.n = conv_fft::FftSize(length + window_size[i][0] - 1);
+      layout.batch = inner;
+      layout.planes = volume(sample_shape.begin(), sample_shape.begin() + axis);
+      // Interleaving the signals avoids the transposition when there's enough of them
+      // to be read and written in a coalesced manner; otherwise there would be too many
+      // small transforms.
+      layout.interleaved = inner >= kMinInterleavedSignals;
+
+      max_elements = std::max(max_elements, layout.num_elements());
+      max_bins = std::max(max_bins, layout.num_bins());
+      total_window += layout.n;
+      max_window_bins = std::max<int64_t>(max_window_bins, layout.n / 2 + 1);
+      max_work = std::max(max_work, convolver_.Plan(layout));
+    }
+
+    KernelRequirements req;
+    ScratchpadEstimator se;
+    se.add<mm::memory_kind::host, float>(total_window);
+    se.add<mm::memory_kind::device, float>(total_window);
+    se.add<mm::memory_kind::device, float>(max_elements, alignof(float2));
+    se.add<mm::memory_kind::device, float2>(max_bins);
+    se.add<mm::memory_kind::device, float2>(max_window_bins);
+    se.add<mm::memory_kind::device, char>(max_work, alignof(double2));
+    req.scratch_sizes = se.sizes;
+    req.output_shapes.push_back(in_shape);
+    total_window_ = total_window;
+    max_elements_ = max_elements;
+    max_bins_ = max_bins;
+    max_window_bins_ = max_window_bins;
+    max_work_ = max_work;
+    return req;
+  }
+
+  void Run(KernelContext& ctx, const TensorListView<StorageGPU, Out, ndim> out,
+           const TensorListView<StorageGPU, const In, ndim>& in,
+           const TensorListView<StorageCPU, const W, 1>& windows,
+           span<const int> window_anchors = {}, float scale = 1) {
+    int num_samples = in.size();
+    cudaStream_t stream = ctx.gpu.stream;
+    DALI_ENFORCE(
+        window_anchors.size() == num_samples || window_anchors.size() == 0,
+        make_string(
+            "Unexpected number of window_anchors, expected either anchors for all samples ( ",
+            num_samples,
+            ") or no anchors for windows centered by default, got: ", window_anchors.size(), "."));
+    assert(static_cast<int>(layouts_.size()) == num_samples);
+
+    float *windows_cpu = ctx.scratchpad->AllocateHost<float>(total_window_);
+    std::fill(windows_cpu, windows_cpu + total_window_, 0.0f);
+    int64_t window_offset = 0;
+    for (int i = 0; i < num_samples; i++) {
+      int window_size = windows.tensor_shape_span(i)[0];
+      if (window_anchors.size()) {
+        DALI_ENFORCE(
+            window_anchors[i] == window_size / 2,
+            make_string("Support for non-centered window is not yet implemented, got anchor: ",
+                        window_anchors[i], ", expected:", window_size / 2,  "."));
+      }
+      for (int k = 0; k < window_size; k++)
+        windows_cpu[window_offset + k] = static_cast<float>(windows.tensor_data(i)[k]);
+      window_offset += layouts_[i].n;
+    }
+    float *windows_gpu = ctx.scratchpad->ToGPU(stream, make_span(windows_cpu, total_window_));
+
+    auto *signals = ctx.scratchpad->AllocateGPU<float>(max_elements_, alignof(float2));
+    auto *spectra = ctx.scratchpad->AllocateGPU<float2>(max_bins_);
+    auto *window_spectrum = ctx.scratchpad->AllocateGPU<float2>(max_window_bins_);
+    auto *work = ctx.scratchpad->AllocateGPU<char>(max_work_, alignof(double2));
+
+    window_offset = 0;
+    for (int i = 0; i < num_samples; i++) {
+      const auto &layout = layouts_[i];
+      int64_t length = in.tensor_shape_span(i)[axis];
+      int radius = windows.tensor_shape_span(i)[0] / 2;
+
+      int block = 256;
+      conv_fft::GatherSignals<<<conv_fft::GridSize(layout.num_elements(), block), block, 0,
+                                stream>>>(signals, layout, in.tensor_data(i), length, radius);
+      CUDA_CALL(cudaGetLastError());
+
+      convolver_.Run(layout, signals, spectra, windows_gpu + window_offset, window_spectrum,
+                     scale, work, stream);
+      window_offset += layout.n;
+
+      int64_t out_elements = layout.planes * length * layout.batch;
+      conv_fft::ScatterSignals<<<conv_fft::GridSize(out_elements, block), block, 0, stream>>>(
+          out.tensor_data(i), length, signals, layout);
+      CUDA_CALL(cudaGetLastError());
+    }
+  }
+
+ private:
+  static constexpr int kMinInterleavedSignals = 32;
+
+  FftConvolverGPU convolver_;
+  std::vector<FftConvolutionLayout> layouts_;
+  int64_t total_window_ = 0, max_elements_ = 0, max_bins_ = 0, max_window_bins_ = 0;
+  size_t max_work_ = 0;
+};
+
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_IMGPROC_CONVOLUTION_CONVOLUTION_FFT_GPU_H_
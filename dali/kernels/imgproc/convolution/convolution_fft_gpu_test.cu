@@ -0,0 +1,173 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "dali/kernels/imgproc/convolution/convolution_cpu.h"
+#include "dali/kernels/imgproc/convolution/convolution_fft_gpu.h"
+#include "dali/kernels/imgproc/convolution/convolution_gpu.h"
+#include "dali/kernels/scratch.h"
+#include "dali/test/tensor_test_utils.h"
+#include "dali/test/test_tensors.h"
+
+namespace dali {
+namespace kernels {
+
+TEST(ConvolutionFftGpu, FftSize) {
+  EXPECT_EQ(conv_fft::FftSize(1), 1);
+  EXPECT_EQ(conv_fft::FftSize(11), 12);
+  EXPECT_EQ(conv_fft::FftSize(97), 98);
+  EXPECT_EQ(conv_fft::FftSize(1000), 1000);
+  EXPECT_EQ(conv_fft::FftSize(1001), 1008);
+}
+
+template <int ndim_, bool has_channels_, int axis_, typename InType_, typename OutType_ = float>
+struct fft_convolution_params {
+  static constexpr int ndim = ndim_;
+  static constexpr bool has_channels = has_channels_;
+  static constexpr int axis = axis_;
+  using InType = InType_;
+  using OutType = OutType_;
+};
+
+template <typename T>
+struct ConvolutionFftGpuTest : public ::testing::Test {
+  using InType = typename T::InType;
+  using OutType = typename T::OutType;
+  using KernelCpu = ConvolutionCpu<OutType, InType, float, T::ndim, T::axis, T::has_channels>;
+  using KernelGpu = ConvolutionGpu<OutType, InType, float, T::ndim, T::axis, T::has_channels>;
+
+  TensorListShape<T::ndim> GetShape() {
+    if (T::has_channels) {
+      return shape_ch_.template last<T::ndim>();
+    } else {
+      return shape_noch_.template last<T::ndim>();
+    }
+  }
+
+  void SetUp() override {
+    kernel_window_.reshape(shape_window_);
+    k_win_ = kernel_window_.cpu();
+
+    std::mt19937 rng;
+    std::uniform_real_distribution<float> dist(0, 1);
+    for (int sample = 0; sample < shape_window_.num_samples(); sample++) {
+      int window_size = shape_window_[sample][0];
+      float sum = 0;
+      for (int i = 0; i < window_size; i++)
+        sum += (k_win_[sample].data[i] = dist(rng));
+      for (int i = 0; i < window_size; i++)
+        k_win_[sample].data[i] /= sum;
+    }
+
+    input_.reshape(GetShape());
+    baseline_in_ = input_.cpu();
+    UniformRandomFill(baseline_in_, rng, 0, 255);
+    in_ = input_.gpu();
+
+    output_.reshape(GetShape());
+    out_ = output_.gpu();
+    baseline_output_.reshape(GetShape());
+    baseline_out_ = baseline_output_.cpu();
+  }
+
+  void RunTest() {
+    KernelContext ctx_cpu, ctx_gpu;
+    KernelCpu kernel_cpu;
+    KernelGpu kernel_gpu;
+
+    auto data_shape = GetShape();
+    int num_samples = data_shape.size();
+
+    for (int sample = 0; sample < num_samples; sample++) {
+      int window_size = shape_window_[sample][0];
+      auto req = kernel_cpu.Setup(ctx_cpu, data_shape[sample], window_size);
+
+      ScratchpadAllocator scratch_alloc;
+      scratch_alloc.Reserve(req.scratch_sizes);
+      auto scratchpad = scratch_alloc.GetScratchpad();
+      ctx_cpu.scratchpad = &scratchpad;
+
+      kernel_cpu.Run(ctx_cpu, baseline_out_[sample], baseline_in_[sample], k_win_[sample], 0.5f);
+    }
+
+    // run twice to check that the plans and buffers are reused correctly
+    for (int iter = 0; iter < 2; iter++) {
+      auto req = kernel_gpu.Setup(ctx_gpu, in_.shape, shape_window_);
+
+      ScratchpadAllocator scratch_alloc;
+      scratch_alloc.Reserve(req.scratch_sizes);
+      auto scratchpad = scratch_alloc.GetScratchpad();
+      ctx_gpu.scratchpad = &scratchpad;
+      kernel_gpu.Run(ctx_gpu, out_, in_, k_win_, span<const int>{}, 0.5f);
+
+      auto out_cpu = output_.cpu();
+      // the results for integral outputs may be rounded differently
+      double eps = std::is_integral<OutType>::value ? 1 : 0.01;
+      Check(out_cpu, baseline_out_, EqualEps(eps));
+    }
+  }
+
+  TestTensorList<float, 1> kernel_window_;
+  TestTensorList<InType, T::ndim> input_;
+  TestTensorList<OutType, T::ndim> output_;
+  TestTensorList<OutType, T::ndim> baseline_output_;
+
+  TensorListView<StorageCPU, float, 1> k_win_;
+  TensorListView<StorageGPU, InType, T::ndim> in_;
+  TensorListView<StorageGPU, OutType, T::ndim> out_;
+  TensorListView<StorageCPU, InType, T::ndim> baseline_in_;
+  TensorListView<StorageCPU, OutType, T::ndim> baseline_out_;
+
+  const TensorListShape<> shape_ch_ = {{29, 145, 128, 3}, {16, 200, 180, 3}, {40, 1, 300, 3},
+                                       {20, 64, 64, 1}, {7, 300, 64, 4}};
+  const TensorListShape<> shape_noch_ = {{29, 145, 128}, {16, 200, 180}, {40, 1, 300},
+                                         {20, 64, 64}, {7, 300, 64}};
+  // Mixes the windows processed with FFT (long ones) and with GEMM (the short one);
+  // the windows longer than the axis exercise the repeated reflection at the borders.
+  const TensorListShape<1> shape_window_ = {{129, 301, 255, 15, 1001}};
+};
+
+TYPED_TEST_SUITE_P(ConvolutionFftGpuTest);
+
+using ConvolutionFftTestValues = ::testing::Types<
+    // 1D
+    fft_convolution_params<1, false, 0, float>,
+    fft_convolution_params<1, false, 0, uint8_t, uint8_t>,
+    // 2D outer
+    fft_convolution_params<2, false, 0, float>,
+    // 2D inner
+    fft_convolution_params<2, false, 1, float>,
+    // 2D outer with channels
+    fft_convolution_params<3, true, 0, uint8_t>,
+    // 2D inner with channels
+    fft_convolution_params<3, true, 1, uint8_t>,
+    // 3D outer, middle and inner with channels
+    fft_convolution_params<4, true, 0, float>,
+    fft_convolution_params<4, true, 1, float>,
+    fft_convolution_params<4, true, 2, float>>;
+
+TYPED_TEST_P(ConvolutionFftGpuTest, DoConvolution) {
+  this->RunTest();
+}
+
+REGISTER_TYPED_TEST_SUITE_P(ConvolutionFftGpuTest, DoConvolution);
+INSTANTIATE_TYPED_TEST_SUITE_P(ConvolutionFftGpu, ConvolutionFftGpuTest,
+                               ConvolutionFftTestValues);
+
+}  // namespace kernels
+}  // namespace dali
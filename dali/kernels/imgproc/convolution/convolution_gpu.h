@@ -15,11 +15,13 @@
 #ifndef DALI_KERNELS_IMGPROC_CONVOLUTION_CONVOLUTION_GPU_H_
 #define DALI_KERNELS_IMGPROC_CONVOLUTION_CONVOLUTION_GPU_H_
 
+#include <vector>
 #include "dali/core/boundary.h"
 #include "dali/core/convert.h"
 #include "dali/core/format.h"
 #include "dali/core/tensor_view.h"
 #include "dali/kernels/common/utils.h"
+#include "dali/kernels/imgproc/convolution/convolution_fft_gpu.h"
 #include "dali/kernels/imgproc/convolution/cutlass/device/gemm.h"
 #include "dali/kernels/imgproc/convolution/cutlass/utility.h"
 #include "dali/kernels/kernel.h"
@@ -52,19 +54,24 @@ namespace kernels {
  * We're intersted in the multiplication only, the C matrix is zeroed by the provided beta.
  * A and B correspond to `in` and `window` (the order depends on whether it's an inner or an outer
  * convolution). Effectively, we calculate ``D = alpha * A * B``.
+ *
+ * The samples with windows longer than `kFftWindowThreshold` or too big to fit in the shared
+ * memory are processed with ConvolutionFftGpu instead, as its cost doesn't depend on the window
+ * size.
  */
 template <typename Out, typename In, typename W, int ndim, int axis, bool has_channels = true>
 struct ConvolutionGpu {
   KernelRequirements Setup(KernelContext& ctx, const TensorListShape<ndim>& in_shape,
                            const TensorListShape<1>& window_size) {
     KernelRequirements req;
-    ScratchpadEstimator se;
     DALI_ENFORCE(
         in_shape.size() == window_size.size(),
         make_string(
             "Provided input shape and window sizes should have the same number of samples. Got: ",
             in_shape.size(), " vs ", window_size.size(), "."));
     int num_samples = in_shape.size();
+    gemm_samples_.clear();
+    fft_samples_.clear();
     for (int i = 0; i < num_samples; i++) {
       int num_channels = has_channels ? in_shape[i][ndim - 1] : 1;
       DALI_ENFORCE(
@@ -72,15 +79,28 @@ struct ConvolutionGpu {
           make_string(
               "Even or non-centered windows are not supported yet, got window with even length: ",
               window_size, " for sample ", i, "."));
-
-      DALI_ENFORCE(window_size[i][0] * num_channels < kMaxWindowSize,
-                   make_string("Window is too big for sample ", i, ", got: ", window_size[i][0],
-                               ", expected at most: ", kMaxWindowSize / num_channels, "."));
+      // The cost of GEMM-based convolution grows linearly with the window size and it
+      // can't handle windows that don't fit in the shared memory.
+      if (window_size[i][0] > kFftWindowThreshold ||
+          window_size[i][0] * num_channels >= kMaxWindowSize) {
+        fft_samples_.push_back(i);
+      } else {
+        gemm_samples_.push_back(i);
+      }
+    }
+    if (!gemm_samples_.empty()) {
+      ScratchpadEstimator se;
+      int num_gemm_samples = gemm_samples_.size();
+      se.add<mm::memory_kind::host, W>(num_gemm_samples * kWindowCopyBufferSize);
+      se.add<mm::memory_kind::device, W>(num_gemm_samples * kWindowCopyBufferSize);
+      se.add<mm::memory_kind::device, typename CutlassConv::SampleParams>(num_gemm_samples);
+      req.scratch_sizes = se.sizes;
+    }
+    if (!fft_samples_.empty()) {
+      auto req_fft = conv_fft_.Setup(ctx, SelectSamples(in_shape, fft_samples_),
+                                     SelectSamples(window_size, fft_samples_));
+      req.scratch_sizes = AppendScratchSize(req.scratch_sizes, req_fft.scratch_sizes);
     }
-    se.add<mm::memory_kind::host, W>(num_samples * kWindowCopyBufferSize);
-    se.add<mm::memory_kind::device, W>(num_samples * kWindowCopyBufferSize);
-    se.add<mm::memory_kind::device, typename CutlassConv::SampleParams>(num_samples);
-    req.scratch_sizes = se.sizes;
     req.output_shapes.push_back(in_shape);
     return req;
   }
@@ -97,6 +117,33 @@ struct ConvolutionGpu {
             "Unexpected number of window_anchors, expected either anchors for all samples ( ",
             num_samples,
             ") or no anchors for windows centered by default, got: ", window_anchors.size(), "."));
+    if (fft_samples_.empty()) {
+      RunGemm(ctx, out, in, windows, window_anchors, scale);
+    } else if (gemm_samples_.empty()) {
+      conv_fft_.Run(ctx, out, in, windows, window_anchors, scale);
+    } else {
+      std::vector<int> anchors;
+      auto select_anchors = [&](const std::vector<int> &indices) {
+        anchors.clear();
+        if (window_anchors.size()) {
+          for (int idx : indices)
+            anchors.push_back(window_anchors[idx]);
+        }
+        return make_cspan(anchors);
+      };
+      RunGemm(ctx, SelectSamples(out, gemm_samples_), SelectSamples(in, gemm_samples_),
+              SelectSamples(windows, gemm_samples_), select_anchors(gemm_samples_), scale);
+      conv_fft_.Run(ctx, SelectSamples(out, fft_samples_), SelectSamples(in, fft_samples_),
+                    SelectSamples(windows, fft_samples_), select_anchors(fft_samples_), scale);
+    }
+  }
+
+ private:
+  void RunGemm(KernelContext& ctx, const TensorListView<StorageGPU, Out, ndim> out,
+               const TensorListView<StorageGPU, const In, ndim>& in,
+               const TensorListView<StorageCPU, const W, 1>& windows,
+               span<const int> window_anchors, float scale) {
+    int num_samples = in.size();
     auto* window_tmp_buffer_host_ptr =
         ctx.scratchpad->AllocateHost<W>(num_samples * kWindowCopyBufferSize);
     span<W> window_tmp_buffer_host(window_tmp_buffer_host_ptr, num_samples * kWindowCopyBufferSize);
@@ -202,7 +249,28 @@ struct ConvolutionGpu {
     gemm_operator(args, ctx.gpu.stream);
   }
 
- private:
+  template <int sample_ndim>
+  static TensorListShape<sample_ndim> SelectSamples(const TensorListShape<sample_ndim> &shape,
+                                                   const std::vector<int> &indices) {
+    TensorListShape<sample_ndim> result;
+    result.resize(indices.size(), shape.sample_dim());
+    for (size_t i = 0; i < indices.size(); i++)
+      result.set_tensor_shape(i, shape.tensor_shape_span(indices[i]));
+    return result;
+  }
+
+  template <typename Backend, typename T, int sample_ndim>
+  static TensorListView<Backend, T, sample_ndim> SelectSamples(
+      const TensorListView<Backend, T, sample_ndim> &tlv, const std::vector<int> &indices) {
+    TensorListView<Backend, T, sample_ndim> result;
+    result.resize(indices.size(), tlv.sample_dim());
+    for (size_t i = 0; i < indices.size(); i++) {
+      result.data[i] = tlv.data[indices[i]];
+      result.shape.set_tensor_shape(i, tlv.shape.tensor_shape_span(indices[i]));
+    }
+    return result;
+  }
+
   // Innermost convolution requires channel handling and multiplies by "kernel matrix"
   // (matrix generated based on convolution kernel windows) from right.
   // Non-innermost convolutions are channel agnostic (assume channels = 1) and place the
@@ -240,6 +308,9 @@ struct ConvolutionGpu {
   static constexpr int kWindowCopyBufferSize =
       CutlassConv::ConvWindowConfiguration::kTotalAlignedSize;
 
+  /// Windows longer than this are applied with FFT
+  static constexpr int kFftWindowThreshold = 128;
+
   using Arguments = typename CutlassConv::Arguments;
 
   using SampleArguments = typename CutlassConv::SampleArguments;
@@ -289,6 +360,9 @@ struct ConvolutionGpu {
       }
     }
   }
+
+  std::vector<int> gemm_samples_, fft_samples_;
+  ConvolutionFftGpu<Out, In, W, ndim, axis, has_channels> conv_fft_;
 };
 
 }  // namespace kernels
@@ -0,0 +1,182 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/kernels/imgproc/convolution/fft_convolver_gpu.h"
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <map>
+#include <memory>
+#include <tuple>
+#include "dali/core/cuda_error.h"
+#include "dali/core/util.h"
+#include "dali/kernels/signal/fft/cufft_helper.h"
+
+namespace dali {
+namespace kernels {
+
+namespace {
+
+/**
+ * @brief Multiplies the spectra of the signals by the conjugate of the window spectrum
+ */
+__global__ void MultiplySpectra(float2 *spectra, const float2 *window_spectrum,
+                                int64_t total_bins, int nbins, int batch, bool interleaved,
+                                float scale) {
+  for (int64_t idx = static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+       idx < total_bins;
+       idx += static_cast<int64_t>(blockDim.x) * gridDim.x) {
+    int k = interleaved ? (idx / batch) % nbins : idx % nbins;
+    float2 s = spectra[idx];
+    float2 w = window_spectrum[k];
+    // s * conj(w)
+    spectra[idx] = make_float2((s.x * w.x + s.y * w.y) * scale,
+                               (s.y * w.x - s.x * w.y) * scale);
+  }
+}
+
+}  // namespace
+
+class FftConvolverImplGPU {
+ public:
+  size_t Plan(const FftConvolutionLayout &layout) {
+    size_t work_size = 0;
+    work_size = std::max(work_size, GetPlan(layout, CUFFT_R2C).work_size);
+    work_size = std::max(work_size, GetPlan(layout, CUFFT_C2R).work_size);
+    work_size = std::max(work_size, GetPlan(WindowLayout(layout), CUFFT_R2C).work_size);
+    return work_size;
+  }
+
+  void TrimPlans() {
+    if (plans_.size() > kMaxCachedPlans)
+      plans_.clear();
+  }
+
+  void Run(const FftConvolutionLayout &layout, float *signals, float2 *spectra,
+           const float *window, float2 *window_spectrum, float scale, void *work,
+           cudaStream_t stream) {
+    auto &window_plan = GetPlan(WindowLayout(layout), CUFFT_R2C);
+    auto &forward = GetPlan(layout, CUFFT_R2C);
+    auto &inverse = GetPlan(layout, CUFFT_C2R);
+    int nbins = layout.n / 2 + 1;
+    int64_t plane_elements = static_cast<int64_t>(layout.batch) * layout.n;
+    int64_t plane_bins = static_cast<int64_t>(layout.batch) * nbins;
+    // Contiguous rows in all planes are processed by a single batched transform;
+    // interleaved signals need one execution per plane.
+    int64_t executions = layout.interleaved ? layout.planes : 1;
+
+    CUDA_CALL(cufftSetStream(window_plan.handle, stream));
+    CUDA_CALL(cufftSetWorkArea(window_plan.handle, work));
+    // cuFFT doesn't modify the input of an out-of-place R2C transform
+    CUDA_CALL(cufftExecR2C(window_plan.handle, const_cast<float *>(window), window_spectrum));
+
+    CUDA_CALL(cufftSetStream(forward.handle, stream));
+    CUDA_CALL(cufftSetWorkArea(forward.handle, work));
+    for (int64_t p = 0; p < executions; p++) {
+      CUDA_CALL(cufftExecR2C(forward.handle,
+                             signals + p * plane_elements,
+                             spectra + p * plane_bins));
+    }
+
+    int64_t total_bins = layout.num_bins();
+    int block = 256;
+    int grid = std::max<int64_t>(1, std::min<int64_t>(div_ceil(total_bins, block), 1024));
+    // the inverse transform is not normalized
+    MultiplySpectra<<<grid, block, 0, stream>>>(spectra, window_spectrum, total_bins, nbins,
+                                                layout.batch, layout.interleaved,
+                                                scale / layout.n);
+    CUDA_CALL(cudaGetLastError());
+
+    CUDA_CALL(cufftSetStream(inverse.handle, stream));
+    CUDA_CALL(cufftSetWorkArea(inverse.handle, work));
+    for (int64_t p = 0; p < executions; p++) {
+      CUDA_CALL(cufftExecC2R(inverse.handle,
+                             spectra + p * plane_bins,
+                             signals + p * plane_elements));
+    }
+  }
+
+ private:
+  struct PlanInfo {
+    CUFFTHandle handle;
+    size_t work_size = 0;
+  };
+
+  static FftConvolutionLayout WindowLayout(const FftConvolutionLayout &layout) {
+    FftConvolutionLayout window_layout;
+    window_layout.n = layout.n;
+    window_layout.batch = 1;
+    return window_layout;
+  }
+
+  PlanInfo &GetPlan(const FftConvolutionLayout &layout, cufftType type) {
+    int64_t batch = layout.interleaved ? layout.batch : layout.batch * layout.planes;
+    DALI_ENFORCE(batch <= std::numeric_limits<int>::max(),
+                 "Too many signals for a single FFT convolution");
+    auto key = std::make_tuple(layout.n, static_cast<int>(batch), layout.interleaved, type);
+    auto &plan = plans_[key];
+    if (!plan.handle) {
+      cufftHandle handle;
+      CUDA_CALL(cufftCreate(&handle));
+      plan.handle.reset(handle);
+      CUDA_CALL(cufftSetAutoAllocation(handle, false));
+      int n[1] = { layout.n };
+      int nbins[1] = { layout.n / 2 + 1 };
+      int *in_embed = type == CUFFT_R2C ? n : nbins;
+      int *out_embed = type == CUFFT_R2C ? nbins : n;
+      plan.work_size = 0;
+      if (layout.interleaved) {
+        CUDA_CALL(cufftMakePlanMany(
+            handle, 1, n,
+            in_embed, layout.batch, 1,
+            out_embed, layout.batch, 1,
+            type, layout.batch, &plan.work_size));
+      } else {
+        CUDA_CALL(cufftMakePlanMany(
+            handle, 1, n,
+            0, 0, 0, 0, 0, 0,
+            type, batch, &plan.work_size));
+      }
+    }
+    return plan;
+  }
+
+  static constexpr size_t kMaxCachedPlans = 64;
+  std::map<std::tuple<int, int, bool, cufftType>, PlanInfo> plans_;
+};
+
+FftConvolverGPU::FftConvolverGPU() = default;
+FftConvolverGPU::FftConvolverGPU(FftConvolverGPU &&) = default;
+FftConvolverGPU::~FftConvolverGPU() = default;
+
+size_t FftConvolverGPU::Plan(const FftConvolutionLayout &layout) {
+  if (!impl_)
+    impl_ = std::make_unique<FftConvolverImplGPU>();
+  return impl_->Plan(layout);
+}
+
+void FftConvolverGPU::TrimPlans() {
+  if (impl_)
+    impl_->TrimPlans();
+}
+
+void FftConvolverGPU::Run(const FftConvolutionLayout &layout, float *signals, float2 *spectra,
+                          const float *window, float2 *window_spectrum, float scale, void *work,
+                          cudaStream_t stream) {
+  assert(impl_ != nullptr && "No instance present - missing call to Plan?");
+  impl_->Run(layout, signals, spectra, window, window_spectrum, scale, work, stream);
+}
+
+}  // namespace kernels
+}  // namespace dali
@@ -0,0 +1,106 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_KERNELS_IMGPROC_CONVOLUTION_FFT_CONVOLVER_GPU_H_
+#define DALI_KERNELS_IMGPROC_CONVOLUTION_FFT_CONVOLVER_GPU_H_
+
+#include <cuda_runtime.h>
+#include <cstdint>
+#include <memory>
+#include "dali/core/api_helper.h"
+
+namespace dali {
+namespace kernels {
+
+/**
+ * @brief Describes how a batch of equally sized 1D real signals is laid out in a buffer.
+ *
+ * If `interleaved` is false, the signals are stored as consecutive rows:
+ * `buffer[(plane * batch + signal) * n + i]`.
+ * If `interleaved` is true, the elements of the signals within a plane are interleaved:
+ * `buffer[(plane * n + i) * batch + signal]`.
+ *
+ * The spectra use the same layout, with `n / 2 + 1` complex bins instead of `n` elements.
+ */
+struct FftConvolutionLayout {
+  int n = 0;             ///< transform size
+  int batch = 0;         ///< number of signals in a plane
+  int64_t planes = 1;    ///< number of planes
+  bool interleaved = false;
+
+  int64_t num_elements() const {
+    return planes * batch * n;
+  }
+
+  int64_t num_bins() const {
+    return planes * batch * (n / 2 + 1);
+  }
+};
+
+class FftConvolverImplGPU;
+
+/**
+ * @brief Calculates circular correlation of real signals with a real window,
+ *        using cuFFT transforms
+ *
+ * The signals are transformed, multiplied by the conjugate of the window spectrum and
+ * transformed back, in place:
+ * ```
+ * signal[i] = scale * sum(signal[(i + k) % n] * window[k] for k in [0, n))
+ * ```
+ *
+ * The cuFFT plans are cached and reused for the same layouts.
+ */
+class DLL_PUBLIC FftConvolverGPU {
+ public:
+  FftConvolverGPU();
+  FftConvolverGPU(FftConvolverGPU &&);
+  ~FftConvolverGPU();
+
+  /**
+   * @brief Prepares the transforms for given layout
+   *
+   * @return the size of the work area, in bytes, necessary to run the transforms
+   */
+  size_t Plan(const FftConvolutionLayout &layout);
+
+  /**
+   * @brief Removes the cached plans, if there are too many of them
+   *
+   * Must not be called between `Plan` and `Run` with the planned `layout`.
+   */
+  void TrimPlans();
+
+  /**
+   * @param signals         the real signals, as described by `layout`; overwritten with
+   *                        the result
+   * @param spectra         temporary buffer for the spectra of the signals,
+   *                        `layout.num_bins()` elements
+   * @param window          the window, `layout.n` elements
+   * @param window_spectrum temporary buffer for the spectrum of the window,
+   *                        `layout.n / 2 + 1` elements
+   * @param work            work area, at least the size returned by `Plan`
+   */
+  void Run(const FftConvolutionLayout &layout, float *signals, float2 *spectra,
+           const float *window, float2 *window_spectrum, float scale, void *work,
+           cudaStream_t stream);
+
+ private:
+  std::unique_ptr<FftConvolverImplGPU> impl_;
+};
+
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_IMGPROC_CONVOLUTION_FFT_CONVOLVER_GPU_H_
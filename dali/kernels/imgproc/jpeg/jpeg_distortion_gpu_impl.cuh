@@ -48,32 +48,51 @@ struct YCbCrSubsampled {
   T cb, cr;
 };
 
-template <bool horz_subsample, bool vert_subsample, typename T>
+/**
+ * @brief Reads an RGB pixel, optionally applying the color twist of the sample
+ *
+ * The color twisted values are saturated to the range of T, as if the image was
+ * processed by ColorTwist first.
+ */
+template <bool color_twist, typename T, typename Sampler>
+__inline__ __device__ void load_rgb(vec<3, T> &rgb, const Sampler &sampler, ivec2 pos,
+                                    const SampleDesc &sample) {
+  sampler(rgb.v, pos, BorderClamp());
+  if (color_twist) {
+    vec3 twisted = sample.color_matrix * vec3(rgb) + sample.color_offset;
+    #pragma unroll
+    for (int c = 0; c < 3; c++)
+      rgb[c] = ConvertSat<T>(twisted[c]);
+  }
+}
+
+template <bool horz_subsample, bool vert_subsample, typename T, bool color_twist = false>
 __inline__ __device__
 YCbCrSubsampled<T, horz_subsample, vert_subsample>
-rgb_to_ycbcr_subsampled(ivec2 offset, const Surface2D<const uint8_t>& in) {
+rgb_to_ycbcr_subsampled(ivec2 offset, const Surface2D<const uint8_t>& in,
+                        const SampleDesc &sample) {
   const auto sampler = make_sampler<DALI_INTERP_NN>(in);
   YCbCrSubsampled<T, horz_subsample, vert_subsample> out;
   int y = offset.y;
   int x = offset.x;
   vec<3, T> rgb[4];
-  sampler(rgb[0].v, ivec2(x, y), BorderClamp());
+  load_rgb<color_twist>(rgb[0], sampler, ivec2(x, y), sample);
   out.luma[0] = color::jpeg::rgb_to_y<T>(rgb[0]);
   vec<3, T> avg_rgb(rgb[0]);
   if (horz_subsample && vert_subsample) {
-    sampler(rgb[1].v, ivec2(x + 1, y), BorderClamp());
-    sampler(rgb[2].v, ivec2(x, y + 1), BorderClamp());
-    sampler(rgb[3].v, ivec2(x + 1, y + 1), BorderClamp());
+    load_rgb<color_twist>(rgb[1], sampler, ivec2(x + 1, y), sample);
+    load_rgb<color_twist>(rgb[2], sampler, ivec2(x, y + 1), sample);
+    load_rgb<color_twist>(rgb[3], sampler, ivec2(x + 1, y + 1), sample);
     out.luma[1] = color::jpeg::rgb_to_y<T>(rgb[1]);
     out.luma[2] = color::jpeg::rgb_to_y<T>(rgb[2]);
     out.luma[3] = color::jpeg::rgb_to_y<T>(rgb[3]);
     avg_rgb = avg4(rgb[0], rgb[1], rgb[2], rgb[3]);
   } else if (horz_subsample) {
-    sampler(rgb[1].v, ivec2(x + 1, y), BorderClamp());
+    load_rgb<color_twist>(rgb[1], sampler, ivec2(x + 1, y), sample);
     out.luma[1] = color::jpeg::rgb_to_y<T>(rgb[1]);
     avg_rgb = avg2(rgb[0], rgb[1]);
   } else if (vert_subsample) {
-    sampler(rgb[1].v, ivec2(x, y + 1), BorderClamp());
+    load_rgb<color_twist>(rgb[1], sampler, ivec2(x, y + 1), sample);
     out.luma[1] = color::jpeg::rgb_to_y<T>(rgb[1]);
     avg_rgb = avg2(rgb[0], rgb[1]);
   }
@@ -141,7 +160,8 @@ __global__ void ChromaSubsampleDistortion(const SampleDesc *samples,
     for (int pos_x = x_start; pos_x < aligned_end_x; pos_x += blockDim.x) {
       int y = pos_y << vert_subsample;
       int x = pos_x << horz_subsample;
-      auto ycbcr = rgb_to_ycbcr_subsampled<horz_subsample, vert_subsample, T>(ivec2{x, y}, in);
+      auto ycbcr = rgb_to_ycbcr_subsampled<horz_subsample, vert_subsample, T>(ivec2{x, y}, in,
+                                                                              sample);
       ycbcr_to_rgb_subsampled<horz_subsample, vert_subsample, T>(ivec2{x, y}, out, ycbcr);
     }
   }
@@ -154,8 +174,11 @@ __device__ __inline__ float quantize(float value, float Q_coeff) {
 /**
  * @brief Produces JPEG compression artifacts by running the lossy part of
  * JPEG compression and decompression.
+ *
+ * If `color_twist` is true, the color twist of the sample is applied to the input pixels.
  */
-template <bool horz_subsample, bool vert_subsample, bool quantization = true>
+template <bool horz_subsample, bool vert_subsample, bool quantization = true,
+          bool color_twist = false>
 __global__ void JpegCompressionDistortion(const SampleDesc *samples,
                                           const kernels::BlockDesc<2> *blocks) {
   using T = uint8_t;
@@ -232,7 +255,8 @@ __global__ void JpegCompressionDistortion(const SampleDesc *samples,
         int x = pos_x << horz_subsample;
         ivec2 offset{x, y};
 
-        auto ycbcr = rgb_to_ycbcr_subsampled<horz_subsample, vert_subsample, T>(offset, in);
+        auto ycbcr = rgb_to_ycbcr_subsampled<horz_subsample, vert_subsample, T, color_twist>(
+            offset, in, sample);
         // Shifting to [-128, 128] before the DCT.
         cb[page * chroma_page][chroma_y][chroma_x] = ycbcr.cb - 128.0f;
         cr[page * chroma_page][chroma_y][chroma_x] = ycbcr.cr - 128.0f;
@@ -55,7 +55,9 @@ KernelRequirements JpegDistortionBaseGPU::Setup(KernelContext &ctx,
 
 void JpegDistortionBaseGPU::SetupSampleDescs(const OutListGPU<uint8_t, 3> &out,
                                              const InListGPU<uint8_t, 3> &in,
-                                             span<const int> quality) {
+                                             span<const int> quality,
+                                             span<const mat3> color_matrices,
+                                             span<const vec3> color_offsets) {
   const auto &in_shape = in.shape;
   int nsamples = in_shape.num_samples();
   sample_descs_.resize(nsamples);
@@ -80,11 +82,15 @@ void JpegDistortionBaseGPU::SetupSampleDescs(const OutListGPU<uint8_t, 3> &out,
     }
     sample_desc.luma_Q_table = GetLumaQuantizationTable(q);
     sample_desc.chroma_Q_table = GetChromaQuantizationTable(q);
+    sample_desc.color_matrix = color_matrices.empty() ? mat3::eye() : color_matrices[i];
+    sample_desc.color_offset = color_offsets.empty() ? vec3() : color_offsets[i];
   }
 }
 
 void JpegCompressionDistortionGPU::Run(KernelContext &ctx, const OutListGPU<uint8_t, 3> &out,
-                                       const InListGPU<uint8_t, 3> &in, span<const int> quality) {
+                                       const InListGPU<uint8_t, 3> &in, span<const int> quality,
+                                       span<const mat3> color_matrices,
+                                       span<const vec3> color_offsets) {
   const auto &in_shape = in.shape;
   int nsamples = in_shape.num_samples();
   if (quality.size() > 1 && quality.size() != nsamples) {
@@ -94,7 +100,13 @@ void JpegCompressionDistortionGPU::Run(KernelContext &ctx, const OutListGPU<uint
                   "one value per sample, or no values (a default is used). Received ",
                   quality.size(), " values but batch size is ", nsamples, "."));
   }
-  SetupSampleDescs(out, in, quality);
+  DALI_ENFORCE(color_matrices.empty() || color_matrices.size() == nsamples,
+               "The color twist matrices must be provided for all samples or for none.");
+  DALI_ENFORCE(color_offsets.empty() ||
+               (!color_matrices.empty() && color_offsets.size() == nsamples),
+               "The color twist offsets must be provided along with the matrices, one per sample.");
+  bool color_twist = !color_matrices.empty();
+  SetupSampleDescs(out, in, quality, color_matrices, color_offsets);
   SampleDesc *samples_gpu;
   BlockDesc *blocks_gpu;
   std::tie(samples_gpu, blocks_gpu) = ctx.scratchpad->ToContiguousGPU(
@@ -103,8 +115,10 @@ void JpegCompressionDistortionGPU::Run(KernelContext &ctx, const OutListGPU<uint
   dim3 block_dim = block_setup_.BlockDim();
   BOOL_SWITCH(horz_subsample_, HorzSubsample, (
     BOOL_SWITCH(vert_subsample_, VertSubsample, (
-      JpegCompressionDistortion<HorzSubsample, VertSubsample>
-          <<<grid_dim, block_dim, 0, ctx.gpu.stream>>>(samples_gpu, blocks_gpu);
+      BOOL_SWITCH(color_twist, ColorTwist, (
+        JpegCompressionDistortion<HorzSubsample, VertSubsample, true, ColorTwist>
+            <<<grid_dim, block_dim, 0, ctx.gpu.stream>>>(samples_gpu, blocks_gpu);
+      ));  // NOLINT
     ));  // NOLINT
   ));  // NOLINT
   CUDA_CALL(cudaGetLastError());
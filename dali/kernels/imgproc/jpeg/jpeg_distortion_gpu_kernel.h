@@ -89,6 +89,9 @@ struct SampleDesc {
   i64vec<2> strides;
   mat<8, 8, uint8_t> luma_Q_table;
   mat<8, 8, uint8_t> chroma_Q_table;
+  // color twist applied to the input pixels: rgb' = color_matrix * rgb + color_offset
+  mat3 color_matrix;
+  vec3 color_offset;
 };
 
 class DLL_PUBLIC JpegDistortionBaseGPU {
@@ -98,7 +101,9 @@ class DLL_PUBLIC JpegDistortionBaseGPU {
 
  protected:
   void SetupSampleDescs(const OutListGPU<uint8_t, 3> &out, const InListGPU<uint8_t, 3> &in,
-                        span<const int> quality = {});
+                        span<const int> quality = {},
+                        span<const mat3> color_matrices = {},
+                        span<const vec3> color_offsets = {});
 
   using BlkSetup = BlockSetup<2, -1>;
   BlkSetup block_setup_;
@@ -110,10 +115,26 @@ class DLL_PUBLIC JpegDistortionBaseGPU {
   bool vert_subsample_ = true;
 };
 
+/**
+ * @brief Introduces JPEG compression artifacts
+ *
+ * Each CUDA block converts, transforms, quantizes and reconstructs whole MCUs in shared
+ * memory - the distortion is a single pass over the image.
+ *
+ * Optionally, a color twist (a linear transformation of RGB, with the results saturated
+ * to uint8), can be applied to the input pixels as they're read, which gives the same
+ * results as running ColorTwist before the distortion, without the intermediate image.
+ */
 class DLL_PUBLIC JpegCompressionDistortionGPU : public JpegDistortionBaseGPU {
  public:
+  /**
+   * @param quality         one value per sample, one value for the whole batch or none
+   * @param color_matrices  color twist matrices, one per sample; no color twist if empty
+   * @param color_offsets   color twist offsets, one per sample; zeros if empty
+   */
   void Run(KernelContext &ctx, const OutListGPU<uint8_t, 3> &out, const InListGPU<uint8_t, 3> &in,
-           span<const int> quality);
+           span<const int> quality, span<const mat3> color_matrices = {},
+           span<const vec3> color_offsets = {});
 
  private:
   using Base = JpegDistortionBaseGPU;
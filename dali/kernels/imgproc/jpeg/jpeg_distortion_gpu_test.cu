@@ -16,6 +16,7 @@
 #include <gtest/gtest.h>
 #include <cstdlib>
 #include <opencv2/opencv.hpp>
+#include <random>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -260,6 +261,8 @@ class JpegDistortionTestGPU : public ::testing::TestWithParam<std::tuple<bool, b
     for (int i = 0; i < in_shapes_.size(); i++) {
       auto sh = in_shapes_[i];
       cv::Mat in_mat(sh[0], sh[1], CV_8UC3, static_cast<void *>(in_view_cpu[i].data));
+      if (!color_matrices_.empty())
+        in_mat = ColorTwist(in_mat, color_matrices_[i], color_offsets_[i]);
 
       int q = quality_.size() == 1 ? quality_[0] : quality_[i];
       std::vector<uint8_t> encoded;
@@ -281,6 +284,37 @@ class JpegDistortionTestGPU : public ::testing::TestWithParam<std::tuple<bool, b
     TestKernel<JpegCompressionDistortionGPU>(make_cspan(quality_));
   }
 
+  static cv::Mat ColorTwist(const cv::Mat &in, const mat3 &matrix, const vec3 &offset) {
+    cv::Mat out = in.clone();
+    for (int64_t i = 0; i < static_cast<int64_t>(in.total()); i++) {
+      vec3 rgb(in.data[3 * i], in.data[3 * i + 1], in.data[3 * i + 2]);
+      vec3 twisted = matrix * rgb + offset;
+      for (int c = 0; c < 3; c++)
+        out.data[3 * i + c] = ConvertSat<uint8_t>(twisted[c]);
+    }
+    return out;
+  }
+
+  void TestJpegCompressionDistortionColorTwist(int quality) {
+    int nsamples = in_shapes_.num_samples();
+    std::mt19937_64 rng(1234);
+    std::uniform_real_distribution<float> dist(-0.3f, 0.3f);
+    color_matrices_.resize(nsamples);
+    color_offsets_.resize(nsamples);
+    for (int i = 0; i < nsamples; i++) {
+      for (int r = 0; r < 3; r++)
+        for (int c = 0; c < 3; c++)
+          color_matrices_[i](r, c) = (r == c) + dist(rng);
+      color_offsets_[i] = vec3(50 * dist(rng), 50 * dist(rng), 50 * dist(rng));
+    }
+    quality_ = {quality};
+    max_abs_error_ = vert_subsample && horz_subsample ? 80 : 128;
+    max_avg_error_ = vert_subsample && horz_subsample ? 3 : 10;
+    CalcOut_JpegCompressionDistortion();
+    TestKernel<JpegCompressionDistortionGPU>(make_cspan(quality_), make_cspan(color_matrices_),
+                                             make_cspan(color_offsets_));
+  }
+
   void TestChromaSubsampleDistortion() {
     CalcOut_ChromaSubsampleDistortion();
     TestKernel<ChromaSubsampleDistortionGPU>();
@@ -293,6 +327,8 @@ class JpegDistortionTestGPU : public ::testing::TestWithParam<std::tuple<bool, b
   TestTensorList<uint8_t> out_ref_;
 
   std::vector<int> quality_ = {95};
+  std::vector<mat3> color_matrices_;
+  std::vector<vec3> color_offsets_;
   kernels::KernelManager kmgr_;
   int max_abs_error_ = 5;
   int max_avg_error_ = 3;
@@ -318,6 +354,10 @@ TEST_P(JpegDistortionTestGPU, JpegCompressionDistortion_HighestQuality) {
   this->TestJpegCompressionDistortion(100);
 }
 
+TEST_P(JpegDistortionTestGPU, JpegCompressionDistortion_ColorTwist) {
+  this->TestJpegCompressionDistortionColorTwist(50);
+}
+
 INSTANTIATE_TEST_SUITE_P(JpegDistortionTestGPU, JpegDistortionTestGPU, ::testing::Combine(
   ::testing::Values(false, true),  // horz_subsample
   ::testing::Values(false, true)   // vert_subsample
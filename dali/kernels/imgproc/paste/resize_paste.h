@@ -0,0 +1,142 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_KERNELS_IMGPROC_PASTE_RESIZE_PASTE_H_
+#define DALI_KERNELS_IMGPROC_PASTE_RESIZE_PASTE_H_
+
+#include <cmath>
+#include <vector>
+#include "dali/core/convert.h"
+#include "dali/core/force_inline.h"
+#include "dali/core/geom/vec.h"
+#include "dali/core/host_dev.h"
+#include "dali/core/math_util.h"
+
+namespace dali {
+namespace kernels {
+namespace paste {
+
+/**
+ * @brief A region of an input image, resized and blended into the output
+ *
+ * The coordinates are in (y, x) order.
+ */
+struct ResizePastePatch {
+  ivec2 in_anchor, in_shape;    ///< source region
+  ivec2 out_anchor, out_shape;  ///< destination region
+  int in_idx;                   ///< index of the input sample
+  float alpha = 1;              ///< weight of the patch in the blending
+};
+
+/**
+ * @brief The patches pasted into one output image, in the order of pasting
+ */
+struct ResizePasteSampleInput {
+  std::vector<ResizePastePatch> patches;
+  bool linear = true;  ///< bilinear interpolation if true, nearest neighbor otherwise
+};
+
+/**
+ * @brief Describes how a patch is sampled; the coordinates are in (y, x) order
+ */
+template <typename In>
+struct ResizePasteDesc {
+  const In *in;
+  int in_stride;          ///< row stride of the input, in elements
+  ivec2 out_lo, out_hi;   ///< destination region
+  ivec2 in_lo, in_hi;     ///< source region - the samples are clamped to it
+  vec2 scale;             ///< source pixels per destination pixel
+  float alpha;
+};
+
+template <typename In>
+ResizePasteDesc<In> MakeResizePasteDesc(const ResizePastePatch &patch, int in_width,
+                                        int channels) {
+  ResizePasteDesc<In> desc;
+  desc.in = nullptr;
+  desc.in_stride = in_width * channels;
+  desc.out_lo = patch.out_anchor;
+  desc.out_hi = patch.out_anchor + patch.out_shape;
+  desc.in_lo = patch.in_anchor;
+  desc.in_hi = patch.in_anchor + patch.in_shape;
+  for (int d = 0; d < 2; d++)
+    desc.scale[d] = patch.out_shape[d] > 0 ? static_cast<float>(patch.in_shape[d]) /
+                                             patch.out_shape[d]
+                                           : 0;
+  desc.alpha = patch.alpha;
+  return desc;
+}
+
+/**
+ * @brief Samples channel `c` of the patch at destination pixel (y, x)
+ *
+ * The pixel centers are mapped between the destination and the source region; the source
+ * is sampled with a nearest neighbor or a bilinear filter, with the coordinates clamped
+ * to the source region - the pixels outside of it never contribute.
+ */
+template <typename In>
+DALI_HOST_DEV DALI_FORCEINLINE float SamplePatch(const ResizePasteDesc<In> &p, int y, int x,
+                                                 int c, int channels, bool linear) {
+  float sy = p.in_lo[0] + (y - p.out_lo[0] + 0.5f) * p.scale[0];
+  float sx = p.in_lo[1] + (x - p.out_lo[1] + 0.5f) * p.scale[1];
+  const In *in = p.in + c;
+  if (!linear) {
+    int iy = clamp(static_cast<int>(floorf(sy)), p.in_lo[0], p.in_hi[0] - 1);
+    int ix = clamp(static_cast<int>(floorf(sx)), p.in_lo[1], p.in_hi[1] - 1);
+    return in[iy * p.in_stride + ix * channels];
+  }
+  sy -= 0.5f;
+  sx -= 0.5f;
+  int y0 = floorf(sy), x0 = floorf(sx);
+  float qy = sy - y0, qx = sx - x0;
+  int y1 = clamp(y0 + 1, p.in_lo[0], p.in_hi[0] - 1);
+  int x1 = clamp(x0 + 1, p.in_lo[1], p.in_hi[1] - 1);
+  y0 = clamp(y0, p.in_lo[0], p.in_hi[0] - 1);
+  x0 = clamp(x0, p.in_lo[1], p.in_hi[1] - 1);
+  const In *row0 = in + y0 * p.in_stride;
+  const In *row1 = in + y1 * p.in_stride;
+  float top = row0[x0 * channels] + qx * (row0[x1 * channels] - row0[x0 * channels]);
+  float bottom = row1[x0 * channels] + qx * (row1[x1 * channels] - row1[x0 * channels]);
+  return top + qy * (bottom - top);
+}
+
+/**
+ * @brief Calculates the output pixel (y, x) by blending the patches that cover it
+ *
+ * The patches are blended, in order, over a black canvas:
+ * ```
+ * value = alpha * patch_value + (1 - alpha) * value
+ * ```
+ */
+template <typename Out, typename In>
+DALI_HOST_DEV void ResizePastePixel(Out *out, int y, int x, int channels,
+                                    const ResizePasteDesc<In> *patches, int num_patches,
+                                    bool linear) {
+  for (int c = 0; c < channels; c++) {
+    float value = 0;
+    for (int i = 0; i < num_patches; i++) {
+      const auto &p = patches[i];
+      if (y < p.out_lo[0] || y >= p.out_hi[0] || x < p.out_lo[1] || x >= p.out_hi[1])
+        continue;
+      value += p.alpha * (SamplePatch(p, y, x, c, channels, linear) - value);
+    }
+    out[c] = ConvertSat<Out>(value);
+  }
+}
+
+}  // namespace paste
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_IMGPROC_PASTE_RESIZE_PASTE_H_
@@ -0,0 +1,69 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_KERNELS_IMGPROC_PASTE_RESIZE_PASTE_CPU_H_
+#define DALI_KERNELS_IMGPROC_PASTE_RESIZE_PASTE_CPU_H_
+
+#include "dali/core/small_vector.h"
+#include "dali/core/tensor_view.h"
+#include "dali/kernels/kernel.h"
+#include "dali/kernels/imgproc/paste/resize_paste.h"
+
+namespace dali {
+namespace kernels {
+
+/**
+ * @brief Resizes regions of the input images and blends them into a single output image
+ *
+ * @see paste::ResizePastePixel
+ */
+template <typename OutputType, typename InputType>
+class ResizePasteCPU {
+ public:
+  /**
+   * @param out    output image (HWC)
+   * @param in     the batch of input images (HWC), indexed by `ResizePastePatch::in_idx`
+   * @param sample the patches pasted into `out`
+   */
+  void Run(KernelContext &context, const OutTensorCPU<OutputType, 3> &out,
+           const InListCPU<InputType, 3> &in, const paste::ResizePasteSampleInput &sample) {
+    int channels = out.shape[2];
+    descs_.clear();
+    for (auto &patch : sample.patches) {
+      auto in_shape = in.tensor_shape_span(patch.in_idx);
+      DALI_ENFORCE(in_shape[2] == channels,
+                   "The input images must have the same number of channels as the output.");
+      auto desc = paste::MakeResizePasteDesc<InputType>(patch, in_shape[1], channels);
+      desc.in = in.tensor_data(patch.in_idx);
+      descs_.push_back(desc);
+    }
+
+    int H = out.shape[0], W = out.shape[1];
+    OutputType *out_row = out.data;
+    for (int y = 0; y < H; y++, out_row += W * channels) {
+      for (int x = 0; x < W; x++) {
+        paste::ResizePastePixel(out_row + x * channels, y, x, channels,
+                                descs_.data(), descs_.size(), sample.linear);
+      }
+    }
+  }
+
+ private:
+  SmallVector<paste::ResizePasteDesc<InputType>, 8> descs_;
+};
+
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_IMGPROC_PASTE_RESIZE_PASTE_CPU_H_
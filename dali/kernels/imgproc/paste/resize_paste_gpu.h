@@ -0,0 +1,144 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_KERNELS_IMGPROC_PASTE_RESIZE_PASTE_GPU_H_
+#define DALI_KERNELS_IMGPROC_PASTE_RESIZE_PASTE_GPU_H_
+
+#include <tuple>
+#include <vector>
+#include "dali/core/span.h"
+#include "dali/core/tensor_view.h"
+#include "dali/kernels/kernel.h"
+#include "dali/kernels/common/block_setup.h"
+#include "dali/kernels/imgproc/paste/resize_paste.h"
+
+namespace dali {
+namespace kernels {
+namespace paste {
+
+template <typename OutputType, typename InputType>
+struct ResizePasteSampleDesc {
+  OutputType *out;
+  int out_stride;
+  int channels;
+  int patch_start, num_patches;
+  bool linear;
+};
+
+template <typename OutputType, typename InputType>
+__global__ void ResizePasteKernel(const ResizePasteSampleDesc<OutputType, InputType> *samples,
+                                  const ResizePasteDesc<InputType> *patches,
+                                  const BlockDesc<2> *blocks) {
+  const auto &block = blocks[blockIdx.x];
+  const auto &sample = samples[block.sample_idx];
+  const ResizePasteDesc<InputType> *sample_patches = patches + sample.patch_start;
+  for (int y = block.start.y + threadIdx.y; y < block.end.y; y += blockDim.y) {
+    OutputType *out_row = sample.out + y * sample.out_stride;
+    for (int x = block.start.x + threadIdx.x; x < block.end.x; x += blockDim.x) {
+      ResizePastePixel(out_row + x * sample.channels, y, x, sample.channels,
+                       sample_patches, sample.num_patches, sample.linear);
+    }
+  }
+}
+
+}  // namespace paste
+
+/**
+ * @brief Resizes regions of the input images and blends them into the output images
+ *        in a single pass, without intermediate buffers
+ *
+ * Each output pixel is calculated by sampling (with NN or bilinear interpolation)
+ * and blending all the patches that cover it - see paste::ResizePastePixel.
+ * No antialiasing is applied when downscaling.
+ */
+template <typename OutputType, typename InputType>
+class ResizePasteGPU {
+ public:
+  using SampleDesc = paste::ResizePasteSampleDesc<OutputType, InputType>;
+  using PatchDesc = paste::ResizePasteDesc<InputType>;
+  using BlockDesc = kernels::BlockDesc<2>;
+
+  KernelRequirements Setup(KernelContext &context,
+                           span<const paste::ResizePasteSampleInput> samples,
+                           const TensorListShape<3> &out_shape,
+                           const TensorListShape<3> &in_shape) {
+    int N = samples.size();
+    assert(out_shape.num_samples() == N);
+    sample_descs_.resize(N);
+    patch_descs_.clear();
+    patch_in_idx_.clear();
+    for (int i = 0; i < N; i++) {
+      auto &desc = sample_descs_[i];
+      int channels = out_shape[i][2];
+      desc.out = nullptr;
+      desc.out_stride = out_shape[i][1] * channels;
+      desc.channels = channels;
+      desc.patch_start = patch_descs_.size();
+      desc.num_patches = samples[i].patches.size();
+      desc.linear = samples[i].linear;
+      for (auto &patch : samples[i].patches) {
+        auto sh = in_shape.tensor_shape_span(patch.in_idx);
+        DALI_ENFORCE(sh[2] == channels,
+                     "The input images must have the same number of channels as the output.");
+        patch_descs_.push_back(paste::MakeResizePasteDesc<InputType>(patch, sh[1], channels));
+        patch_in_idx_.push_back(patch.in_idx);
+      }
+    }
+
+    // each thread produces all channels of a pixel
+    block_setup_.SetupBlocks(out_shape.first<2>(), true);
+
+    KernelRequirements req;
+    ScratchpadEstimator se;
+    se.add<mm::memory_kind::device, SampleDesc>(sample_descs_.size());
+    se.add<mm::memory_kind::device, PatchDesc>(patch_descs_.size());
+    se.add<mm::memory_kind::device, BlockDesc>(block_setup_.Blocks().size());
+    req.output_shapes = { out_shape };
+    req.scratch_sizes = se.sizes;
+    return req;
+  }
+
+  void Run(KernelContext &context,
+           const OutListGPU<OutputType, 3> &out,
+           const InListGPU<InputType, 3> &in) {
+    assert(out.num_samples() == static_cast<int>(sample_descs_.size()));
+    if (block_setup_.Blocks().empty())
+      return;
+    for (int i = 0; i < out.num_samples(); i++)
+      sample_descs_[i].out = out.tensor_data(i);
+    for (size_t i = 0; i < patch_descs_.size(); i++)
+      patch_descs_[i].in = in.tensor_data(patch_in_idx_[i]);
+
+    SampleDesc *samples_gpu;
+    PatchDesc *patches_gpu;
+    BlockDesc *blocks_gpu;
+    std::tie(samples_gpu, patches_gpu, blocks_gpu) = context.scratchpad->ToContiguousGPU(
+        context.gpu.stream, sample_descs_, patch_descs_, block_setup_.Blocks());
+
+    paste::ResizePasteKernel<<<block_setup_.GridDim(), block_setup_.BlockDim(), 0,
+                               context.gpu.stream>>>(samples_gpu, patches_gpu, blocks_gpu);
+    CUDA_CALL(cudaGetLastError());
+  }
+
+ private:
+  BlockSetup<2, -1> block_setup_;
+  std::vector<SampleDesc> sample_descs_;
+  std::vector<PatchDesc> patch_descs_;
+  std::vector<int> patch_in_idx_;
+};
+
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_IMGPROC_PASTE_RESIZE_PASTE_GPU_H_
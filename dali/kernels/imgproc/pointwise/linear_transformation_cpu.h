@@ -21,6 +21,7 @@
 #include "dali/core/convert.h"
 #include "dali/core/geom/box.h"
 #include "dali/kernels/common/block_setup.h"
+#include "dali/kernels/common/simd.h"
 #include "dali/kernels/imgproc/surface.h"
 #include "dali/kernels/imgproc/roi.h"
 
@@ -59,10 +60,16 @@ class LinearTransformationCpu {
     auto adjusted_roi = AdjustRoi(roi, in.shape);
     auto ptr = out.data;
     auto in_width = in.shape[1];
+    int roi_width = adjusted_roi.hi.x - adjusted_roi.lo.x;
 
     for (int y = adjusted_roi.lo.y; y < adjusted_roi.hi.y; y++) {
       auto *row_ptr = &in.data[y * in_width * channels_in];
-      for (int x = adjusted_roi.lo.x; x < adjusted_roi.hi.x; x++) {
+      int x = adjusted_roi.lo.x;
+      int vectorized = TransformRowSimd(ptr, row_ptr + x * channels_in, roi_width,
+                                        tmatrix, tvector);
+      ptr += vectorized * channels_out;
+      x += vectorized;
+      for (; x < adjusted_roi.hi.x; x++) {
         vec<channels_in, float> v_in;
         for (int k = 0; k < channels_in; k++) {
           v_in[k] = row_ptr[channels_in * x + k];
@@ -74,6 +81,54 @@ class LinearTransformationCpu {
       }
     }
   }
+
+ private:
+#ifdef DALI_SIMD_HAS_F32X4
+  static constexpr bool kUseSimd = channels_in == 3 && channels_out == 3 &&
+                                   simd::is_simd_storage<InputType>::value &&
+                                   simd::is_simd_storage<OutputType>::value;
+#else
+  static constexpr bool kUseSimd = false;
+#endif
+
+  /**
+   * @brief Transforms the pixels of a row of RGB-like data, 16 pixels at a time
+   *
+   * The channels are deinterleaved, transformed as planes and interleaved again.
+   * The multiply-adds are done in the same order as in the scalar code.
+   *
+   * @return the number of pixels processed; the remaining ones are left for the scalar code
+   */
+  template <bool use_simd = kUseSimd>
+  static std::enable_if_t<use_simd, int>
+  TransformRowSimd(OutputType *out, const InputType *in, int width,
+                   const Mat &tmatrix, const Vec &tvector) {
+#ifdef DALI_SIMD_HAS_F32X4
+    using planar = simd::multivec<4>;
+    constexpr int kPixels = planar::kNumLanes;
+    int x = 0;
+    for (; x + kPixels <= width; x += kPixels) {
+      planar in_planes[3], out_planes[3];
+      simd::deinterleave3(in_planes, simd::multivec<12>::load(in + 3 * x));
+      for (int i = 0; i < 3; i++) {
+        out_planes[i] = planar::zero();
+        for (int j = 0; j < 3; j++)
+          simd::madd(out_planes[i], tmatrix(i, j), in_planes[j]);
+        simd::add(out_planes[i], planar::set1(tvector[i]));
+      }
+      simd::store(out + 3 * x, simd::interleave3(out_planes));
+    }
+    return x;
+#else
+    return 0;
+#endif
+  }
+
+  template <bool use_simd = kUseSimd>
+  static std::enable_if_t<!use_simd, int>
+  TransformRowSimd(OutputType *, const InputType *, int, const Mat &, const Vec &) {
+    return 0;
+  }
 };
 
 }  // namespace kernels
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <random>
 #include <vector>
 #include <tuple>
 #include "dali/core/geom/mat.h"
@@ -164,6 +165,41 @@ TYPED_TEST(LinearTransformationCpuTest, run_test_with_roi) {
   Check(out, view_as_tensor<float>(mat), EqualUlp());
 }
 
+TYPED_TEST(LinearTransformationCpuTest, run_test_rgb) {
+  // 3-channel data is processed in vectors of 16 pixels, followed by scalar code for the tail
+  using In = typename TypeParam::In;
+  using Out = typename TypeParam::Out;
+  LinearTransformationCpu<Out, In, 3, 3, kNDims> kernel;
+  KernelContext ctx;
+  TensorShape<kNDims> in_shape = {5, 37, 3};
+  std::vector<In> input(volume(in_shape));
+  std::mt19937_64 rng;
+  UniformRandomFill(input, rng, 0., 10.);
+  InTensorCPU<In, kNDims> in(input.data(), in_shape);
+  mat3 tmatrix = {{{1, 0, 1}, {0, 2, 0}, {1, 1, -1}}};
+  vec3 tvector = {1, -2, 3};
+  Roi<2> roi = {{2, 1}, {37, 4}};
+
+  auto reqs = kernel.Setup(ctx, in, tmatrix, tvector, &roi);
+  auto out_shape = reqs.output_shapes[0][0].template to_static<kNDims>();
+  std::vector<Out> output(volume(out_shape)), ref_output;
+  OutTensorCPU<Out, kNDims> out(output.data(), out_shape);
+  kernel.Run(ctx, out, in, tmatrix, tvector, &roi);
+
+  for (int y = roi.lo.y; y < roi.hi.y; y++) {
+    for (int x = roi.lo.x; x < roi.hi.x; x++) {
+      const In *pixel = &input[(y * in_shape[1] + x) * 3];
+      vec3 v_in;
+      for (int c = 0; c < 3; c++)
+        v_in[c] = pixel[c];
+      vec3 v_out = tmatrix * v_in + tvector;
+      for (int c = 0; c < 3; c++)
+        ref_output.push_back(ConvertSat<Out>(v_out[c]));
+    }
+  }
+  Check(out, make_tensor_cpu(ref_output.data(), out_shape), EqualUlp());
+}
+
 }  // namespace test
 }  // namespace kernels
 }  // namespace dali
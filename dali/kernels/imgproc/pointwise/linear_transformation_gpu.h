@@ -15,10 +15,12 @@
 #ifndef DALI_KERNELS_IMGPROC_POINTWISE_LINEAR_TRANSFORMATION_GPU_H_
 #define DALI_KERNELS_IMGPROC_POINTWISE_LINEAR_TRANSFORMATION_GPU_H_
 
+#include <type_traits>
 #include <vector>
 #include "dali/core/format.h"
 #include "dali/core/convert.h"
 #include "dali/core/geom/box.h"
+#include "dali/core/util.h"
 #include "dali/kernels/common/block_setup.h"
 #include "dali/kernels/imgproc/surface.h"
 #include "dali/kernels/imgproc/roi.h"
@@ -39,8 +41,81 @@ struct SampleDescriptor {
   vec<channels_out, float> B;
 
   Roi<spatial_ndims> roi;
+
+  /// If true, the pixels can be processed in groups of 4, with 32-bit loads and stores
+  bool vectorize;
 };
 
+/**
+ * @brief Tells whether groups of 4 pixels can be loaded and stored as 3 `uchar4` values
+ */
+template <typename OutputType, typename InputType, int channels_out, int channels_in>
+struct can_vectorize : std::integral_constant<bool,
+    std::is_same<OutputType, uint8_t>::value && std::is_same<InputType, uint8_t>::value &&
+    channels_out == 3 && channels_in == 3> {};
+
+/**
+ * @brief Calculates `A * in + B`, with the transform stored as a row-major `A` matrix
+ *        followed by the `B` vector
+ */
+template <int channels_out, int channels_in>
+__device__ DALI_FORCEINLINE vec<channels_out> apply_transform(const float *transform,
+                                                              const vec<channels_in> &in) {
+  vec<channels_out> out;
+  const float *B = transform + channels_out * channels_in;
+  #pragma unroll
+  for (int i = 0; i < channels_out; i++) {
+    float acc = B[i];
+    #pragma unroll
+    for (int j = 0; j < channels_in; j++)
+      acc += transform[i * channels_in + j] * in[j];
+    out[i] = acc;
+  }
+  return out;
+}
+
+template <typename OutputType, typename InputType, int channels_out, int channels_in>
+__device__ DALI_FORCEINLINE void TransformPixel(OutputType *out, const InputType *in,
+                                                const float *transform) {
+  vec<channels_in> v_in;
+  #pragma unroll
+  for (int i = 0; i < channels_in; i++)
+    v_in[i] = in[i];
+  vec<channels_out> v_out = apply_transform<channels_out, channels_in>(transform, v_in);
+  #pragma unroll
+  for (int i = 0; i < channels_out; i++)
+    out[i] = ConvertSat<OutputType>(v_out[i]);
+}
+
+/**
+ * @brief Transforms the pixels [x0, x1) of a row, 4 pixels (12 bytes) at a time.
+ *
+ * The row pointers and x0 must be aligned so that the groups start at 4-byte boundary.
+ */
+template <typename OutputType, typename InputType, int channels_out, int channels_in>
+__device__ std::enable_if_t<can_vectorize<OutputType, InputType, channels_out, channels_in>::value>
+TransformRowVectorized(OutputType *out_row, const InputType *in_row, int x0, int x1,
+                       const float *transform) {
+  for (int x = x0 + 4 * threadIdx.x; x + 4 <= x1; x += 4 * blockDim.x) {
+    const uchar4 *src = reinterpret_cast<const uchar4 *>(in_row + 3 * x);
+    uchar4 *dst = reinterpret_cast<uchar4 *>(out_row + 3 * x);
+    uchar4 in_words[3] = { src[0], src[1], src[2] };
+    const uint8_t *in_bytes = reinterpret_cast<const uint8_t *>(in_words);
+    uchar4 out_words[3];
+    uint8_t *out_bytes = reinterpret_cast<uint8_t *>(out_words);
+    #pragma unroll
+    for (int p = 0; p < 4; p++)
+      TransformPixel<OutputType, InputType, 3, 3>(out_bytes + 3 * p, in_bytes + 3 * p, transform);
+    dst[0] = out_words[0];
+    dst[1] = out_words[1];
+    dst[2] = out_words[2];
+  }
+}
+
+template <typename OutputType, typename InputType, int channels_out, int channels_in>
+__device__ std::enable_if_t<!can_vectorize<OutputType, InputType, channels_out, channels_in>::value>
+TransformRowVectorized(OutputType *, const InputType *, int, int, const float *) {}
+
 
 template <typename OutputType, typename InputType,
         int channels_out, int channels_in, int spatial_ndims>
@@ -51,6 +126,18 @@ void __global__ LinearTransformationKernel(
   const auto &block = blocks[blockIdx.x];
   const auto &sample = samples[block.sample_idx];
 
+  // The transform is shared by all threads in the block
+  constexpr int kTransformSize = channels_out * (channels_in + 1);
+  __shared__ float transform[kTransformSize];
+  int tid = threadIdx.x + blockDim.x * threadIdx.y;
+  for (int k = tid; k < kTransformSize; k += blockDim.x * blockDim.y) {
+    int i = k / channels_in, j = k % channels_in;
+    transform[k] = k < channels_out * channels_in
+                 ? sample.A(i, j)
+                 : sample.B[k - channels_out * channels_in];
+  }
+  __syncthreads();
+
   const Surface2D<const InputType> in = {
           sample.in, sample.in_size.x, sample.in_size.y, channels_in,
           sample.in_strides.x, sample.in_strides.y, 1
@@ -63,16 +150,29 @@ void __global__ LinearTransformationKernel(
 
   auto in_roi = crop(in, sample.roi);
 
+  int x_start = block.start.x, x_end = block.end.x;
+  if (can_vectorize<OutputType, InputType, channels_out, channels_in>::value &&
+      sample.vectorize) {
+    // the pixels outside of the 4-aligned range are processed one by one
+    int x0 = min(align_up(x_start, 4), x_end);
+    int x1 = max(x0, x_end & ~3);
+    for (int y = threadIdx.y + block.start.y; y < block.end.y; y += blockDim.y) {
+      TransformRowVectorized<OutputType, InputType, channels_out, channels_in>(
+          &out(0, y), &in_roi(0, y), x0, x1, transform);
+      for (int x = threadIdx.x + x_start; x < x0; x += blockDim.x)
+        TransformPixel<OutputType, InputType, channels_out, channels_in>(
+            &out(x, y), &in_roi(x, y), transform);
+      for (int x = threadIdx.x + x1; x < x_end; x += blockDim.x)
+        TransformPixel<OutputType, InputType, channels_out, channels_in>(
+            &out(x, y), &in_roi(x, y), transform);
+    }
+    return;
+  }
+
   for (int y = threadIdx.y + block.start.y; y < block.end.y; y += blockDim.y) {
-    for (int x = threadIdx.x + block.start.x; x < block.end.x; x += blockDim.x) {
-      vec<channels_in> v_in;
-      for (int i = 0; i < channels_in; i++) {
-        v_in[i] = in_roi(x, y, i);
-      }
-      vec<channels_out> v_out = sample.A * v_in + sample.B;
-      for (int i = 0; i < channels_out; i++) {
-        out(x, y, i) = ConvertSat<OutputType>(v_out[i]);
-      }
+    for (int x = threadIdx.x + x_start; x < x_end; x += blockDim.x) {
+      TransformPixel<OutputType, InputType, channels_out, channels_in>(
+          &out(x, y), &in_roi(x, y), transform);
     }
   }
 }
@@ -186,10 +286,28 @@ class LinearTransformationGpu {
       sample.A = tmatrices[i];
       sample.B = tvectors[i];
       sample.roi = adjusted_rois[i];
+      sample.vectorize = CanVectorize(sample);
     }
   }
 
 
+  /**
+   * @brief Checks whether the groups of 4 pixels in the rows of the sample are 4-byte
+   *        aligned, both in the input and in the output
+   */
+  static bool CanVectorize(const SampleDescriptor &sample) {
+    if (!lin_trans::can_vectorize<OutputType, InputType, channels_out, channels_in>::value)
+      return false;
+    const InputType *in_start = sample.in + sample.roi.lo.y * sample.in_strides.y +
+                                sample.roi.lo.x * sample.in_strides.x;
+    auto aligned = [](const void *ptr) {
+      return reinterpret_cast<uintptr_t>(ptr) % 4 == 0;
+    };
+    return aligned(in_start) && aligned(sample.out) &&
+           sample.in_strides.y * sizeof(InputType) % 4 == 0 &&
+           sample.out_strides.y * sizeof(OutputType) % 4 == 0;
+  }
+
   void gen_default_values(size_t nsamples) {
     default_vecs_ = std::vector<Vec>(nsamples, Vec(0));
   }
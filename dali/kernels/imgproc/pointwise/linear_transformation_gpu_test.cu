@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <random>
 #include <vector>
 #include <tuple>
 #include "dali/core/geom/mat.h"
@@ -24,6 +25,7 @@
 #include "dali/kernels/test/kernel_test_utils.h"
 #include "dali/kernels/imgproc/pointwise/linear_transformation_gpu.h"
 #include "dali/test/cv_mat_utils.h"
+#include "dali/test/test_tensors.h"
 #include "dali/kernels/imgproc/roi.h"
 
 namespace dali {
@@ -202,6 +204,65 @@ TYPED_TEST(LinearTransformationGpuTest, run_test_with_roi) {
   Check(view_as_tensor<typename TypeParam::Out>(mat), res.first, EqualUlp());
 }
 
+TEST(LinearTransformationGpuTest, run_test_rgb8) {
+  // uint8 RGB is processed 4 pixels at a time, when the data is aligned;
+  // the odd widths and ROI offsets exercise the unaligned and the scalar fallback paths
+  using Kernel = LinearTransformationGpu<uint8_t, uint8_t, 3, 3, 2>;
+  std::vector<TensorShape<kNDims>> shapes = {{7, 64, 3}, {5, 37, 3}, {3, 9, 3}, {6, 67, 3}};
+  std::vector<Roi<2>> rois = {{{0, 0}, {64, 7}}, {{1, 0}, {37, 5}},
+                              {{3, 1}, {8, 3}}, {{5, 1}, {66, 6}}};
+  TensorListShape<kNDims> in_shape(shapes);
+  int nsamples = in_shape.num_samples();
+
+  TestTensorList<uint8_t, kNDims> in_list;
+  in_list.reshape(in_shape);
+  auto in_cpu = in_list.cpu();
+  std::mt19937_64 rng;
+  UniformRandomFill(in_cpu, rng, 0, 255);
+
+  std::vector<mat3> mats;
+  std::vector<vec3> vecs;
+  for (int i = 0; i < nsamples; i++) {
+    mats.push_back(mat3{{{0.5f, 0.2f, 0.1f}, {0.1f, 0.9f, -0.1f}, {-0.3f, 0.4f, 1.2f}}} +
+                   0.1f * i);
+    vecs.push_back(vec3{10.f * i, -5.f, 2.f});
+  }
+
+  Kernel kernel;
+  KernelContext ctx;
+  auto in_gpu = in_list.gpu();
+  auto reqs = kernel.Setup(ctx, in_gpu, make_cspan(mats), make_cspan(vecs), make_cspan(rois));
+  ScratchpadAllocator sa;
+  sa.Reserve(reqs.scratch_sizes);
+  auto scratchpad = sa.GetScratchpad();
+  ctx.scratchpad = &scratchpad;
+
+  TestTensorList<uint8_t, kNDims> out_list;
+  out_list.reshape(reqs.output_shapes[0].to_static<kNDims>());
+  kernel.Run(ctx, out_list.gpu(), in_gpu, make_cspan(mats), make_cspan(vecs), make_cspan(rois));
+  auto out_cpu = out_list.cpu();
+
+  TestTensorList<uint8_t, kNDims> ref_list;
+  ref_list.reshape(reqs.output_shapes[0].to_static<kNDims>());
+  auto ref_cpu = ref_list.cpu();
+  for (int i = 0; i < nsamples; i++) {
+    auto in = in_cpu[i];
+    auto ref = ref_cpu[i];
+    for (int y = rois[i].lo.y; y < rois[i].hi.y; y++) {
+      for (int x = rois[i].lo.x; x < rois[i].hi.x; x++) {
+        vec3 v_in;
+        for (int c = 0; c < 3; c++)
+          v_in[c] = *in(y, x, c);
+        vec3 v_out = mats[i] * v_in + vecs[i];
+        for (int c = 0; c < 3; c++)
+          *ref(y - rois[i].lo.y, x - rois[i].lo.x, c) = ConvertSat<uint8_t>(v_out[c]);
+      }
+    }
+  }
+  // the order of the multiply-adds may differ
+  Check(out_cpu, ref_cpu, EqualEps(1));
+}
+
 }  // namespace test
 }  // namespace kernels
 }  // namespace dali
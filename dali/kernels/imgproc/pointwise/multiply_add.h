@@ -21,6 +21,7 @@
 #include "dali/core/convert.h"
 #include "dali/core/geom/box.h"
 #include "dali/core/error_handling.h"
+#include "dali/kernels/common/simd.h"
 #include "dali/kernels/kernel.h"
 #include "dali/kernels/imgproc/roi.h"
 
@@ -68,12 +69,53 @@ class MultiplyAddCpu {
 
     ptrdiff_t row_stride = image_width * num_channels;
     auto *row = in.data + adjusted_roi.lo.y * row_stride;
+    int row_begin = adjusted_roi.lo.x * num_channels, row_end = adjusted_roi.hi.x * num_channels;
     for (int y = adjusted_roi.lo.y; y < adjusted_roi.hi.y; y++) {
-      for (int xc = adjusted_roi.lo.x * num_channels; xc < adjusted_roi.hi.x * num_channels; xc++)
+      int vectorized = RunRowSimd(ptr, row + row_begin, row_end - row_begin, addend, multiplier);
+      ptr += vectorized;
+      for (int xc = row_begin + vectorized; xc < row_end; xc++)
         *ptr++ = ConvertSat<OutputType>(row[xc] * multiplier + addend);
       row += row_stride;
     }
   }
+
+ private:
+#ifdef DALI_SIMD_HAS_F32X4
+  static constexpr bool kUseSimd = simd::is_simd_storage<InputType>::value &&
+                                   simd::is_simd_storage<OutputType>::value;
+#else
+  static constexpr bool kUseSimd = false;
+#endif
+
+  /**
+   * @brief Processes `length` consecutive values, 16 at a time
+   *
+   * @return the number of values processed; the remaining ones are left for the scalar code
+   */
+  template <bool use_simd = kUseSimd>
+  static std::enable_if_t<use_simd, int>
+  RunRowSimd(OutputType *out, const InputType *in, int length, float addend, float multiplier) {
+#ifdef DALI_SIMD_HAS_F32X4
+    using multivec = simd::multivec<4>;
+    constexpr int kLanes = multivec::kNumLanes;
+    auto addend_vec = multivec::set1(addend);
+    int i = 0;
+    for (; i + kLanes <= length; i += kLanes) {
+      auto out_vec = addend_vec;
+      simd::madd(out_vec, multiplier, multivec::load(in + i));
+      simd::store(out + i, out_vec);
+    }
+    return i;
+#else
+    return 0;
+#endif
+  }
+
+  template <bool use_simd = kUseSimd>
+  static std::enable_if_t<!use_simd, int>
+  RunRowSimd(OutputType *, const InputType *, int, float, float) {
+    return 0;
+  }
 };
 
 }  // namespace kernels
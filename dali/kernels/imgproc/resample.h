@@ -38,6 +38,12 @@ struct ResampleGPU {
 
   ImplPtr pImpl;
 
+  /**
+   * @brief If true, the work is split into blocks of similar size and the largest samples
+   *        are processed first; see SeparableResamplingSetup::balance_blocks
+   */
+  bool balance_blocks = false;
+
   Impl *SelectImpl(
       KernelContext &context,
       const Input &input,
@@ -49,6 +55,7 @@ struct ResampleGPU {
 
   KernelRequirements Setup(KernelContext &context, const Input &input, const Params &params) {
     auto *impl = SelectImpl(context, input, params);
+    impl->SetBalanceBlocks(balance_blocks);
     return impl->Setup(context, input, params);
   }
 
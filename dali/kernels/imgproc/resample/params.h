@@ -60,6 +60,14 @@ struct FilterDesc {
   float radius = 0;
 };
 
+constexpr bool operator==(const FilterDesc &a, const FilterDesc &b) {
+  return a.type == b.type && a.radius == b.radius;
+}
+
+constexpr bool operator!=(const FilterDesc &a, const FilterDesc &b) {
+  return !(a == b);
+}
+
 /**
  * @brief Resampling parameters for 1 dimension
  */
@@ -80,6 +88,19 @@ struct ResamplingParams {
   ROI roi;
 };
 
+inline bool operator==(const ResamplingParams::ROI &a, const ResamplingParams::ROI &b) {
+  return a.use_roi == b.use_roi && a.start == b.start && a.end == b.end;
+}
+
+inline bool operator==(const ResamplingParams &a, const ResamplingParams &b) {
+  return a.min_filter == b.min_filter && a.mag_filter == b.mag_filter &&
+         a.output_size == b.output_size && a.roi == b.roi;
+}
+
+inline bool operator!=(const ResamplingParams &a, const ResamplingParams &b) {
+  return !(a == b);
+}
+
 template <int ndim>
 using ResamplingParamsND = std::array<ResamplingParams, ndim>;
 
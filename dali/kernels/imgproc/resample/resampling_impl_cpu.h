@@ -85,147 +85,35 @@ void ResampleCol(Out *out, const In *in, int x, int w, const int32_t *in_columns
   }
 }
 
-template <typename Out, typename In>
-struct SIMD_vert_resample_impl {
-#ifdef __SSE2__
-  static constexpr int kVecSize = 16;
-  static constexpr int load_lanes = kVecSize / sizeof(In);
-  static constexpr int store_lanes = kVecSize / sizeof(Out);
-  static constexpr int kNumLanes = load_lanes > store_lanes ? load_lanes : store_lanes;
-  static constexpr int kNumVecs = kNumLanes * sizeof(float) / kVecSize;
-
-  using vec_pack = simd::multivec<kNumVecs>;
-#endif
-
-  static void run(Out *out, const In **rows, const float *kernel, int support,
-                   int begin_col, int end_col) {
-    int i = begin_col;
-#ifdef __SSE2__
-    for (; i + kNumLanes <= end_col; i += kNumLanes) {
-      vec_pack vtmp = vec_pack::zero();
-
-      for (int k = 0; k < support; k++) {
-        vec_pack vin = vec_pack::load(rows[k] + i);
-        __m128 coeff = _mm_set1_ps(kernel[k]);
-        for (int v = 0; v < kNumVecs; v++)
-          vtmp.v[v] = _mm_add_ps(vtmp.v[v], _mm_mul_ps(coeff, vin.v[v]));
-      }
-      store(out + i, vtmp);
-    }
-#endif
-    for (; i < end_col; i++) {
-      float tmp = 0;
-      for (int k = 0; k < support; k++)
-        tmp += rows[k][i] * kernel[k];
-      out[i] = ConvertSat<Out>(tmp);
-    }
-  }
-};
-
+namespace resampling_impl {
 
-template <typename Out, typename In>
-struct SIMD_horz_resample_impl {
-#ifdef __SSE2__
-  static constexpr int kVecSize = 16;
-  static constexpr int kNumLanes = kVecSize / sizeof(Out);
-  static constexpr int kNumVecs = kNumLanes * sizeof(float) / kVecSize;
-
-  using vec_pack = simd::multivec<kNumVecs>;
+/**
+ * @brief The resampling loops built for the baseline instruction set
+ */
+namespace generic {
+#ifdef DALI_SIMD_HAS_F32X4
+namespace vec = simd;
+#define DALI_RESAMPLING_SIMD_VECTORIZE
 #endif
+#include "dali/kernels/imgproc/resample/resampling_impl_cpu_simd.h"  // NOLINT(build/include)
+#undef DALI_RESAMPLING_SIMD_VECTORIZE
+}  // namespace generic
 
-  template <int static_channels, bool clamp_left, bool clamp_right>
-  inline int run(Out *out, const In *in, int ox0, int ox1, int w,
-                 const int32_t *in_columns,
-                 const float *coeffs, int support,
-                 int dynamic_channels) {
-    const int channels = static_channels < 0 ? dynamic_channels : static_channels;
-
-    int x = ox0;
-#ifdef __SSE2__
-    float tmpin[kNumLanes];
-    for (; x + kNumLanes <= ox1; x += kNumLanes) {
-      Out tmp_out[kNumLanes];
-
-      if (static_channels < 0) {
-        // we don't know how many channels we have at compile time - inner loop over filter
-        for (int c = 0; c < channels; c++) {
-          vec_pack vout;
-          vout = vec_pack::zero();
-
-          for (int k = 0; k < support; k++) {
-            float tmp_coeffs[kNumLanes];
-            for (int l = 0; l < kNumLanes; l++)
-              tmp_coeffs[l] = coeffs[(x + l) * support + k];  // interleave per-column coefficients
-            vec_pack vcoeffs = vec_pack::load(tmp_coeffs);
-
-            for (int l = 0; l < kNumLanes; l++) {
-              int srcx = in_columns[x + l] + k;
-              if (clamp_left) if (srcx < 0) srcx = 0;
-              if (clamp_right) if (srcx > w-1) srcx = w-1;
-              tmpin[l] = in[srcx * channels + c];
-            }
-            vec_pack vin = vec_pack::load(tmpin);
-
-            for (int v = 0; v < kNumVecs; v++)
-              vout.v[v] = _mm_add_ps(vout.v[v], _mm_mul_ps(vcoeffs.v[v], vin.v[v]));
-          }
-          store(tmp_out, vout);
-          for (int l = 0; l < kNumLanes; l++)
-            out[channels * (x + l) + c] = tmp_out[l];  // interleave
-        }
-      } else {
-        // we know how many channels we have at compile time - inner loop over channels
-        static constexpr int kNCh = static_channels > 0 ? static_channels : 1;
-        vec_pack vout[kNCh];
-        Out tmp_out[kNCh][kNumLanes];
-        float tmp_in[kNCh][kNumLanes];
-
-        for (int c = 0; c < channels; c++)
-          vout[c] = vec_pack::zero();
-
-        for (int k = 0; k < support; k++) {
-          float tmp_coeffs[kNumLanes];
-          for (int l = 0; l < kNumLanes; l++)
-            tmp_coeffs[l] = coeffs[(x + l) * support + k];  // interleave per-column coefficients
-          vec_pack vcoeffs = vec_pack::load(tmp_coeffs);
-
-
-          for (int l = 0; l < kNumLanes; l++) {
-            int srcx = in_columns[x + l] + k;
-            if (clamp_left) if (srcx < 0) srcx = 0;
-            if (clamp_right) if (srcx > w-1) srcx = w-1;
-            for (int c = 0; c < channels; c++) {
-              tmp_in[c][l] = in[srcx * channels + c];
-            }
-          }
-
-          for (int c = 0; c < channels; c++) {
-            vec_pack vin = vec_pack::load(tmp_in[c]);
-            for (int v = 0; v < kNumVecs; v++)
-              vout[c].v[v] = _mm_add_ps(vout[c].v[v], _mm_mul_ps(vcoeffs.v[v], vin.v[v]));
-          }
-        }
-
-        for (int c = 0; c < channels; c++)
-          store(tmp_out[c], vout[c]);
-
-        for (int l = 0; l < kNumLanes; l++)
-          for (int c = 0; c < channels; c++)
-            out[channels * (x + l) + c] = tmp_out[c][l];  // interleave channels
-      }
-    }
+#ifdef DALI_SIMD_HAS_AVX2
+DALI_SIMD_AVX2_BEGIN
+/**
+ * @brief The resampling loops built for AVX2 - must only be used when the CPU supports it
+ */
+namespace avx2 {
+namespace vec = simd::avx2;
+#define DALI_RESAMPLING_SIMD_VECTORIZE
+#include "dali/kernels/imgproc/resample/resampling_impl_cpu_simd.h"  // NOLINT(build/include)
+#undef DALI_RESAMPLING_SIMD_VECTORIZE
+}  // namespace avx2
+DALI_SIMD_AVX2_END
 #endif
 
-    for (; x < ox1; x++) {
-      ResampleCol<static_channels, clamp_left, clamp_right, Out, In>(
-          out, in, x, w, in_columns, coeffs, support, dynamic_channels);
-    }
-
-    return x;
-  }
-};
-
-
+}  // namespace resampling_impl
 
 /**
  * @brief Calcualtes the indices of first and last _output_ columns that does not need
@@ -287,32 +175,17 @@ template <int static_channels = -1, typename Out, typename In>
 void ResamplHorzRow(Out *out_row, int out_width, const In *in_row, int in_width, int channels,
                     const int *in_columns, const float *coeffs, int support,
                     int first_regular_col, int last_regular_col, bool flipped) {
-  int x = 0;
-  // if last_regular_col < first_regular_col, then we can only use one-sided clamp
-  // up to last_regular_col-1
-  int max_one_sided_clamp = std::min(first_regular_col, last_regular_col+1);
-
-  SIMD_horz_resample_impl<Out, In> impl;
-  if (flipped) {
-    x = impl.template run<static_channels, false, true>(
-        out_row, in_row, x, max_one_sided_clamp, in_width, in_columns, coeffs, support, channels);
-  } else {
-    x = impl.template run<static_channels, true, false>(
-        out_row, in_row, x, max_one_sided_clamp, in_width, in_columns, coeffs, support, channels);
-  }
-
-  x = impl.template run<static_channels, true, true>(
-        out_row, in_row, x, first_regular_col, in_width, in_columns, coeffs, support, channels);
-  x = impl.template run<static_channels, false, false>(
-        out_row, in_row, x, last_regular_col+1, in_width, in_columns, coeffs, support, channels);
-
-  if (flipped) {
-    impl.template run<static_channels, true, false>(
-        out_row, in_row, x, out_width, in_width, in_columns, coeffs, support, channels);
-  } else {
-    impl.template run<static_channels, false, true>(
-        out_row, in_row, x, out_width, in_width, in_columns, coeffs, support, channels);
+#ifdef DALI_SIMD_HAS_AVX2
+  if (simd::avx2::is_supported()) {
+    resampling_impl::avx2::ResamplHorzRow<static_channels>(
+        out_row, out_width, in_row, in_width, channels, in_columns, coeffs, support,
+        first_regular_col, last_regular_col, flipped);
+    return;
   }
+#endif
+  resampling_impl::generic::ResamplHorzRow<static_channels>(
+      out_row, out_width, in_row, in_width, channels, in_columns, coeffs, support,
+      first_regular_col, last_regular_col, flipped);
 }
 
 template <int static_channels = -1, typename Out, typename In>
@@ -363,9 +236,10 @@ template <typename Out, typename In>
 void ResampleVert(
     Surface2D<Out> out, Surface2D<In> in, const int32_t *in_rows,
     const float *row_coeffs, int support) {
-  constexpr int tile = 256;
-
   int flat_w = out.size.x * out.channels;
+#ifdef DALI_SIMD_HAS_AVX2
+  const bool use_avx2 = simd::avx2::is_supported();
+#endif
 
   assert(support > 0);
   const In **in_row_ptrs = static_cast<const In **>(alloca(support * sizeof(const In *)));
@@ -380,12 +254,15 @@ void ResampleVert(
       in_row_ptrs[k] = &in(0, sy);
     }
 
-    for (int x0 = 0; x0 < flat_w; x0 += tile) {
-      int tile_w = x0 + tile <= flat_w ? tile : flat_w - x0;
-      assert(tile_w <= tile);
-      SIMD_vert_resample_impl<Out, In> res;
-      res.run(out_row, in_row_ptrs, &row_coeffs[y * support], support, x0, x0 + tile_w);
+#ifdef DALI_SIMD_HAS_AVX2
+    if (use_avx2) {
+      resampling_impl::avx2::ResampleVertRow(out_row, in_row_ptrs, &row_coeffs[y * support],
+                                             support, flat_w);
+      continue;
     }
+#endif
+    resampling_impl::generic::ResampleVertRow(out_row, in_row_ptrs, &row_coeffs[y * support],
+                                              support, flat_w);
   }
 }
 
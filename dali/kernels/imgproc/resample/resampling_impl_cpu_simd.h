@@ -0,0 +1,204 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// NOLINT(build/header_guard)
+// This file is intentionally included multiple times, once for each instruction set.
+// It's included by resampling_impl_cpu.h in a namespace which defines `vec` as an alias
+// of the namespace with the vector types (simd or simd::avx2). The vector code is enabled
+// by defining DALI_RESAMPLING_SIMD_VECTORIZE.
+// Don't include it directly.
+
+template <typename Out, typename In>
+struct SIMD_vert_resample_impl {
+#ifdef DALI_RESAMPLING_SIMD_VECTORIZE
+  static constexpr int load_lanes = vec::storage_lanes<In>();
+  static constexpr int store_lanes = vec::storage_lanes<Out>();
+  static constexpr int kNumLanes = load_lanes > store_lanes ? load_lanes : store_lanes;
+  static constexpr int kNumVecs = kNumLanes / vec::kFloatLanes;
+
+  using vec_pack = vec::multivec<kNumVecs>;
+#endif
+
+  static void run(Out *out, const In **rows, const float *kernel, int support,
+                   int begin_col, int end_col) {
+    int i = begin_col;
+#ifdef DALI_RESAMPLING_SIMD_VECTORIZE
+    for (; i + kNumLanes <= end_col; i += kNumLanes) {
+      vec_pack vtmp = vec_pack::zero();
+
+      for (int k = 0; k < support; k++) {
+        vec_pack vin = vec_pack::load(rows[k] + i);
+        vec::madd(vtmp, kernel[k], vin);
+      }
+      vec::store(out + i, vtmp);
+    }
+#endif
+    for (; i < end_col; i++) {
+      float tmp = 0;
+      for (int k = 0; k < support; k++)
+        tmp += rows[k][i] * kernel[k];
+      out[i] = ConvertSat<Out>(tmp);
+    }
+  }
+};
+
+
+template <typename Out, typename In>
+struct SIMD_horz_resample_impl {
+#ifdef DALI_RESAMPLING_SIMD_VECTORIZE
+  static constexpr int kNumLanes = vec::storage_lanes<Out>();
+  static constexpr int kNumVecs = kNumLanes / vec::kFloatLanes;
+
+  using vec_pack = vec::multivec<kNumVecs>;
+#endif
+
+  template <int static_channels, bool clamp_left, bool clamp_right>
+  inline int run(Out *out, const In *in, int ox0, int ox1, int w,
+                 const int32_t *in_columns,
+                 const float *coeffs, int support,
+                 int dynamic_channels) {
+    const int channels = static_channels < 0 ? dynamic_channels : static_channels;
+
+    int x = ox0;
+#ifdef DALI_RESAMPLING_SIMD_VECTORIZE
+    float tmpin[kNumLanes];
+    for (; x + kNumLanes <= ox1; x += kNumLanes) {
+      Out tmp_out[kNumLanes];
+
+      if (static_channels < 0) {
+        // we don't know how many channels we have at compile time - inner loop over filter
+        for (int c = 0; c < channels; c++) {
+          vec_pack vout;
+          vout = vec_pack::zero();
+
+          for (int k = 0; k < support; k++) {
+            float tmp_coeffs[kNumLanes];
+            for (int l = 0; l < kNumLanes; l++)
+              tmp_coeffs[l] = coeffs[(x + l) * support + k];  // interleave per-column coefficients
+            vec_pack vcoeffs = vec_pack::load(tmp_coeffs);
+
+            for (int l = 0; l < kNumLanes; l++) {
+              int srcx = in_columns[x + l] + k;
+              if (clamp_left) if (srcx < 0) srcx = 0;
+              if (clamp_right) if (srcx > w-1) srcx = w-1;
+              tmpin[l] = in[srcx * channels + c];
+            }
+            vec_pack vin = vec_pack::load(tmpin);
+
+            vec::madd(vout, vcoeffs, vin);
+          }
+          vec::store(tmp_out, vout);
+          for (int l = 0; l < kNumLanes; l++)
+            out[channels * (x + l) + c] = tmp_out[l];  // interleave
+        }
+      } else {
+        // we know how many channels we have at compile time - inner loop over channels
+        static constexpr int kNCh = static_channels > 0 ? static_channels : 1;
+        vec_pack vout[kNCh];
+        Out tmp_out[kNCh][kNumLanes];
+        float tmp_in[kNCh][kNumLanes];
+
+        for (int c = 0; c < channels; c++)
+          vout[c] = vec_pack::zero();
+
+        for (int k = 0; k < support; k++) {
+          float tmp_coeffs[kNumLanes];
+          for (int l = 0; l < kNumLanes; l++)
+            tmp_coeffs[l] = coeffs[(x + l) * support + k];  // interleave per-column coefficients
+          vec_pack vcoeffs = vec_pack::load(tmp_coeffs);
+
+
+          for (int l = 0; l < kNumLanes; l++) {
+            int srcx = in_columns[x + l] + k;
+            if (clamp_left) if (srcx < 0) srcx = 0;
+            if (clamp_right) if (srcx > w-1) srcx = w-1;
+            for (int c = 0; c < channels; c++) {
+              tmp_in[c][l] = in[srcx * channels + c];
+            }
+          }
+
+          for (int c = 0; c < channels; c++) {
+            vec_pack vin = vec_pack::load(tmp_in[c]);
+            vec::madd(vout[c], vcoeffs, vin);
+          }
+        }
+
+        for (int c = 0; c < channels; c++)
+          vec::store(tmp_out[c], vout[c]);
+
+        for (int l = 0; l < kNumLanes; l++)
+          for (int c = 0; c < channels; c++)
+            out[channels * (x + l) + c] = tmp_out[c][l];  // interleave channels
+      }
+    }
+#endif
+
+    for (; x < ox1; x++) {
+      ResampleCol<static_channels, clamp_left, clamp_right, Out, In>(
+          out, in, x, w, in_columns, coeffs, support, dynamic_channels);
+    }
+
+    return x;
+  }
+};
+
+/**
+ * @brief Resamples a row horizontally - see kernels::ResamplHorzRow
+ */
+template <int static_channels, typename Out, typename In>
+void ResamplHorzRow(Out *out_row, int out_width, const In *in_row, int in_width, int channels,
+                    const int *in_columns, const float *coeffs, int support,
+                    int first_regular_col, int last_regular_col, bool flipped) {
+  int x = 0;
+  // if last_regular_col < first_regular_col, then we can only use one-sided clamp
+  // up to last_regular_col-1
+  int max_one_sided_clamp = std::min(first_regular_col, last_regular_col+1);
+
+  SIMD_horz_resample_impl<Out, In> impl;
+  if (flipped) {
+    x = impl.template run<static_channels, false, true>(
+        out_row, in_row, x, max_one_sided_clamp, in_width, in_columns, coeffs, support, channels);
+  } else {
+    x = impl.template run<static_channels, true, false>(
+        out_row, in_row, x, max_one_sided_clamp, in_width, in_columns, coeffs, support, channels);
+  }
+
+  x = impl.template run<static_channels, true, true>(
+        out_row, in_row, x, first_regular_col, in_width, in_columns, coeffs, support, channels);
+  x = impl.template run<static_channels, false, false>(
+        out_row, in_row, x, last_regular_col+1, in_width, in_columns, coeffs, support, channels);
+
+  if (flipped) {
+    impl.template run<static_channels, true, false>(
+        out_row, in_row, x, out_width, in_width, in_columns, coeffs, support, channels);
+  } else {
+    impl.template run<static_channels, false, true>(
+        out_row, in_row, x, out_width, in_width, in_columns, coeffs, support, channels);
+  }
+}
+
+/**
+ * @brief Calculates one output row of the vertical resampling, in tiles
+ */
+template <typename Out, typename In>
+void ResampleVertRow(Out *out_row, const In **in_row_ptrs, const float *row_coeffs, int support,
+                     int flat_w) {
+  constexpr int tile = 256;
+  for (int x0 = 0; x0 < flat_w; x0 += tile) {
+    int tile_w = x0 + tile <= flat_w ? tile : flat_w - x0;
+    assert(tile_w <= tile);
+    SIMD_vert_resample_impl<Out, In> res;
+    res.run(out_row, in_row_ptrs, row_coeffs, support, x0, x0 + tile_w);
+  }
+}
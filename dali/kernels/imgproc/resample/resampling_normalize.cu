@@ -0,0 +1,177 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cuda_runtime.h>
+#include "dali/core/convert.h"
+#include "dali/core/float16.h"
+#include "dali/core/math_util.h"
+#include "dali/kernels/imgproc/resample/resampling_normalize.h"
+#include "dali/kernels/imgproc/resample/resampling_impl.cuh"
+
+namespace dali {
+namespace kernels {
+namespace resampling {
+
+namespace {
+
+template <typename Output>
+__device__ void StoreNormalized(const NormalizedOutputDesc<Output> &out, int x, int y, int c,
+                                float value) {
+  ptrdiff_t offset = y * out.strides.y + x * out.strides.x + c * out.channel_stride;
+  out.out[offset] = ConvertSat<Output>(fmaf(value, out.mul[c], out.add[c]));
+}
+
+/**
+ * @brief Nearest neighbor vertical pass with normalized output
+ */
+template <typename Output>
+__device__ void NNVertNormalize(
+    ivec2 lo, ivec2 hi, float origin, float scale,
+    const NormalizedOutputDesc<Output> &out,
+    const float *__restrict__ in, ptrdiff_t in_stride, ivec2 in_shape, int channels) {
+  origin += 0.5f * scale;
+  for (int y = lo.y + threadIdx.y; y < hi.y; y += blockDim.y) {
+    int ysrc = clamp(floor_int(y * scale + origin), 0, in_shape.y - 1);
+    const float *in_row = &in[ysrc * in_stride];
+    for (int x = lo.x + threadIdx.x; x < hi.x; x += blockDim.x) {
+      for (int c = 0; c < channels; c++)
+        StoreNormalized(out, x, y, c, __ldg(&in_row[x * channels + c]));
+    }
+  }
+}
+
+/**
+ * @brief Vertical pass with normalized output - see ResampleVert_Channels
+ */
+template <typename Output>
+__device__ void ResampleVertNormalize(
+    ivec2 lo, ivec2 hi, float src_y0, float scale,
+    const NormalizedOutputDesc<Output> &out,
+    const float *__restrict__ in, ptrdiff_t in_stride, ivec2 in_shape, int channels,
+    ResamplingFilter filter, int support) {
+  using resample_shared::coeffs;
+
+  int in_h = in_shape.y;
+
+  src_y0 += 0.5f * scale - 0.5f - filter.anchor;
+
+  const float filter_step = filter.scale;
+
+  const bool huge_kernel = support > 256;
+  const int coeff_base = huge_kernel ? 0 : support*threadIdx.y;
+
+  for (int i = lo.y; i < hi.y; i+=blockDim.y) {
+    int dy = i + threadIdx.y;
+    const float sy0f = dy * scale + src_y0;
+    const int sy0 = huge_kernel ? __float2int_rn(sy0f) : __float2int_ru(sy0f);
+    float f = (sy0 - sy0f) * filter_step;
+    __syncthreads();
+    if (huge_kernel) {
+      for (int k = threadIdx.x + blockDim.x*threadIdx.y; k < support; k += blockDim.x*blockDim.y) {
+        coeffs[k] = filter(f + k*filter_step);
+      }
+    } else {
+      for (int k = threadIdx.x; k < support; k += blockDim.x) {
+        coeffs[coeff_base + k] = filter(f + k*filter_step);
+      }
+    }
+    __syncthreads();
+
+    if (dy >= hi.y)
+      continue;
+
+    float norm = 0;
+    for (int k = 0; k < support; k++) {
+      norm += coeffs[coeff_base + k];
+    }
+    norm = 1.0f / norm;
+
+    for (int j = lo.x + threadIdx.x; j < hi.x; j += blockDim.x) {
+      const float *in_col = &in[j * channels];
+      for (int c = 0; c < channels; c++) {
+        float tmp = 0;
+        for (int k = 0; k < support; k++) {
+          int y = sy0 + k;
+          int ysample = y < 0 ? 0 : y >= in_h-1 ? in_h-1 : y;
+          tmp = fmaf(__ldg(in_col + in_stride * ysample + c), coeffs[coeff_base + k], tmp);
+        }
+        StoreNormalized(out, j, dy, c, tmp * norm);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+template <typename Output>
+__global__ void BatchedResampleVertNormalizeKernel(
+    const SampleDesc<2> *__restrict__ samples,
+    const NormalizedOutputDesc<Output> *__restrict__ outputs,
+    const BlockDesc<2> *__restrict__ block2sample) {
+  BlockDesc<2> bdesc = block2sample[blockIdx.x];
+  const auto &sample = samples[bdesc.sample_idx];
+  const NormalizedOutputDesc<Output> out = outputs[bdesc.sample_idx];
+
+  constexpr int which_pass = 1;
+  constexpr int axis = 1;  // vertical
+  const float *__restrict__ in = reinterpret_cast<const float *>(sample.pointers[which_pass]);
+  ptrdiff_t in_stride = sample.strides[which_pass].x;
+  ivec2 in_shape = sample.shapes[which_pass];
+
+  ResamplingFilterType ftype = sample.filter_type[axis];
+  ResamplingFilter filter = sample.filter[axis];
+
+  if (ftype == ResamplingFilterType::Nearest) {
+    NNVertNormalize(bdesc.start, bdesc.end, sample.origin[axis], sample.scale[axis],
+                    out, in, in_stride, in_shape, sample.channels);
+  } else {
+    // Linear filter is handled by the generic code - it uses a triangular filter with radius 1
+    ResampleVertNormalize(bdesc.start, bdesc.end, sample.origin[axis], sample.scale[axis],
+                          out, in, in_stride, in_shape, sample.channels,
+                          filter, filter.support());
+  }
+}
+
+template <typename Output>
+void BatchedResampleVertNormalize(
+    const SampleDesc<2> *samples,
+    const NormalizedOutputDesc<Output> *outputs,
+    const BlockDesc<2> *block2sample, int num_blocks,
+    ivec3 block_size,
+    cudaStream_t stream) {
+  if (num_blocks <= 0)
+    return;
+
+  dim3 block(block_size.x, block_size.y, block_size.z);
+
+  BatchedResampleVertNormalizeKernel<Output>
+  <<<num_blocks, block, ResampleSharedMemSize, stream>>>(samples, outputs, block2sample);
+  CUDA_CALL(cudaGetLastError());
+}
+
+#define INSTANTIATE_BATCHED_RESAMPLE_VERT_NORMALIZE(Output)                  \
+template DLL_PUBLIC void BatchedResampleVertNormalize<Output>(               \
+  const SampleDesc<2> *samples,                                              \
+  const NormalizedOutputDesc<Output> *outputs,                               \
+  const BlockDesc<2> *block2sample, int num_blocks,                          \
+  ivec3 block_size, cudaStream_t stream)
+
+INSTANTIATE_BATCHED_RESAMPLE_VERT_NORMALIZE(float);
+INSTANTIATE_BATCHED_RESAMPLE_VERT_NORMALIZE(float16);
+INSTANTIATE_BATCHED_RESAMPLE_VERT_NORMALIZE(uint8_t);
+INSTANTIATE_BATCHED_RESAMPLE_VERT_NORMALIZE(int8_t);
+
+}  // namespace resampling
+}  // namespace kernels
+}  // namespace dali
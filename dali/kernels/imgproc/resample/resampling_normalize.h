@@ -0,0 +1,59 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_KERNELS_IMGPROC_RESAMPLE_RESAMPLING_NORMALIZE_H_
+#define DALI_KERNELS_IMGPROC_RESAMPLE_RESAMPLING_NORMALIZE_H_
+
+#include <cuda_runtime.h>
+#include "dali/kernels/imgproc/resample/resampling_setup.h"
+
+namespace dali {
+namespace kernels {
+namespace resampling {
+
+/**
+ * @brief Describes where and how the fused vertical pass stores the output of one sample
+ *
+ * The output pixel (y, x, c) is stored at
+ * `out[y * strides.y + x * strides.x + c * channel_stride]`, as
+ * `ConvertSat<Output>(value * mul[c] + add[c])`.
+ */
+template <typename Output>
+struct NormalizedOutputDesc {
+  Output *out;
+  vec<2, ptrdiff_t> strides;  // x, y
+  ptrdiff_t channel_stride;
+  const float *mul, *add;
+};
+
+/**
+ * @brief Runs the vertical pass of a 2D separable resampling, storing the output through
+ *        `NormalizedOutputDesc`.
+ *
+ * The pass reads the (horizontally resampled) intermediate buffer from the sample descriptors.
+ * It requires that the samples are processed with the vertical pass last (`HorzVert` order).
+ */
+template <typename Output>
+void BatchedResampleVertNormalize(
+  const SampleDesc<2> *samples,
+  const NormalizedOutputDesc<Output> *outputs,
+  const BlockDesc<2> *block2sample, int num_blocks,
+  ivec3 block_size,
+  cudaStream_t stream);
+
+}  // namespace resampling
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_IMGPROC_RESAMPLE_RESAMPLING_NORMALIZE_H_
@@ -14,6 +14,7 @@
 
 #include <cuda_runtime.h>
 #include <algorithm>
+#include <numeric>
 #include "dali/core/util.h"
 #include "dali/kernels/imgproc/resample/resampling_setup.h"
 #include "dali/kernels/common/block_setup.h"
@@ -24,6 +25,11 @@ namespace resampling {
 
 constexpr int kMaxGPUFilterSupport = 8192;
 
+/**
+ * @brief Maximum number of elements (incl. channels) in a 2D block, when balancing the blocks
+ */
+constexpr int kMaxBalancedBlockElements = 1<<15;
+
 ResamplingFilter GetResamplingFilter(const ResamplingFilters *filters, const FilterDesc &params) {
   switch (params.type) {
     case ResamplingFilterType::Linear:
@@ -203,6 +209,13 @@ void SeparableResamplingSetup<2>::ComputeBlockLayout(SampleDesc &sample) const {
 
     ivec2 blk = sample.shapes[pass+1];
     blk[axis] = block_dim[axis];
+    if (balance_blocks) {
+      // The slices are cut into pieces of similar size, so that large samples
+      // produce many blocks instead of a few long-running ones.
+      int other = 1 - axis;
+      int max_extent = std::max(1, kMaxBalancedBlockElements / (blk[axis] * sample.channels));
+      blk[other] = std::max(1, std::min(blk[other], max_extent));
+    }
     sample.logical_block_shape[pass] = blk;
   }
 }
@@ -279,7 +292,8 @@ void SeparableResamplingSetup<spatial_ndim>::SetupSample(
     filter_support[i] = std::max(1, support);
   }
 
-  desc.order = GetProcessingOrder(roi.extent(), out_size, filter_support);
+  desc.order = use_fixed_order ? fixed_order
+                              : GetProcessingOrder(roi.extent(), out_size, filter_support);
 
   {
     ivec<spatial_ndim> pass_size = roi.extent();
@@ -326,6 +340,9 @@ void SeparableResamplingSetup<spatial_ndim>::SetupSample(
  * This function populates the sample_descs, intermediate_shapes, intermediate_sizes etc.
  * It does not calculate block descriptors directly, but it calculates the number of blocks
  * required to calculate each stage of each sample using SampleDesc::logical_block_shape.
+ *
+ * The descriptors of the samples whose shapes and parameters are the same as in the previous
+ * call (at the same index) are not recalculated.
  */
 template <int spatial_ndim>
 void BatchResamplingSetup<spatial_ndim>::SetupBatch(
@@ -347,10 +364,18 @@ void BatchResamplingSetup<spatial_ndim>::SetupBatch(
 
   total_blocks = 0;
 
+  int num_cached = UpdateOptions() ? setup_cache_.size() : 0;
+  setup_cache_.resize(N);
+
   for (int i = 0; i < N; i++) {
     SampleDesc &desc = sample_descs[i];
     auto ts_in = in.tensor_shape(i);
-    this->SetupSample(desc, ts_in, params[i]);
+    auto &key = setup_cache_[i];
+    if (i >= num_cached || key.in_shape != ts_in || key.params != params[i]) {
+      this->SetupSample(desc, ts_in, params[i]);
+      key.in_shape = ts_in;
+      key.params = params[i];
+    }
 
     for (int t = 0; t < num_tmp_buffers; t++) {
       TensorShape<tensor_ndim> ts_tmp = shape_cat(vec2shape(desc.tmp_shape(t)), desc.channels);
@@ -376,6 +401,25 @@ void BatchResamplingSetup<spatial_ndim>::SetupBatch(
   }
 }
 
+template <int spatial_ndim>
+bool BatchResamplingSetup<spatial_ndim>::UpdateOptions() {
+  SetupOptions options;
+  options.filters = this->filters.get();
+  options.block_dim = this->block_dim;
+  options.use_fixed_order = this->use_fixed_order;
+  options.fixed_order = this->fixed_order;
+  options.balance_blocks = this->balance_blocks;
+
+  auto &cached = cached_options_;
+  bool same = options.filters == cached.filters &&
+              options.block_dim == cached.block_dim &&
+              options.use_fixed_order == cached.use_fixed_order &&
+              (!options.use_fixed_order || options.fixed_order == cached.fixed_order) &&
+              options.balance_blocks == cached.balance_blocks;
+  cached = options;
+  return same;
+}
+
 template <int n>
 int AddBlocks(BlockDesc<n> *blocks, int sample_idx,
               ivec<n> block_size, ivec<n> extent,
@@ -414,8 +458,17 @@ void BatchResamplingSetup<spatial_ndim>::InitializeSampleLookup(
 
   int block = 0;
   int N = sample_descs.size();
+  sample_order_.resize(N);
   for (int pass = 0; pass < spatial_ndim; pass++) {
-    for (int i = 0; i < N; i++) {
+    std::iota(sample_order_.begin(), sample_order_.end(), 0);
+    if (this->balance_blocks) {
+      // The blocks are (roughly) scheduled in the order of their indices - starting with
+      // the largest samples leaves the small ones to fill the gaps at the end of the pass.
+      std::stable_sort(sample_order_.begin(), sample_order_.end(), [&](int a, int b) {
+        return volume(sample_descs[a].shapes[pass+1]) > volume(sample_descs[b].shapes[pass+1]);
+      });
+    }
+    for (int i : sample_order_) {
       auto &desc = sample_descs[i];
       if (volume(desc.out_shape()) > 0) {
         int sample_block_count = AddBlocks(sample_lookup.data + block, i,
@@ -142,6 +142,26 @@ class SeparableResamplingSetup {
 
   ivec3 block_dim;
 
+  /**
+   * @brief If set, `fixed_order` is used for all samples instead of the order
+   *        calculated from the input/output sizes and filter support
+   *
+   * This is required when the last pass is replaced with a custom one, e.g. one that
+   * also normalizes the output.
+   */
+  bool use_fixed_order = false;
+  ProcessingOrder<spatial_ndim> fixed_order;
+
+  /**
+   * @brief If set, the blocks are limited in size and the samples are scheduled
+   *        from the largest to the smallest
+   *
+   * Large samples are split into many blocks of similar cost instead of few long slices,
+   * which improves the load balance when the sizes of the samples in a batch differ a lot.
+   * The results are the same regardless of this setting.
+   */
+  bool balance_blocks = false;
+
  protected:
   using ROI = Roi<spatial_ndim>;
 
@@ -181,6 +201,35 @@ class BatchResamplingSetup : public SeparableResamplingSetup<_spatial_ndim> {
 
   /** @brief Calculates the mapping from grid block indices to samples and regions within samples */
   DLL_PUBLIC void InitializeSampleLookup(const OutTensorCPU<BlockDesc, 1> &sample_lookup);
+
+ private:
+  /**
+   * @brief Checks whether the options and filters are the same as in the previous call
+   *        to SetupBatch and stores the current ones
+   */
+  bool UpdateOptions();
+
+  /**
+   * @brief The arguments of SetupSample used to obtain the cached sample descriptors
+   *
+   * The sample descriptor depends only on these and the setup options, so, when they
+   * repeat in subsequent iterations, the descriptor is reused.
+   */
+  struct SampleSetupKey {
+    TensorShape<tensor_ndim> in_shape;
+    ResamplingParamsND<spatial_ndim> params;
+  };
+  std::vector<SampleSetupKey> setup_cache_;
+
+  struct SetupOptions {
+    const ResamplingFilters *filters = nullptr;
+    ivec3 block_dim;
+    bool use_fixed_order = false;
+    ProcessingOrder<spatial_ndim> fixed_order;
+    bool balance_blocks = false;
+  } cached_options_;
+
+  std::vector<int> sample_order_;
 };
 
 }  // namespace resampling
@@ -43,6 +43,14 @@ struct SeparableResamplingFilter {
   virtual void
   Run(KernelContext &context, const Output &out, const Input &in, const Params &params) = 0;
 
+  /**
+   * @brief Requests that the work is distributed evenly, at the cost of some overhead
+   *
+   * Useful for batches of samples of very different sizes. Implementations
+   * that don't support it ignore this setting.
+   */
+  virtual void SetBalanceBlocks(bool balance) {}
+
   using Ptr = std::unique_ptr<SeparableResamplingFilter>;
 
   static Ptr Create(const Params &params);
@@ -61,8 +61,23 @@ struct SeparableResamplingGPUImpl : Interface {
    */
   Intermediate intermediate[num_tmp_buffers];  // NOLINT
 
+  bool initialized_ = false;
+
+  /**
+   * @brief Obtains the filter tables
+   *
+   * The tables are kept (in device memory) for the lifetime of this object, so that
+   * they don't need to be acquired again in each iteration.
+   */
   void Initialize(KernelContext &context) {
-    setup.Initialize();
+    if (!initialized_) {
+      setup.Initialize();
+      initialized_ = true;
+    }
+  }
+
+  void SetBalanceBlocks(bool balance) override {
+    setup.balance_blocks = balance;
   }
 
   size_t GetTmpMemSize() const {
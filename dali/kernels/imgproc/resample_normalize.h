@@ -0,0 +1,171 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_KERNELS_IMGPROC_RESAMPLE_NORMALIZE_H_
+#define DALI_KERNELS_IMGPROC_RESAMPLE_NORMALIZE_H_
+
+#include <cuda_runtime.h>
+#include <tuple>
+#include <vector>
+#include "dali/core/error_handling.h"
+#include "dali/kernels/common/copy.h"
+#include "dali/kernels/kernel.h"
+#include "dali/kernels/imgproc/resample/params.h"
+#include "dali/kernels/imgproc/resample/resampling_batch.h"
+#include "dali/kernels/imgproc/resample/resampling_normalize.h"
+#include "dali/kernels/imgproc/resample/resampling_setup.h"
+
+namespace dali {
+namespace kernels {
+
+/**
+ * @brief 2D resampling with the normalization and the layout permutation fused into
+ *        the output stage
+ *
+ * The horizontal pass is done first and produces a float intermediate image; the vertical
+ * pass calculates `out = resampled * mul[c] + add[c]` and stores it directly in
+ * the output type, either interleaved (HWC) or planar (CHW).
+ * Cropping and mirroring are expressed as the regions of interest in the `params`.
+ */
+template <typename OutputElement, typename InputElement>
+struct ResampleNormalizeGPU {
+  using Input = InListGPU<InputElement, 3>;
+  using Output = OutListGPU<OutputElement, 3>;
+  using Params = span<const ResamplingParams2D>;
+
+  using ResamplingSetup = resampling::BatchResamplingSetup<2>;
+  using SampleDesc = ResamplingSetup::SampleDesc;
+  using BlockDesc = ResamplingSetup::BlockDesc;
+  using OutputDesc = resampling::NormalizedOutputDesc<OutputElement>;
+  using IntermediateElement = float;
+
+  /**
+   * @param planar_output if true, the output is CHW; otherwise it's HWC
+   */
+  KernelRequirements Setup(KernelContext &context, const Input &in, const Params &params,
+                           bool planar_output) {
+    setup.Initialize();
+    setup.use_fixed_order = true;
+    setup.fixed_order = resampling::HorzVert();
+    setup.SetupBatch(in.shape, params);
+    planar_output_ = planar_output;
+
+    int N = in.num_samples();
+    int total_channels = 0;
+    for (int i = 0; i < N; i++)
+      total_channels += setup.sample_descs[i].channels;
+
+    KernelRequirements req;
+    ScratchpadEstimator se;
+    se.add<mm::memory_kind::device, SampleDesc>(N);
+    se.add<mm::memory_kind::device, OutputDesc>(N);
+    se.add<mm::memory_kind::device, float>(2 * total_channels);
+
+    size_t num_blocks = setup.total_blocks[0] + setup.total_blocks[1];
+    se.add<mm::memory_kind::device, BlockDesc>(num_blocks);
+    se.add<mm::memory_kind::host, BlockDesc>(num_blocks);
+
+    se.add<mm::memory_kind::device, IntermediateElement>(setup.intermediate_sizes[0]);
+    req.scratch_sizes = se.sizes;
+
+    TensorListShape<3> out_shape = setup.output_shape;
+    if (planar_output) {
+      for (int i = 0; i < N; i++) {
+        auto sh = out_shape.tensor_shape_span(i);
+        out_shape.set_tensor_shape(i, TensorShape<3>{ sh[2], sh[0], sh[1] });
+      }
+    }
+    req.output_shapes = { out_shape };
+    return req;
+  }
+
+  /**
+   * @param mul per-channel multipliers; the channels of all samples, concatenated
+   * @param add per-channel values added after multiplication, in the same layout as `mul`
+   */
+  void Run(KernelContext &context, const Output &out, const Input &in,
+           span<const float> mul, span<const float> add) {
+    cudaStream_t stream = context.gpu.stream;
+    int N = in.num_samples();
+    DALI_ENFORCE(mul.size() == add.size(),
+                 "The multipliers and the added values must have the same size");
+
+    int blocks_in_all_passes = setup.total_blocks[0] + setup.total_blocks[1];
+    OutTensorCPU<BlockDesc, 1> sample_lookup_cpu = {
+      context.scratchpad->AllocateHost<BlockDesc>(blocks_in_all_passes),
+      { blocks_in_all_passes }
+    };
+    OutTensorGPU<BlockDesc, 1> sample_lookup_gpu = {
+      context.scratchpad->AllocateGPU<BlockDesc>(blocks_in_all_passes),
+      { blocks_in_all_passes }
+    };
+    setup.InitializeSampleLookup(sample_lookup_cpu);
+    copy(sample_lookup_gpu, sample_lookup_cpu, stream);  // NOLINT (it thinks it's std::copy)
+
+    auto *tmp_mem = context.scratchpad->AllocateGPU<IntermediateElement>(
+        setup.intermediate_sizes[0]);
+    float *mul_gpu, *add_gpu;
+    std::tie(mul_gpu, add_gpu) = context.scratchpad->ToContiguousGPU(stream, mul, add);
+
+    output_descs_.resize(N);
+    size_t tmp_offset = 0, channel_offset = 0;
+    for (int i = 0; i < N; i++) {
+      auto &desc = setup.sample_descs[i];
+      desc.set_base_pointers(in.tensor_data(i), tmp_mem + tmp_offset, out.tensor_data(i));
+      tmp_offset += volume(setup.intermediate_shapes[0].tensor_shape_span(i));
+
+      int C = desc.channels;
+      ivec2 size = desc.out_shape();
+      auto &out_desc = output_descs_[i];
+      out_desc.out = out.tensor_data(i);
+      if (planar_output_) {
+        out_desc.strides = { 1, size.x };
+        out_desc.channel_stride = static_cast<ptrdiff_t>(size.x) * size.y;
+      } else {
+        out_desc.strides = { C, static_cast<ptrdiff_t>(size.x) * C };
+        out_desc.channel_stride = 1;
+      }
+      DALI_ENFORCE(channel_offset + C <= static_cast<size_t>(mul.size()),
+                   "Not enough normalization parameters for all the channels in the batch");
+      out_desc.mul = mul_gpu + channel_offset;
+      out_desc.add = add_gpu + channel_offset;
+      channel_offset += C;
+    }
+
+    SampleDesc *descs_gpu;
+    OutputDesc *output_descs_gpu;
+    std::tie(descs_gpu, output_descs_gpu) = context.scratchpad->ToContiguousGPU(
+        stream, setup.sample_descs, output_descs_);
+
+    resampling::BatchedSeparableResample<2, IntermediateElement, InputElement>(
+        0, descs_gpu,
+        sample_lookup_gpu.data, setup.total_blocks[0],
+        setup.block_dim, stream);
+    resampling::BatchedResampleVertNormalize<OutputElement>(
+        descs_gpu, output_descs_gpu,
+        sample_lookup_gpu.data + setup.total_blocks[0], setup.total_blocks[1],
+        setup.block_dim, stream);
+  }
+
+  ResamplingSetup setup;
+
+ private:
+  bool planar_output_ = false;
+  std::vector<OutputDesc> output_descs_;
+};
+
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_IMGPROC_RESAMPLE_NORMALIZE_H_
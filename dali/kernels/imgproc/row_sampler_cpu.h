@@ -0,0 +1,195 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_KERNELS_IMGPROC_ROW_SAMPLER_CPU_H_
+#define DALI_KERNELS_IMGPROC_ROW_SAMPLER_CPU_H_
+
+#include <algorithm>
+#include <vector>
+#include "dali/core/geom/vec.h"
+#include "dali/kernels/common/simd.h"
+#include "dali/kernels/imgproc/sampler.h"
+#include "dali/kernels/imgproc/surface.h"
+
+namespace dali {
+namespace kernels {
+
+#ifdef DALI_SIMD_HAS_F32X4
+
+/**
+ * @brief Computes the source coordinates `origin + x * dsdx` of the pixels 0..n-1 of a row
+ *
+ * The coordinates are calculated directly (not accumulated), so there's no drift along the row.
+ */
+inline void AffineRowCoords(float *xs, float *ys, int n, vec2 origin, vec2 dsdx) {
+  constexpr int kLanes = simd::kFloatLanes;
+  const float iota[kLanes] = { 0, 1, 2, 3 };
+  auto lanes = simd::load_f(iota).v[0];
+  auto ox = simd::set1_f(origin.x), oy = simd::set1_f(origin.y);
+  auto dx = simd::set1_f(dsdx.x), dy = simd::set1_f(dsdx.y);
+  int x = 0;
+  for (; x + kLanes <= n; x += kLanes) {
+    auto xf = simd::add_f(simd::set1_f(x), lanes);
+    simd::store_f(xs + x, simd::float4x1{{ simd::madd_f(ox, xf, dx) }});
+    simd::store_f(ys + x, simd::float4x1{{ simd::madd_f(oy, xf, dy) }});
+  }
+  for (; x < n; x++) {
+    float xf = x;
+    xs[x] = origin.x + xf * dsdx.x;
+    ys[x] = origin.y + xf * dsdx.y;
+  }
+}
+
+/**
+ * @brief Bilinear sampling of a row of output pixels, kBlock pixels at a time
+ *
+ * The source coordinates are given in arrays, one per dimension. The integer coordinates,
+ * the interpolation weights and the blending are calculated in vectors spanning kBlock pixels.
+ * The taps of the pixels fully inside the image are read directly, the others go through
+ * the border handling of Sampler2D.
+ *
+ * The results are converted to the output type with the SIMD conversions, which round half
+ * to even - the scalar Sampler2D rounds half away from zero.
+ */
+template <typename In>
+class LinearRowSampler2D {
+ public:
+  static constexpr int kBlock = 16;
+  static constexpr int kVecs = kBlock / simd::kFloatLanes;
+  using block_vec = simd::multivec<kVecs>;
+
+  explicit LinearRowSampler2D(const Surface2D<const In> &surface) : surface_(surface) {
+    taps_.resize(4 * surface.channels * kBlock);
+    if (surface.channels != 1 && surface.channels != 3)
+      interleaved_.resize(surface.channels * kBlock);
+  }
+
+  /**
+   * @brief Samples the pixels at (`xs[i]`, `ys[i]`) and stores them, with interleaved channels,
+   *        in `out`
+   *
+   * @return the number of pixels processed - a multiple of kBlock; the remaining ones are left
+   *         for the scalar sampler
+   */
+  template <typename Out, typename BorderValue>
+  int operator()(Out *out, const float *xs, const float *ys, int n, BorderValue border) {
+    int x = 0;
+    for (; x + kBlock <= n; x += kBlock)
+      SampleBlock(out + x * surface_.channels, xs + x, ys + x, border);
+    return x;
+  }
+
+ private:
+  template <typename Out, typename BorderValue>
+  void SampleBlock(Out *out, const float *xs, const float *ys, BorderValue border) {
+    // larger coordinates are outside any image; clamping keeps the integer conversion valid
+    constexpr float kMaxCoord = 1 << 24;
+    alignas(16) int32_t x0s[kBlock], y0s[kBlock];
+    block_vec px, qx, py, qy;
+    auto half = simd::set1_f(0.5f), one = simd::set1_f(1.0f);
+    auto lo = simd::set1_f(-kMaxCoord), hi = simd::set1_f(kMaxCoord);
+    for (int v = 0; v < kVecs; v++) {
+      int offset = v * simd::kFloatLanes;
+      auto x = simd::clamp_f(simd::sub_f(simd::load_f(xs + offset).v[0], half), lo, hi);
+      auto y = simd::clamp_f(simd::sub_f(simd::load_f(ys + offset).v[0], half), lo, hi);
+      auto fx = x, fy = y;
+      simd::store_i32(x0s + offset, simd::i128x1{{ simd::floor_i32(x, fx) }});
+      simd::store_i32(y0s + offset, simd::i128x1{{ simd::floor_i32(y, fy) }});
+      qx.v[v] = simd::sub_f(x, fx);
+      qy.v[v] = simd::sub_f(y, fy);
+      px.v[v] = simd::sub_f(one, qx.v[v]);
+      py.v[v] = simd::sub_f(one, qy.v[v]);
+    }
+
+    LoadTaps(x0s, y0s, border);
+
+    const int C = surface_.channels;
+    auto blend = [&](int c) {
+      const float *t = taps_.data() + c * kBlock;
+      const int tap_stride = C * kBlock;
+      auto s0 = block_vec::zero(), s1 = block_vec::zero(), s = block_vec::zero();
+      simd::madd(s0, block_vec::load(t), px);
+      simd::madd(s0, block_vec::load(t + tap_stride), qx);
+      simd::madd(s1, block_vec::load(t + 2 * tap_stride), px);
+      simd::madd(s1, block_vec::load(t + 3 * tap_stride), qx);
+      simd::madd(s, s0, py);
+      simd::madd(s, s1, qy);
+      return s;
+    };
+
+    if (C == 1) {
+      simd::store(out, blend(0));
+    } else if (C == 3) {
+      block_vec planes[3] = { blend(0), blend(1), blend(2) };
+      simd::store(out, simd::interleave3(planes));
+    } else {
+      float plane[kBlock];
+      for (int c = 0; c < C; c++) {
+        simd::store(plane, blend(c));
+        for (int i = 0; i < kBlock; i++)
+          interleaved_[i * C + c] = plane[i];
+      }
+      for (int i = 0; i < C; i++)
+        simd::store(out + i * kBlock, block_vec::load(interleaved_.data() + i * kBlock));
+    }
+  }
+
+  /**
+   * @brief Reads the 4 taps of each pixel as floats; the tap `k` of channel `c` of the pixel `i`
+   *        is stored in `taps_[(k * C + c) * kBlock + i]`
+   */
+  template <typename BorderValue>
+  void LoadTaps(const int32_t *x0s, const int32_t *y0s, BorderValue border) {
+    const int C = surface_.channels;
+    const int tap_stride = C * kBlock;
+    // when the top-left tap is in this range, all 4 taps are inside the image
+    const unsigned x_limit = std::max(surface_.size.x - 1, 0);
+    const unsigned y_limit = std::max(surface_.size.y - 1, 0);
+    const int64_t sx = surface_.strides.x, sy = surface_.strides.y;
+    const int64_t sc = surface_.channel_stride;
+    Sampler2D<DALI_INTERP_NN, In> NN(surface_);
+    for (int i = 0; i < kBlock; i++) {
+      int x0 = x0s[i], y0 = y0s[i];
+      float *t = taps_.data() + i;
+      if (static_cast<unsigned>(x0) < x_limit && static_cast<unsigned>(y0) < y_limit) {
+        const In *row0 = surface_.data + y0 * sy + x0 * sx;
+        const In *row1 = row0 + sy;
+        for (int c = 0; c < C; c++, t += kBlock, row0 += sc, row1 += sc) {
+          t[0] = row0[0];
+          t[tap_stride] = row0[sx];
+          t[2 * tap_stride] = row1[0];
+          t[3 * tap_stride] = row1[sx];
+        }
+      } else {
+        for (int c = 0; c < C; c++, t += kBlock) {
+          t[0] = NN.at(ivec2(x0, y0), c, border);
+          t[tap_stride] = NN.at(ivec2(x0 + 1, y0), c, border);
+          t[2 * tap_stride] = NN.at(ivec2(x0, y0 + 1), c, border);
+          t[3 * tap_stride] = NN.at(ivec2(x0 + 1, y0 + 1), c, border);
+        }
+      }
+    }
+  }
+
+  Surface2D<const In> surface_;
+  std::vector<float> taps_;
+  std::vector<float> interleaved_;
+};
+
+#endif  // DALI_SIMD_HAS_F32X4
+
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_IMGPROC_ROW_SAMPLER_CPU_H_
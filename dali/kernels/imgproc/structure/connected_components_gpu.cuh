@@ -0,0 +1,393 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_KERNELS_IMGPROC_STRUCTURE_CONNECTED_COMPONENTS_GPU_CUH_
+#define DALI_KERNELS_IMGPROC_STRUCTURE_CONNECTED_COMPONENTS_GPU_CUH_
+
+#include <cuda_runtime.h>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include "dali/core/cuda_error.h"
+#include "dali/core/cuda_utils.h"
+#include "dali/core/force_inline.h"
+#include "dali/core/format.h"
+#include "dali/core/tensor_shape.h"
+#include "dali/core/util.h"
+
+namespace dali {
+namespace kernels {
+namespace connected_components {
+namespace gpu_impl {
+
+/// @brief Number of elements (in flattened order) labeled by one thread block in shared memory
+static constexpr int kTileSize = 2048;
+static constexpr int kBlockSize = 256;
+static constexpr int kScanBlockSize = 1024;
+static constexpr int kMaxDims = 6;
+
+template <typename Label>
+struct LabelingDesc {
+  int ndim;
+  Label volume;
+  Label shape[kMaxDims];
+  Label stride[kMaxDims];
+
+  /// @brief Returns true if the element at flat index `idx` has a predecessor along axis `d`
+  __device__ DALI_FORCEINLINE bool has_prev(Label idx, int d) const {
+    return (idx / stride[d]) % shape[d] != 0;
+  }
+};
+
+template <typename Label>
+LabelingDesc<Label> MakeLabelingDesc(const TensorShape<> &shape) {
+  LabelingDesc<Label> desc;
+  desc.ndim = shape.sample_dim();
+  if (desc.ndim > kMaxDims)
+    throw std::invalid_argument(make_string(
+        "Unsupported number of dimensions: ", desc.ndim, ". Valid range is 0..", kMaxDims, "."));
+  Label stride = 1;
+  for (int d = desc.ndim - 1; d >= 0; d--) {
+    desc.shape[d] = shape[d];
+    desc.stride[d] = stride;
+    stride *= shape[d];
+  }
+  desc.volume = stride;
+  return desc;
+}
+
+__device__ DALI_FORCEINLINE int32_t atomic_min_label(int32_t *addr, int32_t value) {
+  return atomicMin(addr, value);
+}
+
+__device__ DALI_FORCEINLINE int64_t atomic_min_label(int64_t *addr, int64_t value) {
+  return atomicMin(reinterpret_cast<long long *>(addr), static_cast<long long>(value));  // NOLINT
+}
+
+/**
+ * @brief Follows the parent links up to the root, without modifying the structure
+ *
+ * The structure is modified concurrently by other threads, hence no path compression.
+ */
+template <typename Label>
+__device__ Label FindRoot(const Label *parent, Label x) {
+  for (;;) {
+    Label p = parent[x];
+    if (p == x)
+      return x;
+    x = p;
+  }
+}
+
+/**
+ * @brief Merges the sets containing `a` and `b`, linking the greater root to the smaller one.
+ *
+ * If the root that was about to be linked has been linked by another thread in the meantime,
+ * the merge is retried with the new parent, so no link is lost.
+ */
+template <typename Label>
+__device__ void Merge(Label *parent, Label a, Label b) {
+  for (;;) {
+    a = FindRoot(parent, a);
+    b = FindRoot(parent, b);
+    if (a == b)
+      return;
+    if (a > b) {
+      Label tmp = a;
+      a = b;
+      b = tmp;
+    }
+    Label old = atomic_min_label(parent + b, a);
+    if (old == b)
+      return;
+    b = old;
+  }
+}
+
+/**
+ * @brief Labels the connected regions within a tile of `kTileSize` elements in shared memory
+ *        and stores the links to the tile-local roots in `labels`.
+ *
+ * Background elements are marked with -1.
+ */
+template <typename Label, typename T>
+__global__ void LocalMergeKernel(Label *labels, const T *in, LabelingDesc<Label> desc,
+                                 T background) {
+  __shared__ int32_t local[kTileSize];
+  Label tile_start = static_cast<Label>(blockIdx.x) * kTileSize;
+  int tile_len = cuda_min<Label>(kTileSize, desc.volume - tile_start);
+  for (int i = threadIdx.x; i < tile_len; i += blockDim.x)
+    local[i] = i;
+  __syncthreads();
+  for (int i = threadIdx.x; i < tile_len; i += blockDim.x) {
+    Label idx = tile_start + i;
+    T value = in[idx];
+    if (value == background)
+      continue;
+    for (int d = 0; d < desc.ndim; d++) {
+      Label stride = desc.stride[d];
+      if (i >= stride || !desc.has_prev(idx, d))
+        continue;
+      if (in[idx - stride] == value)
+        Merge(local, i, static_cast<int32_t>(i - stride));
+    }
+  }
+  __syncthreads();
+  for (int i = threadIdx.x; i < tile_len; i += blockDim.x) {
+    Label idx = tile_start + i;
+    labels[idx] = in[idx] == background ? Label(-1) : tile_start + FindRoot(local, i);
+  }
+}
+
+/**
+ * @brief Merges the regions which are connected across tile boundaries
+ */
+template <typename Label, typename T>
+__global__ void BoundaryMergeKernel(Label *labels, const T *in, LabelingDesc<Label> desc,
+                                    T background) {
+  Label tile_start = static_cast<Label>(blockIdx.x) * kTileSize;
+  int tile_len = cuda_min<Label>(kTileSize, desc.volume - tile_start);
+  for (int i = threadIdx.x; i < tile_len; i += blockDim.x) {
+    Label idx = tile_start + i;
+    T value = in[idx];
+    if (value == background)
+      continue;
+    for (int d = 0; d < desc.ndim; d++) {
+      Label stride = desc.stride[d];
+      if (i < stride && desc.has_prev(idx, d) && in[idx - stride] == value)
+        Merge(labels, idx, idx - stride);
+    }
+  }
+}
+
+/**
+ * @brief Points each element directly to its root and counts the roots in each tile
+ */
+template <typename Label>
+__global__ void FlattenKernel(Label *labels, Label *tile_counts, Label volume) {
+  __shared__ int count;
+  if (threadIdx.x == 0)
+    count = 0;
+  __syncthreads();
+  Label tile_start = static_cast<Label>(blockIdx.x) * kTileSize;
+  int tile_len = cuda_min<Label>(kTileSize, volume - tile_start);
+  int local_count = 0;
+  for (int i = threadIdx.x; i < tile_len; i += blockDim.x) {
+    Label idx = tile_start + i;
+    if (labels[idx] < 0)
+      continue;
+    Label root = FindRoot(labels, idx);
+    // only the own entry is updated - other threads may be traversing the structure
+    labels[idx] = root;
+    local_count += root == idx;
+  }
+  if (local_count)
+    atomicAdd(&count, local_count);
+  __syncthreads();
+  if (threadIdx.x == 0)
+    tile_counts[blockIdx.x] = count;
+}
+
+/**
+ * @brief Replaces the per-tile root counts with an exclusive prefix sum;
+ *        the total is stored at `tile_counts[ntiles]`
+ *
+ * Launched as a single block.
+ */
+template <typename Label>
+__global__ void ScanTileCountsKernel(Label *tile_counts, int64_t ntiles) {
+  __shared__ Label partial[kScanBlockSize];
+  int64_t chunk = div_ceil(ntiles, static_cast<uint64_t>(blockDim.x));
+  int64_t start = cuda_min<int64_t>(ntiles, threadIdx.x * chunk);
+  int64_t end = cuda_min<int64_t>(ntiles, start + chunk);
+  Label sum = 0;
+  for (int64_t i = start; i < end; i++)
+    sum += tile_counts[i];
+  partial[threadIdx.x] = sum;
+  __syncthreads();
+  if (threadIdx.x == 0) {
+    Label acc = 0;
+    for (int t = 0; t < static_cast<int>(blockDim.x); t++) {
+      Label s = partial[t];
+      partial[t] = acc;
+      acc += s;
+    }
+    tile_counts[ntiles] = acc;
+  }
+  __syncthreads();
+  Label offset = partial[threadIdx.x];
+  for (int64_t i = start; i < end; i++) {
+    Label c = tile_counts[i];
+    tile_counts[i] = offset;
+    offset += c;
+  }
+}
+
+/**
+ * @brief Assigns consecutive region indices to the roots, in the order of their flat indices
+ *
+ * The index is stored in the root entry as `-2 - index`, so it can be told apart from a link.
+ */
+template <typename Label>
+__global__ void AssignIndicesKernel(Label *labels, const Label *tile_offsets, Label volume) {
+  __shared__ Label offsets[kBlockSize];
+  Label tile_start = static_cast<Label>(blockIdx.x) * kTileSize;
+  int tile_len = cuda_min<Label>(kTileSize, volume - tile_start);
+  // each thread processes a contiguous part of the tile, so the roots are ranked in order
+  int part = div_ceil(tile_len, blockDim.x);
+  int start = cuda_min<int>(tile_len, threadIdx.x * part);
+  int end = cuda_min<int>(tile_len, start + part);
+  Label count = 0;
+  for (int i = start; i < end; i++)
+    count += labels[tile_start + i] == tile_start + i;
+  offsets[threadIdx.x] = count;
+  __syncthreads();
+  if (threadIdx.x == 0) {
+    Label acc = tile_offsets[blockIdx.x];
+    for (int t = 0; t < static_cast<int>(blockDim.x); t++) {
+      Label c = offsets[t];
+      offsets[t] = acc;
+      acc += c;
+    }
+  }
+  __syncthreads();
+  Label next = offsets[threadIdx.x];
+  for (int i = start; i < end; i++) {
+    Label idx = tile_start + i;
+    if (labels[idx] == idx)
+      labels[idx] = -2 - next++;
+  }
+}
+
+/**
+ * @brief Replaces the links to the roots with the region indices
+ *
+ * The root entries may be already decoded when they're read by other threads - this is
+ * unambiguous, because an entry known to be a root never contains a link.
+ */
+template <typename Label>
+__global__ void RelabelKernel(Label *labels, Label volume) {
+  for (Label idx = static_cast<Label>(blockIdx.x) * blockDim.x + threadIdx.x; idx < volume;
+       idx += static_cast<Label>(blockDim.x) * gridDim.x) {
+    Label l = labels[idx];
+    if (l == -1)
+      continue;
+    if (l >= 0) {
+      l = labels[l];
+      if (l >= 0) {
+        labels[idx] = l;
+        continue;
+      }
+    }
+    labels[idx] = -2 - l;
+  }
+}
+
+template <typename Value, typename Label, typename T>
+__global__ void RegionValuesKernel(Value *values, const Label *labels, const T *in,
+                                   Label volume) {
+  for (Label idx = static_cast<Label>(blockIdx.x) * blockDim.x + threadIdx.x; idx < volume;
+       idx += static_cast<Label>(blockDim.x) * gridDim.x) {
+    Label l = labels[idx];
+    // all elements of a region have the same value - store it only at the beginning of a run
+    if (l >= 0 && (idx == 0 || labels[idx - 1] != l))
+      values[l] = static_cast<Value>(in[idx]);
+  }
+}
+
+inline int GetElementwiseGridSize(int64_t volume) {
+  return cuda_min<int64_t>(div_ceil(volume, kBlockSize), 1 << 16);
+}
+
+}  // namespace gpu_impl
+
+/**
+ * @brief Returns the number of `Label` elements required by the `tile_counts` argument
+ *        of `LabelConnectedRegionsGPU`
+ */
+inline int64_t GetTileCountsSize(int64_t volume) {
+  return div_ceil(volume, gpu_impl::kTileSize) + 1;
+}
+
+/**
+ * @brief Labels connected components of a single tensor `in` and stores the labels in `labels`
+ *
+ * This function detects connected blobs having the same input label, like the CPU
+ * `LabelConnectedRegions`. The regions are assigned consecutive indices in the order of their
+ * first element (in flattened order), the elements equal to `background` are labeled as -1.
+ *
+ * The labeling is a block-merge union-find: the regions are first found within tiles of
+ * consecutive elements in shared memory and then merged across the tile boundaries with
+ * atomic operations in global memory.
+ *
+ * @tparam Label    signed integer type capable of storing `-1 - volume`
+ *
+ * @param labels      device memory for `volume(shape)` output labels
+ * @param tile_counts device scratch memory for `GetTileCountsSize(volume(shape))` elements;
+ *                    on completion, `tile_counts[GetTileCountsSize(volume(shape)) - 1]`
+ *                    contains the number of regions
+ * @param in          device pointer to the input data
+ * @param shape       shape of the input
+ * @param background  value in the input which denotes background elements
+ */
+template <typename Label, typename T>
+void LabelConnectedRegionsGPU(Label *labels, Label *tile_counts, const T *in,
+                              const TensorShape<> &shape, same_as_t<T> background,
+                              cudaStream_t stream) {
+  static_assert(std::is_signed<Label>::value, "The label type must be signed");
+  using namespace gpu_impl;  // NOLINT
+  auto desc = MakeLabelingDesc<Label>(shape);
+  int64_t ntiles = GetTileCountsSize(desc.volume) - 1;
+  if (ntiles == 0) {
+    CUDA_CALL(cudaMemsetAsync(tile_counts, 0, sizeof(Label), stream));
+    return;
+  }
+  LocalMergeKernel<<<ntiles, kBlockSize, 0, stream>>>(labels, in, desc, background);
+  CUDA_CALL(cudaGetLastError());
+  BoundaryMergeKernel<<<ntiles, kBlockSize, 0, stream>>>(labels, in, desc, background);
+  CUDA_CALL(cudaGetLastError());
+  FlattenKernel<<<ntiles, kBlockSize, 0, stream>>>(labels, tile_counts, desc.volume);
+  CUDA_CALL(cudaGetLastError());
+  ScanTileCountsKernel<<<1, kScanBlockSize, 0, stream>>>(tile_counts, ntiles);
+  CUDA_CALL(cudaGetLastError());
+  AssignIndicesKernel<<<ntiles, kBlockSize, 0, stream>>>(labels, tile_counts, desc.volume);
+  CUDA_CALL(cudaGetLastError());
+  RelabelKernel<<<GetElementwiseGridSize(desc.volume), kBlockSize, 0, stream>>>(
+      labels, desc.volume);
+  CUDA_CALL(cudaGetLastError());
+}
+
+/**
+ * @brief Stores the input value of each region labeled by `LabelConnectedRegionsGPU`
+ *
+ * @param values  device memory for one value per region
+ * @param labels  region labels, as produced by `LabelConnectedRegionsGPU`
+ * @param in      the input that was labeled
+ */
+template <typename Value, typename Label, typename T>
+void GetRegionValuesGPU(Value *values, const Label *labels, const T *in, int64_t volume,
+                        cudaStream_t stream) {
+  using namespace gpu_impl;  // NOLINT
+  if (volume == 0)
+    return;
+  RegionValuesKernel<<<GetElementwiseGridSize(volume), kBlockSize, 0, stream>>>(
+      values, labels, in, static_cast<Label>(volume));
+  CUDA_CALL(cudaGetLastError());
+}
+
+}  // namespace connected_components
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_IMGPROC_STRUCTURE_CONNECTED_COMPONENTS_GPU_CUH_
@@ -0,0 +1,154 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_KERNELS_IMGPROC_STRUCTURE_LABEL_BBOX_GPU_CUH_
+#define DALI_KERNELS_IMGPROC_STRUCTURE_LABEL_BBOX_GPU_CUH_
+
+#include <cuda_runtime.h>
+#include <cstdint>
+#include <stdexcept>
+#include "dali/core/convert.h"
+#include "dali/core/cuda_error.h"
+#include "dali/core/cuda_utils.h"
+#include "dali/core/format.h"
+#include "dali/core/tensor_shape.h"
+#include "dali/core/util.h"
+
+namespace dali {
+namespace kernels {
+namespace label_bbox {
+namespace gpu_impl {
+
+static constexpr int kBlockSize = 256;
+static constexpr int kMaxDims = 6;
+/// @brief Number of consecutive elements of a row processed by one thread
+static constexpr int kRunLength = 16;
+
+struct BoxDesc {
+  int ndim;
+  int shape[kMaxDims];
+  int64_t nrows;
+  int segments_per_row;
+};
+
+template <typename Coord>
+__global__ void InitBoxesKernel(Coord *boxes, int64_t nboxes, int ndim) {
+  int64_t n = nboxes * 2 * ndim;
+  for (int64_t i = static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x; i < n;
+       i += static_cast<int64_t>(blockDim.x) * gridDim.x) {
+    boxes[i] = (i % (2 * ndim)) < ndim ? max_value<Coord>() : 0;
+  }
+}
+
+/**
+ * @brief Extends the box `label` so it contains the run [start, end) along the innermost axis
+ *        of a row at `coords`
+ */
+template <typename Label>
+__device__ void AddRun(int *boxes, Label label, const int *coords, int start, int end,
+                       int ndim) {
+  if (label < 0)
+    return;
+  int *lo = boxes + label * 2 * ndim;
+  int *hi = lo + ndim;
+  for (int d = 0; d < ndim - 1; d++) {
+    atomicMin(lo + d, coords[d]);
+    atomicMax(hi + d, coords[d] + 1);
+  }
+  atomicMin(lo + ndim - 1, start);
+  atomicMax(hi + ndim - 1, end);
+}
+
+/**
+ * @brief Each thread processes `kRunLength` consecutive elements of a row and updates the boxes
+ *        only when the label changes.
+ */
+template <typename Label>
+__global__ void LabelBBoxKernel(int *boxes, const Label *labels, BoxDesc desc) {
+  int ndim = desc.ndim;
+  int inner = desc.shape[ndim - 1];
+  int64_t nwork = desc.nrows * desc.segments_per_row;
+  for (int64_t w = static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x; w < nwork;
+       w += static_cast<int64_t>(blockDim.x) * gridDim.x) {
+    int64_t row = w / desc.segments_per_row;
+    int segment = w - row * desc.segments_per_row;
+    int coords[kMaxDims];
+    int64_t r = row;
+    for (int d = ndim - 2; d >= 0; d--) {
+      int64_t q = r / desc.shape[d];
+      coords[d] = r - q * desc.shape[d];
+      r = q;
+    }
+    int start = segment * kRunLength;
+    int end = cuda_min(inner, start + kRunLength);
+    const Label *row_labels = labels + row * inner;
+    Label curr = row_labels[start];
+    int run_start = start;
+    for (int x = start + 1; x < end; x++) {
+      Label l = row_labels[x];
+      if (l != curr) {
+        AddRun(boxes, curr, coords, run_start, x, ndim);
+        curr = l;
+        run_start = x;
+      }
+    }
+    AddRun(boxes, curr, coords, run_start, end, ndim);
+  }
+}
+
+}  // namespace gpu_impl
+
+/**
+ * @brief Calculates a bounding box for each label in `labels`
+ *
+ * The boxes are stored as `nlabels` consecutive `Box<ndim, int>` objects, i.e. `ndim` start
+ * coordinates followed by `ndim` one-past-end coordinates.
+ *
+ * @param boxes    device memory for `2 * ndim * nlabels` coordinates
+ * @param labels   device pointer to zero-based labels; negative labels denote background
+ * @param shape    shape of the label tensor
+ * @param nlabels  number of labels; each label in range [0, nlabels) must occur at least once
+ */
+template <typename Label>
+void GetLabelBoundingBoxesGPU(int *boxes, const Label *labels, const TensorShape<> &shape,
+                              int64_t nlabels, cudaStream_t stream) {
+  using namespace gpu_impl;  // NOLINT
+  int ndim = shape.sample_dim();
+  if (ndim < 1 || ndim > kMaxDims)
+    throw std::invalid_argument(make_string(
+        "Unsupported number of dimensions: ", ndim, ". Valid range is 1..", kMaxDims, "."));
+  if (nlabels == 0 || volume(shape) == 0)
+    return;
+
+  BoxDesc desc;
+  desc.ndim = ndim;
+  for (int d = 0; d < ndim; d++)
+    desc.shape[d] = shape[d];
+  desc.nrows = volume(shape) / shape[ndim - 1];
+  desc.segments_per_row = div_ceil(desc.shape[ndim - 1], kRunLength);
+
+  int init_grid = cuda_min<int64_t>(div_ceil(nlabels * 2 * ndim, kBlockSize), 1024);
+  InitBoxesKernel<<<init_grid, kBlockSize, 0, stream>>>(boxes, nlabels, ndim);
+  CUDA_CALL(cudaGetLastError());
+  int64_t nwork = desc.nrows * desc.segments_per_row;
+  int grid = cuda_min<int64_t>(div_ceil(nwork, kBlockSize), 1 << 16);
+  LabelBBoxKernel<<<grid, kBlockSize, 0, stream>>>(boxes, labels, desc);
+  CUDA_CALL(cudaGetLastError());
+}
+
+}  // namespace label_bbox
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_IMGPROC_STRUCTURE_LABEL_BBOX_GPU_CUH_
@@ -20,6 +20,7 @@
 #include "dali/kernels/imgproc/warp/warp_setup.cuh"
 #include "dali/kernels/imgproc/warp/mapping_traits.h"
 #include "dali/kernels/imgproc/warp/map_coords.h"
+#include "dali/kernels/imgproc/warp/texture.cuh"
 #include "dali/core/static_switch.h"
 
 namespace dali {
@@ -27,6 +28,43 @@ namespace kernels {
 namespace warp {
 
 
+/**
+ * @brief Warps a block of a 2D sample, reading the input through a texture object
+ */
+template <int static_channels,
+          DALIInterpType interp_type, typename Mapping,
+          typename OutputType, typename InputType,
+          typename BorderType>
+__device__ void BlockWarpTexture(
+    const SampleDesc<2, OutputType, InputType> &sample, BlockDesc<2> block,
+    Mapping mapping, BorderType border) {
+  const int channels = static_channels < 0 ? sample.channels : static_channels;
+  const Surface2D<OutputType> out = {
+      sample.output, sample.out_size, channels,
+      sample.out_strides, 1
+  };
+
+  if (sample.texture.pixel_texels) {
+    // filtering and border handling in hardware
+    for (int y = block.start.y + threadIdx.y; y < block.end.y; y += blockDim.y) {
+      for (int x = block.start.x + threadIdx.x; x < block.end.x; x += blockDim.x) {
+        auto src = map_coords(mapping, ivec2(x, y));
+        FetchPixel(&out(x, y), sample.texture, channels, texture_coords(src));
+      }
+    }
+  } else {
+    const TextureChannelSampler<interp_type, InputType> sampler = {
+      sample.texture.object, sample.in_size, channels
+    };
+    for (int y = block.start.y + threadIdx.y; y < block.end.y; y += blockDim.y) {
+      for (int x = block.start.x + threadIdx.x; x < block.end.x; x += blockDim.x) {
+        auto src = map_coords(mapping, ivec2(x, y));
+        sampler(&out(x, y), src, border);
+      }
+    }
+  }
+}
+
 template <int static_channels,
           DALIInterpType interp_type, typename Mapping,
           typename OutputType, typename InputType,
@@ -34,6 +72,10 @@ template <int static_channels,
 __device__ void BlockWarpChannels(
     SampleDesc<2, OutputType, InputType> sample, BlockDesc<2> block,
     Mapping mapping, BorderType border) {
+  if (UseTexture(sample.texture, mapping, block.start)) {
+    BlockWarpTexture<static_channels, interp_type>(sample, block, mapping, border);
+    return;
+  }
   const int channels = static_channels < 0 ? sample.channels : static_channels;
   // Get the data pointers - un-erase type
   OutputType *__restrict__ output_data = sample.output;
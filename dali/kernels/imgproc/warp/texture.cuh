@@ -0,0 +1,417 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_KERNELS_IMGPROC_WARP_TEXTURE_CUH_
+#define DALI_KERNELS_IMGPROC_WARP_TEXTURE_CUH_
+
+#include <cuda_runtime.h>
+#include <deque>
+#include <exception>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "dali/core/convert.h"
+#include "dali/core/cuda_error.h"
+#include "dali/core/cuda_event.h"
+#include "dali/core/geom/vec.h"
+#include "dali/core/span.h"
+#include "dali/kernels/imgproc/sampler.h"
+#include "dali/kernels/imgproc/warp/map_coords.h"
+#include "dali/kernels/imgproc/warp/warp_setup.cuh"
+
+namespace dali {
+namespace kernels {
+namespace warp {
+
+/**
+ * @brief Inputs smaller than this are always sampled from global memory in `TextureUsage::Auto`
+ *        mode - they fit in the cache anyway.
+ */
+constexpr int64_t kMinTextureInputBytes = 1 << 20;
+
+/**
+ * @brief The displacement of source coordinates, per one output pixel in the x direction,
+ *        above which the texture is used in `TextureUsage::Auto` mode.
+ *
+ * The y component corresponds to rotation (the rows being read change along an output row)
+ * and the x component - to downscaling.
+ */
+constexpr float kTextureMinRowDisplacement = 0.25f;
+constexpr float kTextureMinColumnDisplacement = 2.0f;
+
+/**
+ * @brief Describes how the input type can be bound to a texture
+ */
+template <typename T>
+struct texture_input_traits {
+  /** Can be bound to a texture at all */
+  static constexpr bool supported = false;
+  /** Can be bound as pixel texels, i.e. read with hardware filtering */
+  static constexpr bool pixel_texels = false;
+  static constexpr cudaChannelFormatKind kind = cudaChannelFormatKindNone;
+};
+
+template <>
+struct texture_input_traits<uint8_t> {
+  static constexpr bool supported = true;
+  static constexpr bool pixel_texels = true;
+  static constexpr cudaChannelFormatKind kind = cudaChannelFormatKindUnsigned;
+};
+
+template <>
+struct texture_input_traits<int16_t> {
+  static constexpr bool supported = true;
+  static constexpr bool pixel_texels = false;
+  static constexpr cudaChannelFormatKind kind = cudaChannelFormatKindSigned;
+};
+
+template <>
+struct texture_input_traits<uint16_t> {
+  static constexpr bool supported = true;
+  static constexpr bool pixel_texels = false;
+  static constexpr cudaChannelFormatKind kind = cudaChannelFormatKindUnsigned;
+};
+
+template <>
+struct texture_input_traits<float> {
+  static constexpr bool supported = true;
+  static constexpr bool pixel_texels = true;
+  static constexpr cudaChannelFormatKind kind = cudaChannelFormatKindFloat;
+};
+
+/**
+ * @brief Checks whether the texture address mode can reproduce the border handling
+ */
+inline bool BorderAsAddressMode(BorderClamp, cudaTextureAddressMode &mode) {
+  mode = cudaAddressModeClamp;
+  return true;
+}
+
+template <typename T>
+std::enable_if_t<std::is_arithmetic<T>::value, bool>
+BorderAsAddressMode(const T &value, cudaTextureAddressMode &mode) {
+  // texture reads outside of the texture return zero in this mode
+  mode = cudaAddressModeBorder;
+  return value == 0;
+}
+
+template <typename T>
+std::enable_if_t<!std::is_arithmetic<T>::value, bool>
+BorderAsAddressMode(const T &, cudaTextureAddressMode &) {
+  return false;
+}
+
+/**
+ * @brief Binds the inputs of the warping kernel to texture objects
+ *
+ * The texture objects are released when the kernels which use them are complete.
+ */
+template <typename InputType>
+class WarpTextures {
+ public:
+  WarpTextures() = default;
+
+  ~WarpTextures() {
+    try {
+      while (!pending_.empty())
+        ReleaseOldest(true);
+      Destroy(current_);
+    } catch (const std::exception &e) {
+      std::cerr << "Fatal error: exception in ~WarpTextures():\n" << e.what() << std::endl;
+      std::terminate();
+    }
+  }
+
+  WarpTextures(const WarpTextures &) = delete;
+  WarpTextures &operator=(const WarpTextures &) = delete;
+
+  /**
+   * @brief Binds the eligible inputs to texture objects and stores them in the sample descriptors
+   */
+  template <int spatial_ndim, typename OutputType, typename BorderType>
+  void Bind(span<SampleDesc<spatial_ndim, OutputType, InputType>> samples,
+            TextureUsage usage, const BorderType &border) {
+    ReleaseCompleted();
+    if (usage == TextureUsage::Never)
+      return;
+    for (auto &sample : samples)
+      BindSample(sample, usage, border);
+  }
+
+  /**
+   * @brief Marks the textures bound since the last call as used by the work in the `stream`
+   */
+  void Record(cudaStream_t stream) {
+    if (current_.empty())
+      return;
+    Generation gen;
+    gen.objects = std::move(current_);
+    current_.clear();
+    gen.done = CUDAEvent::Create();
+    CUDA_CALL(cudaEventRecord(gen.done, stream));
+    pending_.push_back(std::move(gen));
+  }
+
+ private:
+  struct Generation {
+    std::vector<cudaTextureObject_t> objects;
+    CUDAEvent done;
+  };
+
+  /** @brief Above this number of pending generations, the host waits for the oldest one */
+  static constexpr int kMaxPendingGenerations = 4;
+
+  template <typename OutputType, typename BorderType>
+  void BindSample(SampleDesc<3, OutputType, InputType> &, TextureUsage, const BorderType &) {}
+
+  template <typename OutputType, typename BorderType>
+  void BindSample(SampleDesc<2, OutputType, InputType> &sample, TextureUsage usage,
+                  const BorderType &border) {
+    using traits = texture_input_traits<InputType>;
+    if (!traits::supported)
+      return;
+    if (sample.interp != DALI_INTERP_NN && sample.interp != DALI_INTERP_LINEAR)
+      return;
+
+    int C = sample.channels;
+    int64_t pitch = sample.in_strides.y * sizeof(InputType);
+    if (usage == TextureUsage::Auto && pitch * sample.in_size.y < kMinTextureInputBytes)
+      return;
+
+    InitLimits();
+    if (reinterpret_cast<uintptr_t>(sample.input) % texture_alignment_ != 0 ||
+        pitch % pitch_alignment_ != 0 || pitch > max_pitch_ ||
+        sample.in_size.y > max_height_ || sample.in_size.y <= 0)
+      return;
+
+    cudaTextureAddressMode address_mode = cudaAddressModeClamp;
+    bool pixel_texels = traits::pixel_texels && (C == 1 || C == 2 || C == 4) &&
+                        BorderAsAddressMode(border, address_mode);
+    int width = pixel_texels ? sample.in_size.x : sample.in_size.x * C;
+    if (width > max_width_ || width <= 0)
+      return;
+
+    int bits = sizeof(InputType) * 8;
+    cudaResourceDesc res_desc = {};
+    res_desc.resType = cudaResourceTypePitch2D;
+    res_desc.res.pitch2D.devPtr = const_cast<InputType *>(sample.input);
+    res_desc.res.pitch2D.width = width;
+    res_desc.res.pitch2D.height = sample.in_size.y;
+    res_desc.res.pitch2D.pitchInBytes = pitch;
+    if (pixel_texels) {
+      res_desc.res.pitch2D.desc = cudaCreateChannelDesc(
+          bits, C > 1 ? bits : 0, C > 2 ? bits : 0, C > 3 ? bits : 0, traits::kind);
+    } else {
+      // channel texels; the border is handled in software
+      res_desc.res.pitch2D.desc = cudaCreateChannelDesc(bits, 0, 0, 0, traits::kind);
+      address_mode = cudaAddressModeClamp;
+    }
+
+    bool normalized = pixel_texels && !std::is_floating_point<InputType>::value;
+    cudaTextureDesc tex_desc = {};
+    tex_desc.addressMode[0] = address_mode;
+    tex_desc.addressMode[1] = address_mode;
+    tex_desc.filterMode = pixel_texels && sample.interp == DALI_INTERP_LINEAR
+                        ? cudaFilterModeLinear : cudaFilterModePoint;
+    tex_desc.readMode = normalized ? cudaReadModeNormalizedFloat : cudaReadModeElementType;
+    tex_desc.normalizedCoords = 0;
+
+    cudaTextureObject_t object = 0;
+    CUDA_CALL(cudaCreateTextureObject(&object, &res_desc, &tex_desc, nullptr));
+    current_.push_back(object);
+
+    sample.texture.object = object;
+    sample.texture.pixel_texels = pixel_texels;
+    sample.texture.scale = normalized ? max_value<InputType>() : 1.0f;
+    sample.texture.usage = usage;
+  }
+
+  void InitLimits() {
+    int device_id;
+    CUDA_CALL(cudaGetDevice(&device_id));
+    if (device_id == device_id_)
+      return;
+    int align = 0, pitch_align = 0;
+    CUDA_CALL(cudaDeviceGetAttribute(&align, cudaDevAttrTextureAlignment, device_id));
+    CUDA_CALL(cudaDeviceGetAttribute(&pitch_align, cudaDevAttrTexturePitchAlignment, device_id));
+    CUDA_CALL(cudaDeviceGetAttribute(&max_width_, cudaDevAttrMaxTexture2DLinearWidth,
+                                     device_id));
+    CUDA_CALL(cudaDeviceGetAttribute(&max_height_, cudaDevAttrMaxTexture2DLinearHeight,
+                                     device_id));
+    CUDA_CALL(cudaDeviceGetAttribute(&max_pitch_, cudaDevAttrMaxTexture2DLinearPitch,
+                                     device_id));
+    texture_alignment_ = align;
+    pitch_alignment_ = pitch_align;
+    device_id_ = device_id;
+  }
+
+  void ReleaseCompleted() {
+    while (!pending_.empty()) {
+      bool wait = pending_.size() > kMaxPendingGenerations;
+      if (!wait) {
+        cudaError_t status = cudaEventQuery(pending_.front().done);
+        if (status == cudaErrorNotReady)
+          break;
+        CUDA_CALL(status);
+      }
+      ReleaseOldest(wait);
+    }
+  }
+
+  void ReleaseOldest(bool wait) {
+    auto &gen = pending_.front();
+    if (wait)
+      CUDA_CALL(cudaEventSynchronize(gen.done));
+    Destroy(gen.objects);
+    pending_.pop_front();
+  }
+
+  static void Destroy(std::vector<cudaTextureObject_t> &objects) {
+    for (auto object : objects)
+      CUDA_CALL(cudaDestroyTextureObject(object));
+    objects.clear();
+  }
+
+  /// textures bound since the last call to Record
+  std::vector<cudaTextureObject_t> current_;
+  /// textures which may still be in use by the GPU
+  std::deque<Generation> pending_;
+
+  int device_id_ = -1;
+  int64_t texture_alignment_ = 1, pitch_alignment_ = 1;
+  int max_width_ = 0, max_height_ = 0, max_pitch_ = 0;
+};
+
+/**
+ * @brief Decides whether the block should sample the input from the texture
+ *
+ * In `Auto` mode, the texture is used when the source coordinates move quickly across
+ * the input rows (rotation) or skip many columns (downscaling), along the output row.
+ */
+template <typename Mapping>
+__device__ bool UseTexture(const SampleTexture &texture, const Mapping &mapping, ivec2 pos) {
+  if (!texture.object)
+    return false;
+  if (texture.usage == TextureUsage::Always)
+    return true;
+  auto a = map_coords(mapping, pos);
+  auto b = map_coords(mapping, ivec2(pos.x + 1, pos.y));
+  float dx = b.x - a.x, dy = b.y - a.y;
+  return fabsf(dy) > kTextureMinRowDisplacement || fabsf(dx) > kTextureMinColumnDisplacement;
+}
+
+/** @brief Converts the source coordinates to texture coordinates, with pixel centers at +0.5 */
+__device__ DALI_FORCEINLINE vec2 texture_coords(vec2 pos) {
+  return pos;
+}
+
+__device__ DALI_FORCEINLINE vec2 texture_coords(ivec2 pos) {
+  return vec2(pos.x + 0.5f, pos.y + 0.5f);
+}
+
+/**
+ * @brief Reads a pixel from a texture with pixel texels - the filtering and the border
+ *        handling are done by the hardware.
+ */
+template <typename OutputType>
+__device__ void FetchPixel(OutputType *out_pixel, const SampleTexture &texture, int channels,
+                           vec2 pos) {
+  float scale = texture.scale;
+  switch (channels) {
+    case 1: {
+      float v = tex2D<float>(texture.object, pos.x, pos.y);
+      out_pixel[0] = ConvertSat<OutputType>(v * scale);
+      break;
+    }
+    case 2: {
+      float2 v = tex2D<float2>(texture.object, pos.x, pos.y);
+      out_pixel[0] = ConvertSat<OutputType>(v.x * scale);
+      out_pixel[1] = ConvertSat<OutputType>(v.y * scale);
+      break;
+    }
+    default: {
+      float4 v = tex2D<float4>(texture.object, pos.x, pos.y);
+      out_pixel[0] = ConvertSat<OutputType>(v.x * scale);
+      out_pixel[1] = ConvertSat<OutputType>(v.y * scale);
+      out_pixel[2] = ConvertSat<OutputType>(v.z * scale);
+      out_pixel[3] = ConvertSat<OutputType>(v.w * scale);
+      break;
+    }
+  }
+}
+
+/**
+ * @brief Samples a texture with channel texels; the filtering and the border handling
+ *        replicate the ones in `Sampler`.
+ */
+template <DALIInterpType interp, typename In>
+struct TextureChannelSampler {
+  cudaTextureObject_t texture;
+  ivec2 size;
+  int channels;
+
+  __device__ DALI_FORCEINLINE In fetch(ivec2 pos, int c) const {
+    return tex2D<In>(texture, pos.x * channels + c + 0.5f, pos.y + 0.5f);
+  }
+
+  template <typename T, typename BorderValue>
+  __device__ DALI_FORCEINLINE T at(ivec2 pos, int c, BorderValue border_value) const {
+    if (all_in_range(pos, size))
+      return ConvertSat<T>(fetch(pos, c));
+    else
+      return ConvertSat<T>(GetBorderChannel(border_value, c));
+  }
+
+  template <typename T>
+  __device__ DALI_FORCEINLINE T at(ivec2 pos, int c, BorderClamp) const {
+    return ConvertSat<T>(fetch(clamp(pos, ivec2(0), size - 1), c));
+  }
+
+  template <typename T, typename BorderValue>
+  __device__ void operator()(T *out_pixel, ivec2 pos, BorderValue border_value) const {
+    for (int c = 0; c < channels; c++)
+      out_pixel[c] = at<T>(pos, c, border_value);
+  }
+
+  template <typename T, typename BorderValue>
+  __device__ void operator()(T *out_pixel, vec2 pos, BorderValue border_value) const {
+    if (interp == DALI_INTERP_NN) {
+      operator()(out_pixel, floor_int(pos), border_value);
+      return;
+    }
+    float x = pos.x - 0.5f;
+    float y = pos.y - 0.5f;
+    int x0 = floor_int(x);
+    int y0 = floor_int(y);
+    float qx = x - x0;
+    float px = 1 - qx;
+    float qy = y - y0;
+    for (int c = 0; c < channels; c++) {
+      In s00 = at<In>(ivec2(x0,   y0),   c, border_value);
+      In s01 = at<In>(ivec2(x0+1, y0),   c, border_value);
+      In s10 = at<In>(ivec2(x0,   y0+1), c, border_value);
+      In s11 = at<In>(ivec2(x0+1, y0+1), c, border_value);
+      float s0 = s00 * px + s01 * qx;
+      float s1 = s10 * px + s11 * qx;
+      out_pixel[c] = ConvertSat<T>(s0 + (s1 - s0) * qy);
+    }
+  }
+};
+
+}  // namespace warp
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_IMGPROC_WARP_TEXTURE_CUH_
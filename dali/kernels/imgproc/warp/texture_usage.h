@@ -0,0 +1,40 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_KERNELS_IMGPROC_WARP_TEXTURE_USAGE_H_
+#define DALI_KERNELS_IMGPROC_WARP_TEXTURE_USAGE_H_
+
+#include <cstdint>
+
+namespace dali {
+namespace kernels {
+namespace warp {
+
+/**
+ * @brief Decides when the input is sampled through a texture object instead of global memory
+ */
+enum class TextureUsage : uint8_t {
+  /** The texture is used when the mapping has large rotation or downscaling */
+  Auto,
+  /** The input is always sampled from global memory */
+  Never,
+  /** The texture is used for all samples which can be bound to a texture */
+  Always
+};
+
+}  // namespace warp
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_IMGPROC_WARP_TEXTURE_USAGE_H_
@@ -15,10 +15,12 @@
 #ifndef DALI_KERNELS_IMGPROC_WARP_WARP_SETUP_CUH_
 #define DALI_KERNELS_IMGPROC_WARP_WARP_SETUP_CUH_
 
+#include <cuda_runtime.h>
 #include <vector>
 #include <utility>
 #include "dali/kernels/kernel.h"
 #include "dali/kernels/common/block_setup.h"
+#include "dali/kernels/imgproc/warp/texture_usage.h"
 #include "dali/core/geom/vec.h"
 
 namespace dali {
@@ -27,6 +29,22 @@ namespace kernels {
 /** @brief Contains implementation of warping kernels */
 namespace warp {
 
+/**
+ * @brief Describes how the input of a sample is bound to a texture object
+ */
+struct SampleTexture {
+  /** The texture object or 0, if the sample is read from global memory */
+  cudaTextureObject_t object;
+  /**
+   * If true, the texels are whole pixels and filtered by hardware;
+   * otherwise, the texels are channel values, sampled at points.
+   */
+  bool pixel_texels;
+  /** The value by which the texture reads are multiplied (for normalized reads) */
+  float scale;
+  TextureUsage usage;
+};
+
 template <int spatial_ndim, typename OutputType, typename InputType>
 struct SampleDesc {
   OutputType *__restrict__ output;
@@ -35,6 +53,7 @@ struct SampleDesc {
   i64vec<spatial_ndim> out_strides, in_strides;
   int channels;
   DALIInterpType interp;
+  SampleTexture texture;
 };
 
 /**
@@ -97,10 +116,12 @@ class WarpSetup : public BlockSetup<spatial_ndim, spatial_ndim> {
       }
 
       sample.interp = interp[interp.size() == 1 ? 0 : i];
+      sample.texture = {};
     }
   }
 
   span<const SampleDesc> Samples() const { return make_span(samples_); }
+  span<SampleDesc> Samples() { return make_span(samples_); }
 
  private:
   std::vector<SampleDesc> samples_;
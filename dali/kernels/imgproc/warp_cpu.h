@@ -16,12 +16,17 @@
 #define DALI_KERNELS_IMGPROC_WARP_CPU_H_
 
 #include <algorithm>
+#include <vector>
 #include "dali/core/common.h"
+#include "dali/core/exec/engine.h"
+#include "dali/core/util.h"
 #include "dali/core/geom/vec.h"
 #include "dali/core/geom/transform.h"
 #include "dali/core/static_switch.h"
 #include "dali/kernels/kernel.h"
+#include "dali/kernels/common/simd.h"
 #include "dali/kernels/imgproc/warp/mapping_traits.h"
+#include "dali/kernels/imgproc/row_sampler_cpu.h"
 #include "dali/kernels/imgproc/sampler.h"
 #include "dali/kernels/imgproc/warp/map_coords.h"
 #include "dali/kernels/imgproc/warp/affine.h"
@@ -29,6 +34,9 @@
 namespace dali {
 namespace kernels {
 
+/// The minimum number of output elements in a block of rows scheduled as a separate job
+constexpr int64_t kWarpMinBlockSize = 16 << 10;
+
 /**
  * @brief Performs generic warping of one tensor (on CPU)
  *
@@ -77,33 +85,117 @@ class WarpCPU {
       const TensorShape<spatial_ndim> &out_size,
       DALIInterpType interp = DALI_INTERP_LINEAR,
       const BorderType &border = {}) {
-    Mapping mapping(mapping_params);
+    assert(output.shape == shape_cat(out_size, input.shape[channel_dim]));
+    RunRows(output, input, mapping_params, interp, border, 0, NumRows(output.shape));
+  }
 
+  /**
+   * @brief Schedules the warping of the tensor with an execution engine.
+   *
+   * The output is split into blocks of rows (for volumes, the depth and height are flattened),
+   * each of them processed as a separate job, so that a large tensor can be warped by multiple
+   * threads. The work does not start until the user calls RunAll() on the execution engine
+   * and the kernel object, as well as the tensors, must outlive it.
+   *
+   * @param min_blk_sz  Minimum number of output elements in a block
+   * @param req_nblocks Requested number of blocks. By default it's ``num_threads * 8``
+   */
+  template <typename ExecutionEngine>
+  void Schedule(
+      KernelContext &context,
+      const OutTensorCPU<OutputType, tensor_ndim> &output,
+      const InTensorCPU<InputType, tensor_ndim> &input,
+      const MappingParams &mapping_params,
+      const TensorShape<spatial_ndim> &out_size,
+      DALIInterpType interp,
+      const BorderType &border,
+      ExecutionEngine &exec_engine,
+      int64_t min_blk_sz = kWarpMinBlockSize,
+      int req_nblocks = -1) {
     assert(output.shape == shape_cat(out_size, input.shape[channel_dim]));
+    if (req_nblocks < 0)
+      req_nblocks = exec_engine.NumThreads() * 8;
+    int64_t rows = NumRows(output.shape);
+    int64_t total = volume(output.shape);
+    int64_t nblocks = std::min<int64_t>({ req_nblocks, div_ceil(total, min_blk_sz), rows });
+    nblocks = std::max<int64_t>(nblocks, 1);
+    for (int64_t b = 0; b < nblocks; b++) {
+      int64_t row_begin = rows * b / nblocks;
+      int64_t row_end = rows * (b + 1) / nblocks;
+      exec_engine.AddWork([=](int) {
+        RunRows(output, input, mapping_params, interp, border, row_begin, row_end);
+      }, total * (row_end - row_begin) / rows, false);  // do not start work immediately
+    }
+  }
 
+  /**
+   * @brief Specialization for SequentialExecutionEngine - the tensor is processed as a whole
+   */
+  void Schedule(
+      KernelContext &context,
+      const OutTensorCPU<OutputType, tensor_ndim> &output,
+      const InTensorCPU<InputType, tensor_ndim> &input,
+      const MappingParams &mapping_params,
+      const TensorShape<spatial_ndim> &out_size,
+      DALIInterpType interp,
+      const BorderType &border,
+      SequentialExecutionEngine &,
+      int64_t = kWarpMinBlockSize,
+      int = -1) {
+    Run(context, output, input, mapping_params, out_size, interp, border);
+  }
+
+ private:
+#ifdef DALI_SIMD_HAS_F32X4
+  static constexpr bool kUseSimd = simd::is_simd_storage<InputType>::value &&
+                                   simd::is_simd_storage<OutputType>::value;
+#else
+  static constexpr bool kUseSimd = false;
+#endif
+
+  /// Whether the rows of the 2D output are sampled with LinearRowSampler2D
+  template <DALIInterpType static_interp, typename Mapping_>
+  static constexpr bool UseRowSampler() {
+    return kUseSimd && static_interp == DALI_INTERP_LINEAR && warp::is_fp_mapping<Mapping_>::value;
+  }
+
+  /// The number of rows - the product of all the output extents except the width and channels
+  static int64_t NumRows(const TensorShape<tensor_ndim> &shape) {
+    return volume(shape.begin(), shape.end() - 2);
+  }
+
+  void RunRows(
+      const OutTensorCPU<OutputType, tensor_ndim> &output,
+      const InTensorCPU<InputType, tensor_ndim> &input,
+      const MappingParams &mapping_params,
+      DALIInterpType interp,
+      const BorderType &border,
+      int64_t row_begin, int64_t row_end) {
+    Mapping mapping(mapping_params);
     VALUE_SWITCH(interp, static_interp, (DALI_INTERP_NN, DALI_INTERP_LINEAR),
-      (RunImpl<static_interp>(context, output, input, mapping, border);),
+      (RunImpl<static_interp>(output, input, mapping, border, row_begin, row_end);),
       (DALI_FAIL("Unsupported interpolation type"))
     ); // NOLINT
   }
 
- private:
   template <DALIInterpType static_interp, typename Mapping_>
   void RunImpl(
-      KernelContext &context,
       const OutTensorCPU<OutputType, 3> &output,
       const InTensorCPU<InputType, 3> &input,
       Mapping_ &mapping,
-      BorderType border = {}) {
+      BorderType border,
+      int64_t row_begin, int64_t row_end) {
+    if (RunRowsSimd<static_interp>(output, input, mapping, border, row_begin, row_end))
+      return;
+
     int out_w = output.shape[1];
-    int out_h = output.shape[0];
     int c     = output.shape[2];
 
     Surface2D<const InputType> in = as_surface_channel_last(input);
 
     Sampler2D<static_interp, InputType> sampler(in);
 
-    for (int y = 0; y < out_h; y++) {
+    for (int y = row_begin; y < row_end; y++) {
       OutputType *out_row = output(y, 0);
       for (int x = 0; x < out_w; x++) {
         auto src = warp::map_coords(mapping, ivec2(x, y));
@@ -114,27 +206,26 @@ class WarpCPU {
 
   template <DALIInterpType static_interp, typename Mapping_>
   void RunImpl(
-      KernelContext &context,
       const OutTensorCPU<OutputType, 4> &output,
       const InTensorCPU<InputType, 4> &input,
       Mapping_ &mapping,
-      BorderType border = {}) {
+      BorderType border,
+      int64_t row_begin, int64_t row_end) {
     int out_w = output.shape[2];
     int out_h = output.shape[1];
-    int out_d = output.shape[0];
     int c     = output.shape[3];
 
     Surface2D<const InputType> in = as_surface_channel_last(input);
 
     Sampler2D<static_interp, InputType> sampler(in);
 
-    for (int z = 0; z < out_d; z++) {
-      for (int y = 0; y < out_h; y++) {
-        OutputType *out_row = output(z, y, 0);
-        for (int x = 0; x < out_w; x++) {
-          auto src = warp::map_coords(mapping, ivec3(x, y, z));
-          sampler(&out_row[c*x], src, border);
-        }
+    for (int64_t row = row_begin; row < row_end; row++) {
+      int z = row / out_h;
+      int y = row % out_h;
+      OutputType *out_row = output(z, y, 0);
+      for (int x = 0; x < out_w; x++) {
+        auto src = warp::map_coords(mapping, ivec3(x, y, z));
+        sampler(&out_row[c*x], src, border);
       }
     }
   }
@@ -142,13 +233,15 @@ class WarpCPU {
 
   template <DALIInterpType static_interp>
   void RunImpl(
-      KernelContext &context,
       const OutTensorCPU<OutputType, 3> &output,
       const InTensorCPU<InputType, 3> &input,
       AffineMapping<2> &mapping,
-      BorderType border = {}) {
+      BorderType border,
+      int64_t row_begin, int64_t row_end) {
+    if (RunRowsSimd<static_interp>(output, input, mapping, border, row_begin, row_end))
+      return;
+
     int out_w = output.shape[1];
-    int out_h = output.shape[0];
     int c     = output.shape[2];
 
     Surface2D<const InputType> in = as_surface_channel_last(input);
@@ -164,7 +257,7 @@ class WarpCPU {
     constexpr int tile_w = 256;
     vec2 dsdx_tile = tile_w * dsdx;
 
-    for (int y = 0; y < out_h; y++) {
+    for (int y = row_begin; y < row_end; y++) {
       OutputType *out_row = output(y, 0);
       auto src_tile = warp::map_coords(mapping, ivec2(0, y));
       for (int x_tile = 0; x_tile < out_w; x_tile += tile_w, src_tile += dsdx_tile) {
@@ -180,14 +273,13 @@ class WarpCPU {
 
   template <DALIInterpType static_interp>
   void RunImpl(
-      KernelContext &context,
       const OutTensorCPU<OutputType, 4> &output,
       const InTensorCPU<InputType, 4> &input,
       AffineMapping<3> &mapping,
-      BorderType border = {}) {
+      BorderType border,
+      int64_t row_begin, int64_t row_end) {
     int out_w = output.shape[2];
     int out_h = output.shape[1];
-    int out_d = output.shape[0];
     int c     = output.shape[3];
 
     Surface3D<const InputType> in = as_surface_channel_last(input);
@@ -203,20 +295,84 @@ class WarpCPU {
     constexpr int tile_w = 256;
     vec3 dsdx_tile = tile_w * dsdx;
 
-    for (int z = 0; z < out_d; z++) {
-      for (int y = 0; y < out_h; y++) {
-        OutputType *out_row = output(z, y, 0);
-        auto src_tile = warp::map_coords(mapping, ivec3(0, y, z));
-        for (int x_tile = 0; x_tile < out_w; x_tile += tile_w, src_tile += dsdx_tile) {
-          int x_tile_end = std::min(x_tile + tile_w, out_w);
-          auto src = src_tile;
-          for (int x = x_tile; x < x_tile_end; x++, src += dsdx) {
-            sampler(&out_row[c*x], src, border);
-          }
+    for (int64_t row = row_begin; row < row_end; row++) {
+      int z = row / out_h;
+      int y = row % out_h;
+      OutputType *out_row = output(z, y, 0);
+      auto src_tile = warp::map_coords(mapping, ivec3(0, y, z));
+      for (int x_tile = 0; x_tile < out_w; x_tile += tile_w, src_tile += dsdx_tile) {
+        int x_tile_end = std::min(x_tile + tile_w, out_w);
+        auto src = src_tile;
+        for (int x = x_tile; x < x_tile_end; x++, src += dsdx) {
+          sampler(&out_row[c*x], src, border);
         }
       }
     }
   }
+
+  /**
+   * @brief Warps the rows of a 2D output with bilinear interpolation, vectorized
+   *
+   * The source coordinates of a row are calculated first, then the pixels are sampled with
+   * LinearRowSampler2D; the pixels at the end of the row, which don't fill a whole block,
+   * are sampled with the scalar sampler.
+   *
+   * @return true, if the rows have been processed; otherwise the scalar code must be used
+   */
+  template <DALIInterpType static_interp, typename Mapping_>
+  std::enable_if_t<UseRowSampler<static_interp, Mapping_>(), bool> RunRowsSimd(
+      const OutTensorCPU<OutputType, 3> &output,
+      const InTensorCPU<InputType, 3> &input,
+      const Mapping_ &mapping,
+      BorderType border,
+      int64_t row_begin, int64_t row_end) {
+#ifdef DALI_SIMD_HAS_F32X4
+    int out_w = output.shape[1];
+    int c     = output.shape[2];
+
+    Surface2D<const InputType> in = as_surface_channel_last(input);
+
+    LinearRowSampler2D<InputType> row_sampler(in);
+    Sampler2D<DALI_INTERP_LINEAR, InputType> sampler(in);
+
+    std::vector<float> xs(out_w), ys(out_w);
+    for (int y = row_begin; y < row_end; y++) {
+      OutputType *out_row = output(y, 0);
+      RowCoords(xs.data(), ys.data(), out_w, mapping, y);
+      int x = row_sampler(out_row, xs.data(), ys.data(), out_w, border);
+      for (OutputType *out_pixel = out_row + c*x; x < out_w; x++, out_pixel += c)
+        sampler(out_pixel, vec2(xs[x], ys[x]), border);
+    }
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  template <DALIInterpType static_interp, typename Mapping_>
+  std::enable_if_t<!UseRowSampler<static_interp, Mapping_>(), bool> RunRowsSimd(
+      const OutTensorCPU<OutputType, 3> &, const InTensorCPU<InputType, 3> &,
+      const Mapping_ &, BorderType, int64_t, int64_t) {
+    return false;
+  }
+
+#ifdef DALI_SIMD_HAS_F32X4
+  /// Calculates the source coordinates of the row `y` of a 2D output
+  template <typename Mapping_>
+  static void RowCoords(float *xs, float *ys, int out_w, const Mapping_ &mapping, int y) {
+    for (int x = 0; x < out_w; x++) {
+      vec2 src = warp::map_coords(mapping, ivec2(x, y));
+      xs[x] = src.x;
+      ys[x] = src.y;
+    }
+  }
+
+  /// Calculates the source coordinates of the row `y` of a 2D output - affine mapping
+  static void RowCoords(float *xs, float *ys, int out_w, const AffineMapping<2> &mapping, int y) {
+    AffineRowCoords(xs, ys, out_w, warp::map_coords(mapping, ivec2(0, y)),
+                    mapping.transform.col(0));
+  }
+#endif
 };
 
 }  // namespace kernels
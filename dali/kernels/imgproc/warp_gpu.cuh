@@ -15,13 +15,16 @@
 #ifndef DALI_KERNELS_IMGPROC_WARP_GPU_CUH_
 #define DALI_KERNELS_IMGPROC_WARP_GPU_CUH_
 
+#include <string>
 #include "dali/core/common.h"
 #include "dali/core/geom/vec.h"
 #include "dali/kernels/kernel.h"
+#include "dali/kernels/common/launch_tuner.h"
 #include "dali/kernels/imgproc/warp/warp_setup.cuh"
 #include "dali/kernels/imgproc/warp/warp_variable_size_impl.cuh"
 #include "dali/kernels/imgproc/warp/warp_uniform_size_impl.cuh"
 #include "dali/kernels/imgproc/warp/mapping_traits.h"
+#include "dali/kernels/imgproc/warp/texture.cuh"
 
 namespace dali {
 namespace kernels {
@@ -36,6 +39,11 @@ namespace kernels {
  *  * Assumes HWC layout
  *  * Output and input have same number of spatial dimenions
  *  * Output and input have same number of channels and layout
+ *
+ * 2D inputs can be sampled through texture objects, which is beneficial for large images
+ * warped with large rotation or downscaling - see SetTextureUsage.
+ *
+ * The CUDA block size is chosen by LaunchTuner from CandidateBlockDim, if the tuning is enabled.
  */
 template <typename _Mapping, int _spatial_ndim, typename _OutputType, typename _InputType,
           typename _BorderType>
@@ -57,6 +65,14 @@ class WarpGPU {
   using BlockDesc = typename WarpSetup::BlockDesc;
   static_assert(spatial_ndim == 2 || spatial_ndim == 3, "WarpGPU only works for 2D and 3D data");
 
+  static constexpr int kNumBlockDims = 4;
+
+  /// The candidate CUDA block sizes; the first one is the default
+  static dim3 CandidateBlockDim(int idx) {
+    const int dims[kNumBlockDims][2] = { { 32, 8 }, { 32, 4 }, { 32, 16 }, { 64, 4 } };
+    return dim3(dims[idx][0], dims[idx][1], 1);
+  }
+
   KernelRequirements Setup(KernelContext &context,
                            const InListGPU<InputType, tensor_ndim> &in,
                            const InTensorGPU<MappingParams, 1> &mapping,
@@ -64,7 +80,8 @@ class WarpGPU {
                            span<const DALIInterpType> interp,
                            BorderType border = {}) {
     assert(in.size() == output_sizes.size());
-    setup.SetBlockDim(dim3(32, 8, 1));
+    block_dim_idx_ = LaunchTuner::Get().Choose(TuningKey(), kNumBlockDims);
+    setup.SetBlockDim(CandidateBlockDim(block_dim_idx_));
     auto out_shapes = setup.GetOutputShape(in.shape, output_sizes);
     return setup.Setup(out_shapes);
   }
@@ -78,11 +95,14 @@ class WarpGPU {
            BorderType border = {}) {
     setup.ValidateOutputShape(out.shape, in.shape, output_sizes);
     setup.PrepareSamples(out, in, interp);
+    textures_.Bind(setup.Samples(), texture_usage_, border);
     SampleDesc *gpu_samples;
     BlockDesc *gpu_blocks;
 
     dim3 grid_dim  = setup.GridDim();
     dim3 block_dim = setup.BlockDim();
+    auto timer = LaunchTuner::Get().Time(TuningKey(), block_dim_idx_, out.shape.num_elements(),
+                                         context.gpu.stream);
 
     if (setup.IsUniformSize()) {
       gpu_samples = context.scratchpad->ToGPU(context.gpu.stream, setup.Samples());
@@ -120,10 +140,31 @@ class WarpGPU {
           border);
       CUDA_CALL(cudaGetLastError());
     }
+    timer.Stop();
+    textures_.Record(context.gpu.stream);
+  }
+
+  /**
+   * @brief Sets when the input is sampled through a texture object instead of global memory
+   *
+   * By default (`Auto`), the texture is used for large inputs when the mapping has large
+   * rotation or downscaling. Inputs which can't be bound to a texture (e.g. misaligned ones)
+   * are always read from global memory.
+   */
+  void SetTextureUsage(warp::TextureUsage usage) {
+    texture_usage_ = usage;
   }
 
  private:
+  static std::string TuningKey() {
+    return make_string("WarpGPU_", spatial_ndim, "D_", sizeof(OutputType), "_",
+                       sizeof(InputType));
+  }
+
   WarpSetup setup;
+  int block_dim_idx_ = 0;
+  warp::WarpTextures<InputType> textures_;
+  warp::TextureUsage texture_usage_ = warp::TextureUsage::Auto;
   friend class WarpPrivateTest;
 };
 
@@ -15,6 +15,8 @@
 #ifndef DALI_KERNELS_IMGPROC_WARP_GPU_H_
 #define DALI_KERNELS_IMGPROC_WARP_GPU_H_
 
+#include "dali/kernels/imgproc/warp/texture_usage.h"
+
 #ifdef __CUDACC__
 #include "dali/kernels/imgproc/warp_gpu.cuh"
 #else
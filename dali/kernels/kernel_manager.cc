@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "dali/kernels/kernel_manager.h"
+#include "dali/kernels/scratch_arena.h"
 
 namespace dali {
 namespace kernels {
@@ -33,13 +34,21 @@ auto KernelManager::ReserveScratchpad(
     ScratchpadAllocator &sa,
     const ScratchSizes &sizes)->decltype(sa.GetScratchpad()) {
   auto caps = sa.Capacities();
+  // the graphs refer to the scratch memory by address, so it can't be shared while capturing
+  auto *arena = ScratchpadCapture::Current() ? nullptr : ScratchArena::Current();
+  const size_t device = static_cast<size_t>(mm::memory_kind_id::device);
 
   for (size_t i = 0; i < sizes.size(); i++) {
     atomic_max(max_scratch_sizes[i], sizes[i]);
+    if (arena && i == device)
+      continue;
     if (sizes[i] > caps[i])
       sa.Reserve(static_cast<mm::memory_kind_id>(i), max_scratch_sizes[i]);
   }
-  return sa.GetScratchpad();
+  auto scratchpad = sa.GetScratchpad();
+  if (arena)
+    scratchpad.allocs[device] = { arena->Allocate(sizes[device]), sizes[device] };
+  return scratchpad;
 }
 
 }  // namespace kernels
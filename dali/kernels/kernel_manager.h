@@ -82,7 +82,8 @@ struct AnyKernelInstance {
  * by kernel's Setup method.
  *
  * A scratchpad allocator is created per-thread with thread indexing supported
- * explicitly by the caller.
+ * explicitly by the caller. Within a ScratchArena::Scope, the device scratch memory is taken
+ * from the arena instead.
  */
 class DLL_PUBLIC KernelManager {
  public:
@@ -261,6 +262,8 @@ class DLL_PUBLIC KernelManager {
    * The manager maintains a lifetime maximum of sizes requested.
    * If reallocation is necessary, it allocates `sizes` or that maximum
    * whichever is larger.
+   * Within a ScratchArena::Scope, the device memory is allocated from the arena instead,
+   * and is valid until the scope ends.
    */
   auto ReserveScratchpad(ScratchpadAllocator &sa, const ScratchSizes &sizes)->
   decltype(sa.GetScratchpad());
@@ -22,6 +22,8 @@
  */
 
 #include <memory>
+#include "dali/core/bfloat16.h"
+#include "dali/core/float16.h"
 #include "dali/core/host_dev.h"
 #include "dali/kernels/kernel.h"
 
@@ -172,7 +174,9 @@ class DLL_PUBLIC NormalizeGPU {
   DALI_INSTANTIATE_NORMALIZE_GPU_OUT(linkage, uint8_t)\
   DALI_INSTANTIATE_NORMALIZE_GPU_OUT(linkage, uint16_t)\
   DALI_INSTANTIATE_NORMALIZE_GPU_OUT(linkage, uint32_t)\
-  DALI_INSTANTIATE_NORMALIZE_GPU_OUT(linkage, float)
+  DALI_INSTANTIATE_NORMALIZE_GPU_OUT(linkage, float)\
+  DALI_INSTANTIATE_NORMALIZE_GPU_OUT(linkage, float16)\
+  DALI_INSTANTIATE_NORMALIZE_GPU_OUT(linkage, bfloat16)
 
 DALI_INSTANTIATE_NORMALIZE_GPU(extern)
 
@@ -266,7 +266,9 @@ class NormalizeImplGPUTest<std::pair<Out, In>> : public ::testing::Test {
       RefNormalize(ref_.cpu(), in_.cpu(), ref_base, ref_scale,
                   global_scale_, shift_, scale_is_stddev_, epsilon_);
 
-      if (scale_is_stddev_ && !std::is_integral<Out>::value)
+      if (is_half<Out>::value)
+        Check(out_.cpu(), ref_.cpu(), EqualEpsRel(1e-2, 1e-2));
+      else if (scale_is_stddev_ && !std::is_integral<Out>::value)
         Check(out_.cpu(), ref_.cpu(), EqualEpsRel(1e-6, 1e-6));
       else
         Check(out_.cpu(), ref_.cpu(), EqualUlp(4));
@@ -348,7 +350,9 @@ class NormalizeImplGPUTest<std::pair<Out, In>> : public ::testing::Test {
 using NormalizeTestTypes = ::testing::Types<
   std::pair<int16_t, uint8_t>,
   std::pair<float, uint16_t>,
-  std::pair<float, float>>;
+  std::pair<float, float>,
+  std::pair<float16, uint8_t>,
+  std::pair<bfloat16, float>>;
 
 TYPED_TEST_SUITE(NormalizeImplGPUTest, NormalizeTestTypes);
 
@@ -27,6 +27,32 @@
 
 namespace dali {
 namespace kernels {
+namespace reductions {
+
+/**
+ * @{
+ * @brief Lets the reduction kernels load and shuffle the moments like a scalar accumulator
+ *
+ * These overloads are found by argument-dependent lookup.
+ */
+template <typename T>
+__device__ DALI_FORCEINLINE Moments<T> __ldg(const Moments<T> *mem) {
+  return { ::__ldg(&mem->count), ::__ldg(&mem->mean), ::__ldg(&mem->m2) };
+}
+
+template <typename T>
+__device__ DALI_FORCEINLINE Moments<T> __shfl_down_sync(unsigned mask, const Moments<T> &var,
+                                                        unsigned delta, int width = 32) {
+  return {
+    ::__shfl_down_sync(mask, var.count, delta, width),
+    ::__shfl_down_sync(mask, var.mean, delta, width),
+    ::__shfl_down_sync(mask, var.m2, delta, width)
+  };
+}
+/** @} */
+
+}  // namespace reductions
+
 namespace reduce_impl {
 
 template <typename T>
@@ -421,6 +447,144 @@ class InvStdDevImplGPU :
   }
 };
 
+/**
+ * @brief The mean and the regularized inverse standard deviation, calculated in one pass
+ */
+template <typename Out>
+struct MeanInvStdDev {
+  Out mean, inv_stddev;
+};
+
+/**
+ * @brief Converts an input value to the moments of a single-element set
+ */
+template <typename Acc>
+struct ToMoments {
+  template <typename T>
+  DALI_HOST_DEV DALI_FORCEINLINE reductions::Moments<Acc> operator()(const T &x) const noexcept {
+    return { 1, static_cast<Acc>(x), 0 };
+  }
+};
+
+template <typename Out, typename ScaleAndReg>
+struct MeanAndRegularizedInvSqrt {
+  RegularizedInvSqrt<Out, ScaleAndReg> inv_sqrt;
+
+  template <typename T>
+  DALI_HOST_DEV MeanInvStdDev<Out> operator()(const reductions::Moments<T> &m) const {
+    return { ConvertSat<Out>(m.mean), inv_sqrt(m.m2) };
+  }
+};
+
+template <typename SplitOut>
+__global__ void SplitMeanInvStdDev(SplitOut *mean, SplitOut *inv_stddev,
+                                   const MeanInvStdDev<SplitOut> *in, int64_t n) {
+  int64_t grid_stride = static_cast<int64_t>(gridDim.x) * blockDim.x;
+  for (int64_t i = static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+       i < n; i += grid_stride) {
+    MeanInvStdDev<SplitOut> v = in[i];
+    mean[i] = v.mean;
+    inv_stddev[i] = v.inv_stddev;
+  }
+}
+
+/**
+ * @brief Implements a single-pass mean and regularized inverse standard deviation reduction
+ *
+ * The input is reduced to the count, mean and sum of squared deviations with Welford's
+ * algorithm - unlike a separate MeanImplGPU and InvStdDevImplGPU, the input is read only once
+ * and the variance does not suffer from the cancellation of a sum-of-squares formula.
+ *
+ * The reduction produces MeanInvStdDev pairs in a temporary buffer, which are then split into
+ * the two outputs.
+ */
+template <typename Out, typename In, typename Acc = scale_t<Out>>
+class MeanInvStdDevImplGPU :
+      public ReduceImplGPU<MeanInvStdDev<Out>, In, reductions::Moments<Acc>,
+                           MeanInvStdDevImplGPU<Out, In, Acc>>,
+      public RegularizedInvRMS<Out, In, MeanInvStdDevImplGPU<Out, In, Acc>> {
+ public:
+  using ReduceBase = ReduceImplGPU<MeanInvStdDev<Out>, In, reductions::Moments<Acc>,
+                                   MeanInvStdDevImplGPU<Out, In, Acc>>;
+  using RMSBase = RegularizedInvRMS<Out, In, MeanInvStdDevImplGPU<Out, In, Acc>>;
+  using typename RMSBase::param_t;
+
+  reductions::welford GetReduction() const { return {}; }
+
+  using Preprocessor = ToMoments<Acc>;
+  template <int non_reduced_dims>
+  using PreprocessorBank = UniformPreprocessorBank<non_reduced_dims, Preprocessor>;
+
+  Preprocessor GetPreprocessorImpl(int sample_idx, bool batch) const { return {}; }
+
+  template <int non_reduced_dims>
+  PreprocessorBank<non_reduced_dims> *
+  GetPreprocessorBanksImpl(WorkArea &wa, int axis, int_const<non_reduced_dims>) const {
+    return nullptr;
+  }
+
+  using Postprocessor = MeanAndRegularizedInvSqrt<Out, param_t>;
+
+  Postprocessor GetPostprocessorImpl(int sample_index, bool reduce_batch) const {
+    return { RMSBase::GetPostprocessorImpl(sample_index, reduce_batch) };
+  }
+
+  KernelRequirements Setup(KernelContext &ctx,
+                           const TensorListShape<> &in_shape,
+                           span<const int> axes,
+                           bool keep_dims,
+                           bool reduce_batch) {
+    auto req = ReduceBase::Setup(ctx, in_shape, axes, keep_dims, reduce_batch);
+    // the pairs are allocated before the reduction's own buffers
+    constexpr int kDevice = static_cast<int>(mm::memory_kind_id::device);
+    ScratchpadEstimator se;
+    se.add<mm::memory_kind::device, MeanInvStdDev<Out>>(req.output_shapes[0].num_elements(), 64);
+    se.add<mm::memory_kind::device, char>(req.scratch_sizes[kDevice], 64);
+    req.scratch_sizes[kDevice] = se.sizes[kDevice];
+    return req;
+  }
+
+  /**
+   * @brief Calculates the mean and the regularized inverse standard deviation
+   *
+   * @param mean        output mean
+   * @param inv_stddev  output inverse standard deviation, as calculated by InvStdDevImplGPU
+   * @param ddof        delta degrees of freedom, for Bessel's correction
+   * @param epsilon     regularizing term, added to the variance
+   */
+  void Run(KernelContext &kctx,
+           const OutListGPU<Out> &mean,
+           const OutListGPU<Out> &inv_stddev,
+           const InListGPU<In> &in,
+           int ddof = 0,
+           float epsilon = 0.0f) {
+    assert(mean.shape == inv_stddev.shape);
+    this->SetStdDevParams(ddof, epsilon);
+    auto pairs = kctx.scratchpad->AllocTensorList<mm::memory_kind::device, MeanInvStdDev<Out>>(
+        mean.shape);
+    ReduceBase::Run(kctx, pairs, in);
+
+    cudaStream_t stream = kctx.gpu.stream;
+    if (mean.is_contiguous() && inv_stddev.is_contiguous()) {
+      Split(mean.data[0], inv_stddev.data[0], pairs.data[0], pairs.num_elements(), stream);
+    } else {
+      for (int i = 0; i < pairs.num_samples(); i++)
+        Split(mean.data[i], inv_stddev.data[i], pairs.data[i], pairs[i].num_elements(), stream);
+    }
+  }
+
+ private:
+  static void Split(Out *mean, Out *inv_stddev, const MeanInvStdDev<Out> *pairs, int64_t n,
+                    cudaStream_t stream) {
+    if (n == 0)
+      return;
+    int block = std::min<int64_t>(n, 256);
+    int grid = std::min<int64_t>(div_ceil(n, block), 1024);
+    SplitMeanInvStdDev<<<grid, block, 0, stream>>>(mean, inv_stddev, pairs, n);
+    CUDA_CALL(cudaGetLastError());
+  }
+};
+
 }  // namespace reduce_impl
 }  // namespace kernels
 }  // namespace dali
@@ -360,6 +360,69 @@ TEST(InvStdDevImplGPU, Outer_Batch_Regularized) {
   }
 }
 
+void TestMeanInvStdDev(const TensorListShape<> &in_shape, span<const int> axes, bool batch,
+                       int ddof, float epsilon) {
+  TestTensorList<int16_t> in;
+  in.reshape(in_shape);
+  std::mt19937_64 rng(12345);
+
+  MeanInvStdDevImplGPU<float, int16_t> kernel;
+  KernelContext ctx;
+  auto req = kernel.Setup(ctx, in_shape, axes, true, batch);
+  ASSERT_EQ(req.output_shapes.size(), 1);
+  auto &out_shape = req.output_shapes[0];
+
+  TestTensorList<float> mean, inv_stddev, ref_mean;
+  mean.reshape(out_shape);
+  inv_stddev.reshape(out_shape);
+  ref_mean.reshape(out_shape);
+  ScratchpadAllocator sa;
+  sa.Reserve(req.scratch_sizes);
+
+  for (int iter = 0; iter < 3; iter++) {
+    // an offset makes the naive sum-of-squares formula lose precision
+    UniformRandomFill(in.cpu(), rng, 1000, 1100);
+    auto scratchpad = sa.GetScratchpad();
+    ctx.scratchpad = &scratchpad;
+    kernel.Run(ctx, mean.gpu(), inv_stddev.gpu(), in.gpu(), ddof, epsilon);
+
+    RefMean<double>(ref_mean.cpu(), in.cpu(), axes, true, batch);
+    auto ref_inv_stddev = RefStdDev(in.cpu(), ref_mean.cpu(), ddof, epsilon, true);
+    Check(mean.cpu(), ref_mean.cpu(), EqualEpsRel(1e-5, 1e-6));
+    Check(inv_stddev.cpu(), ref_inv_stddev.cpu(), EqualEpsRel(1e-4, 1e-6));
+  }
+}
+
+TEST(MeanInvStdDevImplGPU, Inner_Sample) {
+  TensorListShape<> in_shape = {{
+    { 3, 480, 640 },
+    { 3, 720, 1280 },
+    { 1, 1080, 1920 }
+  }};
+  int axes[] = { 1, 2 };
+  TestMeanInvStdDev(in_shape, make_span(axes), false, 0, 0);
+}
+
+TEST(MeanInvStdDevImplGPU, Outer_Batch_Regularized) {
+  TensorListShape<> in_shape = {{
+    { 480, 640, 3 },
+    { 720, 1280, 3 },
+    { 1080, 1920, 3 }
+  }};
+  int axes[] = { 0, 1 };
+  TestMeanInvStdDev(in_shape, make_span(axes), true, 1, 12000);
+}
+
+TEST(MeanInvStdDevImplGPU, Middle_Inner_Sample) {
+  TensorListShape<> in_shape = {{
+    { 2, 32, 3, 6400 },
+    { 2, 15, 3, 12800 },
+    { 2, 7200, 3, 7 }
+  }};
+  int axes[] = { 1, 3 };
+  TestMeanInvStdDev(in_shape, make_span(axes), false, 1, 0);
+}
+
 
 }  // namespace reduce_impl
 }  // namespace kernels
@@ -79,6 +79,53 @@ __global__ void ReduceAllBatchedKernel(Out *out, const In *const *in, const int6
     out[blockIdx.x + blockIdx.y * gridDim.x] = ConvertSat<Out>(postprocess(val));
 }
 
+/**
+ * @brief The largest sample reduced by ReduceAllWarpPerSampleKernel.
+ *
+ * Above this size, a block per sample pays off.
+ */
+constexpr int kMaxWarpPerSampleSize = 512;
+
+/**
+ * @brief Reduce many small samples, each with a single warp.
+ *
+ * A block of 1024 threads per sample is mostly idle and spends more time synchronizing than
+ * reducing when the samples have a few hundred elements or less (e.g. per-box statistics);
+ * here each warp reduces one sample and the block processes `blockDim.y` samples.
+ *
+ * `blockDim = 32, warps_per_block`
+ * `gridDim = div_ceil(num_samples, warps_per_block)`
+ *
+ * @param out         the per-sample results
+ * @param in          pointers to the samples
+ * @param in_sizes    the numbers of elements in the samples
+ * @param num_samples the number of samples
+ */
+template <typename Acc, typename Out, typename In,
+          typename Reduction = reductions::sum,
+          typename Preprocess = dali::identity,
+          typename Postprocess = dali::identity>
+__global__ void ReduceAllWarpPerSampleKernel(Out *out, const In *const *in,
+                                             const int64_t *in_sizes, int num_samples,
+                                             Reduction reduce = {},
+                                             const Preprocess *pre = nullptr,
+                                             const Postprocess *post = nullptr) {
+  const int sample = blockIdx.x * blockDim.y + threadIdx.y;
+  if (sample >= num_samples)
+    return;  // the whole warp leaves, so the others can still use the full mask
+  Preprocess preprocess = pre ? pre[sample] : Preprocess();
+  Postprocess postprocess = post ? post[sample] : Postprocess();
+  const int64_t n = in_sizes[sample];
+  const In *sample_in = in[sample];
+  Acc val = reduce.template neutral<Acc>();
+  for (int64_t idx = threadIdx.x; idx < n; idx += 32) {
+    reduce(val, preprocess(sample_in[idx]));
+  }
+  WarpReduce(val, reduce);
+  if (threadIdx.x == 0)
+    out[sample] = ConvertSat<Out>(postprocess(val));
+}
+
 /**
  * @brief Reduce evenly-spaced, contiguous blocks in `in` and store blockwise results in `out`.
  *
@@ -263,6 +263,8 @@ TYPED_TEST(ReduceAllGPUTest, ReduceAllKernelGPU) {
   this->TestReduceAllKernel(10000, 1000000);
   // small inputs
   this->TestReduceAllKernel(128, 2048);
+  // tiny inputs - one warp per sample
+  this->TestReduceAllKernel(1, kMaxWarpPerSampleSize);
 }
 
 }  // namespace kernels
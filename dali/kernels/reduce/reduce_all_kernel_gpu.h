@@ -48,6 +48,7 @@ class DLL_PUBLIC ReduceAllGPU {
     for (int i = 0; i < num_samples; i++) {
       max_sample_size = std::max(max_sample_size, volume(in.tensor_shape(i)));
     }
+    warp_per_sample_ = max_sample_size <= kMaxWarpPerSampleSize;
     if (max_sample_size <= 4096) {
       blocks_per_sample_ = 1;
     } else {
@@ -99,7 +100,12 @@ class DLL_PUBLIC ReduceAllGPU {
     dim3 block(32, 32);
     dim3 grid(blocks_per_sample_, num_samples);
 
-    if (blocks_per_sample_ == 1) {
+    if (warp_per_sample_) {
+      // Tiny samples - one warp each
+      dim3 warp_grid(div_ceil(num_samples, block.y));
+      ReduceAllWarpPerSampleKernel<Acc><<<warp_grid, block, 0, context.gpu.stream>>>(
+          out_start, sample_data_gpu, sample_size_gpu, num_samples, reduction);
+    } else if (blocks_per_sample_ == 1) {
       // For small inputs, we reduce in one step
       ReduceAllBatchedKernel<Acc><<<grid, block, 0, context.gpu.stream>>>(
           out_start, sample_data_gpu, sample_size_gpu, reduction);
@@ -115,6 +121,7 @@ class DLL_PUBLIC ReduceAllGPU {
 
  private:
   int blocks_per_sample_;
+  bool warp_per_sample_ = false;
   int tmp_buffer_size_;
   Reduction reduction;
 };
@@ -15,6 +15,7 @@
 #ifndef DALI_KERNELS_REDUCE_REDUCE_CPU_H_
 #define DALI_KERNELS_REDUCE_REDUCE_CPU_H_
 
+#include <algorithm>
 #include <cassert>
 #include <utility>
 #include <vector>
@@ -32,6 +33,12 @@
 namespace dali {
 namespace kernels {
 
+/**
+ * @brief Minimum number of input elements reduced by a single job, when the reduction
+ *        is scheduled with an execution engine
+ */
+constexpr int kReduceMinBlockSize = 1 << 16;
+
 namespace reduce_impl {
 
 constexpr int kTreeReduceThreshold = 32;
@@ -60,10 +67,56 @@ void reduce1D_stride(Dst &reduced, const Src *data, int64_t dynamic_stride, int6
   }
 }
 
+constexpr int kReduceLanes = 8;
+constexpr int kContiguousTreeReduceThreshold = 256;
+
+/**
+ * @brief Reduces contiguous data
+ *
+ * The data is split in halves down to blocks of up to `kContiguousTreeReduceThreshold` elements;
+ * the blocks are reduced with `kReduceLanes` independent accumulators, which breaks the
+ * dependency chain and allows the compiler to vectorize the loop. The accumulators are then
+ * combined pairwise, so the error bound of pairwise summation is retained.
+ */
+template <typename Dst, typename Src, typename Preprocessor, typename Reduction>
+void reduce1D_contiguous(Dst &reduced, const Src *data, int64_t n,
+                         const Preprocessor &P, const Reduction &R) {
+  const Dst neutral = R.template neutral<Dst>();
+  if (n > kContiguousTreeReduceThreshold) {
+    // keep the first half a multiple of the number of lanes
+    int64_t m = (n >> 1) & -kReduceLanes;
+    Dst tmp1 = neutral, tmp2 = neutral;
+    reduce1D_contiguous(tmp1, data, m, P, R);
+    reduce1D_contiguous(tmp2, data + m, n - m, P, R);
+    R(tmp1, tmp2);
+    R(reduced, tmp1);
+  } else {
+    Dst acc[kReduceLanes];
+    for (int j = 0; j < kReduceLanes; j++)
+      acc[j] = neutral;
+    int64_t i = 0;
+    for (; i + kReduceLanes <= n; i += kReduceLanes) {
+      for (int j = 0; j < kReduceLanes; j++)
+        R(acc[j], P(data[i + j]));
+    }
+    for (int j = 0; i < n; i++, j++)
+      R(acc[j], P(data[i]));
+    for (int w = kReduceLanes / 2; w > 0; w >>= 1) {
+      for (int j = 0; j < w; j++)
+        R(acc[j], acc[j + w]);
+    }
+    R(reduced, acc[0]);
+  }
+}
+
 template <typename Dst, typename Src, typename Preprocessor, typename Reduction>
 void reduce1D(Dst &reduced, const Src *data, int64_t stride, int64_t n,
               const Preprocessor &P, const Reduction &R) {
-  VALUE_SWITCH(stride, static_stride, (1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 16),
+  if (stride == 1) {
+    reduce1D_contiguous(reduced, data, n, P, R);
+    return;
+  }
+  VALUE_SWITCH(stride, static_stride, (2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 16),
     (reduce1D_stride<static_stride>(reduced, data, static_stride, n, P, R);),
     (reduce1D_stride<-1>(reduced, data, stride, n, P, R);)
   );  // NOLINT
@@ -85,7 +138,7 @@ void reduce(Dst &reduced, const StridedTensor<StorageCPU, Src> &in,
   const Dst neutral = R.template neutral<Dst>();
   if (axis == in.dim() - 1) {
     Dst tmp = neutral;
-    reduce1D(tmp, in.data + offset, stride, in.size[axis], P, R);
+    reduce1D(tmp, in.data + offset, stride, extent, P, R);
     R(reduced, tmp);
   } else {
     int64_t sub_v = volume(in.size.begin() + axis + 1, in.size.end());
@@ -181,6 +234,88 @@ struct ReduceBaseCPU {
     Run(clear, postprocess);
   }
 
+  /**
+   * @brief Schedules the reduction with an execution engine.
+   *
+   * Reductions of more than `min_blk_sz` input elements are split into blocks processed by
+   * separate jobs: the outermost output dimension is split if it's big enough, otherwise
+   * the outermost reduced dimension is split and the partial results are combined in Finalize.
+   *
+   * The work doesn't start until the user calls RunAll() on the execution engine; after that,
+   * Finalize must be called to obtain the final result. The kernel and the tensors must be
+   * kept alive until then.
+   */
+  template <typename ExecutionEngine>
+  void Schedule(ExecutionEngine &engine, bool postprocess = true,
+                int64_t min_blk_sz = kReduceMinBlockSize) {
+    num_partials_ = 0;
+    int64_t in_volume = input.num_elements();
+    int nblocks = engine.NumThreads() > 1
+                ? std::min<int64_t>(engine.NumThreads() * 2, div_ceil(in_volume, min_blk_sz))
+                : 1;
+    if (axes.empty() || nblocks <= 1) {
+      pending_postprocess_ = false;
+      engine.AddWork([this, postprocess](int) {
+        Run(true, postprocess);
+      }, in_volume, false);
+      return;
+    }
+
+    pending_postprocess_ = postprocess;
+
+    if (!step.empty() && output.shape[0] >= nblocks) {
+      int64_t extent = output.shape[0];
+      for (int b = 0; b < nblocks; b++) {
+        int64_t begin = extent * b / nblocks;
+        int64_t end = extent * (b + 1) / nblocks;
+        engine.AddWork([this, begin, end](int) {
+          SmallVector<int64_t, 6> pos;
+          pos.resize(output.dim());
+          for (int64_t i = begin; i < end; i++) {
+            pos[0] = i;
+            ReduceAxis(true, make_span(pos), 1, i * step[0]);
+          }
+        }, in_volume * (end - begin) / extent, false);
+      }
+      return;
+    }
+
+    int64_t extent = strided_in.size[0];
+    num_partials_ = std::min<int64_t>(nblocks, extent);
+    int64_t out_volume = output.num_elements();
+    partials_.resize(num_partials_ * out_volume);
+    for (int b = 0; b < num_partials_; b++) {
+      int64_t begin = extent * b / num_partials_;
+      int64_t end = extent * (b + 1) / num_partials_;
+      engine.AddWork([this, begin, end, b, out_volume](int) {
+        SmallVector<int64_t, 6> pos;
+        pos.resize(output.dim());
+        ReducePartial(make_span(pos), 0, 0, partials_.data() + b * out_volume, begin, end);
+      }, in_volume * (end - begin) / extent, false);
+    }
+  }
+
+  /**
+   * @brief Combines the partial results of the jobs submitted in Schedule and
+   *        postprocesses the output, unless it was already done by the jobs.
+   */
+  void Finalize() {
+    if (num_partials_ > 0) {
+      auto R = This().GetReduction();
+      int64_t out_volume = output.num_elements();
+      for (int64_t i = 0; i < out_volume; i++) {
+        Dst r = partials_[i];
+        for (int b = 1; b < num_partials_; b++)
+          R(r, partials_[b * out_volume + i]);
+        output.data[i] = r;
+      }
+      num_partials_ = 0;
+    }
+    if (pending_postprocess_)
+      This().PostprocessAll();
+    pending_postprocess_ = false;
+  }
+
   void PostprocessAll() {
     if (reinterpret_cast<decltype(&ReduceBaseCPU::Postprocess)>(&Actual::Postprocess) ==
         &ReduceBaseCPU::Postprocess)
@@ -226,6 +361,26 @@ struct ReduceBaseCPU {
     }
   }
 
+  /**
+   * @brief Reduces the range [begin, end) of the outermost reduced dimension,
+   *        storing the results in `partial`, which has the layout of the output.
+   */
+  void ReducePartial(span<int64_t> pos, int axis, int64_t offset, Dst *partial,
+                     int64_t begin, int64_t end) {
+    auto R = This().GetReduction();
+    if (axis == static_cast<int>(step.size())) {
+      Dst &r = partial[output(pos) - output.data];
+      r = R.template neutral<Dst>();
+      reduce_impl::reduce(r, strided_in, This().GetPreprocessor(pos), R, 0, end - begin,
+                          offset + begin * strided_in.stride[0]);
+    } else {
+      for (int64_t i = 0; i < output.shape[axis]; i++) {
+        pos[axis] = i;
+        ReducePartial(pos, axis + 1, offset + i * step[axis], partial, begin, end);
+      }
+    }
+  }
+
   void ReduceForEmptyAxes(span<int64_t> pos) {
     auto P = This().GetPreprocessor(pos);
     for (int64_t i = 0; i < output.num_elements(); i++) {
@@ -332,6 +487,9 @@ struct ReduceBaseCPU {
   reduce_impl::StridedTensor<StorageCPU, const Src> strided_in;
   SmallVector<int64_t, 6> step;
   uint64_t axis_mask = 0;
+  std::vector<Dst> partials_;
+  int num_partials_ = 0;
+  bool pending_postprocess_ = false;
 };
 
 template <typename Dst, typename Src>
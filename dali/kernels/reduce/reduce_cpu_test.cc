@@ -13,9 +13,11 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <memory>
 #include <random>
 #include <chrono>
 #include "dali/kernels/reduce/reduce_cpu.h"
+#include "dali/pipeline/util/thread_pool.h"
 
 namespace dali {
 namespace kernels {
@@ -62,9 +64,15 @@ TEST(ReduceTest, Mean2D) {
   EXPECT_EQ(out[0], xmean + ymean);
 }
 
+/**
+ * @param num_threads if positive, the reduction is scheduled in a thread pool, with small blocks
+ */
 template <typename Reduce, typename Preprocess, typename Postprocess>
-void TestStatelessReduction3D(bool mean, Preprocess pre, Postprocess post) {
+void TestStatelessReduction3D(bool mean, Preprocess pre, Postprocess post, int num_threads = 0) {
   Reduce red;
+  std::unique_ptr<ThreadPool> tp;
+  if (num_threads > 0)
+    tp = std::make_unique<ThreadPool>(num_threads, CPU_ONLY_DEVICE_ID, false);
 
   const int W = 640, H = 480, C = 3;
   std::vector<int> in_v(W*H*C);
@@ -112,7 +120,13 @@ void TestStatelessReduction3D(bool mean, Preprocess pre, Postprocess post) {
 
     auto out = make_tensor_cpu(out_data, out_shape);
     red.Setup(out, in, make_cspan(axes));
-    red.Run();
+    if (tp) {
+      red.Schedule(*tp, true, 1000);
+      tp->RunAll();
+      red.Finalize();
+    } else {
+      red.Run();
+    }
 
     std::fill(ref.begin(), ref.end(), 0);
 
@@ -164,6 +178,62 @@ TEST(ReduceTest, RootMeanSquare3D) {
     sqrt);
 }
 
+TEST(ReduceTest, Sum3DParallel) {
+  TestStatelessReduction3D<SumCPU<float, int>>(
+    false,
+    dali::identity(),
+    dali::identity(),
+    4);
+}
+
+TEST(ReduceTest, RootMeanSquare3DParallel) {
+  auto sqrt = [](auto x) { return std::sqrt(x); };
+  TestStatelessReduction3D<RootMeanSquareCPU<float, int>>(
+    true,
+    reductions::square(),
+    sqrt,
+    4);
+}
+
+TEST(ReduceTest, StdDevParallel) {
+  ThreadPool tp(4, CPU_ONLY_DEVICE_ID, false);
+  std::mt19937_64 rng(1234);
+  std::normal_distribution<float> dist(10, 42);
+
+  const int W = 1920, H = 1080;
+  std::vector<float> in_v(W*H);
+  for (auto &x : in_v)
+    x = dist(rng);
+  auto in = make_tensor_cpu<2>(in_v.data(), { H, W });
+
+  SmallVector<int, 2> axes_sets[] = { { 0 }, { 1 }, { 0, 1 } };
+  for (auto &axes : axes_sets) {
+    TensorShape<> out_shape;
+    if (axes.size() == 1)
+      out_shape = { in.shape[1 - axes[0]] };
+    else
+      out_shape = { 1 };
+    std::vector<float> mean_v(volume(out_shape)), ref_v(mean_v.size()), out_v(mean_v.size());
+    auto mean = make_tensor_cpu(mean_v.data(), out_shape);
+
+    MeanCPU<float, float> mean_kernel;
+    mean_kernel.Setup(mean, in, make_cspan(axes));
+    mean_kernel.Run();
+
+    StdDevCPU<float, float> stddev;
+    stddev.Setup(make_tensor_cpu(ref_v.data(), out_shape), in, make_cspan(axes), mean);
+    stddev.Run();
+
+    stddev.Setup(make_tensor_cpu(out_v.data(), out_shape), in, make_cspan(axes), mean);
+    stddev.Schedule(tp);
+    tp.RunAll();
+    stddev.Finalize();
+
+    for (size_t i = 0; i < out_v.size(); i++)
+      EXPECT_NEAR(out_v[i], ref_v[i], 1e-4 * ref_v[i]);
+  }
+}
+
 TEST(ReduceTest, StdDev) {
   MeanCPU<float, float> mean;
   StdDevCPU<float, float> stddev;
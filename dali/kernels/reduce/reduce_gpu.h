@@ -710,6 +710,80 @@ extern template class InvStdDevGPU<float, int32_t>;
 
 extern template class InvStdDevGPU<float, float>;
 
+
+/**
+ * @brief Calculates the mean and the inverse of standard deviation of input elements along
+ *        given axes, reading the input only once.
+ *
+ * The results are equivalent to running MeanGPU and then InvStdDevGPU with the mean as
+ * an input, but the reduction is done in a single pass, with Welford's algorithm.
+ *
+ * For more details on how directional reductions work, see SumGPU, MeanGPU, RootMeanSquareGPU.
+ *
+ * @see MeanGPU
+ * @see InvStdDevGPU
+ */
+template <typename Out, typename In>
+class DLL_PUBLIC MeanInvStdDevGPU {
+ public:
+  MeanInvStdDevGPU();
+  ~MeanInvStdDevGPU();
+
+  /**
+   * @brief Sets up the reduction
+   *
+   * Sets up the reduction according to the parameters. The indices of dimensions to be reduced
+   * are provided in `axes` parameter.
+   * For a successful batch reduction, the reduced shape of all samples must be equal (but the
+   * input may have non-uniform shape, as long as the non-uniform dimensions are reduced).
+   *
+   * @param ctx          the execution environment
+   * @param in_shape     shape of the input tensor list
+   * @param axes         indices of axes to reduce along
+   * @param keep_dims    if true, the reduced dimensions are kept in the output shape, with the
+   *                     extent of 1
+   * @param reduce_batch if true, reduces respective output values of all samples in the batch
+   *                     and outputs a single tensor
+   *
+   * @return The requirements; the shape of both outputs is `output_shapes[0]`.
+   */
+  KernelRequirements Setup(KernelContext &ctx,
+                           const TensorListShape<> &in_shape,
+                           span<const int> axes, bool keep_dims, bool reduce_batch);
+
+  using param_t = std::conditional_t<std::is_same<Out, double>::value, double, float>;
+
+  /**
+   * @brief Calculates the mean and regularized inverse standard deviation
+   *
+   * The inverse standard deviation is calculated as in InvStdDevGPU::Run.
+   *
+   * @param ctx         the execution environment
+   * @param mean        mean of the input
+   * @param inv_stddev  (regularized) inverse standard deviation
+   * @param in          input tensor
+   * @param ddof        delta degrees of freedom, for Bessel's correction
+   * @param epsilon     regularizing term to avoid division by zero (or small numbers)
+   */
+  void Run(KernelContext &ctx, const OutListGPU<Out> &mean, const OutListGPU<Out> &inv_stddev,
+           const InListGPU<In> &in, int ddof = 0, param_t epsilon = 0);
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+extern template class MeanInvStdDevGPU<float, uint8_t>;
+extern template class MeanInvStdDevGPU<float, int8_t>;
+
+extern template class MeanInvStdDevGPU<float, uint16_t>;
+extern template class MeanInvStdDevGPU<float, int16_t>;
+
+extern template class MeanInvStdDevGPU<float, uint32_t>;
+extern template class MeanInvStdDevGPU<float, int32_t>;
+
+extern template class MeanInvStdDevGPU<float, float>;
+
 }  // namespace kernels
 }  // namespace dali
 
@@ -1025,6 +1025,10 @@ class ReduceImplGPU {
       assert(stage.shape[i].reduced_out == stage.shape[0].reduced_out);
     }
 
+    int64_t max_size = 0;
+    for (int i = 0; i < stage.num_samples(); i++)
+      max_size = std::max(max_size, sizes[i]);
+
     dim3 block(32, 32);
     dim3 grid(stage.shape[0].reduced_out, stage.num_samples());
 
@@ -1038,8 +1042,15 @@ class ReduceImplGPU {
     auto *gpu_pre             = wa.GetDeviceParam(pre);
     auto *gpu_post            = wa.GetDeviceParam(post);
 
-    ReduceAllBatchedKernel<Acc><<<grid, block, 0, ctx.stream>>>(
-      out, gpu_in, gpu_sizes, This().GetReduction(), gpu_pre, gpu_post);
+    if (stage.shape[0].reduced_out == 1 && max_size <= kMaxWarpPerSampleSize) {
+      // many tiny samples, e.g. per-box statistics - one warp per sample
+      dim3 warp_grid(div_ceil(stage.num_samples(), block.y));
+      ReduceAllWarpPerSampleKernel<Acc><<<warp_grid, block, 0, ctx.stream>>>(
+        out, gpu_in, gpu_sizes, stage.num_samples(), This().GetReduction(), gpu_pre, gpu_post);
+    } else {
+      ReduceAllBatchedKernel<Acc><<<grid, block, 0, ctx.stream>>>(
+        out, gpu_in, gpu_sizes, This().GetReduction(), gpu_pre, gpu_post);
+    }
 
     CUDA_CALL(cudaGetLastError());
   }
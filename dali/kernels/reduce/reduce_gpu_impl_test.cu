@@ -356,6 +356,27 @@ TEST(SumImplGPU, WholeSamples) {
   test.Check();
 }
 
+TEST(SumImplGPU, ManyTinySamples) {
+  std::mt19937_64 rng(12345);
+  std::uniform_int_distribution<int> extent_dist(0, 20);
+  int N = 1000;
+  TensorListShape<> in_shape(N, 2), ref_out_shape(N, 2);
+  for (int i = 0; i < N; i++) {
+    in_shape.set_tensor_shape(i, { extent_dist(rng), 4 });
+    ref_out_shape.set_tensor_shape(i, { 1, 1 });
+  }
+  int axes[] = { 0, 1 };
+  testing::ReductionKernelTest<SumImplGPU<int64_t, uint8_t>, int64_t, uint8_t> test;
+  test.Setup(in_shape, ref_out_shape, make_span(axes), true, false);
+  EXPECT_EQ(test.kernel.GetNumStages(), 1);
+  test.FillData(0, 255);
+  test.Run();
+
+  RefReduce(test.ref.cpu(), test.in.cpu(), make_span(axes), true, false, reductions::sum());
+
+  test.Check();
+}
+
 
 TEST(SumImplGPU, All) {
   TensorListShape<> in_shape = {{
@@ -94,6 +94,41 @@ struct max {
   static constexpr T neutral() noexcept { return min_value<T>(); }
 };
 
+/**
+ * @brief The number of elements, their mean and the sum of squared deviations from the mean
+ *
+ * This is the state of Welford's online variance algorithm. The structure is kept trivial,
+ * so that it can be stored in shared memory.
+ */
+template <typename T>
+struct Moments {
+  T count, mean, m2;
+};
+
+/**
+ * @brief Merges partial moments with the parallel variant of Welford's algorithm (Chan et al.)
+ *
+ * The neutral element is an empty set (all fields 0); a single value `x` is `{ 1, x, 0 }`.
+ */
+struct welford {
+  template <typename T>
+  DALI_HOST_DEV DALI_FORCEINLINE
+  void operator()(Moments<T> &acc, const Moments<T> &val) const noexcept {
+    T n = acc.count + val.count;
+    if (n == 0)
+      return;
+    T delta = val.mean - acc.mean;
+    T w = val.count / n;
+    acc.mean += delta * w;
+    acc.m2 += val.m2 + delta * delta * acc.count * w;
+    acc.count = n;
+  }
+
+  template <typename T>
+  DALI_HOST_DEV DALI_FORCEINLINE
+  static constexpr T neutral() noexcept { return T(); }
+};
+
 template <typename Reduction>
 struct is_accurate : std::false_type {};
 
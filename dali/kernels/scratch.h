@@ -23,6 +23,7 @@
 #include "dali/core/mm/memory.h"
 #include "dali/core/mm/memory_kind.h"
 #include "dali/kernels/context.h"
+#include "dali/kernels/scratch_capture.h"
 
 namespace dali {
 namespace kernels {
@@ -166,9 +167,13 @@ class ScratchpadAllocator {
   /**
    * @brief Releases any storage allocated by calls to `Reserve`.
    * @remarks Scratchpad returned by `GetScratchpad` is invalid after this call.
+   *          Within a ScratchpadCapture scope, the storage is handed over to the capture.
    */
   void Free() {
+    auto *capture = ScratchpadCapture::Current();
     for (auto &buffer : buffers_) {
+      if (capture)
+        capture->Retain(std::move(buffer.mem));
       buffer.mem.reset();
       buffer.capacity = 0;
       buffer.padding = 0;
@@ -190,6 +195,8 @@ class ScratchpadAllocator {
    * @brief Ensures that at least `size` bytes of memory are available in storage `type`
    * @remarks If reallocation happens, any `Scratchpad` returned by `GetScratchpad`
    *          is invalidated.
+   *          Within a ScratchpadCapture scope, a buffer allocated outside of the scope is always
+   *          replaced and the old one is handed over to the capture.
    */
   template <typename MemoryKind>
   void Reserve(size_t size) {
@@ -205,7 +212,13 @@ class ScratchpadAllocator {
         new_capacity = size_with_margin;
     }
 
-    if (new_capacity != buf.capacity) {
+    auto *capture = ScratchpadCapture::Current();
+    bool renew = capture && new_capacity > 0 && buf.capture_id != capture->id();
+    if (new_capacity != buf.capacity || renew) {
+      if (capture) {
+        capture->Retain(std::move(buf.mem));
+        buf.capture_id = capture->id();
+      }
       buf.mem.reset();
       buf.mem = mm::alloc_raw_unique<char, MemoryKind>(new_capacity + alignment);
       uintptr_t ptr = reinterpret_cast<uintptr_t>(buf.mem.get());
@@ -258,6 +271,13 @@ class ScratchpadAllocator {
    *          object or by subsequent calls to `Reserve` or `Free`.
    */
   PreallocatedScratchpad GetScratchpad() {
+    if (auto *capture = ScratchpadCapture::Current()) {
+      for (size_t idx = 0; idx < NumMemKinds; idx++) {
+        auto &buf = buffers_[idx];
+        if (buf.capacity > 0 && buf.capture_id != capture->id())
+          Reserve(mm::memory_kind_id(idx), buf.capacity);
+      }
+    }
     PreallocatedScratchpad scratchpad;
     for (size_t idx = 0; idx < NumMemKinds; idx++) {
       auto &buf = buffers_[idx];
@@ -271,6 +291,8 @@ class ScratchpadAllocator {
     mm::uptr<char> mem;
     size_t capacity = 0, padding = 0;
     AllocPolicy policy = {};
+    /// The ScratchpadCapture scope in which the memory was allocated, if any
+    uint64_t capture_id = 0;
   };
   std::array<Buffer, NumMemKinds> buffers_;
 };
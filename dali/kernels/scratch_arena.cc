@@ -0,0 +1,68 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/kernels/scratch_arena.h"
+#include "dali/core/util.h"
+
+namespace dali {
+namespace kernels {
+
+namespace {
+
+thread_local ScratchArena *current_arena = nullptr;
+
+}  // namespace
+
+ScratchArena::Scope::Scope(ScratchArena *arena) : arena_(arena), prev_(current_arena) {
+  if (arena_)
+    current_arena = arena_;
+}
+
+ScratchArena::Scope::~Scope() {
+  if (arena_) {
+    current_arena = prev_;
+    arena_->Release();
+  }
+}
+
+ScratchArena *ScratchArena::Current() {
+  return current_arena;
+}
+
+char *ScratchArena::Allocate(size_t bytes) {
+  if (bytes == 0)
+    return nullptr;
+  bytes = align_up(bytes, kAlignment);
+  size_t offset = used_;
+  used_ += bytes;
+  if (used_ <= capacity_)
+    return buffer_.get() + offset;
+  // doesn't fit - the buffer is grown when the memory is released
+  overflow_.push_back(mm::alloc_raw_unique<char, mm::memory_kind::device>(bytes, kAlignment));
+  return overflow_.back().get();
+}
+
+void ScratchArena::Release() {
+  last_peak_ = used_;
+  used_ = 0;
+  if (overflow_.empty())
+    return;
+  overflow_.clear();
+  buffer_.reset();
+  capacity_ = last_peak_;
+  buffer_ = mm::alloc_raw_unique<char, mm::memory_kind::device>(capacity_, kAlignment);
+}
+
+}  // namespace kernels
+}  // namespace dali
@@ -0,0 +1,102 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_KERNELS_SCRATCH_ARENA_H_
+#define DALI_KERNELS_SCRATCH_ARENA_H_
+
+#include <cstddef>
+#include <vector>
+#include "dali/core/api_helper.h"
+#include "dali/core/common.h"
+#include "dali/core/mm/memory.h"
+
+namespace dali {
+namespace kernels {
+
+/**
+ * @brief Device scratch memory shared by the operators which run one after another in a stream
+ *
+ * The operators of a stage issued to the same stream never use their scratch memory at the same
+ * time, so, instead of each KernelManager keeping its own, ever-growing device buffer, they can
+ * all take it from one arena. While a ScratchArena::Scope is active in the calling thread,
+ * KernelManager takes the device scratch memory from the arena; the other memory kinds still
+ * come from its own allocators, since the host writes to them without stream ordering.
+ *
+ * Everything allocated in a scope is released when the scope ends - the work of the next
+ * operator is issued to the same stream, so it's ordered after the work which used the memory.
+ * The arena grows to the largest amount used within a single scope; the allocations which don't
+ * fit in the current buffer get overflow buffers, which are freed when the scope ends.
+ */
+class DLL_PUBLIC ScratchArena {
+ public:
+  static constexpr size_t kAlignment = 256;
+
+  ScratchArena() = default;
+  ScratchArena(ScratchArena &&) = default;
+  ScratchArena &operator=(ScratchArena &&) = default;
+
+  /**
+   * @brief Makes the arena current in the calling thread; it's released when the scope ends
+   *
+   * A scope with a null arena is allowed and does nothing.
+   */
+  class DLL_PUBLIC Scope {
+   public:
+    explicit Scope(ScratchArena *arena);
+    ~Scope();
+
+    DISABLE_COPY_MOVE_ASSIGN(Scope);
+
+   private:
+    ScratchArena *arena_;
+    ScratchArena *prev_;
+  };
+
+  /**
+   * @brief Returns the arena of the innermost scope active in the calling thread or nullptr
+   */
+  static ScratchArena *Current();
+
+  /**
+   * @brief Allocates `bytes` bytes, aligned to kAlignment, valid until the scope ends
+   */
+  char *Allocate(size_t bytes);
+
+  /**
+   * @brief Releases everything allocated since the last release and, if some of the
+   *        allocations didn't fit, grows the buffer to the amount used
+   */
+  void Release();
+
+  /// The amount allocated since the last release
+  size_t Used() const noexcept { return used_; }
+
+  /// The amount used between the last two releases
+  size_t LastPeak() const noexcept { return last_peak_; }
+
+  /// The size of the buffer, which the allocations take the memory from
+  size_t Capacity() const noexcept { return capacity_; }
+
+ private:
+  mm::uptr<char> buffer_;
+  size_t capacity_ = 0;
+  size_t used_ = 0;
+  size_t last_peak_ = 0;
+  std::vector<mm::uptr<char>> overflow_;
+};
+
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_SCRATCH_ARENA_H_
@@ -0,0 +1,57 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <cstring>
+#include "dali/kernels/scratch_capture.h"
+
+namespace dali {
+namespace kernels {
+
+namespace {
+
+thread_local ScratchpadCapture *current_capture = nullptr;
+
+uint64_t NextCaptureId() {
+  static std::atomic<uint64_t> next_id{1};
+  return next_id++;
+}
+
+}  // namespace
+
+ScratchpadCapture::ScratchpadCapture(std::vector<mm::uptr<char>> *retained)
+: retained_(retained), id_(NextCaptureId()), prev_(current_capture) {
+  current_capture = this;
+}
+
+ScratchpadCapture::~ScratchpadCapture() {
+  current_capture = prev_;
+}
+
+ScratchpadCapture *ScratchpadCapture::Current() {
+  return current_capture;
+}
+
+const void *ScratchpadCapture::StageHost(const void *data, size_t bytes) {
+  if (bytes == 0)
+    return data;
+  auto mem = mm::alloc_raw_unique<char, mm::memory_kind::host>(bytes, 64);
+  std::memcpy(mem.get(), data, bytes);
+  const void *copy = mem.get();
+  retained_->push_back(std::move(mem));
+  return copy;
+}
+
+}  // namespace kernels
+}  // namespace dali
@@ -0,0 +1,84 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_KERNELS_SCRATCH_CAPTURE_H_
+#define DALI_KERNELS_SCRATCH_CAPTURE_H_
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "dali/core/api_helper.h"
+#include "dali/core/common.h"
+#include "dali/core/mm/memory.h"
+
+namespace dali {
+namespace kernels {
+
+/**
+ * @brief Marks a scope in which the work issued by the kernels may be captured into a CUDA graph
+ *
+ * A CUDA graph refers to the scratch memory (and to the sources of host-to-device copies)
+ * by address, so that memory must stay intact for as long as the graph can be launched.
+ * While a capture scope is active in the calling thread:
+ * - ScratchpadAllocator replaces the buffers allocated outside of this scope with new ones,
+ *   so the graphs captured in different scopes never share the scratch memory;
+ * - the buffers which ScratchpadAllocator would free are moved to the `retained` list;
+ * - the host data copied with Scratchpad::ToGPU and ToContiguousGPU is staged in buffers
+ *   which are also placed in the `retained` list.
+ *
+ * The owner of the list must keep it for as long as any of the graphs captured within
+ * the scopes which use it may be launched.
+ */
+class DLL_PUBLIC ScratchpadCapture {
+ public:
+  explicit ScratchpadCapture(std::vector<mm::uptr<char>> *retained);
+  ~ScratchpadCapture();
+
+  DISABLE_COPY_MOVE_ASSIGN(ScratchpadCapture);
+
+  /**
+   * @brief Returns the innermost capture scope active in the calling thread or nullptr
+   */
+  static ScratchpadCapture *Current();
+
+  /**
+   * @brief A process-wide unique, non-zero identifier of the scope
+   */
+  uint64_t id() const noexcept {
+    return id_;
+  }
+
+  /**
+   * @brief Keeps the memory alive for as long as the retained list
+   */
+  void Retain(mm::uptr<char> mem) {
+    if (mem)
+      retained_->push_back(std::move(mem));
+  }
+
+  /**
+   * @brief Copies `bytes` bytes of host data to a retained buffer and returns the copy
+   */
+  const void *StageHost(const void *data, size_t bytes);
+
+ private:
+  std::vector<mm::uptr<char>> *retained_;
+  uint64_t id_;
+  ScratchpadCapture *prev_;
+};
+
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_SCRATCH_CAPTURE_H_
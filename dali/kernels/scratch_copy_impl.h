@@ -146,7 +146,11 @@ ToContiguousGPUMem(Scratchpad &scratchpad, cudaStream_t stream, const Collection
   detail::copy_to_buffer(tmp, &offsets[0], c...);
   void *out_ptr = scratchpad.Alloc<mm::memory_kind::device>(total_size, alignment);
 
-  CUDA_CALL(cudaMemcpyAsync(out_ptr, tmp, total_size, cudaMemcpyHostToDevice, stream));
+  // the temporary buffer doesn't outlive this function, but a CUDA graph reads it at launch
+  const void *src = tmp;
+  if (auto *capture = ScratchpadCapture::Current())
+    src = capture->StageHost(tmp, total_size);
+  CUDA_CALL(cudaMemcpyAsync(out_ptr, src, total_size, cudaMemcpyHostToDevice, stream));
   return detail::GetCollectionPtrs(out_ptr, &offsets[0], c...);
 }
 
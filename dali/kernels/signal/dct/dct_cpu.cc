@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2020, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2019-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -14,6 +14,8 @@
 
 #include "dali/kernels/signal/dct/dct_cpu.h"
 #include <cmath>
+#include <complex>
+#include <vector>
 #include "dali/core/common.h"
 #include "dali/core/convert.h"
 #include "dali/core/error_handling.h"
@@ -29,6 +31,68 @@ namespace kernels {
 namespace signal {
 namespace dct {
 
+namespace {
+
+/**
+ * @brief Computes DCT-II or DCT-III of a power-of-two length `n` with a complex FFT of
+ *        the same length (Makhoul's algorithm)
+ *
+ * DCT-II: the even inputs, followed by the odd ones in reverse order, are transformed and
+ * the k-th output is the real part of the k-th bin, shifted by exp(-i*pi*k/(2n)).
+ * DCT-III reverses these steps, with the inverse FFT.
+ *
+ * @param table   the table filled by `FillFftDctTable`
+ * @param bitrev  the bit-reversal permutation of `n` indices
+ * @param work    `n` complex values
+ */
+template <typename T, typename In>
+void FftDct(T *out, int64_t out_stride, int64_t ndct,
+            const In *in, int64_t in_stride, int64_t n, int dct_type,
+            const T *table, const int *bitrev, std::complex<T> *work) {
+  auto *fft_twiddles = reinterpret_cast<const std::complex<T> *>(table);
+  auto *shift = fft_twiddles + n / 2;
+  T scale0 = table[3 * n], scale = table[3 * n + 1];
+  bool inverse = dct_type == 3;
+
+  if (!inverse) {
+    for (int64_t i = 0; i < n; i++) {
+      int64_t m = i < n / 2 ? 2 * i : 2 * (n - 1 - i) + 1;
+      work[bitrev[i]] = in[m * in_stride];
+    }
+  } else {
+    for (int64_t k = 0; k < n; k++) {
+      T a = in[k * in_stride] * (k ? scale : scale0);
+      T b = k ? in[(n - k) * in_stride] * scale : 0;
+      work[bitrev[k]] = T(0.5) * std::complex<T>(a, -b) * shift[k];
+    }
+  }
+
+  for (int64_t len = 2; len <= n; len <<= 1) {
+    int64_t half = len / 2, tw_step = n / len;
+    for (int64_t i = 0; i < n; i += len) {
+      for (int64_t j = 0; j < half; j++) {
+        auto w = fft_twiddles[j * tw_step];
+        if (inverse)
+          w = std::conj(w);
+        auto u = work[i + j];
+        auto t = w * work[i + j + half];
+        work[i + j] = u + t;
+        work[i + j + half] = u - t;
+      }
+    }
+  }
+
+  if (!inverse) {
+    for (int64_t k = 0; k < ndct; k++)
+      out[k * out_stride] = (std::conj(shift[k]) * work[k]).real() * (k ? scale : scale0);
+  } else {
+    for (int64_t m = 0; m < ndct; m++)
+      out[m * out_stride] = work[m % 2 == 0 ? m / 2 : n - 1 - m / 2].real();
+  }
+}
+
+}  // namespace
+
 template <typename OutputType, typename InputType, int Dims>
 Dct1DCpu<OutputType, InputType, Dims>::~Dct1DCpu() = default;
 
@@ -61,10 +125,25 @@ Dct1DCpu<OutputType, InputType, Dims>::Setup(KernelContext &context,
   auto out_shape = in.shape;
   out_shape[axis_] = args.ndct;
 
-  size_t cos_table_sz = n * args.ndct;
-  if (cos_table_.size() != cos_table_sz || args != args_) {
+  bool use_fft = UseFftDct(n, args);
+  size_t cos_table_sz = use_fft ? FftDctTableSize(n) : n * args.ndct;
+  if (cos_table_.size() != cos_table_sz || args != args_ || use_fft != use_fft_) {
     cos_table_.resize(cos_table_sz);
-    FillCosineTable(cos_table_.data(), n, args);
+    if (use_fft) {
+      FillFftDctTable(cos_table_.data(), n, args);
+      int log2n = ilog2(n);
+      bitrev_.resize(n);
+      for (int i = 0; i < n; i++) {
+        int r = 0;
+        for (int b = 0; b < log2n; b++)
+          r |= ((i >> b) & 1) << (log2n - 1 - b);
+        bitrev_[i] = r;
+      }
+      fft_work_.resize(n);
+    } else {
+      FillCosineTable(cos_table_.data(), n, args);
+    }
+    use_fft_ = use_fft;
     args_ = args;
   }
 
@@ -73,6 +152,31 @@ Dct1DCpu<OutputType, InputType, Dims>::Setup(KernelContext &context,
   return req;
 }
 
+template <typename OutputType, typename InputType, int Dims>
+void Dct1DCpu<OutputType, InputType, Dims>::TransformFrame(
+    OutputType *out, int64_t out_stride, int64_t out_size,
+    const InputType *in, int64_t in_stride, int64_t in_size,
+    std::complex<OutputType> *fft_work) const {
+  if (use_fft_) {
+    FftDct(out, out_stride, out_size, in, in_stride, in_size, args_.dct_type,
+           cos_table_.data(), bitrev_.data(), fft_work);
+    return;
+  }
+  int64_t out_idx = 0;
+  for (int64_t k = 0; k < out_size; k++) {
+    OutputType out_val = 0;
+    const auto *cos_table_row = cos_table_.data() + k * in_size;
+    int64_t in_idx = 0;
+    for (int64_t n = 0; n < in_size; n++) {
+      OutputType in_val = in[in_idx];
+      in_idx += in_stride;
+      out_val += in_val * cos_table_row[n];
+    }
+    out[out_idx] = out_val;
+    out_idx += out_stride;
+  }
+}
+
 template <typename OutputType, typename InputType, int Dims>
 void Dct1DCpu<OutputType, InputType, Dims>::Run(KernelContext &context,
                                                 const OutTensorCPU<OutputType, Dims> &out,
@@ -81,8 +185,6 @@ void Dct1DCpu<OutputType, InputType, Dims>::Run(KernelContext &context,
   (void)args;
   (void)axis;
   assert(axis_ >= 0 && axis_ < Dims);
-  const auto n = in.shape[axis_];
-
   assert(args_.dct_type >= 1 && args_.dct_type <= 4);
 
   auto in_shape = in.shape;
@@ -96,22 +198,32 @@ void Dct1DCpu<OutputType, InputType, Dims>::Run(KernelContext &context,
     [this](
       OutputType *out_data, const InputType *in_data, int64_t out_size, int64_t out_stride,
       int64_t in_size, int64_t in_stride) {
-        int64_t out_idx = 0;
-        for (int64_t k = 0; k < out_size; k++) {
-          OutputType out_val = 0;
-          const auto *cos_table_row = cos_table_.data() + k * in_size;
-          int64_t in_idx = 0;
-          for (int64_t n = 0; n < in_size; n++) {
-            OutputType in_val = in_data[in_idx];
-            in_idx += in_stride;
-            out_val += in_val * cos_table_row[n];
-          }
-          out_data[out_idx] = out_val;
-          out_idx += out_stride;
-        }
+        TransformFrame(out_data, out_stride, out_size, in_data, in_stride, in_size,
+                       fft_work_.data());
     });
 }
 
+template <typename OutputType, typename InputType, int Dims>
+void Dct1DCpu<OutputType, InputType, Dims>::RunFrames(KernelContext &context,
+                                                      const OutTensorCPU<OutputType, Dims> &out,
+                                                      const InTensorCPU<InputType, Dims> &in,
+                                                      int64_t frame_begin,
+                                                      int64_t frame_end) const {
+  assert(axis_ >= 0 && axis_ < Dims);
+  const int64_t n = in.shape[axis_];
+  const int64_t ndct = out.shape[axis_];
+  // the frame f starts at (f / inner, 0, f % inner), with the dimensions around the axis collapsed
+  const int64_t inner = volume(in.shape.begin() + axis_ + 1, in.shape.end());
+  assert(frame_begin >= 0 && frame_end <= (n > 0 ? volume(in.shape) / n : 0));
+  // the work buffer of the kernel is used by Run - the concurrent calls need their own
+  std::vector<std::complex<OutputType>> fft_work(use_fft_ ? n : 0);
+  for (int64_t f = frame_begin; f < frame_end; f++) {
+    int64_t outer_idx = f / inner, inner_idx = f % inner;
+    TransformFrame(out.data + (outer_idx * ndct * inner + inner_idx), inner, ndct,
+                   in.data + (outer_idx * n * inner + inner_idx), inner, n, fft_work.data());
+  }
+}
+
 template class Dct1DCpu<float, float, 1>;
 template class Dct1DCpu<float, float, 2>;
 template class Dct1DCpu<float, float, 3>;
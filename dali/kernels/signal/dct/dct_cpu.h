@@ -1,4 +1,4 @@
-// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2019-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -15,6 +15,7 @@
 #ifndef DALI_KERNELS_SIGNAL_DCT_DCT_CPU_H_
 #define DALI_KERNELS_SIGNAL_DCT_DCT_CPU_H_
 
+#include <complex>
 #include <memory>
 #include <vector>
 #include "dali/core/common.h"
@@ -37,6 +38,9 @@ namespace dct {
  *          https://en.wikipedia.org/wiki/Discrete_cosine_transform
  *          DCT generally stands for type II and inverse DCT stands for DCT type III
  *
+ * @remarks Large power-of-two DCTs of types II and III are computed with a complex FFT of
+ *          the same length (Makhoul's algorithm), instead of the cosine table - see `UseFftDct`
+ *
  * @see DCTArgs
  */
 template <typename OutputType = float,  typename InputType = float, int Dims = 2>
@@ -57,8 +61,29 @@ class DLL_PUBLIC Dct1DCpu {
                       const OutTensorCPU<OutputType, Dims> &out,
                       const InTensorCPU<InputType, Dims> &in,
                       const DctArgs &args, int axis);
+
+  /**
+   * @brief Transforms only the frames [frame_begin, frame_end) of the input
+   *
+   * The frames are the 1D signals along the transform axis, indexed in the order of
+   * the remaining dimensions. `out` and `in` are the whole tensors. Unlike Run, it can be
+   * called concurrently for disjoint ranges of frames.
+   */
+  DLL_PUBLIC void RunFrames(KernelContext &context,
+                            const OutTensorCPU<OutputType, Dims> &out,
+                            const InTensorCPU<InputType, Dims> &in,
+                            int64_t frame_begin, int64_t frame_end) const;
+
  private:
+  void TransformFrame(OutputType *out, int64_t out_stride, int64_t out_size,
+                      const InputType *in, int64_t in_stride, int64_t in_size,
+                      std::complex<OutputType> *fft_work) const;
+
+  /// the cosine table or, with `use_fft_`, the table of `FillFftDctTable`
   std::vector<OutputType> cos_table_;
+  bool use_fft_ = false;
+  std::vector<int> bitrev_;
+  std::vector<std::complex<OutputType>> fft_work_;
   DctArgs args_;
   int axis_;
 };
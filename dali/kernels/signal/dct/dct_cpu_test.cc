@@ -1,4 +1,4 @@
-// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2019-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -148,6 +148,38 @@ TEST_P(Dct1DCpuTest, DctTest) {
   }
 }
 
+TEST_P(Dct1DCpuTest, RunFrames) {
+  Dct1DCpu<float, float, 2> kernel;
+  if (normalize_ && dct_type_ == 1) {
+    return;  // Unsupported, skip this test.
+  }
+  KernelContext ctx;
+  DctArgs args;
+  args.dct_type = dct_type_;
+  args.normalize = normalize_;
+  args.ndct = ndct_;
+  auto reqs = kernel.Setup(ctx, in_view_, args, axis_);
+  ScratchpadAllocator scratch_alloc;
+  scratch_alloc.Reserve(reqs.scratch_sizes);
+  auto scratchpad = scratch_alloc.GetScratchpad();
+  ctx.scratchpad = &scratchpad;
+
+  auto out_shape = reqs.output_shapes[0][0].to_static<2>();
+  std::vector<float> ref_data(volume(out_shape)), out_data(volume(out_shape), -1);
+  auto ref = make_tensor_cpu<2>(ref_data.data(), out_shape);
+  auto out = make_tensor_cpu<2>(out_data.data(), out_shape);
+  kernel.Run(ctx, ref, in_view_, args, axis_);
+
+  // the frames are transformed in uneven ranges, in reverse order
+  int64_t nframes = in_view_.shape[1 - axis_];
+  int64_t split1 = nframes / 3, split2 = nframes / 3 + nframes / 2;
+  kernel.RunFrames(ctx, out, in_view_, split2, nframes);
+  kernel.RunFrames(ctx, out, in_view_, split1, split2);
+  kernel.RunFrames(ctx, out, in_view_, 0, split1);
+  for (size_t i = 0; i < ref_data.size(); i++)
+    ASSERT_EQ(ref_data[i], out_data[i]) << " at " << i;
+}
+
 INSTANTIATE_TEST_SUITE_P(Dct1DCpuTest, Dct1DCpuTest, testing::Combine(
     testing::Values(std::array<int64_t, 2>{8, 8},
                     std::array<int64_t, 2>{100, 80}),  // shape
@@ -157,6 +189,16 @@ INSTANTIATE_TEST_SUITE_P(Dct1DCpuTest, Dct1DCpuTest, testing::Combine(
     testing::Values(-1, 4)  // ndct
   ));  // NOLINT
 
+// power-of-two lengths computed with FFT (types II and III) or with the cosine table
+INSTANTIATE_TEST_SUITE_P(Dct1DCpuFftTest, Dct1DCpuTest, testing::Combine(
+    testing::Values(std::array<int64_t, 2>{3, 256},
+                    std::array<int64_t, 2>{1024, 2}),  // shape
+    testing::Values(2, 3),  // dct_type
+    testing::Values(0, 1),  // axis
+    testing::Values(false, true),  // normalize
+    testing::Values(-1, 40)  // ndct
+  ));  // NOLINT
+
 }  // namespace test
 }  // namespace dct
 }  // namespace signal
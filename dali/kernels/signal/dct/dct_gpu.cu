@@ -113,6 +113,87 @@ __global__ void ApplyDctInner(const typename Dct1DGpu<OutputType, InputType>::Sa
   }
 }
 
+/**
+ * @brief Computes DCT-II or DCT-III with a radix-2 FFT in shared memory (Makhoul's algorithm)
+ *
+ * The data is reduced to 3D and the transform is applied over the middle axis, like in
+ * `ApplyDct`. Each block transforms whole rows of one sample (blockIdx.y), one row at a time.
+ * The table of the sample is the one filled by `FillFftDctTable`.
+ */
+template <typename T, bool HasLifter>
+__global__ void ApplyDctFft(const typename Dct1DGpu<T, T>::SampleDesc *samples,
+                            const float *lifter_coeffs) {
+  extern __shared__ char fft_shm[];
+  const auto &sample = samples[blockIdx.y];
+  const int n = sample.input_length;
+  const int log2n = __ffs(n) - 1;
+  T *re = reinterpret_cast<T *>(fft_shm);
+  T *im = re + n;
+  const T *fft_twiddles = sample.cos_table;
+  const T *shift = sample.cos_table + n;
+  const T scale0 = sample.cos_table[3 * n], scale = sample.cos_table[3 * n + 1];
+  const bool inverse = sample.dct_type == 3;
+  const int tid = threadIdx.x;
+  const int64_t inner = sample.in_stride[1];
+
+  for (int64_t row = blockIdx.x; row < sample.nrows; row += gridDim.x) {
+    int64_t z = row / inner, x = row - z * inner;
+    const T *in = sample.input + z * sample.in_stride[0] + x;
+    T *out = sample.output + z * sample.out_stride[0] + x;
+    int64_t in_step = sample.in_stride[1], out_step = sample.out_stride[1];
+
+    __syncthreads();  // the previous row is no longer used
+    if (!inverse) {
+      for (int i = tid; i < n; i += blockDim.x) {
+        int m = i < n / 2 ? 2 * i : 2 * (n - 1 - i) + 1;
+        int j = __brev(i) >> (32 - log2n);
+        re[j] = in[m * in_step];
+        im[j] = 0;
+      }
+    } else {
+      for (int k = tid; k < n; k += blockDim.x) {
+        T a = in[k * in_step] * (k ? scale : scale0);
+        T b = k ? in[(n - k) * in_step] * scale : T(0);
+        T c = shift[2 * k], s = shift[2 * k + 1];
+        int j = __brev(k) >> (32 - log2n);
+        re[j] = T(0.5) * (a * c + b * s);
+        im[j] = T(0.5) * (a * s - b * c);
+      }
+    }
+    __syncthreads();
+
+    for (int len = 2; len <= n; len <<= 1) {
+      int half = len >> 1, tw_step = n / len;
+      for (int b = tid; b < n / 2; b += blockDim.x) {
+        int j = b & (half - 1);
+        int i0 = (b - j) * 2 + j, i1 = i0 + half;
+        T wr = fft_twiddles[2 * j * tw_step];
+        T wi = fft_twiddles[2 * j * tw_step + 1];
+        if (inverse)
+          wi = -wi;
+        T tr = wr * re[i1] - wi * im[i1];
+        T ti = wr * im[i1] + wi * re[i1];
+        T ur = re[i0], ui = im[i0];
+        re[i0] = ur + tr;
+        im[i0] = ui + ti;
+        re[i1] = ur - tr;
+        im[i1] = ui - ti;
+      }
+      __syncthreads();
+    }
+
+    for (int k = tid; k < sample.ndct; k += blockDim.x) {
+      T value;
+      if (!inverse) {
+        value = (re[k] * shift[2 * k] + im[k] * shift[2 * k + 1]) * (k ? scale : scale0);
+      } else {
+        value = re[k % 2 == 0 ? k / 2 : n - 1 - k / 2];
+      }
+      out[k * out_step] = HasLifter ? value * lifter_coeffs[k] : value;
+    }
+  }
+}
+
 template <typename OutputType, typename InputType>
 KernelRequirements Dct1DGpu<OutputType, InputType>::Setup(KernelContext &ctx,
                                                           const InListGPU<InputType> &in,
@@ -131,6 +212,12 @@ KernelRequirements Dct1DGpu<OutputType, InputType>::Setup(KernelContext &ctx,
   DALI_ENFORCE(axis_ >= 0 && axis_ < dims,
                make_string("Axis is out of bounds: ", axis_));
   inner_axis_ = true;
+  use_fft_ = args.size() > 0;
+  for (int s = 0; s < args.size(); ++s) {
+    int64_t n = in.tensor_shape_span(s)[axis_];
+    if (!UseFftDct(n, args[s]) || n > kMaxFftLength || args[s].ndct > n)
+      use_fft_ = false;
+  }
   for (int s = 0; s < args.size(); ++s) {
     args_.push_back(args[s]);
     auto &arg = args_.back();
@@ -150,9 +237,10 @@ KernelRequirements Dct1DGpu<OutputType, InputType>::Setup(KernelContext &ctx,
     }
     if (cos_tables_.find({n, arg}) == cos_tables_.end()) {
       cos_tables_[{n, arg}] = nullptr;
-      se.add<mm::memory_kind::device, OutputType>(n * arg.ndct);
-      if (n * arg.ndct > max_cos_table_size_) {
-        max_cos_table_size_ = n * arg.ndct;
+      int64_t table_size = use_fft_ ? FftDctTableSize(n) : n * arg.ndct;
+      se.add<mm::memory_kind::device, OutputType>(table_size);
+      if (table_size > max_cos_table_size_) {
+        max_cos_table_size_ = table_size;
       }
     }
     auto reduced_samle_shape = reduce_shape(in_shape, axis_, arg.ndct);
@@ -168,7 +256,9 @@ KernelRequirements Dct1DGpu<OutputType, InputType>::Setup(KernelContext &ctx,
     se.add<mm::memory_kind::pinned, OutputType>(max_cos_table_size_);
   }
   se.add<mm::memory_kind::device, SampleDesc>(in.num_samples());
-  if (inner_axis_) {
+  if (use_fft_) {
+    // one transform per block - no block setup
+  } else if (inner_axis_) {
     block_setup_inner_.Setup(reduced_shape);
     se.add<mm::memory_kind::device, BlockSetupInner::BlockDesc>(block_setup_inner_.Blocks().size());
   } else {
@@ -199,9 +289,16 @@ DLL_PUBLIC void Dct1DGpu<OutputType, InputType>::Run(KernelContext &ctx,
     DctArgs arg;
     std::tie(n, arg) = table_entry.first;
     CUDA_CALL(cudaEventSynchronize(buffer_event));
-    FillCosineTable(cpu_table, n, arg);
+    int64_t table_size;
+    if (use_fft_) {
+      FillFftDctTable(cpu_table, n, arg);
+      table_size = FftDctTableSize(n);
+    } else {
+      FillCosineTable(cpu_table, n, arg);
+      table_size = n * arg.ndct;
+    }
     table_entry.second = ctx.scratchpad->ToGPU(ctx.gpu.stream,
-                                               span<OutputType>(cpu_table, n * arg.ndct));
+                                               span<OutputType>(cpu_table, table_size));
     CUDA_CALL(cudaEventRecord(buffer_event, ctx.gpu.stream));
     ++i;
   }
@@ -210,6 +307,7 @@ DLL_PUBLIC void Dct1DGpu<OutputType, InputType>::Run(KernelContext &ctx,
   int s = 0;
   int max_ndct = 0;
   int max_input_length = 0;
+  int64_t max_rows = 0;
   for (auto arg : args_) {
     auto in_shape = reduce_shape(in.tensor_shape_span(s), axis_);
     auto out_shape = reduce_shape(out.tensor_shape_span(s), axis_);
@@ -221,13 +319,18 @@ DLL_PUBLIC void Dct1DGpu<OutputType, InputType>::Run(KernelContext &ctx,
     ivec3 in_stride = GetStrides(ivec3{in_shape[0], in_shape[1], in_shape[2]});;
     int n = in_shape[1];
     auto *cos_tables = cos_tables_[{n, arg}];
+    int64_t nrows = in_shape[0] * in_shape[2];
     sample_descs_.push_back(SampleDesc{out.tensor_data(s), in.tensor_data(s),
-                                       cos_tables, in_stride, out_stride, n});
+                                       cos_tables, in_stride, out_stride, n,
+                                       arg.ndct, arg.dct_type, nrows});
     max_ndct = std::max(max_ndct, arg.ndct);
     max_input_length = std::max(max_input_length, n);
+    max_rows = std::max(max_rows, nrows);
     ++s;
   }
-  if (inner_axis_) {
+  if (use_fft_) {
+    RunFftDCT(ctx, max_input_length, max_rows, lifter_coeffs);
+  } else if (inner_axis_) {
     RunInnerDCT(ctx, max_input_length, lifter_coeffs);
   } else {
     RunPlanarDCT(ctx, max_ndct, lifter_coeffs);
@@ -294,6 +397,23 @@ void Dct1DGpu<OutputType, InputType>::RunPlanarDCT(KernelContext &ctx, int max_n
   }
 }
 
+template <typename OutputType, typename InputType>
+void Dct1DGpu<OutputType, InputType>::RunFftDCT(KernelContext &ctx, int64_t max_input_length,
+                                                int64_t max_rows,
+                                                InTensorGPU<float, 1> lifter_coeffs) {
+  SampleDesc *sample_descs_gpu = ctx.scratchpad->ToGPU(ctx.gpu.stream, sample_descs_);
+  int block_size = std::min<int64_t>(256, std::max<int64_t>(max_input_length / 2, 32));
+  dim3 grid_dim(std::max<int64_t>(std::min<int64_t>(max_rows, 1024), 1), sample_descs_.size());
+  size_t shm_size = 2 * sizeof(OutputType) * max_input_length;
+  if (lifter_coeffs.num_elements() > 0) {
+    ApplyDctFft<OutputType, true>
+      <<<grid_dim, block_size, shm_size, ctx.gpu.stream>>>(sample_descs_gpu, lifter_coeffs.data);
+  } else {
+    ApplyDctFft<OutputType, false>
+      <<<grid_dim, block_size, shm_size, ctx.gpu.stream>>>(sample_descs_gpu, nullptr);
+  }
+}
+
 template class Dct1DGpu<float, float>;
 
 template class Dct1DGpu<double, double>;
@@ -1,4 +1,4 @@
-// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2020-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -74,6 +74,10 @@ class BlockSetupInner {
  *          https://en.wikipedia.org/wiki/Discrete_cosine_transform
  *          DCT generally stands for type II and inverse DCT stands for DCT type III
  *
+ * @remarks When `UseFftDct` holds for all the samples, the DCTs are computed with
+ *          a radix-2 FFT in shared memory (Makhoul's algorithm), one transform per block,
+ *          instead of the cosine table.
+ *
  * @see DCTArgs
  */
 template <typename OutputType = float,  typename InputType = OutputType>
@@ -82,12 +86,20 @@ class DLL_PUBLIC Dct1DGpu {
   struct SampleDesc {
     OutputType *output;
     const InputType *input;
+    /// the cosine table or, for the FFT path, the table of `FillFftDctTable`
     const OutputType *cos_table;
     ivec3 in_stride;
     ivec3 out_stride;
     int input_length;
+    /// used by the FFT path
+    int ndct;
+    int dct_type;
+    int64_t nrows;
   };
 
+  /// the longest input for which the FFT path fits in the shared memory
+  static constexpr int kMaxFftLength = 32768 / (2 * sizeof(OutputType));
+
  private:
   /// @brief Calculate the output shape, reduced to 3D
   static TensorShape<3> reduce_shape(span<const int64_t> shape, int axis, int ndct = -1) {
@@ -124,6 +136,9 @@ class DLL_PUBLIC Dct1DGpu {
   void RunPlanarDCT(KernelContext &context, int max_ndct,
                     InTensorGPU<float, 1> lifter_coeffs);
 
+  void RunFftDCT(KernelContext &context, int64_t max_input_length, int64_t max_rows,
+                 InTensorGPU<float, 1> lifter_coeffs);
+
   std::map<std::pair<int, DctArgs>, OutputType*> cos_tables_{};
   std::vector<DctArgs> args_{};
   BlockSetup<3, -1> block_setup_{};
@@ -132,6 +147,7 @@ class DLL_PUBLIC Dct1DGpu {
   int64_t max_cos_table_size_ = 0;
   int axis_ = -1;
   bool inner_axis_ = false;
+  bool use_fft_ = false;
   CUDAEvent buffer_events_[2];
 };
 
@@ -192,6 +192,58 @@ INSTANTIATE_TEST_SUITE_P(Dct1DGpuTest, Dct1DGpuTest, testing::Combine(
   ));  // NOLINT
 
 
+/**
+ * @brief Large power-of-two transforms of types II and III, computed with FFT
+ */
+void TestFftDct(int axis, const TensorListShape<2> &shape, span<const DctArgs> args) {
+  using Kernel = Dct1DGpu<float>;
+  int batch_size = shape.num_samples();
+  KernelContext ctx;
+  ctx.gpu.stream = 0;
+  KernelManager kmgr;
+  kmgr.Initialize<Kernel>();
+  kmgr.Resize<Kernel>(1, 1);
+  TestTensorList<float> in, out;
+  in.reshape(shape);
+  std::mt19937_64 rng{4321};
+  UniformRandomFill(in.cpu(), rng, 0., 1.);
+  auto req = kmgr.Setup<Kernel>(0, ctx, in.gpu(), args, axis);
+  out.reshape(req.output_shapes[0]);
+  kmgr.Run<Kernel>(0, 0, ctx, out.gpu(), in.gpu(), InTensorGPU<float, 1>{});
+  CUDA_CALL(cudaStreamSynchronize(ctx.gpu.stream));
+  auto in_cpu = in.cpu();
+  auto out_cpu = out.cpu();
+  for (int s = 0; s < batch_size; s++) {
+    int64_t n = shape[s][axis];
+    int64_t nframes = shape[s][1 - axis];
+    int ndct = args[s].ndct > 0 ? args[s].ndct : n;
+    int64_t in_stride = axis == 0 ? nframes : 1, in_frame_stride = axis == 0 ? 1 : n;
+    int64_t out_stride = axis == 0 ? nframes : 1, out_frame_stride = axis == 0 ? 1 : ndct;
+    for (int64_t f = 0; f < nframes; f++) {
+      std::vector<float> in_buf(n), ref(ndct);
+      for (int64_t i = 0; i < n; i++)
+        in_buf[i] = in_cpu.tensor_data(s)[f * in_frame_stride + i * in_stride];
+      ReferenceDct(args[s].dct_type, make_span(ref), make_cspan(in_buf), args[s].normalize);
+      for (int k = 0; k < ndct; k++) {
+        ASSERT_NEAR(ref[k], out_cpu.tensor_data(s)[f * out_frame_stride + k * out_stride], 1e-3)
+          << "sample " << s << " frame " << f << " coefficient " << k;
+      }
+    }
+  }
+}
+
+TEST(Dct1DGpuFftTest, InnerAxis) {
+  TensorListShape<2> shape = {{{3, 512}, {2, 256}, {4, 1024}, {1, 512}}};
+  std::vector<DctArgs> args = {{2, false, -1}, {3, true, 100}, {2, true, 64}, {3, false, -1}};
+  TestFftDct(1, shape, make_cspan(args));
+}
+
+TEST(Dct1DGpuFftTest, OuterAxis) {
+  TensorListShape<2> shape = {{{512, 3}, {1024, 5}}};
+  std::vector<DctArgs> args = {{3, true, -1}, {2, false, 200}};
+  TestFftDct(0, shape, make_cspan(args));
+}
+
 class Dct1DGpuPerfTest : public ::testing::TestWithParam<bool> {
  protected:
   Dct1DGpuPerfTest(): inner_(GetParam()) {}
@@ -1,4 +1,4 @@
-// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2020-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -15,7 +15,9 @@
 #ifndef DALI_KERNELS_SIGNAL_DCT_TABLE_H_
 #define DALI_KERNELS_SIGNAL_DCT_TABLE_H_
 
+#include <cassert>
 #include <cmath>
+#include "dali/core/util.h"
 #include "dali/kernels/signal/dct/dct_args.h"
 
 namespace dali {
@@ -107,6 +109,72 @@ void FillCosineTable(T *table, int64_t input_length, DctArgs args) {
   }
 }
 
+/**
+ * @brief The shortest input for which the DCT is computed with an FFT
+ */
+constexpr int64_t kMinFftDctLength = 64;
+
+/**
+ * @brief Decides whether to compute the DCT with an FFT (Makhoul's algorithm),
+ *        in O(n log n), instead of multiplying by the cosine table, in O(n * ndct)
+ *
+ * The FFT path supports DCT types II and III with power-of-two input lengths and pays off
+ * when enough coefficients are requested.
+ */
+inline bool UseFftDct(int64_t input_length, const DctArgs &args) {
+  if (args.dct_type != 2 && args.dct_type != 3)
+    return false;
+  if (input_length < kMinFftDctLength || !is_pow2(input_length))
+    return false;
+  int64_t ndct = args.ndct > 0 ? args.ndct : input_length;
+  return ndct >= 4 * ilog2(input_length);
+}
+
+/**
+ * @brief The number of values in the table filled by `FillFftDctTable`
+ */
+inline int64_t FftDctTableSize(int64_t input_length) {
+  return 3 * input_length + 2;
+}
+
+/**
+ * @brief Fills the table used by the FFT-based DCT
+ *
+ * The layout, with N = input_length, is:
+ * - N/2 complex twiddle factors of the FFT, exp(-2*pi*i*j/N), as (re, im) pairs,
+ * - N complex shifts of Makhoul's algorithm, exp(i*pi*k/(2N)), as (re, im) pairs,
+ * - the scale of the coefficient 0 and the scale of the remaining coefficients.
+ *
+ * For DCT-II, the scales are applied to the outputs; for DCT-III, to the inputs - there, they
+ * include the factor 0.5 of the first input of the unnormalized transform, multiplied by 2,
+ * since the algorithm applies 0.5 to all inputs.
+ */
+template <typename T>
+void FillFftDctTable(T *table, int64_t input_length, DctArgs args) {
+  assert(UseFftDct(input_length, args));
+  int64_t n = input_length;
+  T *fft_twiddles = table;
+  for (int64_t j = 0; j < n / 2; j++) {
+    double phase = -2 * M_PI * j / n;
+    fft_twiddles[2 * j] = std::cos(phase);
+    fft_twiddles[2 * j + 1] = std::sin(phase);
+  }
+  T *shift = table + n;
+  for (int64_t k = 0; k < n; k++) {
+    double phase = M_PI * k / (2 * n);
+    shift[2 * k] = std::cos(phase);
+    shift[2 * k + 1] = std::sin(phase);
+  }
+  T *scale = table + 3 * n;
+  if (args.dct_type == 2) {
+    scale[0] = args.normalize ? 1.0 / std::sqrt(n) : 1.0;
+    scale[1] = args.normalize ? std::sqrt(2.0 / n) : 1.0;
+  } else {
+    scale[0] = args.normalize ? 2.0 / std::sqrt(n) : 1.0;
+    scale[1] = args.normalize ? std::sqrt(2.0 / n) : 1.0;
+  }
+}
+
 }  // namespace dct
 }  // namespace signal
 }  // namespace kernels
@@ -0,0 +1,113 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DALI_KERNELS_SIGNAL_FFT_CUFFT_PLAN_CACHE_H_
+#define DALI_KERNELS_SIGNAL_FFT_CUFFT_PLAN_CACHE_H_
+
+#include <cufft.h>
+#include <cassert>
+#include <list>
+#include <map>
+#include <utility>
+#include "dali/kernels/signal/fft/cufft_helper.h"
+
+namespace dali {
+namespace kernels {
+namespace signal {
+namespace fft {
+
+/**
+ * @brief A cache of batched 1D real-to-complex cuFFT plans, keyed by the transform size
+ *        and the batch size
+ *
+ * The plans are created with the automatic work area allocation disabled - the user must
+ * provide the work area (e.g. from a scratchpad) with `cufftSetWorkArea` before execution.
+ * The plans for at most `max_sizes` distinct transform sizes are kept - requesting a new size
+ * destroys the plans for the least recently used one.
+ */
+class CUFFTPlanCache {
+ public:
+  struct PlanInfo {
+    CUFFTHandle handle;
+    size_t work_size = 0;
+  };
+
+  /// @brief Plans for one transform size, ordered by the batch size
+  using PlanMap = std::map<int, PlanInfo>;
+
+  explicit CUFFTPlanCache(int max_sizes = 4) : max_sizes_(max_sizes) {
+    assert(max_sizes > 0);
+  }
+
+  /**
+   * @brief Returns the plans for given transform size and marks the size as the most
+   *        recently used one
+   *
+   * The reference stays valid until the size is evicted.
+   */
+  PlanMap &Plans(int nfft) {
+    for (auto it = sizes_.begin(); it != sizes_.end(); ++it) {
+      if (it->first == nfft) {
+        sizes_.splice(sizes_.begin(), sizes_, it);
+        return it->second;
+      }
+    }
+    if (static_cast<int>(sizes_.size()) >= max_sizes_)
+      sizes_.pop_back();
+    sizes_.emplace_front(nfft, PlanMap());
+    return sizes_.front().second;
+  }
+
+  /**
+   * @brief Returns a plan for `batch` transforms of size `nfft`, creating it if necessary
+   */
+  PlanInfo &Get(int nfft, int batch) {
+    auto &plans = Plans(nfft);
+    auto it = plans.find(batch);
+    if (it != plans.end())
+      return it->second;
+
+    PlanInfo plan;
+    cufftHandle handle;
+    CUDA_CALL(cufftCreate(&handle));
+    plan.handle.reset(handle);
+    CUDA_CALL(cufftSetAutoAllocation(handle, false));
+    int n[1] = { nfft };
+    CUDA_CALL(cufftMakePlanMany(
+        handle, 1, n,
+        0, 0, 0, 0, 0, 0,
+        CUFFT_R2C, batch, &plan.work_size));
+    return plans.emplace(batch, std::move(plan)).first->second;
+  }
+
+  int num_sizes() const {
+    return sizes_.size();
+  }
+
+  void clear() {
+    sizes_.clear();
+  }
+
+ private:
+  std::list<std::pair<int, PlanMap>> sizes_;
+  int max_sizes_;
+};
+
+}  // namespace fft
+}  // namespace signal
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_SIGNAL_FFT_CUFFT_PLAN_CACHE_H_
@@ -0,0 +1,56 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+#include "dali/kernels/signal/fft/cufft_plan_cache.h"
+
+namespace dali {
+namespace kernels {
+namespace signal {
+namespace fft {
+
+TEST(CUFFTPlanCache, Reuse) {
+  CUFFTPlanCache cache;
+  auto &plan = cache.Get(256, 16);
+  EXPECT_TRUE(plan.handle);
+  EXPECT_EQ(&cache.Get(256, 16), &plan);
+  cufftHandle handle = plan.handle;
+  auto &other = cache.Get(256, 32);
+  EXPECT_NE(other.handle, handle);
+  EXPECT_EQ(cache.num_sizes(), 1);
+
+  auto &plans = cache.Plans(256);
+  ASSERT_EQ(plans.size(), 2u);
+  EXPECT_EQ(plans.begin()->first, 16);
+  EXPECT_EQ(plans.rbegin()->first, 32);
+  EXPECT_EQ(cache.Get(256, 16).handle, handle);
+}
+
+TEST(CUFFTPlanCache, EvictLeastRecentlyUsed) {
+  CUFFTPlanCache cache(2);
+  cache.Get(64, 8);
+  cache.Get(128, 8);
+  EXPECT_EQ(cache.num_sizes(), 2);
+  cache.Plans(64);  // 128 is now the least recently used size
+  cache.Get(256, 8);
+  EXPECT_EQ(cache.num_sizes(), 2);
+  EXPECT_EQ(cache.Plans(64).size(), 1u);
+  EXPECT_EQ(cache.Plans(128).size(), 0u);  // recreated, but empty
+}
+
+}  // namespace fft
+}  // namespace signal
+}  // namespace kernels
+}  // namespace dali
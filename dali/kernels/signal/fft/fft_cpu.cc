@@ -1,4 +1,4 @@
-// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2019-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -13,7 +13,11 @@
 // limitations under the License.
 
 #include "dali/kernels/signal/fft/fft_cpu.h"
+#if FFTW_ENABLED
+#include "dali/kernels/signal/fft/fft_cpu_impl_fftw.h"
+#else
 #include "dali/kernels/signal/fft/fft_cpu_impl_ffts.h"
+#endif
 #include <cmath>
 #include <complex>
 #include "dali/core/common.h"
@@ -28,6 +32,24 @@ namespace kernels {
 namespace signal {
 namespace fft {
 
+namespace {
+
+/**
+ * @brief Creates the FFT backend selected at build time
+ *
+ * FFTW (BUILD_FFTW) is used when available, otherwise the bundled ffts.
+ */
+template <typename OutputType, typename InputType, int Dims>
+std::unique_ptr<impl::FftImpl<OutputType, InputType, Dims>> CreateFftImpl() {
+#if FFTW_ENABLED
+  return std::make_unique<impl::Fft1DImplFftw<OutputType, InputType, Dims>>();
+#else
+  return std::make_unique<impl::Fft1DImplFfts<OutputType, InputType, Dims>>();
+#endif
+}
+
+}  // namespace
+
 template <typename OutputType, typename InputType, int Dims>
 Fft1DCpu<OutputType, InputType, Dims>::~Fft1DCpu() = default;
 
@@ -37,7 +59,7 @@ KernelRequirements Fft1DCpu<OutputType, InputType, Dims>::Setup(
     const InTensorCPU<InputType, Dims> &in,
     const FftArgs &args) {
   if (!impl_ || args != args_) {
-    impl_ = std::make_unique<impl::Fft1DImplFfts<OutputType, InputType, Dims>>();
+    impl_ = CreateFftImpl<OutputType, InputType, Dims>();
     args_ = args;
   }
   return impl_->Setup(context, in, args);
@@ -0,0 +1,215 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/kernels/signal/fft/fft_cpu_impl_fftw.h"
+#include <fftw3.h>
+#include <algorithm>
+#include <complex>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include "dali/core/common.h"
+#include "dali/core/convert.h"
+#include "dali/core/error_handling.h"
+#include "dali/core/format.h"
+#include "dali/core/util.h"
+#include "dali/kernels/kernel.h"
+#include "dali/kernels/signal/fft/fft_cpu_impl_utils.h"
+#include "dali/kernels/common/utils.h"
+
+namespace dali {
+namespace kernels {
+namespace signal {
+namespace fft {
+namespace impl {
+
+namespace {
+
+/// @brief Maximum number of signals transformed in one plan execution
+constexpr int kMaxBatch = 32;
+/// @brief Limits the size of the staging buffers for very long transforms
+constexpr int64_t kMaxBatchSamples = 1 << 20;
+/// @brief Alignment of the staging buffers; covers AVX-512 loads
+constexpr int kBufferAlignment = 64;
+
+}  // namespace
+
+FftwBatchedPlan::~FftwBatchedPlan() {
+  if (plan)
+    fftwf_destroy_plan(plan);
+}
+
+std::shared_ptr<const FftwBatchedPlan> GetFftwPlan(int nfft, int batch) {
+  static std::mutex planner_mutex;
+  static std::map<std::pair<int, int>, std::shared_ptr<const FftwBatchedPlan>> plans;
+  std::lock_guard<std::mutex> guard(planner_mutex);
+  auto &entry = plans[{nfft, batch}];
+  if (!entry) {
+    int nout = nfft / 2 + 1;
+    // the plan is created for arrays with the same layout and alignment as the staging buffers
+    float *in = fftwf_alloc_real(static_cast<size_t>(nfft) * batch);
+    fftwf_complex *out = fftwf_alloc_complex(static_cast<size_t>(nout) * batch);
+    auto plan = std::make_shared<FftwBatchedPlan>();
+    plan->nfft = nfft;
+    plan->batch = batch;
+    plan->plan = fftwf_plan_many_dft_r2c(1, &nfft, batch, in, nullptr, 1, nfft,
+                                         out, nullptr, 1, nout, FFTW_ESTIMATE);
+    fftwf_free(in);
+    fftwf_free(out);
+    DALI_ENFORCE(plan->plan != nullptr,
+      make_string("Could not initialize FFTW plan for nfft = ", nfft, " and batch = ", batch));
+    entry = std::move(plan);
+  }
+  return entry;
+}
+
+template <typename OutputType, typename InputType, int Dims>
+KernelRequirements Fft1DImplFftw<OutputType, InputType, Dims>::Setup(
+    KernelContext &context,
+    const InTensorCPU<InputType, Dims> &in,
+    const FftArgs &args) {
+  constexpr bool is_complex_out = std::is_same<OutputType, std::complex<float>>::value;
+  constexpr bool is_real_out = std::is_same<OutputType, float>::value;
+  DALI_ENFORCE((is_complex_out && args.spectrum_type == FFT_SPECTRUM_COMPLEX)
+            || (is_real_out && args.spectrum_type != FFT_SPECTRUM_COMPLEX),
+    "Output type should be complex<float> or float depending on the requested spectrum type");
+
+  transform_axis_ = args.transform_axis >= 0 ? args.transform_axis : Dims-1;
+  DALI_ENFORCE(transform_axis_ >= 0 && transform_axis_ < Dims,
+    make_string("Transform axis ", transform_axis_, " is out of bounds [0, ", Dims, ")"));
+
+  const auto n = in.shape[transform_axis_];
+  auto nfft = args.nfft > 0 ? args.nfft : n;
+  DALI_ENFORCE(nfft > 0, make_string("Invalid FFT size: ", nfft));
+  int64_t nlines = n > 0 ? volume(in.shape) / n : 0;
+
+  if (nfft != nfft_) {
+    nfft_ = nfft;
+    batch_ = std::max<int64_t>(1, std::min<int64_t>(kMaxBatch, kMaxBatchSamples / nfft));
+    plan_.reset();
+    tail_plan_.reset();
+  }
+  int batch = std::max<int64_t>(1, std::min<int64_t>(batch_, nlines));
+  if (!plan_ || plan_->batch != batch)
+    plan_ = GetFftwPlan(nfft_, batch);
+
+  KernelRequirements req;
+  auto out_shape = in.shape;
+
+  ScratchpadEstimator se;
+  se.add<mm::memory_kind::host, float>(static_cast<int64_t>(nfft) * batch, kBufferAlignment);
+  se.add<mm::memory_kind::host, std::complex<float>>(
+      static_cast<int64_t>(nfft / 2 + 1) * batch, kBufferAlignment);
+  req.scratch_sizes = se.sizes;
+
+  out_shape[transform_axis_] = nfft / 2 + 1;
+  req.output_shapes = {TensorListShape<DynamicDimensions>({out_shape})};
+  return req;
+}
+
+template <typename OutputType, typename InputType, int Dims>
+void Fft1DImplFftw<OutputType, InputType, Dims>::Run(
+    KernelContext &context,
+    const OutTensorCPU<OutputType, Dims> &out,
+    const InTensorCPU<InputType, Dims> &in,
+    const FftArgs &args) {
+  const auto n = in.shape[transform_axis_];
+
+  // Those should be already calculated
+  assert(transform_axis_ >= 0);
+  assert(nfft_ > 0);
+  assert(n <= nfft_);
+  assert(plan_);
+
+  if (n == 0)
+    return;
+
+  const int nout = nfft_ / 2 + 1;
+  const int batch = plan_->batch;
+  const int64_t nlines = volume(in.shape) / n;
+  const int64_t tail = nlines % batch;
+  if (tail > 0 && (!tail_plan_ || tail_plan_->batch != tail))
+    tail_plan_ = GetFftwPlan(nfft_, tail);
+
+  // When the nfft is larger than the window length, we center the window
+  // (padding with zeros on both side)
+  int in_win_start = n < nfft_ ? (nfft_ - n) / 2 : 0;
+
+  float *in_buf = context.scratchpad->AllocateHost<float>(
+      static_cast<int64_t>(nfft_) * batch, kBufferAlignment);
+  auto *out_buf = context.scratchpad->AllocateHost<std::complex<float>>(
+      static_cast<int64_t>(nout) * batch, kBufferAlignment);
+  // r2c transforms preserve the input, so the padding needs to be cleared only once
+  if (n < nfft_)
+    memset(in_buf, 0, static_cast<size_t>(nfft_) * batch * sizeof(float));
+
+  auto in_strides = GetStrides(in.shape);
+  auto out_strides = GetStrides(out.shape);
+  const int64_t in_stride = in_strides[transform_axis_];
+  const int64_t out_stride = out_strides[transform_axis_];
+  // the signals are indexed as (outer, inner), where `inner` spans the dimensions
+  // following the transform axis
+  const int64_t inner = in_stride;
+  assert(out_stride == inner);
+
+  for (int64_t line0 = 0; line0 < nlines; line0 += batch) {
+    int count = std::min<int64_t>(batch, nlines - line0);
+    for (int j = 0; j < count; j++) {
+      int64_t line = line0 + j;
+      int64_t outer_idx = line / inner, inner_idx = line % inner;
+      const InputType *in_data = in.data + outer_idx * n * inner + inner_idx;
+      float *dst = in_buf + static_cast<int64_t>(j) * nfft_ + in_win_start;
+      for (int64_t i = 0; i < n; i++)
+        dst[i] = ConvertSat<float>(in_data[i * in_stride]);
+    }
+
+    const auto &plan = count == batch ? plan_ : tail_plan_;
+    fftwf_execute_dft_r2c(plan->plan, in_buf, reinterpret_cast<fftwf_complex *>(out_buf));
+
+    for (int j = 0; j < count; j++) {
+      int64_t line = line0 + j;
+      int64_t outer_idx = line / inner, inner_idx = line % inner;
+      OutputType *out_data = out.data + outer_idx * nout * inner + inner_idx;
+      const auto *spectrum = out_buf + static_cast<int64_t>(j) * nout;
+      if (args.spectrum_type == FFT_SPECTRUM_COMPLEX) {
+        auto *complex_out = reinterpret_cast<std::complex<float> *>(out_data);
+        for (int i = 0; i < nout; i++)
+          complex_out[i * out_stride] = spectrum[i];
+      } else {
+        MagnitudeSpectrumCalculator().Calculate(
+          args.spectrum_type, out_data, spectrum, nout, out_stride, 1);
+      }
+    }
+  }
+}
+
+// 1 Dim, typically input (time), producing output (frequency)
+template class Fft1DImplFftw<std::complex<float>, float, 1>;  // complex fft
+template class Fft1DImplFftw<float, float, 1>;  // magnitude
+
+// 2 Dims, typically input (channels, time), producing output (channels, frequency)
+template class Fft1DImplFftw<std::complex<float>, float, 2>;
+template class Fft1DImplFftw<float, float, 2>;
+
+// 3 Dims, typically input (channels, frames, time), producing output (channels, frames, frequency)
+template class Fft1DImplFftw<std::complex<float>, float, 3>;
+template class Fft1DImplFftw<float, float, 3>;
+
+}  // namespace impl
+}  // namespace fft
+}  // namespace signal
+}  // namespace kernels
+}  // namespace dali
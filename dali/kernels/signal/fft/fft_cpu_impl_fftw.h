@@ -0,0 +1,94 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_KERNELS_SIGNAL_FFT_FFT_CPU_IMPL_FFTW_H_
+#define DALI_KERNELS_SIGNAL_FFT_FFT_CPU_IMPL_FFTW_H_
+
+#include <fftw3.h>
+#include <memory>
+#include <complex>
+#include "dali/core/common.h"
+#include "dali/core/error_handling.h"
+#include "dali/core/format.h"
+#include "dali/core/util.h"
+#include "dali/kernels/kernel.h"
+#include "dali/kernels/signal/fft/fft_cpu.h"
+
+namespace dali {
+namespace kernels {
+namespace signal {
+namespace fft {
+namespace impl {
+
+/**
+ * @brief Real-to-complex FFT plan shared by all kernel instances in the process
+ *
+ * The plan transforms `batch` contiguous signals of length `nfft`, producing `nfft/2+1`
+ * contiguous complex values per signal. It's executed with the new-array execute functions,
+ * which are thread safe.
+ */
+struct FftwBatchedPlan {
+  fftwf_plan plan = nullptr;
+  int nfft = 0;
+  int batch = 0;
+  ~FftwBatchedPlan();
+};
+
+/**
+ * @brief Returns a (cached) batched plan for given transform size and batch size
+ *
+ * The plans are created once per process and kept until it exits. Plan creation is serialized,
+ * because the FFTW planner is not thread safe.
+ */
+DLL_PUBLIC std::shared_ptr<const FftwBatchedPlan> GetFftwPlan(int nfft, int batch);
+
+/**
+ * @brief FFTW backend of Fft1DCpu
+ *
+ * All 1D signals along the transform axis have the same length, so they're gathered into
+ * batches and transformed with a single plan execution per batch.
+ */
+template <typename OutputType = std::complex<float>, typename InputType = float, int Dims = 2>
+class DLL_PUBLIC Fft1DImplFftw : public FftImpl<OutputType, InputType, Dims> {
+ public:
+  static_assert(std::is_same<InputType, float>::value,
+    "Data types other than float are not yet supported");
+
+  static_assert(std::is_same<OutputType, float>::value
+             || std::is_same<OutputType, std::complex<float>>::value,
+    "Data types other than float are not yet supported");
+
+  DLL_PUBLIC KernelRequirements Setup(KernelContext &context,
+                                      const InTensorCPU<InputType, Dims> &in,
+                                      const FftArgs &args) override;
+
+  DLL_PUBLIC void Run(KernelContext &context,
+                      const OutTensorCPU<OutputType, Dims> &out,
+                      const InTensorCPU<InputType, Dims> &in,
+                      const FftArgs &args) override;
+
+ private:
+  std::shared_ptr<const FftwBatchedPlan> plan_, tail_plan_;
+  int nfft_ = -1;
+  int batch_ = 0;
+  int transform_axis_ = -1;
+};
+
+}  // namespace impl
+}  // namespace fft
+}  // namespace signal
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_SIGNAL_FFT_FFT_CPU_IMPL_FFTW_H_
@@ -22,7 +22,6 @@ namespace signal {
 namespace fft {
 
 void StftImplGPU::Reset() {
-  plans_.clear();
   post_complex_.reset();
   post_real_.reset();
 }
@@ -121,23 +120,36 @@ void StftImplGPU::CreatePlans(int64_t nwindows) {
   max_windows_ = max_windows;
   min_windows_ = std::min(max_windows_, next_pow2(kMinSize / transform_size()));
 
-  int n[1] = { transform_size() };
-  for (int w = max_windows_; w >= min_windows_; w >>= 1) {
-    auto &plan = plans_[w];
-    if (!plan.handle) {
-      cufftHandle handle;
-      CUDA_CALL(cufftCreate(&handle));
-      plan.handle.reset(handle);
-      CUDA_CALL(cufftSetAutoAllocation(handle, false));
-      plan.work_size = 0;
-      CUDA_CALL(cufftMakePlanMany(
-          handle, 1, n,
-          0, 0, 0, 0, 0, 0,
-          CUFFT_R2C, w, &plan.work_size));
-    }
-  }
+  for (int w = max_windows_; w >= min_windows_; w >>= 1)
+    plans_.Get(transform_size(), w);
+
+  PlanTransforms();
+  CreateStreams(std::min<int>(plan_batches_.size(), kMaxStreams + 0 /* clang bug */));
+}
 
-  CreateStreams(std::min<int>(plans_.size(), kMaxStreams + 0 /* clang bug */));
+/**
+ * @brief Decomposes the windows into batches, using the largest plans available
+ *
+ * The plans created for the previous, larger batches are used, too.
+ * The total batch size may actually be greater than the number of windows taken from the input.
+ * It's OK, since the intermediate buffers are overallocated.
+ * This helps us reduce the number of cuFFT calls for batch sizes difficult to decompose
+ * to powers of 2.
+ */
+void StftImplGPU::PlanTransforms() {
+  auto &plans = plans_.Plans(transform_size());
+  plan_batches_.clear();
+  int64_t windows_left = total_windows_;
+  int64_t max_plan = num_temp_windows();
+  while (windows_left > 0) {
+    auto it = plans.upper_bound(max_plan);
+    assert(it != plans.begin());
+    --it;
+    int batch = it->first;
+    plan_batches_.push_back(batch);
+    windows_left -= batch;
+    max_plan -= batch;
+  }
 }
 
 void StftImplGPU::CreateStreams(int new_num_streams) {
@@ -158,23 +170,15 @@ void StftImplGPU::ReserveTempStorage(ScratchpadEstimator &se) {
   // transform output
   se.add<mm::memory_kind::device, float2>(num_temp_windows() * transform_out_size());
 
-  int windows_left = total_windows_;
-  int max_plan = num_temp_windows();
-
+  auto &plans = plans_.Plans(transform_size());
   size_t max_work = 0;
-  while (windows_left > 0) {
-    auto it = plans_.upper_bound(max_plan);
-    assert(it != plans_.begin());
-    --it;
-    int batch = it->first;
-    max_work = std::max(max_work, it->second.work_size);
-    windows_left -= batch;
-    max_plan -= batch;
-  }
+  for (int batch : plan_batches_)
+    max_work = std::max(max_work, plans[batch].work_size);
 
   max_work_size_ = max_work;
 
-  for (size_t i = 0; i < streams_.size(); i++)
+  // one work area per stream actually used
+  for (size_t i = 0; i < num_work_areas(); i++)
     // make each allocation aligned to a complex number
     se.add<mm::memory_kind::device, char>(max_work, alignof(double2));
 }
@@ -251,19 +255,13 @@ void StftImplGPU::RunTransform(ExecutionContext &ctx) {
   float *fft_in = transform_in_.data[0];
 
   SmallVector<char *, kMaxStreams> work;
-  for (size_t i = 0; i < streams_.size(); i++)
+  work.resize(num_work_areas());
+  for (size_t i = 0; i < num_work_areas(); i++)
     work[i] = ctx.scratchpad()->AllocateGPU<char>(max_work_size_, 16);
 
-  int64_t windows_left = total_windows_;
-  int64_t max_plan = num_temp_windows();
-
+  auto &plans = plans_.Plans(transform_size());
   int64_t in_ofs = 0, out_ofs = 0;
 
-  // Max_plan may actually be greater than the number of windows taken from the input.
-  // It's OK, since the intermediate buffers are overallocated.
-  // This helps us reduce the number of cuFFT calls for batch sizes difficult to decompose
-  // to powers of 2.
-
   int calls = 0;
   int max_stream = -1;
   int stream_idx = 0;
@@ -271,26 +269,19 @@ void StftImplGPU::RunTransform(ExecutionContext &ctx) {
   if (!main_stream_ready_)
     main_stream_ready_ = CUDAEvent::Create();
   CUDA_CALL(cudaEventRecord(main_stream_ready_, ctx.stream()));
-  while (windows_left > 0) {
-    auto it = plans_.upper_bound(max_plan);
-    assert(it != plans_.begin());
-    --it;
-    int64_t batch = it->first;  // widen for multiplication
-
+  for (int64_t batch : plan_batches_) {  // widen for multiplication
     max_stream = std::max(max_stream, stream_idx);
-    PlanInfo &pi = it->second;
+    PlanInfo &pi = plans[batch];
     if (first_round)
       CUDA_CALL(cudaStreamWaitEvent(streams_[stream_idx].stream, main_stream_ready_, 0));
     CUDA_CALL(cufftSetStream(pi.handle, streams_[stream_idx].stream));
     CUDA_CALL(cufftSetWorkArea(pi.handle, work[stream_idx]));
     CUDA_CALL(cufftExecR2C(pi.handle, fft_in + in_ofs, fft_out + out_ofs));
     calls++;
-    windows_left -= batch;
-    max_plan -= batch;
     in_ofs += batch * transform_in_size();
     out_ofs += batch * transform_out_size();
     stream_idx++;
-    if (stream_idx >= static_cast<int>(streams_.size())) {
+    if (stream_idx >= static_cast<int>(num_work_areas())) {
       stream_idx = 0;
       first_round = false;
     }
@@ -26,6 +26,7 @@
 #include "dali/kernels/kernel_req.h"
 #include "dali/kernels/signal/fft/stft_gpu.h"
 #include "dali/kernels/signal/fft/cufft_helper.h"
+#include "dali/kernels/signal/fft/cufft_plan_cache.h"
 #include "dali/kernels/signal/window/extract_windows_gpu.h"
 #include "dali/kernels/signal/fft/fft_postprocess.cuh"
 
@@ -65,6 +66,7 @@ class StftImplGPU {
   // setup functions
 
   void CreatePlans(int64_t nwindows);
+  void PlanTransforms();
   void CreateStreams(int new_num_streams);
   void ReserveTempStorage(ScratchpadEstimator &se);
   void SetupWindowExtraction(KernelContext &ctx, ScratchpadEstimator &se,
@@ -103,16 +105,28 @@ class StftImplGPU {
   inline int transform_out_size() const {
     return (transform_size() + 2) / 2;
   }
+  inline size_t num_work_areas() const {
+    return std::min(streams_.size(), plan_batches_.size());
+  }
   inline int64_t num_temp_windows() const {
     assert(is_pow2(min_windows_));
     return align_up(total_windows_, min_windows_);
   }
 
-  struct PlanInfo {
-    CUFFTHandle handle;
-    size_t work_size = 0;
-  };
-  std::map<int, PlanInfo> plans_;
+  using PlanInfo = CUFFTPlanCache::PlanInfo;
+
+  /**
+   * @brief Plans for all transform sizes used so far
+   *
+   * The plans depend only on the transform size and the batch size, so they survive
+   * the changes of the other arguments.
+   */
+  CUFFTPlanCache plans_;
+
+  /**
+   * @brief The batch sizes of the consecutive cuFFT calls, covering all windows
+   */
+  std::vector<int> plan_batches_;
   struct Stream {
     CUDAStream stream;
     CUDAEvent event;
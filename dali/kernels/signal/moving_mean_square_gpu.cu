@@ -0,0 +1,208 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "dali/kernels/signal/moving_mean_square_gpu.h"
+#include <type_traits>
+#include <vector>
+#include "dali/core/cuda_utils.h"
+#include "dali/kernels/reduce/reduce_common.cuh"
+#include "dali/kernels/reduce/reductions.h"
+
+namespace dali {
+namespace kernels {
+namespace signal {
+
+namespace {
+
+constexpr int kBlockDimY = 8;
+constexpr int kBlockSize = 32 * kBlockDimY;
+
+/**
+ * Same accumulator as in the CPU variant: small integers are accumulated exactly,
+ * everything else in single precision
+ */
+template <typename T>
+using mms_acc_t = std::conditional_t<std::is_integral<T>::value && sizeof(T) <= 2,
+                                     int64_t, float>;
+
+template <typename T>
+bool needs_reset() {
+  return !std::is_same<mms_acc_t<T>, int64_t>::value;
+}
+
+template <typename Acc, typename T>
+DALI_HOST_DEV DALI_FORCEINLINE Acc Square(T val) {
+  Acc res = val;
+  return res * res;
+}
+
+template <typename T>
+struct MMSSampleDesc {
+  const T *in;
+  float *out;
+  int64_t out_len;
+  int window;
+  float mean_factor;
+};
+
+struct MMSBlockDesc {
+  int sample;
+  int64_t start;
+};
+
+inline int GetWindow(int64_t length, const MovingMeanSquareArgs &args) {
+  return std::min<int64_t>(args.window_size, length);
+}
+
+inline int64_t GetOutputLength(int64_t length, const MovingMeanSquareArgs &args) {
+  return length > 0 ? length - GetWindow(length, args) + 1 : 0;
+}
+
+template <typename T>
+int GetTileSize(const MovingMeanSquareArgs &args) {
+  int tile = MovingMeanSquareGpu<T>::kMaxTileSize;
+  if (needs_reset<T>() && args.reset_interval > 0 && args.reset_interval < tile)
+    tile = args.reset_interval;
+  return tile;
+}
+
+/**
+ * @brief Calculates the moving mean square for one tile of `tile_size` outputs
+ *
+ * Each thread processes a contiguous chunk of the tile. The differences of the sum of squares
+ * are summed per chunk, the partial sums are scanned across the block and the chunks are
+ * then traversed again, producing the outputs.
+ *
+ * @remarks blockDim must be (32, kBlockDimY)
+ */
+template <typename T>
+__global__ void MovingMeanSquareKernel(const MMSSampleDesc<T> *samples,
+                                       const MMSBlockDesc *blocks, int tile_size) {
+  using Acc = mms_acc_t<T>;
+  __shared__ Acc partial[kBlockSize];
+  __shared__ Acc window_sum;
+
+  const auto block = blocks[blockIdx.x];
+  const auto &sample = samples[block.sample];
+  const T *in = sample.in + block.start;
+  float *out = sample.out + block.start;
+  const int window = sample.window;
+  const int64_t n = cuda_min<int64_t>(tile_size, sample.out_len - block.start);
+  const int tid = threadIdx.y * blockDim.x + threadIdx.x;
+
+  Acc sum = 0;
+  for (int j = tid; j < window; j += kBlockSize)
+    sum += Square<Acc>(in[j]);
+  if (BlockReduce(sum, reductions::sum()))
+    window_sum = sum;
+
+  const int chunk = div_ceil(tile_size, kBlockSize);
+  const int64_t chunk_start = static_cast<int64_t>(tid) * chunk;
+  const int64_t chunk_end = cuda_min<int64_t>(chunk_start + chunk, n);
+  Acc chunk_sum = 0;
+  for (int64_t k = cuda_max<int64_t>(chunk_start, 1); k < chunk_end; k++)
+    chunk_sum += Square<Acc>(in[k + window - 1]) - Square<Acc>(in[k - 1]);
+  partial[tid] = chunk_sum;
+  __syncthreads();
+
+  // inclusive scan of the partial sums
+  for (int ofs = 1; ofs < kBlockSize; ofs <<= 1) {
+    Acc v = tid >= ofs ? partial[tid - ofs] : Acc(0);
+    __syncthreads();
+    partial[tid] += v;
+    __syncthreads();
+  }
+
+  Acc acc = window_sum + (tid > 0 ? partial[tid - 1] : Acc(0));
+  for (int64_t k = chunk_start; k < chunk_end; k++) {
+    if (k > 0)
+      acc += Square<Acc>(in[k + window - 1]) - Square<Acc>(in[k - 1]);
+    out[k] = acc * sample.mean_factor;
+  }
+}
+
+}  // namespace
+
+template <typename T>
+KernelRequirements MovingMeanSquareGpu<T>::Setup(KernelContext &context,
+                                                 const InListGPU<T, 1> &in,
+                                                 const MovingMeanSquareArgs &args) {
+  DALI_ENFORCE(args.window_size > 0, make_string("window_size must be positive. Received: ",
+                                                 args.window_size));
+  int N = in.num_samples();
+  int tile = GetTileSize<T>(args);
+  TensorListShape<1> out_shape;
+  out_shape.resize(N);
+  int64_t nblocks = 0;
+  for (int i = 0; i < N; i++) {
+    int64_t out_len = GetOutputLength(in.shape[i][0], args);
+    out_shape.set_tensor_shape(i, {out_len});
+    nblocks += div_ceil(out_len, tile);
+  }
+  ScratchpadEstimator se;
+  se.add<mm::memory_kind::device, MMSSampleDesc<T>>(N);
+  se.add<mm::memory_kind::device, MMSBlockDesc>(nblocks);
+  KernelRequirements req;
+  req.output_shapes = {out_shape};
+  req.scratch_sizes = se.sizes;
+  return req;
+}
+
+template <typename T>
+void MovingMeanSquareGpu<T>::Run(KernelContext &context, const OutListGPU<float, 1> &out,
+                                 const InListGPU<T, 1> &in, const MovingMeanSquareArgs &args) {
+  int N = in.num_samples();
+  int tile = GetTileSize<T>(args);
+  std::vector<MMSSampleDesc<T>> samples(N);
+  std::vector<MMSBlockDesc> blocks;
+  for (int i = 0; i < N; i++) {
+    int64_t length = in.shape[i][0];
+    auto &sample = samples[i];
+    sample.in = in.data[i];
+    sample.out = out.data[i];
+    sample.out_len = GetOutputLength(length, args);
+    sample.window = GetWindow(length, args);
+    sample.mean_factor = sample.window > 0 ? 1.0f / sample.window : 0.0f;
+    DALI_ENFORCE(out.shape[i][0] == sample.out_len, make_string(
+        "Unexpected output length at sample ", i, ": ", out.shape[i][0], " expected ",
+        sample.out_len));
+    for (int64_t start = 0; start < sample.out_len; start += tile)
+      blocks.push_back({i, start});
+  }
+  if (blocks.empty())
+    return;
+
+  auto *samples_gpu = context.scratchpad->ToGPU(context.gpu.stream, samples);
+  auto *blocks_gpu = context.scratchpad->ToGPU(context.gpu.stream, blocks);
+  dim3 block(32, kBlockDimY);
+  MovingMeanSquareKernel<<<blocks.size(), block, 0, context.gpu.stream>>>(
+      samples_gpu, blocks_gpu, tile);
+  CUDA_CALL(cudaGetLastError());
+}
+
+template class MovingMeanSquareGpu<double>;
+template class MovingMeanSquareGpu<float>;
+template class MovingMeanSquareGpu<uint8_t>;
+template class MovingMeanSquareGpu<int8_t>;
+template class MovingMeanSquareGpu<uint16_t>;
+template class MovingMeanSquareGpu<int16_t>;
+template class MovingMeanSquareGpu<uint32_t>;
+template class MovingMeanSquareGpu<int32_t>;
+template class MovingMeanSquareGpu<uint64_t>;
+template class MovingMeanSquareGpu<int64_t>;
+
+}  // namespace signal
+}  // namespace kernels
+}  // namespace dali
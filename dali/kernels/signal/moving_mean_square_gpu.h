@@ -0,0 +1,57 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DALI_KERNELS_SIGNAL_MOVING_MEAN_SQUARE_GPU_H_
+#define DALI_KERNELS_SIGNAL_MOVING_MEAN_SQUARE_GPU_H_
+
+#include "dali/kernels/kernel.h"
+#include "dali/core/format.h"
+#include "dali/kernels/signal/moving_mean_square_args.h"
+
+namespace dali {
+namespace kernels {
+namespace signal {
+
+/**
+ * @brief Calculates the moving mean square of a batch of 1D signals
+ *
+ * The output for a sample of length `n` has `n - window_size + 1` elements.
+ * Samples shorter than `window_size` use a window equal to their length (one output value),
+ * empty samples produce empty outputs.
+ *
+ * The signal is split into tiles, processed by separate blocks. In each tile, the sum of
+ * squares in the first window is calculated directly and the following ones are obtained
+ * with a prefix sum of the differences between the squares entering and leaving the window.
+ * The sum is, therefore, recalculated at least every `kMaxTileSize` outputs - or more often,
+ * if `reset_interval` is smaller.
+ */
+template <typename InputType>
+class DLL_PUBLIC MovingMeanSquareGpu {
+ public:
+  static constexpr int kMaxTileSize = 4096;
+
+  DLL_PUBLIC KernelRequirements Setup(KernelContext &context,
+                                      const InListGPU<InputType, 1> &in,
+                                      const MovingMeanSquareArgs &args);
+
+  DLL_PUBLIC void Run(KernelContext &context, const OutListGPU<float, 1> &out,
+                      const InListGPU<InputType, 1> &in, const MovingMeanSquareArgs &args);
+};
+
+}  // namespace signal
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_SIGNAL_MOVING_MEAN_SQUARE_GPU_H_
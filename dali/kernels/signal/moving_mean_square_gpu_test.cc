@@ -0,0 +1,97 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include "dali/kernels/scratch.h"
+#include "dali/kernels/signal/moving_mean_square_gpu.h"
+#include "dali/test/tensor_test_utils.h"
+#include "dali/test/test_tensors.h"
+
+namespace dali {
+namespace kernels {
+namespace test {
+
+template <class InputType>
+class MovingMeanSquareGpuTest : public ::testing::Test {
+ public:
+  void RunTest(const TensorListShape<1> &shape, signal::MovingMeanSquareArgs args) {
+    std::mt19937_64 rng(1234);
+    TestTensorList<InputType, 1> in;
+    in.reshape(shape);
+    auto in_cpu = in.cpu();
+    if (std::is_signed<InputType>::value)
+      UniformRandomFill(in_cpu, rng, -100, 100);
+    else
+      UniformRandomFill(in_cpu, rng, 0, 100);
+
+    int N = shape.num_samples();
+    TensorListShape<1> ref_shape;
+    ref_shape.resize(N);
+    for (int i = 0; i < N; i++) {
+      int64_t len = shape[i][0];
+      ref_shape.set_tensor_shape(i, {len > 0 ? len - std::min<int64_t>(args.window_size, len) + 1
+                                             : 0});
+    }
+    TestTensorList<float, 1> ref;
+    ref.reshape(ref_shape);
+    auto ref_cpu = ref.cpu();
+    for (int i = 0; i < N; i++) {
+      int window = std::min<int64_t>(args.window_size, shape[i][0]);
+      for (int64_t k = 0; k < ref_shape[i][0]; k++) {
+        double sumsq = 0;
+        for (int j = 0; j < window; j++) {
+          double v = in_cpu.data[i][k + j];
+          sumsq += v * v;
+        }
+        ref_cpu.data[i][k] = sumsq / window;
+      }
+    }
+
+    signal::MovingMeanSquareGpu<InputType> kernel;
+    KernelContext ctx;
+    ctx.gpu.stream = 0;
+    auto req = kernel.Setup(ctx, in.gpu(), args);
+    ASSERT_EQ(req.output_shapes.size(), 1u);
+    ASSERT_EQ(req.output_shapes[0], ref_shape);
+
+    ScratchpadAllocator sa;
+    sa.Reserve(req.scratch_sizes);
+    auto scratchpad = sa.GetScratchpad();
+    ctx.scratchpad = &scratchpad;
+    TestTensorList<float, 1> out;
+    out.reshape(ref_shape);
+    kernel.Run(ctx, out.gpu(), in.gpu(), args);
+    Check(out.cpu(), ref_cpu, EqualEpsRel(1e-3, 1e-4));
+  }
+};
+
+using TestTypes = ::testing::Types<uint8_t, int16_t, int32_t, float>;
+TYPED_TEST_SUITE(MovingMeanSquareGpuTest, TestTypes);
+
+TYPED_TEST(MovingMeanSquareGpuTest, Batch) {
+  TensorListShape<1> shape = {{ 16000, 5000, 2048, 1000, 1, 0, 20000 }};
+  this->RunTest(shape, { 2048, 8192 });
+}
+
+TYPED_TEST(MovingMeanSquareGpuTest, ShortResetInterval) {
+  TensorListShape<1> shape = {{ 12345, 777 }};
+  this->RunTest(shape, { 100, 500 });
+}
+
+}  // namespace test
+}  // namespace kernels
+}  // namespace dali
@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2020, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2019-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -18,6 +18,7 @@
 #ifdef __SSE2__
 #include <emmintrin.h>
 #endif
+#include <algorithm>
 #include <cmath>
 #include <functional>
 #include <utility>
@@ -98,6 +99,74 @@ inline int64_t resampled_length(int64_t in_length, double in_rate, double out_ra
   return std::ceil(in_length * out_rate / in_rate);
 }
 
+/**
+ * @brief Filter coefficients for each phase of a resampling with a rational rate ratio
+ *
+ * When `in_rate / out_rate == step / phases` (a reduced fraction), the output sample `o` lies
+ * at the input position `o * step / phases`, so the fractional part of the position takes only
+ * `phases` distinct values. The window is evaluated once per phase at the input offsets
+ * `-lobes..lobes`, which reduces the inner loop of resampling to a plain dot product.
+ */
+struct PolyphaseFilterBank {
+  int64_t step = 0, phases = 0;
+  int lobes = 0;
+  std::vector<float> coeffs;  // phases x taps()
+
+  int taps() const { return 2 * lobes + 1; }
+  bool empty() const { return coeffs.empty(); }
+
+  const float *phase_coeffs(int64_t phase) const {
+    return coeffs.data() + phase * taps();
+  }
+};
+
+/**
+ * @brief Reduces `in_rate / out_rate` to `step / phases`
+ *
+ * @return false, if the rates are not integral or the number of phases exceeds `max_phases`
+ */
+inline bool RationalRatio(int64_t &step, int64_t &phases,
+                          double in_rate, double out_rate, int64_t max_phases) {
+  if (!(in_rate > 0 && out_rate > 0 && in_rate < (1 << 30) && out_rate < (1 << 30)))
+    return false;
+  if (in_rate != std::floor(in_rate) || out_rate != std::floor(out_rate))
+    return false;
+  int64_t a = in_rate, b = out_rate;
+  while (b) {
+    int64_t r = a % b;
+    a = b;
+    b = r;
+  }
+  step = static_cast<int64_t>(in_rate) / a;
+  phases = static_cast<int64_t>(out_rate) / a;
+  return phases <= max_phases;
+}
+
+/**
+ * @brief Calculates the polyphase filter bank for given rates
+ *
+ * @return false (and leaves the bank empty) if the rate ratio is not a fraction with at most
+ *         `max_phases` in the denominator
+ */
+inline bool MakePolyphaseFilterBank(PolyphaseFilterBank &bank, const ResamplingWindow &window,
+                                    double in_rate, double out_rate, int64_t max_phases = 1024) {
+  bank.coeffs.clear();
+  if (!RationalRatio(bank.step, bank.phases, in_rate, out_rate, max_phases))
+    return false;
+  bank.lobes = window.lobes;
+  int taps = bank.taps();
+  bank.coeffs.resize(bank.phases * taps);
+  for (int64_t p = 0; p < bank.phases; p++) {
+    float frac = static_cast<double>(p) / bank.phases;
+    float *c = &bank.coeffs[p * taps];
+    for (int k = 0; k < taps; k++) {
+      float x = (k - bank.lobes) - frac;
+      c[k] = std::abs(x) <= bank.lobes ? window(x) : 0.0f;
+    }
+  }
+  return true;
+}
+
 struct Resampler {
   ResamplingWindow window;
 
@@ -117,6 +186,11 @@ struct Resampler {
         Out *__restrict__ out, int64_t out_begin, int64_t out_end, double out_rate,
         const float *__restrict__ in, int64_t n_in, double in_rate) const {
     assert(out_rate > 0 && in_rate > 0 && "Sampling rate must be positive");
+    PolyphaseFilterBank bank;
+    if (MakePolyphaseFilterBank(bank, window, in_rate, out_rate)) {
+      ResamplePolyphase(out, out_begin, out_end, in, n_in, bank);
+      return;
+    }
     int64_t in_pos = 0;
     int64_t block = 1 << 10;  // still leaves 13 significant bits for fractional part
     double scale = in_rate / out_rate;
@@ -164,6 +238,93 @@ struct Resampler {
   }
 
 
+  /**
+   * @brief Resample single-channel signal with a precomputed polyphase filter bank
+   *
+   * The output sample `out_pos` is calculated from the input samples around
+   * `out_pos * bank.step / bank.phases`; the positions are exact, so the result doesn't depend
+   * on how the output is split into chunks.
+   */
+  template <typename Out>
+  static void ResamplePolyphase(
+        Out *__restrict__ out, int64_t out_begin, int64_t out_end,
+        const float *__restrict__ in, int64_t n_in, const PolyphaseFilterBank &bank) {
+    const int lobes = bank.lobes, taps = bank.taps();
+    int64_t base = out_begin * bank.step / bank.phases;
+    int64_t phase = out_begin * bank.step - base * bank.phases;
+    const int64_t step_int = bank.step / bank.phases, step_frac = bank.step % bank.phases;
+    for (int64_t out_pos = out_begin; out_pos < out_end; out_pos++) {
+      const float *__restrict__ c = bank.phase_coeffs(phase);
+      int64_t i0 = base - lobes;
+      float f = 0;
+      if (i0 >= 0 && i0 + taps <= n_in) {
+        const float *__restrict__ src = in + i0;
+        int k = 0;
+#ifdef __SSE2__
+        __m128 f4 = _mm_setzero_ps();
+        for (; k + 4 <= taps; k += 4)
+          f4 = _mm_add_ps(f4, _mm_mul_ps(_mm_loadu_ps(src + k), _mm_loadu_ps(c + k)));
+        f4 = _mm_add_ps(f4, _mm_shuffle_ps(f4, f4, _MM_SHUFFLE(1, 0, 3, 2)));
+        f4 = _mm_add_ps(f4, _mm_shuffle_ps(f4, f4, _MM_SHUFFLE(0, 1, 0, 1)));
+        f = _mm_cvtss_f32(f4);
+#endif
+        for (; k < taps; k++)
+          f += src[k] * c[k];
+      } else {
+        int k0 = std::max<int64_t>(0, -i0);
+        int k1 = std::min<int64_t>(taps, n_in - i0);
+        for (int k = k0; k < k1; k++)
+          f += in[i0 + k] * c[k];
+      }
+      out[out_pos] = ConvertSatNorm<Out>(f);
+      base += step_int;
+      phase += step_frac;
+      if (phase >= bank.phases) {
+        phase -= bank.phases;
+        base++;
+      }
+    }
+  }
+
+  /**
+   * @brief Resample multi-channel signal with a precomputed polyphase filter bank
+   */
+  template <int static_channels = -1, typename Out>
+  static void ResamplePolyphase(
+        Out *__restrict__ out, int64_t out_begin, int64_t out_end,
+        const float *__restrict__ in, int64_t n_in, const PolyphaseFilterBank &bank,
+        int dynamic_num_channels) {
+    const int num_channels = static_channels < 0 ? dynamic_num_channels : static_channels;
+    const int lobes = bank.lobes, taps = bank.taps();
+    SmallVector<float, (static_channels < 0 ? 16 : static_channels)> tmp;
+    tmp.resize(num_channels);
+    int64_t base = out_begin * bank.step / bank.phases;
+    int64_t phase = out_begin * bank.step - base * bank.phases;
+    const int64_t step_int = bank.step / bank.phases, step_frac = bank.step % bank.phases;
+    for (int64_t out_pos = out_begin; out_pos < out_end; out_pos++) {
+      const float *__restrict__ c = bank.phase_coeffs(phase);
+      int64_t i0 = base - lobes;
+      int k0 = std::max<int64_t>(0, -i0);
+      int k1 = std::min<int64_t>(taps, n_in - i0);
+      for (int ch = 0; ch < num_channels; ch++)
+        tmp[ch] = 0;
+      const float *__restrict__ src = in + (i0 + k0) * num_channels;
+      for (int k = k0; k < k1; k++, src += num_channels) {
+        float w = c[k];
+        for (int ch = 0; ch < num_channels; ch++)
+          tmp[ch] += src[ch] * w;
+      }
+      for (int ch = 0; ch < num_channels; ch++)
+        out[out_pos * num_channels + ch] = ConvertSatNorm<Out>(tmp[ch]);
+      base += step_int;
+      phase += step_frac;
+      if (phase >= bank.phases) {
+        phase -= bank.phases;
+        base++;
+      }
+    }
+  }
+
   /**
    * @brief Resample multi-channel signal and convert to Out
    *
@@ -191,6 +352,12 @@ struct Resampler {
     const int num_channels = static_channels < 0 ? dynamic_num_channels : static_channels;
     assert(num_channels > 0);
 
+    PolyphaseFilterBank bank;
+    if (MakePolyphaseFilterBank(bank, window, in_rate, out_rate)) {
+      ResamplePolyphase<static_channels>(out, out_begin, out_end, in, n_in, bank, num_channels);
+      return;
+    }
+
     int64_t in_pos = 0;
     int64_t block = 1 << 10;  // still leaves 13 significant bits for fractional part
     double scale = in_rate / out_rate;
@@ -1,4 +1,4 @@
-// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2019-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <vector>
 #include <numeric>
 #include "dali/kernels/signal/resampling.h"
@@ -103,6 +104,62 @@ TEST(ResampleSinc, MultiChannel) {
     "\n  RMS error: " << err << std::endl;
 }
 
+TEST(ResampleSinc, RationalRatio) {
+  int64_t step = 0, phases = 0;
+  ASSERT_TRUE(RationalRatio(step, phases, 44100, 16000, 1024));
+  EXPECT_EQ(step, 441);
+  EXPECT_EQ(phases, 160);
+  EXPECT_FALSE(RationalRatio(step, phases, 22050, 22053, 1024));  // 7350/7351
+  EXPECT_FALSE(RationalRatio(step, phases, 22050.5, 16000, 1024));
+}
+
+TEST(ResampleSinc, PolyphaseMultiChannel) {
+  int n_in = 22050, n_out = 8000;  // in/out = 441/160
+  int ch = 3;
+  std::vector<float> in(n_in * ch);
+  std::vector<float> out(n_out * ch);
+  std::vector<float> ref(out.size());
+  double in_rate = n_in;
+  double out_rate = n_out;
+  for (int c = 0; c < ch; c++) {
+    float f_in = 0.05f * (1 + c * 0.012345);
+    float f_out = f_in * n_in / n_out;
+    TestWave(in.data() + c, n_in, ch, f_in);
+    TestWave(ref.data() + c, n_out, ch, f_out);
+  }
+  Resampler R;
+  R.Initialize(16);
+  PolyphaseFilterBank bank;
+  ASSERT_TRUE(MakePolyphaseFilterBank(bank, R.window, in_rate, out_rate));
+  EXPECT_EQ(bank.phases, 160);
+  R.Resample(out.data(), 0, n_out, out_rate, in.data(), n_in, in_rate, ch);
+
+  double err = 0;
+  for (int i = 0; i < n_out * ch; i++) {
+    ASSERT_NEAR(out[i], ref[i], 2e-3) << "Sample error too big @" << i << std::endl;
+    float diff = out[i] - ref[i];
+    err += diff*diff;
+  }
+  err = std::sqrt(err/(n_out * ch));
+  EXPECT_LE(err, 1e-3) << "Average error too big";
+}
+
+TEST(ResampleSinc, PolyphaseChunks) {
+  int n_in = 4410, n_out = 1600;
+  std::vector<float> in(n_in);
+  std::vector<float> out(n_out), chunked(n_out);
+  TestWave(in.data(), n_in, 1, 0.1f);
+  Resampler R;
+  R.Initialize(16);
+  R.Resample(out.data(), 0, n_out, n_out, in.data(), n_in, n_in);
+  for (int begin = 0; begin < n_out; begin += 300) {
+    int end = std::min(begin + 300, n_out);
+    R.Resample(chunked.data(), begin, end, n_out, in.data(), n_in, n_in);
+  }
+  for (int i = 0; i < n_out; i++)
+    ASSERT_EQ(out[i], chunked[i]) << " @ " << i;
+}
+
 }  // namespace resampling
 }  // namespace signal
 }  // namespace kernels
@@ -1,4 +1,4 @@
-// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2019-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -47,6 +47,14 @@ struct ExtractWindowsArgs {
   int     window_step = -1;
   int     axis = -1;
   Padding padding = Padding::Zero;
+  /**
+   * @brief Preemphasis coefficient, applied to the signal while extracting the windows.
+   *
+   * When nonzero, the windows are extracted from `y[i] = x[i] - preemph_coeff * x[i-1]`,
+   * with `x[-1] = x[0]`. This is equivalent to running PreemphasisFilter with the "clamp" border
+   * before extracting the windows, but doesn't require an extra pass over the signal.
+   */
+  float   preemph_coeff = 0;
 
   DALI_HOST_DEV
   constexpr inline bool operator==(const ExtractWindowsArgs& oth) const {
@@ -54,7 +62,8 @@ struct ExtractWindowsArgs {
            window_center  == oth.window_center &&
            window_step    == oth.window_step &&
            axis           == oth.axis &&
-           padding        == oth.padding;
+           padding        == oth.padding &&
+           preemph_coeff  == oth.preemph_coeff;
   }
 
   DALI_HOST_DEV DALI_FORCEINLINE
@@ -1,4 +1,4 @@
-// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2019-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -48,6 +48,7 @@ KernelRequirements ExtractWindowsCpu<OutputType, InputType, Dims, vertical>::Set
   window_length_ = args.window_length > 0 ? args.window_length : 1;
   window_step_ = args.window_step > 0 ? args.window_step : 1;
   padding_ = args.padding;
+  preemph_coeff_ = args.preemph_coeff;
   if (padding_ != Padding::None)
     window_center_offset_ = args.window_center < 0 ? window_length_ / 2 : args.window_center;
   else
@@ -99,7 +100,13 @@ void ExtractWindowsCpu<OutputType, InputType, Dims, vertical>::Run(
     const OutTensorCPU<OutputType, OutputDims> &out,
     const InTensorCPU<InputType, InputDims> &in,
     const InTensorCPU<float, 1> &window_fn,
-    const ExtractWindowsArgs &args) {
+    const ExtractWindowsArgs &args,
+    int64_t window_begin,
+    int64_t window_end) const {
+  if (window_end < 0)
+    window_end = nwindows_;
+  assert(window_begin >= 0 && window_begin <= window_end && window_end <= nwindows_);
+  const int64_t nwindows = window_end - window_begin;
 
   auto in_shape = in.shape;
   auto in_strides = GetStrides(in_shape);
@@ -107,36 +114,51 @@ void ExtractWindowsCpu<OutputType, InputType, Dims, vertical>::Run(
   // flat_out_shape is the output shape with both window index and time dimensions combined into
   // one dimension
   auto flat_out_shape = in_shape;
-  flat_out_shape[axis_] = nwindows_ * window_length_;
+  flat_out_shape[axis_] = nwindows * window_length_;
   auto out_strides = GetStrides(flat_out_shape);
 
   ForAxis(
     out.data, in.data, flat_out_shape.data(), out_strides.data(),
     in_shape.data(), in_strides.data(), axis_, InputDims,
-    [this, &window_fn](
+    [this, &window_fn, window_begin, window_end, nwindows](
       OutputType *out_data, const InputType *in_data,
       int64_t out_size, int64_t out_stride, int64_t in_size, int64_t in_stride) {
-        for (int64_t w = 0; w < nwindows_; w++) {
+        // reads the (preemphasized) signal at a valid index
+        auto sample = [&](int64_t idx) -> float {
+          float v = in_data[idx * in_stride];
+          if (preemph_coeff_ != 0)
+            v -= preemph_coeff_ * in_data[(idx > 0 ? idx - 1 : 0) * in_stride];
+          return v;
+        };
+        for (int64_t w = window_begin; w < window_end; w++) {
           int64_t window_start = w * window_step_ - window_center_offset_;
           // Window needs special treatment (falls outside of the signal)
           if (window_start < 0 || window_start + window_length_ > in_size) {
             for (int t = 0; t < window_length_; t++) {
-              int64_t out_idx = vertical ? t * nwindows_ + w : w * window_length_ + t;
+              int64_t out_idx = vertical ? t * nwindows + (w - window_begin)
+                                        : (w - window_begin) * window_length_ + t;
               int64_t in_idx = window_start + t;
               if (padding_ == Padding::Reflect) {
                 // find the mirrored position if the index is out of bounds
                 in_idx = boundary::idx_reflect_101(in_idx, in_size);
                 // at this point we know that in_idx is in valid range
-                out_data[out_idx * out_stride] = window_fn.data[t] * in_data[in_idx * in_stride];
+                out_data[out_idx * out_stride] = window_fn.data[t] * sample(in_idx);
               } else {
                 // force out-of-range values to 0 (and avoid multiplication)
                 out_data[out_idx * out_stride] = (in_idx >= 0 && in_idx < in_size) ?
-                  window_fn.data[t] * in_data[in_idx * in_stride] : 0;
+                  window_fn.data[t] * sample(in_idx) : 0;
               }
             }
+          } else if (preemph_coeff_ != 0) {
+            for (int t = 0; t < window_length_; t++) {
+              int64_t out_idx = vertical ? t * nwindows + (w - window_begin)
+                                        : (w - window_begin) * window_length_ + t;
+              out_data[out_idx * out_stride] = window_fn.data[t] * sample(window_start + t);
+            }
           } else {  // no special treatment for this window (just copy)
             for (int t = 0; t < window_length_; t++) {
-              int64_t out_idx = vertical ? t * nwindows_ + w : w * window_length_ + t;
+              int64_t out_idx = vertical ? t * nwindows + (w - window_begin)
+                                        : (w - window_begin) * window_length_ + t;
               int64_t in_idx = window_start + t;
               out_data[out_idx * out_stride] = window_fn.data[t] * in_data[in_idx * in_stride];
             }
@@ -1,4 +1,4 @@
-// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2019-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -61,6 +61,8 @@ namespace signal {
  *        If false, the signal will be padded with zeros.
  *        This option is only relevant when `window_center` is greater than 0
  *
+ * @param args.preemph_coeff If nonzero, a preemphasis filter is applied to the signal on the fly,
+ *        while the windows are extracted.
  */
 template <typename OutputType = float, typename InputType = float, int Dims = 1,
           bool vertical = true>
@@ -79,11 +81,20 @@ class DLL_PUBLIC ExtractWindowsCpu {
                                       const InTensorCPU<float, 1> &window_fn,
                                       const ExtractWindowsArgs &args);
 
+  /**
+   * @brief Extracts the windows [window_begin, window_end) - by default, all of them
+   *
+   * `out` holds only the extracted windows, i.e. its window index dimension is
+   * `window_end - window_begin`. The disjoint ranges of windows of one input can be extracted
+   * concurrently.
+   */
   DLL_PUBLIC void Run(KernelContext &context,
                       const OutTensorCPU<OutputType, OutputDims> &out,
                       const InTensorCPU<InputType, InputDims> &in,
                       const InTensorCPU<float, 1> &window_fn,
-                      const ExtractWindowsArgs &args);
+                      const ExtractWindowsArgs &args,
+                      int64_t window_begin = 0,
+                      int64_t window_end = -1) const;
 
  private:
   int window_length_ = -1;
@@ -93,6 +104,7 @@ class DLL_PUBLIC ExtractWindowsCpu {
   int window_center_offset_ = 0;
   int64_t nwindows_ = -1;
   Padding padding_ = Padding::Zero;
+  float preemph_coeff_ = 0;
 };
 
 }  // namespace signal
@@ -1,4 +1,4 @@
-// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2019-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -31,7 +31,7 @@ namespace window {
 namespace test {
 
 class ExtractWindowsCpuTest : public::testing::TestWithParam<
-  std::tuple<std::array<int64_t, 2>, int64_t, int64_t, int64_t, int64_t, Padding>> {
+  std::tuple<std::array<int64_t, 2>, int64_t, int64_t, int64_t, int64_t, Padding, float>> {
  public:
   ExtractWindowsCpuTest()
     : data_shape_(std::get<0>(GetParam()))
@@ -40,6 +40,7 @@ class ExtractWindowsCpuTest : public::testing::TestWithParam<
     , axis_(std::get<3>(GetParam()))
     , window_center_(std::get<4>(GetParam()))
     , padding_(std::get<5>(GetParam()))
+    , preemph_coeff_(std::get<6>(GetParam()))
     , data_(volume(data_shape_))
     , in_view_(data_.data(), data_shape_) {}
 
@@ -55,6 +56,7 @@ class ExtractWindowsCpuTest : public::testing::TestWithParam<
   TensorShape<2> data_shape_;
   int window_length_ = -1, window_step_ = -1, axis_ = -1, window_center_ = -1;
   Padding padding_ = Padding::Zero;
+  float preemph_coeff_ = 0;
   std::vector<float> data_;
   OutTensorCPU<float, 2> in_view_;
 };
@@ -101,6 +103,7 @@ void ExtractWindowsCpuTest::RunTest() {
   args.axis = axis_;
   args.window_center = window_center_;
   args.padding = padding_;
+  args.preemph_coeff = preemph_coeff_;
 
   // Hamming window
   std::vector<float> window_fn_data(window_length_);
@@ -141,7 +144,10 @@ void ExtractWindowsCpuTest::RunTest() {
     window_center_offset = window_center_ < 0 ? window_length_ / 2 : window_center_;
   for (int i = 0; i < in_view_.shape[0]; i++) {
     auto *out_slice = expected_out_view.data + i * out_strides[0];
-    auto *in_slice = in_view_.data + i * in_strides[0];
+    auto *in_data = in_view_.data + i * in_strides[0];
+    std::vector<float> in_slice(in_data, in_data + n);
+    for (int k = n - 1; k >= 0; k--)
+      in_slice[k] -= preemph_coeff_ * in_data[k > 0 ? k - 1 : 0];
     for (int w = 0; w < nwindows; w++) {
       for (int t = 0; t < window_length_; t++) {
         auto out_k = vertical ? w + t * nwindows : w * window_length_ + t;
@@ -176,6 +182,26 @@ void ExtractWindowsCpuTest::RunTest() {
     ASSERT_EQ(expected_out[idx], out_view.data[idx]) <<
       "Output data doesn't match reference (idx=" << idx << ")";
   }
+
+  // only a range of windows
+  int64_t window_begin = nwindows / 2, range_nwindows = nwindows - window_begin;
+  auto range_shape = out_shape.to_static<OutputDims>();
+  range_shape[vertical ? 2 : 1] = range_nwindows;
+  std::vector<OutputType> range_out(volume(range_shape));
+  auto range_out_view = OutTensorCPU<OutputType, OutputDims>(range_out.data(), range_shape);
+  kernel.Run(ctx, range_out_view, in_view_, window_fn_view, args, window_begin, nwindows);
+  for (int i = 0; i < in_view_.shape[0]; i++) {
+    for (int w = 0; w < range_nwindows; w++) {
+      for (int t = 0; t < window_length_; t++) {
+        auto pos = vertical ? TensorShape<OutputDims>{i, t, w}
+                            : TensorShape<OutputDims>{i, w, t};
+        auto ref_pos = pos;
+        ref_pos[vertical ? 2 : 1] += window_begin;
+        ASSERT_EQ(*expected_out_view(ref_pos), *range_out_view(pos))
+          << "Window range output doesn't match reference (window " << window_begin + w << ")";
+      }
+    }
+  }
 }
 
 TEST_P(ExtractWindowsCpuTest, Vertical) {
@@ -193,7 +219,8 @@ INSTANTIATE_TEST_SUITE_P(ExtractWindowsCpuTest, ExtractWindowsCpuTest, testing::
     testing::Values(2),  // step
     testing::Values(1),  // axis
     testing::Values(0, 2, 4),  // window offsets
-    testing::Values(Padding::None, Padding::Zero, Padding::Reflect)));  // reflect padding
+    testing::Values(Padding::None, Padding::Zero, Padding::Reflect),  // reflect padding
+    testing::Values(0.0f, 0.97f)));  // preemphasis coefficient
 
 }  // namespace test
 }  // namespace window
@@ -31,6 +31,19 @@ namespace window {
 
 constexpr int kBlock = 32;
 
+/**
+ * @brief Reads a sample at index `idx` from the signal, optionally applying a preemphasis filter
+ *
+ * @param idx must be within [0, length)
+ */
+template <typename Src>
+__device__ DALI_FORCEINLINE float LoadSample(const Src *__restrict__ src, ptrdiff_t idx,
+                                             float preemph_coeff) {
+  float v = ConvertNorm<float>(src[idx]);
+  if (preemph_coeff != 0)
+    v -= preemph_coeff * ConvertNorm<float>(src[idx > 0 ? idx - 1 : 0]);
+  return v;
+}
 
 /**
  *  @brief Extract and store kBlock values from kBlock windows.
@@ -51,6 +64,7 @@ constexpr int kBlock = 32;
  * @param win_center        center of the window function; typically win_len/2
  * @param step              step, in samples, between consecutive windows in the input
  * @param reflect           if true, reflect the signal at ends, otherwise zero-pad
+ * @param preemph_coeff     preemphasis coefficient; 0 disables the preemphasis
  * @param page              which shared memory buffer to use; page flipping
  *                          saves one __syncthreads
  * @tparam num_pages        number of shared memory buffers to use; should be 2 if a single CUDA
@@ -70,6 +84,7 @@ __device__ void ExtractVerticalWindowsBlock(
     int win_center,
     int step,
     bool reflect,
+    float preemph_coeff,
     int page = 0) {
   __shared__ float tmp[num_pages][kBlock][kBlock+1];  // +1 to avoid bank conflicts
   ptrdiff_t in_window_idx = first_window_idx + threadIdx.y;
@@ -83,7 +98,7 @@ __device__ void ExtractVerticalWindowsBlock(
     if (reflect) {
       idx = boundary::idx_reflect_101(idx, length);
     }
-    v = idx >= 0 && idx < length ? ConvertNorm<float>(src[idx]) * w : 0.0f;
+    v = idx >= 0 && idx < length ? LoadSample(src, idx, preemph_coeff) * w : 0.0f;
   }
   tmp[page][threadIdx.y][threadIdx.x] = v;
   __syncthreads();
@@ -115,6 +130,7 @@ __device__ void ExtractVerticalWindowsBlock(
  * @param win_center    center of the window function; typically win_len/2
  * @param step          step, in samples, between consecutive windows in the input
  * @param reflect       if true, reflect the signal at ends, otherwise zero-pad
+ * @param preemph_coeff preemphasis coefficient; 0 disables the preemphasis
  */
 template <typename Dst, typename Src>
 __device__ void ExtractHorizontalWindows(
@@ -125,7 +141,8 @@ __device__ void ExtractHorizontalWindows(
     int win_len,
     int win_center,
     int step,
-    bool reflect) {
+    bool reflect,
+    float preemph_coeff) {
 
   // calculate the index of the first window that sample at `idx ` contributes to
   ptrdiff_t idx0 = idx + win_center - win_len + step;  // add step to round up
@@ -135,10 +152,10 @@ __device__ void ExtractHorizontalWindows(
 
   if (reflect) {
     ptrdiff_t src_idx = boundary::idx_reflect_101(idx, length);
-    value = ConvertSatNorm<float>(src[src_idx]);
+    value = LoadSample(src, src_idx, preemph_coeff);
   } else {
     if (idx >= 0 && idx < length)
-      value = ConvertSatNorm<float>(src[idx]);
+      value = LoadSample(src, idx, preemph_coeff);
   }
 
   for (int win_ofs = idx - (win0 * step - win_center), win_idx = win0;
@@ -159,7 +176,8 @@ __global__ void ExtractVerticalWindowsKernel(
     int in_win_len,
     int win_center,
     int step,
-    bool reflect) {
+    bool reflect,
+    float preemph_coeff = 0) {
   // This kernel reads kBlock elements from kBlock windows to shared memory
   // and stores the transposed result to output in columns.
 
@@ -167,7 +185,8 @@ __global__ void ExtractVerticalWindowsKernel(
     blockIdx.x * kBlock,        // first window index
     dst, num_windows, stride,   // output
     src, length,                // input
-    window, out_win_len, in_win_start, in_win_len, win_center, step, reflect);  // windowing options
+    window, out_win_len, in_win_start, in_win_len, win_center, step, reflect,  // windowing options
+    preemph_coeff);
 }
 
 struct SampleDesc {
@@ -222,7 +241,8 @@ __global__ void ExtractVerticalWindowsBatchedKernel(
     int in_win_len,
     int win_center,
     int step,
-    bool reflect) {
+    bool reflect,
+    float preemph_coeff) {
   int block_idx = blockIdx.x;
   BlockDesc blk = blocks[block_idx];
   SampleDesc sample = samples[blk.sample_idx];
@@ -242,6 +262,7 @@ __global__ void ExtractVerticalWindowsBatchedKernel(
       dst, num_windows, stride,   // output
       src, length,                // input
       window, out_win_len, in_win_start, in_win_len, win_center, step, reflect,  // win options
+      preemph_coeff,
       page);  // page-flipped temporary buffer avoids additional __syncthreads
   }
 }
@@ -261,7 +282,8 @@ __global__ void ExtractHorizontalWindowsBatchedKernel(
     int win_len,
     int win_center,
     int step,
-    bool reflect) {
+    bool reflect,
+    float preemph_coeff) {
   int block_idx = blockIdx.x;
   HorizontalBlockDesc blk = blocks[block_idx];
   SampleDesc sample = samples[blk.sample_idx];
@@ -278,7 +300,7 @@ __global__ void ExtractHorizontalWindowsBatchedKernel(
       pos,                        // input offset
       dst, num_windows, stride,   // output
       src, length,                // input
-      window, win_len, win_center, step, reflect);  // windowing options
+      window, win_len, win_center, step, reflect, preemph_coeff);  // windowing options
   }
 }
 
@@ -470,7 +492,7 @@ struct ExtractVerticalWindowsImplGPU : ExtractWindowsImplGPU<Dst, Src> {
     <<<grid_dim, block_dim, 0, ctx.gpu.stream>>>(
       gpu_samples, gpu_blocks, windows_per_block,
       window.data, out_win_length, in_win_start, args.window_length, args.window_center,
-      args.window_step, args.padding == Padding::Reflect);
+      args.window_step, args.padding == Padding::Reflect, args.preemph_coeff);
     CUDA_CALL(cudaGetLastError());
   }
 
@@ -687,7 +709,7 @@ struct ExtractHorizontalWindowsImplGPU : ExtractWindowsImplGPU<Dst, Src> {
     <<<grid_dim, block_dim, 0, ctx.gpu.stream>>>(
       gpu_samples, gpu_blocks,
       window.data, args.window_length, args.window_center,
-      args.window_step, args.padding == Padding::Reflect);
+      args.window_step, args.padding == Padding::Reflect, args.preemph_coeff);
     CUDA_CALL(cudaGetLastError());
 
     int padding_length = out_win_length - args.window_length;
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <cmath>
 #include <memory>
 #include <vector>
 #include "dali/core/util.h"
@@ -100,7 +101,8 @@ void TestBatchedExtract(
     bool concatenate,
     Padding padding,
     span<const float> window,
-    int out_win_len = -1) {
+    int out_win_len = -1,
+    float preemph_coeff = 0) {
   bool vertical = extract->IsVertical();
 
   ScratchpadAllocator sa;
@@ -125,6 +127,7 @@ void TestBatchedExtract(
   args.window_center = window.empty() ? 21 : window.size()/2;
   args.window_step = 2;
   args.padding = padding;
+  args.preemph_coeff = preemph_coeff;
 
   int out_win_len_actual = out_win_len < 0 ? args.window_length : out_win_len;
   int in_win_start = (out_win_len_actual - args.window_length) / 2;
@@ -181,10 +184,17 @@ void TestBatchedExtract(
         if (args.padding == Padding::Reflect) {
           idx = boundary::idx_reflect_101(idx, length);
         }
-        float ref = idx >= 0 && idx < length ? in_cpu.data[sample][idx] : 0.0f;
+        float ref = 0.0f;
+        if (idx >= 0 && idx < length) {
+          ref = in_cpu.data[sample][idx];
+          if (preemph_coeff != 0)
+            ref -= preemph_coeff * in_cpu.data[sample][idx > 0 ? idx - 1 : 0];
+        }
         if (!window.empty())
           ref *= window[j];
-        ASSERT_EQ(out_cpu.data[out_sample][ofs + i * sample_stride], ref)
+        // the preemphasis may be computed with FMA on the device
+        float eps = preemph_coeff != 0 ? 1e-5f * std::abs(ref) + 1e-5f : 0.0f;
+        ASSERT_NEAR(out_cpu.data[out_sample][ofs + i * sample_stride], ref, eps)
             << "@ sample = " << sample << ", window = " << w << ", index = " << i;
       }
       for (; i < out_win_len_actual; i++) {
@@ -201,14 +211,16 @@ void TestBatchedExtract(
     Padding padding,
     bool vertical,
     span<const float> window,
-    int out_win_len = -1) {
+    int out_win_len = -1,
+    float preemph_coeff = 0) {
   std::unique_ptr<ExtractWindowsImplGPU<float, float>> extract;
   if (vertical)
     extract = std::make_unique<ExtractVerticalWindowsImplGPU<float, float>>();
   else
     extract = std::make_unique<ExtractHorizontalWindowsImplGPU<float, float>>();
 
-  TestBatchedExtract(extract.get(), lengths, concatenate, padding, window, out_win_len);
+  TestBatchedExtract(extract.get(), lengths, concatenate, padding, window, out_win_len,
+                     preemph_coeff);
 }
 
 void TestBatchedExtract(
@@ -216,7 +228,8 @@ void TestBatchedExtract(
     Padding padding,
     bool vertical,
     span<const float> window,
-    int out_win_len = -1) {
+    int out_win_len = -1,
+    float preemph_coeff = 0) {
   std::unique_ptr<ExtractWindowsImplGPU<float, float>> extract;
   if (vertical)
     extract = std::make_unique<ExtractVerticalWindowsImplGPU<float, float>>();
@@ -224,14 +237,16 @@ void TestBatchedExtract(
     extract = std::make_unique<ExtractHorizontalWindowsImplGPU<float, float>>();
 
   TensorListShape<1> lengths = {{ 5, 305, 157 }};
-  TestBatchedExtract(extract.get(), lengths, concatenate, padding, window, out_win_len);
+  TestBatchedExtract(extract.get(), lengths, concatenate, padding, window, out_win_len,
+                     preemph_coeff);
 
   if (vertical)
     extract = std::make_unique<ExtractVerticalWindowsImplGPU<float, float>>();
   else
     extract = std::make_unique<ExtractHorizontalWindowsImplGPU<float, float>>();
   lengths = {{ 137, 203, 150, 12 }};
-  TestBatchedExtract(extract.get(), lengths, concatenate, padding, window, out_win_len);
+  TestBatchedExtract(extract.get(), lengths, concatenate, padding, window, out_win_len,
+                     preemph_coeff);
 }
 
 TEST(ExtractVerticalWindowsGPU, BatchedConcat) {
@@ -260,6 +275,13 @@ TEST(ExtractVerticalWindowsGPU, BatchedSeparateWindowFuncPad) {
   TestBatchedExtract(true, Padding::Reflect, true, make_cspan(window), 72);
 }
 
+TEST(ExtractVerticalWindowsGPU, BatchedPreemphasis) {
+  vector<float> window(60);
+  HannWindow(make_span(window));
+  TestBatchedExtract(true, Padding::Reflect, true, make_cspan(window), 64, 0.97f);
+  TestBatchedExtract(false, Padding::Zero, true, make_cspan(window), -1, 0.5f);
+}
+
 TEST(ExtractHorizontalWindowsGPU, BatchedConcat) {
   TestBatchedExtract(true, Padding::Reflect, false, {});
 }
@@ -292,6 +314,13 @@ TEST(ExtractHorizontalWindowsGPU, BatchedConcatWindowFuncPad) {
   TestBatchedExtract(false, Padding::Reflect, true, make_cspan(window), 72);
 }
 
+TEST(ExtractHorizontalWindowsGPU, BatchedPreemphasis) {
+  vector<float> window(60);
+  HannWindow(make_span(window));
+  TestBatchedExtract(false, Padding::Reflect, false, make_cspan(window), 64, 0.97f);
+  TestBatchedExtract(true, Padding::Zero, false, make_cspan(window), -1, 0.5f);
+}
+
 TEST(ExtractHorizontalWindowsGPU, SizeSweep) {
   int max_size = 2048;
   std::vector<TensorShape<1>> lengths;
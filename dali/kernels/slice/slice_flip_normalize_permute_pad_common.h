@@ -49,6 +49,17 @@ struct SliceFlipNormalizePermutePadArgs {
   SmallVector<float, 8> inv_stddev;
   SmallVector<float, 8> fill_values;
   int channel_dim = -1;
+
+  /**
+   * @brief Gaussian noise added to the input values (with saturation to the input type)
+   *        before they are normalized; supported only by the GPU kernel
+   *
+   * The value for the n-th element of the input sample is generated by cuRAND's Philox
+   * initialized with `noise_seed` and subsequence `n`.
+   */
+  float noise_mean = 0.0f;
+  float noise_stddev = 0.0f;
+  uint64_t noise_seed = 0;
 };
 
 namespace detail {
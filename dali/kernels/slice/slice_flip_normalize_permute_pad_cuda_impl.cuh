@@ -16,6 +16,7 @@
 #define DALI_KERNELS_SLICE_SLICE_FLIP_NORMALIZE_PERMUTE_KERNEL_H_
 
 #include <cuda_runtime.h>
+#include <curand_kernel.h>
 #include <utility>
 #include <vector>
 #include "dali/core/common.h"
@@ -35,6 +36,12 @@ namespace kernels {
 
 namespace detail {
 
+struct NoiseDesc {
+  float mean, stddev;
+  uint64_t seed;
+  uint64_t input_offset;  // offset of the first element of the slice in the input sample
+};
+
 template <int Dims>
 struct SampleDesc {
   void *__restrict__ out;
@@ -51,6 +58,7 @@ struct SampleDesc {
   bool need_pad;
   bool need_flip;
   int effective_ndim;
+  NoiseDesc noise;
 
   fast_div<uint64_t> out_strides[Dims];
   TensorShape<Dims> in_strides;
@@ -67,23 +75,37 @@ DALI_HOST_DEV DALI_FORCEINLINE bool is_out_of_bounds(int64_t idx, int64_t data_e
   return static_cast<uint64_t>(idx) >= static_cast<uint64_t>(data_extent);
 }
 
+/**
+ * @brief Adds Gaussian noise to an input value, the same way noise.Gaussian does
+ *
+ * @param in_idx  index of the element relative to the slice start
+ */
+template <typename In>
+__device__ DALI_FORCEINLINE In AddNoise(In value, const NoiseDesc &noise, uint64_t in_idx) {
+  curandStatePhilox4_32_10_t state;
+  curand_init(noise.seed, noise.input_offset + in_idx, 0, &state);
+  float n = noise.mean + curand_normal(&state) * noise.stddev;
+  return ConvertSat<In>(static_cast<float>(value) + n);
+}
+
 /**
  * @brief General algorithm that allows for padding in any dimension
  * @remarks `in` refers to the slice anchor start
  */
-template <bool NeedFlip, bool NeedNormalize, bool NeedPad, int Dims,
+template <bool NeedFlip, bool NeedNormalize, bool NeedPad, bool NeedNoise, int Dims,
           typename Out, typename In, bool AllDims = true>
 __device__ void SliceFlipNormalizePermutePadFunc(
     Out *__restrict__ out, const In *__restrict__ in,
     const fast_div<uint64_t> *out_strides, const int64_t *in_strides, const int64_t *out_shape,
     const int64_t *in_shape, const int64_t *anchor, const Out *__restrict__ fill_values,
     const float *__restrict__ norm_add, const float *__restrict__ norm_mul, int channel_dim,
-    int effective_ndim, uint64_t offset, uint64_t block_end) {
+    int effective_ndim, const NoiseDesc &noise, uint64_t offset, uint64_t block_end) {
   if (Dims > effective_ndim) {
     const int NextDims = Dims > 1 ? Dims - 1 : 1;
-    SliceFlipNormalizePermutePadFunc<NeedFlip, NeedNormalize, NeedPad, NextDims, Out, In, false>(
+    SliceFlipNormalizePermutePadFunc<NeedFlip, NeedNormalize, NeedPad, NeedNoise, NextDims,
+                                     Out, In, false>(
         out, in, out_strides, in_strides, out_shape, in_shape, anchor, fill_values, norm_add,
-        norm_mul, channel_dim, effective_ndim, offset, block_end);
+        norm_mul, channel_dim, effective_ndim, noise, offset, block_end);
     return;
   }
 
@@ -128,16 +150,20 @@ __device__ void SliceFlipNormalizePermutePadFunc(
 
     if (NeedPad && out_of_bounds) {
       out[out_idx] = fill_values[i_c];
-    } else if (NeedNormalize) {
-      float fpout = fmaf(static_cast<float>(in[in_idx]), norm_mul[i_c], norm_add[i_c]);
+      continue;
+    }
+    In value = NeedNoise ? AddNoise(in[in_idx], noise, in_idx) : in[in_idx];
+    if (NeedNormalize) {
+      float fpout = fmaf(static_cast<float>(value), norm_mul[i_c], norm_add[i_c]);
       out[out_idx] = ConvertSat<Out>(fpout);
     } else {
-      out[out_idx] = ConvertSat<Out>(in[in_idx]);
+      out[out_idx] = ConvertSat<Out>(value);
     }
   }
 }
 
-template <bool NeedPad, bool NeedFlip, bool NeedNormalize, typename Out, typename In, int Dims>
+template <bool NeedPad, bool NeedFlip, bool NeedNormalize, bool NeedNoise,
+          typename Out, typename In, int Dims>
 __global__ void SliceFlipNormalizePermutePadKernel(const SampleDesc<Dims> *samples,
                                                    const BlockDesc *blocks) {
   int sampleIdx = blocks[blockIdx.x].sampleIdx;
@@ -154,10 +180,11 @@ __global__ void SliceFlipNormalizePermutePadKernel(const SampleDesc<Dims> *sampl
   auto *fill_values = static_cast<const Out*>(sample.fill_values);
   VALUE_SWITCH(NeedPad && sample.need_pad, SampleNeedPad, (false, true), (
     VALUE_SWITCH(NeedFlip && sample.need_flip, SampleNeedFlip, (false, true), (
-      SliceFlipNormalizePermutePadFunc<SampleNeedFlip, NeedNormalize, SampleNeedPad, Dims>(
+      SliceFlipNormalizePermutePadFunc<SampleNeedFlip, NeedNormalize, SampleNeedPad, NeedNoise,
+                                       Dims>(
           out, in, out_strides, in_strides, out_shape, in_shape, anchor, fill_values,
           sample.norm_add, sample.norm_mul, sample.channel_dim, sample.effective_ndim,
-          offset, block_end);
+          sample.noise, offset, block_end);
     ), ());  // NOLINT
   ), ());  // NOLINT
 }
@@ -16,6 +16,7 @@
 #define DALI_KERNELS_SLICE_SLICE_FLIP_NORMALIZE_PERMUTE_PAD_GPU_H_
 
 #include <cuda_runtime.h>
+#include <string>
 #include <utility>
 #include <vector>
 #include "dali/core/common.h"
@@ -25,6 +26,7 @@
 #include "dali/core/error_handling.h"
 #include "dali/core/static_switch.h"
 #include "dali/kernels/common/copy.h"
+#include "dali/kernels/common/launch_tuner.h"
 #include "dali/kernels/kernel.h"
 #include "dali/kernels/slice/slice_flip_normalize_permute_pad_common.h"
 #include "dali/kernels/slice/slice_flip_normalize_permute_pad_cuda_impl.cuh"
@@ -37,8 +39,20 @@ class SliceFlipNormalizePermutePadGpu {
  private:
   static constexpr size_t kBlockDim = 512;
   static constexpr size_t kBlockSize = 64 * kBlockDim;
+  /// The candidate numbers of threads per block, chosen by LaunchTuner; the first is kBlockDim
+  static constexpr int kNumThreadCounts = 4;
   size_t block_count_ = 0;
 
+  static int CandidateThreadCount(int idx) {
+    const int counts[kNumThreadCounts] = { kBlockDim, 256, 1024, 128 };
+    return counts[idx];
+  }
+
+  static std::string TuningKey() {
+    return make_string("SliceFlipNormalizePermutePadGpu_", Dims, "D_", sizeof(OutputType), "_",
+                       sizeof(InputType));
+  }
+
   using ProcessedArgs = detail::SliceFlipNormalizePermutePadProcessedArgs<Dims>;
   std::vector<ProcessedArgs> processed_args_;
   int norm_args_size_ = -1;
@@ -128,7 +142,6 @@ class SliceFlipNormalizePermutePadGpu {
            const OutListGPU<OutputType, Dims> &out,
            const InListGPU<InputType, Dims> &in,
            const std::vector<Args> &args) {
-    (void) args;
     if (block_count_ == 0) {
       return;  // no data to copy
     }
@@ -173,7 +186,7 @@ class SliceFlipNormalizePermutePadGpu {
     auto *block_descs_cpu =
         context.scratchpad->AllocateHost<detail::BlockDesc>(block_count_);
 
-    bool need_pad = false, need_flip = false;
+    bool need_pad = false, need_flip = false, need_noise = false;
     for (int i = 0; i < in.size(); i++) {
       const auto in_shape = in.tensor_shape(i);
       auto &processed_args = processed_args_[i];
@@ -197,6 +210,9 @@ class SliceFlipNormalizePermutePadGpu {
       for (int d = 0; d < Dims; d++)
         sample_desc.need_flip |= processed_args.in_strides[d] < 0;
       need_flip |= sample_desc.need_flip;
+      sample_desc.noise = {args[i].noise_mean, args[i].noise_stddev, args[i].noise_seed,
+                           processed_args.input_offset};
+      need_noise |= args[i].noise_mean != 0 || args[i].noise_stddev != 0;
 
       // We fuse the last dimension with the previous IF:
       // 1. There are at least 2 dimensions
@@ -224,9 +240,11 @@ class SliceFlipNormalizePermutePadGpu {
     }
 
     size_t block_idx = 0;
+    int64_t total_size = 0;
     for (int i = 0; i < num_samples; i++) {
       size_t offset = 0;
       size_t remaining = volume(processed_args_[i].out_shape);
+      total_size += remaining;
       while (remaining > 0) {
         size_t size = remaining < kBlockSize ? remaining : kBlockSize;
         block_descs_cpu[block_idx++] = {i, offset, size};
@@ -242,18 +260,25 @@ class SliceFlipNormalizePermutePadGpu {
         make_span(sample_descs_cpu, num_samples),
         make_span(block_descs_cpu, block_count_));
 
+    auto &tuner = LaunchTuner::Get();
+    int thread_count_idx = tuner.Choose(TuningKey(), kNumThreadCounts);
+    int thread_count = CandidateThreadCount(thread_count_idx);
+    auto timer = tuner.Time(TuningKey(), thread_count_idx, total_size, context.gpu.stream);
     BOOL_SWITCH(need_pad, NeedPad, (
       BOOL_SWITCH(need_flip, NeedFlip, (
         BOOL_SWITCH(need_normalize_, NeedNormalize, (
-          auto grid = block_count_;
-          // need to handle __half due to compilation differences
-          detail::SliceFlipNormalizePermutePadKernel
-            <NeedPad, NeedFlip, NeedNormalize,
-            OutputType, InputType, Dims>
-            <<<grid, kBlockDim, 0, context.gpu.stream>>>(sample_descs_gpu, block_descs_gpu);
+          BOOL_SWITCH(need_noise, NeedNoise, (
+            auto grid = block_count_;
+            // need to handle __half due to compilation differences
+            detail::SliceFlipNormalizePermutePadKernel
+              <NeedPad, NeedFlip, NeedNormalize, NeedNoise,
+              OutputType, InputType, Dims>
+              <<<grid, thread_count, 0, context.gpu.stream>>>(sample_descs_gpu, block_descs_gpu);
+          ));  // NOLINT
         ));  // NOLINT
       ));  // NOLINT
     ));  // NOLINT
+    timer.Stop();
 
     CUDA_CALL(cudaGetLastError());
   }
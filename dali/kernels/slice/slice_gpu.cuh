@@ -61,6 +61,8 @@ struct SliceSampleDesc {
   const void *__restrict__ fill_values;
   int channel_dim;
   bool need_pad;
+  /// The sample can be copied with 16-byte loads and stores - see CanVectorizeSlice
+  bool vectorize;
 
   fast_div<uint64_t> out_strides[Dims];
   TensorShape<Dims> in_strides;
@@ -102,6 +104,69 @@ __device__ void SliceFuncNoPad(OutputType *__restrict__ out, const InputType *__
   }
 }
 
+/**
+ * @brief Same as SliceFuncNoPad, but each thread copies 16 bytes at a time
+ *
+ * @remarks The contiguous runs of the input, as well as the offsets and pointers, must be
+ *          aligned to 16 bytes - see CanVectorizeSlice.
+ * @remarks `offset` is the index of the first element processed by the thread and must be
+ *          a multiple of the vector size
+ */
+template <int Dims, typename T>
+__device__ void SliceFuncNoPadVec(T *__restrict__ out, const T *__restrict__ in,
+                                  const fast_div<uint64_t> *out_strides, const int64_t *in_strides,
+                                  uint64_t offset, uint64_t block_end) {
+  if (Dims > 1 && out_strides[Dims - 1] == static_cast<uint32_t>(in_strides[Dims - 1])) {
+    const int NextDims = Dims > 1 ? Dims - 1 : 1;
+    SliceFuncNoPadVec<NextDims, T>(out, in, out_strides, in_strides, offset, block_end);
+    return;
+  }
+
+  constexpr int kVecSize = sizeof(uint4) / sizeof(T);
+  for (; offset < block_end; offset += blockDim.x * kVecSize) {
+    uint64_t idx = offset;
+    uint64_t out_idx = idx;
+    uint64_t in_idx = 0;
+
+    #pragma unroll
+    for (int d = 0; d < Dims; d++) {
+      int i_d = div_mod(idx, idx, out_strides[d]);
+      in_idx += i_d * in_strides[d];
+    }
+    in_idx += idx;  // remaining dims have equal strides
+    *reinterpret_cast<uint4 *>(out + out_idx) = __ldg(reinterpret_cast<const uint4 *>(in + in_idx));
+  }
+}
+
+template <typename OutputType, typename InputType>
+struct is_slice_vectorizable : std::integral_constant<bool,
+  std::is_same<OutputType, InputType>::value && sizeof(uint4) % sizeof(OutputType) == 0> {};
+
+template <int Dims, typename OutputType, typename InputType>
+__device__ DALI_FORCEINLINE void SliceNoPad(std::true_type, bool vectorize,
+                                            OutputType *__restrict__ out,
+                                            const InputType *__restrict__ in,
+                                            const fast_div<uint64_t> *out_strides,
+                                            const int64_t *in_strides,
+                                            uint64_t block_start, uint64_t block_end) {
+  constexpr int kVecSize = sizeof(uint4) / sizeof(OutputType);
+  if (vectorize)
+    SliceFuncNoPadVec<Dims>(out, in, out_strides, in_strides,
+                            block_start + threadIdx.x * kVecSize, block_end);
+  else
+    SliceFuncNoPad<Dims>(out, in, out_strides, in_strides, block_start + threadIdx.x, block_end);
+}
+
+template <int Dims, typename OutputType, typename InputType>
+__device__ DALI_FORCEINLINE void SliceNoPad(std::false_type, bool vectorize,
+                                            OutputType *__restrict__ out,
+                                            const InputType *__restrict__ in,
+                                            const fast_div<uint64_t> *out_strides,
+                                            const int64_t *in_strides,
+                                            uint64_t block_start, uint64_t block_end) {
+  SliceFuncNoPad<Dims>(out, in, out_strides, in_strides, block_start + threadIdx.x, block_end);
+}
+
 /**
  * @brief General algorithm that allows for padding in any dimension
  * @remarks `in` refers to the beginning of the input (not the slice anchor)
@@ -168,7 +233,8 @@ __device__ void SliceFunc(OutputType *__restrict__ out, const InputType *__restr
 template <typename OutputType, typename InputType, int Dims, bool SupportPad>
 __global__ void SliceKernel(const SliceSampleDesc<Dims> *samples, const SliceBlockDesc *blocks) {
   int sampleIdx = blocks[blockIdx.x].sampleIdx;
-  uint64_t offset = blocks[blockIdx.x].offset + threadIdx.x;
+  uint64_t block_start = blocks[blockIdx.x].offset;
+  uint64_t offset = block_start + threadIdx.x;
   uint64_t block_end = blocks[blockIdx.x].offset + blocks[blockIdx.x].size;
   auto sample = samples[sampleIdx];
   auto *out = static_cast<OutputType*>(sample.out);
@@ -184,10 +250,47 @@ __global__ void SliceKernel(const SliceSampleDesc<Dims> *samples, const SliceBlo
     SliceFunc<Dims>(out, in, out_strides, in_strides, out_shape, in_shape, anchor, fill_values,
                     channel_dim, offset, block_end);
   } else {
-    SliceFuncNoPad<Dims>(out, in, out_strides, in_strides, offset, block_end);
+    SliceNoPad<Dims>(is_slice_vectorizable<OutputType, InputType>(), sample.vectorize,
+                     out, in, out_strides, in_strides, block_start, block_end);
   }
 }
 
+/**
+ * @brief Checks whether a sample, which doesn't need padding, can be copied with 16-byte
+ *        vector loads and stores.
+ *
+ * The innermost dimensions with matching input and output strides are contiguous in both
+ * tensors; the copy can be vectorized if the length of such contiguous runs, the strides of
+ * the remaining input dimensions and the data pointers are all aligned to 16 bytes.
+ * The block offsets (multiples of the block size) are then also aligned.
+ */
+template <typename T, int Dims>
+std::enable_if_t<is_slice_vectorizable<T, T>::value, bool>
+CanVectorizeSlice(const T *out, const T *in, const TensorShape<Dims> &out_shape,
+                  const TensorShape<Dims> &in_strides) {
+  constexpr int64_t kVecSize = sizeof(uint4) / sizeof(T);
+  if (reinterpret_cast<uintptr_t>(out) % sizeof(uint4) ||
+      reinterpret_cast<uintptr_t>(in) % sizeof(uint4))
+    return false;
+  auto out_strides = GetStrides(out_shape);
+  int ndim = Dims;
+  while (ndim > 1 && out_strides[ndim - 1] == in_strides[ndim - 1])
+    ndim--;
+  if (out_strides[ndim - 1] % kVecSize)
+    return false;
+  for (int d = 0; d < ndim; d++)
+    if (in_strides[d] % kVecSize)
+      return false;
+  return true;
+}
+
+template <typename OutputType, typename InputType, int Dims>
+std::enable_if_t<!is_slice_vectorizable<OutputType, InputType>::value, bool>
+CanVectorizeSlice(const OutputType *, const InputType *, const TensorShape<Dims> &,
+                  const TensorShape<Dims> &) {
+  return false;
+}
+
 }  // namespace detail
 
 template <typename OutputType, typename InputType, int Dims>
@@ -195,6 +298,8 @@ class SliceGPU {
  private:
   static constexpr int64_t kBlockDim = 256;
   static constexpr int64_t kBlockSize = 64 * kBlockDim;
+  static_assert(kBlockSize % sizeof(uint4) == 0,
+                "Block size must be a multiple of the vector size in the vectorized copy");
   int64_t block_count_ = 0;
 
  public:
@@ -311,6 +416,9 @@ class SliceGPU {
       sample_desc.fill_values = fill_values_gpu + i * nfill_values_;
       sample_desc.channel_dim = nfill_values_ > 1 ? slice_args[i].channel_dim : -1;
       sample_desc.need_pad = NeedPad(Dims, anchor, in_shape, out_shape);
+      sample_desc.vectorize = !sample_desc.need_pad &&
+          detail::CanVectorizeSlice(out.tensor_data(i), in_data, out_shape,
+                                    sample_desc.in_strides);
       any_padded_sample |= sample_desc.need_pad;
     }
 
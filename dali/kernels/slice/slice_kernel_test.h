@@ -392,6 +392,9 @@ using SLICE_TEST_TYPES = ::testing::Types<
     SliceTestArgs<uint8_t, uint8_t, 2, 1, 1024, ArgsGen_HalfAllDims<uint8_t, 2>>,
     SliceTestArgs<uint8_t, uint8_t, 2, 100, 1024, ArgsGen_HalfAllDims<uint8_t, 2>>,
     SliceTestArgs<uint8_t, uint8_t, 3, 3, 256, ArgsGen_HalfAllDims<uint8_t, 3>>,
+    SliceTestArgs<uint8_t, uint8_t, 3, 3, 64, ArgsGen_HalfOneDim<uint8_t, 3, 1>>,
+    SliceTestArgs<int16_t, int16_t, 3, 3, 64, ArgsGen_HalfAllDims<int16_t, 3>>,
+    SliceTestArgs<uint8_t, uint8_t, 3, 3, 34, ArgsGen_HalfAllDims<uint8_t, 3>>,
     SliceTestArgs<int, int, 2, 1, 3, ArgsGen_ExtractCenterElement<int, 2>>,
     SliceTestArgs<int, int, 1, 1, 20, ArgsGen_BiggerThanInputSlice<int, 1>>,
     SliceTestArgs<int, int, 2, 1, 20, ArgsGen_BiggerThanInputSlice<int, 2>>,
@@ -15,6 +15,7 @@
 #include <gtest/gtest.h>
 #include "dali/kernels/kernel_manager.h"
 #include "dali/kernels/kernel.h"
+#include "dali/kernels/scratch_arena.h"
 
 namespace dali {
 namespace kernels {
@@ -129,5 +130,47 @@ TEST(KernelManager, TemplateResize) {
   mgr.Run<TestKernel>(0, 0, ctx, out, in, 100, 1.25f);
 }
 
+TEST(KernelManager, SharedScratchArena) {
+  KernelManager mgr1, mgr2;
+  mgr1.Resize<TestKernel>(1, 1);
+  mgr2.Resize<TestKernel>(1, 1);
+  OutListGPU<float, 3> in, out;
+  in.resize(2);
+  in.shape = {{ { 10, 10, 1 }, { 20, 20, 3 } }};
+  out.shape = {{ { 10, 10, 1 }, { 20, 20, 3 } }};
+  KernelContext ctx;
+  const auto device = mm::memory_kind_id::device;
+
+  ScratchArena arena;
+  for (int iter = 0; iter < 2; iter++) {
+    // the operators run one after another - each in its own scope
+    {
+      ScratchArena::Scope scope(&arena);
+      EXPECT_EQ(ScratchArena::Current(), &arena);
+      mgr1.Setup<TestKernel>(0, ctx, in, 100, 1.25f);
+      mgr1.Run<TestKernel>(0, 0, ctx, out, in, 100, 1.25f);
+      EXPECT_GT(arena.Used(), 0u);
+    }
+    EXPECT_EQ(ScratchArena::Current(), nullptr);
+    EXPECT_EQ(arena.Used(), 0u);
+    size_t peak1 = arena.LastPeak();
+    {
+      ScratchArena::Scope scope(&arena);
+      mgr2.Setup<TestKernel>(0, ctx, in, 1000, 1.25f);
+      mgr2.Run<TestKernel>(0, 0, ctx, out, in, 1000, 1.25f);
+    }
+    size_t peak2 = arena.LastPeak();
+    EXPECT_GT(peak2, peak1);
+    // the arena grows to the largest scope, not to the sum of them
+    EXPECT_EQ(arena.Capacity(), peak2);
+  }
+  EXPECT_EQ(mgr1.GetScratchpadAllocator(0).Capacity(device), 0u);
+  EXPECT_EQ(mgr2.GetScratchpadAllocator(0).Capacity(device), 0u);
+
+  // outside of the scope, the managers use their own memory
+  mgr1.Run<TestKernel>(0, 0, ctx, out, in, 100, 1.25f);
+  EXPECT_GT(mgr1.GetScratchpadAllocator(0).Capacity(device), 0u);
+}
+
 }  // namespace kernels
 }  // namespace dali
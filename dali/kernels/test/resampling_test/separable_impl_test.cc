@@ -125,6 +125,142 @@ TEST(SeparableImpl, Setup3D) {
   TestSetup<3>();
 }
 
+template <int spatial_ndim>
+void TestBalancedSampleLookup() {
+  constexpr int tensor_ndim = spatial_ndim + 1;
+  using Setup = resampling::BatchResamplingSetup<spatial_ndim>;
+  using BlockDesc = typename Setup::BlockDesc;
+  int N = 16;
+  TensorListShape<tensor_ndim> tls;
+  std::vector<ResamplingParamsND<spatial_ndim>> params;
+  RandomParams<spatial_ndim>(tls, params, N);
+
+  Setup setup;
+  setup.InitializeCPU();  // the filters are not used by the lookup
+  setup.balance_blocks = true;
+  setup.SetupBatch(tls, params);
+
+  int total_blocks = 0;
+  for (auto x : setup.total_blocks)
+    total_blocks += x;
+  std::vector<BlockDesc> blocks(total_blocks);
+  setup.InitializeSampleLookup(make_tensor_cpu<1>(blocks.data(), { total_blocks }));
+
+  int pass_start = 0;
+  for (int pass = 0; pass < spatial_ndim; pass++) {
+    std::vector<std::vector<uint8_t>> coverage(N);
+    for (int i = 0; i < N; i++)
+      coverage[i].resize(volume(setup.sample_descs[i].shapes[pass+1]));
+
+    int64_t prev_volume = -1;
+    for (int b = pass_start; b < pass_start + setup.total_blocks[pass]; b++) {
+      const BlockDesc &blk = blocks[b];
+      const auto &desc = setup.sample_descs[blk.sample_idx];
+      ivec<spatial_ndim> shape = desc.shapes[pass+1];
+      // the samples are scheduled from the largest to the smallest
+      int64_t sample_volume = volume(shape);
+      if (prev_volume >= 0)
+        EXPECT_LE(sample_volume, prev_volume);
+      prev_volume = sample_volume;
+
+      ivec<spatial_ndim> pos;
+      auto extent = blk.end - blk.start;
+      for (int64_t idx = 0, n = volume(extent); idx < n; idx++) {
+        int64_t flat = idx, offset = 0, stride = 1;
+        for (int d = 0; d < spatial_ndim; d++) {
+          pos[d] = blk.start[d] + flat % extent[d];
+          flat /= extent[d];
+          offset += pos[d] * stride;
+          stride *= shape[d];
+        }
+        coverage[blk.sample_idx][offset]++;
+      }
+    }
+    for (int i = 0; i < N; i++) {
+      for (size_t j = 0; j < coverage[i].size(); j++)
+        ASSERT_EQ(coverage[i][j], 1) << "sample " << i << ", pass " << pass << ", offset " << j;
+    }
+    pass_start += setup.total_blocks[pass];
+  }
+}
+
+TEST(SeparableImpl, BalancedSampleLookup2D) {
+  TestBalancedSampleLookup<2>();
+}
+
+TEST(SeparableImpl, BalancedSampleLookup3D) {
+  TestBalancedSampleLookup<3>();
+}
+
+template <int spatial_ndim>
+void ExpectEqualDesc(const resampling::SampleDesc<spatial_ndim> &a,
+                     const resampling::SampleDesc<spatial_ndim> &b) {
+  for (int i = 0; i < a.num_buffers; i++) {
+    EXPECT_EQ(a.shapes[i], b.shapes[i]);
+    EXPECT_EQ(a.offsets[i], b.offsets[i]);
+    EXPECT_EQ(a.strides[i], b.strides[i]);
+  }
+  for (int pass = 0; pass < spatial_ndim; pass++)
+    EXPECT_EQ(a.logical_block_shape[pass], b.logical_block_shape[pass]);
+  for (int d = 0; d < spatial_ndim; d++) {
+    EXPECT_EQ(a.filter_type[d], b.filter_type[d]);
+    EXPECT_EQ(a.filter[d].coeffs, b.filter[d].coeffs);
+    EXPECT_EQ(a.filter[d].scale, b.filter[d].scale);
+  }
+  EXPECT_EQ(a.order, b.order);
+  EXPECT_EQ(a.origin, b.origin);
+  EXPECT_EQ(a.scale, b.scale);
+  EXPECT_EQ(a.channels, b.channels);
+}
+
+template <int spatial_ndim>
+void TestSetupCache() {
+  constexpr int tensor_ndim = spatial_ndim + 1;
+  using Setup = resampling::BatchResamplingSetup<spatial_ndim>;
+  int N = 8;
+  TensorListShape<tensor_ndim> tls;
+  std::vector<ResamplingParamsND<spatial_ndim>> params;
+  RandomParams<spatial_ndim>(tls, params, N);
+
+  Setup cached;
+  cached.InitializeCPU();
+  cached.SetupBatch(tls, params);
+
+  // change some of the samples and the batch size - the remaining descriptors are reused
+  params[1][0].output_size += 3;
+  params[2][spatial_ndim - 1].min_filter = ResamplingFilterType::Lanczos3;
+  tls.tensor_shape_span(3)[0] += 5;
+  params.pop_back();
+  tls.resize(N - 1);
+  cached.SetupBatch(tls, params);
+
+  Setup fresh;
+  fresh.InitializeCPU();
+  fresh.SetupBatch(tls, params);
+
+  ASSERT_EQ(cached.sample_descs.size(), fresh.sample_descs.size());
+  for (size_t i = 0; i < fresh.sample_descs.size(); i++)
+    ExpectEqualDesc(cached.sample_descs[i], fresh.sample_descs[i]);
+  EXPECT_EQ(cached.output_shape, fresh.output_shape);
+  EXPECT_EQ(cached.total_blocks, fresh.total_blocks);
+
+  // changing the options invalidates the cache
+  cached.balance_blocks = fresh.balance_blocks = true;
+  cached.SetupBatch(tls, params);
+  fresh.SetupBatch(tls, params);
+  for (size_t i = 0; i < fresh.sample_descs.size(); i++)
+    ExpectEqualDesc(cached.sample_descs[i], fresh.sample_descs[i]);
+  EXPECT_EQ(cached.total_blocks, fresh.total_blocks);
+}
+
+TEST(SeparableImpl, SetupCache2D) {
+  TestSetupCache<2>();
+}
+
+TEST(SeparableImpl, SetupCache3D) {
+  TestSetupCache<3>();
+}
+
 ResamplingTestBatch SingleImageBatch = {
   {
     "imgproc/alley.png", "imgproc/ref/resampling/alley_tri_300x300.png",
@@ -58,6 +58,44 @@ TEST(ScatterGather, Coalesce) {
   EXPECT_EQ(in, ref);
 }
 
+TEST(ScatterGather, PreferMemcpy) {
+  static char A[1<<12];
+  using detail::CopyRange;
+  std::vector<CopyRange> ranges = { { A, A + 100, 10 }, { A + 20, A + 200, 10 } };
+  EXPECT_TRUE(detail::PreferMemcpy(make_cspan(ranges)));
+  ranges.push_back({ A + 40, A + 300, 10 });
+  EXPECT_FALSE(detail::PreferMemcpy(make_cspan(ranges)));
+  for (auto &r : ranges)
+    r.size = 4 << 20;
+  EXPECT_TRUE(detail::PreferMemcpy(make_cspan(ranges)));
+}
+
+TEST(ScatterGatherGPU, VectorizedCopy) {
+  const size_t size = 1 << 16;
+  auto in_ptr = mm::alloc_raw_unique<char, mm::memory_kind::device>(size);
+  auto out_ptr = mm::alloc_raw_unique<char, mm::memory_kind::device>(size);
+  std::vector<char> in(size), out(size), ref(size);
+  for (size_t i = 0; i < size; i++)
+    in[i] = i * 7 + 3;
+  CUDA_CALL(cudaMemcpy(in_ptr.get(), in.data(), size, cudaMemcpyHostToDevice));
+  CUDA_CALL(cudaMemset(out_ptr.get(), 0, size));
+
+  ScatterGatherGPU sg(1000);
+  // ranges with equal misalignment of source and destination (vectorized),
+  // different misalignment (byte-wise) and ranges shorter than the unaligned head
+  struct { size_t src, dst, size; } copies[] = {
+    { 0, 32768, 4096 }, { 5000, 40005, 3001 }, { 9000, 48001, 2000 },
+    { 12001, 52033, 7 }, { 13003, 60003, 1 }, { 16000, 0, 16 }
+  };
+  for (auto &c : copies) {
+    sg.AddCopy(out_ptr.get() + c.dst, in_ptr.get() + c.src, c.size);
+    memcpy(ref.data() + c.dst, in.data() + c.src, c.size);
+  }
+  sg.Run(0, true, ScatterGatherGPU::Method::Kernel);
+  CUDA_CALL(cudaMemcpy(out.data(), out_ptr.get(), size, cudaMemcpyDeviceToHost));
+  EXPECT_EQ(out, ref);
+}
+
 template <typename T>
 class ScatterGatherTest : public testing::Test {
  public:
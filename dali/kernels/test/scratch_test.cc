@@ -18,6 +18,7 @@
 #include <cassert>
 #include "dali/kernels/kernel_req.h"
 #include "dali/kernels/scratch.h"
+#include "dali/kernels/scratch_capture.h"
 #include "dali/core/static_switch.h"
 
 namespace dali {
@@ -179,5 +180,47 @@ TEST(Scratch, ScratchpadAllocator) {
   }
 }
 
+TEST(Scratch, ScratchpadCapture) {
+  const int host = static_cast<int>(mm::memory_kind_id::host);
+  ScratchpadAllocator sa;
+  sa.Reserve<mm::memory_kind::host>(1000);
+  char *outside = sa.GetScratchpad().allocs[host].next();
+  std::vector<mm::uptr<char>> retained;
+  {
+    ScratchpadCapture capture(&retained);
+    EXPECT_EQ(ScratchpadCapture::Current(), &capture);
+    // a buffer allocated outside of the capture is replaced and retained
+    char *inside = sa.GetScratchpad().allocs[host].next();
+    EXPECT_NE(inside, outside);
+    ASSERT_EQ(retained.size(), 1u);
+    EXPECT_GE(outside, retained[0].get());
+    // ...but only once
+    EXPECT_EQ(sa.GetScratchpad().allocs[host].next(), inside);
+    EXPECT_EQ(retained.size(), 1u);
+
+    // growing retains the buffer used in the capture
+    sa.Reserve<mm::memory_kind::host>(100000);
+    EXPECT_EQ(retained.size(), 2u);
+    EXPECT_GE(sa.Capacity<mm::memory_kind::host>(), 100000u);
+
+    int data[4] = { 1, 2, 3, 4 };
+    auto *staged = static_cast<const int *>(capture.StageHost(data, sizeof(data)));
+    EXPECT_NE(staged, data);
+    EXPECT_EQ(retained.size(), 3u);
+    for (int i = 0; i < 4; i++)
+      EXPECT_EQ(staged[i], data[i]);
+
+    sa.Free();
+    EXPECT_EQ(retained.size(), 4u);
+  }
+  EXPECT_EQ(ScratchpadCapture::Current(), nullptr);
+
+  // without a capture, the buffers are reused
+  sa.Reserve<mm::memory_kind::host>(1000);
+  char *p1 = sa.GetScratchpad().allocs[host].next();
+  EXPECT_EQ(sa.GetScratchpad().allocs[host].next(), p1);
+  EXPECT_EQ(retained.size(), 4u);
+}
+
 }  // namespace kernels
 }  // namespace dali
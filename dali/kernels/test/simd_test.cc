@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <limits>
 #include "dali/kernels/common/simd.h"
 #include "dali/core/convert.h"
 
@@ -129,6 +130,62 @@ TEST(SSE2Test, ConvertLoad) {
 
 #endif  // __SSE2__
 
+#ifdef DALI_SIMD_HAS_F32X4
+
+template <typename Out, typename In>
+void TestMultivecRoundTrip(void (*load_store)(Out *out, const In *in)) {
+  constexpr int lanes = 16;
+  In in[lanes];  // NOLINT
+  double lo = std::numeric_limits<In>::lowest(), hi = std::numeric_limits<In>::max();
+  for (int i = 0; i < lanes; i++)
+    in[i] = ConvertSat<In>(lo + (hi - lo) * i / (lanes - 1));
+  Out out[lanes];  // NOLINT
+  load_store(out, in);
+  for (int i = 0; i < lanes; i++)
+    EXPECT_EQ(out[i], ConvertSat<Out>(in[i])) << " at lane " << i;
+}
+
+template <typename Out, typename In>
+void LoadStore16(Out *out, const In *in) {
+  store(out, multivec<4>::load(in));
+}
+
+TEST(MultivecTest, LoadStoreMixedTypes) {
+  TestMultivecRoundTrip<uint8_t, uint16_t>(LoadStore16);
+  TestMultivecRoundTrip<uint16_t, uint8_t>(LoadStore16);
+  TestMultivecRoundTrip<int8_t, int16_t>(LoadStore16);
+  TestMultivecRoundTrip<int16_t, int8_t>(LoadStore16);
+  TestMultivecRoundTrip<uint8_t, float>(LoadStore16);
+  TestMultivecRoundTrip<float, uint8_t>(LoadStore16);
+  TestMultivecRoundTrip<int16_t, int32_t>(LoadStore16);
+}
+
+#endif  // DALI_SIMD_HAS_F32X4
+
+#ifdef DALI_SIMD_HAS_AVX2
+
+DALI_SIMD_AVX2_BEGIN
+template <typename Out, typename In>
+void LoadStore16_AVX2(Out *out, const In *in) {
+  avx2::store(out, avx2::multivec<2>::load(in));
+}
+DALI_SIMD_AVX2_END
+
+TEST(AVX2Test, LoadStoreMixedTypes) {
+  if (!avx2::is_supported())
+    GTEST_SKIP() << "AVX2 is not supported by this CPU";
+  TestMultivecRoundTrip<uint8_t, uint16_t>(LoadStore16_AVX2);
+  TestMultivecRoundTrip<uint16_t, uint8_t>(LoadStore16_AVX2);
+  TestMultivecRoundTrip<int8_t, int16_t>(LoadStore16_AVX2);
+  TestMultivecRoundTrip<int16_t, int8_t>(LoadStore16_AVX2);
+  TestMultivecRoundTrip<uint8_t, float>(LoadStore16_AVX2);
+  TestMultivecRoundTrip<float, uint8_t>(LoadStore16_AVX2);
+  TestMultivecRoundTrip<int16_t, int32_t>(LoadStore16_AVX2);
+  TestMultivecRoundTrip<uint16_t, int32_t>(LoadStore16_AVX2);
+}
+
+#endif  // DALI_SIMD_HAS_AVX2
+
 }  // namespace test
 }  // namespace simd
 }  // namespace kernels
@@ -15,10 +15,12 @@
 #include <gtest/gtest.h>
 #include <opencv2/imgcodecs.hpp>
 #include <opencv2/imgproc.hpp>
+#include <random>
 #include <string>
 #include <vector>
 #include "dali/kernels/imgproc/warp_cpu.h"
 #include "dali/kernels/imgproc/warp/affine.h"
+#include "dali/kernels/imgproc/warp/water.h"
 #include "dali/test/tensor_test_utils.h"
 #include "dali/test/dump_diff.h"
 #include "dali/test/mat2tensor.h"
@@ -27,6 +29,7 @@
 #include "dali/test/dali_test_config.h"
 #include "dali/core/geom/transform.h"
 #include "dali/kernels/test/warp_test/warp_test_helper.h"
+#include "dali/pipeline/util/thread_pool.h"
 
 namespace dali {
 namespace kernels {
@@ -146,5 +149,102 @@ TEST(WarpCPU, Affine_RotateScale) {
   }
 }
 
+TEST(WarpCPU, Affine_Scheduled) {
+  WarpCPU<AffineMapping2D, 2, uint8_t, uint8_t, uint8_t> warp;
+
+  cv::Mat cv_img = cv::imread(testing::dali_extra_path() + "/db/imgproc/alley.png");
+  auto cpu_img = view_as_tensor<uint8_t>(cv_img);
+
+  vec2 center(cv_img.cols * 0.5f, cv_img.rows * 0.5f);
+  auto tr = translation(center) * rotation2D(-M_PI/6) * translation(-center);
+  AffineMapping2D mapping_cpu = sub<2, 3>(tr, 0, 0);
+
+  TensorShape<2> out_shape = { cpu_img.shape[0], cpu_img.shape[1] };
+  KernelContext ctx = {};
+  auto interp = DALI_INTERP_LINEAR;
+  auto req = warp.Setup(ctx, cpu_img, mapping_cpu, out_shape, interp, 255);
+
+  TestTensorList<uint8_t, 3> ref, out;
+  ref.reshape(req.output_shapes[0].to_static<3>());
+  out.reshape(req.output_shapes[0].to_static<3>());
+  warp.Run(ctx, ref.cpu(0)[0], cpu_img, mapping_cpu, out_shape, interp, 255);
+
+  ThreadPool tp(4, CPU_ONLY_DEVICE_ID, false);
+  // small blocks, so that the image is split into many jobs of unequal height
+  warp.Schedule(ctx, out.cpu(0)[0], cpu_img, mapping_cpu, out_shape, interp, 255, tp,
+                1000, 7);
+  tp.RunAll();
+
+  Check(out.cpu(0)[0], ref.cpu(0)[0]);
+}
+
+namespace {
+
+/**
+ * @brief Checks the linear warp against the scalar sampler, pixel by pixel
+ *
+ * The image sizes are not multiples of the SIMD block and the mapping reaches outside
+ * of the input, so that the vectorized path, its border handling and the scalar tail are used.
+ */
+template <typename Out, typename In, typename Mapping, typename Border>
+void TestWarpLinearVsSampler(const Mapping &mapping, int channels, Border border) {
+  std::mt19937_64 rng(4321);
+  TestTensorList<In, 3> in;
+  in.reshape(uniform_list_shape<3>(1, { 45, 67, channels }));
+  UniformRandomFill(in.cpu(0)[0], rng, 0, 255);
+  auto in_view = in.cpu(0)[0];
+
+  WarpCPU<Mapping, 2, Out, In, Border> warp;
+  KernelContext ctx = {};
+  TensorShape<2> out_size = { 51, 83 };
+  auto req = warp.Setup(ctx, in_view, mapping, out_size, DALI_INTERP_LINEAR, border);
+  TestTensorList<Out, 3> out;
+  out.reshape(req.output_shapes[0].template to_static<3>());
+  auto out_view = out.cpu(0)[0];
+  warp.Run(ctx, out_view, in_view, mapping, out_size, DALI_INTERP_LINEAR, border);
+
+  Surface2D<const In> surface = as_surface_channel_last(in_view);
+  Sampler2D<DALI_INTERP_LINEAR, In> sampler(surface);
+  std::vector<Out> ref(channels);
+  for (int y = 0; y < out_size[0]; y++) {
+    for (int x = 0; x < out_size[1]; x++) {
+      sampler(ref.data(), warp::map_coords(mapping, ivec2(x, y)), border);
+      for (int c = 0; c < channels; c++) {
+        // the vectorized code rounds half to even
+        ASSERT_NEAR(*out_view(y, x, c), ref[c], 1)
+          << "@ x = " << x << " y = " << y << " c = " << c;
+      }
+    }
+  }
+}
+
+AffineMapping2D TestAffineMapping() {
+  vec2 center(67 * 0.5f, 45 * 0.5f);
+  auto tr = translation(center) * rotation2D(0.3f) * translation(-center) *
+            scaling(vec2(1.3f, 0.7f));
+  return sub<2, 3>(tr, 0, 0);
+}
+
+}  // namespace
+
+TEST(WarpCPU, Affine_Linear_VsSampler) {
+  for (int channels : { 1, 2, 3, 4 }) {
+    TestWarpLinearVsSampler<uint8_t, uint8_t>(TestAffineMapping(), channels, uint8_t(255));
+    TestWarpLinearVsSampler<uint8_t, uint8_t>(TestAffineMapping(), channels, BorderClamp());
+    TestWarpLinearVsSampler<float, uint8_t>(TestAffineMapping(), channels, 42.0f);
+    TestWarpLinearVsSampler<int16_t, float>(TestAffineMapping(), channels, BorderClamp());
+  }
+}
+
+TEST(WarpCPU, Water_Linear_VsSampler) {
+  WaterMapping mapping;
+  mapping.amplitude = vec2(5, 3);
+  mapping.frequency = vec2(0.2f, 0.1f);
+  for (int channels : { 1, 3 }) {
+    TestWarpLinearVsSampler<uint8_t, uint8_t>(mapping, channels, uint8_t(0));
+    TestWarpLinearVsSampler<float, uint8_t>(mapping, channels, BorderClamp());
+  }
+}
+
 }  // namespace kernels
 }  // namespace dali
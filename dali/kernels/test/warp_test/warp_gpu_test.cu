@@ -279,5 +279,46 @@ TEST(WarpGPU, Affine_RotateScale_Uniform) {
   }
 }
 
+TEST(WarpGPU, Affine_Rotate_Texture) {
+  cv::Mat cv_img = cv::imread(testing::dali_extra_path() + "/db/imgproc/alley.png");
+  auto cpu_img = view_as_tensor<uint8_t>(cv_img);
+  auto gpu_img = copy<mm::memory_kind::device>(cpu_img);
+  auto img_tensor = gpu_img.first;
+
+  vec2 center(cv_img.cols * 0.5f, cv_img.rows * 0.5f);
+  auto tr = translation(center) * rotation2D(M_PI/6) * translation(-center);
+  AffineMapping2D mapping_cpu = sub<2, 3>(tr, 0, 0);
+
+  TensorListView<StorageGPU, uint8_t, 3> in_list;
+  in_list.resize(1, 3);
+  in_list.shape.set_tensor_shape(0, img_tensor.shape);
+  in_list.data[0] = img_tensor.data;
+
+  auto mapping_gpu = mm::alloc_raw_unique<AffineMapping2D, mm::memory_kind::device>(1);
+  TensorShape<2> out_shape = { img_tensor.shape[0], img_tensor.shape[1] };
+  auto out_shapes_hw = make_span<1>(&out_shape);
+  auto mappings = make_tensor_gpu<1>(mapping_gpu.get(), { 1 });
+  copy(mappings, make_tensor_cpu<1>(&mapping_cpu, { 1 }));
+
+  for (auto interp : { DALI_INTERP_NN, DALI_INTERP_LINEAR }) {
+    TestTensorList<uint8_t, 3> out[2];
+    for (int use_texture = 0; use_texture < 2; use_texture++) {
+      WarpGPU<AffineMapping2D, 2, uint8_t, uint8_t, BorderClamp> kernel;
+      kernel.SetTextureUsage(use_texture ? warp::TextureUsage::Always : warp::TextureUsage::Never);
+      ScratchpadAllocator scratch_alloc;
+      KernelContext ctx = {};
+      KernelRequirements req = kernel.Setup(ctx, in_list, mappings, out_shapes_hw, {&interp, 1});
+      scratch_alloc.Reserve(req.scratch_sizes);
+      out[use_texture].reshape(req.output_shapes[0].to_static<3>());
+      auto scratchpad = scratch_alloc.GetScratchpad();
+      ctx.scratchpad = &scratchpad;
+      kernel.Run(ctx, out[use_texture].gpu(0), in_list, mappings, out_shapes_hw, {&interp, 1});
+      CUDA_CALL(cudaDeviceSynchronize());
+    }
+    // channel texels are point-sampled and filtered in software, so the results should match
+    Check(out[1].cpu(0)[0], out[0].cpu(0)[0], EqualEps(1));
+  }
+}
+
 }  // namespace kernels
 }  // namespace dali
@@ -1,4 +1,4 @@
-// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2020-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -15,12 +15,19 @@
 #ifndef DALI_KERNELS_TRANSPOSE_TRANSPOSE_H_
 #define DALI_KERNELS_TRANSPOSE_TRANSPOSE_H_
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include <algorithm>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "dali/core/exec/engine.h"
+#include "dali/core/force_inline.h"
 #include "dali/core/static_switch.h"
 #include "dali/core/tensor_view.h"
+#include "dali/kernels/common/split_shape.h"
 #include "dali/kernels/common/utils.h"
 #include "dali/kernels/transpose/transpose_util.h"
 
@@ -111,8 +118,214 @@ void TransposeImpl(T *dst, const T *src, int level, int max_levels, span<const i
   }
 }
 
+
+/**
+ * @brief Side of the square blocks processed at once by the tiled transpose, in elements
+ *
+ * A pair of blocks (source and destination) of the biggest supported type fits in L1.
+ */
+constexpr int kTransposeBlockSize = 32;
+
+/**
+ * @brief Side of the micro tile transposed in registers - the number of elements
+ *        in a 16-byte vector
+ */
+template <typename T>
+constexpr int TransposeTileSize() {
+  return sizeof(T) <= 8 && 16 % sizeof(T) == 0 ? 16 / sizeof(T) : 1;
+}
+
+template <typename T>
+constexpr bool HasTransposeTile() {
+#if defined(__SSE2__)
+  return TransposeTileSize<T>() > 1 && std::is_trivially_copyable<T>::value;
+#else
+  return false;
+#endif
+}
+
+#if defined(__SSE2__)
+
+template <int element_size>
+struct Unpack;
+
+template <>
+struct Unpack<1> {
+  static DALI_FORCEINLINE __m128i lo(__m128i a, __m128i b) { return _mm_unpacklo_epi8(a, b); }
+  static DALI_FORCEINLINE __m128i hi(__m128i a, __m128i b) { return _mm_unpackhi_epi8(a, b); }
+};
+
+template <>
+struct Unpack<2> {
+  static DALI_FORCEINLINE __m128i lo(__m128i a, __m128i b) { return _mm_unpacklo_epi16(a, b); }
+  static DALI_FORCEINLINE __m128i hi(__m128i a, __m128i b) { return _mm_unpackhi_epi16(a, b); }
+};
+
+template <>
+struct Unpack<4> {
+  static DALI_FORCEINLINE __m128i lo(__m128i a, __m128i b) { return _mm_unpacklo_epi32(a, b); }
+  static DALI_FORCEINLINE __m128i hi(__m128i a, __m128i b) { return _mm_unpackhi_epi32(a, b); }
+};
+
+template <>
+struct Unpack<8> {
+  static DALI_FORCEINLINE __m128i lo(__m128i a, __m128i b) { return _mm_unpacklo_epi64(a, b); }
+  static DALI_FORCEINLINE __m128i hi(__m128i a, __m128i b) { return _mm_unpackhi_epi64(a, b); }
+};
+
+/**
+ * @brief Transposes an NxN tile, where N is the number of elements in a vector:
+ *        `dst[r * dst_stride + c] = src[c * src_stride + r]`
+ *
+ * The rows are shuffled log2(N) times with `out[2i] = lo(in[i], in[i + N/2])` and
+ * `out[2i+1] = hi(in[i], in[i + N/2])`, which results in a transposition.
+ */
+template <typename T>
+DALI_FORCEINLINE std::enable_if_t<HasTransposeTile<T>()>
+TransposeTile(T *dst, int64_t dst_stride, const T *src, int64_t src_stride) {
+  constexpr int N = TransposeTileSize<T>();
+  using U = Unpack<sizeof(T)>;
+  __m128i rows[N], tmp[N];
+  for (int i = 0; i < N; i++)
+    rows[i] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * src_stride));
+  for (int stage = 1; stage < N; stage *= 2) {
+    for (int i = 0; i < N / 2; i++) {
+      tmp[2 * i]     = U::lo(rows[i], rows[i + N / 2]);
+      tmp[2 * i + 1] = U::hi(rows[i], rows[i + N / 2]);
+    }
+    for (int i = 0; i < N; i++)
+      rows[i] = tmp[i];
+  }
+  for (int i = 0; i < N; i++)
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * dst_stride), rows[i]);
+}
+
+#endif
+
+/**
+ * @brief No micro tile for the types that don't fit in a vector evenly (or without
+ *        vector instructions) - the tiles are transposed element by element.
+ */
+template <typename T>
+std::enable_if_t<!HasTransposeTile<T>()> TransposeTile(T *, int64_t, const T *, int64_t) {}
+
+/**
+ * @brief Transposes a 2D array: `dst[r * dst_stride + c] = src[c * src_stride + r]`
+ *
+ * The array is processed in blocks that fit in L1; the full micro tiles inside the blocks
+ * are transposed in vector registers, when available.
+ */
+template <typename T>
+void Transpose2D(T *dst, int64_t dst_stride, const T *src, int64_t src_stride,
+                 int64_t rows, int64_t cols) {
+  constexpr int N = HasTransposeTile<T>() ? TransposeTileSize<T>() : 1;
+  constexpr int B = kTransposeBlockSize;
+  for (int64_t c0 = 0; c0 < cols; c0 += B) {
+    int64_t c1 = std::min(c0 + B, cols);
+    for (int64_t r0 = 0; r0 < rows; r0 += B) {
+      int64_t r1 = std::min(r0 + B, rows);
+      int64_t r = r0;
+      if (N > 1) {
+        for (; r + N <= r1; r += N) {
+          int64_t c = c0;
+          for (; c + N <= c1; c += N)
+            TransposeTile(dst + r * dst_stride + c, dst_stride, src + c * src_stride + r,
+                          src_stride);
+          for (int64_t i = r; i < r + N; i++)
+            for (int64_t j = c; j < c1; j++)
+              dst[i * dst_stride + j] = src[j * src_stride + i];
+        }
+      }
+      for (; r < r1; r++)
+        for (int64_t j = c0; j < c1; j++)
+          dst[r * dst_stride + j] = src[j * src_stride + r];
+    }
+  }
+}
+
+/**
+ * @brief Transposes the data in the dst-order, using the cache-blocked 2D transpose
+ *        for the innermost destination dimension and the destination dimension that is
+ *        innermost in the source.
+ *
+ * @param dst_stride destination strides
+ * @param src_stride source strides, in the destination order
+ * @param size dst-ordered shape
+ * @param inner_dim the destination dimension, other than the last one, that is the innermost
+ *                  (unit stride) dimension of the source
+ */
+template <typename T>
+void TransposeTiledImpl(T *dst, const T *src, int ndim, const int64_t *dst_stride,
+                        const int64_t *src_stride, const int64_t *size, int inner_dim) {
+  int outer[32];
+  int nouter = 0;
+  for (int d = 0; d < ndim - 1; d++)
+    if (d != inner_dim)
+      outer[nouter++] = d;
+
+  int64_t pos[32] = {};
+  for (;;) {
+    Transpose2D(dst, dst_stride[inner_dim], src, src_stride[ndim - 1],
+                size[inner_dim], size[ndim - 1]);
+    int k = nouter - 1;
+    for (; k >= 0; k--) {
+      int d = outer[k];
+      dst += dst_stride[d];
+      src += src_stride[d];
+      if (++pos[d] < size[d])
+        break;
+      dst -= dst_stride[d] * size[d];
+      src -= src_stride[d] * size[d];
+      pos[d] = 0;
+    }
+    if (k < 0)
+      break;
+  }
+}
+
+/**
+ * @brief Transposes a (sub)tensor with given strides, in the dst-order
+ *
+ * When the innermost destination dimension is not the innermost one in the source,
+ * the cache-blocked 2D transpose is used, otherwise the data is copied with the recursion
+ * over dimensions.
+ *
+ * @param src_stride source strides, in the source order
+ * @param size dst-ordered shape
+ * @param perm source dimension `perm[i]` goes to destination dimension `i`
+ */
+template <typename T>
+void TransposeStrided(T *dst, const T *src, int ndim, span<const int64_t> dst_stride,
+                      span<const int64_t> src_stride, const TensorShape<> &size,
+                      span<const int> perm) {
+  if (ndim >= 2 && ndim <= 32 && perm[ndim - 1] != ndim - 1 && size[ndim - 1] > 1) {
+    int inner_dim = -1;
+    int64_t perm_src_stride[32];
+    for (int d = 0; d < ndim; d++) {
+      perm_src_stride[d] = src_stride[perm[d]];
+      if (perm[d] == ndim - 1)
+        inner_dim = d;
+    }
+    if (inner_dim >= 0) {
+      TransposeTiledImpl(dst, src, ndim, dst_stride.data(), perm_src_stride, size.data(),
+                         inner_dim);
+      return;
+    }
+  }
+  VALUE_SWITCH(ndim, static_dims, (1, 2, 3), (
+    TransposeImplStatic<static_dims, static_dims>(
+        dst, src, static_dims, dst_stride, src_stride, size, perm);),
+  (
+    TransposeImpl(dst, src, 0, ndim, dst_stride, src_stride, size, perm);));
+}
+
 }  // namespace transpose_impl
 
+/**
+ * @brief Minimum number of elements in a block of a tensor transposed by a single thread
+ */
+constexpr int kTransposeMinBlockSize = 1 << 16;
+
 /**
  * @brief Transpose `src` Tensor to `dst` wrt to permutation `perm`
  *
@@ -130,13 +343,74 @@ void Transpose(const TensorView<StorageCPU, T> &dst, const TensorView<StorageCPU
   assert(volume(src.shape) == volume(dst.shape));
   auto dst_strides = GetStrides(dst.shape);
   auto src_strides = GetStrides(src.shape);
-  VALUE_SWITCH(N, static_dims, (1, 2, 3), (
-    transpose_impl::TransposeImplStatic<static_dims, static_dims>(
-        dst.data, src.data,
-        static_dims, make_span(dst_strides), make_span(src_strides), dst.shape, perm);),
-  (
-    transpose_impl::TransposeImpl(dst.data, src.data, 0, N,
-        make_span(dst_strides), make_span(src_strides), dst.shape, perm);));
+  transpose_impl::TransposeStrided(dst.data, src.data, N, make_cspan(dst_strides),
+                                   make_cspan(src_strides), dst.shape, perm);
+}
+
+/**
+ * @brief Schedules the transposition of `src` to `dst` wrt to permutation `perm`
+ *        with an execution engine.
+ *
+ * The destination is split into blocks of at least `min_blk_sz` elements, so that big
+ * samples can be processed by multiple threads. The work doesn't start until the user
+ * calls RunAll() on the execution engine.
+ *
+ * Source dimension `perm[i]` goes to destination dimension `i`.
+ */
+template <typename ExecutionEngine, typename T>
+void Transpose(ExecutionEngine &engine, const TensorView<StorageCPU, T> &dst,
+               const TensorView<StorageCPU, const T> &src, span<const int> perm,
+               int min_blk_sz = kTransposeMinBlockSize) {
+  int N = src.shape.sample_dim();
+  int64_t vol = volume(dst.shape);
+  int nblocks = 1;
+  SmallVector<int, DynamicTensorShapeContainer::static_size> split_factor;
+  split_factor.resize(N, 1);
+  if (N > 0 && vol > min_blk_sz)
+    nblocks = split_shape(split_factor, dst.shape, engine.NumThreads() * 4, min_blk_sz);
+  if (nblocks == 1) {
+    SmallVector<int, DynamicTensorShapeContainer::static_size> perm_copy(perm.begin(), perm.end());
+    engine.AddWork([=](int) {
+      Transpose(dst, src, make_cspan(perm_copy));
+    }, vol, false);
+    return;
+  }
+
+  auto dst_strides = GetStrides(dst.shape);
+  auto src_strides = GetStrides(src.shape);
+  // the permutation is copied, so that the caller doesn't need to keep it alive
+  SmallVector<int, DynamicTensorShapeContainer::static_size> blk_perm(perm.begin(), perm.end());
+  TensorShape<> start;
+  start.resize(N);
+  for (auto &x : start)
+    x = 0;
+  ForEachBlock(start, dst.shape, split_factor, 0, LastSplitDim(split_factor),
+    [&](const TensorShape<> &blk_start, const TensorShape<> &blk_end) {
+      T *blk_dst = dst.data;
+      const T *blk_src = src.data;
+      TensorShape<> blk_shape;
+      blk_shape.resize(N);
+      for (int d = 0; d < N; d++) {
+        blk_dst += blk_start[d] * dst_strides[d];
+        blk_src += blk_start[d] * src_strides[blk_perm[d]];
+        blk_shape[d] = blk_end[d] - blk_start[d];
+      }
+      engine.AddWork([=](int) {
+        transpose_impl::TransposeStrided(blk_dst, blk_src, N, make_cspan(dst_strides),
+                                         make_cspan(src_strides), blk_shape,
+                                         make_cspan(blk_perm));
+      }, volume(blk_shape), false);
+    });
+}
+
+/**
+ * @brief Specialization for SequentialExecutionEngine - the tensor is transposed at once.
+ */
+template <typename T>
+void Transpose(SequentialExecutionEngine &, const TensorView<StorageCPU, T> &dst,
+               const TensorView<StorageCPU, const T> &src, span<const int> perm,
+               int /* min_blk_sz */ = -1) {
+  Transpose(dst, src, perm);
 }
 
 /**
@@ -163,6 +437,25 @@ void TransposeGrouped(const TensorView<StorageCPU, T> &dst,
             make_cspan(collapsed_perm));
 }
 
+/**
+ * @brief Schedules the transposition of `src` to `dst` wrt to permutation `perm`,
+ *        with the groups of consecutive dimensions collapsed, with an execution engine.
+ *
+ * @see Transpose(ExecutionEngine &, ...), TransposeGrouped
+ */
+template <typename ExecutionEngine, typename T>
+void TransposeGrouped(ExecutionEngine &engine, const TensorView<StorageCPU, T> &dst,
+                      const TensorView<StorageCPU, const T> &src, span<const int> perm,
+                      int min_blk_sz = kTransposeMinBlockSize) {
+  TensorShape<> collapsed_src_shape;
+  SmallVector<int, DynamicTensorShapeContainer::static_size> collapsed_perm;
+  transpose_impl::SimplifyPermute(collapsed_src_shape, collapsed_perm, src.shape, perm);
+  auto collapsed_dst_shape = permute(collapsed_src_shape, collapsed_perm);
+  Transpose(engine, TensorView<StorageCPU, T>{dst.data, collapsed_dst_shape},
+            TensorView<StorageCPU, const T>{src.data, collapsed_src_shape},
+            make_cspan(collapsed_perm), min_blk_sz);
+}
+
 }  // namespace kernels
 }  // namespace dali
 
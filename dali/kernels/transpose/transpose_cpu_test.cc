@@ -0,0 +1,117 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+#include <numeric>
+#include <vector>
+#include "dali/kernels/transpose/transpose.h"
+#include "dali/kernels/transpose/transpose_test.h"
+#include "dali/pipeline/util/thread_pool.h"
+
+namespace dali {
+namespace kernels {
+
+namespace {
+
+struct RGB {
+  uint8_t r, g, b;
+  bool operator==(const RGB &other) const {
+    return r == other.r && g == other.g && b == other.b;
+  }
+};
+
+template <typename T>
+T MakeValue(int64_t i) {
+  return static_cast<T>(i);
+}
+
+template <>
+RGB MakeValue<RGB>(int64_t i) {
+  return { static_cast<uint8_t>(i), static_cast<uint8_t>(i >> 8), static_cast<uint8_t>(i >> 16) };
+}
+
+}  // namespace
+
+template <typename T>
+class TransposeCPUTest : public ::testing::Test {
+ public:
+  void RunTest(const TensorShape<> &shape, span<const int> perm, bool grouped, int num_threads) {
+    int64_t vol = volume(shape);
+    std::vector<T> in(vol), out(vol), ref(vol);
+    for (int64_t i = 0; i < vol; i++)
+      in[i] = MakeValue<T>(i);
+    testing::RefTranspose(ref.data(), in.data(), shape.data(), perm.data(), shape.size());
+
+    auto out_shape = permute(shape, perm);
+    TensorView<StorageCPU, T> out_view(out.data(), out_shape);
+    TensorView<StorageCPU, const T> in_view(in.data(), shape);
+    if (num_threads > 1) {
+      ThreadPool tp(num_threads, CPU_ONLY_DEVICE_ID, false);
+      // small blocks, to exercise the splitting
+      if (grouped)
+        TransposeGrouped(tp, out_view, in_view, perm, 1000);
+      else
+        Transpose(tp, out_view, in_view, perm, 1000);
+      tp.RunAll();
+    } else if (grouped) {
+      TransposeGrouped(out_view, in_view, perm);
+    } else {
+      Transpose(out_view, in_view, perm);
+    }
+    for (int64_t i = 0; i < vol; i++)
+      ASSERT_EQ(out[i], ref[i]) << "at " << i;
+  }
+
+  void RunPermutations4(const TensorShape<> &shape) {
+    for (auto &perm : testing::Permutations4)
+      for (bool grouped : { false, true })
+        for (int num_threads : { 1, 4 })
+          RunTest(shape, make_cspan(perm), grouped, num_threads);
+  }
+};
+
+using TransposeCPUTypes = ::testing::Types<uint8_t, uint16_t, int32_t, double, RGB>;
+TYPED_TEST_SUITE(TransposeCPUTest, TransposeCPUTypes);
+
+TYPED_TEST(TransposeCPUTest, HWC2CHW) {
+  int perm[] = { 2, 0, 1 };
+  for (int num_threads : { 1, 4 }) {
+    this->RunTest({ 123, 211, 3 }, make_cspan(perm), true, num_threads);
+    this->RunTest({ 64, 80, 4 }, make_cspan(perm), false, num_threads);
+  }
+}
+
+TYPED_TEST(TransposeCPUTest, CHW2HWC) {
+  int perm[] = { 1, 2, 0 };
+  for (int num_threads : { 1, 4 })
+    this->RunTest({ 3, 97, 131 }, make_cspan(perm), true, num_threads);
+}
+
+TYPED_TEST(TransposeCPUTest, Transpose2D) {
+  int perm[] = { 1, 0 };
+  for (int num_threads : { 1, 4 }) {
+    this->RunTest({ 256, 128 }, make_cspan(perm), false, num_threads);
+    this->RunTest({ 67, 45 }, make_cspan(perm), false, num_threads);
+    this->RunTest({ 1, 45 }, make_cspan(perm), false, num_threads);
+  }
+}
+
+TYPED_TEST(TransposeCPUTest, Permutations4D) {
+  this->RunPermutations4({ 13, 36, 18, 5 });
+  this->RunPermutations4({ 2, 1, 40, 33 });
+}
+
+}  // namespace kernels
+}  // namespace dali
@@ -15,8 +15,10 @@
 #include "dali/kernels/transpose/transpose_gpu.h"
 #include <cuda_runtime.h>
 #include <memory>
+#include <string>
 #include <vector>
 #include "dali/core/util.h"
+#include "dali/kernels/common/launch_tuner.h"
 #include "dali/kernels/common/type_erasure.h"
 #include "dali/kernels/transpose/transpose_gpu_def.h"
 #include "dali/kernels/transpose/transpose_gpu_impl.cuh"
@@ -33,6 +35,11 @@ struct TransposeInfo {
   SmallVector<int, 6> perm;
 };
 
+/// The candidate CUDA block sizes of the generic and deinterleaving kernels, chosen by
+/// LaunchTuner; the first one is the default
+constexpr int kNumBlockSizes = 4;
+constexpr int kBlockSizes[kNumBlockSizes] = { 256, 128, 512, 1024 };
+
 constexpr int kMaxInterleaveSize = 32;
 constexpr int kMaxDeinterleaveSize = kMaxInterleaveSize;
 
@@ -219,18 +226,23 @@ class TransposeGPU::Impl {
   void RunGeneric(KernelContext &ctx, T *const *out, const T *const *in) {
     if (!generic_descs_.empty()) {
       uint64_t max_size = 0;
-      int block_size = 256;
+      uint64_t total_size = 0;
+      auto key = TuningKey("generic");
+      int block_size_idx = LaunchTuner::Get().Choose(key, kNumBlockSizes);
+      int block_size = kBlockSizes[block_size_idx];
       for (size_t i = 0; i < generic_descs_.size(); i++) {
         generic_descs_[i].out = out[idx_generic_[i]];
         generic_descs_[i].in =  in[idx_generic_[i]];
         if (generic_descs_[i].size > max_size)
           max_size = generic_descs_[i].size;
+        total_size += generic_descs_[i].size;
       }
       auto *gpu_descs = reinterpret_cast<GenericTransposeDesc<T>*>(
         ctx.scratchpad->ToGPU(ctx.gpu.stream, generic_descs_));
 
       dim3 grid(div_ceil(max_size, block_size * 8), generic_descs_.size());
 
+      auto timer = LaunchTuner::Get().Time(key, block_size_idx, total_size, ctx.gpu.stream);
       TransposeGenericBatch<<<grid, block_size, 0, ctx.gpu.stream>>>(gpu_descs);
     }
   }
@@ -273,7 +285,10 @@ class TransposeGPU::Impl {
   void RunDeinterleave(KernelContext &ctx, T *const *out, const T *const *in) {
     if (!deinterleave_descs_.empty()) {
       int64_t max_size = 0;
-      int block_size = 256;
+      int64_t total_size = 0;
+      auto key = TuningKey("deinterleave");
+      int block_size_idx = LaunchTuner::Get().Choose(key, kNumBlockSizes);
+      int block_size = kBlockSizes[block_size_idx];
 
       for (size_t i = 0; i < deinterleave_descs_.size(); i++) {
         auto &desc = deinterleave_descs_[i];
@@ -282,16 +297,22 @@ class TransposeGPU::Impl {
         int64_t outer_size = desc.size / desc.in_strides[desc.ndim-2];
         if (outer_size > max_size)
           max_size = outer_size;
+        total_size += desc.size;
       }
 
       auto *gpu_descs = reinterpret_cast<DeinterleaveDesc<T>*>(
         ctx.scratchpad->ToGPU(ctx.gpu.stream, deinterleave_descs_));
 
       dim3 grid(div_ceil(max_size, 4*block_size), deinterleave_descs_.size());
+      auto timer = LaunchTuner::Get().Time(key, block_size_idx, total_size, ctx.gpu.stream);
       TransposeDeinterleaveBatch<<<grid, block_size, 0, ctx.gpu.stream>>>(gpu_descs);
     }
   }
 
+  std::string TuningKey(const char *method) const {
+    return make_string("TransposeGPU_", method, "_", element_size_, "_", in_shape_.sample_dim());
+  }
+
   int element_size_ = 0;
   TensorListShape<> in_shape_, out_shape_;
   std::vector<TransposeInfo> infos_;
@@ -18,6 +18,7 @@
 #include <cuda_runtime.h>
 #include "dali/core/tensor_view.h"
 #include "dali/core/fast_div.h"
+#include "dali/kernels/common/static_ndim.h"
 #include "dali/kernels/transpose/transpose_gpu_def.h"
 #include "dali/core/static_switch.h"
 
@@ -211,11 +212,11 @@ struct DeinterleaveDesc {
   int ndim;
 };
 
-template <typename T>
-__device__ void TransposeDeinterleave(const DeinterleaveDesc<T> &desc) {
+template <int static_ndim, typename T>
+__device__ void TransposeDeinterleaveStatic(const DeinterleaveDesc<T> &desc) {
   const int tid = threadIdx.x;
 
-  int ndim = desc.ndim;
+  const int ndim = static_ndim > 0 ? static_ndim : desc.ndim;
   int lanes = desc.in_strides[ndim-2];
 
   uint64_t lane_stride = desc.out_strides[ndim-1];
@@ -228,12 +229,8 @@ __device__ void TransposeDeinterleave(const DeinterleaveDesc<T> &desc) {
   const T *in = desc.in;
 
   for (uint64_t in_ofs = start_ofs; in_ofs < desc.size; in_ofs += grid_stride) {
-    uint64_t out_ofs = 0;
-    uint64_t tmp_idx = in_ofs;
-    for (int d = 0; d < ndim - 1; d++) {
-      uint64_t a = div_mod(tmp_idx, tmp_idx, desc.in_strides[d]);
-      out_ofs += a * desc.out_strides[d];
-    }
+    // in_ofs is a multiple of the number of lanes, so the innermost index is always 0
+    uint64_t out_ofs = RemapOffset<static_ndim>(in_ofs, desc.in_strides, desc.out_strides, ndim);
 
     for (int lane = 0; lane < lanes; lane++) {
       out[out_ofs + lane * lane_stride] = __ldg(&in[in_ofs + lane]);
@@ -255,10 +252,16 @@ struct GenericTransposeDesc {
 };
 
 template <typename T>
-__device__ void TransposeGeneric(const GenericTransposeDesc<T> &desc) {
-  const int tid = threadIdx.x;
+__device__ void TransposeDeinterleave(const DeinterleaveDesc<T> &desc) {
+  // deinterleaving requires at least 2 dimensions
+  VALUE_SWITCH(desc.ndim, static_ndim, (2, 3, 4),
+    (TransposeDeinterleaveStatic<static_ndim>(desc)),
+    (TransposeDeinterleaveStatic<DynamicDimensions>(desc)));
+}
 
-  int ndim = desc.ndim;
+template <int static_ndim, typename T>
+__device__ void TransposeGenericStatic(const GenericTransposeDesc<T> &desc) {
+  const int tid = threadIdx.x;
 
   const uint64_t block_size = blockDim.x;
   uint64_t start_ofs = blockIdx.x * block_size + tid;
@@ -268,18 +271,19 @@ __device__ void TransposeGeneric(const GenericTransposeDesc<T> &desc) {
   const T *in = desc.in;
 
   for (uint64_t out_ofs = start_ofs; out_ofs < desc.size; out_ofs += grid_stride) {
-    uint64_t in_ofs = 0;
-    uint64_t tmp_idx = out_ofs;
-    for (int d = 0; d < ndim - 1; d++) {
-      uint64_t a = div_mod(tmp_idx, tmp_idx, desc.out_strides[d]);
-      in_ofs += a * desc.in_strides[d];
-    }
-    in_ofs += tmp_idx * desc.in_strides[ndim-1];
-
+    uint64_t in_ofs = RemapOffset<static_ndim>(out_ofs, desc.out_strides, desc.in_strides,
+                                               desc.ndim);
     out[out_ofs] = in[in_ofs];
   }
 }
 
+template <typename T>
+__device__ void TransposeGeneric(const GenericTransposeDesc<T> &desc) {
+  NDIM_SWITCH(desc.ndim, static_ndim, (
+    TransposeGenericStatic<static_ndim>(desc)
+  ));  // NOLINT
+}
+
 template <typename T>
 __global__ void TransposeDeinterleaveSingle(DeinterleaveDesc<T> desc) {
   TransposeDeinterleave(desc);
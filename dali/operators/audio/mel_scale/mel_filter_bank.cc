@@ -13,12 +13,23 @@
 // limitations under the License.
 
 #include "dali/operators/audio/mel_scale/mel_filter_bank.h"
+#include <algorithm>
 #include "dali/core/static_switch.h"
+#include "dali/core/util.h"
 #include "dali/kernels/audio/mel_scale/mel_filter_bank_cpu.h"
 #include "dali/pipeline/data/views.h"
 
 namespace dali {
 
+namespace {
+
+/// The long samples are split into blocks of at least this many frames
+constexpr int64_t kMinFramesPerBlock = 64;
+/// The target number of blocks per thread, to balance the load
+constexpr int kBlocksPerThread = 4;
+
+}  // namespace
+
 DALI_SCHEMA(MelFilterBank)
     .DocStr(R"code(Converts a spectrogram to a mel spectrogram by applying a bank of
 triangular filters.
@@ -65,6 +76,42 @@ The supported values are:
   | This value is consistent with the implementation of the Hidden Markov Toolkit (HTK).
 )code", "slaney");
 
+DALI_SCHEMA(LogMelFilterBank)
+    .DocStr(R"code(Converts a spectrogram to a log-mel spectrogram, optionally normalized.
+
+The result is equivalent to :meth:`MelFilterBank` followed by :meth:`ToDecibels` with a fixed
+``reference`` and, if ``normalize_features`` is set, by :meth:`Normalize` calculating
+the statistics per mel bin, but the decibel conversion is done in the filter bank kernel
+and the normalization is done in place, without the intermediate outputs.
+
+This operator is available only on the GPU.
+)code")
+    .NumInput(kNumInputs)
+    .NumOutput(kNumOutputs)
+    .AddOptionalArg("multiplier",
+      R"code(Factor by which the logarithm is multiplied. The value is typically 10.0 or 20.0,
+which depends on whether the magnitude is squared.)code",
+      10.0f)
+    .AddOptionalArg("reference",
+      R"code(Reference magnitude.
+
+Unlike in :meth:`ToDecibels`, the reference must be provided - using the maximum of
+the input would require a separate reduction pass.)code",
+      1.0f)
+    .AddOptionalArg("cutoff_db",
+      R"code(Minimum or cut-off ratio in dB.
+
+Any value below this value will saturate.)code",
+      -200.0f)
+    .AddOptionalArg("normalize_features",
+      R"code(If set to True, each mel bin of a sample is normalized to zero mean and unit
+variance, with the statistics calculated over all other dimensions of the sample.)code",
+      false)
+    .AddOptionalArg("epsilon",
+      R"code(A value added to the variance in the feature normalization.)code",
+      0.0f)
+    .AddParent("MelFilterBank");
+
 template <>
 bool MelFilterBank<CPUBackend>::SetupImpl(std::vector<OutputDesc> &output_desc,
                                           const workspace_t<CPUBackend> &ws) {
@@ -98,17 +145,37 @@ void MelFilterBank<CPUBackend>::RunImpl(workspace_t<CPUBackend> &ws) {
   const auto &input = ws.InputRef<CPUBackend>(0);
   auto &output = ws.OutputRef<CPUBackend>(0);
   auto in_shape = input.shape();
+  int nsamples = in_shape.num_samples();
   auto& thread_pool = ws.GetThreadPool();
 
+  // The samples are split into blocks of frames (spectra), so that a long sample is processed
+  // by all the threads instead of holding up the batch
+  auto num_frames = [&](int i) {
+    int64_t nbins = in_shape.tensor_shape_span(i)[args_.axis];
+    return nbins > 0 ? in_shape.tensor_size(i) / nbins : 0;
+  };
+  int64_t total_frames = 0;
+  for (int i = 0; i < nsamples; i++)
+    total_frames += num_frames(i);
+  int64_t block_frames = std::max(kMinFramesPerBlock,
+                                  div_ceil(total_frames, thread_pool.NumThreads() *
+                                                         kBlocksPerThread));
+
   TYPE_SWITCH(input.type(), type2id, T, MEL_FBANK_SUPPORTED_TYPES, (
     using MelFilterBankKernel = kernels::audio::MelFilterBankCpu<T>;
-    for (int i = 0; i < input.shape().num_samples(); i++) {
-      thread_pool.AddWork(
-        [this, &input, &output, i](int thread_id) {
-          auto in_view = view<const T>(input[i]);
-          auto out_view = view<T>(output[i]);
-          kmgr_.Run<MelFilterBankKernel>(thread_id, i, ctx_, out_view, in_view);
-        }, in_shape.tensor_size(i));
+    for (int i = 0; i < nsamples; i++) {
+      int64_t nframes = num_frames(i);
+      int64_t nblocks = div_ceil(nframes, block_frames);
+      for (int64_t b = 0; b < nblocks; b++) {
+        int64_t begin = nframes * b / nblocks, end = nframes * (b + 1) / nblocks;
+        thread_pool.AddWork(
+          [this, &input, &output, i, begin, end](int thread_id) {
+            kernels::KernelContext ctx;
+            auto in_view = view<const T>(input[i]);
+            auto out_view = view<T>(output[i]);
+            kmgr_.Get<MelFilterBankKernel>(i).RunFrames(ctx, out_view, in_view, begin, end);
+          }, (end - begin) * in_shape.tensor_shape_span(i)[args_.axis]);
+      }
     }
   ), DALI_FAIL(make_string("Unsupported data type: ", input.type())));  // NOLINT
 
@@ -1,4 +1,4 @@
-// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2019-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -78,6 +78,7 @@ class MelFilterBank : public Operator<Backend> {
   kernels::KernelManager kmgr_;
   kernels::KernelContext ctx_;
   kernels::audio::MelFilterBankArgs args_;
+  kernels::audio::LogMelArgs log_args_;  // only used by the GPU backend
 };
 
 }  // namespace dali
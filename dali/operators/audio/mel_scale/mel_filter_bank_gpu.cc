@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cmath>
 #include "dali/operators/audio/mel_scale/mel_filter_bank.h"
 #include "dali/core/static_switch.h"
 #include "dali/pipeline/data/views.h"
@@ -37,7 +38,7 @@ bool MelFilterBank<GPUBackend>::SetupImpl(std::vector<OutputDesc> &output_desc,
     kmgr_.Resize<MelFilterBankKernel>(1, 1);
     output_desc[0].type = type2id<T>::value;
     auto in_view = view<const T>(input);
-    auto &req = kmgr_.Setup<MelFilterBankKernel>(0, ctx_, in_view, args_);
+    auto &req = kmgr_.Setup<MelFilterBankKernel>(0, ctx_, in_view, args_, log_args_);
     output_desc[0].shape = req.output_shapes[0];
   ), DALI_FAIL(make_string("Unsupported data type: ", input.type())));  // NOLINT
   return true;
@@ -59,4 +60,27 @@ void MelFilterBank<GPUBackend>::RunImpl(workspace_t<GPUBackend> &ws) {
 
 DALI_REGISTER_OPERATOR(MelFilterBank, MelFilterBank<GPUBackend>, GPU);
 
+/**
+ * @brief MelFilterBank with the decibel conversion and the feature normalization
+ *        fused into the filter bank kernel
+ */
+class LogMelFilterBank : public MelFilterBank<GPUBackend> {
+ public:
+  explicit LogMelFilterBank(const OpSpec &spec) : MelFilterBank<GPUBackend>(spec) {
+    log_args_.to_db = true;
+    log_args_.multiplier = spec.GetArgument<float>("multiplier");
+    log_args_.s_ref = spec.GetArgument<float>("reference");
+    DALI_ENFORCE(log_args_.s_ref > 0.0f, "reference should be > 0");
+    auto cutoff_db = spec.GetArgument<float>("cutoff_db");
+    log_args_.min_ratio = std::pow(10.0f, cutoff_db / log_args_.multiplier);
+    if (log_args_.min_ratio == 0)
+      log_args_.min_ratio = std::nextafter(0.0f, 1.0f);
+    log_args_.normalize_features = spec.GetArgument<bool>("normalize_features");
+    log_args_.epsilon = spec.GetArgument<float>("epsilon");
+    DALI_ENFORCE(log_args_.epsilon >= 0.0f, "epsilon should be >= 0");
+  }
+};
+
+DALI_REGISTER_OPERATOR(LogMelFilterBank, LogMelFilterBank, GPU);
+
 }  // namespace dali
@@ -13,10 +13,11 @@
 // limitations under the License.
 
 #include "dali/operators/audio/mfcc/mfcc.h"
+#include <algorithm>
 #include "dali/core/static_switch.h"
+#include "dali/core/util.h"
 #include "dali/kernels/signal/dct/dct_cpu.h"
 #include "dali/kernels/common/utils.h"
-#include "dali/kernels/common/for_axis.h"
 #include "dali/pipeline/data/views.h"
 
 #define MFCC_SUPPORTED_NDIMS (2, 3, 4)
@@ -50,29 +51,36 @@ DLL_PUBLIC void LifterCoeffs<CPUBackend>::Calculate(int64_t target_length, float
 }
 
 
+/**
+ * @brief Applies the lifter to the frames [frame_begin, frame_end) of `inout`
+ *
+ * The frames are the 1D signals along `axis`, indexed in the order of the remaining dimensions.
+ */
 template <typename T, int Dims>
-void ApplyLifter(const kernels::OutTensorCPU<T, Dims> &inout, int axis, const T* lifter_coeffs) {
+void ApplyLifter(const kernels::OutTensorCPU<T, Dims> &inout, int axis, const T* lifter_coeffs,
+                 int64_t frame_begin, int64_t frame_end) {
   assert(axis >= 0 && axis < Dims);
   assert(lifter_coeffs != nullptr);
-  auto* data = inout.data;
-  auto shape = inout.shape;
-  auto strides = kernels::GetStrides(shape);
-  kernels::ForAxis(
-    data, data, shape.data(), strides.data(), shape.data(), strides.data(), axis, Dims,
-    [lifter_coeffs](
-      T *out_data, const T *in_data, int64_t out_size, int64_t out_stride,
-      int64_t in_size, int64_t in_stride) {
-        int64_t idx = 0;
-        assert(out_size == in_size);
-        assert(out_stride == in_stride);
-        for (int64_t k = 0; k < out_size; k++, idx += out_stride) {
-          out_data[idx] = lifter_coeffs[k] * in_data[idx];
-        }
-      });
+  int64_t n = inout.shape[axis];
+  int64_t inner = volume(inout.shape.begin() + axis + 1, inout.shape.end());
+  for (int64_t f = frame_begin; f < frame_end; f++) {
+    T *data = inout.data + (f / inner * n * inner + f % inner);
+    for (int64_t k = 0; k < n; k++)
+      data[k * inner] *= lifter_coeffs[k];
+  }
 }
 
 }  // namespace detail
 
+namespace {
+
+/// The long samples are split into blocks of at least this many frames
+constexpr int64_t kMinFramesPerBlock = 64;
+/// The target number of blocks per thread, to balance the load
+constexpr int kBlocksPerThread = 4;
+
+}  // namespace
+
 DALI_SCHEMA(MFCC)
     .DocStr(R"code(Computes Mel Frequency Cepstral Coefficiencs (MFCC) from
 a mel spectrogram.)code")
@@ -159,21 +167,39 @@ void MFCC<CPUBackend>::RunImpl(workspace_t<CPUBackend> &ws) {
   int nsamples = input.size();
   auto& thread_pool = ws.GetThreadPool();
 
+  // The samples are split into blocks of frames, so that a long sample is processed
+  // by all the threads instead of holding up the batch
+  auto num_frames = [&](int i) {
+    int64_t n = in_shape.tensor_shape_span(i)[axis_];
+    return n > 0 ? in_shape.tensor_size(i) / n : 0;
+  };
+  int64_t total_frames = 0;
+  for (int i = 0; i < nsamples; i++)
+    total_frames += num_frames(i);
+  int64_t block_frames = std::max(kMinFramesPerBlock,
+                                  div_ceil(total_frames, thread_pool.NumThreads() *
+                                                         kBlocksPerThread));
+
   TYPE_SWITCH(input.type(), type2id, T, MFCC_SUPPORTED_TYPES, (
     VALUE_SWITCH(in_shape.sample_dim(), Dims, MFCC_SUPPORTED_NDIMS, (
       using DctKernel = kernels::signal::dct::Dct1DCpu<T, T, Dims>;
-      for (int i = 0; i < input.shape().num_samples(); i++) {
-        thread_pool.AddWork(
-          [this, &input, &output, i](int thread_id) {
-            kernels::KernelContext ctx;
-            auto in_view = view<const T, Dims>(input[i]);
-            auto out_view = view<T, Dims>(output[i]);
-            kmgr_.Run<DctKernel>(thread_id, i, ctx, out_view, in_view, args_[i], axis_);
-            if (lifter_ != 0.0f) {
-              assert(static_cast<int64_t>(lifter_coeffs_.size()) >= out_view.shape[axis_]);
-              detail::ApplyLifter(out_view, axis_, lifter_coeffs_.data());
-            }
-          }, in_shape.tensor_size(i));
+      for (int i = 0; i < nsamples; i++) {
+        int64_t nframes = num_frames(i);
+        int64_t nblocks = div_ceil(nframes, block_frames);
+        for (int64_t b = 0; b < nblocks; b++) {
+          int64_t begin = nframes * b / nblocks, end = nframes * (b + 1) / nblocks;
+          thread_pool.AddWork(
+            [this, &input, &output, i, begin, end](int thread_id) {
+              kernels::KernelContext ctx;
+              auto in_view = view<const T, Dims>(input[i]);
+              auto out_view = view<T, Dims>(output[i]);
+              kmgr_.Get<DctKernel>(i).RunFrames(ctx, out_view, in_view, begin, end);
+              if (lifter_ != 0.0f) {
+                assert(static_cast<int64_t>(lifter_coeffs_.size()) >= out_view.shape[axis_]);
+                detail::ApplyLifter(out_view, axis_, lifter_coeffs_.data(), begin, end);
+              }
+            }, (end - begin) * in_shape.tensor_shape_span(i)[axis_]);
+        }
       }
     ), DALI_FAIL(make_string("Unsupported number of dimensions ", in_shape.size())));  // NOLINT
   ), DALI_FAIL(make_string("Unsupported data type: ", input.type())));  // NOLINT
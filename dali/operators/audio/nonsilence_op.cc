@@ -76,9 +76,6 @@ bool NonsilenceOperatorCpu::SetupImpl(std::vector<OutputDesc> &output_desc,
 }
 
 
-#define NONSILENCE_TYPES (uint8_t, int8_t, uint16_t, int16_t, uint32_t, int32_t, uint64_t, int64_t, float)  // NOLINT
-
-
 void NonsilenceOperatorCpu::RunImpl(workspace_t<CPUBackend> &ws) {
   const auto &input = ws.template InputRef<CPUBackend>(0);
   TYPE_SWITCH(input.type(), type2id, InputType, NONSILENCE_TYPES, (
@@ -87,7 +84,4 @@ void NonsilenceOperatorCpu::RunImpl(workspace_t<CPUBackend> &ws) {
 }
 
 
-#undef NONSILENCE_TYPES
-
-
 }  // namespace dali
@@ -0,0 +1,219 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <limits>
+#include <vector>
+#include "dali/core/cuda_utils.h"
+#include "dali/core/static_switch.h"
+#include "dali/kernels/reduce/reduce_common.cuh"
+#include "dali/kernels/reduce/reductions.h"
+#include "dali/kernels/signal/moving_mean_square_gpu.h"
+#include "dali/operators/audio/nonsilence_op.h"
+#include "dali/pipeline/data/views.h"
+
+namespace dali {
+
+namespace detail {
+
+constexpr int kNonsilenceBlockDimY = 8;
+
+struct NonsilenceSampleDesc {
+  const float *mms;
+  int64_t mms_len;
+  int window;
+  float threshold;  // relative to the reference power
+  float reference_power;
+  int *begin;
+  int *length;
+};
+
+struct NonsilenceState {
+  float max_mms;
+  int first;
+  int last;
+};
+
+/**
+ * @brief Calculates the maximum of the moving mean square of each sample
+ *
+ * The values are non-negative, so they can be compared as integers.
+ */
+__global__ void MaxPowerKernel(const NonsilenceSampleDesc *samples, NonsilenceState *states) {
+  const auto &sample = samples[blockIdx.y];
+  int64_t block_size = blockDim.x * blockDim.y;
+  int64_t k = blockIdx.x * block_size + threadIdx.y * blockDim.x + threadIdx.x;
+  float max_val = 0;
+  for (; k < sample.mms_len; k += block_size * gridDim.x)
+    max_val = cuda_max(max_val, sample.mms[k]);
+  if (kernels::BlockReduce(max_val, kernels::reductions::max()))
+    atomicMax(reinterpret_cast<int *>(&states[blockIdx.y].max_mms), __float_as_int(max_val));
+}
+
+/**
+ * @brief Finds the first and the last position where the power is above the threshold
+ */
+__global__ void ThresholdKernel(const NonsilenceSampleDesc *samples, NonsilenceState *states,
+                                bool reference_max) {
+  const auto &sample = samples[blockIdx.y];
+  auto &state = states[blockIdx.y];
+  float threshold = sample.threshold * (reference_max ? state.max_mms : sample.reference_power);
+  int64_t block_size = blockDim.x * blockDim.y;
+  int64_t k = blockIdx.x * block_size + threadIdx.y * blockDim.x + threadIdx.x;
+  int first = std::numeric_limits<int>::max(), last = -1;
+  for (; k < sample.mms_len; k += block_size * gridDim.x) {
+    if (sample.mms[k] >= threshold) {
+      first = cuda_min<int>(first, k);
+      last = k;
+    }
+  }
+  if (kernels::BlockReduce(first, kernels::reductions::min()))
+    atomicMin(&state.first, first);
+  __syncthreads();  // the shared memory of BlockReduce is reused
+  if (kernels::BlockReduce(last, kernels::reductions::max()))
+    atomicMax(&state.last, last);
+}
+
+/**
+ * @brief Stores the begin and the length of the nonsilent region, as `DetectNonsilenceRegion`
+ */
+__global__ void StoreRegionKernel(const NonsilenceSampleDesc *samples,
+                                  const NonsilenceState *states, int nsamples) {
+  int i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i >= nsamples)
+    return;
+  const auto &state = states[i];
+  if (state.last < 0) {
+    *samples[i].begin = 0;
+    *samples[i].length = 0;
+  } else {
+    *samples[i].begin = state.first;
+    *samples[i].length = state.last - state.first + 1 + samples[i].window - 1;
+  }
+}
+
+}  // namespace detail
+
+class NonsilenceOperatorGpu : public NonsilenceOperator<GPUBackend> {
+ public:
+  explicit NonsilenceOperatorGpu(const OpSpec &spec) :
+          NonsilenceOperator<GPUBackend>(spec) {
+    mms_.set_type<float>();
+    scratch_mem_.set_type<uint8_t>();
+  }
+
+  ~NonsilenceOperatorGpu() override = default;
+
+  DISABLE_COPY_MOVE_ASSIGN(NonsilenceOperatorGpu);
+
+ protected:
+  bool SetupImpl(std::vector<OutputDesc> &output_desc,
+                 const workspace_t<GPUBackend> &ws) override {
+    AcquireArgs(spec_, ws);
+    TensorShape<> scalar_shape = {};
+    auto curr_batch_size = ws.GetInputBatchSize(0);
+
+    output_desc.resize(detail::kNumOutputs);
+    for (int i = 0; i < detail::kNumOutputs; i++) {
+      output_desc[i].shape = uniform_list_shape(curr_batch_size, scalar_shape);
+      output_desc[i].type = DALI_INT32;
+    }
+    return true;
+  }
+
+  void RunImpl(workspace_t<GPUBackend> &ws) override {
+    const auto &input = ws.template InputRef<GPUBackend>(0);
+    TYPE_SWITCH(input.type(), type2id, InputType, NONSILENCE_TYPES, (
+            RunImplTyped<InputType>(ws);
+    ), DALI_FAIL(make_string("Unsupported input type: ", input.type())))  // NOLINT
+  }
+
+ private:
+  template<typename InputType>
+  void RunImplTyped(workspace_t<GPUBackend> &ws) {
+    using MMSKernel = kernels::signal::MovingMeanSquareGpu<InputType>;
+    const auto &input = ws.template InputRef<GPUBackend>(0);
+    auto &output_begin = ws.OutputRef<GPUBackend>(0);
+    auto &output_length = ws.OutputRef<GPUBackend>(1);
+    int nsamples = input.ntensor();
+    auto stream = ws.stream();
+
+    DALI_ENFORCE(input.shape().sample_dim() == 1, make_string(
+        "NonsilentRegion expects 1D input. Got ", input.shape().sample_dim(), "D"));
+    auto in_view = view<const InputType, 1>(input);
+    kernels::signal::MovingMeanSquareArgs mms_args{window_length_, reset_interval_};
+    kmgr_.Initialize<MMSKernel>();
+    kmgr_.Resize<MMSKernel>(1, 1);
+    ctx_.gpu.stream = stream;
+    auto &req = kmgr_.Setup<MMSKernel>(0, ctx_, in_view, mms_args);
+    mms_.Resize(req.output_shapes[0]);
+    auto mms_view = view<float, 1>(mms_);
+    kmgr_.Run<MMSKernel>(0, 0, ctx_, mms_view, in_view, mms_args);
+
+    samples_.resize(nsamples);
+    states_.resize(nsamples);
+    int64_t max_len = 0;
+    for (int i = 0; i < nsamples; i++) {
+      auto &sample = samples_[i];
+      int64_t length = in_view.shape[i][0];
+      sample.mms = mms_view.data[i];
+      sample.mms_len = mms_view.shape[i][0];
+      sample.window = std::min<int64_t>(window_length_, length);
+      // same as DecibelToMagnitude(10, 1)(cutoff_db), the reference is applied in the kernel
+      sample.threshold = std::pow(10.f, cutoff_db_[i] / 10.f);
+      sample.reference_power = reference_max_ ? 0.f : reference_power_[i];
+      sample.begin = output_begin.mutable_tensor<int>(i);
+      sample.length = output_length.mutable_tensor<int>(i);
+      states_[i] = { 0.f, std::numeric_limits<int>::max(), -1 };
+      max_len = std::max(max_len, sample.mms_len);
+    }
+    if (nsamples == 0)
+      return;
+
+    // sample descriptors followed by the states; the descriptors' size keeps the states aligned
+    int64_t samples_size = nsamples * sizeof(detail::NonsilenceSampleDesc);
+    int64_t states_size = nsamples * sizeof(detail::NonsilenceState);
+    scratch_mem_.Resize({samples_size + states_size});
+    auto *scratch = scratch_mem_.mutable_data<uint8_t>();
+    auto *samples_gpu = reinterpret_cast<detail::NonsilenceSampleDesc *>(scratch);
+    auto *states_gpu = reinterpret_cast<detail::NonsilenceState *>(scratch + samples_size);
+    CUDA_CALL(cudaMemcpyAsync(samples_gpu, samples_.data(), samples_size,
+                              cudaMemcpyHostToDevice, stream));
+    CUDA_CALL(cudaMemcpyAsync(states_gpu, states_.data(), states_size,
+                              cudaMemcpyHostToDevice, stream));
+
+    dim3 block(32, detail::kNonsilenceBlockDimY);
+    int block_size = block.x * block.y;
+    int blocks_per_sample = std::max<int64_t>(1, std::min<int64_t>(
+        div_ceil(max_len, block_size * 8), 1024 / nsamples + 1));
+    dim3 grid(blocks_per_sample, nsamples);
+    if (reference_max_)
+      detail::MaxPowerKernel<<<grid, block, 0, stream>>>(samples_gpu, states_gpu);
+    detail::ThresholdKernel<<<grid, block, 0, stream>>>(samples_gpu, states_gpu, reference_max_);
+    detail::StoreRegionKernel<<<div_ceil(nsamples, 256), 256, 0, stream>>>(
+        samples_gpu, states_gpu, nsamples);
+    CUDA_CALL(cudaGetLastError());
+  }
+
+  kernels::KernelManager kmgr_;
+  kernels::KernelContext ctx_;
+  TensorList<GPUBackend> mms_;
+  std::vector<detail::NonsilenceSampleDesc> samples_;
+  std::vector<detail::NonsilenceState> states_;
+  Tensor<GPUBackend> scratch_mem_;
+};
+
+DALI_REGISTER_OPERATOR(NonsilentRegion, NonsilenceOperatorGpu, GPU);
+
+}  // namespace dali
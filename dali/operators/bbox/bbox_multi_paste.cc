@@ -0,0 +1,202 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/bbox/bbox_multi_paste.h"
+#include <algorithm>
+#include "dali/core/tensor_view.h"
+
+namespace dali {
+
+DALI_SCHEMA(BBoxMultiPaste)
+    .DocStr(R"code(Transforms bounding boxes along with the regions pasted with
+:meth:`nvidia.dali.fn.multi_paste`.
+
+The arguments describing the pastes are the same as in
+:meth:`nvidia.dali.fn.multi_paste`. For each paste, the boxes of the input sample selected
+with ``in_ids`` are clipped to the source region and mapped to the destination region::
+
+  x' = (x - in_anchor_x) * out_shape_x / shape_x + out_anchor_x
+  y' = (y - in_anchor_y) * out_shape_y / shape_y + out_anchor_y
+
+The boxes which don't intersect the source region are discarded. The output contains
+the boxes of all the pastes, in the order of pasting.
+
+.. note::
+  The boxes are not clipped by the regions pasted later, even if they're fully covered.
+)code")
+    .NumInput(1, 2)  // [boxes, labels (optional),]
+    .InputDox(0, "boxes", "2D TensorList of float", R"code(Bounding boxes in the input images.
+
+The boxes are represented as 2D tensors with 4 columns, containing the corner coordinates
+``[left, top, right, bottom]`` in pixels.)code")
+    .InputDox(1, "labels", "1D TensorList of int", R"code(Labels associated with the
+bounding boxes.)code")
+    .NumOutput(1)  // [boxes, labels (optional)]
+    .AdditionalOutputsFn([](const OpSpec &spec) {
+      return spec.NumRegularInput() - 1;  // +1 if labels are provided
+    })
+    .AddArg("in_ids", R"code(Indices of the inputs to paste data from.)code",
+            DALI_INT_VEC, true)
+    .AddArg("shapes", R"code(Shape of the source regions, in (height, width) order.
+
+The shapes are represented as 2D tensors where the first dimension corresponds to the
+elements of ``in_ids``.)code", DALI_INT_VEC, true)
+    .AddOptionalArg<int>("in_anchors", R"code(Absolute coordinates of LU corner
+of the source region, in (y, x) order.
+
+If not provided, all anchors are zero.)code", nullptr, true)
+    .AddOptionalArg<int>("out_anchors", R"code(Absolute coordinates of LU corner
+of the destination region, in (y, x) order.
+
+If not provided, all anchors are zero.)code", nullptr, true)
+    .AddOptionalArg<int>("out_shapes", R"code(Shape of the destination regions,
+in (height, width) order.
+
+If not provided, the destination regions have the same shapes as the source regions.)code",
+                         nullptr, true);
+
+void BBoxMultiPaste::AcquireArguments(const HostWorkspace &ws, int batch_size) {
+  in_idx_.Acquire(spec_, ws, batch_size, false);
+  shapes_.Acquire(spec_, ws, batch_size, false);
+  if (in_anchors_.IsDefined())
+    in_anchors_.Acquire(spec_, ws, batch_size, false);
+  if (out_anchors_.IsDefined())
+    out_anchors_.Acquire(spec_, ws, batch_size, false);
+  if (out_shapes_.IsDefined())
+    out_shapes_.Acquire(spec_, ws, batch_size, false);
+}
+
+bool BBoxMultiPaste::SetupImpl(std::vector<OutputDesc> &output_desc, const HostWorkspace &ws) {
+  const auto &in_boxes = ws.InputRef<CPUBackend>(0);
+  DALI_ENFORCE(in_boxes.type() == DALI_FLOAT, "``boxes`` input is expected to be float");
+  auto in_boxes_view = view<const float>(in_boxes);
+  int batch_size = in_boxes_view.num_samples();
+  for (int i = 0; i < batch_size; i++) {
+    auto sh = in_boxes_view.tensor_shape(i);
+    DALI_ENFORCE(sh.sample_dim() == 2 && sh[1] == 4,
+                 make_string("``boxes`` are expected to be 2D tensors with 4 columns, got ", sh));
+  }
+  bool has_labels = ws.NumInput() > 1;
+  TensorListShape<> in_labels_shape;
+  if (has_labels) {
+    const auto &in_labels = ws.InputRef<CPUBackend>(1);
+    DALI_ENFORCE(in_labels.type() == DALI_INT32, "``labels`` input is expected to be int32");
+    in_labels_shape = in_labels.shape();
+    for (int i = 0; i < batch_size; i++) {
+      auto sh = in_labels_shape.tensor_shape_span(i);
+      DALI_ENFORCE(sh.size() >= 1 && sh[0] == in_boxes_view.tensor_shape_span(i)[0],
+                   make_string("The number of labels doesn't match the number of boxes in sample ",
+                               i));
+    }
+  }
+
+  AcquireArguments(ws, batch_size);
+  TensorListShape<2> out_boxes_shape(batch_size);
+  auto out_labels_shape = in_labels_shape;
+  pasted_.resize(batch_size);
+  for (int i = 0; i < batch_size; i++) {
+    auto &pasted = pasted_[i];
+    pasted.clear();
+    int n_paste = in_idx_[i].shape[0];
+    DALI_ENFORCE(shapes_[i].shape[0] == n_paste && shapes_[i].shape[1] == 2,
+                 "``shapes`` must contain 2 values for each element of ``in_ids``");
+    if (in_anchors_.IsDefined()) {
+      DALI_ENFORCE(in_anchors_[i].shape[0] == n_paste && in_anchors_[i].shape[1] == 2,
+                   "``in_anchors`` must contain 2 values for each element of ``in_ids``");
+    }
+    if (out_anchors_.IsDefined()) {
+      DALI_ENFORCE(out_anchors_[i].shape[0] == n_paste && out_anchors_[i].shape[1] == 2,
+                   "``out_anchors`` must contain 2 values for each element of ``in_ids``");
+    }
+    if (out_shapes_.IsDefined()) {
+      DALI_ENFORCE(out_shapes_[i].shape[0] == n_paste && out_shapes_[i].shape[1] == 2,
+                   "``out_shapes`` must contain 2 values for each element of ``in_ids``");
+    }
+
+    for (int j = 0; j < n_paste; j++) {
+      int in_idx = in_idx_[i].data[j];
+      DALI_ENFORCE(in_idx >= 0 && in_idx < batch_size, "in_idx value out of bounds");
+      // the arguments are in (y, x) order, the boxes - in (x, y)
+      vec2 in_anchor, shape, out_anchor, out_shape;
+      for (int d = 0; d < 2; d++) {
+        int k = 2 * j + 1 - d;
+        shape[d] = shapes_[i].data[k];
+        in_anchor[d] = in_anchors_.IsDefined() ? in_anchors_[i].data[k] : 0;
+        out_anchor[d] = out_anchors_.IsDefined() ? out_anchors_[i].data[k] : 0;
+        out_shape[d] = out_shapes_.IsDefined() ? out_shapes_[i].data[k] : shape[d];
+      }
+      if (shape[0] <= 0 || shape[1] <= 0)
+        continue;
+      Box<2, float> region(in_anchor, in_anchor + shape);
+      vec2 scale = out_shape / shape;
+
+      const float *boxes = in_boxes_view.tensor_data(in_idx);
+      int64_t nboxes = in_boxes_view.tensor_shape_span(in_idx)[0];
+      for (int64_t b = 0; b < nboxes; b++) {
+        const float *ltrb = boxes + 4 * b;
+        Box<2, float> box({ ltrb[0], ltrb[1] }, { ltrb[2], ltrb[3] });
+        box = intersection(box, region);
+        if (box.empty())
+          continue;
+        box.lo = (box.lo - in_anchor) * scale + out_anchor;
+        box.hi = (box.hi - in_anchor) * scale + out_anchor;
+        pasted.push_back({ box, in_idx, b });
+      }
+    }
+    out_boxes_shape.set_tensor_shape(i, { static_cast<int64_t>(pasted.size()), 4 });
+    if (has_labels)
+      out_labels_shape.tensor_shape_span(i)[0] = pasted.size();
+  }
+
+  output_desc.resize(has_labels ? 2 : 1);
+  output_desc[0] = { out_boxes_shape, DALI_FLOAT };
+  if (has_labels)
+    output_desc[1] = { out_labels_shape, DALI_INT32 };
+  return true;
+}
+
+void BBoxMultiPaste::RunImpl(HostWorkspace &ws) {
+  auto out_boxes = view<float, 2>(ws.OutputRef<CPUBackend>(0));
+  bool has_labels = ws.NumInput() > 1;
+  TensorListView<StorageCPU, const int> in_labels;
+  TensorListView<StorageCPU, int> out_labels;
+  if (has_labels) {
+    in_labels = view<const int>(ws.InputRef<CPUBackend>(1));
+    out_labels = view<int>(ws.OutputRef<CPUBackend>(1));
+  }
+
+  for (int i = 0; i < out_boxes.num_samples(); i++) {
+    float *boxes = out_boxes.tensor_data(i);
+    const auto &pasted = pasted_[i];
+    for (size_t b = 0; b < pasted.size(); b++) {
+      boxes[4 * b] = pasted[b].box.lo.x;
+      boxes[4 * b + 1] = pasted[b].box.lo.y;
+      boxes[4 * b + 2] = pasted[b].box.hi.x;
+      boxes[4 * b + 3] = pasted[b].box.hi.y;
+    }
+    if (has_labels) {
+      int64_t label_size = volume(out_labels.tensor_shape_span(i).begin() + 1,
+                                  out_labels.tensor_shape_span(i).end());
+      int *labels = out_labels.tensor_data(i);
+      for (size_t b = 0; b < pasted.size(); b++) {
+        const int *src = in_labels.tensor_data(pasted[b].in_idx) + pasted[b].box_idx * label_size;
+        std::copy(src, src + label_size, labels + b * label_size);
+      }
+    }
+  }
+}
+
+DALI_REGISTER_OPERATOR(BBoxMultiPaste, BBoxMultiPaste, CPU);
+
+}  // namespace dali
@@ -0,0 +1,71 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_BBOX_BBOX_MULTI_PASTE_H_
+#define DALI_OPERATORS_BBOX_BBOX_MULTI_PASTE_H_
+
+#include <vector>
+
+#include "dali/core/common.h"
+#include "dali/core/error_handling.h"
+#include "dali/core/geom/box.h"
+#include "dali/pipeline/operator/arg_helper.h"
+#include "dali/pipeline/operator/common.h"
+#include "dali/pipeline/operator/operator.h"
+
+namespace dali {
+
+/**
+ * @brief Transforms the bounding boxes along with the regions pasted by MultiPaste
+ */
+class BBoxMultiPaste : public Operator<CPUBackend> {
+ public:
+  explicit BBoxMultiPaste(const OpSpec &spec)
+      : Operator<CPUBackend>(spec)
+      , in_idx_("in_ids", spec)
+      , in_anchors_("in_anchors", spec)
+      , shapes_("shapes", spec)
+      , out_anchors_("out_anchors", spec)
+      , out_shapes_("out_shapes", spec) {}
+
+ protected:
+  bool CanInferOutputs() const override {
+    return true;
+  }
+
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const HostWorkspace &ws) override;
+  void RunImpl(HostWorkspace &ws) override;
+
+ private:
+  void AcquireArguments(const HostWorkspace &ws, int batch_size);
+
+  /// A box in the output, along with the index of the source box (in its input sample)
+  struct PastedBox {
+    Box<2, float> box;
+    int in_idx;
+    int64_t box_idx;
+  };
+
+  ArgValue<int, 1> in_idx_;
+  ArgValue<int, 2> in_anchors_;
+  ArgValue<int, 2> shapes_;
+  ArgValue<int, 2> out_anchors_;
+  ArgValue<int, 2> out_shapes_;
+
+  std::vector<std::vector<PastedBox>> pasted_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_BBOX_BBOX_MULTI_PASTE_H_
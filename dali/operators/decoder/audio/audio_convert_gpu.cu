@@ -0,0 +1,194 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <type_traits>
+#include "dali/core/convert.h"
+#include "dali/core/cuda_utils.h"
+#include "dali/core/error_handling.h"
+#include "dali/core/static_switch.h"
+#include "dali/core/util.h"
+#include "dali/operators/decoder/audio/audio_convert_gpu.h"
+
+namespace dali {
+
+namespace {
+
+constexpr int kConvertBlock = 256;
+
+template <typename Out, typename In>
+__device__ DALI_FORCEINLINE std::enable_if_t<std::is_same<Out, In>::value, Out>
+ConvertSample(In value) {
+  return value;  // not processed - decoded directly to the output type
+}
+
+template <typename Out, typename In>
+__device__ DALI_FORCEINLINE std::enable_if_t<!std::is_same<Out, In>::value, Out>
+ConvertSample(In value) {
+  return ConvertSatNorm<Out>(ConvertNorm<float>(value));
+}
+
+/**
+ * @brief The window function, interpolated from the lookup table, as in `ResamplingWindow`
+ */
+__device__ DALI_FORCEINLINE float WindowValue(const float *lookup,
+                                              const AudioResamplingWindow &window, float x) {
+  float fi = x * window.scale + window.center;
+  int i = floorf(fi);
+  float di = fi - i;
+  return lookup[i] + di * (lookup[i + 1] - lookup[i]);
+}
+
+/**
+ * @brief Reads one channel of an input frame or, with `channel < 0`, the average of the channels
+ */
+template <typename In>
+__device__ DALI_FORCEINLINE float FrameValue(const In *frame, int channels, int channel) {
+  if (channel >= 0)
+    return ConvertNorm<float>(frame[channel]);
+  float value = 0;
+  for (int c = 0; c < channels; c++)
+    value += ConvertNorm<float>(frame[c]);
+  return value * (1.0f / channels);
+}
+
+/**
+ * @brief Computes one output frame of a resampled signal
+ *
+ * @param channel   the channel to compute or -1 to average all the channels
+ */
+template <typename In>
+__device__ float ResampleFrame(const AudioSampleDesc &sample, const float *lookup,
+                               const AudioResamplingWindow &window, int64_t out_pos,
+                               int channel) {
+  const In *in = static_cast<const In *>(sample.in);
+  const int channels = sample.channels;
+  double in_pos_f = out_pos * (static_cast<double>(sample.in_rate) / sample.out_rate);
+  int64_t in_base = floor(in_pos_f);
+  float in_pos = in_pos_f - in_base;
+  int64_t i0 = static_cast<int64_t>(ceilf(in_pos)) - window.lobes;
+  int64_t i1 = static_cast<int64_t>(floorf(in_pos)) + window.lobes;
+  if (i0 + in_base < 0)
+    i0 = -in_base;
+  if (i1 + in_base >= sample.in_length)
+    i1 = sample.in_length - 1 - in_base;
+  float f = 0;
+  float x = i0 - in_pos;
+  for (int64_t i = i0; i <= i1; i++, x++) {
+    float w = WindowValue(lookup, window, x);
+    f += FrameValue(in + (in_base + i) * channels, channels, channel) * w;
+  }
+  return f;
+}
+
+/**
+ * @brief Computes one output frame of a resampled signal with the polyphase filter bank
+ *
+ * The output frame `out_pos` is centered at the input frame `out_pos * step / phases`
+ * and the remainder of the division selects the set of coefficients.
+ *
+ * @param channel   the channel to compute or -1 to average all the channels
+ */
+template <typename In>
+__device__ float ResampleFramePolyphase(const AudioSampleDesc &sample, int lobes,
+                                        int64_t out_pos, int channel) {
+  const In *in = static_cast<const In *>(sample.in);
+  const int channels = sample.channels;
+  const int taps = 2 * lobes + 1;
+  int64_t pos = out_pos * sample.bank_step;
+  int64_t in_base = pos / sample.bank_phases;
+  int64_t phase = pos - in_base * sample.bank_phases;
+  const float *coeffs = sample.filter_bank + phase * taps;
+  int64_t i0 = in_base - lobes;
+  int k0 = cuda_max<int64_t>(0, -i0);
+  int k1 = cuda_min<int64_t>(taps, sample.in_length - i0);
+  float f = 0;
+  for (int k = k0; k < k1; k++)
+    f += FrameValue(in + (i0 + k) * channels, channels, channel) * __ldg(coeffs + k);
+  return f;
+}
+
+template <typename Out, typename In>
+__device__ void ConvertSampleData(const AudioSampleDesc &sample, const float *lookup,
+                                  const AudioResamplingWindow &window) {
+  Out *out = static_cast<Out *>(sample.out);
+  const In *in = static_cast<const In *>(sample.in);
+  const int channels = sample.channels;
+  const int out_channels = sample.downmix ? 1 : channels;
+  const bool resample = sample.in_rate != sample.out_rate;
+  for (int64_t o = blockIdx.x * blockDim.x + threadIdx.x; o < sample.out_length;
+       o += blockDim.x * gridDim.x) {
+    if (resample) {
+      for (int c = 0; c < out_channels; c++) {
+        int channel = sample.downmix ? -1 : c;
+        float f = sample.filter_bank
+                ? ResampleFramePolyphase<In>(sample, window.lobes, o, channel)
+                : ResampleFrame<In>(sample, lookup, window, o, channel);
+        out[o * out_channels + c] = ConvertSatNorm<Out>(f);
+      }
+    } else if (sample.downmix && channels > 1) {
+      float sum = 0;
+      for (int c = 0; c < channels; c++)
+        sum += ConvertNorm<float>(in[o * channels + c]);
+      out[o] = ConvertSatNorm<Out>(sum * (1.0f / channels));
+    } else {
+      for (int c = 0; c < channels; c++)
+        out[o * channels + c] = ConvertSample<Out>(in[o * channels + c]);
+    }
+  }
+}
+
+template <typename Out>
+__global__ void AudioConvertKernel(const AudioSampleDesc *samples, AudioResamplingWindow window) {
+  extern __shared__ float lookup[];
+  for (int i = threadIdx.x; i < window.lookup_size; i += blockDim.x)
+    lookup[i] = window.lookup[i];
+  __syncthreads();
+
+  const auto &sample = samples[blockIdx.y];
+  if (blockIdx.x == 0 && threadIdx.x == 0)
+    *sample.out_rate_ptr = sample.out_rate;
+  switch (sample.in_type) {
+    case DALI_INT16:
+      ConvertSampleData<Out, int16_t>(sample, lookup, window);
+      break;
+    case DALI_INT32:
+      ConvertSampleData<Out, int32_t>(sample, lookup, window);
+      break;
+    case DALI_FLOAT:
+      ConvertSampleData<Out, float>(sample, lookup, window);
+      break;
+    default:
+      break;
+  }
+}
+
+}  // namespace
+
+void AudioConvert(const AudioSampleDesc *samples, int num_samples, int64_t max_out_length,
+                  const AudioResamplingWindow &window, DALIDataType out_type,
+                  cudaStream_t stream) {
+  if (num_samples == 0)
+    return;
+  int blocks = std::min<int64_t>(std::max<int64_t>(div_ceil(max_out_length, kConvertBlock), 1),
+                                 1024);
+  size_t shm_size = window.lookup_size * sizeof(float);
+  TYPE_SWITCH(out_type, type2id, Out, (int16_t, int32_t, float), (
+    AudioConvertKernel<Out><<<dim3(blocks, num_samples), kConvertBlock, shm_size, stream>>>(
+        samples, window);
+  ), DALI_FAIL(make_string("Unsupported output type: ", out_type)));  // NOLINT
+  CUDA_CALL(cudaGetLastError());
+}
+
+}  // namespace dali
@@ -0,0 +1,83 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_DECODER_AUDIO_AUDIO_CONVERT_GPU_H_
+#define DALI_OPERATORS_DECODER_AUDIO_AUDIO_CONVERT_GPU_H_
+
+#include <cuda_runtime.h>
+#include <stdint.h>
+#include "dali/core/common.h"
+#include "dali/pipeline/data/types.h"
+
+namespace dali {
+
+/**
+ * @brief A decoded audio sample, to be converted on the GPU
+ */
+struct AudioSampleDesc {
+  /// the decoded, interleaved samples of the type `in_type`, in device memory
+  const void *in;
+  /// the output - interleaved or, when downmixing, single-channel
+  void *out;
+  /// where the output sampling rate is stored
+  float *out_rate_ptr;
+  int64_t in_length;
+  int64_t out_length;
+  int channels;
+  bool downmix;
+  DALIDataType in_type;
+  float in_rate;
+  float out_rate;
+  /**
+   * @brief The polyphase filter bank (`phases` x `2 * lobes + 1` coefficients) in device memory,
+   *        or null, if the sample is to be resampled with the interpolated window
+   *
+   * @see kernels::signal::resampling::PolyphaseFilterBank
+   */
+  const float *filter_bank;
+  int64_t bank_step;
+  int64_t bank_phases;
+};
+
+/**
+ * @brief The windowed-sinc filter of `kernels::signal::resampling::ResamplingWindow`
+ */
+struct AudioResamplingWindow {
+  /// the lookup table, in device memory
+  const float *lookup;
+  int lookup_size;
+  int lobes;
+  float scale;
+  float center;
+};
+
+/**
+ * @brief Converts the decoded samples to `out_type`, with optional downmixing and resampling
+ *
+ * The integer inputs are normalized, the channels are averaged (with `downmix`) and
+ * the samples with `in_rate != out_rate` are resampled with the windowed-sinc filter,
+ * like in `kernels::signal::resampling::Resampler` - with the precomputed polyphase filter bank,
+ * if the sample has one, or by interpolating the lookup table of the window, otherwise.
+ *
+ * @param samples         descriptors of the samples, in device memory
+ * @param num_samples     the number of samples
+ * @param max_out_length  the longest output, in frames
+ */
+DLL_PUBLIC void AudioConvert(const AudioSampleDesc *samples, int num_samples,
+                             int64_t max_out_length, const AudioResamplingWindow &window,
+                             DALIDataType out_type, cudaStream_t stream);
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_DECODER_AUDIO_AUDIO_CONVERT_GPU_H_
@@ -28,6 +28,9 @@ struct AudioMetadata {
   int sample_rate;
   int channels;
   bool channels_interleaved = true;
+  /// @brief Bits per sample of an integer PCM encoding; 0 for the floating point
+  ///        or the non-PCM (e.g. Vorbis) encodings
+  int bits_per_sample = 0;
 };
 
 class AudioDecoderBase {
@@ -1,4 +1,4 @@
-// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2020-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include "dali/operators/decoder/audio/audio_decoder_impl.h"
+#include <algorithm>
+#include <cmath>
 #include "dali/kernels/signal/downmixing.h"
 
 namespace dali {
@@ -22,7 +24,7 @@ std::pair<int64_t, int64_t> ProcessOffsetAndLength(const AudioMetadata &meta,
   int64_t offset = 0;
   int64_t length = meta.length;
   if (offset_sec >= 0.0) {
-    offset = static_cast<int64_t>(offset_sec * meta.sample_rate);
+    offset = std::min<int64_t>(offset_sec * meta.sample_rate, meta.length);
   }
 
   if (length_sec >= 0.0) {
@@ -36,6 +38,12 @@ std::pair<int64_t, int64_t> ProcessOffsetAndLength(const AudioMetadata &meta,
   return {offset, length};
 }
 
+int ResamplingLobes(float quality) {
+  double q = quality;
+  DALI_ENFORCE(q >= 0 && q <= 100, "Resampling quality must be in [0..100] range");
+  return std::round(0.007 * q * q - 0.09 * q + 3);
+}
+
 TensorShape<> DecodedAudioShape(const AudioMetadata &meta, float target_sample_rate, bool downmix) {
   bool should_resample = target_sample_rate > 0 && meta.sample_rate != target_sample_rate;
   bool should_downmix = meta.channels > 1 && downmix;
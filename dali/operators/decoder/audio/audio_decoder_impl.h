@@ -1,4 +1,4 @@
-// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2020-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -28,7 +28,7 @@ namespace dali {
  * @brief Converts offset and length in seconds to offset and lenght in number of samples
  *        according with the audio metadata
  * @param meta Audio metadata
- * @param offset_sec offset, in seconds (optional)
+ * @param offset_sec offset, in seconds (optional). An offset past the end gives an empty range
  * @param length_sec length, in seconds. If a negative value is provided, whole buffer is assumed
  * @returns pair containing offset and length in number of samples
  */
@@ -47,6 +47,13 @@ DLL_PUBLIC std::pair<int64_t, int64_t> ProcessOffsetAndLength(const AudioMetadat
 DLL_PUBLIC TensorShape<> DecodedAudioShape(const AudioMetadata &meta, float target_sample_rate = -1,
                                            bool downmix = true);
 
+/**
+ * @brief Returns the number of lobes of the resampling filter for the given quality
+ * @param quality Resampling quality, in [0..100] range: 3 lobes for 0, 16 lobes for 50
+ *                and 64 lobes for 100
+ */
+DLL_PUBLIC int ResamplingLobes(float quality);
+
 /**
  * @brief Decodes audio data, with optional downmixing and resampling
  * @param audio Destination buffer. The function will decode as many audio samples as the shape of this argument
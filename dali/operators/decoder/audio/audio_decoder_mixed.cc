@@ -0,0 +1,238 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/decoder/audio/audio_decoder_mixed.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <tuple>
+#include <utility>
+#include "dali/core/static_switch.h"
+#include "dali/core/util.h"
+#include "dali/operators/decoder/audio/audio_decoder_impl.h"
+#include "dali/operators/decoder/audio/generic_decoder.h"
+
+namespace dali {
+
+DALI_REGISTER_OPERATOR(decoders__Audio, AudioDecoderMixed, Mixed);
+DALI_REGISTER_OPERATOR(AudioDecoder, AudioDecoderMixed, Mixed);
+
+AudioDecoderMixed::AudioDecoderMixed(const OpSpec &spec)
+    : Operator<MixedBackend>(spec),
+      output_type_(spec.GetArgument<DALIDataType>("dtype")),
+      downmix_(spec.GetArgument<bool>("downmix")),
+      use_resampling_(spec.HasArgument("sample_rate") || spec.HasTensorArgument("sample_rate")),
+      quality_(spec.GetArgument<float>("quality")),
+      thread_pool_(num_threads_, spec.GetArgument<int>("device_id"), false) {
+  DALI_ENFORCE(output_type_ == DALI_INT16 || output_type_ == DALI_INT32 ||
+               output_type_ == DALI_FLOAT,
+               make_string("Unsupported output type: ", output_type_));
+  if (use_resampling_) {
+    int lobes = ResamplingLobes(quality_);
+    resampler_.Initialize(lobes, lobes * 64 + 1);
+    window_lookup_.from_host(resampler_.window.lookup);
+  }
+  staging_event_ = CUDAEvent::Create(spec.GetArgument<int>("device_id"));
+}
+
+AudioDecoderMixed::~AudioDecoderMixed() {
+  try {
+    if (staging_event_)
+      CUDA_CALL(cudaEventSynchronize(staging_event_));
+  } catch (const std::exception &e) {
+    // the staging buffer may still be used by a pending copy, so it can't be freed
+    std::cerr << "Fatal error: exception in ~AudioDecoderMixed():\n" << e.what() << std::endl;
+    std::terminate();
+  }
+}
+
+DALIDataType AudioDecoderMixed::DecodeType(const AudioMetadata &meta, float target_rate) const {
+  bool should_resample = target_rate > 0 && meta.sample_rate != target_rate;
+  bool should_downmix = meta.channels > 1 && downmix_;
+  if (!should_resample && !should_downmix)
+    return output_type_;
+  if (meta.bits_per_sample > 0 && meta.bits_per_sample <= 16)
+    return DALI_INT16;
+  if (meta.bits_per_sample > 16 && meta.bits_per_sample <= 32)
+    return DALI_INT32;
+  return DALI_FLOAT;
+}
+
+bool AudioDecoderMixed::SetupImpl(std::vector<OutputDesc> &output_desc,
+                                  const MixedWorkspace &ws) {
+  auto &input = ws.InputRef<CPUBackend>(0);
+  const int batch_size = input.ntensor();
+  GetPerSampleArgument<float>(target_sample_rates_, "sample_rate", ws, batch_size);
+  GetPerSampleArgument<float>(offsets_sec_, "offset", ws, batch_size);
+  GetPerSampleArgument<float>(durations_sec_, "duration", ws, batch_size);
+  DALI_ENFORCE(IsType<uint8_t>(input.type()), "Raw files must be stored as uint8 data.");
+
+  decoders_.resize(batch_size);
+  samples_.resize(batch_size);
+  TensorListShape<> shape_data(batch_size, downmix_ ? 1 : 2);
+  for (int i = 0; i < batch_size; i++) {
+    DALI_ENFORCE(input[i].shape().size() == 1, "Raw input must be 1D encoded byte data");
+    thread_pool_.AddWork([&, i](int) {
+      auto &sample = samples_[i];
+      if (!decoders_[i])
+        decoders_[i] = make_generic_audio_decoder();
+      sample.file_name = input[i].GetSourceInfo();
+      try {
+        sample.meta = decoders_[i]->Open({static_cast<const char *>(input[i].raw_data()),
+                                          input[i].shape().num_elements()});
+      } catch (const DALIException &e) {
+        DALI_FAIL(make_string("Error decoding file ", sample.file_name, ". Error: ", e.what()));
+      }
+      std::tie(sample.start_frame, sample.meta.length) =
+          ProcessOffsetAndLength(sample.meta, offsets_sec_[i], durations_sec_[i]);
+      sample.target_rate = use_resampling_ ? target_sample_rates_[i] : sample.meta.sample_rate;
+      sample.decode_type = DecodeType(sample.meta, sample.target_rate);
+      shape_data.set_tensor_shape(i, DecodedAudioShape(sample.meta, sample.target_rate,
+                                                       downmix_));
+    }, input[i].size());
+  }
+  thread_pool_.RunAll();
+
+  output_desc.resize(2);
+  output_desc[0] = { shape_data, output_type_ };
+  output_desc[1] = { TensorListShape<>(batch_size, 0), DALI_FLOAT };
+  return true;
+}
+
+const kernels::signal::resampling::PolyphaseFilterBank &
+AudioDecoderMixed::GetFilterBank(float in_rate, float out_rate) {
+  auto key = std::make_pair(in_rate, out_rate);
+  auto it = filter_banks_.find(key);
+  if (it != filter_banks_.end())
+    return it->second;
+  auto &bank = filter_banks_[key];
+  kernels::signal::resampling::MakePolyphaseFilterBank(bank, resampler_.window, in_rate, out_rate);
+  return bank;
+}
+
+void AudioDecoderMixed::DecodeSample(int sample_idx) {
+  auto &sample = samples_[sample_idx];
+  auto &decoder = *decoders_[sample_idx];
+  void *out = staging_.get() + sample.offset;
+  int64_t length = sample.meta.length;
+  int64_t ret = 0;
+  if (sample.start_frame > 0) {
+    DALI_ENFORCE(decoder.SeekFrames(sample.start_frame, SEEK_SET) >= 0,
+                 make_string("Error decoding audio file ", sample.file_name,
+                             ". Failed to seek to frame ", sample.start_frame));
+  }
+  TYPE_SWITCH(sample.decode_type, type2id, T, (int16_t, int32_t, float), (
+    ret = decoder.DecodeFrames(static_cast<T *>(out), length);
+  ), DALI_FAIL(make_string("Unsupported type: ", sample.decode_type)));  // NOLINT
+  DALI_ENFORCE(ret == length,
+    make_string("Error decoding audio file ", sample.file_name, ". Requested ",
+                length, " samples but got ", ret, " samples."));
+}
+
+void AudioDecoderMixed::Run(MixedWorkspace &ws) {
+  auto &output = ws.OutputRef<GPUBackend>(0);
+  auto &rates = ws.OutputRef<GPUBackend>(1);
+  const int batch_size = samples_.size();
+
+  constexpr size_t kAlignment = 256;
+  size_t offset = align_up(batch_size * sizeof(AudioSampleDesc), kAlignment);
+  for (auto &sample : samples_) {
+    sample.offset = offset;
+    size_t type_size = TypeTable::GetTypeInfo(sample.decode_type).size();
+    offset += align_up(sample.meta.length * sample.meta.channels * type_size, kAlignment);
+  }
+
+  // the filter banks of the rate pairs resampled in this batch follow the decoded samples
+  std::map<std::pair<float, float>, size_t> bank_offsets;
+  if (filter_banks_.size() >= kMaxFilterBanks)
+    filter_banks_.clear();  // many distinct rates - don't keep the banks of the past batches
+  for (auto &sample : samples_) {
+    auto rates = std::make_pair(static_cast<float>(sample.meta.sample_rate), sample.target_rate);
+    if (!use_resampling_ || rates.second <= 0 || rates.first == rates.second ||
+        bank_offsets.count(rates))
+      continue;
+    auto &bank = GetFilterBank(rates.first, rates.second);
+    if (bank.empty())
+      continue;
+    bank_offsets[rates] = offset;
+    offset += align_up(bank.coeffs.size() * sizeof(float), kAlignment);
+  }
+  staging_used_ = offset;
+
+  // the previous iteration may still be using the buffers
+  CUDA_CALL(cudaEventSynchronize(staging_event_));
+  if (offset > staging_size_) {
+    staging_.reset();
+    staging_ = mm::alloc_raw_unique<uint8_t, mm::memory_kind::pinned>(offset);
+    staging_size_ = offset;
+  }
+  buffer_.clear();
+  buffer_.resize(offset, ws.stream());
+  for (auto &bank_offset : bank_offsets) {
+    auto &bank = filter_banks_[bank_offset.first];
+    std::memcpy(staging_.get() + bank_offset.second, bank.coeffs.data(),
+                bank.coeffs.size() * sizeof(float));
+  }
+
+  auto *descs = reinterpret_cast<AudioSampleDesc *>(staging_.get());
+  int64_t max_out_length = 0;
+  for (int i = 0; i < batch_size; i++) {
+    auto &sample = samples_[i];
+    auto &desc = descs[i];
+    desc.in = buffer_.data() + sample.offset;
+    desc.out = output.raw_mutable_tensor(i);
+    desc.out_rate_ptr = rates.mutable_tensor<float>(i);
+    desc.in_length = sample.meta.length;
+    desc.out_length = output.tensor_shape_span(i)[0];
+    desc.channels = sample.meta.channels;
+    desc.downmix = downmix_;
+    desc.in_type = sample.decode_type;
+    desc.in_rate = sample.meta.sample_rate;
+    desc.out_rate = sample.target_rate;
+    desc.filter_bank = nullptr;
+    desc.bank_step = desc.bank_phases = 0;
+    auto bank_it = bank_offsets.find({desc.in_rate, desc.out_rate});
+    if (bank_it != bank_offsets.end()) {
+      auto &bank = filter_banks_[bank_it->first];
+      desc.filter_bank = reinterpret_cast<const float *>(buffer_.data() + bank_it->second);
+      desc.bank_step = bank.step;
+      desc.bank_phases = bank.phases;
+    }
+    max_out_length = std::max(max_out_length, desc.out_length);
+    thread_pool_.AddWork([this, i](int) {
+      DecodeSample(i);
+    }, sample.meta.length * sample.meta.channels);
+  }
+  thread_pool_.RunAll();
+
+  CUDA_CALL(cudaMemcpyAsync(buffer_.data(), staging_.get(), staging_used_,
+                            cudaMemcpyHostToDevice, ws.stream()));
+
+  AudioResamplingWindow window = {};
+  if (use_resampling_) {
+    const auto &w = resampler_.window;
+    window.lookup = window_lookup_.data();
+    window.lookup_size = w.lookup.size();
+    window.lobes = w.lobes;
+    window.scale = w.scale;
+    window.center = w.center;
+  }
+  AudioConvert(reinterpret_cast<const AudioSampleDesc *>(buffer_.data()), batch_size,
+               max_out_length, window, output_type_, ws.stream());
+  CUDA_CALL(cudaEventRecord(staging_event_, ws.stream()));
+}
+
+}  // namespace dali
@@ -0,0 +1,118 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_DECODER_AUDIO_AUDIO_DECODER_MIXED_H_
+#define DALI_OPERATORS_DECODER_AUDIO_AUDIO_DECODER_MIXED_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "dali/core/cuda_event.h"
+#include "dali/core/dev_buffer.h"
+#include "dali/core/mm/memory.h"
+#include "dali/kernels/signal/resampling.h"
+#include "dali/operators/decoder/audio/audio_convert_gpu.h"
+#include "dali/operators/decoder/audio/audio_decoder.h"
+#include "dali/pipeline/operator/operator.h"
+#include "dali/pipeline/util/thread_pool.h"
+
+namespace dali {
+
+/**
+ * @brief Decodes the audio on the host and converts it on the GPU
+ *
+ * The containers are parsed and the samples are decoded (e.g. the FLAC entropy coding)
+ * by libsndfile, in the thread pool, to a pinned staging buffer - in the source precision,
+ * when the audio is to be processed. After a single copy to the GPU, the conversion
+ * to the output type, the downmixing and the resampling run for the whole batch in one kernel.
+ */
+class AudioDecoderMixed : public Operator<MixedBackend> {
+ public:
+  explicit AudioDecoderMixed(const OpSpec &spec);
+
+  ~AudioDecoderMixed() override;
+
+  using Operator<MixedBackend>::Run;
+  void Run(MixedWorkspace &ws) override;
+
+ protected:
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const MixedWorkspace &ws) override;
+
+  bool CanInferOutputs() const override {
+    return true;
+  }
+
+ private:
+  struct SampleInfo {
+    /// the metadata, with `length` limited to the decoded range
+    AudioMetadata meta;
+    /// the first decoded frame
+    int64_t start_frame;
+    float target_rate;
+    /// the type to which libsndfile decodes the sample
+    DALIDataType decode_type;
+    /// the offset of the decoded sample in the staging buffer
+    size_t offset;
+    std::string file_name;
+  };
+
+  /**
+   * @brief Chooses the type to decode to: the output type, if the sample isn't processed,
+   *        or the smallest type holding the decoded samples without a loss of precision
+   */
+  DALIDataType DecodeType(const AudioMetadata &meta, float target_rate) const;
+
+  /**
+   * @brief Decodes the sample to its place in the staging buffer
+   */
+  void DecodeSample(int sample_idx);
+
+  /**
+   * @brief Returns the cached polyphase filter bank for the rates - empty, if the ratio of
+   *        the rates has too many phases and the window is to be interpolated instead
+   */
+  const kernels::signal::resampling::PolyphaseFilterBank &
+  GetFilterBank(float in_rate, float out_rate);
+
+  DALIDataType output_type_ = DALI_NO_TYPE;
+  const bool downmix_ = false, use_resampling_ = false;
+  const float quality_ = 50.0f;
+  std::vector<float> target_sample_rates_;
+  std::vector<float> offsets_sec_, durations_sec_;
+  kernels::signal::resampling::Resampler resampler_;
+  DeviceBuffer<float> window_lookup_;
+  static constexpr size_t kMaxFilterBanks = 64;
+  std::map<std::pair<float, float>, kernels::signal::resampling::PolyphaseFilterBank>
+      filter_banks_;
+
+  std::vector<SampleInfo> samples_;
+  std::vector<std::unique_ptr<AudioDecoderBase>> decoders_;
+
+  /// the sample descriptors, followed by the decoded samples and the filter banks
+  mm::uptr<uint8_t> staging_;
+  size_t staging_size_ = 0;
+  size_t staging_used_ = 0;
+  /// the device copy of `staging_`
+  DeviceBuffer<uint8_t> buffer_;
+  /// recorded after the last use of the buffers
+  CUDAEvent staging_event_;
+
+  ThreadPool thread_pool_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_DECODER_AUDIO_AUDIO_DECODER_MIXED_H_
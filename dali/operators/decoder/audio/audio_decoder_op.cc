@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include "dali/operators/decoder/audio/audio_decoder_op.h"
+#include <cstdio>
+#include <tuple>
 #include "dali/operators/decoder/audio/audio_decoder_impl.h"
 #include "dali/pipeline/operator/op_schema.h"
 #include "dali/pipeline/data/views.h"
@@ -25,6 +27,11 @@ DALI_SCHEMA(decoders__Audio)
   .DocStr(R"code(Decodes waveforms from encoded audio data.
 
 It supports the following audio formats: wav, flac and ogg.
+
+With ``device="mixed"``, the audio is decoded on the host, while the conversion to the output
+type, the downmixing and the resampling are done on the GPU, for the whole batch. Both outputs
+are then in the device memory.
+
 This operator produces the following outputs:
 
 * output[0]: A batch of decoded data
@@ -46,7 +53,17 @@ Supported types: ``INT16``, ``INT32``, ``FLOAT``.)code", DALI_FLOAT)
 the highest.
 
 0 gives 3 lobes of the sinc filter, 50 gives 16 lobes, and 100 gives 64 lobes.)code",
-          50.0f, false);
+          50.0f, false)
+  .AddOptionalArg("offset", R"code(The start of the decoded range, in seconds.
+
+The decoder seeks to this position, so only the requested range is decoded. An offset past
+the end of the recording produces an empty output.)code",
+          0.0f, true)
+  .AddOptionalArg("duration", R"code(The length of the decoded range, in seconds.
+
+A negative value means the remainder of the recording, from ``offset`` on. The range is limited
+to the end of the recording.)code",
+          -1.0f, true);
 
 
 DALI_REGISTER_OPERATOR(AudioDecoder, AudioDecoderCpu, CPU);
@@ -68,6 +85,8 @@ AudioDecoderCpu::SetupImpl(std::vector<OutputDesc> &output_desc, const workspace
   auto &input = ws.template InputRef<Backend>(0);
   const auto batch_size = input.shape().num_samples();
   GetPerSampleArgument<float>(target_sample_rates_, "sample_rate", ws, batch_size);
+  GetPerSampleArgument<float>(offsets_sec_, "offset", ws, batch_size);
+  GetPerSampleArgument<float>(durations_sec_, "duration", ws, batch_size);
 
   for (int i = 0; i < batch_size; i++) {
     DALI_ENFORCE(input.shape()[i].size() == 1, "Raw input must be 1D encoded byte data");
@@ -76,6 +95,7 @@ AudioDecoderCpu::SetupImpl(std::vector<OutputDesc> &output_desc, const workspace
   decoders_.resize(batch_size);
   sample_meta_.resize(batch_size);
   files_names_.resize(batch_size);
+  start_frames_.resize(batch_size);
 
   decode_type_ = use_resampling_ ? DALI_FLOAT : output_type_;
   for (int i = 0; i < batch_size; i++)
@@ -90,6 +110,8 @@ AudioDecoderCpu::SetupImpl(std::vector<OutputDesc> &output_desc, const workspace
     auto &meta = sample_meta_[i] =
         decoders_[i]->Open({reinterpret_cast<const char *>(input[i].raw_mutable_data()),
                             input[i].shape().num_elements()});
+    std::tie(start_frames_[i], meta.length) =
+        ProcessOffsetAndLength(meta, offsets_sec_[i], durations_sec_[i]);
     TensorShape<> data_sample_shape = DecodedAudioShape(
         meta, use_resampling_ ? target_sample_rates_[i] : -1.0f, downmix_);
     shape_data.set_tensor_shape(i, data_sample_shape);
@@ -127,7 +149,10 @@ AudioDecoderCpu::DecodeSample(const TensorView<StorageCPU, OutputType, DynamicDi
   auto &scratch_resampler = scratch_resampler_[thread_idx];
   scratch_resampler.resize(resample_scratch_sz);
 
-  // TODO(janton): handle offset and duration
+  if (start_frames_[sample_idx] > 0) {
+    DALI_ENFORCE(decoders_[sample_idx]->SeekFrames(start_frames_[sample_idx], SEEK_SET) >= 0,
+                 make_string("Failed to seek to frame ", start_frames_[sample_idx]));
+  }
 
   DecodeAudio<OutputType>(
     audio, *decoders_[sample_idx], meta, resampler_,
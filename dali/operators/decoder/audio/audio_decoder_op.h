@@ -1,4 +1,4 @@
-// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2019-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -20,6 +20,7 @@
 #include <vector>
 #include "dali/core/static_switch.h"
 #include "dali/operators/decoder/audio/audio_decoder.h"
+#include "dali/operators/decoder/audio/audio_decoder_impl.h"
 #include "dali/operators/decoder/audio/generic_decoder.h"
 #include "dali/pipeline/data/backend.h"
 #include "dali/pipeline/workspace/workspace.h"
@@ -43,10 +44,7 @@ class AudioDecoderCpu : public Operator<CPUBackend> {
           use_resampling_(spec.HasArgument("sample_rate") || spec.HasTensorArgument("sample_rate")),
           quality_(spec.GetArgument<float>("quality")) {
     if (use_resampling_) {
-      double q = quality_;
-      DALI_ENFORCE(q >= 0 && q <= 100, "Resampling quality must be in [0..100] range");
-      // this should give 3 lobes for q = 0, 16 lobes for q = 50 and 64 lobes for q = 100
-      int lobes = std::round(0.007 * q * q - 0.09 * q + 3);
+      int lobes = ResamplingLobes(quality_);
       resampler_.Initialize(lobes, lobes * 64 + 1);
     }
   }
@@ -82,6 +80,9 @@ class AudioDecoderCpu : public Operator<CPUBackend> {
   }
 
   std::vector<float> target_sample_rates_;
+  std::vector<float> offsets_sec_, durations_sec_;
+  /// the first decoded frame of each sample; `sample_meta_` holds the length of the range
+  std::vector<int64_t> start_frames_;
   kernels::signal::resampling::Resampler resampler_;
   DALIDataType output_type_ = DALI_NO_TYPE, decode_type_ = DALI_NO_TYPE;
   const bool downmix_ = false, use_resampling_ = false;
@@ -134,6 +134,24 @@ AudioMetadata GetAudioMetadata(const SF_INFO &sf_info) {
   ret.channels = sf_info.channels;
   ret.sample_rate = sf_info.samplerate;
   ret.channels_interleaved = true;
+  switch (sf_info.format & SF_FORMAT_SUBMASK) {
+    case SF_FORMAT_PCM_S8:
+    case SF_FORMAT_PCM_U8:
+      ret.bits_per_sample = 8;
+      break;
+    case SF_FORMAT_PCM_16:
+      ret.bits_per_sample = 16;
+      break;
+    case SF_FORMAT_PCM_24:
+      ret.bits_per_sample = 24;
+      break;
+    case SF_FORMAT_PCM_32:
+      ret.bits_per_sample = 32;
+      break;
+    default:
+      ret.bits_per_sample = 0;
+      break;
+  }
   return ret;
 }
 
@@ -32,17 +32,23 @@ CachedDecoderImpl::CachedDecoderImpl(const OpSpec& spec)
     const std::size_t cache_size = cache_size_mb * 1024 * 1024;
     const std::size_t cache_threshold =
         static_cast<std::size_t>(spec.GetArgument<int>("cache_threshold"));
+    const std::size_t host_cache_size =
+        static_cast<std::size_t>(spec.GetArgument<int>("cache_host_size")) * 1024 * 1024;
     if (cache_size > 0 && cache_size >= cache_threshold) {
       const std::string cache_type = spec.GetArgument<std::string>("cache_type");
       const bool cache_debug = spec.GetArgument<bool>("cache_debug");
+      const std::string cache_dir = spec.GetArgument<std::string>("cache_dir");
       cache_ = ImageCacheFactory::Instance().Get(
-        device_id_, cache_type, cache_size, cache_debug, cache_threshold);
+        device_id_, cache_type, cache_size, cache_debug, cache_threshold, host_cache_size,
+        cache_dir);
 
       use_batch_copy_kernel_ = spec.GetArgument<bool>("cache_batch_copy");
       auto batch_size = spec.GetArgument<int>("max_batch_size");
       const size_t kMaxSizePerBlock = 1<<18;  // 256 kB per block
+      // the disk cache doesn't keep the images in the device memory
+      const size_t device_cache_size = cache_dir.empty() ? cache_size : 0;
       scatter_gather_.reset(new kernels::ScatterGatherGPU(
-        kMaxSizePerBlock, cache_size, batch_size));
+        kMaxSizePerBlock, device_cache_size, batch_size));
     }
   }
 }
@@ -60,9 +66,15 @@ bool CachedDecoderImpl::DeferCacheLoad(const std::string& file_name, uint8_t *ou
   if (!cache_ || file_name.empty())
     return false;
   auto img = cache_->Get(file_name);
-  if (!img.data)
-    return false;
+  if (!img.data) {
+    // the images which are not in the device memory (e.g. in the disk cache) are read directly
+    if (!cache_->IsCached(file_name))
+      return false;
+    direct_reads_.emplace_back(file_name, output_data);
+    return true;
+  }
   scatter_gather_->AddCopy(output_data, img.data, img.num_elements());
+  deferred_keys_.push_back(file_name);
   return true;
 }
 
@@ -75,6 +87,14 @@ void CachedDecoderImpl::LoadDeferred(cudaStream_t stream) {
   auto copy_method = use_batch_copy_kernel_ ? Method::Default
                                             : Method::Memcpy;
   CUDA_CALL((scatter_gather_->Run(stream, true, copy_method), cudaGetLastError()));
+  // the evicting caches can reuse the memory of these images once the copies are done
+  cache_->FinishDeferredReads(deferred_keys_, stream);
+  deferred_keys_.clear();
+
+  for (auto &read : direct_reads_)
+    DALI_ENFORCE(cache_->Read(read.first, read.second, stream),
+                 "cache entry [" + read.first + "] is no longer available");
+  direct_reads_.clear();
 }
 
 ImageCache::ImageShape CachedDecoderImpl::CacheImageShape(const std::string& file_name) {
@@ -104,6 +124,15 @@ that are larger than ``cache_threshold`` will be cached in GPU memory.
 
 The size threshold, in bytes, for decoded images to be cached. When an image is cached, it no
 longer needs to be decoded when it is encountered at the operator input saving processing time.
+)code",
+      0)
+  .AddOptionalArg("cache_host_size",
+      R"code(Applies **only** to the ``mixed`` backend type.
+
+Size of the second tier of the decoder cache, in pinned host memory, in megabytes.
+
+The images evicted from the GPU memory are moved there and copied back to the GPU memory
+when they are used again. Supported only by the ``lru`` and ``lfu`` cache types.
 )code",
       0)
   .AddOptionalArg("cache_debug",
@@ -129,10 +158,32 @@ Here is a list of the available cache types:
   The warm-up time for threshold policy is 1 epoch.
 * | ``largest``: stores the largest images that can fit in the cache.
   | The warm-up time for largest policy is 2 epochs
+* | ``lru``: caches every image with a size that is larger than ``cache_threshold``; when
+  | the cache is full, evicts the images that were not used for the longest time.
+
+  Suitable when the data set does not fit in the cache.
+* | ``lfu``: like ``lru``, but evicts the images that were used the least number of times.
 
   .. note::
     To take advantage of caching, it is recommended to configure readers with `stick_to_shard=True`
     to limit the amount of unique images seen by each decoder instance in a multi node environment.
+
+* | ``disk``: stores the images in files in ``cache_dir``, until the size of the directory
+  | reaches ``cache_size``. The files are kept after the pipeline is destroyed and the later
+  | pipelines using the same directory read the images from them instead of decoding.
+
+  The image is decoded again if the file named by its source info has changed since it was
+  cached. Only the images larger than ``cache_threshold`` are cached.
+
+With ``cache_debug``, the number of cache hits, misses and evictions is printed, which helps
+to choose the ``cache_size``.
+)code",
+      std::string())
+  .AddOptionalArg("cache_dir",
+      R"code(Applies **only** to the ``mixed`` backend type.
+
+The directory of the ``disk`` cache, preferably on a fast local drive. It's created, if it doesn't
+exist.
 )code",
       std::string());
 
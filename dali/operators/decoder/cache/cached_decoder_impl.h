@@ -18,6 +18,8 @@
 #include <cuda_runtime_api.h>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 #include "dali/operators/decoder/cache/image_cache.h"
 #include "dali/pipeline/operator/op_spec.h"
 
@@ -61,6 +63,10 @@ class CachedDecoderImpl {
   std::unique_ptr<kernels::ScatterGatherGPU> scatter_gather_;
   int device_id_;
   bool use_batch_copy_kernel_ = true;
+  // the images read with DeferCacheLoad, released after LoadDeferred
+  std::vector<ImageCache::ImageKey> deferred_keys_;
+  // the images read with DeferCacheLoad, which are not in the device memory
+  std::vector<std::pair<ImageCache::ImageKey, uint8_t *>> direct_reads_;
 };
 
 }  // namespace dali
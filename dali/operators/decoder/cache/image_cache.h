@@ -17,12 +17,31 @@
 
 #include <cuda_runtime.h>
 #include <string>
+#include <vector>
 #include "dali/core/api_helper.h"
 #include "dali/core/tensor_shape.h"
 #include "dali/core/tensor_view.h"
 
 namespace dali {
 
+struct ImageCacheStats {
+  /// successful reads from the cache
+  std::size_t hits = 0;
+  /// images that were decoded, because they were not in the cache
+  std::size_t misses = 0;
+  /// images removed from the cache to make space for other images
+  std::size_t evictions = 0;
+  std::size_t images_cached = 0;
+  std::size_t bytes_used = 0;
+  std::size_t capacity = 0;
+  /// the second tier, in host memory - the images are counted in images_cached
+  std::size_t host_bytes_used = 0;
+  std::size_t host_capacity = 0;
+  /// images moved from device to host memory and back
+  std::size_t demotions = 0;
+  std::size_t promotions = 0;
+};
+
 class DLL_PUBLIC ImageCache {
  public:
   using ImageKey = std::string;
@@ -72,11 +91,35 @@ class DLL_PUBLIC ImageCache {
    * @brief Get a cache entry describing an image
    * @param image_key key of the cached image
    * @return Pointer and shape of the cached image; if not found, data is null
-   * @remarks This function is valid only if the implementation doesn't evict
-   *          images from the cache.
+   * @remarks If the implementation evicts images from the cache, the image stays valid
+   *          until FinishDeferredReads is called for it.
    */
   DLL_PUBLIC virtual DecodedImage Get(const ImageKey &image_key) const = 0;
 
+  /**
+   * @brief Marks the end of the reads of the images obtained with Get
+   * @param image_keys the keys of the images passed to Get
+   * @param stream cuda stream, in which the copies from the cache were issued
+   */
+  DLL_PUBLIC virtual void FinishDeferredReads(const std::vector<ImageKey> &image_keys,
+                                              cudaStream_t stream) const {}
+
+  /**
+   * @brief Get the hit/miss/eviction counters and the occupancy of the cache
+   */
+  DLL_PUBLIC virtual ImageCacheStats GetStats() const {
+    return {};
+  }
+
+  /**
+   * @brief Drops the cached images and frees the cache memory, if possible
+   * @remarks The memory is allocated again when the next image is added.
+   * @return the number of bytes freed
+   */
+  DLL_PUBLIC virtual std::size_t Trim() {
+    return 0;
+  }
+
   /**
    * @brief Synchronizes internal cache CUDA stream with a provided stream before a cache reading
    *        operation
@@ -71,8 +71,10 @@ bool ImageCacheBlob::Read(const ImageKey& image_key,
   std::lock_guard<std::mutex> lock(mutex_);
   LOG_LINE << "Read: image_key[" << image_key << "]" << std::endl;
   const auto it = cache_.find(image_key);
-  if (it == cache_.end())
+  if (it == cache_.end()) {
+    misses_++;
     return false;
+  }
   const auto& data = it->second;
   DALI_ENFORCE(data.data < tail_);
   const auto n = data.num_elements();
@@ -81,6 +83,7 @@ bool ImageCacheBlob::Read(const ImageKey& image_key,
   SyncToRead(stream);
   MemCopy(destination_buffer, data.data, n, stream);
 
+  hits_++;
   if (stats_enabled_) stats_[image_key].reads++;
   return true;
 }
@@ -90,8 +93,11 @@ ImageCache::DecodedImage ImageCacheBlob::Get(const ImageKey& image_key) const {
   std::lock_guard<std::mutex> lock(mutex_);
   LOG_LINE << "Get: image_key[" << image_key << "]" << std::endl;
   const auto it = cache_.find(image_key);
-  if (it == cache_.end())
+  if (it == cache_.end()) {
+    misses_++;
     return {};
+  }
+  hits_++;
   if (stats_enabled_) stats_[image_key].reads++;
   auto ret = it->second;  // make a copy _before_ leaving the mutex
   return ret;
@@ -103,11 +109,11 @@ void ImageCacheBlob::Add(const ImageKey& image_key, const uint8_t* data,
 
   const std::size_t data_size = volume(data_shape);
   if (stats_enabled_) stats_[image_key].decodes++;
-  if (data_size < image_size_threshold_) return;
-  DALI_ENFORCE(!image_key.empty());
-
   if (cache_.find(image_key) != cache_.end())
     return;
+  misses_++;
+  if (data_size < image_size_threshold_) return;
+  DALI_ENFORCE(!image_key.empty());
 
   if (bytes_left() < data_size) {
     LOG_LINE << "WARNING: not enough space in cache. Ignore" << std::endl;
@@ -136,6 +142,17 @@ void ImageCacheBlob::SyncAfterWrite(cudaStream_t stream) const {
   CUDA_CALL(cudaStreamWaitEvent(cache_stream_, cache_write_event_, 0));
 }
 
+ImageCacheStats ImageCacheBlob::GetStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ImageCacheStats stats;
+  stats.hits = hits_;
+  stats.misses = misses_;
+  stats.images_cached = cache_.size();
+  stats.bytes_used = static_cast<std::size_t>(tail_ - buffer_.get());
+  stats.capacity = cache_size_;
+  return stats;
+}
+
 void ImageCacheBlob::print_stats() const {
   static std::mutex stats_mutex;
   std::lock_guard<std::mutex> lock(stats_mutex);
@@ -154,6 +171,9 @@ void ImageCacheBlob::print_stats() const {
   out << "images_seen: " << images_seen() << std::endl;
   out << "images_cached: " << images_cached << std::endl;
   out << "images_not_cached: " << images_seen() - images_cached << std::endl;
+  out << "hits: " << hits_ << std::endl;
+  out << "misses: " << misses_ << std::endl;
+  out << "evictions: 0" << std::endl;
   for (auto& elem : stats_) {
     out << "image[" << elem.first << "] : is_cached[" << static_cast<int>(elem.second.is_cached)
         << "] decodes[" << elem.second.decodes << "] reads[" << elem.second.reads << "]";
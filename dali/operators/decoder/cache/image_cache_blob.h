@@ -52,6 +52,8 @@ class DLL_PUBLIC ImageCacheBlob : public ImageCache {
 
     void SyncToRead(cudaStream_t stream) const override;  // part of the API
 
+    ImageCacheStats GetStats() const override;
+
  protected:
     void SyncAfterWrite(cudaStream_t stream) const;       // internal impl only
 
@@ -85,6 +87,8 @@ class DLL_PUBLIC ImageCacheBlob : public ImageCache {
     mutable std::unordered_map<ImageKey, Stats> stats_;
     bool is_full = false;
     std::size_t total_seen_images_ = 0;
+    mutable std::size_t hits_ = 0;
+    mutable std::size_t misses_ = 0;
 
     cudaStream_t cache_stream_;
     cudaEvent_t cache_read_event_;
@@ -0,0 +1,359 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/decoder/cache/image_cache_disk.h"
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <vector>
+#include "dali/core/error_handling.h"
+#include "dali/core/format.h"
+#include "dali/core/util.h"
+#include "dali/pipeline/data/backend.h"
+
+namespace dali {
+
+namespace {
+
+constexpr char kMagic[8] = {'D', 'A', 'L', 'I', 'I', 'M', 'G', '1'};
+constexpr const char kEntryExt[] = ".dali_img";
+
+/**
+ * @brief The header of a cache file; it's followed by the key and, at `data_offset`,
+ *        by the image data
+ */
+struct EntryHeader {
+  char magic[8];
+  uint64_t source_size;
+  int64_t source_mtime_ns;
+  int64_t shape[3];
+  uint64_t key_length;
+  uint64_t data_offset;
+};
+
+/**
+ * @brief The size and the modification time of the file named by the key,
+ *        or zeros, if the key is not a path of a file
+ */
+void SourceIdentity(const std::string &key, uint64_t &size, int64_t &mtime_ns) {
+  struct stat st;
+  if (stat(key.c_str(), &st) == 0 && S_ISREG(st.st_mode)) {
+    size = st.st_size;
+    mtime_ns = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+  } else {
+    size = 0;
+    mtime_ns = 0;
+  }
+}
+
+bool IsEntryFile(const char *name) {
+  size_t len = strlen(name), ext_len = sizeof(kEntryExt) - 1;
+  return len > ext_len && strcmp(name + len - ext_len, kEntryExt) == 0;
+}
+
+bool ReadFully(int fd, void *dst, size_t size, off_t offset) {
+  auto *ptr = static_cast<char *>(dst);
+  while (size > 0) {
+    ssize_t n = pread(fd, ptr, size, offset);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return false;
+    ptr += n;
+    offset += n;
+    size -= n;
+  }
+  return true;
+}
+
+bool WriteFully(int fd, const void *src, size_t size, off_t offset) {
+  auto *ptr = static_cast<const char *>(src);
+  while (size > 0) {
+    ssize_t n = pwrite(fd, ptr, size, offset);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return false;
+    ptr += n;
+    offset += n;
+    size -= n;
+  }
+  return true;
+}
+
+size_t EntryDataOffset(size_t key_length) {
+  return align_up(sizeof(EntryHeader) + key_length, ImageCacheDisk::kDataAlignment);
+}
+
+}  // namespace
+
+ImageCacheDisk::ImageCacheDisk(const std::string &cache_dir,
+                               std::size_t cache_size,
+                               std::size_t image_size_threshold,
+                               bool stats_enabled)
+    : cache_dir_(cache_dir)
+    , cache_size_(cache_size)
+    , image_size_threshold_(image_size_threshold)
+    , stats_enabled_(stats_enabled) {
+  DALI_ENFORCE(!cache_dir_.empty(), "The `disk` cache requires a cache directory");
+  DALI_ENFORCE(image_size_threshold <= cache_size_, "Cache size should fit at least one image");
+  if (mkdir(cache_dir_.c_str(), 0777) != 0 && errno != EEXIST)
+    DALI_FAIL(make_string("Could not create the cache directory ", cache_dir_, ": ",
+                          std::strerror(errno)));
+
+  // the images cached by the previous runs count towards the size of the cache
+  DIR *dir = opendir(cache_dir_.c_str());
+  DALI_ENFORCE(dir != nullptr, make_string("Could not open the cache directory ", cache_dir_,
+                                           ": ", std::strerror(errno)));
+  while (auto *ent = readdir(dir)) {
+    if (!IsEntryFile(ent->d_name))
+      continue;
+    struct stat st;
+    if (stat((cache_dir_ + "/" + ent->d_name).c_str(), &st) != 0)
+      continue;
+    bytes_used_ += st.st_size;
+    num_files_++;
+  }
+  closedir(dir);
+  LOG_LINE << "cache " << cache_dir_ << " holds " << num_files_ << " images, "
+           << bytes_used_ / (1024 * 1024) << " MB" << std::endl;
+}
+
+ImageCacheDisk::~ImageCacheDisk() {
+  if (stats_enabled_) print_stats();
+}
+
+std::string ImageCacheDisk::EntryPath(const ImageKey &image_key) const {
+  char name[32];
+  snprintf(name, sizeof(name), "%016zx", std::hash<std::string>()(image_key));
+  return cache_dir_ + "/" + name + kEntryExt;
+}
+
+ImageCacheDisk::Entry ImageCacheDisk::LoadEntry(const ImageKey &image_key) const {
+  Entry entry;
+  std::string path = EntryPath(image_key);
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return entry;
+  EntryHeader header;
+  struct stat st;
+  bool ok = fstat(fd, &st) == 0 &&
+            ReadFully(fd, &header, sizeof(header), 0) &&
+            memcmp(header.magic, kMagic, sizeof(kMagic)) == 0 &&
+            header.key_length == image_key.size();
+  if (ok) {
+    // a different key means a collision of the hashes of the keys
+    std::string stored_key(header.key_length, '\0');
+    ok = ReadFully(fd, &stored_key[0], stored_key.size(), sizeof(header)) &&
+         stored_key == image_key;
+  }
+  close(fd);
+  if (!ok)
+    return entry;
+
+  for (int d = 0; d < 3; d++)
+    entry.shape[d] = header.shape[d];
+  uint64_t source_size;
+  int64_t source_mtime_ns;
+  SourceIdentity(image_key, source_size, source_mtime_ns);
+  bool complete = header.data_offset == EntryDataOffset(header.key_length) &&
+                  static_cast<uint64_t>(st.st_size) == header.data_offset + volume(entry.shape);
+  if (!complete || header.source_size != source_size ||
+      header.source_mtime_ns != source_mtime_ns) {
+    LOG_LINE << "Removing stale cache entry [" << image_key << "]" << std::endl;
+    if (unlink(path.c_str()) == 0) {
+      bytes_used_ -= std::min<std::size_t>(bytes_used_, st.st_size);
+      if (num_files_ > 0) num_files_--;
+    }
+    return entry;
+  }
+  entry.valid = true;
+  entry.data_offset = header.data_offset;
+  return entry;
+}
+
+const ImageCacheDisk::Entry &ImageCacheDisk::LookUp(const ImageKey &image_key) const {
+  auto it = entries_.find(image_key);
+  if (it == entries_.end())
+    it = entries_.emplace(image_key, LoadEntry(image_key)).first;
+  return it->second;
+}
+
+bool ImageCacheDisk::IsCached(const ImageKey &image_key) const {
+  if (image_key.empty())
+    return false;
+  std::lock_guard<std::mutex> lock(mutex_);
+  return LookUp(image_key).valid;
+}
+
+const ImageCache::ImageShape &ImageCacheDisk::GetShape(const ImageKey &image_key) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto &entry = LookUp(image_key);
+  DALI_ENFORCE(entry.valid, "cache entry [" + image_key + "] not found");
+  return entry.shape;
+}
+
+bool ImageCacheDisk::Read(const ImageKey &image_key,
+                          void *destination_data,
+                          cudaStream_t stream) const {
+  DALI_ENFORCE(!image_key.empty());
+  DALI_ENFORCE(destination_data != nullptr);
+  LOG_LINE << "Read: image_key[" << image_key << "]" << std::endl;
+  Entry entry;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entry = LookUp(image_key);
+    if (!entry.valid) {
+      misses_++;
+      return false;
+    }
+  }
+
+  const std::size_t n = volume(entry.shape);
+  const std::size_t map_size = entry.data_offset + n;
+  void *p = MAP_FAILED;
+  int fd = open(EntryPath(image_key).c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd >= 0) {
+    p = mmap(nullptr, map_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+  }
+  if (p == MAP_FAILED) {
+    // removed by another process using the same directory
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.erase(image_key);
+    misses_++;
+    return false;
+  }
+  // A copy from pageable memory returns once the source has been read (for the copies to
+  // the device memory - to a staging buffer), so the file can be unmapped right away.
+  MemCopy(destination_data, static_cast<const uint8_t *>(p) + entry.data_offset, n, stream);
+  munmap(p, map_size);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  hits_++;
+  return true;
+}
+
+ImageCache::DecodedImage ImageCacheDisk::Get(const ImageKey &image_key) const {
+  // the images are not resident in the device memory
+  return {};
+}
+
+void ImageCacheDisk::Add(const ImageKey &image_key, const uint8_t *data,
+                         const ImageShape &data_shape, cudaStream_t stream) {
+  const std::size_t data_size = volume(data_shape);
+  const std::size_t data_offset = EntryDataOffset(image_key.size());
+  const std::size_t file_size = data_offset + data_size;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (image_key.empty() || LookUp(image_key).valid)
+      return;
+    misses_++;
+    if (data_size < image_size_threshold_)
+      return;
+    if (bytes_used_ + file_size > cache_size_) {
+      LOG_LINE << "WARNING: not enough space in cache. Ignore" << std::endl;
+      is_full_ = true;
+      return;
+    }
+    bytes_used_ += file_size;
+  }
+
+  std::vector<uint8_t> host_data(data_size);
+  MemCopy(host_data.data(), data, data_size, stream);
+  CUDA_CALL(cudaStreamSynchronize(stream));
+
+  EntryHeader header = {};
+  memcpy(header.magic, kMagic, sizeof(kMagic));
+  SourceIdentity(image_key, header.source_size, header.source_mtime_ns);
+  for (int d = 0; d < 3; d++)
+    header.shape[d] = data_shape[d];
+  header.key_length = image_key.size();
+  header.data_offset = data_offset;
+
+  // the entry is written to a temporary file and renamed, so that the other processes
+  // (and the later runs, if this one is interrupted) never see a partially written file
+  static std::atomic<int> tmp_idx{0};
+  std::string path = EntryPath(image_key);
+  std::string tmp_path = make_string(path, ".", getpid(), "_", tmp_idx++, ".tmp");
+  int fd = open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+  bool ok = fd >= 0;
+  if (ok) {
+    ok = WriteFully(fd, &header, sizeof(header), 0) &&
+         WriteFully(fd, image_key.data(), image_key.size(), sizeof(header)) &&
+         WriteFully(fd, host_data.data(), data_size, data_offset) &&
+         ftruncate(fd, file_size) == 0;
+    ok = close(fd) == 0 && ok;
+  }
+  if (ok)
+    ok = rename(tmp_path.c_str(), path.c_str()) == 0;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!ok) {
+    DALI_WARN_ONCE("Could not write the image cache file ", path, ": ", std::strerror(errno));
+    if (fd >= 0)
+      unlink(tmp_path.c_str());
+    bytes_used_ -= file_size;
+    return;
+  }
+  auto &entry = entries_[image_key];
+  entry.valid = true;
+  entry.shape = data_shape;
+  entry.data_offset = data_offset;
+  num_files_++;
+}
+
+ImageCacheStats ImageCacheDisk::GetStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ImageCacheStats stats;
+  stats.hits = hits_;
+  stats.misses = misses_;
+  stats.images_cached = num_files_;
+  stats.bytes_used = bytes_used_;
+  stats.capacity = cache_size_;
+  return stats;
+}
+
+void ImageCacheDisk::print_stats() const {
+  static std::mutex stats_mutex;
+  std::lock_guard<std::mutex> lock(stats_mutex);
+  auto stats = GetStats();
+  const char* log_filename = std::getenv("DALI_LOG_FILE");
+  std::ofstream log_file;
+  if (log_filename) log_file.open(log_filename);
+  std::ostream& out = log_filename ? log_file : std::cout;
+  out << "#################### CACHE STATS ####################" << std::endl;
+  out << "cache_dir: " << cache_dir_ << std::endl;
+  out << "cache_size: " << cache_size_ << std::endl;
+  out << "cache_threshold: " << image_size_threshold_ << std::endl;
+  out << "is_cache_full: " << static_cast<int>(is_full_) << std::endl;
+  out << "bytes_used: " << stats.bytes_used << std::endl;
+  out << "images_cached: " << stats.images_cached << std::endl;
+  out << "hits: " << stats.hits << std::endl;
+  out << "misses: " << stats.misses << std::endl;
+  out << "#################### END   STATS ####################" << std::endl;
+}
+
+}  // namespace dali
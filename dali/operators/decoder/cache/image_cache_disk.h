@@ -0,0 +1,115 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_DECODER_CACHE_IMAGE_CACHE_DISK_H_
+#define DALI_OPERATORS_DECODER_CACHE_IMAGE_CACHE_DISK_H_
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "dali/core/common.h"
+#include "dali/operators/decoder/cache/image_cache.h"
+
+namespace dali {
+
+/**
+ * @brief Image cache which keeps the decoded images in files in a local directory
+ *        (preferably on an NVMe drive), so that they survive the process and are reused
+ *        by the later runs of the pipeline.
+ *
+ * Each image is stored in a separate file: a header (with the image key and shape and
+ * the identity of the source file) followed by the raw HWC data, aligned to 4 KiB, so that
+ * the data can be mapped or read directly to the GPU memory.
+ * An entry is valid only if the key, which is usually the path of the encoded image, names
+ * a file with the same size and modification time as when the entry was written;
+ * the stale entries are removed and the images are decoded (and cached) again.
+ *
+ * The images are not resident in the device memory, so `Get` returns no data and the images
+ * are copied with `Read`. When the cache reaches its size, no more images are added.
+ */
+class DLL_PUBLIC ImageCacheDisk : public ImageCache {
+ public:
+  /// Alignment of the image data in the cache files
+  static constexpr size_t kDataAlignment = 4096;
+
+  DLL_PUBLIC ImageCacheDisk(const std::string &cache_dir,
+                            std::size_t cache_size,
+                            std::size_t image_size_threshold = 0,
+                            bool stats_enabled = false);
+
+  ~ImageCacheDisk() override;
+
+  DISABLE_COPY_MOVE_ASSIGN(ImageCacheDisk);
+
+  bool IsCached(const ImageKey &image_key) const override;
+
+  bool Read(const ImageKey &image_key,
+            void *destination_data,
+            cudaStream_t stream) const override;
+
+  const ImageShape &GetShape(const ImageKey &image_key) const override;
+
+  void Add(const ImageKey &image_key,
+           const uint8_t *data,
+           const ImageShape &data_shape,
+           cudaStream_t stream) override;
+
+  DecodedImage Get(const ImageKey &image_key) const override;
+
+  void SyncToRead(cudaStream_t stream) const override {}
+
+  ImageCacheStats GetStats() const override;
+
+  /**
+   * @brief The path of the cache file of the image
+   */
+  std::string EntryPath(const ImageKey &image_key) const;
+
+ private:
+  struct Entry {
+    bool valid = false;
+    ImageShape shape;
+    std::size_t data_offset = 0;
+  };
+
+  /**
+   * @brief Finds the entry of the image, checking the cache directory the first time
+   *        the image is looked up
+   */
+  const Entry &LookUp(const ImageKey &image_key) const;
+
+  Entry LoadEntry(const ImageKey &image_key) const;
+
+  void print_stats() const;
+
+  std::string cache_dir_;
+  std::size_t cache_size_ = 0;
+  std::size_t image_size_threshold_ = 0;
+  bool stats_enabled_ = false;
+
+  mutable std::unordered_map<ImageKey, Entry> entries_;
+  // the size and the number of the files in the cache directory
+  mutable std::size_t bytes_used_ = 0;
+  mutable std::size_t num_files_ = 0;
+  mutable std::mutex mutex_;
+
+  mutable std::size_t hits_ = 0;
+  mutable std::size_t misses_ = 0;
+  bool is_full_ = false;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_DECODER_CACHE_IMAGE_CACHE_DISK_H_
@@ -0,0 +1,135 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "dali/operators/decoder/cache/image_cache_disk.h"
+
+namespace dali {
+namespace testing {
+
+struct ImageCacheDiskTest : public ::testing::Test {
+  void SetUp() override {
+    char dir_template[] = "/tmp/dali_image_cache_XXXXXX";
+    ASSERT_NE(nullptr, mkdtemp(dir_template));
+    dir_ = dir_template;
+    cache_dir_ = dir_ + "/cache";
+    Reopen();
+  }
+
+  void TearDown() override {
+    cache_.reset();
+    ASSERT_EQ(0, system(("rm -rf " + dir_).c_str()));
+  }
+
+  void Reopen(std::size_t cache_size = 1 << 20, std::size_t threshold = 0) {
+    cache_.reset();
+    cache_.reset(new ImageCacheDisk(cache_dir_, cache_size, threshold));
+  }
+
+  std::vector<uint8_t> Image(const ImageCache::ImageShape &shape, uint8_t seed) {
+    std::vector<uint8_t> data(volume(shape));
+    for (size_t i = 0; i < data.size(); i++)
+      data[i] = static_cast<uint8_t>(i * 7 + seed);
+    return data;
+  }
+
+  void WriteSource(const std::string &path, const std::string &contents) {
+    std::ofstream f(path, std::ios::binary | std::ios::trunc);
+    f << contents;
+  }
+
+  std::string dir_, cache_dir_;
+  std::unique_ptr<ImageCacheDisk> cache_;
+};
+
+TEST_F(ImageCacheDiskTest, AddAndRead) {
+  ImageCache::ImageShape shape{4, 5, 3};
+  auto image = Image(shape, 1);
+  EXPECT_FALSE(cache_->IsCached("a"));
+  cache_->Add("a", image.data(), shape, 0);
+  ASSERT_TRUE(cache_->IsCached("a"));
+  EXPECT_EQ(shape, cache_->GetShape("a"));
+  EXPECT_EQ(nullptr, cache_->Get("a").data);
+
+  std::vector<uint8_t> out(image.size());
+  ASSERT_TRUE(cache_->Read("a", out.data(), 0));
+  EXPECT_EQ(image, out);
+  EXPECT_FALSE(cache_->Read("b", out.data(), 0));
+
+  auto stats = cache_->GetStats();
+  EXPECT_EQ(1u, stats.images_cached);
+  EXPECT_EQ(1u, stats.hits);
+  EXPECT_GE(stats.bytes_used, image.size() + ImageCacheDisk::kDataAlignment);
+}
+
+TEST_F(ImageCacheDiskTest, PersistentAcrossInstances) {
+  ImageCache::ImageShape shape{8, 2, 3};
+  auto image = Image(shape, 5);
+  cache_->Add("image", image.data(), shape, 0);
+  auto bytes_used = cache_->GetStats().bytes_used;
+
+  Reopen();
+  auto stats = cache_->GetStats();
+  EXPECT_EQ(1u, stats.images_cached);
+  EXPECT_EQ(bytes_used, stats.bytes_used);
+  ASSERT_TRUE(cache_->IsCached("image"));
+  EXPECT_EQ(shape, cache_->GetShape("image"));
+  std::vector<uint8_t> out(image.size());
+  ASSERT_TRUE(cache_->Read("image", out.data(), 0));
+  EXPECT_EQ(image, out);
+}
+
+TEST_F(ImageCacheDiskTest, SourceChanged) {
+  std::string source = dir_ + "/image.jpg";
+  WriteSource(source, "encoded");
+  ImageCache::ImageShape shape{3, 3, 3};
+  auto image = Image(shape, 9);
+  cache_->Add(source, image.data(), shape, 0);
+  Reopen();
+  EXPECT_TRUE(cache_->IsCached(source));
+
+  WriteSource(source, "encoded again");
+  Reopen();
+  EXPECT_FALSE(cache_->IsCached(source));
+  struct stat st;
+  EXPECT_NE(0, stat(cache_->EntryPath(source).c_str(), &st));
+  EXPECT_EQ(0u, cache_->GetStats().images_cached);
+
+  cache_->Add(source, image.data(), shape, 0);
+  Reopen();
+  EXPECT_TRUE(cache_->IsCached(source));
+}
+
+TEST_F(ImageCacheDiskTest, ThresholdAndSize) {
+  Reopen(2 * ImageCacheDisk::kDataAlignment, 100);
+  ImageCache::ImageShape small{3, 3, 3}, large{10, 10, 3};
+  auto small_image = Image(small, 0), large_image = Image(large, 0);
+  cache_->Add("small", small_image.data(), small, 0);
+  EXPECT_FALSE(cache_->IsCached("small"));
+  cache_->Add("large0", large_image.data(), large, 0);
+  cache_->Add("large1", large_image.data(), large, 0);
+  EXPECT_TRUE(cache_->IsCached("large0"));
+  EXPECT_FALSE(cache_->IsCached("large1"));
+}
+
+}  // namespace testing
+}  // namespace dali
@@ -0,0 +1,411 @@
+// Copyright (c) 2021, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/decoder/cache/image_cache_evicting.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <vector>
+#include "dali/core/device_guard.h"
+#include "dali/core/error_handling.h"
+#include "dali/pipeline/data/backend.h"
+
+namespace dali {
+
+ImageCacheEvicting::ImageCacheEvicting(std::size_t cache_size,
+                                       EvictionPolicy policy,
+                                       std::size_t image_size_threshold,
+                                       bool stats_enabled,
+                                       int num_shards,
+                                       std::size_t host_cache_size)
+    : cache_size_(cache_size)
+    , policy_(policy)
+    , image_size_threshold_(image_size_threshold)
+    , stats_enabled_(stats_enabled)
+    , host_cache_size_(host_cache_size) {
+  DALI_ENFORCE(cache_size_ > 0, "Cache size should be greater than 0");
+  DALI_ENFORCE(image_size_threshold <= cache_size_, "Cache size should fit at least one image");
+  DALI_ENFORCE(num_shards >= 0, "The number of cache shards cannot be negative");
+  if (num_shards == 0) {
+    num_shards = static_cast<int>(std::min<std::size_t>(kMaxShards, cache_size_ / kMinShardSize));
+    num_shards = std::max(num_shards, 1);
+  }
+  num_shards = static_cast<int>(std::min<std::size_t>(num_shards, cache_size_));
+
+  CUDA_CALL(cudaGetDevice(&device_id_));
+  LOG_LINE << "cache size is " << cache_size_ / (1024 * 1024) << " MB + "
+           << host_cache_size_ / (1024 * 1024) << " MB in host memory, in "
+           << num_shards << " shards" << std::endl;
+
+  CUDA_CALL(cudaStreamCreateWithPriority(&cache_stream_, cudaStreamNonBlocking, 0));
+  CUDA_CALL(cudaEventCreateWithFlags(&sync_event_, cudaEventDisableTiming));
+
+  for (int i = 0; i < num_shards; i++) {
+    shards_.emplace_back(new Shard());
+    auto &shard = *shards_.back();
+    shard.index = i;
+    CUDA_CALL(cudaEventCreateWithFlags(&shard.read_event, cudaEventDisableTiming));
+    CUDA_CALL(cudaEventCreateWithFlags(&shard.write_event, cudaEventDisableTiming));
+    CUDA_CALL(cudaEventCreateWithFlags(&shard.done_event, cudaEventDisableTiming));
+  }
+  for (auto &shard : shards_)
+    AttachShard(*shard);
+}
+
+void ImageCacheEvicting::AttachShard(Shard &shard) {
+  std::lock_guard<std::mutex> lock(alloc_mutex_);
+  if (!buffer_) {
+    DeviceGuard dg(device_id_);
+    buffer_ = mm::alloc_raw_unique<uint8_t, mm::memory_kind::device>(cache_size_);
+    DALI_ENFORCE(buffer_ != nullptr);
+    if (host_cache_size_ > 0) {
+      host_buffer_ = mm::alloc_raw_unique<uint8_t, mm::memory_kind::pinned>(host_cache_size_);
+      DALI_ENFORCE(host_buffer_ != nullptr);
+    }
+  }
+
+  // the last shard gets the remainder, so that the whole budget is used
+  const int num_shards = shards_.size();
+  const int i = shard.index;
+  auto split = [num_shards, i](Tier &tier, uint8_t *buffer, std::size_t size) {
+    std::size_t part = size / num_shards;
+    tier.capacity = i + 1 < num_shards ? part : size - part * i;
+    tier.base = buffer + part * i;
+    if (tier.capacity > 0)
+      tier.free_blocks.put(tier.base, tier.capacity);
+  };
+  split(shard.device, buffer_.get(), cache_size_);
+  split(shard.host, host_buffer_.get(), host_cache_size_);
+}
+
+ImageCacheEvicting::~ImageCacheEvicting() {
+  CUDA_CALL(cudaStreamSynchronize(cache_stream_));
+  if (stats_enabled_) print_stats();
+
+  for (auto &shard : shards_) {
+    CUDA_CALL(cudaEventDestroy(shard->read_event));
+    CUDA_CALL(cudaEventDestroy(shard->write_event));
+    CUDA_CALL(cudaEventDestroy(shard->done_event));
+  }
+  CUDA_CALL(cudaEventDestroy(sync_event_));
+  CUDA_CALL(cudaStreamDestroy(cache_stream_));
+}
+
+ImageCacheEvicting::Shard &ImageCacheEvicting::GetShard(const ImageKey &image_key) const {
+  return *shards_[std::hash<ImageKey>()(image_key) % shards_.size()];
+}
+
+void ImageCacheEvicting::Touch(Shard &shard, const ImageKey &image_key, Entry &entry,
+                               bool use) const {
+  if (use)
+    entry.uses++;
+  Rank rank{policy_ == EvictionPolicy::LFU ? entry.uses : 0, ++shard.tick};
+  auto &order = entry.on_host ? shard.host.eviction_order : shard.device.eviction_order;
+  // the ticks start at 1, so a new entry is not found here
+  order.erase(entry.rank);
+  order.emplace(rank, image_key);
+  entry.rank = rank;
+}
+
+bool ImageCacheEvicting::IsCached(const ImageKey& image_key) const {
+  auto &shard = GetShard(image_key);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  auto it = shard.entries.find(image_key);
+  if (it == shard.entries.end())
+    return false;
+  // the image is likely to be read soon, it shouldn't be the next to go
+  Touch(shard, image_key, it->second, false);
+  return true;
+}
+
+const ImageCache::ImageShape& ImageCacheEvicting::GetShape(const ImageKey& image_key) const {
+  thread_local ImageShape shape;
+  auto &shard = GetShard(image_key);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  auto it = shard.entries.find(image_key);
+  if (it == shard.entries.end()) {
+    shape = {};
+  } else {
+    Touch(shard, image_key, it->second, false);
+    shape = it->second.image.shape;
+  }
+  return shape;
+}
+
+bool ImageCacheEvicting::Read(const ImageKey& image_key,
+                              void* destination_buffer,
+                              cudaStream_t stream) const {
+  DALI_ENFORCE(!image_key.empty());
+  DALI_ENFORCE(destination_buffer != nullptr);
+  auto &shard = GetShard(image_key);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  LOG_LINE << "Read: image_key[" << image_key << "]" << std::endl;
+  auto it = shard.entries.find(image_key);
+  if (it == shard.entries.end()) {
+    shard.misses++;
+    return false;
+  }
+  // if there's no space on the device, the image is copied directly from the host memory
+  if (it->second.on_host)
+    Promote(shard, image_key, it->second);
+  const auto &image = it->second.image;
+
+  // wait for the write of the image
+  CUDA_CALL(cudaEventRecord(shard.read_event, cache_stream_));
+  CUDA_CALL(cudaStreamWaitEvent(stream, shard.read_event, 0));
+  MemCopy(destination_buffer, image.data, image.num_elements(), stream);
+  // the memory can be reused only after the copy completes
+  CUDA_CALL(cudaEventRecord(shard.done_event, stream));
+  CUDA_CALL(cudaStreamWaitEvent(cache_stream_, shard.done_event, 0));
+
+  Touch(shard, image_key, it->second, true);
+  shard.hits++;
+  return true;
+}
+
+ImageCache::DecodedImage ImageCacheEvicting::Get(const ImageKey& image_key) const {
+  DALI_ENFORCE(!image_key.empty());
+  auto &shard = GetShard(image_key);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  LOG_LINE << "Get: image_key[" << image_key << "]" << std::endl;
+  auto it = shard.entries.find(image_key);
+  if (it == shard.entries.end()) {
+    shard.misses++;
+    return {};
+  }
+  // the copy back to the device is ordered before the reads by SyncToRead; if there's no space
+  // on the device, the pinned host memory is read directly
+  if (it->second.on_host)
+    Promote(shard, image_key, it->second);
+  it->second.pins++;
+  Touch(shard, image_key, it->second, true);
+  shard.hits++;
+  return it->second.image;
+}
+
+void ImageCacheEvicting::FinishDeferredReads(const std::vector<ImageKey> &image_keys,
+                                             cudaStream_t stream) const {
+  {
+    std::lock_guard<std::mutex> lock(sync_mutex_);
+    CUDA_CALL(cudaEventRecord(sync_event_, stream));
+    CUDA_CALL(cudaStreamWaitEvent(cache_stream_, sync_event_, 0));
+  }
+  for (auto &image_key : image_keys) {
+    auto &shard = GetShard(image_key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.entries.find(image_key);
+    if (it != shard.entries.end() && it->second.pins > 0)
+      it->second.pins--;
+  }
+}
+
+void ImageCacheEvicting::SyncToRead(cudaStream_t stream) const {
+  std::lock_guard<std::mutex> lock(sync_mutex_);
+  CUDA_CALL(cudaEventRecord(sync_event_, cache_stream_));
+  CUDA_CALL(cudaStreamWaitEvent(stream, sync_event_, 0));
+}
+
+uint8_t *ImageCacheEvicting::Allocate(Shard &shard, Tier &tier, std::size_t size) const {
+  if (size > tier.capacity)
+    return nullptr;
+  auto victim = tier.eviction_order.begin();
+  for (;;) {
+    if (tier.used + size <= tier.capacity) {
+      // the blocks are not aligned - there's no padding, which would count against the budget
+      if (auto *block = static_cast<uint8_t *>(tier.free_blocks.get(size, 1)))
+        return block;
+    }
+    // evict the next image that is not pinned
+    while (victim != tier.eviction_order.end() &&
+           shard.entries.at(victim->second).pins > 0)
+      ++victim;
+    if (victim == tier.eviction_order.end())
+      return nullptr;
+    auto it = shard.entries.find(victim->second);
+    victim = tier.eviction_order.erase(victim);
+    auto &image = it->second.image;
+    tier.free_blocks.put(image.data, image.num_elements());
+    tier.used -= image.num_elements();
+    // the block is reused after the copy to the host, as both are ordered in the cache stream
+    if (&tier == &shard.device && Demote(shard, it->first, it->second))
+      continue;
+    LOG_LINE << "Evict: image_key[" << it->first << "]" << std::endl;
+    shard.evictions++;
+    shard.entries.erase(it);
+  }
+}
+
+bool ImageCacheEvicting::Demote(Shard &shard, const ImageKey &image_key, Entry &entry) const {
+  auto &image = entry.image;
+  std::size_t size = image.num_elements();
+  uint8_t *block = Allocate(shard, shard.host, size);
+  if (!block)
+    return false;
+  // the image was written to the cache in the order of the cache stream
+  MemCopy(block, image.data, size, cache_stream_);
+  LOG_LINE << "Demote: image_key[" << image_key << "]" << std::endl;
+  shard.host.used += size;
+  shard.demotions++;
+  image.data = block;
+  entry.on_host = true;
+  shard.host.eviction_order.emplace(entry.rank, image_key);
+  return true;
+}
+
+bool ImageCacheEvicting::Promote(Shard &shard, const ImageKey &image_key, Entry &entry) const {
+  auto &image = entry.image;
+  std::size_t size = image.num_elements();
+  // the images moved to the host to make space must not push this one out
+  entry.pins++;
+  uint8_t *block = Allocate(shard, shard.device, size);
+  entry.pins--;
+  if (!block)
+    return false;
+  MemCopy(block, image.data, size, cache_stream_);
+  LOG_LINE << "Promote: image_key[" << image_key << "]" << std::endl;
+  shard.host.eviction_order.erase(entry.rank);
+  shard.host.free_blocks.put(image.data, size);
+  shard.host.used -= size;
+  shard.device.used += size;
+  shard.promotions++;
+  image.data = block;
+  entry.on_host = false;
+  shard.device.eviction_order.emplace(entry.rank, image_key);
+  return true;
+}
+
+void ImageCacheEvicting::Add(const ImageKey& image_key, const uint8_t* data,
+                             const ImageShape& data_shape, cudaStream_t stream) {
+  DALI_ENFORCE(!image_key.empty());
+  const std::size_t data_size = volume(data_shape);
+  auto &shard = GetShard(image_key);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  if (shard.entries.find(image_key) != shard.entries.end())
+    return;
+  shard.misses++;
+  if (data_size == 0 || data_size < image_size_threshold_)
+    return;
+
+  if (!shard.device.base) {
+    // the memory was released by Trim
+    try {
+      AttachShard(shard);
+    } catch (const std::bad_alloc &) {
+      LOG_LINE << "WARNING: cannot allocate the cache memory for [" << image_key << "]. Ignore"
+               << std::endl;
+      return;
+    }
+  }
+
+  uint8_t *block = Allocate(shard, shard.device, data_size);
+  if (!block) {
+    LOG_LINE << "WARNING: cannot make space for [" << image_key << "]. Ignore" << std::endl;
+    return;
+  }
+
+  // the block may still be read by the copies of the evicted images, including the copies
+  // to the host tier
+  CUDA_CALL(cudaEventRecord(shard.read_event, cache_stream_));
+  CUDA_CALL(cudaStreamWaitEvent(stream, shard.read_event, 0));
+  MemCopy(block, data, data_size, stream);
+  CUDA_CALL(cudaEventRecord(shard.write_event, stream));
+  CUDA_CALL(cudaStreamWaitEvent(cache_stream_, shard.write_event, 0));
+
+  shard.device.used += data_size;
+  auto &entry = shard.entries[image_key];
+  entry.image = {block, data_shape};
+  Touch(shard, image_key, entry, true);
+}
+
+ImageCacheStats ImageCacheEvicting::GetStats() const {
+  ImageCacheStats stats;
+  stats.capacity = cache_size_;
+  stats.host_capacity = host_cache_size_;
+  for (auto &shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    stats.hits += shard->hits;
+    stats.misses += shard->misses;
+    stats.evictions += shard->evictions;
+    stats.images_cached += shard->entries.size();
+    stats.bytes_used += shard->device.used;
+    stats.host_bytes_used += shard->host.used;
+    stats.demotions += shard->demotions;
+    stats.promotions += shard->promotions;
+  }
+  return stats;
+}
+
+std::size_t ImageCacheEvicting::Trim() {
+  std::vector<std::unique_lock<std::mutex>> locks;
+  locks.reserve(shards_.size());
+  for (auto &shard : shards_)
+    locks.emplace_back(shard->mutex);
+  if (!buffer_)
+    return 0;
+  for (auto &shard : shards_) {
+    for (auto &kv : shard->entries) {
+      if (kv.second.pins > 0)
+        return 0;
+    }
+  }
+  // the images may still be read by the copies ordered in the cache stream
+  CUDA_CALL(cudaStreamSynchronize(cache_stream_));
+  for (auto &shard : shards_) {
+    shard->evictions += shard->entries.size();
+    shard->entries.clear();
+    for (Tier *tier : {&shard->device, &shard->host}) {
+      tier->eviction_order.clear();
+      tier->free_blocks.clear();
+      tier->used = 0;
+      tier->base = nullptr;
+    }
+  }
+  DeviceGuard dg(device_id_);
+  buffer_.reset();
+  host_buffer_.reset();
+  LOG_LINE << "Trim: released " << cache_size_ + host_cache_size_ << " bytes" << std::endl;
+  return cache_size_ + host_cache_size_;
+}
+
+void ImageCacheEvicting::print_stats() const {
+  static std::mutex stats_mutex;
+  std::lock_guard<std::mutex> lock(stats_mutex);
+  auto stats = GetStats();
+  const char* log_filename = std::getenv("DALI_LOG_FILE");
+  std::ofstream log_file;
+  if (log_filename) log_file.open(log_filename);
+  std::ostream& out = log_filename ? log_file : std::cout;
+  out << "#################### CACHE STATS ####################" << std::endl;
+  out << "cache_size: " << cache_size_ << std::endl;
+  out << "cache_threshold: " << image_size_threshold_ << std::endl;
+  out << "cache_policy: " << (policy_ == EvictionPolicy::LFU ? "lfu" : "lru") << std::endl;
+  out << "cache_shards: " << shards_.size() << std::endl;
+  out << "bytes_used: " << stats.bytes_used << std::endl;
+  out << "images_cached: " << stats.images_cached << std::endl;
+  out << "hits: " << stats.hits << std::endl;
+  out << "misses: " << stats.misses << std::endl;
+  out << "evictions: " << stats.evictions << std::endl;
+  if (host_cache_size_ > 0) {
+    out << "host_cache_size: " << host_cache_size_ << std::endl;
+    out << "host_bytes_used: " << stats.host_bytes_used << std::endl;
+    out << "demotions: " << stats.demotions << std::endl;
+    out << "promotions: " << stats.promotions << std::endl;
+  }
+  out << "#################### END   STATS ####################" << std::endl;
+}
+
+}  // namespace dali
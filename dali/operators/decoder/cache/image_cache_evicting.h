@@ -0,0 +1,221 @@
+// Copyright (c) 2021, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_DECODER_CACHE_IMAGE_CACHE_EVICTING_H_
+#define DALI_OPERATORS_DECODER_CACHE_IMAGE_CACHE_EVICTING_H_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "dali/core/common.h"
+#include "dali/core/error_handling.h"
+#include "dali/core/mm/memory.h"
+#include "dali/core/mm/detail/free_list.h"
+#include "dali/operators/decoder/cache/image_cache.h"
+
+namespace dali {
+
+enum class EvictionPolicy {
+  LRU,  ///< evicts the image that was not used for the longest time
+  LFU   ///< evicts the image used the least number of times, the least recently used of those
+};
+
+/**
+ * @brief Image cache, which evicts images to make space for new ones
+ *
+ * The cache memory is split into shards, each with its own lock, eviction order and
+ * a free list of blocks. An image goes to the shard chosen by the hash of its key, so the
+ * decoders sharing the cache rarely contend for a lock. The budget is byte-accurate: the images
+ * are stored without padding and the cache never occupies more than `cache_size` bytes.
+ *
+ * The images returned by Get are pinned - they are not evicted until FinishDeferredReads
+ * is called for them.
+ *
+ * Optionally, the cache has a second tier in pinned host memory. The images evicted from
+ * the device memory are moved there instead of being dropped, and moved back to the device
+ * when they are used again. The copies run in the internal stream of the cache, so a read
+ * that follows SyncToRead sees the image already back on the device.
+ *
+ * The cache memory can be freed with Trim, under memory pressure; it's allocated again
+ * when an image is added.
+ */
+class DLL_PUBLIC ImageCacheEvicting : public ImageCache {
+ public:
+  /**
+   * @param cache_size total size of the cache, in bytes
+   * @param policy which image is evicted when the space is needed
+   * @param image_size_threshold the images smaller than that are not cached
+   * @param stats_enabled if true, the statistics are printed when the cache is destroyed
+   * @param num_shards number of independently locked parts of the cache;
+   *                   if 0, it's chosen based on the cache size
+   * @param host_cache_size size of the pinned host memory tier, in bytes; 0 disables it
+   */
+  DLL_PUBLIC ImageCacheEvicting(std::size_t cache_size,
+                                EvictionPolicy policy,
+                                std::size_t image_size_threshold = 0,
+                                bool stats_enabled = false,
+                                int num_shards = 0,
+                                std::size_t host_cache_size = 0);
+
+  ~ImageCacheEvicting() override;
+
+  DISABLE_COPY_MOVE_ASSIGN(ImageCacheEvicting);
+
+  bool IsCached(const ImageKey& image_key) const override;
+
+  /**
+   * @remarks The image may be evicted at any time, so the shape is returned through
+   *          a thread-local copy, valid until the next call; if the image is not cached,
+   *          the shape is empty.
+   */
+  const ImageShape& GetShape(const ImageKey& image_key) const override;
+
+  bool Read(const ImageKey& image_key,
+            void* destination_data,
+            cudaStream_t stream) const override;
+
+  void Add(const ImageKey& image_key,
+           const uint8_t *data,
+           const ImageShape& data_shape,
+           cudaStream_t stream) override;
+
+  DecodedImage Get(const ImageKey &image_key) const override;
+
+  void SyncToRead(cudaStream_t stream) const override;
+
+  void FinishDeferredReads(const std::vector<ImageKey> &image_keys,
+                           cudaStream_t stream) const override;
+
+  ImageCacheStats GetStats() const override;
+
+  /**
+   * @remarks Nothing is freed if any of the images is pinned.
+   */
+  std::size_t Trim() override;
+
+  int num_shards() const {
+    return static_cast<int>(shards_.size());
+  }
+
+ private:
+  // the shard size below which the cache is not split further
+  static constexpr std::size_t kMinShardSize = 256 << 20;
+  static constexpr int kMaxShards = 16;
+
+  // the order of eviction - the lowest rank goes first
+  using Rank = std::pair<uint64_t, uint64_t>;
+
+  struct Entry {
+    DecodedImage image;
+    Rank rank;
+    uint64_t uses = 0;
+    int pins = 0;
+    bool on_host = false;
+  };
+
+  /**
+   * @brief A part of the shard in one kind of memory
+   */
+  struct Tier {
+    uint8_t *base = nullptr;
+    std::size_t capacity = 0;
+    std::size_t used = 0;
+    mm::coalescing_free_tree free_blocks;
+    std::map<Rank, ImageKey> eviction_order;
+  };
+
+  struct Shard {
+    int index = 0;
+    std::mutex mutex;
+    Tier device, host;
+    std::unordered_map<ImageKey, Entry> entries;
+    uint64_t tick = 0;
+
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+    std::size_t evictions = 0;
+    std::size_t demotions = 0;
+    std::size_t promotions = 0;
+
+    cudaEvent_t read_event;   // recorded in the cache stream
+    cudaEvent_t write_event;  // recorded in the stream that writes to the cache
+    cudaEvent_t done_event;   // recorded in the stream that reads from the cache
+  };
+
+  Shard &GetShard(const ImageKey &image_key) const;
+
+  /**
+   * @brief Moves the entry to its new place in the eviction order
+   *
+   * @param use whether the access counts as a use of the image, for LFU
+   */
+  void Touch(Shard &shard, const ImageKey &image_key, Entry &entry, bool use) const;
+
+  /**
+   * @brief Gets a block of `size` bytes in a tier of the shard, evicting the images if needed
+   *
+   * The images evicted from the device tier are moved to the host tier, if possible.
+   *
+   * @return the block or nullptr, if the pinned images prevent freeing enough memory
+   */
+  uint8_t *Allocate(Shard &shard, Tier &tier, std::size_t size) const;
+
+  /**
+   * @brief Moves an image, already removed from the device tier, to the host tier
+   *
+   * @return false, if there's no space for the image in the host tier
+   */
+  bool Demote(Shard &shard, const ImageKey &image_key, Entry &entry) const;
+
+  /**
+   * @brief Moves an image from the host tier back to the device tier
+   *
+   * @return false, if there's no space for the image in the device tier
+   */
+  bool Promote(Shard &shard, const ImageKey &image_key, Entry &entry) const;
+
+  /**
+   * @brief Assigns the parts of the cache buffers to the shard, allocating the buffers if needed
+   *
+   * Must be called with the shard locked.
+   */
+  void AttachShard(Shard &shard);
+
+  void print_stats() const;
+
+  std::size_t cache_size_ = 0;
+  EvictionPolicy policy_;
+  std::size_t image_size_threshold_ = 0;
+  bool stats_enabled_ = false;
+  std::size_t host_cache_size_ = 0;
+  mm::uptr<uint8_t> buffer_;
+  mm::uptr<uint8_t> host_buffer_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+  int device_id_ = 0;
+  // guards the (re)allocation of the buffers, if they are released
+  std::mutex alloc_mutex_;
+
+  cudaStream_t cache_stream_;
+  mutable std::mutex sync_mutex_;
+  cudaEvent_t sync_event_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_DECODER_CACHE_IMAGE_CACHE_EVICTING_H_
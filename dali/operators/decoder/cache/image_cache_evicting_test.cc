@@ -0,0 +1,239 @@
+// Copyright (c) 2021, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/decoder/cache/image_cache_evicting.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dali {
+namespace testing {
+
+struct ImageCacheEvictingTest : public ::testing::Test {
+  void SetUpImpl(EvictionPolicy policy, std::size_t cache_size = 40, int num_shards = 1,
+                 std::size_t host_cache_size = 0) {
+    cache_.reset(new ImageCacheEvicting(cache_size, policy, 0, false, num_shards,
+                                        host_cache_size));
+    data_.clear();
+    for (std::size_t i = 0; i <= 10; i++) {
+      data_.push_back({std::to_string(i), std::vector<uint8_t>(10, i)});
+    }
+  }
+
+  void AddImage(std::size_t i) {
+    cache_->Add(data_[i].first, &data_[i].second[0],
+                {static_cast<int64_t>(data_[i].second.size()), 1, 1}, 0);
+  }
+
+  bool IsCached(std::size_t i) { return cache_->IsCached(data_[i].first); }
+
+  bool ReadImage(std::size_t i) {
+    std::vector<uint8_t> out(data_[i].second.size());
+    if (!cache_->Read(data_[i].first, &out[0], 0))
+      return false;
+    CUDA_CALL(cudaStreamSynchronize(0));
+    EXPECT_EQ(out, data_[i].second);
+    return true;
+  }
+
+  std::unique_ptr<ImageCacheEvicting> cache_;
+  std::vector<std::pair<std::string, std::vector<uint8_t>>> data_;
+};
+
+TEST_F(ImageCacheEvictingTest, LRU) {
+  SetUpImpl(EvictionPolicy::LRU);
+  for (int i = 0; i < 4; i++)
+    AddImage(i);
+  EXPECT_TRUE(ReadImage(0));
+  // the cache is full - the least recently used is 1
+  AddImage(4);
+  EXPECT_FALSE(IsCached(1));
+  EXPECT_TRUE(ReadImage(0));
+  EXPECT_TRUE(ReadImage(2));
+  EXPECT_TRUE(ReadImage(3));
+  EXPECT_TRUE(ReadImage(4));
+
+  auto stats = cache_->GetStats();
+  EXPECT_EQ(stats.hits, 5u);
+  EXPECT_EQ(stats.misses, 5u);
+  EXPECT_EQ(stats.evictions, 1u);
+  EXPECT_EQ(stats.images_cached, 4u);
+  EXPECT_EQ(stats.bytes_used, 40u);
+  EXPECT_EQ(stats.capacity, 40u);
+}
+
+TEST_F(ImageCacheEvictingTest, LFU) {
+  SetUpImpl(EvictionPolicy::LFU);
+  for (int i = 0; i < 4; i++)
+    AddImage(i);
+  for (int i : {0, 0, 1, 2, 2, 3})
+    EXPECT_TRUE(ReadImage(i));
+  // 1 and 3 were used twice, 1 earlier
+  AddImage(4);
+  EXPECT_FALSE(IsCached(1));
+  // 4 has the lowest use count
+  AddImage(5);
+  EXPECT_FALSE(IsCached(4));
+  EXPECT_TRUE(IsCached(0));
+  EXPECT_TRUE(IsCached(2));
+  EXPECT_TRUE(IsCached(3));
+  EXPECT_TRUE(IsCached(5));
+  EXPECT_EQ(cache_->GetStats().evictions, 2u);
+}
+
+TEST_F(ImageCacheEvictingTest, ByteAccurateBudget) {
+  SetUpImpl(EvictionPolicy::LRU, 35);
+  for (int i = 0; i < 4; i++)
+    AddImage(i);
+  // only 3 images fit
+  EXPECT_FALSE(IsCached(0));
+  EXPECT_EQ(cache_->GetStats().bytes_used, 30u);
+
+  // an image that doesn't fit is not cached and doesn't evict anything
+  std::vector<uint8_t> large(36, 0xFF);
+  cache_->Add("large", &large[0], {36, 1, 1}, 0);
+  EXPECT_FALSE(cache_->IsCached("large"));
+  EXPECT_EQ(cache_->GetStats().images_cached, 3u);
+}
+
+TEST_F(ImageCacheEvictingTest, LargerImageEvictsMany) {
+  SetUpImpl(EvictionPolicy::LRU);
+  for (int i = 0; i < 4; i++)
+    AddImage(i);
+  std::vector<uint8_t> large(25, 0xFF);
+  cache_->Add("large", &large[0], {25, 1, 1}, 0);
+  EXPECT_TRUE(cache_->IsCached("large"));
+  EXPECT_EQ(cache_->GetStats().evictions, 3u);
+  EXPECT_TRUE(ReadImage(3));
+}
+
+TEST_F(ImageCacheEvictingTest, PinnedNotEvicted) {
+  SetUpImpl(EvictionPolicy::LRU, 20);
+  AddImage(0);
+  AddImage(1);
+  auto img = cache_->Get(data_[0].first);
+  ASSERT_NE(img.data, nullptr);
+  EXPECT_EQ(img.num_elements(), 10);
+  AddImage(2);
+  EXPECT_TRUE(IsCached(0));
+  EXPECT_FALSE(IsCached(1));
+
+  // both remaining images are pinned, so there's no space
+  auto img2 = cache_->Get(data_[2].first);
+  AddImage(3);
+  EXPECT_FALSE(IsCached(3));
+
+  cache_->FinishDeferredReads({data_[0].first, data_[2].first}, 0);
+  AddImage(3);
+  EXPECT_TRUE(IsCached(3));
+  EXPECT_FALSE(IsCached(0));
+}
+
+TEST_F(ImageCacheEvictingTest, GetShapeOfEvicted) {
+  SetUpImpl(EvictionPolicy::LRU, 10);
+  AddImage(0);
+  EXPECT_EQ(cache_->GetShape(data_[0].first), (ImageCache::ImageShape{10, 1, 1}));
+  AddImage(1);
+  EXPECT_EQ(volume(cache_->GetShape(data_[0].first)), 0);
+}
+
+TEST_F(ImageCacheEvictingTest, Shards) {
+  SetUpImpl(EvictionPolicy::LRU, 1000, 4);
+  EXPECT_EQ(cache_->num_shards(), 4);
+  for (std::size_t i = 0; i < data_.size(); i++)
+    AddImage(i);
+  for (std::size_t i = 0; i < data_.size(); i++)
+    EXPECT_TRUE(ReadImage(i));
+  auto stats = cache_->GetStats();
+  EXPECT_EQ(stats.images_cached, data_.size());
+  EXPECT_EQ(stats.bytes_used, 10 * data_.size());
+  EXPECT_EQ(stats.evictions, 0u);
+}
+
+TEST_F(ImageCacheEvictingTest, HostTier) {
+  SetUpImpl(EvictionPolicy::LRU, 20, 1, 20);
+  for (int i = 0; i < 5; i++)
+    AddImage(i);
+  // 0 was dropped from the host tier, 1 and 2 were moved there
+  EXPECT_FALSE(IsCached(0));
+  for (int i = 1; i < 5; i++)
+    EXPECT_TRUE(IsCached(i));
+  auto stats = cache_->GetStats();
+  EXPECT_EQ(stats.demotions, 3u);
+  EXPECT_EQ(stats.evictions, 1u);
+  EXPECT_EQ(stats.bytes_used, 20u);
+  EXPECT_EQ(stats.host_bytes_used, 20u);
+
+  // reading 1 brings it back to the device and moves 3 to the host, where 2 is the least
+  // recently used
+  EXPECT_TRUE(ReadImage(1));
+  stats = cache_->GetStats();
+  EXPECT_EQ(stats.promotions, 1u);
+  EXPECT_EQ(stats.demotions, 4u);
+  EXPECT_EQ(stats.evictions, 2u);
+  EXPECT_FALSE(IsCached(2));
+  for (int i : {1, 3, 4})
+    EXPECT_TRUE(ReadImage(i));
+  EXPECT_EQ(cache_->GetStats().host_bytes_used, 10u);
+}
+
+TEST_F(ImageCacheEvictingTest, HostTierDirectRead) {
+  // the host block of an image is released after it's moved to the device, so moving
+  // the images in and out needs some free space in the host tier
+  SetUpImpl(EvictionPolicy::LRU, 10, 1, 20);
+  AddImage(0);
+  AddImage(1);
+  auto img = cache_->Get(data_[1].first);
+  ASSERT_NE(img.data, nullptr);
+  // 1 is pinned on the device, so 0 is read from the host memory
+  EXPECT_TRUE(ReadImage(0));
+  EXPECT_EQ(cache_->GetStats().promotions, 0u);
+  cache_->FinishDeferredReads({data_[1].first}, 0);
+  EXPECT_TRUE(ReadImage(0));
+  EXPECT_EQ(cache_->GetStats().promotions, 1u);
+  EXPECT_TRUE(ReadImage(1));
+  EXPECT_EQ(cache_->GetStats().evictions, 0u);
+}
+
+TEST_F(ImageCacheEvictingTest, Trim) {
+  SetUpImpl(EvictionPolicy::LRU, 20, 1, 20);
+  for (int i = 0; i < 4; i++)
+    AddImage(i);
+  auto img = cache_->Get(data_[3].first);
+  ASSERT_NE(img.data, nullptr);
+  // a pinned image prevents freeing the memory
+  EXPECT_EQ(cache_->Trim(), 0u);
+  EXPECT_TRUE(IsCached(0));
+  cache_->FinishDeferredReads({data_[3].first}, 0);
+
+  EXPECT_EQ(cache_->Trim(), 40u);
+  auto stats = cache_->GetStats();
+  EXPECT_EQ(stats.images_cached, 0u);
+  EXPECT_EQ(stats.bytes_used, 0u);
+  EXPECT_EQ(stats.host_bytes_used, 0u);
+  EXPECT_EQ(stats.evictions, 4u);
+  EXPECT_FALSE(IsCached(3));
+  EXPECT_EQ(cache_->Trim(), 0u);
+
+  // the memory is allocated again
+  for (int i = 4; i < 7; i++)
+    AddImage(i);
+  for (int i = 4; i < 7; i++)
+    EXPECT_TRUE(ReadImage(i));
+}
+
+}  // namespace testing
+}  // namespace dali
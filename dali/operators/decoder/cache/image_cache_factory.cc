@@ -14,25 +14,55 @@
 
 #include "dali/operators/decoder/cache/image_cache_factory.h"
 #include <memory>
+#include <utility>
+#include <vector>
+#include "dali/core/mm/default_resources.h"
 #include "dali/operators/decoder/cache/image_cache_blob.h"
+#include "dali/operators/decoder/cache/image_cache_disk.h"
+#include "dali/operators/decoder/cache/image_cache_evicting.h"
 #include "dali/operators/decoder/cache/image_cache_largest.h"
 
 namespace dali {
 
+ImageCacheFactory::ImageCacheFactory() {
+  release_callback_id_ = mm::AddMemoryReleaseCallback([this]() {
+    return Trim();
+  });
+}
+
+ImageCacheFactory::~ImageCacheFactory() {
+  mm::RemoveMemoryReleaseCallback(release_callback_id_);
+}
+
 std::shared_ptr<ImageCache> ImageCacheFactory::Get(int device_id,
                                                    const std::string& cache_policy,
                                                    std::size_t cache_size,
                                                    bool cache_debug,
-                                                   std::size_t cache_threshold) {
+                                                   std::size_t cache_threshold,
+                                                   std::size_t host_cache_size,
+                                                   const std::string& cache_dir) {
   std::lock_guard<std::mutex> lock(mutex_);
-  const CacheParams params{cache_policy, cache_size, cache_debug, cache_threshold};
+  const CacheParams params{cache_policy, cache_size, cache_debug, cache_threshold,
+                           host_cache_size, cache_dir};
   auto &instance = caches_[device_id];
   auto cache = instance.cache.lock();
   if (!cache) {
+    DALI_ENFORCE(host_cache_size == 0 || cache_policy == "lru" || cache_policy == "lfu",
+                 "The host memory tier is supported only by the `lru` and `lfu` cache policies");
+    DALI_ENFORCE(cache_dir.empty() == (cache_policy != "disk"),
+                 "A cache directory is required by (and only by) the `disk` cache policy");
     if (cache_policy == "threshold") {
       cache.reset(new ImageCacheBlob(cache_size, cache_threshold, cache_debug));
     } else if (cache_policy == "largest") {
       cache.reset(new ImageCacheLargest(cache_size, cache_debug));
+    } else if (cache_policy == "lru") {
+      cache.reset(new ImageCacheEvicting(cache_size, EvictionPolicy::LRU, cache_threshold,
+                                         cache_debug, 0, host_cache_size));
+    } else if (cache_policy == "lfu") {
+      cache.reset(new ImageCacheEvicting(cache_size, EvictionPolicy::LFU, cache_threshold,
+                                         cache_debug, 0, host_cache_size));
+    } else if (cache_policy == "disk") {
+      cache.reset(new ImageCacheDisk(cache_dir, cache_size, cache_threshold, cache_debug));
     } else {
       DALI_FAIL("unexpected cache policy `" + cache_policy + "`");
     }
@@ -56,6 +86,21 @@ bool ImageCacheFactory::IsInitialized(int device_id) {
   return CheckWeakPtr(device_id);
 }
 
+std::size_t ImageCacheFactory::Trim() {
+  std::vector<std::shared_ptr<ImageCache>> caches;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &instance : caches_) {
+      if (auto cache = instance.second.cache.lock())
+        caches.push_back(std::move(cache));
+    }
+  }
+  std::size_t freed = 0;
+  for (auto &cache : caches)
+    freed += cache->Trim();
+  return freed;
+}
+
 bool ImageCacheFactory::CheckWeakPtr(int device_id) {
   auto it = caches_.find(device_id);
   if (it != caches_.end() && it->second.cache.expired()) {
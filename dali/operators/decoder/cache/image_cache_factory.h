@@ -36,13 +36,18 @@ class DLL_PUBLIC ImageCacheFactory {
    * are the same.
    * Will fail if the cache was already allocated but with different
    * parameters
+   * @param host_cache_size size of the pinned host memory tier; only the evicting
+   *                        policies ("lru", "lfu") support it
+   * @param cache_dir the directory of the "disk" cache, which keeps the images in files
    */
   DLL_PUBLIC std::shared_ptr<ImageCache> Get(
     int device_id,
     const std::string& cache_policy,
     std::size_t cache_size,
     bool cache_debug = false,
-    std::size_t cache_threshold = 0);
+    std::size_t cache_threshold = 0,
+    std::size_t host_cache_size = 0,
+    const std::string& cache_dir = "");
 
   /**
    * @brief Get the already allocated cache
@@ -55,9 +60,21 @@ class DLL_PUBLIC ImageCacheFactory {
    */
   DLL_PUBLIC bool IsInitialized(int device_id);
 
+  /**
+   * @brief Frees the memory of all existing caches, if possible, dropping the cached images
+   * @remarks It's called by mm::ReleaseUnusedMemory, when the caches are to be released.
+   * @return the number of bytes freed
+   */
+  DLL_PUBLIC std::size_t Trim();
+
  private:
+  ImageCacheFactory();
+  ~ImageCacheFactory();
+
   bool CheckWeakPtr(int device_id);
 
+  int release_callback_id_ = -1;
+
   mutable std::mutex mutex_;
 
   struct CacheParams {
@@ -65,12 +82,16 @@ class DLL_PUBLIC ImageCacheFactory {
     std::size_t cache_size;
     bool cache_debug;
     std::size_t cache_threshold;
+    std::size_t host_cache_size;
+    std::string cache_dir;
 
     inline bool operator==(const CacheParams& oth) const {
       return cache_policy == oth.cache_policy
           && cache_size == oth.cache_size
           && cache_debug == oth.cache_debug
-          && cache_threshold == oth.cache_threshold;
+          && cache_threshold == oth.cache_threshold
+          && host_cache_size == oth.host_cache_size
+          && cache_dir == oth.cache_dir;
     }
   };
 
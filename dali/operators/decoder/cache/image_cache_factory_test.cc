@@ -14,7 +14,10 @@
 
 #include "dali/operators/decoder/cache/image_cache_factory.h"
 #include <gtest/gtest.h>
+#include <unistd.h>
+#include <cstdlib>
 #include <memory>
+#include <string>
 
 namespace dali {
 namespace testing {
@@ -112,5 +115,39 @@ TEST_F(ImageCacheFactoryTest, GetAndRefCount) {
   auto cache03 = factory.Get(0, "threshold", 2*1024*1024, true, 1024);
 }
 
+TEST_F(ImageCacheFactoryTest, EvictingPolicies) {
+  auto &factory = ImageCacheFactory::Instance();
+  ASSERT_FALSE(factory.IsInitialized(0));
+  ASSERT_FALSE(factory.IsInitialized(1));
+  auto cache0 = factory.Get(0, "lru", 1*1024*1024, false, 0);
+  auto cache1 = factory.Get(1, "lfu", 1*1024*1024, false, 1024);
+  EXPECT_NE(nullptr, cache0);
+  EXPECT_NE(nullptr, cache1);
+  EXPECT_THROW(factory.Get(2, "fifo", 1*1024*1024, false, 0), std::runtime_error);
+  // only the evicting caches can move the images to the host memory
+  EXPECT_THROW(factory.Get(2, "threshold", 1*1024*1024, false, 0, 1*1024*1024),
+               std::runtime_error);
+  EXPECT_NE(nullptr, factory.Get(3, "lru", 1*1024*1024, false, 0, 1*1024*1024));
+}
+
+TEST_F(ImageCacheFactoryTest, DiskPolicy) {
+  auto &factory = ImageCacheFactory::Instance();
+  ASSERT_FALSE(factory.IsInitialized(0));
+  char dir_template[] = "/tmp/dali_image_cache_XXXXXX";
+  ASSERT_NE(nullptr, mkdtemp(dir_template));
+  std::string dir = dir_template;
+  // the directory is required by the disk cache and only by it
+  EXPECT_THROW(factory.Get(0, "disk", 1*1024*1024, false, 0), std::runtime_error);
+  EXPECT_THROW(factory.Get(0, "lru", 1*1024*1024, false, 0, 0, dir), std::runtime_error);
+  {
+    auto cache = factory.Get(0, "disk", 1*1024*1024, false, 0, 0, dir);
+    EXPECT_NE(nullptr, cache);
+    EXPECT_THROW(factory.Get(0, "disk", 1*1024*1024, false, 0, 0, dir + "/other"),
+                 std::runtime_error);
+  }
+  EXPECT_FALSE(factory.IsInitialized(0));
+  rmdir(dir.c_str());
+}
+
 }  // namespace testing
 }  // namespace dali
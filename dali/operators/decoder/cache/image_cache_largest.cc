@@ -80,10 +80,11 @@ void ImageCacheLargest::Add(const ImageKey& image_key,
       }
     }
   }
-  lock.unlock();
-
   if (start_caching_ && images_.find(image_key) != images_.end()) {
+    lock.unlock();
     ImageCacheBlob::Add(image_key, data, data_shape, stream);
+  } else {
+    misses_++;
   }
 }
 
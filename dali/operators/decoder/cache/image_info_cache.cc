@@ -0,0 +1,63 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/decoder/cache/image_info_cache.h"
+
+namespace dali {
+
+ImageInfoCache &ImageInfoCache::Instance() {
+  static ImageInfoCache instance;
+  return instance;
+}
+
+bool ImageInfoCache::Get(const std::string &key, int64_t encoded_length,
+                         ImageHeaderInfo &info) const {
+  if (key.empty())
+    return false;
+  auto &shard = GetShard(key);
+  std::lock_guard<std::mutex> guard(shard.mutex);
+  auto it = shard.entries.find(key);
+  if (it == shard.entries.end() || it->second.encoded_length != encoded_length)
+    return false;
+  info = it->second;
+  return true;
+}
+
+bool ImageInfoCache::Reserve() {
+  std::lock_guard<std::mutex> guard(size_mutex_);
+  if (size_ >= capacity_)
+    return false;
+  size_++;
+  return true;
+}
+
+size_t ImageInfoCache::size() const {
+  size_t total = 0;
+  for (auto &shard : shards_) {
+    std::lock_guard<std::mutex> guard(shard.mutex);
+    total += shard.entries.size();
+  }
+  return total;
+}
+
+void ImageInfoCache::Clear() {
+  for (auto &shard : shards_) {
+    std::lock_guard<std::mutex> guard(shard.mutex);
+    shard.entries.clear();
+  }
+  std::lock_guard<std::mutex> guard(size_mutex_);
+  size_ = 0;
+}
+
+}  // namespace dali
@@ -0,0 +1,131 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_DECODER_CACHE_IMAGE_INFO_CACHE_H_
+#define DALI_OPERATORS_DECODER_CACHE_IMAGE_INFO_CACHE_H_
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "dali/core/api_helper.h"
+#include "dali/core/tensor_shape.h"
+
+namespace dali {
+
+/**
+ * @brief The information parsed from the header of an encoded image
+ */
+struct ImageHeaderInfo {
+  /// the size of the encoded image; a cached entry is used only if the size matches
+  int64_t encoded_length = 0;
+
+  /// the shape, as reported by the host image parser (`Image::PeekShape`); empty if not known
+  TensorShape<3> shape = {0, 0, 0};
+
+  /// whether the nvJPEG fields below were filled
+  bool has_nvjpeg_info = false;
+  /// whether nvJPEG could parse the header
+  bool nvjpeg_decodable = false;
+  /// the shape reported by nvJPEG
+  TensorShape<3> nvjpeg_shape = {0, 0, 0};
+  /// the chroma subsampling (nvjpegChromaSubsampling_t)
+  int subsampling = -1;
+  bool progressive = false;
+  bool lossless = false;
+};
+
+/**
+ * @brief A cache of the image header information, shared by all the operators in the process
+ *
+ * The images are identified by their source info (e.g. the file name) and the encoded size,
+ * so that the headers have to be parsed only once, in the first epoch, even when the image
+ * goes through several operators (e.g. PeekImageShape and a decoder).
+ * Images without the source info are not cached.
+ *
+ * The cache stops accepting new entries when it reaches its capacity.
+ */
+class DLL_PUBLIC ImageInfoCache {
+ public:
+  static constexpr size_t kDefaultCapacity = 1 << 20;
+
+  explicit ImageInfoCache(size_t capacity = kDefaultCapacity) : capacity_(capacity) {}
+
+  DLL_PUBLIC static ImageInfoCache &Instance();
+
+  /**
+   * @brief Gets the cached information of an image
+   * @return false, if the image is not in the cache
+   */
+  DLL_PUBLIC bool Get(const std::string &key, int64_t encoded_length,
+                      ImageHeaderInfo &info) const;
+
+  /**
+   * @brief Updates (or adds) the cached information of an image
+   *
+   * @param update   a function modifying the `ImageHeaderInfo`; for a new entry, it's
+   *                 called with a default-initialized one
+   */
+  template <typename UpdateFn>
+  void Update(const std::string &key, int64_t encoded_length, UpdateFn &&update) {
+    if (key.empty())
+      return;
+    auto &shard = GetShard(key);
+    std::lock_guard<std::mutex> guard(shard.mutex);
+    auto it = shard.entries.find(key);
+    if (it == shard.entries.end() || it->second.encoded_length != encoded_length) {
+      if (it == shard.entries.end() && !Reserve())
+        return;
+      ImageHeaderInfo &info = shard.entries[key];
+      info = {};
+      info.encoded_length = encoded_length;
+      update(info);
+    } else {
+      update(it->second);
+    }
+  }
+
+  DLL_PUBLIC size_t size() const;
+
+  DLL_PUBLIC void Clear();
+
+ private:
+  static constexpr int kNumShards = 16;
+
+  struct Shard {
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, ImageHeaderInfo> entries;
+  };
+
+  Shard &GetShard(const std::string &key) {
+    return shards_[std::hash<std::string>()(key) % kNumShards];
+  }
+
+  const Shard &GetShard(const std::string &key) const {
+    return shards_[std::hash<std::string>()(key) % kNumShards];
+  }
+
+  /// reserves the space for a new entry; false if the cache is full
+  DLL_PUBLIC bool Reserve();
+
+  size_t capacity_;
+  std::mutex size_mutex_;
+  size_t size_ = 0;
+  std::array<Shard, kNumShards> shards_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_DECODER_CACHE_IMAGE_INFO_CACHE_H_
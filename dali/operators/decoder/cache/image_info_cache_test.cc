@@ -0,0 +1,93 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/decoder/cache/image_info_cache.h"
+#include <gtest/gtest.h>
+#include <string>
+
+namespace dali {
+namespace testing {
+
+TEST(ImageInfoCacheTest, UpdateAndGet) {
+  ImageInfoCache cache;
+  ImageHeaderInfo info;
+  EXPECT_FALSE(cache.Get("a.jpg", 100, info));
+
+  cache.Update("a.jpg", 100, [](ImageHeaderInfo &info) {
+    info.shape = {10, 20, 3};
+  });
+  ASSERT_TRUE(cache.Get("a.jpg", 100, info));
+  EXPECT_EQ(info.shape, (TensorShape<3>{10, 20, 3}));
+  EXPECT_FALSE(info.has_nvjpeg_info);
+
+  // the entry is extended, not replaced
+  cache.Update("a.jpg", 100, [](ImageHeaderInfo &info) {
+    info.has_nvjpeg_info = true;
+    info.progressive = true;
+  });
+  ASSERT_TRUE(cache.Get("a.jpg", 100, info));
+  EXPECT_EQ(info.shape, (TensorShape<3>{10, 20, 3}));
+  EXPECT_TRUE(info.has_nvjpeg_info);
+  EXPECT_TRUE(info.progressive);
+  EXPECT_EQ(cache.size(), 1u);
+}
+
+TEST(ImageInfoCacheTest, SizeMismatch) {
+  ImageInfoCache cache;
+  ImageHeaderInfo info;
+  cache.Update("a.jpg", 100, [](ImageHeaderInfo &info) {
+    info.shape = {10, 20, 3};
+  });
+  EXPECT_FALSE(cache.Get("a.jpg", 101, info));
+
+  // a different image with the same name replaces the entry
+  cache.Update("a.jpg", 101, [](ImageHeaderInfo &info) {
+    info.progressive = true;
+  });
+  ASSERT_TRUE(cache.Get("a.jpg", 101, info));
+  EXPECT_EQ(info.shape, (TensorShape<3>{0, 0, 0}));
+  EXPECT_TRUE(info.progressive);
+  EXPECT_EQ(cache.size(), 1u);
+}
+
+TEST(ImageInfoCacheTest, NoSourceInfo) {
+  ImageInfoCache cache;
+  ImageHeaderInfo info;
+  cache.Update("", 100, [](ImageHeaderInfo &info) {
+    info.shape = {10, 20, 3};
+  });
+  EXPECT_FALSE(cache.Get("", 100, info));
+  EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST(ImageInfoCacheTest, Capacity) {
+  ImageInfoCache cache(10);
+  for (int i = 0; i < 20; i++) {
+    cache.Update(std::to_string(i), i, [](ImageHeaderInfo &info) {
+      info.shape = {1, 1, 1};
+    });
+  }
+  EXPECT_EQ(cache.size(), 10u);
+  ImageHeaderInfo info;
+  EXPECT_TRUE(cache.Get("0", 0, info));
+  EXPECT_FALSE(cache.Get("15", 15, info));
+
+  cache.Clear();
+  EXPECT_EQ(cache.size(), 0u);
+  cache.Update("15", 15, [](ImageHeaderInfo &) {});
+  EXPECT_TRUE(cache.Get("15", 15, info));
+}
+
+}  // namespace testing
+}  // namespace dali
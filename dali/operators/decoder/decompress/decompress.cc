@@ -0,0 +1,153 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <nvcomp/deflate.h>
+#include <nvcomp/lz4.h>
+#include <nvcomp/snappy.h>
+#include <nvcomp/zstd.h>
+#include <algorithm>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "dali/operators/decoder/decompress/decompress.h"
+#include "dali/pipeline/operator/common.h"
+
+namespace dali {
+
+DALI_SCHEMA(experimental__Decompress)
+  .DocStr(R"code(Decompresses the data on the GPU.
+
+Each sample of the input is a chunk of data compressed with ``algorithm``, e.g. a NumPy array
+compressed after removing the header of the ``.npy`` file. The samples are decompressed
+together, as a batch, to the tensors of the given ``shape`` and ``dtype``.
+
+The input can be read with any reader producing the raw files, e.g. ``fn.readers.file``,
+and copied to the GPU, or read directly to the GPU memory.
+
+.. note::
+  The size of the decompressed data is not validated, so the shape must match it exactly.)code")
+  .NumInput(1)
+  .NumOutput(1)
+  .Deterministic()
+  .InputDox(0, "input", "1D TensorList of uint8", "The compressed data.")
+  .AddOptionalArg("algorithm", R"code(The compression algorithm.
+
+Available values:
+
+* ``lz4`` - LZ4, the data compressed with ``LZ4_compress_default`` (the block format,
+  without the frame header),
+* ``snappy`` - Snappy, the raw format,
+* ``zstd`` - Zstandard, a single frame,
+* ``deflate`` - Deflate, the raw format (without the zlib or gzip header).)code",
+      std::string("lz4"))
+  .AddArg("shape", R"code(The shape of the decompressed samples.)code", DALI_INT_VEC, true)
+  .AddOptionalArg("dtype", R"code(The type of the decompressed samples.)code", DALI_UINT8)
+  .AddOptionalArg("layout", R"code(The layout of the decompressed samples.)code",
+      TensorLayout(""));
+
+namespace {
+
+void CheckStatus(nvcompStatus_t status, const std::string &algorithm) {
+  DALI_ENFORCE(status == nvcompSuccess,
+               make_string("nvCOMP error ", static_cast<int>(status), " when decompressing ",
+                           algorithm, " data."));
+}
+
+}  // namespace
+
+Decompress::Decompress(const OpSpec &spec)
+    : Operator<GPUBackend>(spec),
+      algorithm_(spec.GetArgument<std::string>("algorithm")),
+      dtype_(spec.GetArgument<DALIDataType>("dtype")),
+      layout_(spec.GetArgument<TensorLayout>("layout")) {
+  if (algorithm_ == "lz4") {
+    get_temp_size_ = nvcompBatchedLZ4DecompressGetTempSize;
+    decompress_ = nvcompBatchedLZ4DecompressAsync;
+  } else if (algorithm_ == "snappy") {
+    get_temp_size_ = nvcompBatchedSnappyDecompressGetTempSize;
+    decompress_ = nvcompBatchedSnappyDecompressAsync;
+  } else if (algorithm_ == "zstd") {
+    get_temp_size_ = nvcompBatchedZstdDecompressGetTempSize;
+    decompress_ = nvcompBatchedZstdDecompressAsync;
+  } else if (algorithm_ == "deflate") {
+    get_temp_size_ = nvcompBatchedDeflateDecompressGetTempSize;
+    decompress_ = nvcompBatchedDeflateDecompressAsync;
+  } else {
+    DALI_FAIL(make_string("Unknown compression algorithm: \"", algorithm_,
+                          "\". Valid values are \"lz4\", \"snappy\", \"zstd\" and \"deflate\"."));
+  }
+}
+
+bool Decompress::SetupImpl(std::vector<OutputDesc> &output_desc, const DeviceWorkspace &ws) {
+  const auto &input = ws.InputRef<GPUBackend>(0);
+  DALI_ENFORCE(input.type() == DALI_UINT8,
+               make_string("The compressed data must be of type uint8, got ", input.type(), "."));
+  int nsamples = input.ntensor();
+  GetShapeArgument(shape_, spec_, "shape", ws, nsamples);
+  DALI_ENFORCE(layout_.empty() || layout_.ndim() == shape_.sample_dim(),
+               make_string("The layout \"", layout_, "\" doesn't match the number of dimensions ",
+                           "of the shape: ", shape_.sample_dim(), "."));
+  output_desc.resize(1);
+  output_desc[0] = {shape_, dtype_};
+  return true;
+}
+
+void Decompress::RunImpl(DeviceWorkspace &ws) {
+  const auto &input = ws.InputRef<GPUBackend>(0);
+  auto &output = ws.OutputRef<GPUBackend>(0);
+  output.SetLayout(layout_);
+  size_t type_size = TypeTable::GetTypeInfo(dtype_).size();
+
+  // the empty samples are not passed to nvCOMP
+  std::vector<const void *> in_ptrs;
+  std::vector<size_t> in_sizes, out_sizes;
+  std::vector<void *> out_ptrs;
+  size_t max_out_size = 0;
+  for (int i = 0; i < input.ntensor(); i++) {
+    size_t out_size = output.shape().tensor_size(i) * type_size;
+    if (out_size == 0)
+      continue;
+    in_ptrs.push_back(input.raw_tensor(i));
+    in_sizes.push_back(input.shape().tensor_size(i));
+    out_ptrs.push_back(output.raw_mutable_tensor(i));
+    out_sizes.push_back(out_size);
+    max_out_size = std::max(max_out_size, out_size);
+  }
+  size_t n = in_ptrs.size();
+  if (n == 0)
+    return;
+
+  size_t temp_size = 0;
+  CheckStatus(get_temp_size_(n, max_out_size, &temp_size), algorithm_);
+  constexpr size_t kAlignment = 64;
+  size_t params_size = n * (2 * sizeof(void *) + 3 * sizeof(size_t) + sizeof(nvcompStatus_t));
+  scratch_alloc_.Reserve<mm::memory_kind::device>(params_size + temp_size + 4 * kAlignment);
+  auto scratch = scratch_alloc_.GetScratchpad();
+  const void **dev_in_ptrs;
+  size_t *dev_in_sizes, *dev_out_sizes;
+  void **dev_out_ptrs;
+  std::tie(dev_in_ptrs, dev_in_sizes, dev_out_sizes, dev_out_ptrs) =
+      scratch.ToContiguousGPU(ws.stream(), in_ptrs, in_sizes, out_sizes, out_ptrs);
+  auto *dev_actual_sizes = scratch.AllocateGPU<size_t>(n);
+  auto *dev_statuses = scratch.AllocateGPU<nvcompStatus_t>(n);
+  auto *temp = scratch.AllocateGPU<uint8_t>(temp_size, kAlignment);
+
+  CheckStatus(decompress_(dev_in_ptrs, dev_in_sizes, dev_out_sizes, dev_actual_sizes, n, temp,
+                          temp_size, dev_out_ptrs, dev_statuses, ws.stream()),
+              algorithm_);
+}
+
+DALI_REGISTER_OPERATOR(experimental__Decompress, Decompress, GPU);
+
+}  // namespace dali
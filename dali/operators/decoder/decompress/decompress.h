@@ -0,0 +1,67 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_DECODER_DECOMPRESS_DECOMPRESS_H_
+#define DALI_OPERATORS_DECODER_DECOMPRESS_DECOMPRESS_H_
+
+#include <nvcomp.h>
+#include <string>
+#include <vector>
+#include "dali/kernels/scratch.h"
+#include "dali/pipeline/operator/operator.h"
+
+namespace dali {
+
+/**
+ * @brief Decompresses each sample of the input, compressed as a single chunk with one of
+ *        the batched nvCOMP algorithms, to a tensor of the given shape and type
+ */
+class Decompress : public Operator<GPUBackend> {
+ public:
+  explicit Decompress(const OpSpec &spec);
+
+  DISABLE_COPY_MOVE_ASSIGN(Decompress);
+
+ protected:
+  bool CanInferOutputs() const override {
+    return true;
+  }
+
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const DeviceWorkspace &ws) override;
+  void RunImpl(DeviceWorkspace &ws) override;
+
+ private:
+  using GetTempSizeFn = nvcompStatus_t (*)(size_t num_chunks, size_t max_uncompressed_chunk_bytes,
+                                           size_t *temp_bytes);
+  using DecompressFn = nvcompStatus_t (*)(const void *const *device_compressed_ptrs,
+                                          const size_t *device_compressed_bytes,
+                                          const size_t *device_uncompressed_bytes,
+                                          size_t *device_actual_uncompressed_bytes,
+                                          size_t batch_size, void *const device_temp_ptr,
+                                          size_t temp_bytes, void *const *device_uncompressed_ptrs,
+                                          nvcompStatus_t *device_statuses, cudaStream_t stream);
+
+  std::string algorithm_;
+  GetTempSizeFn get_temp_size_ = nullptr;
+  DecompressFn decompress_ = nullptr;
+  DALIDataType dtype_;
+  TensorLayout layout_;
+
+  TensorListShape<> shape_;
+  kernels::ScratchpadAllocator scratch_alloc_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_DECODER_DECOMPRESS_DECOMPRESS_H_
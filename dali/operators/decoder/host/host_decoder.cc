@@ -17,12 +17,29 @@
 #include <memory>
 #include "dali/image/image_factory.h"
 #include "dali/operators/decoder/host/host_decoder.h"
+#include "dali/pipeline/util/sample_scheduler.h"
 
 namespace dali {
 
-void HostDecoder::RunImpl(SampleWorkspace &ws) {
-  const auto &input = ws.Input<CPUBackend>(0);
-  auto &output = ws.Output<CPUBackend>(0);
+void HostDecoder::RunImpl(HostWorkspace &ws) {
+  const auto &input = ws.InputRef<CPUBackend>(0);
+  auto &output = ws.OutputRef<CPUBackend>(0);
+  auto &thread_pool = ws.GetThreadPool();
+  int batch_size = input.ntensor();
+  output.SetSize(batch_size);
+  SampleScheduler scheduler;
+  for (int i = 0; i < batch_size; i++) {
+    // the largest images first
+    scheduler.AddSample(input[i].size(), [this, &input, &output, i](int) {
+      DecodeSample(input[i], output[i], i);
+    });
+  }
+  scheduler.Run(thread_pool);
+  output.SetLayout("HWC");
+}
+
+void HostDecoder::DecodeSample(const Tensor<CPUBackend> &input, Tensor<CPUBackend> &output,
+                               int data_idx) {
   auto file_name = input.GetSourceInfo();
 
   // Verify input
@@ -34,8 +51,14 @@ void HostDecoder::RunImpl(SampleWorkspace &ws) {
   std::unique_ptr<Image> img;
   try {
     img = ImageFactory::CreateImage(input.data<uint8>(), input.size(), output_type_);
-    img->SetCropWindowGenerator(GetCropWindowGenerator(ws.data_idx()));
+    img->SetCropWindowGenerator(GetCropWindowGenerator(data_idx));
     img->SetUseFastIdct(use_fast_idct_);
+    if (!downscale_hint_.empty())
+      img->SetDownscaleHint(downscale_hint_[0], downscale_hint_[1]);
+    img->SetOutputAllocator([&output](const TensorShape<3> &shape) {
+      output.Resize(shape);
+      return output.mutable_data<uint8_t>();
+    });
     img->Decode();
   } catch (std::exception &e) {
     DALI_FAIL(e.what() + ". File: " + file_name);
@@ -43,9 +66,9 @@ void HostDecoder::RunImpl(SampleWorkspace &ws) {
   const auto decoded = img->GetImage();
   const auto shape = img->GetShape();
   output.Resize(shape);
-  output.SetLayout("HWC");
   unsigned char *out_data = output.mutable_data<unsigned char>();
-  std::memcpy(out_data, decoded.get(), volume(shape));
+  if (decoded.get() != out_data)  // not decoded in place
+    std::memcpy(out_data, decoded.get(), volume(shape));
 }
 
 DALI_REGISTER_OPERATOR(decoders__Image, HostDecoder, CPU);
@@ -29,8 +29,15 @@ class HostDecoder : public Operator<CPUBackend> {
   explicit inline HostDecoder(const OpSpec &spec) :
       Operator<CPUBackend>(spec),
       output_type_(spec.GetArgument<DALIImageType>("output_type")),
-      use_fast_idct_(spec.GetArgument<bool>("use_fast_idct"))
-  {}
+      use_fast_idct_(spec.GetArgument<bool>("use_fast_idct")) {
+    // only the plain (non-cropping) decoders accept the hint
+    if (spec.GetSchema().HasArgument("downscale_hint"))
+      downscale_hint_ = spec.GetRepeatedArgument<int>("downscale_hint");
+    DALI_ENFORCE(downscale_hint_.empty() || downscale_hint_.size() == 2,
+                 "`downscale_hint` must be empty or consist of two values: height and width.");
+    DALI_ENFORCE(output_type_ != DALI_YUV420,
+                 "Decoding to YUV420 is supported only by the ``mixed`` decoder.");
+  }
 
   inline ~HostDecoder() override = default;
   DISABLE_COPY_MOVE_ASSIGN(HostDecoder);
@@ -40,7 +47,19 @@ class HostDecoder : public Operator<CPUBackend> {
     return false;
   }
 
-  void RunImpl(SampleWorkspace &ws) override;
+  /**
+   * @brief Decodes the batch in the thread pool, the largest images first, to balance the load
+   *        of the threads
+   *
+   * When the decoder knows the output shape up front (e.g. libjpeg-turbo), the image is decoded
+   * directly into the output tensor, which keeps its memory between the iterations.
+   */
+  void RunImpl(HostWorkspace &ws) override;
+
+  /**
+   * @brief Decodes one sample into the output tensor
+   */
+  void DecodeSample(const Tensor<CPUBackend> &input, Tensor<CPUBackend> &output, int data_idx);
 
   virtual CropWindowGenerator GetCropWindowGenerator(int data_idx) const {
     return {};
@@ -48,6 +67,7 @@ class HostDecoder : public Operator<CPUBackend> {
 
   DALIImageType output_type_;
   bool use_fast_idct_ = false;
+  std::vector<int> downscale_hint_;
 };
 
 }  // namespace dali
@@ -28,6 +28,11 @@ DALI_SCHEMA(ImageDecoderAttr)
 
 Note: When decoding to YCbCr, the image will be decoded to RGB and then converted to YCbCr,
 following the YCbCr definition from ITU-R BT.601.
+
+``YUV420`` (supported only by the ``mixed`` backend) produces the same YCbCr values, with the chroma
+subsampled 2x in both dimensions, as a 2D tensor (``HW``) holding the Y, Cb and Cr planes one after
+another. This halves the size of the output; the images can be converted to other color spaces
+with :meth:`nvidia.dali.fn.color_space_conversion`.
 )code",
       DALI_RGB)
   .AddOptionalArg("hybrid_huffman_threshold",
@@ -92,6 +97,16 @@ allocations will occur during the pipeline execution. One way to find the ideal
 do a complete run over the dataset with the ``memory_stats`` argument set to True, and then copy
 the largest allocation value that is printed in the statistics.)code",
       0)
+  .AddOptionalArg("num_threads_jpeg2k",
+      R"code(Applies **only** to the ``mixed`` backend type.
+
+The number of threads decoding the JPEG 2000 images with nvJPEG2k. Each thread has its own
+decoding state and CUDA stream, so the images of a batch are decoded concurrently, overlapping
+with the decoding of the other formats. Very large tiled images are split between the threads.
+
+Each thread preallocates its own ``device_memory_padding_jpeg2k`` and
+``host_memory_padding_jpeg2k`` buffers.)code",
+      2)
   .AddOptionalArg("hw_decoder_load",
       R"code(The percentage of the image data to be processed by the HW JPEG decoder.
 
@@ -102,6 +117,18 @@ if available. The optimal workload depends on the number of threads that are pro
 the DALI pipeline and should be found empirically. More details can be found at
 https://developer.nvidia.com/blog/loading-data-fast-with-dali-and-new-jpeg-decoder-in-a100)code",
       0.65f)
+  .AddOptionalArg("adaptive_load_balancing",
+      R"code(If set to True, the split of the work between the decoders is adjusted in every
+iteration, based on the throughput they achieved.
+
+Applies **only** to the ``mixed`` backend type.
+
+The ``hw_decoder_load`` is used as the initial share of the HW JPEG decoder, and then updated so
+that the HW decoder and the CPU threads finish at the same time. Additionally, a part of
+the images that would be decoded by nvJPEG on the CPU threads and the GPU is given to the host
+decoder, if it proves faster. The current split is reported as the ``hw_decoder_load`` and
+``host_decoder_load`` diagnostics of the operator, in the executor metadata.)code",
+      false)
   .AddOptionalArg("preallocate_width_hint",
       R"code(Image width hint.
 
@@ -175,6 +202,11 @@ The output of the decoder is in *HWC* layout.
 Supported formats: JPG, BMP, PNG, TIFF, PNM, PPM, PGM, PBM, JPEG 2000, WebP.
 Please note that GPU acceleration for JPEG 2000 decoding is only available for CUDA 11.
 
+When ``device`` is set to ``mixed``, 8-bit gray, RGB and RGBA PNG and TIFF images are
+decompressed on the CPU and reconstructed (unfiltered and converted to the output color space)
+on the GPU. Other variants of these formats, e.g. palette, interlaced or tiled images,
+are decoded entirely on the CPU.
+
 .. note::
   WebP decoding currently only supports the simple file format (lossy and lossless compression).
   For details on the different WebP file formats, see
@@ -184,6 +216,21 @@ Please note that GPU acceleration for JPEG 2000 decoding is only available for C
   EXIF orientation metadata is disregarded.)code")
   .NumInput(1)
   .NumOutput(1)
+  .Deterministic()
+  .AddOptionalArg("downscale_hint",
+      R"code(The minimum size (height, width) of the decoded image, if it may be decoded at
+a reduced resolution.
+
+If provided, JPEG images are decoded at 1/2, 1/4 or 1/8 of their resolution, using the largest
+scale factor for which the decoded image is still at least as large as the hint in both
+dimensions. A value of 0 means that the respective dimension is not constrained.
+Decoding at a reduced resolution skips most of the IDCT and color conversion work, so it's
+useful when the decoded image is downscaled right after decoding, e.g. with :meth:`resize`.
+
+The ``mixed`` backend decodes such images on the CPU, with *libjpeg-turbo*, unless they are
+assigned to the HW JPEG decoder, which decodes them at the full resolution.
+Other image formats are always decoded at the full resolution.)code",
+      std::vector<int>())
   .AddParent("ImageDecoderAttr")
   .AddParent("CachedDecoderAttr");
 
@@ -210,6 +257,7 @@ Supported formats: JPG, BMP, PNG, TIFF, PNM, PPM, PGM, PBM, JPEG 2000, WebP.
   EXIF orientation metadata is disregarded.)code")
   .NumInput(1)
   .NumOutput(1)
+  .Deterministic()
   .AddParent("ImageDecoderAttr")
   .AddParent("CropAttr");
 
@@ -240,6 +288,40 @@ Supported formats: JPG, BMP, PNG, TIFF, PNM, PPM, PGM, PBM, JPEG 2000, WebP.
   .AddParent("RandomCropAttr");
 
 
+DALI_SCHEMA(decoders__ImageMultiCrop)
+  .DocStr(R"code(Decodes images and produces several random crops of each of them, resized
+to a common size.
+
+The operator returns ``num_crops`` outputs, each of them holding one crop of every image.
+The cropping windows are chosen the same way as in :meth:`decoders.image_random_crop`.
+
+This is more efficient than decoding the same image several times or decoding the entire
+image and cropping it afterwards: only the region spanned by all the cropping windows of an image
+is decoded (with the ROI decoding, when possible), once, and all the crops of the batch are then
+resized from it in a single resampling pass.
+
+The output of the decoder is in *HWC* layout.
+
+Supported formats: JPG, BMP, PNG, TIFF, PNM, PPM, PGM, PBM, JPEG 2000, WebP.
+
+.. note::
+  This operator is available only with the ``mixed`` backend.
+
+.. note::
+  EXIF orientation metadata is disregarded.)code")
+  .NumInput(1)
+  .OutputFn([](const OpSpec &spec) {
+    return spec.GetArgument<int>("num_crops");
+  })
+  .AddOptionalArg("num_crops", R"code(Number of crops produced from each image.)code", 2)
+  .AddArg("size", R"code(The size of the resized crops, as ``(height, width)``.
+
+If a single value is given, it is used for both dimensions.)code", DALI_INT_VEC)
+  .AddParent("ImageDecoderAttr")
+  .AddParent("RandomCropAttr")
+  .AddParent("ResamplingFilterAttr");
+
+
 DALI_SCHEMA(decoders__ImageSlice)
   .DocStr(R"code(Decodes images and extracts regions of interest.
 
@@ -312,6 +394,7 @@ DALI_SCHEMA(ImageDecoder)
     .DocStr("Legacy alias for :meth:`decoders.image`.")
     .NumInput(1)
     .NumOutput(1)
+    .Deterministic()
     .AddParent("decoders__Image")
     .MakeDocPartiallyHidden()
     .Deprecate(
@@ -326,6 +409,7 @@ DALI_SCHEMA(ImageDecoderCrop)
     .DocStr("Legacy alias for :meth:`decoders.image_crop`.")
     .NumInput(1)
     .NumOutput(1)
+    .Deterministic()
     .AddParent("decoders__ImageCrop")
     .MakeDocPartiallyHidden()
     .Deprecate(
@@ -0,0 +1,145 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_DECODER_NVJPEG_DECODER_LOAD_BALANCER_H_
+#define DALI_OPERATORS_DECODER_NVJPEG_DECODER_LOAD_BALANCER_H_
+
+#include <algorithm>
+
+namespace dali {
+
+/**
+ * @brief Splits the JPEG decoding work between the HW decoder, the nvJPEG hybrid (CPU + CUDA)
+ *        decoder and the host decoder, based on the throughput measured for each of them
+ *
+ * The HW decoder works concurrently with the thread pool, which runs both the hybrid and
+ * the host decoding. After each iteration the throughput (pixels per second) of each path is
+ * updated with an exponential moving average and:
+ * - the HW decoder gets the fraction of the work proportional to its share of the total
+ *   throughput, so that both resources finish at the same time,
+ * - the fraction of the thread pool work decoded by the host decoder is moved, by a fixed step,
+ *   towards whichever of the host and hybrid decoders is faster.
+ *
+ * The loads never go below `kMinLoad`, so the throughput of every path keeps being measured.
+ */
+class DecoderLoadBalancer {
+ public:
+  enum Path {
+    kHw = 0,
+    kHybrid = 1,
+    kHost = 2,
+    kNumPaths = 3
+  };
+
+  static constexpr float kMinLoad = 0.05f;
+  static constexpr float kHostLoadStep = 0.05f;
+
+  /**
+   * @param hw_load        the initial fraction of the HW-capable samples for the HW decoder;
+   *                       0 if there's no HW decoder
+   * @param num_threads    the number of threads in the pool running the hybrid and host paths
+   * @param smoothing      the weight of the current iteration in the moving average
+   */
+  DecoderLoadBalancer(float hw_load, int num_threads, float smoothing = 0.25f)
+      : hw_available_(hw_load > 0), num_threads_(std::max(num_threads, 1)),
+        smoothing_(smoothing), hw_load_(hw_load), host_load_(kMinLoad) {}
+
+  /**
+   * @brief Records the work done by a path in the current iteration
+   *
+   * @param pixels    the number of pixels decoded
+   * @param seconds   the busy time of the path; for the thread pool paths - the total time
+   *                  of the tasks, summed over the threads
+   */
+  void Record(Path path, double pixels, double seconds) {
+    pixels_[path] += pixels;
+    seconds_[path] += seconds;
+  }
+
+  /**
+   * @brief Updates the throughput estimates with the recorded work and computes the new split
+   */
+  void Update() {
+    for (int p = 0; p < kNumPaths; p++) {
+      if (seconds_[p] > 0 && pixels_[p] > 0) {
+        double rate = pixels_[p] / seconds_[p];
+        rate_[p] = rate_[p] > 0 ? (1 - smoothing_) * rate_[p] + smoothing_ * rate : rate;
+      }
+      pixels_[p] = 0;
+      seconds_[p] = 0;
+    }
+
+    if (rate_[kHybrid] > 0 && rate_[kHost] > 0) {
+      host_load_ += rate_[kHost] > rate_[kHybrid] ? kHostLoadStep : -kHostLoadStep;
+      host_load_ = Clamp(host_load_, kMinLoad, 1 - kMinLoad);
+    }
+
+    if (hw_available_ && rate_[kHw] > 0) {
+      double pool_rate = PoolRate();
+      if (pool_rate > 0) {
+        float load = static_cast<float>(rate_[kHw] / (rate_[kHw] + pool_rate));
+        hw_load_ = Clamp(load, kMinLoad, 1.0f);
+      }
+    }
+  }
+
+  /**
+   * @brief The fraction of the HW-capable samples to be decoded by the HW decoder
+   */
+  float hw_load() const noexcept {
+    return hw_load_;
+  }
+
+  /**
+   * @brief The fraction of the samples decodable with nvJPEG, not assigned to the HW decoder,
+   *        to be decoded by the host decoder
+   */
+  float host_load() const noexcept {
+    return host_load_;
+  }
+
+  /**
+   * @brief The current throughput estimate of a path, in pixels per second; 0 if it's unknown
+   */
+  double rate(Path path) const noexcept {
+    return rate_[path];
+  }
+
+ private:
+  static float Clamp(float value, float lo, float hi) {
+    return std::min(std::max(value, lo), hi);
+  }
+
+  /// the throughput of the whole thread pool with the current host/hybrid split
+  double PoolRate() const {
+    double hybrid = rate_[kHybrid], host = rate_[kHost];
+    if (hybrid <= 0 || host <= 0)
+      return (hybrid > 0 ? hybrid : host) * num_threads_;
+    // the time per pixel is the weighted average of the time per pixel of the paths
+    return num_threads_ / (host_load_ / host + (1 - host_load_) / hybrid);
+  }
+
+  bool hw_available_;
+  int num_threads_;
+  float smoothing_;
+  float hw_load_;
+  float host_load_;
+  double rate_[kNumPaths] = {};
+  double pixels_[kNumPaths] = {};
+  double seconds_[kNumPaths] = {};
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_DECODER_NVJPEG_DECODER_LOAD_BALANCER_H_
@@ -0,0 +1,75 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include "dali/operators/decoder/nvjpeg/decoder_load_balancer.h"
+
+namespace dali {
+
+namespace {
+
+/**
+ * @brief Simulates an iteration of decoding `pixels` pixels, with given throughputs
+ *        (pixels per second, per thread for the thread pool paths)
+ */
+void Simulate(DecoderLoadBalancer &balancer, double pixels, double hw_rate, double hybrid_rate,
+              double host_rate) {
+  double hw_pixels = pixels * balancer.hw_load();
+  double pool_pixels = pixels - hw_pixels;
+  double host_pixels = pool_pixels * balancer.host_load();
+  double hybrid_pixels = pool_pixels - host_pixels;
+  if (hw_rate > 0)
+    balancer.Record(DecoderLoadBalancer::kHw, hw_pixels, hw_pixels / hw_rate);
+  balancer.Record(DecoderLoadBalancer::kHybrid, hybrid_pixels, hybrid_pixels / hybrid_rate);
+  balancer.Record(DecoderLoadBalancer::kHost, host_pixels, host_pixels / host_rate);
+  balancer.Update();
+}
+
+}  // namespace
+
+TEST(DecoderLoadBalancer, ConvergesToEqualFinishTimes) {
+  const int num_threads = 4;
+  DecoderLoadBalancer balancer(0.65f, num_threads);
+  // the HW decoder is as fast as 4 threads running the hybrid decoder; the host one is slower
+  for (int i = 0; i < 100; i++)
+    Simulate(balancer, 1e8, 400, 100, 50);
+  EXPECT_NEAR(balancer.host_load(), DecoderLoadBalancer::kMinLoad, 1e-6);
+  double pool_rate = num_threads / (balancer.host_load() / 50 + (1 - balancer.host_load()) / 100);
+  EXPECT_NEAR(balancer.hw_load(), 400 / (400 + pool_rate), 1e-3);
+
+  // the HW decoder gets busy
+  for (int i = 0; i < 100; i++)
+    Simulate(balancer, 1e8, 40, 100, 50);
+  EXPECT_LT(balancer.hw_load(), 0.15f);
+  EXPECT_GE(balancer.hw_load(), 0.049f);
+}
+
+TEST(DecoderLoadBalancer, HostDecoderFaster) {
+  DecoderLoadBalancer balancer(0, 8);
+  for (int i = 0; i < 100; i++)
+    Simulate(balancer, 1e7, 0, 50, 100);
+  EXPECT_EQ(balancer.hw_load(), 0);  // no HW decoder
+  EXPECT_NEAR(balancer.host_load(), 1 - DecoderLoadBalancer::kMinLoad, 1e-6);
+  EXPECT_NEAR(balancer.rate(DecoderLoadBalancer::kHost), 100, 1e-6);
+}
+
+TEST(DecoderLoadBalancer, NoMeasurements) {
+  DecoderLoadBalancer balancer(0.5f, 8);
+  balancer.Update();
+  EXPECT_EQ(balancer.hw_load(), 0.5f);
+  EXPECT_FLOAT_EQ(balancer.host_load(), DecoderLoadBalancer::kMinLoad);
+  EXPECT_EQ(balancer.rate(DecoderLoadBalancer::kHybrid), 0);
+}
+
+}  // namespace dali
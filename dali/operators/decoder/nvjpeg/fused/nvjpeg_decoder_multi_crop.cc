@@ -0,0 +1,160 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/decoder/nvjpeg/fused/nvjpeg_decoder_multi_crop.h"
+#include <algorithm>
+#include <iostream>
+#include "dali/core/static_switch.h"
+#include "dali/kernels/imgproc/resample.h"
+
+namespace dali {
+
+nvJPEGDecoderMultiCrop::nvJPEGDecoderMultiCrop(const OpSpec& spec)
+    : nvJPEGDecoder(spec)
+    , RandomCropAttr(spec)
+    , num_crops_(spec.GetArgument<int>("num_crops"))
+    , minibatch_size_(spec.GetArgument<int>("minibatch_size")) {
+  DALI_ENFORCE(num_crops_ > 0, make_string("The number of crops must be positive, got: ",
+                                           num_crops_));
+  DALI_ENFORCE(minibatch_size_ > 0, "``minibatch_size`` must be positive");
+  DALI_ENFORCE(!yuv420_output_, "The resized crops can't be produced in YUV420.");
+  GetSingleOrRepeatedArg(spec, size_, "size", 2);
+  DALI_ENFORCE(size_[0] > 0 && size_[1] > 0, "The output size must be positive");
+  if (spec.HasArgument("dtype"))
+    output_type_ = spec.GetArgument<DALIDataType>("dtype");
+  DALI_ENFORCE(output_type_ == DALI_UINT8 || output_type_ == DALI_FLOAT,
+               make_string("Unsupported output type: ", output_type_,
+                           ". Supported types are: UINT8, FLOAT."));
+  crops_.resize(max_batch_size_, std::vector<CropWindow>(num_crops_));
+  union_windows_.resize(max_batch_size_);
+  resize_event_ = CUDAEvent::Create(device_id_);
+}
+
+nvJPEGDecoderMultiCrop::~nvJPEGDecoderMultiCrop() {
+  try {
+    if (resize_event_)
+      CUDA_CALL(cudaEventSynchronize(resize_event_));
+  } catch (const std::exception &e) {
+    std::cerr << "Fatal error: exception in ~nvJPEGDecoderMultiCrop():\n" << e.what()
+              << std::endl;
+    std::terminate();
+  }
+}
+
+CropWindowGenerator nvJPEGDecoderMultiCrop::GetCropWindowGenerator(int data_idx) const {
+  const auto &generator = RandomCropAttr::GetCropWindowGenerator(data_idx);
+  return [this, &generator, data_idx](const TensorShape<> &shape, const TensorLayout &layout) {
+    auto &crops = crops_[data_idx];
+    CropWindow window;
+    for (int k = 0; k < num_crops_; k++) {
+      crops[k] = generator(shape, layout);
+      crops[k].EnforceInRange(shape);
+      if (k == 0) {
+        window = crops[k];
+        continue;
+      }
+      for (int d = 0; d < 2; d++) {
+        int64_t end = std::max(window.anchor[d] + window.shape[d],
+                               crops[k].anchor[d] + crops[k].shape[d]);
+        window.anchor[d] = std::min(window.anchor[d], crops[k].anchor[d]);
+        window.shape[d] = end - window.anchor[d];
+      }
+    }
+    union_windows_[data_idx] = window;
+    return window;
+  };
+}
+
+bool nvJPEGDecoderMultiCrop::SetupImpl(std::vector<OutputDesc> &output_desc,
+                                       const MixedWorkspace &ws) {
+  resampling_attr_.PrepareFilterParams(spec_, ws, ws.GetInputBatchSize(0));
+  return nvJPEGDecoder::SetupImpl(output_desc, ws);
+}
+
+void nvJPEGDecoderMultiCrop::Run(MixedWorkspace &ws) {
+  // the previous iteration may still be resizing from the decoded images
+  CUDA_CALL(cudaEventSynchronize(resize_event_));
+  nvJPEGDecoder::Run(ws);
+  TYPE_SWITCH(output_type_, type2id, Out, (uint8_t, float), (
+    ResizeCrops<Out>(ws);
+  ), DALI_FAIL(make_string("Unsupported output type: ", output_type_)));  // NOLINT
+  CUDA_CALL(cudaEventRecord(resize_event_, ws.stream()));
+}
+
+template <typename Out>
+void nvJPEGDecoderMultiCrop::ResizeCrops(MixedWorkspace &ws) {
+  using Kernel = kernels::ResampleGPU<Out, uint8_t, 2>;
+  const int batch_size = decoded_.ntensor();
+  const int total = batch_size * num_crops_;
+
+  // the crops are ordered crop-major, so that the filters can be applied to each crop's batch
+  std::vector<kernels::ResamplingParams2D> params(total);
+  for (int k = 0; k < num_crops_; k++) {
+    for (int i = 0; i < batch_size; i++) {
+      auto &p = params[k * batch_size + i];
+      const auto &crop = crops_[i][k];
+      const auto &window = union_windows_[i];
+      for (int d = 0; d < 2; d++) {
+        int64_t start = crop.anchor[d] - window.anchor[d];
+        p[d].roi = kernels::ResamplingParams::ROI(start, start + crop.shape[d]);
+        p[d].output_size = size_[d];
+      }
+    }
+    resampling_attr_.ApplyFilterParams(make_span(&params[k * batch_size], batch_size));
+  }
+
+  auto decoded = view<const uint8_t, 3>(decoded_);
+  kernels::TensorListView<StorageGPU, const uint8_t, 3> in;
+  kernels::TensorListView<StorageGPU, Out, 3> out;
+  in.resize(total);
+  out.resize(total);
+  for (int k = 0; k < num_crops_; k++) {
+    auto &output = ws.OutputRef<GPUBackend>(k);
+    TensorListShape<3> out_shape(batch_size);
+    for (int i = 0; i < batch_size; i++)
+      out_shape.set_tensor_shape(i, {size_[0], size_[1], decoded.shape[i][2]});
+    output.set_type(TypeTable::GetTypeInfo(type2id<Out>::value));
+    output.Resize(out_shape);
+    output.SetLayout("HWC");
+    auto out_view = view<Out, 3>(output);
+    for (int i = 0; i < batch_size; i++) {
+      int j = k * batch_size + i;
+      in.data[j] = decoded.data[i];
+      in.shape.set_tensor_shape(j, decoded.shape[i]);
+      out.data[j] = out_view.data[i];
+      out.shape.set_tensor_shape(j, out_view.shape[i]);
+    }
+  }
+
+  int num_minibatches = div_ceil(total, minibatch_size_);
+  if (static_cast<int>(kmgr_.NumInstances()) < num_minibatches)
+    kmgr_.Resize<Kernel>(1, num_minibatches);
+  kernels::KernelContext ctx;
+  ctx.gpu.stream = ws.stream();
+  for (int b = 0; b < num_minibatches; b++) {
+    int start = b * total / num_minibatches;
+    int end = (b + 1) * total / num_minibatches;
+    kernels::TensorListView<StorageGPU, const uint8_t, 3> mb_in;
+    kernels::TensorListView<StorageGPU, Out, 3> mb_out;
+    sample_range(mb_in, in, start, end);
+    sample_range(mb_out, out, start, end);
+    auto mb_params = make_span(&params[start], end - start);
+    kmgr_.Setup<Kernel>(b, ctx, mb_in, mb_params);
+    kmgr_.Run<Kernel>(0, b, ctx, mb_out, mb_in, mb_params);
+  }
+}
+
+DALI_REGISTER_OPERATOR(decoders__ImageMultiCrop, nvJPEGDecoderMultiCrop, Mixed);
+
+}  // namespace dali
@@ -0,0 +1,86 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_DECODER_NVJPEG_FUSED_NVJPEG_DECODER_MULTI_CROP_H_
+#define DALI_OPERATORS_DECODER_NVJPEG_FUSED_NVJPEG_DECODER_MULTI_CROP_H_
+
+#include <vector>
+#include "dali/core/cuda_event.h"
+#include "dali/kernels/imgproc/resample/params.h"
+#include "dali/kernels/kernel_manager.h"
+#include "dali/operators/decoder/nvjpeg/nvjpeg_decoder_decoupled_api.h"
+#include "dali/operators/image/crop/random_crop_attr.h"
+#include "dali/operators/image/resize/resampling_attr.h"
+
+namespace dali {
+
+/**
+ * @brief Decodes the images once and produces `num_crops` random crops of each of them,
+ *        resized to `size`
+ *
+ * Only the union of the crop windows is decoded. The crops are then resized from it,
+ * all of them in one batch of the resampling kernel.
+ */
+class nvJPEGDecoderMultiCrop : public nvJPEGDecoder, public RandomCropAttr {
+ public:
+  explicit nvJPEGDecoderMultiCrop(const OpSpec& spec);
+
+  ~nvJPEGDecoderMultiCrop() override;
+
+  DISABLE_COPY_MOVE_ASSIGN(nvJPEGDecoderMultiCrop);
+
+  using nvJPEGDecoder::Run;
+  void Run(MixedWorkspace &ws) override;
+
+ protected:
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const MixedWorkspace &ws) override;
+
+  /**
+   * @brief Generates the crop windows of the sample and returns their union as the ROI
+   *        to decode
+   */
+  CropWindowGenerator GetCropWindowGenerator(int data_idx) const override;
+
+  TensorList<GPUBackend> &DecodeOutput(MixedWorkspace &ws) override {
+    return decoded_;
+  }
+
+ private:
+  /**
+   * @brief Resizes the crops from the decoded union windows to the outputs
+   */
+  template <typename Out>
+  void ResizeCrops(MixedWorkspace &ws);
+
+  int num_crops_;
+  std::vector<int> size_;
+  DALIDataType output_type_ = DALI_UINT8;
+  int minibatch_size_ = 32;
+  ResamplingFilterAttr resampling_attr_;
+
+  /// the crop windows, [data_idx][crop]; filled during the parsing, by the crop window generator
+  mutable std::vector<std::vector<CropWindow>> crops_;
+  /// the union of the crop windows of each sample
+  mutable std::vector<CropWindow> union_windows_;
+
+  /// the decoded unions of the crop windows
+  TensorList<GPUBackend> decoded_;
+  /// recorded after the crops are resized, when `decoded_` can be reused
+  CUDAEvent resize_event_;
+  kernels::KernelManager kmgr_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_DECODER_NVJPEG_FUSED_NVJPEG_DECODER_MULTI_CROP_H_
@@ -24,6 +24,13 @@
 #include "dali/core/unique_handle.h"
 #include "dali/core/format.h"
 
+// Decoding of selected tiles (and areas within them) was introduced in nvJPEG2K 0.2
+#if defined(NVJPEG2K_VER_MAJOR) && (NVJPEG2K_VER_MAJOR > 0 || NVJPEG2K_VER_MINOR >= 2)
+#define NVJPEG2K_TILE_DECODE_ENABLED 1
+#else
+#define NVJPEG2K_TILE_DECODE_ENABLED 0
+#endif
+
 namespace dali {
 
 #define NVJPEG2K_CALL(code)                             \
@@ -96,6 +103,24 @@ struct NvJPEG2KDecodeState : public UniqueHandle<nvjpeg2kDecodeState_t, NvJPEG2K
   }
 };
 
+#if NVJPEG2K_TILE_DECODE_ENABLED
+struct NvJPEG2KDecodeParams : public UniqueHandle<nvjpeg2kDecodeParams_t, NvJPEG2KDecodeParams> {
+  DALI_INHERIT_UNIQUE_HANDLE(nvjpeg2kDecodeParams_t, NvJPEG2KDecodeParams);
+
+  static NvJPEG2KDecodeParams Create() {
+    nvjpeg2kDecodeParams_t handle{};
+    NVJPEG2K_CALL(nvjpeg2kDecodeParamsCreate(&handle));
+    return NvJPEG2KDecodeParams(handle);
+  }
+
+  static constexpr nvjpeg2kDecodeParams_t null_handle() { return nullptr; }
+
+  static void DestroyHandle(nvjpeg2kDecodeParams_t handle) {
+    nvjpeg2kDecodeParamsDestroy(handle);
+  }
+};
+#endif  // NVJPEG2K_TILE_DECODE_ENABLED
+
 }  // namespace dali
 
 #endif  // NVJPEG2K_ENABLED
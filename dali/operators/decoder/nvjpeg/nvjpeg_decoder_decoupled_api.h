@@ -16,6 +16,7 @@
 #define DALI_OPERATORS_DECODER_NVJPEG_NVJPEG_DECODER_DECOUPLED_API_H_
 
 #include <nvjpeg.h>
+#include <algorithm>
 #include <functional>
 #include <string>
 #include <utility>
@@ -23,30 +24,32 @@
 #include <memory>
 #include <numeric>
 #include <atomic>
+#include <chrono>
+#include <deque>
 #include "dali/pipeline/operator/operator.h"
 #include "dali/operators/decoder/nvjpeg/nvjpeg_helper.h"
 #include "dali/operators/decoder/nvjpeg/nvjpeg_memory.h"
+#include "dali/operators/decoder/nvjpeg/nvjpeg_shared_handle.h"
 #include "dali/operators/decoder/nvjpeg/nvjpeg2k_helper.h"
 #include "dali/operators/decoder/cache/cached_decoder_impl.h"
+#include "dali/operators/decoder/cache/image_info_cache.h"
 #include "dali/core/mm/memory.h"
 #include "dali/util/image.h"
 #include "dali/util/ocv.h"
 #include "dali/util/npp.h"
 #include "dali/util/nvml.h"
 #include "dali/image/image_factory.h"
+#include "dali/image/jpeg.h"
 #include "dali/pipeline/util/thread_pool.h"
 #include "dali/core/device_guard.h"
 #include "dali/core/dev_buffer.h"
+#include "dali/core/util.h"
 #include "dali/core/static_switch.h"
+#include "dali/operators/decoder/nvjpeg/decoder_load_balancer.h"
 #include "dali/operators/decoder/nvjpeg/permute_layout.h"
-
-#if NVJPEG_VER_MAJOR > 11 || \
-    (NVJPEG_VER_MAJOR == 11 && (NVJPEG_VER_MINOR > 4 || \
-                               (NVJPEG_VER_MINOR == 4 && NVJPEG_VER_PATCH >= 1)))
-  #define IS_HW_DECODER_COMPATIBLE 1
-#else
-  #define IS_HW_DECODER_COMPATIBLE 0
-#endif
+#include "dali/operators/decoder/nvjpeg/raster_image.h"
+#include "dali/operators/decoder/nvjpeg/raster_reconstruct.h"
+#include "dali/kernels/imgproc/color_manipulation/yuv420.h"
 
 namespace dali {
 
@@ -57,7 +60,10 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
   explicit nvJPEGDecoder(const OpSpec& spec) :
     Operator<MixedBackend>(spec),
     CachedDecoderImpl(spec),
-    output_image_type_(spec.GetArgument<DALIImageType>("output_type")),
+    // YUV420 images are decoded to RGB and converted at the end of the batch
+    output_image_type_(spec.GetArgument<DALIImageType>("output_type") == DALI_YUV420
+                       ? DALI_RGB : spec.GetArgument<DALIImageType>("output_type")),
+    yuv420_output_(spec.GetArgument<DALIImageType>("output_type") == DALI_YUV420),
     hybrid_huffman_threshold_(spec.GetArgument<unsigned int>("hybrid_huffman_threshold")),
     use_fast_idct_(spec.GetArgument<bool>("use_fast_idct")),
     output_shape_(max_batch_size_, kOutputDim),
@@ -68,7 +74,6 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
     hw_decoder_jpeg_streams_(num_threads_),
 #endif
 #if NVJPEG2K_ENABLED
-    nvjpeg2k_intermediate_buffer_(),
     nvjpeg2k_dev_alloc_(nvjpeg_memory::GetDeviceAllocatorNvJpeg2k()),
     nvjpeg2k_pin_alloc_(nvjpeg_memory::GetPinnedAllocatorNvJpeg2k()),
     nvjpeg2k_streams_(max_batch_size_),
@@ -83,9 +88,11 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
     thread_pool_(num_threads_,
                  spec.GetArgument<int>("device_id"),
                  spec.GetArgument<bool>("affine") /* pin threads */),
-    nvjpeg2k_thread_(1,
+    num_threads_jpeg2k_(spec.GetArgument<int>("num_threads_jpeg2k")),
+    nvjpeg2k_thread_(num_threads_jpeg2k_,
                      spec.GetArgument<int>("device_id"),
                      spec.GetArgument<bool>("affine")) {
+    DALI_ENFORCE(num_threads_jpeg2k_ > 0, "`num_threads_jpeg2k` must be positive.");
 #if IS_HW_DECODER_COMPATIBLE
     // if hw_decoder_load is not present in the schema (crop/sliceDecoder) then it is not supported
     bool try_init_hw_decoder = false;
@@ -96,8 +103,10 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
       hw_decoder_load_ = 0;
     }
 
+    // the handles (and the memory pool of the HW decoder) are shared by the decoders of
+    // all the pipelines in the process
     if (try_init_hw_decoder &&
-        nvjpegCreate(NVJPEG_BACKEND_HARDWARE, NULL, &handle_) == NVJPEG_STATUS_SUCCESS) {
+        (shared_handle_ = NvjpegSharedHandle::Get(device_id_, true)) != nullptr) {
     // disable HW decoder for drivers < 455.x as the memory pool for it is not available
     // and multi GPU performance is far from perfect due to frequent memory allocations
 #if NVML_ENABLED
@@ -106,15 +115,14 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
       if (driverVersion < 455) {
         try_init_hw_decoder = false,
         hw_decoder_load_ = 0;
-        NVJPEG_CALL(nvjpegDestroy(handle_));
+        shared_handle_.reset();
         LOG_LINE << "NVJPEG_BACKEND_HARDWARE is disabled due to performance reason" << std::endl;
-        NVJPEG_CALL(nvjpegCreateSimple(&handle_));
+        shared_handle_ = NvjpegSharedHandle::Get(device_id_, false);
         DALI_WARN("Due to performance reason HW NVJPEG decoder is disbaled for the driver "
                   "older than 455.x");
       } else {
 #endif
         LOG_LINE << "Using NVJPEG_BACKEND_HARDWARE" << std::endl;
-        NVJPEG_CALL(nvjpegJpegStateCreate(handle_, &state_hw_batched_));
         hw_decoder_images_staging_.set_pinned(true);
         hw_decoder_images_staging_.SetGrowthFactor(2);
         // assume close the worst case size 300kb per image
@@ -139,14 +147,12 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
         // when such value is provided
         preallocate_width_hint = preallocate_width_hint ? preallocate_width_hint : 1;
         preallocate_height_hint = preallocate_height_hint ? preallocate_height_hint : 1;
-        NVJPEG_CALL(nvjpegDecodeBatchedPreAllocate(
-          handle_,
-          state_hw_batched_,
+        // the pool is shared - it grows to fit the batches of all the decoders
+        shared_handle_->PreallocateHw(
           CalcHwDecoderBatchSize(hw_decoder_load_, max_batch_size_),
           preallocate_width_hint,
           preallocate_height_hint,
-          NVJPEG_CSS_444,
-          GetFormat(output_image_type_)));
+          GetFormat(output_image_type_));
 #endif
         using_hw_decoder_ = true;
         in_data_.reserve(max_batch_size_);
@@ -158,18 +164,18 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
 #endif
     } else {
       LOG_LINE << "NVJPEG_BACKEND_HARDWARE is either disabled or not supported" << std::endl;
-      NVJPEG_CALL(nvjpegCreateSimple(&handle_));
+      shared_handle_ = NvjpegSharedHandle::Get(device_id_, false);
     }
 #else
-    NVJPEG_CALL(nvjpegCreateSimple(&handle_));
+    shared_handle_ = NvjpegSharedHandle::Get(device_id_, false);
 #endif
+    handle_ = shared_handle_->get();
 
     size_t device_memory_padding = spec.GetArgument<Index>("device_memory_padding");
     size_t host_memory_padding = spec.GetArgument<Index>("host_memory_padding");
     size_t device_memory_padding_jpeg2k = spec.GetArgument<Index>("device_memory_padding_jpeg2k");
     size_t host_memory_padding_jpeg2k = spec.GetArgument<Index>("host_memory_padding_jpeg2k");
-    NVJPEG_CALL(nvjpegSetDeviceMemoryPadding(device_memory_padding, handle_));
-    NVJPEG_CALL(nvjpegSetPinnedMemoryPadding(host_memory_padding, handle_));
+    shared_handle_->SetMemoryPadding(device_memory_padding, host_memory_padding);
 
     nvjpegDevAllocator_t *device_allocator_ptr = &device_allocator_;
     nvjpegPinnedAllocator_t *pinned_allocator_ptr = &pinned_allocator_;
@@ -215,11 +221,28 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
 
     CUDA_CALL(cudaEventCreate(&hw_decode_event_));
     CUDA_CALL(cudaEventRecord(hw_decode_event_, hw_decode_stream_));
+    CUDA_CALL(cudaEventCreate(&raster_event_));
+    CUDA_CALL(cudaEventCreate(&yuv420_event_));
+
+    adaptive_load_balancing_ = spec.GetArgument<bool>("adaptive_load_balancing");
+    if (adaptive_load_balancing_) {
+      load_balancer_ = DecoderLoadBalancer(using_hw_decoder_ ? hw_decoder_load_ : 0.f,
+                                           num_threads_);
+      CUDA_CALL(cudaEventCreate(&hw_timing_start_event_));
+      CUDA_CALL(cudaEventCreate(&hw_timing_end_event_));
+    }
+    current_hw_load_ = using_hw_decoder_ ? hw_decoder_load_ : 0.f;
+
+    // only the plain (non-cropping) decoders accept the hint
+    if (spec.GetSchema().HasArgument("downscale_hint"))
+      downscale_hint_ = spec.GetRepeatedArgument<int>("downscale_hint");
+    DALI_ENFORCE(downscale_hint_.empty() || downscale_hint_.size() == 2,
+                 "`downscale_hint` must be empty or consist of two values: height and width.");
 
 #if NVJPEG2K_ENABLED
-    auto nvjpeg2k_thread_id = nvjpeg2k_thread_.GetThreadIds()[0];
-    nvjpeg2k_thread_.AddWork([this, device_memory_padding_jpeg2k, host_memory_padding_jpeg2k,
-                              nvjpeg2k_thread_id](int) {
+    nvjpeg2k_ctx_.resize(num_threads_jpeg2k_);
+    nvjpeg2k_thread_.AddWork([this, device_memory_padding_jpeg2k,
+                              host_memory_padding_jpeg2k](int) {
       nvjpeg2k_handle_ = NvJPEG2KHandle(&nvjpeg2k_dev_alloc_, &nvjpeg2k_pin_alloc_);
 
       // nvJPEG2k doesn't support deprecated sm while DALI does. In this case, NvJPEG2KHandle may
@@ -227,30 +250,41 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
       if (!nvjpeg2k_handle_) {
         return;
       }
-      if (device_memory_padding_jpeg2k > 0) {
-        // Adding smaller buffers that are allocated by nvjpeg2k on startup.
-        // The sizes were obtained empirically.
-        nvjpeg_memory::AddBuffer<mm::memory_kind::device>(nvjpeg2k_thread_id, 1024);
-        nvjpeg_memory::AddBuffer<mm::memory_kind::device>(nvjpeg2k_thread_id, 4 * 1024);
-        nvjpeg_memory::AddBuffer<mm::memory_kind::device>(nvjpeg2k_thread_id, 16 * 1024);
-        nvjpeg2k_intermediate_buffer_.resize(device_memory_padding_jpeg2k / 8);
-        nvjpeg_memory::AddBuffer<mm::memory_kind::device>(nvjpeg2k_thread_id,
-                                 device_memory_padding_jpeg2k);
-        nvjpeg_memory::AddBuffer<mm::memory_kind::device>(nvjpeg2k_thread_id,
-                                 device_memory_padding_jpeg2k);
+      // the buffers are kept per thread, each thread decodes with its own context
+      for (auto nvjpeg2k_thread_id : nvjpeg2k_thread_.GetThreadIds()) {
+        if (device_memory_padding_jpeg2k > 0) {
+          // Adding smaller buffers that are allocated by nvjpeg2k on startup.
+          // The sizes were obtained empirically.
+          nvjpeg_memory::AddBuffer<mm::memory_kind::device>(nvjpeg2k_thread_id, 1024);
+          nvjpeg_memory::AddBuffer<mm::memory_kind::device>(nvjpeg2k_thread_id, 4 * 1024);
+          nvjpeg_memory::AddBuffer<mm::memory_kind::device>(nvjpeg2k_thread_id, 16 * 1024);
+          nvjpeg_memory::AddBuffer<mm::memory_kind::device>(nvjpeg2k_thread_id,
+                                   device_memory_padding_jpeg2k);
+          nvjpeg_memory::AddBuffer<mm::memory_kind::device>(nvjpeg2k_thread_id,
+                                   device_memory_padding_jpeg2k);
+        }
+        if (host_memory_padding_jpeg2k > 0) {
+          nvjpeg_memory::AddBuffer<mm::memory_kind::pinned>(nvjpeg2k_thread_id,
+                                   host_memory_padding_jpeg2k);
+        }
       }
-      if (host_memory_padding_jpeg2k > 0) {
-        nvjpeg_memory::AddBuffer<mm::memory_kind::pinned>(nvjpeg2k_thread_id,
-                                 host_memory_padding_jpeg2k);
+      for (auto &ctx : nvjpeg2k_ctx_) {
+        if (device_memory_padding_jpeg2k > 0)
+          ctx.intermediate_buffer.resize(device_memory_padding_jpeg2k / 8);
+        ctx.decoder = NvJPEG2KDecodeState(nvjpeg2k_handle_);
+#if NVJPEG2K_TILE_DECODE_ENABLED
+        ctx.decode_params = NvJPEG2KDecodeParams::Create();
+#endif  // NVJPEG2K_TILE_DECODE_ENABLED
       }
-      nvjpeg2k_decoder_ = NvJPEG2KDecodeState(nvjpeg2k_handle_);
     });
     nvjpeg2k_thread_.RunAll();
 
-    CUDA_CALL(cudaStreamCreateWithPriority(&nvjpeg2k_cu_stream_, cudaStreamNonBlocking,
-                                           default_cuda_stream_priority_));
-    CUDA_CALL(cudaEventCreate(&nvjpeg2k_decode_event_));
-    CUDA_CALL(cudaEventRecord(nvjpeg2k_decode_event_, nvjpeg2k_cu_stream_));
+    for (auto &ctx : nvjpeg2k_ctx_) {
+      CUDA_CALL(cudaStreamCreateWithPriority(&ctx.cu_stream, cudaStreamNonBlocking,
+                                             default_cuda_stream_priority_));
+      CUDA_CALL(cudaEventCreate(&ctx.decode_event));
+      CUDA_CALL(cudaEventRecord(ctx.decode_event, ctx.cu_stream));
+    }
 
     for (auto &stream : nvjpeg2k_streams_) {
       stream = NvJPEG2KStream::Create();
@@ -260,6 +294,8 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
     ReserveSampleContainers();
 
     RegisterTestCounters();
+    RegisterDiagnostic("hw_decoder_load", &current_hw_load_);
+    RegisterDiagnostic("host_decoder_load", &current_host_load_);
   }
 
   ~nvJPEGDecoder() override {
@@ -293,13 +329,23 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
         CUDA_CALL(cudaEventDestroy(event));
       }
       CUDA_CALL(cudaEventDestroy(hw_decode_event_));
+      CUDA_CALL(cudaEventSynchronize(raster_event_));
+      CUDA_CALL(cudaEventDestroy(raster_event_));
+      CUDA_CALL(cudaEventSynchronize(yuv420_event_));
+      CUDA_CALL(cudaEventDestroy(yuv420_event_));
+      if (hw_timing_start_event_) {
+        CUDA_CALL(cudaEventDestroy(hw_timing_start_event_));
+      }
+      if (hw_timing_end_event_) {
+        CUDA_CALL(cudaEventDestroy(hw_timing_end_event_));
+      }
 
       for (auto &stream : streams_) {
         CUDA_CALL(cudaStreamDestroy(stream));
       }
       CUDA_CALL(cudaStreamDestroy(hw_decode_stream_));
 
-      NVJPEG_CALL(nvjpegDestroy(handle_));
+      shared_handle_.reset();
 
       // Free any remaining buffers and remove the thread entry from the global map
       for (auto thread_id : thread_pool_.GetThreadIds()) {
@@ -307,8 +353,12 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
       }
 
 #if NVJPEG2K_ENABLED
-      CUDA_CALL(cudaEventDestroy(nvjpeg2k_decode_event_));
-      CUDA_CALL(cudaStreamDestroy(nvjpeg2k_cu_stream_));
+      for (auto &ctx : nvjpeg2k_ctx_) {
+        if (ctx.decode_event)
+          CUDA_CALL(cudaEventDestroy(ctx.decode_event));
+        if (ctx.cu_stream)
+          CUDA_CALL(cudaStreamDestroy(ctx.cu_stream));
+      }
       for (auto thread_id : nvjpeg2k_thread_.GetThreadIds()) {
         nvjpeg_memory::DeleteAllBuffers(thread_id);
       }
@@ -324,7 +374,9 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
 
   bool SetupImpl(std::vector<OutputDesc> &output_desc, const MixedWorkspace &ws) override {
     auto curr_batch_size = ws.GetInputBatchSize(0);
-    hw_decoder_bs_ = CalcHwDecoderBatchSize(hw_decoder_load_, curr_batch_size);
+    if (adaptive_load_balancing_ && using_hw_decoder_)
+      current_hw_load_ = load_balancer_.hw_load();
+    hw_decoder_bs_ = CalcHwDecoderBatchSize(current_hw_load_, curr_batch_size);
     return false;
   }
 
@@ -332,7 +384,13 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
   void Run(MixedWorkspace &ws) override {
     SetupSharedSampleParams(ws);
     ParseImagesInfo(ws);
+    if (yuv420_output_) {
+      // the previous iteration may still be converting from the decoded images
+      CUDA_CALL(cudaEventSynchronize(yuv420_event_));
+    }
     ProcessImages(ws);
+    if (yuv420_output_)
+      ConvertToYUV420(ws);
   }
 
  protected:
@@ -340,6 +398,37 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
     return {};
   }
 
+  /**
+   * @brief The tensor list the images are decoded to - the operator's output, unless
+   *        the decoded images are processed further
+   */
+  virtual TensorList<GPUBackend> &DecodeOutput(MixedWorkspace &ws) {
+    return yuv420_output_ ? rgb_decoded_ : ws.OutputRef<GPUBackend>(0);
+  }
+
+  /**
+   * @brief Converts the images decoded to RGB to the planar YUV 4:2:0 output
+   */
+  void ConvertToYUV420(MixedWorkspace &ws) {
+    auto &output = ws.OutputRef<GPUBackend>(0);
+    int nsamples = output_shape_.num_samples();
+    TensorListShape<> yuv_shape(nsamples, 2);
+    for (int i = 0; i < nsamples; i++) {
+      kernels::color::YUV420Layout layout{output_shape_[i][0], output_shape_[i][1]};
+      yuv_shape.set_tensor_shape(i, layout.shape());
+    }
+    output.set_type<uint8_t>();
+    output.Resize(yuv_shape);
+    output.SetLayout("HW");
+    for (int i = 0; i < nsamples; i++) {
+      kernels::color::YUV420Layout layout{output_shape_[i][0], output_shape_[i][1]};
+      kernels::color::RunYUV420ConversionKernel(
+          output.mutable_tensor<uint8_t>(i), rgb_decoded_.tensor<uint8_t>(i), DALI_YUV420,
+          DALI_RGB, layout, ws.stream());
+    }
+    CUDA_CALL(cudaEventRecord(yuv420_event_, ws.stream()));
+  }
+
   enum class DecodeMethod {
     Host,
     NvjpegCuda,
@@ -348,6 +437,8 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
     Nvjpeg2k,
 #endif  // NVJPEG2K_ENABLED
     Cache,
+    /// PNG and TIFF images, decompressed on the host and reconstructed on the GPU
+    Raster,
   };
 
   struct DecoderData {
@@ -365,6 +456,24 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
     int bpp = 8;  // currently used for jpeg2k only
     CropWindow roi;
     DecodeMethod method = DecodeMethod::Host;
+    /// the sample could be decoded with nvJPEG, but the load balancer gave it to the host decoder
+    bool balanced_to_host = false;
+    /// a progressive or lossless JPEG, which can't use the GPU Huffman decoding; such samples
+    /// are decoded first, in a queue of their own, so that they overlap with the rest of the batch
+    bool slow_path = false;
+    /// the time spent decoding the sample in the thread pool, in seconds
+    double decode_time = 0;
+    /// the HW decoder can't handle the ROI of the sample, so it decodes the whole image,
+    /// which is then cropped on the GPU
+    bool hw_crop_after_decode = false;
+    /// the DCT scaling denominator, used when the image is decoded at a reduced resolution
+    int scale_denom = 1;
+    /// the layout of a PNG or TIFF image, decoded with the raster path
+    RasterImageInfo raster;
+    /// the offset of the decompressed raster image in the staging buffer
+    size_t raster_offset = 0;
+    /// the raster image couldn't be decompressed, so it was decoded with the host decoder
+    bool raster_failed = false;
     nvjpegDecodeParams_t params;
     nvjpegChromaSubsampling_t subsampling = NVJPEG_CSS_UNKNOWN;
 
@@ -395,6 +504,13 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
       is_progressive = false;
       req_nchannels = -1;
       method = DecodeMethod::Host;
+      balanced_to_host = false;
+      slow_path = false;
+      decode_time = 0;
+      hw_crop_after_decode = false;
+      scale_denom = 1;
+      raster_offset = 0;
+      raster_failed = false;
       subsampling = NVJPEG_CSS_UNKNOWN;
     }
 
@@ -428,9 +544,9 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
   std::vector<SampleData*> samples_host_;
   std::vector<SampleData*> samples_hw_batched_;
   std::vector<SampleData*> samples_single_;
+  std::vector<SampleData*> samples_slow_path_;
   std::vector<SampleData*> samples_jpeg2k_;
-
-  nvjpegJpegState_t state_hw_batched_ = nullptr;
+  std::vector<SampleData*> samples_raster_;
 
   static int64_t subsampling_score(nvjpegChromaSubsampling_t subsampling) {
     switch (subsampling) {
@@ -498,12 +614,93 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
       }
     }
 
+    if (adaptive_load_balancing_)
+      MoveSamplesToHost();
+
     if (sort_method != SORT_METHOD_NO_SORTING) {
       std::sort(samples_single_.begin(), samples_single_.end(), sample_order);
       std::sort(samples_host_.begin(), samples_host_.end(), sample_order);
     }
   }
 
+  template <typename Shape>
+  static int64_t DecodedPixels(const Shape &output_shape) {
+    return output_shape[0] * output_shape[1];
+  }
+
+  /**
+   * @brief Gives the share of the hybrid decoder samples chosen by the load balancer
+   *        to the host decoder
+   *
+   * The smallest images are moved, as the hybrid decoder gains the least on them.
+   */
+  void MoveSamplesToHost() {
+    current_host_load_ = load_balancer_.host_load();
+    size_t n = std::lround(current_host_load_ * samples_single_.size());
+    if (n == 0)
+      return;
+    auto by_size = [&](SampleData *lhs, SampleData *rhs) {
+      return DecodedPixels(output_shape_[lhs->sample_idx]) >
+             DecodedPixels(output_shape_[rhs->sample_idx]);
+    };
+    auto first_moved = samples_single_.end() - n;
+    std::nth_element(samples_single_.begin(), first_moved, samples_single_.end(), by_size);
+    for (auto it = first_moved; it != samples_single_.end(); ++it) {
+      auto &data = **it;
+      data.method = DecodeMethod::Host;
+      data.balanced_to_host = true;
+      data.selected_decoder = nullptr;
+      samples_host_.push_back(&data);
+    }
+    samples_single_.erase(first_moved, samples_single_.end());
+  }
+
+  /**
+   * @brief Passes the throughput measured in this iteration to the load balancer
+   *
+   * The time of the HW decoder is measured with CUDA events, so it's read in the next iteration,
+   * when the events have completed.
+   */
+  void UpdateLoadBalancer() {
+    for (auto *sample : samples_single_) {
+      load_balancer_.Record(DecoderLoadBalancer::kHybrid,
+                            DecodedPixels(output_shape_[sample->sample_idx]), sample->decode_time);
+    }
+    for (auto *sample : samples_host_) {
+      if (sample->balanced_to_host) {
+        load_balancer_.Record(DecoderLoadBalancer::kHost,
+                              DecodedPixels(output_shape_[sample->sample_idx]),
+                              sample->decode_time);
+      }
+    }
+    load_balancer_.Update();
+  }
+
+  void RecordHwDecoderTime() {
+    if (hw_pending_pixels_ == 0)
+      return;
+    if (cudaEventQuery(hw_timing_end_event_) == cudaSuccess) {
+      float ms = 0;
+      CUDA_CALL(cudaEventElapsedTime(&ms, hw_timing_start_event_, hw_timing_end_event_));
+      load_balancer_.Record(DecoderLoadBalancer::kHw, hw_pending_pixels_, ms * 1e-3);
+    } else {
+      // the measurement is dropped, the events are recorded again in this iteration
+      (void) cudaGetLastError();
+    }
+    hw_pending_pixels_ = 0;
+  }
+
+  /**
+   * @brief Whether nvJPEG2K can decode only the tiles intersecting the ROI
+   */
+  static constexpr bool CanDecodeJpeg2kRoi() {
+#if NVJPEG2K_ENABLED && NVJPEG2K_TILE_DECODE_ENABLED
+    return true;
+#else
+    return false;
+#endif
+  }
+
   bool ParseNvjpeg2k(SampleData &data, span<const uint8_t> input) {
 #if NVJPEG2K_ENABLED
     if (!nvjpeg2k_handle_) {
@@ -537,6 +734,20 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
     return false;
   }
 
+  /**
+   * @brief Checks if the sample is a PNG or TIFF image, which can be reconstructed on the GPU
+   */
+  bool ParseRaster(SampleData &data, span<const uint8_t> input) {
+    // the YCbCr conversion of the host decoder isn't replicated on the GPU
+    if (output_image_type_ == DALI_YCbCr)
+      return false;
+    if (!ParseRasterImage(input.data(), input.size(), data.raster))
+      return false;
+    data.method = DecodeMethod::Raster;
+    data.shape = {data.raster.height, data.raster.width, data.raster.channels};
+    return true;
+  }
+
   void ParseImagesInfo(MixedWorkspace &ws) {
     auto curr_batch_size = ws.GetInputBatchSize(0);
     output_shape_.resize(curr_batch_size);
@@ -544,6 +755,8 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
     samples_host_.clear();
     samples_hw_batched_.clear();
     samples_single_.clear();
+    samples_slow_path_.clear();
+    samples_raster_.clear();
 #if NVJPEG2K_ENABLED
     samples_jpeg2k_.clear();
 #endif  // NVJPEG2K_ENABLED
@@ -567,23 +780,56 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
           return;
         }
 
-        int widths[NVJPEG_MAX_COMPONENT], heights[NVJPEG_MAX_COMPONENT], c;
-        nvjpegChromaSubsampling_t subsampling;
-        nvjpegStatus_t ret = nvjpegGetImageInfo(handle_, input_data, in_size, &c,
-                                                &subsampling, widths, heights);
+        // the headers are parsed once - later, the cached information is used
+        auto &info_cache = ImageInfoCache::Instance();
+        ImageHeaderInfo header_info;
+        bool header_cached = info_cache.Get(data.file_name, in_size, header_info) &&
+                             header_info.has_nvjpeg_info;
+        if (!header_cached) {
+          int widths[NVJPEG_MAX_COMPONENT], heights[NVJPEG_MAX_COMPONENT], c;
+          nvjpegChromaSubsampling_t subsampling;
+          nvjpegStatus_t ret = nvjpegGetImageInfo(handle_, input_data, in_size, &c,
+                                                  &subsampling, widths, heights);
+          header_info.has_nvjpeg_info = true;
+          header_info.nvjpeg_decodable = (ret == NVJPEG_STATUS_SUCCESS);
+          if (header_info.nvjpeg_decodable) {
+            header_info.nvjpeg_shape = {heights[0], widths[0], c};
+            header_info.subsampling = subsampling;
+            header_info.progressive = IsProgressiveJPEG(input_data, in_size);
+            header_info.lossless = IsLosslessJPEG(input_data, in_size);
+          }
+          info_cache.Update(data.file_name, in_size, [&](ImageHeaderInfo &info) {
+            info.has_nvjpeg_info = true;
+            info.nvjpeg_decodable = header_info.nvjpeg_decodable;
+            info.nvjpeg_shape = header_info.nvjpeg_shape;
+            info.subsampling = header_info.subsampling;
+            info.progressive = header_info.progressive;
+            info.lossless = header_info.lossless;
+          });
+        }
         bool hw_decode = false;
-        bool nvjpeg_decode = (ret == NVJPEG_STATUS_SUCCESS);
+        bool nvjpeg_decode = header_info.nvjpeg_decodable;
 
         auto crop_generator = GetCropWindowGenerator(i);
         if (nvjpeg_decode) {
-          data.shape = {heights[0], widths[0], c};
-          data.subsampling = subsampling;
-        } else if (crop_generator || !ParseNvjpeg2k(data,
+          data.shape = header_info.nvjpeg_shape;
+          data.subsampling = static_cast<nvjpegChromaSubsampling_t>(header_info.subsampling);
+        } else if (!crop_generator &&
+                   ParseRaster(data, span<const uint8_t>(input_data, in_size))) {
+          // decompressed in the thread pool, reconstructed on the GPU
+        } else if ((crop_generator && !CanDecodeJpeg2kRoi()) || !ParseNvjpeg2k(data,
                                                     span<const uint8_t>(input_data, in_size))) {
           try {
             data.method = DecodeMethod::Host;
-            auto image = ImageFactory::CreateImage(input_data, in_size, output_image_type_);
-            data.shape = image->PeekShape();
+            if (volume(header_info.shape) > 0) {
+              data.shape = header_info.shape;
+            } else {
+              auto image = ImageFactory::CreateImage(input_data, in_size, output_image_type_);
+              data.shape = image->PeekShape();
+              info_cache.Update(data.file_name, in_size, [&](ImageHeaderInfo &info) {
+                info.shape = data.shape.to_static<3>();
+              });
+            }
           } catch (const std::runtime_error &e) {
             DALI_FAIL(e.what() + ". File: " + data.file_name);
           }
@@ -606,16 +852,28 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
         // only when we have ROI info check if nvjpegDecodeBatchedSupportedEx supports it
         if (nvjpeg_decode) {
   #if IS_HW_DECODER_COMPATIBLE
-          if (state_hw_batched_ != nullptr) {
+          if (using_hw_decoder_) {
             // in some cases hybrid decoder can handle the image but HW decoder can't, we should not
             // error in that case
-            ret = nvjpegJpegStreamParse(handle_, input_data, in_size, false, false,
-                                        hw_decoder_jpeg_streams_[tid]);
+            auto ret = nvjpegJpegStreamParse(handle_, input_data, in_size, false, false,
+                                             hw_decoder_jpeg_streams_[tid]);
             if (ret == NVJPEG_STATUS_SUCCESS) {
               int is_supported = -1;
               NVJPEG_CALL(nvjpegDecodeBatchedSupportedEx(handle_, hw_decoder_jpeg_streams_[tid],
                                                           data.params, &is_supported));
               hw_decode = is_supported == 0;
+              if (!hw_decode && data.roi) {
+                // the HW decoder doesn't support this ROI - check if it can decode the whole image
+                NVJPEG_CALL(nvjpegDecodeParamsSetROI(data.params, 0, 0, -1, -1));
+                NVJPEG_CALL(nvjpegDecodeBatchedSupportedEx(handle_, hw_decoder_jpeg_streams_[tid],
+                                                            data.params, &is_supported));
+                hw_decode = is_supported == 0;
+                data.hw_crop_after_decode = hw_decode;
+                // the ROI is still needed if the sample goes to the hybrid decoder
+                NVJPEG_CALL(nvjpegDecodeParamsSetROI(data.params, data.roi.anchor[1],
+                                                    data.roi.anchor[0], data.roi.shape[1],
+                                                    data.roi.shape[0]));
+              }
             }
             if (!hw_decode) {
               LOG_LINE << "Sample \"" << data.file_name
@@ -625,14 +883,31 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
             }
           }
   #endif
+          if (!hw_decode && !crop_generator && !downscale_hint_.empty()) {
+            data.scale_denom = JpegScaleDenominator(data.shape[0], data.shape[1],
+                                                    downscale_hint_[0], downscale_hint_[1]);
+          }
           if (hw_decode) {
             data.method = DecodeMethod::NvjpegHw;
+          } else if (data.scale_denom > 1) {
+            // nvJPEG can't decode at a reduced resolution, while libjpeg-turbo can skip
+            // most of the IDCT work with DCT scaling
+            data.method = DecodeMethod::Host;
+            output_shape_.set_tensor_shape(i, {div_ceil(data.shape[0], data.scale_denom),
+                                               div_ceil(data.shape[1], data.scale_denom),
+                                               data.req_nchannels});
           } else {
             data.method = DecodeMethod::NvjpegCuda;
           }
+          if (!hw_decode && (header_info.progressive || header_info.lossless)) {
+            data.slow_path = true;
+            // nvJPEG doesn't support the lossless JPEGs
+            if (header_info.lossless)
+              data.method = DecodeMethod::Host;
+          }
         }
 
-        data.is_progressive = IsProgressiveJPEG(input_data, in_size);
+        data.is_progressive = header_info.progressive;
         if (data.method == DecodeMethod::NvjpegCuda) {
           int64_t sz = data.roi
             ? data.roi.shape[1] * (data.roi.anchor[0] + data.roi.shape[0])
@@ -649,6 +924,10 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
 
     for (int i = 0; i < curr_batch_size; i++) {
       SampleData &data = sample_data_[i];
+      if (data.slow_path) {
+        samples_slow_path_.push_back(&data);
+        continue;
+      }
       switch (data.method) {
         case DecodeMethod::Host:
           samples_host_.push_back(&data);
@@ -662,6 +941,9 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
         case DecodeMethod::Cache:
           samples_cache_.push_back(&data);
           break;
+        case DecodeMethod::Raster:
+          samples_raster_.push_back(&data);
+          break;
       #if NVJPEG2K_ENABLED
         case DecodeMethod::Nvjpeg2k:
           samples_jpeg2k_.push_back(&data);
@@ -678,7 +960,7 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
   }
 
   void ProcessImagesCache(MixedWorkspace &ws) {
-    auto& output = ws.Output<GPUBackend>(0);
+    auto& output = DecodeOutput(ws);
     for (auto *sample : samples_cache_) {
       assert(sample);
       auto i = sample->sample_idx;
@@ -689,7 +971,7 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
   }
 
   void ProcessImagesCuda(MixedWorkspace &ws) {
-    auto& output = ws.Output<GPUBackend>(0);
+    auto& output = DecodeOutput(ws);
     for (auto *sample : samples_single_) {
       assert(sample);
       auto i = sample->sample_idx;
@@ -697,124 +979,484 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
       const auto &in = ws.Input<CPUBackend>(0, i);
       thread_pool_.AddWork(
         [this, sample, &in, output_data](int tid) {
+          auto start = std::chrono::steady_clock::now();
           SampleWorker(sample->sample_idx, sample->file_name, in.size(), tid,
             in.data<uint8_t>(), output_data, streams_[tid]);
+          sample->decode_time = std::chrono::duration<double>(
+              std::chrono::steady_clock::now() - start).count();
         }, task_priority_seq_--);  // FIFO order, since the samples were already ordered
     }
   }
 
 #if NVJPEG2K_ENABLED
-  void DecodeJpeg2k(uint8_t* output_data, const SampleData *sample,
+  /**
+   * @brief The decoding state of a thread of nvjpeg2k_thread_; the threads decode
+   *        the JPEG 2000 images concurrently, each on its own stream
+   */
+  struct NvJPEG2KContext {
+    NvJPEG2KDecodeState decoder;
+#if NVJPEG2K_TILE_DECODE_ENABLED
+    NvJPEG2KDecodeParams decode_params;
+#endif  // NVJPEG2K_TILE_DECODE_ENABLED
+    DeviceBuffer<uint8_t> intermediate_buffer;
+    cudaStream_t cu_stream = nullptr;
+    cudaEvent_t decode_event = nullptr;
+  };
+
+  /**
+   * @brief A large image decoded by parts, on all the threads of nvjpeg2k_thread_
+   */
+  struct Jpeg2kTiledSample {
+    const SampleData *sample = nullptr;
+    uint8_t *output_data = nullptr;
+    /// the planar output of nvJPEG2K - the output itself, if it needs no conversion
+    uint8_t *decoder_out = nullptr;
+    /// nvJPEG2K can't decode the image, it's decoded with the host decoder
+    std::atomic<bool> failed{false};
+  };
+
+  /// A rectangle of a JPEG 2000 image, in pixels
+  struct Jpeg2kArea {
+    int64_t y_begin, y_end, x_begin, x_end;
+
+    int64_t height() const { return y_end - y_begin; }
+    int64_t width() const { return x_end - x_begin; }
+  };
+
+  /// The part of the image written to the output - the ROI or the whole image
+  static Jpeg2kArea Jpeg2kOutputArea(const SampleData &sample) {
+    if (sample.roi) {
+      return {sample.roi.anchor[0], sample.roi.anchor[0] + sample.roi.shape[0],
+              sample.roi.anchor[1], sample.roi.anchor[1] + sample.roi.shape[1]};
+    }
+    return {0, sample.shape[0], 0, sample.shape[1]};
+  }
+
+  /// The decoded image is planar and needs converting, unless it's a single 8-bit plane
+  static bool NeedsJpeg2kProcessing(const SampleData &sample) {
+    return sample.shape[2] > 1 || sample.bpp == 16;
+  }
+
+  static int Jpeg2kPixelSize(const SampleData &sample) {
+    return sample.bpp == 16 ? sizeof(uint16_t) : sizeof(uint8_t);
+  }
+
+  /**
+   * @brief The planar output of nvJPEG2K for the output area of a sample
+   */
+  struct Jpeg2kPlanarImage {
+    void *pixel_data[NVJPEG_MAX_COMPONENT] = {};
+    size_t pitch_in_bytes[NVJPEG_MAX_COMPONENT] = {};
+    nvjpeg2kImage_t image;
+
+    Jpeg2kPlanarImage(uint8_t *data, const SampleData &sample) {
+      auto area = Jpeg2kOutputArea(sample);
+      int pixel_sz = Jpeg2kPixelSize(sample);
+      int64_t comp_size = area.height() * area.width() * pixel_sz;
+      for (uint32_t c = 0; c < sample.shape[2]; ++c) {
+        pixel_data[c] = data + c * comp_size;
+        pitch_in_bytes[c] = area.width() * pixel_sz;
+      }
+      image.pixel_data = pixel_data;
+      image.pitch_in_bytes = pitch_in_bytes;
+      image.pixel_type = sample.bpp == 16 ? NVJPEG2K_UINT16 : NVJPEG2K_UINT8;
+      image.num_components = sample.shape[2];
+    }
+  };
+
+  /**
+   * @brief Decodes the tiles of the sample intersecting `area`, each at its place in `image`,
+   *        which covers the output area of the sample
+   */
+  nvjpeg2kStatus_t DecodeJpeg2kTiles(NvJPEG2KContext &ctx, const SampleData *sample,
+                                     const nvjpeg2kImage_t &image, const Jpeg2kArea &area) {
+#if NVJPEG2K_TILE_DECODE_ENABLED
+    const auto &jpeg2k_stream = nvjpeg2k_streams_[sample->sample_idx];
+    nvjpeg2kImageInfo_t image_info;
+    NVJPEG2K_CALL(nvjpeg2kStreamGetImageInfo(jpeg2k_stream, &image_info));
+    const auto out = Jpeg2kOutputArea(*sample);
+    const int pixel_sz = Jpeg2kPixelSize(*sample);
+    const int64_t tile_h = image_info.tile_height, tile_w = image_info.tile_width;
+
+    void *pixel_data[NVJPEG_MAX_COMPONENT] = {};
+    nvjpeg2kImage_t tile_image = image;
+    tile_image.pixel_data = pixel_data;
+    for (int64_t ty = area.y_begin / tile_h; ty < div_ceil(area.y_end, tile_h); ty++) {
+      const int64_t y_begin = std::max(area.y_begin, ty * tile_h);
+      const int64_t y_end = std::min(area.y_end, (ty + 1) * tile_h);
+      for (int64_t tx = area.x_begin / tile_w; tx < div_ceil(area.x_end, tile_w); tx++) {
+        const int64_t x_begin = std::max(area.x_begin, tx * tile_w);
+        const int64_t x_end = std::min(area.x_end, (tx + 1) * tile_w);
+        // the decoded area of the tile is written at its place in the output
+        const int64_t offset =
+            ((y_begin - out.y_begin) * out.width() + (x_begin - out.x_begin)) * pixel_sz;
+        for (uint32_t c = 0; c < image.num_components; c++)
+          pixel_data[c] = static_cast<uint8_t *>(image.pixel_data[c]) + offset;
+        NVJPEG2K_CALL(nvjpeg2kDecodeParamsSetDecodeArea(ctx.decode_params,
+                                                        x_begin, x_end, y_begin, y_end));
+        uint32_t tile_id = ty * image_info.num_tiles_x + tx;
+        uint32_t num_res = 0;
+        NVJPEG2K_CALL(nvjpeg2kStreamGetResolutionsInTile(jpeg2k_stream, tile_id, &num_res));
+        auto ret = nvjpeg2kDecodeTile(nvjpeg2k_handle_, ctx.decoder, jpeg2k_stream,
+                                      ctx.decode_params, tile_id, num_res, &tile_image,
+                                      ctx.cu_stream);
+        if (ret != NVJPEG2K_STATUS_SUCCESS)
+          return ret;
+      }
+    }
+    return NVJPEG2K_STATUS_SUCCESS;
+#else
+    DALI_FAIL("Decoding a ROI of a JPEG 2000 image requires nvJPEG2K 0.2 or newer");
+#endif  // NVJPEG2K_TILE_DECODE_ENABLED
+  }
+
+  /**
+   * @brief Converts the planar output of nvJPEG2K to the output of the operator
+   */
+  void ConvertJpeg2k(uint8_t *output_data, const uint8_t *planar, const SampleData *sample,
+                     cudaStream_t stream) {
+    // Converting to Gray or to interleaved, dropping alpha channels if needed
+    assert(sample->shape[2] >= 3);
+    auto area = Jpeg2kOutputArea(*sample);
+    int64_t npixels = area.height() * area.width();
+    DALIDataType pixel_type = sample->bpp == 16 ? DALI_UINT16 : DALI_UINT8;
+    if (output_image_type_ == DALI_GRAY) {
+      TYPE_SWITCH(pixel_type, type2id, Input, (uint8_t, uint16_t), (
+        PlanarRGBToGray<uint8_t, Input>(
+          output_data, reinterpret_cast<const Input*>(planar), npixels,
+          pixel_type, stream);
+      ), DALI_FAIL(make_string("Unsupported input type: ", pixel_type)))  // NOLINT
+    } else {
+      TYPE_SWITCH(pixel_type, type2id, Input, (uint8_t, uint16_t), (
+        PlanarToInterleaved<uint8_t, Input>(
+          output_data, reinterpret_cast<const Input*>(planar), npixels,
+          sample->req_nchannels,
+          output_image_type_, pixel_type, stream);
+      ), DALI_FAIL(make_string("Unsupported input type: ", pixel_type)))  // NOLINT
+    }
+  }
+
+  void DecodeJpeg2k(NvJPEG2KContext &ctx, uint8_t* output_data, const SampleData *sample,
                     span<const uint8_t> input_data) {
     assert(sample->bpp == 8 || sample->bpp == 16);
-    bool need_processing = sample->shape[2] > 1 || sample->bpp == 16;
-    int pixel_sz = sample->bpp == 16 ? sizeof(uint16_t) : sizeof(uint8_t);
-    int64_t npixels = sample->shape[0] * sample->shape[1];
-    int64_t comp_size = npixels * pixel_sz;
-    CUDA_CALL(cudaEventSynchronize(nvjpeg2k_decode_event_));
-    auto &buffer = nvjpeg2k_intermediate_buffer_;
+    bool need_processing = NeedsJpeg2kProcessing(*sample);
+    auto area = Jpeg2kOutputArea(*sample);
+    CUDA_CALL(cudaEventSynchronize(ctx.decode_event));
+    auto &buffer = ctx.intermediate_buffer;
     buffer.clear();
     if (need_processing) {
-      buffer.resize(volume(sample->shape) * pixel_sz);
+      buffer.resize(area.height() * area.width() * Jpeg2kPixelSize(*sample) * sample->shape[2]);
     }
-    const auto &jpeg2k_stream = nvjpeg2k_streams_[sample->sample_idx];
-    void *pixel_data[NVJPEG_MAX_COMPONENT] = {};
-    size_t pitch_in_bytes[NVJPEG_MAX_COMPONENT] = {};
     uint8_t *decoder_out = !need_processing ? output_data : buffer.data();
-    for (uint32_t c = 0; c < sample->shape[2]; ++c) {
-      pixel_data[c] = decoder_out + c * comp_size;
-      pitch_in_bytes[c] = sample->shape[1] * pixel_sz;
-    }
-    nvjpeg2kImage_t output_image;
-    output_image.pixel_data = pixel_data;
-    output_image.pitch_in_bytes = pitch_in_bytes;
-    DALIDataType pixel_type;
-    if (sample->bpp == 16) {
-      pixel_type = DALI_UINT16;
-      output_image.pixel_type = NVJPEG2K_UINT16;
+    Jpeg2kPlanarImage planar(decoder_out, *sample);
+    nvjpeg2kStatus_t ret;
+    if (sample->roi) {
+      // only the tiles intersecting the ROI are decoded
+      ret = DecodeJpeg2kTiles(ctx, sample, planar.image, area);
     } else {
-      pixel_type = DALI_UINT8;
-      output_image.pixel_type = NVJPEG2K_UINT8;
+      ret = nvjpeg2kDecode(nvjpeg2k_handle_, ctx.decoder, nvjpeg2k_streams_[sample->sample_idx],
+                           &planar.image, ctx.cu_stream);
     }
-    output_image.num_components = sample->shape[2];
-    auto ret = nvjpeg2kDecode(nvjpeg2k_handle_, nvjpeg2k_decoder_,
-                              jpeg2k_stream, &output_image, nvjpeg2k_cu_stream_);
     if (ret == NVJPEG2K_STATUS_SUCCESS) {
-      if (need_processing) {
-        if (output_image_type_ == DALI_GRAY) {
-          // Converting to Gray, dropping alpha channels if needed
-          assert(sample->shape[2] >= 3);
-          TYPE_SWITCH(pixel_type, type2id, Input, (uint8_t, uint16_t), (
-            PlanarRGBToGray<uint8_t, Input>(
-              output_data, reinterpret_cast<Input*>(decoder_out), npixels,
-              pixel_type, nvjpeg2k_cu_stream_);
-          ), DALI_FAIL(make_string("Unsupported input type: ", pixel_type)))  // NOLINT
-        } else {
-          // Converting to interleaved, dropping alpha channels if needed
-          assert(sample->shape[2] >= 3);
-          TYPE_SWITCH(pixel_type, type2id, Input, (uint8_t, uint16_t), (
-            PlanarToInterleaved<uint8_t, Input>(
-              output_data, reinterpret_cast<Input*>(decoder_out), npixels,
-              sample->req_nchannels,
-              output_image_type_, pixel_type, nvjpeg2k_cu_stream_);
-          ), DALI_FAIL(make_string("Unsupported input type: ", pixel_type)))  // NOLINT
-        }
-      }
-      CUDA_CALL(cudaEventRecord(nvjpeg2k_decode_event_, nvjpeg2k_cu_stream_));
+      if (need_processing)
+        ConvertJpeg2k(output_data, decoder_out, sample, ctx.cu_stream);
+      CUDA_CALL(cudaEventRecord(ctx.decode_event, ctx.cu_stream));
     } else if (ret == NVJPEG2K_STATUS_BAD_JPEG || ret == NVJPEG2K_STATUS_JPEG_NOT_SUPPORTED) {
       HostFallback<StorageGPU>(input_data.data(), input_data.size(), output_image_type_,
-                               output_data, nvjpeg2k_cu_stream_, sample->file_name,
+                               output_data, ctx.cu_stream, sample->file_name,
                                sample->roi, use_fast_idct_);
 
     } else {
       NVJPEG2K_CALL_EX(ret, sample->file_name);
     }
   }
+
+  /**
+   * @brief Splits the output area of a large, tiled image into parts with whole tiles,
+   *        one per nvJPEG2K thread; returns a single part if it shouldn't be split
+   */
+  std::vector<Jpeg2kArea> Jpeg2kTileChunks(const SampleData &sample) {
+    auto area = Jpeg2kOutputArea(sample);
+    if (!CanDecodeJpeg2kRoi() || num_threads_jpeg2k_ < 2 ||
+        area.height() * area.width() < kJpeg2kTileParallelMinPixels)
+      return { area };
+    nvjpeg2kImageInfo_t image_info;
+    NVJPEG2K_CALL(nvjpeg2kStreamGetImageInfo(nvjpeg2k_streams_[sample.sample_idx], &image_info));
+    const int64_t tile_h = image_info.tile_height, tile_w = image_info.tile_width;
+    const int64_t ty_begin = area.y_begin / tile_h, ty_end = div_ceil(area.y_end, tile_h);
+    const int64_t tx_begin = area.x_begin / tile_w, tx_end = div_ceil(area.x_end, tile_w);
+    // split along the dimension with more tiles
+    bool split_rows = ty_end - ty_begin >= tx_end - tx_begin;
+    int64_t t_begin = split_rows ? ty_begin : tx_begin;
+    int64_t ntiles = split_rows ? ty_end - ty_begin : tx_end - tx_begin;
+    int64_t tile_size = split_rows ? tile_h : tile_w;
+    int64_t nchunks = std::min<int64_t>(ntiles, num_threads_jpeg2k_);
+    std::vector<Jpeg2kArea> chunks;
+    for (int64_t i = 0; i < nchunks; i++) {
+      int64_t begin = (t_begin + ntiles * i / nchunks) * tile_size;
+      int64_t end = (t_begin + ntiles * (i + 1) / nchunks) * tile_size;
+      Jpeg2kArea chunk = area;
+      if (split_rows) {
+        chunk.y_begin = std::max(area.y_begin, begin);
+        chunk.y_end = std::min(area.y_end, end);
+      } else {
+        chunk.x_begin = std::max(area.x_begin, begin);
+        chunk.x_end = std::min(area.x_end, end);
+      }
+      chunks.push_back(chunk);
+    }
+    return chunks;
+  }
+
+  /**
+   * @brief Schedules the decoding of the parts of a large image on all the nvJPEG2K threads;
+   *        the output is finished in FinishTiledJpeg2k
+   */
+  void ScheduleTiledJpeg2k(const SampleData *sample, uint8_t *output_data,
+                           std::vector<Jpeg2kArea> chunks) {
+    nvjpeg2k_tiled_.emplace_back();
+    auto &tiled = nvjpeg2k_tiled_.back();
+    tiled.sample = sample;
+    tiled.output_data = output_data;
+    tiled.decoder_out = output_data;
+    if (NeedsJpeg2kProcessing(*sample)) {
+      // the buffers of the previous iteration may still be in use
+      for (auto &ctx : nvjpeg2k_ctx_)
+        CUDA_CALL(cudaEventSynchronize(ctx.decode_event));
+      size_t idx = nvjpeg2k_tiled_.size() - 1;
+      if (nvjpeg2k_tiled_buffers_.size() <= idx)
+        nvjpeg2k_tiled_buffers_.resize(idx + 1);
+      auto area = Jpeg2kOutputArea(*sample);
+      auto &buffer = nvjpeg2k_tiled_buffers_[idx];
+      buffer.clear();
+      buffer.resize(area.height() * area.width() * Jpeg2kPixelSize(*sample) * sample->shape[2]);
+      tiled.decoder_out = buffer.data();
+    }
+    int64_t priority = volume(sample->shape);
+    for (auto &chunk : chunks) {
+      nvjpeg2k_thread_.AddWork([this, &tiled, chunk](int tid) {
+        auto &ctx = nvjpeg2k_ctx_[tid];
+        if (tiled.failed)
+          return;
+        Jpeg2kPlanarImage planar(tiled.decoder_out, *tiled.sample);
+        auto ret = DecodeJpeg2kTiles(ctx, tiled.sample, planar.image, chunk);
+        if (ret == NVJPEG2K_STATUS_BAD_JPEG || ret == NVJPEG2K_STATUS_JPEG_NOT_SUPPORTED)
+          tiled.failed = true;
+        else
+          NVJPEG2K_CALL_EX(ret, tiled.sample->file_name);
+        CUDA_CALL(cudaEventRecord(ctx.decode_event, ctx.cu_stream));
+      }, priority);
+    }
+  }
+
+  /**
+   * @brief Converts the images decoded by parts to the output, once all the parts are decoded
+   */
+  void FinishTiledJpeg2k(MixedWorkspace &ws) {
+    if (nvjpeg2k_tiled_.empty())
+      return;
+    auto &ctx = nvjpeg2k_ctx_[0];
+    for (auto &other : nvjpeg2k_ctx_) {
+      if (&other == &ctx)
+        continue;
+      CUDA_CALL(cudaEventRecord(other.decode_event, other.cu_stream));
+      CUDA_CALL(cudaStreamWaitEvent(ctx.cu_stream, other.decode_event, 0));
+    }
+    auto &input = ws.InputRef<CPUBackend>(0);
+    for (auto &tiled : nvjpeg2k_tiled_) {
+      const auto *sample = tiled.sample;
+      auto i = sample->sample_idx;
+      if (tiled.failed) {
+        HostFallback<StorageGPU>(input[i].data<uint8_t>(), input[i].size(), output_image_type_,
+                                 tiled.output_data, ctx.cu_stream, sample->file_name,
+                                 sample->roi, use_fast_idct_);
+      } else if (tiled.decoder_out != tiled.output_data) {
+        ConvertJpeg2k(tiled.output_data, tiled.decoder_out, sample, ctx.cu_stream);
+      }
+      CacheStore(sample->file_name, tiled.output_data, output_shape_[i].to_static<3>(),
+                 ctx.cu_stream);
+    }
+    CUDA_CALL(cudaEventRecord(ctx.decode_event, ctx.cu_stream));
+  }
 #endif  // NVJPEG2K_ENABLED
 
   void ProcessImagesJpeg2k(MixedWorkspace &ws) {
 #if NVJPEG2K_ENABLED
+    nvjpeg2k_tiled_.clear();
     if (!nvjpeg2k_handle_) {
       return;
     }
-    nvjpeg2k_thread_.AddWork([this, &ws](int) {
-      auto &output = ws.OutputRef<GPUBackend>(0);
-      auto &input = ws.InputRef<CPUBackend>(0);
-      for (auto *sample : samples_jpeg2k_) {
-        assert(sample);
+    auto &output = DecodeOutput(ws);
+    auto &input = ws.InputRef<CPUBackend>(0);
+    // each sample is decoded by one of the threads, with its own context, the largest first;
+    // the large tiled images are split between the threads
+    for (auto *sample : samples_jpeg2k_) {
+      assert(sample);
+      auto i = sample->sample_idx;
+      auto output_data = output.mutable_tensor<uint8_t>(i);
+      auto chunks = Jpeg2kTileChunks(*sample);
+      if (chunks.size() > 1) {
+        ScheduleTiledJpeg2k(sample, output_data, std::move(chunks));
+        continue;
+      }
+      nvjpeg2k_thread_.AddWork([this, &input, sample, output_data](int tid) {
+        auto &ctx = nvjpeg2k_ctx_[tid];
         auto i = sample->sample_idx;
-        auto output_data = output.mutable_tensor<uint8_t>(i);
         auto in = span<const uint8_t>(input[i].data<uint8_t>(), input[i].size());
         ImageCache::ImageShape shape = output_shape_[i].to_static<3>();
-        DecodeJpeg2k(output_data, sample, in);
-        CacheStore(sample->file_name, output_data, shape, nvjpeg2k_cu_stream_);
-      }
-    });
+        DecodeJpeg2k(ctx, output_data, sample, in);
+        CacheStore(sample->file_name, output_data, shape, ctx.cu_stream);
+      }, volume(sample->shape));
+    }
 #endif  // NVJPEG2K_ENABLED
   }
 
+  void HostDecodeSample(const SampleData *sample, const Tensor<CPUBackend> &in,
+                        uint8_t *output_data, int tid) {
+    TensorShape<2> downscale_hint = {0, 0};
+    if (sample->scale_denom > 1)
+      downscale_hint = {downscale_hint_[0], downscale_hint_[1]};
+    HostFallback<StorageGPU>(in.data<uint8_t>(), in.size(), output_image_type_, output_data,
+                             streams_[tid], sample->file_name, sample->roi, use_fast_idct_,
+                             downscale_hint);
+    CacheStore(sample->file_name, output_data, output_shape_[sample->sample_idx].to_static<3>(),
+               streams_[tid]);
+  }
+
   void ProcessImagesHost(MixedWorkspace &ws) {
-    auto& output = ws.Output<GPUBackend>(0);
+    auto& output = DecodeOutput(ws);
     for (auto *sample : samples_host_) {
       auto i = sample->sample_idx;
       auto *output_data = output.mutable_tensor<uint8_t>(i);
       const auto &in = ws.Input<CPUBackend>(0, i);
-      ImageCache::ImageShape shape = output_shape_[i].to_static<3>();
       thread_pool_.AddWork(
-        [this, sample, &in, output_data, shape](int tid) {
+        [this, sample, &in, output_data](int tid) {
+          auto start = std::chrono::steady_clock::now();
+          HostDecodeSample(sample, in, output_data, tid);
+          sample->decode_time = std::chrono::duration<double>(
+              std::chrono::steady_clock::now() - start).count();
+        }, task_priority_seq_--);  // FIFO order, since the samples were already ordered
+    }
+  }
+
+  /**
+   * @brief Schedules the progressive and lossless JPEGs ahead of the rest of the batch,
+   *        the largest first
+   *
+   * Their Huffman decoding runs on the host, so they'd be the stragglers of the batch if they
+   * were started last. They don't take part in the load balancing, as they'd skew
+   * the throughput measured for the hybrid decoder.
+   */
+  void ProcessImagesSlowPath(MixedWorkspace &ws) {
+    auto& output = DecodeOutput(ws);
+    for (auto *sample : samples_slow_path_) {
+      auto i = sample->sample_idx;
+      auto *output_data = output.mutable_tensor<uint8_t>(i);
+      const auto &in = ws.Input<CPUBackend>(0, i);
+      thread_pool_.AddWork(
+        [this, sample, &in, output_data](int tid) {
+          if (sample->method == DecodeMethod::NvjpegCuda) {
+            SampleWorker(sample->sample_idx, sample->file_name, in.size(), tid,
+                         in.data<uint8_t>(), output_data, streams_[tid]);
+          } else {
+            HostDecodeSample(sample, in, output_data, tid);
+          }
+        }, sample->encoded_length);  // positive, so ahead of the FIFO sequence
+    }
+  }
+
+  /**
+   * @brief Schedules the decompression of the PNG and TIFF images to the pinned staging buffer
+   *
+   * The staging buffer starts with the sample descriptors, followed by the images.
+   * Images which can't be decompressed are decoded with the host decoder instead.
+   */
+  void ProcessImagesRaster(MixedWorkspace &ws) {
+    if (samples_raster_.empty())
+      return;
+    auto& output = DecodeOutput(ws);
+    constexpr size_t kAlignment = 256;
+    size_t offset = align_up(samples_raster_.size() * sizeof(RasterSampleDesc), kAlignment);
+    for (auto *sample : samples_raster_) {
+      sample->raster_offset = offset;
+      offset += align_up(sample->raster.decompressed_size(), kAlignment);
+    }
+    raster_staging_used_ = offset;
+
+    // the previous iteration may still be using the buffers
+    CUDA_CALL(cudaEventSynchronize(raster_event_));
+    if (offset > raster_staging_size_) {
+      raster_staging_.reset();
+      raster_staging_ = mm::alloc_raw_unique<uint8_t, mm::memory_kind::pinned>(offset);
+      raster_staging_size_ = offset;
+    }
+    raster_buffer_.clear();
+    raster_buffer_.resize(offset);
+
+    for (auto *sample : samples_raster_) {
+      auto i = sample->sample_idx;
+      auto *output_data = output.mutable_tensor<uint8_t>(i);
+      const auto &in = ws.Input<CPUBackend>(0, i);
+      thread_pool_.AddWork(
+        [this, sample, &in, output_data](int tid) {
+          if (DecompressRasterImage(in.data<uint8_t>(), in.size(), sample->raster,
+                                    raster_staging_.get() + sample->raster_offset))
+            return;
+          sample->raster_failed = true;
           HostFallback<StorageGPU>(in.data<uint8_t>(), in.size(), output_image_type_, output_data,
                                    streams_[tid], sample->file_name, sample->roi, use_fast_idct_);
-          CacheStore(sample->file_name, output_data, shape, streams_[tid]);
-        }, task_priority_seq_--);  // FIFO order, since the samples were already ordered
+        }, task_priority_seq_--);
     }
   }
 
+  /**
+   * @brief Copies the decompressed PNG and TIFF images to the GPU and reconstructs them
+   *        in the output, in one batched launch
+   */
+  void ReconstructRasterImages(MixedWorkspace &ws) {
+    if (samples_raster_.empty())
+      return;
+    auto& output = DecodeOutput(ws);
+    auto *descs = reinterpret_cast<RasterSampleDesc *>(raster_staging_.get());
+    int num_samples = 0;
+    int64_t max_pixels = 0;
+    for (auto *sample : samples_raster_) {
+      if (sample->raster_failed)
+        continue;
+      auto i = sample->sample_idx;
+      auto &desc = descs[num_samples++];
+      desc.data = raster_buffer_.data() + sample->raster_offset;
+      desc.output = output.mutable_tensor<uint8_t>(i);
+      desc.height = sample->raster.height;
+      desc.width = sample->raster.width;
+      desc.in_channels = sample->raster.channels;
+      desc.out_channels = sample->req_nchannels;
+      desc.layout = sample->raster.layout;
+      max_pixels = std::max<int64_t>(max_pixels, DecodedPixels(sample->shape));
+    }
+    if (num_samples > 0) {
+      CUDA_CALL(cudaMemcpyAsync(raster_buffer_.data(), raster_staging_.get(),
+                                raster_staging_used_, cudaMemcpyHostToDevice, ws.stream()));
+      RasterReconstruct(reinterpret_cast<const RasterSampleDesc *>(raster_buffer_.data()),
+                        num_samples, max_pixels, output_image_type_, ws.stream());
+      for (auto *sample : samples_raster_) {
+        if (sample->raster_failed)
+          continue;
+        auto i = sample->sample_idx;
+        CacheStore(sample->file_name, output.mutable_tensor<uint8_t>(i),
+                   output_shape_[i].to_static<3>(), ws.stream());
+      }
+    }
+    CUDA_CALL(cudaEventRecord(raster_event_, ws.stream()));
+  }
+
   void ProcessImagesHw(MixedWorkspace &ws) {
 #if IS_HW_DECODER_COMPATIBLE
-    auto& output = ws.Output<GPUBackend>(0);
+    auto& output = DecodeOutput(ws);
     if (!samples_hw_batched_.empty()) {
-      nvjpegJpegState_t &state = state_hw_batched_;
-      assert(state != nullptr);
+      // the state is shared with the decoders of the other pipelines
+      NvjpegSharedHandle::HwDecoderLock hw_lock(*shared_handle_);
+      nvjpegJpegState_t state = hw_lock.state();
       // not used so set to 1
       int max_cpu_threads = 1;
 
@@ -831,6 +1473,9 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
 
       int j = 0;
       TensorVector<CPUBackend> tv(samples_hw_batched_.size());
+      hw_crop_offsets_.clear();
+      hw_crop_offsets_.resize(samples_hw_batched_.size(), -1);
+      int64_t crop_buffer_size = 0;
 
       for (auto *sample : samples_hw_batched_) {
         int i = sample->sample_idx;
@@ -839,22 +1484,47 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
 
         tv[j].ShareData(const_cast<Tensor<CPUBackend>*>(&in));
         in_lengths_[j] = in.size();
-        nvjpeg_destinations_[j].channel[0] = output.mutable_tensor<uint8_t>(i);
-        nvjpeg_destinations_[j].pitch[0] = out_shape[1] * out_shape[2];
+        if (sample->hw_crop_after_decode) {
+          // the whole image is decoded to the intermediate buffer
+          NVJPEG_CALL(nvjpegDecodeParamsSetROI(sample->params, 0, 0, -1, -1));
+          hw_crop_offsets_[j] = crop_buffer_size;
+          nvjpeg_destinations_[j].pitch[0] = sample->shape[1] * out_shape[2];
+          crop_buffer_size += sample->shape[0] * nvjpeg_destinations_[j].pitch[0];
+        } else {
+          nvjpeg_destinations_[j].channel[0] = output.mutable_tensor<uint8_t>(i);
+          nvjpeg_destinations_[j].pitch[0] = out_shape[1] * out_shape[2];
+        }
         nvjpeg_params_[j] = sample->params;
         j++;
       }
 
       CUDA_CALL(cudaEventSynchronize(hw_decode_event_));
+      // the previous use of the intermediate buffer is complete, it can be reallocated
+      if (crop_buffer_size > 0) {
+        hw_crop_buffer_.clear();
+        hw_crop_buffer_.resize(crop_buffer_size);
+        for (size_t k = 0; k < samples_hw_batched_.size(); ++k) {
+          if (hw_crop_offsets_[k] >= 0)
+            nvjpeg_destinations_[k].channel[0] = hw_crop_buffer_.data() + hw_crop_offsets_[k];
+        }
+      }
       // it is H2H copy so the stream doesn't matter much as we don't use cudaMemcpy but
       // maybe someday...
       hw_decoder_images_staging_.Copy(tv, hw_decode_stream_);
       for (size_t k = 0; k < samples_hw_batched_.size(); ++k) {
         in_data_[k] = hw_decoder_images_staging_.mutable_tensor<uint8_t>(k);
       }
+      if (adaptive_load_balancing_) {
+        RecordHwDecoderTime();
+        CUDA_CALL(cudaEventRecord(hw_timing_start_event_, hw_decode_stream_));
+      }
       NVJPEG_CALL(nvjpegDecodeBatchedEx(handle_, state, in_data_.data(), in_lengths_.data(),
                                         nvjpeg_destinations_.data(), nvjpeg_params_.data(),
                                         hw_decode_stream_));
+      hw_lock.Scheduled(hw_decode_stream_);
+
+      if (crop_buffer_size > 0)
+        CropHwDecodedImages(output);
 
       if (output_image_type_ == DALI_YCbCr) {
         // We don't decode directly to YCbCr, since we want to control the YCbCr definition,
@@ -869,6 +1539,12 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
         }
       }
 
+      if (adaptive_load_balancing_) {
+        CUDA_CALL(cudaEventRecord(hw_timing_end_event_, hw_decode_stream_));
+        for (auto *sample : samples_hw_batched_)
+          hw_pending_pixels_ += DecodedPixels(output_shape_[sample->sample_idx]);
+      }
+
       for (auto *sample : samples_hw_batched_) {
         int i = sample->sample_idx;
         CacheStore(sample->file_name, output.mutable_tensor<uint8_t>(i),
@@ -879,25 +1555,51 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
 #endif
   }
 
+  /**
+   * @brief Copies the ROIs of the images that the HW decoder decoded as a whole to the output
+   */
+  void CropHwDecodedImages(TensorList<GPUBackend> &output) {
+    for (size_t k = 0; k < samples_hw_batched_.size(); ++k) {
+      if (hw_crop_offsets_[k] < 0)
+        continue;
+      auto &sample = *samples_hw_batched_[k];
+      int i = sample.sample_idx;
+      int64_t nchannels = output_shape_.tensor_shape_span(i)[2];
+      size_t src_pitch = nvjpeg_destinations_[k].pitch[0];
+      size_t row_size = sample.roi.shape[1] * nchannels;
+      const uint8_t *src = nvjpeg_destinations_[k].channel[0] +
+                           sample.roi.anchor[0] * src_pitch + sample.roi.anchor[1] * nchannels;
+      CUDA_CALL(cudaMemcpy2DAsync(output.mutable_tensor<uint8_t>(i), row_size, src, src_pitch,
+                                  row_size, sample.roi.shape[0], cudaMemcpyDeviceToDevice,
+                                  hw_decode_stream_));
+    }
+  }
+
   void ProcessImages(MixedWorkspace &ws) {
-    auto &output = ws.Output<GPUBackend>(0);
+    auto &output = DecodeOutput(ws);
     output.set_type<uint8_t>();
     assert(output_shape_.num_samples() ==
            ws.GetInputBatchSize(0));  // If fails: Incorrect number of samples in shape
     output.Resize(output_shape_);
     output.SetLayout("HWC");
 
-    UpdateTestCounters(samples_hw_batched_.size(), samples_single_.size(), samples_host_.size(),
-                       samples_jpeg2k_.size());
+    int nslow_path_cuda = std::count_if(
+        samples_slow_path_.begin(), samples_slow_path_.end(),
+        [](const SampleData *sample) { return sample->method == DecodeMethod::NvjpegCuda; });
+    int nslow_path_host = samples_slow_path_.size() - nslow_path_cuda;
+    UpdateTestCounters(samples_hw_batched_.size(), samples_single_.size() + nslow_path_cuda,
+                       samples_host_.size() + nslow_path_host, samples_jpeg2k_.size());
 
     // Reset the task priority. Subsequent tasks will use decreasing numbers to ensure the
     // expected order of execution.
     task_priority_seq_ = 0;
     ProcessImagesCache(ws);
 
+    ProcessImagesSlowPath(ws);
     ProcessImagesCuda(ws);
     ProcessImagesHost(ws);
     ProcessImagesJpeg2k(ws);
+    ProcessImagesRaster(ws);
     thread_pool_.RunAll(false);  // don't block
     nvjpeg2k_thread_.RunAll(false);
 
@@ -905,6 +1607,12 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
 
     thread_pool_.WaitForWork();
     nvjpeg2k_thread_.WaitForWork();
+#if NVJPEG2K_ENABLED
+    FinishTiledJpeg2k(ws);
+#endif  // NVJPEG2K_ENABLED
+    if (adaptive_load_balancing_)
+      UpdateLoadBalancer();
+    ReconstructRasterImages(ws);
     // wait for all work in workspace main stream
     for (int tid = 0; tid < num_threads_; tid++) {
       CUDA_CALL(cudaEventRecord(decode_events_[tid], streams_[tid]));
@@ -913,8 +1621,10 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
     CUDA_CALL(cudaEventRecord(hw_decode_event_, hw_decode_stream_));
     CUDA_CALL(cudaStreamWaitEvent(ws.stream(), hw_decode_event_, 0));
 #if NVJPEG2K_ENABLED
-    CUDA_CALL(cudaEventRecord(nvjpeg2k_decode_event_, nvjpeg2k_cu_stream_));
-    CUDA_CALL(cudaStreamWaitEvent(ws.stream(), nvjpeg2k_decode_event_, 0));
+    for (auto &ctx : nvjpeg2k_ctx_) {
+      CUDA_CALL(cudaEventRecord(ctx.decode_event, ctx.cu_stream));
+      CUDA_CALL(cudaStreamWaitEvent(ws.stream(), ctx.decode_event, 0));
+    }
 #endif  // NVJPEG2K_ENABLED
   }
 
@@ -1011,10 +1721,16 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
 
 
   USE_OPERATOR_MEMBERS();
+  std::shared_ptr<NvjpegSharedHandle> shared_handle_;
   nvjpegHandle_t handle_;
 
   // output colour format
   DALIImageType output_image_type_;
+  /// the images are decoded as RGB, to `rgb_decoded_`, and converted to planar YUV 4:2:0
+  bool yuv420_output_ = false;
+  TensorList<GPUBackend> rgb_decoded_;
+  /// recorded after the conversion to YUV 4:2:0, guards the reuse of `rgb_decoded_`
+  cudaEvent_t yuv420_event_;
 
   unsigned int hybrid_huffman_threshold_;
   bool use_fast_idct_;
@@ -1029,15 +1745,21 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
 #if NVJPEG2K_ENABLED
   // nvjpeg2k
   NvJPEG2KHandle nvjpeg2k_handle_{};
-  NvJPEG2KDecodeState nvjpeg2k_decoder_{};
-  DeviceBuffer<uint8_t> nvjpeg2k_intermediate_buffer_;
-  cudaStream_t nvjpeg2k_cu_stream_;
-  cudaEvent_t nvjpeg2k_decode_event_;
   nvjpeg2kDeviceAllocator_t nvjpeg2k_dev_alloc_;
   nvjpeg2kPinnedAllocator_t nvjpeg2k_pin_alloc_;
 
+  // nvjpeg2k - per thread of nvjpeg2k_thread_, indexed with the thread index
+  std::vector<NvJPEG2KContext> nvjpeg2k_ctx_;
+
   // nvjpeg2k - per sample
   std::vector<NvJPEG2KStream> nvjpeg2k_streams_;
+
+  /// The images of the current iteration decoded by parts, on all the threads
+  std::deque<Jpeg2kTiledSample> nvjpeg2k_tiled_;
+  /// The planar outputs of the images decoded by parts
+  std::vector<DeviceBuffer<uint8_t>> nvjpeg2k_tiled_buffers_;
+  /// Images this large are decoded by parts on all the threads, if they're tiled
+  static constexpr int64_t kJpeg2kTileParallelMinPixels = 16 << 20;
 #endif  // NVJPEG2K_ENABLED
 
   // GPU
@@ -1047,14 +1769,39 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
   cudaStream_t hw_decode_stream_;
   std::vector<cudaEvent_t> decode_events_;
   cudaEvent_t hw_decode_event_;
+  /// the whole images decoded by the HW decoder, to be cropped to the output
+  DeviceBuffer<uint8_t> hw_crop_buffer_;
+  /// the offsets of the images in `hw_crop_buffer_`, -1 for the samples decoded with the ROI
+  std::vector<int64_t> hw_crop_offsets_;
   std::vector<int> thread_page_ids_;  // page index for double-buffering
 
+  /// the decompressed PNG and TIFF images, preceded with their descriptors
+  mm::uptr<uint8_t> raster_staging_;
+  size_t raster_staging_size_ = 0;
+  size_t raster_staging_used_ = 0;
+  /// the device copy of `raster_staging_`, where the images are reconstructed
+  DeviceBuffer<uint8_t> raster_buffer_;
+  /// recorded after the reconstruction, guards the reuse of the raster buffers
+  cudaEvent_t raster_event_;
+
   int device_id_;
 
   bool using_hw_decoder_ = false;
   float hw_decoder_load_ = 0.0f;
   int hw_decoder_bs_ = 0;
 
+  std::vector<int> downscale_hint_;
+
+  bool adaptive_load_balancing_ = false;
+  DecoderLoadBalancer load_balancer_{0.f, 1};
+  /// the loads used in the current iteration, reported as diagnostics
+  float current_hw_load_ = 0.0f;
+  float current_host_load_ = 0.0f;
+  cudaEvent_t hw_timing_start_event_ = nullptr;
+  cudaEvent_t hw_timing_end_event_ = nullptr;
+  /// the pixels decoded with the HW decoder, which weren't yet passed to the load balancer
+  double hw_pending_pixels_ = 0;
+
   // Those are used to feed nvjpeg's batched API
   std::vector<const unsigned char*> in_data_;
   std::vector<size_t> in_lengths_;
@@ -1066,6 +1813,7 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
   nvjpegPinnedAllocator_t pinned_allocator_;
 
   ThreadPool thread_pool_;
+  int num_threads_jpeg2k_;
   ThreadPool nvjpeg2k_thread_;
   static constexpr int kOutputDim = 3;
 
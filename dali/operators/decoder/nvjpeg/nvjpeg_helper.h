@@ -137,6 +137,13 @@ inline bool IsProgressiveJPEG(const uint8_t* raw_jpeg, size_t size) {
   return segment_marker == progressive_sof;
 }
 
+inline bool IsLosslessJPEG(const uint8_t* raw_jpeg, size_t size) {
+  const uint8_t segment_marker = GetJpegEncoding(raw_jpeg, size);
+  // SOF3, SOF7, SOF11 and SOF15: lossless, with Huffman or arithmetic coding
+  return segment_marker == 0xc3 || segment_marker == 0xc7 ||
+         segment_marker == 0xcb || segment_marker == 0xcf;
+}
+
 // Predicate to determine if the image should be decoded with the nvJPEG
 // hybrid Huffman decoder instead of the nvjpeg host Huffman decoder
 template <typename T>
@@ -156,12 +163,13 @@ inline bool ShouldUseHybridHuffman(EncodedImageInfo<T>& info,
 template <typename StorageType>
 void HostFallback(const uint8_t *data, int size, DALIImageType image_type, uint8_t *output_buffer,
                   cudaStream_t stream, std::string file_name, CropWindow crop_window,
-                  bool use_fast_idct) {
+                  bool use_fast_idct, TensorShape<2> downscale_hint = {0, 0}) {
   std::unique_ptr<Image> img;
   try {
     img = ImageFactory::CreateImage(data, size, image_type);
     img->SetCropWindow(crop_window);
     img->SetUseFastIdct(use_fast_idct);
+    img->SetDownscaleHint(downscale_hint[0], downscale_hint[1]);
     img->Decode();
   } catch (std::exception &e) {
     DALI_FAIL(e.what() + ". File: " + file_name);
@@ -0,0 +1,116 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/decoder/nvjpeg/nvjpeg_shared_handle.h"
+#include <algorithm>
+#include <cassert>
+#include <exception>
+#include <iostream>
+#include <map>
+#include <utility>
+#include "dali/core/cuda_error.h"
+#include "dali/core/device_guard.h"
+#include "dali/operators/decoder/nvjpeg/nvjpeg_helper.h"
+
+namespace dali {
+
+std::shared_ptr<NvjpegSharedHandle> NvjpegSharedHandle::Get(int device_id, bool hardware) {
+  static std::mutex mutex;
+  static std::map<std::pair<int, bool>, std::weak_ptr<NvjpegSharedHandle>> handles;
+  std::lock_guard<std::mutex> lock(mutex);
+  auto &entry = handles[{device_id, hardware}];
+  if (auto handle = entry.lock())
+    return handle;
+
+  DeviceGuard dg(device_id);
+  nvjpegHandle_t handle = nullptr;
+  if (hardware) {
+#if IS_HW_DECODER_COMPATIBLE
+    if (nvjpegCreate(NVJPEG_BACKEND_HARDWARE, NULL, &handle) != NVJPEG_STATUS_SUCCESS)
+      return nullptr;
+#else
+    return nullptr;
+#endif
+  } else {
+    NVJPEG_CALL(nvjpegCreateSimple(&handle));
+  }
+  std::shared_ptr<NvjpegSharedHandle> ret(new NvjpegSharedHandle(device_id, handle, hardware));
+  entry = ret;
+  return ret;
+}
+
+NvjpegSharedHandle::NvjpegSharedHandle(int device_id, nvjpegHandle_t handle, bool hardware)
+    : device_id_(device_id), handle_(handle) {
+  if (hardware) {
+    NVJPEG_CALL(nvjpegJpegStateCreate(handle_, &hw_state_));
+    CUDA_CALL(cudaEventCreate(&hw_event_));
+  }
+}
+
+NvjpegSharedHandle::~NvjpegSharedHandle() {
+  try {
+    DeviceGuard dg(device_id_);
+    if (hw_event_) {
+      CUDA_CALL(cudaEventSynchronize(hw_event_));
+      CUDA_CALL(cudaEventDestroy(hw_event_));
+    }
+    if (hw_state_)
+      NVJPEG_CALL(nvjpegJpegStateDestroy(hw_state_));
+    NVJPEG_CALL(nvjpegDestroy(handle_));
+  } catch (const std::exception &e) {
+    // If destroying nvJPEG resources failed we are leaking something so terminate
+    std::cerr << "Fatal error: exception in ~NvjpegSharedHandle():\n" << e.what() << std::endl;
+    std::terminate();
+  }
+}
+
+void NvjpegSharedHandle::SetMemoryPadding(size_t device_padding, size_t host_padding) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (device_padding > device_padding_) {
+    NVJPEG_CALL(nvjpegSetDeviceMemoryPadding(device_padding, handle_));
+    device_padding_ = device_padding;
+  }
+  if (host_padding > host_padding_) {
+    NVJPEG_CALL(nvjpegSetPinnedMemoryPadding(host_padding, handle_));
+    host_padding_ = host_padding;
+  }
+}
+
+#if defined(NVJPEG_PREALLOCATE_API)
+void NvjpegSharedHandle::PreallocateHw(int batch_size, int width, int height,
+                                       nvjpegOutputFormat_t format) {
+  HwDecoderLock lock(*this);
+  if (batch_size <= hw_batch_size_ && width <= hw_width_ && height <= hw_height_)
+    return;
+  hw_batch_size_ = std::max(batch_size, hw_batch_size_);
+  hw_width_ = std::max(width, hw_width_);
+  hw_height_ = std::max(height, hw_height_);
+  NVJPEG_CALL(nvjpegDecodeBatchedPreAllocate(handle_, hw_state_, hw_batch_size_, hw_width_,
+                                             hw_height_, NVJPEG_CSS_444, format));
+}
+#endif
+
+NvjpegSharedHandle::HwDecoderLock::HwDecoderLock(NvjpegSharedHandle &handle)
+    : handle_(handle), lock_(handle.hw_mutex_) {
+  DALI_ENFORCE(handle_.hardware(), "The handle doesn't use the hardware decoder");
+  CUDA_CALL(cudaEventSynchronize(handle_.hw_event_));
+}
+
+void NvjpegSharedHandle::HwDecoderLock::Scheduled(cudaStream_t stream) {
+  assert(lock_.owns_lock());
+  CUDA_CALL(cudaEventRecord(handle_.hw_event_, stream));
+  lock_.unlock();
+}
+
+}  // namespace dali
@@ -0,0 +1,123 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_DECODER_NVJPEG_NVJPEG_SHARED_HANDLE_H_
+#define DALI_OPERATORS_DECODER_NVJPEG_NVJPEG_SHARED_HANDLE_H_
+
+#include <cuda_runtime_api.h>
+#include <nvjpeg.h>
+#include <memory>
+#include <mutex>
+#include "dali/core/common.h"
+
+#if NVJPEG_VER_MAJOR > 11 || \
+    (NVJPEG_VER_MAJOR == 11 && (NVJPEG_VER_MINOR > 4 || \
+                               (NVJPEG_VER_MINOR == 4 && NVJPEG_VER_PATCH >= 1)))
+  #define IS_HW_DECODER_COMPATIBLE 1
+#else
+  #define IS_HW_DECODER_COMPATIBLE 0
+#endif
+
+namespace dali {
+
+/**
+ * @brief nvJPEG handle shared by all the decoders of a device in the process
+ *
+ * Creating a handle - and the memory pool of the hardware decoder - is costly, so the decoders
+ * of all the pipelines in the process (e.g. training and validation ones) share one handle
+ * per device and backend. The handle is released with the last decoder using it.
+ *
+ * The handle can be used from many threads, but the state of the hardware batched decoder
+ * can't, so the decoders take turns at it with HwDecoderLock. The hardware decoder is a single
+ * engine anyway, so the batches of the pipelines are queued for it one after another.
+ */
+class DLL_PUBLIC NvjpegSharedHandle {
+ public:
+  /**
+   * @brief Returns the handle of the device, creating it if no decoder holds it
+   * @param hardware whether to use the hardware backend; if it's not available, nullptr
+   *                 is returned
+   */
+  static std::shared_ptr<NvjpegSharedHandle> Get(int device_id, bool hardware);
+
+  ~NvjpegSharedHandle();
+
+  DISABLE_COPY_MOVE_ASSIGN(NvjpegSharedHandle);
+
+  nvjpegHandle_t get() const noexcept {
+    return handle_;
+  }
+
+  bool hardware() const noexcept {
+    return hw_state_ != nullptr;
+  }
+
+  /**
+   * @brief Raises the padding of the buffers allocated by nvJPEG to at least the given sizes
+   */
+  void SetMemoryPadding(size_t device_padding, size_t host_padding);
+
+#if defined(NVJPEG_PREALLOCATE_API)
+  /**
+   * @brief Grows the memory pool of the hardware decoder, so that it fits batches
+   *        of `batch_size` images of up to `width` x `height`
+   */
+  void PreallocateHw(int batch_size, int width, int height, nvjpegOutputFormat_t format);
+#endif
+
+  /**
+   * @brief Exclusive use of the state of the hardware batched decoder
+   *
+   * Waits until the batch scheduled by the previous holder is decoded. The holder calls
+   * `Scheduled` with the stream of its batch, which releases the lock.
+   */
+  class HwDecoderLock {
+   public:
+    explicit HwDecoderLock(NvjpegSharedHandle &handle);
+
+    nvjpegJpegState_t state() const noexcept {
+      return handle_.hw_state_;
+    }
+
+    /**
+     * @brief Marks the end of the use of the state in the stream and releases the lock
+     */
+    void Scheduled(cudaStream_t stream);
+
+   private:
+    NvjpegSharedHandle &handle_;
+    std::unique_lock<std::mutex> lock_;
+  };
+
+ private:
+  NvjpegSharedHandle(int device_id, nvjpegHandle_t handle, bool hardware);
+
+  int device_id_;
+  nvjpegHandle_t handle_ = nullptr;
+  std::mutex mutex_;
+  size_t device_padding_ = 0;
+  size_t host_padding_ = 0;
+
+  // the hardware batched decoder
+  std::mutex hw_mutex_;
+  nvjpegJpegState_t hw_state_ = nullptr;
+  cudaEvent_t hw_event_ = nullptr;
+  int hw_batch_size_ = 0;
+  int hw_width_ = 0;
+  int hw_height_ = 0;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_DECODER_NVJPEG_NVJPEG_SHARED_HANDLE_H_
@@ -0,0 +1,436 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <zlib.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+#include "dali/core/byte_io.h"
+#include "dali/operators/decoder/nvjpeg/raster_image.h"
+
+namespace dali {
+
+namespace {
+
+/// larger images are left for the host decoder
+constexpr int64_t kMaxDecompressedSize = std::numeric_limits<int32_t>::max();
+
+// PNG - https://www.w3.org/TR/PNG/
+
+constexpr uint8_t kPngSignature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+bool ChunkIs(const uint8_t *type, const char *name) {
+  return std::memcmp(type, name, 4) == 0;
+}
+
+bool ParsePng(const uint8_t *data, size_t size, RasterImageInfo &info) {
+  size_t pos = sizeof(kPngSignature);
+  bool header_read = false;
+  info.chunks.clear();
+  while (pos + 12 <= size) {
+    uint32_t length = ReadValueBE<uint32_t>(data + pos);
+    const uint8_t *type = data + pos + 4;
+    size_t chunk_data = pos + 8;
+    if (length > size - chunk_data - 4)
+      return false;
+    if (ChunkIs(type, "IHDR")) {
+      if (length != 13)
+        return false;
+      const uint8_t *hdr = data + chunk_data;
+      uint32_t width = ReadValueBE<uint32_t>(hdr);
+      uint32_t height = ReadValueBE<uint32_t>(hdr + 4);
+      int bit_depth = hdr[8], color_type = hdr[9];
+      int compression = hdr[10], filter = hdr[11], interlace = hdr[12];
+      if (bit_depth != 8 || compression != 0 || filter != 0 || interlace != 0)
+        return false;
+      switch (color_type) {
+        case 0:
+          info.channels = 1;
+          break;
+        case 2:
+          info.channels = 3;
+          break;
+        case 6:
+          info.channels = 4;
+          break;
+        default:  // palette and gray with alpha
+          return false;
+      }
+      if (width == 0 || height == 0 || width > (1u << 24) || height > (1u << 24))
+        return false;
+      info.width = width;
+      info.height = height;
+      header_read = true;
+    } else if (!header_read) {
+      return false;  // IHDR must be the first chunk
+    } else if (ChunkIs(type, "PLTE") || ChunkIs(type, "tRNS")) {
+      return false;
+    } else if (ChunkIs(type, "IDAT")) {
+      info.chunks.push_back({static_cast<uint32_t>(chunk_data), length});
+    } else if (ChunkIs(type, "IEND")) {
+      break;
+    }
+    pos = chunk_data + length + 4;  // skip the CRC
+  }
+  info.layout = RasterLayout::PngFiltered;
+  info.compression = 8;
+  return header_read && !info.chunks.empty();
+}
+
+/**
+ * @brief Inflates a zlib stream split into `chunks`
+ */
+bool Inflate(const uint8_t *data, const std::vector<RasterImageInfo::Chunk> &chunks,
+             uint8_t *out, size_t out_size) {
+  z_stream stream;
+  std::memset(&stream, 0, sizeof(stream));
+  if (inflateInit(&stream) != Z_OK)
+    return false;
+  stream.next_out = out;
+  stream.avail_out = out_size;
+  int ret = Z_OK;
+  for (size_t i = 0; i < chunks.size() && ret == Z_OK; i++) {
+    stream.next_in = const_cast<Bytef *>(data + chunks[i].offset);
+    stream.avail_in = chunks[i].size;
+    while (stream.avail_in > 0 && ret == Z_OK)
+      ret = inflate(&stream, Z_NO_FLUSH);
+    if (ret == Z_BUF_ERROR && stream.avail_out == 0)
+      ret = Z_STREAM_END;  // trailing data after the image
+  }
+  bool complete = stream.avail_out == 0 && (ret == Z_OK || ret == Z_STREAM_END);
+  inflateEnd(&stream);
+  return complete;
+}
+
+bool ValidatePngFilters(const RasterImageInfo &info, const uint8_t *filtered) {
+  int64_t row_size = info.row_size();
+  for (int y = 0; y < info.height; y++) {
+    if (filtered[y * row_size] > 4)
+      return false;
+  }
+  return true;
+}
+
+// TIFF - https://www.itu.int/itudoc/itu-t/com16/tiff-fx/docs/tiff6.pdf
+
+enum TiffTag : uint16_t {
+  kImageWidth = 256,
+  kImageLength = 257,
+  kBitsPerSample = 258,
+  kCompression = 259,
+  kPhotometric = 262,
+  kFillOrder = 266,
+  kStripOffsets = 273,
+  kOrientation = 274,
+  kSamplesPerPixel = 277,
+  kRowsPerStrip = 278,
+  kStripByteCounts = 279,
+  kPlanarConfiguration = 284,
+  kPredictor = 317,
+  kColorMap = 320,
+  kTileWidth = 322,
+  kSampleFormat = 339,
+};
+
+class TiffReader {
+ public:
+  TiffReader(const uint8_t *data, size_t size, bool little_endian)
+  : data_(data), size_(size), little_endian_(little_endian) {}
+
+  bool Read16(size_t offset, uint32_t &value) const {
+    if (offset + 2 > size_)
+      return false;
+    value = little_endian_ ? ReadValueLE<uint16_t>(data_ + offset)
+                           : ReadValueBE<uint16_t>(data_ + offset);
+    return true;
+  }
+
+  bool Read32(size_t offset, uint32_t &value) const {
+    if (offset + 4 > size_)
+      return false;
+    value = little_endian_ ? ReadValueLE<uint32_t>(data_ + offset)
+                           : ReadValueBE<uint32_t>(data_ + offset);
+    return true;
+  }
+
+  /**
+   * @brief Reads the values of an IFD entry of the BYTE, SHORT or LONG type
+   */
+  bool ReadValues(size_t entry, std::vector<uint32_t> &values) const {
+    uint32_t type, count;
+    if (!Read16(entry + 2, type) || !Read32(entry + 4, count))
+      return false;
+    int value_size = type == 1 ? 1 : type == 3 ? 2 : type == 4 ? 4 : 0;
+    if (value_size == 0 || count == 0 || count > size_)
+      return false;
+    size_t offset = entry + 8;
+    if (static_cast<size_t>(count) * value_size > 4) {
+      uint32_t values_offset;
+      if (!Read32(entry + 8, values_offset))
+        return false;
+      offset = values_offset;
+    }
+    if (offset + static_cast<size_t>(count) * value_size > size_)
+      return false;
+    values.resize(count);
+    for (uint32_t i = 0; i < count; i++) {
+      size_t value_offset = offset + i * value_size;
+      if (value_size == 1)
+        values[i] = data_[value_offset];
+      else if (value_size == 2)
+        Read16(value_offset, values[i]);
+      else
+        Read32(value_offset, values[i]);
+    }
+    return true;
+  }
+
+ private:
+  const uint8_t *data_;
+  size_t size_;
+  bool little_endian_;
+};
+
+bool ParseTiff(const uint8_t *data, size_t size, RasterImageInfo &info) {
+  TiffReader reader(data, size, data[0] == 'I');
+  uint32_t ifd_offset, entry_count;
+  if (!reader.Read32(4, ifd_offset) || !reader.Read16(ifd_offset, entry_count))
+    return false;
+
+  uint32_t width = 0, height = 0, samples = 1, compression = 1, photometric = 2;
+  uint32_t rows_per_strip = std::numeric_limits<uint32_t>::max(), predictor = 1;
+  std::vector<uint32_t> offsets, byte_counts, values;
+  for (uint32_t i = 0; i < entry_count; i++) {
+    size_t entry = ifd_offset + 2 + i * 12;
+    uint32_t tag;
+    if (!reader.Read16(entry, tag))
+      return false;
+    switch (tag) {
+      case kTileWidth:
+      case kColorMap:
+        return false;
+      case kImageWidth:
+      case kImageLength:
+      case kBitsPerSample:
+      case kCompression:
+      case kPhotometric:
+      case kFillOrder:
+      case kStripOffsets:
+      case kOrientation:
+      case kSamplesPerPixel:
+      case kRowsPerStrip:
+      case kStripByteCounts:
+      case kPlanarConfiguration:
+      case kPredictor:
+      case kSampleFormat:
+        if (!reader.ReadValues(entry, values))
+          return false;
+        break;
+      default:
+        continue;
+    }
+    switch (tag) {
+      case kImageWidth:
+        width = values[0];
+        break;
+      case kImageLength:
+        height = values[0];
+        break;
+      case kBitsPerSample:
+        for (auto bits : values) {
+          if (bits != 8)
+            return false;
+        }
+        break;
+      case kCompression:
+        compression = values[0];
+        break;
+      case kPhotometric:
+        photometric = values[0];
+        break;
+      case kStripOffsets:
+        offsets = values;
+        break;
+      case kSamplesPerPixel:
+        samples = values[0];
+        break;
+      case kRowsPerStrip:
+        rows_per_strip = values[0];
+        break;
+      case kStripByteCounts:
+        byte_counts = values;
+        break;
+      case kPredictor:
+        predictor = values[0];
+        break;
+      default:  // the remaining tags are supported only with their default values
+        for (auto value : values) {
+          if (value != 1)
+            return false;
+        }
+        break;
+    }
+  }
+
+  if (width == 0 || height == 0 || width > (1u << 24) || height > (1u << 24))
+    return false;
+  if (!(photometric == 1 && samples == 1) && !(photometric == 2 && (samples == 3 || samples == 4)))
+    return false;
+  if (compression != 1 && compression != 5 && compression != 8 && compression != 32946)
+    return false;
+  if (predictor != 1 && predictor != 2)
+    return false;
+  rows_per_strip = std::min(rows_per_strip, height);
+  if (rows_per_strip == 0)
+    return false;
+  size_t num_strips = (height + rows_per_strip - 1) / rows_per_strip;
+  if (offsets.size() != num_strips || byte_counts.size() != num_strips)
+    return false;
+
+  info.chunks.resize(num_strips);
+  for (size_t s = 0; s < num_strips; s++) {
+    if (offsets[s] > size || byte_counts[s] > size - offsets[s])
+      return false;
+    info.chunks[s] = {offsets[s], byte_counts[s]};
+  }
+  info.width = width;
+  info.height = height;
+  info.channels = samples;
+  info.compression = compression;
+  info.rows_per_strip = rows_per_strip;
+  info.layout = predictor == 2 ? RasterLayout::TiffPredicted : RasterLayout::Tiff;
+  return true;
+}
+
+/**
+ * @brief Decodes a TIFF LZW strip (MSB-first codes, with the "early change" of the code width)
+ */
+bool LzwDecode(const uint8_t *in, size_t in_size, uint8_t *out, size_t out_size) {
+  constexpr int kClear = 256, kEndOfInfo = 257, kFirstCode = 258, kMaxCodes = 4096;
+  uint16_t prefix[kMaxCodes];
+  uint8_t suffix[kMaxCodes], first[kMaxCodes];
+  uint16_t length[kMaxCodes];
+  for (int i = 0; i < 256; i++) {
+    suffix[i] = first[i] = i;
+    length[i] = 1;
+  }
+  // the old-style (LSB-first) LZW, used by very old encoders, is not supported
+  if (in_size >= 2 && in[0] == 0 && (in[1] & 1))
+    return false;
+
+  int next = kFirstCode, width = 9, prev = -1;
+  uint32_t bit_buffer = 0;
+  int bits = 0;
+  size_t in_pos = 0, out_pos = 0;
+  while (out_pos < out_size) {
+    while (bits < width && in_pos < in_size) {
+      bit_buffer = (bit_buffer << 8) | in[in_pos++];
+      bits += 8;
+    }
+    if (bits < width)
+      break;
+    int code = (bit_buffer >> (bits - width)) & ((1 << width) - 1);
+    bits -= width;
+
+    if (code == kClear) {
+      next = kFirstCode;
+      width = 9;
+      prev = -1;
+      continue;
+    }
+    if (code == kEndOfInfo)
+      break;
+    if (prev < 0) {
+      if (code >= 256)
+        return false;
+      out[out_pos++] = code;
+      prev = code;
+      continue;
+    }
+    if (code > next || next >= kMaxCodes)
+      return false;
+    int new_first = code < next ? first[code] : first[prev];
+    prefix[next] = prev;
+    suffix[next] = new_first;
+    first[next] = first[prev];
+    length[next] = length[prev] + 1;
+    next++;
+    if (next + 1 >= (1 << width) && width < 12)
+      width++;
+
+    // the string is written from its end; it's truncated if it doesn't fit
+    int len = length[code];
+    int c = code;
+    for (int i = len - 1; i >= 0; i--, c = prefix[c]) {
+      if (out_pos + i < out_size)
+        out[out_pos + i] = suffix[c];
+    }
+    out_pos = std::min(out_pos + len, out_size);
+    prev = code;
+  }
+  return out_pos == out_size;
+}
+
+bool DecompressTiff(const uint8_t *data, const RasterImageInfo &info, uint8_t *out) {
+  int64_t row_size = info.row_size();
+  for (size_t s = 0; s < info.chunks.size(); s++) {
+    int64_t first_row = static_cast<int64_t>(s) * info.rows_per_strip;
+    int64_t rows = std::min<int64_t>(info.rows_per_strip, info.height - first_row);
+    size_t strip_size = rows * row_size;
+    uint8_t *strip_out = out + first_row * row_size;
+    const auto &strip = info.chunks[s];
+    bool ok;
+    switch (info.compression) {
+      case 1:
+        ok = strip.size >= strip_size;
+        if (ok)
+          std::memcpy(strip_out, data + strip.offset, strip_size);
+        break;
+      case 5:
+        ok = LzwDecode(data + strip.offset, strip.size, strip_out, strip_size);
+        break;
+      default:
+        ok = Inflate(data, {strip}, strip_out, strip_size);
+        break;
+    }
+    if (!ok)
+      return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+bool ParseRasterImage(const uint8_t *data, size_t size, RasterImageInfo &info) {
+  bool ok = false;
+  if (size >= sizeof(kPngSignature) && !std::memcmp(data, kPngSignature, sizeof(kPngSignature)))
+    ok = ParsePng(data, size, info);
+  else if (size >= 8 && ((data[0] == 'I' && data[1] == 'I' && data[2] == 42 && data[3] == 0) ||
+                         (data[0] == 'M' && data[1] == 'M' && data[2] == 0 && data[3] == 42)))
+    ok = ParseTiff(data, size, info);
+  return ok && info.decompressed_size() <= kMaxDecompressedSize;
+}
+
+bool DecompressRasterImage(const uint8_t *data, size_t size, const RasterImageInfo &info,
+                           uint8_t *out) {
+  if (info.layout == RasterLayout::PngFiltered) {
+    return Inflate(data, info.chunks, out, info.decompressed_size()) &&
+           ValidatePngFilters(info, out);
+  }
+  return DecompressTiff(data, info, out);
+}
+
+}  // namespace dali
@@ -0,0 +1,95 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_DECODER_NVJPEG_RASTER_IMAGE_H_
+#define DALI_OPERATORS_DECODER_NVJPEG_RASTER_IMAGE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "dali/core/api_helper.h"
+
+namespace dali {
+
+/**
+ * @brief The layout of the decompressed data of a PNG or TIFF image
+ */
+enum class RasterLayout : int {
+  /// PNG scanlines, each preceded with the filter type byte
+  PngFiltered = 0,
+  /// TIFF pixels, row by row, without any prediction
+  Tiff = 1,
+  /// TIFF pixels, with the horizontal differencing predictor applied
+  TiffPredicted = 2,
+};
+
+/**
+ * @brief Describes a PNG or TIFF image, whose reconstruction can be done on the GPU
+ *
+ * Only the decompression (deflate or LZW) is done on the CPU. The PNG unfiltering,
+ * the reversal of the TIFF predictor and the conversion to the output color space
+ * are left for the GPU.
+ */
+struct RasterImageInfo {
+  RasterLayout layout = RasterLayout::PngFiltered;
+  int height = 0;
+  int width = 0;
+  /// the number of 8-bit samples per pixel: 1 (gray), 3 (RGB) or 4 (RGBA)
+  int channels = 0;
+
+  /// TIFF compression scheme: 1 (none), 5 (LZW) or 8/32946 (deflate); PNG always uses deflate
+  int compression = 8;
+  /// the number of rows in a TIFF strip
+  int rows_per_strip = 0;
+
+  struct Chunk {
+    uint32_t offset;
+    uint32_t size;
+  };
+  /// TIFF strips or PNG IDAT chunks, in order
+  std::vector<Chunk> chunks;
+
+  int64_t row_size() const {
+    return static_cast<int64_t>(width) * channels + (layout == RasterLayout::PngFiltered);
+  }
+
+  /// the size of the decompressed data, in bytes
+  int64_t decompressed_size() const {
+    return row_size() * height;
+  }
+};
+
+/**
+ * @brief Checks if the image is a PNG or TIFF, which the GPU path can decode, and reads its layout
+ *
+ * Supported are non-interlaced, 8-bit gray, RGB and RGBA PNG images without a palette
+ * or transparency chunk, and 8-bit gray, RGB and RGBA TIFF images with contiguous samples,
+ * stored in strips, either uncompressed or compressed with LZW or deflate.
+ *
+ * @return false, if the image is not supported (it should be decoded with the host decoder)
+ */
+DLL_PUBLIC bool ParseRasterImage(const uint8_t *data, size_t size, RasterImageInfo &info);
+
+/**
+ * @brief Decompresses the image data to `out`, of `info.decompressed_size()` bytes
+ *
+ * @return false, if the data is corrupted (it should be decoded with the host decoder,
+ *         to report the error)
+ */
+DLL_PUBLIC bool DecompressRasterImage(const uint8_t *data, size_t size,
+                                      const RasterImageInfo &info, uint8_t *out);
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_DECODER_NVJPEG_RASTER_IMAGE_H_
@@ -0,0 +1,280 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <zlib.h>
+#include <map>
+#include <string>
+#include <vector>
+#include "dali/operators/decoder/nvjpeg/raster_image.h"
+
+namespace dali {
+
+namespace {
+
+void PutBE(std::vector<uint8_t> &out, uint32_t value, int bytes) {
+  for (int i = bytes - 1; i >= 0; i--)
+    out.push_back(value >> (8 * i));
+}
+
+void PutLE(std::vector<uint8_t> &out, uint32_t value, int bytes) {
+  for (int i = 0; i < bytes; i++)
+    out.push_back(value >> (8 * i));
+}
+
+std::vector<uint8_t> Deflate(const std::vector<uint8_t> &data) {
+  uLongf size = compressBound(data.size());
+  std::vector<uint8_t> out(size);
+  EXPECT_EQ(compress2(out.data(), &size, data.data(), data.size(), 9), Z_OK);
+  out.resize(size);
+  return out;
+}
+
+std::vector<uint8_t> TestPixels(int height, int width, int channels) {
+  std::vector<uint8_t> pixels(height * width * channels);
+  for (size_t i = 0; i < pixels.size(); i++)
+    pixels[i] = (i * 7 + i / 13) & 0xFF;
+  return pixels;
+}
+
+void PngChunk(std::vector<uint8_t> &png, const char *type, const std::vector<uint8_t> &data) {
+  PutBE(png, data.size(), 4);
+  png.insert(png.end(), type, type + 4);
+  png.insert(png.end(), data.begin(), data.end());
+  PutBE(png, 0, 4);  // the CRC isn't checked
+}
+
+/**
+ * @brief Creates a PNG of the given filtered rows, with the deflated data split into
+ *        two IDAT chunks
+ */
+std::vector<uint8_t> CreatePng(int height, int width, int color_type,
+                               const std::vector<uint8_t> &filtered) {
+  std::vector<uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+  std::vector<uint8_t> header;
+  PutBE(header, width, 4);
+  PutBE(header, height, 4);
+  header.insert(header.end(), {8, static_cast<uint8_t>(color_type), 0, 0, 0});
+  PngChunk(png, "IHDR", header);
+  PngChunk(png, "tEXt", {'a', 0, 'b'});
+  auto compressed = Deflate(filtered);
+  size_t half = compressed.size() / 2;
+  PngChunk(png, "IDAT", {compressed.begin(), compressed.begin() + half});
+  PngChunk(png, "IDAT", {compressed.begin() + half, compressed.end()});
+  PngChunk(png, "IEND", {});
+  return png;
+}
+
+/**
+ * @brief A TIFF LZW encoder, matching the code width changes of the decoder
+ */
+std::vector<uint8_t> LzwEncode(const std::vector<uint8_t> &data) {
+  std::vector<int> codes;
+  std::map<std::string, int> dict;
+  int next = 258;
+  std::string w;
+  auto code_of = [&](const std::string &s) {
+    return s.size() == 1 ? static_cast<uint8_t>(s[0]) : dict[s];
+  };
+  for (uint8_t c : data) {
+    std::string wc = w + static_cast<char>(c);
+    if (wc.size() == 1 || dict.count(wc)) {
+      w = wc;
+    } else {
+      codes.push_back(code_of(w));
+      dict[wc] = next++;
+      w = std::string(1, static_cast<char>(c));
+    }
+  }
+  codes.push_back(code_of(w));
+  codes.push_back(257);
+
+  std::vector<uint8_t> out;
+  uint32_t bit_buffer = 0;
+  int bits = 0;
+  auto write = [&](int code, int width) {
+    bit_buffer = (bit_buffer << width) | code;
+    bits += width;
+    while (bits >= 8) {
+      out.push_back(bit_buffer >> (bits - 8));
+      bits -= 8;
+    }
+  };
+  write(256, 9);
+  for (size_t k = 0; k < codes.size(); k++) {
+    int width = 9;
+    while (258 + static_cast<int>(k) >= (1 << width) && width < 12)
+      width++;
+    write(codes[k], width);
+  }
+  if (bits > 0)
+    out.push_back(bit_buffer << (8 - bits));
+  return out;
+}
+
+/**
+ * @brief Creates a little-endian TIFF with the given strips, one row per strip
+ */
+std::vector<uint8_t> CreateTiff(int height, int width, int channels, int compression,
+                                int predictor, const std::vector<std::vector<uint8_t>> &strips) {
+  std::vector<uint8_t> tiff = {'I', 'I', 42, 0};
+  PutLE(tiff, 8, 4);
+  struct Entry {
+    uint16_t tag, type;
+    uint32_t value;
+  };
+  std::vector<Entry> entries = {
+    {256, 3, static_cast<uint32_t>(width)},
+    {257, 3, static_cast<uint32_t>(height)},
+    {259, 3, static_cast<uint32_t>(compression)},
+    {262, 3, channels == 1 ? 1u : 2u},
+    {273, 4, 0},  // the strip offsets, filled below
+    {277, 3, static_cast<uint32_t>(channels)},
+    {278, 3, 1},
+    {279, 4, 0},  // the strip byte counts, filled below
+    {317, 3, static_cast<uint32_t>(predictor)},
+  };
+  const size_t ifd_size = 2 + entries.size() * 12 + 4;
+  const size_t offsets_pos = 8 + ifd_size, counts_pos = offsets_pos + 4 * strips.size();
+  size_t data_pos = counts_pos + 4 * strips.size();
+  PutLE(tiff, entries.size(), 2);
+  for (auto &e : entries) {
+    PutLE(tiff, e.tag, 2);
+    PutLE(tiff, e.type, 2);
+    if ((e.tag == 273 || e.tag == 279) && strips.size() > 1) {
+      PutLE(tiff, strips.size(), 4);
+      PutLE(tiff, e.tag == 273 ? offsets_pos : counts_pos, 4);
+    } else if (e.tag == 273 || e.tag == 279) {  // a single value is stored in the entry
+      PutLE(tiff, 1, 4);
+      PutLE(tiff, e.tag == 273 ? data_pos : strips[0].size(), 4);
+    } else {
+      PutLE(tiff, 1, 4);
+      PutLE(tiff, e.value, 4);  // a SHORT, left-justified
+    }
+  }
+  PutLE(tiff, 0, 4);  // no next IFD
+  for (auto &strip : strips) {
+    PutLE(tiff, data_pos, 4);
+    data_pos += strip.size();
+  }
+  for (auto &strip : strips)
+    PutLE(tiff, strip.size(), 4);
+  for (auto &strip : strips)
+    tiff.insert(tiff.end(), strip.begin(), strip.end());
+  return tiff;
+}
+
+std::vector<uint8_t> Decompress(const std::vector<uint8_t> &encoded,
+                                const RasterImageInfo &info) {
+  std::vector<uint8_t> out(info.decompressed_size());
+  EXPECT_TRUE(DecompressRasterImage(encoded.data(), encoded.size(), info, out.data()));
+  return out;
+}
+
+}  // namespace
+
+TEST(RasterImage, Png) {
+  const int height = 20, width = 17, channels = 3;
+  auto pixels = TestPixels(height, width, channels);
+  std::vector<uint8_t> filtered;
+  for (int y = 0; y < height; y++) {
+    filtered.push_back(y % 5);  // the filter types aren't reversed on the host
+    filtered.insert(filtered.end(), pixels.begin() + y * width * channels,
+                    pixels.begin() + (y + 1) * width * channels);
+  }
+  auto png = CreatePng(height, width, 2, filtered);
+
+  RasterImageInfo info;
+  ASSERT_TRUE(ParseRasterImage(png.data(), png.size(), info));
+  EXPECT_EQ(info.layout, RasterLayout::PngFiltered);
+  EXPECT_EQ(info.height, height);
+  EXPECT_EQ(info.width, width);
+  EXPECT_EQ(info.channels, channels);
+  EXPECT_EQ(info.chunks.size(), 2u);
+  EXPECT_EQ(info.decompressed_size(), static_cast<int64_t>(filtered.size()));
+  EXPECT_EQ(Decompress(png, info), filtered);
+
+  // an invalid filter type
+  filtered[width * channels + 1] = 5;
+  png = CreatePng(height, width, 2, filtered);
+  ASSERT_TRUE(ParseRasterImage(png.data(), png.size(), info));
+  std::vector<uint8_t> out(info.decompressed_size());
+  EXPECT_FALSE(DecompressRasterImage(png.data(), png.size(), info, out.data()));
+}
+
+TEST(RasterImage, PngUnsupported) {
+  std::vector<uint8_t> filtered(2 * 3, 0);
+  RasterImageInfo info;
+  auto palette = CreatePng(2, 2, 3, filtered);
+  EXPECT_FALSE(ParseRasterImage(palette.data(), palette.size(), info));
+  auto gray_alpha = CreatePng(2, 2, 4, filtered);
+  EXPECT_FALSE(ParseRasterImage(gray_alpha.data(), gray_alpha.size(), info));
+  auto truncated = CreatePng(2, 2, 0, filtered);
+  truncated.resize(20);
+  EXPECT_FALSE(ParseRasterImage(truncated.data(), truncated.size(), info));
+  const uint8_t jpeg[] = {0xFF, 0xD8, 0xFF, 0xE0, 0, 0x10, 'J', 'F', 'I', 'F'};
+  EXPECT_FALSE(ParseRasterImage(jpeg, sizeof(jpeg), info));
+}
+
+TEST(RasterImage, Tiff) {
+  const int height = 16, width = 13, channels = 4;
+  auto pixels = TestPixels(height, width, channels);
+  const int row_size = width * channels;
+  for (int compression : {1, 5, 8}) {
+    std::vector<std::vector<uint8_t>> strips;
+    for (int y = 0; y < height; y++) {
+      std::vector<uint8_t> row(pixels.begin() + y * row_size, pixels.begin() + (y + 1) * row_size);
+      if (compression == 5)
+        row = LzwEncode(row);
+      else if (compression == 8)
+        row = Deflate(row);
+      strips.push_back(row);
+    }
+    auto tiff = CreateTiff(height, width, channels, compression, 2, strips);
+
+    RasterImageInfo info;
+    ASSERT_TRUE(ParseRasterImage(tiff.data(), tiff.size(), info)) << compression;
+    EXPECT_EQ(info.layout, RasterLayout::TiffPredicted);
+    EXPECT_EQ(info.height, height);
+    EXPECT_EQ(info.width, width);
+    EXPECT_EQ(info.channels, channels);
+    EXPECT_EQ(info.rows_per_strip, 1);
+    EXPECT_EQ(info.chunks.size(), static_cast<size_t>(height));
+    EXPECT_EQ(Decompress(tiff, info), pixels) << compression;
+  }
+}
+
+TEST(RasterImage, TiffLzwCodeWidths) {
+  // long enough to switch to 10 and 11-bit codes
+  const int height = 1, width = 1200, channels = 3;
+  auto pixels = TestPixels(height, width, channels);
+  auto tiff = CreateTiff(height, width, channels, 5, 1, {LzwEncode(pixels)});
+  RasterImageInfo info;
+  ASSERT_TRUE(ParseRasterImage(tiff.data(), tiff.size(), info));
+  EXPECT_EQ(info.layout, RasterLayout::Tiff);
+  EXPECT_EQ(Decompress(tiff, info), pixels);
+}
+
+TEST(RasterImage, TiffUnsupported) {
+  RasterImageInfo info;
+  std::vector<std::vector<uint8_t>> strips(2, std::vector<uint8_t>(6));
+  auto jpeg_compressed = CreateTiff(2, 2, 3, 7, 1, strips);
+  EXPECT_FALSE(ParseRasterImage(jpeg_compressed.data(), jpeg_compressed.size(), info));
+  auto float_predictor = CreateTiff(2, 2, 3, 1, 3, strips);
+  EXPECT_FALSE(ParseRasterImage(float_predictor.data(), float_predictor.size(), info));
+  auto missing_strip = CreateTiff(3, 2, 3, 1, 1, strips);
+  EXPECT_FALSE(ParseRasterImage(missing_strip.data(), missing_strip.size(), info));
+}
+
+}  // namespace dali
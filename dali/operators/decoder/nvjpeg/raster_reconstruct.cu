@@ -0,0 +1,166 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include "dali/core/convert.h"
+#include "dali/core/error_handling.h"
+#include "dali/core/util.h"
+#include "dali/kernels/imgproc/color_manipulation/color_space_conversion_impl.h"
+#include "dali/operators/decoder/nvjpeg/raster_reconstruct.h"
+
+namespace dali {
+
+namespace {
+
+constexpr int kReconstructBlock = 256;
+constexpr int kConvertBlock = 256;
+
+__device__ DALI_FORCEINLINE uint8_t PaethPredictor(int a, int b, int c) {
+  int p = a + b - c;
+  int pa = abs(p - a), pb = abs(p - b), pc = abs(p - c);
+  if (pa <= pb && pa <= pc)
+    return a;
+  return pb <= pc ? b : c;
+}
+
+/**
+ * @brief Reverses the PNG filters of one image; run by a whole block
+ *
+ * The rows depend on each other, so they're processed one by one. The Up filter is computed
+ * by all the threads of the block, the others - by one thread per channel.
+ */
+__device__ void UnfilterPng(const RasterSampleDesc &sample) {
+  const int bpp = sample.in_channels;
+  const int64_t stride = static_cast<int64_t>(sample.width) * bpp;
+  const uint8_t *prev = nullptr;
+  for (int y = 0; y < sample.height; y++) {
+    uint8_t *row = sample.data + y * (stride + 1);
+    int filter = row[0];
+    uint8_t *cur = row + 1;
+    switch (filter) {
+      case 1:  // Sub
+        if (threadIdx.x < bpp) {
+          for (int64_t i = threadIdx.x + bpp; i < stride; i += bpp)
+            cur[i] += cur[i - bpp];
+        }
+        break;
+      case 2:  // Up
+        if (prev) {
+          for (int64_t i = threadIdx.x; i < stride; i += blockDim.x)
+            cur[i] += prev[i];
+        }
+        break;
+      case 3:  // Average
+        if (threadIdx.x < bpp) {
+          for (int64_t i = threadIdx.x; i < stride; i += bpp) {
+            int left = i >= bpp ? cur[i - bpp] : 0;
+            int up = prev ? prev[i] : 0;
+            cur[i] += (left + up) >> 1;
+          }
+        }
+        break;
+      case 4:  // Paeth
+        if (threadIdx.x < bpp) {
+          for (int64_t i = threadIdx.x; i < stride; i += bpp) {
+            int left = i >= bpp ? cur[i - bpp] : 0;
+            int up = prev ? prev[i] : 0;
+            int up_left = prev && i >= bpp ? prev[i - bpp] : 0;
+            cur[i] += PaethPredictor(left, up, up_left);
+          }
+        }
+        break;
+      default:  // None
+        break;
+    }
+    __syncthreads();
+    prev = cur;
+  }
+}
+
+/**
+ * @brief Reverses the TIFF horizontal differencing predictor; one thread per row
+ */
+__device__ void UnpredictTiff(const RasterSampleDesc &sample) {
+  const int c = sample.in_channels;
+  const int64_t stride = static_cast<int64_t>(sample.width) * c;
+  for (int y = threadIdx.x; y < sample.height; y += blockDim.x) {
+    uint8_t *row = sample.data + y * stride;
+    for (int64_t i = c; i < stride; i++)
+      row[i] += row[i - c];
+  }
+}
+
+__global__ void RasterReconstructKernel(const RasterSampleDesc *samples) {
+  const auto &sample = samples[blockIdx.x];
+  if (sample.layout == RasterLayout::PngFiltered)
+    UnfilterPng(sample);
+  else if (sample.layout == RasterLayout::TiffPredicted)
+    UnpredictTiff(sample);
+}
+
+__global__ void RasterConvertKernel(const RasterSampleDesc *samples, DALIImageType out_type) {
+  const auto &sample = samples[blockIdx.y];
+  const int in_c = sample.in_channels, out_c = sample.out_channels;
+  const int64_t npixels = static_cast<int64_t>(sample.height) * sample.width;
+  const int64_t row_size = static_cast<int64_t>(sample.width) * in_c +
+                           (sample.layout == RasterLayout::PngFiltered);
+  const int skip = sample.layout == RasterLayout::PngFiltered;  // the filter type byte
+  for (int64_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < npixels;
+       idx += blockDim.x * gridDim.x) {
+    int64_t y = idx / sample.width;
+    int64_t x = idx - y * sample.width;
+    const uint8_t *in = sample.data + y * row_size + skip + x * in_c;
+    uint8_t *out = sample.output + idx * out_c;
+    if (out_type == DALI_ANY_DATA) {
+      for (int c = 0; c < out_c; c++)
+        out[c] = in[c];
+    } else if (out_type == DALI_GRAY) {
+      if (in_c < 3) {
+        out[0] = in[0];
+      } else {
+        vec<3, float> rgb = {ConvertNorm<float>(in[0]), ConvertNorm<float>(in[1]),
+                             ConvertNorm<float>(in[2])};
+        out[0] = kernels::color::rgb_to_gray<uint8_t>(rgb);
+      }
+    } else {
+      uint8_t r = in[0], g = in_c < 3 ? in[0] : in[1], b = in_c < 3 ? in[0] : in[2];
+      if (out_type == DALI_BGR) {
+        out[0] = b;
+        out[1] = g;
+        out[2] = r;
+      } else {
+        out[0] = r;
+        out[1] = g;
+        out[2] = b;
+      }
+    }
+  }
+}
+
+}  // namespace
+
+void RasterReconstruct(const RasterSampleDesc *samples, int num_samples, int64_t max_pixels,
+                       DALIImageType out_type, cudaStream_t stream) {
+  if (num_samples == 0)
+    return;
+  DALI_ENFORCE(out_type == DALI_RGB || out_type == DALI_BGR || out_type == DALI_GRAY ||
+               out_type == DALI_ANY_DATA, "Unsupported output color space");
+  RasterReconstructKernel<<<num_samples, kReconstructBlock, 0, stream>>>(samples);
+  CUDA_CALL(cudaGetLastError());
+  int blocks = std::min<int64_t>(std::max<int64_t>(div_ceil(max_pixels, kConvertBlock), 1), 1024);
+  RasterConvertKernel<<<dim3(blocks, num_samples), kConvertBlock, 0, stream>>>(samples, out_type);
+  CUDA_CALL(cudaGetLastError());
+}
+
+}  // namespace dali
@@ -0,0 +1,58 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_DECODER_NVJPEG_RASTER_RECONSTRUCT_H_
+#define DALI_OPERATORS_DECODER_NVJPEG_RASTER_RECONSTRUCT_H_
+
+#include <cuda_runtime.h>
+#include <stdint.h>
+#include "dali/operators/decoder/nvjpeg/raster_image.h"
+#include "dali/pipeline/data/types.h"
+
+namespace dali {
+
+/**
+ * @brief A decompressed PNG or TIFF image, to be reconstructed on the GPU
+ */
+struct RasterSampleDesc {
+  /// the decompressed data (see RasterLayout), in device memory; it's modified in place
+  uint8_t *data;
+  /// the interleaved output image
+  uint8_t *output;
+  int height;
+  int width;
+  int in_channels;
+  int out_channels;
+  RasterLayout layout;
+};
+
+/**
+ * @brief Reconstructs the images from their decompressed data and converts them to `out_type`
+ *
+ * The PNG filters and the TIFF horizontal predictor are reversed in place and then
+ * the pixels are converted to the output color space:
+ *  - RGB and BGR - the alpha channel is dropped, gray images are replicated to 3 channels,
+ *  - GRAY - the color images are converted with the JPEG (BT.601) luma coefficients,
+ *  - ANY_DATA - the channels are copied as they are (`out_channels == in_channels`).
+ *
+ * @param samples       descriptors of the samples, in device memory
+ * @param num_samples   the number of samples
+ * @param max_pixels    the largest number of pixels in a sample
+ */
+void RasterReconstruct(const RasterSampleDesc *samples, int num_samples, int64_t max_pixels,
+                       DALIImageType out_type, cudaStream_t stream);
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_DECODER_NVJPEG_RASTER_RECONSTRUCT_H_
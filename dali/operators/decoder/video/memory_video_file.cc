@@ -0,0 +1,179 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/decoder/video/memory_video_file.h"
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace dali {
+
+namespace {
+
+#undef av_err2str
+std::string av_err2str(int errnum) {
+  char errbuf[AV_ERROR_MAX_STRING_SIZE];
+  av_strerror(errnum, errbuf, AV_ERROR_MAX_STRING_SIZE);
+  return std::string{errbuf};
+}
+
+const char *BitstreamFilterName(AVCodecID codec_id, const char *format_name) {
+  switch (codec_id) {
+    case AV_CODEC_ID_H264:
+      return "h264_mp4toannexb";
+    case AV_CODEC_ID_HEVC:
+      return "hevc_mp4toannexb";
+    case AV_CODEC_ID_MPEG4:
+      return strcmp(format_name, "avi") ? "null" : "mpeg4_unpack_bframes";
+    case AV_CODEC_ID_VP8:
+    case AV_CODEC_ID_VP9:
+    case AV_CODEC_ID_MJPEG:
+      return "null";
+    default:
+      return nullptr;
+  }
+}
+
+}  // namespace
+
+int MemoryVideoFile::ReadPacket(void *opaque, uint8_t *buf, int buf_size) {
+  auto *file = static_cast<MemoryVideoFile *>(opaque);
+  int64_t left = file->size_ - file->position_;
+  if (left <= 0)
+    return AVERROR_EOF;
+  int n = std::min<int64_t>(buf_size, left);
+  std::memcpy(buf, file->data_ + file->position_, n);
+  file->position_ += n;
+  return n;
+}
+
+int64_t MemoryVideoFile::Seek(void *opaque, int64_t offset, int whence) {
+  auto *file = static_cast<MemoryVideoFile *>(opaque);
+  int64_t position;
+  switch (whence & ~AVSEEK_FORCE) {
+    case SEEK_SET:
+      position = offset;
+      break;
+    case SEEK_CUR:
+      position = file->position_ + offset;
+      break;
+    case SEEK_END:
+      position = file->size_ + offset;
+      break;
+    case AVSEEK_SIZE:
+      return file->size_;
+    default:
+      return -1;
+  }
+  if (position < 0 || position > file->size_)
+    return -1;
+  file->position_ = position;
+  return position;
+}
+
+MemoryVideoFile::MemoryVideoFile(const uint8_t *data, int64_t size, std::string source_info)
+    : data_(data), size_(size), source_info_(std::move(source_info)) {
+  DALI_ENFORCE(size > 0, make_string("Empty video file ", source_info_));
+  constexpr size_t kAvioBufferSize = 4096;
+  auto avio_buffer = std::unique_ptr<uint8_t, void(*)(void*)>(
+      static_cast<uint8_t*>(av_malloc(kAvioBufferSize)), av_free);
+  DALI_ENFORCE(avio_buffer, "Failed to allocate the I/O buffer");
+  avio_ctx_ = av_unique_ptr<AVIOContext>(
+      avio_alloc_context(avio_buffer.get(), kAvioBufferSize, 0, this, &ReadPacket, nullptr,
+                         &Seek),
+      [](AVIOContext *ctx) {
+        // the buffer may have been reallocated by libavformat
+        av_freep(&ctx->buffer);
+        avio_context_free(&ctx);
+      });
+  DALI_ENFORCE(avio_ctx_, "Failed to allocate the I/O context");
+  avio_buffer.release();  // owned by the I/O context now
+
+  AVFormatContext *raw_fmt_ctx = avformat_alloc_context();
+  DALI_ENFORCE(raw_fmt_ctx, "Failed to allocate the format context");
+  raw_fmt_ctx->pb = avio_ctx_.get();
+  raw_fmt_ctx->flags |= AVFMT_FLAG_CUSTOM_IO;
+  // if avformat_open_input fails, it frees the context
+  int ret = avformat_open_input(&raw_fmt_ctx, nullptr, nullptr, nullptr);
+  DALI_ENFORCE(ret >= 0, make_string("Could not open video file ", source_info_, " because of ",
+                                     av_err2str(ret)));
+  fmt_ctx_ = make_unique_av<AVFormatContext>(raw_fmt_ctx, avformat_close_input);
+
+  DALI_ENFORCE(avformat_find_stream_info(fmt_ctx_.get(), nullptr) >= 0,
+               make_string("Could not find stream information in ", source_info_));
+  int stream_idx = av_find_best_stream(fmt_ctx_.get(), AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+  DALI_ENFORCE(stream_idx >= 0, make_string("Could not find video stream in ", source_info_));
+  auto *stream = fmt_ctx_->streams[stream_idx];
+  stream_base_ = stream->time_base;
+  start_time_ = stream->start_time == AV_NOPTS_VALUE ? 0 : stream->start_time;
+
+  auto codec_id = codecpar(stream)->codec_id;
+  const char *filter_name = BitstreamFilterName(codec_id, fmt_ctx_->iformat->name);
+  DALI_ENFORCE(filter_name, make_string("Unhandled codec ", codec_id, " in ", source_info_));
+  auto *bsf = av_bsf_get_by_name(filter_name);
+  DALI_ENFORCE(bsf, "Error finding bit stream filter.");
+  AVBSFContext *raw_bsf_ctx = nullptr;
+  DALI_ENFORCE(av_bsf_alloc(bsf, &raw_bsf_ctx) >= 0,
+               "Error allocating bit stream filter context.");
+  bsf_ctx_ = make_unique_av<AVBSFContext>(raw_bsf_ctx, av_bsf_free);
+  DALI_ENFORCE(avcodec_parameters_copy(bsf_ctx_->par_in, codecpar(stream)) >= 0,
+               "Error setting BSF parameters.");
+  bsf_ctx_->time_base_in = stream->time_base;
+  DALI_ENFORCE(av_bsf_init(bsf_ctx_.get()) >= 0, "Error initializing BSF.");
+
+  ReadPackets(stream_idx);
+  DALI_ENFORCE(!packets_.empty(), make_string("No video frames found in ", source_info_));
+}
+
+const CodecParameters *MemoryVideoFile::codec_params() const {
+  return bsf_ctx_->par_out;
+}
+
+void MemoryVideoFile::ReadPackets(int stream_idx) {
+  auto new_packet = []() {
+    return make_unique_av<AVPacket>(av_packet_alloc(), av_packet_free);
+  };
+  auto receive_filtered = [&]() {
+    for (;;) {
+      auto filtered = new_packet();
+      int ret = av_bsf_receive_packet(bsf_ctx_.get(), filtered.get());
+      if (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF)
+        break;
+      DALI_ENFORCE(ret >= 0, make_string("BSF receive packet failed: ", av_err2str(ret)));
+      packets_.push_back(std::move(filtered));
+    }
+  };
+
+  auto pkt = new_packet();
+  int ret;
+  while ((ret = av_read_frame(fmt_ctx_.get(), pkt.get())) >= 0) {
+    if (pkt->stream_index != stream_idx || pkt->size == 0) {
+      av_packet_unref(pkt.get());
+      continue;
+    }
+    // the filter takes over the reference to the packet data
+    ret = av_bsf_send_packet(bsf_ctx_.get(), pkt.get());
+    DALI_ENFORCE(ret >= 0, make_string("BSF send packet failed: ", av_err2str(ret)));
+    receive_filtered();
+  }
+  DALI_ENFORCE(ret == AVERROR_EOF, make_string("Error reading video file ", source_info_,
+                                               ": ", av_err2str(ret)));
+  // flush the filter
+  av_bsf_send_packet(bsf_ctx_.get(), nullptr);
+  receive_filtered();
+}
+
+}  // namespace dali
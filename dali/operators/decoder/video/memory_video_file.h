@@ -0,0 +1,103 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_DECODER_VIDEO_MEMORY_VIDEO_FILE_H_
+#define DALI_OPERATORS_DECODER_VIDEO_MEMORY_VIDEO_FILE_H_
+
+#include <string>
+#include <vector>
+#include "dali/core/common.h"
+#include "dali/operators/reader/loader/video_loader.h"
+
+namespace dali {
+
+/**
+ * @brief Demuxes a video file held in memory
+ *
+ * The container is read by libavformat through a custom I/O context, which reads from
+ * the buffer, so the data never goes through the file system. All the packets of the best
+ * video stream are read, and filtered to the form expected by NVDEC (e.g. H.264 Annex B),
+ * when the object is created - the buffer is not used afterwards.
+ */
+class DLL_PUBLIC MemoryVideoFile {
+ public:
+  /**
+   * @param source_info used in the error messages
+   */
+  MemoryVideoFile(const uint8_t *data, int64_t size, std::string source_info);
+
+  MemoryVideoFile(const MemoryVideoFile &) = delete;
+  MemoryVideoFile &operator=(const MemoryVideoFile &) = delete;
+
+  /// the parameters of the filtered video stream
+  const CodecParameters *codec_params() const;
+
+  int width() const {
+    return codec_params()->width;
+  }
+
+  int height() const {
+    return codec_params()->height;
+  }
+
+  AVCodecID codec_id() const {
+    return codec_params()->codec_id;
+  }
+
+  /// the number of frames, one per packet
+  int num_frames() const {
+    return packets_.size();
+  }
+
+  /// the packets of the video stream, in the decoding order
+  const std::vector<av_unique_ptr<AVPacket>> &packets() const {
+    return packets_;
+  }
+
+  AVRational stream_base() const {
+    return stream_base_;
+  }
+
+  int64_t start_time() const {
+    return start_time_;
+  }
+
+  const std::string &source_info() const {
+    return source_info_;
+  }
+
+ private:
+  static int ReadPacket(void *opaque, uint8_t *buf, int buf_size);
+  static int64_t Seek(void *opaque, int64_t offset, int whence);
+
+  /// Reads the packets of the stream `stream_idx` and passes them through the bitstream filter
+  void ReadPackets(int stream_idx);
+
+  const uint8_t *data_ = nullptr;
+  int64_t size_ = 0;
+  int64_t position_ = 0;
+  std::string source_info_;
+
+  // the format context is closed before the I/O context it reads from is freed
+  av_unique_ptr<AVIOContext> avio_ctx_;
+  av_unique_ptr<AVFormatContext> fmt_ctx_;
+  av_unique_ptr<AVBSFContext> bsf_ctx_;
+  std::vector<av_unique_ptr<AVPacket>> packets_;
+  AVRational stream_base_ = {0, 1};
+  int64_t start_time_ = 0;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_DECODER_VIDEO_MEMORY_VIDEO_FILE_H_
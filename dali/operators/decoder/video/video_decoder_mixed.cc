@@ -0,0 +1,240 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/decoder/video/video_decoder_mixed.h"
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "dali/core/device_guard.h"
+
+namespace dali {
+
+DALI_SCHEMA(decoders__Video)
+  .DocStr(R"code(Decodes the video files held in memory, with NVDEC.
+
+The input is a batch of 1D ``UINT8`` tensors with the encoded files - e.g. the contents of MP4,
+MKV or AVI files, or raw H.264/HEVC streams - read by any reader or fed with ``external_source``.
+Each file is demuxed in memory and all the frames of its best video stream are decoded.
+
+The output is a ``FHWC`` sequence with all the frames of the sample. Supported codecs are H.264,
+HEVC, VP8, VP9, MPEG4 and MJPEG; interlaced videos are not supported.
+)code")
+  .NumInput(1)
+  .NumOutput(1)
+  .InputLayout(0, { "" })
+  .AddOptionalArg("image_type",
+      R"(The color space of the output frames (RGB or YCbCr).)",
+      DALI_RGB)
+  .AddOptionalArg("dtype",
+      R"(Output data type.
+
+Supported types: ``UINT8``, ``FLOAT16`` or ``FLOAT``.)",
+      DALI_UINT8)
+  .AddOptionalArg("normalized",
+      R"code(Gets the output as normalized data.)code",
+      false)
+  .AddOptionalArg("additional_decode_surfaces",
+      R"code(Additional decode surfaces to use beyond minimum required.
+
+This parameter can be used to trade off memory usage with performance.)code",
+      2)
+  .AddOptionalArg("num_decoders",
+      R"code(The number of the hardware decoding sessions used in parallel.
+
+The samples of a batch are split between the sessions, so it's useful when the GPU has multiple
+NVDEC engines. Each session has its own decoder for each codec.)code", 2);
+
+VideoDecoderMixed::VideoDecoderMixed(const OpSpec &spec)
+    : Operator<MixedBackend>(spec),
+      device_id_(spec.GetArgument<int>("device_id")),
+      image_type_(spec.GetArgument<DALIImageType>("image_type")),
+      dtype_(spec.GetArgument<DALIDataType>("dtype")),
+      normalized_(spec.GetArgument<bool>("normalized")),
+      additional_decode_surfaces_(spec.GetArgument<int>("additional_decode_surfaces")),
+      sessions_(std::max(spec.GetArgument<int>("num_decoders"), 0)),
+      thread_pool_(num_threads_, device_id_, false),
+      decode_pool_(2 * std::max(spec.GetArgument<int>("num_decoders"), 1), device_id_, false) {
+  DALI_ENFORCE(!sessions_.empty(), "The number of decoders should be > 0");
+  DALI_ENFORCE(image_type_ == DALI_RGB || image_type_ == DALI_YCbCr,
+               "Image type must be RGB or YCbCr.");
+  DALI_ENFORCE(dtype_ == DALI_UINT8 || dtype_ == DALI_FLOAT16 || dtype_ == DALI_FLOAT,
+               make_string("Data type must be UINT8, FLOAT16 or FLOAT, got ", dtype_, "."));
+  DALI_ENFORCE(cuvidInitChecked(),
+    "Failed to load libnvcuvid.so, needed by the video decoder. "
+    "If you are running in a Docker container, please refer "
+    "to https://github.com/NVIDIA/nvidia-docker/wiki/Usage");
+}
+
+VideoDecoderMixed::~VideoDecoderMixed() {
+  try {
+    DeviceGuard g(device_id_);
+    for (auto &sequence : sequences_)
+      sequence.wait();
+    for (auto &session : sessions_) {
+      for (auto &slot : session.decoders) {
+        if (slot.second.decoder)
+          slot.second.decoder->finish();
+      }
+    }
+  } catch (const std::exception &e) {
+    // the decoders may still write to the outputs, so they can't be freed
+    std::cerr << "Fatal error: exception in ~VideoDecoderMixed():\n" << e.what() << std::endl;
+    std::terminate();
+  }
+}
+
+bool VideoDecoderMixed::SetupImpl(std::vector<OutputDesc> &output_desc,
+                                  const MixedWorkspace &ws) {
+  auto &input = ws.InputRef<CPUBackend>(0);
+  const int batch_size = input.ntensor();
+  DALI_ENFORCE(input.type() == DALI_UINT8,
+               make_string("The encoded videos must be of type UINT8, got: ", input.type()));
+  files_.resize(batch_size);
+  TensorListShape<4> shape(batch_size);
+  for (int i = 0; i < batch_size; i++) {
+    DALI_ENFORCE(input[i].shape().size() == 1, "Raw input must be 1D encoded byte data");
+    thread_pool_.AddWork([&, i](int) {
+      files_[i] = std::make_unique<MemoryVideoFile>(input[i].data<uint8_t>(), input[i].size(),
+                                                    input[i].GetSourceInfo());
+      auto &file = *files_[i];
+      TensorShape<4> sample_shape = { file.num_frames(), file.height(), file.width(), 3 };
+      shape.set_tensor_shape(i, sample_shape);
+    }, input[i].size());
+  }
+  thread_pool_.RunAll();
+
+  output_desc.resize(1);
+  output_desc[0] = { shape, dtype_ };
+  return true;
+}
+
+void VideoDecoderMixed::PrepareSessions() {
+  for (auto &session : sessions_) {
+    session.samples.clear();
+    for (auto it = session.decoders.begin(); it != session.decoders.end();) {
+      if (it->second.failed)
+        it = session.decoders.erase(it);
+      else
+        ++it;
+    }
+  }
+
+  // the samples are assigned to the session with the fewest frames to decode so far
+  std::vector<int64_t> session_frames(sessions_.size(), 0);
+  for (int i = 0; i < static_cast<int>(files_.size()); i++) {
+    int s = std::min_element(session_frames.begin(), session_frames.end()) -
+            session_frames.begin();
+    sessions_[s].samples.push_back(i);
+    session_frames[s] += files_[i]->num_frames();
+  }
+
+  for (auto &session : sessions_) {
+    for (int i : session.samples) {
+      auto &file = *files_[i];
+      auto &slot = session.decoders[file.codec_id()];
+      if (slot.decoder && file.height() <= slot.max_height && file.width() <= slot.max_width)
+        continue;
+      // the decoder can only be reconfigured to a smaller size, so it's created for the largest
+      // video of the session
+      for (int j : session.samples) {
+        if (files_[j]->codec_id() == file.codec_id()) {
+          slot.max_height = std::max(slot.max_height, files_[j]->height());
+          slot.max_width = std::max(slot.max_width, files_[j]->width());
+        }
+      }
+      if (slot.decoder)
+        slot.decoder->finish();
+      slot.decoder.reset();
+      slot.decoder = std::make_unique<NvDecoder>(device_id_, file.codec_params(), image_type_,
+                                                 dtype_, normalized_, ALIGN16(slot.max_height),
+                                                 ALIGN16(slot.max_width),
+                                                 additional_decode_surfaces_);
+    }
+  }
+}
+
+void VideoDecoderMixed::FeedSession(DecodingSession &session) {
+  for (int i : session.samples) {
+    auto &file = *files_[i];
+    auto &slot = session.decoders[file.codec_id()];
+    try {
+      FrameReq req{file.source_info(), 0, file.num_frames(), 1, {1, 1}, true};
+      slot.decoder->push_req(req);
+      for (auto &pkt : file.packets()) {
+        slot.decoder->decode_packet(pkt.get(), file.start_time(), file.stream_base(),
+                                    file.codec_params());
+      }
+      // flush the decoder, so that all the frames of the file are displayed
+      slot.decoder->decode_packet(nullptr, 0, {0}, nullptr);
+      slot.decoder->end_req();
+    } catch (...) {
+      slot.failed = true;
+      slot.decoder->finish();  // wakes up the receiving worker
+      throw;
+    }
+  }
+}
+
+void VideoDecoderMixed::ReceiveSession(DecodingSession &session) {
+  for (int i : session.samples) {
+    auto &slot = session.decoders[files_[i]->codec_id()];
+    try {
+      slot.decoder->receive_frames(sequences_[i]);
+      sequences_[i].wait();
+    } catch (...) {
+      slot.failed = true;
+      slot.decoder->finish();  // wakes up the feeding worker
+      throw;
+    }
+    DALI_ENFORCE(!slot.failed, make_string("Failed to decode ", files_[i]->source_info()));
+  }
+}
+
+void VideoDecoderMixed::Run(MixedWorkspace &ws) {
+  auto &output = ws.OutputRef<GPUBackend>(0);
+  output.SetLayout("FHWC");
+  const int batch_size = files_.size();
+  // the decoders write to the output on their own streams
+  CUDA_CALL(cudaStreamSynchronize(ws.stream()));
+
+  DeviceGuard g(device_id_);
+  PrepareSessions();
+  sequences_.resize(batch_size);
+  for (int i = 0; i < batch_size; i++) {
+    auto &file = *files_[i];
+    auto &sequence = sequences_[i];
+    sequence.initialize(file.num_frames(), file.num_frames(), file.height(), file.width(), 3,
+                        dtype_);
+    sequence.sequence.ShareData(&output, i);
+  }
+
+  for (auto &session : sessions_) {
+    if (session.samples.empty())
+      continue;
+    decode_pool_.AddWork([this, &session](int) {
+      FeedSession(session);
+    });
+    decode_pool_.AddWork([this, &session](int) {
+      ReceiveSession(session);
+    });
+  }
+  decode_pool_.RunAll();
+  files_.clear();
+}
+
+DALI_REGISTER_OPERATOR(decoders__Video, VideoDecoderMixed, Mixed);
+
+}  // namespace dali
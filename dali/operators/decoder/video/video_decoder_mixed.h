@@ -0,0 +1,97 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_DECODER_VIDEO_VIDEO_DECODER_MIXED_H_
+#define DALI_OPERATORS_DECODER_VIDEO_VIDEO_DECODER_MIXED_H_
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <vector>
+#include "dali/operators/decoder/video/memory_video_file.h"
+#include "dali/operators/reader/nvdecoder/nvdecoder.h"
+#include "dali/operators/reader/nvdecoder/sequencewrapper.h"
+#include "dali/pipeline/operator/operator.h"
+#include "dali/pipeline/util/thread_pool.h"
+
+namespace dali {
+
+/**
+ * @brief Decodes the video files held in memory, with NVDEC
+ *
+ * The files are demuxed on the host, in the thread pool, when the operator is set up - so
+ * the number of frames, and the output shape, is known up front. The samples are then split
+ * between `num_decoders` decoding sessions, balancing the number of frames. Each session has
+ * two workers: one feeds the packets of its samples to the decoder, the other converts
+ * the decoded frames straight to the output.
+ */
+class VideoDecoderMixed : public Operator<MixedBackend> {
+ public:
+  explicit VideoDecoderMixed(const OpSpec &spec);
+  ~VideoDecoderMixed() override;
+  DISABLE_COPY_MOVE_ASSIGN(VideoDecoderMixed);
+
+  using Operator<MixedBackend>::Run;
+  void Run(MixedWorkspace &ws) override;
+
+ protected:
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const MixedWorkspace &ws) override;
+
+  bool CanInferOutputs() const override {
+    return true;
+  }
+
+ private:
+  /// A decoder of one codec, in one session
+  struct DecoderSlot {
+    std::unique_ptr<NvDecoder> decoder;
+    int max_height = 0;
+    int max_width = 0;
+    /// set when decoding failed; the decoder is recreated in the next iteration
+    std::atomic<bool> failed{false};
+  };
+
+  struct DecodingSession {
+    std::map<AVCodecID, DecoderSlot> decoders;
+    /// the samples decoded by the session in this iteration
+    std::vector<int> samples;
+  };
+
+  /// Splits the samples between the sessions and creates the decoders they need
+  void PrepareSessions();
+
+  /// Feeds the packets of the session's samples to the decoders
+  void FeedSession(DecodingSession &session);
+
+  /// Receives the frames of the session's samples, in the same order as they're fed
+  void ReceiveSession(DecodingSession &session);
+
+  const int device_id_;
+  DALIImageType image_type_;
+  DALIDataType dtype_;
+  bool normalized_;
+  int additional_decode_surfaces_;
+
+  std::vector<std::unique_ptr<MemoryVideoFile>> files_;
+  std::vector<SequenceWrapper> sequences_;
+  std::vector<DecodingSession> sessions_;
+
+  ThreadPool thread_pool_;
+  /// runs the feeding and the receiving worker of each session
+  ThreadPool decode_pool_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_DECODER_VIDEO_VIDEO_DECODER_MIXED_H_
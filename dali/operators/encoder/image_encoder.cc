@@ -0,0 +1,167 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/encoder/image_encoder.h"
+#include <exception>
+#include <iostream>
+#include <string>
+#include "dali/core/cuda_error.h"
+#include "dali/core/device_guard.h"
+#include "dali/operators/decoder/nvjpeg/nvjpeg_helper.h"
+
+namespace dali {
+
+DALI_SCHEMA(encoders__Image)
+  .DocStr(R"code(Encodes images as JPEG on the GPU.
+
+The input is a batch of ``HWC`` images of type ``UINT8``, with 3 (RGB) or 1 (grayscale) channels,
+and the outputs are 1D ``UINT8`` tensors with the JPEG files. The encoding, including
+the Huffman coding, is done by nvJPEG on the GPU; the whole batch is scheduled before waiting
+for the results.
+
+The output stays on the GPU. Copy it to the host (e.g. with ``as_cpu()``) to store the files.
+)code")
+  .NumInput(1)
+  .NumOutput(1)
+  .InputLayout(0, { "HWC" })
+  .AddOptionalArg("quality",
+    R"code(JPEG quality, from 1 to 100.)code", 95, true)
+  .AddOptionalArg("chroma_subsampling",
+    R"code(Subsampling of the chroma channels of RGB images.
+
+Supported values: ``"444"``, ``"422"``, ``"420"``.)code", std::string("420"))
+  .AddOptionalArg("optimized_huffman",
+    R"code(If True, the Huffman tables are optimized for each image.
+
+It produces smaller files, at the cost of a slower encoding.)code", false);
+
+ImageEncoderGPU::ImageEncoderGPU(const OpSpec &spec)
+    : Operator<GPUBackend>(spec),
+      device_id_(spec.GetArgument<int>("device_id")),
+      optimized_huffman_(spec.GetArgument<bool>("optimized_huffman")) {
+  auto subsampling = spec.GetArgument<std::string>("chroma_subsampling");
+  if (subsampling == "444") {
+    subsampling_ = NVJPEG_CSS_444;
+  } else if (subsampling == "422") {
+    subsampling_ = NVJPEG_CSS_422;
+  } else if (subsampling == "420") {
+    subsampling_ = NVJPEG_CSS_420;
+  } else {
+    DALI_FAIL(make_string("Unsupported chroma subsampling: \"", subsampling,
+                          "\". Supported values are: \"444\", \"422\", \"420\"."));
+  }
+  handle_ = NvjpegSharedHandle::Get(device_id_, false);
+  bitstreams_.set_pinned(true);
+}
+
+ImageEncoderGPU::~ImageEncoderGPU() {
+  try {
+    DeviceGuard g(device_id_);
+    for (auto &slot : slots_) {
+      if (slot.params)
+        NVJPEG_CALL(nvjpegEncoderParamsDestroy(slot.params));
+      if (slot.state)
+        NVJPEG_CALL(nvjpegEncoderStateDestroy(slot.state));
+    }
+  } catch (const std::exception &e) {
+    // If destroying nvJPEG resources failed we are leaking something so terminate
+    std::cerr << "Fatal error: exception in ~ImageEncoderGPU():\n" << e.what() << std::endl;
+    std::terminate();
+  }
+}
+
+void ImageEncoderGPU::ReserveSlots(int batch_size, cudaStream_t stream) {
+  while (static_cast<int>(slots_.size()) < batch_size) {
+    slots_.emplace_back();
+    auto &slot = slots_.back();
+    NVJPEG_CALL(nvjpegEncoderStateCreate(handle_->get(), &slot.state, stream));
+    NVJPEG_CALL(nvjpegEncoderParamsCreate(handle_->get(), &slot.params, stream));
+    NVJPEG_CALL(nvjpegEncoderParamsSetOptimizedHuffman(slot.params, optimized_huffman_, stream));
+  }
+}
+
+bool ImageEncoderGPU::SetupImpl(std::vector<OutputDesc> &output_desc,
+                                const DeviceWorkspace &ws) {
+  const auto &input = ws.InputRef<GPUBackend>(0);
+  DALI_ENFORCE(input.type() == DALI_UINT8,
+               make_string("The images must be of type UINT8, got: ", input.type()));
+  const auto &shape = input.shape();
+  DALI_ENFORCE(shape.sample_dim() == 3,
+               make_string("Expected HWC images, got ", shape.sample_dim(), "D input."));
+  for (int i = 0; i < shape.num_samples(); i++) {
+    int channels = shape.tensor_shape_span(i)[2];
+    DALI_ENFORCE(channels == 3 || channels == 1,
+                 make_string("Only RGB and grayscale images can be encoded, got ", channels,
+                             " channels in the sample ", i, "."));
+  }
+  return false;
+}
+
+void ImageEncoderGPU::RunImpl(DeviceWorkspace &ws) {
+  const auto &input = ws.InputRef<GPUBackend>(0);
+  auto &output = ws.OutputRef<GPUBackend>(0);
+  auto stream = ws.stream();
+  int nsamples = input.ntensor();
+  ReserveSlots(nsamples, stream);
+
+  // Schedule all the samples, so that the GPU stages of the encoding run back-to-back
+  for (int i = 0; i < nsamples; i++) {
+    auto &slot = slots_[i];
+    int quality = spec_.GetArgument<int>("quality", &ws, i);
+    DALI_ENFORCE(quality >= 1 && quality <= 100,
+                 make_string("``quality`` must be in the range [1, 100], got: ", quality));
+    if (quality != slot.quality) {
+      NVJPEG_CALL(nvjpegEncoderParamsSetQuality(slot.params, quality, stream));
+      slot.quality = quality;
+    }
+    auto sh = input.tensor_shape_span(i);
+    int height = sh[0], width = sh[1], channels = sh[2];
+    nvjpegImage_t image = {};
+    image.channel[0] = const_cast<uint8_t *>(input.tensor<uint8_t>(i));
+    image.pitch[0] = width * channels;
+    if (channels == 3) {
+      NVJPEG_CALL(nvjpegEncoderParamsSetSamplingFactors(slot.params, subsampling_, stream));
+      NVJPEG_CALL(nvjpegEncodeImage(handle_->get(), slot.state, slot.params, &image,
+                                    NVJPEG_INPUT_RGBI, width, height, stream));
+    } else {
+      NVJPEG_CALL(nvjpegEncoderParamsSetSamplingFactors(slot.params, NVJPEG_CSS_GRAY, stream));
+      NVJPEG_CALL(nvjpegEncodeYUV(handle_->get(), slot.state, slot.params, &image,
+                                  NVJPEG_CSS_GRAY, width, height, stream));
+    }
+  }
+  // The bitstreams are retrieved to the host; this also makes sure that the H2D copies
+  // of the previous iteration, which read `bitstreams_`, are complete
+  CUDA_CALL(cudaStreamSynchronize(stream));
+
+  TensorListShape<1> out_shape(nsamples);
+  lengths_.resize(nsamples);
+  for (int i = 0; i < nsamples; i++) {
+    NVJPEG_CALL(nvjpegEncodeRetrieveBitstream(handle_->get(), slots_[i].state, nullptr,
+                                              &lengths_[i], stream));
+    out_shape.set_tensor_shape(i, { static_cast<int64_t>(lengths_[i]) });
+  }
+  bitstreams_.Resize(out_shape, DALI_UINT8);
+  output.Resize(out_shape, DALI_UINT8);
+  for (int i = 0; i < nsamples; i++) {
+    NVJPEG_CALL(nvjpegEncodeRetrieveBitstream(handle_->get(), slots_[i].state,
+                                              bitstreams_.mutable_tensor<uint8_t>(i),
+                                              &lengths_[i], stream));
+    CUDA_CALL(cudaMemcpyAsync(output.mutable_tensor<uint8_t>(i), bitstreams_.tensor<uint8_t>(i),
+                              lengths_[i], cudaMemcpyHostToDevice, stream));
+  }
+}
+
+DALI_REGISTER_OPERATOR(encoders__Image, ImageEncoderGPU, GPU);
+
+}  // namespace dali
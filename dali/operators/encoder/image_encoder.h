@@ -0,0 +1,73 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_ENCODER_IMAGE_ENCODER_H_
+#define DALI_OPERATORS_ENCODER_IMAGE_ENCODER_H_
+
+#include <nvjpeg.h>
+#include <memory>
+#include <vector>
+#include "dali/core/common.h"
+#include "dali/operators/decoder/nvjpeg/nvjpeg_shared_handle.h"
+#include "dali/pipeline/operator/operator.h"
+
+namespace dali {
+
+/**
+ * @brief Encodes HWC uint8 images on the GPU as JPEG, with nvJPEG
+ *
+ * The encoding of all the samples is scheduled first, with a separate encoder state per sample,
+ * so the GPU work of the batch is queued back-to-back and the stream is synchronized only
+ * once, before the bitstreams are retrieved. The output sizes are known only then, so
+ * the outputs are not inferred.
+ */
+class ImageEncoderGPU : public Operator<GPUBackend> {
+ public:
+  explicit ImageEncoderGPU(const OpSpec &spec);
+  ~ImageEncoderGPU() override;
+  DISABLE_COPY_MOVE_ASSIGN(ImageEncoderGPU);
+
+ protected:
+  bool CanInferOutputs() const override {
+    return false;
+  }
+
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const DeviceWorkspace &ws) override;
+  void RunImpl(DeviceWorkspace &ws) override;
+
+  USE_OPERATOR_MEMBERS();
+
+ private:
+  struct EncoderSlot {
+    nvjpegEncoderState_t state = nullptr;
+    nvjpegEncoderParams_t params = nullptr;
+    int quality = -1;
+  };
+
+  /// Creates the encoder states and parameters for up to `batch_size` samples
+  void ReserveSlots(int batch_size, cudaStream_t stream);
+
+  int device_id_;
+  std::shared_ptr<NvjpegSharedHandle> handle_;
+  std::vector<EncoderSlot> slots_;
+  nvjpegChromaSubsampling_t subsampling_ = NVJPEG_CSS_420;
+  bool optimized_huffman_ = false;
+
+  std::vector<size_t> lengths_;
+  TensorList<CPUBackend> bitstreams_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_ENCODER_IMAGE_ENCODER_H_
@@ -0,0 +1,272 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+#include "dali/core/cuda_error.h"
+#include "dali/operators/generic/cache.h"
+
+namespace dali {
+
+DALI_SCHEMA(experimental__Cache)
+  .DocStr(R"code(Stores the samples computed by the deterministic part of the pipeline, so that it
+doesn't have to run again in the next epochs.
+
+The samples are identified by the source info of the samples of ``source`` - usually the output
+of the reader, which sets it to the name of the file or the index of the record.
+The samples of the input are copied to the output and stored, until ``cache_size`` is used up;
+nothing is evicted. When all the samples of a batch are stored, the operator produces them from
+the cache and the operators which compute the input are not run in that iteration.
+
+The input can be computed only by the deterministic operators (like decoding, resizing and
+cropping with fixed arguments) from the outputs of the operator producing ``source``;
+the other operators, e.g. the ones with random arguments, have to follow this one.
+The operators computing the input can't be used for anything else, except for CPU operators,
+which are not skipped.
+
+.. note::
+  The iterations are skipped as a whole, so the size of the cache should fit the whole data set
+  (or the shard read by the pipeline), especially when it's shuffled.)code")
+  .NumInput(1)
+  .NumOutput(1)
+  .CachesInputs("source")
+  .AddArg("source",
+      R"code(The data which identifies the samples by its source info, e.g. the encoded
+images produced by the reader.
+
+The type and the shape of the data are not used.)code", DALI_UINT8, true)
+  .AddOptionalArg("cache_size", R"code(The size of the cache, in megabytes.)code", 1024)
+  .AddOptionalArg("cache_type", R"code(Where the samples are stored.
+
+Available values:
+
+* ``device`` - in the GPU memory,
+* ``host`` - in the pinned host memory,
+* ``disk`` - in a temporary file in ``cache_dir``; the file is removed when the pipeline
+  is destroyed.)code", std::string("device"))
+  .AddOptionalArg("cache_dir", R"code(The directory of the ``disk`` cache.
+
+It should be on a local drive, faster to read than decoding the data again.)code",
+      std::string("/tmp"));
+
+namespace {
+
+constexpr size_t kAlignment = 256;
+
+constexpr size_t align_up(size_t x) {
+  return (x + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+}  // namespace
+
+Cache::Cache(const OpSpec &spec) : Operator<GPUBackend>(spec) {
+  capacity_ = static_cast<size_t>(spec.GetArgument<int>("cache_size")) << 20;
+  auto type = spec.GetArgument<std::string>("cache_type");
+  if (type == "device") {
+    storage_ = Storage::Device;
+  } else if (type == "host") {
+    storage_ = Storage::Host;
+  } else if (type == "disk") {
+    storage_ = Storage::Disk;
+    cache_dir_ = spec.GetArgument<std::string>("cache_dir");
+    std::string path = cache_dir_ + "/dali_cache_XXXXXX";
+    fd_ = mkstemp(&path[0]);
+    DALI_ENFORCE(fd_ >= 0, make_string("Cannot create the cache file in \"", cache_dir_, "\": ",
+                                       std::strerror(errno)));
+    // the data is accessed by the descriptor only
+    unlink(path.c_str());
+    staging_event_ = CUDAEvent::Create(spec.GetArgument<int>("device_id"));
+  } else {
+    DALI_FAIL(make_string("Unknown cache type: \"", type,
+                          "\". Valid values are \"device\", \"host\" and \"disk\"."));
+  }
+}
+
+Cache::~Cache() {
+  if (staging_event_)
+    cudaEventSynchronize(staging_event_);
+  if (fd_ >= 0)
+    close(fd_);
+}
+
+bool Cache::HasCachedOutputs(const std::vector<std::string> &source_info) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (source_info.empty() || entries_.empty())
+    return false;
+  for (auto &key : source_info) {
+    if (key.empty() || !entries_.count(key))
+      return false;
+  }
+  return true;
+}
+
+bool Cache::Setup(std::vector<OutputDesc> &output_desc, const DeviceWorkspace &ws) {
+  const auto &source = ws.ArgumentInput("source");
+  int batch_size = source.ntensor();
+  keys_.resize(batch_size);
+  for (int i = 0; i < batch_size; i++)
+    keys_[i] = source[i].GetSourceInfo();
+  // the entries are never removed, so the executor decided the same when it skipped the input
+  load_ = HasCachedOutputs(keys_);
+  if (!load_)
+    EnforceUniformInputBatchSize<GPUBackend>(ws);
+  return false;
+}
+
+void Cache::Run(DeviceWorkspace &ws) {
+  if (load_) {
+    Load(ws);
+  } else {
+    CheckInputLayouts(ws, spec_);
+    Store(ws);
+  }
+  auto &output = ws.OutputRef<GPUBackend>(0);
+  for (int i = 0; i < static_cast<int>(keys_.size()); i++)
+    output.SetSourceInfo(i, keys_[i]);
+}
+
+uint8_t *Cache::Staging(size_t size) {
+  // the previous copies from the buffer must be complete
+  CUDA_CALL(cudaEventSynchronize(staging_event_));
+  if (size > staging_size_) {
+    staging_.reset();
+    staging_size_ = std::max(size, 2 * staging_size_);
+    staging_ = mm::alloc_raw_unique<uint8_t, mm::memory_kind::pinned>(staging_size_);
+  }
+  return staging_.get();
+}
+
+void Cache::Load(DeviceWorkspace &ws) {
+  auto &output = ws.OutputRef<GPUBackend>(0);
+  int batch_size = keys_.size();
+  std::vector<const Entry *> entries(batch_size);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (int i = 0; i < batch_size; i++)
+      entries[i] = &entries_.at(keys_[i]);  // only Run adds the entries
+  }
+  TensorListShape<> shape(batch_size, entries[0]->shape.sample_dim());
+  size_t total_size = 0;
+  for (int i = 0; i < batch_size; i++) {
+    shape.set_tensor_shape(i, entries[i]->shape);
+    total_size += entries[i]->size;
+  }
+  output.Resize(shape, entries[0]->type);
+  output.SetLayout(entries[0]->layout);
+
+  if (storage_ != Storage::Disk) {
+    for (int i = 0; i < batch_size; i++)
+      CUDA_CALL(cudaMemcpyAsync(output.raw_mutable_tensor(i), buffer_.get() + entries[i]->offset,
+                                entries[i]->size, cudaMemcpyDefault, ws.stream()));
+    return;
+  }
+
+  uint8_t *staging = Staging(total_size);
+  size_t staging_offset = 0;
+  for (int i = 0; i < batch_size; i++) {
+    auto size = entries[i]->size;
+    auto read = pread(fd_, staging + staging_offset, size, entries[i]->offset);
+    DALI_ENFORCE(read == static_cast<ssize_t>(size),
+                 make_string("Cannot read \"", keys_[i], "\" from the cache file in \"",
+                             cache_dir_, "\"."));
+    CUDA_CALL(cudaMemcpyAsync(output.raw_mutable_tensor(i), staging + staging_offset, size,
+                              cudaMemcpyHostToDevice, ws.stream()));
+    staging_offset += size;
+  }
+  CUDA_CALL(cudaEventRecord(staging_event_, ws.stream()));
+}
+
+void Cache::Store(DeviceWorkspace &ws) {
+  const auto &input = ws.InputRef<GPUBackend>(0);
+  auto &output = ws.OutputRef<GPUBackend>(0);
+  int batch_size = input.ntensor();
+  output.Resize(input.shape(), input.type());
+  output.SetLayout(input.GetLayout());
+  for (int i = 0; i < batch_size; i++) {
+    CUDA_CALL(cudaMemcpyAsync(output.raw_mutable_tensor(i), input.raw_tensor(i),
+                              input.shape().tensor_size(i) * input.type_info().size(),
+                              cudaMemcpyDeviceToDevice, ws.stream()));
+  }
+  if (used_ >= capacity_)
+    return;
+
+  // select the samples which are new and fit
+  std::vector<std::pair<int, Entry>> added;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (int i = 0; i < batch_size; i++) {
+      if (keys_[i].empty() || entries_.count(keys_[i]))
+        continue;
+      size_t size = input.shape().tensor_size(i) * input.type_info().size();
+      if (used_ + size > capacity_)
+        continue;
+      bool duplicate = false;
+      for (auto &a : added)
+        duplicate |= keys_[a.first] == keys_[i];
+      if (duplicate)
+        continue;
+      added.push_back({i, {input.shape()[i], input.type(), input.GetLayout(), used_, size}});
+      used_ = align_up(used_ + size);
+    }
+  }
+  if (added.empty())
+    return;
+
+  if (storage_ != Storage::Disk) {
+    if (!buffer_) {
+      buffer_ = storage_ == Storage::Device
+                    ? mm::alloc_raw_unique<uint8_t, mm::memory_kind::device>(capacity_)
+                    : mm::alloc_raw_unique<uint8_t, mm::memory_kind::pinned>(capacity_);
+    }
+    // the stored samples are read later in the same stream
+    for (auto &a : added)
+      CUDA_CALL(cudaMemcpyAsync(buffer_.get() + a.second.offset, output.raw_tensor(a.first),
+                                a.second.size, cudaMemcpyDefault, ws.stream()));
+  } else {
+    size_t total_size = 0;
+    for (auto &a : added)
+      total_size += a.second.size;
+    uint8_t *staging = Staging(total_size);
+    size_t staging_offset = 0;
+    for (auto &a : added) {
+      CUDA_CALL(cudaMemcpyAsync(staging + staging_offset, output.raw_tensor(a.first),
+                                a.second.size, cudaMemcpyDeviceToHost, ws.stream()));
+      staging_offset += a.second.size;
+    }
+    CUDA_CALL(cudaEventRecord(staging_event_, ws.stream()));
+    CUDA_CALL(cudaEventSynchronize(staging_event_));
+    staging_offset = 0;
+    for (auto &a : added) {
+      auto written = pwrite(fd_, staging + staging_offset, a.second.size, a.second.offset);
+      DALI_ENFORCE(written == static_cast<ssize_t>(a.second.size),
+                   make_string("Cannot write to the cache file in \"", cache_dir_, "\": ",
+                               std::strerror(errno)));
+      staging_offset += a.second.size;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto &a : added)
+    entries_.emplace(keys_[a.first], std::move(a.second));
+}
+
+DALI_REGISTER_OPERATOR(experimental__Cache, Cache, GPU);
+
+}  // namespace dali
@@ -0,0 +1,103 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_GENERIC_CACHE_H_
+#define DALI_OPERATORS_GENERIC_CACHE_H_
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "dali/core/cuda_event.h"
+#include "dali/core/mm/memory.h"
+#include "dali/pipeline/operator/operator.h"
+
+namespace dali {
+
+/**
+ * @brief Stores the samples of its input, keyed by their source info, and produces the stored
+ *        samples instead of the input when all the samples of the batch are stored
+ *
+ * The executor skips the deterministic subgraph computing the input in such iterations,
+ * see OpSchema::CachesInputs. The samples are stored until `cache_size` is used up;
+ * nothing is evicted.
+ */
+class Cache : public Operator<GPUBackend> {
+ public:
+  explicit Cache(const OpSpec &spec);
+  ~Cache() override;
+
+  DISABLE_COPY_MOVE_ASSIGN(Cache);
+
+  bool HasCachedOutputs(const std::vector<std::string> &source_info) const override;
+
+  /// In the iterations using the stored samples, the input is stale - it's not checked
+  bool Setup(std::vector<OutputDesc> &output_desc, const DeviceWorkspace &ws) override;
+
+  void Run(DeviceWorkspace &ws) override;
+
+ protected:
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const DeviceWorkspace &ws) override {
+    return false;
+  }
+
+  void RunImpl(DeviceWorkspace &ws) override {}
+
+ private:
+  enum class Storage {
+    Device,
+    Host,
+    Disk,
+  };
+
+  struct Entry {
+    TensorShape<> shape;
+    DALIDataType type;
+    TensorLayout layout;
+    size_t offset, size;
+  };
+
+  /// Produces the output from the stored samples
+  void Load(DeviceWorkspace &ws);
+  /// Copies the input to the output and stores the samples which fit
+  void Store(DeviceWorkspace &ws);
+
+  uint8_t *Staging(size_t size);
+
+  Storage storage_;
+  std::string cache_dir_;
+  size_t capacity_ = 0;
+  size_t used_ = 0;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, Entry> entries_;
+
+  /// Used by the device and host storage
+  mm::uptr<uint8_t> buffer_;
+  /// Used by the disk storage; the file is removed when it's closed
+  int fd_ = -1;
+  /// The host copy of the samples read from or written to the disk
+  mm::uptr<uint8_t> staging_;
+  size_t staging_size_ = 0;
+  /// Recorded after the copies from the staging buffer
+  CUDAEvent staging_event_;
+
+  /// The keys of the samples in the current iteration and whether they're all stored
+  std::vector<std::string> keys_;
+  bool load_ = false;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_GENERIC_CACHE_H_
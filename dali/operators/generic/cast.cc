@@ -61,6 +61,7 @@ DALI_SCHEMA(Cast)
     .DocStr("Cast tensor to a different type.")
     .NumInput(1)
     .NumOutput(1)
+    .Deterministic()
     .AllowSequences()
     .SupportVolumetric()
     .AddArg("dtype", R"code(Output data type.)code", DALI_DATA_TYPE);
@@ -78,6 +78,10 @@ class Constant : public Operator<Backend> {
     return false;
   }
 
+  bool HasInvariantOutputs() const override {
+    return true;
+  }
+
   bool SetupImpl(std::vector<OutputDesc> &output_desc, const Workspace &ws) override {
     output_desc.resize(1);
     if (max_output_shape_.empty()) {
@@ -27,6 +27,7 @@ DALI_SCHEMA(Flip)
 and depthwise).)code")
     .NumInput(1)
     .NumOutput(1)
+    .Deterministic()
     .AddOptionalArg("horizontal", R"code(Flip the horizontal  dimension.)code", 1, true)
     .AddOptionalArg("vertical", R"code(Flip the vertical dimension.)code", 0, true)
     .AddOptionalArg("depthwise", R"code(Flip the depthwise dimension.)code", 0, true)
@@ -35,8 +35,15 @@ The shapes of the inputs must match in all dimensions except the concatenation a
 This argument is mutually exclusive with ``axis``.
 This argument requires that at least one input has a non-empty layout and that all non-empty
 input layouts match.)", nullptr, false)
+  .AddOptionalArg("pad", R"(If set to True, the output tensors are padded to a uniform shape.
+
+The extent of each output dimension is the maximum extent of that dimension across the batch.
+The joined data occupies the beginning of each dimension and the rest is filled with
+``fill_value``. On the GPU, joining and padding is done in a single pass.)", false)
+  .AddOptionalArg("fill_value", "The value used for padding, when ``pad`` is set.", 0.0f)
   .NumInput(1, 999)
-  .NumOutput(1);
+  .NumOutput(1)
+  .Deterministic();
 
 DALI_SCHEMA(Stack)
   .DocStr(R"(Joins the input tensors along a new axis.
@@ -53,8 +60,15 @@ A one-character string that will denote the new axis in the output layout. The o
 constructed by inserting that character into the input layout at the position indicated by ``axis``.
 For example, specifying ``axis = 0`` and ``axis_name = "C"`` with input layout "HW" will yield
 the output layout "CHW")", nullptr, false)
+  .AddOptionalArg("pad", R"(If set to True, the output tensors are padded to a uniform shape.
+
+The extent of each output dimension is the maximum extent of that dimension across the batch.
+The joined data occupies the beginning of each dimension and the rest is filled with
+``fill_value``. On the GPU, joining and padding is done in a single pass.)", false)
+  .AddOptionalArg("fill_value", "The value used for padding, when ``pad`` is set.", 0.0f)
   .NumInput(1, 999)
-  .NumOutput(1);
+  .NumOutput(1)
+  .Deterministic();
 
 #define TENSOR_JOIN_TYPES (bool, uint8_t, int8_t, uint16_t, int16_t, uint32_t, int32_t, \
                           uint64_t, int64_t, float16, float, double)
@@ -116,6 +130,13 @@ void TensorJoin<Backend, new_axis>::SetupTyped(
     return &inputs[index].shape;
   }, inputs.size(), axis_, new_axis);
   DALI_ENFORCE(axis_ < output_shape.sample_dim(), make_string("Invalid axis index: ", axis_));
+
+  if (pad_) {
+    TensorListShape<> joined_shape = output_shape;
+    kernels::tensor_join::PadToMaxShape(output_shape);
+    if (output_shape != joined_shape)
+      copy_idx_ = -1;  // the single input still needs padding
+  }
 }
 
 template <typename Backend, bool new_axis>
@@ -221,7 +242,10 @@ void TensorJoin<Backend, new_axis>::RunTyped(
         sample_in_shapes[t] = sample_in_tensors[t].shape;
       }
       kmgr_.Setup<Kernel>(tid, ctx, sample_in_shapes, axis_);
-      kmgr_.Run<Kernel>(tid, tid, ctx, out[i], sample_in_tensors);
+      if (pad_)
+        kmgr_.Run<Kernel>(tid, tid, ctx, out[i], sample_in_tensors, static_cast<T>(fill_value_));
+      else
+        kmgr_.Run<Kernel>(tid, tid, ctx, out[i], sample_in_tensors);
     }, volume(out.tensor_shape_span(i)));
   }
   tp.RunAll(true);
@@ -238,8 +262,8 @@ void TensorJoin<Backend, new_axis>::RunTyped(
   auto &inputs = this->template inputs<T>();
 
   kmgr_.Resize<Kernel>(1, 1);
-  kmgr_.Setup<Kernel>(0, ctx, make_cspan(inputs), axis_);
-  kmgr_.Run<Kernel>(0, 0, ctx, out, make_cspan(inputs));
+  kmgr_.Setup<Kernel>(0, ctx, make_cspan(inputs), axis_, pad_);
+  kmgr_.Run<Kernel>(0, 0, ctx, out, make_cspan(inputs), static_cast<T>(fill_value_));
 }
 
 template <typename Backend>
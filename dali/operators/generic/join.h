@@ -44,6 +44,8 @@ class TensorJoin : public Operator<Backend> {
         " must be a single character; got ", axis_name_str));
       axis_name_arg_ = axis_name_str[0];
     }
+    pad_ = spec.GetArgument<bool>("pad");
+    fill_value_ = spec.GetArgument<float>("fill_value");
   }
 
   using Storage = detail::storage_tag_map_t<Backend>;
@@ -86,6 +88,8 @@ class TensorJoin : public Operator<Backend> {
   int axis_arg_ = 0;
   int copy_idx_ = -1;
   char axis_name_arg_ = 0;
+  bool pad_ = false;
+  float fill_value_ = 0;
 };
 
 }  // namespace dali
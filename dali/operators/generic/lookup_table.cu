@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <limits>
+#include <type_traits>
 #include <utility>
 #include "dali/core/convert.h"
 #include "dali/core/span.h"
@@ -22,16 +23,45 @@ namespace dali {
 
 namespace detail {
 
-template <typename OutputType, typename InputType>
+template <typename Output, typename Input>
+__device__ DALI_FORCEINLINE Output LookupValue(Input key, const Output *table, int table_size,
+                                               Output default_value) {
+  // uint8 keys never exceed the (padded) table
+  if (std::is_same<Input, uint8_t>::value)
+    return table[key];
+  return (std::is_unsigned<Input>::value || key >= 0) &&
+         static_cast<uint64_t>(key) < static_cast<uint64_t>(table_size)
+         ? table[key] : default_value;
+}
+
+/**
+ * @brief Maps the input values through a lookup table
+ *
+ * @tparam shared_table if true, the first `table_size` entries of the table are copied to
+ *                      shared memory first; this requires `table_size * sizeof(OutputType)`
+ *                      bytes of dynamic shared memory
+ */
+template <typename OutputType, typename InputType, bool shared_table>
 __global__ void LookupValuesImpl(const LutSampleDesc *samples, const kernels::BlockDesc<1> *blocks,
-                                 const OutputType *lookup_table, const OutputType default_value) {
+                                 const OutputType *lookup_table, int table_size,
+                                 const OutputType default_value) {
   const auto &block = blocks[blockIdx.x];
   const auto &sample = samples[block.sample_idx];
 
+  const OutputType *table = lookup_table;
+  if (shared_table) {
+    extern __shared__ uint8_t shared_lut[];
+    OutputType *shared = reinterpret_cast<OutputType *>(shared_lut);
+    for (int i = threadIdx.x; i < table_size; i += blockDim.x)
+      shared[i] = lookup_table[i];
+    __syncthreads();
+    table = shared;
+  }
+
   auto *output = reinterpret_cast<OutputType *>(sample.output);
   const auto *input = reinterpret_cast<const InputType *>(sample.input);
   for (int64_t x = threadIdx.x + block.start.x; x < block.end.x; x += blockDim.x) {
-    DoLookup<GPUBackend>(output[x], input[x], lookup_table, default_value);
+    output[x] = LookupValue(input[x], table, table_size, default_value);
   }
 }
 
@@ -68,8 +98,21 @@ void LookupTable<GPUBackend>::RunImpl(DeviceWorkspace &ws) {
       dim3 grid_dim = block_setup_.GridDim();
       dim3 block_dim = block_setup_.BlockDim();
 
-      detail::LookupValuesImpl<OutputType, InputType><<<grid_dim, block_dim, 0, stream>>>(
-          samples_dev_.data(), blocks_dev_.data(), lookup_table, default_value);
+      // uint8 keys can address only 256 entries - the table is padded to that size,
+      // so that no range check is necessary
+      int shared_size = std::is_same<InputType, uint8_t>::value ? 256 : table_size_;
+      if (shared_size <= kMaxSharedTableSize) {
+        size_t shm_size = shared_size * sizeof(OutputType);
+        detail::LookupValuesImpl<OutputType, InputType, true>
+          <<<grid_dim, block_dim, shm_size, stream>>>(
+            samples_dev_.data(), blocks_dev_.data(), lookup_table, shared_size, default_value);
+      } else {
+        detail::LookupValuesImpl<OutputType, InputType, false>
+          <<<grid_dim, block_dim, 0, stream>>>(
+            samples_dev_.data(), blocks_dev_.data(), lookup_table, kLookupTableSize,
+            default_value);
+      }
+      CUDA_CALL(cudaGetLastError());
 
     ), DALI_FAIL(make_string("Unsupported output type: ", output_type_)); );       // NOLINT
   ), DALI_FAIL(make_string("Unsupported input type: ", input.type())); );     // NOLINT
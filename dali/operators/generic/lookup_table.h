@@ -55,6 +55,8 @@ class LookupTable : public Operator<Backend> {
  public:
   static constexpr size_t kLookupTableSize = 0x10000;
   static constexpr size_t kMaxKey = kLookupTableSize - 1;
+  /// The largest number of table entries that the GPU operator keeps in shared memory
+  static constexpr int kMaxSharedTableSize = 4096;
 
   explicit inline LookupTable(const OpSpec &spec)
       : Operator<Backend>(spec),
@@ -72,6 +74,7 @@ class LookupTable : public Operator<Backend> {
       max_key = *std::max_element(keys.begin(), keys.end());
       DALI_ENFORCE(min_key >= 0 && max_key <= static_cast<int>(kMaxKey),
         "`keys` should be in the range [0, " + std::to_string(kMaxKey) + "]");
+      table_size_ = max_key + 1;
     }
     if (spec.HasArgument("values")) {
       values_f = spec.GetRepeatedArgument<float>("values");
@@ -122,12 +125,15 @@ class LookupTable : public Operator<Backend> {
  private:
   DALIDataType input_type_, output_type_;
   float default_value_f_ = 0.0f;
+  /// All keys past this size map to the default value
+  int table_size_ = 0;
   std::unique_ptr<void, void(*)(void*)> value_mem_ = {nullptr, free};
   Tensor<GPUBackend> lut_;
 
   using GpuBlockSetup = kernels::BlockSetup<1, -1>;
 
-  GpuBlockSetup block_setup_;
+  // Large blocks, so that loading the table to shared memory is amortized
+  GpuBlockSetup block_setup_{16};
   std::vector<LutSampleDesc> samples_;
   DeviceBuffer<GpuBlockSetup::BlockDesc> blocks_dev_;
   DeviceBuffer<LutSampleDesc> samples_dev_;
@@ -59,7 +59,15 @@ This value will be cast to the ``dtype`` type.)code", 0.f)
   .AddOptionalArg<std::string>("axis_name",
                   R"code(Single character that will be used as a name for the newly added
 dimension in the output layout. If no character is provided, the output layout will be
-empty.)code", nullptr);
+empty.)code", nullptr)
+  .AddOptionalArg<std::vector<int>>("class_map",
+                  R"code(Maps the input values to class indices before the encoding.
+
+The input value ``v`` is replaced with ``class_map[v]``. Input values outside of the range
+``[0, len(class_map))`` and negative entries in ``class_map`` don't match any class, so the
+output is ``off_value`` for all classes.
+
+If not provided, the input values are used directly as class indices.)code", nullptr);
 
 class OneHotCPU : public OneHot<CPUBackend> {
  public:
@@ -92,7 +100,8 @@ void OneHotCPU::RunImpl(workspace_t<CPUBackend> &ws) {
               [&, sample_id](int thread_id) {
                   auto in = in_tensor[sample_id];
                   auto out = out_tensor[sample_id];
-                  detail::DoOneHot(out, in, num_classes_, on_value_, off_value_, placement_axis);
+                  detail::DoOneHot(out, in, num_classes_, on_value_, off_value_, placement_axis,
+                                   make_cspan(class_map_));
               }, in_shape.tensor_size(sample_id));
     }
     tp.RunAll();
@@ -38,6 +38,7 @@ class OneHotGPU : public OneHot<GPUBackend> {
  private:
   std::vector<detail::SampleDesc> sample_descs_;
   Tensor<GPUBackend> scratch_mem_;
+  Tensor<GPUBackend> class_map_gpu_;
   int recent_n_samples_ = 0;
 };
 
@@ -79,9 +80,10 @@ void OneHotGPU::RunImplTyped(workspace_t<GPUBackend> &ws, int axis) {
     detail::SampleDesc sample;
     auto output_shape = shape.tensor_shape_span(sample_id);
     auto outer_vol = volume(output_shape.begin(), output_shape.begin() + axis);
-    sample.inner_vol = volume(output_shape.begin() + axis + 1, output_shape.end());
-    sample.inner_vol_classes = sample.inner_vol * num_classes_;
-    sample.output_vol = outer_vol * sample.inner_vol_classes;
+    uint64_t inner_vol = volume(output_shape.begin() + axis + 1, output_shape.end());
+    sample.inner_vol = inner_vol;
+    sample.num_classes = num_classes_;
+    sample.output_vol = outer_vol * inner_vol * num_classes_;
     sample.out = output.mutable_tensor<OutputType>(sample_id);
     sample.in = input.tensor<InputType>(sample_id);
     sample_descs_.push_back(sample);
@@ -93,11 +95,19 @@ void OneHotGPU::RunImplTyped(workspace_t<GPUBackend> &ws, int axis) {
   scratch_mem_.Copy(sample_descs_, stream);
   const auto *scratch_mem_gpu = scratch_mem_.data<detail::SampleDesc>();
 
+  const int *class_map_gpu = nullptr;
+  if (!class_map_.empty()) {
+    if (class_map_gpu_.shape().num_elements() == 0)
+      class_map_gpu_.Copy(class_map_, stream);
+    class_map_gpu = class_map_gpu_.data<int>();
+  }
+
   const int block = 256;
-  auto grid = detail::gridHelper(max_out_vol, num_samples, block);
+  constexpr int kVec = detail::OneHotVecSize<OutputType>();
+  auto grid = detail::gridHelper(div_ceil(max_out_vol, kVec), num_samples, block);
 
   detail::PopulateOneHot<OutputType, InputType><<<grid, block, 0, stream>>>(
-    on_value_, off_value_, scratch_mem_gpu);
+    on_value_, off_value_, scratch_mem_gpu, class_map_gpu, class_map_.size());
 }
 
 DALI_REGISTER_OPERATOR(OneHot, OneHotGPU, GPU);
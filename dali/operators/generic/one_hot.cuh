@@ -15,32 +15,86 @@
 #include <cstdint>
 #include <algorithm>
 #include "dali/core/util.h"
+#include "dali/core/fast_div.h"
+#include "dali/operators/generic/one_hot.h"
 
 namespace dali {
 
 namespace detail {
 
 struct SampleDesc {
-  uint64_t inner_vol, output_vol, inner_vol_classes;
+  fast_div<uint64_t> inner_vol, num_classes;
+  uint64_t output_vol;
   void *out = nullptr;
   const void *in = nullptr;
 };
 
+/**
+ * @brief Number of output elements stored at once - 16 bytes or a single element, if larger
+ */
+template <typename OutputType>
+constexpr int OneHotVecSize() {
+  return sizeof(OutputType) < 16 ? 16 / sizeof(OutputType) : 1;
+}
+
+template <typename T, int N>
+struct alignas(sizeof(T) * N) OneHotVec {
+  T v[N];
+};
+
+/**
+ * @brief Writes the one-hot encoding, OneHotVecSize<OutputType>() consecutive outputs per thread
+ *
+ * The output index is decomposed into (outer, class, inner) coordinates only once per vector;
+ * the following outputs are handled by incrementing the coordinates. If the output is suitably
+ * aligned, the vector is written with a single wide store.
+ *
+ * If `class_map` is not null, the input values are mapped through it before the comparison.
+ */
 template <typename OutputType, typename InputType>
 __global__ void PopulateOneHot(OutputType on_value, OutputType off_value,
-                               const SampleDesc *samples) {
-  uint64_t out_index = static_cast<uint64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
-  uint64_t grid_size = gridDim.x * blockDim.x;
+                               const SampleDesc *samples,
+                               const int *class_map = nullptr, int class_map_size = 0) {
+  constexpr int kVec = OneHotVecSize<OutputType>();
+  using Vec = OneHotVec<OutputType, kVec>;
   const auto &sample = samples[blockIdx.y];
-  for (; out_index < sample.output_vol; out_index += grid_size) {
-    auto *out = static_cast<OutputType*>(sample.out);
-    auto *in = static_cast<const InputType*>(sample.in);
-    uint64_t i = out_index / sample.inner_vol_classes;
-    uint64_t j = out_index % sample.inner_vol;
-    uint64_t in_index = i * sample.inner_vol + j;
-    uint64_t in_val = in[in_index];
-    uint64_t on_out_index = i * sample.inner_vol_classes + in_val * sample.inner_vol + j;
-    out[out_index] = on_out_index == out_index ? on_value : off_value;
+  auto *out = static_cast<OutputType*>(sample.out);
+  auto *in = static_cast<const InputType*>(sample.in);
+  const uint64_t inner_vol = sample.inner_vol;
+  const uint64_t num_classes = sample.num_classes;
+  const uint64_t output_vol = sample.output_vol;
+  const bool aligned = reinterpret_cast<uintptr_t>(out) % sizeof(Vec) == 0;
+  const uint64_t grid_stride = static_cast<uint64_t>(gridDim.x) * blockDim.x * kVec;
+
+  for (uint64_t start = (static_cast<uint64_t>(blockIdx.x) * blockDim.x + threadIdx.x) * kVec;
+       start < output_vol; start += grid_stride) {
+    uint64_t j, c;
+    uint64_t i = div_mod(c, div_mod(j, start, sample.inner_vol), sample.num_classes);
+    uint64_t in_index = i * inner_vol + j;
+    int64_t cls = OneHotClass(in[in_index], class_map, class_map_size);
+    Vec vec;
+    #pragma unroll
+    for (int k = 0; k < kVec; k++) {
+      vec.v[k] = static_cast<int64_t>(c) == cls ? on_value : off_value;
+      if (++j == inner_vol) {
+        j = 0;
+        if (++c == num_classes) {
+          c = 0;
+          i++;
+        }
+      }
+      uint64_t next_index = i * inner_vol + j;
+      if (next_index != in_index && start + k + 1 < output_vol) {
+        in_index = next_index;
+        cls = OneHotClass(in[in_index], class_map, class_map_size);
+      }
+    }
+    if (aligned && start + kVec <= output_vol) {
+      *reinterpret_cast<Vec *>(out + start) = vec;
+    } else {
+      for (int k = 0; k < kVec && start + k < output_vol; k++)
+        out[start + k] = vec.v[k];
+    }
   }
 }
 
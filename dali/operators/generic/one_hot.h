@@ -20,6 +20,9 @@
 
 #include "dali/pipeline/operator/operator.h"
 #include "dali/kernels/kernel_params.h"
+#include "dali/core/force_inline.h"
+#include "dali/core/host_dev.h"
+#include "dali/core/span.h"
 #include "dali/core/tensor_view.h"
 #include "dali/core/static_switch.h"
 
@@ -29,10 +32,27 @@ namespace dali {
 
 namespace detail {
 
+/**
+ * @brief Maps an input value to a class index with an optional class map
+ *
+ * Values outside of the map (or mapped to a negative index) yield -1, which matches no class.
+ */
+template <typename In>
+DALI_HOST_DEV DALI_FORCEINLINE int64_t OneHotClass(In value, const int *class_map,
+                                                   int class_map_size) {
+  auto cls = static_cast<int64_t>(value);
+  if (class_map)
+    cls = cls >= 0 && cls < class_map_size ? class_map[cls] : -1;
+  return cls;
+}
+
 template<typename Out, typename In>
 void DoOneHot(kernels::OutTensorCPU<Out, DynamicDimensions> output,
               kernels::InTensorCPU<In, DynamicDimensions> input, int num_classes,
-              same_as_t<Out> on_value, same_as_t<Out> off_value, int axis) {
+              same_as_t<Out> on_value, same_as_t<Out> off_value, int axis,
+              span<const int> class_map = {}) {
+  const int *map = class_map.empty() ? nullptr : class_map.data();
+  int map_size = class_map.size();
   auto in = input.data;
   auto out = output.data;
   auto volume_outer = volume(output.shape.begin(), output.shape.begin() + axis);
@@ -42,7 +62,7 @@ void DoOneHot(kernels::OutTensorCPU<Out, DynamicDimensions> output,
   }
   for (int64_t outer_coord = 0; outer_coord < volume_outer; outer_coord++) {
     for (int64_t inner_coord = 0; inner_coord < volume_inner; inner_coord++) {
-      int cls = in[outer_coord * volume_inner + inner_coord];
+      int64_t cls = OneHotClass(in[outer_coord * volume_inner + inner_coord], map, map_size);
       if (cls < 0 || cls >= num_classes)
         continue;
       out[outer_coord * volume_inner * num_classes + cls * volume_inner + inner_coord] = on_value;
@@ -61,6 +81,8 @@ class OneHot : public Operator<Backend> {
         output_type_(spec.GetArgument<DALIDataType>(arg_names::kDtype)),
         on_value_(spec.GetArgument<float>("on_value")),
         off_value_(spec.GetArgument<float>("off_value")) {
+    if (spec.HasArgument("class_map"))
+      class_map_ = spec.GetRepeatedArgument<int>("class_map");
     if (spec.HasArgument("axis_name")) {
       auto axis_name = spec.GetArgument<std::string>("axis_name");
       DALI_ENFORCE(axis_name.length() == 1,
@@ -158,6 +180,7 @@ class OneHot : public Operator<Backend> {
   float on_value_;
   float off_value_;
   char new_axis_name_ = 0;
+  std::vector<int> class_map_;
 };
 
 }  // namespace dali
@@ -61,5 +61,26 @@ TYPED_TEST(OneHotOpTest, TestVariousTypes) {
     }
 }
 
+TEST(OneHotOpTest, ClassMap) {
+  std::vector<int> input = { 0, 1, 2, 3, 4, -1 };
+  std::vector<int> class_map = { 2, -1, 0, 1 };
+  int num_classes = 3;
+  std::vector<float> output(input.size() * num_classes);
+  auto in = make_tensor_cpu(static_cast<const int *>(input.data()),
+                            TensorShape<>{static_cast<int64_t>(input.size())});
+  auto out = make_tensor_cpu(output.data(),
+                             TensorShape<>{static_cast<int64_t>(input.size()), num_classes});
+  dali::detail::DoOneHot<float, int>(out, in, num_classes, 1, 0, 1, make_cspan(class_map));
+  std::vector<float> ref = {
+    0, 0, 1,
+    0, 0, 0,
+    1, 0, 0,
+    0, 1, 0,
+    0, 0, 0,
+    0, 0, 0
+  };
+  EXPECT_EQ(output, ref);
+}
+
 }  // namespace testing
 }  // namespace dali
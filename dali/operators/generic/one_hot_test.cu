@@ -59,15 +59,13 @@ struct OneHotOpGpuPerfTest : public ::testing::Test {
 
     auto outer_vol = volume(input_shape.begin(), input_shape.begin() + config_.axis);
     auto inner_vol = volume(input_shape.begin() + config_.axis, input_shape.end());
-    auto inner_vol_classes = inner_vol * config_.num_classes;
-    auto output_vol = outer_vol * inner_vol_classes;
+    auto output_vol = outer_vol * inner_vol * config_.num_classes;
 
-    memset(samples_cpu.data, 0, TestConfig::batch_size * sizeof(detail::SampleDesc));
     auto input_gpu = input_.gpu(stream_);
     auto output_gpu = output_.gpu(stream_);
     for (int sample_id = 0; sample_id < config_.batch_size; ++sample_id) {
       samples_cpu(sample_id)->inner_vol = inner_vol;
-      samples_cpu(sample_id)->inner_vol_classes = inner_vol_classes;
+      samples_cpu(sample_id)->num_classes = config_.num_classes;
       samples_cpu(sample_id)->output_vol = output_vol;
       samples_cpu(sample_id)->out = output_gpu[sample_id].data;
       samples_cpu(sample_id)->in = input_gpu[sample_id].data;
@@ -80,7 +78,8 @@ struct OneHotOpGpuPerfTest : public ::testing::Test {
     auto output_vol = input_vol * config_.num_classes;
 
     const int block = 256;
-    auto grid = detail::gridHelper(output_vol, config_.batch_size, block);
+    constexpr int kVec = detail::OneHotVecSize<Out>();
+    auto grid = detail::gridHelper(div_ceil(output_vol, kVec), config_.batch_size, block);
 
     Out on_value = 1, off_value = 0;
     detail::PopulateOneHot<Out, In><<<grid, block, 0, stream_>>>(on_value, off_value, samples_gpu_);
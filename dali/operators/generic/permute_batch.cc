@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <memory>
 #include <vector>
 #include "dali/operators/generic/permute_batch.h"
 
@@ -23,6 +24,9 @@ on indices given in ``indices`` argument::
 
   out_tensor[i] = in_tensor[indices[i]]
 
+No data is copied on the CPU - the output samples are views of the input samples. On the GPU,
+the output is a view of the input when the indices select consecutive samples, in order;
+otherwise the samples are copied.
 )")
   .NumInput(1)
   .NumOutput(1)
@@ -30,41 +34,57 @@ on indices given in ``indices`` argument::
 of scalars representing indices of the tensors in the input batch.
 
 The indices must be within ``[0..batch_size)`` range. Repetitions and omissions are allowed.)",
-    DALI_INT_VEC, true);
+    DALI_INT_VEC, true)
+  .PassThrough({{0, 0}});
 
 void PermuteBatch<CPUBackend>::RunImpl(HostWorkspace &ws) {
   auto &input = ws.InputRef<CPUBackend>(0);
   auto &output = ws.OutputRef<CPUBackend>(0);
-  const auto &output_shape = output.shape();
+  // the samples can be shared at any position, so the permutation needs no copy
+  output.ShareSamples(input, make_cspan(indices_));
   output.SetLayout(input.GetLayout());
+}
 
-  auto &tp = ws.GetThreadPool();
-  int N = indices_.size();
-  for (int i = 0; i < N; i++) {
-    auto size = output_shape.tensor_size(i);
-    int src = indices_[i];
-    tp.AddWork([&, i, src](int tid) {
-      output.SetMeta(i, input.GetMeta(i));
-      output[i].Copy(input[src], 0);
-    }, size);
+bool PermuteBatch<GPUBackend>::IsInputRange(const TensorList<GPUBackend> &input) const {
+  if (!input.IsContiguousTensor())
+    return false;
+  for (size_t i = 1; i < indices_.size(); i++) {
+    if (indices_[i] != indices_[i - 1] + 1)
+      return false;
   }
-  tp.RunAll();
+  return true;
 }
 
 void PermuteBatch<GPUBackend>::RunImpl(DeviceWorkspace &ws) {
   auto &input = ws.InputRef<GPUBackend>(0);
   auto &output = ws.OutputRef<GPUBackend>(0);
+  int N = indices_.size();
 
+  if (N > 0 && IsInputRange(input)) {
+    // e.g. an identity permutation - the output is a view of a part of the input
+    auto *first = static_cast<const uint8_t *>(input.raw_tensor(indices_[0]));
+    size_t nbytes = output_shape_.num_elements() * input.type_info().size();
+    output.Reset();
+    output.ShareData(shared_ptr<void>(input.get_data_ptr(), const_cast<uint8_t *>(first)),
+                     nbytes, output_shape_, input.type());
+    output.set_device_id(input.device_id());
+    output.SetLayout(input.GetLayout());
+    for (int i = 0; i < N; i++)
+      output.SetMeta(i, input.GetMeta(indices_[i]));
+    return;
+  }
+
+  // the output must be contiguous - gather the samples into a buffer of its own
+  if (output.shares_data())
+    output.Reset();
+  output.Resize(output_shape_, input.type());
   output.SetLayout(input.GetLayout());
-  int N = indices_.size();
   for (int i = 0; i < N; i++)
     output.SetMeta(i, input.GetMeta(indices_[i]));
 
-  const auto &out_shape = output.shape();
   int element_size = output.type_info().size();
-
   for (int i = 0; i < N; i++) {
-    auto size = out_shape.tensor_size(i) * element_size;
+    auto size = output_shape_.tensor_size(i) * element_size;
     sg_.AddCopy(output.raw_mutable_tensor(i), input.raw_tensor(indices_[i]), size);
   }
   sg_.Run(ws.stream());
@@ -61,16 +61,18 @@ class PermuteBatchBase : public Operator<Backend> {
       for (int d = 0; d < D; d++)
         out_ts[d] = in_ts[d];
     }
-    return true;
+    output_shape_ = out_shape;
+    return false;
   }
 
   bool CanInferOutputs() const override {
-    return true;
+    // the output is a view of the input whenever possible; it's allocated only for a copy
+    return false;
   }
 
-
  protected:
   vector<int> indices_;
+  TensorListShape<> output_shape_;
   bool has_indices_input_ = false;
 };
 
@@ -96,6 +98,14 @@ class PermuteBatch<GPUBackend> : public PermuteBatchBase<GPUBackend> {
   void RunImpl(DeviceWorkspace &ws) override;
 
  private:
+  /**
+   * @brief Tells if the output is a contiguous range of the input
+   *
+   * A TensorList can't alias its samples at arbitrary positions - it can only be a view of
+   * a range of the input samples, in order.
+   */
+  bool IsInputRange(const TensorList<GPUBackend> &input) const;
+
   kernels::ScatterGatherGPU sg_;
 };
 
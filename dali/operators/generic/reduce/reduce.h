@@ -119,23 +119,18 @@ class Reduce : public Operator<Backend>, detail::AxesHelper {
     int num_threads = thread_pool.NumThreads();
 
     using Kernel = ReductionType<OutputType, InputType>;
-    kmgr_.template Resize<Kernel>(num_threads, num_threads);
-
-    for (int sample = 0; sample < in_view.num_samples(); sample++) {
-      int64_t priority = volume(in_view.shape.tensor_shape_span(sample));
-      thread_pool.AddWork(
-        [&, sample](int thread_id) {
-          auto in_sample_view = in_view[sample];
-          auto out_sample_view = out_view[sample];
-          kernels::KernelContext ctx;
-
-          kmgr_.Setup<Kernel>(
-            thread_id, ctx, out_sample_view, in_sample_view, make_cspan(axes_));
-          kmgr_.Run<Kernel>(thread_id, thread_id, ctx);
-        },
-        priority);
+    int nsamples = in_view.num_samples();
+    // one instance per sample - big samples are split between multiple threads
+    kmgr_.template Resize<Kernel>(num_threads, nsamples);
+
+    for (int sample = 0; sample < nsamples; sample++) {
+      kernels::KernelContext ctx;
+      kmgr_.Setup<Kernel>(sample, ctx, out_view[sample], in_view[sample], make_cspan(axes_));
+      kmgr_.Get<Kernel>(sample).Schedule(thread_pool);
     }
     thread_pool.RunAll();
+    for (int sample = 0; sample < nsamples; sample++)
+      kmgr_.Get<Kernel>(sample).Finalize();
   }
 
   template <typename OutputType, typename InputType>
@@ -97,35 +97,36 @@ class ReduceWithMeanInput : public Operator<Backend>, detail::AxesHelper {
     int num_threads = thread_pool.NumThreads();
 
     using Kernel = ReductionType<OutputType, InputType, OutputType>;
-    kmgr_.template Resize<Kernel>(num_threads, num_threads);
-
-    for (int sample = 0; sample < in_view.num_samples(); sample++) {
-      int64_t priority = volume(in_view.shape.tensor_shape_span(sample));
-      thread_pool.AddWork(
-        [&, sample](int thread_id) {
-          auto in_sample_view = in_view[sample];
-          auto mean_sample_view = mean_view[sample];
-          auto out_sample_view = out_view[sample];
-          kernels::KernelContext ctx;
-
-          kmgr_.Setup<Kernel>(
-            thread_id,
-            ctx,
-            out_sample_view,
-            in_sample_view,
-            make_cspan(axes_),
-            mean_sample_view,
-            ddof_);
-          if (!has_empty_axes_arg_) {
-            kmgr_.Run<Kernel>(thread_id, thread_id, ctx);
-          } else {
-            OutputType *data = out_sample_view.data;
-            std::fill(data, data + out_sample_view.num_elements(), 0);
-          }
-        },
-        priority);
+    int nsamples = in_view.num_samples();
+    // one instance per sample - big samples are split between multiple threads
+    kmgr_.template Resize<Kernel>(num_threads, nsamples);
+
+    for (int sample = 0; sample < nsamples; sample++) {
+      auto out_sample_view = out_view[sample];
+      kernels::KernelContext ctx;
+      kmgr_.Setup<Kernel>(
+        sample,
+        ctx,
+        out_sample_view,
+        in_view[sample],
+        make_cspan(axes_),
+        mean_view[sample],
+        ddof_);
+      if (!has_empty_axes_arg_) {
+        kmgr_.Get<Kernel>(sample).Schedule(thread_pool);
+      } else {
+        OutputType *data = out_sample_view.data;
+        int64_t size = out_sample_view.num_elements();
+        thread_pool.AddWork([data, size](int) {
+          std::fill(data, data + size, 0);
+        }, size);
+      }
     }
     thread_pool.RunAll();
+    if (!has_empty_axes_arg_) {
+      for (int sample = 0; sample < nsamples; sample++)
+        kmgr_.Get<Kernel>(sample).Finalize();
+    }
   }
 
   template <typename OutputType, typename InputType>
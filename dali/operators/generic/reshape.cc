@@ -30,6 +30,7 @@ DALI_SCHEMA(Reshape)
 The buffer contents are not copied.)code")
   .NumInput(1, 2)
   .NumOutput(1)
+  .Deterministic()
   .InputDox(0, "data", "TensorList", "Data to be reshaped")
   .InputDox(1, "shape_input", "1D TensorList of integers", "Same as `shape` keyword argument")
   .PassThrough({{0, 0}})
@@ -87,6 +88,7 @@ DALI_SCHEMA(Reinterpret)
 The buffer contents are not copied.)")
   .NumInput(1, 2)
   .NumOutput(1)
+  .Deterministic()
   .InputDox(0, "data", "TensorList", "Data to be reshaped")
   .InputDox(1, "shape_input", "1D TensorList of integers", "Same as `shape` keyword argument")
   .PassThrough({{0, 0}})
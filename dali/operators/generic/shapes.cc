@@ -20,6 +20,7 @@ DALI_SCHEMA(Shapes)
     .DocStr(R"code(Returns the shapes of inputs.)code")
     .NumInput(1)
     .NumOutput(1)
+    .Deterministic()
     .AllowSequences()
     .SupportVolumetric()
     .AddOptionalArg("dtype", R"code(Data type to which the sizes are converted.)code", DALI_INT64)
@@ -50,10 +50,15 @@ The slice arguments should provide as many dimensions as specified by the ``axis
 arguments.
 
 By default, the :meth:`nvidia.dali.fn.slice` operator uses normalized coordinates and ``WH``
-order for the slice arguments.)code")
+order for the slice arguments.
+
+On the CPU, when the slice takes a range of the outermost dimension of the input (and the whole
+extent of the other dimensions), the output is a view of the input and no data is copied.)code")
     .NumInput(1, 3)
     .InputDevice(1, 3, InputDevice::CPU)
     .NumOutput(1)
+    .Deterministic()
+    .PassThrough({{0, 0}})
     .InputDox(0, "data", "TensorList", R"code(Batch that contains the input data.)code")
     .InputDox(1, "anchor", "1D TensorList of float or int",
                  R"code((Optional) Input that contains normalized or absolute coordinates for the starting
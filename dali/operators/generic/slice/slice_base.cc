@@ -36,15 +36,52 @@ class SliceBaseCpu : public OpImplBase<CPUBackend> {
   using Kernel = kernels::SliceCPU<OutputType, InputType, Dims>;
   using SliceArgs = kernels::SliceArgs<OutputType, Dims>;
 
+  /**
+   * @param share_input  if true, the output is a view of the input when possible; otherwise
+   *                     the output is allocated here, as the executor doesn't allocate it
+   */
+  explicit SliceBaseCpu(bool share_input) : share_input_(share_input) {}
+
   bool SetupImpl(std::vector<OutputDesc> &output_desc, const workspace_t<CPUBackend> &ws) override;
   void RunImpl(workspace_t<CPUBackend> &ws) override;
 
   std::vector<SliceArgs>& Args() { return args_; }
 
  private:
+  /**
+   * @brief Checks if the slices take whole elements of the outermost dimension (and nothing
+   *        more), so that they can be shared, and calculates their offsets
+   */
+  bool IsOuterDimSlice(const TensorVector<CPUBackend> &input);
+
   std::vector<SliceArgs> args_;
+  bool share_input_ = false;
+  TensorListShape<> output_shape_;
+  std::vector<int64_t> view_offsets_;
 };
 
+template <typename OutputType, typename InputType, int Dims>
+bool SliceBaseCpu<OutputType, InputType, Dims>::IsOuterDimSlice(
+    const TensorVector<CPUBackend> &input) {
+  if (!std::is_same<OutputType, InputType>::value)
+    return false;
+  int nsamples = input.ntensor();
+  view_offsets_.resize(nsamples);
+  for (int i = 0; i < nsamples; i++) {
+    const auto &in_shape = input[i].shape();
+    const auto &args = args_[i];
+    if (args.anchor[0] < 0 || args.anchor[0] + args.shape[0] > in_shape[0])
+      return false;
+    for (int d = 1; d < Dims; d++) {
+      if (args.anchor[d] != 0 || args.shape[d] != in_shape[d])
+        return false;
+    }
+    view_offsets_[i] =
+        args.anchor[0] * volume(in_shape.begin() + 1, in_shape.end()) * sizeof(InputType);
+  }
+  return true;
+}
+
 template <typename OutputType, typename InputType, int Dims>
 bool SliceBaseCpu<OutputType, InputType, Dims>::SetupImpl(std::vector<OutputDesc> &output_desc,
                                                           const workspace_t<CPUBackend> &ws) {
@@ -65,13 +102,23 @@ bool SliceBaseCpu<OutputType, InputType, Dims>::SetupImpl(std::vector<OutputDesc
     auto out_shape = req.output_shapes[0][0].shape;
     output_desc[0].shape.set_tensor_shape(i, out_shape);
   }
-  return true;
+  output_shape_ = output_desc[0].shape;
+  return !share_input_;
 }
 
 template <typename OutputType, typename InputType, int Dims>
 void SliceBaseCpu<OutputType, InputType, Dims>::RunImpl(workspace_t<CPUBackend> &ws) {
   const auto &input = ws.template InputRef<CPUBackend>(0);
   auto &output = ws.template OutputRef<CPUBackend>(0);
+  if (share_input_) {
+    if (IsOuterDimSlice(input)) {
+      output.ShareSamples(input, make_cspan(view_offsets_), output_shape_);
+      output.SetLayout(input.GetLayout());
+      return;
+    }
+    output.SetContiguous(true);
+    output.Resize(output_shape_, type2id<OutputType>::value);
+  }
   output.SetLayout(input.GetLayout());
 
   int nsamples = input.size();
@@ -110,13 +157,13 @@ bool SliceBase<CPUBackend>::SetupImpl(std::vector<OutputDesc> &output_desc,
       if (input_type_ == output_type) {
         using Impl = SliceBaseCpu<InputType, InputType, Dims>;
         if (!impl_)
-          impl_ = std::make_unique<Impl>();
+          impl_ = std::make_unique<Impl>(CanShareInput());
         FillArgs(reinterpret_cast<Impl*>(impl_.get())->Args(), ws);
       } else {
         TYPE_SWITCH(output_type, type2id, OutputType, (float, float16, uint8_t), (
           using Impl = SliceBaseCpu<OutputType, InputType, Dims>;
           if (!impl_)
-            impl_ = std::make_unique<Impl>();
+            impl_ = std::make_unique<Impl>(CanShareInput());
           FillArgs(reinterpret_cast<Impl*>(impl_.get())->Args(), ws);
         ), DALI_FAIL(make_string("Not supported output type: ", output_type));); // NOLINT
       }
@@ -17,6 +17,7 @@
 
 #include <memory>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 #include "dali/core/any.h"
@@ -83,8 +84,20 @@ class SliceBase : public Operator<Backend> {
   virtual const CropWindowGenerator& GetCropWindowGenerator(std::size_t data_idx) const = 0;
 
   bool CanInferOutputs() const override {
-    return true;
+    // the operators returning views of the input allocate the output only when they copy
+    return !CanShareInput();
   }
+
+  /**
+   * @brief Tells if the output can be a view of the input
+   *
+   * The CPU operators which declare the input as passed through return views of the input
+   * for the slices along the outermost dimension only.
+   */
+  bool CanShareInput() const {
+    return std::is_same<Backend, CPUBackend>::value && spec_.GetSchema().HasPassThrough();
+  }
+
   bool SetupImpl(std::vector<OutputDesc> &output_desc, const workspace_t<Backend> &ws) override;
   void RunImpl(workspace_t<Backend> &ws) override;
 
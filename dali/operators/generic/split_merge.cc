@@ -0,0 +1,192 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vector>
+#include "dali/operators/generic/split_merge.h"
+#include "dali/core/static_switch.h"
+
+namespace dali {
+
+DALI_SCHEMA(conditional__Split)
+  .DocStr(R"(Splits the batch into two batches, based on a per-sample ``predicate``.
+
+The first output contains the samples for which the predicate is true and the second output
+contains the remaining samples. The relative order of the samples is preserved in both outputs.
+
+Together with :meth:`nvidia.dali.fn.conditional.merge`, this allows to apply an operation only to
+some of the samples, so that its cost is proportional to the number of the selected samples::
+
+  flip = fn.random.coin_flip(probability=0.1)
+  selected, rest = fn.conditional.split(images, predicate=flip)
+  images = fn.conditional.merge(fn.rotate(selected, angle=90), rest, predicate=flip)
+
+The outputs have fewer samples than the input. The operators processing them should take
+their arguments either as constants or from batches which were split with the same predicate.
+)")
+  .NumInput(1)
+  .NumOutput(2)
+  .AddArg("predicate", R"(A boolean or integral value, or a batch of such scalars.
+
+The samples for which the predicate is nonzero go to the first output and the remaining
+samples to the second one.)",
+    DALI_BOOL, true);
+
+DALI_SCHEMA(conditional__Merge)
+  .DocStr(R"(Merges two batches produced with :meth:`nvidia.dali.fn.conditional.split` back into
+one batch, in the original order.
+
+The i-th output sample is the next sample from the first input if ``predicate[i]`` is true
+or the next sample from the second input otherwise. The inputs must have the same type and
+dimensionality.
+)")
+  .NumInput(2)
+  .NumOutput(1)
+  .AddArg("predicate", R"(A boolean or integral value, or a batch of such scalars.
+
+This must be the same predicate that was used to split the batch.)",
+    DALI_BOOL, true);
+
+void GetPredicate(std::vector<bool> &predicate, const OpSpec &spec, const ArgumentWorkspace &ws,
+                  int nsamples) {
+  if (!spec.HasTensorArgument("predicate")) {
+    predicate.assign(nsamples, spec.GetArgument<bool>("predicate"));
+    return;
+  }
+  const auto &arg = ws.ArgumentInput("predicate");
+  int arg_samples = arg.ntensor();
+  DALI_ENFORCE(arg_samples == nsamples, make_string("The predicate has ", arg_samples,
+               " samples, but ", nsamples, " samples were expected."));
+  predicate.resize(nsamples);
+  TYPE_SWITCH(arg.type(), type2id, T,
+              (bool, uint8_t, int8_t, uint16_t, int16_t, uint32_t, int32_t, uint64_t, int64_t), (
+    for (int i = 0; i < nsamples; i++) {
+      DALI_ENFORCE(volume(arg[i].shape()) == 1, make_string(
+          "The predicate must be a batch of scalars. Got a sample of shape ", arg[i].shape(),
+          " at index ", i, "."));
+      predicate[i] = arg[i].data<T>()[0] != 0;
+    }
+  ), DALI_FAIL(make_string("The predicate must be boolean or integral. Got: ", arg.type())););  // NOLINT
+}
+
+template <typename Backend>
+bool Split<Backend>::SetupImpl(std::vector<OutputDesc> &output_desc,
+                               const workspace_t<Backend> &ws) {
+  const auto &input = ws.template InputRef<Backend>(0);
+  const auto &in_shape = input.shape();
+  int nsamples = in_shape.num_samples();
+  GetPredicate(this->predicate_, this->spec_, ws, nsamples);
+  this->layout_ = input.GetLayout();
+
+  this->copies_.clear();
+  int out_samples[2] = { 0, 0 };
+  for (int i = 0; i < nsamples; i++) {
+    int out_idx = this->predicate_[i] ? 0 : 1;
+    this->copies_.push_back({ out_idx, out_samples[out_idx]++, 0, i });
+  }
+
+  output_desc.resize(2);
+  for (int o = 0; o < 2; o++) {
+    output_desc[o].type = input.type();
+    output_desc[o].shape.resize(out_samples[o], in_shape.sample_dim());
+  }
+  for (auto &c : this->copies_)
+    output_desc[c.out_idx].shape.set_tensor_shape(c.out_sample, in_shape[c.in_sample]);
+  return true;
+}
+
+template <typename Backend>
+bool Merge<Backend>::SetupImpl(std::vector<OutputDesc> &output_desc,
+                               const workspace_t<Backend> &ws) {
+  const auto &in_true = ws.template InputRef<Backend>(0);
+  const auto &in_false = ws.template InputRef<Backend>(1);
+  const auto &true_shape = in_true.shape();
+  const auto &false_shape = in_false.shape();
+  int num_true = true_shape.num_samples();
+  int num_false = false_shape.num_samples();
+  int nsamples = num_true + num_false;
+  DALI_ENFORCE(nsamples <= this->max_batch_size_, make_string("The merged batch has ", nsamples,
+               " samples, which exceeds the maximum batch size of ", this->max_batch_size_, "."));
+  GetPredicate(this->predicate_, this->spec_, ws, nsamples);
+
+  // an empty branch may not carry a meaningful type or dimensionality
+  if (num_true > 0 && num_false > 0) {
+    DALI_ENFORCE(in_true.type() == in_false.type(), make_string(
+        "The merged batches must have the same type. Got: ", in_true.type(), " and ",
+        in_false.type(), "."));
+    DALI_ENFORCE(true_shape.sample_dim() == false_shape.sample_dim(), make_string(
+        "The merged batches must have the same dimensionality. Got: ", true_shape.sample_dim(),
+        " and ", false_shape.sample_dim(), "."));
+  }
+  const auto &ref = num_true > 0 || num_false == 0 ? in_true : in_false;
+  this->layout_ = ref.GetLayout();
+
+  this->copies_.clear();
+  int in_samples[2] = { 0, 0 };
+  for (int i = 0; i < nsamples; i++) {
+    int in_idx = this->predicate_[i] ? 0 : 1;
+    this->copies_.push_back({ 0, i, in_idx, in_samples[in_idx]++ });
+  }
+  DALI_ENFORCE(in_samples[0] == num_true && in_samples[1] == num_false, make_string(
+      "The predicate selects ", in_samples[0], " samples from the first input and ", in_samples[1],
+      " from the second one, but the inputs have ", num_true, " and ", num_false,
+      " samples. The same predicate must be used to split and merge the batch."));
+
+  output_desc.resize(1);
+  output_desc[0].type = ref.type();
+  output_desc[0].shape.resize(nsamples, ref.shape().sample_dim());
+  for (auto &c : this->copies_) {
+    const auto &shape = c.in_idx == 0 ? true_shape : false_shape;
+    output_desc[0].shape.set_tensor_shape(c.out_sample, shape[c.in_sample]);
+  }
+  return true;
+}
+
+template <>
+void SplitMergeBase<CPUBackend>::CopySamples(HostWorkspace &ws) {
+  for (int o = 0; o < ws.NumOutput(); o++)
+    ws.OutputRef<CPUBackend>(o).SetLayout(layout_);
+
+  auto &tp = ws.GetThreadPool();
+  for (auto &c : copies_) {
+    auto &input = ws.InputRef<CPUBackend>(c.in_idx);
+    auto &output = ws.OutputRef<CPUBackend>(c.out_idx);
+    tp.AddWork([&, c](int tid) {
+      output.SetMeta(c.out_sample, input.GetMeta(c.in_sample));
+      output[c.out_sample].Copy(input[c.in_sample], 0);
+    }, input.shape().tensor_size(c.in_sample));
+  }
+  tp.RunAll();
+}
+
+template <>
+void SplitMergeBase<GPUBackend>::CopySamples(DeviceWorkspace &ws) {
+  for (int o = 0; o < ws.NumOutput(); o++)
+    ws.OutputRef<GPUBackend>(o).SetLayout(layout_);
+
+  for (auto &c : copies_) {
+    auto &input = ws.InputRef<GPUBackend>(c.in_idx);
+    auto &output = ws.OutputRef<GPUBackend>(c.out_idx);
+    output.SetMeta(c.out_sample, input.GetMeta(c.in_sample));
+    auto size = input.shape().tensor_size(c.in_sample) * input.type_info().size();
+    sg_->AddCopy(output.raw_mutable_tensor(c.out_sample), input.raw_tensor(c.in_sample), size);
+  }
+  sg_->Run(ws.stream());
+}
+
+DALI_REGISTER_OPERATOR(conditional__Split, Split<CPUBackend>, CPU);
+DALI_REGISTER_OPERATOR(conditional__Split, Split<GPUBackend>, GPU);
+DALI_REGISTER_OPERATOR(conditional__Merge, Merge<CPUBackend>, CPU);
+DALI_REGISTER_OPERATOR(conditional__Merge, Merge<GPUBackend>, GPU);
+
+}  // namespace dali
@@ -0,0 +1,121 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_GENERIC_SPLIT_MERGE_H_
+#define DALI_OPERATORS_GENERIC_SPLIT_MERGE_H_
+
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include "dali/kernels/common/scatter_gather.h"
+#include "dali/pipeline/operator/operator.h"
+
+namespace dali {
+
+/**
+ * @brief Reads the per-sample predicate, given either as a constant or as an argument input
+ *        with one boolean or integral value per sample.
+ */
+void GetPredicate(std::vector<bool> &predicate, const OpSpec &spec, const ArgumentWorkspace &ws,
+                  int nsamples);
+
+/**
+ * @brief Base of the operators which change the number of samples in the batch.
+ *
+ * The batch size of the outputs of such operators differs from the batch size of the inputs,
+ * so the default checks of the uniform batch size are not applied.
+ */
+template <typename Backend>
+class SplitMergeBase : public Operator<Backend> {
+ public:
+  explicit SplitMergeBase(const OpSpec &spec)
+      : Operator<Backend>(spec), max_batch_size_(spec.GetArgument<int>("max_batch_size")) {
+    if (std::is_same<Backend, GPUBackend>::value)
+      sg_ = std::make_unique<kernels::ScatterGatherGPU>(1 << 18, max_batch_size_);
+  }
+
+  using Operator<Backend>::Setup;
+  using Operator<Backend>::Run;
+
+  bool Setup(std::vector<OutputDesc> &output_desc, const workspace_t<Backend> &ws) override {
+    return this->SetupImpl(output_desc, ws);
+  }
+
+  void Run(workspace_t<Backend> &ws) override {
+    this->RunImpl(ws);
+  }
+
+  bool CanInferOutputs() const override {
+    return true;
+  }
+
+ protected:
+  struct SampleCopy {
+    int out_idx;   // the index of the output
+    int out_sample, in_idx, in_sample;
+  };
+
+  /**
+   * @brief Copies the samples, as described by copies_, from the inputs to the outputs
+   */
+  void CopySamples(workspace_t<Backend> &ws);
+
+  int max_batch_size_;
+  TensorLayout layout_;
+  std::vector<bool> predicate_;
+  std::vector<SampleCopy> copies_;
+  std::unique_ptr<kernels::ScatterGatherGPU> sg_;
+};
+
+template <>
+void SplitMergeBase<CPUBackend>::CopySamples(HostWorkspace &ws);
+
+template <>
+void SplitMergeBase<GPUBackend>::CopySamples(DeviceWorkspace &ws);
+
+/**
+ * @brief Splits the batch into the samples for which the predicate is true and the remaining ones
+ */
+template <typename Backend>
+class Split : public SplitMergeBase<Backend> {
+ public:
+  using SplitMergeBase<Backend>::SplitMergeBase;
+  using Operator<Backend>::RunImpl;
+
+ protected:
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const workspace_t<Backend> &ws) override;
+  void RunImpl(workspace_t<Backend> &ws) override {
+    this->CopySamples(ws);
+  }
+};
+
+/**
+ * @brief Merges the outputs of the two branches back into one batch, in the original order
+ */
+template <typename Backend>
+class Merge : public SplitMergeBase<Backend> {
+ public:
+  using SplitMergeBase<Backend>::SplitMergeBase;
+  using Operator<Backend>::RunImpl;
+
+ protected:
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const workspace_t<Backend> &ws) override;
+  void RunImpl(workspace_t<Backend> &ws) override {
+    this->CopySamples(ws);
+  }
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_GENERIC_SPLIT_MERGE_H_
@@ -41,14 +41,13 @@ class TransposeCPU : public Transpose<CPUBackend> {
 
     TYPE_SWITCH(input_type, type2id, T, TRANSPOSE_ALLOWED_TYPES, (
       for (int i = 0; i < nsamples; i++) {
-        thread_pool.AddWork(
-          [this, &input, &output, i](int thread_id) {
-            TensorShape<> src_ts = input.shape()[i];
-            auto dst_ts = permute(src_ts, perm_);
-            kernels::TransposeGrouped(
-                TensorView<StorageCPU, T>{output[i].mutable_data<T>(), dst_ts},
-                TensorView<StorageCPU, const T>{input[i].data<T>(), src_ts}, make_cspan(perm_));
-          }, out_shape.tensor_size(i));
+        // big samples are split into blocks processed by multiple threads
+        TensorShape<> src_ts = input.shape()[i];
+        auto dst_ts = permute(src_ts, perm_);
+        kernels::TransposeGrouped(
+            thread_pool,
+            TensorView<StorageCPU, T>{output[i].mutable_data<T>(), dst_ts},
+            TensorView<StorageCPU, const T>{input[i].data<T>(), src_ts}, make_cspan(perm_));
       }
     ), DALI_FAIL(make_string("Unsupported input type: ", input_type)));  // NOLINT
     thread_pool.RunAll();
@@ -77,6 +76,7 @@ for all valid coordinates.
 )code")
     .NumInput(1)
     .NumOutput(1)
+    .Deterministic()
     .AllowSequences()
     .SupportVolumetric()
     .AddArg("perm",
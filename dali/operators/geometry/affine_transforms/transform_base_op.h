@@ -56,6 +56,9 @@ class TransformBaseOp : public Operator<Backend> {
 
   bool CanInferOutputs() const override { return true; }
 
+  // without the argument inputs, the arguments are the same in every iteration
+  bool HasInvariantOutputs() const override { return true; }
+
   TransformImpl &This() noexcept { return static_cast<TransformImpl&>(*this); }
   const TransformImpl &This() const noexcept { return static_cast<const TransformImpl&>(*this); }
 
@@ -12,8 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <map>
 #include "dali/operators/image/color/color_space_conversion.h"
+#include "dali/pipeline/util/sample_scheduler.h"
 #include "dali/util/ocv.h"
 
 namespace dali {
@@ -22,12 +24,26 @@ DALI_SCHEMA(ColorSpaceConversion)
     .DocStr(R"code(Converts between various image color models.)code")
     .NumInput(1)
     .NumOutput(1)
-    .InputLayout({"FDHWC", "FHWC", "DHWC", "HWC"})
-    .AddArg("image_type", R"code(The color space of the input image.)code", DALI_IMAGE_TYPE)
-    .AddArg("output_type", R"code(The color space of the output image.)code", DALI_IMAGE_TYPE)
+    .Deterministic()
+    .InputLayout({"FDHWC", "FHWC", "DHWC", "HWC", "HW"})
+    .AddArg("image_type", R"code(The color space of the input image.
+
+``YUV420`` images are 2D tensors, holding the full resolution Y plane followed by the Cb and Cr
+planes, subsampled 2x in both dimensions. The image is converted with the chroma of the 2x2 block
+covering each pixel.)code", DALI_IMAGE_TYPE)
+    .AddArg("output_type", R"code(The color space of the output image.
+
+When converting to ``YUV420``, the chroma of each 2x2 block of pixels is averaged. Only single
+images (``HWC``) can be converted from or to ``YUV420``.)code", DALI_IMAGE_TYPE)
     .AllowSequences()
     .SupportVolumetric();
 
+namespace {
+
+constexpr int64_t kMinRowsPerJob = 16;
+
+}  // namespace
+
 template <>
 void ColorSpaceConversion<CPUBackend>::RunImpl(HostWorkspace &ws) {
   const auto &input = ws.InputRef<CPUBackend>(0);
@@ -40,21 +56,48 @@ void ColorSpaceConversion<CPUBackend>::RunImpl(HostWorkspace &ws) {
   int nsamples = in_sh.num_samples();
   int ndim = in_sh.sample_dim();
   auto& thread_pool = ws.GetThreadPool();
+  SampleScheduler scheduler;
+  if (input_type_ == DALI_YUV420 || output_type_ == DALI_YUV420) {
+    output.SetLayout(output_type_ == DALI_YUV420 ? "HW" : "HWC");
+    for (int i = 0; i < nsamples; i++) {
+      auto yuv_sh = input_type_ == DALI_YUV420 ? in_sh[i] : out_sh[i];
+      auto layout = kernels::color::YUV420Layout::FromShape(yuv_sh[0], yuv_sh[1]);
+      // a band of rows must hold whole 2x2 blocks, so the bands are measured in chroma rows
+      scheduler.AddSplittableSample(layout.luma_size(), layout.chroma_height(),
+        [&, i, layout](int thread_id, int64_t begin, int64_t end) {
+          for (int64_t by = begin; by < end; by++) {
+            if (output_type_ == DALI_YUV420) {
+              for (int64_t bx = 0; bx < layout.chroma_width(); bx++)
+                kernels::color::ToYUV420Block(out_view[i].data, layout, in_view[i].data,
+                                              input_type_, bx, by);
+            } else {
+              for (int64_t y = 2 * by; y < std::min(2 * by + 2, layout.height); y++)
+                for (int64_t x = 0; x < layout.width; x++)
+                  kernels::color::FromYUV420Pixel(out_view[i].data, output_type_,
+                                                  in_view[i].data, layout, x, y);
+            }
+          }
+        }, kMinRowsPerJob / 2);
+    }
+    scheduler.Run(thread_pool);
+    return;
+  }
   for (int i = 0; i < nsamples; i++) {
-    thread_pool.AddWork(
-      [&, i](int thread_id) {
-        auto in_sample_sh = in_sh.tensor_shape_span(i);
-        // flatten any leading dimensions together with the height
-        int height = volume(in_sample_sh.begin(), in_sample_sh.end() - 2);
-        int width  = in_sample_sh[ndim - 2];
-        auto cv_in =
-          CreateMatFromPtr(height, width, GetOpenCvChannelType(in_nchannels_), in_view[i].data);
-        auto cv_out =
-          CreateMatFromPtr(height, width, GetOpenCvChannelType(out_nchannels_), out_view[i].data);
+    auto in_sample_sh = in_sh.tensor_shape_span(i);
+    // flatten any leading dimensions together with the height
+    int64_t height = volume(in_sample_sh.begin(), in_sample_sh.end() - 2);
+    // the pixels are converted independently, so a large image can be split into bands of rows
+    scheduler.AddSplittableSample(in_sh.tensor_size(i), height,
+      [&, i](int thread_id, int64_t begin, int64_t end) {
+        int width = in_sh.tensor_shape_span(i)[ndim - 2];
+        auto cv_in = CreateMatFromPtr(end - begin, width, GetOpenCvChannelType(in_nchannels_),
+                                      in_view[i].data + begin * width * in_nchannels_);
+        auto cv_out = CreateMatFromPtr(end - begin, width, GetOpenCvChannelType(out_nchannels_),
+                                       out_view[i].data + begin * width * out_nchannels_);
         OpenCvColorConversion(input_type_, cv_in, output_type_, cv_out);
-      }, in_sh.tensor_size(i));
+      }, kMinRowsPerJob);
   }
-  thread_pool.RunAll();
+  scheduler.Run(thread_pool);
 }
 
 DALI_REGISTER_OPERATOR(ColorSpaceConversion, ColorSpaceConversion<CPUBackend>, CPU);
@@ -17,6 +17,7 @@
 #include <vector>
 #include "dali/operators/image/color/color_space_conversion.h"
 #include "dali/kernels/imgproc/color_manipulation/color_space_conversion_kernel.cuh"
+#include "dali/kernels/imgproc/color_manipulation/yuv420.h"
 #include "dali/core/dev_buffer.h"
 #include "dali/core/geom/vec.h"
 
@@ -26,12 +27,22 @@ template<>
 void ColorSpaceConversion<GPUBackend>::RunImpl(DeviceWorkspace &ws) {
   const auto& input = ws.InputRef<GPUBackend>(0);
   auto& output = ws.OutputRef<GPUBackend>(0);
-  output.SetLayout(input.GetLayout());
   auto in_view = view<const uint8_t>(input);
   auto out_view = view<uint8_t>(output);
   const auto &in_sh = in_view.shape;
   int nsamples = in_sh.num_samples();
   auto stream = ws.stream();
+  if (input_type_ == DALI_YUV420 || output_type_ == DALI_YUV420) {
+    output.SetLayout(output_type_ == DALI_YUV420 ? "HW" : "HWC");
+    for (int i = 0; i < nsamples; ++i) {
+      auto yuv_sh = input_type_ == DALI_YUV420 ? in_sh[i] : out_view.shape[i];
+      auto layout = kernels::color::YUV420Layout::FromShape(yuv_sh[0], yuv_sh[1]);
+      kernels::color::RunYUV420ConversionKernel(out_view[i].data, in_view[i].data, output_type_,
+                                                input_type_, layout, stream);
+    }
+    return;
+  }
+  output.SetLayout(input.GetLayout());
   for (int i = 0; i < nsamples; ++i) {
     auto sample_sh = in_sh.tensor_shape_span(i);
     int64_t npixels = volume(sample_sh.begin(), sample_sh.end() - 1);
@@ -18,6 +18,7 @@
 
 #include <vector>
 
+#include "dali/kernels/imgproc/color_manipulation/yuv420.h"
 #include "dali/pipeline/operator/operator.h"
 
 namespace dali {
@@ -29,8 +30,10 @@ class ColorSpaceConversion : public Operator<Backend> {
       : Operator<Backend>(spec),
         input_type_(spec.GetArgument<DALIImageType>("image_type")),
         output_type_(spec.GetArgument<DALIImageType>("output_type")),
-        in_nchannels_(NumberOfChannels(input_type_)),
-        out_nchannels_(NumberOfChannels(output_type_)) {
+        in_nchannels_(NumberOfImageChannels(input_type_)),
+        out_nchannels_(NumberOfImageChannels(output_type_)) {
+    DALI_ENFORCE(input_type_ != DALI_YUV420 || output_type_ != DALI_YUV420,
+                 "Conversion from YUV420 to YUV420 is not supported.");
   }
 
  protected:
@@ -44,20 +47,64 @@ class ColorSpaceConversion : public Operator<Backend> {
     auto ndim = in_sh.sample_dim();
     int nsamples = in_sh.num_samples();
     auto in_layout = input.GetLayout();
-    int channel_dim = in_layout.find('C');
-    assert(channel_dim == ndim - 1);  // shoulb be enforced by input layouts
     DALI_ENFORCE(IsType<uint8_t>(input.type()), "Color space conversion accept only uint8 tensors");
+    output_desc[0].type = input.type();
+    if (input_type_ == DALI_YUV420 || output_type_ == DALI_YUV420) {
+      output_desc[0].shape = YUV420OutputShape(in_sh);
+      return true;
+    }
+    int channel_dim = in_layout.find('C');
+    DALI_ENFORCE(channel_dim == ndim - 1, make_string("Expected the input to have the channels "
+                 "as the last dimension, got layout \"", in_layout, "\"."));
     auto out_sh = in_sh;
     for (int i = 0; i < in_sh.num_samples(); i++) {
       int c = in_sh.tensor_shape_span(i)[channel_dim];
       DALI_ENFORCE(in_nchannels_ == c, make_string("Expected ", in_nchannels_, ". Got ", c));
       out_sh.tensor_shape_span(i)[channel_dim] = out_nchannels_;
     }
-    output_desc[0].type = input.type();
     output_desc[0].shape = out_sh;
     return true;
   }
 
+  /**
+   * @brief The number of channels of the interleaved images of given type; the planar YUV420
+   *        images are 2D tensors, which is described as a single channel
+   */
+  static int NumberOfImageChannels(DALIImageType type) {
+    return type == DALI_YUV420 ? 1 : NumberOfChannels(type);
+  }
+
+  /**
+   * @brief Calculates the shape of the output when converting from or to YUV420
+   *
+   * The YUV420 images are 2D ("HW") tensors, holding the planes (see YUV420Layout); the other
+   * images must be interleaved ("HWC").
+   */
+  TensorListShape<> YUV420OutputShape(const TensorListShape<> &in_sh) const {
+    int nsamples = in_sh.num_samples();
+    if (input_type_ == DALI_YUV420) {
+      DALI_ENFORCE(in_sh.sample_dim() == 2,
+                   "A YUV420 input must be a 2D tensor holding the planes of the image.");
+      TensorListShape<> out_sh(nsamples, 3);
+      for (int i = 0; i < nsamples; i++) {
+        auto layout = kernels::color::YUV420Layout::FromShape(in_sh[i][0], in_sh[i][1]);
+        out_sh.set_tensor_shape(i, {layout.height, layout.width, out_nchannels_});
+      }
+      return out_sh;
+    }
+    DALI_ENFORCE(in_sh.sample_dim() == 3,
+                 "Only single images (\"HWC\") can be converted to YUV420.");
+    TensorListShape<> out_sh(nsamples, 2);
+    for (int i = 0; i < nsamples; i++) {
+      auto sample_sh = in_sh[i];
+      DALI_ENFORCE(sample_sh[2] == in_nchannels_,
+                   make_string("Expected ", in_nchannels_, ". Got ", sample_sh[2]));
+      kernels::color::YUV420Layout layout{sample_sh[0], sample_sh[1]};
+      out_sh.set_tensor_shape(i, layout.shape());
+    }
+    return out_sh;
+  }
+
   void RunImpl(workspace_t<Backend> &ws) override;
   USE_OPERATOR_MEMBERS();
   using Operator<Backend>::RunImpl;
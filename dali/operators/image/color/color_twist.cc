@@ -35,7 +35,10 @@ This operator accepts images in the RGB color space.
 For performance reasons, the operation is approximated by a linear transform in the RGB space.
 The color vector is projected along the neutral (gray) axis,
 rotated based on the hue delta, scaled based on the value and saturation multipliers,
-and restored to the original color space.)code")
+and restored to the original color space.
+
+The input can be an image or a sequence of images (``FHWC`` layout). For sequences, the arguments
+can be provided as argument inputs with one value per frame.)code")
     .NumInput(1)
     .NumOutput(1)
     .AddOptionalArg(color::kHue,
@@ -52,9 +55,12 @@ they would in case of rotation.)code",
                     1.0f, true)
     .AddOptionalArg(color::kOutputType, R"code(The output data type.
 
-If a value is not set, the input type is used.)code",
+If a value is not set, the input type is used.
+
+The GPU operator can also produce ``BFLOAT16`` output.)code",
                     DALI_UINT8)
-    .InputLayout(0, "HWC");
+    .InputLayout(0, {"HWC", "FHWC"})
+    .AllowSequences();
 
 DALI_SCHEMA(ColorTransformBase)
     .DocStr(R"code(Base Schema for color transformations operators.)code")
@@ -62,20 +68,29 @@ DALI_SCHEMA(ColorTransformBase)
         R"code(The color space of the input and the output image.)code", DALI_RGB)
     .AddOptionalArg(color::kOutputType, R"code(Output data type.
 
-If not set, the input type is used.)code",
+If not set, the input type is used.
+
+The GPU operator can also produce ``BFLOAT16`` output.)code",
                     DALI_UINT8);
 
 DALI_SCHEMA(Hue)
-    .DocStr(R"code(Changes the hue level of the image.)code")
+    .DocStr(R"code(Changes the hue level of the image.
+
+The input can be an image or a sequence of images (``FHWC`` layout). For sequences, the arguments
+can be provided as argument inputs with one value per frame.)code")
     .NumInput(1)
     .NumOutput(1)
     .AddOptionalArg("hue",
         R"code(The hue change in degrees.)code", 0.f, true)
     .AddParent("ColorTransformBase")
-    .InputLayout(0, "HWC");
+    .InputLayout(0, {"HWC", "FHWC"})
+    .AllowSequences();
 
 DALI_SCHEMA(Saturation)
-    .DocStr(R"code(Changes the saturation level of the image.)code")
+    .DocStr(R"code(Changes the saturation level of the image.
+
+The input can be an image or a sequence of images (``FHWC`` layout). For sequences, the arguments
+can be provided as argument inputs with one value per frame.)code")
     .NumInput(1)
     .NumOutput(1)
     .AddOptionalArg("saturation",
@@ -89,10 +104,14 @@ Example values:
 - `1` - No change to image's saturation.
 )code", 1.f, true)
     .AddParent("ColorTransformBase")
-    .InputLayout(0, "HWC");
+    .InputLayout(0, {"HWC", "FHWC"})
+    .AllowSequences();
 
 DALI_SCHEMA(ColorTwist)
-    .DocStr(R"code(Adjusts hue, saturation and brightness of the image.)code")
+    .DocStr(R"code(Adjusts hue, saturation and brightness of the image.
+
+The input can be an image or a sequence of images (``FHWC`` layout). For sequences, the arguments
+can be provided as argument inputs with one value per frame.)code")
     .NumInput(1)
     .NumOutput(1)
     .AddOptionalArg("hue",
@@ -130,7 +149,8 @@ Example values:
 * `2` - Increase brightness twice.
 )code", 1.f, true)
     .AddParent("ColorTransformBase")
-    .InputLayout(0, "HWC");
+    .InputLayout(0, {"HWC", "FHWC"})
+    .AllowSequences();
 
 
 DALI_REGISTER_OPERATOR(Hsv, ColorTwistCpu, CPU)
@@ -148,8 +168,8 @@ bool ColorTwistCpu::SetupImpl(std::vector<OutputDesc> &output_desc, const HostWo
           {
               using Kernel = TheKernel<OutputType, InputType>;
               kernel_manager_.Initialize<Kernel>();
-              auto shapes = CallSetup<Kernel, InputType>(input);
-              output_desc[0] = {shapes, output_type_};
+              CallSetup<Kernel, InputType>(input);
+              output_desc[0] = {input.shape(), output_type_};
           }
       ), DALI_FAIL(make_string("Unsupported output type: ", output_type_)))  // NOLINT
   ), DALI_FAIL(make_string("Unsupported input type: ", input.type())))  // NOLINT
@@ -168,12 +188,21 @@ void ColorTwistCpu::RunImpl(workspace_t<CPUBackend> &ws) {
           {
               using Kernel = TheKernel<OutputType, InputType>;
               for (int i = 0; i < input.shape().num_samples(); i++) {
+                if (frame_offsets_[i] == frame_offsets_[i + 1])
+                  continue;
                 tp.AddWork([&, i](int thread_id) {
                   kernels::KernelContext ctx;
-                  auto tvin = view<const InputType, 3>(input[i]);
-                  auto tvout = view<OutputType, 3>(output[i]);
-                  kernel_manager_.Run<Kernel>(ws.thread_idx(), i, ctx, tvout, tvin,
-                                              tmatrices_[i], toffsets_[i]);
+                  auto *in_ptr = input[i].template data<InputType>();
+                  auto *out_ptr = output[i].template mutable_data<OutputType>();
+                  for (int f = frame_offsets_[i]; f < frame_offsets_[i + 1]; f++) {
+                    auto frame_shape = frame_shape_[f];
+                    TensorView<StorageCPU, const InputType, 3> tvin(in_ptr, frame_shape);
+                    TensorView<StorageCPU, OutputType, 3> tvout(out_ptr, frame_shape);
+                    kernel_manager_.Run<Kernel>(ws.thread_idx(), i, ctx, tvout, tvin,
+                                                tmatrices_[f], toffsets_[f]);
+                    in_ptr += volume(frame_shape);
+                    out_ptr += volume(frame_shape);
+                  }
                 }, out_shape.tensor_size(i));
               }
           }
@@ -16,6 +16,9 @@
 #include "dali/operators/image/color/color_twist.h"
 #include "dali/kernels/imgproc/pointwise/linear_transformation_gpu.h"
 
+// Half-precision outputs are written directly by the kernel - no separate Cast pass is needed
+#define COLOR_TWIST_GPU_OUTPUT_TYPES (uint8_t, int16_t, int32_t, float, float16, bfloat16)
+
 namespace dali {
 namespace {
 
@@ -35,12 +38,12 @@ bool ColorTwistGpu::SetupImpl(std::vector<OutputDesc> &output_desc, const Device
   output_desc.resize(1);
   DetermineTransformation(ws);
   TYPE_SWITCH(input.type(), type2id, InputType, (uint8_t, int16_t, int32_t, float), (
-      TYPE_SWITCH(output_type_, type2id, OutputType, (uint8_t, int16_t, int32_t, float), (
+      TYPE_SWITCH(output_type_, type2id, OutputType, COLOR_TWIST_GPU_OUTPUT_TYPES, (
           {
               using Kernel = TheKernel<OutputType, InputType>;
               kernel_manager_.Initialize<Kernel>();
-              auto &shapes = CallSetup<Kernel, InputType>(ws, input);
-              output_desc[0] = {shapes, output_type_};
+              CallSetup<Kernel, InputType>(ws, input);
+              output_desc[0] = {input.shape(), output_type_};
           }
       ), DALI_FAIL(make_string("Unsupported output type: ", output_type_)))  // NOLINT
   ), DALI_FAIL(make_string("Unsupported input type: ", input.type())))  // NOLINT
@@ -53,13 +56,14 @@ void ColorTwistGpu::RunImpl(workspace_t<GPUBackend> &ws) {
   auto &output = ws.template Output<GPUBackend>(0);
   output.SetLayout(input.GetLayout());
   TYPE_SWITCH(input.type(), type2id, InputType, (uint8_t, int16_t, int32_t, float), (
-      TYPE_SWITCH(output_type_, type2id, OutputType, (uint8_t, int16_t, int32_t, float), (
+      TYPE_SWITCH(output_type_, type2id, OutputType, COLOR_TWIST_GPU_OUTPUT_TYPES, (
           {
               using Kernel = TheKernel<OutputType, InputType>;
               kernels::KernelContext ctx;
               ctx.gpu.stream = ws.stream();
-              auto tvin = view<const InputType, 3>(input);
-              auto tvout = view<OutputType, 3>(output);
+              // All frames of all samples are processed in a single launch
+              auto tvin = reshape(view<const InputType>(input), frame_shape_, true);
+              auto tvout = reshape(view<OutputType>(output), frame_shape_, true);
               kernel_manager_.Run<Kernel>(ws.thread_idx(), 0, ctx, tvout, tvin,
                                           make_cspan(tmatrices_), make_cspan(toffsets_));
           }
@@ -15,6 +15,7 @@
 #ifndef DALI_OPERATORS_IMAGE_COLOR_COLOR_TWIST_H_
 #define DALI_OPERATORS_IMAGE_COLOR_COLOR_TWIST_H_
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
@@ -24,6 +25,7 @@
 #include "dali/kernels/imgproc/pointwise/linear_transformation_cpu.h"
 #include "dali/kernels/kernel_manager.h"
 #include "dali/pipeline/data/views.h"
+#include "dali/pipeline/operator/arg_helper.h"
 #include "dali/pipeline/operator/common.h"
 #include "dali/pipeline/operator/operator.h"
 
@@ -84,6 +86,25 @@ inline mat3 sat_mat(float saturation) {
   return ret;
 }
 
+/**
+ * Composes transformation matrix for the complete color twist
+ *
+ * The transformation is `out = twist_mat(...) * in + twist_offset(...)`
+ */
+inline mat3 twist_mat(float hue, float saturation, float value, float brightness,
+                      float contrast) {
+  return mat3(brightness) * mat3(contrast) *
+         Yiq2Rgb * hue_mat(hue) * sat_mat(saturation) * mat3(value) * Rgb2Yiq;
+}
+
+/**
+ * Calculates the offset of the color twist, which keeps `half_range` fixed when changing
+ * the contrast
+ */
+inline vec3 twist_offset(float brightness, float contrast, float half_range) {
+  return vec3((half_range - half_range * contrast) * brightness);
+}
+
 }  // namespace color
 
 
@@ -96,46 +117,95 @@ class ColorTwistBase : public Operator<Backend> {
   DISABLE_COPY_MOVE_ASSIGN(ColorTwistBase);
 
  protected:
+  /// A scalar or, for sequences, one value per frame
+  using FrameArg = ArgValue<float, DynamicDimensions>;
+
   explicit ColorTwistBase(const OpSpec &spec)
       : Operator<Backend>(spec),
         output_type_arg_(spec.GetArgument<DALIDataType>(color::kOutputType)),
-        output_type_(DALI_NO_TYPE) {}
+        output_type_(DALI_NO_TYPE),
+        hue_arg_(color::kHue, spec),
+        saturation_arg_(color::kSaturation, spec),
+        value_arg_(color::kValue, spec),
+        brightness_arg_(color::kBrightness, spec),
+        contrast_arg_(color::kContrast, spec) {}
 
   bool CanInferOutputs() const override {
     return true;
   }
 
-  void AcquireArguments(const workspace_t<Backend> &ws) {
-    auto curr_batch_size = ws.GetInputBatchSize(0);
-    if (this->spec_.ArgumentDefined(color::kHue)) {
-      this->GetPerSampleArgument(hue_, color::kHue, ws, curr_batch_size);
-    } else {
-      hue_ = std::vector<float>(curr_batch_size, 0);
+  /**
+   * @brief Splits the input into frames
+   *
+   * Images are treated as single-frame sequences; empty sequences contribute no frames.
+   */
+  void SetupFrames(const workspace_t<Backend> &ws) {
+    const auto &input = ws.template InputRef<Backend>(0);
+    const auto &in_shape = input.shape();
+    const auto &layout = input.GetLayout();
+    int nsamples = in_shape.num_samples();
+    bool is_sequence = !layout.empty() && layout[0] == 'F';
+    DALI_ENFORCE(in_shape.sample_dim() == 3 + is_sequence,
+                 make_string("Expected ", is_sequence ? "a sequence of " : "",
+                             "images with channels, got input of dimensionality ",
+                             in_shape.sample_dim(), "."));
+    frame_offsets_.resize(nsamples + 1);
+    frame_offsets_[0] = 0;
+    for (int i = 0; i < nsamples; i++) {
+      auto sample_shape = in_shape.tensor_shape_span(i);
+      int frames = is_sequence ? sample_shape[0] : 1;
+      frame_offsets_[i + 1] = frame_offsets_[i] + frames;
     }
-
-    if (this->spec_.ArgumentDefined(color::kSaturation)) {
-      this->GetPerSampleArgument(saturation_, color::kSaturation, ws, curr_batch_size);
-    } else {
-      saturation_ = std::vector<float>(curr_batch_size, 1);
+    frame_shape_.resize(frame_offsets_[nsamples]);
+    for (int i = 0; i < nsamples; i++) {
+      auto sample_shape = in_shape.tensor_shape_span(i);
+      TensorShape<3> frame_shape(sample_shape[is_sequence], sample_shape[is_sequence + 1],
+                                 sample_shape[is_sequence + 2]);
+      for (int f = frame_offsets_[i]; f < frame_offsets_[i + 1]; f++)
+        frame_shape_.set_tensor_shape(f, frame_shape);
     }
+  }
 
-    if (this->spec_.ArgumentDefined(color::kValue)) {
-      this->GetPerSampleArgument(value_, color::kValue, ws, curr_batch_size);
-    } else {
-      value_ = std::vector<float>(curr_batch_size, 1);
+  /**
+   * @brief Gets the value of the argument for every frame.
+   *
+   * For sequences, the argument may specify one value per frame,
+   * otherwise a single value is used for all the frames of a sample.
+   */
+  void GetFrameArgument(std::vector<float> &values, FrameArg &arg, float default_value,
+                        const workspace_t<Backend> &ws) {
+    int nsamples = static_cast<int>(frame_offsets_.size()) - 1;
+    values.resize(frame_offsets_[nsamples]);
+    if (!arg.IsDefined()) {
+      std::fill(values.begin(), values.end(), default_value);
+      return;
     }
-
-    if (this->spec_.ArgumentDefined(color::kBrightness)) {
-      this->GetPerSampleArgument(brightness_, color::kBrightness, ws, curr_batch_size);
-    } else {
-      brightness_ = std::vector<float>(curr_batch_size, 1);
+    arg.Acquire(this->spec_, ws, nsamples);
+    for (int i = 0; i < nsamples; i++) {
+      int frames = frame_offsets_[i + 1] - frame_offsets_[i];
+      if (frames == 0)
+        continue;
+      auto sample = arg[i];
+      int64_t vol = sample.num_elements();
+      DALI_ENFORCE(sample.dim() <= 1 && (vol == 1 || vol == frames),
+                   make_string("Argument \"", arg.name(), "\" for sample ", i,
+                               " is expected to be a scalar or a 1D tensor with ", frames,
+                               " elements, got: ", sample.shape, "."));
+      float *out = values.data() + frame_offsets_[i];
+      if (vol == 1)
+        std::fill(out, out + frames, sample.data[0]);
+      else
+        std::copy(sample.data, sample.data + frames, out);
     }
+  }
 
-    if (this->spec_.ArgumentDefined(color::kContrast)) {
-      this->GetPerSampleArgument(contrast_, color::kContrast, ws, curr_batch_size);
-    } else {
-      contrast_ = std::vector<float>(curr_batch_size, 1);
-    }
+  void AcquireArguments(const workspace_t<Backend> &ws) {
+    SetupFrames(ws);
+    GetFrameArgument(hue_, hue_arg_, 0, ws);
+    GetFrameArgument(saturation_, saturation_arg_, 1, ws);
+    GetFrameArgument(value_, value_arg_, 1, ws);
+    GetFrameArgument(brightness_, brightness_arg_, 1, ws);
+    GetFrameArgument(contrast_, contrast_arg_, 1, ws);
 
     auto in_type = ws.template InputRef<Backend>(0).type();
     output_type_ = output_type_arg_ != DALI_NO_TYPE ? output_type_arg_ : in_type;
@@ -156,7 +226,7 @@ class ColorTwistBase : public Operator<Backend> {
   }
 
   /**
-   * @brief Creates transformation matrices based on given args
+   * @brief Creates transformation matrices, one per frame, based on given args
    */
   void DetermineTransformation(const workspace_t<Backend> &ws) {
     using namespace color;  // NOLINT
@@ -168,18 +238,21 @@ class ColorTwistBase : public Operator<Backend> {
     toffsets_.resize(size);
     for (size_t i = 0; i < size; i++) {
       tmatrices_[i] =
-               mat3(brightness_[i]) * mat3(contrast_[i]) *
-               Yiq2Rgb * hue_mat(hue_[i]) * sat_mat(saturation_[i]) * mat3(value_[i]) * Rgb2Yiq;
-      toffsets_[i] = (half_range_ - half_range_ * contrast_[i]) * brightness_[i];
+          twist_mat(hue_[i], saturation_[i], value_[i], brightness_[i], contrast_[i]);
+      toffsets_[i] = twist_offset(brightness_[i], contrast_[i], half_range_);
     }
   }
 
   USE_OPERATOR_MEMBERS();
   float half_range_ = 0.0f;
+  /// The frames of the i-th sample are in the range [frame_offsets_[i], frame_offsets_[i + 1])
+  std::vector<int> frame_offsets_;
+  TensorListShape<3> frame_shape_;
   std::vector<float> hue_, saturation_, value_, brightness_, contrast_;
   std::vector<mat3> tmatrices_;
   std::vector<vec3> toffsets_;
   DALIDataType output_type_arg_, output_type_;
+  FrameArg hue_arg_, saturation_arg_, value_arg_, brightness_arg_, contrast_arg_;
   kernels::KernelManager kernel_manager_;
 };
 
@@ -207,18 +280,19 @@ class ColorTwistCpu : public ColorTwistBase<CPUBackend> {
 
  private:
   template <typename Kernel, typename InputType>
-  TensorListShape<> CallSetup(const TensorVector<CPUBackend> &input) {
+  void CallSetup(const TensorVector<CPUBackend> &input) {
     kernels::KernelContext ctx;
-    TensorListShape<> sh = input.shape();
-    TensorListShape<> ret(sh.num_samples(), 3);
-    assert(static_cast<size_t>(sh.num_samples()) == tmatrices_.size());
-    for (int i = 0; i < sh.num_samples(); i++) {
-      const auto tvin = view<const InputType, 3>(input[i]);
-      const auto reqs = kernel_manager_.Setup<Kernel>(i, ctx, tvin, tmatrices_[i], toffsets_[i]);
-      const TensorListShape<> &out_sh = reqs.output_shapes[0];
-      ret.set_tensor_shape(i, out_sh.tensor_shape(0));
+    int nsamples = input.shape().num_samples();
+    for (int i = 0; i < nsamples; i++) {
+      // The kernel is stateless and the output shape is the same as the input shape,
+      // so the setup validates only the first frame of each sample
+      if (frame_offsets_[i] == frame_offsets_[i + 1])
+        continue;
+      int f = frame_offsets_[i];
+      TensorView<StorageCPU, const InputType, 3> frame(input[i].template data<InputType>(),
+                                                       frame_shape_[f]);
+      kernel_manager_.Setup<Kernel>(i, ctx, frame, tmatrices_[f], toffsets_[f]);
     }
-    return ret;
   }
 };
 
@@ -239,13 +313,11 @@ class ColorTwistGpu : public ColorTwistBase<GPUBackend> {
 
  private:
   template <typename Kernel, typename InputType>
-  const TensorListShape<> &CallSetup(const DeviceWorkspace &ws, const TensorList<GPUBackend> &tl) {
+  void CallSetup(const DeviceWorkspace &ws, const TensorList<GPUBackend> &tl) {
     kernels::KernelContext ctx;
     ctx.gpu.stream = ws.stream();
-    const auto tvin = view<const InputType, 3>(tl);
-    const auto &reqs = kernel_manager_.Setup<Kernel>(0, ctx, tvin, make_cspan(tmatrices_),
-                                                     make_cspan(toffsets_));
-    return reqs.output_shapes[0];
+    auto tvin = reshape(view<const InputType>(tl), frame_shape_, true);
+    kernel_manager_.Setup<Kernel>(0, ctx, tvin, make_cspan(tmatrices_), make_cspan(toffsets_));
   }
 };
 
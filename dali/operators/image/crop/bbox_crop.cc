@@ -15,6 +15,7 @@
 #include "dali/operators/image/crop/bbox_crop.h"
 
 #include <algorithm>
+#include <array>
 #include <random>
 #include <string>
 #include <tuple>
@@ -516,7 +517,6 @@ class RandomBBoxCropImpl : public OpImplBase<CPUBackend> {
     int num_samples = in_boxes_shape.num_samples();
     auto &tp = ws.GetThreadPool();
     auto ncoords = ndim * 2;
-    sample_data_.clear();
     sample_data_.resize(num_samples);
     for (int sample_idx = 0; sample_idx < num_samples; sample_idx++) {
       auto &data = sample_data_[sample_idx];
@@ -527,7 +527,7 @@ class RandomBBoxCropImpl : public OpImplBase<CPUBackend> {
                   make_cspan(in_boxes_view.tensor_data(sample_idx),
                              volume(in_boxes_shape.tensor_size(sample_idx))),
                   bbox_layout_);
-        FindProspectiveCrop(data.prospective_crop, make_cspan(data.in_bboxes), sample_idx);
+        FindProspectiveCrop(data, sample_idx);
       }, in_boxes_shape.tensor_size(sample_idx));
     }
     tp.RunAll();
@@ -626,6 +626,47 @@ class RandomBBoxCropImpl : public OpImplBase<CPUBackend> {
     }
   };
 
+  struct Candidate {
+    Box<ndim, float> rel_crop, out_crop;
+    float metric = 0.0f;
+  };
+
+  /**
+   * @brief Bounding boxes in structure-of-arrays layout
+   */
+  struct BoxesSoA {
+    std::array<std::vector<float>, ndim> lo, hi;
+    std::vector<float> volume;
+
+    int size() const {
+      return volume.size();
+    }
+
+    void Set(span<const Box<ndim, float>> boxes) {
+      int n = boxes.size();
+      for (int d = 0; d < ndim; d++) {
+        lo[d].resize(n);
+        hi[d].resize(n);
+      }
+      volume.resize(n);
+      for (int i = 0; i < n; i++) {
+        for (int d = 0; d < ndim; d++) {
+          lo[d][i] = boxes[i].lo[d];
+          hi[d][i] = boxes[i].hi[d];
+        }
+        volume[i] = dali::volume(boxes[i]);
+      }
+    }
+  };
+
+  struct SampleData {
+    std::vector<Box<ndim, float>> in_bboxes;
+    ProspectiveCrop prospective_crop;
+    BoxesSoA boxes;
+    std::vector<Candidate> candidates;
+    std::vector<float> overlap;
+  };
+
   /**
    * @brief Fixes shape dimensions to follow aspect ratio constraints in case of ar_min == ar_max
    * @remarks The dimensions are fixed on a random order
@@ -682,11 +723,16 @@ class RandomBBoxCropImpl : public OpImplBase<CPUBackend> {
       extent = max_extent * extent / new_max_extent;
   }
 
-  void FindProspectiveCrop(ProspectiveCrop &crop, span<const Box<ndim, float>> bounding_boxes,
-                           int sample) {
+  void FindProspectiveCrop(SampleData &data, int sample) {
+    auto &crop = data.prospective_crop;
+    auto bounding_boxes = make_cspan(data.in_bboxes);
+    auto &candidates = data.candidates;
     int count = 0;
     float best_metric = -1.0;
+    Candidate best_crop{};
+    bool has_best = false;
 
+    data.boxes.Set(bounding_boxes);
     crop.clear();
     while (!crop.success && (total_num_attempts_ < 0 || count < total_num_attempts_)) {
       auto &rng = rngs_[sample];
@@ -706,11 +752,14 @@ class RandomBBoxCropImpl : public OpImplBase<CPUBackend> {
         crop.boxes.assign(bounding_boxes.begin(), bounding_boxes.end());
         crop.bbox_indices.resize(crop.boxes.size());
         std::iota(crop.bbox_indices.begin(), crop.bbox_indices.end(), 0);
-        break;
+        return;
       }
 
+      // Draw all the candidates for this option first, so that their overlap with the boxes
+      // can be evaluated in one batch.
+      candidates.clear();
       vec<ndim, float> shape, anchor;
-      Box<ndim, float> rel_crop, out_crop;
+      Candidate c;
       for (int i = 0; i < num_attempts_; i++, count++) {
         if (absolute_crop_dims) {
           auto &crop_shape = crop_shape_[sample];
@@ -718,8 +767,8 @@ class RandomBBoxCropImpl : public OpImplBase<CPUBackend> {
 
           for (int d = 0; d < ndim; d++) {
             shape[d] = static_cast<float>(crop_shape[d]);
-            out_crop.hi[d] = shape[d];
-            rel_crop.hi[d] = shape[d] / input_shape[d];
+            c.out_crop.hi[d] = shape[d];
+            c.rel_crop.hi[d] = shape[d] / input_shape[d];
           }
 
           for (int d = 0; d < ndim; d++) {
@@ -729,11 +778,11 @@ class RandomBBoxCropImpl : public OpImplBase<CPUBackend> {
             } else {
               anchor[d] = 0.0f;
             }
-            out_crop.lo[d] = anchor[d];
-            rel_crop.lo[d] = anchor[d] / input_shape[d];
+            c.out_crop.lo[d] = anchor[d];
+            c.rel_crop.lo[d] = anchor[d] / input_shape[d];
           }
-          out_crop.hi += out_crop.lo;
-          rel_crop.hi += rel_crop.lo;
+          c.out_crop.hi += c.out_crop.lo;
+          c.rel_crop.hi += c.rel_crop.lo;
         } else {  // relative dimensions
           std::uniform_real_distribution<float> extent_dist(scale_range_.min, scale_range_.max);
           for (int d = 0; d < ndim; d++) {
@@ -749,31 +798,31 @@ class RandomBBoxCropImpl : public OpImplBase<CPUBackend> {
           for (int d = 0; d < ndim; d++) {
             std::uniform_real_distribution<float> anchor_dist(0.0f, 1.0f - shape[d]);
             anchor[d] = anchor_dist(rng);
-            rel_crop.lo[d] = anchor[d];
-            rel_crop.hi[d] = anchor[d] + shape[d];
+            c.rel_crop.lo[d] = anchor[d];
+            c.rel_crop.hi[d] = anchor[d] + shape[d];
           }
-          out_crop = rel_crop;
+          c.out_crop = c.rel_crop;
         }
+        candidates.push_back(c);
+      }
 
-        float min_overlap = 0.0, max_overlap = 0.0;
-        std::tie(min_overlap, max_overlap) =
-            OverlapMetricRange(rel_crop, make_cspan(bounding_boxes));
-        float metric = all_boxes_above_threshold_ ? min_overlap : max_overlap;
-        bool is_valid_overlap = metric >= option.threshold;
-        if (metric <= best_metric && !is_valid_overlap)
-          continue;
-
-        best_metric = metric;
-
-        crop.crop = out_crop;
-        crop.boxes.assign(bounding_boxes.begin(), bounding_boxes.end());
-        crop.bbox_indices.clear();  // indices will be populated by FilterByCentroid
-        FilterByCentroid(rel_crop, crop.boxes, crop.bbox_indices);
-        for (auto &box : crop.boxes) {
-          box = RemapBox(box, rel_crop);
+      EvaluateCandidates(data);
+
+      // The first candidate which satisfies the threshold and retains at least one box wins.
+      // Otherwise, the candidate with the best metric is kept as a fallback.
+      for (auto &candidate : candidates) {
+        float metric = candidate.metric;
+        if (metric >= option.threshold && AnyCentroidInside(candidate.rel_crop, bounding_boxes)) {
+          best_crop = candidate;
+          best_metric = metric;
+          crop.success = true;
+          break;
+        }
+        if (!has_best || metric > best_metric) {
+          best_metric = metric;
+          best_crop = candidate;
+          has_best = true;
         }
-        bool at_least_one_box = !crop.boxes.empty();
-        crop.success = is_valid_overlap && at_least_one_box;
       }
     }
 
@@ -782,6 +831,15 @@ class RandomBBoxCropImpl : public OpImplBase<CPUBackend> {
         "Could not find a valid cropping window to satisfy the specified requirements (attempted ",
         count, " times). Using the best cropping window so far (best_metric=", best_metric, ")"));
       crop.success = true;
+      if (!has_best)
+        return;  // no candidate was produced at all
+    }
+
+    crop.crop = best_crop.out_crop;
+    crop.boxes.assign(bounding_boxes.begin(), bounding_boxes.end());
+    FilterByCentroid(best_crop.rel_crop, crop.boxes, crop.bbox_indices);
+    for (auto &box : crop.boxes) {
+      box = RemapBox(box, best_crop.rel_crop);
     }
   }
 
@@ -798,39 +856,65 @@ class RandomBBoxCropImpl : public OpImplBase<CPUBackend> {
     return true;
   }
 
-  template <typename Metric>
-  std::pair<float, float> MinMaxRange(const Box<ndim, float> &crop,
-                                      span<const Box<ndim, float>> boxes,
-                                      Metric&& metric_f) {
-    float best_metric = 0.0, worst_metric = 0.0;
-    if (boxes.empty())
-      return {0.0f, 0.0f};
-    float metric = metric_f(crop, boxes[0]);
-    best_metric = metric;
-    worst_metric = metric;
-    for (int i = 1; i < boxes.size(); i++) {
-      metric = metric_f(crop, boxes[i]);
-      best_metric = std::max(metric, best_metric);
-      worst_metric = std::min(metric, worst_metric);
+  /**
+   * @brief Calculates the overlap metric of each candidate in `data.candidates`
+   *
+   * The metric is the worst (if `all_boxes_above_threshold`) or the best overlap with any of the
+   * boxes. The boxes are stored as a structure of arrays, so the loops over the boxes are
+   * branchless and can be vectorized.
+   */
+  void EvaluateCandidates(SampleData &data) {
+    auto &boxes = data.boxes;
+    int nboxes = boxes.size();
+    auto &overlap = data.overlap;
+    overlap.resize(nboxes);
+    for (auto &candidate : data.candidates) {
+      if (nboxes == 0) {
+        candidate.metric = 0.0f;
+        continue;
+      }
+      auto &crop = candidate.rel_crop;
+      for (int i = 0; i < nboxes; i++)
+        overlap[i] = 1.0f;
+      for (int d = 0; d < ndim; d++) {
+        float lo = crop.lo[d], hi = crop.hi[d];
+        const float *box_lo = boxes.lo[d].data();
+        const float *box_hi = boxes.hi[d].data();
+        for (int i = 0; i < nboxes; i++)
+          overlap[i] *= std::max(0.0f, std::min(hi, box_hi[i]) - std::max(lo, box_lo[i]));
+      }
+      const float *box_vol = boxes.volume.data();
+      if (overlap_metric_ == OverlapMetric::Overlap) {
+        for (int i = 0; i < nboxes; i++)
+          overlap[i] = overlap[i] / box_vol[i];
+      } else {  // IoU
+        float crop_vol = volume(crop);
+        for (int i = 0; i < nboxes; i++) {
+          float intersection_vol = overlap[i];
+          overlap[i] = intersection_vol == 0
+                     ? 0.0f
+                     : intersection_vol / (crop_vol + box_vol[i] - intersection_vol);
+        }
+      }
+      float metric = overlap[0];
+      if (all_boxes_above_threshold_) {
+        for (int i = 1; i < nboxes; i++)
+          metric = std::min(metric, overlap[i]);
+      } else {
+        for (int i = 1; i < nboxes; i++)
+          metric = std::max(metric, overlap[i]);
+      }
+      candidate.metric = metric;
     }
-    return {worst_metric, best_metric};
   }
 
-  std::pair<float, float> OverlapMetricRange(const Box<ndim, float> &crop,
-                                             span<const Box<ndim, float>> boxes) {
-    if (overlap_metric_ == OverlapMetric::Overlap) {
-      auto f =
-          [](const Box<ndim, float> &crop, const Box<ndim, float> &box) {
-            return volume(intersection(crop, box)) / static_cast<float>(volume(box));
-          };
-      return MinMaxRange(crop, boxes, f);
-    } else {  // IoU
-      auto f =
-          [](const Box<ndim, float> &crop, const Box<ndim, float> &box) {
-            return intersection_over_union(crop, box);
-          };
-      return MinMaxRange(crop, boxes, f);
+  static bool AnyCentroidInside(const Box<ndim, float> &crop,
+                                span<const Box<ndim, float>> bboxes) {
+    for (auto &box : bboxes) {
+      if (crop.contains(box.centroid()))
+        return true;
     }
+    return false;
   }
 
   void FilterByCentroid(const Box<ndim, float> &crop,
@@ -872,10 +956,6 @@ class RandomBBoxCropImpl : public OpImplBase<CPUBackend> {
   Range scale_range_;
   std::vector<Range> aspect_ratio_ranges_;
 
-  struct SampleData {
-    std::vector<Box<ndim, float>> in_bboxes;
-    ProspectiveCrop prospective_crop;
-  };
 
   std::vector<SampleData> sample_data_;
 };
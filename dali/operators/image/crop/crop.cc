@@ -27,6 +27,7 @@ DALI_SCHEMA(Crop)
 (upper left corner).)code")
     .NumInput(1)
     .NumOutput(1)
+    .Deterministic()
     .AllowSequences()
     .SupportVolumetric()
     .AddOptionalArg<DALIImageType>("image_type", "Image type", nullptr)
@@ -15,11 +15,13 @@
 #ifndef DALI_OPERATORS_IMAGE_CROP_CROP_ATTR_H_
 #define DALI_OPERATORS_IMAGE_CROP_CROP_ATTR_H_
 
+#include <algorithm>
 #include <cmath>
 #include <utility>
 #include <vector>
 #include "dali/core/common.h"
 #include "dali/core/error_handling.h"
+#include "dali/pipeline/operator/arg_helper.h"
 #include "dali/pipeline/operator/common.h"
 #include "dali/pipeline/operator/operator.h"
 #include "dali/util/crop_window.h"
@@ -34,13 +36,20 @@ namespace dali {
 class CropAttr {
  public:
   static constexpr int kNoCrop = -1;
-  explicit inline CropAttr(const OpSpec& spec) : spec__(spec) {
-    auto max_batch_size = spec__.GetArgument<int>("max_batch_size");
+  explicit inline CropAttr(const OpSpec& spec)
+      : spec__(spec),
+        crop_pos_x_("crop_pos_x", spec),
+        crop_pos_y_("crop_pos_y", spec),
+        crop_pos_z_("crop_pos_z", spec),
+        crop_w_("crop_w", spec),
+        crop_h_("crop_h", spec),
+        crop_d_("crop_d", spec) {
+    max_batch_size_ = spec__.GetArgument<int>("max_batch_size");
     int crop_h = kNoCrop, crop_w = kNoCrop, crop_d = kNoCrop;
     bool has_crop_arg = spec__.HasArgument("crop");
-    bool has_crop_w_arg = spec__.ArgumentDefined("crop_w");
-    bool has_crop_h_arg = spec__.ArgumentDefined("crop_h");
-    bool has_crop_d_arg = spec__.ArgumentDefined("crop_d");
+    bool has_crop_w_arg = crop_w_.IsDefined();
+    bool has_crop_h_arg = crop_h_.IsDefined();
+    bool has_crop_d_arg = crop_d_.IsDefined();
     is_whole_image_ = !has_crop_arg && !has_crop_w_arg && !has_crop_h_arg && !has_crop_d_arg;
 
     DALI_ENFORCE(has_crop_w_arg == has_crop_h_arg,
@@ -70,34 +79,62 @@ class CropAttr {
     }
     has_crop_d_ = has_crop_d_arg || crop_arg_ndims == 3;
 
-    crop_height_.resize(max_batch_size, crop_h);
-    crop_width_.resize(max_batch_size, crop_w);
+    crop_height_.resize(max_batch_size_, crop_h);
+    crop_width_.resize(max_batch_size_, crop_w);
     if (has_crop_d_)
-      crop_depth_.resize(max_batch_size, crop_d);
-    crop_x_norm_.resize(max_batch_size, 0.0f);
-    crop_y_norm_.resize(max_batch_size, 0.0f);
+      crop_depth_.resize(max_batch_size_, crop_d);
+    crop_x_norm_.resize(max_batch_size_, 0.0f);
+    crop_y_norm_.resize(max_batch_size_, 0.0f);
     if (has_crop_d_)
-      crop_z_norm_.resize(max_batch_size, 0.0f);
-    crop_window_generators_.resize(max_batch_size, {});
+      crop_z_norm_.resize(max_batch_size_, 0.0f);
+    crop_window_generators_.resize(max_batch_size_, {});
   }
 
-  void ProcessArguments(const ArgumentWorkspace *ws, std::size_t data_idx) {
-    crop_x_norm_[data_idx] = spec__.GetArgument<float>("crop_pos_x", ws, data_idx);
-    crop_y_norm_[data_idx] = spec__.GetArgument<float>("crop_pos_y", ws, data_idx);
+  /**
+   * @brief Acquires the argument data for the current iteration
+   *
+   * @return the number of samples for which the arguments are available
+   */
+  int AcquireArguments(const ArgumentWorkspace &ws) {
+    int nsamples = max_batch_size_;
+    auto acquire = [&](ScalarArg &arg) {
+      arg.Acquire(spec__, ws, max_batch_size_);
+      if (arg.IsArgInput()) {
+        const auto &shape = arg.get().shape;
+        for (int i = 0; i < shape.num_samples(); i++)
+          DALI_ENFORCE(volume(shape.tensor_shape_span(i)) == 1, make_string(
+              "Unexpected shape of argument \"", arg.name(), "\". Expected a batch of scalars "
+              "or a batch of tensors containing one element per sample. Got:\n", shape));
+      }
+      nsamples = std::min(nsamples, arg.size());
+    };
+    acquire(crop_pos_x_);
+    acquire(crop_pos_y_);
     if (has_crop_d_)
-      crop_z_norm_[data_idx] = spec__.GetArgument<float>("crop_pos_z", ws, data_idx);
-    if (spec__.ArgumentDefined("crop_w")) {
-      crop_width_[data_idx] = static_cast<int>(
-        spec__.GetArgument<float>("crop_w", ws, data_idx));
-    }
-    if (spec__.ArgumentDefined("crop_h")) {
-      crop_height_[data_idx] = static_cast<int>(
-        spec__.GetArgument<float>("crop_h", ws, data_idx));
-    }
-    if (spec__.ArgumentDefined("crop_d")) {
-      crop_depth_[data_idx] = static_cast<int>(
-        spec__.GetArgument<float>("crop_d", ws, data_idx));
-    }
+      acquire(crop_pos_z_);
+    if (crop_w_.IsDefined())
+      acquire(crop_w_);
+    if (crop_h_.IsDefined())
+      acquire(crop_h_);
+    if (crop_d_.IsDefined())
+      acquire(crop_d_);
+    return nsamples;
+  }
+
+  /**
+   * @brief Processes the arguments of one sample; the arguments must be acquired first
+   */
+  void ProcessArguments(std::size_t data_idx) {
+    crop_x_norm_[data_idx] = crop_pos_x_[data_idx].data[0];
+    crop_y_norm_[data_idx] = crop_pos_y_[data_idx].data[0];
+    if (has_crop_d_)
+      crop_z_norm_[data_idx] = crop_pos_z_[data_idx].data[0];
+    if (crop_w_.IsDefined())
+      crop_width_[data_idx] = static_cast<int>(crop_w_[data_idx].data[0]);
+    if (crop_h_.IsDefined())
+      crop_height_[data_idx] = static_cast<int>(crop_h_[data_idx].data[0]);
+    if (crop_d_.IsDefined())
+      crop_depth_[data_idx] = static_cast<int>(crop_d_[data_idx].data[0]);
 
     crop_window_generators_[data_idx] =
       [this, data_idx](const TensorShape<>& input_shape,
@@ -166,14 +203,15 @@ class CropAttr {
   }
 
   void ProcessArguments(const ArgumentWorkspace &ws) {
-    auto max_batch_size = static_cast<size_t>(spec__.GetArgument<int>("max_batch_size"));
-    for (std::size_t data_idx = 0; data_idx < max_batch_size; data_idx++) {
-      ProcessArguments(&ws, data_idx);
+    int nsamples = AcquireArguments(ws);
+    for (int data_idx = 0; data_idx < nsamples; data_idx++) {
+      ProcessArguments(data_idx);
     }
   }
 
   void ProcessArguments(const SampleWorkspace &ws) {
-    ProcessArguments(&ws, ws.data_idx());
+    AcquireArguments(ws);
+    ProcessArguments(ws.data_idx());
   }
 
   const CropWindowGenerator& GetCropWindowGenerator(std::size_t data_idx) const {
@@ -197,6 +235,11 @@ class CropAttr {
 
  private:
   OpSpec spec__;
+  /// A scalar per sample; argument inputs can also be tensors with a single element
+  using ScalarArg = ArgValue<float, DynamicDimensions>;
+  int max_batch_size_ = 0;
+  ScalarArg crop_pos_x_, crop_pos_y_, crop_pos_z_;
+  ScalarArg crop_w_, crop_h_, crop_d_;
 };
 
 }  // namespace dali
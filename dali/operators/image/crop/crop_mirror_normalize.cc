@@ -34,6 +34,7 @@ Normalization takes the input images and produces the output by using the follow
 )code")
   .NumInput(1)
   .NumOutput(1)
+  .Deterministic()
   .AllowSequences()
   .SupportVolumetric()
   .AddOptionalArg<DALIImageType>("image_type", "Image type", nullptr)
@@ -43,6 +44,12 @@ Normalization takes the input images and produces the output by using the follow
 
 Supported types: ``FLOAT``, ``FLOAT16``, ``INT8``, ``UINT8``.
 
+The integer outputs are rounded to the nearest integer and saturated. Together with ``scale``
+(the inverse of the quantization scale) and ``shift`` (the zero point), they produce the quantized
+input of an integer model directly::
+
+  output = round((input - mean) / std * scale + shift)
+
 If not set, the input type is used.)code", DALI_FLOAT)
   .DeprecateArgInFavorOf("output_dtype", "dtype")  // deprecated since 0.24dev
   .AddOptionalArg("output_layout",
@@ -64,8 +71,19 @@ This argument is useful when using integer outputs to improve dynamic range util
     1.0f)
   .AddOptionalArg("shift", R"(The value added to the (scaled) result.
 
-This argument is useful when using unsigned integer outputs to improve dynamic range utilization.)",
+This argument is useful when using integer outputs, e.g. as the zero point of quantized data.)",
     0.0f)
+  .AddOptionalArg("noise_mean", R"(Mean of the Gaussian noise added to the input.
+
+See ``noise_stddev``.)", 0.0f, true)
+  .AddOptionalArg("noise_stddev", R"(Standard deviation of the Gaussian noise added to the input.
+
+The noise is added to the input values (with saturation to the input type) before cropping and
+normalization, so the result is the same as that of applying ``noise.gaussian`` with the same seed
+to the input first. These arguments are set when ``noise.gaussian`` is fused into this
+operator by the pipeline (see ``enable_op_fusion``).
+
+Supported only by the GPU operator.)", 0.0f, true)
   .AddParent("CropAttr")
   .AddParent("OutOfBoundsAttr");
 
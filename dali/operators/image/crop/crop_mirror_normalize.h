@@ -16,11 +16,14 @@
 #define DALI_OPERATORS_IMAGE_CROP_CROP_MIRROR_NORMALIZE_H_
 
 #include <cstring>
+#include <memory>
+#include <type_traits>
 #include <utility>
 #include <vector>
 #include "dali/core/any.h"
 #include "dali/core/common.h"
 #include "dali/core/format.h"
+#include "dali/core/philox.h"
 #include "dali/core/util.h"
 #include "dali/core/error_handling.h"
 #include "dali/core/static_switch.h"
@@ -31,6 +34,7 @@
 #include "dali/operators/image/crop/crop_attr.h"
 #include "dali/pipeline/operator/common.h"
 #include "dali/pipeline/operator/operator.h"
+#include "dali/pipeline/util/batch_rng.h"
 
 #define CMN_IN_TYPES (uint8_t, int16_t, uint16_t, int32_t, float, float16)
 #define CMN_OUT_TYPES (float, float16, uint8_t, int8_t)
@@ -147,6 +151,15 @@ class CropMirrorNormalize : public Operator<Backend> {
     if (out_of_bounds_policy_ == OutOfBoundsPolicy::Pad) {
       fill_values_ = spec.GetRepeatedArgument<float>("fill_values");
     }
+
+    has_noise_ = spec.ArgumentDefined("noise_mean") || spec.ArgumentDefined("noise_stddev");
+    if (has_noise_) {
+      DALI_ENFORCE((std::is_same<Backend, GPUBackend>::value),
+        "Adding noise is supported only by the GPU CropMirrorNormalize.");
+      // the same per-sample seeds as used by noise.Gaussian with the same seed
+      noise_rng_ = std::make_unique<BatchRNG<Philox4x32_10>>(spec.GetArgument<int64_t>("seed"),
+                                                             max_batch_size_);
+    }
   }
 
   inline ~CropMirrorNormalize() override = default;
@@ -160,6 +173,11 @@ class CropMirrorNormalize : public Operator<Backend> {
     return true;
   }
 
+  bool CanBeCaptured() const override {
+    // the GPU variant uses only the kernel scratchpad; the noise seeds change in every iteration
+    return std::is_same<Backend, GPUBackend>::value && !has_noise_;
+  }
+
   void SetupCommonImpl(const workspace_t<Backend> &ws) {
     const auto &input = ws.template InputRef<Backend>(0);
     input_type_ = input.type();
@@ -215,6 +233,13 @@ class CropMirrorNormalize : public Operator<Backend> {
             in_shape[data_idx], input_layout_, output_layout_, crop_window, horizontal_flip,
             pad_output_, make_cspan(mean_vec_), make_cspan(inv_std_vec_),
             make_cspan(fill_values_)));
+        if (has_noise_) {
+          auto &args = kernel_sample_args.back();
+          args.noise_mean = this->spec_.template GetArgument<float>("noise_mean", &ws, data_idx);
+          args.noise_stddev =
+              this->spec_.template GetArgument<float>("noise_stddev", &ws, data_idx);
+          args.noise_seed = (*noise_rng_)[data_idx].next64();
+        }
       }
     ), DALI_FAIL(make_string("Not supported number of dimensions: ", ndim)););  // NOLINT
   }
@@ -235,6 +260,9 @@ class CropMirrorNormalize : public Operator<Backend> {
   std::vector<float> fill_values_;
   OutOfBoundsPolicy out_of_bounds_policy_ = OutOfBoundsPolicy::Error;
 
+  bool has_noise_ = false;
+  std::unique_ptr<BatchRNG<Philox4x32_10>> noise_rng_;
+
   kernels::KernelManager kmgr_;
   any kernel_sample_args_;
 
@@ -17,6 +17,9 @@
 
 #include <string>
 #include <vector>
+#include "dali/core/geom/mat.h"
+#include "dali/core/geom/vec.h"
+#include "dali/operators/image/color/color_twist.h"
 #include "dali/pipeline/operator/arg_helper.h"
 #include "dali/pipeline/data/views.h"
 #include "dali/pipeline/operator/common.h"
@@ -31,7 +34,13 @@ class JpegCompressionDistortion : public Operator<Backend> {
   explicit JpegCompressionDistortion(const OpSpec &spec)
       : Operator<Backend>(spec),
         spec_(spec),
-        quality_arg_("quality", spec) {
+        quality_arg_("quality", spec),
+        hue_arg_("hue", spec),
+        saturation_arg_("saturation", spec),
+        brightness_arg_("brightness", spec),
+        contrast_arg_("contrast", spec) {
+    color_twist_ = hue_arg_.IsDefined() || saturation_arg_.IsDefined() ||
+                   brightness_arg_.IsDefined() || contrast_arg_.IsDefined();
   }
 
   bool CanInferOutputs() const override {
@@ -50,11 +59,38 @@ class JpegCompressionDistortion : public Operator<Backend> {
 
     output_desc[0] = {in_sh, input.type()};
     quality_arg_.Acquire(spec_, ws, in_sh.num_samples(), TensorShape<0>{});
+    if (color_twist_)
+      DetermineColorTwist(ws, in_sh.num_samples());
     return true;
   }
 
+  /**
+   * @brief Calculates the color twist transformations, one per sample
+   */
+  void DetermineColorTwist(const workspace_t<Backend> &ws, int nsamples) {
+    hue_arg_.Acquire(spec_, ws, nsamples, TensorShape<0>{});
+    saturation_arg_.Acquire(spec_, ws, nsamples, TensorShape<0>{});
+    brightness_arg_.Acquire(spec_, ws, nsamples, TensorShape<0>{});
+    contrast_arg_.Acquire(spec_, ws, nsamples, TensorShape<0>{});
+    color_matrices_.resize(nsamples);
+    color_offsets_.resize(nsamples);
+    for (int i = 0; i < nsamples; i++) {
+      float brightness = brightness_arg_[i].data[0];
+      float contrast = contrast_arg_[i].data[0];
+      color_matrices_[i] = color::twist_mat(hue_arg_[i].data[0], saturation_arg_[i].data[0], 1,
+                                            brightness, contrast);
+      color_offsets_[i] = color::twist_offset(brightness, contrast, 128.f);
+    }
+  }
+
   OpSpec spec_;
   ArgValue<int> quality_arg_;
+
+  /// The color twist, applied before the distortion
+  bool color_twist_ = false;
+  ArgValue<float> hue_arg_, saturation_arg_, brightness_arg_, contrast_arg_;
+  std::vector<mat3> color_matrices_;
+  std::vector<vec3> color_offsets_;
 };
 
 }  // namespace dali
@@ -15,6 +15,7 @@
 #include <vector>
 #include <opencv2/opencv.hpp>
 #include "dali/operators/image/distortion/jpeg_compression_distortion_op.h"
+#include "dali/kernels/imgproc/pointwise/linear_transformation_cpu.h"
 
 namespace dali {
 
@@ -31,6 +32,11 @@ at block boundaries.
 
 This operation produces images by subjecting the input to a transformation that
 mimics JPEG compression with given ``quality`` factor followed by decompression.
+
+Optionally, the colors of the input can be adjusted with ``hue``, ``saturation``,
+``brightness`` and ``contrast``, in the same way as with :meth:`nvidia.dali.fn.color_twist`,
+before introducing the artifacts. The GPU operator applies the adjustment as the pixels
+are read by the distortion, without producing an intermediate image.
 )code")
     .NumInput(1)
     .InputLayout(0, "HWC")
@@ -39,7 +45,15 @@ mimics JPEG compression with given ``quality`` factor followed by decompression.
         R"code(JPEG compression quality from 1 (lowest quality) to 100 (highest quality).
 
 Any values outside the range 1-100 will be clamped.)code",
-                    50, true);
+                    50, true)
+    .AddOptionalArg("hue",
+        R"code(Hue change, in degrees, applied before the distortion.)code", 0.f, true)
+    .AddOptionalArg("saturation",
+        R"code(Saturation change factor, applied before the distortion.)code", 1.f, true)
+    .AddOptionalArg("brightness",
+        R"code(Brightness change factor, applied before the distortion.)code", 1.f, true)
+    .AddOptionalArg("contrast",
+        R"code(Contrast change factor, applied before the distortion.)code", 1.f, true);
 
 class JpegCompressionDistortionCPU : public JpegCompressionDistortion<CPUBackend> {
  public:
@@ -74,7 +88,16 @@ void JpegCompressionDistortionCPU::RunImpl(workspace_t<CPUBackend> &ws) {
         auto sh = in_shape.tensor_shape_span(sample_idx);
         cv::Mat in_mat(sh[0], sh[1], CV_8UC3, const_cast<unsigned char*>(in_view[sample_idx].data));
         cv::Mat out_mat(sh[0], sh[1], CV_8UC3, out_view[sample_idx].data);
-        cv::cvtColor(in_mat, out_mat, cv::COLOR_RGB2BGR);
+        if (color_twist_) {
+          kernels::LinearTransformationCpu<uint8_t, uint8_t, 3, 3, 3> twist;
+          kernels::KernelContext kctx;
+          twist.Run(kctx, view<uint8_t, 3>(output[sample_idx]),
+                    view<const uint8_t, 3>(input[sample_idx]),
+                    color_matrices_[sample_idx], color_offsets_[sample_idx]);
+          cv::cvtColor(out_mat, out_mat, cv::COLOR_RGB2BGR);
+        } else {
+          cv::cvtColor(in_mat, out_mat, cv::COLOR_RGB2BGR);
+        }
         cv::imencode(".jpg", out_mat, ctx.encoded, {cv::IMWRITE_JPEG_QUALITY, quality});
         cv::imdecode(ctx.encoded, cv::IMREAD_COLOR, &out_mat);
         cv::cvtColor(out_mat, out_mat, cv::COLOR_BGR2RGB);
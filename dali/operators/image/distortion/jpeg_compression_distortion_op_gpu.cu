@@ -52,7 +52,12 @@ void JpegCompressionDistortionGPU::RunImpl(workspace_t<GPUBackend> &ws) {
   kernels::KernelContext ctx;
   ctx.gpu.stream = ws.stream();
   auto req = kmgr_.Setup<JpegDistortionKernel>(0, ctx, in_view.shape, true, true);
-  kmgr_.Run<JpegDistortionKernel>(0, 0, ctx, out_view, in_view, make_cspan(quality_));
+  if (color_twist_) {
+    kmgr_.Run<JpegDistortionKernel>(0, 0, ctx, out_view, in_view, make_cspan(quality_),
+                                    make_cspan(color_matrices_), make_cspan(color_offsets_));
+  } else {
+    kmgr_.Run<JpegDistortionKernel>(0, 0, ctx, out_view, in_view, make_cspan(quality_));
+  }
 }
 
 DALI_REGISTER_OPERATOR(JpegCompressionDistortion, JpegCompressionDistortionGPU, GPU);
@@ -14,6 +14,7 @@
 
 #include "dali/operators/image/paste/multipaste.h"
 #include "dali/kernels/imgproc/paste/paste.h"
+#include "dali/kernels/imgproc/paste/resize_paste_cpu.h"
 #include "dali/core/tensor_view.h"
 
 namespace dali {
@@ -21,7 +22,15 @@ namespace dali {
 DALI_SCHEMA(MultiPaste)
 .DocStr(R"code(Performs multiple pastes from image batch to each of outputs
 
-This operator can also change the type of data.)code")
+This operator can also change the type of data.
+
+If ``out_shapes`` or ``alphas`` are specified, the regions are resized to the destination
+shapes and blended with the output, in the order of pasting, in a single pass::
+
+  out = alpha * region + (1 - alpha) * out
+
+which allows building mosaics of differently sized images without intermediate buffers.
+The bounding boxes can be transformed accordingly with :meth:`nvidia.dali.fn.bbox_multi_paste`.)code")
 .NumInput(1)
 .InputDox(0, "images", "3D TensorList", R"code(Batch of input images.
 
@@ -52,6 +61,29 @@ elements of ``in_ids`` and the second one is equal to the number of dimensions o
 data, excluding channels.
 
 If not provided, all anchors are zero.)code", nullptr, true)
+.AddOptionalArg<int>("out_shapes", R"code(Shape of the destination regions.
+
+The shapes are represented as 2D tensors where the first dimension corresponds to the
+elements of ``in_ids`` and the second one is equal to the number of dimensions of the
+data, excluding channels.
+
+The source regions are resized to these shapes. If not provided, the destination regions
+have the same shapes as the source regions.)code", nullptr, true)
+.AddOptionalArg<float>("alphas", R"code(Blending weights of the pasted regions,
+in range [0, 1].
+
+The weights are represented as 1D tensors with one value for each element of ``in_ids``.
+The value 1 replaces the contents of the output, the value 0 leaves it unchanged.
+
+If not provided, all weights are 1.)code", nullptr, true)
+.AddOptionalArg("interp_type", R"code(Interpolation used when resizing the regions.
+
+Only ``INTERP_NN`` and ``INTERP_LINEAR`` are supported. No antialiasing is applied
+when the regions are scaled down.
+
+.. note::
+  This argument is relevant only if ``out_shapes`` or ``alphas`` are specified.)code",
+        DALI_INTERP_LINEAR)
 .AddArg("output_size",
 R"code(Shape of the output.)code", DALI_INT_VEC, true)
 .AddOptionalArg("dtype",
@@ -60,7 +92,13 @@ R"code(Output data type. If not set, the input type is used.)code", DALI_NO_TYPE
 
 template <typename OutputType, typename InputType>
 void MultiPasteCPU::SetupTyped(const workspace_t<CPUBackend> & /*ws*/,
-                               const TensorListShape<> & /*out_shape*/) {
+                               const TensorListShape<> &out_shape) {
+  if (resize_paste_) {
+    using Kernel = kernels::ResizePasteCPU<OutputType, InputType>;
+    kernel_manager_.Initialize<Kernel>();
+    InitResizePasteSamples(out_shape.num_samples());
+    return;
+  }
   using Kernel = kernels::PasteCPU<OutputType, InputType>;
   kernel_manager_.Initialize<Kernel>();
 }
@@ -78,9 +116,24 @@ void MultiPasteCPU::RunTyped(workspace_t<CPUBackend> &ws) {
 
   auto batch_size = output.shape().num_samples();
 
-  using Kernel = kernels::PasteCPU<OutputType, InputType>;
   auto in_view = view<const InputType, 3>(images);
   auto out_view = view<OutputType, 3>(output);
+  if (resize_paste_) {
+    using Kernel = kernels::ResizePasteCPU<OutputType, InputType>;
+    for (int i = 0; i < batch_size; i++) {
+      tp.AddWork(
+        [&, i](int thread_id) {
+          kernels::KernelContext ctx;
+          kernel_manager_.Run<Kernel>(thread_id, i, ctx, out_view[i], in_view,
+                                      resize_paste_samples_[i]);
+        },
+        out_shape.tensor_size(i));
+    }
+    tp.RunAll();
+    return;
+  }
+
+  using Kernel = kernels::PasteCPU<OutputType, InputType>;
   for (int i = 0; i < batch_size; i++) {
     auto paste_count = in_idx_[i].shape[0];
     memset(out_view[i].data, 0, out_view[i].num_elements() * sizeof(OutputType));
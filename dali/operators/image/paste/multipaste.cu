@@ -15,6 +15,7 @@
 #include <vector>
 #include "dali/operators/image/paste/multipaste.h"
 #include "dali/kernels/imgproc/paste/paste_gpu.h"
+#include "dali/kernels/imgproc/paste/resize_paste_gpu.h"
 #include "dali/core/tensor_view.h"
 
 namespace dali {
@@ -57,9 +58,17 @@ void MultiPasteGPU::SetupTyped(const workspace_t<GPUBackend> &ws,
                                const TensorListShape<> &out_shape) {
   const auto &images = ws.template Input<GPUBackend>(0);
   const auto &in = view<const InputType, 3>(images);
-  using Kernel = kernels::PasteGPU<OutputType, InputType, 3>;
   kernels::KernelContext ctx;
   ctx.gpu.stream = ws.stream();
+  if (resize_paste_) {
+    using Kernel = kernels::ResizePasteGPU<OutputType, InputType>;
+    kernel_manager_.Initialize<Kernel>();
+    InitResizePasteSamples(out_shape.num_samples());
+    kernel_manager_.Setup<Kernel>(0, ctx, make_cspan(resize_paste_samples_),
+                                  out_shape.to_static<3>(), in.shape);
+    return;
+  }
+  using Kernel = kernels::PasteGPU<OutputType, InputType, 3>;
   kernel_manager_.Initialize<Kernel>();
   InitSamples(out_shape);
   const auto &reqs = kernel_manager_.Setup<Kernel>(
@@ -73,12 +82,17 @@ void MultiPasteGPU::RunTyped(workspace_t<GPUBackend> &ws) {
 
   output.SetLayout(images.GetLayout());
   auto out_shape = output.shape();
-  using Kernel = kernels::PasteGPU<OutputType, InputType, 3>;
   auto in_view = view<const InputType, 3>(images);
   auto out_view = view<OutputType, 3>(output);
 
   kernels::KernelContext ctx;
   ctx.gpu.stream = ws.stream();
+  if (resize_paste_) {
+    using Kernel = kernels::ResizePasteGPU<OutputType, InputType>;
+    kernel_manager_.Run<Kernel>(ws.thread_idx(), 0, ctx, out_view, in_view);
+    return;
+  }
+  using Kernel = kernels::PasteGPU<OutputType, InputType, 3>;
   kernel_manager_.Run<Kernel>(ws.thread_idx(), 0, ctx, out_view, in_view);
 }
 
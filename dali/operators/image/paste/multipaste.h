@@ -29,6 +29,7 @@
 #include "dali/util/crop_window.h"
 #include "dali/pipeline/data/types.h"
 #include "dali/kernels/imgproc/paste/paste_gpu_input.h"
+#include "dali/kernels/imgproc/paste/resize_paste.h"
 
 
 namespace dali {
@@ -74,7 +75,13 @@ class MultiPasteOp : public Operator<Backend> {
       , in_idx_("in_ids", spec)
       , in_anchors_("in_anchors", spec)
       , shapes_("shapes", spec)
-      , out_anchors_("out_anchors", spec) {
+      , out_anchors_("out_anchors", spec)
+      , out_shapes_("out_shapes", spec)
+      , alphas_("alphas", spec)
+      , interp_type_(spec.GetArgument<DALIInterpType>("interp_type")) {
+    DALI_ENFORCE(interp_type_ == DALI_INTERP_NN || interp_type_ == DALI_INTERP_LINEAR,
+                 "Only nearest neighbor and linear interpolation are supported.");
+    resize_paste_ = out_shapes_.IsDefined() || alphas_.IsDefined();
     if (std::is_same<Backend, GPUBackend>::value) {
       kernel_manager_.Resize(1, 1);
     } else {
@@ -117,6 +124,12 @@ class MultiPasteOp : public Operator<Backend> {
     if (shapes_.IsDefined()) {
       shapes_.Acquire(spec, ws, curr_batch_size, false);
     }
+    if (out_shapes_.IsDefined()) {
+      out_shapes_.Acquire(spec, ws, curr_batch_size, false);
+    }
+    if (alphas_.IsDefined()) {
+      alphas_.Acquire(spec, ws, curr_batch_size, false);
+    }
     input_type_ = ws.template InputRef<Backend>(0).type();
     output_type_ =
         output_type_arg_ != DALI_NO_TYPE
@@ -159,6 +172,21 @@ class MultiPasteOp : public Operator<Backend> {
                      make_string("Unexpected number of dimensions for ``out_anchors``. Expected ",
                      spatial_ndim_, ", got ", out_anchors_[i].shape[1]));
       }
+      if (out_shapes_.IsDefined()) {
+        DALI_ENFORCE(out_shapes_[i].shape[0] == n_paste,
+                     "out_shapes must be same length as in_idx");
+        DALI_ENFORCE(out_shapes_[i].shape[1] == spatial_ndim_,
+                     make_string("Unexpected number of dimensions for ``out_shapes``. Expected ",
+                     spatial_ndim_, ", got ", out_shapes_[i].shape[1]));
+      }
+      if (alphas_.IsDefined()) {
+        DALI_ENFORCE(alphas_[i].shape[0] == n_paste, "alphas must be same length as in_idx");
+        for (int j = 0; j < n_paste; j++) {
+          DALI_ENFORCE(alphas_[i].data[j] >= 0 && alphas_[i].data[j] <= 1,
+                       make_string("The alphas must be in range [0, 1], got ",
+                                   alphas_[i].data[j]));
+        }
+      }
 
       bool found_intersection = false;
       for (int j = 0; j < n_paste; j++) {
@@ -167,12 +195,15 @@ class MultiPasteOp : public Operator<Backend> {
         auto in_anchor_j = GetInAnchors(i, j);
         auto in_shape_j = GetInputShape(j_idx);
         auto shape_j = GetShape(i, j, in_shape_j, in_anchor_j);
-        auto shape_j_view = Coords{shape_j.data(), coords_sh_};
+        auto out_shape_j = GetOutShape(i, j, shape_j);
+        auto shape_j_view = Coords{out_shape_j.data(), coords_sh_};
         for (int k = 0; k < spatial_ndim_; k++) {
           DALI_ENFORCE(out_anchor_j.data[k] >= 0 && in_anchor_j.data[k] >= 0 &&
-                       out_anchor_j.data[k] + shape_j[k] <= output_size_[i].data[k] &&
+                       out_anchor_j.data[k] + out_shape_j[k] <= output_size_[i].data[k] &&
                        in_anchor_j.data[k] + shape_j[k] <= in_shape_j.data[k],
                        "Paste in/out coords should be within input/output bounds.");
+          DALI_ENFORCE(out_shape_j[k] >= 0 && (shape_j[k] > 0 || out_shape_j[k] == 0),
+                       "A non-empty output region requires a non-empty input region.");
         }
 
         for (int k = 0; k < j; k++) {
@@ -180,7 +211,7 @@ class MultiPasteOp : public Operator<Backend> {
           auto out_anchor_k = GetOutAnchors(i, k);
           auto in_anchor_k = GetInAnchors(i, k);
           auto in_shape_k = GetInputShape(k_idx);;
-          auto shape_k = GetShape(i, k, in_shape_k, in_anchor_k);
+          auto shape_k = GetOutShape(i, k, GetShape(i, k, in_shape_k, in_anchor_k));
           auto shape_k_view = Coords{shape_k.data(), coords_sh_};
           if (Intersects(out_anchor_j, shape_j_view, out_anchor_k, shape_k_view)) {
             found_intersection = true;
@@ -269,6 +300,50 @@ class MultiPasteOp : public Operator<Backend> {
     return sh;
   }
 
+  /**
+   * @brief Returns the shape of the destination region - if not specified, it's the same
+   *        as the shape of the source region
+   */
+  inline SmallVector<int, 4> GetOutShape(int sample_num, int paste_num,
+                                         const SmallVector<int, 4> &in_region_shape) const {
+    if (!out_shapes_.IsDefined())
+      return in_region_shape;
+    auto sh_view = subtensor(out_shapes_[sample_num], paste_num);
+    SmallVector<int, 4> sh;
+    sh.resize(sh_view.num_elements());
+    for (size_t d = 0; d < sh.size(); d++)
+      sh[d] = sh_view.data[d];
+    return sh;
+  }
+
+  /**
+   * @brief Describes the pastes for the resizing and blending kernels
+   */
+  void InitResizePasteSamples(int batch_size) {
+    resize_paste_samples_.resize(batch_size);
+    for (int i = 0; i < batch_size; i++) {
+      auto &sample = resize_paste_samples_[i];
+      int n = in_idx_[i].num_elements();
+      sample.linear = interp_type_ == DALI_INTERP_LINEAR;
+      sample.patches.resize(n);
+      for (int j = 0; j < n; j++) {
+        auto &patch = sample.patches[j];
+        patch.in_idx = in_idx_[i].data[j];
+        auto in_anchor = GetInAnchors(i, j);
+        auto in_shape = GetShape(i, j, GetInputShape(patch.in_idx), in_anchor);
+        auto out_anchor = GetOutAnchors(i, j);
+        auto out_shape = GetOutShape(i, j, in_shape);
+        for (int d = 0; d < spatial_ndim_; d++) {
+          patch.in_anchor[d] = in_anchor.data[d];
+          patch.in_shape[d] = in_shape[d];
+          patch.out_anchor[d] = out_anchor.data[d];
+          patch.out_shape[d] = out_shape[d];
+        }
+        patch.alpha = alphas_.IsDefined() ? alphas_[i].data[j] : 1.0f;
+      }
+    }
+  }
+
   inline Coords GetOutAnchors(int sample_num, int paste_num) const {
     return out_anchors_.IsDefined()
            ? subtensor(out_anchors_[sample_num], paste_num)
@@ -288,6 +363,13 @@ class MultiPasteOp : public Operator<Backend> {
   ArgValue<int, 2> in_anchors_;
   ArgValue<int, 2> shapes_;
   ArgValue<int, 2> out_anchors_;
+  ArgValue<int, 2> out_shapes_;
+  ArgValue<float, 1> alphas_;
+  DALIInterpType interp_type_;
+
+  /// The regions are resized and/or blended, instead of being copied
+  bool resize_paste_ = false;
+  vector<kernels::paste::ResizePasteSampleInput> resize_paste_samples_;
 
   SmallVector<int, 4> zeros_;
   Coords zero_anchors_;
@@ -0,0 +1,135 @@
+
+
+def resize_paste_ref(inputs, in_idx, in_anchors, shapes, out_anchors, out_shapes, alphas,
+                     out_size, linear):
+    out = np.zeros(out_size + (inputs[0].shape[2],), dtype=np.float32)
+    for j, idx in enumerate(in_idx):
+        src = inputs[idx].astype(np.float32)
+        lo = in_anchors[j]
+        hi = lo + shapes[j]
+        scale = shapes[j] / out_shapes[j]
+        coords = []
+        for d in range(2):
+            # pixel centers of the destination region, mapped to the source region
+            c = lo[d] + (np.arange(out_shapes[j][d]) + 0.5) * scale[d]
+            coords.append(c - 0.5 if linear else np.floor(c))
+        if linear:
+            y0, x0 = [np.floor(c).astype(np.int32) for c in coords]
+            qy = (coords[0] - y0)[:, np.newaxis, np.newaxis]
+            qx = (coords[1] - x0)[np.newaxis, :, np.newaxis]
+            y1, x1 = [np.clip(c0 + 1, lo[d], hi[d] - 1) for d, c0 in enumerate((y0, x0))]
+            y0, x0 = [np.clip(c0, lo[d], hi[d] - 1) for d, c0 in enumerate((y0, x0))]
+            top = src[y0][:, x0] + qx * (src[y0][:, x1] - src[y0][:, x0])
+            bottom = src[y1][:, x0] + qx * (src[y1][:, x1] - src[y1][:, x0])
+            patch = top + qy * (bottom - top)
+        else:
+            y, x = [np.clip(c.astype(np.int32), lo[d], hi[d] - 1) for d, c in enumerate(coords)]
+            patch = src[y][:, x]
+        o_lo = out_anchors[j]
+        o_hi = o_lo + out_shapes[j]
+        region = out[o_lo[0]:o_hi[0], o_lo[1]:o_hi[1]]
+        region += alphas[j] * (patch - region)
+    return np.clip(np.round(out), 0, 255).astype(np.uint8)
+
+
+def prepare_mosaic(batch_size, in_size, out_size):
+    """Pastes random regions of 4 random inputs into the quadrants of each output, resized
+    to the quadrant size; the last region is blended over the whole output."""
+    in_idx_l, in_anchors_l, shapes_l, out_anchors_l, out_shapes_l, alphas_l = [], [], [], [], [], []
+    h, w = out_size[0] // 2, out_size[1] // 2
+    for i in range(batch_size):
+        in_idx = np.random.randint(batch_size, size=5).astype(np.int32)
+        shapes = np.array([[np.random.randint(1, in_size[d] + 1) for d in range(2)] for _ in range(5)],
+                          dtype=np.int32)
+        in_anchors = np.array([[np.random.randint(in_size[d] - s[d] + 1) for d in range(2)] for s in shapes],
+                              dtype=np.int32)
+        out_anchors = np.array([[0, 0], [0, w], [h, 0], [h, w], [0, 0]], dtype=np.int32)
+        out_shapes = np.array([[h, w]] * 4 + [list(out_size)], dtype=np.int32)
+        alphas = np.array([1, 1, 1, 1, np.random.uniform(0, 0.5)], dtype=np.float32)
+        in_idx_l.append(in_idx)
+        in_anchors_l.append(in_anchors)
+        shapes_l.append(shapes)
+        out_anchors_l.append(out_anchors)
+        out_shapes_l.append(out_shapes)
+        alphas_l.append(alphas)
+    return in_idx_l, in_anchors_l, shapes_l, out_anchors_l, out_shapes_l, alphas_l
+
+
+def check_resize_paste(bs, in_size, out_size, interp_type, device):
+    cuts = prepare_mosaic(bs, in_size, out_size)
+    pipe = Pipeline(batch_size=bs, num_threads=4, device_id=0, seed=1234)
+    with pipe:
+        input, _ = fn.readers.file(file_root=img_dir)
+        decoded = fn.decoders.image(input, device='cpu', output_type=types.RGB)
+        resized = fn.resize(decoded, resize_x=in_size[1], resize_y=in_size[0])
+        in_idx, in_anchors, shapes, out_anchors, out_shapes, alphas = \
+            [fn.external_source(lambda c=c: c) for c in cuts]
+        pasted = fn.multi_paste(resized.gpu() if device == 'gpu' else resized,
+                                in_ids=in_idx, in_anchors=in_anchors, shapes=shapes,
+                                out_anchors=out_anchors, out_shapes=out_shapes, alphas=alphas,
+                                output_size=out_size, interp_type=interp_type)
+        pipe.set_outputs(pasted, resized)
+    pipe.build()
+    result, input = pipe.run()
+    if device == 'gpu':
+        result = result.as_cpu()
+    inputs = [input.at(i) for i in range(bs)]
+    for i in range(bs):
+        ref = resize_paste_ref(inputs, *[c[i] for c in cuts], out_size,
+                               interp_type == types.INTERP_LINEAR)
+        out = result.at(i)
+        assert out.shape == ref.shape
+        # the rounding of the intermediate values may differ
+        assert np.max(np.abs(out.astype(np.int32) - ref.astype(np.int32))) <= 1
+
+
+def test_resize_paste():
+    for device in ['cpu', 'gpu']:
+        for interp_type in [types.INTERP_NN, types.INTERP_LINEAR]:
+            for in_size, out_size in [((128, 128), (128, 128)), ((200, 100), (64, 96))]:
+                yield check_resize_paste, 4, in_size, out_size, interp_type, device
+
+
+def test_bbox_multi_paste():
+    bs = 3
+    boxes_l = [np.array([[10, 20, 50, 60], [0, 0, 5, 5]], dtype=np.float32),
+               np.array([[30, 30, 90, 70]], dtype=np.float32),
+               np.zeros((0, 4), dtype=np.float32)]
+    labels_l = [np.array([1, 2], dtype=np.int32), np.array([3], dtype=np.int32),
+                np.zeros((0,), dtype=np.int32)]
+    # (y, x) order
+    in_idx_l = [np.array([0, 1], dtype=np.int32), np.array([1], dtype=np.int32),
+                np.array([0], dtype=np.int32)]
+    in_anchors_l = [np.array([[10, 10], [40, 20]], dtype=np.int32), np.array([[0, 0]], dtype=np.int32),
+                    np.array([[100, 100]], dtype=np.int32)]
+    shapes_l = [np.array([[40, 40], [40, 40]], dtype=np.int32), np.array([[100, 100]], dtype=np.int32),
+                np.array([[10, 10]], dtype=np.int32)]
+    out_anchors_l = [np.array([[0, 0], [20, 40]], dtype=np.int32), np.array([[5, 10]], dtype=np.int32),
+                     np.array([[0, 0]], dtype=np.int32)]
+    out_shapes_l = [np.array([[20, 40], [20, 20]], dtype=np.int32), np.array([[100, 100]], dtype=np.int32),
+                    np.array([[10, 10]], dtype=np.int32)]
+
+    pipe = Pipeline(batch_size=bs, num_threads=1, device_id=None)
+    with pipe:
+        args = [fn.external_source(lambda c=c: c) for c in
+                (boxes_l, labels_l, in_idx_l, in_anchors_l, shapes_l, out_anchors_l, out_shapes_l)]
+        boxes, labels, in_idx, in_anchors, shapes, out_anchors, out_shapes = args
+        out_boxes, out_labels = fn.bbox_multi_paste(boxes, labels, in_ids=in_idx,
+                                                    in_anchors=in_anchors, shapes=shapes,
+                                                    out_anchors=out_anchors, out_shapes=out_shapes)
+        pipe.set_outputs(out_boxes, out_labels)
+    pipe.build()
+    out_boxes, out_labels = pipe.run()
+
+    # sample 0: the first box of input 0 is clipped to x in [10, 50), y in [20, 50), shifted
+    # by (-10, -10) and scaled by (1, 0.5); the second one is outside of the region; the box
+    # of input 1 is clipped to x in [30, 60), y in [40, 70), shifted by (-20, -40), scaled
+    # by 0.5 and shifted by (40, 20)
+    ref_boxes = [np.array([[0, 5, 40, 20], [45, 20, 60, 35]], dtype=np.float32),
+                 np.array([[40, 35, 100, 75]], dtype=np.float32),
+                 np.zeros((0, 4), dtype=np.float32)]
+    ref_labels = [np.array([1, 3]), np.array([3]), np.zeros((0,))]
+    for i in range(bs):
+        assert np.allclose(out_boxes.at(i).reshape(-1, 4), ref_boxes[i]), \
+            f"{out_boxes.at(i)} vs {ref_boxes[i]}"
+        assert np.array_equal(out_labels.at(i), ref_labels[i])
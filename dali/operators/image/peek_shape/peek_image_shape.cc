@@ -17,9 +17,13 @@
 namespace dali {
 
 DALI_SCHEMA(PeekImageShape)
-  .DocStr(R"code(Obtains the shape of the encoded image.)code")
+  .DocStr(R"code(Obtains the shape of the encoded image.
+
+The parsed image headers are cached by the source info of the sample (e.g. the file name),
+together with the decoders, so that each header is parsed only once.)code")
   .NumInput(1)
   .NumOutput(1)
+  .Deterministic()
   .AddOptionalArg("type", R"code(Data type, to which the sizes are converted.)code", DALI_INT64);
 
 DALI_REGISTER_OPERATOR(PeekImageShape, PeekImageShape, CPU);
@@ -17,6 +17,7 @@
 
 #include <vector>
 #include "dali/image/image_factory.h"
+#include "dali/operators/decoder/cache/image_info_cache.h"
 #include "dali/core/tensor_shape.h"
 #include "dali/pipeline/operator/operator.h"
 #include "dali/core/static_switch.h"
@@ -83,8 +84,20 @@ class PeekImageShape : public Operator<CPUBackend> {
                       "Input must be 1D encoded jpeg string.");
         DALI_ENFORCE(IsType<uint8>(image.type()),
                       "Input must be stored as uint8 data.");
-        auto img = ImageFactory::CreateImage(image.data<uint8>(), image.size(), {});
-        auto shape = img->PeekShape();
+        auto &info_cache = ImageInfoCache::Instance();
+        const auto &file_name = image.GetSourceInfo();
+        const int64_t size = image.size();
+        ImageHeaderInfo info;
+        TensorShape<3> shape;
+        if (info_cache.Get(file_name, size, info) && volume(info.shape) > 0) {
+          shape = info.shape;
+        } else {
+          auto img = ImageFactory::CreateImage(image.data<uint8>(), image.size(), {});
+          shape = img->PeekShape();
+          info_cache.Update(file_name, size, [&](ImageHeaderInfo &info) {
+            info.shape = shape;
+          });
+        }
         TYPE_SWITCH(output_type_, type2id, type,
                 (int32_t, uint32_t, int64_t, uint64_t, float, double),
           (WriteShape<type>(output[sample_id], shape);),
@@ -15,6 +15,7 @@
 #ifndef DALI_OPERATORS_IMAGE_REMAP_WARP_H_
 #define DALI_OPERATORS_IMAGE_REMAP_WARP_H_
 
+#include <algorithm>
 #include <cassert>
 #include <memory>
 #include <string>
@@ -113,6 +114,12 @@ class WarpOpImpl : public OpImplInterface<Backend> {
   void SetupBackend(TensorListShape<> &shape, const DeviceWorkspace &ws) {
     auto context = GetContext(ws);
     kmgr_.Resize<Kernel>(1, 1);
+    auto texture_usage = kernels::warp::TextureUsage::Auto;
+    if (spec_.HasArgument("use_texture")) {
+      texture_usage = spec_.GetArgument<bool>("use_texture") ? kernels::warp::TextureUsage::Always
+                                                              : kernels::warp::TextureUsage::Never;
+    }
+    kmgr_.Get<Kernel>(0).SetTextureUsage(texture_usage);
     auto &req = kmgr_.Setup<Kernel>(
         0, context,
         input_,
@@ -155,19 +162,21 @@ class WarpOpImpl : public OpImplInterface<Backend> {
     ThreadPool &pool = ws.GetThreadPool();
     auto interp_types = param_provider_->InterpTypes();
 
-    for (int i = 0; i < input_.num_samples(); i++) {
-      pool.AddWork([&, i](int tid) {
-        DALIInterpType interp_type = interp_types.size() > 1 ? interp_types[i] : interp_types[0];
-        auto context = GetContext(ws);
-        kmgr_.Run<Kernel>(
-            tid, i, context,
-            output[i],
-            input_[i],
-            *param_provider_->ParamsCPU()(i),
-            param_provider_->OutputSizes()[i],
-            interp_type,
-            param_provider_->Border());
-      }, output.shape.tensor_size(i));
+    int N = input_.num_samples();
+    // large images are split into blocks of rows, so that small batches use all the threads
+    int req_nblocks = std::max(1, 10 * pool.NumThreads() / std::max(N, 1));
+    for (int i = 0; i < N; i++) {
+      DALIInterpType interp_type = interp_types.size() > 1 ? interp_types[i] : interp_types[0];
+      auto context = GetContext(ws);
+      kmgr_.Get<Kernel>(i).Schedule(
+          context,
+          output[i],
+          input_[i],
+          *param_provider_->ParamsCPU()(i),
+          param_provider_->OutputSizes()[i],
+          interp_type,
+          param_provider_->Border(),
+          pool, kernels::kWarpMinBlockSize, req_nblocks);
     }
     pool.RunAll();
   }
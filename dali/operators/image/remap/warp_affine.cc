@@ -35,8 +35,12 @@ If the ``inverse_map`` option is set to false, the matrix represents a source to
 transform and it is inverted before applying to the formula above.
 
 It is equivalent to OpenCV's ``warpAffine`` operation with the ``inverse_map`` argument being 
-analog to the ``WARP_INVERSE_MAP`` flag.)code",
+analog to the ``WARP_INVERSE_MAP`` flag.
+
+In the GPU operator, the matrices can be passed as an argument input located in GPU memory,
+which are then used without copying them to the host.)code",
       vector<float>(), true)
+  .AllowGPUArgumentInput("matrix")
   .AddOptionalArg<bool>("inverse_map", "Set to ``False`` if the given transform is a "
                         "destination to source mapping, ``True`` otherwise.", true, false)
   .AddParent("WarpAttr");
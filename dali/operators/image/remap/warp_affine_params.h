@@ -57,7 +57,10 @@ class WarpAffineParamProvider
         UseInputAsParams(ws_->template InputRef<CPUBackend>(1), invert);
       }
     } else if (spec_->HasTensorArgument("matrix")) {
-      UseInputAsParams(ws_->ArgumentInput("matrix"), invert);
+      if (ws_->ArgumentInputIsGPU("matrix"))
+        UseInputAsParams(ws_->GPUArgumentInput("matrix"), invert);
+      else
+        UseInputAsParams(ws_->ArgumentInput("matrix"), invert);
     } else {
       std::vector<float> matrix = spec_->template GetArgument<std::vector<float>>("matrix");
       DALI_ENFORCE(!matrix.empty(),
@@ -149,8 +152,8 @@ class WarpAffineParamProvider
   void UseInputAsParams(const TensorList<GPUBackend> &input, bool invert) {
     CheckParamInput(input);
 
-    std::vector<const MappingParams *> input_mappings;
-    input_mappings.resize(num_samples_);
+    mm::pmr_vector<const MappingParams *> input_mappings(
+        num_samples_, this->ws_->template HostScratchAllocator<const MappingParams *>());
     for (int i = 0; i < num_samples_; i++) {
       input_mappings[i] = static_cast<const MappingParams *>(input.raw_tensor(i));
     }
@@ -38,6 +38,17 @@ If not set, the input type is used.)code",
   .DeprecateArgInFavorOf("output_dtype", "dtype")  // deprecated since 0.24dev
   .AddOptionalArg("interp_type",
       R"code(Type of interpolation used.)code",
-      DALI_INTERP_LINEAR);
+      DALI_INTERP_LINEAR)
+  .AddOptionalArg<bool>("use_texture",
+      R"code(Determines whether the GPU variant reads 2D inputs through texture objects.
+
+If not set, the textures are used for large images when the transform contains a large rotation
+or downscaling. With linear interpolation of ``uint8`` or ``float`` images with 1, 2 or 4
+channels, the hardware filtering is used, which has limited precision of the interpolation
+weights. Inputs which can't be bound to a texture are read from global memory.
+
+.. note::
+  This argument is ignored for the CPU variant.)code",
+      nullptr);
 
 }  // namespace dali
@@ -40,7 +40,16 @@ Must be same as input type or ``float``. If not set, input type is used.)code",
       0)
   .AddOptionalArg("minibatch_size", R"code(Maximum number of images that are processed in
 a kernel call.)code",
-      32);
+      32)
+  .AddOptionalArg("bucket_by_size", R"code(If set to True, the images are grouped by their
+output size and the work is split into evenly sized blocks.
+
+This can improve the performance for batches of images of very different sizes. The order
+of the outputs and the results are not affected.
+
+.. note::
+  This argument is ignored for the CPU variant.)code",
+      false);
 
 
 using namespace kernels;  // NOLINT
@@ -27,6 +27,7 @@ namespace dali {
 template <typename Backend>
 ResizeBase<Backend>::ResizeBase(const OpSpec &spec) {
   size_t temp_buffer_hint = spec.GetArgument<int64_t>("temp_buffer_hint");
+  bucket_by_size_ = spec.GetArgument<bool>("bucket_by_size");
 }
 
 template <typename Backend>
@@ -79,7 +80,7 @@ void ResizeBase<GPUBackend>::SetupResizeStatic(
   auto *impl = dynamic_cast<ImplType*>(impl_.get());
   if (!impl) {
     impl_.reset();
-    auto unq_impl = std::make_unique<ImplType>(kmgr_, minibatch_size_);
+    auto unq_impl = std::make_unique<ImplType>(kmgr_, minibatch_size_, bucket_by_size_);
     impl = unq_impl.get();
     impl_ = std::move(unq_impl);
   }
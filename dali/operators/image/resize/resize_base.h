@@ -95,6 +95,7 @@ class DLL_PUBLIC ResizeBase {
 
   int num_threads_ = 1;
   int minibatch_size_ = 32;
+  bool bucket_by_size_ = false;
   std::unique_ptr<Impl> impl_;
   kernels::KernelManager kmgr_;
 };
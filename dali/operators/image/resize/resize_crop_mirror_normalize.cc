@@ -0,0 +1,202 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/image/resize/resize_crop_mirror_normalize.h"
+#include <utility>
+#include "dali/core/static_switch.h"
+#include "dali/kernels/imgproc/resample_normalize.h"
+#include "dali/pipeline/data/views.h"
+
+namespace dali {
+
+#define RCMN_IN_TYPES (uint8_t, int16_t, uint16_t, float)
+#define RCMN_OUT_TYPES (float, float16, uint8_t, int8_t)
+
+DALI_SCHEMA(ResizeCropMirrorNormalize)
+  .DocStr(R"code(Performs fused resizing, cropping, mirroring, normalization and the layout
+conversion (HWC to CHW) of the images.
+
+The result is equivalent to resizing the images with the arguments of ``resize`` and then
+applying ``crop_mirror_normalize`` to the resized images, but the resized images are never
+stored - the crop and the mirroring are applied to the region of the input that is resampled and
+the normalization is done when the resampled pixels are stored::
+
+  output = (resized - mean) / std * scale + shift
+
+The output type, set with ``dtype``, can be ``FLOAT`` (default), ``FLOAT16``, ``UINT8`` or
+``INT8``. The integer outputs are rounded to the nearest integer and saturated, so ``scale`` and
+``shift`` can be used as the inverse of the quantization scale and the zero point of a quantized
+model input.
+
+.. note::
+    The crop window must lie within the resized image - padding is not supported.
+)code")
+  .NumInput(1)
+  .NumOutput(1)
+  .InputLayout(0, { "HWC" })
+  .AddOptionalArg("output_layout",
+    R"code(Tensor data layout for the output.
+
+Supported values: ``CHW``, ``HWC``.)code", TensorLayout("CHW"))
+  .AddOptionalArg("mirror",
+    R"code(If nonzero, the image will be flipped (mirrored) horizontally.)code",
+    0, true)
+  .AddOptionalArg("mean",
+    R"code(Mean pixel values for image normalization.)code",
+    std::vector<float>{0.0f})
+  .AddOptionalArg("std",
+    R"code(Standard deviation values for image normalization.)code",
+    std::vector<float>{1.0f})
+  .AddOptionalArg("scale", R"code(The value by which the result is multiplied.
+
+This argument is useful when using integer outputs to improve dynamic range utilization.)code",
+    1.0f)
+  .AddOptionalArg("shift", R"code(The value added to the (scaled) result.
+
+This argument is useful when using integer outputs, e.g. as the zero point of quantized data.)code",
+    0.0f)
+  .AddParent("ResizeAttr")
+  .AddParent("ResamplingFilterAttr")
+  .AddParent("CropAttr");
+
+ResizeCropMirrorNormalize::ResizeCropMirrorNormalize(const OpSpec &spec)
+    : Operator<GPUBackend>(spec)
+    , crop_attr_(spec)
+    , output_layout_(spec.GetArgument<TensorLayout>("output_layout"))
+    , scale_(spec.GetArgument<float>("scale"))
+    , shift_(spec.GetArgument<float>("shift")) {
+  DALI_ENFORCE(output_layout_ == "CHW" || output_layout_ == "HWC",
+               make_string("Unsupported output layout: \"", output_layout_,
+                           "\". Supported layouts are: \"CHW\", \"HWC\"."));
+  mean_ = spec.GetRepeatedArgument<float>("mean");
+  auto stddev = spec.GetRepeatedArgument<float>("std");
+  DALI_ENFORCE(!mean_.empty() && !stddev.empty(), "``mean`` and ``std`` must not be empty");
+  for (float s : stddev) {
+    DALI_ENFORCE(s != 0, "``std`` must not contain zeros");
+    inv_stddev_.push_back(1.0f / s);
+  }
+}
+
+void ResizeCropMirrorNormalize::SetupResamplingParams(const DeviceWorkspace &ws,
+                                                      const TensorListShape<> &in_shape) {
+  int N = in_shape.num_samples();
+  resize_attr_.PrepareResizeParams(spec_, ws, in_shape, "HWC");
+  resampling_attr_.PrepareFilterParams(spec_, ws, N);
+  resample_params_.resize(N);
+  resampling_attr_.GetResamplingParams(make_span(resample_params_),
+                                       make_cspan(resize_attr_.params_));
+  crop_attr_.ProcessArguments(ws);
+
+  for (int i = 0; i < N; i++) {
+    auto &params = resample_params_[i];
+    auto sample_shape = in_shape.tensor_shape_span(i);
+    TensorShape<> resized_shape = { params[0].output_size, params[1].output_size };
+    auto crop = crop_attr_.GetCropWindowGenerator(i)(resized_shape, "HW");
+    crop.EnforceInRange(resized_shape);
+    bool mirror = spec_.GetArgument<int>("mirror", &ws, i);
+
+    for (int d = 0; d < 2; d++) {
+      auto &p = params[d];
+      float lo = 0, hi = sample_shape[d];
+      if (p.roi.use_roi) {
+        lo = p.roi.start;
+        hi = p.roi.end;
+      }
+      // position of the crop window, in the input coordinates; the ROI may be flipped
+      float scale = (hi - lo) / p.output_size;
+      float start = lo + crop.anchor[d] * scale;
+      float end = lo + (crop.anchor[d] + crop.shape[d]) * scale;
+      if (d == 1 && mirror)
+        std::swap(start, end);
+      p.roi = kernels::ResamplingParams::ROI(start, end);
+      p.output_size = crop.shape[d];
+    }
+  }
+}
+
+void ResizeCropMirrorNormalize::SetupNormalization(const TensorListShape<> &in_shape) {
+  int N = in_shape.num_samples();
+  mul_.clear();
+  add_.clear();
+  for (int i = 0; i < N; i++) {
+    int C = in_shape.tensor_shape_span(i)[2];
+    DALI_ENFORCE(mean_.size() == 1 || static_cast<int>(mean_.size()) == C,
+                 make_string("``mean`` must have 1 or ", C, " elements, got: ", mean_.size()));
+    DALI_ENFORCE(inv_stddev_.size() == 1 || static_cast<int>(inv_stddev_.size()) == C,
+                 make_string("``std`` must have 1 or ", C, " elements, got: ",
+                             inv_stddev_.size()));
+    for (int c = 0; c < C; c++) {
+      float mean = mean_[mean_.size() == 1 ? 0 : c];
+      float inv_stddev = inv_stddev_[inv_stddev_.size() == 1 ? 0 : c];
+      mul_.push_back(inv_stddev * scale_);
+      add_.push_back(shift_ - mean * inv_stddev * scale_);
+    }
+  }
+}
+
+bool ResizeCropMirrorNormalize::SetupImpl(std::vector<OutputDesc> &output_desc,
+                                          const DeviceWorkspace &ws) {
+  const auto &input = ws.InputRef<GPUBackend>(0);
+  const auto &in_shape = input.shape();
+  DALI_ENFORCE(in_shape.sample_dim() == 3,
+               make_string("Expected HWC images, got ", in_shape.sample_dim(), "D input."));
+
+  SetupResamplingParams(ws, in_shape);
+  SetupNormalization(in_shape);
+  output_type_ = resampling_attr_.GetOutputType(DALI_FLOAT);
+
+  if (input.type() != input_type_) {
+    input_type_ = input.type();
+    kmgr_.Reset();
+  }
+
+  bool planar = output_layout_ == "CHW";
+  kernels::KernelContext ctx;
+  ctx.gpu.stream = ws.stream();
+  output_desc.resize(1);
+  output_desc[0].type = output_type_;
+  TYPE_SWITCH(input_type_, type2id, In, RCMN_IN_TYPES, (
+    TYPE_SWITCH(output_type_, type2id, Out, RCMN_OUT_TYPES, (
+      using Kernel = kernels::ResampleNormalizeGPU<Out, In>;
+      if (kmgr_.NumInstances() == 0)
+        kmgr_.Resize<Kernel>(1, 1);
+      auto in_view = view<const In, 3>(input);
+      auto &req = kmgr_.Setup<Kernel>(0, ctx, in_view, make_cspan(resample_params_), planar);
+      output_desc[0].shape = req.output_shapes[0];
+    ), DALI_FAIL(make_string("Unsupported output type: ", output_type_,  // NOLINT
+                             ". Supported types are: FLOAT, FLOAT16, UINT8, INT8.")));  // NOLINT
+  ), DALI_FAIL(make_string("Unsupported input type: ", input_type_)));  // NOLINT
+  return true;
+}
+
+void ResizeCropMirrorNormalize::RunImpl(DeviceWorkspace &ws) {
+  const auto &input = ws.InputRef<GPUBackend>(0);
+  auto &output = ws.OutputRef<GPUBackend>(0);
+  output.SetLayout(output_layout_);
+  kernels::KernelContext ctx;
+  ctx.gpu.stream = ws.stream();
+  TYPE_SWITCH(input_type_, type2id, In, RCMN_IN_TYPES, (
+    TYPE_SWITCH(output_type_, type2id, Out, RCMN_OUT_TYPES, (
+      using Kernel = kernels::ResampleNormalizeGPU<Out, In>;
+      auto in_view = view<const In, 3>(input);
+      auto out_view = view<Out, 3>(output);
+      kmgr_.Run<Kernel>(0, 0, ctx, out_view, in_view,
+                        make_cspan(mul_), make_cspan(add_));
+    ), DALI_FAIL(make_string("Unsupported output type: ", output_type_)));  // NOLINT
+  ), DALI_FAIL(make_string("Unsupported input type: ", input_type_)));  // NOLINT
+}
+
+DALI_REGISTER_OPERATOR(ResizeCropMirrorNormalize, ResizeCropMirrorNormalize, GPU);
+
+}  // namespace dali
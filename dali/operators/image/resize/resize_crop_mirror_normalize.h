@@ -0,0 +1,80 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_IMAGE_RESIZE_RESIZE_CROP_MIRROR_NORMALIZE_H_
+#define DALI_OPERATORS_IMAGE_RESIZE_RESIZE_CROP_MIRROR_NORMALIZE_H_
+
+#include <vector>
+#include "dali/core/tensor_layout.h"
+#include "dali/kernels/imgproc/resample/params.h"
+#include "dali/kernels/kernel_manager.h"
+#include "dali/operators/image/crop/crop_attr.h"
+#include "dali/operators/image/resize/resampling_attr.h"
+#include "dali/operators/image/resize/resize_attr.h"
+#include "dali/pipeline/operator/operator.h"
+
+namespace dali {
+
+/**
+ * @brief Resizes, crops, mirrors and normalizes the images in one resampling kernel
+ *
+ * This is equivalent to Resize followed by CropMirrorNormalize, but the resized image
+ * is never stored - the crop window and mirroring are applied to the resampling region of
+ * interest and the normalization and layout permutation are fused into the last
+ * resampling pass.
+ */
+class ResizeCropMirrorNormalize : public Operator<GPUBackend> {
+ public:
+  explicit ResizeCropMirrorNormalize(const OpSpec &spec);
+
+  DISABLE_COPY_MOVE_ASSIGN(ResizeCropMirrorNormalize);
+
+ protected:
+  bool CanInferOutputs() const override { return true; }
+
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const DeviceWorkspace &ws) override;
+
+  void RunImpl(DeviceWorkspace &ws) override;
+
+  USE_OPERATOR_MEMBERS();
+
+ private:
+  /**
+   * @brief Calculates the resampling parameters which map the crop window
+   *        in the resized image to the input image.
+   */
+  void SetupResamplingParams(const DeviceWorkspace &ws, const TensorListShape<> &in_shape);
+
+  /**
+   * @brief Calculates per-channel multipliers and added values for all samples
+   */
+  void SetupNormalization(const TensorListShape<> &in_shape);
+
+  ResizeAttr resize_attr_;
+  ResamplingFilterAttr resampling_attr_;
+  CropAttr crop_attr_;
+
+  std::vector<float> mean_, inv_stddev_;
+  float scale_ = 1, shift_ = 0;
+  TensorLayout output_layout_;
+  DALIDataType input_type_ = DALI_NO_TYPE, output_type_ = DALI_FLOAT;
+
+  std::vector<kernels::ResamplingParams2D> resample_params_;
+  std::vector<float> mul_, add_;
+  kernels::KernelManager kmgr_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_IMAGE_RESIZE_RESIZE_CROP_MIRROR_NORMALIZE_H_
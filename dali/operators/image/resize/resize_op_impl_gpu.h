@@ -19,7 +19,9 @@
 #error This file is a part of resize base implementation and should not be included elsewhere
 #endif
 
+#include <algorithm>
 #include <cassert>
+#include <numeric>
 #include <vector>
 #include "dali/operators/image/resize/resize_op_impl.h"
 #include "dali/kernels/imgproc/resample.h"
@@ -29,8 +31,13 @@ namespace dali {
 template <typename Out, typename In, int spatial_ndim>
 class ResizeOpImplGPU : public ResizeBase<GPUBackend>::Impl {
  public:
-  explicit ResizeOpImplGPU(kernels::KernelManager &kmgr, int minibatch_size)
-  : kmgr_(kmgr), minibatch_size_(minibatch_size) {
+  /**
+   * @param bucket_by_size if true, the frames are sorted by output size before being divided
+   *                       into minibatches and the kernels are asked to balance the work;
+   *                       the outputs are stored in the original order
+   */
+  ResizeOpImplGPU(kernels::KernelManager &kmgr, int minibatch_size, bool bucket_by_size = false)
+  : kmgr_(kmgr), minibatch_size_(minibatch_size), bucket_by_size_(bucket_by_size) {
     kmgr_.Resize(kmgr_.NumThreads(), 0);
   }
 
@@ -59,6 +66,8 @@ class ResizeOpImplGPU : public ResizeBase<GPUBackend>::Impl {
     // Now that we know how many logical frames there are, calculate batch subdivision.
     SetNumFrames(in_shape_.num_samples());
 
+    SortFrames();
+
     SetupKernel();
   }
 
@@ -71,12 +80,15 @@ class ResizeOpImplGPU : public ResizeBase<GPUBackend>::Impl {
       in_slice.shape.resize(mb.count, dim);
       int end = mb.start + mb.count;
       for (int i = mb.start, j = 0; i < end; i++, j++) {
+        int frame = frame_order_[i];
         for (int d = 0; d < dim; d++)
-          in_slice.tensor_shape_span(j)[d] = in_shape_.tensor_shape_span(i)[d];
+          in_slice.tensor_shape_span(j)[d] = in_shape_.tensor_shape_span(frame)[d];
       }
 
-      auto param_slice = make_span(&params_[mb.start], mb.count);
-      kernels::KernelRequirements &req = kmgr_.Setup<Kernel>(mb_idx, ctx, mb.input, param_slice);
+      auto &kernel = kmgr_.Get<Kernel>(mb_idx);
+      kernel.balance_blocks = bucket_by_size_;
+      kernels::KernelRequirements &req =
+          kmgr_.Setup<Kernel>(mb_idx, ctx, mb.input, MinibatchParams(mb));
       mb.out_shape = req.output_shapes[0].to_static<frame_ndim>();
     }
   }
@@ -98,11 +110,30 @@ class ResizeOpImplGPU : public ResizeBase<GPUBackend>::Impl {
     for (size_t b = 0; b < minibatches_.size(); b++) {
       MiniBatch &mb = minibatches_[b];
 
-      kmgr_.Run<Kernel>(0, b, context,
-          mb.output, mb.input, make_span(params_.data() + mb.start, mb.count));
+      kmgr_.Run<Kernel>(0, b, context, mb.output, mb.input, MinibatchParams(mb));
     }
   }
 
+  /**
+   * @brief Calculates the order in which the frames are assigned to the minibatches
+   *
+   * When bucketing, the frames are sorted by decreasing output volume, so that each
+   * minibatch contains frames of similar size. The parameters are permuted accordingly.
+   */
+  void SortFrames() {
+    int n = in_shape_.num_samples();
+    frame_order_.resize(n);
+    std::iota(frame_order_.begin(), frame_order_.end(), 0);
+    if (!bucket_by_size_)
+      return;
+    std::stable_sort(frame_order_.begin(), frame_order_.end(), [&](int a, int b) {
+      return volume(out_shape_.tensor_shape_span(a)) > volume(out_shape_.tensor_shape_span(b));
+    });
+    sorted_params_.resize(n);
+    for (int i = 0; i < n; i++)
+      sorted_params_[i] = params_[frame_order_[i]];
+  }
+
   void SetNumFrames(int n) {
     int num_minibatches = CalculateMinibatchPartition(n, minibatch_size_);
     if (static_cast<int>(kmgr_.NumInstances()) < num_minibatches)
@@ -125,7 +156,8 @@ class ResizeOpImplGPU : public ResizeBase<GPUBackend>::Impl {
   }
 
   TensorListShape<frame_ndim> in_shape_, out_shape_;
-  std::vector<ResamplingParamsND<spatial_ndim>> params_;
+  std::vector<ResamplingParamsND<spatial_ndim>> params_, sorted_params_;
+  std::vector<int> frame_order_;
 
   kernels::KernelManager &kmgr_;
 
@@ -138,17 +170,42 @@ class ResizeOpImplGPU : public ResizeBase<GPUBackend>::Impl {
 
   std::vector<MiniBatch> minibatches_;
 
+  span<const ResamplingParamsND<spatial_ndim>> MinibatchParams(const MiniBatch &mb) const {
+    const auto &params = bucket_by_size_ ? sorted_params_ : params_;
+    return make_span(params.data() + mb.start, mb.count);
+  }
+
+  /**
+   * @brief Gathers the frames of a minibatch, as specified by `frame_order_`
+   */
+  template <typename T>
+  void GatherFrames(TensorListView<StorageGPU, T, frame_ndim> &mb_list,
+                    const TensorListView<StorageGPU, T, frame_ndim> &list,
+                    const MiniBatch &mb) const {
+    if (!bucket_by_size_) {
+      sample_range(mb_list, list, mb.start, mb.start + mb.count);
+      return;
+    }
+    mb_list.resize(mb.count);
+    for (int i = 0; i < mb.count; i++) {
+      int frame = frame_order_[mb.start + i];
+      mb_list.data[i] = list.data[frame];
+      mb_list.shape.set_tensor_shape(i, list.shape[frame]);
+    }
+  }
+
   void SubdivideInput(const kernels::InListGPU<In, frame_ndim> &in) {
     for (auto &mb : minibatches_)
-      sample_range(mb.input, in, mb.start, mb.start + mb.count);
+      GatherFrames(mb.input, in, mb);
   }
 
   void SubdivideOutput(const kernels::OutListGPU<Out, frame_ndim> &out) {
     for (auto &mb : minibatches_)
-      sample_range(mb.output, out, mb.start, mb.start + mb.count);
+      GatherFrames(mb.output, out, mb);
   }
 
   int minibatch_size_;
+  bool bucket_by_size_ = false;
 };
 
 }  // namespace dali
@@ -1,4 +1,4 @@
-// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2019, 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -21,10 +21,28 @@ namespace dali {
 
 template <>
 void ArithmeticGenericOp<CPUBackend>::RunImpl(HostWorkspace &ws) {
-  PrepareTilesForTasks<CPUBackend>(tiles_per_task_, exec_order_, tile_cover_, ws, constant_storage_,
-                                   spec_);
   auto &pool = ws.GetThreadPool();
   ws.OutputRef<CPUBackend>(0).SetLayout(result_layout_);
+  if (fused_) {
+    PrepareFusedTiles<CPUBackend>(fused_tiles_, fused_program_, fused_leaves_, tile_cover_, ws,
+                                  constant_storage_);
+    fused_scratch_.resize(pool.NumThreads());
+    for (auto &scratch : fused_scratch_)
+      scratch.resize(FusedExprScratchSize(fused_program_));
+    for (size_t task_idx = 0; task_idx < tile_range_.size(); task_idx++) {
+      pool.AddWork([this, task_idx](int thread_idx) {
+        auto range = tile_range_[task_idx];
+        auto *scratch = fused_scratch_[thread_idx].data();
+        for (int extent_idx = range.begin; extent_idx < range.end; extent_idx++) {
+          EvaluateFusedExprTile(fused_program_, fused_tiles_[extent_idx], scratch);
+        }
+      }, -task_idx);  // FIFO order, since the work is already divided to similarly sized chunks
+    }
+    pool.RunAll();
+    return;
+  }
+  PrepareTilesForTasks<CPUBackend>(tiles_per_task_, exec_order_, tile_cover_, ws, constant_storage_,
+                                   spec_);
   for (size_t task_idx = 0; task_idx < tile_range_.size(); task_idx++) {
     pool.AddWork([this, task_idx](int thread_idx) {
       auto range = tile_range_[task_idx];
@@ -71,6 +89,7 @@ Examples::
     .NumInput(1, 64)  // Some arbitrary number that needs to be validated in operator
     .AddOptionalArg("real_constants", "", std::vector<float>{}, true)
     .NumOutput(1)
+    .Deterministic()
     .MakeDocHidden();
 
 DALI_REGISTER_OPERATOR(ArithmeticGenericOp, ArithmeticGenericOp<CPUBackend>, CPU);
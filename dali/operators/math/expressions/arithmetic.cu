@@ -1,4 +1,4 @@
-// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2019, 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -19,10 +19,18 @@ namespace dali {
 
 template <>
 void ArithmeticGenericOp<GPUBackend>::RunImpl(DeviceWorkspace &ws) {
-  PrepareTilesForTasks<GPUBackend>(tiles_per_task_, exec_order_, tile_cover_, ws, constant_storage_,
-                                   spec_);
   ws.OutputRef<GPUBackend>(0).SetLayout(result_layout_);
   assert(tile_range_.size() == 1 && "Expected to cover whole GPU execution by 1 task");
+  if (fused_) {
+    PrepareFusedTiles<GPUBackend>(fused_tiles_, fused_program_, fused_leaves_, tile_cover_, ws,
+                                  constant_storage_);
+    fused_tiles_gpu_.Copy(fused_tiles_, ws.stream());
+    EvaluateFusedExprTiles(fused_program_, fused_tiles_gpu_.data<FusedExprTileDesc>(),
+                           fused_tiles_.size(), ws.stream());
+    return;
+  }
+  PrepareTilesForTasks<GPUBackend>(tiles_per_task_, exec_order_, tile_cover_, ws, constant_storage_,
+                                   spec_);
   for (size_t i = 0; i < exec_order_.size(); i++) {
     // call impl for whole batch
     exec_order_[i].impl->Execute(exec_order_[i].ctx, tiles_per_task_[i], tile_range_[0]);
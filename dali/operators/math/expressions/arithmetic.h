@@ -28,6 +28,7 @@
 #include "dali/core/tensor_shape_print.h"
 #include "dali/kernels/type_tag.h"
 #include "dali/operators/math/expressions/arithmetic_meta.h"
+#include "dali/operators/math/expressions/expression_fused.h"
 #include "dali/operators/math/expressions/expression_impl_factory.h"
 #include "dali/pipeline/operator/operator.h"
 
@@ -288,7 +289,11 @@ inline void CheckAllowedOperations(ExprNode &expr) {
  * @brief Arithmetic operator capable of executing expression tree of element-wise
  *        arithmetic operations.
  *
- * Only expressions consisting of one function node with tensor inputs are now supported.
+ * Expressions consisting of one function node with tensor inputs are executed with
+ * implementations specialized for the input types, see ExprImplFactory.
+ * More complex trees are flattened into a FusedExprProgram and evaluated in a single pass over
+ * the data - the intermediate results are kept in registers (GPU) or in small, cache-resident
+ * per-thread buffers (CPU), so they never travel to the main memory.
  *
  * There are 3 levels for unit of work.
  * - Thread (CPUBackend) or CUDA kernel invokation (GPUBackend)
@@ -331,8 +336,17 @@ class ArithmeticGenericOp : public Operator<Backend> {
     }
 
     result_shape_ = PropagateShapes<Backend>(*expr_, ws, curr_batch_size);
-    AllocateIntermediateNodes();
-    exec_order_ = CreateExecutionTasks<Backend>(*expr_, cache_, ws.has_stream() ? ws.stream() : 0);
+    fused_ = IsFusedExpression(*expr_);
+    if (fused_) {
+      // the program depends on which of the inputs are scalars, so it's rebuilt every time
+      fused_program_ = BuildFusedExprProgram(*expr_, fused_leaves_);
+      exec_order_.clear();
+    } else {
+      DALI_ENFORCE(expr_->GetNodeType() == NodeType::Function,
+                   "Only function nodes can be executed.");
+      exec_order_ =
+          CreateExecutionTasks<Backend>(*expr_, cache_, ws.has_stream() ? ws.stream() : 0);
+    }
 
     output_desc[0] = {result_shape_, result_type_id_};
     std::tie(tile_cover_, tile_range_) = GetTiledCover(result_shape_, kTileSize, kTaskSize);
@@ -343,22 +357,6 @@ class ArithmeticGenericOp : public Operator<Backend> {
   void RunImpl(workspace_t<Backend> &ws) override;
 
  private:
-  void AllocateIntermediateNodes() {
-    auto &expr = *expr_;
-    bool is_simple_expression = expr.GetNodeType() == NodeType::Function &&
-                                expr.GetSubexpressionCount() > 0 &&
-                                expr.GetSubexpressionCount() <= kMaxArity;
-    auto &func = dynamic_cast<ExprFunc &>(expr);
-    for (int i = 0; i < func.GetSubexpressionCount(); i++) {
-      is_simple_expression = is_simple_expression && func[i].GetNodeType() != NodeType::Function;
-    }
-
-    DALI_ENFORCE(is_simple_expression,
-                 "Complex expression trees are not yet supported. Only expressions containing one "
-                 "function node with one or two inputs are supported.");
-    // TODO(klecki): allocate memory for intermediate results and point the threads to them
-  }
-
   std::unique_ptr<ExprNode> expr_;
   TensorListShape<> result_shape_;
   bool types_layout_inferred_ = false;
@@ -370,6 +368,13 @@ class ArithmeticGenericOp : public Operator<Backend> {
   std::vector<std::vector<ExtendedTileDesc>> tiles_per_task_;
   ConstantStorage<Backend> constant_storage_;
   ExprImplCache cache_;
+  bool fused_ = false;
+  FusedExprProgram fused_program_;
+  std::vector<const ExprNode *> fused_leaves_;
+  std::vector<FusedExprTileDesc> fused_tiles_;
+  // CPU: per-thread buffers for the intermediate results, GPU: the tile descriptors
+  std::vector<std::vector<FusedExprRegister>> fused_scratch_;
+  Tensor<GPUBackend> fused_tiles_gpu_;
   // For CPU we limit the tile size to limit the sizes of intermediate buffers
   // For GPU it's better to execute more at one time.
   static constexpr int kTileSize =
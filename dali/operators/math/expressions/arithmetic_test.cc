@@ -470,6 +470,59 @@ TEST(ArithmeticOpsTest, ConstantsPipeline) {
   }
 }
 
+TEST(ArithmeticOpsTest, FusedTreePipeline) {
+  constexpr float magic_float = 0.5f;
+  constexpr int batch_size = 16;
+  constexpr int num_threads = 4;
+  constexpr int tensor_elements = 1000;
+  Pipeline pipe(batch_size, num_threads, 0);
+
+  pipe.AddExternalInput("data0");
+  pipe.AddExternalInput("data1");
+
+  for (std::string device : {"cpu", "gpu"}) {
+    pipe.AddOperator(OpSpec("ArithmeticGenericOp")
+                         .AddArg("device", device)
+                         .AddArg("expression_desc", "add(mul(sub(&0 &1) $0:float32) &0)")
+                         .AddArg("real_constants", std::vector<float>{magic_float})
+                         .AddInput("data0", device)
+                         .AddInput("data1", device)
+                         .AddOutput("result_" + device, device),
+                     "arithm_fused_" + device);
+  }
+
+  vector<std::pair<string, string>> outputs = {{"result_cpu", "cpu"}, {"result_gpu", "gpu"}};
+
+  pipe.Build(outputs);
+
+  TensorList<CPUBackend> batch0, batch1;
+  FillBatch<int>(batch0, uniform_list_shape(batch_size, {tensor_elements}));
+  FillBatch<int16_t>(batch1, uniform_list_shape(batch_size, {tensor_elements}));
+
+  pipe.SetExternalInput("data0", batch0);
+  pipe.SetExternalInput("data1", batch1);
+  pipe.RunCPU();
+  pipe.RunGPU();
+  DeviceWorkspace ws;
+  pipe.Outputs(&ws);
+
+  for (int sample_id = 0; sample_id < batch_size; sample_id++) {
+    const auto *data0 = batch0.tensor<int>(sample_id);
+    const auto *data1 = batch1.tensor<int16_t>(sample_id);
+    auto *result0 = ws.OutputRef<CPUBackend>(0).tensor<float>(sample_id);
+    auto *result1 = ws.OutputRef<GPUBackend>(1).tensor<float>(sample_id);
+    std::vector<float> result1_cpu(tensor_elements);
+    MemCopy(result1_cpu.data(), result1, tensor_elements * sizeof(float));
+    CUDA_CALL(cudaStreamSynchronize(0));
+
+    for (int i = 0; i < tensor_elements; i++) {
+      float ref = (data0[i] - data1[i]) * magic_float + data0[i];
+      EXPECT_EQ(result0[i], ref);
+      EXPECT_EQ(result1_cpu[i], ref);
+    }
+  }
+}
+
 using shape_sequence = std::vector<std::array<TensorListShape<>, 3>>;
 
 int GetBatchSize(const shape_sequence &seq) {
@@ -0,0 +1,458 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_MATH_EXPRESSIONS_EXPRESSION_FUSED_H_
+#define DALI_OPERATORS_MATH_EXPRESSIONS_EXPRESSION_FUSED_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "dali/core/format.h"
+#include "dali/core/host_dev.h"
+#include "dali/core/static_switch.h"
+#include "dali/operators/math/expressions/arithmetic_meta.h"
+#include "dali/operators/math/expressions/expression_impl_factory.h"
+#include "dali/operators/math/expressions/expression_tile.h"
+#include "dali/operators/math/expressions/expression_tree.h"
+#include "dali/pipeline/data/types.h"
+
+namespace dali {
+
+/**
+ * @brief Limits of the expression trees that can be evaluated in a single pass
+ */
+constexpr int kMaxFusedInstrs = 32;
+constexpr int kMaxFusedLeaves = 16;
+constexpr int kMaxFusedRegs = kMaxFusedLeaves + kMaxFusedInstrs;
+
+/**
+ * @brief Storage for one value of any of the types allowed in the arithmetic expressions
+ */
+struct alignas(8) FusedExprRegister {
+  char data[8];
+};
+
+/**
+ * @brief One step of the evaluation of a flattened expression tree
+ *
+ * `Convert` casts the value in the register `args[0]` from `arg_types[0]` to `out_type`,
+ * `Apply` calculates `op` on the registers `args`, which are already of `arg_types`.
+ * The result is stored in the register `out`.
+ */
+struct FusedExprInstr {
+  enum Kind : uint8_t { Convert, Apply };
+  Kind kind;
+  int8_t num_args;
+  int8_t args[kMaxArity];
+  int8_t out;
+  ArithmeticOp op;
+  DALIDataType arg_types[kMaxArity];
+  DALIDataType out_type;
+};
+
+/**
+ * @brief An expression tree flattened into a sequence of instructions operating on registers
+ *
+ * The first `num_leaves` registers contain the inputs (tensors and constants) of
+ * the expression, the remaining ones - the intermediate results. The last instruction
+ * calculates the result of the whole expression and stores it in `out_reg`.
+ *
+ * The program is small enough to be passed to a CUDA kernel by value.
+ */
+struct FusedExprProgram {
+  FusedExprInstr instrs[kMaxFusedInstrs];
+  DALIDataType leaf_types[kMaxFusedLeaves];
+  int8_t leaf_type_sizes[kMaxFusedLeaves];
+  bool leaf_is_scalar[kMaxFusedLeaves];  ///< the leaf value is broadcast over the whole tile
+  int num_instrs = 0;
+  int num_leaves = 0;
+  int num_regs = 0;
+  int out_reg = -1;
+  DALIDataType out_type = DALI_NO_TYPE;
+  int out_type_size = 0;
+};
+
+/**
+ * @brief Describe tile with pointers to output and to the data of all the leaves
+ *        of a fused expression.
+ *
+ * The pointers to non-scalar leaves already include the tile offset.
+ */
+struct FusedExprTileDesc {
+  TileDesc desc;
+  OutputSamplePtr output;
+  InputSamplePtr leaves[kMaxFusedLeaves];
+};
+
+/**
+ * @brief Check if the expression needs to be evaluated as a fused tree, that is if any of
+ *        the inputs of the root function node is a function node itself.
+ */
+inline bool IsFusedExpression(const ExprNode &expr) {
+  if (expr.GetNodeType() != NodeType::Function)
+    return false;
+  auto &func = dynamic_cast<const ExprFunc &>(expr);
+  for (int i = 0; i < func.GetSubexpressionCount(); i++) {
+    if (func[i].GetNodeType() == NodeType::Function)
+      return true;
+  }
+  return false;
+}
+
+namespace fused_expr {
+
+/**
+ * @brief Calculate the types to which the arguments of `func` are converted before applying
+ *        the operation.
+ *
+ * The implementations in arithm_meta cast the arguments to the promoted type anyway,
+ * so doing it upfront doesn't change the results. The exception are the comparisons
+ * of a `uint64` with a signed integer - converting both to `int64` would lose the range
+ * of the unsigned argument, so only the signed one is widened and the mixed comparison is used.
+ */
+inline void GetArgTypes(ArithmeticOp op, const ExprFunc &func, DALIDataType *arg_types) {
+  int num_args = func.GetSubexpressionCount();
+  if (num_args == 1) {
+    arg_types[0] = func[0].GetTypeId();
+    return;
+  }
+  if (num_args == 3) {
+    for (int i = 0; i < num_args; i++)
+      arg_types[i] = func.GetTypeId();
+    return;
+  }
+  auto left = func[0].GetTypeId(), right = func[1].GetTypeId();
+  auto is_signed_int = [](DALIDataType t) {
+    return IsIntegral(t) && IsSigned(t);
+  };
+  if (IsComparison(op) && left != right &&
+      ((left == DALI_UINT64 && is_signed_int(right)) ||
+       (right == DALI_UINT64 && is_signed_int(left)))) {
+    arg_types[0] = left == DALI_UINT64 ? DALI_UINT64 : DALI_INT64;
+    arg_types[1] = right == DALI_UINT64 ? DALI_UINT64 : DALI_INT64;
+    return;
+  }
+  arg_types[0] = arg_types[1] = BinaryTypePromotion(left, right);
+}
+
+inline int LeafRegister(const ExprNode &node, const std::vector<const ExprNode *> &leaves) {
+  for (size_t i = 0; i < leaves.size(); i++) {
+    if (leaves[i] == &node)
+      return i;
+    if (node.GetNodeType() == NodeType::Tensor && leaves[i]->GetNodeType() == NodeType::Tensor &&
+        dynamic_cast<const ExprTensor &>(node).GetInputIndex() ==
+            dynamic_cast<const ExprTensor *>(leaves[i])->GetInputIndex())
+      return i;
+  }
+  assert(!"The leaf was not collected");
+  return -1;
+}
+
+inline void CollectLeaves(const ExprNode &node, std::vector<const ExprNode *> &leaves) {
+  if (node.GetNodeType() == NodeType::Function) {
+    auto &func = dynamic_cast<const ExprFunc &>(node);
+    for (int i = 0; i < func.GetSubexpressionCount(); i++)
+      CollectLeaves(func[i], leaves);
+    return;
+  }
+  // the inputs referenced more than once are loaded once
+  if (node.GetNodeType() == NodeType::Tensor) {
+    auto input_idx = dynamic_cast<const ExprTensor &>(node).GetInputIndex();
+    for (auto *leaf : leaves) {
+      if (leaf->GetNodeType() == NodeType::Tensor &&
+          dynamic_cast<const ExprTensor *>(leaf)->GetInputIndex() == input_idx)
+        return;
+    }
+  }
+  leaves.push_back(&node);
+}
+
+inline FusedExprInstr &AddInstr(FusedExprProgram &program, FusedExprInstr::Kind kind,
+                                DALIDataType out_type) {
+  DALI_ENFORCE(program.num_instrs < kMaxFusedInstrs && program.num_regs < kMaxFusedRegs,
+               make_string("The arithmetic expression is too complex, at most ", kMaxFusedInstrs,
+                           " operations and type conversions are supported."));
+  auto &instr = program.instrs[program.num_instrs++];
+  instr = {};
+  instr.kind = kind;
+  instr.out = program.num_regs++;
+  instr.out_type = out_type;
+  return instr;
+}
+
+/**
+ * @brief Emit the instructions calculating `node`, in post-order
+ *
+ * @return The register holding the value of `node`
+ */
+inline int Emit(FusedExprProgram &program, const ExprNode &node,
+                const std::vector<const ExprNode *> &leaves) {
+  if (node.GetNodeType() != NodeType::Function)
+    return LeafRegister(node, leaves);
+  auto &func = dynamic_cast<const ExprFunc &>(node);
+  auto op = NameToOp(func.GetFuncName());
+  int num_args = func.GetSubexpressionCount();
+  DALI_ENFORCE(0 < num_args && num_args <= kMaxArity,
+               "Only unary, binary and ternary expressions are supported");
+  int arg_regs[kMaxArity];
+  DALIDataType arg_types[kMaxArity];
+  for (int i = 0; i < num_args; i++)
+    arg_regs[i] = Emit(program, func[i], leaves);
+  GetArgTypes(op, func, arg_types);
+  for (int i = 0; i < num_args; i++) {
+    if (func[i].GetTypeId() == arg_types[i])
+      continue;
+    auto &convert = AddInstr(program, FusedExprInstr::Convert, arg_types[i]);
+    convert.num_args = 1;
+    convert.args[0] = arg_regs[i];
+    convert.arg_types[0] = func[i].GetTypeId();
+    arg_regs[i] = convert.out;
+  }
+  auto &apply = AddInstr(program, FusedExprInstr::Apply, func.GetTypeId());
+  apply.op = op;
+  apply.num_args = num_args;
+  for (int i = 0; i < num_args; i++) {
+    apply.args[i] = arg_regs[i];
+    apply.arg_types[i] = arg_types[i];
+  }
+  return apply.out;
+}
+
+}  // namespace fused_expr
+
+/**
+ * @brief Flatten the expression tree `expr` with inferred types and shapes into a program
+ *        evaluating it in a single pass over the data.
+ *
+ * @param leaves Output: the tensor and constant nodes, in the order of their registers
+ */
+inline FusedExprProgram BuildFusedExprProgram(const ExprNode &expr,
+                                              std::vector<const ExprNode *> &leaves) {
+  DALI_ENFORCE(expr.GetNodeType() == NodeType::Function, "Only function nodes can be executed.");
+  leaves.clear();
+  fused_expr::CollectLeaves(expr, leaves);
+  DALI_ENFORCE(static_cast<int>(leaves.size()) <= kMaxFusedLeaves,
+               make_string("The arithmetic expression is too complex, at most ", kMaxFusedLeaves,
+                           " distinct inputs and constants are supported."));
+  FusedExprProgram program;
+  program.num_leaves = leaves.size();
+  program.num_regs = leaves.size();
+  for (size_t i = 0; i < leaves.size(); i++) {
+    program.leaf_types[i] = leaves[i]->GetTypeId();
+    program.leaf_type_sizes[i] = TypeTable::GetTypeInfo(leaves[i]->GetTypeId()).size();
+    program.leaf_is_scalar[i] = IsScalarLike(*leaves[i]);
+  }
+  program.out_reg = fused_expr::Emit(program, expr, leaves);
+  program.out_type = expr.GetTypeId();
+  program.out_type_size = TypeTable::GetTypeInfo(expr.GetTypeId()).size();
+  return program;
+}
+
+/**
+ * @brief Prepare the descriptors of `tiles` for evaluation of the fused expression, filling
+ *        the pointers to the output and to the data of all the `leaves` of the expression.
+ */
+template <typename Backend>
+void PrepareFusedTiles(std::vector<FusedExprTileDesc> &fused_tiles,
+                       const FusedExprProgram &program, const std::vector<const ExprNode *> &leaves,
+                       const std::vector<TileDesc> &tiles, workspace_t<Backend> &ws,
+                       const ConstantStorage<Backend> &st) {
+  fused_tiles.resize(tiles.size());
+  for (size_t t = 0; t < tiles.size(); t++) {
+    const auto &tile = tiles[t];
+    auto &fused_tile = fused_tiles[t];
+    fused_tile.desc = tile;
+    int64_t tile_offset = tile.tile_size * tile.extent_idx;
+    fused_tile.output = static_cast<char *>(GetOutputSamplePointer(ws, 0, tile.sample_idx)) +
+                        tile_offset * program.out_type_size;
+    for (size_t l = 0; l < leaves.size(); l++) {
+      const auto &leaf = *leaves[l];
+      if (leaf.GetNodeType() == NodeType::Constant) {
+        const auto &constant = dynamic_cast<const ExprConstant &>(leaf);
+        fused_tile.leaves[l] = st.GetPointer(constant.GetConstIndex(), constant.GetTypeId());
+        continue;
+      }
+      const auto &tensor = dynamic_cast<const ExprTensor &>(leaf);
+      const auto *ptr = static_cast<const char *>(
+          GetInputSamplePointer(ws, tensor.GetInputIndex(), tile.sample_idx));
+      // no tile offset for scalars, the value is the same for the whole sample
+      fused_tile.leaves[l] =
+          program.leaf_is_scalar[l] ? ptr : ptr + tile_offset * program.leaf_type_sizes[l];
+    }
+  }
+}
+
+namespace fused_expr {
+
+template <typename T>
+struct mixed_sign_counterpart {
+  using type = T;
+};
+
+template <>
+struct mixed_sign_counterpart<uint64_t> {
+  using type = int64_t;
+};
+
+template <>
+struct mixed_sign_counterpart<int64_t> {
+  using type = uint64_t;
+};
+
+template <typename Out, typename In>
+DALI_HOST_DEV void ConvertValues(void *out, const void *in, int64_t n) {
+  auto *o = static_cast<Out *>(out);
+  auto *i0 = static_cast<const In *>(in);
+  for (int64_t i = 0; i < n; i++)
+    o[i] = static_cast<Out>(i0[i]);
+}
+
+template <typename Backend, ArithmeticOp op, int arity = GetOpArity(op)>
+struct Apply;
+
+template <typename Backend, ArithmeticOp op>
+struct Apply<Backend, op, 1> {
+  using meta_t = arithm_meta<op, Backend>;
+
+  template <typename T>
+  DALI_HOST_DEV static void Run(void *out, const void *const *in, const DALIDataType *, int64_t n) {
+    using Result = typename meta_t::template result_t<T>;
+    auto *o = static_cast<Result *>(out);
+    auto *i0 = static_cast<const T *>(in[0]);
+    for (int64_t i = 0; i < n; i++)
+      o[i] = meta_t::impl(i0[i]);
+  }
+};
+
+template <typename Backend, ArithmeticOp op>
+struct Apply<Backend, op, 2> {
+  using meta_t = arithm_meta<op, Backend>;
+
+  template <typename Left, typename Right>
+  DALI_HOST_DEV static void Run(void *out, const void *l, const void *r, int64_t n) {
+    using Result = typename meta_t::template result_t<Left, Right>;
+    auto *o = static_cast<Result *>(out);
+    auto *i0 = static_cast<const Left *>(l);
+    auto *i1 = static_cast<const Right *>(r);
+    for (int64_t i = 0; i < n; i++)
+      o[i] = meta_t::impl(i0[i], i1[i]);
+  }
+
+  template <typename T>
+  DALI_HOST_DEV static void Run(void *out, const void *const *in, const DALIDataType *arg_types,
+                                int64_t n) {
+    if (arg_types[1] == type2id<T>::value)
+      Run<T, T>(out, in[0], in[1], n);
+    else  // only the mixed sign comparisons have different argument types
+      Run<T, typename mixed_sign_counterpart<T>::type>(out, in[0], in[1], n);
+  }
+};
+
+template <typename Backend, ArithmeticOp op>
+struct Apply<Backend, op, 3> {
+  using meta_t = arithm_meta<op, Backend>;
+
+  template <typename T>
+  DALI_HOST_DEV static void Run(void *out, const void *const *in, const DALIDataType *, int64_t n) {
+    using Result = typename meta_t::template result_t<T, T, T>;
+    auto *o = static_cast<Result *>(out);
+    auto *i0 = static_cast<const T *>(in[0]);
+    auto *i1 = static_cast<const T *>(in[1]);
+    auto *i2 = static_cast<const T *>(in[2]);
+    for (int64_t i = 0; i < n; i++)
+      o[i] = meta_t::impl(i0[i], i1[i], i2[i]);
+  }
+};
+
+/**
+ * @brief Execute `instr` for `n` consecutive values in the registers `regs`
+ *
+ * The static switch over the operation and the argument type is done once per call,
+ * so the cost of the dispatch is amortized when the values are processed in chunks.
+ */
+template <typename Backend>
+DALI_HOST_DEV void ExecuteInstr(const FusedExprInstr &instr, void *const *regs, int64_t n) {
+  const void *in[kMaxArity] = {};
+  for (int i = 0; i < instr.num_args; i++)
+    in[i] = regs[instr.args[i]];
+  void *out = regs[instr.out];
+  if (instr.kind == FusedExprInstr::Convert) {
+    TYPE_SWITCH(instr.out_type, type2id, Out, ARITHMETIC_ALLOWED_TYPES, (
+      TYPE_SWITCH(instr.arg_types[0], type2id, In, ARITHMETIC_ALLOWED_TYPES, (
+        ConvertValues<Out, In>(out, in[0], n);
+      ), ());  // NOLINT(whitespace/parens)
+    ), ());  // NOLINT(whitespace/parens)
+    return;
+  }
+  switch (instr.num_args) {
+    case 1:
+      VALUE_SWITCH(instr.op, op_static, ALLOWED_UN_OPS, (
+        TYPE_SWITCH(instr.arg_types[0], type2id, T, ARITHMETIC_ALLOWED_TYPES, (
+          Apply<Backend, op_static>::template Run<T>(out, in, instr.arg_types, n);
+        ), ());  // NOLINT(whitespace/parens)
+      ), ());  // NOLINT(whitespace/parens)
+      break;
+    case 2:
+      VALUE_SWITCH(instr.op, op_static, ALLOWED_BIN_OPS, (
+        TYPE_SWITCH(instr.arg_types[0], type2id, T, ARITHMETIC_ALLOWED_TYPES, (
+          Apply<Backend, op_static>::template Run<T>(out, in, instr.arg_types, n);
+        ), ());  // NOLINT(whitespace/parens)
+      ), ());  // NOLINT(whitespace/parens)
+      break;
+    case 3:
+      VALUE_SWITCH(instr.op, op_static, ALLOWED_TERNARY_OPS, (
+        TYPE_SWITCH(instr.arg_types[0], type2id, T, ARITHMETIC_ALLOWED_TYPES, (
+          Apply<Backend, op_static>::template Run<T>(out, in, instr.arg_types, n);
+        ), ());  // NOLINT(whitespace/parens)
+      ), ());  // NOLINT(whitespace/parens)
+      break;
+    default:
+      break;
+  }
+}
+
+}  // namespace fused_expr
+
+/**
+ * @brief Evaluate the fused expression over the tile. CPU variant.
+ *
+ * The tile is processed in chunks small enough for the intermediate results to stay in
+ * the L1 cache, all the instructions are executed for one chunk before proceeding to the next.
+ *
+ * @param scratch Buffer of at least `FusedExprScratchSize(program)` registers, private to
+ *                the calling thread.
+ */
+void EvaluateFusedExprTile(const FusedExprProgram &program, const FusedExprTileDesc &tile,
+                           FusedExprRegister *scratch);
+
+/**
+ * @brief The number of registers required by EvaluateFusedExprTile
+ */
+int64_t FusedExprScratchSize(const FusedExprProgram &program);
+
+/**
+ * @brief Evaluate the fused expression over the tiles with a single kernel launch.
+ *        GPU variant.
+ *
+ * Each thread evaluates the whole expression for its elements - the intermediate results
+ * never leave the thread.
+ *
+ * @param tiles Tile descriptors in device-accessible memory
+ */
+void EvaluateFusedExprTiles(const FusedExprProgram &program, const FusedExprTileDesc *tiles,
+                            int num_tiles, cudaStream_t stream);
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_MATH_EXPRESSIONS_EXPRESSION_FUSED_H_
@@ -0,0 +1,69 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <algorithm>
+
+#include "dali/operators/math/expressions/expression_fused.h"
+
+namespace dali {
+
+namespace {
+
+// 256 elements per register keep the intermediate results of moderately complex expressions
+// within the L1 cache
+constexpr int kFusedChunkSize = 256;
+
+template <typename T>
+void FillValues(void *out, const void *value, int64_t n) {
+  std::fill_n(static_cast<T *>(out), n, *static_cast<const T *>(value));
+}
+
+}  // namespace
+
+int64_t FusedExprScratchSize(const FusedExprProgram &program) {
+  return static_cast<int64_t>(program.num_regs) * kFusedChunkSize;
+}
+
+void EvaluateFusedExprTile(const FusedExprProgram &program, const FusedExprTileDesc &tile,
+                           FusedExprRegister *scratch) {
+  void *regs[kMaxFusedRegs];
+  for (int r = 0; r < program.num_regs; r++)
+    regs[r] = scratch + r * kFusedChunkSize;
+
+  int64_t extent = tile.desc.extent_size;
+  // the scalars are broadcast once per tile
+  for (int l = 0; l < program.num_leaves; l++) {
+    if (!program.leaf_is_scalar[l])
+      continue;
+    TYPE_SWITCH(program.leaf_types[l], type2id, T, ARITHMETIC_ALLOWED_TYPES, (
+      FillValues<T>(regs[l], tile.leaves[l], std::min<int64_t>(extent, kFusedChunkSize));
+    ), DALI_FAIL(make_string("Unsupported type: ", program.leaf_types[l])););  // NOLINT
+  }
+
+  for (int64_t start = 0; start < extent; start += kFusedChunkSize) {
+    int64_t n = std::min<int64_t>(extent - start, kFusedChunkSize);
+    for (int l = 0; l < program.num_leaves; l++) {
+      if (!program.leaf_is_scalar[l]) {
+        regs[l] = const_cast<char *>(static_cast<const char *>(tile.leaves[l])) +
+                  start * program.leaf_type_sizes[l];
+      }
+    }
+    regs[program.out_reg] = static_cast<char *>(tile.output) + start * program.out_type_size;
+    for (int i = 0; i < program.num_instrs; i++)
+      fused_expr::ExecuteInstr<CPUBackend>(program.instrs[i], regs, n);
+  }
+}
+
+}  // namespace dali
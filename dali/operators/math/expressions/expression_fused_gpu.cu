@@ -0,0 +1,70 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "dali/core/cuda_error.h"
+#include "dali/operators/math/expressions/expression_fused.h"
+
+namespace dali {
+
+namespace {
+
+/**
+ * @brief Go over the tile and evaluate the whole expression for each element
+ */
+__global__ void EvaluateFusedExprKernel(const FusedExprProgram program,
+                                        const FusedExprTileDesc *tiles) {
+  const auto &tile = tiles[blockIdx.y];
+  FusedExprRegister values[kMaxFusedRegs];
+  void *regs[kMaxFusedRegs];
+  for (int r = 0; r < program.num_regs; r++)
+    regs[r] = &values[r];
+  for (int l = 0; l < program.num_leaves; l++) {
+    if (program.leaf_is_scalar[l])
+      regs[l] = const_cast<void *>(tile.leaves[l]);
+  }
+
+  int64_t extent = tile.desc.extent_size;
+  int64_t stride = static_cast<int64_t>(blockDim.x) * gridDim.x;
+  for (int64_t idx = static_cast<int64_t>(blockDim.x) * blockIdx.x + threadIdx.x; idx < extent;
+       idx += stride) {
+    for (int l = 0; l < program.num_leaves; l++) {
+      if (!program.leaf_is_scalar[l]) {
+        regs[l] = const_cast<char *>(static_cast<const char *>(tile.leaves[l])) +
+                  idx * program.leaf_type_sizes[l];
+      }
+    }
+    regs[program.out_reg] = static_cast<char *>(tile.output) + idx * program.out_type_size;
+    for (int i = 0; i < program.num_instrs; i++)
+      fused_expr::ExecuteInstr<GPUBackend>(program.instrs[i], regs, 1);
+  }
+}
+
+// Same launch configuration as in ExprImplGPUInvoke
+constexpr int kThreadNum = 256;
+constexpr int kBlocksX = 64;
+
+}  // namespace
+
+void EvaluateFusedExprTiles(const FusedExprProgram &program, const FusedExprTileDesc *tiles,
+                            int num_tiles, cudaStream_t stream) {
+  if (num_tiles == 0)
+    return;
+  dim3 grid(kBlocksX, num_tiles, 1);
+  dim3 block(kThreadNum, 1, 1);
+  EvaluateFusedExprKernel<<<grid, block, 0, stream>>>(program, tiles);
+  CUDA_CALL(cudaGetLastError());
+}
+
+}  // namespace dali
@@ -69,6 +69,7 @@ For color images, this example normalizes the 3 color channels separately, but a
 samples in the batch.)code")
   .NumInput(1)
   .NumOutput(1)
+  .Deterministic()
   .SupportVolumetric()
   .AllowSequences()
   .AddOptionalArg("batch", R"code(If set to True, the mean and standard deviation are calculated
@@ -117,7 +118,9 @@ This argument is ignored when an externally supplied standard deviation is used.
 
 When using integral types, use ``shift`` and ``scale`` to improve the usage of the output
 type's dynamic range. If ``dtype`` is an integral type, out of range values are clamped,
-and non-integer values are rounded to nearest integer.)code", DALI_FLOAT);
+and non-integer values are rounded to nearest integer.
+
+The GPU operator also supports ``FLOAT16`` and ``BFLOAT16`` outputs.)code", DALI_FLOAT);
 
 template <>
 class Normalize<CPUBackend> : public NormalizeBase<CPUBackend> {
@@ -31,6 +31,9 @@ namespace dali {
 
 #define DALI_NORMALIZE_INPUT_TYPES (int8_t, uint8_t, int16_t, uint16_t, int32_t, uint32_t, float)
 #define DALI_NORMALIZE_OUTPUT_TYPES DALI_NORMALIZE_INPUT_TYPES
+// The GPU kernel can write half-precision directly, saving a separate Cast pass
+#define DALI_NORMALIZE_GPU_OUTPUT_TYPES \
+  (int8_t, uint8_t, int16_t, uint16_t, int32_t, uint32_t, float, float16, bfloat16)
 
 template <typename Backend>
 class Normalize;
@@ -86,21 +89,50 @@ class NormalizeBase : public Operator<Backend> {
 
     SetupAxes(ws);
     TYPE_SWITCH(input_type_, type2id, InputType, DALI_NORMALIZE_INPUT_TYPES, (
-      TYPE_SWITCH(output_type_, type2id, OutputType, DALI_NORMALIZE_OUTPUT_TYPES, (
-        This().template SetupTyped<OutputType, InputType>(ws);
-      ), (DALI_FAIL(make_string("Normalize: unsupported output type: ", output_type_))))  // NOLINT
+      SetupOutputTyped<InputType>(ws);
     ), (DALI_FAIL(make_string("Normalize: unsupported input type: ", input_type_))));    // NOLINT
     return true;
   }
 
   void RunImpl(workspace_t<Backend> &ws) override {
     TYPE_SWITCH(input_type_, type2id, InputType, DALI_NORMALIZE_INPUT_TYPES, (
-      TYPE_SWITCH(output_type_, type2id, OutputType, DALI_NORMALIZE_OUTPUT_TYPES, (
-        This().template RunTyped<OutputType, InputType>(ws);
-      ), (DALI_FAIL("Normalize: ureachable code - Run without matching Setup?")))  // NOLINT
+      RunOutputTyped<InputType>(ws);
     ), (DALI_FAIL("Normalize: ureachable code - Run without matching Setup?")));   // NOLINT
   }
 
+  /**
+   * @brief Dispatches the output type; the CPU and GPU operators support different output types
+   *
+   * Only the overload matching the backend's workspace is ever instantiated.
+   */
+  template <typename InputType>
+  void SetupOutputTyped(const HostWorkspace &ws) {
+    TYPE_SWITCH(output_type_, type2id, OutputType, DALI_NORMALIZE_OUTPUT_TYPES, (
+      This().template SetupTyped<OutputType, InputType>(ws);
+    ), (DALI_FAIL(make_string("Normalize: unsupported output type: ", output_type_))));  // NOLINT
+  }
+
+  template <typename InputType>
+  void SetupOutputTyped(const DeviceWorkspace &ws) {
+    TYPE_SWITCH(output_type_, type2id, OutputType, DALI_NORMALIZE_GPU_OUTPUT_TYPES, (
+      This().template SetupTyped<OutputType, InputType>(ws);
+    ), (DALI_FAIL(make_string("Normalize: unsupported output type: ", output_type_))));  // NOLINT
+  }
+
+  template <typename InputType>
+  void RunOutputTyped(HostWorkspace &ws) {
+    TYPE_SWITCH(output_type_, type2id, OutputType, DALI_NORMALIZE_OUTPUT_TYPES, (
+      This().template RunTyped<OutputType, InputType>(ws);
+    ), (DALI_FAIL("Normalize: ureachable code - Run without matching Setup?")));  // NOLINT
+  }
+
+  template <typename InputType>
+  void RunOutputTyped(DeviceWorkspace &ws) {
+    TYPE_SWITCH(output_type_, type2id, OutputType, DALI_NORMALIZE_GPU_OUTPUT_TYPES, (
+      This().template RunTyped<OutputType, InputType>(ws);
+    ), (DALI_FAIL("Normalize: ureachable code - Run without matching Setup?")));  // NOLINT
+  }
+
 
   void UseAllAxes() {
     int dim = data_shape_.sample_dim();
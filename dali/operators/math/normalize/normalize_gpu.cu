@@ -51,6 +51,14 @@ class Normalize<GPUBackend> : public NormalizeBase<GPUBackend> {
     return stddev_kernel_.create_or_get<InvStdDevGPU<ParamType, InputType>>();
   }
 
+  template <typename ParamType, typename InputType>
+  MeanInvStdDevGPU<ParamType, InputType> &GetMeanInvStdDevKernel() {
+    return mean_stddev_kernel_.create_or_get<MeanInvStdDevGPU<ParamType, InputType>>();
+  }
+
+  /// Both statistics are calculated - in a single pass over the input
+  bool ShouldFuseMeanStdDev() const noexcept { return ShouldCalcMean() && ShouldCalcStdDev(); }
+
   template <typename OutputType, typename InputType>
   NormalizeGPU<OutputType, InputType> &GetNormalizeKernel() {
     return normalize_kernel_.create_or_get<NormalizeGPU<OutputType, InputType>>();
@@ -58,7 +66,7 @@ class Normalize<GPUBackend> : public NormalizeBase<GPUBackend> {
 
   TensorListView<StorageGPU, float> BroadcastMean(KernelContext &ctx, float value) const;
 
-  AnyKernelInstance mean_kernel_, stddev_kernel_, normalize_kernel_;
+  AnyKernelInstance mean_kernel_, stddev_kernel_, mean_stddev_kernel_, normalize_kernel_;
   ScratchpadAllocator alloc_;
 };
 
@@ -179,14 +187,18 @@ void Normalize<GPUBackend>::SetupTyped(const DeviceWorkspace &ws) {
   auto req = norm.Setup(ctx, data_shape_, make_span(axes_),
                         has_scalar_mean_, has_scalar_stddev_, scale_is_stddev);
 
-  if (ShouldCalcMean()) {
+  if (ShouldFuseMeanStdDev()) {
+    auto &mean_stddev = GetMeanInvStdDevKernel<float, InputType>();
+    auto mean_stddev_req = mean_stddev.Setup(ctx, data_shape_, make_span(axes_),
+                                             true, batch_norm_);
+    assert(mean_stddev_req.output_shapes[0] == param_shape_);
+    MaxInPlace(req.scratch_sizes, mean_stddev_req.scratch_sizes);
+  } else if (ShouldCalcMean()) {
     auto &mean = GetMeanKernel<float, InputType>();
     auto mean_req = mean.Setup(ctx, data_shape_, make_span(axes_), true, batch_norm_);
     assert(mean_req.output_shapes[0] == param_shape_);
     MaxInPlace(req.scratch_sizes, mean_req.scratch_sizes);
-  }
-
-  if (ShouldCalcStdDev()) {
+  } else if (ShouldCalcStdDev()) {
     auto &stddev = GetInvStdDevKernel<float, InputType>();
     auto stddev_req = stddev.Setup(ctx, data_shape_, make_span(axes_), true, batch_norm_);
     assert(stddev_req.output_shapes[0] == param_shape_);
@@ -239,7 +251,11 @@ void Normalize<GPUBackend>::RunTyped(DeviceWorkspace &ws) {
     stddev_gpu = scratch.AllocTensorList<mm::memory_kind::device, float>(param_shape_);
   }
 
-  if (ShouldCalcMean()) {
+  if (ShouldFuseMeanStdDev()) {
+    ScratchpadSnapshot snap(scratch);
+    auto &mean_stddev_kernel = GetMeanInvStdDevKernel<float, InputType>();
+    mean_stddev_kernel.Run(ctx, mean_gpu, stddev_gpu, in_view, degrees_of_freedom_, epsilon_);
+  } else if (ShouldCalcMean()) {
     // We can't just Clear() the scratchpad to reuse it, because temporary buffers are also
     // stored there - so let's make a snapshot of current allocation state and restore it
     // after the kernel Run is done.
@@ -250,7 +266,7 @@ void Normalize<GPUBackend>::RunTyped(DeviceWorkspace &ws) {
     kernels::copy(mean_gpu, mean_input_, stream);
   }
 
-  if (ShouldCalcStdDev()) {
+  if (ShouldCalcStdDev() && !ShouldFuseMeanStdDev()) {
     ScratchpadSnapshot snap(scratch);
     auto &stddev_kernel = GetInvStdDevKernel<float, InputType>();
     stddev_kernel.Run(ctx, stddev_gpu, in_view, mean_gpu, degrees_of_freedom_, epsilon_);
@@ -13,6 +13,11 @@
 // limitations under the License.
 
 
+#include <algorithm>
+#include <limits>
+#include <tuple>
+#include "dali/core/dynlink_cuda.h"
+#include "dali/core/util.h"
 #include "dali/operators/numba_function/numba_func.h"
 
 namespace dali {
@@ -45,6 +50,28 @@ output can be accessed by ``outs[1][0]``.
 
 If no setup function provided, the output shape and data type will be the same as the input.
 
+When ``device`` is set to ``"gpu"``, the run function is compiled with ``numba.cuda`` as a device
+function and launched as a CUDA kernel in the stream of the pipeline - the data never leaves the GPU.
+The kernel is launched with a grid of ``blocks_per_sample`` x ``batch_size`` blocks of
+``threads_per_block`` threads, so the run function is invoked by each thread of the blocks processing
+the sample and should divide the work among them, for example:
+
+.. code-block:: python
+
+    from numba import cuda
+
+    def run_fn(out0, in0):
+        flat_out = out0.reshape(out0.size)
+        flat_in = in0.reshape(in0.size)
+        start = cuda.blockIdx.x * cuda.blockDim.x + cuda.threadIdx.x
+        step = cuda.gridDim.x * cuda.blockDim.x
+        for i in range(start, flat_out.size, step):
+            flat_out[i] = 255 - flat_in[i]
+
+The GPU run function always works per-sample. The kernels are compiled once for each combination of
+the run function, the types and the numbers of dimensions and reused by the subsequent instances of
+the operator. The setup function, if provided, still runs on the CPU.
+
 .. note::
     This operator is experimental and its API might change without notice.
 
@@ -117,7 +144,16 @@ separately for each sample in the batch.
 When ``batch_processing`` is set to ``True``, the function processes the whole batch. It is necessary if the
 function has to perform cross-sample operations and may be beneficial if significant part of the work can
 be reused. For other use cases, specifying False and using per-sample processing function allows the operator
-to process samples in parallel.)code", false);
+to process samples in parallel.
+
+Not supported on the GPU.)code", false)
+  .AddOptionalArg("threads_per_block", R"code(The number of threads in a block processing a sample.
+
+Applies only to the GPU operator.)code", 256)
+  .AddOptionalArg("blocks_per_sample", R"code(The number of blocks processing a sample.
+
+If 0, it's chosen so that each thread of the blocks processing the largest output sample gets one
+element of it. Applies only to the GPU operator.)code", 0);
 
 DALI_SCHEMA(NumbaFuncImpl)
   .DocStr("")
@@ -136,13 +172,26 @@ DALI_SCHEMA(NumbaFuncImpl)
   .AddOptionalArg<int>("setup_fn", R"code(Address of setup function setting shapes for outputs.
 This function is invoked once per batch.)code", 0)
   .AddOptionalArg("batch_processing", R"code(Determines whether the function is invoked once per batch or
-separately for each sample in the batch.)code", false);
+separately for each sample in the batch.)code", false)
+  .AddOptionalArg("threads_per_block", R"code(The number of threads in a block processing a sample
+(GPU only).)code", 256)
+  .AddOptionalArg("blocks_per_sample", R"code(The number of blocks processing a sample (GPU only);
+0 means one thread per element of the largest output sample.)code", 0);
 
 template <typename Backend>
 NumbaFuncImpl<Backend>::NumbaFuncImpl(const OpSpec &spec) : Base(spec) {
   run_fn_ = spec.GetArgument<uint64_t>("run_fn");
   setup_fn_ = spec.GetArgument<uint64_t>("setup_fn");
   batch_processing_ = spec.GetArgument<bool>("batch_processing");
+  threads_per_block_ = spec.GetArgument<int>("threads_per_block");
+  blocks_per_sample_ = spec.GetArgument<int>("blocks_per_sample");
+  if (std::is_same<Backend, GPUBackend>::value) {
+    DALI_ENFORCE(!batch_processing_, "Batch processing is not supported by the GPU operator.");
+    DALI_ENFORCE(threads_per_block_ > 0 && threads_per_block_ <= 1024, make_string(
+      "`threads_per_block` must be between 1 and 1024. Got: ", threads_per_block_));
+    DALI_ENFORCE(blocks_per_sample_ >= 0, make_string(
+      "`blocks_per_sample` must not be negative. Got: ", blocks_per_sample_));
+  }
 
   out_types_ = spec.GetRepeatedArgument<DALIDataType>("out_types");
   DALI_ENFORCE(out_types_.size() <= 6,
@@ -176,9 +225,9 @@ NumbaFuncImpl<Backend>::NumbaFuncImpl(const OpSpec &spec) : Base(spec) {
   }
 }
 
-template <>
-bool NumbaFuncImpl<CPUBackend>::SetupImpl(std::vector<OutputDesc> &output_desc,
-    const workspace_t<CPUBackend> &ws) {
+template <typename Backend>
+bool NumbaFuncImpl<Backend>::SetupImpl(std::vector<OutputDesc> &output_desc,
+    const workspace_t<Backend> &ws) {
   int ninputs = ws.NumInput();
   int noutputs = out_types_.size();
   DALI_ENFORCE(in_types_.size() == static_cast<size_t>(ninputs), make_string(
@@ -189,7 +238,7 @@ bool NumbaFuncImpl<CPUBackend>::SetupImpl(std::vector<OutputDesc> &output_desc,
   output_desc.resize(out_types_.size());
   in_shapes_.resize(ninputs);
   for (int in_id = 0; in_id < ninputs; in_id++) {
-    auto& in = ws.InputRef<CPUBackend>(in_id);
+    auto& in = ws.template InputRef<Backend>(in_id);
     in_shapes_[in_id] = in.shape();
     DALI_ENFORCE(in_shapes_[in_id].sample_dim() == ins_ndim_[in_id], make_string(
       "Number of dimensions passed in `ins_ndim` at index ", in_id,
@@ -210,7 +259,7 @@ bool NumbaFuncImpl<CPUBackend>::SetupImpl(std::vector<OutputDesc> &output_desc,
 
   if (!setup_fn_) {
     for (int i = 0; i < noutputs; i++) {
-      const auto &in = ws.InputRef<CPUBackend>(i);
+      const auto &in = ws.template InputRef<Backend>(i);
       output_desc[i] = {in.shape(), in.type()};
     }
     return true;
@@ -315,7 +364,67 @@ void NumbaFuncImpl<CPUBackend>::RunImpl(workspace_t<CPUBackend> &ws) {
   tp.RunAll();
 }
 
+template <>
+void NumbaFuncImpl<GPUBackend>::RunImpl(workspace_t<GPUBackend> &ws) {
+  int N = ws.InputRef<GPUBackend>(0).shape().num_samples();
+  int noutputs = out_types_.size();
+  int ninputs = in_types_.size();
+  auto &out_shapes = setup_fn_ ? out_shapes_ : in_shapes_;
+
+  // the pointers and the shapes of the samples of all the outputs, followed by the inputs;
+  // the shapes are padded to the largest number of dimensions
+  int max_ndim = 1;
+  for (int ndim : outs_ndim_)
+    max_ndim = std::max(max_ndim, ndim);
+  for (int ndim : ins_ndim_)
+    max_ndim = std::max(max_ndim, ndim);
+  sample_ptrs_.resize((noutputs + ninputs) * N);
+  sample_shapes_.assign((noutputs + ninputs) * N * max_ndim, 0);
+  int64_t max_volume = 0;
+  for (int out_id = 0; out_id < noutputs; out_id++) {
+    auto &out = ws.OutputRef<GPUBackend>(out_id);
+    for (int i = 0; i < N; i++) {
+      sample_ptrs_[N * out_id + i] = reinterpret_cast<uint64_t>(out.raw_mutable_tensor(i));
+      auto shape = out_shapes[out_id].tensor_shape_span(i);
+      std::copy(shape.begin(), shape.end(), &sample_shapes_[(N * out_id + i) * max_ndim]);
+      max_volume = std::max(max_volume, out_shapes[out_id].tensor_size(i));
+    }
+  }
+  for (int in_id = 0; in_id < ninputs; in_id++) {
+    auto &in = ws.InputRef<GPUBackend>(in_id);
+    int slot = noutputs + in_id;
+    for (int i = 0; i < N; i++) {
+      sample_ptrs_[N * slot + i] = reinterpret_cast<uint64_t>(in.raw_tensor(i));
+      auto shape = in_shapes_[in_id].tensor_shape_span(i);
+      std::copy(shape.begin(), shape.end(), &sample_shapes_[(N * slot + i) * max_ndim]);
+    }
+  }
+  if (N == 0)
+    return;
+
+  scratch_alloc_.Reserve<mm::memory_kind::device>(
+      sample_ptrs_.size() * sizeof(uint64_t) + sample_shapes_.size() * sizeof(int64_t) + 64);
+  auto scratch = scratch_alloc_.GetScratchpad();
+  uint64_t *dev_ptrs;
+  int64_t *dev_shapes;
+  std::tie(dev_ptrs, dev_shapes) = scratch.ToContiguousGPU(ws.stream(), sample_ptrs_,
+                                                           sample_shapes_);
+
+  int64_t blocks = blocks_per_sample_;
+  if (blocks == 0)
+    blocks = std::max<int64_t>(1, div_ceil(max_volume, static_cast<uint64_t>(threads_per_block_)));
+  blocks = std::min<int64_t>(blocks, std::numeric_limits<int32_t>::max());
+  uint64_t ptrs_arg = reinterpret_cast<uint64_t>(dev_ptrs);
+  uint64_t shapes_arg = reinterpret_cast<uint64_t>(dev_shapes);
+  int32_t num_samples_arg = N;
+  int32_t max_ndim_arg = max_ndim;
+  void *args[] = { &ptrs_arg, &shapes_arg, &num_samples_arg, &max_ndim_arg };
+  CUDA_CALL(cuLaunchKernel(reinterpret_cast<CUfunction>(run_fn_), blocks, N, 1,
+                           threads_per_block_, 1, 1, 0, ws.stream(), args, nullptr));
+}
+
 DALI_REGISTER_OPERATOR(NumbaFuncImpl, NumbaFuncImpl<CPUBackend>, CPU);
+DALI_REGISTER_OPERATOR(NumbaFuncImpl, NumbaFuncImpl<GPUBackend>, GPU);
 
 }  // namespace dali
 
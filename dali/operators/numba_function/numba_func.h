@@ -17,6 +17,7 @@
 
 #include <vector>
 
+#include "dali/kernels/scratch.h"
 #include "dali/pipeline/operator/operator.h"
 
 namespace dali {
@@ -39,9 +40,12 @@ class NumbaFuncImpl : public Operator<Backend> {
  private:
   using NumbaPtr = uint64_t;
 
+  /// The address of the cfunc on the CPU or the CUfunction handle of the kernel on the GPU
   NumbaPtr run_fn_;
   NumbaPtr setup_fn_;
   bool batch_processing_;
+  int threads_per_block_;
+  int blocks_per_sample_;
   SmallVector<DALIDataType, 6> out_types_;
   SmallVector<DALIDataType, 6> in_types_;
   SmallVector<int, 6> outs_ndim_;
@@ -50,6 +54,10 @@ class NumbaFuncImpl : public Operator<Backend> {
   std::vector<uint64_t> input_shape_ptrs_;
   vector<TensorListShape<-1>> in_shapes_;
   vector<TensorListShape<-1>> out_shapes_;
+  // GPU only - the per-sample pointers and shapes passed to the kernel
+  std::vector<uint64_t> sample_ptrs_;
+  std::vector<int64_t> sample_shapes_;
+  kernels::ScratchpadAllocator scratch_alloc_;
 };
 
 
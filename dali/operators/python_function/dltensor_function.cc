@@ -50,6 +50,12 @@ tasks are finished in the operator call. The GPU code can be executed on the CUD
 by DALI, which can be obtained by calling the ``current_dali_stream()`` function. In this case,
 the ``synchronize_stream`` flag can be set to False.
 
+With ``stream_ordered`` set to True, the GPU operator passes the CUDA stream used by DALI to
+the function, which must issue all its device work to that stream (for example, by wrapping it in
+``cupy.cuda.ExternalStream`` or ``torch.cuda.ExternalStream``). Neither DALI nor the function need
+to synchronize then - the work of the function and the copy of its outputs are ordered in the stream
+with the rest of DALI's GPU work and the returned tensors are kept alive until the copy is done.
+
 .. warning::
   This operator is not compatible with TensorFlow integration.
 )code")
@@ -64,6 +70,13 @@ the ``synchronize_stream`` flag can be set to False.
 separately for every sample in the batch.
 
 If set to True, the function will receive its arguments as lists of DLPack tensors.)code", false)
+    .AddOptionalArg("stream_ordered",
+                    R"code(Passes the CUDA stream used by DALI to the function, as the ``stream``
+keyword argument, and doesn't synchronize the stream before the call.
+
+The stream is a ``CUDAStream`` object - its handle is available as the ``ptr`` attribute.
+The function must issue all its device work, including the computation of the returned tensors,
+to this stream. Applies only to the GPU operator.)code", false)
     .NumInput(0, 256)
     .AllowSequences()
     .SupportVolumetric()
@@ -17,9 +17,11 @@
 #include <dali/util/pybind.h>
 #include <pybind11/embed.h>
 #include <pybind11/stl.h>
+#include <deque>
 #include <vector>
 #include <utility>
 #include <string>
+#include "dali/core/cuda_event.h"
 #include "dali/pipeline/operator/operator.h"
 #include "dali/pipeline/util/copy_with_stride.h"
 
@@ -101,8 +103,16 @@ template <typename Workspace, typename Output>
 void CopyOutputData(Output& output, std::vector<DLMTensorPtr> &dl_tensors,
                     int batch_size, Workspace &workspace);
 
+/**
+ * @brief Copies the data returned by the function to the outputs
+ *
+ * @return the DLPack tensors that were copied - on the GPU, the copy is issued to the stream,
+ *         so they must stay alive until the copy is done
+ */
 template <typename Backend>
-void PrepareOutputs(workspace_t<Backend> &ws, const py::object &output_o, int batch_size) {
+std::vector<DLMTensorPtr> PrepareOutputs(workspace_t<Backend> &ws, const py::object &output_o,
+                                         int batch_size) {
+  std::vector<DLMTensorPtr> copied;
   py::tuple return_tuple = (py::tuple::check_(output_o)) ? output_o : py::make_tuple(output_o);
   for (Index idx = 0; idx < ws.NumOutput(); ++idx) {
     py::list dl_list = py::cast<py::list>(return_tuple[idx]);
@@ -112,11 +122,15 @@ void PrepareOutputs(workspace_t<Backend> &ws, const py::object &output_o, int ba
     tlist.set_type(DLToDALIType(dl_tensors[0]->dl_tensor.dtype));
     tlist.Resize(GetDLTensorListShape(dl_tensors));
     CopyOutputData(tlist, dl_tensors, batch_size, ws);
+    for (auto &t : dl_tensors)
+      copied.push_back(std::move(t));
   }
+  return copied;
 }
 
 template <typename Backend>
-void PrepareOutputsPerSample(workspace_t<Backend> &ws, const py::object &output_o, int batch_size) {
+std::vector<DLMTensorPtr> PrepareOutputsPerSample(workspace_t<Backend> &ws,
+                                                  const py::object &output_o, int batch_size) {
   py::list output = output_o;
   py::tuple output_tuple(ws.NumOutput());
   std::vector<py::list> output_lists(ws.NumOutput());
@@ -133,7 +147,7 @@ void PrepareOutputsPerSample(workspace_t<Backend> &ws, const py::object &output_
   for (Index idx = 0; idx < ws.NumOutput(); ++idx) {
     output_tuple[idx] = std::move(output_lists[idx]);
   }
-  PrepareOutputs<Backend>(ws, output_tuple, batch_size);
+  return PrepareOutputs<Backend>(ws, output_tuple, batch_size);
 }
 
 template <typename Backend>
@@ -160,6 +174,75 @@ class StreamSynchronizer<CPUBackend> {
   StreamSynchronizer(HostWorkspace &ws, bool synchronize) {}
 };
 
+template <typename Backend>
+class OutputKeeper;
+
+/**
+ * @brief Keeps the tensors returned by the function alive until their data, copied to
+ *        the outputs in the stream, is no longer needed
+ *
+ * Thanks to that, neither the function nor DALI have to synchronize after the call. The tensors
+ * are released by the subsequent iterations, once their copy is done. Their deleters may call
+ * into Python, so the GIL must be held by the caller.
+ */
+template <>
+class OutputKeeper<GPUBackend> {
+ public:
+  OutputKeeper() = default;
+  DISABLE_COPY_MOVE_ASSIGN(OutputKeeper);
+
+  void Keep(DeviceWorkspace &ws, std::vector<DLMTensorPtr> tensors) {
+    if (tensors.empty())
+      return;
+    CUDAEvent event;
+    if (free_events_.empty()) {
+      event = CUDAEvent::Create();
+    } else {
+      event = std::move(free_events_.back());
+      free_events_.pop_back();
+    }
+    CUDA_CALL(cudaEventRecord(event, ws.stream()));
+    pending_.push_back({std::move(event), std::move(tensors)});
+  }
+
+  /**
+   * @brief Releases the tensors, whose copy is done
+   */
+  void Collect() {
+    while (!pending_.empty()) {
+      auto status = cudaEventQuery(pending_.front().first);
+      if (status == cudaErrorNotReady)
+        break;
+      CUDA_CALL(status);
+      free_events_.push_back(std::move(pending_.front().first));
+      pending_.pop_front();
+    }
+  }
+
+  ~OutputKeeper() {
+    if (pending_.empty() || !Py_IsInitialized())
+      return;
+    for (auto &p : pending_)
+      cudaEventSynchronize(p.first);
+    py::gil_scoped_acquire interpreter_guard{};
+    pending_.clear();
+  }
+
+ private:
+  std::deque<std::pair<CUDAEvent, std::vector<DLMTensorPtr>>> pending_;
+  std::vector<CUDAEvent> free_events_;
+};
+
+/**
+ * @brief The copy on the CPU is synchronous - the tensors are released right away
+ */
+template <>
+class OutputKeeper<CPUBackend> {
+ public:
+  void Keep(HostWorkspace &ws, std::vector<DLMTensorPtr> tensors) {}
+  void Collect() {}
+};
+
 }  // namespace detail
 
 
@@ -192,6 +275,7 @@ class DLTensorPythonFunctionImpl : public Operator<Backend> {
     SetOutputLayouts(ws);
     std::lock_guard<std::mutex> operator_guard(operator_lock);
     py::gil_scoped_acquire interpreter_guard{};
+    output_keeper_.Collect();
     py::object output_o = py::none();
     auto curr_batch_size = GetCurrBatchSize(ws);
     try {
@@ -220,9 +304,10 @@ class DLTensorPythonFunctionImpl : public Operator<Backend> {
     }
     if (!output_o.is_none()) {
       if (batch_processing) {
-        detail::PrepareOutputs<Backend>(ws, output_o, curr_batch_size);
+        output_keeper_.Keep(ws, detail::PrepareOutputs<Backend>(ws, output_o, curr_batch_size));
       } else {
-        detail::PrepareOutputsPerSample<Backend>(ws, output_o, curr_batch_size);
+        output_keeper_.Keep(ws, detail::PrepareOutputsPerSample<Backend>(ws, output_o,
+                                                                         curr_batch_size));
       }
     } else {
       DALI_ENFORCE(ws.NumOutput() == 0, "Python function returned 0 outputs and "
@@ -246,6 +331,7 @@ class DLTensorPythonFunctionImpl : public Operator<Backend> {
   bool synchronize_stream_;
   bool batch_processing;
   std::vector<TensorLayout> output_layouts_;
+  detail::OutputKeeper<Backend> output_keeper_;
 
  private:
   int GetCurrBatchSize(workspace_t<Backend> &ws) {
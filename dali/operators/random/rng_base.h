@@ -18,6 +18,7 @@
 #include <random>
 #include <vector>
 #include "dali/core/convert.h"
+#include "dali/core/philox.h"
 #include "dali/pipeline/operator/operator.h"
 #include "dali/pipeline/util/batch_rng.h"
 #include "dali/core/static_switch.h"
@@ -106,7 +107,8 @@ class RNGBase : public Operator<Backend> {
   using Operator<Backend>::max_batch_size_;
 
   DALIDataType dtype_ = DALI_NO_TYPE;
-  BatchRNG<std::mt19937_64> rng_;
+  // Provides the per-sample keys of the counter-based generators, drawn once per iteration
+  BatchRNG<Philox4x32_10> rng_;
   TensorListShape<> shape_;
   RNGBaseFields<Backend, IsNoiseGen> backend_data_;
 };
@@ -115,7 +115,6 @@ void RNGBase<Backend, Impl, IsNoiseGen>::RunImplTyped(workspace_t<CPUBackend> &w
   auto &tp = ws.GetThreadPool();
   constexpr int64_t kThreshold = 1 << 18;
   constexpr int64_t kChunkSize = 1 << 16;
-  constexpr size_t kNumChunkSeeds = 16;
   int nsamples = output.shape().size();
   int ndim = output.shape().sample_dim();
 
@@ -139,6 +138,9 @@ void RNGBase<Backend, Impl, IsNoiseGen>::RunImplTyped(workspace_t<CPUBackend> &w
 
   DistGen<IsNoiseGen> dist_gen_;
   for (int sample_id = 0; sample_id < nsamples; ++sample_id) {
+    // The chunks are generated with counter-based generators keyed by the sample key and
+    // the chunk index, so they don't need any (costly) seeding and can run in any order.
+    uint64_t sample_key = rng_[sample_id].next64();
     auto sample_sz = out_shape.tensor_size(sample_id);
     int64_t total_p_count = sample_sz;
     int nchannels = -1;
@@ -167,26 +169,23 @@ void RNGBase<Backend, Impl, IsNoiseGen>::RunImplTyped(workspace_t<CPUBackend> &w
     if (total_p_count < kThreshold) {
       tp.AddWork(
         [=](int thread_id) {
+          Philox4x32_10 sample_rng(sample_key);
           auto dist = use_default_dist ? Dist() : dists[sample_id];
           if (independent_channels) {
-            dist_gen_.template gen<T>(out_span, in_span, dist, rng_[sample_id], 0, total_p_count);
+            dist_gen_.template gen<T>(out_span, in_span, dist, sample_rng, 0, total_p_count);
           } else {
-            dist_gen_.template gen_all_channels<T>(out_span, in_span, dist, rng_[sample_id], 0,
+            dist_gen_.template gen_all_channels<T>(out_span, in_span, dist, sample_rng, 0,
                                                    total_p_count, nchannels, c_stride, p_stride);
           }
         }, total_p_count);
     } else {
       int chunks = div_ceil(total_p_count, kChunkSize);
-      std::array<uint32_t, kNumChunkSeeds> seed;
       for (int c = 0; c < chunks; c++) {
         int64_t p_offset, p_count;
         std::tie(p_offset, p_count) = get_chunk<T>(total_p_count, c, chunks);
-        for (auto &s : seed)
-          s = rng_[sample_id]();
         tp.AddWork(
           [=](int thread_id) {
-            std::seed_seq seq(seed.begin(), seed.end());
-            std::mt19937_64 chunk_rng(seq);
+            Philox4x32_10 chunk_rng(sample_key, c);
             auto dist = use_default_dist ? Dist() : dists[sample_id];
             if (independent_channels) {
               dist_gen_.template gen<T>(out_span, in_span, dist, chunk_rng,
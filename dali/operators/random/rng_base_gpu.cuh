@@ -30,17 +30,31 @@ namespace {
 template <bool value>
 using bool_const = std::integral_constant<bool, value>;
 
+/**
+ * @brief Initializes the generator for the given element of a sample
+ *
+ * The generator is keyed by the seed of the sample (drawn per sample and iteration) and uses
+ * the element index as the subsequence, so the result doesn't depend on how the work is split
+ * between the blocks and threads, and no generator state needs to be kept in memory.
+ */
+__device__ __inline__ curandStatePhilox4_32_10_t *InitElementRNG(
+    curandStatePhilox4_32_10_t &state, const SampleDesc &sample, int64_t idx) {
+  curand_init(sample.seed, idx, 0, &state);
+  return &state;
+}
+
 template <typename T, typename Dist>
 __device__ __inline__ void Generate(const SampleDesc &sample,
                                     const BlockDesc &block,
                                     Dist& dist,
-                                    curandState* __restrict__ rng,
                                     bool_const<true>,     // is_noise_gen
                                     bool_const<true>) {   // is_per_channel
   auto out = static_cast<T*>(sample.output);
   auto in = static_cast<const T*>(sample.input);
   auto idx_end = block.p_offset + block.p_count;
   for (auto idx = block.p_offset + threadIdx.x; idx < idx_end; idx += blockDim.x) {
+    curandStatePhilox4_32_10_t rng_state;
+    auto *rng = InitElementRNG(rng_state, sample, idx);
     auto n = dist.Generate(in[idx], rng);
     dist.Apply(out[idx], in[idx], n);
   }
@@ -50,13 +64,14 @@ template <typename T, typename Dist>
 __device__ __inline__ void Generate(const SampleDesc &sample,
                                     const BlockDesc &block,
                                     Dist& dist,
-                                    curandState* __restrict__ rng,
                                     bool_const<true>,     // is_noise_gen
                                     bool_const<false>) {  // is_per_channel
   auto out = static_cast<T*>(sample.output);
   auto in = static_cast<const T*>(sample.input);
   auto idx_end = block.p_offset + block.p_count;
   for (auto idx = block.p_offset + threadIdx.x; idx < idx_end; idx += blockDim.x) {
+    curandStatePhilox4_32_10_t rng_state;
+    auto *rng = InitElementRNG(rng_state, sample, idx);
     int64_t pos = idx * sample.p_stride;
     // Implementations that generate noise once for all channels should not depend on the input
     // to generate the number.
@@ -71,12 +86,13 @@ template <typename T, typename Dist>
 __device__ __inline__ void Generate(const SampleDesc &sample,
                                     const BlockDesc &block,
                                     Dist& dist,
-                                    curandState* __restrict__ rng,
                                     bool_const<false>,     // is_noise_gen
                                     bool_const<true>) {    // is_per_channel
   auto out = static_cast<T*>(sample.output);
   auto idx_end = block.p_offset + block.p_count;
   for (auto idx = block.p_offset + threadIdx.x; idx < idx_end; idx += blockDim.x) {
+    curandStatePhilox4_32_10_t rng_state;
+    auto *rng = InitElementRNG(rng_state, sample, idx);
     auto n = dist.Generate(rng);
     out[idx] = ConvertSat<T>(n);
   }
@@ -86,12 +102,13 @@ template <typename T, typename Dist>
 __device__ __inline__ void Generate(const SampleDesc &sample,
                                     const BlockDesc &block,
                                     Dist& dist,
-                                    curandState* __restrict__ rng,
                                     bool_const<false>,      // is_noise_gen
                                     bool_const<false>) {    // is_per_channel
   auto out = static_cast<T*>(sample.output);
   auto idx_end = block.p_offset + block.p_count;
   for (auto idx = block.p_offset + threadIdx.x; idx < idx_end; idx += blockDim.x) {
+    curandStatePhilox4_32_10_t rng_state;
+    auto *rng = InitElementRNG(rng_state, sample, idx);
     int64_t pos = idx * sample.p_stride;
     auto n = dist.Generate(rng);
     for (int c = 0; c < sample.c_count; c++, pos += sample.c_stride) {
@@ -103,19 +120,14 @@ __device__ __inline__ void Generate(const SampleDesc &sample,
 template <typename T, typename Dist, bool DefaultDist, bool IsNoiseGen, bool IsPerChannel>
 __global__ void RNGKernel(SampleDesc* __restrict__ sample_descs,
                           BlockDesc* __restrict__ block_descs,
-                          curandState* __restrict__ states,
                           const Dist* __restrict__ dists, int nblocks) {
-  int block_size = blockDim.x * blockDim.y;
-  int local_tid = blockDim.x * threadIdx.y + threadIdx.x;
-  int64_t global_tid = blockIdx.y * block_size + local_tid;
-  auto rng = states + global_tid;
   int blk_stride = blockDim.y * gridDim.y;
   int blk = blockIdx.y * blockDim.y + threadIdx.y;
   for (; blk < nblocks; blk += blk_stride) {
     auto block = block_descs[blk];
     auto sample = sample_descs[block.sample_idx];
     Dist dist = DefaultDist ? Dist() : dists[block.sample_idx];
-    Generate<T, Dist>(sample, block, dist, rng,
+    Generate<T, Dist>(sample, block, dist,
                       bool_const<IsNoiseGen>(), bool_const<IsPerChannel>());
   }
 }
@@ -127,7 +139,6 @@ template <typename T, typename Dist>
 void RNGBase<Backend, Impl, IsNoiseGen>::RunImplTyped(workspace_t<GPUBackend> &ws) {
   static_assert(std::is_same<Backend, GPUBackend>::value, "Unexpected backend");
   auto &output = ws.template OutputRef<GPUBackend>(0);
-  auto rngs = backend_data_.randomizer_.states();
   int block_sz = backend_data_.block_size_;
   int max_nblocks = backend_data_.max_blocks_;
   int blockdesc_count = -1;
@@ -158,6 +169,8 @@ void RNGBase<Backend, Impl, IsNoiseGen>::RunImplTyped(workspace_t<GPUBackend> &w
   auto &samples_cpu = backend_data_.sample_descs_cpu_;
   auto &samples_gpu = backend_data_.sample_descs_gpu_;
   SetupSampleDescs(samples_cpu.data(), out_view, in_view, channel_dim);
+  for (int s = 0; s < nsamples; s++)
+    samples_cpu[s].seed = rng_[s].next64();
   samples_gpu.from_host(samples_cpu, ws.stream());
 
   auto &blocks_cpu = backend_data_.block_descs_cpu_;
@@ -198,7 +211,7 @@ void RNGBase<Backend, Impl, IsNoiseGen>::RunImplTyped(workspace_t<GPUBackend> &w
     VALUE_SWITCH(independent_channels ? 1 : 0, IsPerChannel, (false, true), (
       RNGKernel<T, Dist, DefaultDist, IsNoiseGen, IsPerChannel>
         <<<gridDim, blockDim, 0, ws.stream()>>>(samples_gpu, blocks_gpu,
-                                                rngs, dists, blockdesc_count);
+                                                dists, blockdesc_count);
     ), ());  // NOLINT
   ), ());  // NOLINT
   CUDA_CALL(cudaGetLastError());
@@ -28,6 +28,7 @@
 namespace dali {
 
 struct SampleDesc {
+  uint64_t seed;  // key of the counter-based generator for this sample and iteration
   void *output;
   const void* input;
   int64_t p_count;
@@ -50,8 +51,7 @@ struct RNGBaseFields<GPUBackend, IsNoiseGen> {
         max_blocks_(static_sample_size < 0 ?
                         1024 :
                         std::min<int64_t>(
-                            max_batch_size * div_ceil(static_sample_size, block_size_), 1024)),
-        randomizer_(seed, block_size_ * max_blocks_) {
+                            max_batch_size * div_ceil(static_sample_size, block_size_), 1024)) {
     sample_descs_cpu_.resize(max_batch_size);
     sample_descs_gpu_.resize(max_batch_size);
     block_descs_cpu_.resize(max_blocks_);
@@ -65,7 +65,6 @@ struct RNGBaseFields<GPUBackend, IsNoiseGen> {
 
   const int block_size_;
   const int max_blocks_;
-  curand_states randomizer_;
 
   std::vector<SampleDesc> sample_descs_cpu_;
   DeviceBuffer<SampleDesc> sample_descs_gpu_;
@@ -0,0 +1,143 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/reader/aligned_shard_reader_op.h"
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dali {
+
+bool AlignedShardReader::SetupImpl(std::vector<OutputDesc>& output_desc, const HostWorkspace& ws) {
+  DataReader<CPUBackend, std::vector<Tensor<CPUBackend>>>::SetupImpl(output_desc, ws);
+  int num_outputs = ws.NumOutput();
+  int num_samples = GetCurrBatchSize();
+
+  output_desc.resize(num_outputs);
+  for (int output_idx = 0; output_idx < num_outputs; output_idx++) {
+    // the missing components are empty, with a single dimension
+    int ndim = 1;
+    for (int data_idx = 0; data_idx < num_samples; data_idx++) {
+      auto& component = GetSample(data_idx)[output_idx];
+      if (component.shape().num_elements() > 0) {
+        ndim = component.shape().sample_dim();
+        output_desc[output_idx].type = component.type();
+        break;
+      }
+    }
+    output_desc[output_idx].shape = TensorListShape<>(num_samples, ndim);
+    for (int data_idx = 0; data_idx < num_samples; data_idx++) {
+      auto& component = GetSample(data_idx)[output_idx];
+      if (component.shape().num_elements() == 0) {
+        output_desc[output_idx].shape.set_tensor_shape(
+            data_idx, TensorShape<>(std::vector<int64_t>(ndim, 0)));
+        continue;
+      }
+      DALI_ENFORCE(component.shape().sample_dim() == ndim &&
+                       component.type() == output_desc[output_idx].type,
+                   make_string("The components of the output ", output_idx,
+                               " must have the same number of dimensions and type. \"",
+                               component.GetSourceInfo(), "\" has shape ", component.shape(),
+                               " and type ", component.type(), "."));
+      output_desc[output_idx].shape.set_tensor_shape(data_idx, component.shape());
+    }
+    if (output_desc[output_idx].type == DALI_NO_TYPE)
+      output_desc[output_idx].type = GetSample(0)[output_idx].type();
+  }
+  return true;
+}
+
+void AlignedShardReader::RunImpl(HostWorkspace& ws) {
+  int num_outputs = ws.NumOutput();
+  int num_samples = GetCurrBatchSize();
+
+  bool threaded = ws.GetThreadPool().NumThreads() > 1;
+
+  for (int output_idx = 0; output_idx < num_outputs; output_idx++) {
+    auto& output = ws.OutputRef<CPUBackend>(output_idx);
+    for (int data_idx = 0; data_idx < num_samples; data_idx++) {
+      auto& sample = GetSample(data_idx);
+      ThreadPool::Work copy_task = [output_idx = output_idx, data_idx = data_idx, &output,
+                                    &sample](int) {
+        output[data_idx].SetMeta(sample[output_idx].GetMeta());
+        std::memcpy(output[data_idx].raw_mutable_data(), sample[output_idx].raw_data(),
+                    sample[output_idx].nbytes());
+      };
+      if (threaded) {
+        ws.GetThreadPool().AddWork(std::move(copy_task), -data_idx);
+      } else {
+        copy_task(0);
+      }
+    }
+  }
+  if (threaded) {
+    ws.GetThreadPool().RunAll();
+  }
+}
+
+DALI_SCHEMA(experimental__readers__AlignedShard)
+    .DocStr(R"code(A reader for the aligned shards - the DALI container format designed for
+reading with ``O_DIRECT`` and GPUDirect Storage.
+
+A shard holds samples made of one or more components (e.g. an encoded image and its label),
+each identified by its type, like the extension of a file in a webdataset archive.
+Unlike in TFRecord, RecordIO or tar files, the data of every component starts at a multiple
+of 4 KiB and is not interleaved with any headers; the index of the samples is stored at the
+end of the shard, so no separate index file is needed.
+A component can also describe its data type and shape, so that e.g. the arrays are produced
+with their shapes, without decoding.
+
+The shards can be created from the webdataset archives, with the ``.npy`` files stored as arrays,
+using the dedicated script::
+
+    ``<path_to_dali>/tools/tar2shard.py <path_to_archive> <path_to_shard>``
+
+Every sample is read with a single request. By default, the shards are memory mapped;
+with ``use_o_direct``, the samples are read directly from the drive to the aligned buffers,
+bypassing the page cache, which is faster for the data sets much larger than the memory.)code")
+    .NumInput(0)
+    .OutputFn([](const OpSpec& spec) {
+      return spec.HasArgument("ext") ? spec.GetRepeatedArgument<std::string>("ext").size() : 0;
+    })
+    .AddArg("paths", R"code(The list of (one or more) paths to the shards.)code",
+            DALI_STRING_VEC)
+    .AddArg("ext", R"code(The component types for each of the outputs produced.
+
+The number of the type sets determines the number of outputs of the reader.
+The different types should be separated with a semicolon (';').
+When a sample has no component of any of the types, the output is an empty tensor.
+
+Example: "jpg;png")code",
+            DALI_STRING_VEC)
+    .AddOptionalArg("dtypes", R"code(Data types of the respective outputs.
+
+Used for the components which don't store their data type; the default is UINT8.
+The size of such components must be divisible by the size of the data type.)code",
+                    DALI_DATA_TYPE_VEC, nullptr)
+    .AddOptionalArg("use_o_direct",
+        R"code(If set to True, the shards are read with ``O_DIRECT``, bypassing the page cache.
+
+When the file system doesn't support it, the shards are read normally.)code", false)
+    .AddOptionalArg("shuffle_after_epoch",
+        R"code(If set to True, the reader shuffles the samples of all the shards after each
+epoch.
+
+``stick_to_shard`` and ``random_shuffle`` cannot be used when this argument is set to True.)code",
+        false)
+    .AddParent("LoaderBase");
+
+DALI_REGISTER_OPERATOR(experimental__readers__AlignedShard, AlignedShardReader, CPU);
+
+}  // namespace dali
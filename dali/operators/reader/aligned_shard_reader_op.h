@@ -0,0 +1,44 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_READER_ALIGNED_SHARD_READER_OP_H_
+#define DALI_OPERATORS_READER_ALIGNED_SHARD_READER_OP_H_
+
+#include <vector>
+#include "dali/operators/reader/loader/aligned_shard_loader.h"
+#include "dali/operators/reader/reader_op.h"
+#include "dali/pipeline/data/tensor.h"
+
+namespace dali {
+
+class DLL_PUBLIC AlignedShardReader : public DataReader<CPUBackend, vector<Tensor<CPUBackend>>> {
+ public:
+  explicit AlignedShardReader(const OpSpec& spec)
+      : DataReader<CPUBackend, vector<Tensor<CPUBackend>>>(spec) {
+    loader_ = InitLoader<AlignedShardLoader>(spec);
+  }
+
+  bool SetupImpl(std::vector<OutputDesc>& output_desc, const HostWorkspace&) override;
+  void RunImpl(HostWorkspace& ws) override;
+  bool CanInferOutputs() const override {
+    return true;
+  }
+
+ protected:
+  USE_READER_OPERATOR_MEMBERS(CPUBackend, vector<Tensor<CPUBackend>>);
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_READER_ALIGNED_SHARD_READER_OP_H_
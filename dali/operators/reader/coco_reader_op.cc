@@ -122,6 +122,13 @@ mutually exclusive with ``polygon_masks``.)code",
   .AddOptionalArg("skip_empty",
       R"code(If true, reader will skip samples with no object instances in them)code",
       false)
+  .AddOptionalArg("min_image_size",
+      R"code(If the width or the height of an image, in number of pixels, is lower than this value,
+the image is skipped.
+
+The size is taken from the annotations, so the images are filtered out before the dataset is
+shuffled and split between the shards, and are never read.)code",
+      0)
   .AddOptionalArg("size_threshold",
       R"code(If the width or the height, in number of pixels, of a bounding box that represents an
 instance of an object is lower than this value, the object will be ignored.)code",
@@ -64,6 +64,13 @@ The file names can contain spaces in the middle, but cannot contain trailing whi
 
 3. Use file names and labels provided as a list of strings and integers, respectively.
 
+4. Mix several data sets, given as ``file_roots`` or ``file_lists``.
+
+Each data set is read as in the modes 1 or 2 - with its own shuffling and sharding - and the data
+set of each sample is drawn at random, according to ``dataset_weights``. All the data sets
+are read by this operator, so they share its prefetching. The labels are the labels
+within each data set.
+
 As with other readers, the (file, label) pairs returned by this operator can be randomly shuffled
 and various sharding strategies can be applied. See documentation of this operator's arguments
 for details.
@@ -82,6 +89,24 @@ pair per line. The filenames are relative to the location of that file or to ``f
 if specified.
 
 This argument is mutually exclusive with ``files``.)", nullptr)
+  .AddOptionalArg<string>("file_list_cache_dir",
+      R"(Path to a directory where the list of the files found in ``file_root`` is stored.
+
+The stored list is used instead of traversing ``file_root`` again, as long as the modification
+times of ``file_root`` and its subdirectories don't change. The processes on one node,
+e.g. the ranks of a multi-GPU job, can share the directory, so that the tree is listed only
+once. Used only when the files are discovered by traversing ``file_root``.)", nullptr)
+  .AddOptionalArg<string>("shared_cache_name",
+      R"(Name of a shared memory cache of the encoded files, shared by the processes on one node.
+
+The processes which use the same name, e.g. the per-GPU pipelines of a multi-GPU job, read
+each file from the storage only once - whichever process reads it first, stores it in the cache
+and the others use the stored copy. The files are stored until the cache is full; nothing
+is evicted. The cache is removed when the last process using it is done.)", nullptr)
+  .AddOptionalArg("shared_cache_size",
+      R"(Size of the shared cache, in megabytes.
+
+Used only with ``shared_cache_name``, by the first process which opens the cache.)", 0)
 .AddOptionalArg("shuffle_after_epoch",
       R"(If set to True, the reader shuffles the entire dataset after each epoch.
 
@@ -94,10 +119,42 @@ When using ``files``, the labels are taken from ``labels`` argument or, if it wa
 contain indices at which given file appeared in the ``files`` list.
 
 This argument is mutually exclusive with ``file_list``.)", nullptr)
+  .AddOptionalArg<vector<string>>("file_roots",
+      R"(Directories of the data sets of a mixture, one per data set.
+
+Each directory is read as ``file_root`` would be. This argument is mutually exclusive with
+``file_root``, ``file_list``, ``files`` and ``file_lists``.)", nullptr)
+  .AddOptionalArg<vector<string>>("file_lists",
+      R"(File lists of the data sets of a mixture, one per data set.
+
+Each list is read as ``file_list`` would be. This argument is mutually exclusive with
+``file_root``, ``file_list``, ``files`` and ``file_roots``.)", nullptr)
+  .AddOptionalArg("dataset_weights",
+      R"(Sampling weights of the data sets given in ``file_roots`` or ``file_lists``.
+
+The weights don't need to sum up to 1. To change the weights between the epochs, pass
+the weights of the consecutive epochs one after another - the last epoch given keeps being
+used afterwards. An epoch is as many samples as the shard of all the data sets together.
+The data set of each sample is drawn with a generator seeded with ``seed``.
+
+If not given, all the data sets are sampled with equal probability.
+``pad_last_batch`` and ``skip_samples`` can't be used with a mixture.)",
+      std::vector<float>())
   .AddOptionalArg<vector<int>>("labels", R"(Labels accompanying contents of files listed in
 ``files`` argument.
 
 If not used, sequential 0-based indices are used as labels)", nullptr)
+  .AddOptionalArg<vector<int>>("exclude_labels", R"(Labels of the files that are skipped.
+
+The files are filtered out before the dataset is shuffled and split between the shards,
+so they are never read and don't count towards the epoch size.)", nullptr)
+  .AddOptionalArg<int64_t>("min_file_size", R"(Minimum size of a file, in bytes.
+
+Smaller files are skipped, like with ``exclude_labels``. The sizes are checked when
+the reader is built, without reading the files.)", 0)
+  .AddOptionalArg<int64_t>("max_file_size", R"(Maximum size of a file, in bytes.
+
+Larger files are skipped, like with ``exclude_labels``. A negative value means no limit.)", -1)
   .AddParent("LoaderBase");
 
 
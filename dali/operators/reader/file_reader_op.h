@@ -15,11 +15,13 @@
 #ifndef DALI_OPERATORS_READER_FILE_READER_OP_H_
 #define DALI_OPERATORS_READER_FILE_READER_OP_H_
 
+#include <memory>
 #include <utility>
 #include <string>
 #include <vector>
 #include "dali/operators/reader/reader_op.h"
 #include "dali/operators/reader/loader/file_label_loader.h"
+#include "dali/operators/reader/loader/mixture_loader.h"
 
 namespace dali {
 
@@ -28,7 +30,49 @@ class FileReader : public DataReader<CPUBackend, ImageLabelWrapper> {
   explicit FileReader(const OpSpec& spec)
     : DataReader<CPUBackend, ImageLabelWrapper>(spec) {
     bool shuffle_after_epoch = spec.GetArgument<bool>("shuffle_after_epoch");
-    loader_ = InitLoader<FileLabelLoader>(spec, shuffle_after_epoch);
+    std::vector<std::string> roots, lists;
+    bool has_roots = spec.TryGetRepeatedArgument(roots, "file_roots");
+    bool has_lists = spec.TryGetRepeatedArgument(lists, "file_lists");
+    if (!has_roots && !has_lists) {
+      loader_ = InitLoader<FileLabelLoader>(spec, shuffle_after_epoch);
+      return;
+    }
+
+    // A mixture of data sets: one loader per data set, all fed by this reader's prefetch thread
+    DALI_ENFORCE(has_roots + has_lists == 1,
+                 "The data sets can be given with ``file_roots`` or ``file_lists``, not both.");
+    DALI_ENFORCE(!spec.HasArgument("file_root") && !spec.HasArgument("file_list") &&
+                 !spec.HasArgument("files"),
+                 "``file_roots`` and ``file_lists`` can't be used together with ``file_root``, "
+                 "``file_list`` or ``files``.");
+    auto &paths = has_roots ? roots : lists;
+    std::vector<std::unique_ptr<Loader<CPUBackend, ImageLabelWrapper>>> loaders;
+    for (auto &path : paths) {
+      OpSpec dataset_spec = spec;
+      dataset_spec.SetArg(has_roots ? "file_root" : "file_list", path);
+      loaders.push_back(InitLoader<FileLabelLoader>(dataset_spec, shuffle_after_epoch));
+    }
+    loader_ = InitLoader<MixtureLoader<CPUBackend, ImageLabelWrapper>>(
+        spec, std::move(loaders), spec.GetRepeatedArgument<float>("dataset_weights"));
+  }
+
+  bool CanInferOutputs() const override {
+    return true;
+  }
+
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const HostWorkspace &ws) override {
+    // the samples are prefetched, so the outputs can be allocated as one contiguous batch
+    // and the samples copied straight to their slots in it
+    DataReader<CPUBackend, ImageLabelWrapper>::SetupImpl(output_desc, ws);
+    int batch_size = GetCurrBatchSize();
+    output_desc.resize(2);
+    output_desc[0].type = DALI_UINT8;
+    output_desc[0].shape.resize(batch_size, 1);
+    for (int i = 0; i < batch_size; i++)
+      output_desc[0].shape.set_tensor_shape(i, {GetSample(i).image.size()});
+    output_desc[1].type = DALI_INT32;
+    output_desc[1].shape = uniform_list_shape(batch_size, {1});
+    return true;
   }
 
   void RunImpl(SampleWorkspace &ws) override {
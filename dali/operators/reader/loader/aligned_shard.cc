@@ -0,0 +1,156 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include "dali/core/error_handling.h"
+#include "dali/core/format.h"
+#include "dali/operators/reader/loader/aligned_shard.h"
+
+namespace dali {
+namespace detail {
+namespace shard {
+
+namespace {
+
+/**
+ * @brief Reads the little-endian values from the index, checking its bounds
+ */
+class IndexReader {
+ public:
+  IndexReader(const uint8_t *data, size_t size, const std::string &path)
+      : data_(data), size_(size), path_(path) {}
+
+  template <typename T>
+  T Read() {
+    Check(sizeof(T));
+    uint64_t value = 0;
+    for (size_t i = 0; i < sizeof(T); i++)
+      value |= static_cast<uint64_t>(data_[pos_ + i]) << (8 * i);
+    pos_ += sizeof(T);
+    return static_cast<T>(value);
+  }
+
+  std::string ReadString() {
+    auto length = Read<uint32_t>();
+    Check(length);
+    std::string s(reinterpret_cast<const char *>(data_ + pos_), length);
+    pos_ += length;
+    return s;
+  }
+
+ private:
+  void Check(size_t n) {
+    DALI_ENFORCE(n <= size_ - pos_,
+                 make_string("Malformed index of the shard \"", path_, "\" - unexpected end at ",
+                             pos_, "."));
+  }
+
+  const uint8_t *data_;
+  size_t size_;
+  size_t pos_ = 0;
+  const std::string &path_;
+};
+
+}  // namespace
+
+ShardIndex ParseIndex(const uint8_t *data, size_t size, int64_t data_end,
+                      const std::string &path) {
+  IndexReader reader(data, size, path);
+  ShardIndex index;
+  auto num_types = reader.Read<uint32_t>();
+  for (uint32_t i = 0; i < num_types; i++)
+    index.types.push_back(reader.ReadString());
+
+  auto num_samples = reader.Read<uint64_t>();
+  // each sample takes at least 8 bytes of the index
+  DALI_ENFORCE(num_samples <= size / 8,
+               make_string("Malformed index of the shard \"", path, "\" - ", num_samples,
+                           " samples don't fit in ", size, " bytes."));
+  index.samples.resize(num_samples);
+  for (auto &sample : index.samples) {
+    sample.key = reader.ReadString();
+    auto num_components = reader.Read<uint32_t>();
+    DALI_ENFORCE(num_components <= size,
+                 make_string("Malformed index of the shard \"", path, "\" - sample \"",
+                             sample.key, "\" has ", num_components, " components."));
+    sample.components.resize(num_components);
+    for (auto &c : sample.components) {
+      c.type = reader.Read<uint32_t>();
+      c.offset = reader.Read<int64_t>();
+      c.size = reader.Read<int64_t>();
+      c.dtype = reader.ReadString();
+      auto ndim = reader.Read<int32_t>();
+      c.has_shape = ndim >= 0;
+      if (c.has_shape) {
+        DALI_ENFORCE(ndim <= 64 && !c.dtype.empty(),
+                     make_string("Malformed index of the shard \"", path, "\" - sample \"",
+                                 sample.key, "\" has an invalid shape."));
+        c.shape.resize(ndim);
+        for (int d = 0; d < ndim; d++)
+          c.shape[d] = reader.Read<int64_t>();
+      }
+      DALI_ENFORCE(c.type < index.types.size(),
+                   make_string("Malformed index of the shard \"", path, "\" - sample \"",
+                               sample.key, "\" has a component of an unknown type ", c.type,
+                               "."));
+      DALI_ENFORCE(c.offset >= 0 && c.size >= 0 && c.offset <= data_end - c.size,
+                   make_string("Malformed index of the shard \"", path, "\" - component \"",
+                               index.types[c.type], "\" of the sample \"", sample.key,
+                               "\" is outside of the data."));
+    }
+  }
+  return index;
+}
+
+ShardIndex ReadIndex(FileStream &file, const std::string &path) {
+  size_t file_size = file.Size();
+  DALI_ENFORCE(file_size >= kFooterSize,
+               make_string("\"", path, "\" is not a shard - it's too small."));
+  uint8_t footer[kFooterSize];
+  file.Seek(file_size - kFooterSize);
+  DALI_ENFORCE(file.Read(footer, kFooterSize) == kFooterSize,
+               make_string("Cannot read the footer of the shard \"", path, "\"."));
+  DALI_ENFORCE(std::memcmp(footer + kFooterSize - sizeof(kMagic), kMagic, sizeof(kMagic)) == 0,
+               make_string("\"", path, "\" is not a shard - the footer doesn't match."));
+
+  IndexReader reader(footer, kFooterSize, path);
+  auto index_offset = reader.Read<uint64_t>();
+  auto index_size = reader.Read<uint64_t>();
+  auto version = reader.Read<uint32_t>();
+  auto alignment = reader.Read<uint32_t>();
+  DALI_ENFORCE(version == kVersion,
+               make_string("Unsupported version ", version, " of the shard \"", path,
+                           "\". The supported version is ", kVersion, "."));
+  DALI_ENFORCE(alignment > 0 && (alignment & (alignment - 1)) == 0,
+               make_string("Malformed footer of the shard \"", path, "\" - alignment ",
+                           alignment, " is not a power of 2."));
+  DALI_ENFORCE(index_offset <= file_size - kFooterSize &&
+               index_size <= file_size - kFooterSize - index_offset,
+               make_string("Malformed footer of the shard \"", path,
+                           "\" - the index is outside of the file."));
+
+  std::vector<uint8_t> data(index_size);
+  file.Seek(index_offset);
+  DALI_ENFORCE(file.Read(data.data(), index_size) == index_size,
+               make_string("Cannot read the index of the shard \"", path, "\"."));
+  auto index = ParseIndex(data.data(), data.size(), index_offset, path);
+  index.alignment = alignment;
+  return index;
+}
+
+}  // namespace shard
+}  // namespace detail
+}  // namespace dali
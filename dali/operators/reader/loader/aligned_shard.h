@@ -0,0 +1,97 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_READER_LOADER_ALIGNED_SHARD_H_
+#define DALI_OPERATORS_READER_LOADER_ALIGNED_SHARD_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "dali/core/common.h"
+#include "dali/core/tensor_shape.h"
+#include "dali/util/file.h"
+
+namespace dali {
+namespace detail {
+namespace shard {
+
+/**
+ * The aligned shard is a container of samples, each made of one or more components
+ * (e.g. an encoded image and its label), laid out so that they can be read with O_DIRECT
+ * and cuFile without any copies:
+ *
+ *   [component data, padded to kAlignment] ... [index, padded to kAlignment] [footer]
+ *
+ * All the offsets are multiples of the alignment stored in the footer, so both the position
+ * and the length of every read (rounded up to the alignment) are aligned. The components
+ * of a sample are stored one after another, so a sample is a single contiguous read.
+ *
+ * The footer, the last kFooterSize bytes of the file, little-endian:
+ *   uint64 index_offset, uint64 index_size, uint32 version, uint32 alignment, char magic[8]
+ *
+ * The index, little-endian:
+ *   uint32 num_types, then for each type: uint32 length, the name (e.g. "jpg", "cls")
+ *   uint64 num_samples, then for each sample:
+ *     uint32 length, the key of the sample
+ *     uint32 num_components, then for each component:
+ *       uint32 type, uint64 offset, uint64 size,
+ *       uint32 length, the NumPy type string (e.g. "<f4"), or nothing for raw bytes
+ *       int32 ndim, -1 if the shape is not stored, then int64 shape[ndim]
+ */
+constexpr char kMagic[8] = {'D', 'A', 'L', 'I', 'S', 'H', 'R', 'D'};
+constexpr uint32_t kVersion = 1;
+constexpr size_t kAlignment = 4096;
+constexpr size_t kFooterSize = 32;
+
+struct ComponentDesc {
+  uint32_t type = 0;
+  int64_t offset = 0;
+  int64_t size = 0;
+  /// The NumPy type string, empty for the raw bytes
+  std::string dtype;
+  /// Valid only if has_shape is set
+  TensorShape<> shape;
+  bool has_shape = false;
+};
+
+struct SampleDesc {
+  std::string key;
+  std::vector<ComponentDesc> components;
+};
+
+struct ShardIndex {
+  std::vector<std::string> types;
+  std::vector<SampleDesc> samples;
+  size_t alignment = kAlignment;
+};
+
+/**
+ * @brief Parses the index stored in the shard
+ *
+ * @param path used in the error messages
+ * @param data_end the offset of the index - the components must end before it
+ */
+DLL_PUBLIC ShardIndex ParseIndex(const uint8_t *data, size_t size, int64_t data_end,
+                                 const std::string &path);
+
+/**
+ * @brief Reads the footer and the index of the shard
+ */
+DLL_PUBLIC ShardIndex ReadIndex(FileStream &file, const std::string &path);
+
+}  // namespace shard
+}  // namespace detail
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_READER_LOADER_ALIGNED_SHARD_H_
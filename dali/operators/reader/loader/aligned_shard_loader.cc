@@ -0,0 +1,247 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "dali/core/error_handling.h"
+#include "dali/operators/reader/loader/aligned_shard_loader.h"
+#include "dali/operators/reader/loader/numpy_loader.h"
+
+namespace dali {
+
+namespace {
+
+constexpr char kExtDelim = ';';
+
+int OpenDirect(const std::string &path) {
+  int fd = open(path.c_str(), O_RDONLY | O_DIRECT);
+  if (fd < 0 && errno == EINVAL) {
+    // e.g. tmpfs doesn't support O_DIRECT
+    DALI_WARN(make_string("The file system of \"", path, "\" doesn't support O_DIRECT. "
+                          "The shard is read through the page cache."));
+    fd = open(path.c_str(), O_RDONLY);
+  }
+  DALI_ENFORCE(fd >= 0, make_string("Cannot open the shard \"", path, "\": ",
+                                    std::strerror(errno)));
+  return fd;
+}
+
+}  // namespace
+
+AlignedShardLoader::AlignedShardLoader(const OpSpec &spec)
+    : Loader(spec),
+      paths_(spec.GetRepeatedArgument<std::string>("paths")),
+      use_o_direct_(spec.GetArgument<bool>("use_o_direct")),
+      shuffle_after_epoch_(spec.GetArgument<bool>("shuffle_after_epoch")) {
+  DALI_ENFORCE(paths_.size() > 0, "No shards provided");
+
+  for (auto &exts : spec.GetRepeatedArgument<std::string>("ext")) {
+    std::stringstream exts_stream(exts);
+    std::string ext;
+    ext_.emplace_back();
+    while (std::getline(exts_stream, ext, kExtDelim))
+      ext_.back().insert(ext);
+  }
+
+  dtypes_ = spec.HasArgument("dtypes") ? spec.GetRepeatedArgument<DALIDataType>("dtypes")
+                                       : std::vector<DALIDataType>(ext_.size(), DALI_UINT8);
+  DALI_ENFORCE(ext_.size() == dtypes_.size(),
+               "Number of extensions does not match the number of provided types");
+
+  DALI_ENFORCE(!(shuffle_after_epoch_ && stick_to_shard_),
+               "shuffle_after_epoch and stick_to_shard cannot be both true");
+  DALI_ENFORCE(!(shuffle_after_epoch_ && shuffle_),
+               "shuffle_after_epoch and random_shuffle cannot be both true");
+  if (shuffle_after_epoch_)
+    stick_to_shard_ = true;
+}
+
+AlignedShardLoader::~AlignedShardLoader() {
+  for (int fd : fds_)
+    close(fd);
+}
+
+void AlignedShardLoader::PrepareEmpty(vector<Tensor<CPUBackend>> &empty) {
+  empty = std::vector<Tensor<CPUBackend>>(ext_.size());
+  for (size_t output = 0; output < ext_.size(); output++) {
+    empty[output].set_pinned(false);
+    empty[output].reserve(tensor_init_bytes_);
+    empty[output].set_type(dtypes_[output]);
+  }
+}
+
+shared_ptr<void> AlignedShardLoader::ReadRange(int shard, int64_t begin, int64_t end) {
+  if (use_o_direct_) {
+    // both the position and the length of the read must be aligned
+    constexpr int64_t alignment = detail::shard::kAlignment;
+    int64_t aligned_begin = begin & ~(alignment - 1);
+    int64_t aligned_end = (end + alignment - 1) & ~(alignment - 1);
+    size_t size = aligned_end - aligned_begin;
+    void *buffer = nullptr;
+    DALI_ENFORCE(posix_memalign(&buffer, alignment, std::max<size_t>(size, 1)) == 0,
+                 make_string("Cannot allocate ", size, " bytes for reading the shard."));
+    shared_ptr<uint8_t> data(static_cast<uint8_t *>(buffer), free);
+    // the aligned end may be past the end of the file
+    size_t read = 0;
+    while (read < size) {
+      auto n = pread(fds_[shard], data.get() + read, size - read, aligned_begin + read);
+      if (n < 0 && errno == EINTR)
+        continue;
+      DALI_ENFORCE(n >= 0, make_string("Error reading from the shard \"", paths_[shard], "\": ",
+                                       std::strerror(errno)));
+      if (n == 0)
+        break;
+      read += n;
+    }
+    DALI_ENFORCE(static_cast<int64_t>(read) >= end - aligned_begin,
+                 make_string("Error reading from the shard \"", paths_[shard],
+                             "\" - unexpected end of the file."));
+    return shared_ptr<void>(data, data.get() + (begin - aligned_begin));
+  }
+
+  auto &stream = streams_[shard];
+  size_t size = end - begin;
+  stream->Seek(begin);
+  if (!copy_read_data_)
+    return stream->Get(size);
+  shared_ptr<uint8_t> data(new uint8_t[std::max<size_t>(size, 1)],
+                           std::default_delete<uint8_t[]>());
+  DALI_ENFORCE(stream->Read(data.get(), size) == size,
+               "Error reading from a file " + paths_[shard]);
+  return data;
+}
+
+void AlignedShardLoader::ReadSample(vector<Tensor<CPUBackend>> &sample) {
+  MoveToNextShard(sample_index_);
+  int shard = samples_[sample_index_].first;
+  const auto &desc = shards_[shard].samples[samples_[sample_index_].second];
+  const auto &outputs = type_outputs_[shard];
+  sample_index_++;
+
+  DALIMeta meta;
+  meta.SetSourceInfo(make_string(paths_[shard], ":", desc.key));
+  std::vector<bool> filled(ext_.size(), false);
+
+  if (ShouldSkipImage(meta.GetSourceInfo())) {
+    meta.SetSkipSample(true);
+  } else {
+    // the components are read together
+    int64_t begin = std::numeric_limits<int64_t>::max(), end = 0;
+    for (auto &c : desc.components) {
+      if (outputs[c.type] >= 0) {
+        begin = std::min(begin, c.offset);
+        end = std::max(end, c.offset + c.size);
+      }
+    }
+    shared_ptr<void> data;
+    if (begin < end)
+      data = ReadRange(shard, begin, end);
+
+    for (auto &c : desc.components) {
+      int output = outputs[c.type];
+      if (output < 0 || filled[output])
+        continue;
+      DALIDataType type = dtypes_[output];
+      TensorShape<> shape;
+      if (!c.dtype.empty()) {
+        DALI_ENFORCE(c.dtype[0] != '>',
+                     make_string("Big-endian data of \"", meta.GetSourceInfo(),
+                                 "\" is not supported."));
+        type = TypeFromNumpyStr(c.dtype.substr(1)).id();
+      }
+      if (c.has_shape)
+        shape = c.shape;
+      else
+        shape = {c.size / static_cast<int64_t>(TypeTable::GetTypeInfo(type).size())};
+      DALI_ENFORCE(volume(shape) * TypeTable::GetTypeInfo(type).size() ==
+                       static_cast<size_t>(c.size),
+                   make_string("The size of the component \"", shards_[shard].types[c.type],
+                               "\" of \"", meta.GetSourceInfo(), "\" (", c.size,
+                               " bytes) doesn't match its type ", type, " and shape ", shape,
+                               "."));
+      auto *ptr = data ? static_cast<uint8_t *>(data.get()) + (c.offset - begin) : nullptr;
+      sample[output].ShareData(shared_ptr<void>(data, ptr), c.size, shape, type);
+      sample[output].SetMeta(meta);
+      filled[output] = true;
+    }
+  }
+
+  for (size_t output = 0; output < ext_.size(); output++) {
+    if (!filled[output]) {
+      sample[output].Reset();
+      sample[output].SetMeta(meta);
+      sample[output].Resize({0}, dtypes_[output]);
+    }
+  }
+}
+
+Index AlignedShardLoader::SizeImpl() {
+  return samples_.size();
+}
+
+void AlignedShardLoader::PrepareMetadataImpl() {
+  if (use_o_direct_) {
+    for (auto &path : paths_)
+      fds_.push_back(OpenDirect(path));
+  } else {
+    if (!dont_use_mmap_)
+      mmap_reserver_ = FileStream::MappingReserver(static_cast<unsigned int>(paths_.size()));
+    copy_read_data_ = dont_use_mmap_ || !mmap_reserver_.CanShareMappedData();
+    for (auto &path : paths_)
+      streams_.emplace_back(FileStream::Open(path, read_ahead_, !copy_read_data_));
+  }
+
+  for (size_t shard = 0; shard < paths_.size(); shard++) {
+    if (use_o_direct_) {
+      auto stream = FileStream::Open(paths_[shard], false, false);
+      shards_.push_back(detail::shard::ReadIndex(*stream, paths_[shard]));
+    } else {
+      shards_.push_back(detail::shard::ReadIndex(*streams_[shard], paths_[shard]));
+    }
+
+    const auto &types = shards_.back().types;
+    type_outputs_.emplace_back(types.size(), -1);
+    for (size_t t = 0; t < types.size(); t++) {
+      for (size_t output = 0; output < ext_.size(); output++) {
+        if (ext_[output].count(types[t])) {
+          type_outputs_.back()[t] = output;
+          break;
+        }
+      }
+    }
+    for (size_t i = 0; i < shards_.back().samples.size(); i++)
+      samples_.emplace_back(shard, i);
+  }
+  DALI_ENFORCE(!samples_.empty(), "No samples found in the shards");
+  Reset(true);
+}
+
+void AlignedShardLoader::Reset(bool wrap_to_shard) {
+  sample_index_ = wrap_to_shard ? start_index(shard_id_, num_shards_, samples_.size()) : 0;
+  current_epoch_++;
+
+  if (shuffle_after_epoch_)
+    ShuffleAfterEpoch(samples_, current_epoch_);
+}
+
+}  // namespace dali
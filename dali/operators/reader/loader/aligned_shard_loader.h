@@ -0,0 +1,76 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_READER_LOADER_ALIGNED_SHARD_LOADER_H_
+#define DALI_OPERATORS_READER_LOADER_ALIGNED_SHARD_LOADER_H_
+
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include "dali/operators/reader/loader/aligned_shard.h"
+#include "dali/operators/reader/loader/loader.h"
+#include "dali/pipeline/data/tensor.h"
+#include "dali/util/file.h"
+
+namespace dali {
+
+/**
+ * @brief Reads the samples of the aligned shards, see detail::shard
+ *
+ * A sample is read with a single request - either mapped, or read with O_DIRECT to an aligned
+ * buffer, bypassing the page cache. The components are shared with the outputs without copying.
+ */
+class DLL_PUBLIC AlignedShardLoader : public Loader<CPUBackend, vector<Tensor<CPUBackend>>> {
+ public:
+  explicit AlignedShardLoader(const OpSpec& spec);
+  ~AlignedShardLoader() override;
+
+  void PrepareEmpty(std::vector<Tensor<CPUBackend>>&) override;
+  void ReadSample(std::vector<Tensor<CPUBackend>>&) override;
+
+ protected:
+  Index SizeImpl() override;
+  void PrepareMetadataImpl() override;
+  void Reset(bool wrap_to_shard) override;
+
+ private:
+  /// Reads the bytes [begin, end) of the shard
+  shared_ptr<void> ReadRange(int shard, int64_t begin, int64_t end);
+
+  std::vector<std::string> paths_;
+  std::vector<std::set<std::string>> ext_;
+  std::vector<DALIDataType> dtypes_;
+  bool use_o_direct_ = false;
+  bool shuffle_after_epoch_ = false;
+
+  std::vector<detail::shard::ShardIndex> shards_;
+  /// For each shard, the output of each type, or -1
+  std::vector<std::vector<int>> type_outputs_;
+  /// The shard and the sample in it
+  std::vector<std::pair<int, int>> samples_;
+
+  std::vector<std::unique_ptr<FileStream>> streams_;
+  /// Used with O_DIRECT instead of the streams
+  std::vector<int> fds_;
+  FileStream::MappingReserver mmap_reserver_;
+
+  size_t sample_index_ = 0;
+  int current_epoch_ = 0;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_READER_LOADER_ALIGNED_SHARD_LOADER_H_
@@ -0,0 +1,187 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include "dali/operators/reader/loader/aligned_shard.h"
+
+namespace dali {
+namespace detail {
+namespace shard {
+
+namespace {
+
+class MemoryStream : public FileStream {
+ public:
+  explicit MemoryStream(const std::vector<uint8_t> &data) : FileStream(""), data_(data) {}
+
+  void Close() override {}
+
+  size_t Read(uint8_t *buffer, size_t n_bytes) override {
+    n_bytes = std::min(n_bytes, data_.size() - pos_);
+    std::memcpy(buffer, data_.data() + pos_, n_bytes);
+    pos_ += n_bytes;
+    return n_bytes;
+  }
+
+  shared_ptr<void> Get(size_t n_bytes) override {
+    return nullptr;
+  }
+
+  void Seek(int64 pos) override {
+    pos_ = pos;
+  }
+
+  int64 Tell() const override {
+    return pos_;
+  }
+
+  size_t Size() const override {
+    return data_.size();
+  }
+
+ private:
+  const std::vector<uint8_t> &data_;
+  size_t pos_ = 0;
+};
+
+class ShardWriter {
+ public:
+  template <typename T>
+  void Write(std::vector<uint8_t> &out, T value) {
+    for (size_t i = 0; i < sizeof(T); i++)
+      out.push_back(static_cast<uint64_t>(value) >> (8 * i));
+  }
+
+  void Write(std::vector<uint8_t> &out, const std::string &s) {
+    Write<uint32_t>(out, s.size());
+    out.insert(out.end(), s.begin(), s.end());
+  }
+
+  /// Two samples: "a" with an image and a 2x3 float array, "b" with an image only
+  std::vector<uint8_t> Shard() {
+    std::vector<uint8_t> shard(3 * kAlignment, 0);
+    std::vector<uint8_t> index;
+    Write<uint32_t>(index, 2);
+    Write(index, "jpg");
+    Write(index, "npy");
+    Write<uint64_t>(index, 2);
+
+    Write(index, "a");
+    Write<uint32_t>(index, 2);
+    Write<uint32_t>(index, 0);
+    Write<uint64_t>(index, 0);
+    Write<uint64_t>(index, 100);
+    Write(index, "");
+    Write<int32_t>(index, -1);
+    Write<uint32_t>(index, 1);
+    Write<uint64_t>(index, kAlignment);
+    Write<uint64_t>(index, 24);
+    Write(index, "<f4");
+    Write<int32_t>(index, 2);
+    Write<int64_t>(index, 2);
+    Write<int64_t>(index, 3);
+
+    Write(index, "b");
+    Write<uint32_t>(index, 1);
+    Write<uint32_t>(index, 0);
+    Write<uint64_t>(index, 2 * kAlignment);
+    Write<uint64_t>(index, 200);
+    Write(index, "");
+    Write<int32_t>(index, -1);
+
+    index_offset = shard.size();
+    shard.insert(shard.end(), index.begin(), index.end());
+    Write<uint64_t>(shard, index_offset);
+    Write<uint64_t>(shard, index.size());
+    Write<uint32_t>(shard, kVersion);
+    Write<uint32_t>(shard, kAlignment);
+    shard.insert(shard.end(), kMagic, kMagic + sizeof(kMagic));
+    return shard;
+  }
+
+  size_t index_offset = 0;
+};
+
+}  // namespace
+
+TEST(AlignedShardTest, ReadIndex) {
+  ShardWriter writer;
+  auto data = writer.Shard();
+  MemoryStream stream(data);
+  auto index = ReadIndex(stream, "test");
+  ASSERT_EQ(index.types, (std::vector<std::string>{"jpg", "npy"}));
+  EXPECT_EQ(index.alignment, kAlignment);
+  ASSERT_EQ(index.samples.size(), 2u);
+
+  auto &a = index.samples[0];
+  EXPECT_EQ(a.key, "a");
+  ASSERT_EQ(a.components.size(), 2u);
+  EXPECT_EQ(a.components[0].type, 0u);
+  EXPECT_EQ(a.components[0].offset, 0);
+  EXPECT_EQ(a.components[0].size, 100);
+  EXPECT_TRUE(a.components[0].dtype.empty());
+  EXPECT_FALSE(a.components[0].has_shape);
+  EXPECT_EQ(a.components[1].type, 1u);
+  EXPECT_EQ(a.components[1].offset, static_cast<int64_t>(kAlignment));
+  EXPECT_EQ(a.components[1].dtype, "<f4");
+  EXPECT_TRUE(a.components[1].has_shape);
+  EXPECT_EQ(a.components[1].shape, TensorShape<>(2, 3));
+
+  auto &b = index.samples[1];
+  EXPECT_EQ(b.key, "b");
+  ASSERT_EQ(b.components.size(), 1u);
+  EXPECT_EQ(b.components[0].offset, static_cast<int64_t>(2 * kAlignment));
+  EXPECT_EQ(b.components[0].size, 200);
+}
+
+TEST(AlignedShardTest, NotAShard) {
+  ShardWriter writer;
+  auto data = writer.Shard();
+  data.back() = 'X';
+  MemoryStream stream(data);
+  EXPECT_THROW(ReadIndex(stream, "test"), std::runtime_error);
+
+  std::vector<uint8_t> small(10, 0);
+  MemoryStream small_stream(small);
+  EXPECT_THROW(ReadIndex(small_stream, "test"), std::runtime_error);
+}
+
+TEST(AlignedShardTest, TruncatedIndex) {
+  ShardWriter writer;
+  auto data = writer.Shard();
+  const uint8_t *index = data.data() + writer.index_offset;
+  size_t index_size = data.size() - kFooterSize - writer.index_offset;
+  EXPECT_NO_THROW(ParseIndex(index, index_size, writer.index_offset, "test"));
+  for (size_t size : {size_t{0}, size_t{10}, index_size / 2, index_size - 1})
+    EXPECT_THROW(ParseIndex(index, size, writer.index_offset, "test"), std::runtime_error);
+}
+
+TEST(AlignedShardTest, ComponentOutsideOfData) {
+  ShardWriter writer;
+  auto data = writer.Shard();
+  const uint8_t *index = data.data() + writer.index_offset;
+  size_t index_size = data.size() - kFooterSize - writer.index_offset;
+  // the last component ends at 2 * kAlignment + 200
+  EXPECT_NO_THROW(ParseIndex(index, index_size, 2 * kAlignment + 200, "test"));
+  EXPECT_THROW(ParseIndex(index, index_size, 2 * kAlignment + 199, "test"), std::runtime_error);
+}
+
+}  // namespace shard
+}  // namespace detail
+}  // namespace dali
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cstring>
 #include <list>
 #include <map>
 #include <unordered_map>
@@ -19,8 +20,10 @@
 #include <iostream>
 #include <fstream>
 
+#include "dali/core/util.h"
 #include "dali/operators/reader/loader/coco_loader.h"
 #include "dali/pipeline/util/lookahead_parser.h"
+#include "dali/util/mmaped_file.h"
 
 namespace dali {
 namespace detail {
@@ -217,6 +220,155 @@ void LoadFromFile(ImageIdPairs &image_id_pairs, const std::string path) {
   }
 }
 
+template <typename T>
+void SaveToFile(const MappableArray<T> &input, const std::string path) {
+  SaveToFile(input.owned(), path);
+}
+
+template <typename T>
+void LoadFromFile(MappableArray<T> &output, const std::string path) {
+  LoadFromFile(output.owned(), path);
+}
+
+/*
+ * Layout of the mappable annotations file:
+ *   MappedAnnotationsHeader
+ *   MappedSection[num_sections]
+ *   data of each section, starting at an offset aligned to kMappedSectionAlignment
+ *
+ * All values are stored in the native byte order.
+ */
+constexpr char kMappedAnnotationsMagic[8] = {'D', 'A', 'L', 'I', 'C', 'O', 'C', 'O'};
+constexpr uint32_t kMappedAnnotationsVersion = 1;
+constexpr uint64_t kMappedSectionAlignment = 64;
+
+enum class MappedSectionId : uint32_t {
+  Offsets = 0,
+  Boxes,
+  Labels,
+  Counts,
+  OriginalIds,
+  PolygonData,
+  PolygonOffset,
+  PolygonCount,
+  VerticesData,
+  VerticesOffset,
+  VerticesCount,
+  MasksRlesIdx,
+  MaskOffsets,
+  MaskCounts,
+  Heights,
+  Widths,
+};
+
+struct MappedAnnotationsHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t num_sections;
+};
+
+struct MappedSection {
+  uint32_t id;
+  uint32_t element_size;
+  uint64_t offset;  // in bytes, from the beginning of the file
+  uint64_t count;   // in elements
+};
+
+class MappedAnnotationsWriter {
+ public:
+  template <typename T>
+  void Add(MappedSectionId id, const MappableArray<T> &array) {
+    sections_.push_back({static_cast<uint32_t>(id), sizeof(T), 0, array.size()});
+    data_.push_back(reinterpret_cast<const char *>(array.data()));
+  }
+
+  void Save(const std::string &path) {
+    std::ofstream file(path, std::ios_base::binary | std::ios_base::out);
+    DALI_ENFORCE(file, "CocoReader meta file error while saving: " + path);
+
+    MappedAnnotationsHeader header;
+    std::memcpy(header.magic, kMappedAnnotationsMagic, sizeof(header.magic));
+    header.version = kMappedAnnotationsVersion;
+    header.num_sections = sections_.size();
+
+    uint64_t offset = sizeof(header) + sections_.size() * sizeof(MappedSection);
+    for (auto &section : sections_) {
+      offset = align_up(offset, kMappedSectionAlignment);
+      section.offset = offset;
+      offset += section.count * section.element_size;
+    }
+
+    Write(file, header, path.c_str());
+    Write(file, make_cspan(sections_), path.c_str());
+    const char padding[kMappedSectionAlignment] = {};
+    for (size_t i = 0; i < sections_.size(); i++) {
+      uint64_t pos = file.tellp();
+      assert(pos <= sections_[i].offset);
+      Write(file, span<const char>(padding, sections_[i].offset - pos), path.c_str());
+      Write(file, span<const char>(data_[i], sections_[i].count * sections_[i].element_size),
+            path.c_str());
+    }
+    DALI_ENFORCE(file.good(), make_string("Error writing to path: ", path));
+  }
+
+ private:
+  std::vector<MappedSection> sections_;
+  std::vector<const char *> data_;
+};
+
+class MappedAnnotationsReader {
+ public:
+  MappedAnnotationsReader(std::shared_ptr<void> data, size_t length, const std::string &path)
+      : data_(std::move(data)), length_(length), path_(path) {
+    auto *base = static_cast<const char *>(data_.get());
+    MappedAnnotationsHeader header;
+    DALI_ENFORCE(length_ >= sizeof(header), make_string("Truncated annotations file: ", path_));
+    std::memcpy(&header, base, sizeof(header));
+    DALI_ENFORCE(!std::memcmp(header.magic, kMappedAnnotationsMagic, sizeof(header.magic)),
+                 make_string("Not a preprocessed COCO annotations file: ", path_));
+    DALI_ENFORCE(header.version == kMappedAnnotationsVersion,
+                 make_string("Unsupported version of the preprocessed COCO annotations file: ",
+                             path_, ". Expected ", kMappedAnnotationsVersion, ", got ",
+                             header.version, "."));
+    DALI_ENFORCE(length_ >= sizeof(header) + header.num_sections * sizeof(MappedSection),
+                 make_string("Truncated annotations file: ", path_));
+    sections_.resize(header.num_sections);
+    std::memcpy(sections_.data(), base + sizeof(header),
+                header.num_sections * sizeof(MappedSection));
+  }
+
+  /**
+   * @brief Points the array to the data in the file; sections absent in the file
+   *        result in empty arrays.
+   */
+  template <typename T>
+  void Map(MappedSectionId id, MappableArray<T> &array) const {
+    for (auto &section : sections_) {
+      if (section.id != static_cast<uint32_t>(id))
+        continue;
+      DALI_ENFORCE(section.element_size == sizeof(T),
+                   make_string("Unexpected element size in section ", section.id,
+                               " of the annotations file: ", path_));
+      DALI_ENFORCE(section.offset % alignof(T) == 0 &&
+                   section.offset <= length_ &&
+                   section.count <= (length_ - section.offset) / sizeof(T),
+                   make_string("Invalid section ", section.id, " in the annotations file: ",
+                               path_));
+      auto *ptr = reinterpret_cast<const T *>(
+          static_cast<const char *>(data_.get()) + section.offset);
+      array.Map(data_, make_cspan(ptr, section.count));
+      return;
+    }
+    array.Map(data_, {});
+  }
+
+ private:
+  std::shared_ptr<void> data_;
+  size_t length_;
+  std::string path_;
+  std::vector<MappedSection> sections_;
+};
+
 void ParseImageInfo(LookaheadParser &parser, std::vector<ImageInfo> &image_infos) {
   RAPIDJSON_ASSERT(parser.PeekType() == kArrayType);
   parser.EnterArray();
@@ -441,6 +593,87 @@ void CocoLoader::SavePreprocessedAnnotations(const std::string &path,
   if (output_image_ids_) {
     SaveToFile(original_ids_, path + "/original_ids.dat");
   }
+
+  SaveMappableAnnotations(path + "/annotations.bin");
+}
+
+void CocoLoader::SaveMappableAnnotations(const std::string &filename) const {
+  using detail::MappedSectionId;
+  detail::MappedAnnotationsWriter writer;
+  writer.Add(MappedSectionId::Offsets, offsets_);
+  writer.Add(MappedSectionId::Boxes, boxes_);
+  writer.Add(MappedSectionId::Labels, labels_);
+  writer.Add(MappedSectionId::Counts, counts_);
+
+  if (output_polygon_masks_ || output_pixelwise_masks_) {
+    writer.Add(MappedSectionId::PolygonData, polygon_data_);
+    writer.Add(MappedSectionId::PolygonOffset, polygon_offset_);
+    writer.Add(MappedSectionId::PolygonCount, polygon_count_);
+    writer.Add(MappedSectionId::VerticesData, vertices_data_);
+    writer.Add(MappedSectionId::VerticesOffset, vertices_offset_);
+    writer.Add(MappedSectionId::VerticesCount, vertices_count_);
+  }
+
+  if (output_pixelwise_masks_) {
+    writer.Add(MappedSectionId::MasksRlesIdx, masks_rles_idx_);
+    writer.Add(MappedSectionId::MaskOffsets, mask_offsets_);
+    writer.Add(MappedSectionId::MaskCounts, mask_counts_);
+    writer.Add(MappedSectionId::Heights, heights_);
+    writer.Add(MappedSectionId::Widths, widths_);
+  }
+
+  if (output_image_ids_) {
+    writer.Add(MappedSectionId::OriginalIds, original_ids_);
+  }
+
+  writer.Save(filename);
+}
+
+void CocoLoader::MapAnnotations(const std::string &filename) {
+  std::shared_ptr<void> data;
+  size_t length = 0;
+  if (dont_use_mmap_) {
+    std::ifstream file(filename, std::ios_base::binary);
+    DALI_ENFORCE(file, "Could not open preprocessed annotations file: " + filename);
+    file.seekg(0, std::ios::end);
+    length = file.tellg();
+    file.seekg(0, std::ios::beg);
+    std::shared_ptr<char> buffer(new char[length], std::default_delete<char[]>());
+    detail::Read(file, span<char>(buffer.get(), length), filename.c_str());
+    data = std::move(buffer);
+  } else {
+    MmapedFileStream file(filename, false);
+    length = file.Size();
+    data = file.Get(length);
+  }
+
+  using detail::MappedSectionId;
+  detail::MappedAnnotationsReader reader(std::move(data), length, filename);
+  reader.Map(MappedSectionId::Offsets, offsets_);
+  reader.Map(MappedSectionId::Boxes, boxes_);
+  reader.Map(MappedSectionId::Labels, labels_);
+  reader.Map(MappedSectionId::Counts, counts_);
+
+  if (output_polygon_masks_ || output_pixelwise_masks_) {
+    reader.Map(MappedSectionId::PolygonData, polygon_data_);
+    reader.Map(MappedSectionId::PolygonOffset, polygon_offset_);
+    reader.Map(MappedSectionId::PolygonCount, polygon_count_);
+    reader.Map(MappedSectionId::VerticesData, vertices_data_);
+    reader.Map(MappedSectionId::VerticesOffset, vertices_offset_);
+    reader.Map(MappedSectionId::VerticesCount, vertices_count_);
+  }
+
+  if (output_pixelwise_masks_) {
+    reader.Map(MappedSectionId::MasksRlesIdx, masks_rles_idx_);
+    reader.Map(MappedSectionId::MaskOffsets, mask_offsets_);
+    reader.Map(MappedSectionId::MaskCounts, mask_counts_);
+    reader.Map(MappedSectionId::Heights, heights_);
+    reader.Map(MappedSectionId::Widths, widths_);
+  }
+
+  if (output_image_ids_) {
+    reader.Map(MappedSectionId::OriginalIds, original_ids_);
+  }
 }
 
 void CocoLoader::ParsePreprocessedAnnotations() {
@@ -449,11 +682,22 @@ void CocoLoader::ParsePreprocessedAnnotations() {
       ? spec_.GetArgument<string>("meta_files_path")
       : spec_.GetArgument<string>("preprocessed_annotations");
   using detail::LoadFromFile;
+  LoadFromFile(image_label_pairs_, path + "/filenames.dat");
+  if (output_pixelwise_masks_) {
+    LoadFromFile(masks_rles_, path + "/masks_rles.dat");
+  }
+
+  // The numeric data is mapped, if the annotations were saved in the mappable format
+  const auto mappable_file = path + "/annotations.bin";
+  if (std::ifstream(mappable_file).good()) {
+    MapAnnotations(mappable_file);
+    return;
+  }
+
   LoadFromFile(offsets_, path + "/offsets.dat");
   LoadFromFile(boxes_, path + "/boxes.dat");
   LoadFromFile(labels_, path + "/labels.dat");
   LoadFromFile(counts_, path + "/counts.dat");
-  LoadFromFile(image_label_pairs_, path + "/filenames.dat");
 
   if (output_polygon_masks_ || output_pixelwise_masks_) {
     LoadFromFile(polygon_data_, path + "/polygon_data.dat");
@@ -465,7 +709,6 @@ void CocoLoader::ParsePreprocessedAnnotations() {
   }
 
   if (output_pixelwise_masks_) {
-    LoadFromFile(masks_rles_, path + "/masks_rles.dat");
     LoadFromFile(masks_rles_idx_, path + "/masks_rles_idx.dat");
     LoadFromFile(mask_offsets_, path + "/masks_offset.dat");
     LoadFromFile(mask_counts_, path + "/mask_count.dat");
@@ -519,6 +762,7 @@ void CocoLoader::ParseJsonAnnotations() {
   }
 
   bool skip_empty = spec_.GetArgument<bool>("skip_empty");
+  int min_image_size = spec_.GetArgument<int>("min_image_size");
   bool ratio = spec_.GetArgument<bool>("ratio");
   bool remap_classes = !spec_.GetArgument<bool>("avoid_class_remapping");
 
@@ -531,6 +775,8 @@ void CocoLoader::ParseJsonAnnotations() {
     if (!img_info_ptr)
       continue;
     const auto &image_info = *img_info_ptr;
+    if (image_info.width_ < min_image_size || image_info.height_ < min_image_size)
+      continue;
     auto image_id = image_info.original_id_;
     int objects_in_sample = 0;
     int64_t sample_polygons_offset = polygon_data_.size();
@@ -97,6 +97,64 @@ struct RLEMask : public UniqueHandle<RLE, RLEMask> {
 
 using RLEMaskPtr = std::shared_ptr<RLEMask>;
 
+/**
+ * @brief An append-only array of annotation data, which can alternatively point to
+ *        a memory-mapped preprocessed annotations file.
+ *
+ * When the annotations are parsed from JSON, the data is accumulated in an owned vector.
+ * When the data is mapped, the vector is left empty and the mapping is kept alive for as long
+ * as the array exists.
+ */
+template <typename T>
+class MappableArray {
+ public:
+  void push_back(const T &value) {
+    assert(!mapping_);
+    data_.push_back(value);
+  }
+
+  void Map(std::shared_ptr<void> mapping, span<const T> data) {
+    data_.clear();
+    data_.shrink_to_fit();
+    mapping_ = std::move(mapping);
+    mapped_ = data;
+  }
+
+  const T *data() const {
+    return mapping_ ? mapped_.data() : data_.data();
+  }
+
+  size_t size() const {
+    return mapping_ ? mapped_.size() : data_.size();
+  }
+
+  bool empty() const {
+    return size() == 0;
+  }
+
+  const T &operator[](int64_t idx) const {
+    return data()[idx];
+  }
+
+  /**
+   * @brief Access to the owned storage; not valid for a mapped array.
+   */
+  std::vector<T> &owned() {
+    assert(!mapping_);
+    return data_;
+  }
+
+  const std::vector<T> &owned() const {
+    assert(!mapping_);
+    return data_;
+  }
+
+ private:
+  std::vector<T> data_;
+  std::shared_ptr<void> mapping_;
+  span<const T> mapped_;
+};
+
 class DLL_PUBLIC CocoLoader : public FileLabelLoader {
  public:
   explicit inline CocoLoader(const OpSpec &spec)
@@ -106,7 +164,8 @@ class DLL_PUBLIC CocoLoader : public FileLabelLoader {
         "Either ``annotations_file`` or ``preprocessed_annotations`` must be provided");
     if (has_preprocessed_annotations_) {
       for (const char* arg_name : {"annotations_file", "skip_empty", "ratio", "ltrb", "images",
-                                   "size_threshold", "dump_meta_files", "dump_meta_files_path"}) {
+                                   "size_threshold", "min_image_size", "dump_meta_files",
+                                   "dump_meta_files_path"}) {
         if (spec.HasArgument(arg_name))
           DALI_FAIL(make_string("When reading data from preprocessed annotation files, \"",
                                 arg_name, "\" is not supported."));
@@ -199,31 +258,45 @@ class DLL_PUBLIC CocoLoader : public FileLabelLoader {
 
   void SavePreprocessedAnnotations(const std::string &path, const ImageIdPairs &image_id_pairs);
 
+  /**
+   * @brief Saves the numeric annotation arrays as a single file, which can be mapped
+   *        directly, without any parsing or copying.
+   */
+  void SaveMappableAnnotations(const std::string &filename) const;
+
+  /**
+   * @brief Maps the file written by SaveMappableAnnotations.
+   *
+   * The mapping is read-only, so the page cache is shared by all the processes
+   * (e.g. one per GPU) that read the same preprocessed annotations.
+   */
+  void MapAnnotations(const std::string &filename);
+
  private:
   const OpSpec &spec_;
 
-  std::vector<int> heights_;
-  std::vector<int> widths_;
-  std::vector<int> offsets_;
-  std::vector<float> boxes_;
-  std::vector<int> labels_;
-  std::vector<int> counts_;
-  std::vector<int> original_ids_;
+  MappableArray<int> heights_;
+  MappableArray<int> widths_;
+  MappableArray<int> offsets_;
+  MappableArray<float> boxes_;
+  MappableArray<int> labels_;
+  MappableArray<int> counts_;
+  MappableArray<int> original_ids_;
 
   // polygons: (mask_idx, offset, size)
-  std::vector<ivec3> polygon_data_;
-  std::vector<int64_t> polygon_offset_;  // per-sample offset of polygons
-  std::vector<int64_t> polygon_count_;   // number of polygon per sample
+  MappableArray<ivec3> polygon_data_;
+  MappableArray<int64_t> polygon_offset_;  // per-sample offset of polygons
+  MappableArray<int64_t> polygon_count_;   // number of polygon per sample
   // vertices: (all polygons concatenated)
-  std::vector<vec2> vertices_data_;
-  std::vector<int64_t> vertices_offset_;  // per-sample offset of vertices
-  std::vector<int64_t> vertices_count_;   // number of vertices per sample
+  MappableArray<vec2> vertices_data_;
+  MappableArray<int64_t> vertices_offset_;  // per-sample offset of vertices
+  MappableArray<int64_t> vertices_count_;   // number of vertices per sample
 
   // masks_rles: (run-length encodings)
   std::vector<RLEMaskPtr> masks_rles_;
-  std::vector<int> masks_rles_idx_;
-  std::vector<int64_t> mask_offsets_;  // per-sample offsets of masks
-  std::vector<int64_t> mask_counts_;   // number of masks per sample
+  MappableArray<int> masks_rles_idx_;
+  MappableArray<int64_t> mask_offsets_;  // per-sample offsets of masks
+  MappableArray<int64_t> mask_counts_;   // number of masks per sample
 
   bool output_polygon_masks_ = false;
   bool output_pixelwise_masks_ = false;
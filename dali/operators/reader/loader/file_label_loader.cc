@@ -12,12 +12,21 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <sys/stat.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <future>
 #include <memory>
+#include <unordered_set>
 
 #include "dali/core/common.h"
 #include "dali/operators/reader/loader/file_label_loader.h"
 #include "dali/util/file.h"
 #include "dali/operators/reader/loader/utils.h"
+#if IO_URING_ENABLED
+#include "dali/util/uring_file.h"
+#endif
 
 namespace dali {
 
@@ -27,15 +36,72 @@ void FileLabelLoader::PrepareEmpty(ImageLabelWrapper &image_label) {
   PrepareEmptyTensor(image_label.image);
 }
 
+void FileLabelLoader::FilterSamples() {
+  bool filter_size = min_file_size_ > 0 || max_file_size_ >= 0;
+  if (exclude_labels_.empty() && !filter_size)
+    return;
+
+  std::unordered_set<int> excluded(exclude_labels_.begin(), exclude_labels_.end());
+  Index total = image_label_pairs_.size();
+  std::vector<uint8_t> keep(total, 1);
+  auto check_range = [&](Index begin, Index end) {
+    for (Index i = begin; i < end; i++) {
+      const auto &sample = image_label_pairs_[i];
+      if (excluded.count(sample.second)) {
+        keep[i] = 0;
+        continue;
+      }
+      if (!filter_size)
+        continue;
+      auto path = filesystem::join_path(file_root_, sample.first);
+      struct stat st;
+      DALI_ENFORCE(stat(path.c_str(), &st) == 0,
+                   make_string("Cannot access the file \"", path, "\": ", std::strerror(errno)));
+      keep[i] = st.st_size >= min_file_size_ &&
+                (max_file_size_ < 0 || st.st_size <= max_file_size_);
+    }
+  };
+
+  if (filter_size) {
+    // stat-ing is dominated by the latency of the storage, so the files are checked in parallel
+    const Index kMinChunk = 1024;
+    Index num_chunks = std::min<Index>(16, (total + kMinChunk - 1) / kMinChunk);
+    std::vector<std::future<void>> chunks;
+    for (Index c = 1; c < num_chunks; c++)
+      chunks.push_back(std::async(std::launch::async, check_range, total * c / num_chunks,
+                                  total * (c + 1) / num_chunks));
+    check_range(0, total / num_chunks);
+    for (auto &chunk : chunks)
+      chunk.get();
+  } else {
+    check_range(0, total);
+  }
+
+  Index kept = 0;
+  for (Index i = 0; i < total; i++) {
+    if (keep[i])
+      image_label_pairs_[kept++] = std::move(image_label_pairs_[i]);
+  }
+  image_label_pairs_.resize(kept);
+  DALI_ENFORCE(kept > 0, make_string("All ", total, " files were rejected by ``exclude_labels``, "
+                                     "``min_file_size`` and ``max_file_size``."));
+}
+
 void FileLabelLoader::ReadSample(ImageLabelWrapper &image_label) {
-  auto image_pair = image_label_pairs_[current_index_++];
+  auto read = ReadSampleDeferred(image_label);
+  if (read)
+    read();
+}
+
+bool FileLabelLoader::NextSample(ImageLabelWrapper &image_label, std::string &path,
+                                 DALIMeta &meta) {
+  auto image_pair = image_label_pairs_[SampleIndex(current_index_++)];
 
   // handle wrap-around
   MoveToNextShard(current_index_);
 
   // copy the label
   image_label.label = image_pair.second;
-  DALIMeta meta;
   meta.SetSourceInfo(image_pair.first);
   meta.SetSkipSample(false);
 
@@ -46,34 +112,90 @@ void FileLabelLoader::ReadSample(ImageLabelWrapper &image_label) {
     image_label.image.SetMeta(meta);
     image_label.image.set_type<uint8_t>();
     image_label.image.Resize({0});
-    return;
+    return false;
   }
 
-  auto current_image = FileStream::Open(filesystem::join_path(file_root_, image_pair.first),
-                                        read_ahead_, !copy_read_data_);
-  Index image_size = current_image->Size();
+  path = filesystem::join_path(file_root_, image_pair.first);
+  return true;
+}
+
+FileLabelLoader::ReadTask FileLabelLoader::ReadSampleDeferred(ImageLabelWrapper &image_label) {
+  std::string path;
+  DALIMeta meta;
+  if (!NextSample(image_label, path, meta))
+    return {};
 
-  if (copy_read_data_) {
-    if (image_label.image.shares_data()) {
-      image_label.image.Reset();
+  bool read_ahead = read_ahead_;
+  bool copy_read_data = copy_read_data_;
+  auto shared_cache = shared_cache_;
+  return [&image_label, path, meta, read_ahead, copy_read_data, shared_cache]() {
+    if (shared_cache) {
+      size_t cached_size = 0;
+      if (auto *cached = shared_cache->Get(path, cached_size)) {
+        // the data stays in the cache for as long as the cache is open
+        Index image_size = cached_size;
+        image_label.image.ShareData(
+            std::shared_ptr<void>(const_cast<uint8_t *>(cached), [shared_cache](void *) {}),
+            image_size, {image_size});
+        image_label.image.set_type<uint8_t>();
+        image_label.image.SetMeta(meta);
+        return;
+      }
     }
-    image_label.image.Resize({image_size});
-    // copy the image
-    Index ret = current_image->Read(image_label.image.mutable_data<uint8_t>(), image_size);
-    DALI_ENFORCE(ret == image_size, make_string("Failed to read file: ", image_pair.first));
-  } else {
-    auto p = current_image->Get(image_size);
-    DALI_ENFORCE(p != nullptr, make_string("Failed to read file: ", image_pair.first));
-    // Wrap the raw data in the Tensor object.
-    image_label.image.ShareData(p, image_size, {image_size});
-    image_label.image.set_type<uint8_t>();
-  }
 
-  // close the file handle
-  current_image->Close();
+    auto current_image = FileStream::Open(path, read_ahead, !copy_read_data);
+    Index image_size = current_image->Size();
+
+    if (copy_read_data) {
+      if (image_label.image.shares_data()) {
+        image_label.image.Reset();
+      }
+      image_label.image.Resize({image_size});
+      // copy the image
+      Index ret = current_image->Read(image_label.image.mutable_data<uint8_t>(), image_size);
+      DALI_ENFORCE(ret == image_size, make_string("Failed to read file: ", meta.GetSourceInfo()));
+    } else {
+      auto p = current_image->Get(image_size);
+      DALI_ENFORCE(p != nullptr, make_string("Failed to read file: ", meta.GetSourceInfo()));
+      // Wrap the raw data in the Tensor object.
+      image_label.image.ShareData(p, image_size, {image_size});
+      image_label.image.set_type<uint8_t>();
+    }
+
+    // close the file handle
+    current_image->Close();
+
+    if (shared_cache)
+      shared_cache->Put(path, image_label.image.raw_data(), image_label.image.nbytes());
 
+    image_label.image.SetMeta(meta);
+  };
+}
+
+#if IO_URING_ENABLED
+bool FileLabelLoader::ReadSampleAsync(ImageLabelWrapper &image_label, AsyncReadRequest &request) {
+  std::string path;
+  DALIMeta meta;
+  if (!NextSample(image_label, path, meta))
+    return false;
+
+  auto file = std::make_shared<UringFileStream>(path);
+  Index image_size = file->Size();
+  if (image_label.image.shares_data()) {
+    image_label.image.Reset();
+  }
+  image_label.image.Resize({image_size});
   image_label.image.SetMeta(meta);
+
+  request.fd = file->fd();
+  request.offset = 0;
+  request.size = image_size;
+  request.buffer = image_label.image.mutable_data<uint8_t>();
+  request.file = std::move(file);
+  request.source_info = meta.GetSourceInfo();
+  return true;
 }
+#endif
 
 Index FileLabelLoader::SizeImpl() {
   return static_cast<Index>(image_label_pairs_.size());
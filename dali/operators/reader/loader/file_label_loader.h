@@ -20,6 +20,7 @@
 #include <errno.h>
 
 #include <fstream>
+#include <memory>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -29,6 +30,7 @@
 #include "dali/core/common.h"
 #include "dali/operators/reader/loader/loader.h"
 #include "dali/operators/reader/loader/filesystem.h"
+#include "dali/operators/reader/loader/shared_sample_cache.h"
 #include "dali/util/file.h"
 
 namespace dali {
@@ -55,6 +57,20 @@ class DLL_PUBLIC FileLabelLoader : public Loader<CPUBackend, ImageLabelWrapper>
       has_labels_arg_ = spec.TryGetRepeatedArgument(labels, "labels");
       has_file_list_arg_ = spec.TryGetArgument(file_list_, "file_list");
       has_file_root_arg_ = spec.TryGetArgument(file_root_, "file_root");
+      spec.TryGetArgument(file_list_cache_dir_, "file_list_cache_dir");
+      spec.TryGetRepeatedArgument(exclude_labels_, "exclude_labels");
+      spec.TryGetArgument(min_file_size_, "min_file_size");
+      spec.TryGetArgument(max_file_size_, "max_file_size");
+
+      string shared_cache_name;
+      if (spec.TryGetArgument(shared_cache_name, "shared_cache_name") &&
+          !shared_cache_name.empty()) {
+        int shared_cache_size = spec.GetArgument<int>("shared_cache_size");
+        DALI_ENFORCE(shared_cache_size > 0,
+          "``shared_cache_size`` must be positive when ``shared_cache_name`` is used.");
+        shared_cache_ = std::make_shared<SharedSampleCache>(
+            shared_cache_name, static_cast<size_t>(shared_cache_size) << 20);
+      }
 
       DALI_ENFORCE(has_file_root_arg_ || has_files_arg_ || has_file_list_arg_,
         "``file_root`` argument is required when not using ``files`` or ``file_list``.");
@@ -116,13 +132,32 @@ class DLL_PUBLIC FileLabelLoader : public Loader<CPUBackend, ImageLabelWrapper>
   void PrepareEmpty(ImageLabelWrapper &tensor) override;
   void ReadSample(ImageLabelWrapper &tensor) override;
 
+  ReadTask ReadSampleDeferred(ImageLabelWrapper &tensor) override;
+
+#if IO_URING_ENABLED
+  bool ReadSampleAsync(ImageLabelWrapper &tensor, AsyncReadRequest &request) override;
+#endif
+
  protected:
   Index SizeImpl() override;
 
+  /**
+   * @brief The sequential part of a read - advances to the next sample and sets its label
+   *
+   * @return false, if the image doesn't need to be read, because it's cached
+   */
+  bool NextSample(ImageLabelWrapper &image_label, std::string &path, DALIMeta &meta);
+
+  void SkipSample() override {
+    current_index_++;
+    MoveToNextShard(current_index_);
+  }
+
   void PrepareMetadataImpl() override {
     if (image_label_pairs_.empty()) {
       if (!has_file_list_arg_ && !has_files_arg_) {
-        image_label_pairs_ = filesystem::traverse_directories(file_root_);
+        image_label_pairs_ = filesystem::traverse_directories_cached(file_root_,
+                                                                     file_list_cache_dir_);
       } else if (has_file_list_arg_) {
         // load (path, label) pairs from list
         std::ifstream s(file_list_);
@@ -166,6 +201,7 @@ class DLL_PUBLIC FileLabelLoader : public Loader<CPUBackend, ImageLabelWrapper>
       }
     }
     DALI_ENFORCE(SizeImpl() > 0, "No files found.");
+    FilterSamples();
 
     if (shuffle_) {
       // seeded with hardcoded value to get
@@ -185,17 +221,31 @@ class DLL_PUBLIC FileLabelLoader : public Loader<CPUBackend, ImageLabelWrapper>
 
     current_epoch_++;
 
-    if (shuffle_after_epoch_) {
-      std::mt19937 g(kDaliDataloaderSeed + current_epoch_);
-      std::shuffle(image_label_pairs_.begin(), image_label_pairs_.end(), g);
-    }
+    if (shuffle_after_epoch_)
+      ShuffleAfterEpoch(image_label_pairs_, current_epoch_);
+    ShuffleIndices();
   }
 
+  bool SupportsShuffleIndices() const override {
+    return true;
+  }
+
+  /**
+   * @brief Drops the samples rejected by ``exclude_labels``, ``min_file_size`` and
+   *        ``max_file_size``, before they are shuffled and split between the shards
+   */
+  void FilterSamples();
+
   using Loader<CPUBackend, ImageLabelWrapper>::shard_id_;
   using Loader<CPUBackend, ImageLabelWrapper>::num_shards_;
 
   string file_root_, file_list_;
+  string file_list_cache_dir_;
+  std::shared_ptr<SharedSampleCache> shared_cache_;
   vector<std::pair<string, int>> image_label_pairs_;
+  vector<int> exclude_labels_;
+  int64_t min_file_size_ = 0;
+  int64_t max_file_size_ = -1;
 
   bool has_files_arg_     = false;
   bool has_labels_arg_    = false;
@@ -143,10 +143,13 @@ class FileLoader : public Loader<Backend, Target> {
 
     current_epoch_++;
 
-    if (shuffle_after_epoch_) {
-      std::mt19937 g(kDaliDataloaderSeed + current_epoch_);
-      std::shuffle(files_.begin(), files_.end(), g);
-    }
+    if (shuffle_after_epoch_)
+      this->ShuffleAfterEpoch(files_, current_epoch_);
+    this->ShuffleIndices();
+  }
+
+  bool SupportsShuffleIndices() const override {
+    return true;
   }
 
   using Loader<Backend, Target>::shard_id_;
@@ -158,6 +161,7 @@ class FileLoader : public Loader<Backend, Target> {
   using Loader<Backend, Target>::copy_read_data_;
   using Loader<Backend, Target>::read_ahead_;
   using Loader<Backend, Target>::MoveToNextShard;
+  using Loader<Backend, Target>::SampleIndex;
   using Loader<Backend, Target>::ShouldSkipImage;
   using Loader<Backend, Target>::Size;
   using Loader<Backend, Target>::PrepareEmptyTensor;
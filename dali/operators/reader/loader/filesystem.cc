@@ -16,9 +16,20 @@
 #include <errno.h>
 #include <glob.h>
 #include <sys/stat.h>
+#include <unistd.h>
 #include <algorithm>
-#include <string>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 #include "dali/operators/reader/loader/filesystem.h"
@@ -47,102 +58,145 @@ std::string join_path(const std::string &dir, const std::string &path) {
 
 
 
-inline void assemble_file_list(std::vector<std::pair<std::string, int>>& file_label_pairs,
-                               const std::string &path, const std::string &curr_entry, int label) {
-  std::string curr_dir_path = path + dir_sep + curr_entry;
-  DIR *dir = opendir(curr_dir_path.c_str());
+namespace {
 
-  dirent *entry;
+// more threads don't help, even on the parallel file systems
+constexpr unsigned kMaxTraversalThreads = 16;
 
-  while ((entry = readdir(dir))) {
-#ifdef _DIRENT_HAVE_D_TYPE
-    /*
-     * we support only regular files and symlinks, if FS returns DT_UNKNOWN
-     * it doesn't mean anything and let us validate filename itself
-     */
-    if (entry->d_type != DT_REG && entry->d_type != DT_LNK &&
-        entry->d_type != DT_UNKNOWN) {
-      continue;
-    }
-#endif
-    std::string rel_path = curr_entry + dir_sep + std::string{entry->d_name};
-    if (HasKnownExtension(std::string(entry->d_name))) {
-      file_label_pairs.emplace_back(rel_path, label);
-    }
+/**
+ * @brief Runs fn(i) for i in [0, n), spreading the calls over several threads
+ *
+ * The first exception thrown by fn is rethrown, once all the threads have stopped.
+ */
+template <typename Fn>
+void parallel_for(size_t n, Fn &&fn) {
+  size_t num_threads = std::min<size_t>(
+      n, std::max(1u, std::min(std::thread::hardware_concurrency(), kMaxTraversalThreads)));
+  if (num_threads <= 1) {
+    for (size_t i = 0; i < n; i++)
+      fn(i);
+    return;
   }
-  closedir(dir);
+  std::atomic<size_t> next{0};
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < num_threads; t++) {
+    threads.emplace_back([&]() {
+      try {
+        for (size_t i; (i = next++) < n;)
+          fn(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (!error)
+          error = std::current_exception();
+        next = n;
+      }
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+  if (error)
+    std::rethrow_exception(error);
 }
 
-vector<std::pair<string, int>> traverse_directories(const std::string &file_root) {
-  // open the root
+/**
+ * @brief Returns the sorted names of the subdirectories of file_root
+ */
+std::vector<std::string> list_subdirectories(const std::string &file_root) {
   DIR *dir = opendir(file_root.c_str());
-
   DALI_ENFORCE(dir != nullptr,
       "Directory " + file_root + " could not be opened.");
 
-  struct dirent *entry;
-
-  std::vector<std::pair<std::string, int>> file_label_pairs;
   std::vector<std::string> entry_name_list;
-
+  struct dirent *entry;
   while ((entry = readdir(dir))) {
-    struct stat s;
+    if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) continue;
     std::string entry_name(entry->d_name);
+#ifdef _DIRENT_HAVE_D_TYPE
+    // stat is slow on the parallel file systems, so it's used only when the type is unknown
+    // or a symlink may point to a directory
+    if (entry->d_type == DT_DIR) {
+      entry_name_list.push_back(entry_name);
+      continue;
+    }
+    if (entry->d_type != DT_LNK && entry->d_type != DT_UNKNOWN)
+      continue;
+#endif
+    struct stat s;
     std::string full_path = join_path(file_root, entry_name);
     int ret = stat(full_path.c_str(), &s);
     DALI_ENFORCE(ret == 0,
         "Could not access " + full_path + " during directory traversal.");
-    if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) continue;
     if (S_ISDIR(s.st_mode)) {
       entry_name_list.push_back(entry_name);
     }
   }
+  closedir(dir);
+
   // sort directories to preserve class alphabetic order, as readdir could
   // return unordered dir list. Otherwise file reader for training and validation
   // could return directories with the same names in completely different order
   std::sort(entry_name_list.begin(), entry_name_list.end());
-  for (unsigned dir_count = 0; dir_count < entry_name_list.size(); ++dir_count) {
-    assemble_file_list(file_label_pairs, file_root, entry_name_list[dir_count], dir_count);
-  }
-  // sort file names as well
-  std::sort(file_label_pairs.begin(), file_label_pairs.end());
-  printf("read %lu files from %lu directories\n", file_label_pairs.size(), entry_name_list.size());
+  return entry_name_list;
+}
 
-  closedir(dir);
+inline DIR *open_subdirectory(const std::string &path, const std::string &curr_entry) {
+  std::string curr_dir_path = path + dir_sep + curr_entry;
+  DIR *dir = opendir(curr_dir_path.c_str());
+  DALI_ENFORCE(dir != nullptr,
+      "Directory " + curr_dir_path + " could not be opened.");
+  return dir;
+}
 
-  return file_label_pairs;
+inline bool may_be_file(const dirent *entry) {
+#ifdef _DIRENT_HAVE_D_TYPE
+  /*
+   * we support only regular files and symlinks, if FS returns DT_UNKNOWN
+   * it doesn't mean anything and let us validate filename itself
+   */
+  return entry->d_type == DT_REG || entry->d_type == DT_LNK || entry->d_type == DT_UNKNOWN;
+#else
+  return true;
+#endif
 }
 
+inline void assemble_file_list(std::vector<std::pair<std::string, int>>& file_label_pairs,
+                               const std::string &path, const std::string &curr_entry, int label) {
+  DIR *dir = open_subdirectory(path, curr_entry);
+
+  dirent *entry;
+
+  while ((entry = readdir(dir))) {
+    if (!may_be_file(entry))
+      continue;
+    std::string rel_path = curr_entry + dir_sep + std::string{entry->d_name};
+    if (HasKnownExtension(std::string(entry->d_name))) {
+      file_label_pairs.emplace_back(rel_path, label);
+    }
+  }
+  closedir(dir);
+}
 
 inline void assemble_file_list(std::vector<std::string>& file_list,
                                const std::string &path, const std::string &curr_entry,
                                const std::string &filter) {
-  std::string curr_dir_path = path + dir_sep + curr_entry;
-  DIR *dir = opendir(curr_dir_path.c_str());
-
-  dirent *entry;
-
   if (filter.empty()) {
+    DIR *dir = open_subdirectory(path, curr_entry);
+    dirent *entry;
     while ((entry = readdir(dir))) {
-#ifdef _DIRENT_HAVE_D_TYPE
-    /*
-     * we support only regular files and symlinks, if FS returns DT_UNKNOWN
-     * it doesn't mean anything and let us validate filename itself
-     */
-      if (entry->d_type != DT_REG && entry->d_type != DT_LNK &&
-         entry->d_type != DT_UNKNOWN) {
+      if (!may_be_file(entry))
         continue;
-      }
-#endif
       std::string rel_path = curr_entry + dir_sep + std::string{entry->d_name};
       if (HasKnownExtension(std::string(entry->d_name))) {
          file_list.push_back(rel_path);
       }
     }
+    closedir(dir);
   } else {
     // use glob to do the file search
     glob_t pglob;
-    std::string pattern = curr_dir_path + dir_sep + filter;
+    std::string pattern = path + dir_sep + curr_entry + dir_sep + filter;
     if (glob(pattern.c_str(), GLOB_TILDE, NULL, &pglob) == 0) {
       // iterate through the matched files
       for (unsigned int count = 0; count < pglob.gl_pathc; ++count) {
@@ -154,50 +208,163 @@ inline void assemble_file_list(std::vector<std::string>& file_list,
       globfree(&pglob);
     }
   }
-  closedir(dir);
 }
 
+/**
+ * @brief Lists the files in each of the directories, in parallel, and merges the sorted lists
+ */
+template <typename Entry, typename AssembleFn>
+std::vector<Entry> traverse_parallel(const std::vector<std::string> &entry_name_list,
+                                     AssembleFn &&assemble) {
+  std::vector<std::vector<Entry>> per_dir(entry_name_list.size());
+  parallel_for(entry_name_list.size(), [&](size_t i) {
+    assemble(per_dir[i], i);
+  });
+  size_t total = 0;
+  for (auto &files : per_dir)
+    total += files.size();
+  std::vector<Entry> result;
+  result.reserve(total);
+  for (auto &files : per_dir)
+    std::move(files.begin(), files.end(), std::back_inserter(result));
+  // sort file names as well
+  std::sort(result.begin(), result.end());
+  return result;
+}
 
-vector<std::string> traverse_directories(const std::string &file_root, const std::string &filter) {
-  // open the root
-  DIR *dir = opendir(file_root.c_str());
+int64_t mtime_ns(const struct stat &s) {
+  return static_cast<int64_t>(s.st_mtim.tv_sec) * 1000000000 + s.st_mtim.tv_nsec;
+}
 
-  DALI_ENFORCE(dir != nullptr,
-      "Directory " + file_root + " could not be opened.");
+constexpr const char kFileListCacheHeader[] = "DALI file list cache 1";
 
-  struct dirent *entry;
+/**
+ * @brief Describes the state of the tree: the root and its subdirectories with their mtimes
+ *
+ * Adding or removing a file changes the mtime of its directory, so the list stays valid as
+ * long as the description doesn't change.
+ */
+std::string describe_tree(const std::string &file_root,
+                          const std::vector<std::string> &entry_name_list) {
+  std::vector<int64_t> mtimes(entry_name_list.size());
+  parallel_for(entry_name_list.size(), [&](size_t i) {
+    struct stat s;
+    std::string full_path = join_path(file_root, entry_name_list[i]);
+    DALI_ENFORCE(stat(full_path.c_str(), &s) == 0,
+        "Could not access " + full_path + " during directory traversal.");
+    mtimes[i] = mtime_ns(s);
+  });
+  struct stat s;
+  DALI_ENFORCE(stat(file_root.c_str(), &s) == 0,
+      "Could not access " + file_root + " during directory traversal.");
+  std::stringstream ss;
+  ss << file_root << "\n" << mtime_ns(s) << "\n" << entry_name_list.size() << "\n";
+  for (size_t i = 0; i < entry_name_list.size(); i++)
+    ss << mtimes[i] << " " << entry_name_list[i] << "\n";
+  return ss.str();
+}
 
-  std::vector<std::string> file_list;
-  std::vector<std::string> entry_name_list;
+std::string file_list_cache_path(const std::string &file_root, const std::string &cache_dir) {
+  // the same tree may be given by different paths
+  std::string key = file_root;
+  if (char *real_path = realpath(file_root.c_str(), nullptr)) {
+    key = real_path;
+    free(real_path);
+  }
+  std::stringstream name;
+  name << "dali_file_list_" << std::hex << std::hash<std::string>()(key) << ".txt";
+  return join_path(cache_dir, name.str());
+}
 
-  // always append the root current directory
-  entry_name_list.push_back(".");
+bool read_file_list_cache(const std::string &cache_path, const std::string &tree,
+                          std::vector<std::pair<std::string, int>> &file_label_pairs) {
+  std::ifstream f(cache_path);
+  if (!f.is_open())
+    return false;
+  std::string line;
+  if (!std::getline(f, line) || line != kFileListCacheHeader)
+    return false;
+  std::string cached_tree(tree.size(), '\0');
+  if (!f.read(&cached_tree[0], cached_tree.size()) || cached_tree != tree)
+    return false;
+  size_t num_files = 0;
+  if (!(f >> num_files) || !std::getline(f, line))
+    return false;
+  file_label_pairs.clear();
+  file_label_pairs.reserve(num_files);
+  for (size_t i = 0; i < num_files; i++) {
+    int label;
+    if (!(f >> label) || f.get() != ' ' || !std::getline(f, line))
+      return false;
+    file_label_pairs.emplace_back(line, label);
+  }
+  return true;
+}
 
-  // now traverse sub-directories
-  while ((entry = readdir(dir))) {
-    struct stat s;
-    std::string entry_name(entry->d_name);
-    std::string full_path = join_path(file_root, entry_name);
-    int ret = stat(full_path.c_str(), &s);
-    DALI_ENFORCE(ret == 0,
-        "Could not access " + full_path + " during directory traversal.");
-    if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) continue;
-    if (S_ISDIR(s.st_mode)) {
-      entry_name_list.push_back(entry_name);
+void write_file_list_cache(const std::string &cache_path, const std::string &tree,
+                           const std::vector<std::pair<std::string, int>> &file_label_pairs) {
+  // the processes sharing the cache may write it at the same time - each writes its own
+  // file and moves it in place
+  std::string tmp_path = make_string(cache_path, ".", getpid(), ".tmp");
+  {
+    std::ofstream f(tmp_path);
+    f << kFileListCacheHeader << "\n" << tree << file_label_pairs.size() << "\n";
+    for (auto &entry : file_label_pairs)
+      f << entry.second << " " << entry.first << "\n";
+    if (!f.good()) {
+      DALI_WARN(make_string("Could not write the file list cache ", tmp_path));
+      f.close();
+      std::remove(tmp_path.c_str());
+      return;
     }
   }
+  if (std::rename(tmp_path.c_str(), cache_path.c_str()) != 0) {
+    DALI_WARN(make_string("Could not write the file list cache ", cache_path));
+    std::remove(tmp_path.c_str());
+  }
+}
 
-  // sort directories
-  std::sort(entry_name_list.begin(), entry_name_list.end());
-  for (unsigned dir_count = 0; dir_count < entry_name_list.size(); ++dir_count) {
-    assemble_file_list(file_list, file_root, entry_name_list[dir_count], filter);
+}  // namespace
+
+vector<std::pair<string, int>> traverse_directories(const std::string &file_root) {
+  auto entry_name_list = list_subdirectories(file_root);
+  auto file_label_pairs = traverse_parallel<std::pair<std::string, int>>(entry_name_list,
+      [&](std::vector<std::pair<std::string, int>> &files, int dir_idx) {
+        assemble_file_list(files, file_root, entry_name_list[dir_idx], dir_idx);
+      });
+  printf("read %lu files from %lu directories\n", file_label_pairs.size(), entry_name_list.size());
+  return file_label_pairs;
+}
+
+vector<std::pair<string, int>> traverse_directories_cached(const std::string &file_root,
+                                                           const std::string &cache_dir) {
+  if (cache_dir.empty())
+    return traverse_directories(file_root);
+  auto entry_name_list = list_subdirectories(file_root);
+  std::string tree = describe_tree(file_root, entry_name_list);
+  std::string cache_path = file_list_cache_path(file_root, cache_dir);
+  std::vector<std::pair<std::string, int>> file_label_pairs;
+  if (read_file_list_cache(cache_path, tree, file_label_pairs)) {
+    printf("read %lu files from the file list cache %s\n", file_label_pairs.size(),
+           cache_path.c_str());
+    return file_label_pairs;
   }
-  // sort file names as well
-  std::sort(file_list.begin(), file_list.end());
-  printf("read %lu files from %lu directories\n", file_list.size(), entry_name_list.size());
+  file_label_pairs = traverse_directories(file_root);
+  write_file_list_cache(cache_path, tree, file_label_pairs);
+  return file_label_pairs;
+}
 
-  closedir(dir);
+vector<std::string> traverse_directories(const std::string &file_root, const std::string &filter) {
+  auto entry_name_list = list_subdirectories(file_root);
+  // always append the root current directory
+  entry_name_list.insert(entry_name_list.begin(), ".");
+  std::sort(entry_name_list.begin(), entry_name_list.end());
 
+  auto file_list = traverse_parallel<std::string>(entry_name_list,
+      [&](std::vector<std::string> &files, int dir_idx) {
+        assemble_file_list(files, file_root, entry_name_list[dir_idx], filter);
+      });
+  printf("read %lu files from %lu directories\n", file_list.size(), entry_name_list.size());
   return file_list;
 }
 
@@ -28,6 +28,17 @@ DLL_PUBLIC vector<string> traverse_directories(const string &path, const string
 // TODO(michalz): Make it a more generic utility; support filters.
 DLL_PUBLIC vector<std::pair<string, int>> traverse_directories(const string &file_root);
 
+/**
+ * @brief Same as traverse_directories(file_root), but reuses the list stored in cache_dir
+ *
+ * The list is stored under a name derived from the path of file_root, together with
+ * the modification times of file_root and its subdirectories. It's reused as long as they
+ * don't change, so repeated runs and the processes on one node sharing cache_dir list
+ * the tree only once. If cache_dir is empty, the cache is not used.
+ */
+DLL_PUBLIC vector<std::pair<string, int>> traverse_directories_cached(const string &file_root,
+                                                                      const string &cache_dir);
+
 /**
  * @brief Prepends dir to a relative path and keeps absolute path unchanged.
  */
@@ -0,0 +1,126 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "dali/operators/reader/loader/filesystem.h"
+
+namespace dali {
+namespace filesystem {
+
+class TraverseDirectoriesTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    root_ = testing::TempDir() + "dali_traverse_test_" + std::to_string(getpid());
+    cache_dir_ = root_ + "_cache";
+    ASSERT_EQ(mkdir(root_.c_str(), 0755), 0);
+    ASSERT_EQ(mkdir(cache_dir_.c_str(), 0755), 0);
+    // more directories than the traversal threads
+    for (int d = 0; d < 20; d++) {
+      std::string dir = "class" + std::to_string(100 + d);
+      AddDir(dir);
+      for (int f = 0; f < 3; f++)
+        AddFile(dir + "/img" + std::to_string(f) + ".jpg");
+      AddFile(dir + "/notes.txt");
+    }
+  }
+
+  void TearDown() override {
+    for (auto it = files_.rbegin(); it != files_.rend(); ++it)
+      std::remove(it->c_str());
+    for (auto it = dirs_.rbegin(); it != dirs_.rend(); ++it)
+      rmdir(it->c_str());
+    RemoveAll(cache_dir_);
+    rmdir(root_.c_str());
+  }
+
+  void AddDir(const std::string &dir) {
+    dirs_.push_back(root_ + "/" + dir);
+    ASSERT_EQ(mkdir(dirs_.back().c_str(), 0755), 0);
+  }
+
+  void AddFile(const std::string &file) {
+    files_.push_back(root_ + "/" + file);
+    std::ofstream f(files_.back());
+    f << "data";
+  }
+
+  static void RemoveAll(const std::string &dir) {
+    if (DIR *d = opendir(dir.c_str())) {
+      while (dirent *entry = readdir(d))
+        std::remove((dir + "/" + entry->d_name).c_str());
+      closedir(d);
+    }
+    rmdir(dir.c_str());
+  }
+
+  std::string root_, cache_dir_;
+  std::vector<std::string> dirs_, files_;
+};
+
+TEST_F(TraverseDirectoriesTest, Labels) {
+  auto files = traverse_directories(root_);
+  ASSERT_EQ(files.size(), 60u);
+  for (int d = 0; d < 20; d++) {
+    for (int f = 0; f < 3; f++) {
+      auto &entry = files[d * 3 + f];
+      EXPECT_EQ(entry.first,
+                "class" + std::to_string(100 + d) + "/img" + std::to_string(f) + ".jpg");
+      EXPECT_EQ(entry.second, d);
+    }
+  }
+}
+
+TEST_F(TraverseDirectoriesTest, Filter) {
+  AddFile("top.txt");
+  auto files = traverse_directories(root_, "*.txt");
+  ASSERT_EQ(files.size(), 21u);
+  EXPECT_EQ(files[0], "./top.txt");
+  EXPECT_EQ(files[1], "class100/notes.txt");
+}
+
+TEST_F(TraverseDirectoriesTest, Cached) {
+  auto expected = traverse_directories(root_);
+  EXPECT_EQ(traverse_directories_cached(root_, cache_dir_), expected);
+
+  // the list is stored in the cache directory and read from there by the next call
+  std::string cache_file;
+  DIR *d = opendir(cache_dir_.c_str());
+  ASSERT_NE(d, nullptr);
+  while (dirent *entry = readdir(d)) {
+    if (entry->d_name[0] != '.')
+      cache_file = cache_dir_ + "/" + entry->d_name;
+  }
+  closedir(d);
+  ASSERT_FALSE(cache_file.empty());
+  EXPECT_EQ(traverse_directories_cached(root_, cache_dir_), expected);
+
+  // a new directory invalidates the list
+  AddDir("class200");
+  AddFile("class200/new.png");
+  auto updated = traverse_directories_cached(root_, cache_dir_);
+  ASSERT_EQ(updated.size(), expected.size() + 1);
+  EXPECT_EQ(updated.back(), std::make_pair(std::string("class200/new.png"), 20));
+  EXPECT_EQ(updated, traverse_directories(root_));
+}
+
+}  // namespace filesystem
+}  // namespace dali
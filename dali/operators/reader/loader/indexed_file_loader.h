@@ -24,6 +24,9 @@
 #include "dali/core/common.h"
 #include "dali/operators/reader/loader/loader.h"
 #include "dali/util/file.h"
+#if IO_URING_ENABLED
+#include "dali/util/uring_file.h"
+#endif
 
 namespace dali {
 
@@ -37,32 +40,11 @@ class IndexedFileLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
     }
 
   void ReadSample(Tensor<CPUBackend>& tensor) override {
-    MoveToNextShard(current_index_);
-
     int64 seek_pos, size;
     size_t file_index;
-    std::tie(seek_pos, size, file_index) = indices_[current_index_];
-    ++current_index_;
-
-    std::string image_key = uris_[file_index] + " at index " + to_string(seek_pos);
     DALIMeta meta;
-    meta.SetSourceInfo(image_key);
-    meta.SetSkipSample(false);
-
-    if (file_index != current_file_index_) {
-      current_file_->Close();
-      current_file_ = FileStream::Open(uris_[file_index], read_ahead_, !copy_read_data_);
-      current_file_index_ = file_index;
-    }
-
-    // if image is cached, skip loading
-    if (ShouldSkipImage(image_key)) {
-      meta.SetSkipSample(true);
+    if (!NextRecord(tensor, seek_pos, size, file_index, meta)) {
       should_seek_ = true;
-      tensor.Reset();
-      tensor.SetMeta(meta);
-      tensor.set_type<uint8_t>();
-      tensor.Resize({0});
       return;
     }
 
@@ -72,29 +54,60 @@ class IndexedFileLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
     }
     next_seek_pos_ = seek_pos + size;
 
-    if (!copy_read_data_) {
-      auto p = current_file_->Get(size);
-      DALI_ENFORCE(p != nullptr, "Error reading from a file " + uris_[current_file_index_]);
-      // Wrap the raw data in the Tensor object.
-      tensor.ShareData(p, size, {size});
-      tensor.set_type<uint8_t>();
-    } else {
-      if (tensor.shares_data()) {
-        tensor.Reset();
-      }
-      tensor.set_type<uint8_t>();
-      tensor.Resize({size});
+    ReadRecord(current_file_.get(), tensor, size, uris_[current_file_index_]);
+    tensor.SetMeta(meta);
+    return;
+  }
 
-      int64 n_read = current_file_->Read(reinterpret_cast<uint8_t*>(tensor.raw_mutable_data()),
-                          size);
-      DALI_ENFORCE(n_read == size, "Error reading from a file " + uris_[current_file_index_]);
-    }
+  ReadTask ReadSampleDeferred(Tensor<CPUBackend>& tensor) override {
+    int64 seek_pos, size;
+    size_t file_index;
+    DALIMeta meta;
+    if (!NextRecord(tensor, seek_pos, size, file_index, meta))
+      return {};
+
+    return [this, &tensor, seek_pos, size, file_index, meta]() {
+      auto file = FileStream::Open(uris_[file_index], read_ahead_, !copy_read_data_);
+      file->Seek(seek_pos);
+      ReadRecord(file.get(), tensor, size, uris_[file_index]);
+      file->Close();
+      tensor.SetMeta(meta);
+    };
+  }
 
+#if IO_URING_ENABLED
+  bool ReadSampleAsync(Tensor<CPUBackend>& tensor, AsyncReadRequest& request) override {
+    int64 seek_pos, size;
+    size_t file_index;
+    DALIMeta meta;
+    if (!NextRecord(tensor, seek_pos, size, file_index, meta))
+      return false;
+
+    if (file_index != uring_file_index_) {
+      // the previous file is kept open by the requests that still read from it
+      uring_file_ = std::make_shared<UringFileStream>(uris_[file_index]);
+      uring_file_index_ = file_index;
+    }
+    if (tensor.shares_data()) {
+      tensor.Reset();
+    }
+    tensor.set_type<uint8_t>();
+    tensor.Resize({size});
     tensor.SetMeta(meta);
-    return;
+
+    request.fd = uring_file_->fd();
+    request.offset = seek_pos;
+    request.size = size;
+    request.buffer = tensor.raw_mutable_data();
+    request.file = uring_file_;
+    request.source_info = meta.GetSourceInfo();
+    return true;
   }
+#endif
 
   ~IndexedFileLoader() override {
+    // the read tasks use uris_
+    WaitForPendingReads();
     if (current_file_ != nullptr) {
       current_file_->Close();
     }
@@ -119,6 +132,62 @@ class IndexedFileLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
     return indices_.size();
   }
 
+  /**
+   * @brief The sequential part of ReadSampleDeferred - advances to the next record
+   *
+   * Keeps `current_file_` at the file of the record, so that the mapping of the file
+   * is shared by the concurrent reads.
+   *
+   * @return false, if the record doesn't need to be read, because it's cached
+   */
+  bool NextRecord(Tensor<CPUBackend>& tensor, int64 &seek_pos, int64 &size, size_t &file_index,
+                  DALIMeta &meta) {
+    MoveToNextShard(current_index_);
+
+    std::tie(seek_pos, size, file_index) = indices_[SampleIndex(current_index_)];
+    ++current_index_;
+
+    std::string image_key = uris_[file_index] + " at index " + to_string(seek_pos);
+    meta.SetSourceInfo(image_key);
+    meta.SetSkipSample(false);
+
+    SwitchToFile(file_index);
+
+    // if image is cached, skip loading
+    if (ShouldSkipImage(image_key)) {
+      meta.SetSkipSample(true);
+      tensor.Reset();
+      tensor.SetMeta(meta);
+      tensor.set_type<uint8_t>();
+      tensor.Resize({0});
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * @brief Reads `size` bytes from the current position of `file` into `tensor`
+   */
+  void ReadRecord(FileStream *file, Tensor<CPUBackend>& tensor, int64 size,
+                  const std::string &uri) {
+    if (!copy_read_data_) {
+      auto p = file->Get(size);
+      DALI_ENFORCE(p != nullptr, "Error reading from a file " + uri);
+      // Wrap the raw data in the Tensor object.
+      tensor.ShareData(p, size, {size});
+      tensor.set_type<uint8_t>();
+    } else {
+      if (tensor.shares_data()) {
+        tensor.Reset();
+      }
+      tensor.set_type<uint8_t>();
+      tensor.Resize({size});
+
+      int64 n_read = file->Read(reinterpret_cast<uint8_t*>(tensor.raw_mutable_data()), size);
+      DALI_ENFORCE(n_read == size, "Error reading from a file " + uri);
+    }
+  }
+
   void PrepareMetadataImpl() override {
     if (!dont_use_mmap_) {
       mmap_reserver_ = FileStream::MappingReserver(
@@ -129,6 +198,8 @@ class IndexedFileLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
     DALI_ENFORCE(!uris_.empty(), "No files specified.");
     ReadIndexFile(index_uris_);
     DALI_ENFORCE(!indices_.empty(), "Content of index files should not be empty");
+    if (shuffle_indices_)
+      open_files_.resize(uris_.size());
     current_file_index_ = INVALID_INDEX;
     Reset(true);
   }
@@ -141,15 +212,37 @@ class IndexedFileLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
     } else {
       current_index_ = 0;
     }
-    std::tie(seek_pos, size, file_index) = indices_[current_index_];
-    if (file_index != current_file_index_) {
-      if (current_file_index_ != static_cast<size_t>(INVALID_INDEX)) {
+    ShuffleIndices();
+    std::tie(seek_pos, size, file_index) = indices_[SampleIndex(current_index_)];
+    SwitchToFile(file_index);
+    current_file_->Seek(seek_pos);
+  }
+
+  bool SupportsShuffleIndices() const override {
+    return true;
+  }
+
+  /**
+   * @brief Makes `current_file_` the stream of the file `file_index`
+   *
+   * With the shuffled indices, the consecutive records come from random files, so the files
+   * are kept open instead of being reopened for each record.
+   */
+  void SwitchToFile(size_t file_index) {
+    if (file_index == current_file_index_)
+      return;
+    if (current_file_index_ != static_cast<size_t>(INVALID_INDEX)) {
+      if (shuffle_indices_)
+        open_files_[current_file_index_] = std::move(current_file_);
+      else
         current_file_->Close();
-      }
-      current_file_ = FileStream::Open(uris_[file_index], read_ahead_, !copy_read_data_);
-      current_file_index_ = file_index;
     }
-    current_file_->Seek(seek_pos);
+    if (shuffle_indices_ && open_files_[file_index])
+      current_file_ = std::move(open_files_[file_index]);
+    else
+      current_file_ = FileStream::Open(uris_[file_index], read_ahead_, !copy_read_data_);
+    current_file_index_ = file_index;
+    should_seek_ = true;
   }
 
   std::vector<std::string> uris_;
@@ -158,10 +251,16 @@ class IndexedFileLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
   size_t current_index_;
   size_t current_file_index_;
   std::unique_ptr<FileStream> current_file_;
+  // the streams of the other files, used with the shuffled indices, see SwitchToFile
+  std::vector<std::unique_ptr<FileStream>> open_files_;
   FileStream::MappingReserver mmap_reserver_;
   static constexpr int INVALID_INDEX = -1;
   bool should_seek_ = false;
   int64 next_seek_pos_ = 0;
+#if IO_URING_ENABLED
+  std::shared_ptr<UringFileStream> uring_file_;
+  size_t uring_file_index_ = static_cast<size_t>(INVALID_INDEX);
+#endif
 };
 
 }  // namespace dali
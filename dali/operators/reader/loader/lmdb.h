@@ -32,11 +32,31 @@ namespace dali {
   } while (0)
 
 
+/**
+ * @brief The LMDB environment with the read transaction, in which the values are read
+ *
+ * The values point into the memory map of the environment and remain valid as long as
+ * the transaction, so the samples sharing them keep it alive.
+ */
+struct LMDBTransaction {
+  MDB_env* env = nullptr;
+  MDB_txn* txn = nullptr;
+  MDB_dbi dbi = 0;
+  bool has_dbi = false;
+
+  ~LMDBTransaction() {
+    if (has_dbi)
+      mdb_dbi_close(env, dbi);
+    if (txn)
+      mdb_txn_abort(txn);
+    if (env)
+      mdb_env_close(env);
+  }
+};
+
 class IndexedLMDB {
-  MDB_env* mdb_env_ = nullptr;
+  std::shared_ptr<LMDBTransaction> transaction_;
   MDB_cursor* mdb_cursor_ = nullptr;
-  MDB_dbi mdb_dbi_;
-  MDB_txn* mdb_transaction_ = nullptr;
   int num_;
   Index mdb_index_;
   std::string db_path_;
@@ -44,25 +64,29 @@ class IndexedLMDB {
 
  public:
   void Open(const std::string& path, int num) {
-    DALI_ENFORCE(mdb_env_ == nullptr, "Previous MDB environment was not closed");
+    DALI_ENFORCE(transaction_ == nullptr, "Previous MDB environment was not closed");
     db_path_ = path;
     num_ = num;
-    CHECK_LMDB(mdb_env_create(&mdb_env_), db_path_);
+    auto t = std::make_shared<LMDBTransaction>();
+    CHECK_LMDB(mdb_env_create(&t->env), db_path_);
     auto mdb_flags = MDB_RDONLY | MDB_NOTLS | MDB_NOLOCK;
-    CHECK_LMDB(mdb_env_open(mdb_env_, path.c_str(), mdb_flags, 0664), db_path_);
+    CHECK_LMDB(mdb_env_open(t->env, path.c_str(), mdb_flags, 0664), db_path_);
 
     // Create transaction and cursor
-    CHECK_LMDB(mdb_txn_begin(mdb_env_, NULL, MDB_RDONLY, &mdb_transaction_), db_path_);
-    CHECK_LMDB(mdb_dbi_open(mdb_transaction_, NULL, 0, &mdb_dbi_), db_path_);
-    CHECK_LMDB(mdb_cursor_open(mdb_transaction_, mdb_dbi_, &mdb_cursor_), db_path_);
+    CHECK_LMDB(mdb_txn_begin(t->env, NULL, MDB_RDONLY, &t->txn), db_path_);
+    CHECK_LMDB(mdb_dbi_open(t->txn, NULL, 0, &t->dbi), db_path_);
+    t->has_dbi = true;
+    CHECK_LMDB(mdb_cursor_open(t->txn, t->dbi, &mdb_cursor_), db_path_);
     MDB_stat stat;
-    CHECK_LMDB(mdb_stat(mdb_transaction_, mdb_dbi_, &stat), db_path_);
+    CHECK_LMDB(mdb_stat(t->txn, t->dbi, &stat), db_path_);
+    transaction_ = std::move(t);
     mdb_size_ = stat.ms_entries;
     LOG_LINE << "lmdb " << num_ << " " << db_path_
              << " has " << mdb_size_ << " entries" << std::endl;
     mdb_index_ = 0;
   }
   size_t GetSize() const { return mdb_size_; }
+  const std::shared_ptr<LMDBTransaction>& Transaction() const { return transaction_; }
   Index GetIndex() const { return mdb_index_; }
   void SeekByIndex(Index index, MDB_val* key = nullptr, MDB_val* value = nullptr) {
     MDB_val tmp_key, tmp_value;
@@ -104,20 +128,16 @@ class IndexedLMDB {
     mdb_index_ = index;
   }
 
+  /**
+   * @brief Closes the cursor; the environment is closed when the samples sharing its values
+   *        are released
+   */
   void Close() {
     if (mdb_cursor_) {
       mdb_cursor_close(mdb_cursor_);
-      mdb_dbi_close(mdb_env_, mdb_dbi_);
       mdb_cursor_ = nullptr;
     }
-    if (mdb_transaction_) {
-      mdb_txn_abort(mdb_transaction_);
-      mdb_transaction_ = nullptr;
-    }
-    if (mdb_env_) {
-      mdb_env_close(mdb_env_);
-      mdb_env_ = nullptr;
-    }
+    transaction_.reset();
   }
 };
 
@@ -152,6 +172,7 @@ class LMDBLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
   }
 
   ~LMDBLoader() override {
+    WaitForPendingReads();
     for (size_t i = 0; i < mdb_.size(); i++) {
       mdb_[i].Close();
     }
@@ -165,6 +186,20 @@ class LMDBLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
   }
 
   void ReadSample(Tensor<CPUBackend>& tensor) override {
+    auto read = ReadSampleDeferred(tensor);
+    if (read)
+      read();
+  }
+
+  /**
+   * @brief Advances the cursor to the next entry; the value is read by the returned task
+   *
+   * The values are pointers into the memory map of the database, so the cursor walks only
+   * the keys and the pages of the values are read (faulted in) concurrently by the I/O
+   * workers. Unless `dont_use_mmap` is set, the sample shares the mapped value instead of
+   * copying it - the parsers only read it.
+   */
+  ReadTask ReadSampleDeferred(Tensor<CPUBackend>& tensor) override {
     // assume cursor is valid, read next, loop to start if necessary
 
     Index file_index, local_index;
@@ -192,14 +227,30 @@ class LMDBLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
       tensor.SetMeta(meta);
       tensor.set_type<uint8_t>();
       tensor.Resize({0});
-      return;
+      return {};
     }
 
+    Index size = static_cast<Index>(value.mv_size);
+    if (!copy_read_data_) {
+      // the data stays valid as long as the transaction, which the sample keeps alive
+      tensor.ShareData(std::shared_ptr<void>(mdb_[file_index].Transaction(), value.mv_data),
+                       size, {size});
+      tensor.set_type<uint8_t>();
+      tensor.SetMeta(meta);
+      return {};
+    }
+
+    if (tensor.shares_data()) {
+      tensor.Reset();
+    }
+    tensor.set_type<uint8_t>();
     tensor.SetMeta(meta);
-    tensor.Resize({static_cast<Index>(value.mv_size)});
-    std::memcpy(tensor.raw_mutable_data(),
-                reinterpret_cast<uint8_t*>(value.mv_data),
-                value.mv_size * sizeof(uint8_t));
+    tensor.Resize({size});
+    auto transaction = mdb_[file_index].Transaction();
+    const void* data = value.mv_data;
+    return [&tensor, transaction, data, size]() {
+      std::memcpy(tensor.raw_mutable_data(), data, size);
+    };
   }
 
  protected:
@@ -208,6 +259,7 @@ class LMDBLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
   }
 
   void PrepareMetadataImpl() override {
+    copy_read_data_ = dont_use_mmap_;
     offsets_.resize(db_paths_.size() + 1);
     offsets_[0] = 0;
     mdb_.resize(db_paths_.size());
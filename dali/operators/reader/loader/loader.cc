@@ -27,6 +27,15 @@ and then samples are selected randomly to form a batch.)code", false)
       R"code(Size of the buffer that is used for shuffling.
 
 If ``random_shuffle`` is False, this parameter is ignored.)code", 1024)
+  .AddOptionalArg("shuffle_indices",
+      R"code(If set to True together with ``random_shuffle``, the samples are read in the order
+of a random permutation of their indices, drawn anew for each pass through the shard,
+instead of being picked from the shuffling buffer.
+
+The shuffle of each shard is uniform and ``initial_fill`` is ignored, so the memory use
+doesn't depend on it. The samples don't move between the shards. Supported by the readers
+which know the number of samples up front: the file, COCO, numpy and TFRecord readers.
+Other readers issue a warning and use the shuffling buffer.)code", false)
   .AddOptionalArg("num_shards",
       R"code(Partitions the data into the specified number of parts (shards).
 
@@ -35,6 +44,14 @@ This is typically used for multi-GPU or multi-node training.)code", 1)
       R"code(Index of the shard to read.)code", 0)
   .AddOptionalArg("tensor_init_bytes",
       R"code(Hint for how much memory to allocate per image.)code", 1048576)
+  .AddOptionalArg("tensor_init_percentile",
+      R"code(Percentile of the sizes of the samples read so far, given as a fraction
+(e.g. 0.95 for the 95th percentile), used as the size of the new buffers instead of
+``tensor_init_bytes``, once enough samples have been read.
+
+The buffers returned by the reader are reallocated to this size when they are much larger, so
+that a few large samples don't hold their memory for the whole run. Set to 0 to always use
+``tensor_init_bytes``.)code", 0.95f)
   .AddOptionalArg("stick_to_shard",
       R"code(Determines whether the reader should stick to a data shard instead of going through
 the entire dataset.
@@ -71,7 +88,33 @@ the file in memory.
 
 Mapping provides a small performance benefit when accessing a local file system, but most network file
 systems, do not provide optimum performance.
-)code", false);
+)code", false)
+  .AddOptionalArg("num_io_threads",
+      R"code(Number of threads that read the samples concurrently.
+
+Increasing it helps when the latency of a single read is high, for example on a network file
+system. The order of the samples doesn't depend on this value. Readers that don't support
+concurrent reads ignore it.)code", 1)
+  .AddOptionalArg("skip_samples",
+      R"code(Number of samples to skip before the first one is returned.
+
+Used to resume reading from a checkpoint taken with ``Pipeline.reader_checkpoints()``, without
+going through the consumed samples again; the sample order is the same as if the reading
+had not been interrupted. The file and COCO readers only move their position, the other readers
+read and discard the skipped samples.
+
+Can't be used with ``pad_last_batch`` nor with the shuffling buffer, that is ``random_shuffle``
+without ``shuffle_indices``.)code", 0)
+  .AddOptionalArg("use_io_uring",
+      R"code(If set to True, the samples are read with io_uring.
+
+The reads of the samples that wait in the shuffling buffer are submitted to the kernel together,
+with a single system call, and they complete asynchronously. The data is always copied into
+the output, as with ``dont_use_mmap``. Takes precedence over ``num_io_threads``.
+
+If DALI was built without io_uring support or the kernel doesn't allow it, a warning
+is issued and the regular reads are used. Readers that don't support io_uring ignore it.)code",
+      false);
 
 size_t start_index(const size_t shard_id,
                    const size_t shard_num,
@@ -15,17 +15,23 @@
 #ifndef DALI_OPERATORS_READER_LOADER_LOADER_H_
 #define DALI_OPERATORS_READER_LOADER_LOADER_H_
 
+#include <algorithm>
+#include <functional>
+#include <future>
 #include <list>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <numeric>
 #include <random>
 #include <string>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 #include <deque>
 #include <atomic>
+#include <cstring>
 
 #include "dali/core/nvtx.h"
 #include "dali/core/common.h"
@@ -33,6 +39,13 @@
 #include "dali/pipeline/operator/op_spec.h"
 #include "dali/pipeline/data/tensor.h"
 #include "dali/operators/decoder/cache/image_cache_factory.h"
+#include "dali/operators/reader/loader/permutation_prefetcher.h"
+#include "dali/pipeline/util/size_histogram.h"
+#include "dali/pipeline/util/thread_pool.h"
+#include "dali/util/thread_safe_queue.h"
+#if IO_URING_ENABLED
+#include "dali/util/uring_file.h"
+#endif
 
 namespace dali {
 
@@ -54,12 +67,34 @@ class Loader {
  public:
   using LoadTargetUniquePtr = std::unique_ptr<LoadTarget>;
   using LoadTargetSharedPtr = std::shared_ptr<LoadTarget>;
+  /// The part of a sample read that can run concurrently with other reads
+  using ReadTask = std::function<void()>;
+
+  /**
+   * @brief A read of a sample data, issued by ReadSampleAsync
+   */
+  struct AsyncReadRequest {
+    int fd = -1;
+    int64 offset = 0;
+    int64 size = 0;
+    void *buffer = nullptr;
+    /// keeps the file open until the read completes
+    std::shared_ptr<void> file;
+    /// used in the error messages
+    std::string source_info;
+  };
+
   explicit Loader(const OpSpec& options)
     : shuffle_(options.GetArgument<bool>("random_shuffle")),
+      shuffle_indices_(shuffle_ && options.GetArgument<bool>("shuffle_indices")),
       initial_buffer_fill_(shuffle_ ? options.GetArgument<int>("initial_fill") : 1),
       initial_empty_size_(2 * options.GetArgument<int>("prefetch_queue_depth")
                           * options.GetArgument<int>("max_batch_size")),
       tensor_init_bytes_(options.GetArgument<int>("tensor_init_bytes")),
+      tensor_init_percentile_(options.GetArgument<float>("tensor_init_percentile")),
+      // every sample taken from here lands in sample_buffer_, while one leaves it for each,
+      // so there are never more than initial_empty_size_ tensors to return
+      empty_tensors_(std::max(initial_empty_size_, 1)),
       seed_(options.GetArgument<Index>("seed")),
       shard_id_(options.GetArgument<int>("shard_id")),
       num_shards_(options.GetArgument<int>("num_shards")),
@@ -73,9 +108,30 @@ class Loader {
       read_sample_counter_(0),
       returned_sample_counter_(0),
       pad_last_batch_(options.GetArgument<bool>("pad_last_batch")),
-      dont_use_mmap_(options.GetArgument<bool>("dont_use_mmap")) {
+      dont_use_mmap_(options.GetArgument<bool>("dont_use_mmap")),
+      num_io_threads_(options.GetArgument<int>("num_io_threads")),
+      skip_samples_(options.GetArgument<Index>("skip_samples")) {
     DALI_ENFORCE(initial_empty_size_ > 0, "Batch size needs to be greater than 0");
+    DALI_ENFORCE(skip_samples_ >= 0, "skip_samples needs to be non-negative");
+    if (skip_samples_ > 0) {
+      DALI_ENFORCE(!shuffle_ || shuffle_indices_, "skip_samples can't be used with "
+                   "the shuffling buffer, set shuffle_indices to shuffle the samples");
+      DALI_ENFORCE(!pad_last_batch_, "skip_samples can't be used together with pad_last_batch");
+    }
+    DALI_ENFORCE(num_io_threads_ > 0, "num_io_threads needs to be greater than 0");
+    DALI_ENFORCE(tensor_init_percentile_ >= 0 && tensor_init_percentile_ <= 1,
+                 "tensor_init_percentile needs to be in the range [0, 1]");
     DALI_ENFORCE(num_shards_ > shard_id_, "num_shards needs to be greater than shard_id");
+    if (options.GetArgument<bool>("use_io_uring")) {
+#if IO_URING_ENABLED
+      if (UringReadQueue::IsSupported())
+        uring_ = std::make_unique<UringReadQueue>();
+      else
+        DALI_WARN_ONCE("io_uring is not available, falling back to the regular reads.");
+#else
+      DALI_WARN_ONCE("DALI was built without io_uring support, falling back to the regular reads.");
+#endif
+    }
     // initialize a random distribution -- this will be
     // used to pick from our sample buffer
     std::seed_seq seq({seed_});
@@ -84,6 +140,7 @@ class Loader {
   }
 
   virtual ~Loader() {
+    WaitForPendingReads();
     sample_buffer_.clear();
     empty_tensors_.clear();
   }
@@ -106,7 +163,7 @@ class Loader {
   PrepareEmptyTensor(T& tensor) {
     tensor.set_pinned(false);
     // Initialize tensors to a set size to limit expensive reallocations
-    tensor.Resize({tensor_init_bytes_});
+    tensor.Resize({InitBytes()});
     tensor.template mutable_data<uint8_t>();
   }
 
@@ -118,32 +175,45 @@ class Loader {
   }
 
   // Get a random read sample
-  LoadTargetSharedPtr ReadOne(bool is_new_batch) {
+  virtual LoadTargetSharedPtr ReadOne(bool is_new_batch) {
     PrepareMetadata();
-    DomainTimeRange tr("[DALI][Loader] ReadOne", DomainTimeRange::kGreen1);
+    TraceRange tr(kTraceLoader, "[DALI][Loader] ReadOne", RangeBase::kGreen1);
     // perform an initial buffer fill if it hasn't already happened
     if (!initial_buffer_filled_) {
-      DomainTimeRange tr("[DALI][Loader] Filling initial buffer", DomainTimeRange::kBlue1);
+      TraceRange tr(kTraceLoader, "[DALI][Loader] Filling initial buffer", RangeBase::kBlue1);
       shards_.push_back({0, 0});
 
+      // Fast-forward past the samples consumed before the checkpoint; the samples are read
+      // in order, so only the position in the data set has to be restored
+      if (skip_samples_ > 0) {
+        TraceRange tr(kTraceLoader, "[DALI][Loader] Skipping samples", RangeBase::kBlue1);
+        for (Index i = 0; i < skip_samples_; ++i) {
+          SkipSample();
+          IncreaseReadSampleCounter();
+        }
+        // none of the skipped samples is left in the buffer
+        shards_.clear();
+        shards_.push_back({0, 0});
+      }
+
       // Read an initial number of samples to fill our
-      // sample buffer
-      for (int i = 0; i < initial_buffer_fill_; ++i) {
+      // sample buffer; with the shuffled indices, it only keeps the reads in flight
+      int initial_fill = shuffle_indices_ ? num_io_threads_ : initial_buffer_fill_;
+      for (int i = 0; i < initial_fill; ++i) {
         auto tensor_ptr = LoadTargetUniquePtr(new LoadTarget());
         PrepareEmpty(*tensor_ptr);
-        ReadSample(*tensor_ptr);
+        IssueRead(*tensor_ptr);
         IncreaseReadSampleCounter();
         sample_buffer_.push_back(std::move(tensor_ptr));
         ++shards_.back().end;
       }
 
       // need some entries in the empty_tensors_ list
-      DomainTimeRange tr2("[DALI][Loader] Filling empty list", DomainTimeRange::kOrange);
-      std::lock_guard<std::mutex> lock(empty_tensors_mutex_);
+      TraceRange tr2(kTraceLoader, "[DALI][Loader] Filling empty list", RangeBase::kOrange);
       for (int i = 0; i < initial_empty_size_; ++i) {
         auto tensor_ptr = LoadTargetUniquePtr(new LoadTarget());
         PrepareEmpty(*tensor_ptr);
-        empty_tensors_.push_back(std::move(tensor_ptr));
+        RecycleTensor(std::move(tensor_ptr));
       }
 
       initial_buffer_filled_ = true;
@@ -171,8 +241,10 @@ class Loader {
     std::uniform_int_distribution<> dis;
     dis = std::uniform_int_distribution<>(0, shards_.front().end - shards_.front().start - 1);
 
-    int offset = shuffle_ ? dis(e_) : 0;
+    int offset = shuffle_ && !shuffle_indices_ ? dis(e_) : 0;
     Index idx = (shards_.front().start + offset) % sample_buffer_.size();
+    WaitForRead(*sample_buffer_[idx]);
+    RecordSampleSize(*sample_buffer_[idx]);
     LoadTargetSharedPtr sample_ptr(sample_buffer_[idx].release(),
       [this](LoadTarget* sample) {
         LoadTargetUniquePtr recycle_ptr(sample);
@@ -180,16 +252,12 @@ class Loader {
     });
     std::swap(sample_buffer_[idx], sample_buffer_[shards_.front().start % sample_buffer_.size()]);
     // now grab an empty tensor, fill it and add to filled buffers
-    // empty_tensors_ needs to be thread-safe w.r.t. RecycleTensor()
-    // being called by multiple consumer threads
+    // empty_tensors_ is a lock-free queue, as RecycleTensor()
+    // is called by multiple consumer threads
     LoadTargetUniquePtr tensor_ptr;
-    {
-      std::lock_guard<std::mutex> lock(empty_tensors_mutex_);
-      DALI_ENFORCE(empty_tensors_.size() > 0, "No empty tensors - did you forget to return them?");
-      tensor_ptr = std::move(empty_tensors_.back());
-      empty_tensors_.pop_back();
-    }
-    ReadSample(*tensor_ptr);
+    bool has_empty = empty_tensors_.try_pop(tensor_ptr);
+    DALI_ENFORCE(has_empty, "No empty tensors - did you forget to return them?");
+    IssueRead(*tensor_ptr);
     IncreaseReadSampleCounter();
     std::swap(sample_buffer_[shards_.back().end % sample_buffer_.size()], tensor_ptr);
     ++shards_.back().end;
@@ -201,10 +269,15 @@ class Loader {
   }
 
   // return a tensor to the empty pile
-  // called by multiple consumer threads
+  // called by multiple consumer threads, also from the deleters of the returned samples,
+  // so it must not throw; the queue fits all the tensors, if it didn't, the tensor is just freed
   void RecycleTensor(LoadTargetUniquePtr&& tensor_ptr) {
-    std::lock_guard<std::mutex> lock(empty_tensors_mutex_);
-    empty_tensors_.push_back(std::move(tensor_ptr));
+    try {
+      FitToSampleSizes(*tensor_ptr);
+    } catch (...) {
+      // the reader grows the tensor when needed anyway
+    }
+    empty_tensors_.try_push(std::move(tensor_ptr));
   }
 
   // Read an actual sample from the FileStore,
@@ -212,10 +285,61 @@ class Loader {
   // reads.
   virtual void ReadSample(LoadTarget& tensor) = 0;
 
+  /**
+   * @brief Starts reading the next sample into `tensor`
+   *
+   * Loaders that can read the samples concurrently override it to do here only the sequential
+   * part - choosing the next sample and advancing the position in the data set - and return
+   * the rest of the read, which is then run by one of the `num_io_threads` workers.
+   * The returned task must not use the state of the loader that changes between the samples.
+   * The samples are still read in a deterministic order, they only complete out of order.
+   *
+   * The default implementation reads the sample right away and returns an empty task.
+   */
+  virtual ReadTask ReadSampleDeferred(LoadTarget& tensor) {
+    ReadSample(tensor);
+    return {};
+  }
+
+  /**
+   * @brief Starts reading the next sample into `tensor` with io_uring
+   *
+   * Used instead of ReadSampleDeferred, when `use_io_uring` is set. Loaders that support it
+   * do the sequential part of the read, prepare the `tensor` to receive the data and describe
+   * the read in `request`. The reads are submitted in batches and `tensor` is not accessed
+   * until its read completes.
+   *
+   * The default implementation reads the sample right away.
+   *
+   * @return true, if the data needs to be read as described by `request`
+   */
+  virtual bool ReadSampleAsync(LoadTarget& tensor, AsyncReadRequest& request) {
+    ReadSample(tensor);
+    return false;
+  }
+
+  /**
+   * @brief Checks if the reads are issued with ReadSampleAsync
+   */
+  bool UsesIoUring() const {
+#if IO_URING_ENABLED
+    return uring_ != nullptr;
+#else
+    return false;
+#endif
+  }
+
   void PrepareMetadata() {
     if (!loading_flag_) {
       std::lock_guard<std::mutex> l(prepare_metadata_mutex_);
       if (!loading_flag_) {
+        if (shuffle_indices_ && !SupportsShuffleIndices()) {
+          DALI_WARN_ONCE("This reader doesn't support `shuffle_indices`, "
+                         "falling back to the shuffling buffer.");
+          shuffle_indices_ = false;
+          DALI_ENFORCE(skip_samples_ == 0, "skip_samples can't be used with "
+                       "the shuffling buffer");
+        }
         PrepareMetadataImpl();
         std::atomic_thread_fence(std::memory_order_release);
         loading_flag_ = true;
@@ -249,11 +373,95 @@ class Loader {
     return stick_to_shard_;
   }
 
+  /**
+   * @brief Moves the loader to another shard, keeping the metadata of the data set
+   *
+   * The samples read ahead from the current shard are discarded and the new shard is read
+   * from its beginning, in the order of the next epoch. The loaders resharded at the same epoch
+   * use the same order of the whole data set, so their new shards stay disjoint.
+   * Must not be called concurrently with ReadOne.
+   */
+  virtual void Reshard(int shard_id, int num_shards) {
+    DALI_ENFORCE(num_shards > 0, "num_shards needs to be greater than 0");
+    DALI_ENFORCE(shard_id >= 0 && shard_id < num_shards,
+                 make_string("shard_id needs to be in range [0, ", num_shards, "), got ",
+                             shard_id, "."));
+    WaitForPendingReads();
+    for (auto &tensor : sample_buffer_) {
+      if (tensor)
+        RecycleTensor(std::move(tensor));
+    }
+    sample_buffer_.clear();
+    shards_.clear();
+    initial_buffer_filled_ = false;
+    last_sample_ptr_tmp.reset();
+    read_sample_counter_ = 0;
+    returned_sample_counter_ = 0;
+    shard_id_ = shard_id;
+    num_shards_ = num_shards;
+    virtual_shard_id_ = shard_id;
+    index_permutations_.SetGenerator(ShardedPermutations(seed_, num_shards_));
+    // otherwise, the first shard is chosen when the metadata is prepared
+    if (loading_flag_)
+      Reset(true);
+  }
+
  protected:
   virtual Index SizeImpl() = 0;
 
   virtual void PrepareMetadataImpl() {}
 
+  /**
+   * @brief Advances the loader past the next sample, used to restore the position given by
+   *        `skip_samples`
+   *
+   * The default implementation reads the sample and discards it. Loaders that can move
+   * to the next sample without reading it should override it.
+   */
+  virtual void SkipSample() {
+    LoadTarget target;
+    PrepareEmpty(target);
+    ReadSample(target);
+  }
+
+  /**
+   * @brief Checks if the loader reads the samples in the order given by SampleIndex
+   *
+   * Such loaders call ShuffleIndices in their Reset.
+   */
+  virtual bool SupportsShuffleIndices() const {
+    return false;
+  }
+
+  /**
+   * @brief Maps the position in the data set to the index of the sample to read
+   */
+  Index SampleIndex(Index position) const {
+    return permutation_.empty() ? position : permutation_[position];
+  }
+
+  /**
+   * @brief Draws a new permutation of the samples of each shard, when `shuffle_indices` is set
+   *
+   * The samples don't move between the shards, so the shards stay disjoint, regardless of
+   * the seeds of the readers. Each pass through a shard reads it in a different order.
+   * The permutation of the next pass is drawn in the background.
+   */
+  void ShuffleIndices() {
+    if (!shuffle_indices_)
+      return;
+    permutation_ = index_permutations_.Get(SizeImpl(), permutation_epoch_++);
+  }
+
+  /**
+   * @brief Shuffles the items for `shuffle_after_epoch` as std::shuffle with
+   *        std::mt19937(kDaliDataloaderSeed + epoch) would, with the order drawn one epoch ahead
+   */
+  template <typename T>
+  void ShuffleAfterEpoch(std::vector<T> &items, int epoch) {
+    ApplyPermutation(items, epoch_shuffles_.Get(items.size(), epoch));
+  }
+
   virtual void MoveToNextShard(Index current_index) {
     if (IsNextShard(current_index)) {
       Reset(stick_to_shard_);
@@ -293,6 +501,82 @@ class Loader {
     }
   }
 
+  /**
+   * @brief Waits for all the reads issued to the I/O workers; the errors are discarded
+   *
+   * The loaders whose read tasks use their members need to call it in their destructors.
+   */
+  void WaitForPendingReads() noexcept {
+    for (auto &read : pending_reads_) {
+      try {
+        read.second.get();
+      } catch (...) {}
+    }
+    pending_reads_.clear();
+#if IO_URING_ENABLED
+    if (uring_) {
+      try {
+        while (uring_->Pending() > 0) {
+          uring_->Reap(uring_completions_, true);
+          uring_completions_.clear();
+        }
+      } catch (...) {}
+      uring_reads_.clear();
+    }
+#endif
+  }
+
+  /**
+   * @brief The size of the new tensors: `tensor_init_percentile` of the sizes of the samples
+   *        read so far or, until enough of them is known, `tensor_init_bytes`
+   */
+  int64_t InitBytes() const {
+    int64_t adaptive = adaptive_init_bytes_.load(std::memory_order_relaxed);
+    return adaptive > 0 ? adaptive : tensor_init_bytes_;
+  }
+
+  template <typename T>
+  std::enable_if_t<std::is_same<T, Tensor<GPUBackend>>::value ||
+                   std::is_same<T, Tensor<CPUBackend>>::value>
+  RecordSampleSize(const T& tensor) {
+    if (tensor_init_percentile_ == 0)
+      return;
+    sample_sizes_.Add(tensor.nbytes());
+    if (sample_sizes_.count() >= kMinSampleSizes &&
+        sample_sizes_.count() % kSampleSizeUpdateInterval == 0) {
+      adaptive_init_bytes_.store(sample_sizes_.Percentile(tensor_init_percentile_),
+                                 std::memory_order_relaxed);
+    }
+  }
+
+  template <typename T>
+  std::enable_if_t<!(std::is_same<T, Tensor<CPUBackend>>::value ||
+                     std::is_same<T, Tensor<GPUBackend>>::value)>
+  RecordSampleSize(const T&) {}
+
+  /**
+   * @brief Reallocates a recycled tensor to InitBytes, if it's smaller or much larger,
+   *        so that a few large samples don't keep their buffers for the whole run
+   *
+   * Only the host tensors are adapted, as it's called from the consumer threads.
+   */
+  template <typename T>
+  std::enable_if_t<std::is_same<T, Tensor<CPUBackend>>::value>
+  FitToSampleSizes(T& tensor) {
+    int64_t target = adaptive_init_bytes_.load(std::memory_order_relaxed);
+    if (target <= 0 || tensor.shares_data())
+      return;
+    int64_t capacity = tensor.capacity();
+    if (capacity >= target && capacity <= kMaxOverallocation * target)
+      return;
+    tensor.Reset();
+    PrepareEmpty(tensor);
+  }
+
+  template <typename T>
+  std::enable_if_t<!std::is_same<T, Tensor<CPUBackend>>::value>
+  FitToSampleSizes(T&) {}
+
   bool ShouldSkipImage(const ImageCache::ImageKey& key) {
     if (!skip_cached_images_)
       return false;
@@ -310,26 +594,36 @@ class Loader {
 
   std::vector<LoadTargetUniquePtr> sample_buffer_;
 
-  std::vector<LoadTargetUniquePtr> empty_tensors_;
-
   // number of samples to initialize buffer with
   // ~1 minibatch seems reasonable
   bool shuffle_;
+  // if the samples are read in the order of a permutation of the indices, instead of being
+  // picked from the sample buffer, see ShuffleIndices
+  bool shuffle_indices_;
   const int initial_buffer_fill_;
   const int initial_empty_size_;
   const int tensor_init_bytes_;
+  // the percentile of the sample sizes used as the size of the new tensors, 0 if disabled
+  const float tensor_init_percentile_;
+  static constexpr int kMinSampleSizes = 64;
+  static constexpr int kSampleSizeUpdateInterval = 64;
+  // how much larger than InitBytes a recycled tensor can be, before it's reallocated
+  static constexpr int kMaxOverallocation = 4;
+  // the sizes of the samples read, used only by the prefetch thread
+  SizeHistogram sample_sizes_;
+  std::atomic<int64_t> adaptive_init_bytes_{0};
+
+  // control return of tensors - filled by the consumer threads, drained by the prefetch thread
+  BoundedLockFreeQueue<LoadTargetUniquePtr> empty_tensors_;
   bool initial_buffer_filled_ = false;
 
   // rng
   std::default_random_engine e_;
   Index seed_;
 
-  // control return of tensors
-  std::mutex empty_tensors_mutex_;
-
-  // sharding
-  const int shard_id_;
-  const int num_shards_;
+  // sharding, see Reshard
+  int shard_id_;
+  int num_shards_;
 
   // if read data need to be copied or can be just shared with tensor
   bool copy_read_data_;
@@ -377,6 +671,123 @@ class Loader {
   };
 
   std::deque<ShardBoundaries> shards_;
+
+  // the order of the samples, when shuffle_indices_ is set
+  std::vector<Index> permutation_;
+  int64_t permutation_epoch_ = 0;
+
+  // Number of threads reading the samples concurrently, see ReadSampleDeferred
+  const int num_io_threads_;
+
+  // Number of samples skipped at the start, see SkipSample
+  const Index skip_samples_;
+
+ private:
+  // the next permutations are drawn while the current epoch is read, see PermutationPrefetcher
+  PermutationPrefetcher index_permutations_{ShardedPermutations(seed_, num_shards_)};
+  PermutationPrefetcher epoch_shuffles_{[](Index size, int64_t epoch) {
+    return ShufflePermutation(size, kDaliDataloaderSeed + epoch);
+  }};
+
+  static PermutationPrefetcher::Generator ShardedPermutations(Index seed, int num_shards) {
+    return [seed, num_shards](Index size, int64_t epoch) {
+      std::vector<Index> permutation(size);
+      std::iota(permutation.begin(), permutation.end(), 0);
+      std::mt19937_64 g(seed + epoch);
+      for (int shard = 0; shard < num_shards; shard++) {
+        std::shuffle(permutation.begin() + start_index(shard, num_shards, size),
+                     permutation.begin() + start_index(shard + 1, num_shards, size), g);
+      }
+      return permutation;
+    };
+  }
+
+  void IssueRead(LoadTarget &tensor) {
+#if IO_URING_ENABLED
+    if (uring_) {
+      AsyncReadRequest request;
+      if (!ReadSampleAsync(tensor, request))
+        return;
+      // submitted together with the other reads by the next WaitForRead
+      uring_->Enqueue(request.fd, request.offset, request.buffer, request.size,
+                      reinterpret_cast<uint64_t>(&tensor));
+      uring_reads_.emplace(&tensor, UringRead{std::move(request), false, 0});
+      return;
+    }
+#endif
+    if (num_io_threads_ == 1) {
+      TraceRange tr(kTraceLoader, "[DALI][Loader] Read", RangeBase::kCyan);
+      ReadSample(tensor);
+      return;
+    }
+    auto read = ReadSampleDeferred(tensor);
+    if (!read)
+      return;
+    if (!io_thread_pool_)
+      io_thread_pool_ = std::make_unique<ThreadPool>(num_io_threads_, device_id_, false);
+    auto task = std::make_shared<std::packaged_task<void()>>(std::move(read));
+    pending_reads_.emplace(&tensor, task->get_future());
+    // the reads issued earlier are needed earlier
+    io_thread_pool_->AddWork([task](int) {
+      TraceRange tr(kTraceLoader, "[DALI][Loader] Read", RangeBase::kCyan);
+      (*task)();
+    }, -(issued_reads_++), true);
+  }
+
+  // rethrows the error of the read, if there was one
+  void WaitForRead(const LoadTarget &tensor) {
+#if IO_URING_ENABLED
+    if (uring_) {
+      WaitForUringRead(tensor);
+      return;
+    }
+#endif
+    auto it = pending_reads_.find(&tensor);
+    if (it == pending_reads_.end())
+      return;
+    auto read = std::move(it->second);
+    pending_reads_.erase(it);
+    read.get();
+  }
+
+#if IO_URING_ENABLED
+  void WaitForUringRead(const LoadTarget &tensor) {
+    auto it = uring_reads_.find(&tensor);
+    if (it == uring_reads_.end())
+      return;
+    while (!it->second.done) {
+      // submits everything that was issued since the last wait
+      uring_->Reap(uring_completions_, true);
+      for (auto &completion : uring_completions_) {
+        auto &read = uring_reads_.at(reinterpret_cast<const LoadTarget*>(completion.tag));
+        read.done = true;
+        read.result = completion.result;
+      }
+      uring_completions_.clear();
+    }
+    auto read = std::move(it->second);
+    uring_reads_.erase(it);
+    DALI_ENFORCE(read.result >= 0, make_string("Error reading from a file ",
+                 read.request.source_info, ": ", std::strerror(-read.result)));
+    DALI_ENFORCE(read.result == read.request.size, make_string("Error reading from a file ",
+                 read.request.source_info, ": unexpected end of file"));
+  }
+
+  struct UringRead {
+    AsyncReadRequest request;
+    bool done;
+    int64 result;
+  };
+
+  std::unique_ptr<UringReadQueue> uring_;
+  std::unordered_map<const LoadTarget*, UringRead> uring_reads_;
+  std::vector<UringCompletion> uring_completions_;
+#endif
+
+  std::unique_ptr<ThreadPool> io_thread_pool_;
+  // the tensors in the sample buffer, that are still being read
+  std::unordered_map<const LoadTarget*, std::future<void>> pending_reads_;
+  int64_t issued_reads_ = 0;
 };
 
 template<typename T, typename... Args>
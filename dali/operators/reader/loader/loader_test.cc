@@ -13,7 +13,12 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "dali/core/common.h"
 #include "dali/pipeline/data/backend.h"
@@ -21,10 +26,12 @@
 #include "dali/test/dali_test.h"
 
 #include "dali/operators/reader/loader/loader.h"
+#include "dali/operators/reader/loader/permutation_prefetcher.h"
 #include "dali/operators/reader/loader/file_label_loader.h"
 #include "dali/operators/reader/loader/recordio_loader.h"
 #include "dali/operators/reader/loader/indexed_file_loader.h"
 #include "dali/operators/reader/loader/coco_loader.h"
+#include "dali/operators/reader/loader/mixture_loader.h"
 
 #if LMDB_ENABLED
 #include "dali/operators/reader/loader/lmdb.h"
@@ -64,6 +71,58 @@ TYPED_TEST(DataLoadStoreTest, LMDBTest) {
 }
 #endif
 
+#if LMDB_ENABLED
+TYPED_TEST(DataLoadStoreTest, LMDBSharedAndParallelReads) {
+  auto read_samples = [&](bool dont_use_mmap, int num_io_threads) {
+    LMDBLoader reader(
+        OpSpec("CaffeReader")
+        .AddArg("max_batch_size", 8)
+        .AddArg("path", testing::dali_extra_path() + "/db/c2lmdb/")
+        .AddArg("device_id", 0)
+        .AddArg("random_shuffle", true)
+        .AddArg("initial_fill", 16)
+        .AddArg("seed", 123)
+        .AddArg("dont_use_mmap", dont_use_mmap)
+        .AddArg("num_io_threads", num_io_threads));
+    reader.PrepareMetadata();
+    std::vector<std::pair<std::string, std::vector<uint8_t>>> samples;
+    for (int i = 0; i < 50; ++i) {
+      auto sample = reader.ReadOne(i % 8 == 0);
+      EXPECT_EQ(sample->shares_data(), !dont_use_mmap);
+      auto *data = sample->template data<uint8_t>();
+      samples.emplace_back(sample->GetSourceInfo(),
+                           std::vector<uint8_t>(data, data + sample->size()));
+    }
+    return samples;
+  };
+  auto copied = read_samples(true, 1);
+  EXPECT_EQ(copied, read_samples(false, 1));
+  EXPECT_EQ(copied, read_samples(true, 4));
+}
+
+TYPED_TEST(DataLoadStoreTest, LMDBSharedSampleOutlivesLoader) {
+  std::shared_ptr<Tensor<CPUBackend>> sample;
+  std::vector<uint8_t> expected;
+  {
+    LMDBLoader reader(
+        OpSpec("CaffeReader")
+        .AddArg("max_batch_size", 8)
+        .AddArg("path", testing::dali_extra_path() + "/db/c2lmdb/")
+        .AddArg("device_id", 0));
+    reader.PrepareMetadata();
+    auto shared = reader.ReadOne(false);
+    ASSERT_TRUE(shared->shares_data());
+    // a copy of the tensor, which shares the mapped value, but not the loader's deleter
+    sample = std::make_shared<Tensor<CPUBackend>>();
+    sample->ShareData(shared.get());
+    auto *data = shared->template data<uint8_t>();
+    expected.assign(data, data + shared->size());
+  }
+  auto *data = sample->template data<uint8_t>();
+  EXPECT_EQ(std::vector<uint8_t>(data, data + sample->size()), expected);
+}
+#endif
+
 TYPED_TEST(DataLoadStoreTest, FileLabelLoaderMmmap) {
   for (bool dont_use_mmap : {true, false}) {
     shared_ptr<dali::FileLabelLoader> reader(
@@ -118,6 +177,210 @@ TYPED_TEST(DataLoadStoreTest, TFRecordLoaderMmmap) {
   }
 }
 
+TYPED_TEST(DataLoadStoreTest, ParallelReadsKeepOrder) {
+  std::vector<std::string> path = {testing::dali_extra_path() + "/db/tfrecord/train"};
+  std::vector<std::string> index_path = {testing::dali_extra_path() + "/db/tfrecord/train.idx"};
+  auto read_sources = [&](int num_io_threads) {
+    auto spec = OpSpec("TFRecordReader")
+                .AddArg("path", path)
+                .AddArg("index_path", index_path)
+                .AddArg("max_batch_size", 8)
+                .AddArg("device_id", 0)
+                .AddArg("random_shuffle", true)
+                .AddArg("initial_fill", 16)
+                .AddArg("seed", 123)
+                .AddArg("num_io_threads", num_io_threads);
+    IndexedFileLoader reader(spec);
+    reader.PrepareMetadata();
+    std::vector<std::pair<std::string, int64_t>> sources;
+    for (int i = 0; i < 100; ++i) {
+      auto sample = reader.ReadOne(i % 8 == 0);
+      sources.emplace_back(sample->GetSourceInfo(), sample->size());
+    }
+    return sources;
+  };
+  EXPECT_EQ(read_sources(1), read_sources(4));
+}
+
+TYPED_TEST(DataLoadStoreTest, ShuffleIndices) {
+  std::vector<std::string> path = {testing::dali_extra_path() + "/db/tfrecord/train"};
+  std::vector<std::string> index_path = {testing::dali_extra_path() + "/db/tfrecord/train.idx"};
+  auto read_epochs = [&](bool shuffle_indices, int num_io_threads) {
+    auto spec = OpSpec("TFRecordReader")
+                .AddArg("path", path)
+                .AddArg("index_path", index_path)
+                .AddArg("max_batch_size", 8)
+                .AddArg("device_id", 0)
+                .AddArg("num_shards", 2)
+                .AddArg("shard_id", 1)
+                .AddArg("stick_to_shard", true)
+                .AddArg("random_shuffle", shuffle_indices)
+                .AddArg("shuffle_indices", shuffle_indices)
+                .AddArg("seed", 123)
+                .AddArg("num_io_threads", num_io_threads);
+    IndexedFileLoader reader(spec);
+    reader.PrepareMetadata();
+    Index shard_size = reader.Size() - start_index(1, 2, reader.Size());
+    std::vector<std::vector<std::string>> epochs(2);
+    for (auto &epoch : epochs) {
+      for (Index i = 0; i < shard_size; ++i)
+        epoch.push_back(reader.ReadOne(i % 8 == 0)->GetSourceInfo());
+    }
+    return epochs;
+  };
+  auto sequential = read_epochs(false, 1);
+  auto shuffled = read_epochs(true, 1);
+  EXPECT_EQ(shuffled, read_epochs(true, 4));
+  // each pass is a different permutation of the samples of the shard
+  EXPECT_NE(shuffled[0], sequential[0]);
+  EXPECT_NE(shuffled[0], shuffled[1]);
+  for (auto &epoch : shuffled) {
+    auto sorted = epoch;
+    std::sort(sorted.begin(), sorted.end());
+    auto expected = sequential[0];
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(sorted, expected);
+  }
+}
+
+TYPED_TEST(DataLoadStoreTest, Reshard) {
+  auto spec = OpSpec("FileReader")
+              .AddArg("file_root", loader_test_image_folder)
+              .AddArg("max_batch_size", 8)
+              .AddArg("device_id", 0)
+              .AddArg("num_shards", 1)
+              .AddArg("shard_id", 0);
+  std::vector<std::string> all, resharded;
+  for (int shard_id = 0; shard_id < 3; shard_id++) {
+    FileLabelLoader reader(spec, true);
+    reader.PrepareMetadata();
+    Index size = reader.Size();
+    // go through the first epoch
+    std::vector<std::string> epoch;
+    for (Index i = 0; i < size; ++i)
+      epoch.push_back(reader.ReadOne(i % 8 == 0)->GetSourceInfo());
+    if (all.empty())
+      all = epoch;
+    reader.Reshard(shard_id, 3);
+    EXPECT_EQ(reader.GetShardId(), shard_id);
+    EXPECT_EQ(reader.GetNumShards(), 3);
+    Index shard_size = start_index(shard_id + 1, 3, size) - start_index(shard_id, 3, size);
+    for (Index i = 0; i < shard_size; ++i)
+      resharded.push_back(reader.ReadOne(i % 8 == 0)->GetSourceInfo());
+  }
+  // the readers resharded at the same point split the data set into disjoint shards
+  std::sort(all.begin(), all.end());
+  std::sort(resharded.begin(), resharded.end());
+  EXPECT_EQ(resharded, all);
+  EXPECT_THROW(FileLabelLoader(spec).Reshard(3, 3), std::exception);
+}
+
+TEST(PermutationPrefetcherTest, SameAsSynchronous) {
+  auto generator = [](Index size, int64_t epoch) {
+    return ShufflePermutation(size, static_cast<uint32_t>(123 + epoch));
+  };
+  PermutationPrefetcher prefetcher(generator);
+  // consecutive epochs come from the background, the others are drawn on demand
+  for (int64_t epoch : {0, 1, 2, 5, 6, 3}) {
+    EXPECT_EQ(prefetcher.Get(100, epoch), generator(100, epoch));
+  }
+  EXPECT_EQ(prefetcher.Get(50, 4), generator(50, 4));
+}
+
+TEST(PermutationPrefetcherTest, ApplyPermutationMatchesShuffle) {
+  std::vector<std::string> items, shuffled;
+  for (int i = 0; i < 100; i++)
+    items.push_back(std::to_string(i));
+  shuffled = items;
+  std::mt19937 g(kDaliDataloaderSeed + 3);
+  std::shuffle(shuffled.begin(), shuffled.end(), g);
+  ApplyPermutation(items, ShufflePermutation(items.size(), kDaliDataloaderSeed + 3));
+  EXPECT_EQ(items, shuffled);
+}
+
+template <typename LoaderType>
+std::vector<std::string> ReadSourceInfo(OpSpec spec, Index skip_samples, Index count) {
+  LoaderType reader(spec.AddArg("skip_samples", skip_samples));
+  reader.PrepareMetadata();
+  std::vector<std::string> ret;
+  for (Index i = 0; i < count; ++i)
+    ret.push_back(reader.ReadOne(i % 8 == 0)->GetSourceInfo());
+  return ret;
+}
+
+TYPED_TEST(DataLoadStoreTest, SkipSamples) {
+  auto file_spec = OpSpec("FileReader")
+                   .AddArg("file_root", loader_test_image_folder)
+                   .AddArg("max_batch_size", 8)
+                   .AddArg("device_id", 0)
+                   .AddArg("num_shards", 3)
+                   .AddArg("shard_id", 1)
+                   .AddArg("random_shuffle", true)
+                   .AddArg("shuffle_indices", true)
+                   .AddArg("seed", 123);
+  auto tfrecord_spec = OpSpec("TFRecordReader")
+                       .AddArg("path", std::vector<std::string>{
+                          testing::dali_extra_path() + "/db/tfrecord/train"})
+                       .AddArg("index_path", std::vector<std::string>{
+                          testing::dali_extra_path() + "/db/tfrecord/train.idx"})
+                       .AddArg("max_batch_size", 8)
+                       .AddArg("device_id", 0)
+                       .AddArg("num_shards", 2)
+                       .AddArg("shard_id", 0);
+  // go through a few epochs, so the resumed reading has to cross the shard boundaries
+  Index total = 100;
+  for (Index skip : {0, 1, 37, 60}) {
+    auto all = ReadSourceInfo<FileLabelLoader>(file_spec, 0, total);
+    auto resumed = ReadSourceInfo<FileLabelLoader>(file_spec, skip, total - skip);
+    EXPECT_EQ(resumed, std::vector<std::string>(all.begin() + skip, all.end()));
+
+    all = ReadSourceInfo<IndexedFileLoader>(tfrecord_spec, 0, total);
+    resumed = ReadSourceInfo<IndexedFileLoader>(tfrecord_spec, skip, total - skip);
+    EXPECT_EQ(resumed, std::vector<std::string>(all.begin() + skip, all.end()));
+  }
+
+  // the shuffling buffer can't be restored
+  EXPECT_THROW(FileLabelLoader(OpSpec("FileReader")
+                               .AddArg("file_root", loader_test_image_folder)
+                               .AddArg("max_batch_size", 8)
+                               .AddArg("device_id", 0)
+                               .AddArg("random_shuffle", true)
+                               .AddArg("skip_samples", 10)), std::exception);
+}
+
+#if IO_URING_ENABLED
+TYPED_TEST(DataLoadStoreTest, IoUringReadsMatch) {
+  if (!UringReadQueue::IsSupported())
+    GTEST_SKIP() << "io_uring is not available";
+  std::vector<std::string> path = {testing::dali_extra_path() + "/db/tfrecord/train"};
+  std::vector<std::string> index_path = {testing::dali_extra_path() + "/db/tfrecord/train.idx"};
+  auto read_samples = [&](bool use_io_uring) {
+    auto spec = OpSpec("TFRecordReader")
+                .AddArg("path", path)
+                .AddArg("index_path", index_path)
+                .AddArg("max_batch_size", 8)
+                .AddArg("device_id", 0)
+                .AddArg("random_shuffle", true)
+                .AddArg("initial_fill", 16)
+                .AddArg("seed", 123)
+                .AddArg("dont_use_mmap", true)
+                .AddArg("use_io_uring", use_io_uring);
+    IndexedFileLoader reader(spec);
+    reader.PrepareMetadata();
+    EXPECT_EQ(reader.UsesIoUring(), use_io_uring);
+    std::vector<std::pair<std::string, std::vector<uint8_t>>> samples;
+    for (int i = 0; i < 100; ++i) {
+      auto sample = reader.ReadOne(i % 8 == 0);
+      auto *data = sample->template data<uint8_t>();
+      samples.emplace_back(sample->GetSourceInfo(),
+                           std::vector<uint8_t>(data, data + sample->size()));
+    }
+    return samples;
+  };
+  EXPECT_EQ(read_samples(false), read_samples(true));
+}
+#endif
+
 TYPED_TEST(DataLoadStoreTest, CocoLoaderMmmap) {
   for (bool dont_use_mmap : {true, false}) {
     std::string file_root = testing::dali_extra_path() + "/db/coco/images";
@@ -153,6 +416,53 @@ TYPED_TEST(DataLoadStoreTest, LoaderTest) {
   }
 }
 
+TYPED_TEST(DataLoadStoreTest, MixtureLoader) {
+  std::vector<std::string> roots = {loader_test_image_folder,
+                                    testing::dali_extra_path() + "/db/single/jpeg2k"};
+  auto spec = OpSpec("FileReader")
+              .AddArg("max_batch_size", 8)
+              .AddArg("device_id", 0)
+              .AddArg("random_shuffle", true)
+              .AddArg("seed", 123);
+  using Mixture = MixtureLoader<CPUBackend, ImageLabelWrapper>;
+  auto make_mixture = [&](std::vector<float> weights) {
+    std::vector<std::unique_ptr<Loader<CPUBackend, ImageLabelWrapper>>> loaders;
+    for (auto &root : roots)
+      loaders.push_back(InitLoader<FileLabelLoader>(OpSpec(spec).AddArg("file_root", root)));
+    return InitLoader<Mixture>(spec, std::move(loaders), std::move(weights));
+  };
+  auto read_epochs = [&](Mixture &mixture, int num_epochs) {
+    std::vector<std::vector<std::string>> epochs(num_epochs);
+    for (auto &epoch : epochs) {
+      for (Index i = 0; i < mixture.Size(); ++i)
+        epoch.push_back(mixture.ReadOne(i % 8 == 0)->image.GetSourceInfo());
+    }
+    return epochs;
+  };
+  auto from = [](const std::string &root, const std::vector<std::string> &epoch) {
+    return std::all_of(epoch.begin(), epoch.end(), [&](const std::string &source) {
+      return source.compare(0, root.size() + 1, root + "/") == 0;
+    });
+  };
+
+  // the weights of the first epoch pick only the first data set, then only the second one
+  auto switching = make_mixture({1, 0, 0, 1});
+  auto epochs = read_epochs(*switching, 3);
+  EXPECT_TRUE(from(roots[0], epochs[0]));
+  EXPECT_TRUE(from(roots[1], epochs[1]));
+  EXPECT_TRUE(from(roots[1], epochs[2]));
+
+  // the data sets are drawn with a seeded generator
+  auto mixed = read_epochs(*make_mixture({}), 2);
+  EXPECT_EQ(mixed, read_epochs(*make_mixture({}), 2));
+  EXPECT_FALSE(from(roots[0], mixed[0]));
+  EXPECT_FALSE(from(roots[1], mixed[0]));
+
+  EXPECT_THROW(make_mixture({1, 1, 1}), std::exception);
+  EXPECT_THROW(make_mixture({0, 0}), std::exception);
+  EXPECT_THROW(make_mixture({1, -1}), std::exception);
+}
+
 TYPED_TEST(DataLoadStoreTest, LoaderTestFail) {
   shared_ptr<dali::FileLabelLoader> reader(
       new FileLabelLoader(OpSpec("FileReader")
@@ -0,0 +1,133 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_READER_LOADER_MIXTURE_LOADER_H_
+#define DALI_OPERATORS_READER_LOADER_MIXTURE_LOADER_H_
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+#include "dali/operators/reader/loader/loader.h"
+
+namespace dali {
+
+/**
+ * @brief Draws the samples from several loaders, picking the loader of each sample at random,
+ *        with the given weights
+ *
+ * The loaders read their data sets as usual - each one with its own shuffling and the same
+ * sharding as the mixture, so the shards of the mixture stay disjoint. The mixture only chooses
+ * which of them returns the next sample, with a generator seeded with `seed`, so the order
+ * of the data sets is the same in every run.
+ *
+ * The weights can change between the epochs: `weights` holds `num_epochs` rows of one weight
+ * per loader; the epoch `e` uses the row `min(e, num_epochs - 1)`. An epoch of the mixture
+ * is as many samples as a shard of all the data sets together.
+ *
+ * The samples are not padded and can't be skipped, so `pad_last_batch` and `skip_samples`
+ * are not supported.
+ */
+template <typename Backend, typename LoadTarget>
+class MixtureLoader : public Loader<Backend, LoadTarget> {
+ public:
+  using Base = Loader<Backend, LoadTarget>;
+  using typename Base::LoadTargetSharedPtr;
+
+  MixtureLoader(const OpSpec &spec, std::vector<std::unique_ptr<Base>> loaders,
+                std::vector<float> weights)
+      : Base(spec), loaders_(std::move(loaders)), weights_(std::move(weights)),
+        rng_(this->seed_) {
+    int n = loaders_.size();
+    DALI_ENFORCE(n > 0, "The mixture needs at least one data set.");
+    DALI_ENFORCE(!this->pad_last_batch_, "pad_last_batch can't be used with a mixture of "
+                 "data sets.");
+    DALI_ENFORCE(this->skip_samples_ == 0, "skip_samples can't be used with a mixture of "
+                 "data sets.");
+    if (weights_.empty())
+      weights_.resize(n, 1.0f);
+    DALI_ENFORCE(weights_.size() % n == 0,
+                 make_string("Expected one weight per data set for each epoch, i.e. a multiple of ",
+                             n, " weights, got ", weights_.size(), "."));
+    for (size_t i = 0; i < weights_.size(); i += n) {
+      DALI_ENFORCE(std::all_of(&weights_[i], &weights_[i] + n, [](float w) { return w >= 0; }),
+                   "The weights of the data sets must not be negative.");
+      DALI_ENFORCE(std::any_of(&weights_[i], &weights_[i] + n, [](float w) { return w > 0; }),
+                   make_string("At least one data set needs a positive weight in the epoch ",
+                               i / n, "."));
+    }
+  }
+
+  LoadTargetSharedPtr ReadOne(bool is_new_batch) override {
+    this->PrepareMetadata();
+    if (epoch_sample_ == 0 || epoch_sample_ == epoch_size_) {
+      if (epoch_sample_ > 0)
+        epoch_++;
+      epoch_sample_ = 0;
+      int n = loaders_.size();
+      const float *w = &weights_[std::min<size_t>(epoch_, weights_.size() / n - 1) * n];
+      choice_ = std::discrete_distribution<int>(w, w + n);
+    }
+    epoch_sample_++;
+    return loaders_[choice_(rng_)]->ReadOne(is_new_batch);
+  }
+
+  void ReadSample(LoadTarget &) override {
+    DALI_FAIL("The samples of a mixture are read by its loaders.");
+  }
+
+  void Reshard(int shard_id, int num_shards) override {
+    for (auto &loader : loaders_)
+      loader->Reshard(shard_id, num_shards);
+    Base::Reshard(shard_id, num_shards);
+    epoch_sample_ = 0;
+    if (this->loading_flag_)
+      epoch_size_ = std::max<Index>(num_samples(num_shards, SizeImpl()), 1);
+  }
+
+ protected:
+  Index SizeImpl() override {
+    Index size = 0;
+    for (auto &loader : loaders_)
+      size += loader->Size();
+    return size;
+  }
+
+  void PrepareMetadataImpl() override {
+    for (auto &loader : loaders_)
+      loader->PrepareMetadata();
+    epoch_size_ = std::max<Index>(num_samples(this->num_shards_, SizeImpl()), 1);
+  }
+
+  // the loaders shuffle their samples themselves
+  bool SupportsShuffleIndices() const override {
+    return true;
+  }
+
+  void Reset(bool wrap_to_shard) override {}
+
+ private:
+  std::vector<std::unique_ptr<Base>> loaders_;
+  std::vector<float> weights_;
+  std::mt19937_64 rng_;
+  std::discrete_distribution<int> choice_;
+  Index epoch_size_ = 1;
+  Index epoch_sample_ = 0;
+  int64_t epoch_ = 0;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_READER_LOADER_MIXTURE_LOADER_H_
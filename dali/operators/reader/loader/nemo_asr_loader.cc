@@ -12,10 +12,12 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <string>
 #include <numeric>
 #include "dali/core/common.h"
 #include "dali/core/error_handling.h"
+#include "dali/core/util.h"
 #include "dali/operators/decoder/audio/generic_decoder.h"
 #include "dali/operators/decoder/audio/audio_decoder_impl.h"
 #include "dali/operators/reader/loader/nemo_asr_loader.h"
@@ -71,6 +73,46 @@ void ParseManifest(std::vector<NemoAsrEntry> &entries, std::istream& manifest_fi
   }
 }
 
+void BucketByDuration(std::vector<size_t> &indices, const std::vector<NemoAsrEntry> &entries,
+                      const std::vector<float> &boundaries, int batch_size, int window,
+                      std::mt19937 &rng) {
+  assert(batch_size > 0);
+  size_t window_size = div_ceil(std::max(window, batch_size), batch_size) * batch_size;
+  std::vector<std::vector<size_t>> buckets(boundaries.size() + 1);
+  std::vector<size_t> reordered, rest, groups;
+  for (size_t window_start = 0; window_start < indices.size(); window_start += window_size) {
+    size_t window_end = std::min(indices.size(), window_start + window_size);
+    for (auto &bucket : buckets)
+      bucket.clear();
+    for (size_t i = window_start; i < window_end; i++) {
+      double duration = entries[indices[i]].duration;
+      auto b = std::upper_bound(boundaries.begin(), boundaries.end(), duration);
+      buckets[b - boundaries.begin()].push_back(indices[i]);
+    }
+
+    reordered.clear();
+    rest.clear();
+    for (auto &bucket : buckets) {
+      std::shuffle(bucket.begin(), bucket.end(), rng);
+      size_t full = bucket.size() - bucket.size() % batch_size;
+      reordered.insert(reordered.end(), bucket.begin(), bucket.begin() + full);
+      rest.insert(rest.end(), bucket.begin() + full, bucket.end());
+    }
+    reordered.insert(reordered.end(), rest.begin(), rest.end());
+
+    size_t num_full_groups = reordered.size() / batch_size;
+    groups.resize(num_full_groups);
+    std::iota(groups.begin(), groups.end(), 0);
+    std::shuffle(groups.begin(), groups.end(), rng);
+    auto out = indices.begin() + window_start;
+    for (size_t g : groups) {
+      auto group_start = reordered.begin() + g * batch_size;
+      out = std::copy(group_start, group_start + batch_size, out);
+    }
+    std::copy(reordered.begin() + num_full_groups * batch_size, reordered.end(), out);
+  }
+}
+
 }  // namespace detail
 
 void NemoAsrLoader::PrepareMetadataImpl() {
@@ -101,6 +143,13 @@ void NemoAsrLoader::Reset(bool wrap_to_shard) {
     std::mt19937 g(kDaliDataloaderSeed + current_epoch_);
     std::shuffle(shuffled_indices_.begin(), shuffled_indices_.end(), g);
   }
+
+  if (!bucket_boundaries_.empty()) {
+    // the same seed in all the shards, so that they see the same order
+    std::mt19937 g(kDaliDataloaderSeed + bucketing_seed_ + current_epoch_);
+    detail::BucketByDuration(shuffled_indices_, entries_, bucket_boundaries_, batch_size_,
+                             bucketing_window_, g);
+  }
 }
 
 void NemoAsrLoader::PrepareEmpty(AsrSample &sample) {
@@ -161,7 +210,7 @@ void NemoAsrLoader::ReadSample(AsrSample& sample) {
   int64_t offset, length;
   std::tie(offset, length) =
       ProcessOffsetAndLength(meta, entry.offset, entry.duration);
-  assert(0 < length && length <= meta.length && "Unexpected length");
+  assert(0 <= length && length <= meta.length && "Unexpected length");
   meta.length = length;
 
   sample.shape_ = DecodedAudioShape(meta, sample_rate_, downmix_);
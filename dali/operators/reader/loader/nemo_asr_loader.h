@@ -19,6 +19,7 @@
 #include <future>
 #include <istream>
 #include <memory>
+#include <random>
 #include <string>
 #include <utility>
 #include <vector>
@@ -105,6 +106,21 @@ DLL_PUBLIC void ParseManifest(std::vector<NemoAsrEntry> &entries, std::istream &
                               double max_duration = kDefaultDuration,
                               bool read_text = true);
 
+/**
+ * @brief Reorders the samples so that consecutive groups of `batch_size` samples come from
+ *        a single duration bucket
+ *
+ * The indices are processed in windows of `window` samples, rounded up to a multiple of
+ * `batch_size`. Within a window, the samples are assigned to the buckets delimited by
+ * `boundaries` (ascending, in seconds), shuffled within the buckets and cut into groups of
+ * `batch_size`. The remainders of the buckets form the last, mixed groups of the window.
+ * The order of the full groups is shuffled; a partial group stays at the end of the window.
+ */
+DLL_PUBLIC void BucketByDuration(std::vector<size_t> &indices,
+                                 const std::vector<NemoAsrEntry> &entries,
+                                 const std::vector<float> &boundaries,
+                                 int batch_size, int window, std::mt19937 &rng);
+
 }  // namespace detail
 
 class DLL_PUBLIC NemoAsrLoader : public Loader<CPUBackend, AsrSample> {
@@ -120,6 +136,10 @@ class DLL_PUBLIC NemoAsrLoader : public Loader<CPUBackend, AsrSample> {
         min_duration_(spec.GetArgument<float>("min_duration")),
         max_duration_(spec.GetArgument<float>("max_duration")),
         read_text_(spec.GetArgument<bool>("read_text")),
+        bucket_boundaries_(spec.GetRepeatedArgument<float>("bucket_boundaries")),
+        bucketing_window_(spec.GetArgument<int>("bucketing_window")),
+        bucketing_seed_(spec.GetArgument<int>("bucketing_seed")),
+        batch_size_(spec.GetArgument<int>("max_batch_size")),
         num_threads_(std::max(1, spec.GetArgument<int>("num_threads"))),
         decode_scratch_(num_threads_),
         resample_scratch_(num_threads_) {
@@ -140,6 +160,14 @@ class DLL_PUBLIC NemoAsrLoader : public Loader<CPUBackend, AsrSample> {
     if (shuffle_after_epoch_)
       stick_to_shard_ = true;
 
+    if (!bucket_boundaries_.empty()) {
+      DALI_ENFORCE(!shuffle_, "`bucket_boundaries` and `random_shuffle` can't be provided "
+                              "together - the samples are shuffled within the buckets.");
+      DALI_ENFORCE(std::is_sorted(bucket_boundaries_.begin(), bucket_boundaries_.end()),
+                   "`bucket_boundaries` must be in ascending order.");
+      DALI_ENFORCE(bucketing_window_ > 0, "`bucketing_window` must be positive.");
+    }
+
     double q = quality_;
     DALI_ENFORCE(q >= 0 && q <= 100, "Resampling quality must be in [0..100] range");
     // this should give 3 lobes for q = 0, 16 lobes for q = 50 and 64 lobes for q = 100
@@ -180,6 +208,10 @@ class DLL_PUBLIC NemoAsrLoader : public Loader<CPUBackend, AsrSample> {
   double min_duration_;
   double max_duration_;
   bool read_text_;
+  std::vector<float> bucket_boundaries_;
+  int bucketing_window_;
+  int bucketing_seed_;
+  int batch_size_;
   int num_threads_;
   kernels::signal::resampling::Resampler resampler_;
   std::vector<std::vector<float>> decode_scratch_;
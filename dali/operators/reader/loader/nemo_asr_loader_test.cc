@@ -13,7 +13,10 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <cstdio>
+#include <numeric>
+#include <random>
 #include <utility>
 #include <sstream>
 #include <string>
@@ -180,6 +183,49 @@ TEST(NemoAsrLoaderTest, ParseManifestContent) {
   ASSERT_EQ(0, std::remove(manifest_filepath.c_str()));
 }
 
+TEST(NemoAsrLoaderTest, BucketByDuration) {
+  std::vector<NemoAsrEntry> entries(100);
+  for (int i = 0; i < 100; i++)
+    entries[i].duration = (i * 7) % 10 + 0.5;
+  std::vector<float> boundaries = {2, 5, 8};
+  auto bucket_of = [&](size_t idx) {
+    return std::upper_bound(boundaries.begin(), boundaries.end(), entries[idx].duration)
+         - boundaries.begin();
+  };
+  const int batch_size = 4, window = 40;
+
+  std::vector<size_t> indices(entries.size());
+  std::iota(indices.begin(), indices.end(), 0);
+  std::mt19937 rng(123);
+  detail::BucketByDuration(indices, entries, boundaries, batch_size, window, rng);
+
+  std::vector<size_t> sorted = indices;
+  std::sort(sorted.begin(), sorted.end());
+  for (size_t i = 0; i < sorted.size(); i++)
+    ASSERT_EQ(sorted[i], i) << "Not a permutation";
+
+  for (size_t w = 0; w < indices.size(); w += window) {
+    size_t w_end = std::min(indices.size(), w + window);
+    int mixed_groups = 0;
+    for (size_t g = w; g < w_end; g += batch_size) {
+      size_t g_end = std::min(w_end, g + batch_size);
+      for (size_t i = g; i < g_end; i++)
+        ASSERT_TRUE(indices[i] >= w && indices[i] < w_end) << "Sample moved out of its window";
+      bool mixed = false;
+      for (size_t i = g + 1; i < g_end; i++)
+        mixed |= bucket_of(indices[i]) != bucket_of(indices[g]);
+      mixed_groups += mixed;
+    }
+    EXPECT_LT(mixed_groups, static_cast<int>(boundaries.size()) + 1);
+  }
+
+  std::vector<size_t> indices2(entries.size());
+  std::iota(indices2.begin(), indices2.end(), 0);
+  std::mt19937 rng2(123);
+  detail::BucketByDuration(indices2, entries, boundaries, batch_size, window, rng2);
+  EXPECT_EQ(indices, indices2);
+}
+
 TEST(NemoAsrLoaderTest, ReadSample) {
   std::string manifest_filepath =
       "/tmp/nemo_asr_manifest_XXXXXX";  // XXXXXX is replaced in tempfile()
@@ -21,6 +21,7 @@
 #include "dali/operators/reader/loader/numpy_loader.h"
 #include "dali/util/file.h"
 #include "dali/operators/reader/loader/utils.h"
+#include "dali/pipeline/workspace/host_workspace.h"
 
 namespace dali {
 const TypeInfo &TypeFromNumpyStr(const std::string &format) {
@@ -217,10 +218,68 @@ void NumpyHeaderCache::UpdateCache(const string &file_name, const NumpyParseTarg
   }
 }
 
+NumpyReadRoi::NumpyReadRoi(const OpSpec &spec)
+    : slice_attr_(spec, "roi_start", "rel_roi_start", "roi_end", "rel_roi_end", "roi_shape",
+                  "rel_roi_shape", "roi_axes", nullptr),
+      out_of_bounds_policy_(GetOutOfBoundsPolicy(spec)) {
+  bool has_roi = false;
+  for (const char *name : { "roi_start", "rel_roi_start", "roi_end", "rel_roi_end",
+                            "roi_shape", "rel_roi_shape" }) {
+    // argument inputs are known only in the iteration, after the data is read
+    if (spec.HasTensorArgument(name))
+      return;
+    has_roi |= spec.HasArgument(name);
+  }
+  enabled_ = has_roi;
+}
+
+bool NumpyReadRoi::Get(CropWindow &roi, const TensorShape<> &file_shape, bool fortran_order) {
+  int ndim = file_shape.sample_dim();
+  if (!enabled_ || ndim == 0)
+    return false;
+
+  // the ROI arguments refer to the transposed array
+  TensorShape<> shape = file_shape;
+  if (fortran_order)
+    std::reverse(shape.begin(), shape.end());
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (ndim != ndim_) {
+      // the arguments are constant - the workspace is not accessed
+      HostWorkspace ws;
+      slice_attr_.ProcessArguments<CPUBackend>(ws, 1, ndim);
+      ndim_ = ndim;
+    }
+    roi = slice_attr_.GetCropWindowGenerator(0)(shape, {});
+  }
+  if (out_of_bounds_policy_ == OutOfBoundsPolicy::TrimToShape)
+    ApplySliceBoundsPolicy(out_of_bounds_policy_, shape, roi.anchor, roi.shape);
+  // padding and error reporting are left to the operator
+  if (!roi.IsInRange(shape))
+    return false;
+  bool whole = true;
+  for (int d = 0; d < ndim; d++)
+    whole = whole && roi.anchor[d] == 0 && roi.shape[d] == shape[d];
+  if (whole)
+    return false;
+
+  if (fortran_order) {
+    std::reverse(roi.anchor.begin(), roi.anchor.end());
+    std::reverse(roi.shape.begin(), roi.shape.end());
+  }
+  return true;
+}
+
 }  // namespace detail
 
 void NumpyLoader::ReadSample(NumpyFileWrapper& target) {
-  auto filename = files_[current_index_++];
+  auto read = ReadSampleDeferred(target);
+  if (read)
+    read();
+}
+
+NumpyLoader::ReadTask NumpyLoader::ReadSampleDeferred(NumpyFileWrapper& target) {
+  auto filename = files_[SampleIndex(current_index_++)];
 
   // handle wrap-around
   MoveToNextShard(current_index_);
@@ -238,51 +297,71 @@ void NumpyLoader::ReadSample(NumpyFileWrapper& target) {
     target.data.set_type<uint8_t>();
     target.data.Resize({0});
     target.filename.clear();
-    return;
+    return {};
   }
 
-  auto current_file = FileStream::Open(file_root_ + "/" + filename, read_ahead_, !copy_read_data_);
+  return [this, &target, filename, meta]() {
+    auto current_file = FileStream::Open(file_root_ + "/" + filename, read_ahead_,
+                                         !copy_read_data_);
 
-  // read the header
-  NumpyParseTarget parse_target;
-  auto ret = header_cache_.GetFromCache(filename, parse_target);
-  if (ret) {
-    current_file->Seek(parse_target.data_offset);
-  } else {
-    detail::ParseHeader(current_file.get(), parse_target);
-    header_cache_.UpdateCache(filename, parse_target);
-  }
+    // read the header
+    NumpyParseTarget parse_target;
+    auto ret = header_cache_.GetFromCache(filename, parse_target);
+    if (ret) {
+      current_file->Seek(parse_target.data_offset);
+    } else {
+      detail::ParseHeader(current_file.get(), parse_target);
+      header_cache_.UpdateCache(filename, parse_target);
+    }
+
+    Index nbytes = parse_target.nbytes();
 
-  Index nbytes = parse_target.nbytes();
+    // with mmap, only the pages of the region of interest are read anyway
+    CropWindow roi;
+    target.roi_applied = copy_read_data_ &&
+                         read_roi_.Get(roi, parse_target.shape, parse_target.fortran_order);
 
-  if (copy_read_data_) {
-    if (target.data.shares_data()) {
-      target.data.Reset();
+    if (target.roi_applied) {
+      if (target.data.shares_data()) {
+        target.data.Reset();
+      }
+      target.data.Resize(roi.shape, parse_target.type());
+      auto *data = static_cast<uint8_t*>(target.data.raw_mutable_data());
+      detail::ForEachRoiSpan(parse_target.shape, roi, parse_target.type_info->size(),
+          [&](int64_t file_offset, int64_t buffer_offset, int64_t span) {
+        current_file->Seek(parse_target.data_offset + file_offset);
+        Index ret = current_file->Read(data + buffer_offset, span);
+        DALI_ENFORCE(ret == span, make_string("Failed to read file: ", filename));
+      });
+    } else if (copy_read_data_) {
+      if (target.data.shares_data()) {
+        target.data.Reset();
+      }
+      target.data.Resize(parse_target.shape, parse_target.type());
+      // copy the image
+      Index ret = current_file->Read(static_cast<uint8_t*>(target.data.raw_mutable_data()),
+                                      nbytes);
+      DALI_ENFORCE(ret == nbytes, make_string("Failed to read file: ", filename));
+    } else {
+      auto p = current_file->Get(nbytes);
+      DALI_ENFORCE(p != nullptr, make_string("Failed to read file: ", filename));
+      // Wrap the raw data in the Tensor object.
+      target.data.ShareData(p, nbytes, {nbytes});
+      target.data.Resize(parse_target.shape, parse_target.type());
     }
-    target.data.Resize(parse_target.shape, parse_target.type());
-    // copy the image
-    Index ret = current_file->Read(static_cast<uint8_t*>(target.data.raw_mutable_data()),
-                                    nbytes);
-    DALI_ENFORCE(ret == nbytes, make_string("Failed to read file: ", filename));
-  } else {
-    auto p = current_file->Get(nbytes);
-    DALI_ENFORCE(p != nullptr, make_string("Failed to read file: ", filename));
-    // Wrap the raw data in the Tensor object.
-    target.data.ShareData(p, nbytes, {nbytes});
-    target.data.Resize(parse_target.shape, parse_target.type());
-  }
 
-  // close the file handle
-  current_file->Close();
+    // close the file handle
+    current_file->Close();
 
-  // set metadata
-  target.data.SetMeta(meta);
+    // set metadata
+    target.data.SetMeta(meta);
 
-  // set file path
-  target.filename = file_root_ + "/" + filename;
+    // set file path
+    target.filename = file_root_ + "/" + filename;
 
-  // set meta
-  target.fortran_order = parse_target.fortran_order;
+    // set meta
+    target.fortran_order = parse_target.fortran_order;
+  };
 }
 
 }  // namespace dali
@@ -30,8 +30,12 @@
 #include <memory>
 
 #include "dali/core/common.h"
+#include "dali/core/small_vector.h"
 #include "dali/pipeline/data/types.h"
+#include "dali/operators/generic/slice/out_of_bounds_policy.h"
+#include "dali/operators/generic/slice/slice_attr.h"
 #include "dali/operators/reader/loader/file_loader.h"
+#include "dali/util/crop_window.h"
 #include "dali/util/file.h"
 
 namespace dali {
@@ -62,6 +66,8 @@ struct NumpyFileWrapper {
   Tensor<CPUBackend> data;
   std::string filename;
   bool fortran_order;
+  // only the region of interest was read - the data doesn't need to be sliced
+  bool roi_applied = false;
 
   DALIDataType get_type() const {
     return data.type();
@@ -83,6 +89,80 @@ DLL_PUBLIC void ParseHeaderMetadata(NumpyParseTarget& target, const std::string
 // parser function, only for internal use
 void ParseHeader(FileStream *file, NumpyParseTarget& target);
 
+/**
+ * @brief Calls `read(file_offset, buffer_offset, nbytes)` for each contiguous span of bytes
+ *        that make up the region of interest of a C-order array
+ *
+ * The file offsets are relative to the beginning of the array data, the buffer offsets are
+ * the positions of the spans in the densely packed ROI. The spans are visited in order.
+ */
+template <typename ReadSpan>
+void ForEachRoiSpan(const TensorShape<> &shape, const CropWindow &roi, int64_t element_size,
+                    ReadSpan &&read) {
+  int ndim = shape.sample_dim();
+  assert(ndim > 0);
+  if (volume(roi.shape) == 0)
+    return;
+  SmallVector<int64_t, 6> strides;
+  strides.resize(ndim);
+  int64_t stride = element_size;
+  for (int d = ndim - 1; d >= 0; d--) {
+    strides[d] = stride;
+    stride *= shape[d];
+  }
+  // the inner dimensions taken whole are merged with the outermost one of them that's cropped
+  int inner = ndim - 1;
+  while (inner > 0 && roi.anchor[inner] == 0 && roi.shape[inner] == shape[inner])
+    inner--;
+  int64_t span = roi.shape[inner] * strides[inner];
+
+  SmallVector<int64_t, 6> pos;
+  pos.resize(inner, 0);
+  int64_t buffer_offset = 0;
+  for (;;) {
+    int64_t file_offset = roi.anchor[inner] * strides[inner];
+    for (int d = 0; d < inner; d++)
+      file_offset += (roi.anchor[d] + pos[d]) * strides[d];
+    read(file_offset, buffer_offset, span);
+    buffer_offset += span;
+
+    int d = inner - 1;
+    for (; d >= 0; d--) {
+      if (++pos[d] < roi.shape[d])
+        break;
+      pos[d] = 0;
+    }
+    if (d < 0)
+      break;
+  }
+}
+
+/**
+ * @brief Calculates the region of interest to read from a file, when it's known up front
+ *
+ * The ROI can be applied when reading only if it's given with constant arguments
+ * (not argument inputs) and, after applying the out of bounds policy, lies within the array.
+ * Otherwise, the whole array is read and sliced by the operator.
+ */
+class DLL_PUBLIC NumpyReadRoi {
+ public:
+  explicit NumpyReadRoi(const OpSpec &spec);
+
+  /**
+   * @brief Calculates the region of the array to read, in the layout of the file
+   *
+   * @return false, if the whole array should be read
+   */
+  bool Get(CropWindow &roi, const TensorShape<> &file_shape, bool fortran_order);
+
+ private:
+  bool enabled_ = false;
+  std::mutex mutex_;
+  int ndim_ = -1;
+  NamedSliceAttr slice_attr_;
+  OutOfBoundsPolicy out_of_bounds_policy_ = OutOfBoundsPolicy::Error;
+};
+
 class NumpyHeaderCache {
  public:
   explicit NumpyHeaderCache(bool cache_headers) : cache_headers_(cache_headers) {}
@@ -104,17 +184,26 @@ class NumpyLoader : public FileLoader<CPUBackend, NumpyFileWrapper> {
     const OpSpec& spec,
     bool shuffle_after_epoch = false)
     : FileLoader(spec, shuffle_after_epoch),
-    header_cache_(spec.GetArgument<bool>("cache_header_information")) {}
+    header_cache_(spec.GetArgument<bool>("cache_header_information")),
+    read_roi_(spec) {}
 
   void PrepareEmpty(NumpyFileWrapper &target) override {
     target = {};
   }
 
+  ~NumpyLoader() override {
+    // the read tasks use the members of this loader
+    WaitForPendingReads();
+  }
+
   // we want to make it possible to override this function as well
   void ReadSample(NumpyFileWrapper& target) override;
 
+  ReadTask ReadSampleDeferred(NumpyFileWrapper& target) override;
+
  private:
   detail::NumpyHeaderCache header_cache_;
+  detail::NumpyReadRoi read_roi_;
 };
 
 }  // namespace dali
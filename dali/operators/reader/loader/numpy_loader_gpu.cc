@@ -22,6 +22,8 @@
 
 namespace dali {
 
+constexpr size_t NumpyLoaderGPU::kHostReadThreshold;
+
 // register buffer
 void NumpyLoaderGPU::RegisterBuffer(void *buffer, size_t total_size) {
   if (register_buffers_) {
@@ -64,7 +66,7 @@ void NumpyLoaderGPU::ReadSample(NumpyFileWrapperGPU& target) {
   DeviceGuard g(device_id_);
 
   // extract image file
-  auto filename = files_[current_index_++];
+  auto filename = files_[SampleIndex(current_index_++)];
 
   // handle wrap-around
   MoveToNextShard(current_index_);
@@ -100,15 +102,52 @@ void NumpyLoaderGPU::ReadSample(NumpyFileWrapperGPU& target) {
     }
 
     target.type = parse_target.type();
-    target.shape = parse_target.shape;
+    target.file_shape = parse_target.shape;
     target.fortran_order = parse_target.fortran_order;
+    target.roi_applied = read_roi_.Get(target.roi, target.file_shape, target.fortran_order);
+    target.shape = target.roi_applied ? target.roi.shape : target.file_shape;
+
+    // the file is positioned at the data already
+    size_t nbytes = volume(target.shape) * parse_target.type_info->size();
+    if (nbytes > 0 && nbytes <= kHostReadThreshold) {
+      target.host_data.resize(nbytes);
+      if (target.roi_applied) {
+        detail::ForEachRoiSpan(target.file_shape, target.roi, parse_target.type_info->size(),
+            [&](int64_t file_offset, int64_t buffer_offset, int64_t span) {
+          target.file_stream->Seek(parse_target.data_offset + file_offset);
+          size_t nread = target.file_stream->Read(target.host_data.data() + buffer_offset, span);
+          DALI_ENFORCE(nread == static_cast<size_t>(span),
+                       make_string("Failed to read file: ", filename));
+        });
+      } else {
+        size_t nread = target.file_stream->Read(target.host_data.data(), nbytes);
+        DALI_ENFORCE(nread == nbytes, make_string("Failed to read file: ", filename));
+      }
+      target.file_stream->Close();
+    } else {
+      target.host_data.clear();
+    }
   };
 
-  target.read_sample_f = [this, filename, &target] (void *buffer, Index file_offset,
+  target.read_sample_f = [this, filename, &target] (void *buffer, Index offset,
                                                       size_t read_size) {
-    // read sample
-    ReadSampleHelper(target.file_stream.get(), buffer, file_offset, read_size);
-    // we cannot close the file handle here, we need to remember to do it later on
+    if (!target.roi_applied) {
+      // read sample
+      ReadSampleHelper(target.file_stream.get(), buffer, offset, read_size);
+      // we cannot close the file handle here, we need to remember to do it later on
+      return;
+    }
+    // the offset and the size refer to the densely packed region of interest
+    int64_t begin = offset, end = offset + read_size;
+    detail::ForEachRoiSpan(target.file_shape, target.roi,
+                           TypeTable::GetTypeInfo(target.type).size(),
+        [&](int64_t file_offset, int64_t buffer_offset, int64_t span) {
+      int64_t lo = std::max(begin, buffer_offset);
+      int64_t hi = std::min(end, buffer_offset + span);
+      if (lo < hi)
+        ReadSampleHelper(target.file_stream.get(), static_cast<uint8_t*>(buffer) + (lo - begin),
+                         file_offset + (lo - buffer_offset), hi - lo);
+    });
   };
 
   // set file path
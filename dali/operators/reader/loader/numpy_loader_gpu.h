@@ -48,6 +48,13 @@ struct NumpyFileWrapperGPU {
   std::function<void(void)> read_meta_f;
   std::function<void(void* buffer, Index offset, size_t total_size)> read_sample_f;
   std::unique_ptr<CUFileStream> file_stream;
+  // the data of a small sample, read together with the header
+  std::vector<uint8_t> host_data;
+
+  // only the region of interest is read - the shape is the shape of the ROI
+  bool roi_applied = false;
+  CropWindow roi;
+  TensorShape<> file_shape;
 
   const TensorShape<>& get_shape() const {
     return shape;
@@ -68,7 +75,8 @@ class NumpyLoaderGPU : public CUFileLoader<NumpyFileWrapperGPU> {
                                  bool shuffle_after_epoch = false)
       : CUFileLoader(spec, files, shuffle_after_epoch),
         register_buffers_(false),
-        header_cache_(spec.GetArgument<bool>("cache_header_information")) {}
+        header_cache_(spec.GetArgument<bool>("cache_header_information")),
+        read_roi_(spec) {}
 
   ~NumpyLoaderGPU() override {
     // set device
@@ -84,6 +92,15 @@ class NumpyLoaderGPU : public CUFileLoader<NumpyFileWrapperGPU> {
   void PrepareEmpty(NumpyFileWrapperGPU& tensor) override;
   void ReadSample(NumpyFileWrapperGPU& tensor) override;
 
+  /**
+   * @brief Samples up to this size are read to the host memory, together with the header
+   *
+   * GPUDirect Storage reads of small arrays are bound by the per-call latency. Such samples
+   * are read with the buffered I/O while the other headers are still being parsed and are
+   * copied to the device in bulk afterwards.
+   */
+  static constexpr size_t kHostReadThreshold = 1 << 16;
+
  protected:
   // register input tensor
   void RegisterBuffer(void *buffer, size_t total_size);
@@ -100,6 +117,7 @@ class NumpyLoaderGPU : public CUFileLoader<NumpyFileWrapperGPU> {
   std::map<uint8_t*, size_t> reg_buff_;
 
   detail::NumpyHeaderCache header_cache_;
+  detail::NumpyReadRoi read_roi_;
 };
 
 }  // namespace dali
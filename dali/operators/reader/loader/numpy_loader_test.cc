@@ -13,7 +13,10 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <cstring>
+#include <numeric>
 #include <string>
+#include <vector>
 #include "dali/operators/reader/loader/numpy_loader.h"
 
 
@@ -59,5 +62,58 @@ TEST(NumpyLoaderTest, ParseHeaderError) {
   }
 }
 
+TEST(NumpyLoaderTest, RoiSpans) {
+  // a 4x5x6 array
+  TensorShape<> shape = { 4, 5, 6 };
+  std::vector<int> data(volume(shape));
+  std::iota(data.begin(), data.end(), 0);
+
+  auto read_roi = [&](const CropWindow &roi, int &nspans) {
+    std::vector<int> out(volume(roi.shape), -1);
+    nspans = 0;
+    int64_t total = 0;
+    detail::ForEachRoiSpan(shape, roi, sizeof(int),
+        [&](int64_t file_offset, int64_t buffer_offset, int64_t span) {
+      EXPECT_EQ(buffer_offset, total);
+      std::memcpy(reinterpret_cast<char *>(out.data()) + buffer_offset,
+                  reinterpret_cast<char *>(data.data()) + file_offset, span);
+      total += span;
+      nspans++;
+    });
+    EXPECT_EQ(total, static_cast<int64_t>(out.size() * sizeof(int)));
+    return out;
+  };
+
+  CropWindow roi;
+  roi.anchor = { 1, 2, 3 };
+  roi.shape = { 2, 2, 2 };
+  int nspans;
+  auto out = read_roi(roi, nspans);
+  EXPECT_EQ(nspans, 4);
+  int k = 0;
+  for (int i = 1; i < 3; i++)
+    for (int j = 2; j < 4; j++)
+      for (int l = 3; l < 5; l++)
+        EXPECT_EQ(out[k++], (i * 5 + j) * 6 + l);
+
+  // the trailing dimensions are whole - the spans are merged
+  roi.anchor = { 1, 1, 0 };
+  roi.shape = { 3, 3, 6 };
+  out = read_roi(roi, nspans);
+  EXPECT_EQ(nspans, 3);
+  k = 0;
+  for (int i = 1; i < 4; i++)
+    for (int j = 1; j < 4; j++)
+      for (int l = 0; l < 6; l++)
+        EXPECT_EQ(out[k++], (i * 5 + j) * 6 + l);
+
+  roi.anchor = { 2, 0, 0 };
+  roi.shape = { 1, 5, 6 };
+  out = read_roi(roi, nspans);
+  EXPECT_EQ(nspans, 1);
+  EXPECT_EQ(out.front(), 60);
+  EXPECT_EQ(out.back(), 89);
+}
+
 }  // namespace dali
 
@@ -0,0 +1,115 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_READER_LOADER_PERMUTATION_PREFETCHER_H_
+#define DALI_OPERATORS_READER_LOADER_PERMUTATION_PREFETCHER_H_
+
+#include <algorithm>
+#include <functional>
+#include <future>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+#include "dali/core/common.h"
+
+namespace dali {
+
+/**
+ * @brief Draws the permutations of the samples for the consecutive epochs, one epoch ahead
+ *
+ * The permutation of the next epoch is drawn in the background while the current epoch is read,
+ * so that the loader doesn't stall the reads when it resets at the epoch boundary.
+ */
+class PermutationPrefetcher {
+ public:
+  /// Draws the permutation of `size` samples for the epoch; it must depend only on the arguments
+  using Generator = std::function<std::vector<Index>(Index size, int64_t epoch)>;
+
+  explicit PermutationPrefetcher(Generator generator) : generator_(std::move(generator)) {}
+
+  ~PermutationPrefetcher() {
+    if (next_.valid())
+      next_.wait();
+  }
+
+  DISABLE_COPY_MOVE_ASSIGN(PermutationPrefetcher);
+
+  /**
+   * @brief Returns the permutation for the epoch and starts drawing the one for the next epoch
+   */
+  std::vector<Index> Get(Index size, int64_t epoch) {
+    std::vector<Index> permutation;
+    if (next_.valid()) {
+      if (next_size_ == size && next_epoch_ == epoch)
+        permutation = next_.get();
+      else
+        next_.wait();
+      next_ = {};
+    }
+    if (permutation.empty())
+      permutation = generator_(size, epoch);
+    next_size_ = size;
+    next_epoch_ = epoch + 1;
+    next_ = std::async(std::launch::async, generator_, next_size_, next_epoch_);
+    return permutation;
+  }
+
+  /**
+   * @brief Replaces the generator; the permutation drawn in the background is discarded
+   */
+  void SetGenerator(Generator generator) {
+    if (next_.valid()) {
+      next_.wait();
+      next_ = {};
+    }
+    generator_ = std::move(generator);
+  }
+
+ private:
+  Generator generator_;
+  std::future<std::vector<Index>> next_;
+  Index next_size_ = -1;
+  int64_t next_epoch_ = -1;
+};
+
+/**
+ * @brief Returns the permutation applied by std::shuffle with std::mt19937 seeded with `seed`
+ *
+ * std::shuffle does the same swaps regardless of the values, so shuffling the indices and then
+ * reordering the items gives the same order as shuffling the items.
+ */
+inline std::vector<Index> ShufflePermutation(Index size, uint32_t seed) {
+  std::vector<Index> permutation(size);
+  std::iota(permutation.begin(), permutation.end(), 0);
+  std::mt19937 g(seed);
+  std::shuffle(permutation.begin(), permutation.end(), g);
+  return permutation;
+}
+
+/**
+ * @brief Reorders the items, so that items[i] becomes the former items[permutation[i]]
+ */
+template <typename T>
+void ApplyPermutation(std::vector<T> &items, const std::vector<Index> &permutation) {
+  std::vector<T> reordered;
+  reordered.reserve(items.size());
+  for (Index i : permutation)
+    reordered.push_back(std::move(items[i]));
+  items.swap(reordered);
+}
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_READER_LOADER_PERMUTATION_PREFETCHER_H_
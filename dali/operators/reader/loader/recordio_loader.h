@@ -33,6 +33,11 @@ class RecordIOLoader : public IndexedFileLoader {
   }
   ~RecordIOLoader() override {}
 
+  // ReadSample relies on the records being read in the order of the files
+  bool SupportsShuffleIndices() const override {
+    return false;
+  }
+
   void ReadIndexFile(const std::vector<std::string>& index_uris) override {
     std::vector<size_t> file_offsets;
     file_offsets.push_back(0);
@@ -151,6 +156,52 @@ class RecordIOLoader : public IndexedFileLoader {
     }
     tensor.SetMeta(meta);
   }
+
+  ReadTask ReadSampleDeferred(Tensor<CPUBackend>& tensor) override {
+    int64 seek_pos, size;
+    size_t file_index;
+    DALIMeta meta;
+    if (!NextRecord(tensor, seek_pos, size, file_index, meta))
+      return {};
+
+    return [this, &tensor, seek_pos, size, file_index, meta]() {
+      size_t index = file_index;
+      auto file = FileStream::Open(uris_[index], read_ahead_, !copy_read_data_);
+      file->Seek(seek_pos);
+      shared_ptr<void> p = nullptr;
+      if (!copy_read_data_)
+        p = file->Get(size);
+      if (p != nullptr) {
+        // Wrap the raw data in the Tensor object.
+        tensor.ShareData(p, size, {size});
+        tensor.set_type<uint8_t>();
+      } else {
+        // the record can be divided between two files, then we need to fallback to read
+        if (tensor.shares_data()) {
+          tensor.Reset();
+        }
+        tensor.set_type<uint8_t>();
+        tensor.Resize({size});
+        int64 n_read = file->Read(tensor.mutable_data<uint8_t>(), size);
+        while (n_read < size) {
+          DALI_ENFORCE(index + 1 < uris_.size(), "Incomplete or corrupted record files");
+          file->Close();
+          file = FileStream::Open(uris_[++index], read_ahead_, !copy_read_data_);
+          n_read += file->Read(tensor.mutable_data<uint8_t>() + n_read, size - n_read);
+        }
+      }
+      file->Close();
+      tensor.SetMeta(meta);
+    };
+  }
+
+#if IO_URING_ENABLED
+  bool ReadSampleAsync(Tensor<CPUBackend>& tensor, AsyncReadRequest&) override {
+    // the records can span multiple files - they are read synchronously
+    ReadSample(tensor);
+    return false;
+  }
+#endif
 };
 
 }  // namespace dali
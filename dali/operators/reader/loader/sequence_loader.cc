@@ -100,38 +100,57 @@ void SequenceLoader::PrepareEmpty(TensorSequence &sequence) {
 }
 
 void SequenceLoader::ReadSample(TensorSequence &sequence) {
+  auto read = ReadSampleDeferred(sequence);
+  if (read)
+    read();
+}
+
+SequenceLoader::ReadTask SequenceLoader::ReadSampleDeferred(TensorSequence &sequence) {
   // TODO(klecki) this is written as a prototype for video handling
   const auto &sequence_paths = sequences_[current_sequence_];
-  // TODO(klecki) we probably should buffer the "stream", or recently used
-  // frames
+  std::vector<std::string> frames;
+  std::vector<Tensor<CPUBackend> *> targets;
   for (int i = 0; i < sequence_length_; i++) {
-    LoadFrame(sequence_paths, i, &sequence.tensors[i]);
+    if (!SkipCachedFrame(sequence_paths[i], &sequence.tensors[i])) {
+      frames.push_back(sequence_paths[i]);
+      targets.push_back(&sequence.tensors[i]);
+    }
   }
   current_sequence_++;
   // wrap-around
   MoveToNextShard(current_sequence_);
+  if (frames.empty())
+    return {};
+  // TODO(klecki) we probably should buffer the "stream", or recently used
+  // frames
+  return [this, frames = std::move(frames), targets = std::move(targets)]() {
+    for (size_t i = 0; i < frames.size(); i++)
+      LoadFrame(frames[i], targets[i]);
+  };
 }
 
 Index SequenceLoader::SizeImpl() {
   return total_size_;
 }
 
-void SequenceLoader::LoadFrame(const std::vector<std::string> &s, Index frame_idx,
-                               Tensor<CPUBackend> *target) {
-  const auto frame_filename = s[frame_idx];
+bool SequenceLoader::SkipCachedFrame(const std::string &frame_filename,
+                                     Tensor<CPUBackend> *target) {
+  if (!ShouldSkipImage(frame_filename))
+    return false;
   DALIMeta meta;
   meta.SetSourceInfo(frame_filename);
-  meta.SetSkipSample(false);
+  meta.SetSkipSample(true);
+  target->Reset();
+  target->SetMeta(meta);
+  target->set_type<uint8_t>();
+  target->Resize({0});
+  return true;
+}
 
-  // if image is cached, skip loading
-  if (ShouldSkipImage(frame_filename)) {
-    meta.SetSkipSample(true);
-    target->Reset();
-    target->SetMeta(meta);
-    target->set_type<uint8_t>();
-    target->Resize({0});
-    return;
-  }
+void SequenceLoader::LoadFrame(const std::string &frame_filename, Tensor<CPUBackend> *target) {
+  DALIMeta meta;
+  meta.SetSourceInfo(frame_filename);
+  meta.SetSkipSample(false);
 
   auto frame = FileStream::Open(frame_filename, read_ahead_, !copy_read_data_);
   Index frame_size = frame->Size();
@@ -95,8 +95,14 @@ class SequenceLoader : public Loader<CPUBackend, TensorSequence> {
         current_sequence_(0) {
   }
 
+  ~SequenceLoader() override {
+    // the read tasks use the members of the loader
+    WaitForPendingReads();
+  }
+
   void PrepareEmpty(TensorSequence &tensor) override;
   void ReadSample(TensorSequence &tensor) override;
+  ReadTask ReadSampleDeferred(TensorSequence &tensor) override;
 
  protected:
   Index SizeImpl() override;
@@ -144,7 +150,12 @@ class SequenceLoader : public Loader<CPUBackend, TensorSequence> {
   Index current_sequence_;
   FileStream::MappingReserver mmap_reserver_;
 
-  void LoadFrame(const std::vector<std::string> &s, Index frame, Tensor<CPUBackend> *target);
+  /**
+   * @brief Marks the frame as skipped, if it's cached by the decoder
+   */
+  bool SkipCachedFrame(const std::string &frame_filename, Tensor<CPUBackend> *target);
+
+  void LoadFrame(const std::string &frame_filename, Tensor<CPUBackend> *target);
 };
 
 }  // namespace dali
@@ -0,0 +1,251 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <thread>
+#include "dali/core/error_handling.h"
+#include "dali/core/format.h"
+#include "dali/operators/reader/loader/shared_sample_cache.h"
+
+namespace dali {
+
+namespace {
+
+constexpr uint64_t kMagic = 0x44414c4953433031;  // "DALISC01"
+constexpr size_t kAlignment = 64;
+// the expected average size of an entry, used to size the hash table
+constexpr size_t kTypicalSampleSize = 32 << 10;
+
+enum BucketState : uint32_t {
+  kEmpty = 0,
+  kWriting = 1,
+  kReady = 2,
+};
+
+constexpr size_t align_up(size_t x) {
+  return (x + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+std::string errno_string() {
+  return std::strerror(errno);
+}
+
+/**
+ * @brief Locks the process-shared mutex, recovering it if its owner died while holding it
+ */
+class RobustLock {
+ public:
+  explicit RobustLock(pthread_mutex_t *mutex) : mutex_(mutex) {
+    int ret = pthread_mutex_lock(mutex_);
+    if (ret == EOWNERDEAD)
+      pthread_mutex_consistent(mutex_);
+    else
+      DALI_ENFORCE(ret == 0, "Cannot lock the shared sample cache.");
+  }
+
+  ~RobustLock() {
+    pthread_mutex_unlock(mutex_);
+  }
+
+ private:
+  pthread_mutex_t *mutex_;
+};
+
+}  // namespace
+
+struct SharedSampleCache::Header {
+  uint64_t magic;
+  std::atomic<uint32_t> initialized;
+  pthread_mutex_t mutex;
+  uint64_t num_buckets;
+  uint64_t data_begin;
+  uint64_t data_end;
+  // guarded by the mutex
+  uint64_t data_used;
+  uint64_t num_entries;
+  int64_t num_users;
+};
+
+struct SharedSampleCache::Bucket {
+  std::atomic<uint32_t> state;
+  uint32_t key_size;
+  uint64_t key_hash;
+  uint64_t offset;  // of the key, followed by the data
+  uint64_t size;    // of the data
+};
+
+SharedSampleCache::SharedSampleCache(const std::string &name, size_t capacity)
+    : name_(name[0] == '/' ? name : "/" + name) {
+  size_t num_buckets = std::max<size_t>(1024, 2 * capacity / kTypicalSampleSize);
+  size_t min_size = align_up(sizeof(Header)) + align_up(num_buckets * sizeof(Bucket));
+  bool created = false;
+  int fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+  if (fd >= 0) {
+    created = true;
+    size_ = std::max(capacity, min_size + kAlignment);
+    if (ftruncate(fd, size_) != 0) {
+      auto error = errno_string();
+      close(fd);
+      shm_unlink(name_.c_str());
+      DALI_FAIL(make_string("Cannot allocate ", size_, " bytes for the shared sample cache \"",
+                            name_, "\": ", error));
+    }
+  } else {
+    DALI_ENFORCE(errno == EEXIST, make_string("Cannot open the shared sample cache \"", name_,
+                                              "\": ", errno_string()));
+    fd = shm_open(name_.c_str(), O_RDWR, S_IRUSR | S_IWUSR);
+    DALI_ENFORCE(fd >= 0, make_string("Cannot open the shared sample cache \"", name_, "\": ",
+                                      errno_string()));
+    // the creator may not have set the size yet
+    struct stat s;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (fstat(fd, &s) == 0 && static_cast<size_t>(s.st_size) < sizeof(Header) &&
+           std::chrono::steady_clock::now() < deadline)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    size_ = s.st_size;
+  }
+  if (size_ >= sizeof(Header)) {
+    void *ptr = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    base_ = ptr == MAP_FAILED ? nullptr : static_cast<uint8_t *>(ptr);
+  }
+  close(fd);
+  DALI_ENFORCE(base_ != nullptr, make_string("Cannot map the shared sample cache \"", name_,
+                                             "\"."));
+
+  auto &h = header();
+  if (created) {
+    h.magic = kMagic;
+    h.num_buckets = num_buckets;
+    h.data_begin = align_up(sizeof(Header)) + align_up(num_buckets * sizeof(Bucket));
+    h.data_end = size_;
+    h.data_used = h.data_begin;
+    h.num_entries = 0;
+    h.num_users = 1;
+    // the new memory is zeroed, so all the buckets are empty
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+    pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+    pthread_mutex_init(&h.mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+    h.initialized.store(1, std::memory_order_release);
+  } else {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!h.initialized.load(std::memory_order_acquire) &&
+           std::chrono::steady_clock::now() < deadline)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    if (!h.initialized.load(std::memory_order_acquire) || h.magic != kMagic) {
+      munmap(base_, size_);
+      base_ = nullptr;
+      DALI_FAIL(make_string("\"", name_, "\" is not a valid shared sample cache."));
+    }
+    RobustLock lock(&h.mutex);
+    h.num_users++;
+  }
+}
+
+SharedSampleCache::~SharedSampleCache() {
+  if (!base_)
+    return;
+  bool last = false;
+  {
+    RobustLock lock(&header().mutex);
+    last = --header().num_users == 0;
+  }
+  munmap(base_, size_);
+  if (last)
+    shm_unlink(name_.c_str());
+}
+
+SharedSampleCache::Header &SharedSampleCache::header() const {
+  return *reinterpret_cast<Header *>(base_);
+}
+
+SharedSampleCache::Bucket *SharedSampleCache::buckets() const {
+  return reinterpret_cast<Bucket *>(base_ + align_up(sizeof(Header)));
+}
+
+const uint8_t *SharedSampleCache::Get(const std::string &key, size_t &size) const {
+  auto &h = header();
+  uint64_t hash = std::hash<std::string>()(key);
+  Bucket *table = buckets();
+  for (uint64_t i = 0; i < h.num_buckets; i++) {
+    Bucket &b = table[(hash + i) % h.num_buckets];
+    uint32_t state = b.state.load(std::memory_order_acquire);
+    if (state == kEmpty)
+      return nullptr;
+    if (state != kReady || b.key_hash != hash || b.key_size != key.size())
+      continue;
+    const uint8_t *entry = base_ + b.offset;
+    if (std::memcmp(entry, key.data(), key.size()) != 0)
+      continue;
+    size = b.size;
+    return entry + align_up(key.size());
+  }
+  return nullptr;
+}
+
+bool SharedSampleCache::Put(const std::string &key, const void *data, size_t size) {
+  auto &h = header();
+  uint64_t hash = std::hash<std::string>()(key);
+  Bucket *table = buckets();
+  Bucket *bucket = nullptr;
+  uint64_t offset = 0;
+  {
+    RobustLock lock(&h.mutex);
+    size_t entry_size = align_up(key.size()) + align_up(size);
+    // keep the load factor of the table below 1/2, so that the lookups are short
+    if (h.data_used + entry_size > h.data_end || 2 * (h.num_entries + 1) > h.num_buckets)
+      return false;
+    for (uint64_t i = 0; i < h.num_buckets; i++) {
+      Bucket &b = table[(hash + i) % h.num_buckets];
+      if (b.state.load(std::memory_order_relaxed) == kEmpty) {
+        bucket = &b;
+        break;
+      }
+      // stored or being stored by another process
+      if (b.key_hash == hash && b.key_size == key.size() &&
+          std::memcmp(base_ + b.offset, key.data(), key.size()) == 0)
+        return false;
+    }
+    if (!bucket)
+      return false;
+    offset = h.data_used;
+    h.data_used += entry_size;
+    h.num_entries++;
+    bucket->key_hash = hash;
+    bucket->key_size = key.size();
+    bucket->offset = offset;
+    bucket->size = size;
+    // the key is written under the lock, so that the other writers can compare it
+    std::memcpy(base_ + offset, key.data(), key.size());
+    bucket->state.store(kWriting, std::memory_order_release);
+  }
+  std::memcpy(base_ + offset + align_up(key.size()), data, size);
+  bucket->state.store(kReady, std::memory_order_release);
+  return true;
+}
+
+}  // namespace dali
@@ -0,0 +1,81 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_READER_LOADER_SHARED_SAMPLE_CACHE_H_
+#define DALI_OPERATORS_READER_LOADER_SHARED_SAMPLE_CACHE_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "dali/core/common.h"
+
+namespace dali {
+
+/**
+ * @brief A cache of the encoded samples in POSIX shared memory, shared by all the processes
+ *        on the node which open it with the same name
+ *
+ * The samples are identified by a key, e.g. the path of the file. Whichever process reads
+ * a sample first stores it; the others find it there instead of reading it again.
+ * The cache is filled until it's full - nothing is evicted, so a sample, once stored, stays
+ * at the same address and can be used without copying for as long as the cache is open.
+ *
+ * The shared memory is removed when the last process using it closes it.
+ */
+class DLL_PUBLIC SharedSampleCache {
+ public:
+  /**
+   * @brief Opens the cache with the given name, creating it if it doesn't exist
+   *
+   * @param capacity the size of the shared memory, in bytes; used only by the process
+   *                 which creates the cache
+   */
+  SharedSampleCache(const std::string &name, size_t capacity);
+  ~SharedSampleCache();
+
+  DISABLE_COPY_MOVE_ASSIGN(SharedSampleCache);
+
+  /**
+   * @brief Finds the sample stored with the key
+   *
+   * @return the data of the sample, valid until the cache is closed, or nullptr
+   */
+  const uint8_t *Get(const std::string &key, size_t &size) const;
+
+  /**
+   * @brief Stores the sample, unless it's already there or doesn't fit
+   *
+   * @return true, if the sample was stored
+   */
+  bool Put(const std::string &key, const void *data, size_t size);
+
+  size_t capacity() const {
+    return size_;
+  }
+
+ private:
+  struct Header;
+  struct Bucket;
+
+  Header &header() const;
+  Bucket *buckets() const;
+
+  std::string name_;
+  uint8_t *base_ = nullptr;
+  size_t size_ = 0;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_READER_LOADER_SHARED_SAMPLE_CACHE_H_
@@ -0,0 +1,100 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include "dali/operators/reader/loader/shared_sample_cache.h"
+
+namespace dali {
+
+namespace {
+
+std::string CacheName() {
+  return "dali_shared_sample_cache_test_" + std::to_string(getpid());
+}
+
+bool CacheExists(const std::string &name) {
+  int fd = shm_open(("/" + name).c_str(), O_RDONLY, 0);
+  if (fd < 0)
+    return false;
+  close(fd);
+  return true;
+}
+
+}  // namespace
+
+TEST(SharedSampleCache, PutGet) {
+  SharedSampleCache cache(CacheName(), 1 << 20);
+  std::string data = "some encoded sample";
+  size_t size = 0;
+  EXPECT_EQ(cache.Get("a/1.jpg", size), nullptr);
+  EXPECT_TRUE(cache.Put("a/1.jpg", data.data(), data.size()));
+  // already stored
+  EXPECT_FALSE(cache.Put("a/1.jpg", data.data(), data.size()));
+
+  auto *ptr = cache.Get("a/1.jpg", size);
+  ASSERT_NE(ptr, nullptr);
+  ASSERT_EQ(size, data.size());
+  EXPECT_EQ(std::memcmp(ptr, data.data(), size), 0);
+  EXPECT_EQ(cache.Get("a/2.jpg", size), nullptr);
+}
+
+TEST(SharedSampleCache, Shared) {
+  auto name = CacheName();
+  auto first = std::make_unique<SharedSampleCache>(name, 1 << 20);
+  std::string data = "stored by the first one";
+  EXPECT_TRUE(first->Put("x", data.data(), data.size()));
+
+  // the size of the existing cache is used
+  SharedSampleCache second(name, 1);
+  EXPECT_EQ(second.capacity(), first->capacity());
+  size_t size = 0;
+  auto *ptr = second.Get("x", size);
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(std::string(reinterpret_cast<const char *>(ptr), size), data);
+
+  EXPECT_TRUE(second.Put("y", data.data(), 1));
+  EXPECT_NE(first->Get("y", size), nullptr);
+  EXPECT_EQ(size, 1u);
+
+  // the shared memory is removed by the last user
+  first.reset();
+  EXPECT_TRUE(CacheExists(name));
+  EXPECT_NE(second.Get("x", size), nullptr);
+}
+
+TEST(SharedSampleCache, Full) {
+  auto name = CacheName();
+  {
+    SharedSampleCache cache(name, 1 << 20);
+    std::vector<char> data(100 << 10, 'a');
+    int stored = 0;
+    for (int i = 0; i < 20; i++)
+      stored += cache.Put(std::to_string(i), data.data(), data.size());
+    EXPECT_GT(stored, 0);
+    EXPECT_LT(stored, 10);
+    size_t size = 0;
+    for (int i = 0; i < 20; i++)
+      EXPECT_EQ(cache.Get(std::to_string(i), size) != nullptr, i < stored);
+  }
+  EXPECT_FALSE(CacheExists(name));
+}
+
+}  // namespace dali
@@ -0,0 +1,151 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dali/operators/reader/loader/video_index.h"
+
+namespace dali {
+
+namespace {
+
+const char kMagic[8] = {'D', 'A', 'L', 'I', 'V', 'I', 'D', 'X'};
+constexpr uint32_t kFormatVersion = 1;
+
+/// an index larger than this is surely damaged
+constexpr uint64_t kMaxKeyFrames = 1u << 28;
+
+struct FileCloser {
+  void operator()(FILE *f) {
+    fclose(f);
+  }
+};
+
+using file_ptr = std::unique_ptr<FILE, FileCloser>;
+
+template <typename T>
+bool ReadValue(FILE *f, T &value) {
+  return fread(&value, sizeof(T), 1, f) == 1;
+}
+
+template <typename T>
+bool WriteValue(FILE *f, const T &value) {
+  return fwrite(&value, sizeof(T), 1, f) == 1;
+}
+
+}  // namespace
+
+void VideoIndex::Add(int64_t frame, int64_t pts) {
+  key_frames.push_back({frame, pts});
+}
+
+void VideoIndex::Finalize() {
+  std::sort(key_frames.begin(), key_frames.end(),
+            [](const KeyFrame &a, const KeyFrame &b) { return a.frame < b.frame; });
+  key_frames.erase(std::unique(key_frames.begin(), key_frames.end(),
+                               [](const KeyFrame &a, const KeyFrame &b) {
+                                 return a.frame == b.frame;
+                               }),
+                   key_frames.end());
+}
+
+const VideoIndex::KeyFrame *VideoIndex::KeyFrameBefore(int64_t frame) const {
+  auto it = std::upper_bound(key_frames.begin(), key_frames.end(), frame,
+                             [](int64_t f, const KeyFrame &k) { return f < k.frame; });
+  if (it == key_frames.begin())
+    return nullptr;
+  return &*(it - 1);
+}
+
+bool VideoIndex::Load(const std::string &index_path, const std::string &version) {
+  file_ptr f(fopen(index_path.c_str(), "rb"));
+  if (!f)
+    return false;
+  char magic[sizeof(kMagic)];
+  uint32_t format_version;
+  uint32_t version_len;
+  if (fread(magic, sizeof(magic), 1, f.get()) != 1 ||
+      std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+      !ReadValue(f.get(), format_version) || format_version != kFormatVersion ||
+      !ReadValue(f.get(), version_len) || version_len != version.size())
+    return false;
+  std::string stored_version(version_len, '\0');
+  if (version_len && fread(&stored_version[0], version_len, 1, f.get()) != 1)
+    return false;
+  if (stored_version != version)
+    return false;
+  uint64_t n;
+  if (!ReadValue(f.get(), n) || n > kMaxKeyFrames)
+    return false;
+  std::vector<KeyFrame> frames(n);
+  if (n && fread(frames.data(), sizeof(KeyFrame), n, f.get()) != n)
+    return false;
+  key_frames = std::move(frames);
+  return true;
+}
+
+bool VideoIndex::Save(const std::string &index_path, const std::string &version) const {
+  std::string tmp_path = index_path + ".tmp" + std::to_string(getpid());
+  bool ok;
+  {
+    file_ptr f(fopen(tmp_path.c_str(), "wb"));
+    if (!f)
+      return false;
+    uint32_t version_len = version.size();
+    uint64_t n = key_frames.size();
+    ok = fwrite(kMagic, sizeof(kMagic), 1, f.get()) == 1 &&
+         WriteValue(f.get(), kFormatVersion) &&
+         WriteValue(f.get(), version_len) &&
+         (version.empty() || fwrite(version.data(), version.size(), 1, f.get()) == 1) &&
+         WriteValue(f.get(), n) &&
+         (n == 0 || fwrite(key_frames.data(), sizeof(KeyFrame), n, f.get()) == n);
+    ok = (fclose(f.release()) == 0) && ok;
+  }
+  if (ok)
+    ok = rename(tmp_path.c_str(), index_path.c_str()) == 0;
+  if (!ok)
+    unlink(tmp_path.c_str());
+  return ok;
+}
+
+std::string VideoIndex::PathFor(const std::string &video_path) {
+  const char *dir = std::getenv("DALI_VIDEO_INDEX_DIR");
+  if (!dir || !*dir)
+    return video_path + ".dali_idx";
+  // the basename is kept for readability, the hash of the whole path makes the name unique
+  auto slash = video_path.find_last_of('/');
+  std::string base = slash == std::string::npos ? video_path : video_path.substr(slash + 1);
+  char hash[32];
+  snprintf(hash, sizeof(hash), "%016zx", std::hash<std::string>()(video_path));
+  return std::string(dir) + "/" + base + "." + hash + ".dali_idx";
+}
+
+std::string VideoIndex::VersionOf(const std::string &video_path) {
+  struct stat st;
+  if (stat(video_path.c_str(), &st) != 0)
+    return {};
+  return std::to_string(st.st_size) + ":" + std::to_string(st.st_mtim.tv_sec) + "." +
+         std::to_string(st.st_mtim.tv_nsec);
+}
+
+}  // namespace dali
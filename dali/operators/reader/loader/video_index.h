@@ -0,0 +1,94 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_READER_LOADER_VIDEO_INDEX_H_
+#define DALI_OPERATORS_READER_LOADER_VIDEO_INDEX_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace dali {
+
+/**
+ * @brief The key frames of the video stream of a file
+ *
+ * Built by scanning the packets of the file once and kept in an index file, so that the loader
+ * can seek straight to the key frame preceding a sequence and skip the scan of the file
+ * at startup.
+ *
+ * The index is stored next to the video, as `<video file>.dali_idx`, or - if the environment
+ * variable DALI_VIDEO_INDEX_DIR is set (e.g. for read-only datasets) - in that directory.
+ * It's tagged with the size and the modification time of the video and discarded, if they
+ * don't match.
+ */
+struct VideoIndex {
+  struct KeyFrame {
+    /// the frame number, relative to the start of the stream
+    int64_t frame;
+    /// the presentation timestamp, in the units of the stream time base
+    int64_t pts;
+  };
+
+  /// sorted by the frame number
+  std::vector<KeyFrame> key_frames;
+
+  bool empty() const noexcept {
+    return key_frames.empty();
+  }
+
+  /**
+   * @brief Adds a key frame found while scanning the stream; the packets may come
+   *        in the decoding order
+   */
+  void Add(int64_t frame, int64_t pts);
+
+  /**
+   * @brief Sorts the key frames; called after the scan
+   */
+  void Finalize();
+
+  /**
+   * @brief The last key frame at or before `frame`, nullptr if there's none
+   */
+  const KeyFrame *KeyFrameBefore(int64_t frame) const;
+
+  /**
+   * @brief Loads the index; returns false, if it doesn't exist, is damaged or was made
+   *        for a different version of the video
+   */
+  bool Load(const std::string &index_path, const std::string &version);
+
+  /**
+   * @brief Stores the index; returns false, if the file could not be written
+   *
+   * The file is written under a temporary name and renamed, so the concurrent readers
+   * (e.g. the other processes of a multi-GPU job) never see a partial index.
+   */
+  bool Save(const std::string &index_path, const std::string &version) const;
+
+  /**
+   * @brief The path of the index of given video file
+   */
+  static std::string PathFor(const std::string &video_path);
+
+  /**
+   * @brief The size and the modification time of the video, empty if it can't be stat'ed
+   */
+  static std::string VersionOf(const std::string &video_path);
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_READER_LOADER_VIDEO_INDEX_H_
@@ -0,0 +1,77 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string>
+
+#include "dali/operators/reader/loader/video_index.h"
+
+namespace dali {
+
+TEST(VideoIndex, KeyFrameBefore) {
+  VideoIndex index;
+  // the packets come in the decoding order
+  index.Add(30, 3000);
+  index.Add(0, 0);
+  index.Add(60, 6000);
+  index.Add(30, 3000);
+  index.Finalize();
+  ASSERT_EQ(index.key_frames.size(), 3u);
+
+  EXPECT_EQ(index.KeyFrameBefore(-1), nullptr);
+  EXPECT_EQ(index.KeyFrameBefore(0)->frame, 0);
+  EXPECT_EQ(index.KeyFrameBefore(29)->frame, 0);
+  EXPECT_EQ(index.KeyFrameBefore(30)->frame, 30);
+  EXPECT_EQ(index.KeyFrameBefore(59)->pts, 3000);
+  EXPECT_EQ(index.KeyFrameBefore(1000)->frame, 60);
+}
+
+TEST(VideoIndex, SaveLoad) {
+  char dir[] = "/tmp/dali_video_index_XXXXXX";
+  ASSERT_NE(mkdtemp(dir), nullptr);
+  std::string path = std::string(dir) + "/video.mp4.dali_idx";
+
+  VideoIndex index;
+  index.Add(0, 512);
+  index.Add(48, 25088);
+  index.Finalize();
+  ASSERT_TRUE(index.Save(path, "1234:5.6"));
+
+  VideoIndex loaded;
+  ASSERT_TRUE(loaded.Load(path, "1234:5.6"));
+  ASSERT_EQ(loaded.key_frames.size(), 2u);
+  EXPECT_EQ(loaded.key_frames[1].frame, 48);
+  EXPECT_EQ(loaded.key_frames[1].pts, 25088);
+
+  // the video has changed
+  VideoIndex stale;
+  EXPECT_FALSE(stale.Load(path, "1234:7.8"));
+  EXPECT_TRUE(stale.empty());
+
+  // a damaged index
+  if (FILE *f = fopen(path.c_str(), "r+b")) {
+    fputc('X', f);
+    fclose(f);
+  }
+  EXPECT_FALSE(stale.Load(path, "1234:5.6"));
+  EXPECT_FALSE(stale.Load(path + ".missing", "1234:5.6"));
+
+  unlink(path.c_str());
+  rmdir(dir);
+}
+
+}  // namespace dali
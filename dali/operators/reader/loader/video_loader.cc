@@ -264,8 +264,8 @@ static int64_t seek_file(void *opaque, int64_t offset, int whence) {
   }
 }
 
-VideoFile& VideoLoader::get_or_open_file(const std::string &filename) {
-  auto& file = open_files_[filename];
+VideoFile& VideoLoader::get_or_open_file(VideoDecoderLane& lane, const std::string &filename) {
+  auto& file = lane.open_files[filename];
 
   if (file.empty()) {
     file.file_desc.filename = filename;
@@ -441,6 +441,10 @@ VideoFile& VideoLoader::get_or_open_file(const std::string &filename) {
       err << "Unhandled codec " << codec_id << " in " << filename;
       DALI_FAIL(err.str());
     }
+
+    if (keyframe_index_) {
+      load_or_build_index(file);
+    }
   } else {
     /* Flush the bitstream filter handle when using mpeg4_unpack_bframes filter.
      * When mpeg4_unpack_bframe is used the filter handle stores information
@@ -454,15 +458,15 @@ VideoFile& VideoLoader::get_or_open_file(const std::string &filename) {
     }
   }
   // close the previous file if there was any open
-  if (last_opened_.size() && last_opened_ != filename) {
-    auto& old_file = open_files_[last_opened_];
+  if (lane.last_opened.size() && lane.last_opened != filename) {
+    auto& old_file = lane.open_files[lane.last_opened];
     if (old_file.file_desc.file_stream) {
       old_file.file_desc.file_position = ftell(old_file.file_desc.file_stream);
       fclose(old_file.file_desc.file_stream);
       old_file.file_desc.file_stream = nullptr;
     }
   }
-  last_opened_ = filename;
+  lane.last_opened = filename;
   return file;
 }
 
@@ -490,7 +494,76 @@ void VideoLoader::seek(VideoFile& file, int frame) {
     // starting.
 }
 
-void VideoLoader::read_file() {
+void VideoLoader::seek_key_frame(VideoFile& file, int frame) {
+  auto key_frame = file.index_.KeyFrameBefore(frame);
+  if (!key_frame) {
+    seek(file, frame);
+    return;
+  }
+  LOG_LINE << "Seeking to key frame " << key_frame->frame << " timestamp " << key_frame->pts
+           << " for frame " << frame << std::endl;
+
+  auto ret = av_seek_frame(file.fmt_ctx_.get(), file.vid_stream_idx_,
+                           key_frame->pts, AVSEEK_FLAG_BACKWARD);
+  if (ret < 0) {
+    LOG_LINE << "Unable to skip to ts " << key_frame->pts
+             << ": " << av_err2str(ret) << std::endl;
+  }
+  // see seek()
+  av_bsf_flush(file.bsf_ctx_.get());
+}
+
+void VideoLoader::load_or_build_index(VideoFile& file) {
+  using pkt_ptr = std::unique_ptr<AVPacket, decltype(&av_packet_unref)>;
+  const auto& filename = file.file_desc.filename;
+  auto index_path = VideoIndex::PathFor(filename);
+  auto version = VideoIndex::VersionOf(filename);
+
+  {
+    // already loaded or built by another lane
+    std::lock_guard<std::mutex> lock(index_mutex_);
+    auto it = indices_.find(filename);
+    if (it != indices_.end()) {
+      file.index_ = it->second;
+      return;
+    }
+  }
+
+  if (!file.index_.Load(index_path, version)) {
+    LOG_LINE << "Building the key frame index of " << filename << std::endl;
+    // only the packet headers are needed, nothing is decoded
+    VideoIndex index;
+    AVPacket raw_pkt = {};
+    while (av_read_frame(file.fmt_ctx_.get(), &raw_pkt) >= 0) {
+      auto pkt = pkt_ptr(&raw_pkt, av_packet_unref);
+      if (pkt->stream_index != file.vid_stream_idx_ || pkt->pts == AV_NOPTS_VALUE) {
+        continue;
+      }
+      if (pkt->flags & AV_PKT_FLAG_KEY) {
+        auto frame = av_rescale_q(pkt->pts - file.start_time_,
+                                  file.stream_base_,
+                                  file.frame_base_);
+        index.Add(frame, pkt->pts);
+      }
+    }
+    index.Finalize();
+    file.index_ = std::move(index);
+
+    std::lock_guard<std::mutex> lock(index_mutex_);
+    if (!version.empty() && !file.index_.Save(index_path, version) && !index_save_warned_) {
+      index_save_warned_ = true;
+      DALI_WARN("Could not store the key frame index of " + filename + " as " + index_path +
+                ". The indices are rebuilt on every run; set DALI_VIDEO_INDEX_DIR to a writable "
+                "directory to keep them.");
+    }
+    indices_.emplace(filename, file.index_);
+    return;
+  }
+  std::lock_guard<std::mutex> lock(index_mutex_);
+  indices_.emplace(filename, file.index_);
+}
+
+void VideoLoader::read_file(VideoDecoderLane& lane) {
   // av_packet_unref is unlike the other libav free functions
   using pkt_ptr = std::unique_ptr<AVPacket, decltype(&av_packet_unref)>;
   AVPacket raw_pkt = {};
@@ -500,31 +573,53 @@ void VideoLoader::read_file() {
       break;
     }
 
-    auto req = send_queue_.pop();
+    auto req = lane.send_queue.pop();
 
     LOG_LINE << "Got a request for " << req.filename << " frame " << req.frame
-             << " count " << req.count << " send_queue_ has " << send_queue_.size()
+             << " count " << req.count << " send_queue has " << lane.send_queue.size()
              << " frames left" << std::endl;
 
     if (stop_) {
       break;
     }
 
-    auto& file = get_or_open_file(req.filename);
+    auto& file = get_or_open_file(lane, req.filename);
     auto stream = file.fmt_ctx_->streams[file.vid_stream_idx_];
     req.frame_base = file.frame_base_;
 
-    if (vid_decoder_) {
-        vid_decoder_->push_req(req);
+    if (lane.decoder) {
+        lane.decoder->push_req(req);
     } else {
         DALI_FAIL("No video decoder even after opening a file");
     }
 
+    // The following requests for the same file, which start in a GOP that overlaps the range
+    // read so far, are served by the same pass: the decoder matches the frames to
+    // the requests in order, so it's enough to keep reading.
+    while (!file.index_.empty() && !stop_ && !lane.send_queue.empty()) {
+      const auto& next = lane.send_queue.peek();
+      auto next_key_frame = file.index_.KeyFrameBefore(next.frame);
+      if (next.filename != req.filename || next.frame < req.frame + req.count ||
+          !next_key_frame || next_key_frame->frame > req.frame + req.count) {
+        break;
+      }
+      auto next_req = lane.send_queue.pop();
+      next_req.frame_base = file.frame_base_;
+      LOG_LINE << "Frame " << next_req.frame << " is read in the same pass as frame "
+               << req.frame << std::endl;
+      lane.decoder->push_req(next_req);
+      req.count = next_req.frame + next_req.count - req.frame;
+    }
+
     // we want to seek each time because even if we ended on the
     // correct key frame, we've flushed the decoder, so it needs
     // another key frame to start decoding again
     int seek_hack = 1;
-    seek(file, req.frame);
+    if (file.index_.empty()) {
+      seek(file, req.frame);
+    } else {
+      seek_key_frame(file, req.frame);
+    }
 
     auto nonkey_frame_count = 0;
     int frames_left = req.count;
@@ -542,8 +637,8 @@ void VideoLoader::read_file() {
     while (av_read_frame(file.fmt_ctx_.get(), &raw_pkt) >= 0) {
       auto pkt = pkt_ptr(&raw_pkt, av_packet_unref);
 
-      stats_.bytes_read += pkt->size;
-      stats_.packets_read++;
+      lane.stats.bytes_read += pkt->size;
+      lane.stats.packets_read++;
 
       if (pkt->stream_index != file.vid_stream_idx_) {
           continue;
@@ -632,8 +727,8 @@ void VideoLoader::read_file() {
                   << " nonkey_frame_count = " << nonkey_frame_count
                   << std::endl;
 
-      stats_.bytes_decoded += pkt->size;
-      stats_.packets_decoded++;
+      lane.stats.bytes_decoded += pkt->size;
+      lane.stats.packets_decoded++;
 
       if (file.bsf_ctx_ && pkt->size > 0) {
         int ret;
@@ -645,7 +740,7 @@ void VideoLoader::read_file() {
         }
         while ((ret = av_bsf_receive_packet(file.bsf_ctx_.get(), &raw_filtered_pkt)) == 0) {
           auto fpkt = pkt_ptr(&raw_filtered_pkt, av_packet_unref);
-          vid_decoder_->decode_packet(fpkt.get(), file.start_time_, file.stream_base_,
+          lane.decoder->decode_packet(fpkt.get(), file.start_time_, file.stream_base_,
                                       codecpar(stream));
         }
         if (ret != AVERROR(EAGAIN)) {
@@ -683,51 +778,52 @@ void VideoLoader::read_file() {
           }
           *pkt.get() = fpkt;
         }
-        vid_decoder_->decode_packet(pkt.get(), file.start_time_, file.stream_base_,
+        lane.decoder->decode_packet(pkt.get(), file.start_time_, file.stream_base_,
                                     codecpar(stream));
 #endif
       } else {
-        vid_decoder_->decode_packet(pkt.get(), file.start_time_, file.stream_base_,
+        lane.decoder->decode_packet(pkt.get(), file.start_time_, file.stream_base_,
                                     codecpar(stream));
       }
       is_first_frame = false;
     }
 
     // flush the decoder
-    vid_decoder_->decode_packet(nullptr, 0, {0}, 0);
+    lane.decoder->decode_packet(nullptr, 0, {0}, 0);
   }  // while not done
 
-  if (vid_decoder_) {
+  if (lane.decoder) {
     // stop decoding
-    vid_decoder_->decode_packet(nullptr, 0, {0}, 0);
+    lane.decoder->decode_packet(nullptr, 0, {0}, 0);
   }
   LOG_LINE << "Leaving read_file" << std::endl;
 }
 
-void VideoLoader::push_sequence_to_read(std::string filename, int frame, int count) {
+void VideoLoader::push_sequence_to_read(VideoDecoderLane& lane, std::string filename,
+                                       int frame, int count) {
     int total_count = 1 + (count - 1) * stride_;
     auto req = FrameReq{std::move(filename), frame, total_count, stride_, {0, 0}};
     // give both reader thread and decoder a copy of what is coming
-    send_queue_.push(req);
+    lane.send_queue.push(req);
 }
 
-void VideoLoader::receive_frames(SequenceWrapper& sequence) {
+void VideoLoader::receive_frames(VideoDecoderLane& lane, SequenceWrapper& sequence) {
   auto startup_timeout = 1000;
-  while (!vid_decoder_) {
+  while (!lane.decoder) {
     usleep(500);
     if (startup_timeout-- == 0) {
       DALI_FAIL("Timeout waiting for a valid decoder");
     }
   }
-  vid_decoder_->receive_frames(sequence);
+  lane.decoder->receive_frames(sequence);
 
   // Stats code
-  stats_.frames_used += sequence.count;
+  lane.stats.frames_used += sequence.count;
 
   static auto frames_since_warn = 0;
   static auto frames_used_warned = false;
   frames_since_warn += sequence.count;
-  auto ratio_used = static_cast<float>(stats_.packets_decoded) / stats_.frames_used;
+  auto ratio_used = static_cast<float>(lane.stats.packets_decoded) / lane.stats.frames_used;
   if (ratio_used > frames_used_warning_ratio &&
       frames_since_warn > (frames_used_warned ? frames_used_warning_interval :
                             frames_used_warning_minimum)) {
@@ -745,16 +841,29 @@ void VideoLoader::PrepareEmpty(SequenceWrapper &tensor) {}
 void VideoLoader::ReadSample(SequenceWrapper& tensor) {
     // TODO(spanev) remove the async between the 2 following methods?
     auto& seq_meta = frame_starts_[current_frame_idx_];
-    tensor.initialize(seq_meta.length, count_, seq_meta.height, seq_meta.width, channels_, dtype_);
+    if (resize_.enabled()) {
+      tensor.initialize(seq_meta.length, count_, resize_.height, resize_.width, channels_, dtype_,
+                        true);
+    } else {
+      tensor.initialize(seq_meta.length, count_, seq_meta.height, seq_meta.width, channels_,
+                        dtype_);
+    }
 
-    tensor.read_sample_f = [this,
-                            file_name = file_info_[seq_meta.filename_idx].video_file,
-                            index = seq_meta.frame_idx, count = seq_meta.length, &tensor] () {
-      push_sequence_to_read(file_name, index, count);
-      receive_frames(tensor);
+    // the sequences from the same file go to the same lane, which keeps the file open
+    int lane_idx = seq_meta.filename_idx % lanes_.size();
+    auto& lane = *lanes_[lane_idx];
+    tensor.request_sample_f = [this, &lane,
+                               file_name = file_info_[seq_meta.filename_idx].video_file,
+                               index = seq_meta.frame_idx, count = seq_meta.length] () {
+      push_sequence_to_read(lane, file_name, index, count);
+    };
+    tensor.read_sample_f = [this, &lane, &tensor] () {
+      receive_frames(lane, tensor);
     };
     ++current_frame_idx_;
 
+    tensor.file_idx = seq_meta.filename_idx;
+    tensor.decoder_idx = lane_idx;
     tensor.label = seq_meta.label;
     tensor.first_frame_idx = seq_meta.frame_idx;
     MoveToNextShard(current_frame_idx_);
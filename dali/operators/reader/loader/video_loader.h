@@ -24,6 +24,7 @@ extern "C" {
 }
 
 #include <algorithm>
+#include <functional>
 #include <memory>
 #include <random>
 #include <string>
@@ -32,9 +33,11 @@ extern "C" {
 #include <utility>
 #include <vector>
 #include <list>
+#include <mutex>
 
 #include "dali/core/common.h"
 #include "dali/operators/reader/loader/loader.h"
+#include "dali/operators/reader/loader/video_index.h"
 #include "dali/operators/reader/nvdecoder/nvdecoder.h"
 #include "dali/operators/reader/nvdecoder/sequencewrapper.h"
 
@@ -106,6 +109,9 @@ struct VideoFile {
 #endif
   av_unique_ptr<AVFormatContext> fmt_ctx_;
 
+  /// the key frames of the video stream; empty, if the index is not used
+  VideoIndex index_;
+
   VideoFileDesc file_desc;
   bool empty() const noexcept { return file_desc.filename.empty(); }
 };
@@ -133,6 +139,21 @@ struct VideoLoaderStats {
   uint64_t frames_used;
 };
 
+/**
+ * @brief A decoding session: the decoder with its own parser, the thread which reads
+ *        the packets for it and the files opened by that thread
+ *
+ * The sessions work independently, each on a different hardware decoder engine, if available.
+ */
+struct VideoDecoderLane {
+  std::unique_ptr<NvDecoder> decoder;
+  ThreadSafeQueue<FrameReq> send_queue;
+  std::thread file_reader;
+  std::unordered_map<std::string, VideoFile> open_files;
+  std::string last_opened;
+  VideoLoaderStats stats = {0, 0, 0, 0, 0};
+};
+
 struct sequence_meta {
   size_t filename_idx;
   int frame_idx;
@@ -143,10 +164,26 @@ struct sequence_meta {
 };
 
 
+/**
+ * @brief The size of the frames produced by the decoder, when they are resized while being
+ *        converted; by default, the frames keep their size
+ */
+struct VideoFrameResize {
+  int height = 0;
+  int width = 0;
+  /// use the nearest neighbor instead of the bilinear interpolation
+  bool nearest = false;
+
+  bool enabled() const {
+    return height > 0 && width > 0;
+  }
+};
+
 class VideoLoader : public Loader<GPUBackend, SequenceWrapper> {
  public:
   explicit inline VideoLoader(const OpSpec& spec,
-    const std::vector<std::string>& filenames)
+    const std::vector<std::string>& filenames,
+    const VideoFrameResize &resize = {})
     : Loader<GPUBackend, SequenceWrapper>(spec),
       file_root_(spec.GetArgument<std::string>("file_root")),
       file_list_(spec.GetArgument<std::string>("file_list")),
@@ -159,6 +196,7 @@ class VideoLoader : public Loader<GPUBackend, SequenceWrapper> {
       image_type_(spec.GetArgument<DALIImageType>("image_type")),
       dtype_(spec.GetArgument<DALIDataType>("dtype")),
       normalized_(spec.GetArgument<bool>("normalized")),
+      resize_(resize),
       filenames_(filenames),
       codec_id_(0),
       skip_vfr_check_(spec.GetArgument<bool>("skip_vfr_check")),
@@ -166,10 +204,22 @@ class VideoLoader : public Loader<GPUBackend, SequenceWrapper> {
       file_list_include_preceding_frame_(
         spec.GetArgument<bool>("file_list_include_preceding_frame")),
       pad_sequences_(spec.GetArgument<bool>("pad_sequences")),
-      stats_({0, 0, 0, 0, 0}),
+      keyframe_index_(spec.GetArgument<bool>("keyframe_index")),
+      num_decoders_(spec.GetArgument<int>("num_decoders")),
       current_frame_idx_(-1),
       stop_(false) {
     DALI_ENFORCE(stride_ > 0, "Stride should be > 0");
+    DALI_ENFORCE(num_decoders_ > 0, "The number of decoders should be > 0");
+    std::vector<float> mean, stddev;
+    spec.TryGetRepeatedArgument(mean, "mean");
+    spec.TryGetRepeatedArgument(stddev, "std");
+    DALI_ENFORCE(mean.size() <= 1 || mean.size() == 3,
+                 make_string("``mean`` should have 1 or 3 values, got ", mean.size()));
+    DALI_ENFORCE(stddev.size() <= 1 || stddev.size() == 3,
+                 make_string("``std`` should have 1 or 3 values, got ", stddev.size()));
+    for (float s : stddev)
+      DALI_ENFORCE(s != 0, "``std`` must not contain zeros");
+    norm_ = FrameNormalization::FromMeanStd(mean, stddev);
     if (step_ < 0)
       step_ = count_ * stride_;
     if (!file_list_include_preceding_frame_) {
@@ -192,15 +242,19 @@ class VideoLoader : public Loader<GPUBackend, SequenceWrapper> {
 
   ~VideoLoader() noexcept override {
     stop_ = true;
-    send_queue_.shutdown();
-    if (vid_decoder_) {
-      vid_decoder_->finish();
+    for (auto& lane : lanes_) {
+      lane->send_queue.shutdown();
+      if (lane->decoder) {
+        lane->decoder->finish();
+      }
     }
-    if (thread_file_reader_.joinable()) {
-      try {
-        thread_file_reader_.join();
-      } catch (const std::system_error& e) {
-        // We should not throw here
+    for (auto& lane : lanes_) {
+      if (lane->file_reader.joinable()) {
+        try {
+          lane->file_reader.join();
+        } catch (const std::system_error& e) {
+          // We should not throw here
+        }
       }
     }
   }
@@ -208,11 +262,13 @@ class VideoLoader : public Loader<GPUBackend, SequenceWrapper> {
   void PrepareEmpty(SequenceWrapper &tensor) override;
   void ReadSample(SequenceWrapper &tensor) override;
 
-  VideoFile& get_or_open_file(const std::string &filename);
+  VideoFile& get_or_open_file(VideoDecoderLane& lane, const std::string &filename);
   void seek(VideoFile& file, int frame);
-  void read_file();
-  void push_sequence_to_read(std::string filename, int frame, int count);
-  void receive_frames(SequenceWrapper& sequence);
+  void seek_key_frame(VideoFile& file, int frame);
+  void load_or_build_index(VideoFile& file);
+  void read_file(VideoDecoderLane& lane);
+  void push_sequence_to_read(VideoDecoderLane& lane, std::string filename, int frame, int count);
+  void receive_frames(VideoDecoderLane& lane, SequenceWrapper& sequence);
 
  protected:
   Index SizeImpl() override;
@@ -220,8 +276,14 @@ class VideoLoader : public Loader<GPUBackend, SequenceWrapper> {
   void PrepareMetadataImpl() override {
     int total_count = 1 + (count_ - 1) * stride_;
 
+    for (int i = 0; i < num_decoders_; i++) {
+      lanes_.push_back(std::make_unique<VideoDecoderLane>());
+    }
+    // the metadata is read by the first lane; the others open the files as they need them
+    auto& first_lane = *lanes_[0];
+
     for (size_t i = 0; i < file_info_.size(); ++i) {
-      const auto& file = get_or_open_file(file_info_[i].video_file);
+      const auto& file = get_or_open_file(first_lane, file_info_[i].video_file);
       const auto stream = file.fmt_ctx_->streams[file.vid_stream_idx_];
       int frame_count = file.frame_count_;
 
@@ -309,17 +371,22 @@ class VideoLoader : public Loader<GPUBackend, SequenceWrapper> {
                  "length.");
 
 
-    const auto& file = get_or_open_file(file_info_[0].video_file);
+    const auto& file = get_or_open_file(first_lane, file_info_[0].video_file);
     auto stream = file.fmt_ctx_->streams[file.vid_stream_idx_];
 
-    vid_decoder_ = std::make_unique<NvDecoder>(device_id_,
-                                               codecpar(stream),
-                                               image_type_,
-                                               dtype_,
-                                               normalized_,
-                                               ALIGN16(max_height_),
-                                               ALIGN16(max_width_),
-                                               additional_decode_surfaces_);
+    for (auto& lane : lanes_) {
+      lane->decoder = std::make_unique<NvDecoder>(device_id_,
+                                                  codecpar(stream),
+                                                  image_type_,
+                                                  dtype_,
+                                                  normalized_,
+                                                  ALIGN16(max_height_),
+                                                  ALIGN16(max_width_),
+                                                  additional_decode_surfaces_,
+                                                  resize_.nearest ? ScaleMethod_Nearest
+                                                                  : ScaleMethod_Linear,
+                                                  norm_);
+    }
 
     if (shuffle_) {
       // TODO(spanev) decide of a policy for multi-gpu here and SequenceLoader
@@ -331,7 +398,9 @@ class VideoLoader : public Loader<GPUBackend, SequenceWrapper> {
 
     Reset(true);
 
-    thread_file_reader_ = std::thread{&VideoLoader::read_file, this};
+    for (auto& lane : lanes_) {
+      lane->file_reader = std::thread{&VideoLoader::read_file, this, std::ref(*lane)};
+    }
   }
 
  private:
@@ -355,6 +424,8 @@ class VideoLoader : public Loader<GPUBackend, SequenceWrapper> {
   DALIImageType image_type_;
   DALIDataType dtype_;
   bool normalized_;
+  VideoFrameResize resize_;
+  FrameNormalization norm_;
 
   std::vector<std::string> filenames_;
   std::vector<int> labels_;
@@ -364,15 +435,15 @@ class VideoLoader : public Loader<GPUBackend, SequenceWrapper> {
   bool file_list_frame_num_;
   bool file_list_include_preceding_frame_;
   bool pad_sequences_;
-  VideoLoaderStats stats_;
-
-  std::unordered_map<std::string, VideoFile> open_files_;
-  std::string last_opened_;
-  std::unique_ptr<NvDecoder> vid_decoder_;
+  bool keyframe_index_;
+  int num_decoders_;
 
-  ThreadSafeQueue<FrameReq> send_queue_;
+  /// the key frame indices, shared by the lanes
+  std::unordered_map<std::string, VideoIndex> indices_;
+  bool index_save_warned_ = false;
+  std::mutex index_mutex_;
 
-  std::thread thread_file_reader_;
+  std::vector<std::unique_ptr<VideoDecoderLane>> lanes_;
 
   std::vector<struct sequence_meta> frame_starts_;
   Index current_frame_idx_;
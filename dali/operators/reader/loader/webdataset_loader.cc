@@ -17,6 +17,7 @@
 #include <cstring>
 #include <limits>
 #include <memory>
+#include <random>
 #include <utility>
 #include "dali/core/error_handling.h"
 #include "dali/operators/reader/loader/webdataset/tar_utils.h"
@@ -133,7 +134,8 @@ WebdatasetLoader::WebdatasetLoader(const OpSpec& spec)
       paths_(spec.GetRepeatedArgument<std::string>("paths")),
       index_paths_(spec.GetRepeatedArgument<std::string>("index_paths")),
       missing_component_behavior_(detail::wds::ParseMissingExtBehavior(
-          spec.GetArgument<std::string>("missing_component_behavior"))) {
+          spec.GetArgument<std::string>("missing_component_behavior"))),
+      shuffle_after_epoch_(spec.GetArgument<bool>("shuffle_after_epoch")) {
   DALI_ENFORCE(paths_.size() == index_paths_.size(),
                "Number of webdataset archives does not match the number of index files");
   DALI_ENFORCE(paths_.size() > 0, "No webdataset archives provided");
@@ -167,6 +169,14 @@ WebdatasetLoader::WebdatasetLoader(const OpSpec& spec)
   }
   DALI_ENFORCE(ext_.size() == dtypes_.size(),
                "Number of extensions does not match the number of provided types");
+
+  // the same as in the FileLoader - every shard changes after each epoch
+  DALI_ENFORCE(!(shuffle_after_epoch_ && stick_to_shard_),
+               "shuffle_after_epoch and stick_to_shard cannot be both true");
+  DALI_ENFORCE(!(shuffle_after_epoch_ && shuffle_),
+               "shuffle_after_epoch and random_shuffle cannot be both true");
+  if (shuffle_after_epoch_)
+    stick_to_shard_ = true;
 }
 
 WebdatasetLoader::~WebdatasetLoader() {}
@@ -359,11 +369,16 @@ void WebdatasetLoader::PrepareMetadataImpl() {
       was_output_set.fill(false);
     }
   }
-  sample_index_ = start_index(shard_id_, num_shards_, samples_.size());
+  Reset(true);
 }
 
 void WebdatasetLoader::Reset(bool wrap_to_shard) {
   sample_index_ = wrap_to_shard ? start_index(shard_id_, num_shards_, samples_.size()) : 0;
+  current_epoch_++;
+
+  // the index allows random access - the samples are shuffled across all the archives
+  if (shuffle_after_epoch_)
+    ShuffleAfterEpoch(samples_, current_epoch_);
 }
 
 }  // namespace dali
@@ -44,8 +44,8 @@ Example manifest file::
     Only ``audio_filepath`` is field mandatory. If ``duration`` is not specified, the whole audio file will be used. A missing ``text`` field
     will produce an empty string as a text.
 
-.. warning::
-    Handling of ``duration`` and ``offset`` fields is not yet implemented. The current implementation always reads the whole audio file.
+When ``offset`` or ``duration`` is specified, the reader seeks to the start of the range and
+decodes only the requested fragment of the audio file.
 
 This reader produces between 1 and 3 outputs:
 
@@ -100,6 +100,29 @@ in seconds, of the audio samples.
 
 Samples with a duration longer than this value will be ignored.)code",
     0.0f)
+  .AddOptionalArg("bucket_boundaries",
+    R"code(If specified, the samples are grouped into batches of similar duration.
+
+The boundaries, in seconds and in ascending order, divide the durations given in the manifest
+into buckets. The reader collects ``bucketing_window`` samples, shuffles them within the buckets
+and emits each batch from a single bucket, which reduces the padding of the batches. The
+remainders of the buckets form mixed batches at the end of the window.
+
+Batches are aligned with the buckets when the shard size is a multiple of the batch size.
+This option can't be used together with ``random_shuffle``.)code",
+    std::vector<float>())
+  .AddOptionalArg("bucketing_window",
+    R"code(The number of samples sorted into the duration buckets at a time, rounded up to
+a multiple of the batch size.
+
+Used with ``bucket_boundaries``.)code",
+    1024)
+  .AddOptionalArg("bucketing_seed",
+    R"code(The seed of the shuffling within the duration buckets and of the order of
+the batches. It should be the same in all the shards.
+
+Used with ``bucket_boundaries``.)code",
+    0)
   .AddOptionalArg<bool>("normalize_text", "Normalize text.", nullptr)
   .DeprecateArg("normalize_text")  // deprecated since 0.28dev
   .AdditionalOutputsFn(NemoAsrReaderOutputFn)
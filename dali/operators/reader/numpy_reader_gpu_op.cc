@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cstring>
 #include <memory>
 #include <string>
 #include "dali/core/mm/memory.h"
@@ -56,6 +57,8 @@ NumpyReaderGPU::NumpyReaderGPU(const OpSpec& spec)
   bool shuffle_after_epoch = spec.GetArgument<bool>("shuffle_after_epoch");
   loader_ = InitLoader<NumpyLoaderGPU>(spec, std::vector<string>(), shuffle_after_epoch);
 
+  copy_stream_ = CUDAStream::Create(true, device_id_);
+
   kmgr_transpose_.Resize<TransposeKernel>(1, 1);
 }
 
@@ -113,13 +116,20 @@ void NumpyReaderGPU::Prefetch() {
   }
   curr_tensor_list.Resize(tmp_shapes, ref_type);
 
+  // the small samples have been read already, together with the headers
+  size_t host_bytes = 0;
+  for (size_t data_idx = 0; data_idx < curr_batch.size(); ++data_idx)
+    host_bytes += curr_batch[data_idx]->host_data.size();
+
   size_t chunk_size = static_cast<size_t>( \
-                        div_ceil(static_cast<uint64_t>(curr_tensor_list.nbytes()),
+                        div_ceil(static_cast<uint64_t>(curr_tensor_list.nbytes() - host_bytes),
                                  static_cast<uint64_t>(thread_pool_.NumThreads())));
 
   // read the data
   for (size_t data_idx = 0; data_idx < curr_tensor_list.ntensor(); ++data_idx) {
     curr_tensor_list.SetMeta(data_idx, curr_batch[data_idx]->get_meta());
+    if (!curr_batch[data_idx]->host_data.empty())
+      continue;
     size_t image_bytes = static_cast<size_t>(volume(curr_tensor_list.tensor_shape(data_idx))
                                              * curr_tensor_list.type_info().size());
     uint8_t* dst_ptr = static_cast<uint8_t*>(curr_tensor_list.raw_mutable_tensor(data_idx));
@@ -137,7 +147,36 @@ void NumpyReaderGPU::Prefetch() {
       image_bytes -= read_bytes;
     }
   }
-  thread_pool_.RunAll();
+  thread_pool_.RunAll(false);
+
+  // copy the small samples while the GPUDirect reads are running;
+  // consecutive samples are contiguous both in the staging buffer and in the tensor list
+  if (host_bytes > 0) {
+    if (host_bytes > staging_size_) {
+      staging_.reset();
+      staging_ = mm::alloc_raw_unique<uint8_t, mm::memory_kind::pinned>(host_bytes);
+      staging_size_ = host_bytes;
+    }
+    uint8_t *src = staging_.get();
+    size_t data_idx = 0, nsamples = curr_tensor_list.ntensor();
+    while (data_idx < nsamples) {
+      if (curr_batch[data_idx]->host_data.empty()) {
+        data_idx++;
+        continue;
+      }
+      auto *dst = static_cast<uint8_t*>(curr_tensor_list.raw_mutable_tensor(data_idx));
+      size_t run_bytes = 0;
+      for (; data_idx < nsamples && !curr_batch[data_idx]->host_data.empty(); data_idx++) {
+        auto &host_data = curr_batch[data_idx]->host_data;
+        std::memcpy(src + run_bytes, host_data.data(), host_data.size());
+        run_bytes += host_data.size();
+      }
+      CUDA_CALL(cudaMemcpyAsync(dst, src, run_bytes, cudaMemcpyHostToDevice, copy_stream_));
+      src += run_bytes;
+    }
+    CUDA_CALL(cudaStreamSynchronize(copy_stream_));
+  }
+  thread_pool_.WaitForWork();
 
   for (size_t data_idx = 0; data_idx < curr_tensor_list.ntensor(); ++data_idx) {
     curr_batch[data_idx]->file_stream->Close();
@@ -19,6 +19,8 @@
 #include <string>
 #include <vector>
 
+#include "dali/core/cuda_stream.h"
+#include "dali/core/mm/memory.h"
 #include "dali/kernels/kernel_manager.h"
 #include "dali/kernels/common/scatter_gather.h"
 #include "dali/kernels/transpose/transpose_gpu.h"
@@ -51,6 +53,11 @@ class NumpyReaderGPU : public NumpyReader<GPUBackend, NumpyFileWrapperGPU> {
 
   vector<TensorList<GPUBackend>> prefetched_batch_tensors_;
 
+  // the samples read to the host memory are packed here and copied to the device in bulk
+  mm::uptr<uint8_t> staging_;
+  size_t staging_size_ = 0;
+  CUDAStream copy_stream_;
+
   template <typename T, int Dims>
   TensorListView<StorageGPU, const T, Dims> GetCurrBatchView() {
     return view<const T, Dims>(prefetched_batch_tensors_[curr_batch_consumer_]);
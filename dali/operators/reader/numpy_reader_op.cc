@@ -46,14 +46,16 @@ static void CopyHelper(Tensor<CPUBackend> &output, const Tensor<CPUBackend> &inp
   }
 }
 
-static void TransposeHelper(Tensor<CPUBackend> &output, const Tensor<CPUBackend> &input) {
+static void TransposeHelper(Tensor<CPUBackend> &output, const Tensor<CPUBackend> &input,
+                            ThreadPool &thread_pool, int min_blk_sz) {
   int n_dims = input.shape().sample_dim();
   SmallVector<int, 6> perm;
   perm.resize(n_dims);
   for (int i = 0; i < n_dims; ++i)
     perm[i] = n_dims - i - 1;
   TYPE_SWITCH(input.type(), type2id, T, NUMPY_ALLOWED_TYPES, (
-    kernels::TransposeGrouped(view<T>(output), view<const T>(input), make_cspan(perm));
+    kernels::TransposeGrouped(thread_pool, view<T>(output), view<const T>(input),
+                              make_cspan(perm), min_blk_sz);
   ), DALI_FAIL(make_string("Unsupported input type: ", input.type())));  // NOLINT
 }
 
@@ -115,6 +117,10 @@ This operator can be used in the following modes:
 .. note::
   The ``gpu`` backend requires cuFile/GDS support (418.x driver family or newer). Please check
   the relevant GDS package for more details.
+
+.. note::
+  If the region-of-interest arguments are constant (not argument inputs), only the
+  region of interest is read from the file, unless it extends outside of the array.
 )")
   .NumInput(0)
   .NumOutput(1)  // (Arrays)
@@ -245,7 +251,6 @@ void NumpyReaderCPU::RunImpl(HostWorkspace &ws) {
   for (int i = 0; i < nsamples; i++) {
     const auto& file_i = GetSample(i);
     const auto& file_sh = file_i.get_shape();
-    int64_t sample_sz = volume(file_i.get_shape());
     if (need_slice_[i] && need_transpose_[i]) {
       SlicePermuteHelper(output[i], file_i.data, rois_[i], fill_value_, thread_pool, kThreshold,
                          blocks_per_sample);
@@ -253,10 +258,7 @@ void NumpyReaderCPU::RunImpl(HostWorkspace &ws) {
       SliceHelper(output[i], file_i.data, rois_[i], fill_value_, thread_pool, kThreshold,
                   blocks_per_sample);
     } else if (need_transpose_[i]) {
-      // TODO(janton): Parallelize when Transpose supports tiling
-      thread_pool.AddWork([&, i](int tid) {
-        TransposeHelper(output[i], file_i.data);
-      }, sample_sz * 8);  // 8 x (heuristic)
+      TransposeHelper(output[i], file_i.data, thread_pool, kThreshold);
     } else {
       CopyHelper(output[i], file_i.data, thread_pool, kThreshold, blocks_per_sample);
     }
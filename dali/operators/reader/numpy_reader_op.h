@@ -104,7 +104,8 @@ class NumpyReader : public DataReader<Backend, Target> {
       }
 
       bool need_slice = false;
-      if (has_roi_args) {
+      // the loader may have read only the region of interest already
+      if (has_roi_args && !file_i.roi_applied) {
         // Calculate the cropping window, based on the final layout (user provides axes in that
         // layout)
         auto full_sample_sh = sh.tensor_shape(i);  // already permuted dims
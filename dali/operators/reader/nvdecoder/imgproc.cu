@@ -15,6 +15,7 @@
 #include "dali/operators/reader/nvdecoder/imgproc.h"
 
 #include <cuda_fp16.h>
+#include "dali/core/float16.h"
 
 namespace dali {
 
@@ -64,7 +65,7 @@ __device__ uint8_t convert<uint8_t>(const float x) {
 
 template<typename YCbCr_T, typename RGB_T, bool Normalized = false>
 __device__ void ycbcr2rgb(const YCbCr<YCbCr_T>& ycbcr, RGB_T* rgb,
-                        size_t stride) {
+                        size_t stride, const FrameNormalization &norm) {
   auto y = (static_cast<float>(ycbcr.y) - 16.0f/255.0f);
   auto cb = (static_cast<float>(ycbcr.cb) - 128.0f/255.0f);
   auto cr = (static_cast<float>(ycbcr.cr) - 128.0f/255.0f);
@@ -83,9 +84,9 @@ __device__ void ycbcr2rgb(const YCbCr<YCbCr_T>& ycbcr, RGB_T* rgb,
     b = clip(y*m[6] + cb*m[7] + cr*m[8], 255.0f);
   }
 
-  rgb[0] = convert<RGB_T>(r);
-  rgb[stride] = convert<RGB_T>(g);
-  rgb[stride*2] = convert<RGB_T>(b);
+  rgb[0] = convert<RGB_T>(fmaf(r, norm.scale[0], norm.shift[0]));
+  rgb[stride] = convert<RGB_T>(fmaf(g, norm.scale[1], norm.shift[1]));
+  rgb[stride*2] = convert<RGB_T>(fmaf(b, norm.scale[2], norm.shift[2]));
 }
 
 template<typename T, bool Normalized = false, bool RGB = true>
@@ -93,18 +94,25 @@ __global__ void process_frame_kernel(
   cudaTextureObject_t luma, cudaTextureObject_t chroma,
   T* dst, int index,
   float fx, float fy,
-  int dst_width, int dst_height, int c) {
+  int dst_width, int dst_height, int c,
+  FrameNormalization norm) {
   const int dst_x = blockIdx.x * blockDim.x + threadIdx.x;
   const int dst_y = blockIdx.y * blockDim.y + threadIdx.y;
 
   if (dst_x >= dst_width || dst_y >= dst_height)
       return;
 
-  auto src_x = 0.0f;
-  // TODO(spanev) something less hacky here, why 4:2:0 fails on this edge?
-  float shift = (dst_x == dst_width - 1) ? 0 : 0.5f;
-  src_x = static_cast<float>(dst_x) * fx + shift;
-  auto src_y = static_cast<float>(dst_y) * fy + shift;
+  float src_x, src_y;
+  if (fx == 1.0f && fy == 1.0f) {
+    // TODO(spanev) something less hacky here, why 4:2:0 fails on this edge?
+    float shift = (dst_x == dst_width - 1) ? 0 : 0.5f;
+    src_x = static_cast<float>(dst_x) + shift;
+    src_y = static_cast<float>(dst_y) + shift;
+  } else {
+    // map the pixel centers, the same as the resampling does
+    src_x = (dst_x + 0.5f) * fx;
+    src_y = (dst_y + 0.5f) * fy;
+  }
 
   // https://docs.nvidia.com/cuda/cuda-c-programming-guide/index.html#tex2d-object
   YCbCr<float> ycbcr;
@@ -117,12 +125,12 @@ __global__ void process_frame_kernel(
 
   constexpr size_t stride = 1;
   if (RGB) {
-    ycbcr2rgb<float, T, Normalized>(ycbcr, out, stride);
+    ycbcr2rgb<float, T, Normalized>(ycbcr, out, stride, norm);
   } else {
     constexpr float scaling = Normalized ? 1.0f : 255.0f;
-    out[0] = convert<T>(ycbcr.y * scaling);
-    out[stride] = convert<T>(ycbcr.cb * scaling);
-    out[stride*2] = convert<T>(ycbcr.cr * scaling);
+    out[0] = convert<T>(fmaf(ycbcr.y * scaling, norm.scale[0], norm.shift[0]));
+    out[stride] = convert<T>(fmaf(ycbcr.cb * scaling, norm.scale[1], norm.shift[1]));
+    out[stride*2] = convert<T>(fmaf(ycbcr.cr * scaling, norm.scale[2], norm.shift[2]));
   }
 }
 
@@ -137,12 +145,9 @@ void process_frame(
   cudaTextureObject_t chroma, cudaTextureObject_t luma,
   SequenceWrapper& output, int index, cudaStream_t stream,
   uint16_t input_width, uint16_t input_height,
-  bool rgb, bool normalized) {
-  auto scale_width = input_width;
-  auto scale_height = input_height;
-
-  auto fx = static_cast<float>(input_width) / scale_width;
-  auto fy = static_cast<float>(input_height) / scale_height;
+  bool rgb, bool normalized, const FrameNormalization &norm) {
+  auto fx = static_cast<float>(input_width) / output.width;
+  auto fy = static_cast<float>(input_height) / output.height;
 
   dim3 block(32, 8);
   dim3 grid(divUp(output.width, block.x), divUp(output.height, block.y));
@@ -155,34 +160,36 @@ void process_frame(
   if (normalized) {
     if (rgb) {
       process_frame_kernel<T, true, true><<<grid, block, 0, stream>>>
-          (luma, chroma, tensor_out, index, fx, fy, output.width, output.height, output.channels);
+          (luma, chroma, tensor_out, index, fx, fy, output.width, output.height, output.channels,
+           norm);
     } else {
       process_frame_kernel<T, true, false><<<grid, block, 0, stream>>>
-          (luma, chroma, tensor_out, index, fx, fy, output.width, output.height, output.channels);
+          (luma, chroma, tensor_out, index, fx, fy, output.width, output.height, output.channels,
+           norm);
     }
   } else {
     if (rgb) {
       process_frame_kernel<T, false, true><<<grid, block, 0, stream>>>
-          (luma, chroma, tensor_out, index, fx, fy, output.width, output.height, output.channels);
+          (luma, chroma, tensor_out, index, fx, fy, output.width, output.height, output.channels,
+           norm);
     } else {
       process_frame_kernel<T, false, false><<<grid, block, 0, stream>>>
-          (luma, chroma, tensor_out, index, fx, fy, output.width, output.height, output.channels);
+          (luma, chroma, tensor_out, index, fx, fy, output.width, output.height, output.channels,
+           norm);
     }
   }
 }
 
-template
-void process_frame<float>(
-  cudaTextureObject_t chroma, cudaTextureObject_t luma,
-  SequenceWrapper& output, int index, cudaStream_t stream,
-  uint16_t input_width, uint16_t input_height,
-  bool rgb, bool normalized);
-
-template
-void process_frame<uint8_t>(
-  cudaTextureObject_t chroma, cudaTextureObject_t luma,
-  SequenceWrapper& output, int index, cudaStream_t stream,
-  uint16_t input_width, uint16_t input_height,
-  bool rgb, bool normalized);
+#define INSTANTIATE_PROCESS_FRAME(T)                          \
+  template                                                    \
+  void process_frame<T>(                                      \
+    cudaTextureObject_t chroma, cudaTextureObject_t luma,     \
+    SequenceWrapper& output, int index, cudaStream_t stream,  \
+    uint16_t input_width, uint16_t input_height,              \
+    bool rgb, bool normalized, const FrameNormalization &norm);
+
+INSTANTIATE_PROCESS_FRAME(float)
+INSTANTIATE_PROCESS_FRAME(float16)
+INSTANTIATE_PROCESS_FRAME(uint8_t)
 
 }  // namespace dali
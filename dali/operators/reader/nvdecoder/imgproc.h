@@ -16,17 +16,56 @@
 #define DALI_OPERATORS_READER_NVDECODER_IMGPROC_H_
 
 
+#include <vector>
 #include "dali/core/common.h"
 #include "dali/operators/reader/nvdecoder/sequencewrapper.h"
 
 namespace dali {
 
+/**
+ * @brief Per-channel normalization applied to the converted pixels: `out = in * scale + shift`
+ *
+ * The values are in the range of the output (0..255, or 0..1 for the normalized output).
+ */
+struct FrameNormalization {
+  float scale[3] = { 1.0f, 1.0f, 1.0f };
+  float shift[3] = { 0.0f, 0.0f, 0.0f };
+
+  /**
+   * @brief Makes a normalization computing `(in - mean) / stddev`
+   *
+   * The mean and the standard deviation can have one value for all the channels or one
+   * per channel. Empty vectors stand for 0 and 1, respectively.
+   */
+  static FrameNormalization FromMeanStd(const std::vector<float> &mean,
+                                        const std::vector<float> &stddev) {
+    FrameNormalization norm;
+    for (int c = 0; c < 3; c++) {
+      float m = mean.empty() ? 0.0f : mean[mean.size() == 1 ? 0 : c];
+      float s = stddev.empty() ? 1.0f : stddev[stddev.size() == 1 ? 0 : c];
+      norm.scale[c] = 1.0f / s;
+      norm.shift[c] = -m / s;
+    }
+    return norm;
+  }
+};
+
+/**
+ * @brief Converts a decoded NV12 frame to RGB or YCbCr, resizing it to the size of the output
+ *        sequence and applying the normalization, in one pass
+ *
+ * The frame is sampled through the textures, so the resizing uses the filter mode of the luma
+ * texture (nearest neighbor or bilinear).
+ *
+ * @param input_width   the width of the frame, used to calculate the scale
+ * @param input_height  the height of the frame, used to calculate the scale
+ */
 template<typename T>
 DLL_PUBLIC void process_frame(
     cudaTextureObject_t chroma, cudaTextureObject_t luma,
     SequenceWrapper& output, int index, cudaStream_t stream,
     uint16_t input_width, uint16_t input_height,
-    bool rgb, bool normalized);
+    bool rgb, bool normalized, const FrameNormalization &norm = {});
 
 }  // namespace dali
 
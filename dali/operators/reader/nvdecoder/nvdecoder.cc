@@ -46,9 +46,12 @@ NvDecoder::NvDecoder(int device_id,
                      bool normalized,
                      int max_height,
                      int max_width,
-                     int additional_decode_surfaces)
+                     int additional_decode_surfaces,
+                     ScaleMethod scale_method,
+                     const FrameNormalization &norm)
     : device_id_(device_id),
       rgb_(image_type == DALI_RGB), dtype_(dtype), normalized_(normalized),
+      scale_method_(scale_method), norm_(norm),
       device_(), parser_(), decoder_(max_height, max_width, additional_decode_surfaces),
       frame_in_use_(32),  // 32 is cuvid's max number of decode surfaces
       recv_queue_(), frame_queue_(),
@@ -352,7 +355,7 @@ int NvDecoder::handle_display_(CUVIDPARSERDISPINFO* disp_info) {
     return kNvcuvid_success;
   }
 
-  if (frame != current_recv_.frame) {
+  if (!current_recv_.display_order && frame != current_recv_.frame) {
     // TODO(spanev) This definitely needs better error handling...
     // Add exception? Directly or after countdown treshold?
     LOG_LINE << "Ditching frame " << frame << " since we are waiting for "
@@ -406,6 +409,11 @@ void NvDecoder::receive_frames(SequenceWrapper& sequence) {
 
       auto* frame_disp_info = frame_queue_.pop();
       if (stop_) break;
+      if (!frame_disp_info) {
+        // the request ended early, see end_req
+        sequence.count = i;
+        break;
+      }
       auto frame = MappedFrame{frame_disp_info, decoder_, stream_};
       sequence.timestamps.push_back(frame_disp_info->timestamp * av_q2d(
             nv_time_base_));
@@ -422,7 +430,7 @@ void NvDecoder::receive_frames(SequenceWrapper& sequence) {
       cudaMemsetAsync(sequence.sequence.mutable_data<OutputType>() + data_size, 0, pad_size,
                       stream_);
     ), DALI_FAIL(make_string("Not supported output type:", dtype_, // NOLINT
-        "Only DALI_UINT8 and DALI_FLOAT are supported as the decoder outputs.")););
+        "Only DALI_UINT8, DALI_FLOAT16 and DALI_FLOAT are supported as the decoder outputs.")););
   }
   record_sequence_event_(sequence);
 }
@@ -488,24 +496,40 @@ void NvDecoder::convert_frame(const MappedFrame& frame, SequenceWrapper& sequenc
   auto input_height = decoder_.height();
 
   auto output_idx = index;
-  // TODO(spanev) Add ScaleMethod choice
   auto& textures = this->get_textures(frame.get_ptr(),
                                       frame.get_pitch(),
                                       input_width,
                                       input_height,
-                                      ScaleMethod_Linear);
+                                      scale_method_);
+  // unless the frames are resized, they are converted with the scale of 1
+  uint16_t scale_width = sequence.resized ? decoder_.width() : sequence.width;
+  uint16_t scale_height = sequence.resized ? input_height : sequence.height;
   TYPE_SWITCH(dtype_, type2id, OutputType, NVDECODER_SUPPORTED_TYPES, (
       process_frame<OutputType>(textures.chroma, textures.luma,
                   sequence,
                   output_idx, stream_,
-                  input_width, input_height,
-                  rgb_, normalized_);
+                  scale_width, scale_height,
+                  rgb_, normalized_, norm_);
     ), DALI_FAIL(make_string("Not supported output type:", dtype_, // NOLINT
-        "Only DALI_UINT8 and DALI_FLOAT are supported as the decoder outputs.")););
+        "Only DALI_UINT8, DALI_FLOAT16 and DALI_FLOAT are supported as the decoder outputs.")););
 
   frame_in_use_[frame.disp_info->picture_index] = false;
 }
 
+void NvDecoder::end_req() {
+  if (current_recv_.count <= 0) {
+    // no frame of the request was displayed
+    if (recv_queue_.empty())
+      return;
+    current_recv_ = recv_queue_.pop();
+  }
+  if (current_recv_.count > 0) {
+    LOG_LINE << "Request ended " << current_recv_.count << " frames short" << std::endl;
+    current_recv_.count = 0;
+    frame_queue_.push(nullptr);
+  }
+}
+
 void NvDecoder::finish() {
   stop_ = true;
   recv_queue_.shutdown();
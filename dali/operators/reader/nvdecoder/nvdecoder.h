@@ -33,6 +33,7 @@ extern "C" {
 #include "dali/core/dynlink_cuda.h"
 #include "dali/core/cuda_stream.h"
 #include "dali/operators/reader/nvdecoder/sequencewrapper.h"
+#include "dali/operators/reader/nvdecoder/imgproc.h"
 #include "dali/operators/reader/nvdecoder/cuvideoparser.h"
 #include "dali/operators/reader/nvdecoder/cuvideodecoder.h"
 #include "dali/operators/reader/nvdecoder/dynlink_nvcuvid.h"
@@ -51,7 +52,7 @@ using CodecParameters = AVCodecContext;
 
 namespace dali {
 
-#define NVDECODER_SUPPORTED_TYPES (float, uint8_t)
+#define NVDECODER_SUPPORTED_TYPES (float, float16, uint8_t)
 
 struct FrameReq {
   std::string filename;
@@ -59,6 +60,8 @@ struct FrameReq {
   int count;
   int stride;
   AVRational frame_base;
+  /// take the next `count` frames in the display order, instead of matching their timestamps
+  bool display_order = false;
 };
 
 enum ScaleMethod {
@@ -82,7 +85,9 @@ class NvDecoder {
             bool normalized,
             int max_height,
             int max_width,
-            int additional_decode_surfaces);
+            int additional_decode_surfaces,
+            ScaleMethod scale_method = ScaleMethod_Linear,
+            const FrameNormalization &norm = {});
 
   // Some of the members are non-movable or non-copyable so the constructors below still end up
   // implicitly deleted, thus marking them explicitly deleted as this class in managed through
@@ -108,6 +113,14 @@ class NvDecoder {
 
   void receive_frames(SequenceWrapper& batch);
 
+  /**
+   * @brief Ends the current request, after all its packets were decoded and the decoder flushed
+   *
+   * If fewer frames than requested were displayed, the sequence received for the request
+   * is shortened to the frames decoded so far. Called by the thread which decodes the packets.
+   */
+  void end_req();
+
   void finish();
 
  private:
@@ -178,6 +191,9 @@ class NvDecoder {
   bool rgb_;
   DALIDataType dtype_;
   bool normalized_;
+  /// the filtering used when the frames are resized during the conversion
+  ScaleMethod scale_method_;
+  FrameNormalization norm_;
 
   CUdevice device_;
   CUVideoParser parser_;
@@ -30,7 +30,7 @@
 
 namespace dali {
 
-#define SEQUENCEWRAPPER_SUPPORTED_TYPES (float, uint8_t)
+#define SEQUENCEWRAPPER_SUPPORTED_TYPES (float, float16, uint8_t)
 
 // Struct that Loader::ReadOne will read
 struct SequenceWrapper {
@@ -38,13 +38,14 @@ struct SequenceWrapper {
   SequenceWrapper() = default;
 
   void initialize(int count, int max_count, int height, int width, int channels,
-                  DALIDataType dtype) {
+                  DALIDataType dtype, bool resized = false) {
     this->count = count;
     this->max_count = max_count;
     this->height = height;
     this->width = width;
     this->channels = channels;
     this->dtype = dtype;
+    this->resized = resized;
 
     timestamps.clear();
     timestamps.reserve(max_count);
@@ -84,7 +85,16 @@ struct SequenceWrapper {
   int label = -1;
   vector<double> timestamps;
   int first_frame_idx = -1;
+  /// the index of the source file, used to group the sequences read from the same file
+  int file_idx = -1;
+  /// the decoder session which decodes the sequence
+  int decoder_idx = 0;
   DALIDataType dtype = DALI_NO_TYPE;
+  /// the frames are resized to `height` x `width` while being converted from the decoded surfaces
+  bool resized = false;
+  /// schedules the decoding of the sequence
+  std::function<void(void)> request_sample_f;
+  /// waits for the frames requested with `request_sample_f`, in the same order
   std::function<void(void)> read_sample_f;
 
  private:
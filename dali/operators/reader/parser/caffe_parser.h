@@ -15,11 +15,18 @@
 #ifndef DALI_OPERATORS_READER_PARSER_CAFFE_PARSER_H_
 #define DALI_OPERATORS_READER_PARSER_CAFFE_PARSER_H_
 
+#include <exception>
 #include "dali/operators/reader/parser/parser.h"
-#include "dali/operators/reader/parser/caffe.pb.h"
+#include "dali/operators/reader/parser/tfrecord_wire_format.h"
 
 namespace dali {
 
+/**
+ * @brief Parses `caffe.Datum` messages, straight from their protobuf wire format
+ *
+ * The image is not copied out of the message - when the loader shares the data of the database,
+ * the output is a view of it.
+ */
 class CaffeParser : public Parser<Tensor<CPUBackend>> {
  public:
   explicit CaffeParser(const OpSpec& spec) :
@@ -28,41 +35,95 @@ class CaffeParser : public Parser<Tensor<CPUBackend>> {
     label_available_(spec.GetArgument<bool>("label_available")) {}
 
   void Parse(const Tensor<CPUBackend>& data, SampleWorkspace* ws) override {
-    caffe::Datum datum;
+    Datum datum;
+    try {
+      datum = ReadDatum(data);
+    } catch (std::exception &e) {
+      DALI_FAIL(make_string("Error while parsing Caffe file: ", data.GetSourceInfo(),
+                            " (raw data length: ", data.size(), " bytes): ", e.what()));
+    }
     int out_tensors = 0;
-    DALI_ENFORCE(datum.ParseFromArray(data.raw_data(), data.size()),
-      make_string("Error while parsing Caffe file: ", data.GetSourceInfo(),
-                  " (raw data length: ", data.size(), " bytes)."));
 
-    if (image_available_ && datum.has_data()) {
-      bool encoded_data = true;
+    if (image_available_ && datum.has_data) {
       auto& image = ws->Output<CPUBackend>(out_tensors);
-      if (datum.has_encoded() && !datum.encoded()) {
-        encoded_data = false;
-      }
-      // copy image
-      if (encoded_data) {
-        image.Resize({static_cast<Index>(datum.data().size())});
+      const auto &bytes = datum.data;
+      if (datum.encoded) {
+        ShareOrCopy(image, data, bytes.data, {static_cast<Index>(bytes.size())}, DALI_UINT8);
       } else {
-        image.Resize({datum.height(), datum.width(), datum.channels()});
+        TensorShape<> shape{datum.height, datum.width, datum.channels};
+        DALI_ENFORCE(volume(shape) == static_cast<Index>(bytes.size()),
+          make_string("The size of the image data in the Caffe file ", data.GetSourceInfo(),
+                      " doesn't match its shape: ", bytes.size(), " bytes vs ", shape, "."));
+        ShareOrCopy(image, data, bytes.data, shape, DALI_UINT8);
       }
-      std::memcpy(image.mutable_data<uint8_t>(), datum.data().data(),
-                  datum.data().size()*sizeof(uint8_t));
       image.SetSourceInfo(data.GetSourceInfo());
       out_tensors++;
     }
 
-    if (label_available_ && datum.has_label()) {
+    if (label_available_ && datum.has_label) {
       auto& label = ws->Output<CPUBackend>(out_tensors);
 
       // copy label
       label.Resize({1});
-      label.mutable_data<int>()[0] = datum.label();
+      label.mutable_data<int>()[0] = datum.label;
       out_tensors++;
     }
   }
 
  private:
+  /// the fields of `caffe.Datum` used by the parser, see proto/caffe.proto
+  struct Datum {
+    int channels = 0, height = 0, width = 0;
+    bool has_data = false;
+    tfrecord_wire::Span data;
+    bool has_label = false;
+    int label = 0;
+    // the data is treated as encoded, unless stated otherwise
+    bool encoded = true;
+  };
+
+  static Datum ReadDatum(const Tensor<CPUBackend>& message) {
+    namespace wire = tfrecord_wire;
+    const uint8_t *begin = message.data<uint8_t>();
+    Datum datum;
+    uint32_t field;
+    wire::WireType type;
+    wire::Span value;
+    wire::FieldReader reader({begin, begin + message.size()});
+    while (reader.Next(field, type, value)) {
+      if (field == 4 && type == wire::kLengthDelimited) {
+        datum.has_data = true;
+        datum.data = value;
+        continue;
+      }
+      if (type != wire::kVarint)
+        continue;
+      const uint8_t *p = value.data;
+      auto number = wire::ReadVarint(p, value.end);
+      switch (field) {
+        case 1:
+          datum.channels = static_cast<int>(number);
+          break;
+        case 2:
+          datum.height = static_cast<int>(number);
+          break;
+        case 3:
+          datum.width = static_cast<int>(number);
+          break;
+        case 5:
+          datum.has_label = true;
+          datum.label = static_cast<int>(number);
+          break;
+        case 7:
+          datum.encoded = number != 0;
+          break;
+        default:
+          break;
+      }
+    }
+    return datum;
+  }
+
   bool image_available_;
   bool label_available_;
 };
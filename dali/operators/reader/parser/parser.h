@@ -15,10 +15,34 @@
 #ifndef DALI_OPERATORS_READER_PARSER_PARSER_H_
 #define DALI_OPERATORS_READER_PARSER_PARSER_H_
 
+#include <cstring>
+#include <memory>
 #include "dali/pipeline/workspace/sample_workspace.h"
 
 namespace dali {
 
+/**
+ * @brief Sets `output` to the part of the loaded `data` which starts at `ptr`
+ *
+ * When `data` shares the memory of its source, e.g. a mapped file, `output` becomes a view
+ * of that memory and keeps it alive. Otherwise the data is copied, as the memory owned by
+ * the loaded tensors is reused for the next samples.
+ */
+inline void ShareOrCopy(Tensor<CPUBackend> &output, const Tensor<CPUBackend> &data,
+                        const void *ptr, const TensorShape<> &shape, DALIDataType type) {
+  if (data.shares_data()) {
+    size_t bytes = volume(shape) * TypeTable::GetTypeInfo(type).size();
+    output.Reset();
+    output.ShareData(std::shared_ptr<void>(data.get_data_ptr(), const_cast<void *>(ptr)),
+                     bytes, shape, type);
+    return;
+  }
+  if (output.shares_data())
+    output.Reset();
+  output.Resize(shape, type);
+  std::memcpy(output.raw_mutable_data(), ptr, output.nbytes());
+}
+
 /**
  * @brief Base class for parsing data returned from a Loader
  *
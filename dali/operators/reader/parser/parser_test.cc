@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <cstring>
 #include <memory>
 #include <vector>
 
@@ -23,6 +24,8 @@
 #include "dali/test/dali_test.h"
 #include "dali/pipeline/workspace/sample_workspace.h"
 #include "dali/operators/reader/parser/parser.h"
+#include "dali/operators/reader/parser/caffe_parser.h"
+#include "dali/operators/reader/parser/recordio_parser.h"
 
 namespace dali {
 
@@ -85,5 +88,64 @@ TYPED_TEST(ParserTest, BasicTest) {
   parser.Parse(ia_wrapper, &ws);
 }
 
+namespace {
+
+/**
+ * @brief Parses `record` loaded either to a tensor that shares the data (like a mapped file)
+ *        or to one that owns it and checks if the first output is a view of the record
+ */
+template <typename ParserType>
+void ParseShared(ParserType &parser, std::vector<uint8_t> &record, bool share, int num_outputs,
+                 const uint8_t *expected_image, size_t image_size) {
+  Tensor<CPUBackend> data;
+  if (share) {
+    data.ShareData(record.data(), record.size(), {static_cast<Index>(record.size())}, DALI_UINT8);
+  } else {
+    data.Resize({static_cast<Index>(record.size())}, DALI_UINT8);
+    std::memcpy(data.raw_mutable_data(), record.data(), record.size());
+  }
+  HostWorkspace workspace;
+  SampleWorkspace ws;
+  workspace.GetSample(&ws, 0, 0);
+  for (int i = 0; i < num_outputs; i++)
+    ws.AddOutput(std::make_shared<Tensor<CPUBackend>>());
+  parser.Parse(data, &ws);
+  auto &image = ws.Output<CPUBackend>(0);
+  ASSERT_EQ(image.size(), static_cast<Index>(image_size));
+  EXPECT_EQ(std::memcmp(image.raw_data(), expected_image, image_size), 0);
+  EXPECT_EQ(image.shares_data(), share);
+  auto *image_data = static_cast<const uint8_t*>(image.raw_data());
+  bool in_record = image_data >= data.data<uint8_t>() &&
+                   image_data < data.data<uint8_t>() + data.size();
+  EXPECT_EQ(in_record, share);
+}
+
+}  // namespace
+
+TEST(CaffeParserTest, SharesMappedData) {
+  std::vector<uint8_t> image = {0xff, 0xd8, 1, 2, 3, 4, 5};
+  // data = 4 (length-delimited), label = 5 (varint)
+  std::vector<uint8_t> record = {4 << 3 | 2, static_cast<uint8_t>(image.size())};
+  record.insert(record.end(), image.begin(), image.end());
+  record.insert(record.end(), {5 << 3, 42});
+  CaffeParser parser(OpSpec("CaffeReader"));
+  for (bool share : {true, false})
+    ParseShared(parser, record, share, 2, image.data(), image.size());
+}
+
+TEST(RecordIOParserTest, SharesMappedData) {
+  std::vector<uint8_t> image = {0xff, 0xd8, 1, 2, 3, 4, 5};
+  ImageRecordIOHeader header = {0, 7.0f, {0, 0}};
+  uint32_t magic = 0xced7230a;
+  uint32_t length = sizeof(header) + image.size();  // a single chunk - the flag is 0
+  std::vector<uint8_t> record(sizeof(magic) + sizeof(length) + sizeof(header));
+  std::memcpy(record.data(), &magic, sizeof(magic));
+  std::memcpy(record.data() + sizeof(magic), &length, sizeof(length));
+  std::memcpy(record.data() + sizeof(magic) + sizeof(length), &header, sizeof(header));
+  record.insert(record.end(), image.begin(), image.end());
+  RecordIOParser parser(OpSpec("MXNetReader"));
+  for (bool share : {true, false})
+    ParseShared(parser, record, share, 2, image.data(), image.size());
+}
 
 }  // namespace dali
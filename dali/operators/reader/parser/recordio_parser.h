@@ -37,7 +37,7 @@ class RecordIOParser : public Parser<Tensor<CPUBackend>> {
   void Parse(const Tensor<CPUBackend>& data, SampleWorkspace* ws) override {
     auto& image = ws->Output<CPUBackend>(0);
     auto& label = ws->Output<CPUBackend>(1);
-    ReadSingleImageRecordIO(image, label, data.data<uint8_t>());
+    ReadSingleImageRecordIO(image, label, data);
     image.SetSourceInfo(data.GetSourceInfo());
   }
 
@@ -56,9 +56,11 @@ class RecordIOParser : public Parser<Tensor<CPUBackend>> {
     *in += sizeof(T);
   }
 
+  // the image of a record stored in a single chunk is shared with the loaded data, if possible
   inline void ReadSingleImageRecordIO(Tensor<CPUBackend>& o_image,
                 Tensor<CPUBackend>& o_label,
-                const uint8_t* input) {
+                const Tensor<CPUBackend>& data) {
+    const uint8_t* input = data.data<uint8_t>();
     uint32_t magic;
     const uint32_t kMagic = 0xced7230a;
     ReadSingle<uint32_t>(&input, &magic);
@@ -83,9 +85,7 @@ class RecordIOParser : public Parser<Tensor<CPUBackend>> {
     int64_t label_size = hdr.flag * sizeof(float);
     int64_t image_size = data_size - label_size;
     if (cflag == 0) {
-      o_image.Resize({image_size});
-      uint8_t* data = o_image.mutable_data<uint8_t>();
-      memcpy(data, input + label_size, image_size);
+      ShareOrCopy(o_image, data, input + label_size, {image_size}, DALI_UINT8);
       if (hdr.flag > 0) {
         float * label = o_label.mutable_data<float>();
         memcpy(label, input, label_size);
@@ -115,9 +115,11 @@ class RecordIOParser : public Parser<Tensor<CPUBackend>> {
         memcpy(&temp_vec[s], input, clength);
         input += clength;
       }
+      if (o_image.shares_data())
+        o_image.Reset();
       o_image.Resize({static_cast<Index>(temp_vec.size() - label_size)});
-      uint8_t* data = o_image.mutable_data<uint8_t>();
-      memcpy(data, (&temp_vec[0]) + label_size, temp_vec.size() - label_size);
+      uint8_t* image = o_image.mutable_data<uint8_t>();
+      memcpy(image, (&temp_vec[0]) + label_size, temp_vec.size() - label_size);
       if (hdr.flag > 0) {
         float * label = o_label.mutable_data<float>();
         memcpy(label, &temp_vec[0], label_size);
@@ -27,50 +27,55 @@ void SequenceParser::Parse(const TensorSequence& data, SampleWorkspace* ws) {
   Index seq_length = data.tensors.size();
 
   // Decode first frame, obtain it's size and allocate output
-  {
-    auto file_name = data.tensors[0].GetSourceInfo();
-    std::unique_ptr<Image> img;
+  auto img = DecodeFirstFrame(data.tensors[0]);
+  const auto shape = img->GetShape();
+  // Calculate shape of sequence tensor, that is Frames x (Frame Shape)
+  sequence.Resize({seq_length, shape[0], shape[1], shape[2]});
+  img->GetImage(sequence.mutable_data<uint8_t>());
 
-    try {
-      img = ImageFactory::CreateImage(
-        data.tensors[0].data<uint8_t>(), data.tensors[0].size(), image_type_);
-      img->Decode();
-    } catch (std::exception &e) {
-      DALI_FAIL(e.what() + ". File: " + file_name);
-    }
-    const auto decoded = img->GetImage();
-
-    const auto shape = img->GetShape();
-    const Index h = shape[0];
-    const Index w = shape[1];
-    const Index c = shape[2];
-    const auto frame_size = volume(shape);
+  // Decode rest of the frames straight into the sequence
+  const auto frame_size = volume(shape);
+  for (Index frame = 1; frame < seq_length; frame++) {
+    DecodeFrame(data.tensors[frame], shape,
+                sequence.mutable_data<uint8_t>() + frame * frame_size);
+  }
+}
 
-    // Calculate shape of sequence tensor, that is Frames x (Frame Shape)
-    auto seq_shape = std::vector<Index>{seq_length, h, w, c};
-    sequence.Resize(seq_shape);
-    // Take a view tensor for first frame and copy it to target sequence
-    auto view_0 = sequence.SubspaceTensor(0);
-    std::memcpy(view_0.raw_mutable_data(), decoded.get(), frame_size);
+std::unique_ptr<Image> SequenceParser::DecodeFirstFrame(const Tensor<CPUBackend>& frame) const {
+  std::unique_ptr<Image> img;
+  try {
+    img = ImageFactory::CreateImage(frame.data<uint8_t>(), frame.size(), image_type_);
+    img->Decode();
+  } catch (std::exception &e) {
+    DALI_FAIL(e.what() + ". File: " + frame.GetSourceInfo());
   }
+  return img;
+}
 
-  // Decode and copy rest of the frames
-  for (Index frame = 1; frame < seq_length; frame++) {
-    auto view_tensor = sequence.SubspaceTensor(frame);
-    auto file_name = data.tensors[frame].GetSourceInfo();
-    std::unique_ptr<Image> img;
-    try {
-      img = ImageFactory::CreateImage(data.tensors[frame].data<uint8_t>(),
-                                      data.tensors[frame].size(), image_type_);
-      img->Decode();
-    } catch (std::exception &e) {
-      DALI_FAIL(e.what() + ". File: " + file_name);
-    }
-    img->GetImage(view_tensor.mutable_data<uint8_t>());
-    DALI_ENFORCE(view_tensor.shares_data(),
-                 "Buffer view was invalidated after image decoding, frames do not match in "
-                 "dimensions");
+void SequenceParser::DecodeFrame(const Tensor<CPUBackend>& frame,
+                                 const Image::Shape& frame_shape, uint8_t* dst) const {
+  std::unique_ptr<Image> img;
+  // receives the frames of a wrong shape, which are then rejected
+  std::vector<uint8_t> mismatched;
+  try {
+    img = ImageFactory::CreateImage(frame.data<uint8_t>(), frame.size(), image_type_);
+    img->SetOutputAllocator([&](const Image::Shape& shape) {
+      if (shape == frame_shape)
+        return dst;
+      mismatched.resize(volume(shape));
+      return mismatched.data();
+    });
+    img->Decode();
+  } catch (std::exception &e) {
+    DALI_FAIL(e.what() + ". File: " + frame.GetSourceInfo());
   }
+  DALI_ENFORCE(img->GetShape() == frame_shape,
+               make_string("The frames of a sequence do not match in dimensions: ",
+                           img->GetShape(), " vs ", frame_shape, ". File: ",
+                           frame.GetSourceInfo()));
+  auto decoded = img->GetImage();
+  if (decoded.get() != dst)  // not decoded in place
+    img->GetImage(dst);
 }
 
 }  // namespace dali
@@ -15,6 +15,8 @@
 #ifndef DALI_OPERATORS_READER_PARSER_SEQUENCE_PARSER_H_
 #define DALI_OPERATORS_READER_PARSER_SEQUENCE_PARSER_H_
 
+#include <memory>
+#include "dali/image/image.h"
 #include "dali/operators/reader/loader/sequence_loader.h"
 #include "dali/operators/reader/parser/parser.h"
 
@@ -27,6 +29,19 @@ class SequenceParser : public Parser<TensorSequence> {
 
   void Parse(const TensorSequence& data, SampleWorkspace* ws) override;
 
+  /**
+   * @brief Decodes the first frame of a sequence, which determines the shape of the frames
+   */
+  std::unique_ptr<Image> DecodeFirstFrame(const Tensor<CPUBackend>& frame) const;
+
+  /**
+   * @brief Decodes a frame into `dst`, which fits an image of `frame_shape`
+   *
+   * Fails if the frame has a different shape.
+   */
+  void DecodeFrame(const Tensor<CPUBackend>& frame, const Image::Shape& frame_shape,
+                   uint8_t* dst) const;
+
  private:
   DALIImageType image_type_;
 };
@@ -23,10 +23,12 @@
 #include <functional>
 
 #include "dali/core/common.h"
+#include "dali/core/small_vector.h"
 #include "dali/pipeline/operator/argument.h"
 #include "dali/pipeline/operator/op_spec.h"
 #include "dali/operators/reader/parser/parser.h"
 #include "dali/operators/reader/parser/tf_feature.h"
+#include "dali/operators/reader/parser/tfrecord_wire_format.h"
 #include "dali/operators/reader/parser/example.pb.h"
 
 namespace dali {
@@ -44,6 +46,7 @@ class TFRecordParser : public Parser<Tensor<CPUBackend>> {
         "Number of features needs to match number of feature names.");
     DALI_ENFORCE(features_.size() > 0,
         "No features provided");
+    use_fast_parser_ = spec.GetArgument<bool>("use_fast_parser");
   }
 
   void Parse(const Tensor<CPUBackend>& data, SampleWorkspace* ws) override {
@@ -58,6 +61,13 @@ class TFRecordParser : public Parser<Tensor<CPUBackend>> {
 
     // Omit length and crc
     raw_data = raw_data + sizeof(length) + sizeof(crc);
+    if (use_fast_parser_) {
+      DALI_ENFORCE(sizeof(length) + sizeof(crc) + length <= static_cast<uint64_t>(data.size()),
+        make_string("Error while parsing TFRecord file: ", data.GetSourceInfo(),
+                    " (raw data length: ", length, "bytes exceeds the record)."));
+      ParseWireFormat(raw_data, length, data, ws);
+      return;
+    }
     DALI_ENFORCE(example.ParseFromArray(raw_data, length),
       make_string("Error while parsing TFRecord file: ", data.GetSourceInfo(),
                   " (raw data length: ", length, "bytes)."));
@@ -69,19 +79,7 @@ class TFRecordParser : public Parser<Tensor<CPUBackend>> {
       auto& feature = example.features().feature();
       auto it = feature.find(name);
       if (it == feature.end()) {
-        output.Resize({0});
-        // set type
-        switch (f.GetType()) {
-          case FeatureType::int64:
-             output.Resize({0}, DALI_INT64);
-            break;
-          case FeatureType::string:
-             output.Resize({0}, DALI_UINT8);
-            break;
-          case FeatureType::float32:
-             output.Resize({0}, DALI_FLOAT);
-            break;
-        }
+        SetEmpty(output, f);
         output.SetSourceInfo(data.GetSourceInfo());
         continue;
       }
@@ -134,8 +132,102 @@ class TFRecordParser : public Parser<Tensor<CPUBackend>> {
   }
 
  private:
+  /**
+   * @brief Decodes the features straight from the serialized `Example`
+   *
+   * The values are written to the outputs with a single copy (or varint decoding),
+   * without building the protobuf message.
+   */
+  void ParseWireFormat(const uint8_t *example, uint64_t length, const Tensor<CPUBackend> &data,
+                       SampleWorkspace *ws) {
+    using tfrecord_wire::FeatureKind;
+    SmallVector<tfrecord_wire::FeatureView, 8> views;
+    views.resize(features_.size());
+    tfrecord_wire::FindFeatures({example, example + length}, feature_names_, views.data());
+
+    for (size_t i = 0; i < features_.size(); ++i) {
+      auto& output = ws->Output<CPUBackend>(i);
+      Feature& f = features_[i];
+      auto& view = views[i];
+      if (view.kind == FeatureKind::none) {
+        SetEmpty(output, f);
+        output.SetSourceInfo(data.GetSourceInfo());
+        continue;
+      }
+      if (f.HasShape() && f.GetType() != FeatureType::string) {
+        if (f.Shape().empty()) {
+          output.Resize({1});
+        } else {
+          output.Resize(f.Shape());
+        }
+      }
+      ssize_t number_of_elms = 0;
+      switch (f.GetType()) {
+        case FeatureType::int64: {
+          // a list of a different kind reads as empty, as with the protobuf message
+          bool matches = view.kind == FeatureKind::int64_list;
+          number_of_elms = matches ? tfrecord_wire::CountInt64(view.list) : 0;
+          if (!f.HasShape()) {
+            output.Resize(InferShape(f, number_of_elms));
+          }
+          DALI_ENFORCE(number_of_elms <= output.size(), make_string("Output tensor shape is too "
+                       "small: [", output.shape(), "]. Expected at least ", number_of_elms,
+                       " elements."));
+          auto *out = output.mutable_data<int64_t>();
+          if (matches)
+            tfrecord_wire::DecodeInt64(view.list, out);
+          break;
+        }
+        case FeatureType::string: {
+          if (!f.HasShape() || volume(f.Shape()) > 1) {
+            DALI_FAIL("Tensors of strings are not supported.");
+          }
+          bool found = false;
+          tfrecord_wire::Span bytes;
+          if (view.kind == FeatureKind::bytes_list)
+            bytes = tfrecord_wire::FirstBytes(view.list, found);
+          DALI_ENFORCE(found, make_string("The feature \"", feature_names_[i], "\" in ",
+                                          data.GetSourceInfo(), " has no bytes value."));
+          output.Resize({static_cast<Index>(bytes.size())});
+          std::memcpy(output.mutable_data<uint8_t>(), bytes.data, bytes.size());
+          break;
+        }
+        case FeatureType::float32: {
+          bool matches = view.kind == FeatureKind::float_list;
+          number_of_elms = matches ? tfrecord_wire::CountFloat(view.list) : 0;
+          if (!f.HasShape()) {
+            output.Resize(InferShape(f, number_of_elms));
+          }
+          DALI_ENFORCE(number_of_elms <= output.size(), make_string("Output tensor shape is too "
+                       "small: [", output.shape(), "]. Expected at least ", number_of_elms,
+                       " elements."));
+          auto *out = output.mutable_data<float>();
+          if (matches)
+            tfrecord_wire::DecodeFloat(view.list, out);
+          break;
+        }
+      }
+      output.SetSourceInfo(data.GetSourceInfo());
+    }
+  }
+
+  static void SetEmpty(Tensor<CPUBackend> &output, const Feature &f) {
+    switch (f.GetType()) {
+      case FeatureType::int64:
+        output.Resize({0}, DALI_INT64);
+        break;
+      case FeatureType::string:
+        output.Resize({0}, DALI_UINT8);
+        break;
+      case FeatureType::float32:
+        output.Resize({0}, DALI_FLOAT);
+        break;
+    }
+  }
+
   std::vector<std::string> feature_names_;
   std::vector<Feature> features_;
+  bool use_fast_parser_ = false;
 
   std::vector<Index> InferShape(Feature& feature, size_t feature_size) {
     if (feature.HasPartialShape()) {
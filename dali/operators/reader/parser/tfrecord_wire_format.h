@@ -0,0 +1,294 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_READER_PARSER_TFRECORD_WIRE_FORMAT_H_
+#define DALI_OPERATORS_READER_PARSER_TFRECORD_WIRE_FORMAT_H_
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "dali/core/error_handling.h"
+#include "dali/core/format.h"
+
+namespace dali {
+
+/**
+ * @brief Reads `tensorflow.Example` messages directly from their protobuf wire format
+ *
+ * The features are located in the serialized message and their values are decoded straight
+ * into the output buffers, without building the message objects.
+ */
+namespace tfrecord_wire {
+
+enum WireType : uint32_t {
+  kVarint = 0,
+  kFixed64 = 1,
+  kLengthDelimited = 2,
+  kFixed32 = 5,
+};
+
+/// field numbers of the `Feature.kind` oneof
+enum class FeatureKind : uint32_t {
+  none = 0,
+  bytes_list = 1,
+  float_list = 2,
+  int64_list = 3,
+};
+
+/**
+ * @brief A part of the serialized message
+ */
+struct Span {
+  const uint8_t *data = nullptr;
+  const uint8_t *end = nullptr;
+
+  size_t size() const {
+    return end - data;
+  }
+};
+
+/**
+ * @brief The serialized list of values of a feature
+ */
+struct FeatureView {
+  FeatureKind kind = FeatureKind::none;
+  Span list;
+};
+
+inline uint64_t ReadVarint(const uint8_t *&p, const uint8_t *end) {
+  uint64_t value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    DALI_ENFORCE(p < end, "Truncated varint in a TFRecord");
+    uint8_t b = *p++;
+    value |= static_cast<uint64_t>(b & 0x7f) << shift;
+    if (!(b & 0x80))
+      return value;
+  }
+  DALI_FAIL("Invalid varint in a TFRecord");
+}
+
+/**
+ * @brief Iterates over the fields of a message
+ */
+class FieldReader {
+ public:
+  explicit FieldReader(Span message) : p_(message.data), end_(message.end) {}
+
+  /**
+   * @brief Reads the next field; for a length-delimited field `value` is its contents,
+   *        otherwise the encoded value.
+   */
+  bool Next(uint32_t &field, WireType &type, Span &value) {
+    if (p_ >= end_)
+      return false;
+    uint64_t tag = ReadVarint(p_, end_);
+    field = static_cast<uint32_t>(tag >> 3);
+    type = static_cast<WireType>(tag & 7);
+    const uint8_t *start = p_;
+    switch (type) {
+      case kVarint:
+        ReadVarint(p_, end_);
+        break;
+      case kFixed64:
+        DALI_ENFORCE(end_ - p_ >= 8, "Truncated field in a TFRecord");
+        p_ += 8;
+        break;
+      case kFixed32:
+        DALI_ENFORCE(end_ - p_ >= 4, "Truncated field in a TFRecord");
+        p_ += 4;
+        break;
+      case kLengthDelimited: {
+        uint64_t len = ReadVarint(p_, end_);
+        DALI_ENFORCE(len <= static_cast<uint64_t>(end_ - p_), "Truncated field in a TFRecord");
+        start = p_;
+        p_ += len;
+        break;
+      }
+      default:
+        DALI_FAIL(make_string("Unsupported wire type ", static_cast<int>(type),
+                              " in a TFRecord"));
+    }
+    value.data = start;
+    value.end = p_;
+    return true;
+  }
+
+ private:
+  const uint8_t *p_, *end_;
+};
+
+/**
+ * @brief Finds the features with given names in a serialized `Example`
+ *
+ * `features[i]` receives the feature called `names[i]`; it's left with `FeatureKind::none`,
+ * if the example has no such feature. As with the protobuf parser, the last occurrence
+ * of a key (or of a list in a feature) wins.
+ */
+inline void FindFeatures(Span example, const std::vector<std::string> &names,
+                         FeatureView *features) {
+  for (size_t i = 0; i < names.size(); i++)
+    features[i] = {};
+  uint32_t field;
+  WireType type;
+  Span value;
+  // Example.features = 1
+  FieldReader example_reader(example);
+  while (example_reader.Next(field, type, value)) {
+    if (field != 1 || type != kLengthDelimited)
+      continue;
+    // Features.feature = 1, a map entry: key = 1, value = 2
+    FieldReader features_reader(value);
+    Span entry;
+    while (features_reader.Next(field, type, entry)) {
+      if (field != 1 || type != kLengthDelimited)
+        continue;
+      Span key, feature;
+      FieldReader entry_reader(entry);
+      while (entry_reader.Next(field, type, value)) {
+        if (type != kLengthDelimited)
+          continue;
+        if (field == 1)
+          key = value;
+        else if (field == 2)
+          feature = value;
+      }
+      for (size_t i = 0; i < names.size(); i++) {
+        if (names[i].size() != key.size() ||
+            std::memcmp(names[i].data(), key.data, key.size()) != 0)
+          continue;
+        FeatureView view;
+        FieldReader feature_reader(feature);
+        while (feature_reader.Next(field, type, value)) {
+          if (type == kLengthDelimited && field >= 1 && field <= 3) {
+            view.kind = static_cast<FeatureKind>(field);
+            view.list = value;
+          }
+        }
+        features[i] = view;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Counts the values of an `Int64List` (`value = 1`, packed or not)
+ */
+inline int64_t CountInt64(Span list) {
+  int64_t count = 0;
+  uint32_t field;
+  WireType type;
+  Span value;
+  FieldReader reader(list);
+  while (reader.Next(field, type, value)) {
+    if (field != 1)
+      continue;
+    if (type == kVarint) {
+      count++;
+    } else if (type == kLengthDelimited) {
+      // each varint ends with a byte without the continuation bit
+      for (const uint8_t *p = value.data; p < value.end; p++)
+        count += !(*p & 0x80);
+    }
+  }
+  return count;
+}
+
+/**
+ * @brief Decodes the values of an `Int64List`; `out` must fit CountInt64(list) values
+ */
+inline void DecodeInt64(Span list, int64_t *out) {
+  uint32_t field;
+  WireType type;
+  Span value;
+  FieldReader reader(list);
+  while (reader.Next(field, type, value)) {
+    if (field != 1)
+      continue;
+    if (type == kVarint) {
+      const uint8_t *p = value.data;
+      *out++ = static_cast<int64_t>(ReadVarint(p, value.end));
+    } else if (type == kLengthDelimited) {
+      const uint8_t *p = value.data;
+      while (p < value.end)
+        *out++ = static_cast<int64_t>(ReadVarint(p, value.end));
+    }
+  }
+}
+
+/**
+ * @brief Counts the values of a `FloatList` (`value = 1`, packed or not)
+ */
+inline int64_t CountFloat(Span list) {
+  int64_t count = 0;
+  uint32_t field;
+  WireType type;
+  Span value;
+  FieldReader reader(list);
+  while (reader.Next(field, type, value)) {
+    if (field != 1)
+      continue;
+    if (type == kFixed32)
+      count++;
+    else if (type == kLengthDelimited)
+      count += value.size() / sizeof(float);
+  }
+  return count;
+}
+
+/**
+ * @brief Copies the values of a `FloatList`; `out` must fit CountFloat(list) values
+ *
+ * The floats are stored in little-endian order, so the packed arrays are copied as they are.
+ */
+inline void DecodeFloat(Span list, float *out) {
+  uint32_t field;
+  WireType type;
+  Span value;
+  FieldReader reader(list);
+  while (reader.Next(field, type, value)) {
+    if (field != 1)
+      continue;
+    if (type == kFixed32 || type == kLengthDelimited) {
+      size_t n = value.size() / sizeof(float);
+      std::memcpy(out, value.data, n * sizeof(float));
+      out += n;
+    }
+  }
+}
+
+/**
+ * @brief Returns the first value of a `BytesList`; `found` is false, if the list is empty
+ */
+inline Span FirstBytes(Span list, bool &found) {
+  uint32_t field;
+  WireType type;
+  Span value;
+  FieldReader reader(list);
+  while (reader.Next(field, type, value)) {
+    if (field == 1 && type == kLengthDelimited) {
+      found = true;
+      return value;
+    }
+  }
+  found = false;
+  return {};
+}
+
+}  // namespace tfrecord_wire
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_READER_PARSER_TFRECORD_WIRE_FORMAT_H_
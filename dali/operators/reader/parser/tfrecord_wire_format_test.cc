@@ -0,0 +1,183 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "dali/operators/reader/parser/tfrecord_wire_format.h"
+#ifdef DALI_BUILD_PROTO3
+#include "dali/operators/reader/parser/example.pb.h"
+#endif
+
+namespace dali {
+namespace tfrecord_wire {
+
+namespace {
+
+/**
+ * @brief A minimal protobuf encoder, used to build the test messages
+ */
+struct Encoder {
+  std::string out;
+
+  void Varint(uint64_t v) {
+    while (v >= 0x80) {
+      out.push_back(static_cast<char>(v | 0x80));
+      v >>= 7;
+    }
+    out.push_back(static_cast<char>(v));
+  }
+
+  void Tag(uint32_t field, WireType type) {
+    Varint((field << 3) | type);
+  }
+
+  void Bytes(uint32_t field, const std::string &bytes) {
+    Tag(field, kLengthDelimited);
+    Varint(bytes.size());
+    out += bytes;
+  }
+
+  void Fixed32(uint32_t field, float f) {
+    Tag(field, kFixed32);
+    out.append(reinterpret_cast<const char *>(&f), sizeof(f));
+  }
+};
+
+std::string PackedInt64(const std::vector<int64_t> &values) {
+  Encoder packed;
+  for (auto v : values)
+    packed.Varint(static_cast<uint64_t>(v));
+  Encoder list;
+  list.Bytes(1, packed.out);
+  return list.out;
+}
+
+std::string Feature(FeatureKind kind, const std::string &list) {
+  Encoder e;
+  e.Bytes(static_cast<uint32_t>(kind), list);
+  return e.out;
+}
+
+std::string Example(const std::vector<std::pair<std::string, std::string>> &features) {
+  Encoder map;
+  for (auto &f : features) {
+    Encoder entry;
+    entry.Bytes(1, f.first);
+    entry.Bytes(2, f.second);
+    map.Bytes(1, entry.out);
+  }
+  Encoder example;
+  example.Bytes(1, map.out);
+  return example.out;
+}
+
+Span ToSpan(const std::string &s) {
+  auto *p = reinterpret_cast<const uint8_t *>(s.data());
+  return {p, p + s.size()};
+}
+
+}  // namespace
+
+TEST(TFRecordWireFormat, Features) {
+  std::vector<int64_t> ints = {0, 1, -1, 300, INT64_MAX, INT64_MIN};
+  Encoder floats;
+  floats.Fixed32(1, 1.5f);  // unpacked
+  floats.Fixed32(1, -2.25f);
+  Encoder bytes;
+  bytes.Bytes(1, std::string("\0abc", 4));
+  bytes.Bytes(1, "second");
+
+  auto example = Example({
+      {"ints", Feature(FeatureKind::int64_list, PackedInt64(ints))},
+      {"other", Feature(FeatureKind::int64_list, PackedInt64({5}))},
+      {"floats", Feature(FeatureKind::float_list, floats.out)},
+      {"bytes", Feature(FeatureKind::bytes_list, bytes.out)},
+  });
+
+  std::vector<std::string> names = {"bytes", "ints", "missing", "floats"};
+  FeatureView views[4];
+  FindFeatures(ToSpan(example), names, views);
+
+  EXPECT_EQ(views[0].kind, FeatureKind::bytes_list);
+  bool found = false;
+  Span first = FirstBytes(views[0].list, found);
+  ASSERT_TRUE(found);
+  EXPECT_EQ(std::string(reinterpret_cast<const char *>(first.data), first.size()),
+            std::string("\0abc", 4));
+
+  ASSERT_EQ(views[1].kind, FeatureKind::int64_list);
+  ASSERT_EQ(CountInt64(views[1].list), static_cast<int64_t>(ints.size()));
+  std::vector<int64_t> decoded(ints.size());
+  DecodeInt64(views[1].list, decoded.data());
+  EXPECT_EQ(decoded, ints);
+
+  EXPECT_EQ(views[2].kind, FeatureKind::none);
+
+  ASSERT_EQ(views[3].kind, FeatureKind::float_list);
+  ASSERT_EQ(CountFloat(views[3].list), 2);
+  float f[2];
+  DecodeFloat(views[3].list, f);
+  EXPECT_EQ(f[0], 1.5f);
+  EXPECT_EQ(f[1], -2.25f);
+}
+
+TEST(TFRecordWireFormat, Truncated) {
+  auto example = Example({{"ints", Feature(FeatureKind::int64_list, PackedInt64({1, 2, 3}))}});
+  std::vector<std::string> names = {"ints"};
+  FeatureView view;
+  auto span = ToSpan(example);
+  span.end--;
+  EXPECT_THROW(FindFeatures(span, names, &view), std::runtime_error);
+}
+
+#ifdef DALI_BUILD_PROTO3
+TEST(TFRecordWireFormat, MatchesProtobuf) {
+  tensorflow::Example example;
+  auto &features = *example.mutable_features()->mutable_feature();
+  for (int i = 0; i < 100; i++)
+    features["ints"].mutable_int64_list()->add_value(i * 1000003LL - 5000);
+  for (int i = 0; i < 10; i++)
+    features["floats"].mutable_float_list()->add_value(i * 0.25f);
+  features["bytes"].mutable_bytes_list()->add_value("encoded image");
+  std::string serialized;
+  ASSERT_TRUE(example.SerializeToString(&serialized));
+
+  std::vector<std::string> names = {"ints", "floats", "bytes"};
+  FeatureView views[3];
+  FindFeatures(ToSpan(serialized), names, views);
+
+  std::vector<int64_t> ints(CountInt64(views[0].list));
+  DecodeInt64(views[0].list, ints.data());
+  auto &ref_ints = features["ints"].int64_list().value();
+  EXPECT_EQ(ints, std::vector<int64_t>(ref_ints.begin(), ref_ints.end()));
+
+  std::vector<float> floats(CountFloat(views[1].list));
+  DecodeFloat(views[1].list, floats.data());
+  auto &ref_floats = features["floats"].float_list().value();
+  EXPECT_EQ(floats, std::vector<float>(ref_floats.begin(), ref_floats.end()));
+
+  bool found = false;
+  Span bytes = FirstBytes(views[2].list, found);
+  ASSERT_TRUE(found);
+  EXPECT_EQ(std::string(reinterpret_cast<const char *>(bytes.data), bytes.size()),
+            "encoded image");
+}
+#endif
+
+}  // namespace tfrecord_wire
+}  // namespace dali
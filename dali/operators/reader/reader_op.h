@@ -16,6 +16,7 @@
 #define DALI_OPERATORS_READER_READER_OP_H_
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <memory>
 #include <string>
@@ -28,6 +29,8 @@
 #include "dali/operators/reader/loader/loader.h"
 #include "dali/operators/reader/parser/parser.h"
 #include "dali/pipeline/operator/operator.h"
+#include "dali/pipeline/util/thread_affinity.h"
+#include "dali/util/thread_safe_queue.h"
 
 namespace dali {
 
@@ -58,15 +61,24 @@ class DataReader : public Operator<Backend> {
         prefetch_queue_depth_(spec.GetArgument<int>("prefetch_queue_depth")),
         skip_cached_images_(spec.GetArgument<bool>("skip_cached_images")),
         prefetched_batch_queue_(prefetch_queue_depth_),
+        free_batches_(prefetch_queue_depth_),
+        ready_batches_(prefetch_queue_depth_),
         curr_batch_consumer_(0),
         curr_batch_producer_(0),
-        consumer_cycle_(false),
-        producer_cycle_(false),
+        consumer_has_batch_(false),
+        waiters_(0),
         device_id_(-1),
         samples_processed_(0) {
           if (std::is_same<Backend, GPUBackend>::value) {
             device_id_ = spec.GetArgument<int>("device_id");
           }
+          // the slots are handed out in order, so the batches are produced and consumed in order
+          for (int i = 0; i < prefetch_queue_depth_; i++)
+            free_batches_.try_push(std::move(i));
+          this->RegisterDiagnostic("prefetch_queue_depth", &prefetch_queue_depth_);
+          this->RegisterDiagnostic("prefetch_queue_fill", &prefetch_queue_fill_);
+          this->RegisterDiagnostic("prefetch_starved", &prefetch_starved_);
+          this->RegisterDiagnostic("prefetch_wait_time", &prefetch_wait_time_);
         }
 
   ~DataReader() noexcept override {
@@ -81,8 +93,9 @@ class DataReader : public Operator<Backend> {
   // perform the prefetching operation
   virtual void Prefetch() {
     // We actually prepare the next batch
-    DomainTimeRange tr("[DALI][DataReader] Prefetch #" + to_string(curr_batch_producer_),
-                       DomainTimeRange::kRed);
+    DALI_TRACE_RANGE(kTraceLoader,
+                     "[DALI][DataReader] Prefetch #" + to_string(curr_batch_producer_),
+                     RangeBase::kRed);
     auto &curr_batch = prefetched_batch_queue_[curr_batch_producer_];
     curr_batch.clear();
     curr_batch.reserve(max_batch_size_);
@@ -94,6 +107,13 @@ class DataReader : public Operator<Backend> {
   // Main prefetch work loop
   void PrefetchWorker() {
     DeviceGuard g(device_id_);
+    try {
+      InitThreadAffinity(make_string(spec_.name(), " prefetch"), device_id_,
+                         spec_.GetArgument<bool>("set_affinity"));
+    } catch (...) {
+      ProducerStop(std::current_exception());
+      return;
+    }
     ProducerWait();
     while (!finished_) {
       try {
@@ -138,8 +158,8 @@ class DataReader : public Operator<Backend> {
   // CPUBackend operators
   void Run(HostWorkspace &ws) override {
     // consume batch
-    DomainTimeRange tr("[DALI][DataReader] Run #" + to_string(curr_batch_consumer_),
-                       DomainTimeRange::kViolet);
+    DALI_TRACE_RANGE(kTraceLoader, "[DALI][DataReader] Run #" + to_string(curr_batch_consumer_),
+                     RangeBase::kViolet);
 
     // This is synchronous call for CPU Backend
     Operator<Backend>::Run(ws);
@@ -197,6 +217,38 @@ class DataReader : public Operator<Backend> {
     return ret;
   }
 
+  /**
+   * @brief Moves the reader to another shard, see Loader::Reshard
+   *
+   * The prefetched batches are discarded and the prefetch thread is restarted by the next Setup.
+   * Must not be called while an iteration of the pipeline is running.
+   */
+  void Reshard(int shard_id, int num_shards) override {
+    StopPrefetchThread();
+    {
+      std::lock_guard<std::mutex> lock(prefetch_access_mutex_);
+      if (prefetch_error_)
+        std::rethrow_exception(prefetch_error_);
+    }
+    // Fill the remaining free slots, so that the loader is always at the same position,
+    // however far the prefetch thread got - the readers resharded after the same number
+    // of iterations must draw the same order of the next epoch
+    {
+      DeviceGuard g(device_id_);
+      while (free_batches_.try_pop(curr_batch_producer_))
+        Prefetch();
+    }
+    for (auto &batch : prefetched_batch_queue_)
+      batch.clear();
+    int slot;
+    while (ready_batches_.try_pop(slot)) {}
+    for (int i = 0; i < prefetch_queue_depth_; i++)
+      free_batches_.try_push(std::move(i));
+    consumer_has_batch_ = false;
+    loader_->Reshard(shard_id, num_shards);
+    finished_ = false;
+  }
+
   inline std::vector<std::shared_ptr<LoadTarget>>& GetCurrBatch() {
     return prefetched_batch_queue_[curr_batch_consumer_];
   }
@@ -238,6 +290,9 @@ class DataReader : public Operator<Backend> {
         "Unexpected number of outputs");
       for (std::size_t i = 0; i < cached_outputs.size(); i++) {
         auto& output = ws->Output<CPUBackend>(i);
+        // the parser could have made it a view of the loaded data
+        if (output.shares_data())
+          output.Reset();
         output.Copy(cached_outputs[i], 0);
       }
       return;
@@ -273,60 +328,88 @@ class DataReader : public Operator<Backend> {
   void ProducerStop(std::exception_ptr error = nullptr) {
     {
       std::lock_guard<std::mutex> lock(prefetch_access_mutex_);
-      finished_ = true;
       if (error)
         prefetch_error_ = error;
+      finished_ = true;
     }
     consumer_.notify_all();
   }
 
   void ProducerAdvanceQueue() {
-    {
-      std::lock_guard<std::mutex> lock(prefetch_access_mutex_);
-      AdvanceIndex(curr_batch_producer_, producer_cycle_);
-    }
-    consumer_.notify_all();
+    ready_batches_.try_push(std::move(curr_batch_producer_));
+    Notify(consumer_);
   }
 
   void ProducerWait() {
-    std::unique_lock<std::mutex> lock(prefetch_access_mutex_);
-    producer_.wait(lock, [&]() { return finished_ || !IsPrefetchQueueFull(); });
+    WaitUntil(producer_, [&]() {
+      return finished_ || free_batches_.try_pop(curr_batch_producer_);
+    });
   }
 
   void ConsumerWait() {
-    DomainTimeRange tr("[DALI][DataReader] ConsumerWait #" + to_string(curr_batch_consumer_),
-                 DomainTimeRange::kMagenta);
-    std::unique_lock<std::mutex> prefetch_lock(prefetch_access_mutex_);
-    consumer_.wait(prefetch_lock, [this]() { return finished_ || !IsPrefetchQueueEmpty(); });
-    if (prefetch_error_) std::rethrow_exception(prefetch_error_);
-  }
-
-  void ConsumerAdvanceQueue() {
-    {
+    DALI_TRACE_RANGE(kTraceLoader,
+                     "[DALI][DataReader] ConsumerWait #" + to_string(curr_batch_consumer_),
+                     RangeBase::kMagenta);
+    if (!consumer_has_batch_) {
+      prefetch_queue_fill_ = ready_batches_.size();
+      consumer_has_batch_ = ready_batches_.try_pop(curr_batch_consumer_);
+    }
+    if (!consumer_has_batch_) {
+      prefetch_starved_++;
+      auto wait_start = std::chrono::steady_clock::now();
+      WaitUntil(consumer_, [&]() {
+        consumer_has_batch_ = ready_batches_.try_pop(curr_batch_consumer_);
+        return consumer_has_batch_ || finished_;
+      });
+      prefetch_wait_time_ += std::chrono::duration<double>(
+          std::chrono::steady_clock::now() - wait_start).count();
+    }
+    if (finished_) {
       std::lock_guard<std::mutex> lock(prefetch_access_mutex_);
-      AdvanceIndex(curr_batch_consumer_, consumer_cycle_);
+      if (prefetch_error_) std::rethrow_exception(prefetch_error_);
     }
-    producer_.notify_one();
   }
 
-  void AdvanceIndex(int& index, bool& cycle) {
-    index = (index + 1) % prefetch_queue_depth_;
-    if (index == 0) cycle = !cycle;
+  void ConsumerAdvanceQueue() {
+    if (!consumer_has_batch_)
+      return;
+    consumer_has_batch_ = false;
+    free_batches_.try_push(std::move(curr_batch_consumer_));
+    Notify(producer_);
   }
 
-  bool IsPrefetchQueueEmpty() {
-    return curr_batch_producer_ == curr_batch_consumer_ && consumer_cycle_ == producer_cycle_;
+  /**
+   * @brief Waits until `pred` is satisfied; doesn't lock if it's satisfied right away
+   */
+  template <typename Predicate>
+  void WaitUntil(std::condition_variable &cv, Predicate &&pred) {
+    if (pred())
+      return;
+    std::unique_lock<std::mutex> lock(prefetch_access_mutex_);
+    waiters_++;
+    // pairs with the fence in Notify - either we see the change or the notifier sees us
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    cv.wait(lock, pred);
+    waiters_--;
   }
 
-  bool IsPrefetchQueueFull() {
-    return curr_batch_producer_ == curr_batch_consumer_ && consumer_cycle_ != producer_cycle_;
+  /**
+   * @brief Wakes up the threads waiting on `cv`, if there are any
+   */
+  void Notify(std::condition_variable &cv) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters_ > 0) {
+      // the waiter holds the lock between checking the predicate and going to sleep
+      { std::lock_guard<std::mutex> lock(prefetch_access_mutex_); }
+      cv.notify_all();
+    }
   }
 
   USE_OPERATOR_MEMBERS();
 
   std::thread prefetch_thread_;
 
-  // mutex to control access to the producer
+  // mutex used only when the producer or the consumer has to wait
   std::mutex prefetch_access_mutex_;
 
   // signals for producer and consumer
@@ -340,10 +423,18 @@ class DataReader : public Operator<Backend> {
   bool skip_cached_images_;
   using BatchQueueElement = std::vector<LoadTargetPtr>;
   std::vector<BatchQueueElement> prefetched_batch_queue_;
+  // indices of the slots in prefetched_batch_queue_ that can be filled / consumed
+  BoundedLockFreeQueue<int> free_batches_, ready_batches_;
   int curr_batch_consumer_;
   int curr_batch_producer_;
-  bool consumer_cycle_;
-  bool producer_cycle_;
+  bool consumer_has_batch_;
+  // the diagnostics of the prefetching, as seen by the consumer: the batches ready when
+  // the consumer asked for the last one, the number of batches it had to wait for and
+  // the time it waited
+  int prefetch_queue_fill_ = 0;
+  int64_t prefetch_starved_ = 0;
+  double prefetch_wait_time_ = 0;
+  std::atomic<int> waiters_;
   int device_id_;
 
   // keep track of how many samples have been processed over all threads.
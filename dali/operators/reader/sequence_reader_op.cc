@@ -18,8 +18,47 @@
 
 namespace dali {
 
-void SequenceReader::RunImpl(SampleWorkspace &ws) {
-  parser_->Parse(GetSample(ws.data_idx()), &ws);
+void SequenceReader::RunImpl(HostWorkspace &ws) {
+  auto &parser = static_cast<const SequenceParser &>(*parser_);
+  auto &output = ws.OutputRef<CPUBackend>(0);
+  auto &thread_pool = ws.GetThreadPool();
+  int num_samples = GetCurrBatchSize();
+
+  first_frames_.resize(num_samples);
+  for (int data_idx = 0; data_idx < num_samples; data_idx++) {
+    thread_pool.AddWork([&, data_idx](int) {
+      first_frames_[data_idx] = parser.DecodeFirstFrame(GetSample(data_idx).tensors[0]);
+    }, GetSample(data_idx).tensors[0].size());
+  }
+  thread_pool.RunAll();
+
+  TensorListShape<> shape(num_samples, 4);
+  for (int data_idx = 0; data_idx < num_samples; data_idx++) {
+    auto frame_shape = first_frames_[data_idx]->GetShape();
+    Index seq_length = GetSample(data_idx).tensors.size();
+    shape.set_tensor_shape(data_idx, {seq_length, frame_shape[0], frame_shape[1],
+                                      frame_shape[2]});
+  }
+  output.Resize(shape, DALI_UINT8);
+  output.SetLayout("FHWC");
+
+  for (int data_idx = 0; data_idx < num_samples; data_idx++) {
+    const auto &frames = GetSample(data_idx).tensors;
+    auto frame_shape = first_frames_[data_idx]->GetShape();
+    auto frame_size = volume(frame_shape);
+    uint8_t *sequence = output[data_idx].mutable_data<uint8_t>();
+    thread_pool.AddWork([&, data_idx, sequence](int) {
+      first_frames_[data_idx]->GetImage(sequence);
+      first_frames_[data_idx].reset();
+    }, frame_size);
+    for (size_t frame = 1; frame < frames.size(); frame++) {
+      thread_pool.AddWork([&parser, &encoded = frames[frame], frame_shape,
+                           dst = sequence + frame * frame_size](int) {
+        parser.DecodeFrame(encoded, frame_shape, dst);
+      }, frames[frame].size());
+    }
+  }
+  thread_pool.RunAll();
 }
 
 DALI_REGISTER_OPERATOR(readers__Sequence, SequenceReader, CPU);
@@ -15,6 +15,8 @@
 #ifndef DALI_OPERATORS_READER_SEQUENCE_READER_OP_H_
 #define DALI_OPERATORS_READER_SEQUENCE_READER_OP_H_
 
+#include <memory>
+#include <vector>
 #include "dali/operators/reader/loader/sequence_loader.h"
 #include "dali/operators/reader/parser/sequence_parser.h"
 #include "dali/operators/reader/reader_op.h"
@@ -28,10 +30,20 @@ class SequenceReader : public DataReader<CPUBackend, TensorSequence> {
     parser_.reset(new SequenceParser(spec));
   }
 
-  void RunImpl(SampleWorkspace &ws) override;
+  /**
+   * @brief Decodes the frames of all the sequences of the batch in the thread pool
+   *
+   * The first frames, which determine the shapes of the sequences, are decoded first,
+   * then the rest of the frames - the frames of a sequence are decoded in parallel, rather
+   * than one after another.
+   */
+  void RunImpl(HostWorkspace &ws) override;
 
  protected:
   USE_READER_OPERATOR_MEMBERS(CPUBackend, TensorSequence);
+
+ private:
+  std::vector<std::unique_ptr<Image>> first_frames_;
 };
 
 }  // namespace dali
@@ -45,7 +45,14 @@ DALI_SCHEMA(readers___TFRecordBase)
 
 The index files can be obtained from TFRecord files by using the ``tfrecord2idx`` script
 that is distributed with DALI.)code",
-      DALI_STRING_VEC);
+      DALI_STRING_VEC)
+  .AddOptionalArg("use_fast_parser",
+      R"code(If set to True, the features are decoded directly from the serialized records,
+without deserializing them into protobuf messages.
+
+It reduces the CPU time spent on each record, which dominates when the records are small.
+The outputs are the same as with the protobuf parser.)code",
+      false);
 
 // Internal readers._tfrecord schema.
 DALI_SCHEMA(readers___TFRecord)
@@ -12,6 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <numeric>
+#include <tuple>
 #include <vector>
 
 #include "dali/core/common.h"
@@ -42,13 +45,38 @@ void VideoReader::Prefetch() {
 
   curr_tensor_list.Resize(tmp_shapes, ref_type);
 
-  // ask for frames
-  for (size_t data_idx = 0; data_idx < curr_tensor_list.ntensor(); ++data_idx) {
-    auto &sample = curr_batch[data_idx];
-    sample->sequence.ShareData(&curr_tensor_list, static_cast<int>(data_idx));
-    sample->read_sample_f();
-    // data has been read, decouple sequence from the wrapped memory
-    sample->sequence.Reset();
+  // Ask for all the frames first and in the order of the files and frames, so that
+  // the sequences from the same GOP are decoded in one pass
+  std::vector<size_t> order(curr_batch.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return std::make_tuple(curr_batch[a]->decoder_idx, curr_batch[a]->file_idx,
+                           curr_batch[a]->first_frame_idx) <
+           std::make_tuple(curr_batch[b]->decoder_idx, curr_batch[b]->file_idx,
+                           curr_batch[b]->first_frame_idx);
+  });
+  std::vector<std::vector<size_t>> decoder_order;
+  for (size_t data_idx : order) {
+    curr_batch[data_idx]->request_sample_f();
+    size_t decoder_idx = curr_batch[data_idx]->decoder_idx;
+    if (decoder_order.size() <= decoder_idx)
+      decoder_order.resize(decoder_idx + 1);
+    decoder_order[decoder_idx].push_back(data_idx);
+  }
+  // Each decoder returns its sequences in the order they were requested; the decoders
+  // work in parallel, so the sequences are taken from them in turns
+  for (size_t pos = 0, received = 0; received < order.size(); pos++) {
+    for (auto &sequences : decoder_order) {
+      if (pos >= sequences.size())
+        continue;
+      size_t data_idx = sequences[pos];
+      auto &sample = curr_batch[data_idx];
+      sample->sequence.ShareData(&curr_tensor_list, static_cast<int>(data_idx));
+      sample->read_sample_f();
+      // data has been read, decouple sequence from the wrapped memory
+      sample->sequence.Reset();
+      received++;
+    }
   }
   // make sure that frames have been processed
   for (size_t data_idx = 0; data_idx < curr_tensor_list.ntensor(); ++data_idx) {
@@ -140,8 +168,20 @@ This parameter can be used to trade off memory usage with performance.)code",
   .AddOptionalArg("dtype",
       R"(Output data type.
 
-Supported types: ``UINT8`` or ``FLOAT``.)",
+Supported types: ``UINT8``, ``FLOAT16`` or ``FLOAT``.)",
       DALI_UINT8)
+  .AddOptionalArg<vector<float>>("mean",
+      R"code(Mean pixel values, subtracted from the frames while they are converted.
+
+Can be one value for all the channels or one value per channel. The values are in the range
+of the output, which is [0, 1] when ``normalized`` is set and [0, 255] otherwise.)code",
+      nullptr)
+  .AddOptionalArg<vector<float>>("std",
+      R"code(Standard deviation values, by which the frames are divided while they are converted
+(after subtracting ``mean``).
+
+Can be one value for all the channels or one value per channel.)code",
+      nullptr)
   .AddOptionalArg("stride",
       R"code(Distance between consecutive frames in the sequence.)code", 1u, false)
   .AddOptionalArg("skip_vfr_check",
@@ -185,6 +225,24 @@ timestamps are correlated with displayed video frames.
 of frames at the very end of the video.
 
 Redundant frames are zeroed. Corresponding time stamps and frame numbers are set to -1.)code", false)
+  .AddOptionalArg("keyframe_index",
+      R"code(Uses an index of the key frames of each video to seek directly to the key frame
+preceding the requested sequence.
+
+The index is built by scanning the packets of the file once and is stored next to the video
+as ``<file>.dali_idx`` or, if the ``DALI_VIDEO_INDEX_DIR`` environment variable is set, in that
+directory. The stored index is reused in the subsequent runs, as long as the size and
+the modification time of the video don't change.
+
+With the index, the sequences of a batch which start in the same GOP are decoded in a single
+pass.)code", false)
+  .AddOptionalArg("num_decoders",
+      R"code(The number of the hardware decoding sessions the reader uses in parallel.
+
+Each session has its own parser and decoder and reads a different subset of the files, so it's
+useful when the GPU has multiple NVDEC engines and there are more files than sessions.
+The memory used for the decoded frames grows linearly with the number of sessions, as each has
+its own set of ``additional_decode_surfaces`` + the surfaces required by the stream.)code", 1)
   .AddParent("LoaderBase");
 
 
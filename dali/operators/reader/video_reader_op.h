@@ -46,7 +46,10 @@ inline int VideoReaderOutputFn(const OpSpec &spec) {
 
 class VideoReader : public DataReader<GPUBackend, SequenceWrapper> {
  public:
-  explicit VideoReader(const OpSpec &spec)
+  /**
+   * @param resize  the size of the frames, when they are resized by the decoder
+   */
+  explicit VideoReader(const OpSpec &spec, const VideoFrameResize &resize = {})
       : DataReader<GPUBackend, SequenceWrapper>(spec),
         filenames_(spec.GetRepeatedArgument<std::string>("filenames")),
         file_root_(spec.GetArgument<std::string>("file_root")),
@@ -71,7 +74,8 @@ class VideoReader : public DataReader<GPUBackend, SequenceWrapper> {
     DALI_ENFORCE(image_type == DALI_RGB || image_type == DALI_YCbCr,
                  "Image type must be RGB or YCbCr.");
 
-    DALI_ENFORCE(dtype_ == DALI_FLOAT || dtype_ == DALI_UINT8, "Data type must be FLOAT or UINT8.");
+    DALI_ENFORCE(dtype_ == DALI_FLOAT || dtype_ == DALI_FLOAT16 || dtype_ == DALI_UINT8,
+                 "Data type must be FLOAT, FLOAT16 or UINT8.");
 
     can_use_frames_timestamps_ = !file_list_.empty() || (!filenames_.empty() && has_labels_arg);
 
@@ -94,7 +98,7 @@ class VideoReader : public DataReader<GPUBackend, SequenceWrapper> {
     output_labels_ = has_labels_arg || !file_list_.empty() || !file_root_.empty();
 
     // TODO(spanev): Factor out the constructor body to make VideoReader compatible with lazy_init.
-    loader_ = InitLoader<VideoLoader>(spec, filenames_);
+    loader_ = InitLoader<VideoLoader>(spec, filenames_, resize);
 
     label_shape_ = uniform_list_shape(max_batch_size_, {1});
 
@@ -36,6 +36,11 @@ the batch size, and F the number of frames in the sequence.
 
 This operator combines the features of :meth:`nvidia.dali.fn.video_reader` and :meth:`nvidia.dali.fn.resize`.
 
+When both ``resize_x`` and ``resize_y`` are given as scalars and the frames are resized with
+the nearest neighbor or linear filter (both ``min_filter`` and ``mag_filter``), the resizing is
+done by the decoder, together with the color space conversion and the optional normalization,
+without storing the full-size frames.
+
 .. note::
   The decoder supports only constant frame-rate videos.
 )code")
@@ -15,6 +15,8 @@
 #ifndef DALI_OPERATORS_READER_VIDEO_READER_RESIZE_OP_H_
 #define DALI_OPERATORS_READER_VIDEO_READER_RESIZE_OP_H_
 
+#include <algorithm>
+#include <cmath>
 #include <string>
 #include <vector>
 
@@ -31,16 +33,74 @@ class VideoReaderResize : public VideoReader,
                           protected ResizeBase<GPUBackend> {
  public:
   explicit VideoReaderResize(const OpSpec &spec)
-      : VideoReader(spec),
-        ResizeBase(spec) {
+      : VideoReader(spec, GetDecoderResize(spec)),
+        ResizeBase(spec),
+        decoder_resize_(GetDecoderResize(spec)) {
     ResizeBase::InitializeGPU(spec_.GetArgument<int>("minibatch_size"),
                               spec_.GetArgument<int64_t>("temp_buffer_hint"));
   }
 
   inline ~VideoReaderResize() override = default;
 
+  /**
+   * @brief Checks if the resizing can be done by the decoder, while converting the frames
+   *
+   * The decoder samples the frames through textures, so it can resize them only with
+   * the nearest neighbor or the bilinear filter (without antialiasing) and to a size which
+   * doesn't depend on the size of the video: both `resize_x` and `resize_y` must be given
+   * as scalars, without the ROI, `max_size` or a mode preserving the aspect ratio.
+   *
+   * @return the size of the frames or, if the resizing can't be done by the decoder,
+   *         an empty VideoFrameResize
+   */
+  static VideoFrameResize GetDecoderResize(const OpSpec &spec) {
+    VideoFrameResize resize;
+    for (const char *arg : { "size", "resize_shorter", "resize_longer", "max_size",
+                             "roi_start", "roi_end" }) {
+      if (spec.ArgumentDefined(arg))
+        return resize;
+    }
+    for (const char *arg : { "resize_x", "resize_y", "interp_type", "min_filter",
+                             "mag_filter" }) {
+      if (spec.HasTensorArgument(arg))
+        return resize;
+    }
+    if (!spec.HasArgument("resize_x") || !spec.HasArgument("resize_y"))
+      return resize;
+    auto mode = spec.GetArgument<std::string>("mode");
+    if (mode != "default" && mode != "stretch")
+      return resize;
+
+    // the same defaults as in ResamplingFilterAttr
+    auto interp = spec.GetArgument<DALIInterpType>("interp_type");
+    bool has_interp = spec.HasArgument("interp_type");
+    auto min_filter = spec.HasArgument("min_filter")
+        ? spec.GetArgument<DALIInterpType>("min_filter")
+        : has_interp ? interp : DALI_INTERP_TRIANGULAR;
+    auto mag_filter = spec.HasArgument("mag_filter")
+        ? spec.GetArgument<DALIInterpType>("mag_filter")
+        : has_interp ? interp : DALI_INTERP_LINEAR;
+    if (min_filter != mag_filter ||
+        (min_filter != DALI_INTERP_NN && min_filter != DALI_INTERP_LINEAR))
+      return resize;
+
+    float resize_x = spec.GetArgument<float>("resize_x");
+    float resize_y = spec.GetArgument<float>("resize_y");
+    if (resize_x <= 0 || resize_y <= 0)
+      return resize;
+    resize.width = std::max(1, static_cast<int>(std::round(resize_x)));
+    resize.height = std::max(1, static_cast<int>(std::round(resize_y)));
+    resize.nearest = min_filter == DALI_INTERP_NN;
+    return resize;
+  }
+
  protected:
   void SetOutputShapeType(TensorList<GPUBackend> &output, DeviceWorkspace &ws) override {
+    if (decoder_resize_.enabled()) {
+      // the frames already have the output size
+      VideoReader::SetOutputShapeType(output, ws);
+      return;
+    }
     input_shape_ = prefetched_batch_tensors_[curr_batch_consumer_].shape();
 
     resize_attr_.PrepareResizeParams(spec_, ws, input_shape_, "FHWC");
@@ -65,6 +125,10 @@ class VideoReaderResize : public VideoReader,
     TensorList<GPUBackend> &video_output,
     TensorList<GPUBackend> &video_batch,
     DeviceWorkspace &ws) override {
+    if (decoder_resize_.enabled()) {
+      VideoReader::ProcessVideo(video_output, video_batch, ws);
+      return;
+    }
     TensorListShape<> input_shape(1, sequence_dim);
     for (size_t data_idx = 0; data_idx < video_batch.ntensor(); ++data_idx) {
       TensorList<GPUBackend> input;
@@ -87,6 +151,7 @@ class VideoReaderResize : public VideoReader,
   ResizeAttr resize_attr_;
   ResamplingFilterAttr resampling_attr_;
  private:
+  VideoFrameResize decoder_resize_;
   std::vector<kernels::ResamplingParams2D> resample_params_;
   TensorListShape<> input_shape_, output_shape_;
 };
@@ -141,6 +141,15 @@ Moreover, the tar file should be constructed so that it will only output a sampl
 divisible by the size of the data type.)code",
                     DALI_DATA_TYPE_VEC,
                     nullptr)  // default is a vector of uint8
+    .AddOptionalArg("shuffle_after_epoch",
+        R"code(If set to True, the reader shuffles the samples of all the archives after each
+epoch.
+
+Since the samples are located with the index files, the shuffling is not limited to a single
+archive or to the shuffling buffer, as it is the case with ``random_shuffle``.
+
+``stick_to_shard`` and ``random_shuffle`` cannot be used when this argument is set to True.)code",
+        false)
     .AddParent("LoaderBase");
 
 DALI_REGISTER_OPERATOR(readers__Webdataset, WebdatasetReader, CPU);
@@ -111,9 +111,11 @@ has few items, but item size is big, you can use caching to save the boxes and r
 the same input is seen again. The inputs are compared based on 256-bit hash, which is much faster
 to compute than to recalculate the object boxes.)", false);
 
-bool RandomObjectBBox::SetupImpl(vector<OutputDesc> &out_descs, const HostWorkspace &ws) {
-  out_descs.resize(spec_.NumOutput());
-  auto &input = ws.InputRef<CPUBackend>(0);
+template <typename Backend>
+bool RandomObjectBBox<Backend>::SetupImpl(vector<OutputDesc> &out_descs,
+                                          const workspace_t<Backend> &ws) {
+  out_descs.resize(this->spec_.NumOutput());
+  auto &input = ws.template InputRef<Backend>(0);
   int ndim = input.sample_dim();
   int N = input.ntensor();
 
@@ -133,15 +135,17 @@ bool RandomObjectBBox::SetupImpl(vector<OutputDesc> &out_descs, const HostWorksp
   return true;
 }
 
-void RandomObjectBBox::AcquireArgs(const HostWorkspace &ws, int N, int ndim) {
-  background_.Acquire(spec_, ws, N);
+template <typename Backend>
+void RandomObjectBBox<Backend>::AcquireArgs(const workspace_t<Backend> &ws, int N, int ndim) {
+  auto &spec = this->spec_;
+  background_.Acquire(spec, ws, N);
   if (classes_.IsDefined())
-    classes_.Acquire(spec_, ws, N);
-  foreground_prob_.Acquire(spec_, ws, N);
+    classes_.Acquire(spec, ws, N);
+  foreground_prob_.Acquire(spec, ws, N);
   if (weights_.IsDefined())
-    weights_.Acquire(spec_, ws, N);
+    weights_.Acquire(spec, ws, N);
   if (threshold_.IsDefined())
-    threshold_.Acquire(spec_, ws, N, TensorShape<1>{ndim});
+    threshold_.Acquire(spec, ws, N, TensorShape<1>{ndim});
 
   if (weights_.IsDefined() && classes_.IsDefined()) {
     DALI_ENFORCE(weights_.get().shape == classes_.get().shape, make_string(
@@ -152,8 +156,6 @@ void RandomObjectBBox::AcquireArgs(const HostWorkspace &ws, int N, int ndim) {
 }
 
 
-#define INPUT_TYPES (bool, uint8_t, int8_t, uint16_t, int16_t, uint32_t, int32_t)
-
 namespace detail {
 
 template <typename T>
@@ -174,7 +176,7 @@ void FindLabels(std::unordered_set<int> &labels, const T *data, int64_t N) {
 
 template <typename BlobLabel>
 template <typename T>
-void RandomObjectBBox::SampleContext<BlobLabel>::FindLabels(const InTensorCPU<T> &in) {
+void RandomObjectBBoxCpu::SampleContext<BlobLabel>::FindLabels(const InTensorCPU<T> &in) {
   labels.clear();
   int64_t N = in.num_elements();
   if (!N)
@@ -236,48 +238,10 @@ void FilterByLabel(ThreadPool *tp,
 }
 
 
-template <typename Lo, typename Hi>
-void StoreBox(const OutListCPU<int, 1> &out1,
-              const OutListCPU<int, 1> &out2,
-              RandomObjectBBox::OutputFormat format,
-              int sample_idx, Lo &&start, Hi &&end) {
-  assert(size(start) == size(end));
-  int ndim = size(start);
-  switch (format) {
-    case RandomObjectBBox::Out_Box:
-      for (int i = 0; i < ndim; i++) {
-        out1.data[sample_idx][i] = start[i];
-        out1.data[sample_idx][i + ndim] = end[i];
-      }
-      break;
-    case RandomObjectBBox::Out_AnchorShape:
-      for (int i = 0; i < ndim; i++) {
-        out1.data[sample_idx][i] = start[i];
-        out2.data[sample_idx][i] = end[i] - start[i];
-      }
-      break;
-    case RandomObjectBBox::Out_StartEnd:
-      for (int i = 0; i < ndim; i++) {
-        out1.data[sample_idx][i] = start[i];
-        out2.data[sample_idx][i] = end[i];
-      }
-      break;
-    default:
-      assert(!"Unreachable code");
-  }
-}
-
-template <typename Box>
-void StoreBox(const OutListCPU<int, 1> &out1,
-              const OutListCPU<int, 1> &out2,
-              RandomObjectBBox::OutputFormat format,
-              int sample_idx, Box &&box) {
-  StoreBox(out1, out2, format, sample_idx, box.lo, box.hi);
-}
-
-void RandomObjectBBox::ClassInfo::Init(const int *bg_ptr,
-                                       const InTensorCPU<int, 1> &cls_tv,
-                                       const InTensorCPU<float, 1> &weight_tv) {
+template <typename Backend>
+void RandomObjectBBox<Backend>::ClassInfo::Init(const int *bg_ptr,
+                                                const InTensorCPU<int, 1> &cls_tv,
+                                                const InTensorCPU<float, 1> &weight_tv) {
   Reset();
   background = bg_ptr ? *bg_ptr : 0;
 
@@ -340,7 +304,8 @@ void RandomObjectBBox::ClassInfo::Init(const int *bg_ptr,
   }
 }
 
-void RandomObjectBBox::InitClassInfo(int sample_idx) {
+template <typename Backend>
+void RandomObjectBBox<Backend>::InitClassInfo(int sample_idx) {
   const int *bg = background_.IsDefined() ? background_[sample_idx].data : nullptr;
   InTensorCPU<int, 1> class_tv;
   InTensorCPU<float, 1> weight_tv;
@@ -349,8 +314,9 @@ void RandomObjectBBox::InitClassInfo(int sample_idx) {
   class_info_.Init(bg, class_tv, weight_tv);
 }
 
+template <typename Backend>
 template <int ndim>
-int RandomObjectBBox::PickBox(span<Box<ndim, int>> boxes, int sample_idx) {
+int RandomObjectBBox<Backend>::PickBox(span<Box<ndim, int>> boxes, int sample_idx) {
   auto beg = boxes.begin();
   auto end = boxes.end();
   if (threshold_.IsDefined()) {
@@ -382,8 +348,25 @@ int RandomObjectBBox::PickBox(span<Box<ndim, int>> boxes, int sample_idx) {
   }
 }
 
+template <typename Backend>
+int RandomObjectBBox<Backend>::PickBox(int *box_data, int nboxes, int ndim, int sample_idx) {
+  if (!nboxes)
+    return -1;
+
+  int box_idx = -1;
+  VALUE_SWITCH(ndim, static_ndim, (1, 2, 3, 4, 5, 6),
+    (
+      auto *boxes = reinterpret_cast<Box<static_ndim, int>*>(box_data);
+      box_idx = PickBox(make_span(boxes, nboxes), sample_idx);
+    ), (  // NOLINT
+      DALI_FAIL(make_string("Unsupported number of dimensions: ", ndim, "; must be 1..6"));
+    )  // NOLINT
+  );  // NOLINT
+  return box_idx;
+}
+
 template <typename BlobLabel>
-void RandomObjectBBox::GetBoxes(SampleContext<BlobLabel> &ctx, int nblobs) {
+void RandomObjectBBoxCpu::GetBoxes(SampleContext<BlobLabel> &ctx, int nblobs) {
   ctx.box_data.clear();
   if (!nblobs)
     return;
@@ -404,35 +387,25 @@ void RandomObjectBBox::GetBoxes(SampleContext<BlobLabel> &ctx, int nblobs) {
 }
 
 template <typename BlobLabel>
-bool RandomObjectBBox::PickBox(SampleContext<BlobLabel> &ctx) {
+bool RandomObjectBBoxCpu::PickBox(SampleContext<BlobLabel> &ctx) {
   int ndim = ctx.blobs.dim();
   int nblobs = ctx.box_data.size() / (2 * ndim);
-  if (!nblobs)
+  int box_idx = PickBox(ctx.box_data.data(), nblobs, ndim, ctx.sample_idx);
+  if (box_idx < 0)
     return false;
-
-  VALUE_SWITCH(ndim, static_ndim, (1, 2, 3, 4, 5, 6),
-    (
-      auto *box_data = reinterpret_cast<Box<static_ndim, int>*>(ctx.box_data.data());
-      auto boxes = make_span(box_data, nblobs);
-      int box_idx = PickBox(boxes, ctx.sample_idx);
-      if (box_idx >= 0) {
-        ctx.SelectBox(box_idx);
-        return true;
-      }
-    ), (  // NOLINT
-      DALI_FAIL(make_string("Unsupported number of dimensions: ", ndim, "; must be 1..6"));
-    )  // NOLINT
-  );  // NOLINT
-  return false;
+  ctx.SelectBox(box_idx);
+  return true;
 }
 
-void RandomObjectBBox::ClassInfo::Reset() {
+template <typename Backend>
+void RandomObjectBBox<Backend>::ClassInfo::Reset() {
   classes.clear();
   weights.clear();
   cdf.clear();
 }
 
-void RandomObjectBBox::ClassInfo::FromLabels(const LabelSet &labels) {
+template <typename Backend>
+void RandomObjectBBox<Backend>::ClassInfo::FromLabels(const LabelSet &labels) {
   classes.clear();
   weights.clear();
   for (auto cls : labels) {
@@ -446,7 +419,8 @@ void RandomObjectBBox::ClassInfo::FromLabels(const LabelSet &labels) {
   std::sort(classes.begin(), classes.end());
 }
 
-void RandomObjectBBox::ClassInfo::DisableAbsentClasses(const LabelSet &labels) {
+template <typename Backend>
+void RandomObjectBBox<Backend>::ClassInfo::DisableAbsentClasses(const LabelSet &labels) {
   for (int i = 0; i < static_cast<int>(classes.size()); i++) {
     if (!labels.count(classes[i]))
       weights[i] = 0;  // label not present - reduce its weight to 0
@@ -454,7 +428,7 @@ void RandomObjectBBox::ClassInfo::DisableAbsentClasses(const LabelSet &labels) {
 }
 
 template <typename BlobLabel, typename T>
-bool RandomObjectBBox::PickForegroundBox(
+bool RandomObjectBBoxCpu::PickForegroundBox(
       SampleContext<BlobLabel> &context, const InTensorCPU<T> &input) {
   InitClassInfo(context.sample_idx);
   context.class_label = class_info_.background;
@@ -519,16 +493,16 @@ bool RandomObjectBBox::PickForegroundBox(
 }
 
 template <typename BlobLabel>
-bool RandomObjectBBox::PickForegroundBox(SampleContext<BlobLabel> &context) {
+bool RandomObjectBBoxCpu::PickForegroundBox(SampleContext<BlobLabel> &context) {
   bool ret = false;
-  TYPE_SWITCH(context.input->type(), type2id, T, INPUT_TYPES,
+  TYPE_SWITCH(context.input->type(), type2id, T, RANDOM_OBJECT_BBOX_INPUT_TYPES,
     (ret = PickForegroundBox(context, view<const T>(*context.input));),
     (DALI_FAIL(make_string("Unsupported input type: ", context.input->type())))
   );  // NOLINT
   return ret;
 }
 
-void RandomObjectBBox::AllocateTempStorage(const TensorVector<CPUBackend> &input) {
+void RandomObjectBBoxCpu::AllocateTempStorage(const TensorVector<CPUBackend> &input) {
   int64_t max_blob_bytes = 0;
   int64_t max_filtered_bytes = 0;
   int N = input.ntensor();
@@ -552,7 +526,7 @@ void RandomObjectBBox::AllocateTempStorage(const TensorVector<CPUBackend> &input
   grow(tmp_filtered_storage_, max_filtered_bytes);
 }
 
-void RandomObjectBBox::RunImpl(HostWorkspace &ws) {
+void RandomObjectBBoxCpu::RunImpl(HostWorkspace &ws) {
   auto &input = ws.InputRef<CPUBackend>(0);
   int N = input.ntensor();
   if (N == 0)
@@ -617,6 +591,9 @@ void RandomObjectBBox::RunImpl(HostWorkspace &ws) {
   tp.RunAll();
 }
 
-DALI_REGISTER_OPERATOR(segmentation__RandomObjectBBox, RandomObjectBBox, CPU);
+template class RandomObjectBBox<CPUBackend>;
+template class RandomObjectBBox<GPUBackend>;
+
+DALI_REGISTER_OPERATOR(segmentation__RandomObjectBBox, RandomObjectBBoxCpu, CPU);
 
 }  // namespace dali
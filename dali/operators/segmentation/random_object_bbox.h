@@ -17,23 +17,30 @@
 #define DALI_OPERATORS_SEGMENTATION_RANDOM_OBJECT_BBOX_H_
 
 #include <algorithm>
+#include <cassert>
 #include <string>
 #include <random>
 #include <unordered_set>
 #include <unordered_map>
 #include <utility>
 #include <vector>
+#include "dali/core/geom/box.h"
 #include "dali/pipeline/operator/operator.h"
 #include "dali/pipeline/operator/arg_helper.h"
 #include "dali/pipeline/util/batch_rng.h"
 #include "dali/kernels/kernel_params.h"
 #include "dali/kernels/common/fast_hash.h"
 
+#define RANDOM_OBJECT_BBOX_INPUT_TYPES \
+  (bool, uint8_t, int8_t, uint16_t, int16_t, uint32_t, int32_t)
+
 namespace dali {
 
 using kernels::InTensorCPU;
+using kernels::OutListCPU;
 
-class RandomObjectBBox : public Operator<CPUBackend> {
+template <typename Backend>
+class RandomObjectBBox : public Operator<Backend> {
  public:
   enum OutputFormat {
     Out_AnchorShape,
@@ -43,8 +50,8 @@ class RandomObjectBBox : public Operator<CPUBackend> {
 
   using hash_t = kernels::fast_hash_t;
 
-  explicit RandomObjectBBox(const OpSpec &spec) : Operator<CPUBackend>(spec),
-        rngs_(spec.GetArgument<int>("seed"), max_batch_size_),
+  explicit RandomObjectBBox(const OpSpec &spec) : Operator<Backend>(spec),
+        rngs_(spec.GetArgument<int>("seed"), this->max_batch_size_),
         background_("background", spec),
         classes_("classes", spec),
         foreground_prob_("foreground_prob", spec),
@@ -68,9 +75,6 @@ class RandomObjectBBox : public Operator<CPUBackend> {
       DALI_ENFORCE(k_largest_ >= 1, make_string(
                    "``k_largest`` must be at least 1; got ", k_largest_));
     }
-
-    tmp_blob_storage_.set_pinned(false);
-    tmp_filtered_storage_.set_pinned(false);
   }
 
   static OutputFormat ParseOutputFormat(const std::string &format)  {
@@ -89,11 +93,10 @@ class RandomObjectBBox : public Operator<CPUBackend> {
     return true;
   }
 
-  bool SetupImpl(vector<OutputDesc> &out_descs, const HostWorkspace &ws) override;
-  void RunImpl(HostWorkspace &ws) override;
+  bool SetupImpl(vector<OutputDesc> &out_descs, const workspace_t<Backend> &ws) override;
 
- private:
-  void AcquireArgs(const HostWorkspace &ws, int N, int ndim);
+ protected:
+  void AcquireArgs(const workspace_t<Backend> &ws, int N, int ndim);
 
   bool HasClassLabelOutput() const {
     return class_output_idx_ >= 0;
@@ -167,8 +170,99 @@ class RandomObjectBBox : public Operator<CPUBackend> {
 
   void InitClassInfo(int sample_idx);
 
-  void GetBgFgAndWeights(ClassVec &classes, WeightVec &weights, int &background, int sample_idx);
+  /**
+   * @brief Picks a box from `nboxes` boxes stored in `box_data`, subject to `threshold` and
+   *        `k_largest`.
+   *
+   * The boxes which don't meet the threshold are removed from `box_data`.
+   *
+   * @return Index of the selected box or -1, if no box is acceptable.
+   */
+  int PickBox(int *box_data, int nboxes, int ndim, int sample_idx);
+
+  template <int ndim>
+  int PickBox(span<Box<ndim, int>> boxes, int sample_idx);
+
+  template <typename Lo, typename Hi>
+  static void StoreBox(const OutListCPU<int, 1> &out1,
+                       const OutListCPU<int, 1> &out2,
+                       OutputFormat format,
+                       int sample_idx, Lo &&start, Hi &&end) {
+    assert(size(start) == size(end));
+    int ndim = size(start);
+    switch (format) {
+      case Out_Box:
+        for (int i = 0; i < ndim; i++) {
+          out1.data[sample_idx][i] = start[i];
+          out1.data[sample_idx][i + ndim] = end[i];
+        }
+        break;
+      case Out_AnchorShape:
+        for (int i = 0; i < ndim; i++) {
+          out1.data[sample_idx][i] = start[i];
+          out2.data[sample_idx][i] = end[i] - start[i];
+        }
+        break;
+      case Out_StartEnd:
+        for (int i = 0; i < ndim; i++) {
+          out1.data[sample_idx][i] = start[i];
+          out2.data[sample_idx][i] = end[i];
+        }
+        break;
+      default:
+        assert(!"Unreachable code");
+    }
+  }
+
+  template <typename Box>
+  static void StoreBox(const OutListCPU<int, 1> &out1,
+                       const OutListCPU<int, 1> &out2,
+                       OutputFormat format,
+                       int sample_idx, Box &&box) {
+    StoreBox(out1, out2, format, sample_idx, box.lo, box.hi);
+  }
+
+  bool  ignore_class_ = false;
+  int   k_largest_ = -1;          // -1 means no k largest
+  int   class_output_idx_ = -1;   // -1 means no class output
+  BatchRNG<> rngs_;
+  ArgValue<int> background_;
+  ArgValue<int, 1> classes_;
+  ArgValue<float> foreground_prob_;
+  ArgValue<float, 1> weights_;
+  ArgValue<int, 1> threshold_;
+  OutputFormat format_;
+
+  bool use_cache_ = false;
+  struct CacheEntry {
+    LabelSet labels;
+    std::unordered_map<int, vector<int>> class_boxes;
+
+    bool Get(vector<int> &boxes, int label) const {
+      auto it = class_boxes.find(label);
+      if (it == class_boxes.end())
+        return false;
+      boxes = it->second;
+      return true;
+    }
 
+    void Put(int label, const vector<int> &boxes) {
+      class_boxes[label] = boxes;
+    }
+  };
+  std::unordered_map<hash_t, CacheEntry> cache_;
+};
+
+class RandomObjectBBoxCpu : public RandomObjectBBox<CPUBackend> {
+ public:
+  explicit RandomObjectBBoxCpu(const OpSpec &spec) : RandomObjectBBox<CPUBackend>(spec) {
+    tmp_blob_storage_.set_pinned(false);
+    tmp_filtered_storage_.set_pinned(false);
+  }
+
+  void RunImpl(HostWorkspace &ws) override;
+
+ private:
   void AllocateTempStorage(const TensorVector<CPUBackend> &tls);
 
   template <typename BlobLabel>
@@ -247,41 +341,10 @@ class RandomObjectBBox : public Operator<CPUBackend> {
   template <typename BlobLabel>
   void GetBoxes(SampleContext<BlobLabel> &ctx, int nblobs);
 
+  using RandomObjectBBox<CPUBackend>::PickBox;
+
   template <typename BlobLabel>
   bool PickBox(SampleContext<BlobLabel> &ctx);
-
-  template <int ndim>
-  int PickBox(span<Box<ndim, int>> boxes, int sample_idx);
-
-  bool  ignore_class_ = false;
-  int   k_largest_ = -1;          // -1 means no k largest
-  int   class_output_idx_ = -1;   // -1 means no class output
-  BatchRNG<> rngs_;
-  ArgValue<int> background_;
-  ArgValue<int, 1> classes_;
-  ArgValue<float> foreground_prob_;
-  ArgValue<float, 1> weights_;
-  ArgValue<int, 1> threshold_;
-  OutputFormat format_;
-
-  bool use_cache_ = false;
-  struct CacheEntry {
-    LabelSet labels;
-    std::unordered_map<int, vector<int>> class_boxes;
-
-    bool Get(vector<int> &boxes, int label) const {
-      auto it = class_boxes.find(label);
-      if (it == class_boxes.end())
-        return false;
-      boxes = it->second;
-      return true;
-    }
-
-    void Put(int label, const vector<int> &boxes) {
-      class_boxes[label] = boxes;
-    }
-  };
-  std::unordered_map<hash_t, CacheEntry> cache_;
 };
 
 }  // namespace dali
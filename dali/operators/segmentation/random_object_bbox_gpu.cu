@@ -0,0 +1,322 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cassert>
+#include <random>
+#include <utility>
+#include <vector>
+#include "dali/core/cuda_event.h"
+#include "dali/core/dev_buffer.h"
+#include "dali/core/static_switch.h"
+#include "dali/kernels/common/fast_hash_gpu.cuh"
+#include "dali/kernels/imgproc/structure/connected_components_gpu.cuh"
+#include "dali/kernels/imgproc/structure/label_bbox_gpu.cuh"
+#include "dali/operators/segmentation/random_object_bbox.h"
+#include "dali/pipeline/data/views.h"
+
+namespace dali {
+
+using kernels::connected_components::GetRegionValuesGPU;
+using kernels::connected_components::GetTileCountsSize;
+using kernels::connected_components::LabelConnectedRegionsGPU;
+using kernels::label_bbox::GetLabelBoundingBoxesGPU;
+
+/**
+ * @brief GPU variant of RandomObjectBBox
+ *
+ * The blobs are labeled and their bounding boxes are calculated on the GPU. The boxes, which are
+ * small compared to the input, are then copied to the host, where the class and the box are
+ * picked in the same way as in the CPU operator.
+ *
+ * All the classes are labeled at once: the blobs of equal input values are the same as the
+ * blobs in the masks of individual classes, so one labeling pass per sample suffices.
+ */
+class RandomObjectBBoxGpu : public RandomObjectBBox<GPUBackend> {
+ public:
+  explicit RandomObjectBBoxGpu(const OpSpec &spec) : RandomObjectBBox<GPUBackend>(spec) {
+    for (auto &out : host_outputs_)
+      out.set_pinned(true);
+    copy_event_ = CUDAEvent::Create(spec.GetArgument<int>("device_id"));
+  }
+
+  ~RandomObjectBBoxGpu() override {
+    if (copy_event_)
+      CUDA_DTOR_CALL(cudaEventSynchronize(copy_event_));
+  }
+
+  DISABLE_COPY_MOVE_ASSIGN(RandomObjectBBoxGpu);
+
+  void RunImpl(DeviceWorkspace &ws) override;
+
+ private:
+  static constexpr int kMaxOutputs = 3;
+
+  struct SampleContext {
+    int sample_idx;
+    int class_idx;
+    int class_label;
+    TensorShape<> shape;
+    vector<int> box_data;
+    struct {
+      SmallVector<int, 6> lo, hi;
+    } selected_box;
+
+    void SelectBox(int index) {
+      int ndim = shape.sample_dim();
+      selected_box.lo.resize(ndim);
+      selected_box.hi.resize(ndim);
+      for (int d = 0; d < ndim; d++) {
+        selected_box.lo[d] = box_data[2*index*ndim + d];
+        selected_box.hi[d] = box_data[2*index*ndim + d + ndim];
+      }
+    }
+  };
+
+  template <typename T>
+  bool PickForegroundBox(SampleContext &ctx, const T *input, cudaStream_t stream);
+
+  /**
+   * @brief Labels the blobs in the input and stores their boxes and input values
+   *        in `blob_boxes_` and `blob_values_`
+   */
+  template <typename T>
+  void FindBlobs(const T *input, const TensorShape<> &shape, int background,
+                 cudaStream_t stream);
+
+  template <typename Label, typename T>
+  void FindBlobs(DeviceBuffer<Label> &labels, DeviceBuffer<Label> &tile_counts,
+                 const T *input, const TensorShape<> &shape, int background,
+                 cudaStream_t stream);
+
+  /**
+   * @brief Fills the labels and per-class boxes in `entry` from `blob_boxes_`/`blob_values_`
+   */
+  void GroupBoxesByClass(CacheEntry &entry, int ndim);
+
+  using RandomObjectBBox<GPUBackend>::PickBox;
+
+  bool PickBox(SampleContext &ctx);
+
+  SampleContext context_;
+  CacheEntry tmp_entry_;
+
+  vector<int> blob_boxes_, blob_values_;
+  DeviceBuffer<int32_t> labels_, tile_counts_;
+  DeviceBuffer<int64_t> huge_labels_, huge_tile_counts_;
+  DeviceBuffer<int> boxes_gpu_, values_gpu_;
+  DeviceBuffer<hash_t> chunk_hashes_;
+  vector<hash_t> host_hashes_;
+
+  TensorList<CPUBackend> host_outputs_[kMaxOutputs];
+  CUDAEvent copy_event_;
+};
+
+template <typename Label, typename T>
+void RandomObjectBBoxGpu::FindBlobs(DeviceBuffer<Label> &labels,
+                                    DeviceBuffer<Label> &tile_counts,
+                                    const T *input, const TensorShape<> &shape, int background,
+                                    cudaStream_t stream) {
+  int64_t vol = volume(shape);
+  int ndim = shape.sample_dim();
+  int64_t tile_counts_size = GetTileCountsSize(vol);
+  labels.resize(vol, stream);
+  tile_counts.resize(tile_counts_size, stream);
+  LabelConnectedRegionsGPU(labels.data(), tile_counts.data(), input, shape,
+                           static_cast<T>(background), stream);
+
+  Label nblobs = 0;
+  copyD2H(&nblobs, tile_counts.data() + tile_counts_size - 1, 1, stream);
+  CUDA_CALL(cudaStreamSynchronize(stream));
+  if (!nblobs)
+    return;
+
+  boxes_gpu_.resize(nblobs * 2 * ndim, stream);
+  values_gpu_.resize(nblobs, stream);
+  GetLabelBoundingBoxesGPU(boxes_gpu_.data(), labels.data(), shape, nblobs, stream);
+  GetRegionValuesGPU(values_gpu_.data(), labels.data(), input, vol, stream);
+  blob_boxes_.resize(nblobs * 2 * ndim);
+  blob_values_.resize(nblobs);
+  copyD2H(blob_boxes_.data(), boxes_gpu_.data(), blob_boxes_.size(), stream);
+  copyD2H(blob_values_.data(), values_gpu_.data(), blob_values_.size(), stream);
+  CUDA_CALL(cudaStreamSynchronize(stream));
+}
+
+template <typename T>
+void RandomObjectBBoxGpu::FindBlobs(const T *input, const TensorShape<> &shape, int background,
+                                    cudaStream_t stream) {
+  blob_boxes_.clear();
+  blob_values_.clear();
+  if (volume(shape) == 0)
+    return;
+  // The labeling stores region indices as -2 - index, so the label type must be able to hold
+  // -1 - volume. To limit memory traffic, 32-bit labels are used whenever possible.
+  if (volume(shape) < 0x7fffffff)
+    FindBlobs(labels_, tile_counts_, input, shape, background, stream);
+  else
+    FindBlobs(huge_labels_, huge_tile_counts_, input, shape, background, stream);
+}
+
+void RandomObjectBBoxGpu::GroupBoxesByClass(CacheEntry &entry, int ndim) {
+  entry.labels.clear();
+  entry.class_boxes.clear();
+  int box_size = 2 * ndim;
+  for (int i = 0; i < static_cast<int>(blob_values_.size()); i++) {
+    int label = blob_values_[i];
+    entry.labels.insert(label);
+    // the blobs are ordered by their first element, so the order within a class is the same
+    // as if the blobs of that class were labeled separately
+    auto &boxes = entry.class_boxes[label];
+    boxes.insert(boxes.end(), &blob_boxes_[i * box_size], &blob_boxes_[(i + 1) * box_size]);
+  }
+}
+
+bool RandomObjectBBoxGpu::PickBox(SampleContext &ctx) {
+  int ndim = ctx.shape.sample_dim();
+  int nblobs = ctx.box_data.size() / (2 * ndim);
+  int box_idx = PickBox(ctx.box_data.data(), nblobs, ndim, ctx.sample_idx);
+  if (box_idx < 0)
+    return false;
+  ctx.SelectBox(box_idx);
+  return true;
+}
+
+template <typename T>
+bool RandomObjectBBoxGpu::PickForegroundBox(SampleContext &ctx, const T *input,
+                                            cudaStream_t stream) {
+  InitClassInfo(ctx.sample_idx);
+  ctx.class_label = class_info_.background;
+  int ndim = ctx.shape.sample_dim();
+
+  CacheEntry *entry = &tmp_entry_;
+  if (use_cache_) {
+    hash_t hash = {};
+    kernels::fast_hash_gpu(hash, input, volume(ctx.shape), chunk_hashes_, host_hashes_, stream);
+    entry = &cache_[hash];
+  } else {
+    tmp_entry_.labels.clear();
+    tmp_entry_.class_boxes.clear();
+  }
+
+  if (ignore_class_) {
+    if (!entry->Get(ctx.box_data, class_info_.background)) {
+      FindBlobs(input, ctx.shape, class_info_.background, stream);
+      entry->Put(class_info_.background, blob_boxes_);
+      ctx.box_data = blob_boxes_;
+    }
+    return PickBox(ctx);
+  }
+
+  if (entry->labels.empty()) {
+    FindBlobs(input, ctx.shape, class_info_.background, stream);
+    GroupBoxesByClass(*entry, ndim);
+  }
+
+  if (!classes_.IsDefined() && !weights_.IsDefined()) {
+    class_info_.FromLabels(entry->labels);
+  } else {
+    class_info_.DisableAbsentClasses(entry->labels);
+  }
+
+  while (class_info_.CalculateCDF()) {
+    std::tie(ctx.class_idx, ctx.class_label) =
+        class_info_.PickClassLabel(rngs_[ctx.sample_idx]);
+    if (ctx.class_idx < 0)
+      return false;
+
+    assert(ctx.class_label != class_info_.background);
+
+    if (!entry->Get(ctx.box_data, ctx.class_label))
+      ctx.box_data.clear();
+
+    if (PickBox(ctx))
+      return true;
+
+    // we couldn't find a satisfactory blob in this class, so let's exclude it and try again
+    class_info_.weights[ctx.class_idx] = 0;
+    ctx.class_label = class_info_.background;
+  }
+  // we've run out of classes and still there's no good blob
+  return false;
+}
+
+void RandomObjectBBoxGpu::RunImpl(DeviceWorkspace &ws) {
+  auto &input = ws.InputRef<GPUBackend>(0);
+  int N = input.ntensor();
+  if (N == 0)
+    return;
+
+  int ndim = input.sample_dim();
+  auto stream = ws.stream();
+  int nout = spec_.NumOutput();
+  assert(nout <= kMaxOutputs);
+
+  // the host buffers may still be used by the copy issued in the previous iteration
+  CUDA_CALL(cudaEventSynchronize(copy_event_));
+  for (int o = 0; o < nout; o++)
+    host_outputs_[o].Resize(ws.OutputRef<GPUBackend>(o).shape(), DALI_INT32);
+
+  OutListCPU<int, 1> out1 = view<int, 1>(host_outputs_[0]);
+  OutListCPU<int, 1> out2;
+  if (format_ != Out_Box)
+    out2 = view<int, 1>(host_outputs_[1]);
+  OutListCPU<int, 0> class_label_out;
+  if (HasClassLabelOutput())
+    class_label_out = view<int, 0>(host_outputs_[class_output_idx_]);
+
+  TensorShape<> default_anchor;
+  default_anchor.resize(ndim);
+
+  std::uniform_real_distribution<> foreground(0, 1);
+  for (int i = 0; i < N; i++) {
+    auto shape = input.tensor_shape(i);
+    bool fg = foreground(rngs_[i]) < foreground_prob_[i].data[0];
+    if (!fg) {
+      StoreBox(out1, out2, format_, i, default_anchor, shape);
+      if (HasClassLabelOutput()) {
+        InitClassInfo(i);
+        class_label_out.data[i][0] = class_info_.background;
+      }
+    } else {
+      auto &ctx = context_;
+      ctx.sample_idx = i;
+      ctx.shape = shape;
+      ctx.class_idx = -1;
+      ctx.class_label = -1;
+      bool found = false;
+      TYPE_SWITCH(input.type(), type2id, T, RANDOM_OBJECT_BBOX_INPUT_TYPES,
+        (found = PickForegroundBox(ctx, input.tensor<T>(i), stream);),
+        (DALI_FAIL(make_string("Unsupported input type: ", input.type())))
+      );  // NOLINT
+
+      if (found) {
+        assert(ctx.class_label != class_info_.background || ignore_class_);
+        StoreBox(out1, out2, format_, i, ctx.selected_box);
+      } else {
+        assert(ctx.class_label == class_info_.background);
+        StoreBox(out1, out2, format_, i, default_anchor, shape);
+      }
+
+      if (HasClassLabelOutput())
+        class_label_out.data[i][0] = ctx.class_label;
+    }
+  }
+
+  for (int o = 0; o < nout; o++)
+    ws.OutputRef<GPUBackend>(o).Copy(host_outputs_[o], stream);
+  CUDA_CALL(cudaEventRecord(copy_event_, stream));
+}
+
+DALI_REGISTER_OPERATOR(segmentation__RandomObjectBBox, RandomObjectBBoxGpu, GPU);
+
+}  // namespace dali
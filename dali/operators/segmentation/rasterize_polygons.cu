@@ -0,0 +1,354 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+#include "dali/core/cuda_error.h"
+#include "dali/core/dev_buffer.h"
+#include "dali/core/geom/vec.h"
+#include "dali/core/util.h"
+#include "dali/pipeline/data/views.h"
+#include "dali/pipeline/operator/arg_helper.h"
+#include "dali/pipeline/operator/operator.h"
+
+namespace dali {
+
+DALI_SCHEMA(segmentation__RasterizePolygons)
+    .DocStr(R"(Rasterizes segmentation mask polygons into dense binary masks.
+
+The polygons are described in the same format as produced by COCOReader, so the masks can be
+kept in the sparse polygon form through the operators which process the coordinates
+(e.g. :meth:`nvidia.dali.fn.segmentation.select_masks`, :meth:`nvidia.dali.fn.coord_transform`,
+:meth:`nvidia.dali.fn.coord_flip`) and converted to dense masks only at the final output
+resolution.
+
+The output of each sample has the shape ``(M, H, W)``, where ``M`` is the number of masks and
+``(H, W)`` is given by ``mask_shape``. A pixel belongs to a mask if its center lies inside any of
+the polygons of that mask; the inside of a single polygon is determined with the even-odd rule.
+)")
+    .NumInput(2)
+    .NumOutput(1)
+    .InputDox(0, "polygons", "2D TensorList of int",
+              R"code(Polygons, described by 3 columns::
+
+    [[mask_id0, start_vertex_idx0, end_vertex_idx0],
+     [mask_id1, start_vertex_idx1, end_vertex_idx1],
+     ...,
+     [mask_idn, start_vertex_idxn, end_vertex_idxn],]
+
+with ``mask_id`` being the index of the output mask this polygon belongs to, and
+``[start_vertex_idx, end_vertex_idx)`` describing the range of indices from ``vertices`` that belong to
+this polygon.)code")
+    .InputDox(1, "vertices", "2D TensorList of float",
+              R"code(Vertex data stored in interleaved format::
+
+    [[x0, y0],
+     [x1, y1],
+     ... ,
+     [xn, yn]])code")
+    .InputDevice(0, 2, InputDevice::CPU)
+    .AddArg("mask_shape",
+            R"code(Shape of the output masks, ``(height, width)``.)code",
+            DALI_INT_VEC, true)
+    .AddOptionalArg("relative_coords",
+                    R"code(If set to True, the vertex coordinates are relative to the mask size,
+i.e. ``(0, 0)`` and ``(1, 1)`` denote the opposite corners of the mask.)code",
+                    false)
+    .AddOptionalArg("num_masks",
+                    R"code(Number of output masks.
+
+If not provided or negative, it is one more than the highest ``mask_id`` in the sample.)code",
+                    -1);
+
+namespace rasterize_polygons {
+
+static constexpr int kTileWidth = 32;
+static constexpr int kTileHeight = 32;
+static constexpr int kBlockHeight = 8;
+static constexpr int kRowsPerThread = kTileHeight / kBlockHeight;
+static constexpr int kEdgeChunk = 256;
+
+/**
+ * @brief Polygon edge, in pixel coordinates
+ */
+struct Edge {
+  float x0, y0, y1;
+  float dxdy;          // inverse slope; unused for horizontal edges
+  int polygon_end;     // nonzero for the last edge of a polygon
+};
+
+struct MaskDesc {
+  uint8_t *out;
+  int width;
+  int edge_start, edge_end;
+  int x1, y1;          // end of the pixel range which may be covered by the mask
+};
+
+struct BlockDesc {
+  int mask;
+  int x, y;            // origin of the tile
+};
+
+/**
+ * @brief Rasterizes one tile of one mask
+ *
+ * The edges of the mask are staged in shared memory. For each pixel center, the polygon edges
+ * crossed by a ray going in the positive x direction are counted; the parity is accumulated per
+ * polygon and the polygons are then OR-ed.
+ */
+__global__ void RasterizeKernel(const BlockDesc *blocks, const MaskDesc *masks,
+                                const Edge *edges) {
+  __shared__ Edge tile_edges[kEdgeChunk];
+  const BlockDesc block = blocks[blockIdx.x];
+  const MaskDesc mask = masks[block.mask];
+  const int x = block.x + threadIdx.x;
+  const int y = block.y + threadIdx.y * kRowsPerThread;
+  const float px = x + 0.5f;
+  const int flat_tid = threadIdx.y * blockDim.x + threadIdx.x;
+  const int nthreads = blockDim.x * blockDim.y;
+
+  unsigned parity = 0, inside = 0;
+  for (int chunk_start = mask.edge_start; chunk_start < mask.edge_end; chunk_start += kEdgeChunk) {
+    int chunk_len = cuda_min(kEdgeChunk, mask.edge_end - chunk_start);
+    __syncthreads();
+    for (int i = flat_tid; i < chunk_len; i += nthreads)
+      tile_edges[i] = edges[chunk_start + i];
+    __syncthreads();
+
+    for (int i = 0; i < chunk_len; i++) {
+      Edge e = tile_edges[i];
+      #pragma unroll
+      for (int r = 0; r < kRowsPerThread; r++) {
+        float py = y + r + 0.5f;
+        if ((e.y0 > py) != (e.y1 > py) && px < e.x0 + (py - e.y0) * e.dxdy)
+          parity ^= 1u << r;
+      }
+      if (e.polygon_end) {
+        inside |= parity;
+        parity = 0;
+      }
+    }
+  }
+
+  if (x >= mask.x1)
+    return;
+  #pragma unroll
+  for (int r = 0; r < kRowsPerThread; r++) {
+    if (y + r < mask.y1)
+      mask.out[static_cast<int64_t>(y + r) * mask.width + x] = (inside >> r) & 1;
+  }
+}
+
+}  // namespace rasterize_polygons
+
+class RasterizePolygonsGPU : public Operator<GPUBackend> {
+ public:
+  explicit RasterizePolygonsGPU(const OpSpec &spec)
+      : Operator<GPUBackend>(spec),
+        mask_shape_("mask_shape", spec),
+        relative_coords_(spec.GetArgument<bool>("relative_coords")),
+        num_masks_(spec.GetArgument<int>("num_masks")) {}
+
+ protected:
+  bool CanInferOutputs() const override {
+    return true;
+  }
+
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const DeviceWorkspace &ws) override;
+  void RunImpl(DeviceWorkspace &ws) override;
+
+ private:
+  void AddMask(uint8_t *out, int height, int width,
+               span<const ivec3> polygons, span<const vec2> vertices);
+
+  ArgValue<int, 1> mask_shape_;
+  bool relative_coords_ = false;
+  int num_masks_ = -1;
+
+  std::vector<int> sample_num_masks_;
+  std::vector<rasterize_polygons::Edge> edges_;
+  std::vector<rasterize_polygons::MaskDesc> masks_;
+  std::vector<rasterize_polygons::BlockDesc> blocks_;
+  std::vector<int> polygon_order_;
+  std::vector<ivec3> mask_polygons_;
+  DeviceBuffer<rasterize_polygons::Edge> edges_gpu_;
+  DeviceBuffer<rasterize_polygons::MaskDesc> masks_gpu_;
+  DeviceBuffer<rasterize_polygons::BlockDesc> blocks_gpu_;
+};
+
+bool RasterizePolygonsGPU::SetupImpl(std::vector<OutputDesc> &output_desc,
+                                     const DeviceWorkspace &ws) {
+  const auto &polygons = ws.InputRef<CPUBackend>(0);
+  const auto &vertices = ws.InputRef<CPUBackend>(1);
+  DALI_ENFORCE(polygons.type() == DALI_INT32,
+               make_string("Expected polygons of type int32; got: ", polygons.type()));
+  DALI_ENFORCE(vertices.type() == DALI_FLOAT,
+               make_string("Expected vertices of type float; got: ", vertices.type()));
+  auto polygons_view = view<const int, 2>(polygons);
+  auto vertices_view = view<const float, 2>(vertices);
+  int nsamples = polygons_view.num_samples();
+  DALI_ENFORCE(vertices_view.num_samples() == nsamples, make_string(
+      "The number of samples in polygons and vertices must match. Got ", nsamples, " and ",
+      vertices_view.num_samples()));
+  mask_shape_.Acquire(spec_, ws, nsamples, TensorShape<1>{2});
+
+  TensorListShape<3> out_shape(nsamples);
+  sample_num_masks_.resize(nsamples);
+  for (int i = 0; i < nsamples; i++) {
+    auto poly_sh = polygons_view.tensor_shape(i);
+    auto vert_sh = vertices_view.tensor_shape(i);
+    DALI_ENFORCE(poly_sh[1] == 3, make_string(
+        "Polygons must be described by 3 values; got ", poly_sh[1], " in sample ", i));
+    DALI_ENFORCE(vert_sh[1] == 2, make_string(
+        "Only 2D vertices are supported; got ", vert_sh[1], " coordinates in sample ", i));
+    int64_t nvertices = vert_sh[0];
+    int max_mask_id = -1;
+    const auto *poly = polygons_view.tensor_data(i);
+    for (int64_t p = 0; p < poly_sh[0]; p++, poly += 3) {
+      DALI_ENFORCE(poly[0] >= 0, make_string("Negative mask id ", poly[0], " in sample ", i));
+      DALI_ENFORCE(poly[1] >= 0 && poly[1] <= poly[2] && poly[2] <= nvertices, make_string(
+          "Invalid vertex range [", poly[1], ", ", poly[2], ") in sample ", i,
+          " with ", nvertices, " vertices"));
+      max_mask_id = std::max(max_mask_id, poly[0]);
+    }
+    int num_masks = max_mask_id + 1;
+    if (num_masks_ >= 0) {
+      DALI_ENFORCE(max_mask_id < num_masks_, make_string(
+          "Mask id ", max_mask_id, " in sample ", i, " exceeds `num_masks`=", num_masks_));
+      num_masks = num_masks_;
+    }
+    const int *mask_shape = mask_shape_[i].data;
+    DALI_ENFORCE(mask_shape[0] >= 0 && mask_shape[1] >= 0, make_string(
+        "`mask_shape` must not be negative; got (", mask_shape[0], ", ", mask_shape[1], ")"));
+    sample_num_masks_[i] = num_masks;
+    out_shape.set_tensor_shape(i, TensorShape<3>{num_masks, mask_shape[0], mask_shape[1]});
+  }
+
+  output_desc.resize(1);
+  output_desc[0].type = DALI_UINT8;
+  output_desc[0].shape = out_shape;
+  return true;
+}
+
+void RasterizePolygonsGPU::AddMask(uint8_t *out, int height, int width,
+                                   span<const ivec3> polygons, span<const vec2> vertices) {
+  using namespace rasterize_polygons;  // NOLINT
+  float sx = relative_coords_ ? width : 1.0f;
+  float sy = relative_coords_ ? height : 1.0f;
+  MaskDesc mask;
+  mask.out = out;
+  mask.width = width;
+  mask.edge_start = edges_.size();
+  float lo_x = width, hi_x = 0, lo_y = height, hi_y = 0;
+  for (auto &polygon : polygons) {
+    int start = polygon[1], end = polygon[2];
+    if (end == start)
+      continue;
+    for (int v = start; v < end; v++) {
+      vec2 a = vertices[v];
+      vec2 b = vertices[v + 1 < end ? v + 1 : start];
+      a.x *= sx; a.y *= sy;
+      b.x *= sx; b.y *= sy;
+      Edge e;
+      e.x0 = a.x;
+      e.y0 = a.y;
+      e.y1 = b.y;
+      e.dxdy = a.y != b.y ? (b.x - a.x) / (b.y - a.y) : 0.0f;
+      e.polygon_end = v + 1 == end;
+      edges_.push_back(e);
+      lo_x = std::min(lo_x, a.x);
+      hi_x = std::max(hi_x, a.x);
+      lo_y = std::min(lo_y, a.y);
+      hi_y = std::max(hi_y, a.y);
+    }
+  }
+  mask.edge_end = edges_.size();
+  // Only the pixels with centers in the bounding box of the vertices can be covered
+  int x0 = std::max(0, static_cast<int>(std::ceil(lo_x - 0.5f)));
+  int y0 = std::max(0, static_cast<int>(std::ceil(lo_y - 0.5f)));
+  mask.x1 = std::min(width, static_cast<int>(std::floor(hi_x - 0.5f)) + 1);
+  mask.y1 = std::min(height, static_cast<int>(std::floor(hi_y - 0.5f)) + 1);
+  if (mask.edge_end == mask.edge_start || mask.x1 <= x0 || mask.y1 <= y0)
+    return;
+
+  int mask_idx = masks_.size();
+  masks_.push_back(mask);
+  for (int y = y0; y < mask.y1; y += kTileHeight)
+    for (int x = x0; x < mask.x1; x += kTileWidth)
+      blocks_.push_back({mask_idx, x, y});
+}
+
+void RasterizePolygonsGPU::RunImpl(DeviceWorkspace &ws) {
+  using namespace rasterize_polygons;  // NOLINT
+  const auto &polygons = ws.InputRef<CPUBackend>(0);
+  const auto &vertices = ws.InputRef<CPUBackend>(1);
+  auto &output = ws.OutputRef<GPUBackend>(0);
+  auto stream = ws.stream();
+  auto polygons_view = view<const int, 2>(polygons);
+  auto vertices_view = view<const float, 2>(vertices);
+  auto out_view = view<uint8_t, 3>(output);
+  int nsamples = out_view.num_samples();
+
+  // The pixels which are not covered by any mask tile are never visited by the kernel
+  if (output.nbytes() > 0)
+    CUDA_CALL(cudaMemsetAsync(output.raw_mutable_data(), 0, output.nbytes(), stream));
+
+  edges_.clear();
+  masks_.clear();
+  blocks_.clear();
+  for (int i = 0; i < nsamples; i++) {
+    auto sample_polygons = make_cspan(
+        reinterpret_cast<const ivec3 *>(polygons_view.tensor_data(i)),
+        polygons_view.tensor_shape_span(i)[0]);
+    auto sample_vertices = make_cspan(
+        reinterpret_cast<const vec2 *>(vertices_view.tensor_data(i)),
+        vertices_view.tensor_shape_span(i)[0]);
+    int num_masks = sample_num_masks_[i];
+    int height = out_view.tensor_shape_span(i)[1];
+    int width = out_view.tensor_shape_span(i)[2];
+    if (height == 0 || width == 0)
+      continue;
+
+    // group the polygons by mask id, keeping their original order
+    polygon_order_.resize(sample_polygons.size());
+    std::iota(polygon_order_.begin(), polygon_order_.end(), 0);
+    std::stable_sort(polygon_order_.begin(), polygon_order_.end(), [&](int a, int b) {
+      return sample_polygons[a][0] < sample_polygons[b][0];
+    });
+    size_t p = 0;
+    for (int m = 0; m < num_masks; m++) {
+      mask_polygons_.clear();
+      for (; p < polygon_order_.size() && sample_polygons[polygon_order_[p]][0] == m; p++)
+        mask_polygons_.push_back(sample_polygons[polygon_order_[p]]);
+      uint8_t *mask_out = out_view.tensor_data(i) + static_cast<int64_t>(m) * height * width;
+      AddMask(mask_out, height, width, make_cspan(mask_polygons_), sample_vertices);
+    }
+  }
+
+  if (blocks_.empty())
+    return;
+  edges_gpu_.from_host(edges_, stream);
+  masks_gpu_.from_host(masks_, stream);
+  blocks_gpu_.from_host(blocks_, stream);
+  dim3 block_dim(kTileWidth, kBlockHeight);
+  RasterizeKernel<<<blocks_.size(), block_dim, 0, stream>>>(
+      blocks_gpu_.data(), masks_gpu_.data(), edges_gpu_.data());
+  CUDA_CALL(cudaGetLastError());
+}
+
+DALI_REGISTER_OPERATOR(segmentation__RasterizePolygons, RasterizePolygonsGPU, GPU);
+
+}  // namespace dali
@@ -85,77 +85,74 @@ The operator accepts vertices with arbitrary number of coordinates.)code")
 in ``mask_ids`` input.)code",
       false);
 
-bool SelectMasksCPU::SetupImpl(std::vector<OutputDesc> &output_desc,
-                              const workspace_t<CPUBackend> &ws) {
-  const auto &in_mask_ids = ws.template InputRef<CPUBackend>(0);
-  auto in_mask_ids_shape = in_mask_ids.shape();
-  DALI_ENFORCE(in_mask_ids.type() == DALI_INT32, "``mask_ids`` input is expected to be int32");
-  DALI_ENFORCE(in_mask_ids_shape.sample_dim() == 1, "``mask_ids`` input is expected to be 1D");
+namespace select_masks {
 
-  const auto &in_polygons = ws.template InputRef<CPUBackend>(1);
-  auto in_polygons_shape = in_polygons.shape();
-  DALI_ENFORCE(in_polygons.type() == DALI_INT32,
+bool CheckInputs(DALIDataType mask_ids_type, const TensorListShape<> &mask_ids_shape,
+                 DALIDataType polygons_type, const TensorListShape<> &polygons_shape,
+                 const TensorListShape<> &vertices_shape) {
+  DALI_ENFORCE(mask_ids_type == DALI_INT32, "``mask_ids`` input is expected to be int32");
+  DALI_ENFORCE(mask_ids_shape.sample_dim() == 1, "``mask_ids`` input is expected to be 1D");
+
+  DALI_ENFORCE(polygons_type == DALI_INT32,
                "``polygons`` input is expected to be int32");
-  DALI_ENFORCE(in_polygons_shape.sample_dim() == 2,
+  DALI_ENFORCE(polygons_shape.sample_dim() == 2,
                make_string("``polygons`` input is expected to be 2D. Got ",
-                           in_polygons_shape.sample_dim(), "D"));
+                           polygons_shape.sample_dim(), "D"));
 
-  const auto &in_vertices = ws.template InputRef<CPUBackend>(2);
-  auto in_vertices_shape = in_vertices.shape();
-  DALI_ENFORCE(in_vertices_shape.sample_dim() == 2,
+  DALI_ENFORCE(vertices_shape.sample_dim() == 2,
                make_string("``vertices`` input is expected to be 2D. Got ",
-                           in_vertices_shape.sample_dim(), "D"));
+                           vertices_shape.sample_dim(), "D"));
 
-  int nsamples = in_polygons.size();
-  DALI_ENFORCE(nsamples == in_polygons_shape.size() && nsamples == in_vertices_shape.size(),
-               make_string("All the inputs should have the same number of samples. Got: ", nsamples,
-                           ", ", in_polygons_shape.size(), ", ", in_vertices_shape.size()));
+  int nsamples = polygons_shape.num_samples();
+  DALI_ENFORCE(nsamples == mask_ids_shape.num_samples() &&
+               nsamples == vertices_shape.num_samples(),
+               make_string("All the inputs should have the same number of samples. Got: ",
+                           mask_ids_shape.num_samples(), ", ", nsamples, ", ",
+                           vertices_shape.num_samples()));
 
-  if (nsamples == 0) {  // empty input
-    output_desc.reserve(2);
-    output_desc.push_back({in_polygons_shape, in_polygons.type()});
-    output_desc.push_back({in_vertices_shape, in_vertices.type()});
-    return true;
-  }
+  if (nsamples == 0)  // empty input
+    return false;
 
   for (int i = 0; i < nsamples; i++) {
-    auto sh = in_polygons_shape.tensor_shape_span(i);
+    auto sh = polygons_shape.tensor_shape_span(i);
     DALI_ENFORCE(3 == sh[1],
                  make_string("``polygons`` is expected to contain 2D tensors with 3 columns: "
                              "``mask_id, start_idx, end_idx``. Got ",
                              sh[1], " columns."));
   }
+  return true;
+}
 
-  const auto &in_mask_ids_view = view<const int32_t, 1>(in_mask_ids);
-  const auto &in_polygons_view = view<const int32_t, 2>(in_polygons);
-
-  auto out_polygons_shape = in_polygons_shape;
-  auto out_vertices_shape = in_vertices_shape;
-
-  samples_.resize(nsamples);
+void SelectPolygons(std::vector<SampleDesc> &samples, TensorListShape<> &out_polygons_shape,
+                    TensorListShape<> &out_vertices_shape,
+                    const TensorListView<StorageCPU, const int32_t, 1> &mask_ids,
+                    const TensorListView<StorageCPU, const int32_t, 2> &polygons,
+                    const TensorListShape<> &vertices_shape, bool reindex_masks) {
+  int nsamples = polygons.num_samples();
+  samples.resize(nsamples);
   for (int i = 0; i < nsamples; i++) {
-    samples_[i].clear();
-    auto &selected_masks = samples_[i].selected_masks;
-    auto &polygons = samples_[i].polygons;
-    int64_t nselected = in_mask_ids_view.tensor_shape_span(i)[0];
-    selected_masks = make_cspan(in_mask_ids_view.tensor_data(i), nselected);
+    samples[i].clear();
+    auto &selected_masks = samples[i].selected_masks;
+    auto &sample_polygons = samples[i].polygons;
+    int64_t nselected = mask_ids.tensor_shape_span(i)[0];
+    selected_masks = make_cspan(mask_ids.tensor_data(i), nselected);
     out_polygons_shape.tensor_shape_span(i)[0] = selected_masks.size();
     int idx = 0;
     for (auto mask_id : selected_masks) {
-      if (polygons.find(mask_id) != polygons.end()) {
+      if (sample_polygons.find(mask_id) != sample_polygons.end()) {
         DALI_FAIL(
             make_string("mask_ids should not have duplicated values. Got ", mask_id, " repeated."));
       }
-      polygons[mask_id].new_mask_id = reindex_masks_ ? idx++ : mask_id;
+      sample_polygons[mask_id].new_mask_id = reindex_masks ? idx++ : mask_id;
     }
 
-    int64_t npolygons = in_polygons_shape.tensor_shape_span(i)[0];
-    int64_t in_nvertices = in_vertices_shape.tensor_shape_span(i)[0];
+    int64_t npolygons = polygons.tensor_shape_span(i)[0];
+    int64_t in_nvertices = vertices_shape.tensor_shape_span(i)[0];
     for (int64_t k = 0; k < npolygons; k++) {
-      const auto *poly_data = in_polygons_view.tensor_data(i) + k * 3;
+      const auto *poly_data = polygons.tensor_data(i) + k * 3;
       int mask_id = poly_data[0];
-      auto it = polygons.find(mask_id);
-      if (it == polygons.end())
+      auto it = sample_polygons.find(mask_id);
+      if (it == sample_polygons.end())
         continue;
       auto &poly = it->second;
       poly.start_vertex = poly_data[1];
@@ -177,17 +174,33 @@ bool SelectMasksCPU::SetupImpl(std::vector<OutputDesc> &output_desc,
     int64_t nvertices = 0;
     for (int k = 0; k < nselected; k++) {
       int mask_id = selected_masks[k];
-      const auto &poly = polygons[mask_id];
+      const auto &poly = sample_polygons[mask_id];
       if (poly.start_vertex == -1 && poly.end_vertex == -1)
         DALI_FAIL(make_string("Selected mask_id ", mask_id, " is not present in the input."));
       nvertices += poly.end_vertex - poly.start_vertex;
     }
     out_vertices_shape.tensor_shape_span(i)[0] = nvertices;
   }
+}
+
+}  // namespace select_masks
 
-  output_desc.reserve(2);
-  output_desc.push_back({std::move(out_polygons_shape), in_polygons.type()});
-  output_desc.push_back({std::move(out_vertices_shape), in_vertices.type()});
+bool SelectMasksCPU::SetupImpl(std::vector<OutputDesc> &output_desc,
+                              const workspace_t<CPUBackend> &ws) {
+  const auto &in_mask_ids = ws.template InputRef<CPUBackend>(0);
+  const auto &in_polygons = ws.template InputRef<CPUBackend>(1);
+  const auto &in_vertices = ws.template InputRef<CPUBackend>(2);
+  auto in_polygons_shape = in_polygons.shape();
+  auto in_vertices_shape = in_vertices.shape();
+  if (!select_masks::CheckInputs(in_mask_ids.type(), in_mask_ids.shape(), in_polygons.type(),
+                                 in_polygons_shape, in_vertices_shape)) {
+    output_desc.reserve(2);
+    output_desc.push_back({in_polygons_shape, in_polygons.type()});
+    output_desc.push_back({in_vertices_shape, in_vertices.type()});
+    return true;
+  }
+  SetupOutputs(output_desc, view<const int32_t, 1>(in_mask_ids),
+               view<const int32_t, 2>(in_polygons), in_vertices_shape, in_vertices.type());
   return true;
 }
 
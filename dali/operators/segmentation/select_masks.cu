@@ -0,0 +1,163 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cuda_runtime_api.h>
+#include <utility>
+#include <vector>
+#include "dali/core/static_switch.h"
+#include "dali/kernels/common/type_erasure.h"
+#include "dali/operators/segmentation/select_masks.h"
+
+namespace dali {
+
+namespace {
+
+/**
+ * @brief Describes one output polygon: its mask id and the range of the output vertices,
+ *        and the input vertices to copy
+ */
+template <typename T>
+struct PolygonCopyDesc {
+  int32_t *out_polygon;
+  int32_t new_mask_id;
+  int32_t out_start_vertex;
+  int32_t out_end_vertex;
+  T *out_vertices;
+  const T *in_vertices;
+  int64_t size;
+};
+
+/**
+ * @brief Each block writes one output polygon and copies its vertices
+ */
+template <typename T>
+__global__ void SelectMasksKernel(const PolygonCopyDesc<T> *polygons) {
+  const auto &poly = polygons[blockIdx.x];
+  if (threadIdx.x == 0) {
+    poly.out_polygon[0] = poly.new_mask_id;
+    poly.out_polygon[1] = poly.out_start_vertex;
+    poly.out_polygon[2] = poly.out_end_vertex;
+  }
+  for (int64_t idx = threadIdx.x; idx < poly.size; idx += blockDim.x)
+    poly.out_vertices[idx] = poly.in_vertices[idx];
+}
+
+}  // namespace
+
+class SelectMasksGPU : public SelectMasks<GPUBackend> {
+ public:
+  explicit SelectMasksGPU(const OpSpec &spec) : SelectMasks<GPUBackend>(spec) {
+    mask_ids_cpu_.set_pinned(true);
+    polygons_cpu_.set_pinned(true);
+  }
+
+  ~SelectMasksGPU() override = default;
+  DISABLE_COPY_MOVE_ASSIGN(SelectMasksGPU);
+
+ protected:
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const workspace_t<GPUBackend> &ws) override;
+  void RunImpl(workspace_t<GPUBackend> &ws) override;
+
+ private:
+  template <typename T>
+  void RunImplTyped(workspace_t<GPUBackend> &ws);
+
+  TensorList<CPUBackend> mask_ids_cpu_, polygons_cpu_;
+  std::vector<uint8_t> descs_;
+  Tensor<GPUBackend> descs_gpu_;
+};
+
+bool SelectMasksGPU::SetupImpl(std::vector<OutputDesc> &output_desc,
+                               const workspace_t<GPUBackend> &ws) {
+  const auto &in_mask_ids = ws.template InputRef<GPUBackend>(0);
+  const auto &in_polygons = ws.template InputRef<GPUBackend>(1);
+  const auto &in_vertices = ws.template InputRef<GPUBackend>(2);
+  auto in_polygons_shape = in_polygons.shape();
+  auto in_vertices_shape = in_vertices.shape();
+  if (!select_masks::CheckInputs(in_mask_ids.type(), in_mask_ids.shape(), in_polygons.type(),
+                                 in_polygons_shape, in_vertices_shape)) {
+    output_desc.reserve(2);
+    output_desc.push_back({in_polygons_shape, in_polygons.type()});
+    output_desc.push_back({in_vertices_shape, in_vertices.type()});
+    return true;
+  }
+  // The output shapes depend on the selection, so the (small) mask metadata is read back;
+  // the vertices stay on the device
+  mask_ids_cpu_.Copy(in_mask_ids, ws.stream());
+  polygons_cpu_.Copy(in_polygons, ws.stream());
+  CUDA_CALL(cudaStreamSynchronize(ws.stream()));
+  SetupOutputs(output_desc, view<const int32_t, 1>(mask_ids_cpu_),
+               view<const int32_t, 2>(polygons_cpu_), in_vertices_shape, in_vertices.type());
+  return true;
+}
+
+template <typename T>
+void SelectMasksGPU::RunImplTyped(workspace_t<GPUBackend> &ws) {
+  const auto &in_vertices = ws.template InputRef<GPUBackend>(2);
+  const auto &in_vertices_view = reinterpret_view<const T, 2>(in_vertices);
+  auto &out_polygons = ws.template OutputRef<GPUBackend>(0);
+  const auto &out_polygons_view = view<int32_t, 2>(out_polygons);
+  auto &out_vertices = ws.template OutputRef<GPUBackend>(1);
+  const auto &out_vertices_view = reinterpret_view<T, 2>(out_vertices);
+
+  // the output vertex ranges are the prefix sums of the vertex counts of the selected polygons
+  int64_t npolygons = out_polygons_view.shape.num_elements() / 3;
+  descs_.resize(npolygons * sizeof(PolygonCopyDesc<T>));
+  auto *descs = reinterpret_cast<PolygonCopyDesc<T> *>(descs_.data());
+  for (int i = 0; i < out_polygons_view.num_samples(); i++) {
+    const auto &selected_masks = samples_[i].selected_masks;
+    const auto &polygons = samples_[i].polygons;
+    auto vertex_ndim = in_vertices_view.tensor_shape_span(i)[1];
+    int32_t out_vertex_i = 0;
+    for (int64_t k = 0; k < selected_masks.size(); k++) {
+      auto it = polygons.find(selected_masks[k]);
+      assert(it != polygons.end());
+      const auto &poly = it->second;
+      int32_t nvertices = poly.end_vertex - poly.start_vertex;
+      auto &desc = *descs++;
+      desc.out_polygon = out_polygons_view.tensor_data(i) + k * 3;
+      desc.new_mask_id = poly.new_mask_id;
+      desc.out_start_vertex = out_vertex_i;
+      desc.out_end_vertex = out_vertex_i + nvertices;
+      desc.out_vertices = out_vertices_view.tensor_data(i) + out_vertex_i * vertex_ndim;
+      desc.in_vertices = in_vertices_view.tensor_data(i) + poly.start_vertex * vertex_ndim;
+      desc.size = nvertices * vertex_ndim;
+      out_vertex_i += nvertices;
+    }
+  }
+  if (npolygons == 0)
+    return;
+
+  descs_gpu_.set_type<uint8_t>();
+  descs_gpu_.Resize({static_cast<int64_t>(descs_.size())});
+  auto *descs_gpu = reinterpret_cast<PolygonCopyDesc<T> *>(descs_gpu_.mutable_data<uint8_t>());
+  CUDA_CALL(cudaMemcpyAsync(descs_gpu, descs_.data(), descs_.size(), cudaMemcpyHostToDevice,
+                            ws.stream()));
+  SelectMasksKernel<<<npolygons, 256, 0, ws.stream()>>>(descs_gpu);
+  CUDA_CALL(cudaGetLastError());
+}
+
+void SelectMasksGPU::RunImpl(workspace_t<GPUBackend> &ws) {
+  const auto &in_vertices = ws.template InputRef<GPUBackend>(2);
+  VALUE_SWITCH(in_vertices.type_info().size(), dtype_sz, (1, 2, 4, 8, 16), (
+    using T = kernels::type_of_size<dtype_sz>;
+    RunImplTyped<T>(ws);
+  ), (  // NOLINT
+    DALI_FAIL(make_string("Unexpected vertex data type: ", in_vertices.type()));
+  ));  // NOLINT
+}
+
+DALI_REGISTER_OPERATOR(segmentation__SelectMasks, SelectMasksGPU, GPU);
+
+}  // namespace dali
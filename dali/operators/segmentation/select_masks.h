@@ -16,53 +16,99 @@
 #ifndef DALI_OPERATORS_SEGMENTATION_SELECT_MASKS_H_
 #define DALI_OPERATORS_SEGMENTATION_SELECT_MASKS_H_
 
-#include <vector>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 #include "dali/core/common.h"
 #include "dali/core/span.h"
 #include "dali/core/tensor_shape.h"
+#include "dali/core/tensor_view.h"
 #include "dali/pipeline/operator/operator.h"
 
 namespace dali {
 
+namespace select_masks {
 
-class SelectMasksCPU : public Operator<CPUBackend> {
- public:
-  explicit SelectMasksCPU(const OpSpec &spec)
-      : Operator<CPUBackend>(spec), reindex_masks_(spec.GetArgument<bool>("reindex_masks")) {}
+struct PolygonDesc {
+  int new_mask_id = -1;
+  int start_vertex = -1;
+  int end_vertex = -1;
+};
 
-  ~SelectMasksCPU() override = default;
-  DISABLE_COPY_MOVE_ASSIGN(SelectMasksCPU);
+struct SampleDesc {
+  span<const int> selected_masks;
+  std::unordered_map<int, PolygonDesc> polygons;
+  void clear() {
+    selected_masks = {};
+    polygons.clear();
+  }
+};
+
+/**
+ * @brief Validates the types and the shapes of the inputs
+ *
+ * @return false, if the batch is empty
+ */
+bool CheckInputs(DALIDataType mask_ids_type, const TensorListShape<> &mask_ids_shape,
+                 DALIDataType polygons_type, const TensorListShape<> &polygons_shape,
+                 const TensorListShape<> &vertices_shape);
+
+/**
+ * @brief Finds the polygons of the selected masks and computes the shapes of the outputs
+ */
+void SelectPolygons(std::vector<SampleDesc> &samples, TensorListShape<> &out_polygons_shape,
+                    TensorListShape<> &out_vertices_shape,
+                    const TensorListView<StorageCPU, const int32_t, 1> &mask_ids,
+                    const TensorListView<StorageCPU, const int32_t, 2> &polygons,
+                    const TensorListShape<> &vertices_shape, bool reindex_masks);
+
+}  // namespace select_masks
+
+template <typename Backend>
+class SelectMasks : public Operator<Backend> {
+ public:
+  explicit SelectMasks(const OpSpec &spec)
+      : Operator<Backend>(spec), reindex_masks_(spec.GetArgument<bool>("reindex_masks")) {}
 
  protected:
   bool CanInferOutputs() const override {
     return true;
   }
 
+  /**
+   * @brief Selects the polygons, given the host copies of ``mask_ids`` and ``polygons``
+   */
+  void SetupOutputs(std::vector<OutputDesc> &output_desc,
+                    const TensorListView<StorageCPU, const int32_t, 1> &mask_ids,
+                    const TensorListView<StorageCPU, const int32_t, 2> &polygons,
+                    const TensorListShape<> &vertices_shape, DALIDataType vertices_type) {
+    TensorListShape<> out_polygons_shape = polygons.shape;
+    auto out_vertices_shape = vertices_shape;
+    select_masks::SelectPolygons(samples_, out_polygons_shape, out_vertices_shape, mask_ids,
+                                 polygons, vertices_shape, reindex_masks_);
+    output_desc.reserve(2);
+    output_desc.push_back({std::move(out_polygons_shape), DALI_INT32});
+    output_desc.push_back({std::move(out_vertices_shape), vertices_type});
+  }
+
+  std::vector<select_masks::SampleDesc> samples_;
+  bool reindex_masks_;
+};
+
+class SelectMasksCPU : public SelectMasks<CPUBackend> {
+ public:
+  explicit SelectMasksCPU(const OpSpec &spec) : SelectMasks<CPUBackend>(spec) {}
+
+  ~SelectMasksCPU() override = default;
+  DISABLE_COPY_MOVE_ASSIGN(SelectMasksCPU);
+
+ protected:
   bool SetupImpl(std::vector<OutputDesc> &output_desc, const workspace_t<CPUBackend> &ws) override;
   void RunImpl(workspace_t<CPUBackend> &ws) override;
 
  private:
   template <typename T>
   void RunImplTyped(workspace_t<CPUBackend> &ws);
-
-  struct PolygonDesc {
-    int new_mask_id = -1;
-    int start_vertex = -1;
-    int end_vertex = -1;
-  };
-
-  struct SampleDesc {
-    span<const int> selected_masks;
-    std::unordered_map<int, PolygonDesc> polygons;
-    void clear() {
-      selected_masks = {};
-      polygons.clear();
-    }
-  };
-  std::vector<SampleDesc> samples_;
-
-  bool reindex_masks_;
 };
 
 }  // namespace dali
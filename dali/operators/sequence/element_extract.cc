@@ -28,6 +28,8 @@ For example, for ``element_map = [2, 0, 3]`` there will be three outputs, contai
 
 The input layout, if provided, must begin with ``F`` dimension. The outputs will have one less
 dimension than the input, that is for ``FHWC`` inputs, the outputs will be ``HWC`` elements.
+
+On the CPU, the outputs are views of the input sequences - no data is copied.
 )code")
     .NumInput(1)
     .NumOutput(1)
@@ -35,6 +37,7 @@ dimension than the input, that is for ``FHWC`` inputs, the outputs will be ``HWC
     .AddArg("element_map",
         R"code(Indices of the elements to extract.)code",
         DALI_INT_VEC)
+    .PassThroughToAllOutputs()
     .AdditionalOutputsFn(
         [](const OpSpec& spec) {
             auto element_map = spec.GetRepeatedArgument<int>("element_map");
@@ -45,8 +48,20 @@ dimension than the input, that is for ``FHWC`` inputs, the outputs will be ``HWC
 
 
 template <>
-void ElementExtract<CPUBackend>::RunCopies(HostWorkspace &ws) {
-  scatter_gather_.Run(ws.GetThreadPool(), true);
+void ElementExtract<CPUBackend>::RunImpl(HostWorkspace &ws) {
+  // an element is a contiguous part of the sequence, so it can be shared instead of copied
+  const auto &input = ws.InputRef<CPUBackend>(0);
+  auto element_layout = VideoLayoutInfo::GetFrameLayout(input.GetLayout());
+  auto output_shape = input.shape().last(input.shape().sample_dim() - 1);
+  int nsamples = input.ntensor();
+  offsets_.resize(nsamples);
+  for (size_t k = 0; k < element_map_.size(); k++) {
+    for (int i = 0; i < nsamples; i++)
+      offsets_[i] = element_map_[k] * output_shape.tensor_size(i) * input.type_info().size();
+    auto &output = ws.OutputRef<CPUBackend>(k);
+    output.ShareSamples(input, make_cspan(offsets_), output_shape);
+    output.SetLayout(element_layout);
+  }
 }
 
 DALI_REGISTER_OPERATOR(ElementExtract, ElementExtract<CPUBackend>, CPU);
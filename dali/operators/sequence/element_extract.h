@@ -83,7 +83,8 @@ class ElementExtract : public Operator<Backend> {
 
  protected:
   bool CanInferOutputs() const override {
-    return true;
+    // the CPU outputs are views of the input
+    return !std::is_same<Backend, CPUBackend>::value;
   }
 
   bool SetupImpl(std::vector<OutputDesc> &output_desc, const workspace_t<Backend> &ws) override {
@@ -94,7 +95,7 @@ class ElementExtract : public Operator<Backend> {
       desc.shape = output_shape;
       desc.type = input.type();
     }
-    return true;
+    return CanInferOutputs();
   }
 
   void RunImpl(workspace_t<Backend> &ws) override {
@@ -126,6 +127,7 @@ class ElementExtract : public Operator<Backend> {
 
  private:
   std::vector<int> element_map_;
+  std::vector<int64_t> offsets_;
 
   std::conditional_t<
       std::is_same<Backend, CPUBackend>::value,
@@ -136,6 +138,9 @@ class ElementExtract : public Operator<Backend> {
       std::is_same<Backend, CPUBackend>::value ? kernels::ScatterGatherCPU::kAnyBlockSize : 1 << 18;
 };
 
+template <>
+void ElementExtract<CPUBackend>::RunImpl(HostWorkspace &ws);
+
 }  // namespace dali
 
 #endif  // DALI_OPERATORS_SEQUENCE_ELEMENT_EXTRACT_H_
@@ -137,18 +137,8 @@ void OpticalFlow<GPUBackend>::RunImpl(Workspace<GPUBackend> &ws) {
     DALI_ENFORCE(tvlhints.size() == nsequences_,
                  "Number of tensors for hints and inputs doesn't match");
     for (int sequence_idx = 0; sequence_idx < nsequences_; sequence_idx++) {
-      auto sequence_tv = tvlin[sequence_idx];
-      auto output_tv = tvlout[sequence_idx];
-      auto hints_tv = tvlhints[sequence_idx];
-
-      for (int i = 1; i < sequence_tv.shape[0]; i++) {
-        auto ref = subtensor(sequence_tv, i - 1);
-        auto in = subtensor(sequence_tv, i);
-        auto h = subtensor(hints_tv, i);
-        auto out = subtensor(output_tv, i - 1);
-
-        optical_flow_->CalcOpticalFlow(ref, in, out, h);
-      }
+      optical_flow_->CalcOpticalFlowSequence(tvlin[sequence_idx], tvlout[sequence_idx],
+                                             tvlhints[sequence_idx]);
     }
   } else {
     // Fetch data
@@ -175,16 +165,7 @@ void OpticalFlow<GPUBackend>::RunImpl(Workspace<GPUBackend> &ws) {
     auto tvlout = view<float, kNInputDims>(output);
 
     for (int sequence_idx = 0; sequence_idx < nsequences_; sequence_idx++) {
-      auto sequence_tv = tvlin[sequence_idx];
-      auto output_tv = tvlout[sequence_idx];
-
-      for (int i = 1; i < sequence_tv.shape[0]; i++) {
-        auto ref = subtensor(sequence_tv, i - 1);
-        auto in = subtensor(sequence_tv, i);
-        auto out = subtensor(output_tv, i - 1);
-
-        optical_flow_->CalcOpticalFlow(ref, in, out);
-      }
+      optical_flow_->CalcOpticalFlowSequence(tvlin[sequence_idx], tvlout[sequence_idx]);
     }
   }
   if (of_stream != ws.stream()) {
@@ -88,20 +88,27 @@ class OpticalFlow : public Operator<Backend> {
  private:
   /**
    * Optical flow lazy initialization
+   *
+   * The optical flow engine and its buffers are kept across the iterations and recreated
+   * only when the size of the frames changes.
    */
   void of_lazy_init(size_t width, size_t height, size_t channels, DALIImageType image_type,
                     int device_id, cudaStream_t stream) {
-    std::call_once(of_initialized_,
-                   [&]() {
-                       optical_flow_.reset(
-                               new optical_flow::OpticalFlowTuring(of_params_,
-                                                                   width,
-                                                                   height,
-                                                                   channels,
-                                                                   image_type,
-                                                                   device_id,
-                                                                   stream));
-                   });
+    if (of_initialized_ && of_width_ == width && of_height_ == height &&
+        of_channels_ == channels)
+      return;
+    if (of_initialized_) {
+      // the buffers of the previous engine may still be in use
+      CUDA_CALL(cudaStreamSynchronize(stream));
+    }
+    // release the previous engine before creating the new one
+    optical_flow_.reset();
+    optical_flow_.reset(new optical_flow::OpticalFlowTuring(of_params_, width, height, channels,
+                                                            image_type, device_id, stream));
+    of_initialized_ = true;
+    of_width_ = width;
+    of_height_ = height;
+    of_channels_ = channels;
   }
 
   optical_flow::VectorGridSize ConvertGridSize(int grid_size) {
@@ -168,7 +175,8 @@ class OpticalFlow : public Operator<Backend> {
   const int grid_size_;
   const bool enable_temporal_hints_;
   const bool enable_external_hints_;
-  std::once_flag of_initialized_;
+  bool of_initialized_ = false;
+  size_t of_width_ = 0, of_height_ = 0, of_channels_ = 0;
   optical_flow::OpticalFlowParams of_params_;
   std::unique_ptr<optical_flow::OpticalFlowAdapter<ComputeBackend>> optical_flow_;
   DALIImageType image_type_;
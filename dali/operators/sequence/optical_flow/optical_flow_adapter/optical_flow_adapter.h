@@ -63,6 +63,29 @@ class DLL_PUBLIC OpticalFlowAdapter {
                                TensorView<StorageBackend, const float, 3> external_hints = TensorView<StorageBackend, const float, 3>()) = 0;  // NOLINT
 
 
+  /**
+   * Perform OpticalFlow calculation for every pair of consecutive frames in a sequence.
+   *
+   * The output (and the external hints, if used) for the pair of frames (i-1, i)
+   * is placed at index i-1 (respectively i) of the outermost dimension.
+   * Implementations can reuse the data prepared for one frame in both pairs it takes part in.
+   */
+  virtual void CalcOpticalFlowSequence(TensorView<StorageBackend, const uint8_t, 4> frames,
+                                       TensorView<StorageBackend, float, 4> output,
+                                       TensorView<StorageBackend, const float, 4> external_hints =
+                                           TensorView<StorageBackend, const float, 4>()) {
+    for (int i = 1; i < frames.shape[0]; i++) {
+      auto ref = subtensor(frames, i - 1);
+      auto in = subtensor(frames, i);
+      auto out = subtensor(output, i - 1);
+      if (external_hints.data)
+        CalcOpticalFlow(ref, in, out, subtensor(external_hints, i));
+      else
+        CalcOpticalFlow(ref, in, out);
+    }
+  }
+
+
   virtual ~OpticalFlowAdapter() = default;
 
  protected:
@@ -39,6 +39,22 @@ TEST(OpticalFlowAdapter, StubApiCpuBackend) {
 }
 
 
+TEST(OpticalFlowAdapter, StubSequenceCpuBackend) {
+  constexpr int kFrames = 4;
+  std::vector<uint8_t> frames(kFrames);
+  std::vector<float> out_data((kFrames - 1) * kTestDataSize);
+  TensorView<StorageCPU, const uint8_t, 4> tvframes(frames.data(), {kFrames, 1, 1, 1});
+  TensorView<StorageCPU, float, 4> tvout(out_data.data(), {kFrames - 1, 1, 1, 2});
+  OpticalFlowParams params = {0.f, VectorGridSize::SIZE_4, false, false};
+  std::unique_ptr<OpticalFlowAdapter<ComputeCPU>> of(new OpticalFlowStub<ComputeCPU>(params));
+  of->CalcOpticalFlowSequence(tvframes, tvout);
+  for (int i = 0; i < kFrames - 1; i++) {
+    EXPECT_FLOAT_EQ(OpticalFlowStub<ComputeCPU>::kStubValue, *tvout(i, 0, 0, 0));
+    EXPECT_FLOAT_EQ(OpticalFlowStub<ComputeCPU>::kStubValue / 2, *tvout(i, 0, 0, 1));
+  }
+}
+
+
 TEST(OpticalFlowAdapter, StubApiGpuBackend) {
   using StubValueType = std::remove_const_t<decltype(OpticalFlowStub<ComputeGPU>::kStubValue)>;
   StubValueType *tvout_data;
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <dlfcn.h>
+#include <utility>
 
 #include "dali/operators/sequence/optical_flow/turing_of/optical_flow_turing.h"
 #include "dali/core/device_guard.h"
@@ -107,40 +108,82 @@ void OpticalFlowTuring::CalcOpticalFlow(
         TensorView<StorageGPU, const uint8_t, 3> input_image,
         TensorView<StorageGPU, float, 3> output_image,
         TensorView<StorageGPU, const float, 3> external_hints) {
+  VerifyHints(output_image.shape, external_hints.shape);
+  ConvertFrame(input_image.data, *inbuf_);
+  ConvertFrame(reference_image.data, *refbuf_);
+  Execute(output_image, external_hints, of_params_.enable_temporal_hints);
+}
+
+
+void OpticalFlowTuring::CalcOpticalFlowSequence(
+        TensorView<StorageGPU, const uint8_t, 4> frames,
+        TensorView<StorageGPU, float, 4> output,
+        TensorView<StorageGPU, const float, 4> external_hints) {
+  if (of_params_.enable_external_hints) {
+    DALI_ENFORCE(external_hints.shape[0] >= frames.shape[0],
+                 "If external hints are used, there must be a hint for every frame");
+  }
+  if (frames.shape[0] < 2)
+    return;
+  ConvertFrame(subtensor(frames, 0).data, *refbuf_);
+  for (int i = 1; i < frames.shape[0]; i++) {
+    auto out = subtensor(output, i - 1);
+    auto hints = of_params_.enable_external_hints ? subtensor(external_hints, i)
+                                                  : TensorView<StorageGPU, const float, 3>();
+    VerifyHints(out.shape, hints.shape);
+    ConvertFrame(subtensor(frames, i).data, *inbuf_);
+    // the flow from the previous sequence is not a valid hint for the first pair of frames
+    Execute(out, hints, of_params_.enable_temporal_hints && i > 1);
+    // the current frame is the reference frame of the next pair - it's converted only once
+    std::swap(inbuf_, refbuf_);
+  }
+}
+
+
+void OpticalFlowTuring::VerifyHints(const TensorShape<3> &output_shape,
+                                    const TensorShape<3> &hints_shape) {
   if (of_params_.enable_external_hints) {
-    DALI_ENFORCE(external_hints.shape == output_image.shape,
+    DALI_ENFORCE(hints_shape == output_shape,
                  "If external hint are used, shape must match against output_image");
   } else {
-    DALI_ENFORCE(external_hints.shape == TensorShape<3>(),
+    DALI_ENFORCE(hints_shape == TensorShape<3>(),
                  "If external hints aren't used, shape must be empty");
   }
+}
+
+
+void OpticalFlowTuring::ConvertFrame(const uint8_t *frame, OpticalFlowBuffer &buffer) {
+  auto *ptr = reinterpret_cast<uint8_t *>(buffer.GetPtr());
   switch (image_type_) {
     case DALI_BGR:
-      kernel::BgrToRgba(input_image.data, reinterpret_cast<uint8_t *>(inbuf_->GetPtr()),
-                        inbuf_->GetStride().x, width_, height_, stream_);
-      kernel::BgrToRgba(reference_image.data, reinterpret_cast<uint8_t *>(refbuf_->GetPtr()),
-                        refbuf_->GetStride().x, width_, height_, stream_);
+      kernel::BgrToRgba(frame, ptr, buffer.GetStride().x, width_, height_, stream_);
       break;
     case DALI_RGB:
-      kernel::RgbToRgba(input_image.data, reinterpret_cast<uint8_t *>(inbuf_->GetPtr()),
-                        inbuf_->GetStride().x, width_, height_, stream_);
-      kernel::RgbToRgba(reference_image.data, reinterpret_cast<uint8_t *>(refbuf_->GetPtr()),
-                        refbuf_->GetStride().x, width_, height_, stream_);
+      kernel::RgbToRgba(frame, ptr, buffer.GetStride().x, width_, height_, stream_);
       break;
     case DALI_GRAY:
-      kernel::Gray(input_image.data, reinterpret_cast<uint8_t *>(inbuf_->GetPtr()),
-                   inbuf_->GetStride().x, width_, height_, stream_);
-      kernel::Gray(reference_image.data, reinterpret_cast<uint8_t *>(refbuf_->GetPtr()),
-                   refbuf_->GetStride().x, width_, height_, stream_);
+      kernel::Gray(frame, ptr, buffer.GetStride().x, width_, height_, stream_);
       break;
     default:
       DALI_FAIL("Provided image type not supported");
   }
+}
+
 
+void OpticalFlowTuring::Execute(TensorView<StorageGPU, float, 3> output_image,
+                                TensorView<StorageGPU, const float, 3> external_hints,
+                                bool temporal_hints) {
+  if (of_params_.enable_external_hints) {
+    kernel::EncodeFlowComponents(external_hints.data,
+                                 reinterpret_cast<int16_t *>(hintsbuf_->GetPtr()),
+                                 hintsbuf_->GetStride().x, hintsbuf_->GetDescriptor().width,
+                                 hintsbuf_->GetDescriptor().height, stream_);
+  }
   auto in_params = GenerateExecuteInParams(inbuf_->GetHandle(), refbuf_->GetHandle(),
                                            of_params_.enable_external_hints
                                            ? hintsbuf_->GetHandle()
-                                           : nullptr);
+                                           : nullptr,
+                                           temporal_hints);
   auto out_params = GenerateExecuteOutParams(outbuf_->GetHandle());
   CUDA_CALL(turing_of_.nvOFExecute(of_handle_, &in_params, &out_params));
 
@@ -185,12 +228,12 @@ void OpticalFlowTuring::SetInitParams(dali::optical_flow::OpticalFlowParams api_
 
 NV_OF_EXECUTE_INPUT_PARAMS OpticalFlowTuring::GenerateExecuteInParams
         (NvOFGPUBufferHandle in_handle, NvOFGPUBufferHandle ref_handle,
-         NvOFGPUBufferHandle hints_handle) {
+         NvOFGPUBufferHandle hints_handle, bool temporal_hints) {
   // zeroing required for padding, padding2 and hPrivData
   NV_OF_EXECUTE_INPUT_PARAMS params = {};
   params.inputFrame = in_handle;
   params.referenceFrame = ref_handle;
-  params.disableTemporalHints = of_params_.enable_temporal_hints ? NV_OF_FALSE : NV_OF_TRUE;
+  params.disableTemporalHints = temporal_hints ? NV_OF_FALSE : NV_OF_TRUE;
   params.externalHints = hints_handle;
   return params;
 }
@@ -130,13 +130,40 @@ class DLL_PUBLIC OpticalFlowTuring : public OpticalFlowAdapter<ComputeGPU> {
                        TensorView<StorageBackend, const float, 3>()) override;
 
 
+  /**
+   * Each frame is converted to the NVOF input format only once and used as the input frame
+   * of one pair and the reference frame of the next one. Temporal hints (if enabled)
+   * are not carried over from the previous sequence.
+   */
+  void CalcOpticalFlowSequence(TensorView<StorageBackend, const uint8_t, 4> frames,
+                               TensorView<StorageBackend, float, 4> output,
+                               TensorView<StorageBackend, const float, 4> external_hints =
+                               TensorView<StorageBackend, const float, 4>()) override;
+
+
  private:
   void SetInitParams(OpticalFlowParams api_params);
 
 
+  void VerifyHints(const TensorShape<3> &output_shape, const TensorShape<3> &hints_shape);
+
+
+  /**
+   * Converts the frame to the NVOF input format and puts it in the buffer
+   */
+  void ConvertFrame(const uint8_t *frame, OpticalFlowBuffer &buffer);
+
+
+  /**
+   * Calculates the flow between the frames in `inbuf_` and `refbuf_`
+   */
+  void Execute(TensorView<StorageBackend, float, 3> output_image,
+               TensorView<StorageBackend, const float, 3> external_hints, bool temporal_hints);
+
+
   NV_OF_EXECUTE_INPUT_PARAMS
   GenerateExecuteInParams(NvOFGPUBufferHandle in_handle, NvOFGPUBufferHandle ref_handle,
-                          NvOFGPUBufferHandle hints_handle = nullptr);
+                          NvOFGPUBufferHandle hints_handle, bool temporal_hints);
 
 
   NV_OF_EXECUTE_OUTPUT_PARAMS GenerateExecuteOutParams(NvOFGPUBufferHandle out_handle);
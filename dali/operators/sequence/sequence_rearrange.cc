@@ -22,10 +22,14 @@ DALI_SCHEMA(SequenceRearrange)
     .DocStr(R"code(Rearranges frames in a sequence.
 
 Assumes that the outermost dimension represents the frame index in the sequence.
-If the input has a non-empty layout description, it must start with ``F`` (frame).)code")
+If the input has a non-empty layout description, it must start with ``F`` (frame).
+
+On the CPU, when ``new_order`` selects a run of consecutive frames, in order, for all samples,
+the output is a view of the input and no data is copied.)code")
     .NumInput(1)
     .NumOutput(1)
     .AllowSequences()
+    .PassThrough({{0, 0}})
     .AddArg("new_order", R"code(List that describes the new order for the elements in each sample.
 
 Output sequence at position ``i`` will contain element ``new_order[i]`` from input sequence::
@@ -73,31 +77,41 @@ void SequenceRearrange<CPUBackend>::RunImpl(workspace_t<CPUBackend> &ws) {
   const auto &input = ws.InputRef<CPUBackend>(0);
   auto &output = ws.OutputRef<CPUBackend>(0);
   auto &thread_pool = ws.GetThreadPool();
-  auto out_shape = output.shape();
   auto curr_batch_size = ws.GetInputBatchSize(0);
+  const TypeInfo &type = input.type_info();
+
+  // consecutive frames, in order, are a contiguous part of the input sequence - if all samples
+  // select such a run of frames, the output is a view of the input
+  view_offsets_.resize(curr_batch_size);
+  bool share = true;
+  for (int sample_idx = 0; sample_idx < curr_batch_size && share; ++sample_idx) {
+    auto new_order = GetNewOrder(ws, sample_idx);
+    for (int i = 1; i < new_order.shape.num_elements() && share; i++)
+      share = new_order.data[i] == new_order.data[0] + i;
+    const auto &in_shape = input[sample_idx].shape();
+    auto element_sizeof = volume(in_shape.last(in_shape.sample_dim() - 1)) * type.size();
+    view_offsets_[sample_idx] = new_order.data[0] * element_sizeof;
+  }
+  if (share) {
+    output.ShareSamples(input, make_cspan(view_offsets_), output_shape_);
+    output.SetLayout(input.GetLayout());
+    return;
+  }
 
+  output.SetContiguous(true);
+  output.Resize(output_shape_, input.type());
   for (int sample_idx = 0; sample_idx < curr_batch_size; ++sample_idx) {
-    thread_pool.AddWork([this, &ws, &input, &output, sample_idx](int tid) {
-      const TypeInfo &type = input.type_info();
+    thread_pool.AddWork([this, &ws, &input, &output, &type, sample_idx](int tid) {
       const auto *in_sample = reinterpret_cast<const char *>(input[sample_idx].raw_data());
       auto *out_sample = reinterpret_cast<char *>(output[sample_idx].raw_mutable_data());
       const auto &in_shape = input[sample_idx].shape();
       auto element_sizeof = volume(in_shape.last(in_shape.sample_dim() - 1)) * type.size();
-
-      TensorView<StorageCPU, const int, 1> new_order = {};
-
-      if (single_order_) {
-        new_order = TensorView<StorageCPU, const int, 1>(new_order_.data(),
-                                                         TensorShape<1>(new_order_.size()));
-      } else {
-        auto &new_orders = ws.ArgumentInput("new_order");
-        new_order = view<const int, 1>(new_orders[sample_idx]);
-      }
+      auto new_order = GetNewOrder(ws, sample_idx);
       for (int i = 0; i < new_order.shape.num_elements(); i++) {
         auto copy_desc = GetCopyDesc(out_sample, in_sample, i, new_order.data[i], element_sizeof);
         memcpy(copy_desc.to, copy_desc.from, copy_desc.size);
       }
-    }, out_shape.tensor_size(sample_idx));
+    }, output_shape_.tensor_size(sample_idx));
   }
   thread_pool.RunAll();
 
@@ -16,6 +16,7 @@
 #define DALI_OPERATORS_SEQUENCE_SEQUENCE_REARRANGE_H_
 
 #include <tuple>
+#include <type_traits>
 #include <vector>
 
 #include "dali/core/format.h"
@@ -62,7 +63,9 @@ class SequenceRearrange : public Operator<Backend> {
 
  protected:
   bool CanInferOutputs() const override {
-    return true;
+    // the CPU operator returns a view of the input when possible, so it allocates the output
+    // only when the frames need to be copied
+    return !std::is_same<Backend, CPUBackend>::value;
   }
 
   bool SetupImpl(std::vector<OutputDesc>& output_desc, const workspace_t<Backend>& ws) override {
@@ -88,6 +91,7 @@ class SequenceRearrange : public Operator<Backend> {
         output_desc[0].shape.set_tensor_shape(i, GetSeqRearrangedShape(in_shape[i], new_order));
       }
     }
+    output_shape_ = output_desc[0].shape;
 
     auto layout = input.GetLayout();
     DALI_ENFORCE(layout.empty() || layout.find('F') == 0,
@@ -95,15 +99,25 @@ class SequenceRearrange : public Operator<Backend> {
                              "frames dimension `F`, got data with layout = \"",
                              layout, "\"."));
 
-    return true;
+    return CanInferOutputs();
   }
 
   void RunImpl(workspace_t<Backend>& ws) override;
 
+  TensorView<StorageCPU, const int, 1> GetNewOrder(const workspace_t<Backend>& ws,
+                                                   int sample_idx) const {
+    if (single_order_)
+      return TensorView<StorageCPU, const int, 1>(new_order_.data(),
+                                                  TensorShape<1>(new_order_.size()));
+    return view<const int, 1>(ws.ArgumentInput("new_order")[sample_idx]);
+  }
+
  private:
   USE_OPERATOR_MEMBERS();
   bool single_order_ = false;
   std::vector<int> new_order_;
+  TensorListShape<> output_shape_;
+  std::vector<int64_t> view_offsets_;
   kernels::ScatterGatherGPU scatter_gather_;
   static constexpr size_t kMaxSizePerBlock = 1 << 18;  // 256 kB per block
 };
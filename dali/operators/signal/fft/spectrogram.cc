@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
@@ -21,12 +22,22 @@
 #include "dali/kernels/signal/window/window_functions.h"
 #include "dali/kernels/signal/fft/fft_cpu.h"
 #include "dali/core/static_switch.h"
+#include "dali/core/util.h"
 #include "dali/pipeline/data/views.h"
 
 #define SPECTROGRAM_SUPPORTED_NDIMS (1, 2)
 
 namespace dali {
 
+namespace {
+
+/// The long signals are split into blocks of at least this many windows
+constexpr int64_t kMinWindowsPerBlock = 64;
+/// The target number of blocks per thread, to balance the load
+constexpr int kBlocksPerThread = 4;
+
+}  // namespace
+
 DALI_SCHEMA(Spectrogram)
   .DocStr(R"(Produces a spectrogram from a 1D signal (for example, audio).
 
@@ -81,6 +92,14 @@ is padded with zeros.
   When ``center_windows`` is set to False, this option is ignored.
 )",
     true)
+  .AddOptionalArg("preemph_coeff",
+    R"(Preemphasis coefficient applied to the signal before the windows are extracted.
+
+The filter is applied on the fly, as ``y[i] = x[i] - preemph_coeff * x[i-1]`` with
+``x[-1] = x[0]``, which is equivalent to running :meth:`nvidia.dali.fn.preemphasis_filter` with
+``border="clamp"`` first, but doesn't require an extra pass over the signal.
+A value of 0 disables the preemphasis.)",
+    0.0f)
   .AddOptionalArg("layout", R"(Output layout: "ft" (frequency-major) or "tf" (time-major).)",
     TensorLayout("ft"));
 
@@ -109,6 +128,7 @@ struct SpectrogramImplCpu : OpImplBase<CPUBackend> {
   std::vector<float> window_fn_;
   int window_center_ = -1;
   int nfft_ = -1;
+  float preemph_coeff_ = 0;
   TensorLayout layout_;
 
   using Padding = kernels::signal::Padding;
@@ -118,10 +138,22 @@ struct SpectrogramImplCpu : OpImplBase<CPUBackend> {
   kernels::signal::ExtractWindowsArgs window_args_;
 
   std::vector<OutputDesc> window_out_desc_;
+  /// the windows of the block processed by each thread
   std::vector<Tensor<CPUBackend>> window_out_;
+  /// the frequency-major spectra of the block processed by each thread, before they're
+  /// copied to the output columns
+  std::vector<std::vector<OutputType>> spectrum_out_;
 
+  /// One instance per thread - the FFT kernel can't be run concurrently
   kernels::KernelManager kmgr_fft_;
   kernels::signal::fft::FftArgs fft_args_;
+
+  /// A range of windows of one sample
+  struct WindowBlock {
+    int sample;
+    int64_t begin, end;
+  };
+  std::vector<WindowBlock> blocks_;
 };
 
 namespace {
@@ -152,7 +184,8 @@ SpectrogramImplCpu<time_major>::SpectrogramImplCpu(const OpSpec &spec)
     : window_length_(spec.GetArgument<int>("window_length"))
     , window_step_(spec.GetArgument<int>("window_step"))
     , power_(spec.GetArgument<int>("power"))
-    , window_fn_(spec.GetRepeatedArgument<float>("window_fn")) {
+    , window_fn_(spec.GetRepeatedArgument<float>("window_fn"))
+    , preemph_coeff_(spec.GetArgument<float>("preemph_coeff")) {
   DALI_ENFORCE(window_length_ > 0, make_string("Invalid window length: ", window_length_));
   DALI_ENFORCE(window_step_ > 0, make_string("Invalid window step: ", window_step_));
   nfft_ = spec.HasArgument("nfft") ? spec.GetArgument<int>("nfft") : window_length_;
@@ -207,7 +240,7 @@ bool SpectrogramImplCpu<time_major>::SetupImpl(std::vector<OutputDesc> &out_desc
   kmgr_window_.Initialize<WindowKernel>();
   kmgr_window_.Resize<WindowKernel>(nthreads, nsamples);
   constexpr int axis = 0;
-  window_args_ = {window_length_, window_center_, window_step_, axis, padding_};
+  window_args_ = {window_length_, window_center_, window_step_, axis, padding_, preemph_coeff_};
 
   for (int sample_id = 0; sample_id < in_shape.num_samples(); sample_id++) {
     int64_t signal_length = in_shape[sample_id].num_elements();
@@ -216,7 +249,8 @@ bool SpectrogramImplCpu<time_major>::SetupImpl(std::vector<OutputDesc> &out_desc
   }
 
   kmgr_fft_.Initialize<FftKernel>();
-  kmgr_fft_.Resize<FftKernel>(nthreads, nsamples);
+  kmgr_fft_.Resize<FftKernel>(nthreads, nthreads);
+  spectrum_out_.resize(nthreads);
   FillFftArgs(fft_args_, power_, window_length_, nfft_, transform_dim);
 
   window_out_desc_.resize(1);
@@ -240,14 +274,24 @@ bool SpectrogramImplCpu<time_major>::SetupImpl(std::vector<OutputDesc> &out_desc
         window_args_);
     window_out_desc_[0].shape.set_tensor_shape(i, windows_req.output_shapes[0][0].shape);
 
-    auto windows_shape = windows_req.output_shapes[0][0].template to_static<WindowsDims>();
-    auto dummy_win_view = make_tensor_cpu<WindowsDims, InputType>(nullptr, windows_shape);
-    auto &out_req =
-      kmgr_fft_.Setup<FftKernel>(
-        i, ctx,
-        dummy_win_view,
-        fft_args_);
-    out_desc[0].shape.set_tensor_shape(i, out_req.output_shapes[0][0].shape);
+    auto out_shape = windows_req.output_shapes[0][0].template to_static<WindowsDims>();
+    out_shape[transform_dim] = nfft_ / 2 + 1;
+    out_desc[0].shape.set_tensor_shape(i, out_shape);
+  }
+
+  // The samples are split into blocks of windows, so that a long signal is processed
+  // by all the threads instead of holding up the batch
+  int64_t total_windows = 0;
+  for (int i = 0; i < nsamples; i++)
+    total_windows += window_out_desc_[0].shape.tensor_shape_span(i)[1 - transform_dim];
+  int64_t block_windows = std::max(kMinWindowsPerBlock,
+                                   div_ceil(total_windows, nthreads * kBlocksPerThread));
+  blocks_.clear();
+  for (int i = 0; i < nsamples; i++) {
+    int64_t nwindows = window_out_desc_[0].shape.tensor_shape_span(i)[1 - transform_dim];
+    int64_t nblocks = div_ceil(nwindows, block_windows);
+    for (int64_t b = 0; b < nblocks; b++)
+      blocks_.push_back({ i, nwindows * b / nblocks, nwindows * (b + 1) / nblocks });
   }
   return true;
 }
@@ -257,19 +301,22 @@ void SpectrogramImplCpu<time_major>::RunImpl(workspace_t<CPUBackend> &ws) {
   const auto &input = ws.InputRef<CPUBackend>(0);
   auto &output = ws.OutputRef<CPUBackend>(0);
   auto out_shape = output.shape();
-  int nsamples = input.size();
   auto& thread_pool = ws.GetThreadPool();
   auto view_window_fn = make_tensor_cpu<1>(window_fn_.data(), window_length_);
   output.SetLayout(layout_);
 
-  for (int i = 0; i < nsamples; i++) {
+  for (const auto &block : blocks_) {
+    int i = block.sample;
+    int64_t nwindows = block.end - block.begin;
     thread_pool.AddWork(
-      [this, &input, &output, view_window_fn, i](int thread_id) {
+      [this, &input, &output, view_window_fn, block, i, nwindows](int thread_id) {
         kernels::KernelContext ctx;
 
+        auto win_shape = window_out_desc_[0].shape.tensor_shape<WindowsDims>(i);
+        win_shape[1 - transform_dim] = nwindows;
         auto &win_out = window_out_[thread_id];
         win_out.set_type<InputType>();
-        win_out.Resize(window_out_desc_[0].shape.tensor_shape(i));
+        win_out.Resize(win_shape);
 
         auto view_signal_1d =
             make_tensor_cpu<1>(input[i].data<const InputType>(), {input[i].size()});
@@ -278,14 +325,33 @@ void SpectrogramImplCpu<time_major>::RunImpl(workspace_t<CPUBackend> &ws) {
           view<InputType, WindowsDims>(win_out),
           view_signal_1d,
           view_window_fn,
-          window_args_);
-
-        kmgr_fft_.Run<FftKernel>(
-          thread_id, i, ctx,
-          view<OutputType, WindowsDims>(output[i]),
-          view<const InputType, WindowsDims>(win_out),
-          fft_args_);
-    }, out_shape.tensor_size(i));
+          window_args_,
+          block.begin, block.end);
+
+        auto windows = view<const InputType, WindowsDims>(win_out);
+        kmgr_fft_.Setup<FftKernel>(thread_id, ctx, windows, fft_args_);
+
+        auto out = view<OutputType, WindowsDims>(output[i]);
+        int64_t nbins = out.shape[transform_dim];
+        if (time_major) {
+          // the spectra of the block are consecutive rows of the output
+          auto rows = make_tensor_cpu<WindowsDims>(out.data + block.begin * nbins,
+                                                   { nwindows, nbins });
+          kmgr_fft_.Run<FftKernel>(thread_id, thread_id, ctx, rows, windows, fft_args_);
+        } else if (nwindows == out.shape[1]) {
+          kmgr_fft_.Run<FftKernel>(thread_id, thread_id, ctx, out, windows, fft_args_);
+        } else {
+          // the spectra are columns of the output - they're computed in a dense buffer first
+          auto &spectrum = spectrum_out_[thread_id];
+          spectrum.resize(nbins * nwindows);
+          auto cols = make_tensor_cpu<WindowsDims>(spectrum.data(), { nbins, nwindows });
+          kmgr_fft_.Run<FftKernel>(thread_id, thread_id, ctx, cols, windows, fft_args_);
+          for (int64_t b = 0; b < nbins; b++) {
+            std::copy(&spectrum[b * nwindows], &spectrum[(b + 1) * nwindows],
+                      out.data + b * out.shape[1] + block.begin);
+          }
+        }
+    }, nwindows * out_shape[i][transform_dim]);
   }
 
   thread_pool.RunAll();
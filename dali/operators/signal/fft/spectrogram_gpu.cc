@@ -35,6 +35,7 @@ struct SpectrogramOpImplGPU : public OpImplBase<GPUBackend> {
     args.window_length = spec.GetArgument<int>("window_length");
     args.window_step = spec.GetArgument<int>("window_step");
     args.nfft = spec.HasArgument("nfft") ? spec.GetArgument<int>("nfft") : args.window_length;
+    args.preemph_coeff = spec.GetArgument<float>("preemph_coeff");
     int power = spec.GetArgument<int>("power");
 
     DALI_ENFORCE(args.window_length > 0,
@@ -14,8 +14,10 @@
 
 #include "dali/operators/ssd/box_encoder.cuh"
 #include <cuda.h>
+#include <algorithm>
 #include <vector>
 #include <utility>
+#include "dali/core/util.h"
 
 namespace dali {
 __host__ __device__ inline float4 ToCenterWidthHeight(const float4 &box) {
@@ -64,22 +66,6 @@ __device__ __forceinline__ float CalculateIou(const float4 &b1, const float4 &b2
   return intersection / (area1 + area2 - intersection);
 }
 
-__device__ inline void FindBestMatch(const int N, volatile float *vals, volatile int *idx) {
-  for (unsigned int stride = blockDim.x / 2; stride > 0; stride >>= 1) {
-    if (threadIdx.x < stride) {
-      if (vals[threadIdx.x] <= vals[threadIdx.x + stride]) {
-        if (vals[threadIdx.x] == vals[threadIdx.x + stride]) {
-          idx[threadIdx.x] = cuda_max(idx[threadIdx.x], idx[threadIdx.x + stride]);
-        } else {
-          vals[threadIdx.x] = vals[threadIdx.x + stride];
-          idx[threadIdx.x] = idx[threadIdx.x + stride];
-        }
-      }
-    }
-    __syncthreads();
-  }
-}
-
 __device__ float4 MatchOffsets(
   float4 box, float4 anchor, const float *means, const float *stds, float scale) {
   box.x *= scale; box.y *= scale; box.z *= scale; box.w *= scale;
@@ -93,154 +79,134 @@ __device__ float4 MatchOffsets(
   return {x, y, z, w};
 }
 
-__device__ void WriteMatchesToOutput(
-  unsigned int anchor_count, float criteria, int *labels_out, const int *labels_in,
-  float4 *boxes_out, const float4 *boxes_in,
-  volatile int *best_box_idx, volatile float *best_box_iou, bool offset,
-  const float* means, const float* stds, float scale, const float4 *anchors_as_cwh) {
-  for (unsigned int anchor = threadIdx.x; anchor < anchor_count; anchor += blockDim.x) {
-    if (best_box_iou[anchor] > criteria) {
-      int box_idx = best_box_idx[anchor];
-      labels_out[anchor] = labels_in[box_idx];
-      float4 box = boxes_in[box_idx];
-
-      if (!offset)
-        boxes_out[anchor] = ToCenterWidthHeight(box);
-      else
-        boxes_out[anchor] = MatchOffsets(
-          ToCenterWidthHeight(box), anchors_as_cwh[anchor], means, stds, scale);
-    }
-  }
+/**
+ * @brief Packs a non-negative IoU and an anchor index into a key, such that the maximum key
+ *        refers to the best anchor and ties are resolved in favor of the higher anchor index.
+ */
+__device__ __forceinline__ uint64_t AnchorMatchKey(float iou, int anchor) {
+  return (static_cast<uint64_t>(__float_as_uint(iou)) << 32) | static_cast<uint32_t>(anchor);
 }
 
-__device__ void MatchBoxWithAnchors(
-  const float4 &box, const int box_idx, unsigned int anchor_count, const float4 *anchors,
-  volatile int *best_anchor_idx_tmp, volatile float *best_anchor_iou_tmp,
-  volatile int *best_box_idx, volatile float *best_box_iou) {
-  float best_anchor_iou = -1.0f;
-  int best_anchor_idx = -1;
-
-  for (unsigned int anchor = threadIdx.x; anchor < anchor_count; anchor += blockDim.x) {
-    float new_val = CalculateIou(box, anchors[anchor]);
-
-    if (new_val >= best_anchor_iou) {
-        best_anchor_iou = new_val;
-        best_anchor_idx = anchor;
-    }
-
-    if (new_val >= best_box_iou[anchor]) {
-        best_box_iou[anchor] = new_val;
-        best_box_idx[anchor] = box_idx;
-    }
-  }
-
-  best_anchor_iou_tmp[threadIdx.x] = best_anchor_iou;
-  best_anchor_idx_tmp[threadIdx.x] = best_anchor_idx;
+__device__ __forceinline__ uint64_t WarpMax(uint64_t key) {
+  for (int offset = 16; offset > 0; offset >>= 1)
+    key = cuda_max(key, static_cast<uint64_t>(__shfl_xor_sync(0xffffffffu, key, offset)));
+  return key;
 }
 
-template <int BLOCK_SIZE>
-__global__ void Encode(const BoxEncoderSampleDesc *samples, const int anchor_count,
-                       const float4 *anchors, const float criteria, int *box_idx_buffer,
-                       float *box_iou_buffer, bool offset, const float *means, const float *stds,
-                       float scale, const float4 *anchors_as_cwh) {
-  const int sample_idx = blockIdx.x;
-  const auto &sample = samples[sample_idx];
-
-  // Remark: This algorithm is very fragile to floating point arithmetic effects.
-  // For now, excessive use of volatile in this code,
-  // makes it conform to reference solution in terms of resulting encoding.
-
-  __shared__ volatile int best_anchor_idx_tmp[BLOCK_SIZE];
-  __shared__ volatile float best_anchor_iou_tmp[BLOCK_SIZE];
-
-  volatile int *best_box_idx = box_idx_buffer + sample_idx * anchor_count;
-  volatile float *best_box_iou = box_iou_buffer + sample_idx * anchor_count;
-
-  for (int box_idx = 0; box_idx < sample.in_box_count; ++box_idx) {
-    MatchBoxWithAnchors(
-      sample.boxes_in[box_idx],
-      box_idx,
-      anchor_count,
-      anchors,
-      best_anchor_idx_tmp,
-      best_anchor_iou_tmp,
-      best_box_idx,
-      best_box_iou);
-
+/**
+ * @brief Computes a tile of the box-anchor IoU matrix and reduces it in both directions
+ *
+ * Each block processes `BLOCK_SIZE` anchors of one sample (blockIdx.y); the boxes are staged in
+ * shared memory in tiles of `BOX_TILE`. For each anchor, the box with the highest IoU
+ * is stored in `anchor_box_idx` and `anchor_box_iou` (ties go to the later box).
+ * For each box, the best anchor is accumulated with atomicMax in `box_best_anchor`,
+ * as a key produced by `AnchorMatchKey`.
+ */
+template <int BLOCK_SIZE, int BOX_TILE>
+__global__ void MatchAnchorsKernel(const BoxEncoderSampleDesc *samples, int anchor_count,
+                                   const float4 *anchors, int *anchor_box_idx,
+                                   float *anchor_box_iou, uint64_t *box_best_anchor) {
+  static_assert(BOX_TILE <= BLOCK_SIZE, "Each thread loads at most one box of a tile");
+  constexpr int kWarps = BLOCK_SIZE / 32;
+  const auto &sample = samples[blockIdx.y];
+  const int anchor = blockIdx.x * BLOCK_SIZE + threadIdx.x;
+  const bool valid = anchor < anchor_count;
+  const int warp = threadIdx.x / 32;
+  const int lane = threadIdx.x % 32;
+
+  __shared__ float4 boxes[BOX_TILE];
+  __shared__ uint64_t warp_keys[kWarps][BOX_TILE];
+
+  float4 anchor_box = valid ? anchors[anchor] : float4{0, 0, 0, 0};
+  float best_iou = 0.0f;
+  int best_idx = 0;
+
+  for (int tile_start = 0; tile_start < sample.in_box_count; tile_start += BOX_TILE) {
+    int tile_len = cuda_min(BOX_TILE, sample.in_box_count - tile_start);
+    __syncthreads();  // the previous tile is no longer used
+    if (threadIdx.x < tile_len)
+      boxes[threadIdx.x] = sample.boxes_in[tile_start + threadIdx.x];
     __syncthreads();
 
-    FindBestMatch(blockDim.x, best_anchor_iou_tmp, best_anchor_idx_tmp);
+    for (int i = 0; i < tile_len; i++) {
+      uint64_t key = 0;
+      if (valid) {
+        float iou = CalculateIou(boxes[i], anchor_box);
+        if (iou >= best_iou) {
+          best_iou = iou;
+          best_idx = tile_start + i;
+        }
+        if (iou >= 0)  // skip NaNs
+          key = AnchorMatchKey(iou, anchor);
+      }
+      key = WarpMax(key);
+      if (lane == 0)
+        warp_keys[warp][i] = key;
+    }
     __syncthreads();
 
-    if (threadIdx.x == 0) {
-      int idx = best_anchor_idx_tmp[0];
-      best_box_idx[idx] = box_idx;
-      best_box_iou[idx] = 2.f;
+    if (threadIdx.x < tile_len) {
+      uint64_t key = warp_keys[0][threadIdx.x];
+      for (int w = 1; w < kWarps; w++)
+        key = cuda_max(key, warp_keys[w][threadIdx.x]);
+      atomicMax(reinterpret_cast<unsigned long long *>(  // NOLINT
+                  box_best_anchor + sample.box_offset + tile_start + threadIdx.x),
+                static_cast<unsigned long long>(key));  // NOLINT
     }
-    __syncthreads();
   }
-  __syncthreads();
-
-  WriteMatchesToOutput(
-    anchor_count,
-    criteria,
-    sample.labels_out,
-    sample.labels_in,
-    sample.boxes_out,
-    sample.boxes_in,
-    best_box_idx,
-    best_box_iou,
-    offset,
-    means,
-    stds,
-    scale,
-    anchors_as_cwh);
-}
-
-std::pair<int *, float *> BoxEncoder<GPUBackend>::ClearBuffers(const cudaStream_t &stream) {
-  auto best_box_idx_data = best_box_idx_.mutable_data<int>();
-  auto best_box_iou_data = best_box_iou_.mutable_data<float>();
-
-  CUDA_CALL(cudaMemsetAsync(
-    best_box_idx_data, 0, curr_batch_size_ * anchor_count_ * sizeof(int), stream));
-  CUDA_CALL(cudaMemsetAsync(
-    best_box_iou_data, 0, curr_batch_size_ * anchor_count_ * sizeof(float), stream));
-
-  return {best_box_idx_data, best_box_iou_data};
-}
 
-void BoxEncoder<GPUBackend>::ClearLabels(TensorList<GPUBackend> &labels_out,
-                                         const cudaStream_t &stream) {
-  for (int sample = 0; sample < curr_batch_size_; ++sample) {
-    CUDA_CALL(cudaMemsetAsync(labels_out.mutable_tensor<int>(sample), 0,
-                              anchor_count_ * sizeof(int), stream));
+  if (valid) {
+    int64_t offset = static_cast<int64_t>(blockIdx.y) * anchor_count + anchor;
+    anchor_box_idx[offset] = best_idx;
+    anchor_box_iou[offset] = best_iou;
   }
 }
 
-void BoxEncoder<GPUBackend>::WriteAnchorsToOutput(TensorList<GPUBackend> &boxes_out,
-                                                  const cudaStream_t &stream) {
-  if (!curr_batch_size_)
+/**
+ * @brief Assigns each box to its best anchor, regardless of the IoU
+ *
+ * The forced match is stored in `anchor_box_idx` as `-2 - box_idx`; when several boxes
+ * pick the same anchor, the last box wins.
+ */
+__global__ void ForceMatchesKernel(const BoxEncoderSampleDesc *samples, int anchor_count,
+                                   int *anchor_box_idx, const uint64_t *box_best_anchor) {
+  const auto &sample = samples[blockIdx.y];
+  int box_idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (box_idx >= sample.in_box_count)
     return;
-  const auto *anchors_to_copy = anchors_as_center_wh_.data<float>();
-  auto *first_sample_boxes_out = boxes_out.mutable_tensor<float>(0);
-  // Host -> device copy of anchors for first sample
-  MemCopy(first_sample_boxes_out, anchors_to_copy,
-          anchor_count_ * BoundingBox::size * sizeof(float), stream);
-  // Device -> device copy for the rest
-  for (int sample = 1; sample < curr_batch_size_; ++sample) {
-    auto *boxes_out_data = boxes_out.mutable_tensor<float>(sample);
-    MemCopy(boxes_out_data, first_sample_boxes_out,
-            anchor_count_ * BoundingBox::size * sizeof(float), stream);
-  }
+  int anchor = static_cast<uint32_t>(box_best_anchor[sample.box_offset + box_idx]);
+  int64_t offset = static_cast<int64_t>(blockIdx.y) * anchor_count + anchor;
+  atomicMin(anchor_box_idx + offset, -2 - box_idx);
 }
 
-void BoxEncoder<GPUBackend>::ClearOutput(TensorList<GPUBackend> &boxes_out,
-                                         const cudaStream_t &stream) {
-  for (int sample = 0; sample < curr_batch_size_; ++sample) {
-    auto *boxes_out_data = boxes_out.mutable_tensor<float>(sample);
-    CUDA_CALL(cudaMemsetAsync(boxes_out_data, 0, anchor_count_ * BoundingBox::size * sizeof(float),
-                              stream));
+/**
+ * @brief Writes the encoded boxes and labels for all anchors, including the unmatched ones
+ */
+__global__ void WriteOutputKernel(const BoxEncoderSampleDesc *samples, int anchor_count,
+                                  float criteria, const int *anchor_box_idx,
+                                  const float *anchor_box_iou, bool offset, const float *means,
+                                  const float *stds, float scale, const float4 *anchors_as_cwh) {
+  const auto &sample = samples[blockIdx.y];
+  int anchor = blockIdx.x * blockDim.x + threadIdx.x;
+  if (anchor >= anchor_count)
+    return;
+  int64_t buf_offset = static_cast<int64_t>(blockIdx.y) * anchor_count + anchor;
+  int box_idx = anchor_box_idx[buf_offset];
+  bool matched = box_idx < 0 || anchor_box_iou[buf_offset] > criteria;
+  if (!matched) {
+    sample.labels_out[anchor] = 0;
+    sample.boxes_out[anchor] = offset ? float4{0, 0, 0, 0} : anchors_as_cwh[anchor];
+    return;
   }
+  if (box_idx < 0)
+    box_idx = -2 - box_idx;
+  sample.labels_out[anchor] = sample.labels_in[box_idx];
+  float4 box = sample.boxes_in[box_idx];
+  if (!offset)
+    sample.boxes_out[anchor] = ToCenterWidthHeight(box);
+  else
+    sample.boxes_out[anchor] = MatchOffsets(
+      ToCenterWidthHeight(box), anchors_as_cwh[anchor], means, stds, scale);
 }
 
 std::pair<TensorListShape<>, TensorListShape<>>
@@ -262,14 +228,11 @@ void BoxEncoder<GPUBackend>::RunImpl(Workspace<GPUBackend> &ws) {
   const auto &boxes_input = ws.Input<GPUBackend>(kBoxesInId);
   const auto &labels_input = ws.Input<GPUBackend>(kLabelsInId);
   assert(ws.GetInputBatchSize(kBoxesInId) == ws.GetInputBatchSize(kLabelsInId));
-  auto curr_batch_size = ws.GetInputBatchSize(kBoxesInId);
 
   const auto anchors_data = reinterpret_cast<const float4 *>(anchors_.data<float>());
   const auto anchors_as_cwh_data =
     reinterpret_cast<const float4 *>(anchors_as_center_wh_.data<float>());
 
-  const auto buffers = ClearBuffers(ws.stream());
-
   auto dims = CalculateDims(boxes_input);
 
   auto &boxes_output = ws.Output<GPUBackend>(kBoxesOutId);
@@ -281,6 +244,8 @@ void BoxEncoder<GPUBackend>::RunImpl(Workspace<GPUBackend> &ws) {
   labels_output.Resize(dims.second);
 
   samples.resize(curr_batch_size_);
+  int total_box_count = 0;
+  int max_box_count = 0;
   for (int sample_idx = 0; sample_idx < curr_batch_size_; sample_idx++) {
     auto &sample = samples[sample_idx];
     sample.boxes_out = reinterpret_cast<float4 *>(boxes_output.mutable_tensor<float>(sample_idx));
@@ -288,32 +253,59 @@ void BoxEncoder<GPUBackend>::RunImpl(Workspace<GPUBackend> &ws) {
     sample.boxes_in = reinterpret_cast<const float4 *>(boxes_input.tensor<float>(sample_idx));
     sample.labels_in = labels_input.tensor<int>(sample_idx);
     sample.in_box_count = boxes_input.shape().tensor_shape_span(sample_idx)[0];
+    sample.box_offset = total_box_count;
+    total_box_count += sample.in_box_count;
+    max_box_count = std::max(max_box_count, sample.in_box_count);
   }
 
+  if (curr_batch_size_ == 0 || anchor_count_ == 0)
+    return;
+
   const auto means_data = means_.data<float>();
   const auto stds_data = stds_.data<float>();
 
-  ClearLabels(labels_output, ws.stream());
-
-  if (!offset_)
-    WriteAnchorsToOutput(boxes_output, ws.stream());
-  else
-    ClearOutput(boxes_output, ws.stream());
+  auto stream = ws.stream();
+  samples_dev.from_host(samples, stream);
+  box_best_anchor_.resize(total_box_count, stream);
+  if (total_box_count > 0)
+    CUDA_CALL(cudaMemsetAsync(box_best_anchor_.data(), 0,
+                              total_box_count * sizeof(uint64_t), stream));
 
-  samples_dev.from_host(samples, ws.stream());
+  auto *anchor_box_idx = best_box_idx_.mutable_data<int>();
+  auto *anchor_box_iou = best_box_iou_.mutable_data<float>();
 
-  Encode<BlockSize><<<curr_batch_size, BlockSize, 0, ws.stream()>>>(
+  dim3 anchor_grid(div_ceil(anchor_count_, BlockSize), curr_batch_size_);
+  MatchAnchorsKernel<BlockSize, kBoxTile><<<anchor_grid, BlockSize, 0, stream>>>(
     samples_dev.data(),
     anchor_count_,
     anchors_data,
+    anchor_box_idx,
+    anchor_box_iou,
+    box_best_anchor_.data());
+  CUDA_CALL(cudaGetLastError());
+
+  if (max_box_count > 0) {
+    dim3 box_grid(div_ceil(max_box_count, BlockSize), curr_batch_size_);
+    ForceMatchesKernel<<<box_grid, BlockSize, 0, stream>>>(
+      samples_dev.data(),
+      anchor_count_,
+      anchor_box_idx,
+      box_best_anchor_.data());
+    CUDA_CALL(cudaGetLastError());
+  }
+
+  WriteOutputKernel<<<anchor_grid, BlockSize, 0, stream>>>(
+    samples_dev.data(),
+    anchor_count_,
     criteria_,
-    buffers.first,
-    buffers.second,
+    anchor_box_idx,
+    anchor_box_iou,
     offset_,
     means_data,
     stds_data,
     scale_,
     anchors_as_cwh_data);
+  CUDA_CALL(cudaGetLastError());
 }
 
 DALI_REGISTER_OPERATOR(BoxEncoder, BoxEncoder<GPUBackend>, GPU);
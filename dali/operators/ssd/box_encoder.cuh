@@ -31,12 +31,14 @@ struct BoxEncoderSampleDesc {
   const float4 *boxes_in;
   const int *labels_in;
   int in_box_count;
+  int box_offset;  // index of the first box of this sample in the whole batch
 };
 
 template <>
 class BoxEncoder<GPUBackend> : public Operator<GPUBackend> {
  public:
   static constexpr int BlockSize = 256;
+  static constexpr int kBoxTile = 64;
   using BoundingBox = Box<2, float>;
 
   explicit BoxEncoder(const OpSpec &spec)
@@ -98,22 +100,15 @@ class BoxEncoder<GPUBackend> : public Operator<GPUBackend> {
 
   std::vector<BoxEncoderSampleDesc> samples;
   DeviceBuffer<BoxEncoderSampleDesc> samples_dev;
+  DeviceBuffer<uint64_t> box_best_anchor_;
 
   bool offset_;
   Tensor<GPUBackend> means_;
   Tensor<GPUBackend> stds_;
   float scale_;
 
-  std::pair<int*, float*> ClearBuffers(const cudaStream_t &stream);
-
   void PrepareAnchors(const vector<float> &anchors);
 
-  void ClearLabels(TensorList<GPUBackend> &labels_out, const cudaStream_t &stream);
-
-  void WriteAnchorsToOutput(TensorList<GPUBackend> &boxes_out, const cudaStream_t &stream);
-
-  void ClearOutput(TensorList<GPUBackend> &boxes_out, const cudaStream_t &stream);
-
   std::pair<TensorListShape<>, TensorListShape<>> CalculateDims(
     const TensorList<GPUBackend> &boxes_input);
 
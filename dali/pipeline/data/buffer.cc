@@ -14,6 +14,7 @@
 
 #include "dali/pipeline/data/buffer.h"
 #include "dali/pipeline/data/backend.h"
+#include "dali/core/mm/cuda_vm_growable_buffer.h"
 #include "dali/core/mm/memory.h"
 
 namespace dali {
@@ -36,4 +37,41 @@ DLL_PUBLIC shared_ptr<uint8_t> AllocBuffer(size_t bytes, bool pinned, CPUBackend
     return mm::alloc_raw_shared<uint8_t, mm::memory_kind::host>(bytes, kHostAlignment);
 }
 
+#if DALI_USE_CUDA_VM_MAP
+
+class GrowableDeviceMemory : public mm::cuda_vm_growable_buffer {
+ public:
+  using mm::cuda_vm_growable_buffer::cuda_vm_growable_buffer;
+};
+
+DLL_PUBLIC shared_ptr<GrowableDeviceMemory>
+CreateGrowableDeviceMemory(size_t bytes, size_t reservation, int device) {
+  if (!mm::cuvm::IsSupported() || bytes < mm::cuvm::GetAddressGranularity())
+    return nullptr;
+  return std::make_shared<GrowableDeviceMemory>(reservation, device);
+}
+
+DLL_PUBLIC shared_ptr<uint8_t>
+GrowDeviceMemory(const shared_ptr<GrowableDeviceMemory> &mem, size_t bytes, int device) {
+  if (!mem || mem->device_id() != device || !mem->reserve(bytes))
+    return nullptr;
+  return shared_ptr<uint8_t>(mem, static_cast<uint8_t *>(mem->data()));
+}
+
+#else  // DALI_USE_CUDA_VM_MAP
+
+class GrowableDeviceMemory {};
+
+DLL_PUBLIC shared_ptr<GrowableDeviceMemory>
+CreateGrowableDeviceMemory(size_t, size_t, int) {
+  return nullptr;
+}
+
+DLL_PUBLIC shared_ptr<uint8_t>
+GrowDeviceMemory(const shared_ptr<GrowableDeviceMemory> &, size_t, int) {
+  return nullptr;
+}
+
+#endif  // DALI_USE_CUDA_VM_MAP
+
 }  // namespace dali
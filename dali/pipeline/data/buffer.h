@@ -15,6 +15,7 @@
 #ifndef DALI_PIPELINE_DATA_BUFFER_H_
 #define DALI_PIPELINE_DATA_BUFFER_H_
 
+#include <algorithm>
 #include <functional>
 #include <limits>
 #include <memory>
@@ -43,6 +44,34 @@ inline shared_ptr<uint8_t> AllocBuffer(size_t bytes, bool pinned) {
   return AllocBuffer(bytes, pinned, static_cast<Backend*>(nullptr));
 }
 
+/**
+ * @brief Device memory in a reserved virtual address range, which can grow in place.
+ *
+ * Defined in buffer.cc - it's usable only if CUDA virtual memory management is supported.
+ */
+class GrowableDeviceMemory;
+
+/**
+ * @brief Creates a growable device memory block with a virtual address range of `reservation` bytes
+ *
+ * @return The memory block or null, if the virtual memory management is not supported
+ *         or the requested size is smaller than the allocation granularity, in which case
+ *         a regular allocation should be used.
+ */
+DLL_PUBLIC shared_ptr<GrowableDeviceMemory>
+CreateGrowableDeviceMemory(size_t bytes, size_t reservation, int device);
+
+/**
+ * @brief Makes at least `bytes` of a growable memory block usable, keeping its address
+ *        and contents.
+ *
+ * @return A pointer to the beginning of the memory block, sharing the ownership with `mem`,
+ *         or null if `bytes` exceeds the reservation or the memory is located on a different
+ *         device.
+ */
+DLL_PUBLIC shared_ptr<uint8_t>
+GrowDeviceMemory(const shared_ptr<GrowableDeviceMemory> &mem, size_t bytes, int device);
+
 // Helper function to get a string of the data shape
 inline string ShapeString(vector<Index> shape) {
   string tmp;
@@ -286,7 +315,8 @@ class DLL_PUBLIC Buffer {
   }
 
   inline void reserve(size_t new_num_bytes) {
-    if (new_num_bytes <= num_bytes_) return;
+    // a detached allocation is not reused; it doesn't apply to the memory we don't own
+    if (new_num_bytes <= num_bytes_ && !(detached_ && !shares_data_)) return;
 
     // re-allocating: get the device
     if (std::is_same<Backend, GPUBackend>::value) {
@@ -299,8 +329,16 @@ class DLL_PUBLIC Buffer {
                  "Cannot reallocate Buffer if it is sharing data. "
                  "Clear the status by `Reset()` first.");
     data_.reset();
-    data_ = allocate_ ? allocate_(new_num_bytes)
-                      : AllocBuffer<Backend>(new_num_bytes, pinned_);
+    if (detached_) {
+      // the detached memory may be a part of the reserved range
+      growable_.reset();
+      detached_ = false;
+    }
+    if (!allocate_ && std::is_same<Backend, GPUBackend>::value && vm_reservation_ > 0)
+      data_ = AllocGrowable(new_num_bytes);
+    if (!data_)
+      data_ = allocate_ ? allocate_(new_num_bytes)
+                        : AllocBuffer<Backend>(new_num_bytes, pinned_);
 
     num_bytes_ = new_num_bytes;
   }
@@ -308,9 +346,11 @@ class DLL_PUBLIC Buffer {
   void reset() {
     type_ = {};
     data_.reset();
+    growable_.reset();
     allocate_ = {};
     size_ = 0;
     shares_data_ = false;
+    detached_ = false;
     num_bytes_ = 0;
     device_ =  CPU_ONLY_DEVICE_ID;
   }
@@ -322,6 +362,37 @@ class DLL_PUBLIC Buffer {
     return shares_data_;
   }
 
+  /**
+   * @brief Returns the pointer to the underlying storage, which keeps it alive
+   *
+   * Used to share the data without copying; the storage of a buffer that doesn't share data
+   * can be overwritten when the buffer is reused.
+   */
+  inline const shared_ptr<void> &get_data_ptr() const {
+    return data_;
+  }
+
+  /**
+   * @brief Returns the allocation and makes the buffer stop reusing it
+   *
+   * The buffer still refers to the same data, but the next resize allocates new memory,
+   * even if the current allocation is large enough. It allows handing out the memory to an
+   * owner with independent lifetime, without copying the data and without waiting for that
+   * owner before the buffer is written to again.
+   */
+  shared_ptr<void> detach_data() {
+    DALI_ENFORCE(!shares_data_, "Cannot detach the data of a buffer which doesn't own it.");
+    detached_ = true;
+    return data_;
+  }
+
+  /**
+   * @brief Returns true, if the data was detached and a new allocation wasn't made yet.
+   */
+  inline bool is_detached() const {
+    return detached_;
+  }
+
   DISABLE_COPY_MOVE_ASSIGN(Buffer);
 
   static void SetGrowthFactor(double factor) {
@@ -339,6 +410,24 @@ class DLL_PUBLIC Buffer {
     return shrink_threshold_;
   }
 
+  /**
+   * @brief Sets the size of the virtual address range reserved by GPU buffers
+   *
+   * When nonzero, a GPU buffer reserves (at least) this many bytes of virtual address space
+   * on the first large allocation and maps physical memory to it as it grows. The growth
+   * doesn't reallocate nor copy the data and only the memory that's used is backed by physical
+   * storage. If the buffer outgrows the range, a new one is reserved.
+   *
+   * It's ignored for CPU buffers, buffers with a custom allocation function and if the
+   * CUDA virtual memory management is not supported.
+   */
+  static void SetVirtualReservation(size_t bytes) {
+    vm_reservation_ = bytes;
+  }
+  static size_t GetVirtualReservation() {
+    return vm_reservation_;
+  }
+
   static constexpr double kMaxGrowthFactor = 4;
 
  protected:
@@ -374,6 +463,14 @@ class DLL_PUBLIC Buffer {
     if (shares_data_)
       return;
 
+    if (detached_) {
+      // the memory is owned by the consumer of the detached data now
+      data_.reset();
+      growable_.reset();
+      num_bytes_ = 0;
+      detached_ = false;
+    }
+
     if (new_size == 0) {
       if (std::is_same<Backend, GPUBackend>::value && device_ == CPU_ONLY_DEVICE_ID) {
         CUDA_CALL(cudaGetDevice(&device_));
@@ -396,14 +493,31 @@ class DLL_PUBLIC Buffer {
     }
   }
 
+  /**
+   * @brief Grows the virtual memory range of the buffer or reserves a new one
+   *
+   * @return The allocation or null, if the growable memory can't be used
+   */
+  shared_ptr<uint8_t> AllocGrowable(size_t bytes) {
+    if (growable_) {
+      if (auto mem = GrowDeviceMemory(growable_, bytes, device_))
+        return mem;
+      growable_.reset();
+    }
+    growable_ = CreateGrowableDeviceMemory(bytes, std::max(bytes, vm_reservation_), device_);
+    return growable_ ? GrowDeviceMemory(growable_, bytes, device_) : nullptr;
+  }
+
   void move_buffer(Buffer &&buffer) {
     type_         = std::move(buffer.type_);
     data_         = std::move(buffer.data_);
+    growable_     = std::move(buffer.growable_);
     allocate_     = std::move(buffer.allocate_);
     size_         = buffer.size_;
     num_bytes_    = buffer.num_bytes_;
     device_       = buffer.device_;
     shares_data_  = buffer.shares_data_;
+    detached_     = buffer.detached_;
     pinned_       = buffer.pinned_;
 
     buffer.reset();
@@ -411,14 +525,17 @@ class DLL_PUBLIC Buffer {
 
   static double growth_factor_;
   static double shrink_threshold_;
+  static size_t vm_reservation_;
 
   TypeInfo type_ = {};               // Data type of underlying storage
   shared_ptr<void> data_ = nullptr;  // Pointer to underlying storage
   AllocFunc allocate_;               // Custom allocation function
+  shared_ptr<GrowableDeviceMemory> growable_;  // Reserved virtual memory range, if used
   Index size_ = 0;                   // The number of elements in the buffer
   size_t num_bytes_ = 0;             // To keep track of the true size of the underlying allocation
   int device_ = CPU_ONLY_DEVICE_ID;  // device the buffer was allocated on
   bool shares_data_ = false;         // Whether we aren't using our own allocation
+  bool detached_ = false;            // Whether the allocation was handed out by detach_data
   bool pinned_ = true;               // Whether the allocation uses pinned memory
 };
 
@@ -429,6 +546,9 @@ template <typename Backend>
 DLL_PUBLIC double Buffer<Backend>::shrink_threshold_ =
   std::is_same<Backend, CPUBackend>::value ? 0.9 : 0;
 
+template <typename Backend>
+DLL_PUBLIC size_t Buffer<Backend>::vm_reservation_ = 0;
+
 template <typename Backend>
 DLL_PUBLIC constexpr double Buffer<Backend>::kMaxGrowthFactor;
 
@@ -16,9 +16,12 @@
 #define DALI_PIPELINE_DATA_COPY_TO_EXTERNAL_H_
 
 #include <cuda_runtime.h>
+#include <algorithm>
 #include "dali/core/static_switch.h"
+#include "dali/core/util.h"
 #include "dali/pipeline/data/buffer.h"
 #include "dali/pipeline/data/types.h"
+#include "dali/pipeline/util/thread_pool.h"
 #include "dali/core/mm/memory_kind.h"
 
 namespace dali {
@@ -40,6 +43,57 @@ struct kind2backend<mm::memory_kind::managed> {
   using type = GPUBackend;
 };
 
+/// Host copies smaller than this are done on the calling thread
+constexpr int64_t kMinParallelHostCopySize = 1 << 20;
+/// Minimum size of a job of the parallel host copy
+constexpr int64_t kMinHostCopyJobSize = 1 << 16;
+
+/**
+ * @brief Copies `n` host samples of `sizes[i]` elements with the threads of `tp`
+ *
+ * The batch is cut into jobs of similar size, regardless of the sample boundaries, so that
+ * many small samples don't produce a job each and a single large sample still uses all
+ * the threads. Small batches are copied on the calling thread.
+ */
+inline void ParallelHostCopy(void **dsts, const void **srcs, const int64_t *sizes, int n,
+                             const TypeInfo &type_info, ThreadPool &tp) {
+  SmallVector<int64_t, 256> offsets;
+  offsets.resize(n + 1);
+  offsets[0] = 0;
+  for (int i = 0; i < n; i++)
+    offsets[i + 1] = offsets[i] + sizes[i];
+  int64_t total = offsets[n];
+  int64_t element_size = type_info.size();
+
+  if (total * element_size < kMinParallelHostCopySize || tp.NumThreads() < 2) {
+    for (int i = 0; i < n; i++)
+      type_info.Copy<CPUBackend, CPUBackend>(dsts[i], srcs[i], sizes[i], 0);
+    return;
+  }
+
+  // a few jobs per thread, to even out the imbalance between the threads
+  int64_t job_size = std::max(div_ceil(total, 4 * tp.NumThreads()),
+                              div_ceil(kMinHostCopyJobSize, element_size));
+  for (int64_t begin = 0; begin < total; begin += job_size) {
+    int64_t end = std::min(begin + job_size, total);
+    tp.AddWork([&, begin, end](int) {
+      // the last sample starting at or before `begin` - this skips the empty samples
+      int i = std::upper_bound(offsets.begin(), offsets.end(), begin) - offsets.begin() - 1;
+      for (int64_t pos = begin; pos < end; i++) {
+        int64_t count = std::min(offsets[i + 1], end) - pos;
+        if (count <= 0)
+          continue;
+        int64_t sample_offset = (pos - offsets[i]) * element_size;
+        auto *dst = static_cast<uint8_t *>(dsts[i]) + sample_offset;
+        auto *src = static_cast<const uint8_t *>(srcs[i]) + sample_offset;
+        type_info.Copy<CPUBackend, CPUBackend>(dst, src, count, 0);
+        pos += count;
+      }
+    });
+  }
+  tp.RunAll();
+}
+
 }  // namespace detail
 
 template <typename DstBackend, typename SrcBackend>
@@ -55,9 +109,32 @@ inline void CopyToExternalImpl(void* dst,
 template <typename DstBackend, typename SrcBackend>
 inline void CopyToExternalImpl(void* dst,
                                const TensorList<SrcBackend> &src,
-                               cudaStream_t stream, bool use_copy_kernel) {
+                               cudaStream_t stream, bool use_copy_kernel,
+                               ThreadPool *tp = nullptr) {
   DeviceGuard d(src.device_id());
   const auto &type_info = src.type_info();
+  constexpr bool is_host_to_host = std::is_same<DstBackend, CPUBackend>::value &&
+                                   std::is_same<SrcBackend, CPUBackend>::value;
+
+  if (is_host_to_host && tp) {
+    const auto &src_shape = src.shape();
+    int num_samples = src_shape.num_samples();
+    SmallVector<const void *, 256> from;
+    SmallVector<void *, 256> to;
+    SmallVector<int64_t, 256> sizes;
+    from.reserve(num_samples);
+    to.reserve(num_samples);
+    sizes.reserve(num_samples);
+    auto *sample_dst = static_cast<uint8_t *>(dst);
+    for (int i = 0; i < num_samples; i++) {
+      from.push_back(src.raw_tensor(i));
+      to.push_back(sample_dst);
+      sizes.push_back(src_shape.tensor_size(i));
+      sample_dst += sizes.back() * type_info.size();
+    }
+    detail::ParallelHostCopy(to.data(), from.data(), sizes.data(), num_samples, type_info, *tp);
+    return;
+  }
 
   // TODO(klecki): Add a proper test for non-contiguous access when we can have non-contiguous
   // data here.
@@ -84,11 +161,14 @@ inline void CopyToExternalImpl(void* dst,
 template <typename DstBackend, typename SrcBackend>
 inline void CopyToExternalImpl(void** dsts,
                                const TensorList<SrcBackend> &src,
-                               cudaStream_t stream, bool use_copy_kernel) {
+                               cudaStream_t stream, bool use_copy_kernel,
+                               ThreadPool *tp = nullptr) {
   DeviceGuard d(src.device_id());
 
   const auto &type_info = src.type_info();
   const auto &src_shape = src.shape();
+  constexpr bool is_host_to_host = std::is_same<DstBackend, CPUBackend>::value &&
+                                   std::is_same<SrcBackend, CPUBackend>::value;
 
   SmallVector<int64_t, 256> sizes;
   int num_samples = src_shape.num_samples();
@@ -100,7 +180,7 @@ inline void CopyToExternalImpl(void** dsts,
   }
   int samples_to_copy = sizes.size();
 
-  if (src.IsContiguous() && samples_to_copy == num_samples) {
+  if (!(is_host_to_host && tp) && src.IsContiguous() && samples_to_copy == num_samples) {
     type_info.template Copy<DstBackend, SrcBackend>(dsts, unsafe_raw_data(src), sizes.data(),
                                                     num_samples, stream, use_copy_kernel);
 
@@ -116,8 +196,13 @@ inline void CopyToExternalImpl(void** dsts,
       to.push_back(dsts[i]);
     }
 
-    type_info.template Copy<DstBackend, SrcBackend>(to.data(), from.data(), sizes.data(),
-                                                    samples_to_copy, stream, use_copy_kernel);
+    if (is_host_to_host && tp) {
+      detail::ParallelHostCopy(to.data(), from.data(), sizes.data(), samples_to_copy, type_info,
+                               *tp);
+    } else {
+      type_info.template Copy<DstBackend, SrcBackend>(to.data(), from.data(), sizes.data(),
+                                                      samples_to_copy, stream, use_copy_kernel);
+    }
   }
 }
 
@@ -133,12 +218,13 @@ inline void CopyToExternal(void* dst, const Tensor<SrcBackend> &src,
 
 template <typename DstKind, typename SrcBackend>
 inline void CopyToExternal(void* dst, const TensorList<SrcBackend> &src,
-                           cudaStream_t stream, bool use_copy_kernel) {
+                           cudaStream_t stream, bool use_copy_kernel,
+                           ThreadPool *tp = nullptr) {
   bool src_device_access = (std::is_same<SrcBackend, GPUBackend>::value || src.is_pinned());
   bool dst_device_access = cuda::kind_has_property<DstKind, cuda::memory_access::device>::value;
   use_copy_kernel &= dst_device_access && src_device_access;
   using DstBackend = typename detail::kind2backend<DstKind>::type;
-  CopyToExternalImpl<DstBackend, SrcBackend>(dst, src, stream, use_copy_kernel);
+  CopyToExternalImpl<DstBackend, SrcBackend>(dst, src, stream, use_copy_kernel, tp);
 }
 
 /**
@@ -155,39 +241,49 @@ inline void CopyToExternal(void* dst, mm::memory_kind_id kind_id, const Tensor<S
     (throw std::logic_error("Unreachable code - invalid memory kind.")));
 }
 
+/**
+ * @brief Run-time dispatch - DO NOT USE unless really necessary
+ *
+ * If `tp` is given, the copies from host to host memory are split between its threads.
+ */
 template <typename SrcBackend>
 inline void CopyToExternal(void* dst, mm::memory_kind_id kind_id, const TensorList<SrcBackend> &src,
-                           cudaStream_t stream, bool use_copy_kernel) {
+                           cudaStream_t stream, bool use_copy_kernel,
+                           ThreadPool *tp = nullptr) {
   TYPE_SWITCH(kind_id, mm::kind2id, Kind, (mm::memory_kind::host,
                                            mm::memory_kind::pinned,
                                            mm::memory_kind::device,
                                            mm::memory_kind::managed),
-    (CopyToExternal<Kind, SrcBackend>(dst, src, stream, use_copy_kernel)),
+    (CopyToExternal<Kind, SrcBackend>(dst, src, stream, use_copy_kernel, tp)),
     (throw std::logic_error("Unreachable code - invalid memory kind.")));
 }
 
 template <typename DstKind, typename SrcBackend>
 inline void CopyToExternal(void** dsts, const TensorList<SrcBackend> &src,
-                           cudaStream_t stream, bool use_copy_kernel) {
+                           cudaStream_t stream, bool use_copy_kernel,
+                           ThreadPool *tp = nullptr) {
   bool src_device_access = (std::is_same<SrcBackend, GPUBackend>::value || src.is_pinned());
   bool dst_device_access = cuda::kind_has_property<DstKind, cuda::memory_access::device>::value;
   use_copy_kernel &= dst_device_access && src_device_access;
   using DstBackend = typename detail::kind2backend<DstKind>::type;
-  CopyToExternalImpl<DstBackend, SrcBackend>(dsts, src, stream, use_copy_kernel);
+  CopyToExternalImpl<DstBackend, SrcBackend>(dsts, src, stream, use_copy_kernel, tp);
 }
 
 /**
  * @brief Run-time dispatch - DO NOT USE unless really necessary
+ *
+ * If `tp` is given, the copies from host to host memory are split between its threads.
  */
 template <typename SrcBackend>
 inline void CopyToExternal(void** dsts, mm::memory_kind_id kind_id,
                            const TensorList<SrcBackend> &src,
-                           cudaStream_t stream, bool use_copy_kernel) {
+                           cudaStream_t stream, bool use_copy_kernel,
+                           ThreadPool *tp = nullptr) {
   TYPE_SWITCH(kind_id, mm::kind2id, Kind, (mm::memory_kind::host,
                                            mm::memory_kind::pinned,
                                            mm::memory_kind::device,
                                            mm::memory_kind::managed),
-    (CopyToExternal<Kind, SrcBackend>(dsts, src, stream, use_copy_kernel)),
+    (CopyToExternal<Kind, SrcBackend>(dsts, src, stream, use_copy_kernel, tp)),
     (throw std::logic_error("Unreachable code - invalid memory kind.")));
 }
 
@@ -0,0 +1,77 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/pipeline/data/copy_to_external.h"
+#include <gtest/gtest.h>
+#include <numeric>
+#include <random>
+#include <vector>
+#include "dali/pipeline/data/tensor_list.h"
+
+namespace dali {
+
+namespace {
+
+void TestCopyToExternalHost(const TensorListShape<> &shape, bool skip_odd) {
+  ThreadPool tp(4, CPU_ONLY_DEVICE_ID, false);
+  TensorList<CPUBackend> src;
+  src.Resize(shape, DALI_INT32);
+  int32_t value = 0;
+  for (int i = 0; i < shape.num_samples(); i++) {
+    auto *data = src.mutable_tensor<int32_t>(i);
+    for (int64_t j = 0; j < shape.tensor_size(i); j++)
+      data[j] = value++;
+  }
+
+  std::vector<std::vector<int32_t>> dst(shape.num_samples());
+  std::vector<void *> dsts(shape.num_samples());
+  for (int i = 0; i < shape.num_samples(); i++) {
+    dst[i].resize(shape.tensor_size(i), -1);
+    dsts[i] = skip_odd && i % 2 ? nullptr : dst[i].data();
+  }
+  CopyToExternal<mm::memory_kind::host>(dsts.data(), src, 0, false, &tp);
+
+  value = 0;
+  for (int i = 0; i < shape.num_samples(); i++) {
+    for (int64_t j = 0; j < shape.tensor_size(i); j++, value++) {
+      int32_t expected = skip_odd && i % 2 ? -1 : value;
+      ASSERT_EQ(dst[i][j], expected) << "sample " << i << ", element " << j;
+    }
+  }
+
+  std::vector<int32_t> contiguous_dst(shape.num_elements(), -1);
+  CopyToExternal<mm::memory_kind::host>(contiguous_dst.data(), src, 0, false, &tp);
+  for (int64_t i = 0; i < shape.num_elements(); i++)
+    ASSERT_EQ(contiguous_dst[i], i);
+}
+
+}  // namespace
+
+TEST(CopyToExternalTest, ParallelHostCopyManySmallSamples) {
+  std::mt19937_64 rng(1234);
+  std::uniform_int_distribution<int64_t> size_dist(0, 1000);
+  TensorListShape<> shape(1024, 1);
+  for (int i = 0; i < shape.num_samples(); i++)
+    shape.set_tensor_shape(i, { size_dist(rng) });
+  TestCopyToExternalHost(shape, false);
+  TestCopyToExternalHost(shape, true);
+}
+
+TEST(CopyToExternalTest, ParallelHostCopyLargeSample) {
+  TensorListShape<> shape = {{ 3 }, { 1 << 20 }, { 0 }, { 5 }};
+  TestCopyToExternalHost(shape, false);
+  TestCopyToExternalHost(shape, true);
+}
+
+}  // namespace dali
@@ -20,6 +20,7 @@
 #include <utility>
 #include "third_party/dlpack/include/dlpack/dlpack.h"
 #include "dali/pipeline/data/tensor.h"
+#include "dali/pipeline/data/tensor_list.h"
 
 namespace dali {
 
@@ -71,6 +72,81 @@ std::vector<DLMTensorPtr> GetDLTensorListView(TensorList<Backend> &tensor_list)
   return dl_tensors;
 }
 
+/**
+ * @brief Keeps the memory of the exported tensor alive
+ */
+struct DLTensorSharedResource : DLTensorResource {
+  DLTensorSharedResource(TensorShape<> shape, shared_ptr<void> data)
+  : DLTensorResource(std::move(shape))
+  , data(std::move(data)) {}
+
+  shared_ptr<void> data;
+};
+
+/**
+ * @brief Returns the memory of the TensorList, to be shared with an owner of independent lifetime
+ *
+ * The TensorList is detached from its allocation (see Buffer::detach_data), so the returned
+ * memory stays valid and unchanged regardless of the further use of the list - e.g. when
+ * the list is an output of the pipeline, the buffer is not copied and the next iteration
+ * writes to a new one.
+ * If the list doesn't own its memory, the data is copied in `stream`. The samples are at the
+ * same offsets in the returned memory as in the list.
+ */
+template <typename Backend>
+shared_ptr<void> ShareTensorListData(TensorList<Backend> &tl, cudaStream_t stream = 0) {
+  if (!tl.shares_data())
+    return tl.detach_data();
+  shared_ptr<uint8_t> copy = AllocBuffer<Backend>(tl.nbytes(), tl.is_pinned());
+  if (tl.nbytes() > 0)
+    tl.type_info().template Copy<Backend, Backend>(copy.get(), unsafe_raw_data(tl), tl.size(),
+                                                   stream);
+  return copy;
+}
+
+/**
+ * @brief Exports a dense TensorList as a single DLPack tensor, which shares the ownership
+ *        of the memory
+ *
+ * The memory is obtained with ShareTensorListData - the list is detached from it or, if the list
+ * doesn't own its memory, the data is copied in `stream`.
+ */
+template <typename Backend>
+DLMTensorPtr ExportDLTensor(TensorList<Backend> &tl, cudaStream_t stream = 0) {
+  DALI_ENFORCE(tl.IsDenseTensor(), "Only a list of samples of the same shape, contiguous "
+               "in memory, can be exported as a single DLPack tensor.");
+  TensorShape<> shape = tl.ntensor() > 0 ? shape_cat(static_cast<int64_t>(tl.ntensor()),
+                                                     tl.tensor_shape(0))
+                                         : TensorShape<>{0};
+  shared_ptr<void> data = ShareTensorListData(tl, stream);
+  void *ptr = data.get();
+  return MakeDLTensor(ptr, tl.type(), std::is_same<Backend, GPUBackend>::value, tl.device_id(),
+                      std::make_unique<DLTensorSharedResource>(std::move(shape), std::move(data)));
+}
+
+/**
+ * @brief Exports the samples of a TensorList as separate DLPack tensors, which share
+ *        the ownership of the memory
+ *
+ * Unlike ExportDLTensor, the samples can have different shapes. The memory is obtained as
+ * in ExportDLTensor and each of the tensors keeps it alive.
+ */
+template <typename Backend>
+std::vector<DLMTensorPtr> ExportDLTensorSamples(TensorList<Backend> &tl,
+                                                cudaStream_t stream = 0) {
+  shared_ptr<void> data = ShareTensorListData(tl, stream);
+  std::vector<DLMTensorPtr> dl_tensors;
+  dl_tensors.reserve(tl.ntensor());
+  for (size_t i = 0; i < tl.ntensor(); i++) {
+    void *ptr = static_cast<uint8_t *>(data.get()) + tl.tensor_offset(i) * tl.type_info().size();
+    dl_tensors.push_back(MakeDLTensor(ptr, tl.type(), std::is_same<Backend, GPUBackend>::value,
+                                      tl.device_id(),
+                                      std::make_unique<DLTensorSharedResource>(
+                                          tl.tensor_shape(i), data)));
+  }
+  return dl_tensors;
+}
+
 DLL_PUBLIC DALIDataType DLToDALIType(const DLDataType &dl_type);
 
 }  // namespace dali
@@ -135,4 +135,85 @@ TEST(DLMTensorPtr, Cleanup) {
   ASSERT_TRUE(deleter_called);
 }
 
+TEST(DLMTensorPtr, ExportDetaches) {
+  TensorList<CPUBackend> tlist;
+  tlist.set_type<int>();
+  tlist.Resize(uniform_list_shape(4, {10, 3}));
+  auto *data = tlist.mutable_tensor<int>(0);
+  for (int i = 0; i < 4 * 10 * 3; i++)
+    data[i] = i;
+
+  DLMTensorPtr dlm_tensor = ExportDLTensor(tlist);
+  ASSERT_EQ(dlm_tensor->dl_tensor.ndim, 3);
+  ASSERT_EQ(dlm_tensor->dl_tensor.shape[0], 4);
+  ASSERT_EQ(dlm_tensor->dl_tensor.shape[1], 10);
+  ASSERT_EQ(dlm_tensor->dl_tensor.shape[2], 3);
+  ASSERT_EQ(dlm_tensor->dl_tensor.data, data);
+  ASSERT_EQ(dlm_tensor->dl_tensor.device.device_type, kDLCPU);
+  EXPECT_TRUE(tlist.is_detached());
+
+  // the list gets a new buffer, the exported data is intact
+  tlist.Resize(uniform_list_shape(4, {10, 3}));
+  EXPECT_FALSE(tlist.is_detached());
+  auto *new_data = tlist.mutable_tensor<int>(0);
+  EXPECT_NE(new_data, data);
+  for (int i = 0; i < 4 * 10 * 3; i++)
+    new_data[i] = -1;
+  auto *exported = static_cast<int *>(dlm_tensor->dl_tensor.data);
+  for (int i = 0; i < 4 * 10 * 3; i++)
+    ASSERT_EQ(exported[i], i);
+}
+
+TEST(DLMTensorPtr, ExportSharedCopies) {
+  TensorList<CPUBackend> owner, tlist;
+  owner.set_type<float>();
+  owner.Resize(uniform_list_shape(2, {5}));
+  for (int i = 0; i < 10; i++)
+    owner.mutable_tensor<float>(0)[i] = i;
+  tlist.ShareData(&owner);
+
+  DLMTensorPtr dlm_tensor = ExportDLTensor(tlist);
+  ASSERT_EQ(dlm_tensor->dl_tensor.ndim, 2);
+  EXPECT_NE(dlm_tensor->dl_tensor.data, unsafe_raw_data(owner));
+  EXPECT_FALSE(owner.is_detached());
+  auto *exported = static_cast<float *>(dlm_tensor->dl_tensor.data);
+  for (int i = 0; i < 10; i++)
+    ASSERT_EQ(exported[i], i);
+}
+
+TEST(DLMTensorPtr, ExportNonUniform) {
+  TensorList<CPUBackend> tlist;
+  tlist.set_type<double>();
+  tlist.Resize({{100, 50, 1}, {50, 30, 3}});
+  EXPECT_THROW(ExportDLTensor(tlist), std::exception);
+}
+
+TEST(DLMTensorPtr, ExportSamples) {
+  TensorList<CPUBackend> tlist;
+  tlist.set_type<int>();
+  tlist.Resize({{2, 3}, {4}, {1, 5}});
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < tlist.tensor_shape(i).num_elements(); j++)
+      tlist.mutable_tensor<int>(i)[j] = i * 100 + j;
+  }
+  const void *sample1 = tlist.raw_tensor(1);
+
+  auto dlm_tensors = ExportDLTensorSamples(tlist);
+  ASSERT_EQ(dlm_tensors.size(), 3u);
+  EXPECT_TRUE(tlist.is_detached());
+  EXPECT_EQ(dlm_tensors[1]->dl_tensor.data, sample1);
+  ASSERT_EQ(dlm_tensors[1]->dl_tensor.ndim, 1);
+  EXPECT_EQ(dlm_tensors[1]->dl_tensor.shape[0], 4);
+  ASSERT_EQ(dlm_tensors[2]->dl_tensor.ndim, 2);
+  EXPECT_EQ(dlm_tensors[2]->dl_tensor.shape[1], 5);
+
+  // each of the tensors keeps the memory alive
+  tlist.Reset();
+  dlm_tensors[0].reset();
+  dlm_tensors[1].reset();
+  auto *exported = static_cast<int *>(dlm_tensors[2]->dl_tensor.data);
+  for (int j = 0; j < 5; j++)
+    ASSERT_EQ(exported[j], 200 + j);
+}
+
 }  // namespace dali
@@ -83,6 +83,8 @@ class DLL_PUBLIC TensorList : private Buffer<Backend> {
   using Buffer<Backend>::reserve;
   // using Buffer<Backend>::reset;  // Available via USE_BUFFER_MEMBERS
   using Buffer<Backend>::shares_data;
+  using Buffer<Backend>::detach_data;
+  using Buffer<Backend>::is_detached;
   using Buffer<Backend>::SetGrowthFactor;
   using Buffer<Backend>::SetShrinkThreshold;
   using Buffer<Backend>::GetGrowthFactor;
@@ -157,6 +159,12 @@ class DLL_PUBLIC TensorList : private Buffer<Backend> {
 
     use_copy_kernel &= (std::is_same<SrcBackend, GPUBackend>::value || other.is_pinned()) &&
                        (std::is_same<Backend, GPUBackend>::value || pinned_);
+    if (nsamples > 0 && other.IsContiguousInMemory()) {
+      // the samples are packed in one buffer, like here - copy them at once
+      type_.template Copy<Backend, SrcBackend>(this->raw_mutable_data(), srcs[0], this->size(),
+                                               stream, use_copy_kernel);
+      return;
+    }
     type_.template Copy<SrcBackend, Backend>(dsts.data(), srcs.data(), sizes.data(),
                                              nsamples, stream, use_copy_kernel);
   }
@@ -579,6 +587,9 @@ class DLL_PUBLIC TensorList : private Buffer<Backend> {
   // with different template types
   template <typename InBackend>
   friend class TensorList;
+  // TensorVector needs the owning pointer of the buffer to create views of the samples
+  template <typename InBackend>
+  friend class TensorVector;
 
   inline std::string GetSourceInfo(int idx) const {
     return meta_[idx].GetSourceInfo();
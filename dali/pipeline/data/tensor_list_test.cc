@@ -16,6 +16,7 @@
 
 #include <gtest/gtest.h>
 
+#include "dali/core/mm/cu_vm.h"
 #include "dali/core/tensor_shape.h"
 #include "dali/pipeline/data/backend.h"
 #include "dali/pipeline/data/buffer.h"
@@ -554,4 +555,38 @@ TYPED_TEST(TensorListTest, TestShareData) {
   ASSERT_EQ(tensor_list2.shape(), TensorListShape<>());
 }
 
+#if DALI_USE_CUDA_VM_MAP
+
+TEST(TensorListGPUTest, GrowInVirtualReservation) {
+  if (!mm::cuvm::IsSupported())
+    GTEST_SKIP() << "CUDA Virtual Memory API not supported on this machine";
+
+  const size_t prev_reservation = Buffer<GPUBackend>::GetVirtualReservation();
+  Buffer<GPUBackend>::SetVirtualReservation(64 << 20);
+  {
+    TensorList<GPUBackend> tl;
+    tl.Resize(uniform_list_shape(4, {1 << 20}), DALI_UINT8);
+    uint8_t *ptr = tl.mutable_tensor<uint8_t>(0);
+    CUDA_CALL(cudaMemset(ptr, 42, 4 << 20));
+
+    tl.Resize(uniform_list_shape(4, {4 << 20}), DALI_UINT8);
+    // the buffer grew in place and the contents are preserved
+    EXPECT_EQ(tl.mutable_tensor<uint8_t>(0), ptr);
+    EXPECT_GE(tl.capacity(), size_t(16 << 20));
+    std::vector<uint8_t> host(4 << 20);
+    CUDA_CALL(cudaMemcpy(host.data(), ptr, host.size(), cudaMemcpyDeviceToHost));
+    for (size_t i = 0; i < host.size(); i += 4093)
+      ASSERT_EQ(host[i], 42) << " at offset " << i;
+
+    // exceeding the reservation reserves a new range
+    tl.Resize(uniform_list_shape(4, {32 << 20}), DALI_UINT8);
+    EXPECT_GE(tl.capacity(), size_t(128 << 20));
+    CUDA_CALL(cudaMemset(tl.raw_mutable_data(), 0, 128 << 20));
+    CUDA_CALL(cudaDeviceSynchronize());
+  }
+  Buffer<GPUBackend>::SetVirtualReservation(prev_reservation);
+}
+
+#endif  // DALI_USE_CUDA_VM_MAP
+
 }  // namespace dali
@@ -289,6 +289,23 @@ bool TensorVector<Backend>::IsContiguous() const noexcept {
 }
 
 
+template <typename Backend>
+bool TensorVector<Backend>::IsContiguousInMemory() const {
+  if (!IsContiguous())
+    return false;
+  if (curr_tensors_size_ == 0)
+    return true;
+  auto *base = static_cast<const uint8_t *>(tensors_[0]->raw_data());
+  size_t offset = 0;
+  for (size_t i = 0; i < curr_tensors_size_; i++) {
+    if (tensors_[i]->raw_data() != base + offset)
+      return false;
+    offset += tensors_[i]->nbytes();
+  }
+  return true;
+}
+
+
 template <typename Backend>
 void TensorVector<Backend>::SetContiguous(bool contiguous) {
   if (contiguous) {
@@ -392,6 +409,65 @@ void TensorVector<Backend>::ShareData(TensorVector<Backend> *tv) {
 }
 
 
+template <typename Backend>
+void TensorVector<Backend>::ShareSamples(const TensorVector<Backend> &src,
+                                         span<const int64_t> offsets,
+                                         const TensorListShape<> &shape) {
+  int batch_size = shape.num_samples();
+  DALI_ENFORCE(batch_size == static_cast<int>(src.ntensor()) && offsets.size() == batch_size,
+               "The number of views must match the number of samples of the source");
+  SetContiguous(false);
+  type_ = src.type_;
+  pinned_ = src.is_pinned();
+  resize_tensors(batch_size);
+
+  for (int i = 0; i < batch_size; i++) {
+    int64_t nbytes = shape.tensor_size(i) * type_.size();
+    DALI_ENFORCE(offsets[i] >= 0 &&
+                 offsets[i] + nbytes <= static_cast<int64_t>(src.tensors_[i]->nbytes()),
+                 make_string("The view of sample ", i, " exceeds the source sample."));
+    share_sample(i, src, i, offsets[i], nbytes, shape[i]);
+  }
+}
+
+template <typename Backend>
+void TensorVector<Backend>::ShareSamples(const TensorVector<Backend> &src,
+                                         span<const int> indices) {
+  int batch_size = indices.size();
+  int src_size = src.ntensor();
+  for (int i = 0; i < batch_size; i++) {
+    DALI_ENFORCE(indices[i] >= 0 && indices[i] < src_size, make_string(
+        "Sample index out of range: ", indices[i], " is not a valid index in a batch of ",
+        src_size, " samples."));
+  }
+  SetContiguous(false);
+  type_ = src.type_;
+  pinned_ = src.is_pinned();
+  resize_tensors(batch_size);
+
+  for (int i = 0; i < batch_size; i++) {
+    const auto &src_sample = *src.tensors_[indices[i]];
+    share_sample(i, src, indices[i], 0, src_sample.nbytes(), src_sample.shape());
+  }
+}
+
+template <typename Backend>
+void TensorVector<Backend>::share_sample(int idx, const TensorVector<Backend> &src, int src_idx,
+                                         int64_t offset, int64_t nbytes,
+                                         const TensorShape<> &shape) {
+  const auto &src_sample = *src.tensors_[src_idx];
+  // the samples of a contiguous batch don't own their memory - the buffer does
+  shared_ptr<void> owner = src_sample.get_data_ptr();
+  if (static_cast<int>(src.tl_->ntensor()) > src_idx &&
+      src_sample.raw_data() == src.tl_->raw_tensor(src_idx))
+    owner = src.tl_->get_data_ptr();
+  auto *ptr = static_cast<uint8_t *>(const_cast<void *>(src_sample.raw_data())) + offset;
+  tensors_[idx]->Reset();
+  tensors_[idx]->ShareData(shared_ptr<void>(owner, ptr), nbytes, shape, type_.id());
+  tensors_[idx]->SetMeta(src_sample.GetMeta());
+}
+
+
 template <typename Backend>
 TensorVector<Backend> &TensorVector<Backend>::operator=(TensorVector<Backend> &&other) noexcept {
   if (&other != this) {
@@ -25,6 +25,7 @@
 #include "dali/pipeline/data/tensor.h"
 #include "dali/pipeline/data/tensor_list.h"
 
+#include "dali/core/span.h"
 #include "dali/core/tensor_shape.h"
 
 namespace dali {
@@ -35,6 +36,12 @@ namespace dali {
  *
  * Propagates Buffer calls to every tensor uniformly
  *
+ * In the contiguous state, the batch is allocated as one TensorList (the arena) and the tensors
+ * are views to their slots in it, so the batch is allocated with one reservation and can be
+ * passed on as a TensorList without copying. The operators which know the shapes of the whole
+ * batch in advance (e.g. readers with prefetched samples) can write to the slots directly.
+ * A sample resized beyond its slot gets its own allocation and the batch is no longer contiguous.
+ *
  * @tparam Backend
  */
 template <typename Backend>
@@ -175,6 +182,15 @@ class DLL_PUBLIC TensorVector {
    */
   bool IsContiguous() const noexcept;
 
+  /**
+   * @brief If the samples are stored back to back in one buffer, in order, so that the whole
+   *        batch can be copied at once.
+   *
+   * Unlike IsContiguous, this checks the actual samples - a view shrunk by resizing
+   * the sample leaves a gap in the buffer.
+   */
+  bool IsContiguousInMemory() const;
+
   /**
    * @brief Set the current state if further calls like Resize() or set_type
    *        should use TensorList or std::vector<Tensor> as backing memory
@@ -195,6 +211,25 @@ class DLL_PUBLIC TensorVector {
 
   void ShareData(TensorVector<Backend> *tv);
 
+  /**
+   * @brief Makes the samples views of parts of the samples of `src`
+   *
+   * The i-th sample becomes a view of `shape[i]` elements of the i-th sample of `src`, starting
+   * `offsets[i]` bytes into it. The views hold a reference to the memory of `src`, so it stays
+   * alive when `src` is reset or reallocated. The TensorVector becomes non-contiguous.
+   */
+  void ShareSamples(const TensorVector<Backend> &src, span<const int64_t> offsets,
+                    const TensorListShape<> &shape);
+
+  /**
+   * @brief Makes the samples views of whole samples of `src`, selected by `indices`
+   *
+   * The i-th sample becomes a view of the sample `indices[i]` of `src` - the indices can repeat
+   * and the number of samples can differ from that of `src`. As above, the views keep the memory
+   * of `src` alive and the TensorVector becomes non-contiguous.
+   */
+  void ShareSamples(const TensorVector<Backend> &src, span<const int> indices);
+
   TensorVector<Backend> &operator=(TensorVector<Backend> &&other) noexcept;
 
   void UpdateViews();
@@ -213,6 +248,10 @@ class DLL_PUBLIC TensorVector {
 
   void update_view(int idx);
 
+  /// Makes the sample `idx` a view of `nbytes` of the sample `src_idx` of `src`, at `offset`
+  void share_sample(int idx, const TensorVector<Backend> &src, int src_idx, int64_t offset,
+                    int64_t nbytes, const TensorShape<> &shape);
+
   std::atomic<int> views_count_;
   std::vector<std::shared_ptr<Tensor<Backend>>> tensors_;
   size_t curr_tensors_size_;
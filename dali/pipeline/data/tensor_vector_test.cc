@@ -271,5 +271,112 @@ TEST_F(TensorVectorVariableBatchSizeTest, TlCopyWithResizeDown) {
   EXPECT_PRED_FORMAT2(Compare, test_tl_, tv);
 }
 
+TEST(TensorVectorTest, ContiguousInMemory) {
+  TensorVector<CPUBackend> tv;
+  tv.set_pinned(false);
+  tv.SetContiguous(true);
+  tv.Resize({{2, 3}, {4}, {1, 5}}, DALI_INT32);
+  ASSERT_TRUE(tv.IsContiguousInMemory());
+  for (int i = 0; i < 3; i++) {
+    auto *data = tv[i].mutable_data<int>();
+    for (int j = 0; j < tv[i].size(); j++)
+      data[j] = i * 100 + j;
+  }
+
+  TensorList<CPUBackend> tl;
+  tl.Copy(tv, 0);
+  for (int i = 0; i < 3; i++) {
+    ASSERT_EQ(tl.tensor_shape(i), tv[i].shape());
+    for (int j = 0; j < tv[i].size(); j++)
+      EXPECT_EQ(tl.tensor<int>(i)[j], i * 100 + j);
+  }
+
+  // a shrunk sample leaves a gap in the buffer
+  tv[1].Resize({2});
+  EXPECT_TRUE(tv.IsContiguous());
+  EXPECT_FALSE(tv.IsContiguousInMemory());
+  tl.Copy(tv, 0);
+  EXPECT_EQ(tl.tensor_shape(1), TensorShape<>(2));
+  EXPECT_EQ(tl.tensor<int>(2)[0], 200);
+
+  // a sample resized beyond its slot gets its own allocation
+  tv[1].Reset();
+  tv[1].Resize({100}, DALI_INT32);
+  EXPECT_FALSE(tv.IsContiguous());
+  EXPECT_FALSE(tv.IsContiguousInMemory());
+}
+
+TEST(TensorVectorTest, ShareSamples) {
+  TensorVector<CPUBackend> src;
+  src.set_pinned(false);
+  src.SetContiguous(true);
+  src.Resize({{4, 3}, {2, 3}}, DALI_INT32);
+  src.SetLayout("FC");
+  for (int i = 0; i < 2; i++) {
+    auto *data = src[i].mutable_data<int>();
+    for (int j = 0; j < src[i].size(); j++)
+      data[j] = i * 100 + j;
+  }
+
+  // the rows 1-2 of the first sample and the row 1 of the second one
+  TensorVector<CPUBackend> views;
+  int64_t offsets[] = { 3 * sizeof(int), 3 * sizeof(int) };
+  views.ShareSamples(src, make_cspan(offsets), {{2, 3}, {1, 3}});
+  EXPECT_FALSE(views.IsContiguous());
+  EXPECT_EQ(views.type(), DALI_INT32);
+  EXPECT_EQ(views.GetLayout(), "FC");
+  EXPECT_EQ(views[0].raw_data(), src[0].data<int>() + 3);
+  EXPECT_EQ(views[1].raw_data(), src[1].data<int>() + 3);
+
+  // the views keep the memory alive after the source is released
+  src.Reset();
+  src.Resize({{1000}}, DALI_INT32);
+  for (int j = 0; j < 6; j++)
+    EXPECT_EQ(views[0].data<int>()[j], j + 3);
+  for (int j = 0; j < 3; j++)
+    EXPECT_EQ(views[1].data<int>()[j], 100 + j + 3);
+
+  int64_t bad_offsets[] = { 0, 5 * sizeof(int) };
+  TensorVector<CPUBackend> tv;
+  tv.SetContiguous(true);
+  tv.Resize({{2}, {2}}, DALI_INT32);
+  EXPECT_THROW(views.ShareSamples(tv, make_cspan(bad_offsets), {{1}, {1}}), std::exception);
+}
+
+TEST(TensorVectorTest, ShareSamplesByIndex) {
+  TensorVector<CPUBackend> src;
+  src.set_pinned(false);
+  src.SetContiguous(true);
+  src.Resize({{4}, {2}, {3}}, DALI_INT32);
+  src.SetLayout("X");
+  for (int i = 0; i < 3; i++) {
+    auto *data = src[i].mutable_data<int>();
+    for (int j = 0; j < src[i].size(); j++)
+      data[j] = i * 100 + j;
+  }
+
+  TensorVector<CPUBackend> views;
+  int indices[] = { 2, 0, 2, 1 };
+  views.ShareSamples(src, make_cspan(indices));
+  ASSERT_EQ(views.ntensor(), 4u);
+  EXPECT_FALSE(views.IsContiguous());
+  EXPECT_EQ(views.GetLayout(), "X");
+  for (int i = 0; i < 4; i++) {
+    EXPECT_EQ(views[i].raw_data(), src[indices[i]].raw_data());
+    EXPECT_EQ(views[i].shape(), src[indices[i]].shape());
+  }
+
+  // the views keep the memory alive after the source is released
+  src.Reset();
+  src.Resize({{1000}}, DALI_INT32);
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < views[i].size(); j++)
+      EXPECT_EQ(views[i].data<int>()[j], indices[i] * 100 + j);
+  }
+
+  int bad_indices[] = { 0, 1 };
+  EXPECT_THROW(views.ShareSamples(src, make_cspan(bad_indices)), std::exception);
+}
+
 }  // namespace test
 }  // namespace dali
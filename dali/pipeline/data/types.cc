@@ -39,22 +39,34 @@ namespace detail {
 
 static constexpr size_t kMaxSizePerBlock = 1 << 18;  // 256 kB per block
 using ScatterGatherPool = PerStreamPool<kernels::ScatterGatherGPU, spinlock, true>;
+using ScatterGatherMethod = kernels::ScatterGatherGPU::Method;
 ScatterGatherPool& ScatterGatherPoolInstance() {
   static ScatterGatherPool scatter_gather_pool_;
   return scatter_gather_pool_;
 }
 
+/**
+ * @brief Batched copies coalesce adjacent samples and, when allowed, pick between
+ *        cudaMemcpyAsync and the gather kernel depending on the sizes of the ranges.
+ *
+ * The kernel can't access pageable host memory, so without `use_copy_kernel` only the copy
+ * engine is used.
+ */
+ScatterGatherMethod GetScatterGatherMethod(bool use_copy_kernel) {
+  return use_copy_kernel ? ScatterGatherMethod::Default : ScatterGatherMethod::Memcpy;
+}
+
 void ScatterGatherCopy(void **dsts, const void **srcs, const Index *sizes, int n, int element_size,
-                       cudaStream_t stream) {
+                       cudaStream_t stream, ScatterGatherMethod method) {
   auto sc = ScatterGatherPoolInstance().Get(stream, kMaxSizePerBlock, n);
   for (int i = 0; i < n; i++) {
     sc->AddCopy(dsts[i], srcs[i], sizes[i] * element_size);
   }
-  sc->Run(stream, true, kernels::ScatterGatherGPU::Method::Kernel);
+  sc->Run(stream, true, method);
 }
 
 void ScatterGatherCopy(void *dst, const void **srcs, const Index *sizes, int n, int element_size,
-                       cudaStream_t stream) {
+                       cudaStream_t stream, ScatterGatherMethod method) {
   auto sc = ScatterGatherPoolInstance().Get(stream, kMaxSizePerBlock, n);
   auto *sample_dst = reinterpret_cast<uint8_t*>(dst);
   for (int i = 0; i < n; i++) {
@@ -62,11 +74,11 @@ void ScatterGatherCopy(void *dst, const void **srcs, const Index *sizes, int n,
     sc->AddCopy(sample_dst, srcs[i], nbytes);
     sample_dst += nbytes;
   }
-  sc->Run(stream, true, kernels::ScatterGatherGPU::Method::Kernel);
+  sc->Run(stream, true, method);
 }
 
 void ScatterGatherCopy(void **dsts, const void *src, const Index *sizes, int n, int element_size,
-                       cudaStream_t stream) {
+                       cudaStream_t stream, ScatterGatherMethod method) {
   auto sc = ScatterGatherPoolInstance().Get(stream, kMaxSizePerBlock, n);
   auto *sample_src = reinterpret_cast<const uint8_t*>(src);
   for (int i = 0; i < n; i++) {
@@ -74,7 +86,7 @@ void ScatterGatherCopy(void **dsts, const void *src, const Index *sizes, int n,
     sc->AddCopy(dsts[i], sample_src, nbytes);
     sample_src += nbytes;
   }
-  sc->Run(stream, true, kernels::ScatterGatherGPU::Method::Kernel);
+  sc->Run(stream, true, method);
 }
 
 }  // namespace detail
@@ -119,8 +131,9 @@ void TypeInfo::Copy(void **dsts, const void** srcs, const Index* sizes, int n,
                     cudaStream_t stream, bool use_copy_kernel) const {
   constexpr bool is_host_to_host = std::is_same<DstBackend, CPUBackend>::value &&
                                    std::is_same<SrcBackend, CPUBackend>::value;
-  if (!is_host_to_host && use_copy_kernel) {
-    detail::ScatterGatherCopy(dsts, srcs, sizes, n, size(), stream);
+  if (!is_host_to_host) {
+    auto method = detail::GetScatterGatherMethod(use_copy_kernel);
+    detail::ScatterGatherCopy(dsts, srcs, sizes, n, size(), stream, method);
   } else {
     for (int i = 0; i < n; i++) {
       Copy<DstBackend, SrcBackend>(dsts[i], srcs[i], sizes[i], stream);
@@ -146,8 +159,9 @@ void TypeInfo::Copy(void *dst, const void** srcs, const Index* sizes, int n,
                     cudaStream_t stream, bool use_copy_kernel) const {
   constexpr bool is_host_to_host = std::is_same<DstBackend, CPUBackend>::value &&
                                    std::is_same<SrcBackend, CPUBackend>::value;
-  if (!is_host_to_host && use_copy_kernel) {
-    detail::ScatterGatherCopy(dst, srcs, sizes, n, size(), stream);
+  if (!is_host_to_host) {
+    auto method = detail::GetScatterGatherMethod(use_copy_kernel);
+    detail::ScatterGatherCopy(dst, srcs, sizes, n, size(), stream, method);
   } else {
     auto sample_dst = static_cast<uint8_t*>(dst);
     for (int i = 0; i < n; i++) {
@@ -176,8 +190,9 @@ void TypeInfo::Copy(void **dsts, const void* src, const Index* sizes, int n,
                     cudaStream_t stream, bool use_copy_kernel) const {
   constexpr bool is_host_to_host = std::is_same<DstBackend, CPUBackend>::value &&
                                    std::is_same<SrcBackend, CPUBackend>::value;
-  if (!is_host_to_host && use_copy_kernel) {
-    detail::ScatterGatherCopy(dsts, src, sizes, n, size(), stream);
+  if (!is_host_to_host) {
+    auto method = detail::GetScatterGatherMethod(use_copy_kernel);
+    detail::ScatterGatherCopy(dsts, src, sizes, n, size(), stream, method);
   } else {
     auto sample_src = reinterpret_cast<const uint8_t*>(src);
     for (int i = 0; i < n; i++) {
@@ -76,6 +76,7 @@ TYPENAME_FUNC(int16_t, int16);
 TYPENAME_FUNC(int32_t, int32);
 TYPENAME_FUNC(int64_t, int64);
 TYPENAME_FUNC(float16, float16);
+TYPENAME_FUNC(bfloat16, bfloat16);
 TYPENAME_FUNC(float, float);
 TYPENAME_FUNC(double, double);
 TYPENAME_FUNC(bool, bool);
@@ -91,7 +92,7 @@ std::string TypesTest<std::array<std::vector<uint8>, DUMMY_ARRAY_SIZE>>::TypeNam
 }
 
 typedef ::testing::Types<uint8_t, uint16_t, uint32_t, uint64_t, int8_t, int16_t, int32_t, int64_t,
-                         float16, float, double, bool, std::vector<uint8>,
+                         float16, bfloat16, float, double, bool, std::vector<uint8>,
                          std::array<std::vector<uint8>, DUMMY_ARRAY_SIZE>>
     TestTypes;
 
@@ -37,6 +37,8 @@ void AsyncPipelinedExecutor::RunCPU() {
         lock.unlock();
 
         PipelinedExecutor::RunCPU();
+        if (enable_concurrent_cpu_iterations_)
+          return;  // CPUIterationReleased signals the mixed stage
 
         // Mark that there is now mixed work to do
         // and signal to any threads that are waiting
@@ -36,12 +36,14 @@ class DLL_PUBLIC AsyncPipelinedExecutor : public PipelinedExecutor {
                                            size_t bytes_per_sample_hint, bool set_affinity = false,
                                            int max_num_stream = -1,
                                            int default_cuda_stream_priority = 0,
-                                           QueueSizes prefetch_queue_depth = QueueSizes{2, 2})
+                                           QueueSizes prefetch_queue_depth = QueueSizes{2, 2},
+                                           bool share_thread_pool = false)
       : PipelinedExecutor(batch_size, num_thread, device_id, bytes_per_sample_hint, set_affinity,
-                          max_num_stream, default_cuda_stream_priority, prefetch_queue_depth),
-        cpu_thread_(device_id, set_affinity),
-        mixed_thread_(device_id, set_affinity),
-        gpu_thread_(device_id, set_affinity) {}
+                          max_num_stream, default_cuda_stream_priority, prefetch_queue_depth,
+                          share_thread_pool),
+        cpu_thread_(device_id, set_affinity, "executor CPU stage"),
+        mixed_thread_(device_id, set_affinity, "executor mixed stage"),
+        gpu_thread_(device_id, set_affinity, "executor GPU stage") {}
 
   DLL_PUBLIC ~AsyncPipelinedExecutor() override {
     ShutdownQueue();
@@ -66,6 +68,8 @@ class DLL_PUBLIC AsyncPipelinedExecutor : public PipelinedExecutor {
     cpu_thread_.Shutdown();
     mixed_thread_.Shutdown();
     gpu_thread_.Shutdown();
+    // no new CPU iterations can start now; the ones in flight notify the mixed stage
+    StopCPUIterations();
   }
 
   DLL_PUBLIC void Init() override {
@@ -104,6 +108,16 @@ class DLL_PUBLIC AsyncPipelinedExecutor : public PipelinedExecutor {
   }
 
  protected:
+  bool CanOverlapCPUIterations() const override {
+    return true;
+  }
+
+  void CPUIterationReleased() override {
+    std::lock_guard<std::mutex> lock(GetReadyMutex());
+    ++mixed_work_counter_;
+    mixed_work_cv_.notify_one();
+  }
+
   void CheckForErrors() {
     cpu_thread_.CheckForErrors();
     mixed_thread_.CheckForErrors();
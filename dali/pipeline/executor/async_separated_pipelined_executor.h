@@ -35,13 +35,13 @@ class DLL_PUBLIC AsyncSeparatedPipelinedExecutor : public SeparatedPipelinedExec
   DLL_PUBLIC inline AsyncSeparatedPipelinedExecutor(
       int batch_size, int num_thread, int device_id, size_t bytes_per_sample_hint,
       bool set_affinity = false, int max_num_stream = -1, int default_cuda_stream_priority = 0,
-      QueueSizes prefetch_queue_depth = QueueSizes{2, 2})
+      QueueSizes prefetch_queue_depth = QueueSizes{2, 2}, bool share_thread_pool = false)
       : SeparatedPipelinedExecutor(batch_size, num_thread, device_id, bytes_per_sample_hint,
                                    set_affinity, max_num_stream, default_cuda_stream_priority,
-                                   prefetch_queue_depth),
-        cpu_thread_(device_id, set_affinity),
-        mixed_thread_(device_id, set_affinity),
-        gpu_thread_(device_id, set_affinity) {}
+                                   prefetch_queue_depth, share_thread_pool),
+        cpu_thread_(device_id, set_affinity, "executor CPU stage"),
+        mixed_thread_(device_id, set_affinity, "executor mixed stage"),
+        gpu_thread_(device_id, set_affinity, "executor GPU stage") {}
 
   DLL_PUBLIC ~AsyncSeparatedPipelinedExecutor() override {
     ShutdownQueue();
@@ -59,6 +59,8 @@ class DLL_PUBLIC AsyncSeparatedPipelinedExecutor : public SeparatedPipelinedExec
     cpu_thread_.Shutdown();
     mixed_thread_.Shutdown();
     gpu_thread_.Shutdown();
+    // no new CPU iterations can start now; the ones in flight notify the mixed stage
+    StopCPUIterations();
   }
 
   DLL_PUBLIC void Init() override {
@@ -14,16 +14,26 @@
 
 #include <algorithm>
 #include <condition_variable>
+#include <cstring>
+#include <functional>
 #include <iterator>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <set>
+#include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
+#include "dali/core/util.h"
+#include "dali/kernels/scratch_capture.h"
 #include "dali/pipeline/executor/executor.h"
 #include "dali/pipeline/executor/queue_metadata.h"
 #include "dali/pipeline/graph/op_graph_storage.h"
 #include "dali/pipeline/operator/common.h"
+#include "dali/pipeline/operator/operator.h"
 #include "dali/pipeline/workspace/workspace_data_factory.h"
 
 namespace dali {
@@ -52,57 +62,378 @@ void Executor<WorkspacePolicy, QueuePolicy>::RunCPUImpl() {
                  "valid device id or change the operators' device.");
   }
 
-  DomainTimeRange tr("[DALI][Executor] RunCPU");
+  int64_t iteration = stage_iterations_[static_cast<int>(OpType::CPU)]++;
+  DALI_TRACE_RANGE(kTraceExecutor, make_string("[DALI][Executor] RunCPU #", iteration),
+                   RangeBase::kBlue);
 
   DeviceGuard g(device_id_);
 
+  auto wait_start = TimingStart();
+  auto acquire_start = HealthMonitor::Clock::now();
   auto cpu_idxs = QueuePolicy::AcquireIdxs(OpType::CPU);
+  health_.StageAcquired(OpType::CPU, acquire_start,
+                        QueuePolicy::template AreValid<OpType::CPU>(cpu_idxs));
   if (exec_error_ || QueuePolicy::IsStopSignaled() ||
       !QueuePolicy::template AreValid<OpType::CPU>(cpu_idxs)) {
     QueuePolicy::ReleaseIdxs(OpType::CPU, cpu_idxs);
+    if (cpu_iteration_runners_)
+      CPUIterationReleased();
     return;
   }
+  auto stage_start = TimingStart();
 
   auto batch_size = batch_sizes_cpu_.front();
   batch_sizes_cpu_.pop();
 
-  // Run the cpu-ops in the thread
-  // Process each CPU Op in batch
-  for (int cpu_op_id = 0; cpu_op_id < graph_->NumOp(OpType::CPU) && !exec_error_; ++cpu_op_id) {
-    OpNode &op_node = graph_->Node(OpType::CPU, cpu_op_id);
-    typename WorkspacePolicy::template ws_t<OpType::CPU> ws =
-        WorkspacePolicy::template GetWorkspace<OpType::CPU>(cpu_idxs, *graph_, cpu_op_id);
+  if (cpu_iteration_runners_) {
+    // the iteration is released to the next stage once all its operators have finished
+    StartCPUIteration(cpu_idxs, batch_size, iteration, wait_start, stage_start);
+    return;
+  } else if (cpu_op_runners_) {
+    RunCPUDataflow(cpu_idxs, batch_size, iteration);
+  } else if (enable_cpu_depth_first_) {
+    RunCPUDepthFirst(cpu_idxs, batch_size, iteration);
+  } else {
+    // Run the cpu-ops in the thread
+    // Process each CPU Op in batch
+    for (int cpu_op_id = 0; cpu_op_id < graph_->NumOp(OpType::CPU) && !exec_error_; ++cpu_op_id)
+      RunCPUOp(cpu_op_id, cpu_idxs, batch_size, iteration);
+  }
 
-    ws.SetBatchSizes(batch_size);
+  FillStageTiming(OpType::CPU, batch_size, wait_start, stage_start);
+
+  // Pass the work to the mixed stage
+  health_.StageReleased(OpType::CPU);
+  QueuePolicy::ReleaseIdxs(OpType::CPU, cpu_idxs);
+}
 
-    DomainTimeRange tr("[DALI][CPU op] " + op_node.instance_name, DomainTimeRange::kBlue1);
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::RunCPUOp(int cpu_op_id, QueueIdxs cpu_idxs,
+                                                       int batch_size, int64_t iteration) {
+  OpNode &op_node = graph_->Node(OpType::CPU, cpu_op_id);
+  typename WorkspacePolicy::template ws_t<OpType::CPU> ws =
+      WorkspacePolicy::template GetWorkspace<OpType::CPU>(cpu_idxs, *graph_, cpu_op_id);
 
-    try {
+  ws.SetBatchSizes(batch_size);
+
+  DALI_TRACE_RANGE(kTraceOperator, make_string("[DALI][CPU op] ", op_node.instance_name, " #",
+                                               iteration, " batch ", batch_size),
+                   RangeBase::kBlue1);
+
+  try {
+    auto op_start = TimingStart();
+    if (!ReuseInvariantOutputs(op_node, cpu_idxs[OpType::CPU], ws)) {
       RunHelper(op_node, ws);
-      FillStats(cpu_memory_stats_, ws, "CPU_" + op_node.instance_name, cpu_memory_stats_mutex_);
+      SaveInvariantOutputs(op_node, cpu_idxs[OpType::CPU], ws);
+    }
+    FillOpTiming(OpType::CPU, cpu_op_id, batch_size, op_start);
+    FillStats(cpu_memory_stats_, cpu_sample_sizes_, ws, "CPU_" + op_node.instance_name,
+              cpu_memory_stats_mutex_);
+  } catch (std::exception &e) {
+    HandleError("CPU", op_node, e.what());
+  } catch (...) {
+    HandleError();
+  }
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::RunCPUDataflow(QueueIdxs cpu_idxs, int batch_size,
+                                                             int64_t iteration) {
+  auto priorities = CPUOpPriorities();
+  std::vector<int> num_pending = cpu_op_num_producers_;
+  std::mutex pending_mutex;
+
+  // The consumers are queued by the producer finishing last; the runners pick the ready
+  // operators with the highest priority first.
+  std::function<void(int, bool)> launch = [&](int cpu_op_id, bool start) {
+    cpu_op_runners_->AddWork([&, cpu_op_id](int) {
+      if (exec_error_)
+        return;  // don't start anything new after an error
+      RunCPUOp(cpu_op_id, cpu_idxs, batch_size, iteration);
+      std::lock_guard<std::mutex> lock(pending_mutex);
+      for (int consumer : cpu_op_consumers_[cpu_op_id]) {
+        if (--num_pending[consumer] == 0)
+          launch(consumer, true);
+      }
+    }, priorities[cpu_op_id], start);
+  };
+
+  for (int cpu_op_id = 0; cpu_op_id < graph_->NumOp(OpType::CPU); cpu_op_id++) {
+    if (num_pending[cpu_op_id] == 0)
+      launch(cpu_op_id, false);
+  }
+  // waits also for the operators queued while running
+  cpu_op_runners_->RunAll();
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::StartCPUIteration(
+    QueueIdxs cpu_idxs, int batch_size, int64_t iteration, TimingClock::time_point wait_start,
+    TimingClock::time_point stage_start) {
+  int num_ops = graph_->NumOp(OpType::CPU);
+  std::unique_lock<std::mutex> lock(cpu_iterations_mutex_);
+  int64_t seq = cpu_iterations_started_++;
+  cpu_iterations_.push_back({seq, iteration, cpu_idxs, batch_size, wait_start, stage_start,
+                             cpu_op_num_producers_, num_ops});
+  for (int cpu_op_id = 0; cpu_op_id < num_ops; cpu_op_id++)
+    TryLaunchCPUOp(cpu_op_id, seq);
+  ReleaseCPUIterations();  // in case there are no CPU operators
+  if (!CanOverlapCPUIterations()) {
+    cpu_iteration_released_.wait(lock, [&]() { return cpu_iterations_released_ > seq; });
+  }
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::TryLaunchCPUOp(int cpu_op_id, int64_t seq) {
+  if (cpu_op_running_[cpu_op_id] || cpu_op_next_iteration_[cpu_op_id] != seq)
+    return;  // the operator must finish the previous iterations first
+  int64_t pos = seq - cpu_iterations_released_;
+  if (pos >= static_cast<int64_t>(cpu_iterations_.size()))
+    return;  // the iteration hasn't started yet
+  const CPUIteration &it = cpu_iterations_[pos];
+  if (it.num_pending[cpu_op_id] > 0)
+    return;  // the inputs aren't ready yet
+  cpu_op_running_[cpu_op_id] = true;
+  QueueIdxs cpu_idxs = it.idxs;
+  int batch_size = it.batch_size;
+  int64_t iteration = it.iteration;
+  cpu_iteration_runners_->AddWork([=](int) {
+    if (!exec_error_ && !QueuePolicy::IsStopSignaled())
+      RunCPUOp(cpu_op_id, cpu_idxs, batch_size, iteration);
+    std::lock_guard<std::mutex> lock(cpu_iterations_mutex_);
+    cpu_op_running_[cpu_op_id] = false;
+    cpu_op_next_iteration_[cpu_op_id]++;
+    auto &finished = cpu_iterations_[seq - cpu_iterations_released_];
+    finished.num_ops_left--;
+    for (int consumer : cpu_op_consumers_[cpu_op_id]) {
+      finished.num_pending[consumer]--;
+      TryLaunchCPUOp(consumer, seq);
+    }
+    TryLaunchCPUOp(cpu_op_id, seq + 1);
+    ReleaseCPUIterations();
+  }, -seq, true);  // the older iterations first
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::ReleaseCPUIterations() {
+  bool released = false;
+  while (!cpu_iterations_.empty() && cpu_iterations_.front().num_ops_left == 0) {
+    auto &it = cpu_iterations_.front();
+    FillStageTiming(OpType::CPU, it.batch_size, it.wait_start, it.stage_start);
+    // Pass the work to the mixed stage
+    health_.StageReleased(OpType::CPU);
+    QueuePolicy::ReleaseIdxs(OpType::CPU, it.idxs);
+    cpu_iterations_.pop_front();
+    cpu_iterations_released_++;
+    CPUIterationReleased();
+    released = true;
+  }
+  if (released)
+    cpu_iteration_released_.notify_all();
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::SetupCPUDependencies() {
+  int num_ops = graph_->NumOp(OpType::CPU);
+  cpu_op_consumers_.assign(num_ops, {});
+  cpu_op_num_producers_.assign(num_ops, 0);
+  for (int i = 0; i < num_ops; i++) {
+    for (OpNodeId child : graph_->Node(OpType::CPU, i).children) {
+      if (graph_->NodeType(child) != OpType::CPU)
+        continue;
+      int consumer = graph_->NodeIdx(child);
+      cpu_op_consumers_[i].push_back(consumer);
+      cpu_op_num_producers_[consumer]++;
+    }
+  }
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::SetupCPUDataflow() {
+  SetupCPUDependencies();
+  int num_ops = graph_->NumOp(OpType::CPU);
+
+  // The runners only launch the operators and wait for them - the per-sample work is done
+  // by the thread pool, so more runners than its threads wouldn't help
+  int num_runners = std::min(num_ops, thread_pool_.NumThreads());
+  cpu_op_runners_ = std::make_unique<ThreadPool>(num_runners, device_id_, false);
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+std::vector<int64_t> Executor<WorkspacePolicy, QueuePolicy>::CPUOpPriorities() {
+  int num_ops = graph_->NumOp(OpType::CPU);
+  // in microseconds; the operators which weren't measured count as 1
+  std::vector<int64_t> weights(num_ops, 1);
+  {
+    int stage_idx = static_cast<int>(OpType::CPU);
+    std::lock_guard<std::mutex> lck(timing_stats_mutex_[stage_idx]);
+    auto &stats = op_timing_stats_[stage_idx];
+    for (int i = 0; i < static_cast<int>(stats.size()); i++) {
+      if (stats[i].iterations > 0)
+        weights[i] = std::max<int64_t>(1, 1e6 * stats[i].total_time / stats[i].iterations);
+    }
+  }
+  // the operators are numbered in a topological order, so the consumers come later
+  std::vector<int64_t> priorities(num_ops, 0);
+  for (int i = num_ops - 1; i >= 0; i--) {
+    int64_t path = 0;
+    for (int consumer : cpu_op_consumers_[i])
+      path = std::max(path, priorities[consumer]);
+    priorities[i] = weights[i] + path;
+  }
+  return priorities;
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::RunCPUDepthFirst(QueueIdxs cpu_idxs, int batch_size,
+                                                               int64_t iteration) {
+  int num_ops = graph_->NumOp(OpType::CPU);
+  // found in each iteration - whether an operator runs per sample is known once it has run
+  std::vector<bool> per_sample(num_ops);
+  for (int i = 0; i < num_ops; i++) {
+    auto *op = dynamic_cast<Operator<CPUBackend> *>(graph_->Node(OpType::CPU, i).op.get());
+    per_sample[i] = op && op->RunsPerSample();
+  }
+  std::vector<int> next(num_ops, -1);
+  std::vector<bool> chained(num_ops, false);
+  for (int i = 0; i < num_ops; i++) {
+    auto &op_node = graph_->Node(OpType::CPU, i);
+    if (!per_sample[i] || op_node.spec.NumInput() != 1 || op_node.op->CanInferOutputs())
+      continue;
+    int producer = graph_->NodeIdx(*op_node.parents.begin());
+    if (per_sample[producer] && next[producer] < 0) {
+      next[producer] = i;
+      chained[i] = true;
+    }
+  }
+
+  std::vector<int> chain;
+  for (int i = 0; i < num_ops && !exec_error_; i++) {
+    if (chained[i])
+      continue;  // already run with its producer
+    if (next[i] < 0) {
+      RunCPUOp(i, cpu_idxs, batch_size, iteration);
+      continue;
+    }
+    chain.clear();
+    for (int op = i; op >= 0; op = next[op])
+      chain.push_back(op);
+    RunCPUChain(chain, cpu_idxs, batch_size, iteration);
+  }
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::RunCPUChain(const std::vector<int> &chain,
+                                                          QueueIdxs cpu_idxs, int batch_size,
+                                                          int64_t iteration) {
+  using ws_t = typename WorkspacePolicy::template ws_t<OpType::CPU>;
+  static_assert(std::is_reference<ws_t>::value,
+                "The workspaces must outlive the calls to GetWorkspace.");
+  int chain_len = chain.size();
+  const auto &first_name = graph_->Node(OpType::CPU, chain[0]).instance_name;
+  DALI_TRACE_RANGE(kTraceOperator, make_string("[DALI][CPU chain] ", first_name, " (", chain_len,
+                                               " ops) #", iteration, " batch ", batch_size),
+                   RangeBase::kBlue1);
+
+  int failed = -1;
+  std::string error;
+  std::mutex error_mutex;
+  auto set_error = [&](int idx, const char *message) {
+    std::lock_guard<std::mutex> lock(error_mutex);
+    if (failed < 0) {
+      failed = idx;
+      error = message;
+    }
+  };
+
+  auto chain_start = TimingStart();
+  std::vector<HostWorkspace *> wss;
+  std::vector<Operator<CPUBackend> *> ops;
+  SmallVector<int, 16> empty_layout_in_idxs;
+  int num_samples = 0;
+  for (int j = 0; j < chain_len; j++) {
+    OpNode &op_node = graph_->Node(OpType::CPU, chain[j]);
+    try {
+      ws_t ws = WorkspacePolicy::template GetWorkspace<OpType::CPU>(cpu_idxs, *graph_, chain[j]);
+      ws.SetBatchSizes(batch_size);
+      wss.push_back(&ws);
+      ops.push_back(static_cast<Operator<CPUBackend> *>(op_node.op.get()));
+      // the inputs of the next operators aren't produced yet
+      SetupHelper(op_node, ws, j == 0 ? &empty_layout_in_idxs : nullptr);
+      int n = ops[j]->StartSamples(ws);
+      if (j == 0)
+        num_samples = n;
     } catch (std::exception &e) {
-      HandleError("CPU", op_node, e.what());
+      set_error(j, e.what());
+      break;
     } catch (...) {
-      HandleError();
+      set_error(j, "Unknown exception");
+      break;
     }
   }
 
-  // Pass the work to the mixed stage
-  QueuePolicy::ReleaseIdxs(OpType::CPU, cpu_idxs);
-}
+  if (failed < 0) {
+    auto &thread_pool = wss[0]->GetThreadPool();
+    for (int data_idx = 0; data_idx < num_samples; data_idx++) {
+      thread_pool.AddWork([&, data_idx](int tid) {
+        for (int j = 0; j < chain_len; j++) {
+          try {
+            ops[j]->RunSample(*wss[j], data_idx, tid);
+          } catch (std::exception &e) {
+            set_error(j, e.what());
+            return;
+          } catch (...) {
+            set_error(j, "Unknown exception");
+            return;
+          }
+        }
+      }, -data_idx);  // -data_idx for FIFO order
+    }
+    try {
+      thread_pool.RunAll();
+    } catch (std::exception &e) {
+      set_error(0, e.what());
+    }
+  }
+  if (!wss.empty())
+    ResetDefaultLayouts(*wss[0], empty_layout_in_idxs);
 
+  for (int j = 0; j < chain_len && failed < 0; j++) {
+    OpNode &op_node = graph_->Node(OpType::CPU, chain[j]);
+    try {
+      ops[j]->FinishSamples(*wss[j]);
+      // the time of the whole chain is reported for its first operator
+      if (j == 0)
+        FillOpTiming(OpType::CPU, chain[0], batch_size, chain_start);
+      FillStats(cpu_memory_stats_, cpu_sample_sizes_, *wss[j], "CPU_" + op_node.instance_name,
+                cpu_memory_stats_mutex_);
+    } catch (std::exception &e) {
+      set_error(j, e.what());
+    }
+  }
+
+  if (failed >= 0)
+    HandleError("CPU", graph_->Node(OpType::CPU, chain[failed]), error);
+}
 
 template <typename WorkspacePolicy, typename QueuePolicy>
 void Executor<WorkspacePolicy, QueuePolicy>::RunMixedImpl() {
-  DomainTimeRange tr("[DALI][Executor] RunMixed");
+  int64_t iteration = stage_iterations_[static_cast<int>(OpType::MIXED)]++;
+  DALI_TRACE_RANGE(kTraceExecutor, make_string("[DALI][Executor] RunMixed #", iteration),
+                   RangeBase::kBlue);
   DeviceGuard g(device_id_);
 
+  auto wait_start = TimingStart();
+  auto acquire_start = HealthMonitor::Clock::now();
   auto mixed_idxs = QueuePolicy::AcquireIdxs(OpType::MIXED);
+  health_.StageAcquired(OpType::MIXED, acquire_start,
+                        QueuePolicy::template AreValid<OpType::MIXED>(mixed_idxs));
   if (exec_error_ || QueuePolicy::IsStopSignaled() ||
      !QueuePolicy::template AreValid<OpType::MIXED>(mixed_idxs)) {
     QueuePolicy::ReleaseIdxs(OpType::MIXED, mixed_idxs);
     return;
   }
+  auto stage_start = TimingStart();
 
   // short path for pure CPU pipeline
   if (device_id_ == CPU_ONLY_DEVICE_ID) {
@@ -117,22 +448,59 @@ void Executor<WorkspacePolicy, QueuePolicy>::RunMixedImpl() {
   // Enforce our assumed dependency between consecutive
   // iterations of a stage of the pipeline.
 
-  CUDA_CALL(cudaEventSynchronize(mixed_stage_event_));
+  WaitForEvent(mixed_stage_event_);
+  WaitForConsumer(mixed_op_stream_);
 
   auto batch_size = batch_sizes_mixed_.front();
   batch_sizes_mixed_.pop();
 
+  if (!cached_subgraphs_.empty()) {
+    try {
+      MarkSkippedOps(mixed_idxs, batch_size);
+    } catch (std::exception &e) {
+      HandleError(make_string("Exception in Mixed stage: ", e.what()));
+    }
+  }
+
+  try {
+    PackSmallTransfers(mixed_idxs);
+  } catch (std::exception &e) {
+    HandleError(make_string("Exception in Mixed stage: ", e.what()));
+  }
+
   for (int i = 0; i < graph_->NumOp(OpType::MIXED) && !exec_error_; ++i) {
     OpNode &op_node = graph_->Node(OpType::MIXED, i);
+    if (IsSkipped(mixed_idxs[OpType::MIXED], op_node.id))
+      continue;
     try {
       typename WorkspacePolicy::template ws_t<OpType::MIXED> ws =
           WorkspacePolicy::template GetWorkspace<OpType::MIXED>(mixed_idxs, *graph_, i);
 
       ws.SetBatchSizes(batch_size);
+      if (packed_transfers_[i].input) {
+        UsePackedTransfer(i, mixed_idxs[OpType::MIXED], ws);
+        if (ws.has_event())
+          CUDA_CALL(cudaEventRecord(ws.event(), ws.stream()));
+        continue;
+      }
+      if (!packed_outputs_.empty() && ws.NumOutput() > 0 &&
+          !ws.template OutputIsType<CPUBackend>(0) &&
+          packed_outputs_.erase(&ws.template OutputRef<GPUBackend>(0)) > 0) {
+        // packed in the previous use of the queue slot - the output needs its own memory again
+        ws.template OutputRef<GPUBackend>(0).Reset();
+      }
 
-      DomainTimeRange tr("[DALI][Mixed op] " + op_node.instance_name, DomainTimeRange::kOrange);
+      DALI_TRACE_RANGE(kTraceOperator, make_string("[DALI][Mixed op] ", op_node.instance_name,
+                                                   " #", iteration, " batch ", batch_size),
+                       RangeBase::kOrange);
+      auto op_start = TimingStart();
+      if (ws.has_stream())
+        StartGPUTiming(OpType::MIXED, i, mixed_idxs[OpType::MIXED], ws.stream());
       RunHelper(op_node, ws);
-      FillStats(mixed_memory_stats_, ws, "MIXED_" + op_node.instance_name,
+      if (ws.has_stream())
+        StopGPUTiming(OpType::MIXED, i, mixed_idxs[OpType::MIXED], ws.stream());
+      FillOpTiming(OpType::MIXED, i, batch_size, op_start);
+      FillStats(mixed_memory_stats_, mixed_sample_sizes_, ws, "MIXED_" + op_node.instance_name,
                 mixed_memory_stats_mutex_);
       if (ws.has_stream() && ws.has_event()) {
         CUDA_CALL(cudaEventRecord(ws.event(), ws.stream()));
@@ -159,25 +527,36 @@ void Executor<WorkspacePolicy, QueuePolicy>::RunMixedImpl() {
   // We know that this is the proper stream, we do not need to look it up in any workspace
   CUDA_CALL(cudaEventRecord(mixed_stage_event_, mixed_op_stream_));
 
+  FillStageTiming(OpType::MIXED, batch_size, wait_start, stage_start);
+
   // Pass the work to the gpu stage
+  health_.StageReleased(OpType::MIXED);
   QueuePolicy::ReleaseIdxs(OpType::MIXED, mixed_idxs, mixed_op_stream_);
 }
 
 
 template <typename WorkspacePolicy, typename QueuePolicy>
 void Executor<WorkspacePolicy, QueuePolicy>::RunGPUImpl() {
-  DomainTimeRange tr("[DALI][Executor] RunGPU");
+  int64_t iteration = stage_iterations_[static_cast<int>(OpType::GPU)]++;
+  DALI_TRACE_RANGE(kTraceExecutor, make_string("[DALI][Executor] RunGPU #", iteration),
+                   RangeBase::kBlue);
 
+  auto wait_start = TimingStart();
+  auto acquire_start = HealthMonitor::Clock::now();
   auto gpu_idxs = QueuePolicy::AcquireIdxs(OpType::GPU);
+  health_.StageAcquired(OpType::GPU, acquire_start,
+                        QueuePolicy::template AreValid<OpType::GPU>(gpu_idxs));
   if (exec_error_ || QueuePolicy::IsStopSignaled() ||
       !QueuePolicy::template AreValid<OpType::GPU>(gpu_idxs)) {
     QueuePolicy::ReleaseIdxs(OpType::GPU, gpu_idxs);
     return;
   }
+  auto stage_start = TimingStart();
 
   // short path for pure CPU pipeline
   if (device_id_ == CPU_ONLY_DEVICE_ID) {
     // We do not release, but handle to used outputs
+    health_.StageReleased(OpType::GPU);
     QueuePolicy::QueueOutputIdxs(gpu_idxs, gpu_op_stream_);
     return;
   }
@@ -185,31 +564,111 @@ void Executor<WorkspacePolicy, QueuePolicy>::RunGPUImpl() {
 
   // Enforce our assumed dependency between consecutive
   // iterations of a stage of the pipeline.
-  CUDA_CALL(cudaEventSynchronize(gpu_stage_event_));
+  WaitForEvent(gpu_stage_event_);
+  WaitForConsumer(gpu_op_stream_);
 
   auto batch_size = batch_sizes_gpu_.front();
   batch_sizes_gpu_.pop();
 
+  if (use_gpu_graphs_)
+    RunGPUGraphs(gpu_idxs, batch_size, iteration);
+  else
+    RunGPUOps(gpu_idxs, batch_size, iteration);
+
+  // Update the ready queue to signal that all the work
+  // in the `gpu_idxs` set of output buffers has been
+  // issued. Notify any waiting threads.
+
+  // If we have GPU outputs than
+  if (!gpu_output_events_.empty()) {
+    int queue_id = gpu_idxs[OpType::GPU];
+    // The consumer waits for a single event, which covers the Mixed stage outputs as well
+    if (!mixed_output_events_.empty())
+      CUDA_CALL(cudaStreamWaitEvent(gpu_op_stream_,
+                                    mixed_output_events_.GetEvent(gpu_idxs[OpType::MIXED]), 0));
+    CUDA_CALL(cudaEventRecord(gpu_output_events_.GetEvent(queue_id), gpu_op_stream_));
+  }
+
+  // Schedule the call to any callback registered previously
+  if (callback_) {
+    CUDA_CALL(
+        cudaStreamWaitEvent(gpu_op_stream_, mixed_callback_events_[gpu_idxs[OpType::MIXED]], 0));
+    CUDA_CALL(cudaStreamAddCallback(gpu_op_stream_, &detail::gpu_finished_callback,
+                                    static_cast<void *>(&callback_), 0));
+  }
+
+  // We know that this is the proper stream, we do not need to look it up in any workspace
+  CUDA_CALL(cudaEventRecord(gpu_stage_event_, gpu_op_stream_));
+
+  FillStageTiming(OpType::GPU, batch_size, wait_start, stage_start);
+
+  // We do not release, but handle to used outputs
+  health_.StageReleased(OpType::GPU);
+  QueuePolicy::QueueOutputIdxs(gpu_idxs, gpu_op_stream_);
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::RunGPUOps(QueueIdxs gpu_idxs, int batch_size,
+                                                        int64_t iteration) {
+  bool multi_stream = !gpu_op_stream_idx_.empty();
+  if (multi_stream) {
+    // the other streams start when the stage is allowed to overwrite the outputs
+    CUDA_CALL(cudaEventRecord(gpu_fork_event_, gpu_op_stream_));
+    for (size_t s = 1; s < gpu_streams_.size(); s++)
+      CUDA_CALL(cudaStreamWaitEvent(gpu_streams_[s], gpu_fork_event_, 0));
+  }
+
+  bool early_setup = !gpu_op_early_setup_.empty() && SetupGPUOpsEarly(gpu_idxs, batch_size);
+
   for (int i = 0; i < graph_->NumOp(OpType::GPU) && !exec_error_; ++i) {
     OpNode &op_node = graph_->Node(OpType::GPU, i);
+    if (IsSkipped(gpu_idxs[OpType::MIXED], op_node.id))
+      continue;
     try {
       typename WorkspacePolicy::template ws_t<OpType::GPU> ws =
           WorkspacePolicy::template GetWorkspace<OpType::GPU>(gpu_idxs, *graph_, i);
 
       ws.SetBatchSizes(batch_size);
 
+      if (multi_stream) {
+        ws.set_stream(gpu_streams_[gpu_op_stream_idx_[i]]);
+        for (int producer : gpu_op_cross_stream_producers_[i])
+          CUDA_CALL(cudaStreamWaitEvent(ws.stream(), gpu_op_events_[producer], 0));
+      }
+
       auto parent_events = ws.ParentEvents();
 
       for (auto &event : parent_events) {
         CUDA_CALL(cudaStreamWaitEvent(ws.stream(), event, 0));
       }
 
-      DomainTimeRange tr("[DALI][GPU op] " + op_node.instance_name, DomainTimeRange::knvGreen);
-      RunHelper(op_node, ws);
-      FillStats(gpu_memory_stats_, ws, "GPU_" + op_node.instance_name, gpu_memory_stats_mutex_);
+      DALI_TRACE_RANGE(kTraceOperator, make_string("[DALI][GPU op] ", op_node.instance_name,
+                                                   " #", iteration, " batch ", batch_size),
+                       RangeBase::knvGreen);
+      kernels::ScratchArena *arena = nullptr;
+      if (!gpu_scratch_arenas_.empty())
+        arena = &gpu_scratch_arenas_[multi_stream ? gpu_op_stream_idx_[i] : 0];
+      auto op_start = TimingStart();
+      StartGPUTiming(OpType::GPU, i, gpu_idxs[OpType::GPU], ws.stream());
+      if (!ReuseInvariantOutputs(op_node, gpu_idxs[OpType::GPU], ws)) {
+        kernels::ScratchArena::Scope scratch_scope(arena);
+        if (early_setup && gpu_op_early_setup_[i])
+          op_node.op->Run(ws);
+        else
+          RunHelper(op_node, ws);
+        SaveInvariantOutputs(op_node, gpu_idxs[OpType::GPU], ws);
+      }
+      if (arena)
+        FillScratchStats(i, arena->LastPeak());
+      StopGPUTiming(OpType::GPU, i, gpu_idxs[OpType::GPU], ws.stream());
+      FillOpTiming(OpType::GPU, i, batch_size, op_start);
+      FillStats(gpu_memory_stats_, gpu_sample_sizes_, ws, "GPU_" + op_node.instance_name,
+                gpu_memory_stats_mutex_);
       if (ws.has_event()) {
         CUDA_CALL(cudaEventRecord(ws.event(), ws.stream()));
       }
+      if (multi_stream && gpu_op_events_[i])
+        CUDA_CALL(cudaEventRecord(gpu_op_events_[i], ws.stream()));
       CUDA_CALL(cudaGetLastError());
     } catch (std::exception &e) {
       HandleError("GPU", op_node, e.what());
@@ -218,29 +677,529 @@ void Executor<WorkspacePolicy, QueuePolicy>::RunGPUImpl() {
     }
   }
 
-  // Update the ready queue to signal that all the work
-  // in the `gpu_idxs` set of output buffers has been
-  // issued. Notify any waiting threads.
+  if (multi_stream) {
+    // the outputs, the callback and the next iteration wait for all the streams
+    for (size_t s = 1; s < gpu_streams_.size(); s++) {
+      CUDA_CALL(cudaEventRecord(gpu_join_events_[s], gpu_streams_[s]));
+      CUDA_CALL(cudaStreamWaitEvent(gpu_op_stream_, gpu_join_events_[s], 0));
+    }
+  }
+}
 
-  // If we have GPU outputs than
-  if (!gpu_output_events_.empty()) {
-    int queue_id = gpu_idxs[OpType::GPU];
-    CUDA_CALL(cudaEventRecord(gpu_output_events_.GetEvent(queue_id), gpu_op_stream_));
+template <typename WorkspacePolicy, typename QueuePolicy>
+bool Executor<WorkspacePolicy, QueuePolicy>::SetupGPUOpsEarly(QueueIdxs gpu_idxs,
+                                                               int batch_size) {
+  using ws_t = typename WorkspacePolicy::template ws_t<OpType::GPU>;
+  static_assert(std::is_reference<ws_t>::value,
+                "The workspaces must outlive the calls to GetWorkspace.");
+  DomainTimeRange tr("[DALI][Executor] SetupGPUOpsEarly");
+  bool multi_stream = !gpu_op_stream_idx_.empty();
+  for (int i = 0; i < graph_->NumOp(OpType::GPU); i++) {
+    OpNode &op_node = graph_->Node(OpType::GPU, i);
+    if (!gpu_op_early_setup_[i] || IsSkipped(gpu_idxs[OpType::MIXED], op_node.id) ||
+        HasInvariantOutputs(op_node.id, batch_size))
+      continue;
+    try {
+      ws_t ws = WorkspacePolicy::template GetWorkspace<OpType::GPU>(gpu_idxs, *graph_, i);
+      ws.SetBatchSizes(batch_size);
+      if (multi_stream)
+        ws.set_stream(gpu_streams_[gpu_op_stream_idx_[i]]);
+      // the inputs of most of the operators aren't produced yet
+      SetupHelper(op_node, ws, nullptr);
+    } catch (std::exception &e) {
+      HandleError("GPU", op_node, e.what());
+      return false;
+    } catch (...) {
+      HandleError();
+      return false;
+    }
   }
+  return true;
+}
 
-  // Schedule the call to any callback registered previously
-  if (callback_) {
-    CUDA_CALL(
-        cudaStreamWaitEvent(gpu_op_stream_, mixed_callback_events_[gpu_idxs[OpType::MIXED]], 0));
-    CUDA_CALL(cudaStreamAddCallback(gpu_op_stream_, &detail::gpu_finished_callback,
-                                    static_cast<void *>(&callback_), 0));
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::SetupGPUStreams() {
+  int num_ops = graph_->NumOp(OpType::GPU);
+  int max_side_streams = max_num_stream_ < 0 ? kMaxGPUSideStreams
+                                             : std::max(0, max_num_stream_ - 2);
+  std::vector<int> stream_idx(num_ops, 0);
+  std::vector<int> last_op = { -1 };  // stream index -> the last op assigned to the stream
+  int num_reused = 0;
+  for (int i = 0; i < num_ops; i++) {
+    int s = -1;
+    for (OpNodeId parent : graph_->Node(OpType::GPU, i).parents) {
+      if (graph_->NodeType(parent) != OpType::GPU)
+        continue;
+      int producer = graph_->NodeIdx(parent);
+      if (last_op[stream_idx[producer]] == producer) {
+        s = stream_idx[producer];
+        break;
+      }
+    }
+    if (s < 0) {
+      if (last_op[0] < 0) {
+        s = 0;
+      } else if (static_cast<int>(last_op.size()) <= max_side_streams) {
+        s = last_op.size();
+        last_op.push_back(-1);
+      } else {
+        s = num_reused++ % last_op.size();
+      }
+    }
+    stream_idx[i] = s;
+    last_op[s] = i;
   }
+  if (last_op.size() < 2)
+    return;  // a single branch - nothing to overlap
 
-  // We know that this is the proper stream, we do not need to look it up in any workspace
-  CUDA_CALL(cudaEventRecord(gpu_stage_event_, gpu_op_stream_));
+  gpu_op_stream_idx_ = std::move(stream_idx);
+  gpu_streams_ = { gpu_op_stream_ };
+  gpu_join_events_ = { nullptr };
+  for (size_t s = 1; s < last_op.size(); s++) {
+    gpu_streams_.push_back(stream_pool_.GetStream());
+    gpu_join_events_.push_back(event_pool_.GetEvent());
+  }
+  gpu_fork_event_ = event_pool_.GetEvent();
 
-  // We do not release, but handle to used outputs
-  QueuePolicy::QueueOutputIdxs(gpu_idxs, gpu_op_stream_);
+  gpu_op_cross_stream_producers_.assign(num_ops, {});
+  gpu_op_events_.assign(num_ops, nullptr);
+  for (int i = 0; i < num_ops; i++) {
+    for (OpNodeId parent : graph_->Node(OpType::GPU, i).parents) {
+      if (graph_->NodeType(parent) != OpType::GPU)
+        continue;
+      int producer = graph_->NodeIdx(parent);
+      if (gpu_op_stream_idx_[producer] == gpu_op_stream_idx_[i])
+        continue;
+      gpu_op_cross_stream_producers_[i].push_back(producer);
+      if (!gpu_op_events_[producer])
+        gpu_op_events_[producer] = event_pool_.GetEvent();
+    }
+  }
+}
+
+namespace {
+
+/**
+ * @brief A device memory block shared by the buffers of one memory group
+ *
+ * The block grows to the largest request. A buffer, which allocated from a smaller block, keeps
+ * it until it has to grow, so the buffers of the group converge to one block.
+ */
+struct SharedGPUMemory {
+  shared_ptr<uint8_t> Get(size_t bytes) {
+    if (bytes > size) {
+      data = AllocBuffer<GPUBackend>(bytes, false);
+      size = bytes;
+    }
+    return data;
+  }
+
+  shared_ptr<uint8_t> data;
+  size_t size = 0;
+};
+
+}  // namespace
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::SetupGPUMemoryReuse() {
+  // the invariant outputs are shared by the iterations, so they keep their memory
+  auto outputs = graph_->GetOutputs(output_names_, true);
+  for (int i = 0; i < graph_->NumOp(OpType::GPU); i++) {
+    const OpNode &op_node = graph_->Node(OpType::GPU, i);
+    if (invariant_outputs_[op_node.id])
+      outputs.insert(outputs.end(), op_node.children_tensors.begin(),
+                     op_node.children_tensors.end());
+  }
+  auto groups = GetGPUMemoryGroups(*graph_, gpu_op_stream_idx_, outputs);
+  // (group, queue index) -> the shared block; the queue indices are used in separate iterations
+  std::map<std::pair<int, int>, std::shared_ptr<SharedGPUMemory>> blocks;
+  auto for_each_grouped = [&](auto &&fn) {
+    for (int tid = 0; tid < graph_->NumTensor(); tid++) {
+      if (groups[tid] < 0)
+        continue;
+      auto &queue = get_queue<OpType::GPU, StorageDevice::GPU>(tensor_to_store_queue_[tid]);
+      for (size_t i = 0; i < queue.size(); i++)
+        fn(*queue[i], blocks[{groups[tid], static_cast<int>(i)}]);
+    }
+  };
+  // the block starts at the largest of the sizes reserved with the hints
+  for_each_grouped([](TensorList<GPUBackend> &tl, std::shared_ptr<SharedGPUMemory> &block) {
+    if (!block)
+      block = std::make_shared<SharedGPUMemory>();
+    block->size = std::max(block->size, tl.capacity());
+  });
+  for_each_grouped([](TensorList<GPUBackend> &tl, std::shared_ptr<SharedGPUMemory> &block) {
+    if (!block->data && block->size > 0)
+      block->data = AllocBuffer<GPUBackend>(block->size, false);
+    size_t capacity = tl.capacity();
+    bool contiguous = tl.IsContiguous();
+    tl.Reset();
+    tl.set_alloc_func([block](size_t bytes) { return block->Get(bytes); });
+    if (capacity > 0)
+      tl.reserve(capacity);
+    tl.SetContiguous(contiguous);
+  });
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::SetupInvariantOutputs() {
+  invariant_outputs_.clear();
+  invariant_outputs_.resize(graph_->NumOp());
+  auto setup = [&](OpType op_type, int queue_depth) {
+    for (int i = 0; i < graph_->NumOp(op_type); i++) {
+      const OpNode &op_node = graph_->Node(op_type, i);
+      if (!op_node.op->HasInvariantOutputs() || op_node.spec.NumInput() > 0 ||
+          op_node.spec.NumOutput() == 0)
+        continue;
+      auto &outputs = invariant_outputs_[op_node.id];
+      outputs = std::make_unique<InvariantOutputs>();
+      outputs->holds.resize(queue_depth, false);
+    }
+  };
+  setup(OpType::CPU, stage_queue_depths_[OpType::CPU]);
+  // the captured graphs write the outputs of every op
+  if (!use_gpu_graphs_)
+    setup(OpType::GPU, stage_queue_depths_[OpType::GPU]);
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+bool Executor<WorkspacePolicy, QueuePolicy>::HasInvariantOutputs(OpNodeId id,
+                                                                 int batch_size) const {
+  if (invariant_outputs_.empty() || !invariant_outputs_[id])
+    return false;
+  std::lock_guard<std::mutex> lock(invariant_outputs_mutex_);
+  return invariant_outputs_[id]->batch_size == batch_size;
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+template <typename Workspace>
+bool Executor<WorkspacePolicy, QueuePolicy>::ReuseInvariantOutputs(const OpNode &op_node,
+                                                                   int queue_idx,
+                                                                   Workspace &ws) {
+  if (invariant_outputs_.empty() || !invariant_outputs_[op_node.id])
+    return false;
+  using Backend = std::conditional_t<std::is_same<Workspace, HostWorkspace>::value, CPUBackend,
+                                     GPUBackend>;
+  using Container = typename Workspace::template output_t<Backend>::element_type;
+  auto &outputs = *invariant_outputs_[op_node.id];
+  std::lock_guard<std::mutex> lock(invariant_outputs_mutex_);
+  bool reuse = outputs.batch_size == ws.GetRequestedBatchSize(0);
+  if (outputs.holds[queue_idx] == reuse)
+    return reuse;
+  for (int i = 0; i < ws.NumOutput(); i++) {
+    auto &out = ws.template OutputRef<Backend>(i);
+    out.Reset();
+    if (reuse)
+      out.ShareData(static_cast<Container *>(outputs.source[i]));
+  }
+  // the buffer of an earlier batch size may still be read by the iterations in flight,
+  // so the operator writes a fresh one
+  outputs.holds[queue_idx] = reuse;
+  return reuse;
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+template <typename Workspace>
+void Executor<WorkspacePolicy, QueuePolicy>::SaveInvariantOutputs(const OpNode &op_node,
+                                                                 int queue_idx, Workspace &ws) {
+  if (invariant_outputs_.empty() || !invariant_outputs_[op_node.id])
+    return;
+  using Backend = std::conditional_t<std::is_same<Workspace, HostWorkspace>::value, CPUBackend,
+                                     GPUBackend>;
+  auto &outputs = *invariant_outputs_[op_node.id];
+  std::lock_guard<std::mutex> lock(invariant_outputs_mutex_);
+  outputs.batch_size = ws.GetRequestedBatchSize(0);
+  outputs.source.resize(ws.NumOutput());
+  for (int i = 0; i < ws.NumOutput(); i++)
+    outputs.source[i] = &ws.template OutputRef<Backend>(i);
+  outputs.holds.assign(outputs.holds.size(), false);
+  outputs.holds[queue_idx] = true;
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::SetupCachedSubgraphs() {
+  cached_subgraphs_.clear();
+  skipped_ops_.clear();
+  auto outputs = graph_->GetOutputs(output_names_, true);
+  std::set<TensorNodeId> output_set(outputs.begin(), outputs.end());
+  for (int i = 0; i < graph_->NumOp(OpType::GPU); i++) {
+    const OpNode &cache_node = graph_->Node(OpType::GPU, i);
+    const auto &key_arg = cache_node.spec.GetSchema().CacheKeyArgument();
+    if (key_arg.empty())
+      continue;
+    auto key_input = cache_node.spec.ArgumentInputs().find(key_arg);
+    if (key_input == cache_node.spec.ArgumentInputs().end())
+      continue;  // without the keys, nothing is cached
+    CachedSubgraph subgraph;
+    subgraph.cache_op = i;
+    subgraph.keys = cache_node.parent_tensors[key_input->second];
+    OpNodeId key_producer = graph_->Tensor(subgraph.keys).producer.node;
+
+    // The cached inputs have to be computed from the samples identified by the keys only:
+    // the subgraph may read the outputs of the operator producing the keys and of
+    // the deterministic operators. The CPU operators are not skipped.
+    std::set<OpNodeId> visited, skipped;
+    std::vector<OpNodeId> stack;
+    for (int in = 0; in < cache_node.spec.NumRegularInput(); in++)
+      stack.push_back(graph_->Tensor(cache_node.parent_tensors[in]).producer.node);
+    while (!stack.empty()) {
+      OpNodeId id = stack.back();
+      stack.pop_back();
+      if (id == key_producer || !visited.insert(id).second)
+        continue;
+      const OpNode &node = graph_->Node(id);
+      DALI_ENFORCE(node.spec.GetSchema().IsDeterministic(), make_string(
+          "The operator \"", node.instance_name, "\" computes the input of \"",
+          cache_node.instance_name, "\", which caches it, but its results are not determined by "
+          "its inputs. Only the deterministic operators can be used to compute the cached data."));
+      if (node.op_type != OpType::CPU)
+        skipped.insert(id);
+      for (TensorNodeId t : node.parent_tensors)
+        stack.push_back(graph_->Tensor(t).producer.node);
+    }
+
+    // the skipped operators don't produce anything used elsewhere
+    for (OpNodeId id : skipped) {
+      const OpNode &node = graph_->Node(id);
+      for (TensorNodeId t : node.children_tensors) {
+        bool used_elsewhere = output_set.count(t) > 0;
+        for (auto &consumer : graph_->Tensor(t).consumers)
+          used_elsewhere |= consumer.node != cache_node.id && !skipped.count(consumer.node);
+        DALI_ENFORCE(!used_elsewhere, make_string(
+            "The output \"", graph_->Tensor(t).name, "\" of the operator \"",
+            node.instance_name, "\" is used by \"", cache_node.instance_name,
+            "\", which caches it, and elsewhere in the pipeline. Only the data used by the "
+            "caching operator alone can be cached."));
+      }
+    }
+    if (skipped.empty())
+      continue;
+    subgraph.ops.assign(skipped.begin(), skipped.end());
+    cached_subgraphs_.push_back(std::move(subgraph));
+  }
+  if (!cached_subgraphs_.empty()) {
+    skipped_ops_.resize(stage_queue_depths_[OpType::MIXED]);
+    for (auto &skipped : skipped_ops_)
+      skipped.assign(graph_->NumOp(), false);
+  }
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::MarkSkippedOps(QueueIdxs mixed_idxs,
+                                                             int batch_size) {
+  auto &skipped = skipped_ops_[mixed_idxs[OpType::MIXED]];
+  std::fill(skipped.begin(), skipped.end(), false);
+  std::vector<std::string> keys;
+  for (auto &subgraph : cached_subgraphs_) {
+    auto &queue = get_queue<OpType::CPU, StorageDevice::CPU>(
+        tensor_to_store_queue_[subgraph.keys]);
+    const auto &key_batch = *queue[mixed_idxs[OpType::CPU]];
+    keys.clear();
+    for (int i = 0; i < batch_size; i++)
+      keys.push_back(key_batch[i].GetSourceInfo());
+    if (!graph_->Node(OpType::GPU, subgraph.cache_op).op->HasCachedOutputs(keys))
+      continue;
+    for (OpNodeId id : subgraph.ops)
+      skipped[id] = true;
+  }
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+bool Executor<WorkspacePolicy, QueuePolicy>::CanCaptureGPUStage() const {
+  if (graph_->NumOp(OpType::GPU) == 0)
+    return false;
+  for (int i = 0; i < graph_->NumOp(OpType::GPU); i++) {
+    const OpNode &op_node = graph_->Node(OpType::GPU, i);
+    if (!op_node.op->CanBeCaptured())
+      return false;
+    // host outputs are produced when the operator runs, not when the graph is launched
+    for (int j = 0; j < op_node.spec.NumOutput(); j++) {
+      if (op_node.spec.OutputDevice(j) != "gpu")
+        return false;
+    }
+  }
+  return true;
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+StageSignature Executor<WorkspacePolicy, QueuePolicy>::GPUStageSignature(QueueIdxs gpu_idxs,
+                                                                         int batch_size) {
+  StageSignature sig;
+  sig.Append(batch_size);
+
+  auto append_meta = [&](const auto &data) {
+    sig.Append(data.type());
+    auto layout = data.GetLayout();
+    sig.Append(layout.size());
+    sig.AppendBytes(layout.c_str(), layout.size());
+    sig.Append(data.shape());
+  };
+  // the device data is referred to by address...
+  auto append_address = [&](const auto &data) {
+    append_meta(data);
+    for (int s = 0; s < static_cast<int>(data.ntensor()); s++)
+      sig.Append(data.raw_tensor(s));
+  };
+  // ...but the host data is consumed by the operators when the work is issued
+  auto append_contents = [&](const auto &data) {
+    append_meta(data);
+    auto shape = data.shape();
+    size_t type_size = data.type_info().size();
+    for (int s = 0; s < shape.num_samples(); s++)
+      sig.AppendBytes(data.raw_tensor(s), shape.tensor_size(s) * type_size);
+  };
+
+  for (int i = 0; i < graph_->NumOp(OpType::GPU); i++) {
+    OpNode &op_node = graph_->Node(OpType::GPU, i);
+    const auto &spec = op_node.spec;
+    typename WorkspacePolicy::template ws_t<OpType::GPU> ws =
+        WorkspacePolicy::template GetWorkspace<OpType::GPU>(gpu_idxs, *graph_, i);
+    for (int j = 0; j < spec.NumRegularInput(); j++) {
+      if (ws.template InputIsType<GPUBackend>(j))
+        append_address(ws.template InputRef<GPUBackend>(j));
+      else
+        append_contents(ws.template InputRef<CPUBackend>(j));
+    }
+    for (int j = spec.NumRegularInput(); j < spec.NumInput(); j++) {
+      const auto &arg_name = spec.ArgumentInputName(j);
+      if (ws.ArgumentInputIsGPU(arg_name))
+        append_address(ws.GPUArgumentInput(arg_name));
+      else
+        append_contents(ws.ArgumentInput(arg_name));
+    }
+    for (int j = 0; j < ws.NumOutput(); j++)
+      append_address(ws.template OutputRef<GPUBackend>(j));
+  }
+  return sig;
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::LaunchGPUGraph(QueueIdxs gpu_idxs, int batch_size,
+                                                            cudaGraphExec_t graph) {
+  // The dependencies on the other stages are not a part of the graph
+  for (int i = 0; i < graph_->NumOp(OpType::GPU); i++) {
+    typename WorkspacePolicy::template ws_t<OpType::GPU> ws =
+        WorkspacePolicy::template GetWorkspace<OpType::GPU>(gpu_idxs, *graph_, i);
+    ws.SetBatchSizes(batch_size);
+    for (auto &event : ws.ParentEvents())
+      CUDA_CALL(cudaStreamWaitEvent(gpu_op_stream_, event, 0));
+  }
+
+  CUDA_CALL(cudaGraphLaunch(graph, gpu_op_stream_));
+
+  // The events of the operators can't be recorded inside the graph - they mark the end
+  // of the whole graph instead
+  for (int i = 0; i < graph_->NumOp(OpType::GPU); i++) {
+    typename WorkspacePolicy::template ws_t<OpType::GPU> ws =
+        WorkspacePolicy::template GetWorkspace<OpType::GPU>(gpu_idxs, *graph_, i);
+    if (ws.has_event())
+      CUDA_CALL(cudaEventRecord(ws.event(), gpu_op_stream_));
+  }
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+bool Executor<WorkspacePolicy, QueuePolicy>::CaptureGPUStage(QueueIdxs gpu_idxs, int batch_size,
+                                                             GPUGraphCache::Entry &entry) {
+  // The other stages may still write to the inputs - the work captured here is not issued yet,
+  // so it's enough to wait when the graph is launched.
+  CUDAGraph graph;
+  std::string error;
+  {
+    kernels::ScratchpadCapture capture(&gpu_graphs_.RetainedScratch());
+    try {
+      CUDA_CALL(cudaStreamBeginCapture(gpu_op_stream_, cudaStreamCaptureModeRelaxed));
+      for (int i = 0; i < graph_->NumOp(OpType::GPU); ++i) {
+        OpNode &op_node = graph_->Node(OpType::GPU, i);
+        typename WorkspacePolicy::template ws_t<OpType::GPU> ws =
+            WorkspacePolicy::template GetWorkspace<OpType::GPU>(gpu_idxs, *graph_, i);
+        ws.SetBatchSizes(batch_size);
+        DALI_TRACE_RANGE(kTraceOperator,
+                         make_string("[DALI][GPU op capture] ", op_node.instance_name,
+                                     " batch ", batch_size),
+                         RangeBase::knvGreen);
+        RunHelper(op_node, ws);
+      }
+    } catch (std::exception &e) {
+      error = e.what();
+    } catch (...) {
+      error = "Unknown exception";
+    }
+    cudaGraph_t g = nullptr;
+    cudaError_t err = cudaStreamEndCapture(gpu_op_stream_, &g);
+    graph.reset(g);
+    if (err != cudaSuccess) {
+      cudaGetLastError();  // clear the error - the stage is re-run without the capture
+      if (error.empty())
+        error = cudaGetErrorString(err);
+    }
+  }
+
+  CUDAGraphExec exec;
+  if (error.empty()) {
+    try {
+      exec = CUDAGraphExec::Instantiate(graph);
+    } catch (std::exception &e) {
+      cudaGetLastError();
+      error = e.what();
+    }
+  }
+
+  if (!error.empty()) {
+    // An error which isn't related to the capture is reported when the operators are re-run
+    DALI_WARN(make_string("The GPU stage could not be captured into a CUDA graph - the graphs "
+                          "are disabled. The error:\n", error));
+    use_gpu_graphs_ = false;
+    gpu_graphs_.Clear();
+    return false;
+  }
+
+  gpu_graphs_.SetGraph(entry, GPUStageSignature(gpu_idxs, batch_size), std::move(exec));
+  LaunchGPUGraph(gpu_idxs, batch_size, entry.graph);
+  return true;
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::RunGPUGraphs(QueueIdxs gpu_idxs, int batch_size,
+                                                           int64_t iteration) {
+  // The previous iteration of the stage has completed (see gpu_stage_event_), so none of
+  // the graphs is running now and the cache can be modified freely.
+  try {
+    auto *entry = gpu_graphs_.Find(GPUStageSignature(gpu_idxs, batch_size));
+    if (entry && entry->graph) {
+      DALI_TRACE_RANGE(kTraceOperator, make_string("[DALI][GPU graph launch] #", iteration,
+                                                   " batch ", batch_size),
+                       RangeBase::knvGreen);
+      LaunchGPUGraph(gpu_idxs, batch_size, entry->graph);
+      CUDA_CALL(cudaGetLastError());
+      return;
+    }
+    // The state is captured only when it repeats - the first run allocates the buffers
+    if (entry && CaptureGPUStage(gpu_idxs, batch_size, *entry)) {
+      CUDA_CALL(cudaGetLastError());
+      return;
+    }
+  } catch (std::exception &e) {
+    HandleError(make_string("Error when executing the GPU stage graph:\n", e.what()));
+    return;
+  }
+
+  if (gpu_graphs_.HasGraphs()) {
+    // The operators mustn't overwrite the scratch memory used by the graphs
+    kernels::ScratchpadCapture capture(&gpu_graphs_.RetainedScratch());
+    RunGPUOps(gpu_idxs, batch_size, iteration);
+  } else {
+    RunGPUOps(gpu_idxs, batch_size, iteration);
+  }
+
+  if (use_gpu_graphs_ && !exec_error_) {
+    try {
+      auto sig = GPUStageSignature(gpu_idxs, batch_size);
+      if (!gpu_graphs_.Find(sig))
+        gpu_graphs_.Add(std::move(sig));
+    } catch (std::exception &e) {
+      HandleError(make_string("Error when executing the GPU stage graph:\n", e.what()));
+    }
+  }
 }
 
 template <typename WorkspacePolicy, typename QueuePolicy>
@@ -279,12 +1238,34 @@ void Executor<WorkspacePolicy, QueuePolicy>::RunGPU() {
 template <typename WorkspacePolicy, typename QueuePolicy>
 template <typename Workspace>
 void Executor<WorkspacePolicy, QueuePolicy>::RunHelper(OpNode &op_node, Workspace &ws) {
+  SmallVector<int, 16> empty_layout_in_idxs;
+  SetupHelper(op_node, ws, &empty_layout_in_idxs);
+  op_node.op->Run(ws);
+  ResetDefaultLayouts(ws, empty_layout_in_idxs);
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+template <typename Workspace>
+void Executor<WorkspacePolicy, QueuePolicy>::SetupHelper(
+    OpNode &op_node, Workspace &ws, SmallVector<int, 16> *empty_layout_in_idxs) {
   auto &output_desc = op_node.output_desc;
   auto &op = *op_node.op;
   output_desc.clear();
   const auto &spec = op.GetSpec();
   const auto &schema = spec.GetSchema();
-  SmallVector<int, 16> empty_layout_in_idxs;
+
+  // The metadata of the previous operator in this stage is no longer needed;
+  // the stages run in separate threads, so each uses its own arena.
+  // With the dataflow or the depth-first mode, the runs of the CPU operators overlap,
+  // so they need separate arenas.
+  // With the early setup, the GPU operators are set up before the previous ones run.
+  auto &host_scratch = op_node.op_type == OpType::CPU && !cpu_op_scratch_.empty()
+                           ? cpu_op_scratch_[op_node.partition_index]
+                     : op_node.op_type == OpType::GPU && !gpu_op_scratch_.empty()
+                           ? gpu_op_scratch_[op_node.partition_index]
+                           : host_scratch_[static_cast<int>(op_node.op_type)];
+  host_scratch.reset();
+  ws.SetHostScratch(&host_scratch);
 
   for (int i = 0; i < ws.NumInput(); i++) {
     DALI_ENFORCE(
@@ -298,14 +1279,14 @@ void Executor<WorkspacePolicy, QueuePolicy>::RunHelper(OpNode &op_node, Workspac
                              ws.GetRequestedBatchSize(i), " <= ", max_batch_size_));
   }
 
-  for (int i = 0; i < spec.NumRegularInput(); i++) {
+  for (int i = 0; empty_layout_in_idxs && i < spec.NumRegularInput(); i++) {
     bool had_empty_layout = false;
     if (ws.template InputIsType<CPUBackend>(i)) {
       had_empty_layout = SetDefaultLayoutIfNeeded(ws.template InputRef<CPUBackend>(i), schema, i);
     } else {
       had_empty_layout = SetDefaultLayoutIfNeeded(ws.template InputRef<GPUBackend>(i), schema, i);
     }
-    if (had_empty_layout) empty_layout_in_idxs.push_back(i);
+    if (had_empty_layout) empty_layout_in_idxs->push_back(i);
   }
   if (op.Setup(output_desc, ws)) {
     DALI_ENFORCE(
@@ -321,8 +1302,11 @@ void Executor<WorkspacePolicy, QueuePolicy>::RunHelper(OpNode &op_node, Workspac
         ws.template OutputRef<CPUBackend>(i).Resize(desc.shape);
         ws.template OutputRef<CPUBackend>(i).set_type(desc.type);
       } else {
-        ws.template OutputRef<GPUBackend>(i).Resize(desc.shape);
-        ws.template OutputRef<GPUBackend>(i).set_type(desc.type);
+        auto &out = ws.template OutputRef<GPUBackend>(i);
+        if (!BindExternalOutput(op_node, i, &desc, out)) {
+          out.Resize(desc.shape);
+          out.set_type(desc.type);
+        }
       }
     }
   } else {
@@ -330,10 +1314,180 @@ void Executor<WorkspacePolicy, QueuePolicy>::RunHelper(OpNode &op_node, Workspac
                  "Operator::Setup returned false indicating that it cannot calculate shape and "
                  "type information for Operator outputs. In that case CanInferOutputs should "
                  "always return false.");
+    for (int i = 0; i < ws.NumOutput(); i++) {
+      if (!ws.template OutputIsType<CPUBackend>(i))
+        BindExternalOutput(op_node, i, nullptr, ws.template OutputRef<GPUBackend>(i));
+    }
+  }
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+bool Executor<WorkspacePolicy, QueuePolicy>::BindExternalOutput(const OpNode &op_node,
+                                                                int output_idx,
+                                                                const OutputDesc *desc,
+                                                                TensorList<GPUBackend> &out) {
+  std::lock_guard<std::mutex> lock(external_outputs_mutex_);
+  if (external_outputs_.empty() && external_bound_.empty())
+    return false;
+  bool was_bound = external_bound_.erase(&out) > 0;
+  TensorNodeId tid = op_node.children_tensors[output_idx];
+  auto it = external_outputs_.find(tid);
+  // the invariant outputs are shared between the queue slots
+  bool invariant = !invariant_outputs_.empty() && invariant_outputs_[op_node.id];
+  if (desc && it != external_outputs_.end() && !invariant) {
+    auto find_slot = [&](const auto &queue) {
+      for (int q = 0; q < static_cast<int>(queue.size()); q++) {
+        if (queue[q].get() == &out)
+          return q;
+      }
+      return -1;
+    };
+    auto &storage = tensor_to_store_queue_[tid];
+    int slot = op_node.op_type == OpType::MIXED
+        ? find_slot(get_queue<OpType::MIXED, StorageDevice::GPU>(storage))
+        : find_slot(get_queue<OpType::GPU, StorageDevice::GPU>(storage));
+    size_t bytes = desc->shape.num_elements() * TypeTable::GetTypeInfo(desc->type).size();
+    if (slot >= 0 && slot < static_cast<int>(it->second.size()) &&
+        bytes <= it->second[slot].bytes) {
+      auto &buffer = it->second[slot];
+      out.ShareData(buffer.data, buffer.bytes, desc->shape, desc->type);
+      out.set_device_id(device_id_);
+      external_bound_.insert(&out);
+      return true;
+    }
+  }
+  if (was_bound)
+    out.Reset();  // back to own memory - the buffer may be in use by the caller
+  return false;
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::PackSmallTransfers(QueueIdxs mixed_idxs) {
+  int num_mixed = graph_->NumOp(OpType::MIXED);
+  packed_transfers_.clear();
+  packed_transfers_.resize(num_mixed);
+  int queue_idx = mixed_idxs[OpType::MIXED];
+  int64_t total_bytes = 0;
+  int num_packed = 0;
+  for (int i = 0; i < num_mixed; i++) {
+    OpNode &op_node = graph_->Node(OpType::MIXED, i);
+    if (op_node.spec.name() != "MakeContiguous" || IsSkipped(queue_idx, op_node.id))
+      continue;
+    {
+      // the output must be written to the external buffer
+      std::lock_guard<std::mutex> lock(external_outputs_mutex_);
+      if (external_outputs_.count(op_node.children_tensors[0]))
+        continue;
+    }
+    auto ws = WorkspacePolicy::template GetWorkspace<OpType::MIXED>(mixed_idxs, *graph_, i);
+    const auto &input = ws.template InputRef<CPUBackend>(0);
+    int nsamples = input.ntensor();
+    if (nsamples == 0)
+      continue;
+    // the inconsistent batches are left to the operator, which reports them
+    DALIDataType type = input[0].type();
+    int sample_dim = input[0].shape().sample_dim();
+    int64_t bytes = 0;
+    bool packable = true;
+    for (int s = 0; s < nsamples && packable; s++) {
+      bytes += input[s].nbytes();
+      packable = input[s].type() == type && input[s].shape().sample_dim() == sample_dim &&
+                 bytes <= kMaxPackedTransferBytes;
+    }
+    if (!packable || bytes == 0)
+      continue;
+    total_bytes = align_up(total_bytes, kPackedTransferAlignment);
+    packed_transfers_[i] = { &input, total_bytes, bytes };
+    total_bytes += bytes;
+    num_packed++;
+  }
+  if (num_packed < 2) {
+    // nothing to save - the operators copy their batches themselves
+    packed_transfers_.assign(num_mixed, {});
+    return;
   }
 
-  op.Run(ws);
+  DomainTimeRange tr("[DALI][Executor] Packed H2D transfer", DomainTimeRange::kBlue);
+  // the previous Mixed stage is complete, so the staging buffer is no longer in use
+  packed_staging_.set_pinned(true);
+  packed_staging_.Resize({ total_bytes }, DALI_UINT8);
+  auto *staging = packed_staging_.mutable_data<uint8_t>();
+  for (auto &transfer : packed_transfers_) {
+    if (!transfer.input)
+      continue;
+    auto *dst = staging + transfer.offset;
+    for (size_t s = 0; s < transfer.input->ntensor(); s++) {
+      const auto &sample = (*transfer.input)[s];
+      std::memcpy(dst, sample.raw_data(), sample.nbytes());
+      dst += sample.nbytes();
+    }
+  }
 
+  // the queue slot is free, so are the views of its previous device buffer; if the buffer
+  // grows, the views still in use elsewhere keep the old one alive
+  if (static_cast<int>(packed_device_.size()) <= queue_idx)
+    packed_device_.resize(queue_idx + 1);
+  auto &device = packed_device_[queue_idx];
+  device.Resize({ total_bytes }, DALI_UINT8);
+  CUDA_CALL(cudaMemcpyAsync(device.raw_mutable_data(), staging, total_bytes,
+                            cudaMemcpyHostToDevice, mixed_op_stream_));
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::UsePackedTransfer(int mixed_op_idx, int queue_idx,
+                                                               MixedWorkspace &ws) {
+  const auto &transfer = packed_transfers_[mixed_op_idx];
+  const auto &input = *transfer.input;
+  auto &output = ws.template OutputRef<GPUBackend>(0);
+  auto &device = packed_device_[queue_idx];
+  auto *ptr = static_cast<uint8_t *>(device.raw_mutable_data()) + transfer.offset;
+  output.Reset();
+  output.ShareData(shared_ptr<void>(device.get_data_ptr(), ptr), transfer.bytes, input.shape(),
+                   input[0].type());
+  output.set_device_id(device_id_);
+  output.SetLayout(input.GetLayout());
+  for (int s = 0; s < static_cast<int>(input.ntensor()); s++) {
+    output.SetSourceInfo(s, input[s].GetSourceInfo());
+    output.SetSkipSample(s, input[s].ShouldSkipSample());
+  }
+  packed_outputs_.insert(&output);
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::SetExternalOutputBuffers(
+      int output_idx, std::vector<ExternalOutputBuffer> buffers) {
+  DALI_ENFORCE(graph_, "The executor must be built before setting the external output buffers.");
+  DALI_ENFORCE(output_idx >= 0 && output_idx < static_cast<int>(pipeline_outputs_.size()),
+               make_string("Output index ", output_idx, " out of range [0, ",
+                           pipeline_outputs_.size(), ")."));
+  TensorNodeId tid = pipeline_outputs_[output_idx];
+  auto &tensor = graph_->Tensor(tid);
+  DALI_ENFORCE(tensor.producer.storage_device == StorageDevice::GPU,
+               make_string("Only the GPU outputs can be written to external buffers; the output ",
+                           output_idx, " is a CPU one."));
+  OpType op_type = graph_->Node(tensor.producer.node).op_type;
+  DALI_ENFORCE(op_type != OpType::GPU || !use_gpu_graphs_,
+               "The external output buffers can't be used when the GPU stage is captured into "
+               "CUDA graphs - the graphs would keep writing to the buffers used when captured.");
+  int depth = stage_queue_depths_[op_type];
+  DALI_ENFORCE(buffers.empty() || static_cast<int>(buffers.size()) == depth,
+               make_string("Expected ", depth, " external buffers for the output ", output_idx,
+                           " - one for each output buffer of the producing stage - got ",
+                           buffers.size(), "."));
+  for (auto &buffer : buffers)
+    DALI_ENFORCE(buffer.data || buffer.bytes == 0, "The external output buffer is null.");
+
+  std::lock_guard<std::mutex> lock(external_outputs_mutex_);
+  if (buffers.empty())
+    external_outputs_.erase(tid);
+  else
+    external_outputs_[tid] = std::move(buffers);
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+template <typename Workspace>
+void Executor<WorkspacePolicy, QueuePolicy>::ResetDefaultLayouts(
+    Workspace &ws, const SmallVector<int, 16> &empty_layout_in_idxs) {
   for (int i : empty_layout_in_idxs) {
     if (ws.template InputIsType<CPUBackend>(i)) {
       auto &in = ws.template InputRef<CPUBackend>(i);
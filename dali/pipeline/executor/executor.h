@@ -15,10 +15,15 @@
 #ifndef DALI_PIPELINE_EXECUTOR_EXECUTOR_H_
 #define DALI_PIPELINE_EXECUTOR_EXECUTOR_H_
 
+#include <array>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <map>
 #include <memory>
 #include <queue>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -26,9 +31,17 @@
 #include <mutex>
 
 #include "dali/core/common.h"
+#include "dali/core/cuda_event.h"
+#include "dali/core/cuda_stream.h"
 #include "dali/core/error_handling.h"
+#include "dali/core/mm/malloc_resource.h"
+#include "dali/core/mm/monotonic_resource.h"
 #include "dali/core/nvtx.h"
+#include "dali/core/small_vector.h"
+#include "dali/kernels/scratch_arena.h"
 #include "dali/pipeline/data/backend.h"
+#include "dali/pipeline/executor/gpu_graph_cache.h"
+#include "dali/pipeline/executor/health_monitor.h"
 #include "dali/pipeline/executor/queue_metadata.h"
 #include "dali/pipeline/executor/queue_policy.h"
 #include "dali/pipeline/executor/workspace_policy.h"
@@ -38,6 +51,7 @@
 #include "dali/pipeline/operator/batch_size_provider.h"
 #include "dali/pipeline/operator/common.h"
 #include "dali/pipeline/util/event_pool.h"
+#include "dali/pipeline/util/size_histogram.h"
 #include "dali/pipeline/util/stream_pool.h"
 #include "dali/pipeline/util/thread_pool.h"
 #include "dali/pipeline/workspace/device_workspace.h"
@@ -52,8 +66,40 @@ struct DLL_PUBLIC ExecutorMeta {
   size_t max_real_size;
   size_t reserved;
   size_t max_reserved;
+  /// the size of a sample not exceeded by SizeHistogram::kDefaultPercentile of the samples
+  size_t sample_size_hint;
 };
 using ExecutorMetaMap = std::unordered_map<std::string, std::vector<ExecutorMeta>>;
+using SampleSizeHistograms = std::unordered_map<std::string, std::vector<SizeHistogram>>;
+
+/**
+ * @brief Timing statistics of an operator or, for the `STAGE_<stage>` entries, of a stage
+ *
+ * The times are in seconds. For Mixed and GPU operators `total_time` covers only the host part
+ * (the work issue) - the time spent on the device is measured with CUDA events and reported
+ * as `gpu_time`, for `gpu_iterations` of the runs.
+ */
+struct DLL_PUBLIC ExecutorTimingMeta {
+  int64_t iterations = 0;
+  int64_t samples = 0;
+  double total_time = 0;
+  double max_time = 0;
+  int64_t gpu_iterations = 0;
+  double gpu_time = 0;
+  /// time spent waiting for the queue buffers; only for the stages
+  double wait_time = 0;
+  /// the current values of the numeric diagnostics registered by the operator
+  std::map<std::string, double> diagnostics;
+};
+using ExecutorTimingMetaMap = std::unordered_map<std::string, ExecutorTimingMeta>;
+
+/**
+ * @brief A caller-owned device buffer, to which an output of the pipeline can be written
+ */
+struct ExternalOutputBuffer {
+  void *data = nullptr;
+  size_t bytes = 0;
+};
 
 namespace detail {
 // This is stream callback used on GPU stream to indicate that GPU work for this
@@ -76,10 +122,28 @@ class DLL_PUBLIC ExecutorBase {
   DLL_PUBLIC virtual void RunGPU() = 0;
   DLL_PUBLIC virtual void Outputs(DeviceWorkspace *ws) = 0;
   DLL_PUBLIC virtual void ShareOutputs(DeviceWorkspace *ws) = 0;
-  DLL_PUBLIC virtual void ReleaseOutputs() = 0;
+  DLL_PUBLIC virtual cudaEvent_t ShareOutputsAsync(DeviceWorkspace *ws) = 0;
+  DLL_PUBLIC virtual cudaEvent_t ShareOutputsAsync(DeviceWorkspace *ws, int *output_id) = 0;
+  DLL_PUBLIC virtual void ReleaseOutputs(cudaEvent_t consumer_event = nullptr) = 0;
+  DLL_PUBLIC virtual void ReleaseOutputs(int output_id, cudaEvent_t consumer_event) = 0;
+  DLL_PUBLIC virtual void SetExternalOutputBuffers(int output_idx,
+                                                   std::vector<ExternalOutputBuffer> buffers) = 0;
   DLL_PUBLIC virtual void SetCompletionCallback(ExecutorCallback cb) = 0;
   DLL_PUBLIC virtual void EnableMemoryStats(bool enable_memory_stats = false) = 0;
+  DLL_PUBLIC virtual void EnableTimingStats(bool enable_timing_stats = false) = 0;
+  DLL_PUBLIC virtual void EnableAdaptiveQueueDepth(QueueSizes min_queue_depth) = 0;
+  DLL_PUBLIC virtual void EnableCudaGraphs(bool enable_cuda_graphs = false) = 0;
+  DLL_PUBLIC virtual void EnableCPUDataflow(bool enable_cpu_dataflow = false) = 0;
+  DLL_PUBLIC virtual void EnableCPUDepthFirst(bool enable_cpu_depth_first = false) = 0;
+  DLL_PUBLIC virtual void EnableConcurrentCPUIterations(bool enable = false) = 0;
+  DLL_PUBLIC virtual void EnableMemoryReuse(bool enable = false) = 0;
+  DLL_PUBLIC virtual void EnableEarlyGPUSetup(bool enable = false) = 0;
+  DLL_PUBLIC virtual void EnableSharedScratch(bool enable = false) = 0;
+  DLL_PUBLIC virtual void EnableLowLatency(bool enable = false) = 0;
+  DLL_PUBLIC virtual void SetThreadPoolWeight(double weight) = 0;
   DLL_PUBLIC virtual ExecutorMetaMap GetExecutorMeta() = 0;
+  DLL_PUBLIC virtual ExecutorTimingMetaMap GetExecutorTimingMeta() = 0;
+  DLL_PUBLIC virtual PipelineHealth GetHealth() = 0;
 
  protected:
   // virtual to allow the TestPruneWholeGraph test in gcc
@@ -101,27 +165,154 @@ class DLL_PUBLIC Executor : public ExecutorBase, public WorkspacePolicy, public
   DLL_PUBLIC inline Executor(int max_batch_size, int num_thread, int device_id,
                              size_t bytes_per_sample_hint, bool set_affinity = false,
                              int max_num_stream = -1, int default_cuda_stream_priority = 0,
-                             QueueSizes prefetch_queue_depth = QueueSizes{2, 2})
+                             QueueSizes prefetch_queue_depth = QueueSizes{2, 2},
+                             bool share_thread_pool = false)
       : max_batch_size_(max_batch_size),
         device_id_(device_id),
         bytes_per_sample_hint_(bytes_per_sample_hint),
         callback_(nullptr),
+        max_num_stream_(max_num_stream),
         stream_pool_(max_num_stream, true, default_cuda_stream_priority),
         event_pool_(),
-        thread_pool_(num_thread, device_id, set_affinity),
+        thread_pool_(num_thread, device_id, set_affinity, share_thread_pool),
         exec_error_(false),
         queue_sizes_(prefetch_queue_depth),
         mixed_op_stream_(0),
         gpu_op_stream_(0),
-        enable_memory_stats_(false) {
+        enable_memory_stats_(false),
+        enable_timing_stats_(false) {
     DALI_ENFORCE(max_batch_size_ > 0, "Max batch size must be greater than 0.");
 
     stage_queue_depths_ = QueuePolicy::GetQueueSizes(prefetch_queue_depth);
+    for (auto &scratch : host_scratch_)
+      scratch = mm::monotonic_host_resource(&mm::malloc_memory_resource::instance(),
+                                            kHostScratchBlockSize);
+  }
+
+  DLL_PUBLIC ~Executor() noexcept(false) override {
+    // the CPU iterations in flight use the members destroyed before the runners
+    StopCPUIterations();
   }
 
   DLL_PUBLIC void EnableMemoryStats(bool enable_memory_stats = false) override {
     enable_memory_stats_ = enable_memory_stats;
   }
+  DLL_PUBLIC void EnableTimingStats(bool enable_timing_stats = false) override {
+    enable_timing_stats_ = enable_timing_stats;
+  }
+  /**
+   * @brief Lets the queue policy adjust the number of buffers in use between
+   *        `min_queue_depth` and the prefetch queue depth. Must be called before Build().
+   */
+  DLL_PUBLIC void EnableAdaptiveQueueDepth(QueueSizes min_queue_depth) override {
+    QueuePolicy::EnableAdaptiveQueueDepth(min_queue_depth);
+  }
+  /**
+   * @brief Lets the executor capture the GPU stage into CUDA graphs and replay them
+   *        while the shapes and the arguments stay the same. Must be called before Build().
+   *
+   * The graphs are used only if all the GPU operators can be captured
+   * (see OperatorBase::CanBeCaptured).
+   */
+  DLL_PUBLIC void EnableCudaGraphs(bool enable_cuda_graphs = false) override {
+    enable_cuda_graphs_ = enable_cuda_graphs;
+  }
+  /**
+   * @brief Lets the executor run the independent CPU operators concurrently. Must be called
+   *        before Build().
+   *
+   * An operator is started as soon as the CPU operators producing its inputs finish; when more
+   * operators are ready, the ones on the longest path to the end of the CPU stage go first.
+   * The operators still share the thread pool for their per-sample work.
+   */
+  DLL_PUBLIC void EnableCPUDataflow(bool enable_cpu_dataflow = false) override {
+    enable_cpu_dataflow_ = enable_cpu_dataflow;
+  }
+  /**
+   * @brief Lets the executor run the chains of per-sample CPU operators depth-first. Must be
+   *        called before Build().
+   *
+   * When an operator implemented per sample (see Operator<CPUBackend>::RunsPerSample) has
+   * a single input, produced by another such operator, each thread runs a sample through both
+   * (or through a longer chain) before taking the next one, so the intermediate data stays in
+   * the CPU cache. The operators in the chain (except the first one) can't infer their output
+   * shapes in Setup and their inputs don't get the default layouts.
+   * It can't be combined with EnableCPUDataflow.
+   */
+  DLL_PUBLIC void EnableCPUDepthFirst(bool enable_cpu_depth_first = false) override {
+    enable_cpu_depth_first_ = enable_cpu_depth_first;
+  }
+  /**
+   * @brief Lets the CPU stage of a CPU-only pipeline run several iterations at once. Must be
+   *        called before Build().
+   *
+   * RunCPU doesn't wait for the iteration to finish: an operator runs an iteration as soon as
+   * it has finished the previous one and the operators producing its inputs have finished this
+   * one, so the operators work on different iterations at the same time. The number of
+   * the iterations in flight is bounded by the CPU prefetch queue depth and the outputs are
+   * returned in order. The operators share the thread pool for their per-sample work.
+   * It can't be combined with EnableCPUDataflow or EnableCPUDepthFirst.
+   */
+  DLL_PUBLIC void EnableConcurrentCPUIterations(bool enable = false) override {
+    enable_concurrent_cpu_iterations_ = enable;
+  }
+  /**
+   * @brief Lets the intermediate GPU buffers, which are not used at the same time, share
+   *        memory. Must be called before Build().
+   *
+   * The buffers produced and consumed by the GPU operators issued to the same stream are
+   * grouped by their live ranges (see GetGPUMemoryGroups) and the buffers in a group are
+   * allocated from one block, sized to the largest of them. The pipeline outputs and the buffers
+   * passed through to other operators keep their own memory.
+   */
+  DLL_PUBLIC void EnableMemoryReuse(bool enable = false) override {
+    enable_memory_reuse_ = enable;
+  }
+  /**
+   * @brief Sets up the GPU operators, whose output shapes can be found before any GPU work is
+   *        issued, at the start of the GPU stage. Must be called before Build().
+   *
+   * An operator is set up early if it can infer its outputs and so can all GPU operators
+   * producing its inputs. Their outputs are allocated before the first kernel of the stage is
+   * launched, so the kernels are issued back to back. The inputs of the operators set up early
+   * don't get the default layouts and their reported time doesn't include the setup.
+   */
+  DLL_PUBLIC void EnableEarlyGPUSetup(bool enable = false) override {
+    enable_early_gpu_setup_ = enable;
+  }
+  /**
+   * @brief Lets the GPU operators issued to the same stream share the device scratch memory of
+   *        their kernels (see kernels::ScratchArena). Must be called before Build().
+   *
+   * The arena is released after each operator, so it's only as large as the largest scratch
+   * requirement of a single operator, instead of the sum of them. The peak scratch usage of
+   * each GPU operator is reported as the `max_scratch_size` diagnostic in the timing statistics.
+   * Not used when the GPU stage is captured into CUDA graphs.
+   */
+  DLL_PUBLIC void EnableSharedScratch(bool enable = false) override {
+    enable_shared_scratch_ = enable;
+  }
+  /**
+   * @brief Tunes the executor for the latency of a single iteration, e.g. when serving
+   *        batches of 1. Must be called before Build().
+   *
+   * When there's just one job, the per-sample work of the CPU operators is run on the calling
+   * thread (see ThreadPool::SetInlineSingleJob). The host waits for the previous iterations of
+   * the stages and for the outputs by polling the CUDA events for a short while before it
+   * blocks, so it doesn't pay for being woken up. It's meant for the executor which runs all
+   * the stages on the calling thread (not pipelined, not async).
+   */
+  DLL_PUBLIC void EnableLowLatency(bool enable = false) override {
+    enable_low_latency_ = enable;
+    thread_pool_.SetInlineSingleJob(enable);
+  }
+  /**
+   * @brief Sets the share of the shared worker threads the CPU operators get, when the thread
+   *        pool is shared with other pipelines (see ThreadPool::SetWeight)
+   */
+  DLL_PUBLIC void SetThreadPoolWeight(double weight) override {
+    thread_pool_.SetWeight(weight);
+  }
   DLL_PUBLIC void Build(OpGraph *graph, vector<string> output_names) override;
   DLL_PUBLIC void Init() override {}
   DLL_PUBLIC void RunCPU() override;
@@ -129,9 +320,61 @@ class DLL_PUBLIC Executor : public ExecutorBase, public WorkspacePolicy, public
   DLL_PUBLIC void RunGPU() override;
   DLL_PUBLIC void Outputs(DeviceWorkspace *ws) override;
   DLL_PUBLIC void ShareOutputs(DeviceWorkspace *ws) override;
-  DLL_PUBLIC void ReleaseOutputs() override;
+  /**
+   * @brief Fills the workspace with the outputs without waiting for the GPU work producing them
+   *
+   * @return The event recorded after the work producing the GPU outputs (of both the Mixed and
+   *         the GPU stage) or nullptr, if there are no GPU outputs. The consumer should make its
+   *         stream wait on the event before accessing the outputs.
+   */
+  DLL_PUBLIC cudaEvent_t ShareOutputsAsync(DeviceWorkspace *ws) override;
+  /**
+   * @brief Like ShareOutputsAsync(ws), but also returns the id of the outputs, which can be
+   *        used to release them with ReleaseOutputs(output_id, consumer_event).
+   *
+   * Several outputs can be held this way at the same time (up to the prefetch queue depth)
+   * and released in any order.
+   */
+  DLL_PUBLIC cudaEvent_t ShareOutputsAsync(DeviceWorkspace *ws, int *output_id) override;
+  /**
+   * @brief Releases the oldest of the outputs returned by the (Share)Outputs calls
+   *
+   * @param consumer_event If not null, the event recorded after the consumer's work which uses
+   *                       the outputs; the buffers are not overwritten until it completes.
+   *                       The event may be reused as soon as this function returns.
+   */
+  DLL_PUBLIC void ReleaseOutputs(cudaEvent_t consumer_event = nullptr) override;
+  /**
+   * @brief Releases the outputs with given id, returned by ShareOutputsAsync(ws, output_id)
+   */
+  DLL_PUBLIC void ReleaseOutputs(int output_id, cudaEvent_t consumer_event) override;
+  /**
+   * @brief Makes the operator producing the GPU output `output_idx` write it directly to
+   *        the caller's buffers
+   *
+   * There's one buffer for each output buffer of the producing stage (i.e. the prefetch queue
+   * depth of the stage), so a buffer is not overwritten until the outputs stored in it are
+   * released. The data of an output can be checked to find out which buffer holds it.
+   * The output is written to a buffer only when the operator infers the output shape
+   * (see OperatorBase::CanInferOutputs) and the batch fits in the buffer; otherwise it's
+   * stored in DALI's memory, as usual, and has to be copied.
+   *
+   * The buffers apply to the iterations set up after the call; an empty list stops using
+   * the external buffers. The caller must keep the buffers alive until the outputs stored in
+   * them are released and the buffers are replaced.
+   */
+  DLL_PUBLIC void SetExternalOutputBuffers(int output_idx,
+                                           std::vector<ExternalOutputBuffer> buffers) override;
   DLL_PUBLIC void SetCompletionCallback(ExecutorCallback cb) override;
   DLL_PUBLIC ExecutorMetaMap GetExecutorMeta() override;
+  DLL_PUBLIC ExecutorTimingMetaMap GetExecutorTimingMeta() override;
+  /**
+   * @brief Returns the queue occupancy, the waits of the stages and of the consumer,
+   *        the state of the readers' prefetching and the use of the thread pool
+   *
+   * The readers are the operators reporting the `prefetch_queue_depth` diagnostic.
+   */
+  DLL_PUBLIC PipelineHealth GetHealth() override;
 
   DLL_PUBLIC void ShutdownQueue() {
     QueuePolicy::SignalStop();
@@ -144,42 +387,130 @@ class DLL_PUBLIC Executor : public ExecutorBase, public WorkspacePolicy, public
   DLL_PUBLIC void RunMixedImpl();
   DLL_PUBLIC void RunGPUImpl();
 
-  template<typename T>
-  inline void GetMaxSizesCont(T &in, size_t &max_out_size, size_t &max_reserved_size) {
-    auto out_size = in.nbytes();
-    auto reserved_size = in.capacity();
-    max_out_size = std::max<size_t>(std::ceil((out_size * 1.0) / in.ntensor()), max_out_size);
-    max_reserved_size = std::max<size_t>(std::ceil((reserved_size * 1.0) / in.ntensor()),
-                                         max_reserved_size);
+  /**
+   * @brief Issues the work of all GPU operators one by one; `iteration` is used in the trace ranges
+   *
+   * The independent branches of the stage are issued to separate streams, see SetupGPUStreams.
+   */
+  void RunGPUOps(QueueIdxs gpu_idxs, int batch_size, int64_t iteration);
+
+  /**
+   * @brief Sets up the GPU operators marked in gpu_op_early_setup_, see EnableEarlyGPUSetup
+   *
+   * @return false, if an operator failed; the error is already handled
+   */
+  bool SetupGPUOpsEarly(QueueIdxs gpu_idxs, int batch_size);
+
+  /// Issues the work of the GPU stage using the graph cache
+  void RunGPUGraphs(QueueIdxs gpu_idxs, int batch_size, int64_t iteration);
+
+  /**
+   * @brief Captures the GPU stage into a graph stored in `entry` and launches it
+   *
+   * @return false, if the capture failed - the graphs are disabled then and the work
+   *         has to be issued by running the operators
+   */
+  bool CaptureGPUStage(QueueIdxs gpu_idxs, int batch_size, GPUGraphCache::Entry &entry);
+
+  /// Makes the stream wait for the other stages and launches the graph
+  void LaunchGPUGraph(QueueIdxs gpu_idxs, int batch_size, cudaGraphExec_t graph);
+
+  /// Computes the signature of the current state of the GPU stage for the given queue indices
+  StageSignature GPUStageSignature(QueueIdxs gpu_idxs, int batch_size);
+
+  bool CanCaptureGPUStage() const;
+
+  /**
+   * @brief Assigns the GPU operators to streams, so that the independent branches of the GPU
+   *        stage can run concurrently
+   *
+   * An operator continues on the stream of one of its producers, unless another consumer
+   * already did; otherwise, it starts a new branch on a new stream. The dependencies between
+   * the streams are enforced with events. Within `max_num_stream` (which includes the Mixed and
+   * the main GPU stream) at most kMaxGPUSideStreams additional streams are used; when there are
+   * more branches than streams, the streams are reused.
+   */
+  void SetupGPUStreams();
+
+  /**
+   * @brief Makes the intermediate GPU buffers with disjoint live ranges allocate their memory
+   *        from shared blocks, see EnableMemoryReuse
+   */
+  void SetupGPUMemoryReuse();
+
+  /**
+   * @brief Finds the deterministic subgraphs computing the inputs of the operators which cache
+   *        them (see OpSchema::CachesInputs) and checks that they can be skipped
+   */
+  void SetupCachedSubgraphs();
+
+  /**
+   * @brief Marks the Mixed and GPU operators of the cached subgraphs to be skipped in
+   *        the iteration, if the caching operators have the outputs for all its samples
+   */
+  void MarkSkippedOps(QueueIdxs mixed_idxs, int batch_size);
+
+  /// Checks whether the operator is skipped in the iteration using the Mixed queue index
+  bool IsSkipped(int mixed_queue_idx, OpNodeId id) const {
+    return !skipped_ops_.empty() && skipped_ops_[mixed_queue_idx][id];
   }
 
-  template<typename T>
-  inline void GetMaxSizesNonCont(T &in, size_t &max_out_size, size_t &max_reserved_size) {
-    for (size_t j = 0; j < in.ntensor(); ++j) {
-      max_out_size = std::max(in[j].nbytes(), max_out_size);
-      max_reserved_size = std::max(in[j].capacity(), max_reserved_size);
-    }
-  }
+  /**
+   * @brief Finds the CPU and GPU operators with iteration-invariant outputs, see
+   *        OperatorBase::HasInvariantOutputs
+   */
+  void SetupInvariantOutputs();
+
+  /**
+   * @brief Checks whether the invariant outputs of the operator were computed for the batch size
+   */
+  bool HasInvariantOutputs(OpNodeId id, int batch_size) const;
+
+  /**
+   * @brief Makes the outputs in the workspace share the invariant outputs computed
+   *        in an earlier iteration, if there are ones for the batch size.
+   *
+   * @param queue_idx the queue index of the stage of the operator
+   * @return true, if the operator doesn't need to run
+   */
+  template <typename Workspace>
+  bool ReuseInvariantOutputs(const OpNode &op_node, int queue_idx, Workspace &ws);
+
+  /// Records the invariant outputs just computed by the operator in the workspace
+  template <typename Workspace>
+  void SaveInvariantOutputs(const OpNode &op_node, int queue_idx, Workspace &ws);
 
   template<typename backend>
   inline void GetMaxSizes(TensorList<backend> &in, size_t &max_out_size,
-                          size_t &max_reserved_size) {
-    GetMaxSizesCont(in, max_out_size, max_reserved_size);
+                          size_t &max_reserved_size, SizeHistogram &sample_sizes) {
+    max_out_size = std::max<size_t>(std::ceil((in.nbytes() * 1.0) / in.ntensor()), max_out_size);
+    max_reserved_size = std::max<size_t>(std::ceil((in.capacity() * 1.0) / in.ntensor()),
+                                         max_reserved_size);
+    for (size_t j = 0; j < in.ntensor(); ++j)
+      sample_sizes.Add(volume(in.tensor_shape(j)) * in.type_info().size());
   }
 
   template<typename backend>
   inline void GetMaxSizes(TensorVector<backend> &in, size_t &max_out_size,
-                          size_t &max_reserved_size) {
+                          size_t &max_reserved_size, SizeHistogram &sample_sizes) {
     if (in.IsContiguous()) {
-      GetMaxSizesCont(in, max_out_size, max_reserved_size);
+      max_out_size = std::max<size_t>(std::ceil((in.nbytes() * 1.0) / in.ntensor()),
+                                      max_out_size);
+      max_reserved_size = std::max<size_t>(std::ceil((in.capacity() * 1.0) / in.ntensor()),
+                                           max_reserved_size);
     } else {
-      GetMaxSizesNonCont(in, max_out_size, max_reserved_size);
+      for (size_t j = 0; j < in.ntensor(); ++j) {
+        max_out_size = std::max(in[j].nbytes(), max_out_size);
+        max_reserved_size = std::max(in[j].capacity(), max_reserved_size);
+      }
     }
+    for (size_t j = 0; j < in.ntensor(); ++j)
+      sample_sizes.Add(in[j].nbytes());
   }
 
   template <typename W>
-  inline void FillStats(ExecutorMetaMap &memory_stats, W &ws, std::string op_name,
-                        std::mutex &write_mutex) {
+  inline void FillStats(ExecutorMetaMap &memory_stats, SampleSizeHistograms &sample_sizes,
+                        W &ws, std::string op_name, std::mutex &write_mutex) {
     if (enable_memory_stats_) {
         size_t out_size = 0;
         size_t max_out_size = 0;
@@ -188,6 +519,8 @@ class DLL_PUBLIC Executor : public ExecutorBase, public WorkspacePolicy, public
         std::lock_guard<std::mutex> lck(write_mutex);
         auto &stats = memory_stats[op_name];
         stats.resize(ws.NumOutput(), {0, 0});
+        auto &histograms = sample_sizes[op_name];
+        histograms.resize(ws.NumOutput());
 
         for (int i = 0; i < ws.NumOutput(); ++i) {
           out_size = 0;
@@ -198,21 +531,128 @@ class DLL_PUBLIC Executor : public ExecutorBase, public WorkspacePolicy, public
             auto &out = ws.template OutputRef<CPUBackend>(i);
             out_size = out.nbytes();
             reserved_size = out.capacity();
-            GetMaxSizes(out, max_out_size, max_reserved_size);
+            GetMaxSizes(out, max_out_size, max_reserved_size, histograms[i]);
           } else {
             auto &out = ws.template OutputRef<GPUBackend>(i);
             out_size = out.nbytes();
             reserved_size = out.capacity();
-            GetMaxSizes(out, max_out_size, max_reserved_size);
+            GetMaxSizes(out, max_out_size, max_reserved_size, histograms[i]);
           }
           stats[i].real_size = std::max(out_size, stats[i].real_size);
           stats[i].max_real_size = std::max(max_out_size, stats[i].max_real_size);
           stats[i].reserved = std::max(reserved_size, stats[i].reserved);
           stats[i].max_reserved = std::max(max_reserved_size, stats[i].max_reserved);
+          stats[i].sample_size_hint =
+              histograms[i].Percentile(SizeHistogram::kDefaultPercentile);
         }
       }
   }
 
+  using TimingClock = std::chrono::steady_clock;
+
+  /**
+   * @brief Returns the current time if timing statistics are enabled, or a null time point
+   */
+  TimingClock::time_point TimingStart() const {
+    return enable_timing_stats_ ? TimingClock::now() : TimingClock::time_point{};
+  }
+
+  static double Seconds(TimingClock::duration d) {
+    return std::chrono::duration<double>(d).count();
+  }
+
+  void FillScratchStats(int op_idx, size_t peak) {
+    std::lock_guard<std::mutex> lck(timing_stats_mutex_[static_cast<int>(OpType::GPU)]);
+    gpu_op_scratch_peaks_[op_idx] = std::max(gpu_op_scratch_peaks_[op_idx], peak);
+  }
+
+  void FillOpTiming(OpType stage, int op_idx, int batch_size, TimingClock::time_point start) {
+    if (!enable_timing_stats_ || start == TimingClock::time_point{})
+      return;
+    double elapsed = Seconds(TimingClock::now() - start);
+    int stage_idx = static_cast<int>(stage);
+    std::lock_guard<std::mutex> lck(timing_stats_mutex_[stage_idx]);
+    auto &stage_stats = op_timing_stats_[stage_idx];
+    if (static_cast<int>(stage_stats.size()) <= op_idx)
+      stage_stats.resize(graph_->NumOp(stage));
+    auto &stats = stage_stats[op_idx];
+    stats.iterations++;
+    stats.samples += batch_size;
+    stats.total_time += elapsed;
+    stats.max_time = std::max(stats.max_time, elapsed);
+  }
+
+  void FillStageTiming(OpType stage, int batch_size, TimingClock::time_point wait_start,
+                       TimingClock::time_point start) {
+    if (!enable_timing_stats_ || wait_start == TimingClock::time_point{} ||
+        start == TimingClock::time_point{})
+      return;
+    double elapsed = Seconds(TimingClock::now() - start);
+    int stage_idx = static_cast<int>(stage);
+    std::lock_guard<std::mutex> lck(timing_stats_mutex_[stage_idx]);
+    auto &stats = stage_timing_stats_[stage_idx];
+    stats.iterations++;
+    stats.samples += batch_size;
+    stats.total_time += elapsed;
+    stats.max_time = std::max(stats.max_time, elapsed);
+    stats.wait_time += Seconds(start - wait_start);
+  }
+
+  /**
+   * @brief Records the event marking the start of the operator's work on the stream
+   *
+   * The measurement from the previous use of the same queue index is collected
+   * here, if it's complete; otherwise it's dropped, so the timing never blocks.
+   */
+  void StartGPUTiming(OpType stage, int op_idx, int queue_idx, cudaStream_t stream) {
+    if (!enable_timing_stats_)
+      return;
+    int stage_idx = static_cast<int>(stage);
+    auto &timers = gpu_timers_[stage_idx];
+    if (timers.empty()) {
+      timers.resize(graph_->NumOp(stage));
+      for (auto &op_timers : timers)
+        op_timers.resize(stage_queue_depths_[stage]);
+    }
+    auto &timer = timers[op_idx][queue_idx];
+    if (!timer.start) {
+      timer.start = CUDAEvent::CreateWithFlags(cudaEventDefault);
+      timer.end = CUDAEvent::CreateWithFlags(cudaEventDefault);
+    }
+    if (timer.pending) {
+      timer.pending = false;
+      auto status = cudaEventQuery(timer.end);
+      if (status == cudaSuccess) {
+        float ms = 0;
+        CUDA_CALL(cudaEventElapsedTime(&ms, timer.start, timer.end));
+        std::lock_guard<std::mutex> lck(timing_stats_mutex_[stage_idx]);
+        auto &stage_stats = op_timing_stats_[stage_idx];
+        if (static_cast<int>(stage_stats.size()) <= op_idx)
+          stage_stats.resize(graph_->NumOp(stage));
+        stage_stats[op_idx].gpu_iterations++;
+        stage_stats[op_idx].gpu_time += ms * 1e-3;
+      } else if (status == cudaErrorNotReady) {
+        cudaGetLastError();  // not an error - just clear it
+      } else {
+        CUDA_CALL(status);
+      }
+    }
+    CUDA_CALL(cudaEventRecord(timer.start, stream));
+    timer.started = true;
+  }
+
+  void StopGPUTiming(OpType stage, int op_idx, int queue_idx, cudaStream_t stream) {
+    auto &timers = gpu_timers_[static_cast<int>(stage)];
+    if (timers.empty())
+      return;
+    auto &timer = timers[op_idx][queue_idx];
+    if (!timer.started)
+      return;
+    CUDA_CALL(cudaEventRecord(timer.end, stream));
+    timer.started = false;
+    timer.pending = true;
+  }
+
   void HandleError(const std::string &stage, const OpNode &op_node, const std::string &message) {
     // handle internal Operator names that start with underscore
     const auto &op_name =
@@ -246,6 +686,17 @@ class DLL_PUBLIC Executor : public ExecutorBase, public WorkspacePolicy, public
 
   void PruneUnusedGraphNodes() override;
 
+  /**
+   * @brief Makes the stages which overwrite the released outputs wait for `consumer_event`
+   */
+  void WaitForConsumer(cudaEvent_t consumer_event);
+
+  /**
+   * @brief Waits for the event on the host - with the low latency mode, polls it for a while
+   *        first (see EnableLowLatency)
+   */
+  void WaitForEvent(cudaEvent_t event);
+
   virtual std::vector<int> GetTensorQueueSizes(const OpGraph &graph);
 
   virtual void SetupOutputInfo(const OpGraph &graph);
@@ -318,12 +769,15 @@ class DLL_PUBLIC Executor : public ExecutorBase, public WorkspacePolicy, public
 
   StageQueues stage_queue_depths_;
 
+  HealthMonitor health_;
+
   std::queue<int> batch_sizes_cpu_, batch_sizes_mixed_, batch_sizes_gpu_;
 
   OpGraph *graph_ = nullptr;
   // we need to keep this above the stream_pool_ so we still have it when the stream_pool_
   // destructor runs and it waits for streams to finish
   ExecutorCallback callback_;
+  int max_num_stream_;
   StreamPool stream_pool_;
   EventPool event_pool_;
   ThreadPool thread_pool_;
@@ -346,10 +800,198 @@ class DLL_PUBLIC Executor : public ExecutorBase, public WorkspacePolicy, public
   std::mutex cpu_memory_stats_mutex_;
   std::mutex mixed_memory_stats_mutex_;
   std::mutex gpu_memory_stats_mutex_;
+  /// the sizes of the samples of each output; guarded by the mutexes of the memory stats
+  SampleSizeHistograms cpu_sample_sizes_, mixed_sample_sizes_, gpu_sample_sizes_;
+
+  struct GPUTimer {
+    CUDAEvent start, end;
+    bool started = false;
+    bool pending = false;
+  };
+  static constexpr int kNumStages = static_cast<int>(OpType::COUNT);
+  std::atomic<bool> enable_timing_stats_;
+  // stage -> index of the op in the stage -> stats
+  std::array<std::vector<ExecutorTimingMeta>, kNumStages> op_timing_stats_;
+  std::array<ExecutorTimingMeta, kNumStages> stage_timing_stats_;
+  std::array<std::mutex, kNumStages> timing_stats_mutex_;
+  // stage -> index of the op in the stage -> queue idx -> events;
+  // used only by the thread running the stage
+  std::array<std::vector<std::vector<GPUTimer>>, kNumStages> gpu_timers_;
+  // the number of the runs of each stage, to identify the iterations in the trace ranges;
+  // used only by the thread running the stage
+  std::array<int64_t, kNumStages> stage_iterations_{};
+
+  static constexpr size_t kHostScratchBlockSize = 64 << 10;
+  /// Per-stage arenas for the host-side metadata of the operators, see Workspace::HostScratch
+  std::array<mm::monotonic_host_resource, kNumStages> host_scratch_;
+
+  bool enable_cuda_graphs_ = false;
+  /// Set in Build, if the GPU stage can be captured; reset when a capture fails
+  bool use_gpu_graphs_ = false;
+  /// Used only by the thread running the GPU stage
+  GPUGraphCache gpu_graphs_;
+
+  static constexpr int kMaxGPUSideStreams = 3;
+  /// GPU op index -> the index in gpu_streams_; empty, if the GPU stage uses gpu_op_stream_ only
+  std::vector<int> gpu_op_stream_idx_;
+  /// gpu_op_stream_, followed by the streams of the other branches of the GPU stage
+  std::vector<cudaStream_t> gpu_streams_;
+  /// GPU op index -> the indices of the GPU ops producing its inputs in other streams
+  std::vector<std::vector<int>> gpu_op_cross_stream_producers_;
+  /// GPU op index -> the event recorded after the op, if it has consumers in other streams
+  std::vector<cudaEvent_t> gpu_op_events_;
+  /// Recorded in gpu_op_stream_ when the stage starts, to start the other streams
+  cudaEvent_t gpu_fork_event_ = nullptr;
+  /// Stream index -> recorded in the stream when the stage ends, for gpu_op_stream_ to wait for
+  std::vector<cudaEvent_t> gpu_join_events_;
+
+  bool enable_memory_reuse_ = false;
+
+  struct CachedSubgraph {
+    /// the index of the caching operator among the GPU ops
+    int cache_op;
+    /// the CPU tensor with the keys of the samples in its source info
+    TensorNodeId keys;
+    /// the Mixed and GPU operators computing the cached inputs
+    std::vector<OpNodeId> ops;
+  };
+  std::vector<CachedSubgraph> cached_subgraphs_;
+  /// Mixed queue index -> OpNodeId -> whether the op is skipped in the iteration using the index;
+  /// written by the Mixed stage, read by the GPU stage of the same iteration
+  std::vector<std::vector<bool>> skipped_ops_;
+
+  struct InvariantOutputs {
+    /// the batch size of the computed outputs, -1 if there are none
+    int batch_size = -1;
+    /// the output containers with the computed outputs
+    std::vector<void *> source;
+    /// queue index -> whether the outputs in the queue slot are the computed ones
+    std::vector<bool> holds;
+  };
+  /// OpNodeId -> the outputs of the operator, if they are iteration-invariant, or null
+  std::vector<std::unique_ptr<InvariantOutputs>> invariant_outputs_;
+  /// the CPU operators of concurrent iterations may use them at the same time
+  mutable std::mutex invariant_outputs_mutex_;
+
+  /// TensorNodeId of a pipeline output -> the external buffers, one per queue slot
+  std::map<TensorNodeId, std::vector<ExternalOutputBuffer>> external_outputs_;
+  /// the output containers which use an external buffer now
+  std::set<const TensorList<GPUBackend> *> external_bound_;
+  /// the buffers may be replaced while the Mixed and the GPU stage run
+  std::mutex external_outputs_mutex_;
+
+  /// The largest batch uploaded by MakeContiguous which is packed with the others
+  static constexpr int64_t kMaxPackedTransferBytes = 64 << 10;
+  static constexpr int64_t kPackedTransferAlignment = 256;
+  /// A part of the packed transfer, uploaded for one MakeContiguous operator
+  struct PackedTransfer {
+    const TensorVector<CPUBackend> *input = nullptr;
+    int64_t offset = 0, bytes = 0;
+  };
+  /// Mixed op index -> the part of the packed transfer; the input is null, if not packed.
+  /// Used only by the thread running the Mixed stage, as are the buffers below.
+  std::vector<PackedTransfer> packed_transfers_;
+  /// The pinned staging buffer - it's reused once the previous Mixed stage completes
+  Tensor<CPUBackend> packed_staging_;
+  /// Mixed queue index -> the device buffer with the packed outputs of the queue slot
+  std::vector<Tensor<GPUBackend>> packed_device_;
+  /// the output containers which are views of a packed device buffer now
+  std::set<const TensorList<GPUBackend> *> packed_outputs_;
+
+  bool enable_early_gpu_setup_ = false;
+  /// GPU op index -> whether the op is set up at the start of the stage; empty, if none is
+  std::vector<bool> gpu_op_early_setup_;
+  /// GPU op index -> the metadata arena, used instead of the per-stage one with the early setup
+  std::vector<mm::monotonic_host_resource> gpu_op_scratch_;
+
+  bool enable_shared_scratch_ = false;
+  /// Stream index -> the device scratch memory of the GPU ops in the stream; empty, if not shared
+  std::vector<kernels::ScratchArena> gpu_scratch_arenas_;
+  /// GPU op index -> the largest device scratch memory used by the op in the arena
+  std::vector<size_t> gpu_op_scratch_peaks_;
+
+  bool enable_low_latency_ = false;
+
+  bool enable_cpu_dataflow_ = false;
+  /// The threads launching the CPU operators; set in Build, if the dataflow is used
+  std::unique_ptr<ThreadPool> cpu_op_runners_;
+  /// CPU op index -> the indices of the CPU operators consuming its outputs
+  std::vector<std::vector<int>> cpu_op_consumers_;
+  /// CPU op index -> the number of the CPU operators producing its inputs
+  std::vector<int> cpu_op_num_producers_;
+  /// CPU op index -> the metadata arena, used instead of the per-stage one, if the runs
+  /// of the operators overlap (the dataflow or the depth-first mode)
+  std::vector<mm::monotonic_host_resource> cpu_op_scratch_;
+
+  bool enable_cpu_depth_first_ = false;
+
+  bool enable_concurrent_cpu_iterations_ = false;
+  /// The state of a CPU iteration run with EnableConcurrentCPUIterations
+  struct CPUIteration {
+    int64_t seq;        // the position among the iterations run concurrently
+    int64_t iteration;  // the CPU stage iteration, for tracing
+    QueueIdxs idxs;
+    int batch_size;
+    TimingClock::time_point wait_start, stage_start;
+    /// CPU op index -> the number of the producers, which haven't finished this iteration yet
+    std::vector<int> num_pending;
+    int num_ops_left;
+  };
+  /// The CPU iterations in flight, the oldest first
+  std::deque<CPUIteration> cpu_iterations_;
+  /// CPU op index -> the seq of the next iteration to run; an operator runs them in order
+  std::vector<int64_t> cpu_op_next_iteration_;
+  /// CPU op index -> whether the operator is running
+  std::vector<bool> cpu_op_running_;
+  int64_t cpu_iterations_started_ = 0;
+  /// The number of the CPU iterations finished and released to the next stage
+  int64_t cpu_iterations_released_ = 0;
+  std::mutex cpu_iterations_mutex_;
+  std::condition_variable cpu_iteration_released_;
+  /// The threads running the CPU operators; set in Build, if the iterations run concurrently
+  std::unique_ptr<ThreadPool> cpu_iteration_runners_;
+
+  /**
+   * @brief Makes the work issued to the stream wait for the consumer of the released outputs
+   */
+  void WaitForConsumer(cudaStream_t stream) {
+    if (wait_for_consumer_)
+      CUDA_CALL(cudaStreamWaitEvent(stream, consumer_event_, 0));
+  }
+
+  /// Set when the outputs are released with a consumer event for the first time
+  std::atomic<bool> wait_for_consumer_{false};
+  /// Mirrors the last consumer event - it's recorded in release_stream_ after waiting for it
+  cudaEvent_t consumer_event_ = {};
+  CUDAStream release_stream_;
+  /// The outputs can be released from multiple threads
+  std::mutex release_mutex_;
+  bool has_cpu_outputs_ = false;
 
   /// Graph nodes, which define batch size for the entire graph
   std::vector<BatchSizeProvider *> batch_size_providers_;
 
+  /**
+   * @brief Waits for the CPU iterations in flight and stops the threads running them
+   */
+  void StopCPUIterations() {
+    cpu_iteration_runners_.reset();
+  }
+
+  /**
+   * @brief Whether the next stage can take the CPU iterations finished asynchronously,
+   *        after RunCPU has returned. Otherwise, RunCPU waits for its iteration to finish.
+   */
+  virtual bool CanOverlapCPUIterations() const {
+    return std::is_same<QueuePolicy, SeparateQueuePolicy>::value;
+  }
+
+  /**
+   * @brief Called when a CPU iteration, run with EnableConcurrentCPUIterations, is handed over
+   *        to the next stage (or dropped, because of an error)
+   */
+  virtual void CPUIterationReleased() {}
+
  private:
   template <typename InputRef>
   static bool SetDefaultLayoutIfNeeded(InputRef &in, const OpSchema &schema, int in_idx) {
@@ -363,6 +1005,100 @@ class DLL_PUBLIC Executor : public ExecutorBase, public WorkspacePolicy, public
   template <typename Workspace>
   void RunHelper(OpNode &op_node, Workspace &ws);
 
+  /**
+   * @brief The part of RunHelper preceding Operator::Run - checks the batch sizes, calls
+   *        Operator::Setup and resizes the outputs.
+   *
+   * @param empty_layout_in_idxs if not null, the inputs without a layout get the default one
+   *                             from the schema and their indices are stored here
+   */
+  template <typename Workspace>
+  void SetupHelper(OpNode &op_node, Workspace &ws, SmallVector<int, 16> *empty_layout_in_idxs);
+
+  /**
+   * @brief Makes the GPU output of the operator use the external buffer registered for its
+   *        queue slot, if there's one and the output fits; otherwise, the output goes back to
+   *        DALI's memory.
+   *
+   * @param desc the shape and the type of the output or null, if the operator doesn't infer them
+   * @return true, if the output uses the external buffer
+   */
+  bool BindExternalOutput(const OpNode &op_node, int output_idx, const OutputDesc *desc,
+                          TensorList<GPUBackend> &out);
+
+  /**
+   * @brief Uploads the small batches of all the Mixed MakeContiguous operators with one copy
+   *
+   * Each of the batches, e.g. labels or bounding boxes, would otherwise take a copy of its own.
+   * The samples are gathered in a pinned staging buffer and copied to the device buffer of
+   * the queue slot at once. The operators are then not run - their outputs become views of
+   * the parts of the device buffer, see UsePackedTransfer.
+   * Nothing is packed, unless there are at least two such batches.
+   */
+  void PackSmallTransfers(QueueIdxs mixed_idxs);
+
+  /// Makes the output of the packed MakeContiguous operator a view of its part of the transfer
+  void UsePackedTransfer(int mixed_op_idx, int queue_idx, MixedWorkspace &ws);
+
+  /// Clears the default layouts set by SetupHelper
+  template <typename Workspace>
+  void ResetDefaultLayouts(Workspace &ws, const SmallVector<int, 16> &empty_layout_in_idxs);
+
+  void RunCPUOp(int cpu_op_id, QueueIdxs cpu_idxs, int batch_size, int64_t iteration);
+
+  /**
+   * @brief Finds the CPU operators consuming the outputs of each CPU operator
+   */
+  void SetupCPUDependencies();
+
+  /**
+   * @brief Starts the CPU iteration, see EnableConcurrentCPUIterations. Waits for it to finish
+   *        only if the next stage can't take it asynchronously (CanOverlapCPUIterations).
+   */
+  void StartCPUIteration(QueueIdxs cpu_idxs, int batch_size, int64_t iteration,
+                         TimingClock::time_point wait_start, TimingClock::time_point stage_start);
+
+  /**
+   * @brief Queues the operator to run the iteration, if it's ready to; the caller holds
+   *        cpu_iterations_mutex_
+   */
+  void TryLaunchCPUOp(int cpu_op_id, int64_t seq);
+
+  /**
+   * @brief Hands the finished CPU iterations over to the next stage, in order; the caller holds
+   *        cpu_iterations_mutex_
+   */
+  void ReleaseCPUIterations();
+
+  /**
+   * @brief Runs the CPU operators in the order of their dependencies, see EnableCPUDataflow
+   */
+  void RunCPUDataflow(QueueIdxs cpu_idxs, int batch_size, int64_t iteration);
+
+  /**
+   * @brief Finds the dependencies between the CPU operators and starts the threads running them
+   */
+  void SetupCPUDataflow();
+
+  /**
+   * @brief Computes the priorities of the CPU operators as the length of the longest path
+   *        to the end of the stage, weighted with the measured run time, if available.
+   */
+  std::vector<int64_t> CPUOpPriorities();
+
+  /**
+   * @brief Runs the CPU operators, running the chains of per-sample operators depth-first,
+   *        see EnableCPUDepthFirst
+   */
+  void RunCPUDepthFirst(QueueIdxs cpu_idxs, int batch_size, int64_t iteration);
+
+  /**
+   * @brief Runs a chain of per-sample CPU operators, each consuming the output of the previous
+   *        one, passing every sample through the whole chain in one task of the thread pool
+   */
+  void RunCPUChain(const std::vector<int> &chain, QueueIdxs cpu_idxs, int batch_size,
+                   int64_t iteration);
+
   void RethrowError() const {
     std::lock_guard<std::mutex> errors_lock(errors_mutex_);
     // TODO(klecki): collect all errors
@@ -411,6 +1147,55 @@ ExecutorMetaMap Executor<WorkspacePolicy, QueuePolicy>::GetExecutorMeta() {
   return ret;
 }
 
+template <typename WorkspacePolicy, typename QueuePolicy>
+ExecutorTimingMetaMap Executor<WorkspacePolicy, QueuePolicy>::GetExecutorTimingMeta() {
+  ExecutorTimingMetaMap ret;
+  const char *stage_names[kNumStages] = {"GPU", "CPU", "MIXED"};  // OpType order
+  for (int stage_idx = 0; stage_idx < kNumStages; stage_idx++) {
+    auto stage = static_cast<OpType>(stage_idx);
+    std::string stage_name = stage_names[stage_idx];
+    std::lock_guard<std::mutex> lck(timing_stats_mutex_[stage_idx]);
+    auto &stage_stats = op_timing_stats_[stage_idx];
+    for (int i = 0; i < static_cast<int>(stage_stats.size()); i++) {
+      if (stage_stats[i].iterations > 0) {
+        auto &node = graph_->Node(stage, i);
+        auto &entry = ret[stage_name + "_" + node.instance_name];
+        entry = stage_stats[i];
+        entry.diagnostics = node.op->GetNumericDiagnostics();
+        if (stage == OpType::GPU && i < static_cast<int>(gpu_op_scratch_peaks_.size()))
+          entry.diagnostics["max_scratch_size"] = gpu_op_scratch_peaks_[i];
+      }
+    }
+    if (stage_timing_stats_[stage_idx].iterations > 0)
+      ret["STAGE_" + stage_name] = stage_timing_stats_[stage_idx];
+  }
+  return ret;
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+PipelineHealth Executor<WorkspacePolicy, QueuePolicy>::GetHealth() {
+  auto health = health_.Snapshot();
+  if (graph_) {
+    for (int i = 0; i < graph_->NumOp(); i++) {
+      auto &node = graph_->Node(i);
+      auto diagnostics = node.op->GetNumericDiagnostics();
+      auto depth = diagnostics.find("prefetch_queue_depth");
+      if (depth == diagnostics.end())
+        continue;
+      ReaderHealth reader;
+      reader.name = node.instance_name;
+      reader.prefetch_queue_depth = depth->second;
+      reader.prefetch_queue_fill = diagnostics["prefetch_queue_fill"];
+      reader.starved = diagnostics["prefetch_starved"];
+      reader.wait_time = diagnostics["prefetch_wait_time"];
+      health.readers.push_back(std::move(reader));
+    }
+  }
+  health.thread_pool_threads = thread_pool_.NumThreads();
+  health.thread_pool_busy_time = thread_pool_.BusyTime();
+  return health;
+}
+
 template <typename WorkspacePolicy, typename QueuePolicy>
 void Executor<WorkspacePolicy, QueuePolicy>::Build(OpGraph *graph, vector<string> output_names) {
   DALI_ENFORCE(graph != nullptr, "Input graph is nullptr.");
@@ -469,16 +1254,149 @@ void Executor<WorkspacePolicy, QueuePolicy>::Build(OpGraph *graph, vector<string
 
   // Producer-consumer queues info
   SetupOutputQueuesForGraph();
+  for (auto stage : {OpType::CPU, OpType::MIXED, OpType::GPU})
+    health_.SetCapacity(stage, stage_queue_depths_[stage]);
 
   DiscoverBatchSizeProviders();
+
+  use_gpu_graphs_ = enable_cuda_graphs_ && device_id_ != CPU_ONLY_DEVICE_ID &&
+                    CanCaptureGPUStage();
+  // each combination of the Mixed and GPU buffers needs a graph; half of the entries
+  // may be the states seen only once
+  gpu_graphs_.SetMaxEntries(
+      2 * stage_queue_depths_[OpType::MIXED] * stage_queue_depths_[OpType::GPU]);
+  SetupInvariantOutputs();
+  // the graphs capture gpu_op_stream_ only
+  if (device_id_ != CPU_ONLY_DEVICE_ID && !use_gpu_graphs_) {
+    DeviceGuard g(device_id_);
+    SetupGPUStreams();
+  }
+  // the reuse relies on the order of the ops in a stream, so it follows the stream assignment
+  if (enable_memory_reuse_ && device_id_ != CPU_ONLY_DEVICE_ID) {
+    DeviceGuard g(device_id_);
+    SetupGPUMemoryReuse();
+  }
+
+  if (device_id_ != CPU_ONLY_DEVICE_ID)
+    SetupCachedSubgraphs();
+
+  // the captured graphs would refer to the arena memory, which is reused and may be reallocated
+  if (enable_shared_scratch_ && device_id_ != CPU_ONLY_DEVICE_ID && !use_gpu_graphs_) {
+    gpu_scratch_arenas_.resize(std::max<size_t>(gpu_streams_.size(), 1));
+    gpu_op_scratch_peaks_.assign(graph_->NumOp(OpType::GPU), 0);
+  }
+
+  if (enable_early_gpu_setup_ && graph_->NumOp(OpType::GPU) > 1) {
+    int num_ops = graph_->NumOp(OpType::GPU);
+    // the shapes of the inputs are known, if their producers set the output shapes in Setup
+    gpu_op_early_setup_.assign(num_ops, true);
+    for (int i = 0; i < num_ops; i++) {
+      for (OpNodeId parent : graph_->Node(OpType::GPU, i).parents) {
+        if (graph_->NodeType(parent) != OpType::GPU)
+          continue;
+        int producer = graph_->NodeIdx(parent);
+        if (!gpu_op_early_setup_[producer] ||
+            !graph_->Node(OpType::GPU, producer).op->CanInferOutputs()) {
+          gpu_op_early_setup_[i] = false;
+          break;
+        }
+      }
+    }
+    gpu_op_scratch_.resize(num_ops);
+    for (auto &scratch : gpu_op_scratch_)
+      scratch = mm::monotonic_host_resource(&mm::malloc_memory_resource::instance(),
+                                            kHostScratchBlockSize);
+  }
+
+  DALI_ENFORCE(!enable_cpu_dataflow_ || !enable_cpu_depth_first_,
+               "The CPU dataflow and the depth-first execution of the CPU operators "
+               "can't be enabled together.");
+  if ((enable_cpu_dataflow_ || enable_cpu_depth_first_) && graph_->NumOp(OpType::CPU) > 1) {
+    cpu_op_scratch_.resize(graph_->NumOp(OpType::CPU));
+    for (auto &scratch : cpu_op_scratch_)
+      scratch = mm::monotonic_host_resource(&mm::malloc_memory_resource::instance(),
+                                            kHostScratchBlockSize);
+  }
+  if (enable_cpu_dataflow_ && graph_->NumOp(OpType::CPU) > 1)
+    SetupCPUDataflow();
+
+  if (enable_concurrent_cpu_iterations_) {
+    DALI_ENFORCE(device_id_ == CPU_ONLY_DEVICE_ID,
+                 "The concurrent CPU iterations are supported only in CPU-only pipelines.");
+    DALI_ENFORCE(!enable_cpu_dataflow_ && !enable_cpu_depth_first_,
+                 "The concurrent CPU iterations can't be combined with the CPU dataflow or "
+                 "the depth-first execution of the CPU operators.");
+    int num_ops = graph_->NumOp(OpType::CPU);
+    if (num_ops > 1) {
+      cpu_op_scratch_.resize(num_ops);
+      for (auto &scratch : cpu_op_scratch_)
+        scratch = mm::monotonic_host_resource(&mm::malloc_memory_resource::instance(),
+                                              kHostScratchBlockSize);
+    }
+    SetupCPUDependencies();
+    cpu_op_next_iteration_.assign(num_ops, 0);
+    cpu_op_running_.assign(num_ops, false);
+    // each operator runs one iteration at a time
+    int num_runners = std::max(1, std::min(num_ops, thread_pool_.NumThreads()));
+    cpu_iteration_runners_ = std::make_unique<ThreadPool>(num_runners, device_id_, false);
+  }
 }
 
 
 template <typename WorkspacePolicy, typename QueuePolicy>
-void Executor<WorkspacePolicy, QueuePolicy>::ReleaseOutputs() {
+void Executor<WorkspacePolicy, QueuePolicy>::ReleaseOutputs(cudaEvent_t consumer_event) {
+  WaitForConsumer(consumer_event);
   QueuePolicy::ReleaseOutputIdxs();
 }
 
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::ReleaseOutputs(int output_id,
+                                                            cudaEvent_t consumer_event) {
+  WaitForConsumer(consumer_event);
+  QueuePolicy::ReleaseOutputIdxs(output_id);
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::WaitForConsumer(cudaEvent_t consumer_event) {
+  if (consumer_event) {
+    std::lock_guard<std::mutex> lock(release_mutex_);
+    DeviceGuard g(device_id_);
+    // The host buffers are reused as soon as they are released
+    if (has_cpu_outputs_ || device_id_ == CPU_ONLY_DEVICE_ID)
+      WaitForEvent(consumer_event);
+    if (device_id_ != CPU_ONLY_DEVICE_ID) {
+      // The GPU buffers are overwritten by the work issued to the Mixed and GPU streams
+      // after the release. The stages wait for our copy of the event, so that the user can
+      // record the original one again and the stages never wait on an event from outside
+      // of a graph capture.
+      if (!release_stream_) {
+        release_stream_ = CUDAStream::Create(true, device_id_);
+        consumer_event_ = event_pool_.GetEvent();
+      }
+      CUDA_CALL(cudaStreamWaitEvent(release_stream_, consumer_event, 0));
+      CUDA_CALL(cudaEventRecord(consumer_event_, release_stream_));
+      wait_for_consumer_ = true;
+    }
+  }
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::WaitForEvent(cudaEvent_t event) {
+  if (enable_low_latency_) {
+    // the small iterations complete within microseconds
+    constexpr auto kSpinTime = std::chrono::microseconds(200);
+    auto start = std::chrono::steady_clock::now();
+    do {
+      cudaError_t result = cudaEventQuery(event);
+      if (result == cudaSuccess)
+        return;
+      if (result != cudaErrorNotReady)
+        CUDA_CALL(result);
+    } while (std::chrono::steady_clock::now() - start < kSpinTime);
+  }
+  CUDA_CALL(cudaEventSynchronize(event));
+}
+
 template <typename WorkspacePolicy, typename QueuePolicy>
 void Executor<WorkspacePolicy, QueuePolicy>::Outputs(DeviceWorkspace *ws) {
   ReleaseOutputs();
@@ -487,6 +1405,23 @@ void Executor<WorkspacePolicy, QueuePolicy>::Outputs(DeviceWorkspace *ws) {
 
 template <typename WorkspacePolicy, typename QueuePolicy>
 void Executor<WorkspacePolicy, QueuePolicy>::ShareOutputs(DeviceWorkspace *ws) {
+  cudaEvent_t ready = ShareOutputsAsync(ws);
+  // We need to wait for GPU outputs from Mixed & GPU stages that are computed asynchronously.
+  if (ready) {
+    DeviceGuard g(device_id_);
+    WaitForEvent(ready);
+  }
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+cudaEvent_t Executor<WorkspacePolicy, QueuePolicy>::ShareOutputsAsync(DeviceWorkspace *ws) {
+  int output_id;
+  return ShareOutputsAsync(ws, &output_id);
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+cudaEvent_t Executor<WorkspacePolicy, QueuePolicy>::ShareOutputsAsync(DeviceWorkspace *ws,
+                                                                      int *output_id) {
   DALI_ENFORCE(ws != nullptr, "Workspace is nullptr");
   DeviceGuard g(device_id_);
   ws->Clear();
@@ -494,10 +1429,14 @@ void Executor<WorkspacePolicy, QueuePolicy>::ShareOutputs(DeviceWorkspace *ws) {
   if (exec_error_ || QueuePolicy::IsStopSignaled())
     RethrowError();
 
+  auto wait_start = health_.OutputRequested();
   auto output_idx = QueuePolicy::UseOutputIdxs();
 
   if (exec_error_ || QueuePolicy::IsStopSignaled())
     RethrowError();
+  health_.OutputAcquired(wait_start);
+
+  *output_id = output_idx[OpType::GPU];
 
   // We need to fill the output workspace with pointers to appropriate output buffers.
   for (size_t i = 0; i < pipeline_outputs_.size(); i++) {
@@ -516,17 +1455,14 @@ void Executor<WorkspacePolicy, QueuePolicy>::ShareOutputs(DeviceWorkspace *ws) {
       ), DALI_FAIL("Invalid op type"));  // NOLINT(whitespace/parens)
     ), DALI_FAIL("Invalid storage device"));  // NOLINT(whitespace/parens)
   }
-  // We than need to wait for GPU outputs from Mixed & GPU stages that are computed asynchronously.
-  // If the output event list is not empty, it means that there are outputs on GPU that we
-  // have to wait for.
-  if (!mixed_output_events_.empty()) {
-    auto queue_idx = output_idx[OpType::MIXED];
-    CUDA_CALL(cudaEventSynchronize(mixed_output_events_.GetEvent(queue_idx)));
-  }
-  if (!gpu_output_events_.empty()) {
-    auto queue_idx = output_idx[OpType::GPU];
-    CUDA_CALL(cudaEventSynchronize(gpu_output_events_.GetEvent(queue_idx)));
-  }
+  // If the output event list is not empty, it means that there are outputs on GPU that
+  // the consumer has to wait for. When there are GPU outputs from both stages, the GPU stage
+  // output event is recorded after waiting for the Mixed one.
+  if (!gpu_output_events_.empty())
+    return gpu_output_events_.GetEvent(output_idx[OpType::GPU]);
+  if (!mixed_output_events_.empty())
+    return mixed_output_events_.GetEvent(output_idx[OpType::MIXED]);
+  return nullptr;
 }
 
 template <typename WorkspacePolicy, typename QueuePolicy>
@@ -592,6 +1528,10 @@ template <typename WorkspacePolicy, typename QueuePolicy>
 void Executor<WorkspacePolicy, QueuePolicy>::SetupOutputInfo(const OpGraph &graph) {
   DeviceGuard g(device_id_);
   pipeline_outputs_ = graph.GetOutputs(output_names_);
+  has_cpu_outputs_ = false;
+  for (auto tid : pipeline_outputs_)
+    if (graph.Tensor(tid).producer.storage_device == StorageDevice::CPU)
+      has_cpu_outputs_ = true;
 
   // If there are GPU outputs from given stages, we have to wait for them
   auto has_gpu_output = [] (OpType stage_type, const auto &pipeline_outputs,
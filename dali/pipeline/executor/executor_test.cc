@@ -15,6 +15,7 @@
 
 #include <gtest/gtest.h>
 #include <chrono>
+#include <cstring>
 #include <future>
 
 #include "dali/test/dali_test_decoder.h"
@@ -442,6 +443,78 @@ TYPED_TEST(ExecutorTest, TestRunBasicGraph) {
   ASSERT_TRUE(ws.OutputIsType<CPUBackend>(0));
 }
 
+TYPED_TEST(ExecutorTest, TestRunCPUDataflow) {
+  this->num_threads_ = 4;
+  // Two independent branches, joined by the outputs
+  auto build_graph = [&](OpGraph &graph) {
+    graph.AddOp(this->PrepareSpec(
+            OpSpec("ExternalSource")
+            .AddArg("device", "cpu")
+            .AddArg("device_id", 0)
+            .AddOutput("data", "cpu")), "");
+    graph.AddOp(this->PrepareSpec(
+            OpSpec("ImageDecoder")
+            .AddArg("device", "cpu")
+            .AddInput("data", "cpu")
+            .AddOutput("images", "cpu")), "decoder");
+    graph.AddOp(this->PrepareSpec(
+            OpSpec("ImageDecoder")
+            .AddArg("device", "cpu")
+            .AddArg("output_type", DALI_GRAY)
+            .AddInput("data", "cpu")
+            .AddOutput("gray", "cpu")), "gray_decoder");
+    graph.AddOp(this->PrepareSpec(
+            OpSpec("MakeContiguous")
+            .AddArg("device", "cpu")
+            .AddInput("images", "cpu")
+            .AddOutput("final_images", "cpu")), "");
+    graph.AddOp(this->PrepareSpec(
+            OpSpec("MakeContiguous")
+            .AddArg("device", "cpu")
+            .AddInput("gray", "cpu")
+            .AddOutput("final_gray", "cpu")), "");
+  };
+  vector<string> outputs = {"final_images_cpu", "final_gray_cpu"};
+
+  TensorList<CPUBackend> tl;
+  this->MakeJPEGBatch(&tl, this->batch_size_);
+
+  auto run = [&](bool dataflow, vector<TensorList<CPUBackend>> &results) {
+    auto exe = this->GetExecutor(this->batch_size_, this->num_threads_, 0, 1);
+    exe->EnableCPUDataflow(dataflow);
+    exe->Init();
+    OpGraph graph;
+    build_graph(graph);
+    exe->Build(&graph, outputs);
+    auto *src_op =
+        dynamic_cast<ExternalSource<CPUBackend> *>(graph.Node(OpType::CPU, 0).op.get());
+    ASSERT_NE(src_op, nullptr);
+    src_op->SetDataSource(tl);
+    exe->RunCPU();
+    exe->RunMixed();
+    exe->RunGPU();
+    DeviceWorkspace ws;
+    exe->Outputs(&ws);
+    ASSERT_EQ(ws.NumOutput(), 2);
+    results.resize(ws.NumOutput());
+    for (int i = 0; i < ws.NumOutput(); i++)
+      results[i].Copy(ws.Output<CPUBackend>(i), 0);
+  };
+
+  vector<TensorList<CPUBackend>> ref, out;
+  run(false, ref);
+  run(true, out);
+
+  ASSERT_EQ(out.size(), 2u);
+  for (int o = 0; o < 2; o++) {
+    ASSERT_EQ(out[o].shape(), ref[o].shape());
+    for (int i = 0; i < this->batch_size_; i++) {
+      EXPECT_EQ(std::memcmp(out[o].raw_tensor(i), ref[o].raw_tensor(i),
+                            ref[o].tensor_shape(i).num_elements()), 0);
+    }
+  }
+}
+
 TYPED_TEST(ExecutorTest, TestRunBasicGraphWithCB) {
   auto exe = this->GetExecutor(this->batch_size_, this->num_threads_, 0, 1);
   exe->Init();
@@ -499,6 +572,77 @@ TYPED_TEST(ExecutorTest, TestRunBasicGraphWithCB) {
   ASSERT_TRUE(ws.OutputIsType<CPUBackend>(0));
 }
 
+TYPED_TEST(ExecutorTest, TestRunGPUBranches) {
+  auto exe = this->GetExecutor(this->batch_size_, this->num_threads_, 0, 1);
+  exe->Init();
+
+  // Two GPU branches, issued to separate streams
+  OpGraph graph;
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("ExternalSource")
+          .AddArg("device", "cpu")
+          .AddArg("device_id", 0)
+          .AddOutput("data", "cpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("ImageDecoder")
+          .AddArg("device", "cpu")
+          .AddInput("data", "cpu")
+          .AddOutput("images", "cpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("MakeContiguous")
+          .AddArg("device", "mixed")
+          .AddInput("images", "cpu")
+          .AddOutput("images", "gpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("Copy")
+          .AddArg("device", "gpu")
+          .AddInput("images", "gpu")
+          .AddOutput("copy1", "gpu")), "copy1");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("Copy")
+          .AddArg("device", "gpu")
+          .AddInput("images", "gpu")
+          .AddOutput("copy2", "gpu")), "copy2");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("Copy")
+          .AddArg("device", "gpu")
+          .AddInput("copy2", "gpu")
+          .AddOutput("final_images", "gpu")), "copy3");
+
+  vector<string> outputs = {"copy1_gpu", "final_images_gpu"};
+  exe->Build(&graph, outputs);
+
+  auto *src_op =
+      dynamic_cast<ExternalSource<CPUBackend> *>(graph.Node(OpType::CPU, 0).op.get());
+  ASSERT_NE(src_op, nullptr);
+  TensorList<CPUBackend> tl;
+  this->MakeJPEGBatch(&tl, this->batch_size_);
+  src_op->SetDataSource(tl);
+
+  exe->RunCPU();
+  exe->RunMixed();
+  exe->RunGPU();
+
+  DeviceWorkspace ws;
+  exe->Outputs(&ws);
+  ASSERT_EQ(ws.NumOutput(), 2);
+  for (int o = 0; o < 2; o++) {
+    ASSERT_TRUE(ws.OutputIsType<GPUBackend>(o));
+    TensorList<GPUBackend> &res = ws.Output<GPUBackend>(o);
+    for (int i = 0; i < this->batch_size_; ++i) {
+      this->VerifyDecode(
+          res.template tensor<uint8>(i),
+          res.tensor_shape(i)[0],
+          res.tensor_shape(i)[1], i);
+    }
+  }
+}
+
 // This test does not work with Async Executors
 TYPED_TEST(ExecutorSyncTest, TestPrefetchedExecution) {
   int batch_size = this->batch_size_ / 2;
@@ -0,0 +1,171 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_EXECUTOR_GPU_GRAPH_CACHE_H_
+#define DALI_PIPELINE_EXECUTOR_GPU_GRAPH_CACHE_H_
+
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "dali/core/cuda_graph.h"
+#include "dali/core/mm/memory.h"
+#include "dali/core/tensor_shape.h"
+
+namespace dali {
+
+/**
+ * @brief Describes the state of the GPU stage which a captured CUDA graph depends on
+ *
+ * The signature is a sequence of bytes, to which the shapes, types and addresses of the
+ * buffers and the contents of the host inputs are appended in a fixed order.
+ */
+class StageSignature {
+ public:
+  template <typename T>
+  void Append(const T &value) {
+    static_assert(std::is_trivially_copyable<T>::value, "Only POD values can be appended");
+    AppendBytes(&value, sizeof(T));
+  }
+
+  void AppendBytes(const void *data, size_t bytes) {
+    auto *b = static_cast<const uint8_t *>(data);
+    data_.insert(data_.end(), b, b + bytes);
+  }
+
+  template <int ndim>
+  void Append(const TensorListShape<ndim> &shape) {
+    Append(shape.num_samples());
+    Append(shape.sample_dim());
+    AppendBytes(shape.shapes.data(), shape.shapes.size() * sizeof(int64_t));
+  }
+
+  void clear() {
+    data_.clear();
+  }
+
+  size_t size() const noexcept {
+    return data_.size();
+  }
+
+  bool operator==(const StageSignature &other) const noexcept {
+    return data_ == other.data_;
+  }
+
+  bool operator!=(const StageSignature &other) const noexcept {
+    return !(*this == other);
+  }
+
+ private:
+  std::vector<uint8_t> data_;
+};
+
+/**
+ * @brief The CUDA graphs captured from the GPU stage, keyed by the stage signature
+ *
+ * Each combination of the queue indices uses different buffers, so there are (at least) as many
+ * graphs as there are distinct combinations. An entry may lack the graph - it means that
+ * the state has been seen once; the stage is captured when the state repeats.
+ *
+ * The cache also owns the scratch memory retained for the graphs (see kernels::ScratchpadCapture).
+ */
+class GPUGraphCache {
+ public:
+  struct Entry {
+    StageSignature signature;
+    CUDAGraphExec graph;
+  };
+
+  explicit GPUGraphCache(int max_entries = 4) : max_entries_(max_entries) {}
+
+  void SetMaxEntries(int max_entries) {
+    max_entries_ = max_entries;
+  }
+
+  int MaxEntries() const noexcept {
+    return max_entries_;
+  }
+
+  /**
+   * @brief Returns the entry with given signature or nullptr, if there's none
+   */
+  Entry *Find(const StageSignature &signature) {
+    for (auto &e : entries_)
+      if (e.signature == signature)
+        return &e;
+    return nullptr;
+  }
+
+  /**
+   * @brief Adds an entry without a graph.
+   *
+   * When the cache is full, the state of the stage has changed (or it's not static),
+   * so all the graphs are discarded.
+   */
+  Entry &Add(StageSignature signature) {
+    if (static_cast<int>(entries_.size()) >= max_entries_)
+      Clear();
+    entries_.emplace_back();
+    entries_.back().signature = std::move(signature);
+    return entries_.back();
+  }
+
+  /**
+   * @brief Destroys the graphs and frees the retained scratch memory
+   *
+   * The caller must ensure that the graphs are not running.
+   */
+  void Clear() {
+    entries_.clear();
+    num_graphs_ = 0;
+    retained_scratch_.clear();
+  }
+
+  /**
+   * @brief Stores the graph in the entry; the entry's signature is replaced
+   */
+  void SetGraph(Entry &entry, StageSignature signature, CUDAGraphExec graph) {
+    if (!entry.graph && graph)
+      num_graphs_++;
+    else if (entry.graph && !graph)
+      num_graphs_--;
+    entry.signature = std::move(signature);
+    entry.graph = std::move(graph);
+  }
+
+  bool HasGraphs() const noexcept {
+    return num_graphs_ > 0;
+  }
+
+  size_t size() const noexcept {
+    return entries_.size();
+  }
+
+  std::vector<mm::uptr<char>> &RetainedScratch() {
+    return retained_scratch_;
+  }
+
+ private:
+  int max_entries_;
+  int num_graphs_ = 0;
+  // a list, because the entries are referred to by pointer
+  std::list<Entry> entries_;
+  std::vector<mm::uptr<char>> retained_scratch_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_EXECUTOR_GPU_GRAPH_CACHE_H_
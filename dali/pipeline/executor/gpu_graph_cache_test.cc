@@ -0,0 +1,69 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include "dali/pipeline/executor/gpu_graph_cache.h"
+
+namespace dali {
+
+namespace test {
+
+namespace {
+
+StageSignature MakeSignature(const TensorListShape<> &shape, const void *ptr) {
+  StageSignature sig;
+  sig.Append(shape);
+  sig.Append(ptr);
+  return sig;
+}
+
+}  // namespace
+
+TEST(GPUGraphCacheTest, Signature) {
+  int a = 0, b = 0;
+  TensorListShape<> s1 = {{ 2, 3 }, { 4, 5 }};
+  TensorListShape<> s2 = {{ 2, 3 }, { 4, 6 }};
+  TensorListShape<> s3 = {{ 2, 3, 4, 5 }};
+  EXPECT_EQ(MakeSignature(s1, &a), MakeSignature(s1, &a));
+  EXPECT_NE(MakeSignature(s1, &a), MakeSignature(s1, &b));
+  EXPECT_NE(MakeSignature(s1, &a), MakeSignature(s2, &a));
+  // the same flattened extents
+  EXPECT_NE(MakeSignature(s1, &a), MakeSignature(s3, &a));
+}
+
+TEST(GPUGraphCacheTest, FindAndEvict) {
+  int data[3];
+  TensorListShape<> shape = {{ 2, 3 }};
+  GPUGraphCache cache(2);
+  EXPECT_EQ(cache.Find(MakeSignature(shape, &data[0])), nullptr);
+
+  auto &e0 = cache.Add(MakeSignature(shape, &data[0]));
+  auto &e1 = cache.Add(MakeSignature(shape, &data[1]));
+  EXPECT_EQ(cache.Find(MakeSignature(shape, &data[0])), &e0);
+  EXPECT_EQ(cache.Find(MakeSignature(shape, &data[1])), &e1);
+  EXPECT_FALSE(e0.graph);
+  EXPECT_FALSE(cache.HasGraphs());
+
+  cache.RetainedScratch().push_back(mm::alloc_raw_unique<char, mm::memory_kind::host>(16));
+  // the cache is full - the state is not static, everything is discarded
+  auto &e2 = cache.Add(MakeSignature(shape, &data[2]));
+  EXPECT_EQ(cache.size(), 1u);
+  EXPECT_EQ(cache.Find(MakeSignature(shape, &data[2])), &e2);
+  EXPECT_EQ(cache.Find(MakeSignature(shape, &data[0])), nullptr);
+  EXPECT_TRUE(cache.RetainedScratch().empty());
+}
+
+}  // namespace test
+
+}  // namespace dali
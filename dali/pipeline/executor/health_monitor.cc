@@ -0,0 +1,236 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <sstream>
+#include <string>
+#include "dali/pipeline/executor/health_monitor.h"
+#include "dali/core/format.h"
+#include "dali/pipeline/executor/queue_metadata.h"
+
+namespace dali {
+
+namespace {
+
+double Seconds(HealthMonitor::Clock::duration d) {
+  return std::chrono::duration<double>(d).count();
+}
+
+const char *StageLabel(OpType stage) {
+  switch (stage) {
+    case OpType::CPU:
+      return "cpu";
+    case OpType::MIXED:
+      return "mixed";
+    default:
+      return "gpu";
+  }
+}
+
+std::string EscapeLabel(const std::string &value) {
+  std::string ret;
+  ret.reserve(value.size());
+  for (char c : value) {
+    if (c == '\\' || c == '"')
+      ret += '\\';
+    if (c == '\n') {
+      ret += "\\n";
+      continue;
+    }
+    ret += c;
+  }
+  return ret;
+}
+
+class PrometheusWriter {
+ public:
+  explicit PrometheusWriter(const std::string &labels) : labels_(labels) {}
+
+  void Metric(const char *name, const char *type, const char *help) {
+    os_ << "# HELP " << name << " " << help << "\n";
+    os_ << "# TYPE " << name << " " << type << "\n";
+    name_ = name;
+  }
+
+  template <typename T>
+  void Sample(T value, const std::string &labels = "") {
+    os_ << name_;
+    if (!labels_.empty() || !labels.empty()) {
+      os_ << "{" << labels_;
+      if (!labels_.empty() && !labels.empty())
+        os_ << ",";
+      os_ << labels << "}";
+    }
+    os_ << " " << value << "\n";
+  }
+
+  std::string str() const {
+    return os_.str();
+  }
+
+ private:
+  std::string labels_;
+  const char *name_ = "";
+  std::stringstream os_;
+};
+
+constexpr OpType kStageOrder[] = { OpType::CPU, OpType::MIXED, OpType::GPU };
+
+}  // namespace
+
+const char *PipelineHealth::Bottleneck() const {
+  if (outputs == 0)
+    return "unknown";
+  return consumer_wait_time > stage(OpType::CPU).wait_time ? "pipeline" : "consumer";
+}
+
+std::string FormatPrometheus(const PipelineHealth &health, const std::string &labels) {
+  PrometheusWriter w(labels);
+  auto stage_label = [](OpType stage) {
+    return make_string("stage=\"", StageLabel(stage), "\"");
+  };
+
+  w.Metric("dali_uptime_seconds", "gauge", "Time since the pipeline started.");
+  w.Sample(health.uptime);
+
+  w.Metric("dali_stage_iterations_total", "counter", "Batches processed by the stage.");
+  for (auto stage : kStageOrder)
+    w.Sample(health.stage(stage).iterations, stage_label(stage));
+  w.Metric("dali_stage_wait_seconds_total", "counter",
+           "Time the stage spent waiting for the buffers.");
+  for (auto stage : kStageOrder)
+    w.Sample(health.stage(stage).wait_time, stage_label(stage));
+  w.Metric("dali_stage_stalls_total", "counter", "Long waits of the stage for the buffers.");
+  for (auto stage : kStageOrder)
+    w.Sample(health.stage(stage).stalls, stage_label(stage));
+  w.Metric("dali_queue_occupancy", "gauge",
+           "Batches produced by the stage and not yet taken by the next one.");
+  for (auto stage : kStageOrder)
+    w.Sample(health.stage(stage).output_queue.occupancy, stage_label(stage));
+  w.Metric("dali_queue_capacity", "gauge", "Buffers of the stage.");
+  for (auto stage : kStageOrder)
+    w.Sample(health.stage(stage).output_queue.capacity, stage_label(stage));
+  w.Metric("dali_queue_mean_occupancy", "gauge",
+           "Occupancy of the output queue of the stage averaged over the uptime.");
+  for (auto stage : kStageOrder)
+    w.Sample(health.stage(stage).output_queue.mean_occupancy, stage_label(stage));
+
+  w.Metric("dali_outputs_total", "counter", "Batches taken by the consumer.");
+  w.Sample(health.outputs);
+  w.Metric("dali_consumer_wait_seconds_total", "counter",
+           "Time the consumer spent waiting for the batches.");
+  w.Sample(health.consumer_wait_time);
+  w.Metric("dali_consumer_starved_total", "counter",
+           "Batches requested by the consumer when none was ready.");
+  w.Sample(health.consumer_starved);
+
+  if (!health.readers.empty()) {
+    auto reader_label = [](const ReaderHealth &reader) {
+      return make_string("reader=\"", EscapeLabel(reader.name), "\"");
+    };
+    w.Metric("dali_reader_prefetch_queue_depth", "gauge", "Batches prefetched by the reader.");
+    for (auto &reader : health.readers)
+      w.Sample(reader.prefetch_queue_depth, reader_label(reader));
+    w.Metric("dali_reader_prefetch_queue_fill", "gauge",
+             "Prefetched batches ready when the last one was requested.");
+    for (auto &reader : health.readers)
+      w.Sample(reader.prefetch_queue_fill, reader_label(reader));
+    w.Metric("dali_reader_starved_total", "counter", "Batches the reader had to wait for.");
+    for (auto &reader : health.readers)
+      w.Sample(reader.starved, reader_label(reader));
+    w.Metric("dali_reader_wait_seconds_total", "counter",
+             "Time spent waiting for the prefetched batches.");
+    for (auto &reader : health.readers)
+      w.Sample(reader.wait_time, reader_label(reader));
+  }
+
+  w.Metric("dali_thread_pool_threads", "gauge", "Threads of the thread pool.");
+  w.Sample(health.thread_pool_threads);
+  w.Metric("dali_thread_pool_busy_seconds_total", "counter",
+           "Thread time spent running the work of the pipeline.");
+  w.Sample(health.thread_pool_busy_time);
+  w.Metric("dali_thread_pool_busy_fraction", "gauge",
+           "Fraction of the thread time spent running the work of the pipeline.");
+  w.Sample(health.thread_pool_busy_fraction());
+  return w.str();
+}
+
+void HealthMonitor::SetCapacity(OpType stage, int capacity) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  queues_[static_cast<int>(stage)].capacity = capacity;
+}
+
+void HealthMonitor::ChangeOccupancy(OpType stage, int delta, Clock::time_point now) {
+  auto &queue = queues_[static_cast<int>(stage)];
+  auto since = queue.last_change == Clock::time_point() ? start_ : queue.last_change;
+  queue.occupancy_time += queue.occupancy * Seconds(now - since);
+  queue.occupancy += delta;
+  queue.last_change = now;
+}
+
+void HealthMonitor::StageAcquired(OpType stage, Clock::time_point wait_start, bool valid) {
+  auto now = Clock::now();
+  double wait = Seconds(now - wait_start);
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto &stats = stages_[static_cast<int>(stage)];
+  stats.wait_time += wait;
+  if (wait > kStallThreshold)
+    stats.stalls++;
+  if (valid && HasPreviousStage(stage))
+    ChangeOccupancy(PreviousStage(stage), -1, now);
+}
+
+void HealthMonitor::StageReleased(OpType stage) {
+  auto now = Clock::now();
+  std::lock_guard<std::mutex> lock(mutex_);
+  stages_[static_cast<int>(stage)].iterations++;
+  ChangeOccupancy(stage, 1, now);
+}
+
+HealthMonitor::Clock::time_point HealthMonitor::OutputRequested() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (queues_[static_cast<int>(OpType::GPU)].occupancy <= 0)
+    consumer_starved_++;
+  return Clock::now();
+}
+
+void HealthMonitor::OutputAcquired(Clock::time_point wait_start) {
+  auto now = Clock::now();
+  std::lock_guard<std::mutex> lock(mutex_);
+  outputs_++;
+  consumer_wait_time_ += Seconds(now - wait_start);
+  ChangeOccupancy(OpType::GPU, -1, now);
+}
+
+PipelineHealth HealthMonitor::Snapshot() const {
+  auto now = Clock::now();
+  PipelineHealth health;
+  health.uptime = Seconds(now - start_);
+  std::lock_guard<std::mutex> lock(mutex_);
+  health.stages = stages_;
+  for (int i = 0; i < static_cast<int>(OpType::COUNT); i++) {
+    auto &queue = queues_[i];
+    auto &out = health.stages[i].output_queue;
+    out.occupancy = queue.occupancy;
+    out.capacity = queue.capacity;
+    auto since = queue.last_change == Clock::time_point() ? start_ : queue.last_change;
+    double occupancy_time = queue.occupancy_time + queue.occupancy * Seconds(now - since);
+    out.mean_occupancy = health.uptime > 0 ? occupancy_time / health.uptime : 0;
+  }
+  health.outputs = outputs_;
+  health.consumer_wait_time = consumer_wait_time_;
+  health.consumer_starved = consumer_starved_;
+  return health;
+}
+
+}  // namespace dali
@@ -0,0 +1,175 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_EXECUTOR_HEALTH_MONITOR_H_
+#define DALI_PIPELINE_EXECUTOR_HEALTH_MONITOR_H_
+
+#include <array>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "dali/core/common.h"
+
+namespace dali {
+
+/**
+ * @brief The batches produced by a stage and not yet taken by the next stage (or,
+ *        for the last stage, by the consumer of the pipeline)
+ */
+struct QueueHealth {
+  int occupancy = 0;
+  /// the number of buffers of the stage
+  int capacity = 0;
+  /// the occupancy averaged over the time since the pipeline started
+  double mean_occupancy = 0;
+};
+
+struct StageHealth {
+  int64_t iterations = 0;
+  /// time spent waiting for the buffers - for a free one or for the output of the previous stage
+  double wait_time = 0;
+  /// the number of waits longer than HealthMonitor::kStallThreshold
+  int64_t stalls = 0;
+  QueueHealth output_queue;
+};
+
+/**
+ * @brief The prefetching of a reader, as seen by the operator taking the batches
+ */
+struct ReaderHealth {
+  std::string name;
+  int prefetch_queue_depth = 0;
+  /// the batches ready when the operator asked for the last one
+  int prefetch_queue_fill = 0;
+  /// the number of batches the operator had to wait for
+  int64_t starved = 0;
+  double wait_time = 0;
+};
+
+/**
+ * @brief A snapshot of the state of the pipeline, to tell where the time is lost
+ *
+ * The counters and the times (in seconds) are cumulative since the pipeline started,
+ * so the rates can be computed from two snapshots.
+ */
+struct DLL_PUBLIC PipelineHealth {
+  double uptime = 0;
+  /// indexed with OpType
+  std::array<StageHealth, static_cast<int>(OpType::COUNT)> stages;
+  /// the batches taken by the consumer
+  int64_t outputs = 0;
+  /// time the consumer spent waiting for the batches
+  double consumer_wait_time = 0;
+  /// the number of batches requested when none was ready
+  int64_t consumer_starved = 0;
+  std::vector<ReaderHealth> readers;
+  int thread_pool_threads = 0;
+  /// the thread time spent running the work of the pipeline in its thread pool
+  double thread_pool_busy_time = 0;
+
+  const StageHealth &stage(OpType type) const {
+    return stages[static_cast<int>(type)];
+  }
+
+  StageHealth &stage(OpType type) {
+    return stages[static_cast<int>(type)];
+  }
+
+  /**
+   * @brief The fraction of the thread time of the pool spent on the work of the pipeline
+   */
+  double thread_pool_busy_fraction() const {
+    return thread_pool_threads > 0 && uptime > 0 ?
+           thread_pool_busy_time / (thread_pool_threads * uptime) : 0;
+  }
+
+  /**
+   * @brief Tells which side waits for the other: "pipeline" when the consumer waits for
+   *        the batches longer than the first stage waits for the buffers to be released,
+   *        "consumer" otherwise, or "unknown" before any batch was taken.
+   */
+  const char *Bottleneck() const;
+};
+
+/**
+ * @brief Formats the snapshot in the Prometheus text exposition format
+ *
+ * @param labels  labels added to every sample, e.g. `pipeline="train"`; can be empty
+ */
+DLL_PUBLIC std::string FormatPrometheus(const PipelineHealth &health,
+                                        const std::string &labels = "");
+
+/**
+ * @brief Collects the PipelineHealth data of the executor; thread-safe
+ *
+ * The stages report taking a batch from the previous stage (Acquired) and passing one on
+ * (Released); the consumer reports taking the outputs. It's always on - it costs a few clock
+ * reads per iteration.
+ */
+class DLL_PUBLIC HealthMonitor {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  /// the waits that count as stalls, in seconds
+  static constexpr double kStallThreshold = 1e-3;
+
+  HealthMonitor() : start_(Clock::now()) {}
+
+  void SetCapacity(OpType stage, int capacity);
+
+  /**
+   * @brief The stage got its buffers; the wait started at `wait_start`
+   *
+   * @param valid  false if the stage was stopped instead
+   */
+  void StageAcquired(OpType stage, Clock::time_point wait_start, bool valid = true);
+
+  /**
+   * @brief The stage finished a batch and passed it on
+   */
+  void StageReleased(OpType stage);
+
+  /**
+   * @brief The consumer asks for the outputs; returns the start of the wait
+   */
+  Clock::time_point OutputRequested();
+
+  void OutputAcquired(Clock::time_point wait_start);
+
+  PipelineHealth Snapshot() const;
+
+ private:
+  struct QueueState {
+    int occupancy = 0;
+    int capacity = 0;
+    /// the integral of the occupancy over time
+    double occupancy_time = 0;
+    Clock::time_point last_change;
+  };
+
+  void ChangeOccupancy(OpType stage, int delta, Clock::time_point now);
+
+  Clock::time_point start_;
+  mutable std::mutex mutex_;
+  std::array<StageHealth, static_cast<int>(OpType::COUNT)> stages_;
+  std::array<QueueState, static_cast<int>(OpType::COUNT)> queues_;
+  int64_t outputs_ = 0;
+  double consumer_wait_time_ = 0;
+  int64_t consumer_starved_ = 0;
+};
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_EXECUTOR_HEALTH_MONITOR_H_
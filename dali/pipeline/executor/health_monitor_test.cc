@@ -0,0 +1,87 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <string>
+#include "dali/pipeline/executor/health_monitor.h"
+
+namespace dali {
+
+TEST(HealthMonitor, QueueOccupancy) {
+  HealthMonitor monitor;
+  monitor.SetCapacity(OpType::CPU, 3);
+  auto now = HealthMonitor::Clock::now();
+  // two batches through the CPU stage, one of them taken by the mixed stage
+  monitor.StageAcquired(OpType::CPU, now);
+  monitor.StageReleased(OpType::CPU);
+  monitor.StageAcquired(OpType::CPU, now);
+  monitor.StageReleased(OpType::CPU);
+  monitor.StageAcquired(OpType::MIXED, now);
+  // stopped - doesn't take a batch
+  monitor.StageAcquired(OpType::MIXED, now, false);
+
+  auto health = monitor.Snapshot();
+  EXPECT_EQ(health.stage(OpType::CPU).iterations, 2);
+  EXPECT_EQ(health.stage(OpType::CPU).output_queue.occupancy, 1);
+  EXPECT_EQ(health.stage(OpType::CPU).output_queue.capacity, 3);
+  EXPECT_GE(health.stage(OpType::CPU).output_queue.mean_occupancy, 0);
+  EXPECT_LE(health.stage(OpType::CPU).output_queue.mean_occupancy, 2);
+  EXPECT_EQ(health.stage(OpType::MIXED).output_queue.occupancy, 0);
+}
+
+TEST(HealthMonitor, ConsumerStarvation) {
+  HealthMonitor monitor;
+  auto start = monitor.OutputRequested();  // nothing ready
+  monitor.StageReleased(OpType::GPU);
+  monitor.OutputAcquired(start);
+  monitor.StageReleased(OpType::GPU);
+  start = monitor.OutputRequested();  // a batch is ready
+  monitor.OutputAcquired(start);
+
+  auto health = monitor.Snapshot();
+  EXPECT_EQ(health.outputs, 2);
+  EXPECT_EQ(health.consumer_starved, 1);
+  EXPECT_EQ(health.stage(OpType::GPU).output_queue.occupancy, 0);
+  EXPECT_GE(health.consumer_wait_time, 0);
+  EXPECT_STREQ(health.Bottleneck(), "pipeline");
+  EXPECT_STREQ(PipelineHealth().Bottleneck(), "unknown");
+}
+
+TEST(HealthMonitor, Stalls) {
+  HealthMonitor monitor;
+  auto long_ago = HealthMonitor::Clock::now() - std::chrono::milliseconds(10);
+  monitor.StageAcquired(OpType::CPU, long_ago);
+  monitor.StageAcquired(OpType::CPU, HealthMonitor::Clock::now());
+  auto health = monitor.Snapshot();
+  EXPECT_EQ(health.stage(OpType::CPU).stalls, 1);
+  EXPECT_GE(health.stage(OpType::CPU).wait_time, 0.01);
+}
+
+TEST(HealthMonitor, Prometheus) {
+  PipelineHealth health;
+  health.outputs = 5;
+  health.stage(OpType::MIXED).iterations = 7;
+  health.readers.push_back({"my \"reader\"", 2, 1, 3, 0.5});
+  auto text = FormatPrometheus(health, "pipeline=\"train\"");
+  EXPECT_NE(text.find("# TYPE dali_outputs_total counter\n"), std::string::npos);
+  EXPECT_NE(text.find("dali_outputs_total{pipeline=\"train\"} 5\n"), std::string::npos);
+  EXPECT_NE(text.find("dali_stage_iterations_total{pipeline=\"train\",stage=\"mixed\"} 7\n"),
+            std::string::npos);
+  EXPECT_NE(text.find(
+      "dali_reader_starved_total{pipeline=\"train\",reader=\"my \\\"reader\\\"\"} 3"),
+      std::string::npos);
+  EXPECT_NE(FormatPrometheus(health).find("dali_outputs_total 5\n"), std::string::npos);
+}
+
+}  // namespace dali
@@ -16,9 +16,12 @@
 #define DALI_PIPELINE_EXECUTOR_QUEUE_POLICY_H_
 
 #include <cuda_runtime_api.h>
+#include <algorithm>
 #include <atomic>
 #include <cassert>
+#include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <mutex>
 #include <queue>
 #include <vector>
@@ -46,10 +49,15 @@ namespace dali {
 //   OutputIdxs UseOutputIdxs();
 //   // Release currently used output
 //   void ReleaseOutputIdxs();
+//   // Release the in-use output with given GPU stage index, not necessarily the oldest one
+//   void ReleaseOutputIdxs(int gpu_idx);
 //   // Wake all waiting threads and skip further execution due to stop signaled
 //   void SignalStop();
 //   // Returns true if we signaled stop previously
 //   bool IsStopSignaled();
+//   // Adapt the number of buffers in use to the observed stage and consumer latency.
+//   // Must be called before InitializeQueues().
+//   void EnableAdaptiveQueueDepth(QueueSizes min_sizes);
 // };
 
 
@@ -144,24 +152,31 @@ struct UniformQueuePolicy {
     }
     int output_idx = ready_queue_.front();
     ready_queue_.pop();
-    in_use_queue_.push(output_idx);
+    in_use_queue_.push_back(output_idx);
     lock.unlock();
     return OutputIdxs{output_idx};
   }
 
   void ReleaseOutputIdxs() {
-    // Mark the last in-use buffer as free and signal
+    // Mark the oldest in-use buffer as free and signal
     // to waiting threads
-    // TODO(klecki): in_use_queue should be guarded, but we assume it is used only in synchronous
-    // python calls
-    if (!in_use_queue_.empty()) {
-      {
-        std::lock_guard<std::mutex> lock(free_mutex_);
-        free_queue_.push(in_use_queue_.front());
-        in_use_queue_.pop();
-      }
-      free_cond_.notify_one();
-    }
+    std::unique_lock<std::mutex> lock(ready_mutex_);
+    if (in_use_queue_.empty())
+      return;
+    int released = in_use_queue_.front();
+    in_use_queue_.pop_front();
+    lock.unlock();
+    ReleaseOutputIdx(released);
+  }
+
+  void ReleaseOutputIdxs(int gpu_idx) {
+    std::unique_lock<std::mutex> lock(ready_mutex_);
+    auto it = std::find(in_use_queue_.begin(), in_use_queue_.end(), gpu_idx);
+    DALI_ENFORCE(it != in_use_queue_.end(),
+                 make_string("The output buffer ", gpu_idx, " is not in use."));
+    in_use_queue_.erase(it);
+    lock.unlock();
+    ReleaseOutputIdx(gpu_idx);
   }
 
   void NotifyAll() {
@@ -191,8 +206,22 @@ struct UniformQueuePolicy {
     return ready_stop_;
   }
 
+  void EnableAdaptiveQueueDepth(QueueSizes) {
+    DALI_FAIL("Adaptive prefetch queue depth is supported only with separated execution.");
+  }
+
  private:
-  std::queue<int> ready_queue_, free_queue_, in_use_queue_;
+  void ReleaseOutputIdx(int idx) {
+    {
+      std::lock_guard<std::mutex> lock(free_mutex_);
+      free_queue_.push(idx);
+    }
+    free_cond_.notify_one();
+  }
+
+  std::queue<int> ready_queue_, free_queue_;
+  // Guarded by ready_mutex_; the outputs can be released out of order
+  std::deque<int> in_use_queue_;
   std::mutex ready_mutex_, free_mutex_;
   std::condition_variable ready_cond_, free_cond_;
 
@@ -224,14 +253,58 @@ struct SeparateQueuePolicy {
     return result;
   }
 
+  /**
+   * @brief Makes the number of buffers that are used by each stage adaptive
+   *
+   * The queue sizes passed to GetQueueSizes become the upper bounds - all the buffers are
+   * still preallocated, but only some of them are in circulation. The depth starts at
+   * `min_sizes` and is adjusted once per iteration, in UseOutputIdxs:
+   *  - when the consumer had to wait for the outputs, the depth of the stage with the
+   *    higher latency is increased,
+   *  - when the consumer didn't wait for `kShrinkInterval` iterations, the depth of
+   *    the other stage is decreased.
+   *
+   * Must be called before InitializeQueues.
+   */
+  void EnableAdaptiveQueueDepth(QueueSizes min_sizes) {
+    DALI_ENFORCE(min_sizes.cpu_size > 0 && min_sizes.gpu_size > 0,
+                 "Only positive queue sizes allowed");
+    adaptive_ = true;
+    min_depth_ = GetQueueSizes(min_sizes);
+  }
+
   void InitializeQueues(const StageQueues &stage_queue_depths) {
+    max_depth_ = stage_queue_depths;
+    if (adaptive_) {
+      for (int stage = 0; stage < kOpCount; stage++) {
+        auto op_type = static_cast<OpType>(stage);
+        DALI_ENFORCE(min_depth_[op_type] <= max_depth_[op_type], make_string(
+            "The minimum queue depth cannot exceed the prefetch queue depth, got: ",
+            min_depth_, " and ", max_depth_));
+      }
+      depth_ = min_depth_;
+    } else {
+      depth_ = max_depth_;
+    }
     for (int stage = 0; stage < static_cast<int>(OpType::COUNT); stage++) {
-      for (int i = 0; i < stage_queue_depths[static_cast<OpType>(stage)]; i++) {
+      auto op_type = static_cast<OpType>(stage);
+      for (int i = 0; i < depth_[op_type]; i++) {
         stage_free_[stage].push(i);
       }
+      for (int i = max_depth_[op_type] - 1; i >= depth_[op_type]; i--) {
+        stage_parked_[stage].push_back(i);
+      }
     }
   }
 
+  /**
+   * @brief Returns the number of buffers currently in use by each of the stages
+   */
+  StageQueues GetQueueDepths() {
+    std::lock_guard<std::mutex> lock(adaptive_mutex_);
+    return depth_;
+  }
+
   QueueIdxs AcquireIdxs(OpType stage) {
     QueueIdxs result;
     // We dine with the philosophers
@@ -266,6 +339,8 @@ struct SeparateQueuePolicy {
       result[stage] = stage_free_[current_stage].front();
       stage_free_[current_stage].pop();
     }
+    if (adaptive_)
+      stage_start_[current_stage] = Clock::now();
     return result;
   }
 
@@ -274,6 +349,8 @@ struct SeparateQueuePolicy {
       return;
     }
     int current_stage = static_cast<int>(stage);
+    if (adaptive_)
+      RecordStageLatency(stage);
     {
       std::lock_guard<std::mutex> ready_current_lock(stage_ready_mutex_[current_stage]);
       // Store the idxs up to the point of stage that we processed
@@ -294,6 +371,8 @@ struct SeparateQueuePolicy {
   }
 
   void QueueOutputIdxs(QueueIdxs idxs, cudaStream_t gpu_op_stream) {
+    if (adaptive_)
+      RecordStageLatency(OpType::GPU);
     {
       std::lock_guard<std::mutex> ready_output_lock(ready_output_mutex_);
       ready_output_queue_.push({idxs[OpType::CPU], idxs[OpType::MIXED], idxs[OpType::GPU]});
@@ -304,6 +383,7 @@ struct SeparateQueuePolicy {
   OutputIdxs UseOutputIdxs() {
     // Block until the work for a batch has been issued.
     // Move the queue id from ready to in_use
+    auto wait_start = Clock::now();
     std::unique_lock<std::mutex> ready_lock(ready_output_mutex_);
     ready_output_cv_.wait(ready_lock, [this]() {
       return !ready_output_queue_.empty() || ready_stop_;
@@ -313,25 +393,36 @@ struct SeparateQueuePolicy {
     }
     auto output_idx = ready_output_queue_.front();
     ready_output_queue_.pop();
-    // TODO(klecki): in_use_queue should be guarded, but we assume it is used only in synchronous
-    // python calls
-    in_use_queue_.push(output_idx);
+    in_use_queue_.push_back(output_idx);
     ready_lock.unlock();
+    if (adaptive_)
+      AdaptQueueDepth(Seconds(Clock::now() - wait_start));
     return output_idx;
   }
 
   void ReleaseOutputIdxs() {
-    // Mark the last in-use buffer as free and signal
+    // Mark the oldest in-use buffer as free and signal
     // to waiting threads
-    if (!in_use_queue_.empty()) {
-      // TODO(klecki): in_use_queue should be guarded, but we assume it is used only in synchronous
-      // python calls
-      auto processed = in_use_queue_.front();
-      in_use_queue_.pop();
-      ReleaseStageIdx(OpType::CPU, processed.cpu);
-      ReleaseStageIdx(OpType::MIXED, processed.mixed);
-      ReleaseStageIdx(OpType::GPU, processed.gpu);
-    }
+    std::unique_lock<std::mutex> ready_lock(ready_output_mutex_);
+    if (in_use_queue_.empty())
+      return;
+    auto processed = in_use_queue_.front();
+    in_use_queue_.pop_front();
+    ready_lock.unlock();
+    ReleaseStageIdxs(processed);
+  }
+
+  void ReleaseOutputIdxs(int gpu_idx) {
+    // The GPU stage buffer is held until the output is released, so it identifies the output
+    std::unique_lock<std::mutex> ready_lock(ready_output_mutex_);
+    auto it = std::find_if(in_use_queue_.begin(), in_use_queue_.end(),
+                           [gpu_idx](const OutputIdxs &idxs) { return idxs.gpu == gpu_idx; });
+    DALI_ENFORCE(it != in_use_queue_.end(),
+                 make_string("The output buffer ", gpu_idx, " is not in use."));
+    auto processed = *it;
+    in_use_queue_.erase(it);
+    ready_lock.unlock();
+    ReleaseStageIdxs(processed);
   }
 
   void NotifyAll() {
@@ -372,17 +463,120 @@ struct SeparateQueuePolicy {
   }
 
  private:
+  using Clock = std::chrono::high_resolution_clock;
+
+  static double Seconds(Clock::duration d) {
+    return std::chrono::duration<double>(d).count();
+  }
+
+  void ReleaseStageIdxs(const OutputIdxs &processed) {
+    ReleaseStageIdx(OpType::CPU, processed.cpu);
+    ReleaseStageIdx(OpType::MIXED, processed.mixed);
+    ReleaseStageIdx(OpType::GPU, processed.gpu);
+  }
+
   void ReleaseStageIdx(OpType stage, int idx) {
     auto released_stage = static_cast<int>(stage);
     // We release the consumed buffer
     {
       std::lock_guard<std::mutex> free_lock(stage_free_mutex_[released_stage]);
+      if (stage_to_park_[released_stage] > 0) {
+        // The stage was shrunk while this buffer was in use - take it out of circulation
+        stage_to_park_[released_stage]--;
+        stage_parked_[released_stage].push_back(idx);
+        return;
+      }
       stage_free_[released_stage].push(idx);
     }
     // We freed buffer, so we notfiy the released stage it can continue it's work
     stage_free_cv_[released_stage].notify_one();
   }
 
+  /**
+   * @brief Updates the moving average of the time spent in the stage.
+   *
+   * Each stage is executed by one thread at a time, so the start time needs no guarding.
+   */
+  void RecordStageLatency(OpType stage) {
+    double latency = Seconds(Clock::now() - stage_start_[static_cast<int>(stage)]);
+    std::lock_guard<std::mutex> lock(adaptive_mutex_);
+    auto &avg = stage_latency_[static_cast<int>(stage)];
+    avg = avg < 0 ? latency : avg + kLatencySmoothing * (latency - avg);
+  }
+
+  /**
+   * @brief Grows or shrinks the depth of the CPU or the GPU queues (Mixed and GPU stages
+   *        are bound together) based on the time the consumer waited for the outputs.
+   */
+  void AdaptQueueDepth(double consumer_wait) {
+    std::lock_guard<std::mutex> lock(adaptive_mutex_);
+    double cpu_latency = std::max(stage_latency_[static_cast<int>(OpType::CPU)], 0.0);
+    double gpu_latency = std::max(stage_latency_[static_cast<int>(OpType::MIXED)], 0.0) +
+                         std::max(stage_latency_[static_cast<int>(OpType::GPU)], 0.0);
+    bool cpu_bound = cpu_latency >= gpu_latency;
+    if (consumer_wait > kStarvationThreshold * std::max(cpu_latency, gpu_latency)) {
+      iters_without_wait_ = 0;
+      // Try the bottleneck first - a deeper queue hides the variation of its latency
+      if (!ResizeStages(cpu_bound, 1))
+        ResizeStages(!cpu_bound, 1);
+    } else if (++iters_without_wait_ >= kShrinkInterval) {
+      iters_without_wait_ = 0;
+      if (!ResizeStages(!cpu_bound, -1))
+        ResizeStages(cpu_bound, -1);
+    }
+  }
+
+  /**
+   * @brief Changes the depth of the CPU stage or the Mixed and GPU stages by `delta`.
+   *
+   * @return false, if the depth would go outside of the bounds
+   */
+  bool ResizeStages(bool cpu, int delta) {
+    auto stages = cpu ? std::vector<OpType>{OpType::CPU}
+                      : std::vector<OpType>{OpType::MIXED, OpType::GPU};
+    for (auto stage : stages) {
+      int new_depth = depth_[stage] + delta;
+      if (new_depth < min_depth_[stage] || new_depth > max_depth_[stage])
+        return false;
+    }
+    for (auto stage : stages) {
+      depth_[stage] += delta;
+      if (delta > 0)
+        UnparkStageIdx(stage);
+      else
+        ParkStageIdx(stage);
+    }
+    return true;
+  }
+
+  void UnparkStageIdx(OpType stage) {
+    auto unparked_stage = static_cast<int>(stage);
+    {
+      std::lock_guard<std::mutex> free_lock(stage_free_mutex_[unparked_stage]);
+      if (stage_to_park_[unparked_stage] > 0) {
+        // A buffer that was about to be parked is still in use - just keep it
+        stage_to_park_[unparked_stage]--;
+        return;
+      }
+      assert(!stage_parked_[unparked_stage].empty());
+      stage_free_[unparked_stage].push(stage_parked_[unparked_stage].back());
+      stage_parked_[unparked_stage].pop_back();
+    }
+    stage_free_cv_[unparked_stage].notify_one();
+  }
+
+  void ParkStageIdx(OpType stage) {
+    auto parked_stage = static_cast<int>(stage);
+    std::lock_guard<std::mutex> free_lock(stage_free_mutex_[parked_stage]);
+    if (stage_free_[parked_stage].empty()) {
+      // All the buffers are in use - park the first one that is released
+      stage_to_park_[parked_stage]++;
+      return;
+    }
+    stage_parked_[parked_stage].push_back(stage_free_[parked_stage].front());
+    stage_free_[parked_stage].pop();
+  }
+
   void ReleaseStageIdx(OpType stage, QueueIdxs idxs) {
     ReleaseStageIdx(stage, idxs[stage]);
   }
@@ -416,7 +610,27 @@ struct SeparateQueuePolicy {
   std::mutex ready_output_mutex_;
 
   std::queue<OutputIdxs> ready_output_queue_;
-  std::queue<OutputIdxs> in_use_queue_;
+  // Guarded by ready_output_mutex_; the outputs can be released out of order
+  std::deque<OutputIdxs> in_use_queue_;
+
+  // Adaptive queue depth
+  // Relative consumer wait time (w.r.t. the stage latency) that is considered a stall
+  static constexpr double kStarvationThreshold = 0.05;
+  // Number of iterations without a stall after which a queue is shrunk
+  static constexpr int kShrinkInterval = 100;
+  static constexpr double kLatencySmoothing = 0.1;
+
+  bool adaptive_ = false;
+  StageQueues min_depth_, max_depth_, depth_;
+  // Buffers that are preallocated, but currently not in circulation;
+  // guarded by the stage_free_mutex_
+  std::array<std::vector<int>, kOpCount> stage_parked_;
+  std::array<int, kOpCount> stage_to_park_ = {{0, 0, 0}};
+  std::array<Clock::time_point, kOpCount> stage_start_;
+  // Guards depth_ and the statistics below
+  std::mutex adaptive_mutex_;
+  std::array<double, kOpCount> stage_latency_ = {{-1, -1, -1}};
+  int iters_without_wait_ = 0;
 };
 
 
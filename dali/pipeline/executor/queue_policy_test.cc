@@ -0,0 +1,134 @@
+// Copyright (c) 2021, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+
+#include "dali/pipeline/executor/queue_policy.h"
+
+namespace dali {
+
+namespace test {
+
+namespace {
+
+/**
+ * @brief Runs all the stages for one iteration and returns the outputs to the consumer
+ */
+void RunIteration(SeparateQueuePolicy &policy, std::chrono::microseconds cpu_time = {}) {
+  auto idxs = policy.AcquireIdxs(OpType::CPU);
+  std::this_thread::sleep_for(cpu_time);
+  policy.ReleaseIdxs(OpType::CPU, idxs);
+  idxs = policy.AcquireIdxs(OpType::MIXED);
+  policy.ReleaseIdxs(OpType::MIXED, idxs);
+  idxs = policy.AcquireIdxs(OpType::GPU);
+  policy.QueueOutputIdxs(idxs, 0);
+}
+
+}  // namespace
+
+TEST(SeparateQueuePolicyTest, FixedDepth) {
+  SeparateQueuePolicy policy;
+  auto depths = SeparateQueuePolicy::GetQueueSizes(QueueSizes{3, 2});
+  policy.InitializeQueues(depths);
+  auto current = policy.GetQueueDepths();
+  EXPECT_EQ(current[OpType::CPU], 3);
+  EXPECT_EQ(current[OpType::MIXED], 2);
+  EXPECT_EQ(current[OpType::GPU], 2);
+}
+
+TEST(SeparateQueuePolicyTest, AdaptiveDepthGrowsWhenConsumerWaits) {
+  SeparateQueuePolicy policy;
+  policy.EnableAdaptiveQueueDepth(QueueSizes{1, 1});
+  policy.InitializeQueues(SeparateQueuePolicy::GetQueueSizes(QueueSizes{3, 2}));
+  auto current = policy.GetQueueDepths();
+  EXPECT_EQ(current[OpType::CPU], 1);
+  EXPECT_EQ(current[OpType::GPU], 1);
+
+  // The CPU stage is slow and the consumer waits for it on every iteration
+  for (int i = 0; i < 10; i++) {
+    std::thread producer([&]() { RunIteration(policy, std::chrono::microseconds(2000)); });
+    auto out = policy.UseOutputIdxs();
+    producer.join();
+    EXPECT_GE(out.cpu, 0);
+    policy.ReleaseOutputIdxs();
+  }
+  current = policy.GetQueueDepths();
+  EXPECT_EQ(current[OpType::CPU], 3);
+  EXPECT_EQ(current[OpType::MIXED], 2);
+  EXPECT_EQ(current[OpType::GPU], 2);
+}
+
+TEST(SeparateQueuePolicyTest, AdaptiveDepthShrinksWhenOutputsAreReady) {
+  SeparateQueuePolicy policy;
+  policy.EnableAdaptiveQueueDepth(QueueSizes{1, 1});
+  policy.InitializeQueues(SeparateQueuePolicy::GetQueueSizes(QueueSizes{3, 2}));
+
+  // grow
+  for (int i = 0; i < 10; i++) {
+    std::thread producer([&]() { RunIteration(policy, std::chrono::microseconds(2000)); });
+    policy.UseOutputIdxs();
+    producer.join();
+    policy.ReleaseOutputIdxs();
+  }
+
+  // The outputs are always ready before the consumer asks for them
+  for (int i = 0; i < 600; i++) {
+    RunIteration(policy, std::chrono::microseconds(500));
+    auto out = policy.UseOutputIdxs();
+    EXPECT_GE(out.cpu, 0);
+    policy.ReleaseOutputIdxs();
+  }
+  auto current = policy.GetQueueDepths();
+  EXPECT_EQ(current[OpType::CPU], 1);
+  EXPECT_EQ(current[OpType::MIXED], 1);
+  EXPECT_EQ(current[OpType::GPU], 1);
+}
+
+TEST(SeparateQueuePolicyTest, AdaptiveDepthBounds) {
+  SeparateQueuePolicy policy;
+  policy.EnableAdaptiveQueueDepth(QueueSizes{3, 1});
+  EXPECT_THROW(policy.InitializeQueues(SeparateQueuePolicy::GetQueueSizes(QueueSizes{2, 2})),
+               std::exception);
+  EXPECT_THROW(policy.EnableAdaptiveQueueDepth(QueueSizes{0, 1}), std::exception);
+}
+
+TEST(SeparateQueuePolicyTest, ReleaseOutputsOutOfOrder) {
+  SeparateQueuePolicy policy;
+  policy.InitializeQueues(SeparateQueuePolicy::GetQueueSizes(QueueSizes{2, 2}));
+  RunIteration(policy);
+  RunIteration(policy);
+  auto first = policy.UseOutputIdxs();
+  auto second = policy.UseOutputIdxs();
+  EXPECT_NE(first.gpu, second.gpu);
+
+  policy.ReleaseOutputIdxs(second.gpu);
+  EXPECT_THROW(policy.ReleaseOutputIdxs(second.gpu), std::exception);
+  // the released buffers are reused, while the first output is still in use
+  RunIteration(policy);
+  auto third = policy.UseOutputIdxs();
+  EXPECT_EQ(third.cpu, second.cpu);
+  EXPECT_EQ(third.mixed, second.mixed);
+  EXPECT_EQ(third.gpu, second.gpu);
+
+  // the oldest one
+  policy.ReleaseOutputIdxs();
+  policy.ReleaseOutputIdxs(third.gpu);
+  EXPECT_THROW(policy.ReleaseOutputIdxs(first.gpu), std::exception);
+}
+
+}  // namespace test
+
+}  // namespace dali
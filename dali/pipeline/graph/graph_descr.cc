@@ -561,7 +561,7 @@ std::vector<TensorNodeId> OpGraph::GetOutputs(const std::vector<string>& output_
         for (TensorNodeId parent_tid : Node(output.node).parent_tensors) {
           for (TensorMeta input : Tensor(parent_tid).consumers) {
             if (input.node == output.node &&
-                schema.GetPassThroughOutputIdx(input.index) == output.index) {
+                schema.IsPassThrough(input.index, output.index)) {
                 q.push_back(parent_tid);
             }
           }
@@ -580,9 +580,9 @@ bool OpGraph::HasConsumersInOtherStage(const TensorNode &tensor, OpType this_sta
       return true;
     }
     const OpSchema &schema = cons_op.spec.GetSchema();
-    int out_idx = schema.GetPassThroughOutputIdx(cons_edge.index);
-    if (out_idx >= 0) {
-      if (HasConsumersInOtherStage(Tensor(cons_op.children_tensors[out_idx]), this_stage))
+    for (int out_idx = 0; out_idx < static_cast<int>(cons_op.children_tensors.size()); out_idx++) {
+      if (schema.IsPassThrough(cons_edge.index, out_idx) &&
+          HasConsumersInOtherStage(Tensor(cons_op.children_tensors[out_idx]), this_stage))
         return true;
     }
   }
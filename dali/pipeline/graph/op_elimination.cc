@@ -0,0 +1,216 @@
+// Copyright (c) 2021, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/pipeline/graph/op_elimination.h"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+#include <utility>
+
+namespace dali {
+
+namespace {
+
+const OpSchema *TryGetSchema(const OpSpec &spec) {
+  return SchemaRegistry::TryGetSchema(spec.name());
+}
+
+bool IsPreserved(const OpSpec &spec) {
+  return spec.GetArgument<bool>("preserve");
+}
+
+bool ProducesAny(const OpSpec &spec, const std::set<std::string> &tensors) {
+  for (int o = 0; o < spec.NumOutput(); o++) {
+    if (tensors.count(spec.OutputName(o)))
+      return true;
+  }
+  return false;
+}
+
+void AppendValue(std::string &key, bool value) {
+  key += value ? '1' : '0';
+}
+
+void AppendValue(std::string &key, int64_t value) {
+  key += std::to_string(value);
+}
+
+void AppendValue(std::string &key, float value) {
+  // exact representation - to_string would round the value
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  key += std::to_string(bits);
+}
+
+void AppendValue(std::string &key, const std::string &value) {
+  key += std::to_string(value.size());
+  key += ':';
+  key += value;
+}
+
+template <typename T>
+bool TryAppendArgument(std::string &key, Argument &arg) {
+  if (arg.IsType<T>()) {
+    AppendValue(key, arg.Get<T>());
+    return true;
+  }
+  if (arg.IsType<std::vector<T>>()) {
+    key += '[';
+    for (const auto &value : arg.Get<std::vector<T>>()) {
+      AppendValue(key, value);
+      key += ',';
+    }
+    key += ']';
+    return true;
+  }
+  return false;
+}
+
+/**
+ * @brief Appends an exact representation of the argument value to the key
+ *
+ * @return false, if the type of the argument is not supported
+ */
+bool AppendArgument(std::string &key, Argument &arg) {
+  return TryAppendArgument<bool>(key, arg) ||
+         TryAppendArgument<int64_t>(key, arg) ||
+         TryAppendArgument<float>(key, arg) ||
+         TryAppendArgument<std::string>(key, arg);
+}
+
+/**
+ * @brief Builds a key that's equal for the operators that compute the same result
+ *
+ * @return false, if the operator cannot be compared with others
+ */
+bool GetOpKey(std::string &key, const OpSpec &spec) {
+  key = spec.name();
+  key += '\n';
+  for (int i = 0; i < spec.NumInput(); i++) {
+    if (spec.IsArgumentInput(i))
+      key += spec.ArgumentInputName(i) + '=';
+    key += spec.Input(i);
+    key += '\n';
+  }
+  for (int o = 0; o < spec.NumOutput(); o++) {
+    key += spec.OutputDevice(o);
+    key += '\n';
+  }
+  std::vector<std::string> arg_names;
+  for (auto &arg : spec.Arguments())
+    arg_names.push_back(arg.first);
+  std::sort(arg_names.begin(), arg_names.end());
+  for (auto &name : arg_names) {
+    // the seed matters only for ops with a random component, e.g. CropMirrorNormalize with noise
+    if (name == "seed" && !spec.ArgumentDefined("noise_stddev") &&
+        !spec.ArgumentDefined("noise_mean"))
+      continue;
+    key += name;
+    key += '=';
+    if (!AppendArgument(key, *spec.Arguments().at(name)))
+      return false;
+    key += '\n';
+  }
+  return true;
+}
+
+std::vector<OpDefinition> RemoveMarked(std::vector<OpDefinition> &ops,
+                                       const std::vector<bool> &removed) {
+  std::vector<OpDefinition> remaining;
+  for (size_t i = 0; i < ops.size(); i++) {
+    if (!removed[i])
+      remaining.push_back(std::move(ops[i]));
+  }
+  return remaining;
+}
+
+}  // namespace
+
+int EliminateCommonSubexpressions(std::vector<OpDefinition> &ops,
+                                  const std::set<std::string> &protected_tensors) {
+  std::vector<bool> removed(ops.size(), false);
+  std::unordered_map<std::string, int> first_op;
+  // full name of the tensor produced by a removed op -> name of the equivalent tensor
+  std::unordered_map<std::string, std::string> renamed;
+  int eliminated = 0;
+  std::string key;
+
+  for (int i = 0; i < static_cast<int>(ops.size()); i++) {
+    auto &spec = ops[i].spec;
+    for (int in = 0; in < spec.NumInput(); in++) {
+      auto it = renamed.find(spec.Input(in));
+      if (it != renamed.end())
+        spec.MutableInput(in).name = it->second;
+    }
+
+    auto *schema = TryGetSchema(spec);
+    if (!schema || !schema->IsDeterministic() || !GetOpKey(key, spec))
+      continue;
+
+    auto first = first_op.find(key);
+    if (first == first_op.end()) {
+      first_op.emplace(key, i);
+      continue;
+    }
+    if (IsPreserved(spec) || ProducesAny(spec, protected_tensors))
+      continue;
+
+    auto &equivalent = ops[first->second].spec;
+    for (int o = 0; o < spec.NumOutput(); o++)
+      renamed[spec.Output(o)] = equivalent.OutputName(o);
+    removed[i] = true;
+    eliminated++;
+  }
+
+  if (eliminated > 0)
+    ops = RemoveMarked(ops, removed);
+  return eliminated;
+}
+
+int PruneUnusedOperators(std::vector<OpDefinition> &ops,
+                         const std::set<std::string> &protected_tensors) {
+  std::unordered_map<std::string, int> num_consumers;
+  for (auto &op : ops) {
+    for (int in = 0; in < op.spec.NumInput(); in++)
+      num_consumers[op.spec.Input(in)]++;
+  }
+
+  std::vector<bool> removed(ops.size(), false);
+  int pruned = 0;
+  // the ops are in topological order - the consumers are visited before their producers
+  for (int i = static_cast<int>(ops.size()) - 1; i >= 0; i--) {
+    auto &spec = ops[i].spec;
+    auto *schema = TryGetSchema(spec);
+    if (!schema || schema->IsNoPrune() || IsPreserved(spec) ||
+        ProducesAny(spec, protected_tensors))
+      continue;
+    bool used = false;
+    for (int o = 0; o < spec.NumOutput() && !used; o++)
+      used = num_consumers[spec.Output(o)] > 0;
+    if (used)
+      continue;
+
+    for (int in = 0; in < spec.NumInput(); in++)
+      num_consumers[spec.Input(in)]--;
+    removed[i] = true;
+    pruned++;
+  }
+
+  if (pruned > 0)
+    ops = RemoveMarked(ops, removed);
+  return pruned;
+}
+
+}  // namespace dali
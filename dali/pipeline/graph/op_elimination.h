@@ -0,0 +1,59 @@
+// Copyright (c) 2021, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_GRAPH_OP_ELIMINATION_H_
+#define DALI_PIPELINE_GRAPH_OP_ELIMINATION_H_
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "dali/core/common.h"
+#include "dali/pipeline/graph/op_fusion.h"
+
+namespace dali {
+
+/**
+ * @brief Merges operators that compute the same result
+ *
+ * Two operators are merged if their schema is marked as `Deterministic`, they have the same
+ * arguments and they consume the same inputs. The later one is removed and its consumers
+ * are redirected to the outputs of the first one. The `seed` argument is ignored, since
+ * it doesn't affect the result of a deterministic operator. Operators with `preserve` set
+ * or producing any of the `protected_tensors` are never removed.
+ *
+ * @param ops                 operators in topological order; modified in place
+ * @param protected_tensors   names (without device suffix) of tensors that must be preserved
+ * @return number of operators removed from `ops`
+ */
+DLL_PUBLIC int EliminateCommonSubexpressions(std::vector<OpDefinition> &ops,
+                                             const std::set<std::string> &protected_tensors);
+
+/**
+ * @brief Removes the operators whose outputs are not used
+ *
+ * Works like Executor::PruneUnusedGraphNodes, but before the operators are instantiated,
+ * so no resources are allocated for the operators that would be pruned anyway.
+ * Operators with `preserve` set or with a `NoPrune` schema are kept.
+ *
+ * @param ops                 operators in topological order; modified in place
+ * @param protected_tensors   names (without device suffix) of tensors that must be preserved
+ * @return number of operators removed from `ops`
+ */
+DLL_PUBLIC int PruneUnusedOperators(std::vector<OpDefinition> &ops,
+                                    const std::set<std::string> &protected_tensors);
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_GRAPH_OP_ELIMINATION_H_
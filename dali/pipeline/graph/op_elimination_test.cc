@@ -0,0 +1,99 @@
+// Copyright (c) 2021, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "dali/pipeline/graph/op_elimination.h"
+
+namespace dali {
+
+namespace {
+
+OpDefinition CPUOp(OpSpec spec, const std::string &input, const std::string &output) {
+  spec.AddArg("device", "cpu");
+  if (!input.empty())
+    spec.AddInput(input, "cpu");
+  spec.AddOutput(output, "cpu");
+  return {"__" + spec.name() + "_" + output, spec, 0};
+}
+
+OpDefinition ExternalSource() {
+  return CPUOp(OpSpec("ExternalSource"), "", "data");
+}
+
+}  // namespace
+
+TEST(OpEliminationTest, MergeDuplicates) {
+  std::vector<OpDefinition> ops;
+  ops.push_back(ExternalSource());
+  ops.push_back(CPUOp(OpSpec("PeekImageShape"), "data", "shape1"));
+  ops.push_back(CPUOp(OpSpec("PeekImageShape"), "data", "shape2"));
+  ops.push_back(CPUOp(OpSpec("Cast").AddArg("dtype", DALI_FLOAT), "shape1", "out1"));
+  ops.push_back(CPUOp(OpSpec("Cast").AddArg("dtype", DALI_FLOAT), "shape2", "out2"));
+  ops.push_back(CPUOp(OpSpec("Cast").AddArg("dtype", DALI_INT32), "shape2", "out3"));
+
+  // the second PeekImageShape is removed; then, the second Cast has the same input as the first
+  EXPECT_EQ(EliminateCommonSubexpressions(ops, {"out1", "out3"}), 2);
+  ASSERT_EQ(ops.size(), 4u);
+  EXPECT_EQ(ops[1].spec.OutputName(0), "shape1");
+  EXPECT_EQ(ops[2].spec.OutputName(0), "out1");
+  EXPECT_EQ(ops[3].spec.OutputName(0), "out3");
+  EXPECT_EQ(ops[3].spec.InputName(0), "shape1");
+}
+
+TEST(OpEliminationTest, SeedIsIgnored) {
+  std::vector<OpDefinition> ops;
+  ops.push_back(ExternalSource());
+  ops.push_back(CPUOp(OpSpec("Shapes").AddArg("seed", 1), "data", "shape1"));
+  ops.push_back(CPUOp(OpSpec("Shapes").AddArg("seed", 2), "data", "shape2"));
+  ops.push_back(CPUOp(OpSpec("Cat"), "shape2", "out"));
+
+  EXPECT_EQ(EliminateCommonSubexpressions(ops, {"out"}), 1);
+  ASSERT_EQ(ops.size(), 3u);
+  EXPECT_EQ(ops[2].spec.InputName(0), "shape1");
+}
+
+TEST(OpEliminationTest, NoMergeOfDifferentOrNondeterministicOps) {
+  std::vector<OpDefinition> ops;
+  ops.push_back(ExternalSource());
+  ops.push_back(CPUOp(OpSpec("CoinFlip"), "", "coin1"));
+  ops.push_back(CPUOp(OpSpec("CoinFlip"), "", "coin2"));
+  ops.push_back(CPUOp(OpSpec("Cast").AddArg("dtype", DALI_FLOAT), "data", "f1"));
+  ops.push_back(CPUOp(OpSpec("Cast").AddArg("dtype", DALI_FLOAT16), "data", "f2"));
+  ops.push_back(CPUOp(OpSpec("Cast").AddArg("dtype", DALI_FLOAT), "data", "out"));
+
+  // CoinFlip is random, Casts differ in type and the last one produces a pipeline output
+  EXPECT_EQ(EliminateCommonSubexpressions(ops, {"coin1", "coin2", "f1", "f2", "out"}), 0);
+  EXPECT_EQ(ops.size(), 6u);
+}
+
+TEST(OpEliminationTest, PruneUnused) {
+  std::vector<OpDefinition> ops;
+  ops.push_back(ExternalSource());
+  ops.push_back(CPUOp(OpSpec("Shapes"), "data", "shape"));
+  ops.push_back(CPUOp(OpSpec("Cast").AddArg("dtype", DALI_FLOAT), "shape", "unused"));
+  ops.push_back(CPUOp(OpSpec("Cast").AddArg("dtype", DALI_FLOAT).AddArg("preserve", true),
+                      "data", "preserved"));
+  ops.push_back(CPUOp(OpSpec("Cast").AddArg("dtype", DALI_FLOAT16), "data", "out"));
+
+  // Shapes is pruned only because the Cast consuming its output is pruned
+  EXPECT_EQ(PruneUnusedOperators(ops, {"out"}), 2);
+  ASSERT_EQ(ops.size(), 3u);
+  EXPECT_EQ(ops[0].spec.name(), "ExternalSource");
+  EXPECT_EQ(ops[1].spec.OutputName(0), "preserved");
+  EXPECT_EQ(ops[2].spec.OutputName(0), "out");
+}
+
+}  // namespace dali
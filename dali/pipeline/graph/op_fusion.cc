@@ -0,0 +1,671 @@
+// Copyright (c) 2021, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/pipeline/graph/op_fusion.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+#include "dali/core/geom/mat.h"
+#include "dali/core/permute.h"
+#include "dali/core/tensor_layout.h"
+
+namespace dali {
+
+namespace {
+
+/**
+ * @brief Arguments that are added to every operator and don't affect the computation
+ */
+bool IsCommonArg(const std::string &name) {
+  static const std::set<std::string> common_args = {
+    "device", "max_batch_size", "num_threads", "device_id", "seed", "bytes_per_sample_hint",
+    "preserve", "inplace", "default_cuda_stream_priority",
+    "cpu_prefetch_queue_depth", "gpu_prefetch_queue_depth"
+  };
+  return common_args.count(name) > 0;
+}
+
+const std::set<std::string> &CropArgs() {
+  static const std::set<std::string> crop_args = {
+    "crop", "crop_pos_x", "crop_pos_y", "crop_pos_z", "crop_w", "crop_h", "crop_d"
+  };
+  return crop_args;
+}
+
+/**
+ * @brief Checks that the spec uses only the arguments from `allowed` (or the common ones)
+ */
+bool HasOnlyArgs(const OpSpec &spec, const std::set<std::string> &allowed) {
+  for (auto &arg : spec.ListArguments()) {
+    if (!IsCommonArg(arg) && !allowed.count(arg))
+      return false;
+  }
+  return !spec.GetArgument<bool>("preserve");
+}
+
+bool HasAnyArg(const OpSpec &spec, const std::set<std::string> &args) {
+  for (auto &arg : args) {
+    if (spec.ArgumentDefined(arg))
+      return true;
+  }
+  return false;
+}
+
+bool IsGPUOp(const OpSpec &spec, const char *name) {
+  return spec.name() == name && spec.GetArgument<std::string>("device") == "gpu" &&
+         spec.NumRegularInput() == 1 && spec.NumOutput() == 1 &&
+         spec.InputDevice(0) == "gpu" && spec.OutputDevice(0) == "gpu";
+}
+
+/**
+ * @brief Editable representation of an OpSpec - OpSpec itself doesn't allow
+ *        for removal of inputs and arguments.
+ */
+struct SpecParts {
+  explicit SpecParts(const OpSpec &spec) : name(spec.name()) {
+    for (auto &arg : spec.Arguments())
+      args.insert(arg);
+    for (int i = 0; i < spec.NumInput(); i++) {
+      if (!spec.IsArgumentInput(i))
+        inputs.push_back({spec.InputName(i), spec.InputDevice(i)});
+    }
+    for (auto &arg_input : spec.ArgumentInputs())
+      arg_inputs[arg_input.first] = {spec.InputName(arg_input.second),
+                                     spec.InputDevice(arg_input.second)};
+    for (int i = 0; i < spec.NumOutput(); i++)
+      outputs.push_back({spec.OutputName(i), spec.OutputDevice(i)});
+  }
+
+  /**
+   * @brief Moves the argument `from_name` of `other` into `this` as `to_name`.
+   */
+  void TakeArg(const OpSpec &other, const std::string &from_name, const std::string &to_name) {
+    args.erase(to_name);
+    arg_inputs.erase(to_name);
+    if (other.HasTensorArgument(from_name)) {
+      int idx = other.ArgumentInputs().at(from_name);
+      arg_inputs[to_name] = {other.InputName(idx), other.InputDevice(idx)};
+    } else {
+      auto it = other.Arguments().find(from_name);
+      if (it != other.Arguments().end())
+        args[to_name] = it->second;
+    }
+  }
+
+  OpSpec Compose() const {
+    OpSpec spec(name);
+    for (auto &arg : args)
+      spec.AddInitializedArg(arg.first, arg.second);
+    for (auto &in : inputs)
+      spec.AddInput(in.name, in.device);
+    for (auto &arg_input : arg_inputs)
+      spec.AddArgumentInput(arg_input.first, arg_input.second.name, arg_input.second.device);
+    for (auto &out : outputs)
+      spec.AddOutput(out.name, out.device);
+    return spec;
+  }
+
+  std::string name;
+  std::map<std::string, std::shared_ptr<Argument>> args;
+  std::vector<OpSpec::InOutDeviceDesc> inputs;
+  std::map<std::string, OpSpec::InOutDeviceDesc> arg_inputs;
+  std::vector<OpSpec::InOutDeviceDesc> outputs;
+};
+
+class OpFusion {
+ public:
+  OpFusion(std::vector<OpDefinition> &ops, const std::set<std::string> &protected_tensors)
+  : ops_(ops), protected_(protected_tensors), removed_(ops.size(), false) {}
+
+  int Run() {
+    int fused = 0;
+    bool changed = true;
+    while (changed) {
+      changed = false;
+      Analyze();
+      for (int i = 0; i < static_cast<int>(ops_.size()); i++) {
+        if (removed_[i])
+          continue;
+        if (TryFuse(i)) {
+          fused++;
+          changed = true;
+          break;  // connectivity changed - analyze again
+        }
+      }
+    }
+
+    std::vector<OpDefinition> remaining;
+    remaining.reserve(ops_.size() - fused);
+    for (size_t i = 0; i < ops_.size(); i++) {
+      if (!removed_[i])
+        remaining.push_back(std::move(ops_[i]));
+    }
+    ops_.swap(remaining);
+    return fused;
+  }
+
+ private:
+  void Analyze() {
+    producers_.clear();
+    consumers_.clear();
+    for (int i = 0; i < static_cast<int>(ops_.size()); i++) {
+      if (removed_[i])
+        continue;
+      auto &spec = ops_[i].spec;
+      for (int o = 0; o < spec.NumOutput(); o++)
+        producers_[spec.Output(o)] = i;
+      for (int in = 0; in < spec.NumInput(); in++)
+        consumers_[spec.Input(in)].push_back(i);
+    }
+  }
+
+  bool TryFuse(int op_idx) {
+    auto &spec = ops_[op_idx].spec;
+    if (IsGPUOp(spec, "CropMirrorNormalize"))
+      return TryFuseFlip(op_idx) || TryFuseCrop(op_idx) || TryFuseNoise(op_idx) ||
+             TryFuseCast(op_idx) || TryFuseTranspose(op_idx) ||
+             TryFuseInputTranspose(op_idx);
+    if (IsGPUOp(spec, "WarpAffine"))
+      return TryFuseWarpAffine(op_idx);
+    if (IsGPUOp(spec, "Transpose"))
+      return TryFuseTransposes(op_idx) || TryRemoveIdentityTranspose(op_idx);
+    return false;
+  }
+
+  /**
+   * @brief Checks that the transpose only reorders the dimensions of the data and of the layout
+   */
+  static bool IsPlainTranspose(const OpSpec &transpose) {
+    return HasOnlyArgs(transpose, {"perm", "transpose_layout", "output_layout"}) &&
+           transpose.GetArgument<bool>("transpose_layout") &&
+           transpose.GetArgument<TensorLayout>("output_layout").empty();
+  }
+
+  static bool IsPermutation(const std::vector<int> &perm) {
+    std::vector<bool> used(perm.size(), false);
+    for (int p : perm) {
+      if (p < 0 || p >= static_cast<int>(perm.size()) || used[p])
+        return false;
+      used[p] = true;
+    }
+    return true;
+  }
+
+  /**
+   * @brief Returns the index of the op producing the only input of `op_idx`, if it can be fused
+   */
+  int FusibleProducer(int op_idx) {
+    auto &spec = ops_[op_idx].spec;
+    auto tensor = spec.Input(0);
+    if (protected_.count(spec.InputName(0)) || consumers_[tensor].size() != 1)
+      return -1;
+    auto it = producers_.find(tensor);
+    if (it == producers_.end())
+      return -1;
+    auto &producer = ops_[it->second].spec;
+    if (producer.NumOutput() != 1 || producer.NumRegularInput() != 1)
+      return -1;
+    return it->second;
+  }
+
+  /**
+   * @brief Returns the index of the only consumer of the output of `op_idx`, if it can be fused
+   */
+  int FusibleConsumer(int op_idx) {
+    auto &spec = ops_[op_idx].spec;
+    auto tensor = spec.Output(0);
+    if (protected_.count(spec.OutputName(0)))
+      return -1;
+    auto &cons = consumers_[tensor];
+    if (cons.size() != 1)
+      return -1;
+    auto &consumer = ops_[cons[0]].spec;
+    if (consumer.NumRegularInput() != 1 || consumer.Input(0) != tensor)
+      return -1;
+    return cons[0];
+  }
+
+  /**
+   * @brief Flip -> CropMirrorNormalize  =>  CropMirrorNormalize(mirror=horizontal)
+   */
+  bool TryFuseFlip(int cmn_idx) {
+    int flip_idx = FusibleProducer(cmn_idx);
+    if (flip_idx < 0)
+      return false;
+    auto &flip = ops_[flip_idx].spec;
+    auto &cmn = ops_[cmn_idx].spec;
+    if (!IsGPUOp(flip, "Flip") || !HasOnlyArgs(flip, {"horizontal", "vertical", "depthwise"}))
+      return false;
+    for (const char *arg : {"vertical", "depthwise"}) {
+      if (flip.HasTensorArgument(arg) || flip.GetArgument<int>(arg) != 0)
+        return false;
+    }
+    // mirroring must be applied to the whole image, not to the cropping window
+    if (cmn.ArgumentDefined("mirror") || HasAnyArg(cmn, CropArgs()))
+      return false;
+
+    SpecParts fused(cmn);
+    fused.inputs[0] = {flip.InputName(0), flip.InputDevice(0)};
+    if (flip.ArgumentDefined("horizontal"))
+      fused.TakeArg(flip, "horizontal", "mirror");
+    else
+      fused.args["mirror"] = Argument::Store<int64_t>("mirror", 1);  // Flip's default
+    Replace(cmn_idx, fused, flip_idx);
+    return true;
+  }
+
+  /**
+   * @brief Crop -> CropMirrorNormalize  =>  CropMirrorNormalize(crop=...)
+   */
+  bool TryFuseCrop(int cmn_idx) {
+    int crop_idx = FusibleProducer(cmn_idx);
+    if (crop_idx < 0)
+      return false;
+    auto &crop = ops_[crop_idx].spec;
+    auto &cmn = ops_[cmn_idx].spec;
+    // No padding (fill values would be normalized) and no intermediate type conversion
+    if (!IsGPUOp(crop, "Crop") || !HasOnlyArgs(crop, CropArgs()))
+      return false;
+    if (HasAnyArg(cmn, CropArgs()))
+      return false;
+
+    SpecParts fused(cmn);
+    fused.inputs[0] = {crop.InputName(0), crop.InputDevice(0)};
+    for (auto &arg : CropArgs()) {
+      if (crop.ArgumentDefined(arg))
+        fused.TakeArg(crop, arg, arg);
+    }
+    Replace(cmn_idx, fused, crop_idx);
+    return true;
+  }
+
+  /**
+   * @brief noise.Gaussian -> CropMirrorNormalize  =>  CropMirrorNormalize(noise_stddev=...)
+   *
+   * CropMirrorNormalize takes over the seed of the noise operator, so it generates exactly
+   * the same noise.
+   */
+  bool TryFuseNoise(int cmn_idx) {
+    int noise_idx = FusibleProducer(cmn_idx);
+    if (noise_idx < 0)
+      return false;
+    auto &noise = ops_[noise_idx].spec;
+    auto &cmn = ops_[cmn_idx].spec;
+    if (!IsGPUOp(noise, "noise__Gaussian") || !HasOnlyArgs(noise, {"mean", "stddev"}))
+      return false;
+    if (HasAnyArg(cmn, {"noise_mean", "noise_stddev"}))
+      return false;
+
+    SpecParts fused(cmn);
+    fused.inputs[0] = {noise.InputName(0), noise.InputDevice(0)};
+    if (noise.ArgumentDefined("mean"))
+      fused.TakeArg(noise, "mean", "noise_mean");
+    if (noise.ArgumentDefined("stddev"))
+      fused.TakeArg(noise, "stddev", "noise_stddev");
+    else
+      fused.args["noise_stddev"] = Argument::Store<float>("noise_stddev", 1.0f);  // the default
+    fused.TakeArg(noise, "seed", "seed");
+    Replace(cmn_idx, fused, noise_idx);
+    return true;
+  }
+
+  /**
+   * @brief CropMirrorNormalize(dtype=FLOAT) -> Cast  =>  CropMirrorNormalize(dtype=...)
+   *
+   * Both operators use saturating conversion, so the result is the same.
+   */
+  bool TryFuseCast(int cmn_idx) {
+    int cast_idx = FusibleConsumer(cmn_idx);
+    if (cast_idx < 0)
+      return false;
+    auto &cast = ops_[cast_idx].spec;
+    auto &cmn = ops_[cmn_idx].spec;
+    if (!IsGPUOp(cast, "Cast") || !HasOnlyArgs(cast, {"dtype"}))
+      return false;
+    if (cmn.GetArgument<DALIDataType>("dtype") != DALI_FLOAT)
+      return false;
+    auto dtype = cast.GetArgument<DALIDataType>("dtype");
+    if (dtype != DALI_FLOAT && dtype != DALI_FLOAT16 && dtype != DALI_INT8 && dtype != DALI_UINT8)
+      return false;
+
+    SpecParts fused(cmn);
+    fused.args["dtype"] = Argument::Store<int64_t>("dtype", static_cast<int64_t>(dtype));
+    fused.outputs[0] = {cast.OutputName(0), cast.OutputDevice(0)};
+    Replace(cmn_idx, fused, cast_idx);
+    return true;
+  }
+
+  /**
+   * @brief CropMirrorNormalize -> Transpose  =>  CropMirrorNormalize(output_layout=permuted)
+   */
+  bool TryFuseTranspose(int cmn_idx) {
+    int transpose_idx = FusibleConsumer(cmn_idx);
+    if (transpose_idx < 0)
+      return false;
+    auto &transpose = ops_[transpose_idx].spec;
+    auto &cmn = ops_[cmn_idx].spec;
+    if (!IsGPUOp(transpose, "Transpose") ||
+        !HasOnlyArgs(transpose, {"perm", "transpose_layout", "output_layout"}))
+      return false;
+    if (!transpose.GetArgument<bool>("transpose_layout") ||
+        !transpose.GetArgument<TensorLayout>("output_layout").empty())
+      return false;
+    // an empty output layout means "same as input" - unknown until run time
+    auto layout = cmn.GetArgument<TensorLayout>("output_layout");
+    auto perm = transpose.GetRepeatedArgument<int>("perm");
+    if (layout.empty() || static_cast<int>(perm.size()) != layout.ndim() ||
+        !IsPermutation(perm))
+      return false;
+
+    SpecParts fused(cmn);
+    fused.args["output_layout"] = Argument::Store<std::string>("output_layout",
+                                                               permute(layout, perm).str());
+    fused.outputs[0] = {transpose.OutputName(0), transpose.OutputDevice(0)};
+    Replace(cmn_idx, fused, transpose_idx);
+    return true;
+  }
+
+  /**
+   * @brief Transpose -> CropMirrorNormalize(output_layout=...)  =>  CropMirrorNormalize
+   *
+   * CropMirrorNormalize finds the dimensions by their names in the input layout (the channels
+   * for the normalization, W for the mirroring, the spatial ones for the cropping window) and
+   * permutes them to the requested output layout, so the order of the input dimensions
+   * doesn't matter and the input doesn't need to be transposed first.
+   */
+  bool TryFuseInputTranspose(int cmn_idx) {
+    int transpose_idx = FusibleProducer(cmn_idx);
+    if (transpose_idx < 0)
+      return false;
+    auto &transpose = ops_[transpose_idx].spec;
+    auto &cmn = ops_[cmn_idx].spec;
+    if (!IsGPUOp(transpose, "Transpose") || !IsPlainTranspose(transpose))
+      return false;
+    // an empty output layout means "same as input" - that is, the transposed one
+    if (cmn.GetArgument<TensorLayout>("output_layout").empty())
+      return false;
+
+    SpecParts fused(cmn);
+    fused.inputs[0] = {transpose.InputName(0), transpose.InputDevice(0)};
+    Replace(cmn_idx, fused, transpose_idx);
+    return true;
+  }
+
+  /**
+   * @brief Transpose(P1) -> Transpose(P2)  =>  Transpose(P1 o P2)
+   *
+   * The data is then permuted once; if the composed permutation is the identity, the transpose
+   * is removed altogether by TryRemoveIdentityTranspose.
+   */
+  bool TryFuseTransposes(int transpose_idx) {
+    int first_idx = FusibleProducer(transpose_idx);
+    if (first_idx < 0)
+      return false;
+    auto &first = ops_[first_idx].spec;
+    auto &second = ops_[transpose_idx].spec;
+    if (!IsGPUOp(first, "Transpose") || !IsPlainTranspose(first) ||
+        !HasOnlyArgs(second, {"perm", "transpose_layout", "output_layout"}))
+      return false;
+    auto p1 = first.GetRepeatedArgument<int>("perm");
+    auto p2 = second.GetRepeatedArgument<int>("perm");
+    if (p1.size() != p2.size() || !IsPermutation(p1) || !IsPermutation(p2))
+      return false;
+    // out[i] = mid[p2[i]] = in[p1[p2[i]]]
+    std::vector<int> composed(p2.size());
+    for (size_t i = 0; i < p2.size(); i++)
+      composed[i] = p1[p2[i]];
+
+    SpecParts fused(second);
+    fused.inputs[0] = {first.InputName(0), first.InputDevice(0)};
+    fused.args["perm"] = Argument::Store<std::vector<int>>("perm", composed);
+    Replace(transpose_idx, fused, first_idx);
+    return true;
+  }
+
+  /**
+   * @brief Removes a transpose with the identity permutation - its consumers read its input
+   */
+  bool TryRemoveIdentityTranspose(int transpose_idx) {
+    auto &transpose = ops_[transpose_idx].spec;
+    if (!IsPlainTranspose(transpose) || protected_.count(transpose.OutputName(0)))
+      return false;
+    auto perm = transpose.GetRepeatedArgument<int>("perm");
+    if (perm.empty())
+      return false;
+    for (int i = 0; i < static_cast<int>(perm.size()); i++) {
+      if (perm[i] != i)
+        return false;
+    }
+
+    auto output = transpose.OutputName(0);
+    OpSpec::InOutDeviceDesc input = {transpose.InputName(0), transpose.InputDevice(0)};
+    std::set<int> consumers(consumers_[transpose.Output(0)].begin(),
+                            consumers_[transpose.Output(0)].end());
+    for (int idx : consumers) {
+      SpecParts rewired(ops_[idx].spec);
+      for (auto &in : rewired.inputs) {
+        if (in.name == output)
+          in = input;
+      }
+      for (auto &arg_input : rewired.arg_inputs) {
+        if (arg_input.second.name == output)
+          arg_input.second = input;
+      }
+      ops_[idx].spec = rewired.Compose();
+    }
+    removed_[transpose_idx] = true;
+    return true;
+  }
+
+  /**
+   * @brief WarpAffine(M1) -> WarpAffine(M2)  =>  WarpAffine(M1 * M2)
+   *
+   * Both matrices must be known when the graph is built. The image is resampled once,
+   * so the result is not bit-exact: it's free of the interpolation error of the intermediate
+   * image and the areas cut off by the intermediate output are sampled from the input
+   * instead of being filled.
+   */
+  bool TryFuseWarpAffine(int warp_idx) {
+    int first_idx = FusibleProducer(warp_idx);
+    if (first_idx < 0)
+      return false;
+    auto &first = ops_[first_idx].spec;
+    auto &second = ops_[warp_idx].spec;
+    static const std::set<std::string> warp_args = {
+      "matrix", "inverse_map", "size", "fill_value", "interp_type", "use_texture", "dtype"
+    };
+    if (!IsGPUOp(first, "WarpAffine") || !HasOnlyArgs(first, warp_args) ||
+        !HasOnlyArgs(second, warp_args))
+      return false;
+    // the intermediate image must have the type of the input
+    if (first.ArgumentDefined("dtype") || first.ArgumentDefined("use_texture"))
+      return false;
+    for (const char *arg : {"matrix", "size"}) {
+      if (first.HasTensorArgument(arg) || second.HasTensorArgument(arg))
+        return false;
+    }
+    if (first.GetArgument<DALIInterpType>("interp_type") !=
+            second.GetArgument<DALIInterpType>("interp_type") ||
+        first.ArgumentDefined("fill_value") != second.ArgumentDefined("fill_value") ||
+        first.GetArgument<float>("fill_value") != second.GetArgument<float>("fill_value"))
+      return false;
+
+    auto m1 = first.GetRepeatedArgument<float>("matrix");
+    auto m2 = second.GetRepeatedArgument<float>("matrix");
+    std::vector<float> composed;
+    if (m1.size() != m2.size())
+      return false;
+    if (m1.size() == 6) {
+      if (!ComposeWarpMatrices<2>(first, m1, second, m2, composed))
+        return false;
+    } else if (m1.size() == 12) {
+      if (!ComposeWarpMatrices<3>(first, m1, second, m2, composed))
+        return false;
+    } else {
+      return false;
+    }
+
+    SpecParts fused(second);
+    fused.inputs[0] = {first.InputName(0), first.InputDevice(0)};
+    fused.args["matrix"] = Argument::Store<std::vector<float>>("matrix", composed);
+    fused.args["inverse_map"] = Argument::Store<bool>("inverse_map", true);
+    // without the size, the second warp produces an output of the size of its input
+    if (!second.ArgumentDefined("size") && first.ArgumentDefined("size"))
+      fused.TakeArg(first, "size", "size");
+    Replace(warp_idx, fused, first_idx);
+    return true;
+  }
+
+  /**
+   * @brief Computes the destination-to-source matrix equivalent to applying
+   *        the warp `first` and then `second`.
+   */
+  template <int ndim>
+  static bool ComposeWarpMatrices(const OpSpec &first, const std::vector<float> &m1,
+                                  const OpSpec &second, const std::vector<float> &m2,
+                                  std::vector<float> &composed) {
+    auto to_mat = [](const OpSpec &spec, const std::vector<float> &m) {
+      auto M = dmat<ndim + 1, ndim + 1>::identity();
+      for (int i = 0, k = 0; i < ndim; i++)
+        for (int j = 0; j <= ndim; j++, k++)
+          M(i, j) = m[k];
+      // a source-to-destination matrix
+      if (!spec.GetArgument<bool>("inverse_map"))
+        M = inverse(M);
+      return M;
+    };
+    try {
+      // the output of the second warp is mapped to the intermediate image and then to the input
+      auto M = to_mat(first, m1) * to_mat(second, m2);
+      composed.clear();
+      for (int i = 0; i < ndim; i++)
+        for (int j = 0; j <= ndim; j++)
+          composed.push_back(M(i, j));
+    } catch (const std::range_error &) {
+      return false;  // a singular matrix - let the operator report it
+    }
+    return true;
+  }
+
+  /**
+   * @brief Replaces the fused op with the fused spec and removes the other op
+   *
+   * The fused op stays in place: the inputs taken from a producer are
+   * defined before the producer, and the outputs taken from a consumer are used only after it,
+   * so the topological order is preserved.
+   */
+  void Replace(int op_idx, const SpecParts &fused, int removed_idx) {
+    ops_[op_idx].spec = fused.Compose();
+    removed_[removed_idx] = true;
+  }
+
+  std::vector<OpDefinition> &ops_;
+  const std::set<std::string> &protected_;
+  std::vector<bool> removed_;
+  std::unordered_map<std::string, int> producers_;
+  std::unordered_map<std::string, std::vector<int>> consumers_;
+};
+
+/**
+ * @brief Computes the minimum size of the input, for which `Resize` produces an output
+ *        of the same size - or returns false if it's not fixed
+ */
+bool ResizeMinimumInput(const OpSpec &resize, std::vector<int> &hint) {
+  static const std::set<std::string> size_args = {
+    "resize_x", "resize_y", "size", "resize_shorter", "resize_longer", "max_size",
+    "roi_start", "roi_end"
+  };
+  for (auto &arg : size_args) {
+    if (resize.HasTensorArgument(arg))
+      return false;
+  }
+  if (resize.ArgumentDefined("roi_start") || resize.ArgumentDefined("roi_end"))
+    return false;
+
+  float shorter = resize.GetArgument<float>("resize_shorter");
+  if (shorter > 0) {
+    if (resize.GetArgument<float>("resize_longer") > 0)
+      return false;
+    int size = std::ceil(shorter);
+    hint = {size, size};
+    return true;
+  }
+  if (resize.GetArgument<float>("resize_longer") > 0)
+    return false;
+
+  auto mode = resize.GetArgument<std::string>("mode");
+  if (mode != "default" && mode != "stretch")
+    return false;
+  float x = resize.GetArgument<float>("resize_x");
+  float y = resize.GetArgument<float>("resize_y");
+  if (resize.ArgumentDefined("size")) {
+    auto size = resize.GetRepeatedArgument<float>("size");
+    if (size.size() != 2)
+      return false;
+    y = size[0];
+    x = size[1];
+  }
+  if (x <= 0 && y <= 0)
+    return false;
+  hint = {static_cast<int>(std::ceil(std::max(y, 0.0f))),
+          static_cast<int>(std::ceil(std::max(x, 0.0f)))};
+  return true;
+}
+
+}  // namespace
+
+int AddDecoderDownscaleHints(std::vector<OpDefinition> &ops,
+                             const std::set<std::string> &protected_tensors) {
+  std::unordered_map<std::string, std::vector<int>> consumers;
+  for (int i = 0; i < static_cast<int>(ops.size()); i++) {
+    auto &spec = ops[i].spec;
+    for (int in = 0; in < spec.NumInput(); in++)
+      consumers[spec.Input(in)].push_back(i);
+  }
+
+  int hinted = 0;
+  for (auto &op : ops) {
+    auto &decoder = op.spec;
+    if ((decoder.name() != "decoders__Image" && decoder.name() != "ImageDecoder") ||
+        decoder.NumOutput() != 1 || decoder.ArgumentDefined("downscale_hint") ||
+        protected_tensors.count(decoder.OutputName(0)))
+      continue;
+    auto &cons = consumers[decoder.Output(0)];
+    if (cons.size() != 1)
+      continue;
+    auto &resize = ops[cons[0]].spec;
+    if (resize.name() != "Resize" || resize.NumOutput() != 1 ||
+        resize.NumRegularInput() != 1 || resize.Input(0) != decoder.Output(0))
+      continue;
+    std::vector<int> hint;
+    if (!ResizeMinimumInput(resize, hint))
+      continue;
+    decoder.AddArg("downscale_hint", hint);
+    hinted++;
+  }
+  return hinted;
+}
+
+int FuseOperators(std::vector<OpDefinition> &ops,
+                  const std::set<std::string> &protected_tensors) {
+  return OpFusion(ops, protected_tensors).Run();
+}
+
+}  // namespace dali
@@ -0,0 +1,92 @@
+// Copyright (c) 2021, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_GRAPH_OP_FUSION_H_
+#define DALI_PIPELINE_GRAPH_OP_FUSION_H_
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "dali/core/common.h"
+#include "dali/pipeline/operator/op_spec.h"
+
+namespace dali {
+
+/**
+ * @brief Definition of an operator, as added to the pipeline, before it's placed in OpGraph
+ */
+struct OpDefinition {
+  std::string instance_name;
+  OpSpec spec;
+  int logical_id;
+};
+
+/**
+ * @brief Fuses chains of GPU operators into a single CropMirrorNormalize, WarpAffine
+ *        or Transpose
+ *
+ * CropMirrorNormalize is backed by the SliceFlipNormalizePermutePad kernel, which can crop,
+ * flip, normalize, transpose and convert the data in a single pass. The pass looks for
+ * a GPU CropMirrorNormalize and folds into it:
+ *  - a producing `Flip` (horizontal only), as `mirror`,
+ *  - a producing `Crop` (without padding and type conversion), as the cropping window,
+ *  - a producing `noise.Gaussian`, as `noise_mean` and `noise_stddev`,
+ *  - a consuming `Cast`, as `dtype` (only when CropMirrorNormalize produces floats),
+ *  - a consuming `Transpose`, as a permuted `output_layout`,
+ *  - a producing `Transpose`, which is dropped - CropMirrorNormalize finds the dimensions by
+ *    their names in the input layout, so it can permute the original input directly to
+ *    the requested `output_layout`.
+ *
+ * Consecutive GPU `Transpose` operators are composed into one and the ones with the identity
+ * permutation are removed (their consumers read the input instead), so that the data changes
+ * its layout at most once between the operators which need a specific one.
+ *
+ * Similarly, two consecutive GPU `WarpAffine` operators with constant matrices, the same
+ * interpolation and fill value, are replaced with one, with a composed matrix. The image is
+ * then resampled only once, so the result differs slightly from the unfused one (mostly near
+ * the borders of the intermediate image).
+ *
+ * An edge is fused only if the intermediate tensor is consumed by exactly one operator and it's
+ * not one of the `protected_tensors` (e.g. pipeline outputs). The operators that are folded
+ * into another one are removed from `ops`, the order of the remaining ones is preserved.
+ *
+ * @param ops                 operators in topological order; modified in place
+ * @param protected_tensors   names (without device suffix) of tensors that must be preserved
+ * @return number of operators removed from `ops`
+ */
+DLL_PUBLIC int FuseOperators(std::vector<OpDefinition> &ops,
+                             const std::set<std::string> &protected_tensors);
+
+/**
+ * @brief Sets the `downscale_hint` of image decoders, whose output is only resized to a fixed size
+ *
+ * A decoder gets the hint if its output is consumed only by one `Resize`, which:
+ *  - uses `resize_shorter` - the hint is a square of that size, or
+ *  - uses `size` or `resize_x`/`resize_y` in the "default" or "stretch" mode - the hint is
+ *    the output size,
+ * and the size is not a tensor argument, no ROI is used and the decoded image is not one of
+ * the `protected_tensors`. Then the JPEG images can be decoded at a reduced resolution that's
+ * still not smaller than the output of the resize.
+ *
+ * @param ops                 operators; the specs of the hinted decoders are modified in place
+ * @param protected_tensors   names (without device suffix) of tensors that must be preserved
+ * @return number of decoders that got the hint
+ */
+DLL_PUBLIC int AddDecoderDownscaleHints(std::vector<OpDefinition> &ops,
+                                        const std::set<std::string> &protected_tensors);
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_GRAPH_OP_FUSION_H_
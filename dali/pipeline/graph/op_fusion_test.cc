@@ -0,0 +1,259 @@
+// Copyright (c) 2021, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "dali/pipeline/graph/op_fusion.h"
+
+namespace dali {
+
+namespace {
+
+OpDefinition GPUOp(OpSpec spec, const std::string &input, const std::string &output) {
+  spec.AddArg("device", "gpu");
+  if (!input.empty())
+    spec.AddInput(input, "gpu");
+  spec.AddOutput(output, "gpu");
+  return {"__" + spec.name() + "_" + output, spec, 0};
+}
+
+OpDefinition ExternalSource() {
+  return GPUOp(OpSpec("ExternalSource"), "", "data");
+}
+
+OpDefinition Decoder(const std::string &output) {
+  OpSpec spec("decoders__Image");
+  spec.AddArg("device", "mixed").AddInput("encoded", "cpu").AddOutput(output, "gpu");
+  return {"decoder_" + output, spec, 0};
+}
+
+}  // namespace
+
+TEST(OpFusionTest, FullChain) {
+  std::vector<OpDefinition> ops;
+  ops.push_back(ExternalSource());
+  ops.push_back(GPUOp(OpSpec("Crop").AddArg("crop", std::vector<float>{64, 32}),
+                      "data", "cropped"));
+  ops.push_back(GPUOp(OpSpec("Flip"), "cropped", "flipped"));
+  ops.push_back(GPUOp(OpSpec("CropMirrorNormalize")
+                        .AddArg("mean", std::vector<float>{128, 128, 128})
+                        .AddArg("output_layout", "CHW"),
+                      "flipped", "normalized"));
+  ops.push_back(GPUOp(OpSpec("Cast").AddArg("dtype", DALI_FLOAT16), "normalized", "converted"));
+  ops.push_back(GPUOp(OpSpec("Transpose").AddArg("perm", std::vector<int>{1, 2, 0}),
+                      "converted", "out"));
+
+  EXPECT_EQ(FuseOperators(ops, {"out"}), 4);
+  ASSERT_EQ(ops.size(), 2u);
+  EXPECT_EQ(ops[0].spec.name(), "ExternalSource");
+  auto &fused = ops[1].spec;
+  EXPECT_EQ(fused.name(), "CropMirrorNormalize");
+  EXPECT_EQ(fused.InputName(0), "data");
+  EXPECT_EQ(fused.OutputName(0), "out");
+  EXPECT_EQ(fused.GetRepeatedArgument<float>("crop"), (std::vector<float>{64, 32}));
+  EXPECT_EQ(fused.GetRepeatedArgument<float>("mean"), (std::vector<float>{128, 128, 128}));
+  EXPECT_EQ(fused.GetArgument<int>("mirror"), 1);
+  EXPECT_EQ(fused.GetArgument<DALIDataType>("dtype"), DALI_FLOAT16);
+  EXPECT_EQ(fused.GetArgument<TensorLayout>("output_layout"), "HWC");
+}
+
+TEST(OpFusionTest, FlipTensorArgument) {
+  std::vector<OpDefinition> ops;
+  ops.push_back(ExternalSource());
+  OpSpec coin("CoinFlip");
+  coin.AddArg("device", "cpu").AddOutput("coin", "cpu");
+  ops.push_back({"coin", coin, 1});
+  ops.push_back(GPUOp(OpSpec("Flip").AddArgumentInput("horizontal", "coin"), "data", "flipped"));
+  ops.push_back(GPUOp(OpSpec("CropMirrorNormalize"), "flipped", "out"));
+
+  EXPECT_EQ(FuseOperators(ops, {"out"}), 1);
+  ASSERT_EQ(ops.size(), 3u);
+  auto &fused = ops[2].spec;
+  EXPECT_EQ(fused.InputName(0), "data");
+  ASSERT_TRUE(fused.HasTensorArgument("mirror"));
+  EXPECT_EQ(fused.InputName(fused.ArgumentInputs().at("mirror")), "coin");
+}
+
+TEST(OpFusionTest, GaussianNoise) {
+  std::vector<OpDefinition> ops;
+  ops.push_back(ExternalSource());
+  ops.push_back(GPUOp(OpSpec("noise__Gaussian").AddArg("mean", 1.5f).AddArg("seed", 1234),
+                      "data", "noisy"));
+  ops.push_back(GPUOp(OpSpec("CropMirrorNormalize").AddArg("seed", 42), "noisy", "out"));
+
+  EXPECT_EQ(FuseOperators(ops, {"out"}), 1);
+  ASSERT_EQ(ops.size(), 2u);
+  auto &fused = ops[1].spec;
+  EXPECT_EQ(fused.name(), "CropMirrorNormalize");
+  EXPECT_EQ(fused.InputName(0), "data");
+  EXPECT_EQ(fused.GetArgument<float>("noise_mean"), 1.5f);
+  EXPECT_EQ(fused.GetArgument<float>("noise_stddev"), 1.0f);
+  EXPECT_EQ(fused.GetArgument<int64_t>("seed"), 1234);
+}
+
+TEST(OpFusionTest, NoFusionOfSharedOrProtectedTensors) {
+  std::vector<OpDefinition> ops;
+  ops.push_back(ExternalSource());
+  ops.push_back(GPUOp(OpSpec("Flip"), "data", "flipped"));
+  ops.push_back(GPUOp(OpSpec("CropMirrorNormalize"), "flipped", "normalized"));
+  ops.push_back(GPUOp(OpSpec("Cast").AddArg("dtype", DALI_UINT8), "flipped", "flipped_u8"));
+  ops.push_back(GPUOp(OpSpec("Cast").AddArg("dtype", DALI_UINT8), "normalized", "out"));
+
+  // `flipped` has two consumers and `normalized` is a pipeline output
+  EXPECT_EQ(FuseOperators(ops, {"normalized", "out", "flipped_u8"}), 0);
+  EXPECT_EQ(ops.size(), 5u);
+}
+
+TEST(OpFusionTest, NoFusionOfNonEquivalentOps) {
+  std::vector<OpDefinition> ops;
+  ops.push_back(ExternalSource());
+  ops.push_back(GPUOp(OpSpec("Flip").AddArg("vertical", 1), "data", "flipped"));
+  ops.push_back(GPUOp(OpSpec("CropMirrorNormalize").AddArg("dtype", DALI_FLOAT16),
+                      "flipped", "normalized"));
+  ops.push_back(GPUOp(OpSpec("Cast").AddArg("dtype", DALI_UINT8), "normalized", "out"));
+
+  // vertical flip is not supported by CropMirrorNormalize and casting from a half-precision
+  // result is not equivalent to producing the final type directly
+  EXPECT_EQ(FuseOperators(ops, {"out"}), 0);
+  EXPECT_EQ(ops.size(), 4u);
+}
+
+TEST(OpFusionTest, WarpAffineChain) {
+  std::vector<OpDefinition> ops;
+  ops.push_back(ExternalSource());
+  // scale by 2 (source to destination) and then shift by (10, 20) (destination to source)
+  ops.push_back(GPUOp(OpSpec("WarpAffine")
+                        .AddArg("matrix", std::vector<float>{2, 0, 0, 0, 2, 0})
+                        .AddArg("inverse_map", false)
+                        .AddArg("size", std::vector<float>{200, 300}),
+                      "data", "scaled"));
+  ops.push_back(GPUOp(OpSpec("WarpAffine")
+                        .AddArg("matrix", std::vector<float>{1, 0, 10, 0, 1, 20})
+                        .AddArg("dtype", DALI_FLOAT),
+                      "scaled", "out"));
+
+  EXPECT_EQ(FuseOperators(ops, {"out"}), 1);
+  ASSERT_EQ(ops.size(), 2u);
+  auto &fused = ops[1].spec;
+  EXPECT_EQ(fused.name(), "WarpAffine");
+  EXPECT_EQ(fused.InputName(0), "data");
+  EXPECT_EQ(fused.OutputName(0), "out");
+  EXPECT_TRUE(fused.GetArgument<bool>("inverse_map"));
+  EXPECT_EQ(fused.GetRepeatedArgument<float>("matrix"),
+            (std::vector<float>{0.5f, 0, 5, 0, 0.5f, 10}));
+  EXPECT_EQ(fused.GetRepeatedArgument<float>("size"), (std::vector<float>{200, 300}));
+  EXPECT_EQ(fused.GetArgument<DALIDataType>("dtype"), DALI_FLOAT);
+}
+
+TEST(OpFusionTest, NoFusionOfNonEquivalentWarps) {
+  std::vector<OpDefinition> ops;
+  ops.push_back(ExternalSource());
+  OpSpec matrix_src("transforms__Rotation");
+  matrix_src.AddArg("device", "cpu").AddArg("angle", 30.0f).AddOutput("mtx", "cpu");
+  ops.push_back({"rotation", matrix_src, 1});
+  ops.push_back(GPUOp(OpSpec("WarpAffine").AddArgumentInput("matrix", "mtx"), "data", "rotated"));
+  ops.push_back(GPUOp(OpSpec("WarpAffine")
+                        .AddArg("matrix", std::vector<float>{1, 0, 10, 0, 1, 20}),
+                      "rotated", "shifted"));
+  ops.push_back(GPUOp(OpSpec("WarpAffine")
+                        .AddArg("matrix", std::vector<float>{1, 0, 10, 0, 1, 20})
+                        .AddArg("interp_type", DALI_INTERP_NN),
+                      "shifted", "out"));
+
+  // the first matrix is not known when the graph is built and the last warp uses
+  // a different interpolation
+  EXPECT_EQ(FuseOperators(ops, {"out"}), 0);
+  EXPECT_EQ(ops.size(), 5u);
+}
+
+TEST(OpFusionTest, TransposeChain) {
+  std::vector<OpDefinition> ops;
+  ops.push_back(ExternalSource());
+  ops.push_back(GPUOp(OpSpec("Transpose").AddArg("perm", std::vector<int>{1, 0, 2}),
+                      "data", "swapped"));
+  ops.push_back(GPUOp(OpSpec("Transpose").AddArg("perm", std::vector<int>{2, 0, 1}),
+                      "swapped", "out"));
+
+  EXPECT_EQ(FuseOperators(ops, {"out"}), 1);
+  ASSERT_EQ(ops.size(), 2u);
+  auto &fused = ops[1].spec;
+  EXPECT_EQ(fused.name(), "Transpose");
+  EXPECT_EQ(fused.InputName(0), "data");
+  EXPECT_EQ(fused.OutputName(0), "out");
+  EXPECT_EQ(fused.GetRepeatedArgument<int>("perm"), (std::vector<int>{2, 1, 0}));
+}
+
+TEST(OpFusionTest, TransposeRoundTrip) {
+  std::vector<OpDefinition> ops;
+  ops.push_back(ExternalSource());
+  ops.push_back(GPUOp(OpSpec("Transpose").AddArg("perm", std::vector<int>{2, 0, 1}),
+                      "data", "chw"));
+  ops.push_back(GPUOp(OpSpec("Transpose").AddArg("perm", std::vector<int>{1, 2, 0}),
+                      "chw", "hwc"));
+  ops.push_back(GPUOp(OpSpec("Cast").AddArg("dtype", DALI_FLOAT), "hwc", "out"));
+
+  // the composed permutation is the identity, so no transpose is left
+  EXPECT_EQ(FuseOperators(ops, {"out"}), 2);
+  ASSERT_EQ(ops.size(), 2u);
+  EXPECT_EQ(ops[1].spec.name(), "Cast");
+  EXPECT_EQ(ops[1].spec.InputName(0), "data");
+}
+
+TEST(OpFusionTest, TransposeBeforeCropMirrorNormalize) {
+  std::vector<OpDefinition> ops;
+  ops.push_back(ExternalSource());
+  ops.push_back(GPUOp(OpSpec("Transpose").AddArg("perm", std::vector<int>{2, 0, 1}),
+                      "data", "chw"));
+  ops.push_back(GPUOp(OpSpec("CropMirrorNormalize").AddArg("output_layout", "HWC"),
+                      "chw", "out"));
+  ops.push_back(GPUOp(OpSpec("Transpose").AddArg("perm", std::vector<int>{0, 1, 2}),
+                      "out", "out_copy"));
+
+  // the identity transpose produces a pipeline output, so it must stay
+  EXPECT_EQ(FuseOperators(ops, {"out", "out_copy"}), 1);
+  ASSERT_EQ(ops.size(), 3u);
+  EXPECT_EQ(ops[1].spec.name(), "CropMirrorNormalize");
+  EXPECT_EQ(ops[1].spec.InputName(0), "data");
+  EXPECT_EQ(ops[2].spec.name(), "Transpose");
+}
+
+TEST(OpFusionTest, DecoderDownscaleHint) {
+  std::vector<OpDefinition> ops;
+  ops.push_back(Decoder("decoded"));
+  ops.push_back(GPUOp(OpSpec("Resize").AddArg("resize_x", 224.0f).AddArg("resize_y", 160.5f),
+                      "decoded", "resized"));
+  ops.push_back(Decoder("decoded_shorter"));
+  ops.push_back(GPUOp(OpSpec("Resize").AddArg("resize_shorter", 256.0f),
+                      "decoded_shorter", "resized_shorter"));
+  // the size of the output depends on the aspect ratio of the input
+  ops.push_back(Decoder("decoded_not_larger"));
+  ops.push_back(GPUOp(OpSpec("Resize").AddArg("size", std::vector<float>{224, 224})
+                                      .AddArg("mode", "not_larger"),
+                      "decoded_not_larger", "resized_not_larger"));
+  // the decoded image is used also elsewhere
+  ops.push_back(Decoder("decoded_shared"));
+  ops.push_back(GPUOp(OpSpec("Resize").AddArg("resize_shorter", 256.0f),
+                      "decoded_shared", "resized_shared"));
+  ops.push_back(GPUOp(OpSpec("Flip"), "decoded_shared", "flipped"));
+
+  EXPECT_EQ(AddDecoderDownscaleHints(ops, {"resized", "resized_shorter", "resized_not_larger",
+                                           "resized_shared", "flipped"}), 2);
+  EXPECT_EQ(ops[0].spec.GetRepeatedArgument<int>("downscale_hint"), (std::vector<int>{161, 224}));
+  EXPECT_EQ(ops[2].spec.GetRepeatedArgument<int>("downscale_hint"), (std::vector<int>{256, 256}));
+  EXPECT_FALSE(ops[4].spec.ArgumentDefined("downscale_hint"));
+  EXPECT_FALSE(ops[6].spec.ArgumentDefined("downscale_hint"));
+}
+
+}  // namespace dali
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <utility>
 #include <vector>
 
 #include "dali/pipeline/graph/op_graph_storage.h"
@@ -35,6 +37,84 @@ std::vector<tensor_data_store_queue_t> CreateBackingStorageForTensorNodes(
   return result;
 }
 
+std::vector<int> GetGPUMemoryGroups(const OpGraph &op_graph,
+                                    const std::vector<int> &gpu_op_stream,
+                                    const std::vector<TensorNodeId> &outputs) {
+  int num_tensors = op_graph.NumTensor();
+  std::vector<int> groups(num_tensors, -1);
+  std::vector<bool> is_output(num_tensors, false);
+  for (TensorNodeId id : outputs)
+    is_output[id] = true;
+  auto stream_of = [&](int gpu_op_idx) {
+    return gpu_op_stream.empty() ? 0 : gpu_op_stream[gpu_op_idx];
+  };
+
+  // the live ranges are the GPU op indices, in which order the ops are issued
+  struct LiveRange {
+    int start, end, stream;
+    TensorNodeId id;
+  };
+  std::vector<LiveRange> ranges;
+  for (TensorNodeId id = 0; id < num_tensors; id++) {
+    const auto &tensor = op_graph.Tensor(id);
+    // the outputs of the pass-through operators don't own their memory
+    const auto &producer = op_graph.Node(tensor.producer.node);
+    if (is_output[id] || tensor.producer.storage_device != StorageDevice::GPU ||
+        producer.op_type != OpType::GPU || producer.spec.GetSchema().HasPassThrough())
+      continue;
+    int start = op_graph.NodeIdx(tensor.producer.node);
+    int stream = stream_of(start);
+    int end = start;
+    bool eligible = true;
+    for (const auto &edge : tensor.consumers) {
+      const auto &consumer = op_graph.Node(edge.node);
+      if (consumer.op_type != OpType::GPU ||
+          stream_of(op_graph.NodeIdx(edge.node)) != stream ||
+          consumer.spec.GetSchema().IsPassThroughInput(edge.index)) {
+        eligible = false;
+        break;
+      }
+      end = std::max<int>(end, op_graph.NodeIdx(edge.node));
+    }
+    if (eligible)
+      ranges.push_back({start, end, stream, id});
+  }
+  std::sort(ranges.begin(), ranges.end(), [](const LiveRange &a, const LiveRange &b) {
+    return a.start < b.start || (a.start == b.start && a.id < b.id);
+  });
+
+  // group -> the stream and the end of the live range of its last tensor
+  std::vector<std::pair<int, int>> group_end;
+  std::vector<int> group_size;
+  for (const auto &range : ranges) {
+    int g = 0;
+    for (; g < static_cast<int>(group_end.size()); g++) {
+      if (group_end[g].first == range.stream && group_end[g].second < range.start)
+        break;
+    }
+    if (g == static_cast<int>(group_end.size())) {
+      group_end.emplace_back(range.stream, range.end);
+      group_size.push_back(0);
+    }
+    group_end[g].second = range.end;
+    group_size[g]++;
+    groups[range.id] = g;
+  }
+
+  // a tensor alone in its group keeps its own memory
+  std::vector<int> renumbered(group_size.size(), -1);
+  int num_groups = 0;
+  for (size_t g = 0; g < group_size.size(); g++) {
+    if (group_size[g] > 1)
+      renumbered[g] = num_groups++;
+  }
+  for (auto &g : groups) {
+    if (g >= 0)
+      g = renumbered[g];
+  }
+  return groups;
+}
+
 MixedOpEventMap CreateEventsForMixedOps(EventPool &event_pool, const OpGraph &op_graph,
                                         int mixed_queue_depth) {
   MixedOpEventMap result;
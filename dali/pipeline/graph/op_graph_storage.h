@@ -30,6 +30,23 @@ using MixedOpEventMap = std::vector<std::vector<cudaEvent_t>>;
 DLL_PUBLIC std::vector<tensor_data_store_queue_t> CreateBackingStorageForTensorNodes(
     const OpGraph& op_graph, int batch_size, const std::vector<int>& queue_sizes);
 
+/**
+ * @brief Finds the intermediate tensors of the GPU stage which can share memory.
+ *
+ * A tensor is live from its producer until its last consumer; the tensors with disjoint live
+ * ranges get the same memory group. Only the tensors produced and consumed by the GPU operators
+ * issued to one stream qualify - the stream orders the last use of a tensor before the producer
+ * of the next one. The pipeline outputs and the tensors passed through to other outputs keep
+ * their own memory.
+ *
+ * @param gpu_op_stream GPU op index -> the stream it's issued to; empty if there's one stream
+ * @param outputs the pipeline outputs, with the tensors passed through to them
+ * @return tensor id -> memory group, or -1 if the tensor keeps its own memory
+ */
+DLL_PUBLIC std::vector<int> GetGPUMemoryGroups(const OpGraph &op_graph,
+                                               const std::vector<int> &gpu_op_stream,
+                                               const std::vector<TensorNodeId> &outputs);
+
 // Mapping from MixedOp partition id to queue of corresponding events
 DLL_PUBLIC MixedOpEventMap CreateEventsForMixedOps(EventPool& event_pool, const OpGraph& op_graph,
                                                    int queue_depth);
@@ -0,0 +1,91 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "dali/pipeline/graph/op_graph_storage.h"
+#include "dali/test/dali_test.h"
+
+namespace dali {
+
+class GPUMemoryGroupsTest : public DALITest {
+ public:
+  void AddGPUOp(OpGraph &graph, const std::string &name, const std::string &input,
+                const std::string &output) {
+    OpSpec spec(name);
+    spec.AddArg("device", "gpu")
+      .AddArg("max_batch_size", 1)
+      .AddArg("num_threads", 1)
+      .AddArg("cuda_stream", 0)
+      .AddArg("pixels_per_image_hint", 0);
+    if (!input.empty())
+      spec.AddInput(input, "gpu");
+    spec.AddOutput(output, "gpu");
+    graph.AddOp(spec, "");
+  }
+
+  // data -> a -> b -> c -> out
+  void BuildChain(OpGraph &graph) {
+    AddGPUOp(graph, "ExternalSource", "", "data");
+    AddGPUOp(graph, "Copy", "data", "a");
+    AddGPUOp(graph, "Copy", "a", "b");
+    AddGPUOp(graph, "Copy", "b", "c");
+    AddGPUOp(graph, "Copy", "c", "out");
+  }
+};
+
+TEST_F(GPUMemoryGroupsTest, Chain) {
+  OpGraph graph;
+  BuildChain(graph);
+  auto groups = GetGPUMemoryGroups(graph, {}, graph.GetOutputs({"out_gpu"}, true));
+  ASSERT_EQ(groups.size(), 5u);
+
+  // each tensor is live until the next op has run, so every other one can share the memory
+  int data = groups[graph.TensorId("data_gpu")];
+  int a = groups[graph.TensorId("a_gpu")];
+  int b = groups[graph.TensorId("b_gpu")];
+  int c = groups[graph.TensorId("c_gpu")];
+  EXPECT_GE(data, 0);
+  EXPECT_GE(a, 0);
+  EXPECT_NE(data, a);
+  EXPECT_EQ(b, data);
+  EXPECT_EQ(c, a);
+  EXPECT_EQ(groups[graph.TensorId("out_gpu")], -1);
+}
+
+TEST_F(GPUMemoryGroupsTest, LongLiveRange) {
+  OpGraph graph;
+  BuildChain(graph);
+  // "data" is used again by the last op, so it can't share the memory with anything
+  AddGPUOp(graph, "Copy", "data", "out2");
+  auto groups = GetGPUMemoryGroups(graph, {}, graph.GetOutputs({"out_gpu", "out2_gpu"}, true));
+  EXPECT_EQ(groups[graph.TensorId("data_gpu")], -1);
+  EXPECT_GE(groups[graph.TensorId("a_gpu")], 0);
+  EXPECT_EQ(groups[graph.TensorId("a_gpu")], groups[graph.TensorId("c_gpu")]);
+  EXPECT_EQ(groups[graph.TensorId("out2_gpu")], -1);
+}
+
+TEST_F(GPUMemoryGroupsTest, CrossStream) {
+  OpGraph graph;
+  BuildChain(graph);
+  // "a" and "c" are consumed in another stream than they're produced in
+  std::vector<int> streams = { 0, 0, 1, 1, 0 };
+  auto groups = GetGPUMemoryGroups(graph, streams, graph.GetOutputs({"out_gpu"}, true));
+  for (int group : groups)
+    EXPECT_EQ(group, -1);
+}
+
+}  // namespace dali
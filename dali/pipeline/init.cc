@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <signal.h>
+#include <algorithm>
 #include <cstring>
 #include <cstdlib>
 #include "dali/pipeline/init.h"
@@ -61,6 +62,9 @@ void InitializeBufferPolicies() {
     const double max_factor = Buffer<GPUBackend>::kMaxGrowthFactor;
     Buffer<GPUBackend>::SetGrowthFactor(clamp(atof(factor), 1.0, max_factor));
   }
+  if (const char *reservation = std::getenv("DALI_DEVICE_BUFFER_VM_RESERVATION")) {
+    Buffer<GPUBackend>::SetVirtualReservation(std::max<int64_t>(atoll(reservation), 0));
+  }
 }
 
 void DALIInit(const OpSpec &cpu_allocator,
@@ -55,6 +55,15 @@ struct ArgShapeFromSize<1> {
   }
 };
 
+template <>
+struct ArgShapeFromSize<DynamicDimensions> {
+  TensorShape<> operator()(int64_t size) const {
+    if (size == 1)
+      return {};
+    return { size };
+  }
+};
+
 /**
  * @}
  */
@@ -67,6 +76,11 @@ struct ArgShapeFromSize<1> {
  * - Explicitly providing the expected shape of the data
  * - Inferring the shape of the data from a flat size, either by a default or with a custom callable object.
  * 
+ * The source of the argument and the value of a constant (including the schema default) are
+ * resolved once, when the object is constructed, so that acquiring the argument in each iteration
+ * does not look it up by name in the OpSpec again and the per-sample access is just indexing.
+ * It should be a member of the operator, constructed together with it.
+ *
  * @tparam T    Underlying data type.
  * @tparam ndim Number of dimensions of the argument. By default, scalar.
  *              Higher dimensions are expected for arguments that are passed as vector<T>.
@@ -82,6 +96,8 @@ class ArgValue {
     has_arg_const_ = spec.HasArgument(arg_name_);
     has_arg_input_ = spec.HasTensorArgument(arg_name_);
     assert(!(has_arg_const_ && has_arg_input_));
+    if (!has_arg_input_)
+      const_resolved_ = TryResolveConstant(spec);
   }
 
   /**
@@ -117,21 +133,14 @@ class ArgValue {
         make_string("Expected uniform shape for argument \"", arg_name_,
                     "\" but got shape ", view_.shape));
     } else {
-      if (ndim == 0) {
-        data_.resize(1);
-        if (!spec.TryGetArgument<T>(data_[0], arg_name_)) {
-          // something went bad - call GetArgument and let it throw
-          (void) spec.GetArgument<T>(arg_name_);
-        }
-      } else {
-        if (!spec.TryGetRepeatedArgument<T>(data_, arg_name_)) {
-          // something went bad - call GetRepeatedArgument and let it throw
-          (void) spec.GetRepeatedArgument<T>(arg_name_);
-        }
-        int64_t len = data_.size();
+      ResolveConstant(spec);
+      const T *data = const_data_.data();
+      if (ndim != 0) {
+        int64_t len = const_data_.size();
         int64_t expected_len = volume(expected_shape);
         if (len == 1 && expected_len > 1) {
-          data_.resize(expected_len, data_[0]);
+          data_.assign(expected_len, const_data_[0]);
+          data = data_.data();
         } else {
           DALI_ENFORCE(len == volume(expected_shape),
                        make_string("Argument \"", arg_name_, "\" expected shape ", expected_shape,
@@ -139,7 +148,7 @@ class ArgValue {
                                    " values, which can't be interpreted as the expected shape."));
         }
       }
-      view_ = constant_view(nsamples, data_.data(), expected_shape);
+      view_ = constant_view(nsamples, data, expected_shape);
     }
   }
 
@@ -159,20 +168,9 @@ class ArgValue {
                       "\" but got shape ", view_.shape));
       }
     } else {
-      if (ndim == 0) {
-        data_.resize(1);
-        if (!spec.TryGetArgument<T>(data_[0], arg_name_)) {
-          // something went bad - call GetArgument and let it throw
-          (void) spec.GetArgument<T>(arg_name_);
-        }
-      } else {
-        if (!spec.TryGetRepeatedArgument<T>(data_, arg_name_)) {
-          // something went bad - call GetRepeatedArgument and let it throw
-          (void) spec.GetRepeatedArgument<T>(arg_name_);
-        }
-      }
-      auto sh = shape_from_size(static_cast<int64_t>(data_.size()));
-      view_ = constant_view(nsamples, data_.data(), std::move(sh));
+      ResolveConstant(spec);
+      auto sh = shape_from_size(static_cast<int64_t>(const_data_.size()));
+      view_ = constant_view(nsamples, const_data_.data(), std::move(sh));
     }
   }
 
@@ -206,6 +204,37 @@ class ArgValue {
   }
 
  private:
+  /**
+   * @brief Reads the constant value of the argument (or its default) from the spec.
+   *
+   * Non-scalar arguments also accept a single value.
+   *
+   * @return false, if there's no valid constant value
+   */
+  bool TryResolveConstant(const OpSpec &spec) {
+    if (ndim == 0) {
+      const_data_.resize(1);
+      return spec.TryGetArgument<T>(const_data_[0], arg_name_);
+    }
+    if (spec.TryGetRepeatedArgument<T>(const_data_, arg_name_))
+      return true;
+    const_data_.resize(1);
+    return spec.TryGetArgument<T>(const_data_[0], arg_name_);
+  }
+
+  void ResolveConstant(const OpSpec &spec) {
+    if (const_resolved_)
+      return;
+    if (!TryResolveConstant(spec)) {
+      // something went bad - call GetArgument/GetRepeatedArgument and let it throw
+      if (ndim == 0)
+        (void) spec.GetArgument<T>(arg_name_);
+      else
+        (void) spec.GetRepeatedArgument<T>(arg_name_);
+    }
+    const_resolved_ = true;
+  }
+
   /**
    * @brief Creates a TensorListView out of a constant arguments by assigning the same
    *        data pointer to all the samples. This way, the user code can be shared regardless
@@ -217,11 +246,13 @@ class ArgValue {
   }
 
   std::string arg_name_;
-  std::vector<T> data_;
+  std::vector<T> const_data_;  // the constant value, as resolved from the spec
+  std::vector<T> data_;        // the constant value, broadcast to the expected shape
   TLV view_;
 
   bool has_arg_const_ = false;
   bool has_arg_input_ = false;
+  bool const_resolved_ = false;
 };
 
 }  // namespace dali
@@ -153,4 +153,43 @@ TEST(ArgValueTests, Constant_2D) {
   }
 }
 
+TEST(ArgValueTests, Constant_Dynamic) {
+  int nsamples = 5;
+  workspace_t<CPUBackend> ws;
+  auto spec = OpSpec("Erase").AddArg("shape", 0.5f);
+  ArgValue<float, DynamicDimensions> arg("shape", spec);
+  arg.Acquire(spec, ws, nsamples);
+  ASSERT_TRUE(arg.IsConstant());
+  ASSERT_EQ(nsamples, arg.size());
+  for (int i = 0; i < nsamples; i++) {
+    ASSERT_EQ(TensorShape<>{}, arg[i].shape);
+    ASSERT_EQ(0.5f, arg[i].data[0]);
+  }
+
+  std::vector<float> data{0.1f, 0.2f, 0.3f};
+  auto spec2 = OpSpec("Erase").AddArg("shape", data);
+  ArgValue<float, DynamicDimensions> arg2("shape", spec2);
+  arg2.Acquire(spec2, ws, nsamples);
+  for (int i = 0; i < nsamples; i++) {
+    ASSERT_EQ(TensorShape<>{3}, arg2[i].shape);
+    for (int j = 0; j < 3; j++)
+      ASSERT_EQ(data[j], arg2[i].data[j]);
+  }
+}
+
+TEST(ArgValueTests, Constant_ResolvedOnce) {
+  int nsamples = 3;
+  workspace_t<CPUBackend> ws;
+  auto spec = OpSpec("Erase").AddArg("shape", 0.25f);
+  ArgValue<float> arg("shape", spec);
+  // the value is resolved at construction - subsequent acquisitions don't read the spec
+  auto other_spec = OpSpec("Erase").AddArg("shape", 0.75f);
+  for (int iter = 0; iter < 2; iter++) {
+    arg.Acquire(other_spec, ws, nsamples);
+    ASSERT_EQ(nsamples, arg.size());
+    for (int i = 0; i < nsamples; i++)
+      ASSERT_EQ(0.25f, *arg[i].data);
+  }
+}
+
 }  // namespace dali
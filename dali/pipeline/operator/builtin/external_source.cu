@@ -24,32 +24,28 @@ template<>
 void ExternalSource<GPUBackend>::RunImpl(DeviceWorkspace &ws) {
   std::list<uptr_tl_type> tensor_list_elm;
   std::list<uptr_cuda_event_type> internal_copy_to_storage;
-  ExternalSourceState state_info;
   {
     std::unique_lock<std::mutex> busy_lock(busy_m_);
     tensor_list_elm = tl_data_.PopFront();
-    state_info = state_.front();
     state_.pop_front();
-    // even with no_copy we may have copied from TensorVector to TensorList and we
-    // need to sync with that
-    if (!state_info.no_copy || state_info.copied_shared_data) {
-      internal_copy_to_storage = copy_to_storage_events_.PopFront();
-    }
+    // the data is accompanied by an event recorded after the copy to the internal buffer or,
+    // for no_copy, in the stream of the producer
+    internal_copy_to_storage = copy_to_storage_events_.PopFront();
   }
 
   auto &output = ws.Output<GPUBackend>(0);
   cudaStream_t stream_used = ws.has_stream() ? ws.stream() : 0;
-  if (!state_info.no_copy || state_info.copied_shared_data) {
-    CUDA_CALL(cudaStreamWaitEvent(stream_used, *internal_copy_to_storage.front(), 0));
-  }
+  CUDA_CALL(cudaStreamWaitEvent(stream_used, *internal_copy_to_storage.front(), 0));
 
   std::swap(output, *tensor_list_elm.front());
-
-  if (!state_info.no_copy || state_info.copied_shared_data) {
-    RecycleBuffer(tensor_list_elm, &internal_copy_to_storage);
-  } else {
-    RecycleBuffer(tensor_list_elm);
-  }
+  // The data swapped out of the output was used only by the work already issued to
+  // `stream_used` - if it was shared, the reference is dropped now, so that the memory
+  // is released as soon as possible
+  *release_stream_ = stream_used;
+  if (tensor_list_elm.front()->shares_data())
+    tensor_list_elm.front()->Reset();
+
+  RecycleBuffer(tensor_list_elm, &internal_copy_to_storage);
 }
 
 DALI_REGISTER_OPERATOR(ExternalSource, ExternalSource<GPUBackend>, GPU);
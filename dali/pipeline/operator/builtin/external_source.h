@@ -17,6 +17,8 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <functional>
+#include <iostream>
 #include <list>
 #include <memory>
 #include <mutex>
@@ -197,6 +199,22 @@ struct ExtSrcSettingMode {
    *  override the mode of operation forcing the copy or no-copy
    */
   ExtSrcNoCopyMode no_copy_mode = ExtSrcNoCopyMode::DEFAULT;
+  /**
+   * @brief If set, the event is recorded once the provided data has been copied to the internal
+   *  buffer, in the same stream as the copy. The caller can wait for it (or make other streams
+   *  wait for it) before reusing the memory, instead of synchronizing the host.
+   *  Not supported when the data is shared without a copy, as the memory is then used until
+   *  the pipeline outputs are consumed.
+   */
+  cudaEvent_t done_event = nullptr;
+  /**
+   * @brief If set, invoked once the pipeline no longer references the data passed to a GPU
+   *  External Source without a copy, with the stream in which the work using the data was
+   *  issued. The memory can be reused after that work completes - e.g.
+   *  the callback can record an event in the stream.
+   *  Only contiguous GPU data (TensorList) is supported.
+   */
+  std::function<void(cudaStream_t)> release_callback;
 };
 
 /**
@@ -211,6 +229,7 @@ class ExternalSource : public Operator<Backend>, virtual public BatchSizeProvide
   using uptr_tl_type = std::unique_ptr<TensorList<Backend>>;
   using uptr_tv_type = std::unique_ptr<TensorVector<Backend>>;
   using uptr_cuda_event_type = std::unique_ptr<detail::CudaEventWrapper>;
+  using ReleaseCallback = std::function<void(cudaStream_t)>;
 
  public:
   inline explicit ExternalSource(const OpSpec &spec)
@@ -218,12 +237,14 @@ class ExternalSource : public Operator<Backend>, virtual public BatchSizeProvide
         blocking_(spec.GetArgument<bool>("blocking")),
         no_copy_(spec.GetArgument<bool>("no_copy")),
         device_id_(spec.GetArgument<int>("device_id")),
-        sync_worker_(device_id_, false) {
+        sync_worker_(device_id_, false, "ExternalSource sync worker") {
     output_name_ = spec.Output(0);
     sync_worker_.WaitForInit();
   }
 
   inline ~ExternalSource() {
+    // the shared data released later is no longer ordered with the pipeline stream
+    *release_stream_ = 0;
     sync_worker_.ForceStop();
     sync_worker_.Shutdown();
   }
@@ -344,7 +365,7 @@ class ExternalSource : public Operator<Backend>, virtual public BatchSizeProvide
   template<typename SrcBackend, template<typename> class SourceDataType>
   inline std::enable_if_t<!std::is_same<SrcBackend, Backend>::value>
   ShareUserData(const SourceDataType<SrcBackend> &t, cudaStream_t /*stream = 0*/,
-                bool /* use_copy_kernel */) {
+                bool /* use_copy_kernel */, const ReleaseCallback & /* release_callback */) {
     DALI_FAIL(make_string("no_copy is supported only for the same data source device type "
                           "as operator. Received: ",
                           std::is_same<SrcBackend, CPUBackend>::value? "CPU" : "GPU",
@@ -357,7 +378,8 @@ class ExternalSource : public Operator<Backend>, virtual public BatchSizeProvide
   inline std::enable_if_t<std::is_same<SrcBackend, Backend>::value &&
                           std::is_same<SrcBackend, CPUBackend>::value>
   ShareUserData(const SourceDataType<SrcBackend> &batch, cudaStream_t /*stream = 0*/,
-                bool /*use_copy_kernel = false*/) {
+                bool /*use_copy_kernel = false*/, const ReleaseCallback &release_callback) {
+    DALI_ENFORCE(!release_callback, "A release callback can be used only with GPU data.");
     std::lock_guard<std::mutex> busy_lock(busy_m_);
     state_.push_back({false, true});
     auto tv_elm = tv_data_.GetEmpty();
@@ -381,12 +403,15 @@ class ExternalSource : public Operator<Backend>, virtual public BatchSizeProvide
    * @param stream CUDA stream use to schedule the copy
    * @param use_copy_kernel If true, a copy kernel will be used to make a
    *        contiguous buffer instead of cudaMemcpyAsync.
+   * @param release_callback Not supported for TensorVector, must be empty
    */
   template <typename SrcBackend>
   inline std::enable_if_t<std::is_same<SrcBackend, Backend>::value &&
                           std::is_same<SrcBackend, GPUBackend>::value>
-  ShareUserData(const TensorVector<SrcBackend> &batch, cudaStream_t stream = 0,
-                bool use_copy_kernel = false) {
+  ShareUserData(const TensorVector<SrcBackend> &batch, cudaStream_t stream,
+                bool use_copy_kernel, const ReleaseCallback &release_callback) {
+    DALI_ENFORCE(!release_callback,
+                 "A release callback can be used only with contiguous data (a TensorList).");
     std::lock_guard<std::mutex> busy_lock(busy_m_);
     auto tl_elm = tl_data_.GetEmpty();
     bool copied_shared_data = false;
@@ -397,11 +422,6 @@ class ExternalSource : public Operator<Backend>, virtual public BatchSizeProvide
       // it is not contiguous so we need to copy
       tl_elm.front()->Copy(batch, stream, use_copy_kernel);
 
-      std::list<uptr_cuda_event_type> copy_to_storage_event;
-      copy_to_storage_event = copy_to_storage_events_.GetEmpty();
-      CUDA_CALL(cudaEventRecord(*copy_to_storage_event.front(), stream));
-      copy_to_storage_events_.PushBack(copy_to_storage_event);
-
       if (zero_copy_noncontiguous_gpu_input_) {
         DALI_WARN("ExternalSource operator should not mix contiguous and noncontiguous inputs. "
                   "In such a case the internal memory used to gather data in a contiguous chunk "
@@ -409,6 +429,7 @@ class ExternalSource : public Operator<Backend>, virtual public BatchSizeProvide
       }
       copied_shared_data = true;
     }
+    RecordReadyEvent(stream);
     state_.push_back({copied_shared_data, true});
     tl_data_.PushBack(tl_elm);
   }
@@ -416,20 +437,54 @@ class ExternalSource : public Operator<Backend>, virtual public BatchSizeProvide
   template <typename SrcBackend>
   inline std::enable_if_t<std::is_same<SrcBackend, Backend>::value &&
                           std::is_same<SrcBackend, GPUBackend>::value>
-  ShareUserData(const TensorList<SrcBackend> &batch, cudaStream_t /*stream = 0*/,
-                bool /* use_copy_kernel */) {
+  ShareUserData(const TensorList<SrcBackend> &batch, cudaStream_t stream,
+                bool /* use_copy_kernel */, const ReleaseCallback &release_callback) {
     std::lock_guard<std::mutex> busy_lock(busy_m_);
     state_.push_back({false, true});
     auto tl_elm = tl_data_.GetEmpty();
-    tl_elm.front()->ShareData(const_cast<TensorList<Backend>*>(&batch));
+    if (release_callback) {
+      // The memory is wrapped in a pointer that invokes the callback once the last reference
+      // to it - in this operator, the pipeline outputs or the buffers of the user - is dropped
+      auto release_stream = release_stream_;
+      auto owner = std::make_shared<TensorList<Backend>>();
+      owner->ShareData(const_cast<TensorList<Backend>*>(&batch));
+      std::shared_ptr<void> data(
+          unsafe_raw_mutable_data(*owner),
+          [owner, release_callback, release_stream](void *) {
+            try {
+              release_callback(release_stream->load());
+            } catch (std::exception &e) {
+              std::cerr << "External Source release callback failed: " << e.what() << std::endl;
+            }
+          });
+      tl_elm.front()->ShareData(data, batch.nbytes(), batch.shape(), batch.type());
+      tl_elm.front()->SetLayout(batch.GetLayout());
+    } else {
+      tl_elm.front()->ShareData(const_cast<TensorList<Backend>*>(&batch));
+    }
+    RecordReadyEvent(stream);
     tl_data_.PushBack(tl_elm);
     zero_copy_noncontiguous_gpu_input_ = true;
   }
 
+  /**
+   * @brief Records an event in the producer's stream, which the pipeline stream waits for
+   *        before the data is used. Must be called with busy_m_ held.
+   *
+   * This makes the no-copy GPU input stream-ordered with the work that produced it,
+   * without synchronizing the host.
+   */
+  void RecordReadyEvent(cudaStream_t stream) {
+    auto ready_event = copy_to_storage_events_.GetEmpty();
+    CUDA_CALL(cudaEventRecord(*ready_event.front(), stream));
+    copy_to_storage_events_.PushBack(ready_event);
+  }
+
   template<typename SrcBackend, template<typename> class SourceDataType, typename B = Backend>
   inline std::enable_if_t<std::is_same<B, CPUBackend>::value>
   CopyUserData(const SourceDataType<SrcBackend> &batch,
-               cudaStream_t stream, bool /* sync */, bool /* use_copy_kernel */) {
+               cudaStream_t stream, bool /* sync */, bool /* use_copy_kernel */,
+               cudaEvent_t done_event) {
     std::list<uptr_tv_type> tv_elm;
     {
       std::lock_guard<std::mutex> busy_lock(busy_m_);
@@ -445,6 +500,9 @@ class ExternalSource : public Operator<Backend>, virtual public BatchSizeProvide
     if (std::is_same<SrcBackend, GPUBackend>::value) {
       CUDA_CALL(cudaStreamSynchronize(stream));
     }
+    if (done_event) {
+      CUDA_CALL(cudaEventRecord(done_event, stream));
+    }
 
     {
       std::lock_guard<std::mutex> busy_lock(busy_m_);
@@ -456,7 +514,7 @@ class ExternalSource : public Operator<Backend>, virtual public BatchSizeProvide
   template<typename SrcBackend, template<typename> class SourceDataType, typename B = Backend>
   inline std::enable_if_t<std::is_same<B, GPUBackend>::value>
   CopyUserData(const SourceDataType<SrcBackend> &batch,
-               cudaStream_t stream, bool sync, bool use_copy_kernel) {
+               cudaStream_t stream, bool sync, bool use_copy_kernel, cudaEvent_t done_event) {
     std::list<uptr_cuda_event_type> copy_to_storage_event;
     std::list<uptr_tl_type> tl_elm;
     {
@@ -474,6 +532,10 @@ class ExternalSource : public Operator<Backend>, virtual public BatchSizeProvide
     // if copying from non pinned CPU it happens on the stream 0
     if (std::is_same<SrcBackend, CPUBackend>::value && !batch.is_pinned()) {
       CUDA_CALL(cudaEventRecord(*copy_to_storage_event.front(), 0));
+      stream = 0;
+    }
+    if (done_event) {
+      CUDA_CALL(cudaEventRecord(done_event, stream));
     }
     if (sync) {
       CUDA_CALL(cudaEventSynchronize(*copy_to_storage_event.front()));
@@ -518,10 +580,18 @@ class ExternalSource : public Operator<Backend>, virtual public BatchSizeProvide
         break;
     }
 
+    DALI_ENFORCE(actual_no_copy || !ext_src_setting_mode.release_callback,
+                 "A release callback can be used only when the data is passed without a copy. "
+                 "Use the completion event when the data is copied.");
     if (actual_no_copy) {
-      ShareUserData(batch, stream, ext_src_setting_mode.use_copy_kernel);
+      DALI_ENFORCE(ext_src_setting_mode.done_event == nullptr,
+                   "A completion event cannot be used when the data is passed without a copy - "
+                   "the memory is used until the outputs of the pipeline are consumed.");
+      ShareUserData(batch, stream, ext_src_setting_mode.use_copy_kernel,
+                    ext_src_setting_mode.release_callback);
     } else {
-      CopyUserData(batch, stream, ext_src_setting_mode.sync, ext_src_setting_mode.use_copy_kernel);
+      CopyUserData(batch, stream, ext_src_setting_mode.sync, ext_src_setting_mode.use_copy_kernel,
+                   ext_src_setting_mode.done_event);
     }
     cv_.notify_one();
   }
@@ -565,6 +635,13 @@ class ExternalSource : public Operator<Backend>, virtual public BatchSizeProvide
 
   WorkerThread sync_worker_;
 
+  /**
+   * @brief The stream of the pipeline in which the shared GPU data is used, passed to
+   *        the release callbacks; shared with them, as the data may outlive the operator.
+   */
+  std::shared_ptr<std::atomic<cudaStream_t>> release_stream_ =
+      std::make_shared<std::atomic<cudaStream_t>>(nullptr);
+
  private:
   using storage_t =
       std::conditional_t<std::is_same<Backend, GPUBackend>::value,
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <atomic>
 #include <fstream>
 #include <tuple>
 #include <utility>
@@ -598,6 +599,51 @@ void TestRunExternalSource(Pipeline &pipe, const std::string &name,
 }
 
 
+TEST(ExternalSourceTest, ReleaseCallback) {
+  constexpr int kIters = 5;
+  TensorListShape<> shape = uniform_list_shape(10, {42, 42, 3});
+  std::vector<TensorList<GPUBackend>> inputs(kIters);
+  std::atomic<int> released{0};
+  {
+    Pipeline pipe(10, 4, 0);
+    pipe.AddExternalInput("es", "gpu");
+    pipe.Build({{"es", "gpu"}});
+
+    for (auto &input : inputs) {
+      input.Resize(shape, DALI_UINT8);
+      ExtSrcSettingMode mode;
+      mode.no_copy_mode = ExtSrcNoCopyMode::FORCE_NO_COPY;
+      mode.release_callback = [&](cudaStream_t) { released++; };
+      pipe.SetExternalInputHelper("es", input, 0, mode);
+    }
+    // nothing was consumed yet
+    EXPECT_EQ(released, 0);
+
+    DeviceWorkspace ws;
+    for (int i = 0; i < kIters; i++) {
+      pipe.RunCPU();
+      pipe.RunGPU();
+      pipe.Outputs(&ws);
+    }
+    // the data of the first iterations was swapped out of the pipeline buffers
+    EXPECT_GT(released, 0);
+  }
+  EXPECT_EQ(released, kIters);
+}
+
+TEST(ExternalSourceTest, ReleaseCallbackWithCopyFail) {
+  Pipeline pipe(10, 4, 0);
+  pipe.AddExternalInput("es", "gpu");
+  pipe.Build({{"es", "gpu"}});
+  TensorList<GPUBackend> input;
+  input.Resize(uniform_list_shape(10, {42, 42, 3}), DALI_UINT8);
+  ExtSrcSettingMode mode;
+  mode.no_copy_mode = ExtSrcNoCopyMode::FORCE_COPY;
+  mode.release_callback = [](cudaStream_t) {};
+  EXPECT_THROW(pipe.SetExternalInputHelper("es", input, 0, mode), std::runtime_error);
+}
+
+
 TEST(ExternalSourceTest, SerializeDeserializeOpSpec) {
   std::string name = "es";
   for (std::string dev : {"cpu", "gpu"}) {
@@ -35,13 +35,17 @@ void MakeContiguousMixed::Run(MixedWorkspace &ws) {
   }
 
   auto &output = ws.Output<GPUBackend>(0);
-  if (coalesced) {
+  if (input.IsContiguousInMemory()) {
+    // the input is already one buffer, it's copied at once without staging
+    DomainTimeRange tr("[DALI][MakeContiguousMixed] contiguous", DomainTimeRange::kBlue);
+    output.Copy(input, ws.stream());
+  } else if (coalesced) {
     DomainTimeRange tr("[DALI][MakeContiguousMixed] coalesced", DomainTimeRange::kBlue);
     cpu_output_buff.Copy(input, 0);
     output.Copy(cpu_output_buff, ws.stream());
   } else {
     DomainTimeRange tr("[DALI][MakeContiguousMixed] non coalesced", DomainTimeRange::kGreen);
-      output.Copy(input, ws.stream());
+    output.Copy(input, ws.stream(), true);
   }
   coalesced = true;
 }
@@ -290,4 +290,15 @@ bool OpSchema::IsTensorArgument(const std::string &name) const {
   return ret;
 }
 
+bool OpSchema::AllowsGPUArgumentInput(const std::string &name) const {
+  if (gpu_argument_inputs_.count(name))
+    return true;
+  for (const auto &p : parents_) {
+    const OpSchema &parent = SchemaRegistry::GetSchema(p);
+    if (parent.AllowsGPUArgumentInput(name))
+      return true;
+  }
+  return false;
+}
+
 }  // namespace dali
@@ -75,6 +75,8 @@ class DLL_PUBLIC OpSchema {
     AddInternalArg("device", "Device on which the Op is run", std::string("cpu"));
     AddInternalArg("inplace", "Whether Op can be run in place", false);
     AddInternalArg("default_cuda_stream_priority", "Default cuda stream priority", 0);
+    AddInternalArg("set_affinity", "Whether the threads of the pipeline are pinned to the CPU "
+                   "cores (see AffinityPolicy)", false);
 
     AddOptionalArg("seed", R"code(Random seed.
 
@@ -300,6 +302,18 @@ graph even if its outputs are not used.)code", false);
     return *this;
   }
 
+  /**
+   * @brief Allows the argument input `name` to be located in GPU memory, when the operator
+   *        is placed on the GPU.
+   *
+   * The GPU implementation consumes such argument directly, without a copy to the host, so it
+   * can be used only for arguments which don't affect the shape of the outputs.
+   */
+  DLL_PUBLIC inline OpSchema& AllowGPUArgumentInput(const std::string &name) {
+    gpu_argument_inputs_.insert(name);
+    return *this;
+  }
+
   /**
    * @brief Notes that this operator is internal to DALI backend (and shouldn't be exposed in Python API)
    */
@@ -600,6 +614,31 @@ graph even if its outputs are not used.)code", false);
     return *this;
   }
 
+  /**
+   * @brief Notes that the outputs of this operator depend only on its inputs and arguments
+   * and that running it has no side effects.
+   *
+   * Instances of such an operator that have identical arguments and inputs compute the same
+   * result, so the pipeline can merge them into one (see EliminateCommonSubexpressions).
+   */
+  DLL_PUBLIC inline OpSchema& Deterministic() {
+    deterministic_ = true;
+    return *this;
+  }
+
+  /**
+   * @brief Notes that this operator caches the results of the deterministic subgraph computing
+   *        its regular inputs, keyed by the source info of the samples of the argument input
+   *        `key_arg`.
+   *
+   * The executor skips the Mixed and GPU operators of that subgraph in the iterations for which
+   * OperatorBase::HasCachedOutputs returns true.
+   */
+  DLL_PUBLIC inline OpSchema& CachesInputs(const std::string &key_arg) {
+    cache_key_arg_ = key_arg;
+    return *this;
+  }
+
   /**
    * @brief Informs that the data passes though this operator unchanged, only
    *        the metadata is affected.
@@ -621,6 +660,18 @@ graph even if its outputs are not used.)code", false);
     return *this;
   }
 
+  /**
+   * @brief Sets a given input to be passed through to each of the outputs
+   *
+   * For the operators which may return views of different parts of one input in several
+   * outputs, e.g. the elements extracted from a sequence. The same caveats as for PassThrough
+   * apply.
+   */
+  DLL_PUBLIC inline OpSchema &PassThroughToAllOutputs(int input_idx = 0) {
+    passthrough_all_outputs_.insert(input_idx);
+    return *this;
+  }
+
   DLL_PUBLIC inline const vector<std::string>& GetParents() const {
     return parents_;
   }
@@ -776,6 +827,18 @@ graph even if its outputs are not used.)code", false);
     return no_prune_;
   }
 
+  DLL_PUBLIC inline bool IsDeterministic() const {
+    return deterministic_;
+  }
+
+  /**
+   * @brief Returns the name of the argument input with the keys of the cached inputs or an empty
+   *        string, if the operator doesn't cache its inputs; see CachesInputs
+   */
+  DLL_PUBLIC inline const std::string &CacheKeyArgument() const {
+    return cache_key_arg_;
+  }
+
   DLL_PUBLIC inline bool IsSerializable() const {
     return serializable_;
   }
@@ -792,7 +855,23 @@ graph even if its outputs are not used.)code", false);
   }
 
   DLL_PUBLIC inline bool HasPassThrough() const {
-    return !passthrough_map_.empty();
+    return !passthrough_map_.empty() || !passthrough_all_outputs_.empty();
+  }
+
+  /**
+   * @brief Returns true if the output `output_idx` may be a view of the input `input_idx`
+   */
+  DLL_PUBLIC inline bool IsPassThrough(int input_idx, int output_idx) const {
+    if (passthrough_all_outputs_.count(input_idx))
+      return true;
+    return output_idx >= 0 && GetPassThroughOutputIdx(input_idx) == output_idx;
+  }
+
+  /**
+   * @brief Returns true if any of the outputs may be a view of the input `input_idx`
+   */
+  DLL_PUBLIC inline bool IsPassThroughInput(int input_idx) const {
+    return passthrough_all_outputs_.count(input_idx) || GetPassThroughOutputIdx(input_idx) >= 0;
   }
 
   DLL_PUBLIC int CalculateOutputs(const OpSpec &spec) const;
@@ -863,6 +942,7 @@ graph even if its outputs are not used.)code", false);
    */
   DLL_PUBLIC std::vector<std::string> GetArgumentNames() const;
   DLL_PUBLIC bool IsTensorArgument(const std::string &name) const;
+  DLL_PUBLIC bool AllowsGPUArgumentInput(const std::string &name) const;
 
  private:
   inline void CheckArgument(const std::string &s) {
@@ -947,9 +1027,14 @@ graph even if its outputs are not used.)code", false);
 
   bool no_prune_ = false;
 
+  bool deterministic_ = false;
+
+  std::string cache_key_arg_;
+
   bool serializable_ = true;
 
   std::map<int, int> passthrough_map_;
+  std::set<int> passthrough_all_outputs_;
 
   bool is_deprecated_ = false;
   std::string deprecated_in_favor_of_;
@@ -965,6 +1050,7 @@ graph even if its outputs are not used.)code", false);
   std::vector<dali::InputDevice> input_devices_;
 
   std::set<std::string> tensor_arguments_;
+  std::set<std::string> gpu_argument_inputs_;
 };
 
 class SchemaRegistry {
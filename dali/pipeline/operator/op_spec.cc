@@ -48,7 +48,8 @@ OpSpec& OpSpec::AddOutput(const string &name, const string &device) {
   return *this;
 }
 
-OpSpec& OpSpec::AddArgumentInput(const string &arg_name, const string &inp_name) {
+OpSpec& OpSpec::AddArgumentInput(const string &arg_name, const string &inp_name,
+                                 const string &device) {
   DALI_ENFORCE(!this->HasArgument(arg_name), make_string(
       "Argument ", arg_name, " is already specified."));
   const OpSchema& schema = GetSchema();
@@ -56,9 +57,11 @@ OpSpec& OpSpec::AddArgumentInput(const string &arg_name, const string &inp_name)
       "Argument '", arg_name, "' is not part of the op schema '", schema.name(), "'"));
   DALI_ENFORCE(schema.IsTensorArgument(arg_name), make_string(
       "Argument `", arg_name, "` in operator `", schema.name(), "` is not a a tensor argument."));
+  DALI_ENFORCE(device == "cpu" || schema.AllowsGPUArgumentInput(arg_name), make_string(
+      "Argument `", arg_name, "` in operator `", schema.name(), "` must be located in CPU memory."));
   argument_inputs_[arg_name] = inputs_.size();
   argument_inputs_indexes_.insert(inputs_.size());
-  AddInput(inp_name, "cpu", false);
+  AddInput(inp_name, device, false);
   return *this;
 }
 
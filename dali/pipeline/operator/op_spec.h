@@ -208,8 +208,10 @@ class DLL_PUBLIC OpSpec {
    * Argument inputs are named inputs that are treated as
    * per-iteration arguments. The input may be added only if
    * corresponding argument exists in the schema.
+   * The input may be located on the GPU only if the schema allows it for this argument.
    */
-  DLL_PUBLIC OpSpec& AddArgumentInput(const string &arg_name, const string &inp_name);
+  DLL_PUBLIC OpSpec& AddArgumentInput(const string &arg_name, const string &inp_name,
+                                      const string &device = "cpu");
 
   /**
    * @brief Specifies the name and device (cpu or gpu) of an
@@ -16,6 +16,7 @@
 #define DALI_PIPELINE_OPERATOR_OPERATOR_H_
 
 #include <algorithm>
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -119,6 +120,43 @@ class DLL_PUBLIC OperatorBase {
     return false;
   }
 
+  /**
+   * @brief If true, the GPU work issued by the operator can be captured into a CUDA graph
+   *        and replayed instead of running the operator again.
+   *
+   * It requires that:
+   * - Setup and Run depend only on the shapes, types, layouts and addresses of the inputs
+   *   and outputs and on the values of the arguments (no per-iteration host state, like RNG),
+   * - apart from the inputs and outputs, the issued work uses only the kernel scratchpads
+   *   (see kernels::ScratchpadCapture),
+   * - the operator doesn't synchronize with the stream.
+   */
+  DLL_PUBLIC virtual bool CanBeCaptured() const {
+    return false;
+  }
+
+  /**
+   * @brief If true, the outputs of the operator are the same in every iteration with the same
+   *        batch size, as long as it has no inputs (regular or argument ones).
+   *
+   * The executor computes such outputs once and shares them between the buffers of all
+   * the iterations; the operator is not run again, unless the batch size changes.
+   */
+  DLL_PUBLIC virtual bool HasInvariantOutputs() const {
+    return false;
+  }
+
+  /**
+   * @brief Checks whether the operator can compute its outputs for the samples with the given
+   *        source info without its regular inputs
+   *
+   * Used with OpSchema::CachesInputs - the executor skips the operators computing these inputs
+   * when it returns true. Called from the thread running the Mixed stage, concurrently with Run.
+   */
+  DLL_PUBLIC virtual bool HasCachedOutputs(const std::vector<std::string> &source_info) const {
+    return false;
+  }
+
   /**
    * @brief Executes the operator on a batch of samples on the CPU.
    */
@@ -159,6 +197,14 @@ class DLL_PUBLIC OperatorBase {
     return {};
   }
 
+  /**
+   * @brief For reader Ops, moves the reader to another shard of the data set,
+   * reusing the metadata it has already loaded. Other Ops throw.
+   */
+  DLL_PUBLIC virtual void Reshard(int shard_id, int num_shards) {
+    DALI_FAIL(make_string("Operator \"", name(), "\" is not a reader and can't be resharded."));
+  }
+
   DLL_PUBLIC const OpSpec& GetSpec() const {
     return spec_;
   }
@@ -187,6 +233,26 @@ class DLL_PUBLIC OperatorBase {
     }
   }
 
+  /**
+   * @brief Returns the current values of the diagnostics registered with the common numeric types
+   */
+  std::map<std::string, double> GetNumericDiagnostics() const {
+    std::map<std::string, double> ret;
+    for (const auto &diag : diagnostics_) {
+      if (auto *f = any_cast<float *>(&diag.second))
+        ret[diag.first] = **f;
+      else if (auto *d = any_cast<double *>(&diag.second))
+        ret[diag.first] = **d;
+      else if (auto *i = any_cast<int *>(&diag.second))
+        ret[diag.first] = **i;
+      else if (auto *l = any_cast<int64_t *>(&diag.second))
+        ret[diag.first] = **l;
+      else if (auto *b = any_cast<bool *>(&diag.second))
+        ret[diag.first] = **b;
+    }
+    return ret;
+  }
+
   template<typename T>
   void RegisterDiagnostic(std::string name, T *val) {
     using namespace std;  // NOLINT
@@ -322,24 +388,53 @@ class Operator<CPUBackend> : public OperatorBase {
   virtual void RunImpl(HostWorkspace &ws) {
     // This is implemented, as a default, using the RunImpl that accepts SampleWorkspace,
     // allowing for fallback to old per-sample implementations.
+    runs_per_sample_ = true;
 
-    auto curr_batch_size = ws.NumInput() > 0 ? ws.GetInputBatchSize(0) : max_batch_size_;
-    for (int i = 0; i < ws.NumOutput(); i++) {
-      auto &output = ws.OutputRef<CPUBackend>(i);
-      output.SetSize(curr_batch_size);
-    }
+    int curr_batch_size = SetSampleOutputsSize(ws);
     auto &thread_pool = ws.GetThreadPool();
     for (int data_idx = 0; data_idx < curr_batch_size; ++data_idx) {
       thread_pool.AddWork([this, &ws, data_idx](int tid) {
-        SampleWorkspace sample;
-        ws.GetSample(&sample, data_idx, tid);
-        this->SetupSharedSampleParams(sample);
-        this->RunImpl(sample);
+        this->RunSample(ws, data_idx, tid);
       }, -data_idx);  // -data_idx for FIFO order
     }
     thread_pool.RunAll();
   }
 
+  /**
+   * @brief True if the operator is implemented per sample, with `RunImpl(SampleWorkspace &)`.
+   *
+   * It's known once the operator has run.
+   */
+  bool RunsPerSample() const {
+    return runs_per_sample_;
+  }
+
+  /**
+   * @brief Replaces Run for the operators which RunsPerSample, to let the caller interleave
+   *        the samples of several operators.
+   *
+   * StartSamples does the batch-level part of Run and returns the number of samples to run,
+   * then RunSample is called (from any thread of the pool) for each sample and FinishSamples
+   * completes the run. The input layouts are checked in FinishSamples, as the inputs may be
+   * produced by the interleaved operators.
+   */
+  int StartSamples(HostWorkspace &ws) {
+    SetupSharedSampleParams(ws);
+    return SetSampleOutputsSize(ws);
+  }
+
+  void RunSample(HostWorkspace &ws, int data_idx, int thread_idx) {
+    SampleWorkspace sample;
+    ws.GetSample(&sample, data_idx, thread_idx);
+    SetupSharedSampleParams(sample);
+    RunImpl(sample);
+  }
+
+  void FinishSamples(HostWorkspace &ws) {
+    CheckInputLayouts(ws, spec_);
+    EnforceUniformOutputBatchSize<CPUBackend>(ws);
+  }
+
   /**
    * @brief Shared param setup. Legacy implementation for per-sample approach
    *
@@ -355,6 +450,18 @@ class Operator<CPUBackend> : public OperatorBase {
    * should be used instead.
    */
   virtual void SetupSharedSampleParams(HostWorkspace &ws) {}
+
+ private:
+  int SetSampleOutputsSize(HostWorkspace &ws) {
+    auto curr_batch_size = ws.NumInput() > 0 ? ws.GetInputBatchSize(0) : max_batch_size_;
+    for (int i = 0; i < ws.NumOutput(); i++) {
+      auto &output = ws.OutputRef<CPUBackend>(i);
+      output.SetSize(curr_batch_size);
+    }
+    return curr_batch_size;
+  }
+
+  bool runs_per_sample_ = false;
 };
 
 template <>
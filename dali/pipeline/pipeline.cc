@@ -18,8 +18,14 @@
 #include <google/protobuf/io/coded_stream.h>
 
 #include <algorithm>
+#include <cctype>
+#include <fstream>
 #include <functional>
+#include <limits>
 #include <memory>
+#include <set>
+#include <sstream>
+#include <utility>
 
 #include "dali/pipeline/executor/async_pipelined_executor.h"
 #include "dali/pipeline/executor/async_separated_pipelined_executor.h"
@@ -63,7 +69,8 @@ namespace dali {
 
     for (int i = 0; i < def.input_size(); ++i) {
       if (def.input(i).is_argument_input()) {
-        spec->AddArgumentInput(def.input(i).arg_name(), def.input(i).name());
+        spec->AddArgumentInput(def.input(i).arg_name(), def.input(i).name(),
+                               def.input(i).device());
       }
     }
 
@@ -296,6 +303,15 @@ int Pipeline::AddOperator(const OpSpec &const_spec, const std::string& inst_name
     string error_str = "(op: '" + spec.name() + "', input: '" +
       input_name + "')";
 
+    if (spec.InputDevice(input_idx) == "gpu") {
+      DALI_ENFORCE(device == "gpu", "Only GPU operators can take argument inputs located "
+          "in GPU memory. " + error_str);
+      DALI_ENFORCE(it->second.has_gpu, "gpu argument input requested by op exists "
+          "only on CPU. " + error_str);
+      SetupGPUInput(it);
+      continue;
+    }
+
     DALI_ENFORCE(it->second.has_cpu, "cpu input requested by op exists "
         "only on GPU. " + error_str);
 
@@ -405,19 +421,51 @@ void Pipeline::Build(vector<std::pair<string, string>> output_names) {
   output_names_ = output_names;
   DALI_ENFORCE(!built_, "\"Build()\" can only be called once.");
   DALI_ENFORCE(output_names.size() > 0, "User specified zero outputs.");
+  DALI_ENFORCE(!enable_low_latency_ || (!pipelined_execution_ && !async_execution_),
+               "The low latency mode runs all the stages on the calling thread - it needs "
+               "the pipeline which is neither pipelined nor async.");
 
   executor_ =
       GetExecutor(pipelined_execution_, separated_execution_, async_execution_, max_batch_size_,
                   num_threads_, device_id_, bytes_per_sample_hint_, set_affinity_, max_num_stream_,
-                  default_cuda_stream_priority_, prefetch_queue_depth_);
+                  default_cuda_stream_priority_, prefetch_queue_depth_, share_thread_pool_);
   executor_->EnableMemoryStats(enable_memory_stats_);
+  executor_->EnableTimingStats(enable_timing_stats_);
+  executor_->EnableCudaGraphs(enable_cuda_graphs_);
+  executor_->EnableCPUDataflow(enable_cpu_dataflow_);
+  executor_->EnableCPUDepthFirst(enable_cpu_depth_first_);
+  executor_->EnableConcurrentCPUIterations(enable_concurrent_cpu_iterations_);
+  executor_->EnableMemoryReuse(enable_memory_reuse_);
+  executor_->EnableEarlyGPUSetup(enable_early_gpu_setup_);
+  executor_->EnableSharedScratch(enable_shared_scratch_);
+  executor_->EnableLowLatency(enable_low_latency_);
+  executor_->SetThreadPoolWeight(thread_pool_weight_);
+  if (adaptive_queue_depth_)
+    executor_->EnableAdaptiveQueueDepth(min_prefetch_queue_depth_);
   executor_->Init();
 
+  // Seeds are assigned before any operator is removed, so that the removal
+  // doesn't affect the seeds of the remaining operators
+  std::vector<OpDefinition> op_specs = op_specs_;
+  for (auto &op_def : op_specs) {
+    PrepareOpSpec(&op_def.spec, op_def.logical_id);
+    ApplyMemoryHints(op_def);
+  }
+
+  std::set<std::string> protected_tensors;
+  for (const auto &name_pair : output_names)
+    protected_tensors.insert(name_pair.first);
+  EliminateCommonSubexpressions(op_specs, protected_tensors);
+  if (enable_op_fusion_) {
+    FuseOperators(op_specs, protected_tensors);
+    AddDecoderDownscaleHints(op_specs, protected_tensors);
+  }
+  PruneUnusedOperators(op_specs, protected_tensors);
+
   // Creating the graph
-  for (auto& name_op_spec : op_specs_) {
+  for (auto& name_op_spec : op_specs) {
     string& inst_name = name_op_spec.instance_name;
-    OpSpec op_spec = name_op_spec.spec;
-    PrepareOpSpec(&op_spec, name_op_spec.logical_id);
+    const OpSpec &op_spec = name_op_spec.spec;
     try {
       graph_.AddOp(op_spec, inst_name);
     } catch (std::exception &e) {
@@ -538,6 +586,7 @@ void Pipeline::Outputs(DeviceWorkspace *ws) {
       "\"Build()\" must be called prior to executing the pipeline.");
     try {
       executor_->Outputs(ws);
+      ++consumed_iterations_;
     } catch (std::exception &e) {
       throw std::runtime_error("Critical error in pipeline:\n"
           + std::string(e.what())
@@ -552,6 +601,7 @@ void Pipeline::ShareOutputs(DeviceWorkspace *ws) {
       "\"Build()\" must be called prior to executing the pipeline.");
     try {
       executor_->ShareOutputs(ws);
+      ++consumed_iterations_;
     } catch (std::exception &e) {
       throw std::runtime_error("Critical error in pipeline:\n"
           + std::string(e.what())
@@ -561,11 +611,13 @@ void Pipeline::ShareOutputs(DeviceWorkspace *ws) {
     }
 }
 
-void Pipeline::ReleaseOutputs() {
+cudaEvent_t Pipeline::ShareOutputsAsync(DeviceWorkspace *ws) {
   DALI_ENFORCE(built_,
       "\"Build()\" must be called prior to executing the pipeline.");
     try {
-      executor_->ReleaseOutputs();
+      cudaEvent_t event = executor_->ShareOutputsAsync(ws);
+      ++consumed_iterations_;
+      return event;
     } catch (std::exception &e) {
       throw std::runtime_error("Critical error in pipeline:\n"
           + std::string(e.what())
@@ -575,6 +627,71 @@ void Pipeline::ReleaseOutputs() {
     }
 }
 
+void Pipeline::ReleaseOutputs(cudaEvent_t consumer_event) {
+  DALI_ENFORCE(built_,
+      "\"Build()\" must be called prior to executing the pipeline.");
+    try {
+      executor_->ReleaseOutputs(consumer_event);
+    } catch (std::exception &e) {
+      throw std::runtime_error("Critical error in pipeline:\n"
+          + std::string(e.what())
+          + "\nCurrent pipeline object is no longer valid.");
+    } catch (...) {
+      throw std::runtime_error("Unknown critical error in pipeline.");
+    }
+}
+
+cudaEvent_t Pipeline::ShareOutputsAsync(DeviceWorkspace *ws, int *output_id) {
+  DALI_ENFORCE(built_,
+      "\"Build()\" must be called prior to executing the pipeline.");
+    try {
+      cudaEvent_t event = executor_->ShareOutputsAsync(ws, output_id);
+      ++consumed_iterations_;
+      return event;
+    } catch (std::exception &e) {
+      throw std::runtime_error("Critical error in pipeline:\n"
+          + std::string(e.what())
+          + "\nCurrent pipeline object is no longer valid.");
+    } catch (...) {
+      throw std::runtime_error("Unknown critical error in pipeline.");
+    }
+}
+
+void Pipeline::ReleaseOutputs(int output_id, cudaEvent_t consumer_event) {
+  DALI_ENFORCE(built_,
+      "\"Build()\" must be called prior to executing the pipeline.");
+    try {
+      executor_->ReleaseOutputs(output_id, consumer_event);
+    } catch (std::exception &e) {
+      throw std::runtime_error("Critical error in pipeline:\n"
+          + std::string(e.what())
+          + "\nCurrent pipeline object is no longer valid.");
+    } catch (...) {
+      throw std::runtime_error("Unknown critical error in pipeline.");
+    }
+}
+
+void Pipeline::SetExternalOutputBuffers(int output_idx,
+                                        std::vector<ExternalOutputBuffer> buffers) {
+  DALI_ENFORCE(built_,
+      "\"Build()\" must be called prior to setting the external output buffers.");
+  executor_->SetExternalOutputBuffers(output_idx, std::move(buffers));
+}
+
+void Pipeline::Warmup(int iterations) {
+  DALI_ENFORCE(built_, "\"Build()\" must be called prior to warming up the pipeline.");
+  DALI_ENFORCE(iterations >= 0, make_string("The number of warmup iterations must not be "
+               "negative, got: ", iterations));
+  DeviceWorkspace ws;
+  for (int i = 0; i < iterations; i++) {
+    RunCPU();
+    RunGPU();
+    Outputs(&ws);
+  }
+  if (iterations > 0)
+    ReleaseOutputs();
+}
+
 void Pipeline::SetupCPUInput(std::map<string, EdgeMeta>::iterator it, int input_idx, OpSpec *spec) {
   if (!it->second.has_contiguous) {
     OpSpec make_contiguous_spec =
@@ -614,6 +731,7 @@ void Pipeline::PrepareOpSpec(OpSpec *spec, int logical_id) {
   spec->AddArg("max_batch_size", max_batch_size_)
     .AddArg("num_threads", num_threads_)
     .AddArg("device_id", device_id_)
+    .AddArg("set_affinity", static_cast<bool>(set_affinity_))
     .AddArgIfNotExisting("seed", logical_id_to_seed_[logical_id]);
   string dev = spec->GetArgument<string>("device");
   if (dev == "cpu" || dev == "mixed")
@@ -655,6 +773,7 @@ void SerializeToProtobuf(dali_proto::OpDef *op, const string &inst_name, const O
     // loading a serialized pipeline
     if (a.first == "max_batch_size" ||
         a.first == "num_threads" ||
+        a.first == "set_affinity" ||
         a.first == "bytes_per_sample_hint") {
       continue;
     }
@@ -666,7 +785,121 @@ void SerializeToProtobuf(dali_proto::OpDef *op, const string &inst_name, const O
   }
 }
 
+/**
+ * @brief The per-sample output sizes of the operator `inst_name` observed in `memory_stats`
+ * (at a high percentile, so that a few outliers don't inflate them), or the `bytes_per_sample_hint`
+ * set by the user, if larger. Empty if there are no statistics for the operator.
+ */
+std::vector<int> LearnedMemoryHints(const string &inst_name, const OpSpec &spec,
+                                    const ExecutorMetaMap &memory_stats) {
+  string device = spec.GetArgument<string>("device");
+  std::transform(device.begin(), device.end(), device.begin(), ::toupper);
+  auto it = memory_stats.find(device + "_" + inst_name);
+  if (it == memory_stats.end())
+    return {};
+  const auto &stats = it->second;
+  int num_outputs = spec.NumOutput();
+  std::vector<int> hints(num_outputs, 0);
+  if (spec.HasArgument("bytes_per_sample_hint"))
+    GetSingleOrRepeatedArg(spec, hints, "bytes_per_sample_hint", num_outputs);
+  for (int i = 0; i < num_outputs && i < static_cast<int>(stats.size()); i++) {
+    size_t learned = std::min<size_t>(stats[i].sample_size_hint, std::numeric_limits<int>::max());
+    hints[i] = std::max(hints[i], static_cast<int>(learned));
+  }
+  return hints;
+}
+
+/**
+ * @brief Stores the LearnedMemoryHints of the operator as its `bytes_per_sample_hint`
+ */
+void SerializeMemoryHints(dali_proto::OpDef *op, const string &inst_name, const OpSpec &spec,
+                          const ExecutorMetaMap &memory_stats) {
+  auto hints = LearnedMemoryHints(inst_name, spec, memory_stats);
+  if (hints.empty())
+    return;
+  dali_proto::Argument *arg = op->add_args();
+  DaliProtoPriv arg_wrap(arg);
+  Argument::Store("bytes_per_sample_hint", hints)->SerializeToProtobuf(&arg_wrap);
+}
+
+void Pipeline::SaveMemoryHints(const std::string &filename) {
+  DALI_ENFORCE(built_ && enable_memory_stats_,
+               "The memory hints can be obtained only from a pipeline which was built with "
+               "the executor memory statistics enabled.");
+  auto memory_stats = GetExecutorMeta();
+  std::ofstream file(filename);
+  DALI_ENFORCE(file.good(), make_string("Cannot open the memory hints file: ", filename));
+  file << "# DALI memory hints: <operator name>\t<bytes per sample of each output>\n";
+  for (const auto &op_def : op_specs_for_serialization_) {
+    auto hints = LearnedMemoryHints(op_def.instance_name, op_def.spec, memory_stats);
+    if (hints.empty())
+      continue;
+    file << op_def.instance_name << "\t";
+    for (size_t i = 0; i < hints.size(); i++)
+      file << (i ? " " : "") << hints[i];
+    file << "\n";
+  }
+  DALI_ENFORCE(file.good(), make_string("Cannot write the memory hints file: ", filename));
+}
+
+void Pipeline::LoadMemoryHints(const std::string &filename) {
+  DALI_ENFORCE(!built_, "The memory hints can be loaded only before the pipeline is built.");
+  std::ifstream file(filename);
+  DALI_ENFORCE(file.good(), make_string("Cannot open the memory hints file: ", filename));
+  std::string line;
+  int line_no = 0;
+  while (std::getline(file, line)) {
+    line_no++;
+    if (line.empty() || line[0] == '#')
+      continue;
+    auto tab = line.rfind('\t');
+    DALI_ENFORCE(tab != std::string::npos, make_string("Invalid memory hints file ", filename,
+                 ", line ", line_no, ": expected the operator name and the hints."));
+    std::vector<int> hints;
+    std::stringstream ss(line.substr(tab + 1));
+    int64_t hint;
+    while (ss >> hint) {
+      DALI_ENFORCE(hint >= 0 && hint <= std::numeric_limits<int>::max(), make_string(
+                   "Invalid memory hints file ", filename, ", line ", line_no, ": the hint ",
+                   hint, " is out of range."));
+      hints.push_back(hint);
+    }
+    DALI_ENFORCE(ss.eof(), make_string("Invalid memory hints file ", filename, ", line ",
+                 line_no, ": the hints must be non-negative integers."));
+    memory_hints_[line.substr(0, tab)] = std::move(hints);
+  }
+}
+
+void Pipeline::ApplyMemoryHints(OpDefinition &op_def) {
+  auto it = memory_hints_.find(op_def.instance_name);
+  if (it == memory_hints_.end())
+    return;
+  auto &spec = op_def.spec;
+  int num_outputs = spec.NumOutput();
+  if (num_outputs == 0)
+    return;
+  std::vector<int> hints(num_outputs, 0);
+  if (spec.HasArgument("bytes_per_sample_hint"))
+    GetSingleOrRepeatedArg(spec, hints, "bytes_per_sample_hint", num_outputs);
+  const auto &loaded = it->second;
+  for (int i = 0; i < num_outputs && i < static_cast<int>(loaded.size()); i++)
+    hints[i] = std::max(hints[i], loaded[i]);
+  spec.SetArg("bytes_per_sample_hint", hints);
+}
+
 string Pipeline::SerializeToProtobuf() const {
+  return SerializeToProtobufImpl(nullptr);
+}
+
+string Pipeline::SerializeToProtobufWithMemoryHints() {
+  DALI_ENFORCE(built_ && enable_memory_stats_,
+               "The memory hints can be obtained only from a pipeline which was built with "
+               "the executor memory statistics enabled.");
+  auto memory_stats = GetExecutorMeta();
+  return SerializeToProtobufImpl(&memory_stats);
+}
+
+string Pipeline::SerializeToProtobufImpl(const ExecutorMetaMap *memory_stats) const {
   dali_proto::PipelineDef pipe;
   pipe.set_num_threads(this->num_threads());
   pipe.set_batch_size(this->max_batch_size());
@@ -684,6 +917,8 @@ string Pipeline::SerializeToProtobuf() const {
                                                     + spec.name());
 
     dali::SerializeToProtobuf(op_def, p.instance_name, spec, p.logical_id);
+    if (memory_stats)
+      SerializeMemoryHints(op_def, p.instance_name, spec, *memory_stats);
   }
 
   // loop over outputs used to create the graph
@@ -733,6 +968,37 @@ ReaderMeta Pipeline::GetReaderMeta(std::string name) {
   return meta;
 }
 
+void Pipeline::Reshard(const std::string &name, int shard_id, int num_shards) {
+  DALI_ENFORCE(built_, "\"Build()\" must be called prior to calling \"Reshard()\".");
+  for (Index i = 0; i < graph_.NumOp(); ++i) {
+    OpNode &current = graph_.Node(i);
+    if (current.instance_name == name) {
+      current.op->Reshard(shard_id, num_shards);
+      // keep the spec of the node in line with the reader
+      current.spec.SetArg("shard_id", shard_id);
+      current.spec.SetArg("num_shards", num_shards);
+      return;
+    }
+  }
+  DALI_FAIL(make_string("Operator \"", name, "\" not found."));
+}
+
+std::map<std::string, Index> Pipeline::GetReaderCheckpoints() {
+  DALI_ENFORCE(built_,
+      "\"Build()\" must be called prior to calling \"GetReaderCheckpoints()\".");
+  std::map<std::string, Index> ret;
+  for (Index i = 0; i < graph_.NumOp(); ++i) {
+    const OpNode &current = graph_.Node(i);
+    if (!current.op->GetReaderMeta() || !current.spec.GetSchema().HasArgument("skip_samples"))
+      continue;
+    // the readers always read full batches, regardless of the current batch size
+    Index consumed = consumed_iterations_ * current.spec.GetArgument<int>("max_batch_size");
+    ret.insert(make_pair(current.instance_name,
+                         current.spec.GetArgument<Index>("skip_samples") + consumed));
+  }
+  return ret;
+}
+
 const std::string &Pipeline::output_name(int id) const {
   DALI_ENFORCE(built_, "\"Build()\" must be called prior to calling \"output_name()\".");
   DALI_ENFORCE_VALID_INDEX(id, output_names_.size());
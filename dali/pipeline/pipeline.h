@@ -15,6 +15,7 @@
 #ifndef DALI_PIPELINE_PIPELINE_H_
 #define DALI_PIPELINE_PIPELINE_H_
 
+#include <atomic>
 #include <chrono>
 #include <limits>
 #include <map>
@@ -31,6 +32,8 @@
 #include "dali/pipeline/data/tensor.h"
 #include "dali/pipeline/data/tensor_list.h"
 #include "dali/pipeline/operator/builtin/external_source.h"
+#include "dali/pipeline/graph/op_elimination.h"
+#include "dali/pipeline/graph/op_fusion.h"
 #include "dali/pipeline/graph/op_graph.h"
 
 
@@ -181,12 +184,15 @@ class DLL_PUBLIC Pipeline {
    *             to the internal buffer
    * @param no_copy_mode Select whether to use the parameter defined in the External Source or
    *                     override the mode of operation forcing the copy or no-copy
+   * @param done_event If set, recorded once the data has been copied to the internal buffer
+   *                   (see ExtSrcSettingMode::done_event)
    */
   template <typename Backend>
   DLL_PUBLIC inline void SetExternalInput(
       const string &name, const TensorList<Backend> &tl, cudaStream_t stream = 0, bool sync = false,
-      bool use_copy_kernel = false, ExtSrcNoCopyMode no_copy_mode = ExtSrcNoCopyMode::DEFAULT) {
-    SetExternalInputHelper(name, tl, stream, {sync, use_copy_kernel, no_copy_mode});
+      bool use_copy_kernel = false, ExtSrcNoCopyMode no_copy_mode = ExtSrcNoCopyMode::DEFAULT,
+      cudaEvent_t done_event = nullptr) {
+    SetExternalInputHelper(name, tl, stream, {sync, use_copy_kernel, no_copy_mode, done_event});
   }
 
 
@@ -200,13 +206,16 @@ class DLL_PUBLIC Pipeline {
    *             to the internal buffer
    * @param no_copy_mode Select whether to use the parameter defined in the External Source or
    *                     override the mode of operation forcing the copy or no-copy
+   * @param done_event If set, recorded once the data has been copied to the internal buffer
+   *                   (see ExtSrcSettingMode::done_event)
    */
   template <typename Backend>
   DLL_PUBLIC inline void SetExternalInput(
       const string &name, const TensorVector<Backend> &tv, cudaStream_t stream = 0,
       bool sync = false, bool use_copy_kernel = false,
-      ExtSrcNoCopyMode no_copy_mode = ExtSrcNoCopyMode::DEFAULT) {
-    SetExternalInputHelper(name, tv, stream, {sync, use_copy_kernel, no_copy_mode});
+      ExtSrcNoCopyMode no_copy_mode = ExtSrcNoCopyMode::DEFAULT,
+      cudaEvent_t done_event = nullptr) {
+    SetExternalInputHelper(name, tv, stream, {sync, use_copy_kernel, no_copy_mode, done_event});
   }
 
   /**
@@ -294,6 +303,185 @@ class DLL_PUBLIC Pipeline {
     }
   }
 
+  /**
+   * @brief Set if the DALI pipeline should gather executor statistics of the operator
+   * and stage execution times
+   *
+   * @param enable_timing_stats If statistics should be gathered
+   * See ExecutorTimingMeta. The collection can be switched on and off at any time.
+   */
+  DLL_PUBLIC void EnableExecutorTimingStats(bool enable_timing_stats = true) {
+    enable_timing_stats_ = enable_timing_stats;
+    if (executor_) {
+      executor_->EnableTimingStats(enable_timing_stats_);
+    }
+  }
+
+  /**
+   * @brief Set if the operators should be fused before the graph is built
+   *
+   * Must be called before Build()
+   *
+   * @param enable_op_fusion If chains of GPU operators that can be executed as one
+   *                         CropMirrorNormalize or WarpAffine should be fused and
+   *                         the image decoders followed by a fixed-size Resize should get
+   *                         a downscale hint.
+   *                         See FuseOperators and AddDecoderDownscaleHints.
+   */
+  DLL_PUBLIC void EnableOperatorFusion(bool enable_op_fusion = true) {
+    DALI_ENFORCE(!built_, "Alterations to the pipeline after "
+        "\"Build()\" has been called are not allowed - cannot enable operator fusion.");
+    enable_op_fusion_ = enable_op_fusion;
+  }
+
+  /**
+   * @brief Set if the GPU stage should be captured into CUDA graphs and replayed
+   *
+   * Must be called before Build()
+   *
+   * @param enable_cuda_graphs If the graphs should be used, when all the GPU operators
+   *                           allow it. See Executor::EnableCudaGraphs.
+   */
+  DLL_PUBLIC void EnableCudaGraphs(bool enable_cuda_graphs = true) {
+    DALI_ENFORCE(!built_, "Alterations to the pipeline after "
+        "\"Build()\" has been called are not allowed - cannot enable CUDA graphs.");
+    enable_cuda_graphs_ = enable_cuda_graphs;
+  }
+
+  /**
+   * @brief Set if the independent CPU operators should run concurrently
+   *
+   * Must be called before Build()
+   *
+   * @param enable_cpu_dataflow If the CPU operators should be started as soon as their inputs
+   *                            are ready. See Executor::EnableCPUDataflow.
+   */
+  DLL_PUBLIC void EnableCPUDataflow(bool enable_cpu_dataflow = true) {
+    DALI_ENFORCE(!built_, "Alterations to the pipeline after "
+        "\"Build()\" has been called are not allowed - cannot enable the CPU dataflow.");
+    enable_cpu_dataflow_ = enable_cpu_dataflow;
+  }
+
+  /**
+   * @brief Set if the chains of per-sample CPU operators should run sample by sample
+   *
+   * Must be called before Build()
+   *
+   * @param enable_cpu_depth_first If each sample should go through the whole chain before
+   *                               the next one. See Executor::EnableCPUDepthFirst.
+   */
+  DLL_PUBLIC void EnableCPUDepthFirst(bool enable_cpu_depth_first = true) {
+    DALI_ENFORCE(!built_, "Alterations to the pipeline after "
+        "\"Build()\" has been called are not allowed - cannot enable the depth-first mode.");
+    enable_cpu_depth_first_ = enable_cpu_depth_first;
+  }
+
+  /**
+   * @brief Set if a CPU-only pipeline should run several CPU iterations at once
+   *
+   * Must be called before Build()
+   *
+   * @param enable If an operator can start the next iteration before the whole current
+   *               one has finished. See Executor::EnableConcurrentCPUIterations.
+   */
+  DLL_PUBLIC void EnableConcurrentCPUIterations(bool enable = true) {
+    DALI_ENFORCE(!built_, "Alterations to the pipeline after \"Build()\" has been called "
+        "are not allowed - cannot enable the concurrent CPU iterations.");
+    enable_concurrent_cpu_iterations_ = enable;
+  }
+
+  /**
+   * @brief Set if the intermediate GPU buffers should share memory
+   *
+   * Must be called before Build()
+   *
+   * @param enable If the intermediate GPU buffers, which are not used at the same time,
+   *               share memory. See Executor::EnableMemoryReuse.
+   */
+  DLL_PUBLIC void EnableMemoryReuse(bool enable = true) {
+    DALI_ENFORCE(!built_, "Alterations to the pipeline after \"Build()\" has been called "
+        "are not allowed - cannot enable the memory reuse.");
+    enable_memory_reuse_ = enable;
+  }
+
+  /**
+   * @brief Set if the GPU operators should be set up at the start of the GPU stage
+   *
+   * Must be called before Build()
+   *
+   * @param enable If the GPU operators, whose output shapes are known before any of them runs,
+   *               are set up before the first one is run. See Executor::EnableEarlyGPUSetup.
+   */
+  DLL_PUBLIC void EnableEarlyGPUSetup(bool enable = true) {
+    DALI_ENFORCE(!built_, "Alterations to the pipeline after \"Build()\" has been called "
+        "are not allowed - cannot enable the early setup of the GPU operators.");
+    enable_early_gpu_setup_ = enable;
+  }
+
+  /**
+   * @brief Set if the GPU operators should share the device scratch memory of their kernels
+   *
+   * Must be called before Build()
+   *
+   * @param enable If the GPU operators issued to the same stream take the scratch memory from
+   *               one arena, released after each operator. See Executor::EnableSharedScratch.
+   */
+  DLL_PUBLIC void EnableSharedScratch(bool enable = true) {
+    DALI_ENFORCE(!built_, "Alterations to the pipeline after \"Build()\" has been called "
+        "are not allowed - cannot enable the shared scratch memory.");
+    enable_shared_scratch_ = enable;
+  }
+
+  /**
+   * @brief Set if the executor should be tuned for the latency of a single iteration
+   *
+   * Must be called before Build(). Needs the pipeline which is neither pipelined nor async,
+   * so that all the stages are run on the calling thread.
+   *
+   * @param enable If the per-sample work of a batch of 1 is run on the calling thread and
+   *               the host polls the CUDA events before it blocks on them.
+   *               See Executor::EnableLowLatency.
+   */
+  DLL_PUBLIC void EnableLowLatency(bool enable = true) {
+    DALI_ENFORCE(!built_, "Alterations to the pipeline after \"Build()\" has been called "
+        "are not allowed - cannot enable the low latency mode.");
+    enable_low_latency_ = enable;
+  }
+
+  /**
+   * @brief Set if the CPU operators should run in the worker threads shared with other pipelines
+   *
+   * The pipelines with the same number of threads, e.g. one per device in a multi-GPU job, use
+   * a single, process-wide thread pool instead of starting num_threads threads each.
+   * The work of the pipelines is interleaved in the shared threads. CPU affinity is not set
+   * for the shared threads.
+   *
+   * Must be called before Build()
+   */
+  DLL_PUBLIC void EnableSharedThreadPool(bool share_thread_pool = true) {
+    DALI_ENFORCE(!built_, "Alterations to the pipeline after "
+        "\"Build()\" has been called are not allowed - cannot share the thread pool.");
+    share_thread_pool_ = share_thread_pool;
+  }
+
+  /**
+   * @brief Set the share of the shared worker threads, which this pipeline gets when other
+   *        pipelines have work too
+   *
+   * The shared threads run the work of the pipeline, which has used the least thread time
+   * relative to its weight, so a latency-sensitive pipeline can be given a larger share than
+   * a batch job. Has effect only with EnableSharedThreadPool.
+   *
+   * Must be called before Build()
+   */
+  DLL_PUBLIC void SetThreadPoolWeight(double weight) {
+    DALI_ENFORCE(!built_, "Alterations to the pipeline after "
+        "\"Build()\" has been called are not allowed - cannot set the thread pool weight.");
+    DALI_ENFORCE(weight > 0, make_string("The thread pool weight must be positive. Got: ",
+                                         weight));
+    thread_pool_weight_ = weight;
+  }
+
   /**
    * @brief Obtains the executor statistics
    */
@@ -305,6 +493,31 @@ class DLL_PUBLIC Pipeline {
     }
   }
 
+  /**
+   * @brief Obtains the executor timing statistics
+   */
+  DLL_PUBLIC ExecutorTimingMetaMap GetExecutorTimingMeta() {
+    if (executor_) {
+      return executor_->GetExecutorTimingMeta();
+    } else {
+      return {};
+    }
+  }
+
+  /**
+   * @brief Obtains the health metrics of the pipeline: queue occupancy, waits of the stages and
+   *        of the consumer, readers' prefetching and the use of the thread pool
+   *
+   * It's always collected and can be polled at any time - see PipelineHealth.
+   */
+  DLL_PUBLIC PipelineHealth GetHealth() {
+    if (executor_) {
+      return executor_->GetHealth();
+    } else {
+      return {};
+    }
+  }
+
   /**
    * @brief Set queue sizes for Pipeline using Separated Queues
    *
@@ -323,6 +536,32 @@ class DLL_PUBLIC Pipeline {
     prefetch_queue_depth_ = QueueSizes(cpu_size, gpu_size);
   }
 
+  /**
+   * @brief Enable adaptive prefetch queue depth for asynchronous Pipeline using Separated Queues
+   *
+   * The queue sizes set with SetQueueSizes become the upper bounds. The depth of the CPU and
+   * GPU queues starts at the given minimum and grows when the consumer waits for the outputs,
+   * or shrinks when it doesn't.
+   *
+   * Must be called before Build()
+   *
+   * @param min_cpu_size
+   * @param min_gpu_size
+   */
+  DLL_PUBLIC void SetAdaptiveQueueSizes(int min_cpu_size, int min_gpu_size) {
+    DALI_ENFORCE(!built_,
+                 "Alterations to the pipeline after "
+                 "\"Build()\" has been called are not allowed - cannot set queue sizes.");
+    // With synchronous execution, the scheduled iterations would block the calling thread
+    // waiting for the buffers that are not in circulation
+    DALI_ENFORCE(separated_execution_ && async_execution_,
+                 "Adaptive prefetch queue depth is supported only with asynchronous, "
+                 "separated execution");
+    DALI_ENFORCE(min_cpu_size > 0 && min_gpu_size > 0, "Only positive queue sizes allowed");
+    min_prefetch_queue_depth_ = QueueSizes(min_cpu_size, min_gpu_size);
+    adaptive_queue_depth_ = true;
+  }
+
   /*
    * @brief Set name output_names of the pipeline. Used to update the graph without
    * running the executor.
@@ -364,19 +603,107 @@ class DLL_PUBLIC Pipeline {
    */
   DLL_PUBLIC void ShareOutputs(DeviceWorkspace *ws);
 
+  /**
+   * @brief Fills the input device workspace with the output of the pipeline,
+   * without waiting for the GPU work producing it.
+   * Blocks only until the work for the next batch has been issued.
+   * To release previously returned buffers ReleaseOutputs need to be called.
+   *
+   * @return The event which has to complete before the GPU outputs can be accessed or nullptr,
+   *         if there are no GPU outputs. The caller should wait on it in its own stream,
+   *         e.g. with cudaStreamWaitEvent.
+   */
+  DLL_PUBLIC cudaEvent_t ShareOutputsAsync(DeviceWorkspace *ws);
+
+  /**
+   * @brief Like ShareOutputsAsync(ws), but also returns the id of the outputs.
+   *
+   * The outputs stay valid until they are released with ReleaseOutputs(output_id, ...),
+   * so up to prefetch queue depth outputs can be held at the same time and released
+   * in any order.
+   */
+  DLL_PUBLIC cudaEvent_t ShareOutputsAsync(DeviceWorkspace *ws, int *output_id);
+
   /**
    * @brief Release buffers returned by the Output call
    * This method is meant for cases where buffers are coppied out
    * or consumed in any other way, so it is possible to set them free
    * before next Outputs call
+   *
+   * @param consumer_event If not null, the event recorded after the work which uses the outputs,
+   *                       which can still be running; the pipeline doesn't overwrite the buffers
+   *                       before the event completes.
+   */
+  DLL_PUBLIC void ReleaseOutputs(cudaEvent_t consumer_event = nullptr);
+
+  /**
+   * @brief Release the buffers returned by ShareOutputsAsync(ws, output_id)
+   *
+   * @param consumer_event See ReleaseOutputs(consumer_event), can be nullptr
    */
-  DLL_PUBLIC void ReleaseOutputs();
+  DLL_PUBLIC void ReleaseOutputs(int output_id, cudaEvent_t consumer_event);
+
+  /**
+   * @brief Makes the GPU output `output_idx` be written directly to the caller's buffers,
+   *        e.g. the input bindings of an inference engine, instead of DALI's memory
+   *
+   * One buffer is needed for each output buffer of the stage producing the output (the prefetch
+   * queue depth); the caller finds out which one holds the output by its data pointer. When
+   * the output doesn't fit in the buffer or its shape is not known before the operator runs,
+   * it's stored in DALI's memory and has to be copied as usual. An empty list stops using
+   * the buffers. See Executor::SetExternalOutputBuffers.
+   */
+  DLL_PUBLIC void SetExternalOutputBuffers(int output_idx,
+                                           std::vector<ExternalOutputBuffer> buffers);
+
+  /**
+   * @brief Runs the given number of iterations and discards their outputs
+   *
+   * The first iterations are much slower than the following ones - the operators create their
+   * handles and plans, load their kernels and grow their buffers. Warming the pipeline up right
+   * after Build() moves that cost out of the first real iterations, e.g. in online serving.
+   *
+   * The external sources must be fed the data for all the iterations beforehand; the data
+   * should be representative of the real one (the shapes, the image sizes), as the buffers
+   * grow to the largest sizes seen. The readers and the random operators advance as in regular
+   * iterations. Must be called when no iteration is scheduled.
+   */
+  DLL_PUBLIC void Warmup(int iterations = 1);
 
   /**
    * @brief serializes the pipe to a protobuf
    */
   DLL_PUBLIC string SerializeToProtobuf() const;
 
+  /**
+   * @brief Serializes the pipe to a protobuf, storing the largest output sizes observed so far
+   * as the `bytes_per_sample_hint` of the operators.
+   *
+   * A pipeline deserialized from it allocates its buffers up front, instead of growing them
+   * during the first iterations. The executor memory statistics have to be enabled
+   * (EnableExecutorMemoryStats) and the pipeline should have run for some iterations.
+   */
+  DLL_PUBLIC string SerializeToProtobufWithMemoryHints();
+
+  /**
+   * @brief Writes the output sizes observed so far to a text file, which later runs of
+   * the pipeline can load with LoadMemoryHints.
+   *
+   * Like SerializeToProtobufWithMemoryHints, it requires the executor memory statistics.
+   * Each line holds the name of an operator and, separated with a tab, its
+   * `bytes_per_sample_hint` for each output.
+   */
+  DLL_PUBLIC void SaveMemoryHints(const std::string &filename);
+
+  /**
+   * @brief Loads the memory hints saved with SaveMemoryHints; they're applied to
+   * the operators with the same names when the pipeline is built.
+   *
+   * The hints set by the user are kept, if they are larger. The operators not found in the file
+   * are not affected. Must be called before Build.
+   */
+  DLL_PUBLIC void LoadMemoryHints(const std::string &filename);
+
   /**
    * @brief Save graph in DOT direct graph format
    * in filename.
@@ -402,6 +729,26 @@ class DLL_PUBLIC Pipeline {
    */
   DLL_PUBLIC ReaderMeta GetReaderMeta(std::string name);
 
+  /**
+   * @brief Moves the reader with given name to another shard of the data set
+   *
+   * The reader keeps the metadata it has already loaded, e.g. the list of files, and discards
+   * the samples it has prefetched. The new shard is read from its beginning, in the order
+   * of the next epoch. Must be called when no iteration is scheduled, i.e. after the outputs
+   * of all the scheduled iterations were returned.
+   */
+  DLL_PUBLIC void Reshard(const std::string &name, int shard_id, int num_shards);
+
+  /**
+   * @brief Returns the map of (reader name, number of samples consumed) for all the readers
+   *        which support the `skip_samples` argument
+   *
+   * Only the iterations whose outputs were returned by Outputs or ShareOutputs count, the ones
+   * that are still in the prefetch queue don't. Constructing the readers with `skip_samples`
+   * set to the returned values resumes the reading where it stopped.
+   */
+  DLL_PUBLIC std::map<std::string, Index> GetReaderCheckpoints();
+
   /**
    * @brief Returns the number of threads used by the pipeline.
    */
@@ -484,6 +831,14 @@ class DLL_PUBLIC Pipeline {
 
   void PropagateMemoryHint(OpNode &node);
 
+  /// Sets the `bytes_per_sample_hint` of the operator from the memory hints loaded from a file
+  void ApplyMemoryHints(OpDefinition &op_def);
+
+  /**
+   * @brief Serializes the pipe; if `memory_stats` are provided, they're stored as the memory hints
+   */
+  string SerializeToProtobufImpl(const ExecutorMetaMap *memory_stats) const;
+
   inline void AddToOpSpecs(const std::string &inst_name, const OpSpec &spec, int logical_id);
 
   int GetNextLogicalId();
@@ -503,7 +858,21 @@ class DLL_PUBLIC Pipeline {
   int next_logical_id_ = 0;
   int next_internal_logical_id_ = -1;
   QueueSizes prefetch_queue_depth_;
+  QueueSizes min_prefetch_queue_depth_;
+  bool adaptive_queue_depth_ = false;
   bool enable_memory_stats_ = false;
+  bool enable_timing_stats_ = false;
+  bool enable_op_fusion_ = false;
+  bool enable_cuda_graphs_ = false;
+  bool enable_cpu_dataflow_ = false;
+  bool enable_cpu_depth_first_ = false;
+  bool enable_concurrent_cpu_iterations_ = false;
+  bool enable_memory_reuse_ = false;
+  bool enable_early_gpu_setup_ = false;
+  bool enable_shared_scratch_ = false;
+  bool enable_low_latency_ = false;
+  bool share_thread_pool_ = false;
+  double thread_pool_weight_ = 1;
 
   std::vector<int64_t> seed_;
   int original_seed_;
@@ -513,19 +882,18 @@ class DLL_PUBLIC Pipeline {
   std::unique_ptr<ExecutorBase> executor_;
   std::map<string, EdgeMeta> edge_names_;
 
-  struct OpDefinition {
-    std::string instance_name;
-    OpSpec spec;
-    int logical_id;
-  };
-
   vector<OpDefinition> op_specs_;
   vector<OpDefinition> op_specs_for_serialization_;
   vector<std::pair<string, string>> output_names_;
+  /// The memory hints loaded with LoadMemoryHints, by the operator name
+  std::map<string, std::vector<int>> memory_hints_;
 
   // Mapping between logical id and index in op_spces_;
   std::map<int, std::vector<size_t>> logical_ids_;
   std::map<int, int64_t> logical_id_to_seed_;
+
+  // number of iterations whose outputs were returned to the user, see GetReaderCheckpoints
+  std::atomic<int64_t> consumed_iterations_{0};
 };
 
 }  // namespace dali
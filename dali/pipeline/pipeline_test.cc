@@ -16,6 +16,9 @@
 
 #include <cuda_runtime_api.h>
 #include <gtest/gtest.h>
+#include <mutex>
+#include <utility>
+#include <vector>
 
 #include "dali/core/common.h"
 #include "dali/pipeline/data/backend.h"
@@ -743,6 +746,198 @@ DALI_SCHEMA(DummyOpNoSync)
   .NumInput(1)
   .NumOutput(1);
 
+// Adds 1 to the input, sample by sample; records the order in which the samples are processed
+class DummyPerSampleAdd : public Operator<CPUBackend> {
+ public:
+  explicit DummyPerSampleAdd(const OpSpec &spec)
+      : Operator<CPUBackend>(spec), id_(spec.GetArgument<int>("id")) {}
+
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const HostWorkspace &ws) override {
+    return false;
+  }
+
+  using Operator<CPUBackend>::RunImpl;
+
+  void RunImpl(SampleWorkspace &ws) override {
+    auto &in = ws.Input<CPUBackend>(0);
+    auto &out = ws.Output<CPUBackend>(0);
+    out.set_type(in.type());
+    out.Resize(in.shape());
+    for (int64_t i = 0; i < in.size(); i++)
+      out.mutable_data<int>()[i] = in.data<int>()[i] + 1;
+    std::lock_guard<std::mutex> lock(log_mutex);
+    log.emplace_back(id_, ws.data_idx());
+  }
+
+  static std::mutex log_mutex;
+  static std::vector<std::pair<int, int>> log;  // (id, sample index)
+
+ private:
+  int id_;
+};
+
+std::mutex DummyPerSampleAdd::log_mutex;
+std::vector<std::pair<int, int>> DummyPerSampleAdd::log;
+
+DALI_REGISTER_OPERATOR(DummyPerSampleAdd, DummyPerSampleAdd, CPU);
+
+DALI_SCHEMA(DummyPerSampleAdd)
+  .DocStr("DummyPerSampleAdd")
+  .NumInput(1)
+  .NumOutput(1)
+  .AddOptionalArg("id", "Identifies the instance in the log", 0);
+
+TEST(PipelineTest, CPUDepthFirst) {
+  int batch_size = 4;
+  Pipeline pipe(batch_size, 1, 0, -1, false, 2, false);
+  pipe.EnableCPUDepthFirst();
+  pipe.AddExternalInput("data");
+  pipe.AddOperator(OpSpec("DummyPerSampleAdd")
+          .AddArg("device", "cpu")
+          .AddArg("id", 0)
+          .AddInput("data", "cpu")
+          .AddOutput("plus1", "cpu"), "add1");
+  pipe.AddOperator(OpSpec("DummyPerSampleAdd")
+          .AddArg("device", "cpu")
+          .AddArg("id", 1)
+          .AddInput("plus1", "cpu")
+          .AddOutput("plus2", "cpu"), "add2");
+  vector<std::pair<string, string>> outputs = {{"plus2", "cpu"}};
+  pipe.Build(outputs);
+
+  TensorList<CPUBackend> data;
+  data.Resize(uniform_list_shape(batch_size, {10}), DALI_INT32);
+  for (int i = 0; i < batch_size; i++) {
+    for (int j = 0; j < 10; j++)
+      data.mutable_tensor<int>(i)[j] = i * 10 + j;
+  }
+
+  for (int iter = 0; iter < 2; iter++) {
+    DummyPerSampleAdd::log.clear();
+    pipe.SetExternalInput("data", data);
+    pipe.RunCPU();
+    pipe.RunGPU();
+    DeviceWorkspace ws;
+    pipe.Outputs(&ws);
+    auto &out = ws.Output<CPUBackend>(0);
+    for (int i = 0; i < batch_size; i++) {
+      for (int j = 0; j < 10; j++)
+        EXPECT_EQ(out.tensor<int>(i)[j], i * 10 + j + 2);
+    }
+
+    // The operators running per sample are known once they have run, so the first iteration
+    // runs them one after another; then, each sample goes through both before the next one.
+    std::vector<std::pair<int, int>> expected;
+    if (iter == 0) {
+      for (int id = 0; id < 2; id++) {
+        for (int i = 0; i < batch_size; i++)
+          expected.emplace_back(id, i);
+      }
+    } else {
+      for (int i = 0; i < batch_size; i++) {
+        for (int id = 0; id < 2; id++)
+          expected.emplace_back(id, i);
+      }
+    }
+    EXPECT_EQ(DummyPerSampleAdd::log, expected);
+  }
+}
+
+TEST(PipelineTest, ConcurrentCPUIterations) {
+  int batch_size = 4, depth = 3;
+  Pipeline pipe(batch_size, 2, CPU_ONLY_DEVICE_ID, -1, true, depth, true);
+  pipe.EnableConcurrentCPUIterations();
+  pipe.AddExternalInput("data");
+  pipe.AddOperator(OpSpec("DummyPerSampleAdd")
+          .AddArg("device", "cpu")
+          .AddInput("data", "cpu")
+          .AddOutput("plus1", "cpu"), "add1");
+  pipe.AddOperator(OpSpec("DummyPerSampleAdd")
+          .AddArg("device", "cpu")
+          .AddInput("plus1", "cpu")
+          .AddOutput("plus2", "cpu"), "add2");
+  vector<std::pair<string, string>> outputs = {{"plus2", "cpu"}};
+  pipe.Build(outputs);
+
+  int num_iters = 2 * depth;
+  for (int iter = 0; iter < num_iters; iter++) {
+    TensorList<CPUBackend> data;
+    data.Resize(uniform_list_shape(batch_size, {10}), DALI_INT32);
+    for (int i = 0; i < batch_size; i++) {
+      for (int j = 0; j < 10; j++)
+        data.mutable_tensor<int>(i)[j] = iter * 100 + i * 10 + j;
+    }
+    pipe.SetExternalInput("data", data);
+  }
+
+  // several iterations are in flight, but the outputs come in order
+  for (int iter = 0; iter < depth; iter++) {
+    pipe.RunCPU();
+    pipe.RunGPU();
+  }
+  for (int iter = 0; iter < num_iters; iter++) {
+    DeviceWorkspace ws;
+    pipe.Outputs(&ws);
+    auto &out = ws.Output<CPUBackend>(0);
+    for (int i = 0; i < batch_size; i++) {
+      for (int j = 0; j < 10; j++)
+        EXPECT_EQ(out.tensor<int>(i)[j], iter * 100 + i * 10 + j + 2);
+    }
+    if (iter + depth < num_iters) {
+      pipe.RunCPU();
+      pipe.RunGPU();
+    }
+  }
+}
+
+TEST(PipelineTest, ConcurrentCPUIterationsNeedCPUOnly) {
+  Pipeline pipe(4, 2, 0);
+  pipe.EnableConcurrentCPUIterations();
+  pipe.AddExternalInput("data");
+  vector<std::pair<string, string>> outputs = {{"data", "cpu"}};
+  EXPECT_THROW(pipe.Build(outputs), std::exception);
+}
+
+TEST(PipelineTest, EarlyGPUSetup) {
+  int batch_size = 4;
+  Pipeline pipe(batch_size, 2, 0);
+  pipe.EnableEarlyGPUSetup();
+  pipe.AddExternalInput("data");
+  pipe.AddOperator(OpSpec("Copy")
+          .AddArg("device", "gpu")
+          .AddInput("data", "gpu")
+          .AddOutput("copy1", "gpu"), "copy1");
+  pipe.AddOperator(OpSpec("Copy")
+          .AddArg("device", "gpu")
+          .AddInput("copy1", "gpu")
+          .AddOutput("copy2", "gpu"), "copy2");
+  vector<std::pair<string, string>> outputs = {{"copy2", "gpu"}};
+  pipe.Build(outputs);
+
+  for (int iter = 0; iter < 3; iter++) {
+    // the shapes change in each iteration
+    TensorList<CPUBackend> data;
+    data.Resize(uniform_list_shape(batch_size, {10 + iter}), DALI_INT32);
+    for (int i = 0; i < batch_size; i++) {
+      for (int j = 0; j < 10 + iter; j++)
+        data.mutable_tensor<int>(i)[j] = iter * 100 + i * 10 + j;
+    }
+    pipe.SetExternalInput("data", data);
+    pipe.RunCPU();
+    pipe.RunGPU();
+    DeviceWorkspace ws;
+    pipe.Outputs(&ws);
+    TensorList<CPUBackend> out;
+    out.Copy(ws.Output<GPUBackend>(0), 0);
+    CUDA_CALL(cudaDeviceSynchronize());
+    ASSERT_EQ(out.shape(), data.shape());
+    for (int i = 0; i < batch_size; i++) {
+      for (int j = 0; j < 10 + iter; j++)
+        EXPECT_EQ(out.tensor<int>(i)[j], iter * 100 + i * 10 + j);
+    }
+  }
+}
+
 TEST(PipelineTest, AddOperator) {
   Pipeline pipe(10, 4, 0);
   int input_0 = pipe.AddExternalInput("data_in0");
@@ -793,4 +988,40 @@ TEST(PipelineTest, AddOperator) {
   ASSERT_EQ(pipe.GetOperatorNode("third_op")->spec.GetArgument<int64_t>("seed"), 0xDEADBEEF);
 }
 
+TEST(PipelineTest, SerializeMemoryHints) {
+  int batch_size = 4;
+  Pipeline pipe(batch_size, 1, 0);
+  pipe.EnableExecutorMemoryStats();
+  pipe.AddExternalInput("data");
+  pipe.AddOperator(OpSpec("Copy")
+          .AddArg("device", "cpu")
+          .AddInput("data", "cpu")
+          .AddOutput("copied", "cpu"), "copy");
+  vector<std::pair<string, string>> outputs = {{"copied", "cpu"}};
+  EXPECT_THROW(pipe.SerializeToProtobufWithMemoryHints(), std::exception);
+  pipe.Build(outputs);
+
+  TensorList<CPUBackend> data;
+  data.Resize(uniform_list_shape(batch_size, {1000}), DALI_UINT8);
+  pipe.SetExternalInput("data", data);
+  pipe.RunCPU();
+  pipe.RunGPU();
+  DeviceWorkspace ws;
+  pipe.Outputs(&ws);
+
+  auto serialized = pipe.SerializeToProtobufWithMemoryHints();
+  Pipeline loaded_pipe(serialized, batch_size, 1, 0);
+  loaded_pipe.Build(outputs);
+  auto hints = loaded_pipe.GetOperatorNode("copy")->spec.GetRepeatedArgument<int>(
+      "bytes_per_sample_hint");
+  ASSERT_EQ(hints.size(), 1u);
+  EXPECT_EQ(hints[0], 1000);
+
+  // the hints are not stored by default
+  Pipeline plain_pipe(pipe.SerializeToProtobuf(), batch_size, 1, 0);
+  plain_pipe.Build(outputs);
+  EXPECT_FALSE(
+      plain_pipe.GetOperatorNode("copy")->spec.HasArgument("bytes_per_sample_hint"));
+}
+
 }  // namespace dali
@@ -0,0 +1,130 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_UTIL_SAMPLE_SCHEDULER_H_
+#define DALI_PIPELINE_UTIL_SAMPLE_SCHEDULER_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace dali {
+
+/**
+ * @brief Schedules the per-sample jobs of a batch on a thread pool, based on their cost
+ *
+ * The costs of the samples in a batch can differ by orders of magnitude (e.g. thumbnails
+ * next to large photos), so the order in which the jobs are picked up matters. The jobs are
+ * issued to the pool with their cost as the priority, so the most expensive ones start first
+ * and the small ones fill the gaps at the end (the longest-processing-time-first rule).
+ *
+ * That alone cannot help, when a single sample takes longer than the rest of the batch divided
+ * among the other threads. The samples which support it can be added as splittable - their
+ * work is a range of independent parts (e.g. rows) and the ones costing more than an even
+ * share of a thread are split into several jobs, so that no job is larger than the mean work
+ * per thread.
+ *
+ * The cost is in arbitrary units (bytes, pixels, a model specific to the operator), but it
+ * must be consistent within one batch.
+ */
+class SampleScheduler {
+ public:
+  using Work = std::function<void(int thread_id)>;
+  /// Processes the parts [begin, end) of a splittable sample
+  using RangeWork = std::function<void(int thread_id, int64_t begin, int64_t end)>;
+
+  /**
+   * @brief Adds the job of a sample, which cannot be split
+   */
+  void AddSample(double cost, Work work) {
+    Job job;
+    job.cost = cost;
+    job.work = std::move(work);
+    jobs_.push_back(std::move(job));
+  }
+
+  /**
+   * @brief Adds the job of a sample, consisting of `extent` independent parts of equal cost
+   *
+   * @param min_parts the minimum number of parts in a single job, so that the jobs
+   *                  don't get too small
+   */
+  void AddSplittableSample(double cost, int64_t extent, RangeWork work, int64_t min_parts = 1) {
+    if (extent <= 0)
+      return;
+    Job job;
+    job.cost = cost;
+    job.extent = extent;
+    job.min_parts = std::max<int64_t>(min_parts, 1);
+    job.range_work = std::move(work);
+    jobs_.push_back(std::move(job));
+  }
+
+  /**
+   * @brief Issues the jobs to the pool, optionally waiting for them to complete
+   *
+   * The pool can be a ThreadPool or a WorkStealingThreadPool. The scheduler is empty afterwards
+   * and can be reused for the next batch.
+   */
+  template <typename Pool>
+  void Run(Pool &pool, bool wait = true) {
+    double total = 0;
+    for (auto &job : jobs_)
+      total += job.cost;
+    int num_threads = std::max(pool.NumThreads(), 1);
+    double share = total / num_threads;
+
+    for (auto &job : jobs_) {
+      if (!job.range_work) {
+        pool.AddWork(std::move(job.work), std::llround(job.cost));
+        continue;
+      }
+      int64_t num_jobs = 1;
+      if (share > 0 && job.cost > share)
+        num_jobs = static_cast<int64_t>(std::ceil(job.cost / share));
+      num_jobs = std::min<int64_t>(num_jobs, std::max<int64_t>(job.extent / job.min_parts, 1));
+      int64_t priority = std::llround(job.cost / num_jobs);
+      for (int64_t i = 0; i < num_jobs; i++) {
+        int64_t begin = job.extent * i / num_jobs;
+        int64_t end = job.extent * (i + 1) / num_jobs;
+        pool.AddWork([work = job.range_work, begin, end](int thread_id) {
+          work(thread_id, begin, end);
+        }, priority);
+      }
+    }
+    jobs_.clear();
+    pool.RunAll(wait);
+  }
+
+  int NumSamples() const noexcept {
+    return jobs_.size();
+  }
+
+ private:
+  struct Job {
+    double cost = 0;
+    Work work;
+    int64_t extent = 0;
+    int64_t min_parts = 1;
+    RangeWork range_work;
+  };
+  std::vector<Job> jobs_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_UTIL_SAMPLE_SCHEDULER_H_
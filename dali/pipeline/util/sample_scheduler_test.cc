@@ -0,0 +1,124 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/pipeline/util/sample_scheduler.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <utility>
+#include <vector>
+#include "dali/pipeline/util/thread_pool.h"
+
+namespace dali {
+namespace test {
+
+namespace {
+
+/// Records the jobs and runs them in the priority order in the calling thread
+struct RecordingPool {
+  explicit RecordingPool(int num_threads) : num_threads(num_threads) {}
+
+  int NumThreads() const {
+    return num_threads;
+  }
+
+  void AddWork(std::function<void(int)> work, int64_t priority) {
+    jobs.emplace_back(priority, std::move(work));
+  }
+
+  void RunAll(bool) {
+    std::stable_sort(jobs.begin(), jobs.end(), [](auto &a, auto &b) {
+      return a.first > b.first;
+    });
+    for (auto &job : jobs)
+      job.second(0);
+  }
+
+  int num_threads;
+  std::vector<std::pair<int64_t, std::function<void(int)>>> jobs;
+};
+
+}  // namespace
+
+TEST(SampleScheduler, LargestFirst) {
+  RecordingPool pool(4);
+  SampleScheduler scheduler;
+  std::vector<int> order;
+  double costs[] = { 10, 1000, 1, 100 };
+  for (int i = 0; i < 4; i++)
+    scheduler.AddSample(costs[i], [&, i](int) { order.push_back(i); });
+  EXPECT_EQ(scheduler.NumSamples(), 4);
+  scheduler.Run(pool);
+  EXPECT_EQ(order, (std::vector<int>{ 1, 3, 0, 2 }));
+  EXPECT_EQ(scheduler.NumSamples(), 0);
+}
+
+TEST(SampleScheduler, SplitsLargeSamples) {
+  RecordingPool pool(4);
+  SampleScheduler scheduler;
+  // the total is 1000 + 6 * 50 = 1300; the share of a thread is 325
+  std::vector<int> covered(1000, 0);
+  scheduler.AddSplittableSample(1000, 1000, [&](int, int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++)
+      covered[i]++;
+  });
+  int small_done = 0;
+  for (int i = 0; i < 6; i++)
+    scheduler.AddSplittableSample(50, 10, [&](int, int64_t begin, int64_t end) {
+      EXPECT_EQ(begin, 0);
+      EXPECT_EQ(end, 10);
+      small_done++;
+    });
+  scheduler.Run(pool);
+  ASSERT_EQ(pool.jobs.size(), 4u + 6u);
+  for (int i = 0; i < 4; i++)
+    EXPECT_EQ(pool.jobs[i].first, 250);
+  EXPECT_EQ(small_done, 6);
+  for (int c : covered)
+    EXPECT_EQ(c, 1);
+}
+
+TEST(SampleScheduler, MinParts) {
+  RecordingPool pool(8);
+  SampleScheduler scheduler;
+  int64_t total = 0;
+  int jobs = 0;
+  scheduler.AddSplittableSample(100, 40, [&](int, int64_t begin, int64_t end) {
+    EXPECT_GE(end - begin, 16);
+    total += end - begin;
+    jobs++;
+  }, 16);
+  scheduler.Run(pool);
+  EXPECT_EQ(jobs, 2);
+  EXPECT_EQ(total, 40);
+}
+
+TEST(SampleScheduler, ThreadPool) {
+  ThreadPool tp(4, 0, false);
+  SampleScheduler scheduler;
+  std::atomic<int64_t> done{0};
+  for (int i = 0; i < 16; i++) {
+    int64_t extent = (i % 4 == 0) ? 1000 : 10;
+    scheduler.AddSplittableSample(extent, extent, [&](int, int64_t begin, int64_t end) {
+      done += end - begin;
+    });
+    scheduler.AddSample(1, [&](int) { done++; });
+  }
+  scheduler.Run(tp);
+  EXPECT_EQ(done, 4 * 1000 + 12 * 10 + 16);
+}
+
+}  // namespace test
+}  // namespace dali
@@ -0,0 +1,92 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_UTIL_SIZE_HISTOGRAM_H_
+#define DALI_PIPELINE_UTIL_SIZE_HISTOGRAM_H_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include "dali/core/util.h"
+
+namespace dali {
+
+/**
+ * @brief A histogram of buffer sizes, used to choose how much memory to preallocate
+ *
+ * The buckets are logarithmic, with 4 buckets per power of two, so a percentile is
+ * overestimated by at most 25%. It's not thread-safe.
+ */
+class SizeHistogram {
+ public:
+  /// The percentile of the sizes used for preallocation, by default
+  static constexpr double kDefaultPercentile = 0.95;
+
+  void Add(size_t size) {
+    buckets_[Bucket(size)]++;
+    count_++;
+  }
+
+  int64_t count() const {
+    return count_;
+  }
+
+  /**
+   * @brief Returns a size not smaller than the given fraction `p` of the sizes seen so far,
+   *        or 0, if there were none
+   */
+  size_t Percentile(double p) const {
+    if (count_ == 0)
+      return 0;
+    int64_t target = std::max<int64_t>(1, std::ceil(p * count_));
+    int64_t seen = 0;
+    for (int b = 0; b < kNumBuckets; b++) {
+      seen += buckets_[b];
+      if (seen >= target)
+        return UpperBound(b);
+    }
+    return UpperBound(kNumBuckets - 1);
+  }
+
+ private:
+  static constexpr int kSubBuckets = 4;
+  static constexpr int kSubBucketBits = 2;
+  static constexpr int kNumBuckets = 64 * kSubBuckets;
+
+  static int Bucket(size_t size) {
+    if (size < kSubBuckets)
+      return size;
+    int e = ilog2(size);
+    int sub = (size >> (e - kSubBucketBits)) & (kSubBuckets - 1);
+    return kSubBuckets * (e - kSubBucketBits + 1) + sub;
+  }
+
+  /// The largest size in the bucket `b`
+  static size_t UpperBound(int b) {
+    if (b < kSubBuckets)
+      return b;
+    int e = b / kSubBuckets + kSubBucketBits - 1;
+    size_t sub = b % kSubBuckets;
+    return ((kSubBuckets + sub + 1) << (e - kSubBucketBits)) - 1;
+  }
+
+  std::array<int64_t, kNumBuckets> buckets_{};
+  int64_t count_ = 0;
+};
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_UTIL_SIZE_HISTOGRAM_H_
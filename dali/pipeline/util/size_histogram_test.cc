@@ -0,0 +1,65 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/pipeline/util/size_histogram.h"
+#include <gtest/gtest.h>
+#include <limits>
+
+namespace dali {
+
+namespace test {
+
+TEST(SizeHistogram, Empty) {
+  SizeHistogram hist;
+  EXPECT_EQ(hist.count(), 0);
+  EXPECT_EQ(hist.Percentile(0.95), 0u);
+}
+
+TEST(SizeHistogram, SmallSizesAreExact) {
+  SizeHistogram hist;
+  for (size_t size = 0; size < 8; size++)
+    hist.Add(size);
+  EXPECT_EQ(hist.count(), 8);
+  EXPECT_EQ(hist.Percentile(0), 0u);
+  EXPECT_EQ(hist.Percentile(0.5), 3u);
+  EXPECT_EQ(hist.Percentile(1), 7u);
+}
+
+TEST(SizeHistogram, PercentileBounds) {
+  for (size_t size : { 100u, 1000u, 12345u, 1u << 20, (1u << 20) + 1 }) {
+    SizeHistogram hist;
+    hist.Add(size);
+    size_t p = hist.Percentile(1);
+    EXPECT_GE(p, size);
+    EXPECT_LE(p, size + size / 4) << size;
+  }
+  SizeHistogram hist;
+  hist.Add(std::numeric_limits<size_t>::max());
+  EXPECT_EQ(hist.Percentile(1), std::numeric_limits<size_t>::max());
+}
+
+TEST(SizeHistogram, OutliersIgnored) {
+  SizeHistogram hist;
+  for (int i = 0; i < 99; i++)
+    hist.Add(1000 + i);
+  hist.Add(100000000);
+  size_t p95 = hist.Percentile(0.95);
+  EXPECT_GE(p95, 1094u);
+  EXPECT_LT(p95, 2000u);
+  EXPECT_GE(hist.Percentile(1), 100000000u);
+}
+
+}  // namespace test
+
+}  // namespace dali
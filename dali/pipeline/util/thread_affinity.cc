@@ -0,0 +1,231 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <sys/sysinfo.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "dali/pipeline/util/thread_affinity.h"
+#if NVML_ENABLED
+#include "dali/util/nvml.h"
+#include "dali/core/device_guard.h"
+#endif
+#include "dali/core/error_handling.h"
+#include "dali/core/format.h"
+
+namespace dali {
+
+namespace {
+
+struct AffinityRegistry {
+  std::mutex mutex;
+  bool policy_set = false;
+  AffinityPolicy policy = AffinityPolicy::Socket;
+  /// The next core assigned with the Core policy, per device
+  std::map<int, int> next_core;
+  std::map<std::thread::id, ThreadAffinityInfo> threads;
+};
+
+AffinityRegistry &Registry() {
+  // never destroyed - the threads may exit after the static objects are gone
+  static auto *registry = new AffinityRegistry();
+  return *registry;
+}
+
+/**
+ * @brief Removes the thread from the report when it exits
+ */
+struct ThreadRecord {
+  bool registered = false;
+
+  ~ThreadRecord() {
+    if (!registered)
+      return;
+    auto &registry = Registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.threads.erase(std::this_thread::get_id());
+  }
+};
+
+thread_local ThreadRecord this_thread_record;
+
+const std::pair<const char *, AffinityPolicy> kAffinityPolicyNames[] = {
+  { "none",   AffinityPolicy::None },
+  { "socket", AffinityPolicy::Socket },
+  { "core",   AffinityPolicy::Core },
+};
+
+std::vector<int> ToCPUList(const cpu_set_t &set) {
+  std::vector<int> cpus;
+  for (int i = 0; i < CPU_SETSIZE; i++) {
+    if (CPU_ISSET(i, &set))
+      cpus.push_back(i);
+  }
+  return cpus;
+}
+
+/**
+ * @brief The cores close to the device, which the calling thread is allowed to use,
+ *        or all the allowed ones if NVML can't tell
+ */
+cpu_set_t PreferredCPUs(int device_id) {
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  pthread_getaffinity_np(pthread_self(), sizeof(allowed), &allowed);
+#if NVML_ENABLED
+  if (device_id >= 0) {
+    cpu_set_t close;
+    CPU_ZERO(&close);
+    try {
+      DeviceGuard g(device_id);
+      nvml::Init();
+      {
+        std::lock_guard<std::mutex> lock(nvml::Mutex());
+        nvml::GetNVMLAffinityMask(&close, get_nprocs_conf());
+      }
+      nvml::Shutdown();
+    } catch (const std::exception &e) {
+      DALI_WARN("Cannot get the CPU affinity of the device ", device_id, " from NVML: ",
+                e.what());
+    }
+    if (CPU_COUNT(&close) > 0)
+      return close;
+  }
+#endif
+  return allowed;
+}
+
+}  // namespace
+
+AffinityPolicy ParseAffinityPolicy(const std::string &name) {
+  for (auto &entry : kAffinityPolicyNames) {
+    if (name == entry.first)
+      return entry.second;
+  }
+  DALI_FAIL(make_string("Unknown affinity policy: \"", name,
+                        "\". Valid policies are: \"none\", \"socket\" and \"core\"."));
+}
+
+const char *AffinityPolicyName(AffinityPolicy policy) {
+  for (auto &entry : kAffinityPolicyNames) {
+    if (policy == entry.second)
+      return entry.first;
+  }
+  return "<invalid>";
+}
+
+AffinityPolicy GetAffinityPolicy() {
+  auto &registry = Registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  if (!registry.policy_set) {
+    if (const char *env = std::getenv("DALI_AFFINITY_POLICY"))
+      registry.policy = ParseAffinityPolicy(env);
+    registry.policy_set = true;
+  }
+  return registry.policy;
+}
+
+void SetAffinityPolicy(AffinityPolicy policy) {
+  auto &registry = Registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.policy = policy;
+  registry.policy_set = true;
+}
+
+int AffinityMaskCore(int thread_idx) {
+  const char *env_affinity = std::getenv("DALI_AFFINITY_MASK");
+  if (!env_affinity)
+    return -1;
+  const auto &vec = string_split(env_affinity, ',');
+  if (static_cast<size_t>(thread_idx) < vec.size())
+    return std::stoi(vec[thread_idx]);
+  DALI_WARN("DALI_AFFINITY_MASK environment variable is set, "
+            "but does not have enough entries: thread_id (", thread_idx,
+            ") vs #entries (", vec.size(), "). Ignoring...");
+  return -1;
+}
+
+void InitThreadAffinity(const std::string &name, int device_id, bool set_affinity, int core) {
+  auto policy = set_affinity ? GetAffinityPolicy() : AffinityPolicy::None;
+  if (policy != AffinityPolicy::None) {
+    int num_cpus = get_nprocs_conf();
+    cpu_set_t requested;
+    CPU_ZERO(&requested);
+    if (core >= 0 && core < num_cpus) {
+      CPU_SET(core, &requested);
+    } else {
+      if (core != -1) {
+        DALI_WARN(make_string("Requested setting affinity to core ", core,
+                              " but only ", num_cpus, " cores available. Ignoring..."));
+      }
+      requested = PreferredCPUs(device_id);
+      auto cpus = ToCPUList(requested);
+      if (policy == AffinityPolicy::Core && !cpus.empty()) {
+        int idx;
+        {
+          auto &registry = Registry();
+          std::lock_guard<std::mutex> lock(registry.mutex);
+          idx = registry.next_core[device_id]++;
+        }
+        CPU_ZERO(&requested);
+        CPU_SET(cpus[idx % cpus.size()], &requested);
+      }
+    }
+
+    if (CPU_COUNT(&requested) == 0) {
+      DALI_WARN("CPU affinity requested by user or recommended by nvml setting"
+                " does not meet allowed affinity for given DALI thread."
+                " Use taskset tool to check allowed affinity");
+    } else {
+      int error = pthread_setaffinity_np(pthread_self(), sizeof(requested), &requested);
+      if (error != 0)
+        DALI_WARN("Setting affinity failed! Error code: " + to_string(error));
+    }
+  }
+
+  cpu_set_t actual;
+  CPU_ZERO(&actual);
+  pthread_getaffinity_np(pthread_self(), sizeof(actual), &actual);
+  ThreadAffinityInfo info{name, device_id, static_cast<int64_t>(syscall(SYS_gettid)),
+                          ToCPUList(actual)};
+  auto &registry = Registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.threads[std::this_thread::get_id()] = std::move(info);
+  this_thread_record.registered = true;
+}
+
+std::vector<ThreadAffinityInfo> GetThreadAffinityReport() {
+  std::vector<ThreadAffinityInfo> report;
+  {
+    auto &registry = Registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    report.reserve(registry.threads.size());
+    for (auto &entry : registry.threads)
+      report.push_back(entry.second);
+  }
+  std::sort(report.begin(), report.end(), [](const auto &a, const auto &b) {
+    return a.device_id != b.device_id ? a.device_id < b.device_id : a.tid < b.tid;
+  });
+  return report;
+}
+
+}  // namespace dali
@@ -0,0 +1,98 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_UTIL_THREAD_AFFINITY_H_
+#define DALI_PIPELINE_UTIL_THREAD_AFFINITY_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "dali/core/common.h"
+
+namespace dali {
+
+/**
+ * @brief How the threads created by DALI are placed on the CPU cores
+ *
+ * The policy applies to the threads of the pipelines with `set_affinity` enabled: the thread
+ * pools, the executor's stage threads and the readers' prefetch threads.
+ * The cores close to the GPU of the pipeline are the ones reported by NVML (all the cores
+ * available to the process, if NVML is not available).
+ */
+enum class AffinityPolicy {
+  /// The threads are not pinned
+  None,
+  /// Each thread can run on any of the cores close to the GPU
+  Socket,
+  /// Each thread is pinned to one of the cores close to the GPU, assigned in turn
+  Core,
+};
+
+/**
+ * @brief Parses the name of the policy: none, socket or core
+ */
+DLL_PUBLIC AffinityPolicy ParseAffinityPolicy(const std::string &name);
+
+DLL_PUBLIC const char *AffinityPolicyName(AffinityPolicy policy);
+
+/**
+ * @brief Returns the current policy - by default, the one given in the DALI_AFFINITY_POLICY
+ *        environment variable, or Socket
+ */
+DLL_PUBLIC AffinityPolicy GetAffinityPolicy();
+
+/**
+ * @brief Sets the policy for the threads started afterwards
+ */
+DLL_PUBLIC void SetAffinityPolicy(AffinityPolicy policy);
+
+/**
+ * @brief Returns the core requested for the thread `thread_idx` of a pool in
+ *        the DALI_AFFINITY_MASK environment variable (a comma-separated list of cores),
+ *        or -1 if there's none
+ */
+DLL_PUBLIC int AffinityMaskCore(int thread_idx);
+
+/**
+ * @brief Places the calling thread according to the affinity policy and records its placement
+ *
+ * It's called by each thread created by DALI when it starts. The thread is listed in
+ * GetThreadAffinityReport until it exits.
+ *
+ * @param name          name of the thread in the report
+ * @param device_id     the GPU the thread works for, or CPU_ONLY_DEVICE_ID
+ * @param set_affinity  if false, the thread is only recorded
+ * @param core          the core requested by the user for this thread (see AffinityMaskCore),
+ *                      which takes precedence over the policy; -1 if none
+ */
+DLL_PUBLIC void InitThreadAffinity(const std::string &name, int device_id, bool set_affinity,
+                                   int core = -1);
+
+struct ThreadAffinityInfo {
+  std::string name;
+  int device_id;
+  /// The id of the thread in the operating system
+  int64_t tid;
+  /// The cores the thread can run on
+  std::vector<int> cpus;
+};
+
+/**
+ * @brief Lists the running threads created by DALI, with the cores they can run on
+ */
+DLL_PUBLIC std::vector<ThreadAffinityInfo> GetThreadAffinityReport();
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_UTIL_THREAD_AFFINITY_H_
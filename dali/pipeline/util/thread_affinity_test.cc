@@ -0,0 +1,75 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/pipeline/util/thread_affinity.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace dali {
+
+namespace test {
+
+namespace {
+
+std::vector<ThreadAffinityInfo> ReportOf(const std::string &name) {
+  std::vector<ThreadAffinityInfo> ret;
+  for (auto &info : GetThreadAffinityReport()) {
+    if (info.name == name)
+      ret.push_back(info);
+  }
+  return ret;
+}
+
+}  // namespace
+
+TEST(ThreadAffinity, ParsePolicy) {
+  EXPECT_EQ(ParseAffinityPolicy("none"), AffinityPolicy::None);
+  EXPECT_EQ(ParseAffinityPolicy("socket"), AffinityPolicy::Socket);
+  EXPECT_EQ(ParseAffinityPolicy("core"), AffinityPolicy::Core);
+  EXPECT_STREQ(AffinityPolicyName(AffinityPolicy::Core), "core");
+  EXPECT_THROW(ParseAffinityPolicy("numa"), std::exception);
+}
+
+TEST(ThreadAffinity, ReportLifetime) {
+  std::thread t([]() {
+    InitThreadAffinity("ThreadAffinity.ReportLifetime", CPU_ONLY_DEVICE_ID, false);
+    auto report = ReportOf("ThreadAffinity.ReportLifetime");
+    ASSERT_EQ(report.size(), 1u);
+    EXPECT_FALSE(report[0].cpus.empty());
+    EXPECT_EQ(report[0].device_id, CPU_ONLY_DEVICE_ID);
+  });
+  t.join();
+  // the thread is removed from the report when it exits
+  EXPECT_TRUE(ReportOf("ThreadAffinity.ReportLifetime").empty());
+}
+
+TEST(ThreadAffinity, CorePolicy) {
+  auto prev_policy = GetAffinityPolicy();
+  SetAffinityPolicy(AffinityPolicy::Core);
+  std::vector<ThreadAffinityInfo> report;
+  std::thread t([&]() {
+    InitThreadAffinity("ThreadAffinity.CorePolicy", CPU_ONLY_DEVICE_ID, true);
+    report = ReportOf("ThreadAffinity.CorePolicy");
+  });
+  t.join();
+  SetAffinityPolicy(prev_policy);
+  ASSERT_EQ(report.size(), 1u);
+  EXPECT_EQ(report[0].cpus.size(), 1u);
+}
+
+}  // namespace test
+
+}  // namespace dali
@@ -12,26 +12,43 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <chrono>
 #include <cstdlib>
+#include <limits>
+#include <map>
 #include <utility>
 #include "dali/pipeline/util/thread_pool.h"
+#include "dali/pipeline/util/thread_affinity.h"
 #if NVML_ENABLED
 #include "dali/util/nvml.h"
 #endif
 #include "dali/core/format.h"
 #include "dali/core/cuda_utils.h"
 #include "dali/core/device_guard.h"
+#include "dali/core/nvtx.h"
 
 namespace dali {
 
-ThreadPool::ThreadPool(int num_thread, int device_id, bool set_affinity)
-    : threads_(num_thread), running_(true), work_complete_(true), started_(false)
-    , active_threads_(0) {
+ThreadPool::ThreadPool(int num_thread, int device_id, bool set_affinity, bool shared)
+    : running_(true), work_complete_(true), started_(false)
+    , active_threads_(0), device_id_(device_id) {
   DALI_ENFORCE(num_thread > 0, "Thread pool must have non-zero size");
+  if (shared) {
+    if (set_affinity)
+      DALI_WARN("Thread affinity is not set for the threads shared between pipelines.");
+    shared_ = GetShared(num_thread);
+    tl_errors_.resize(num_thread);
+    return;
+  }
+  threads_.resize(num_thread);
 #if NVML_ENABLED
   // only for the CPU pipeline
   if (device_id != CPU_ONLY_DEVICE_ID) {
     nvml::Init();
+    // the pinned buffers should be close to the CPUs processing the data
+    if (set_affinity)
+      nvml::SetMemoryAffinity(device_id);
   }
 #endif
   // Start the threads in the main loop
@@ -52,12 +69,120 @@ ThreadPool::~ThreadPool() {
   for (auto &thread : threads_) {
     thread.join();
   }
+  if (shared_)
+    shared_->RemoveClient(this);
 #if NVML_ENABLED
-  nvml::Shutdown();
+  if (!shared_)
+    nvml::Shutdown();
 #endif
 }
 
+std::shared_ptr<ThreadPool> ThreadPool::GetShared(int num_thread) {
+  static std::mutex registry_mutex;
+  static std::map<int, std::weak_ptr<ThreadPool>> registry;
+  std::lock_guard<std::mutex> lock(registry_mutex);
+  auto &entry = registry[num_thread];
+  auto pool = entry.lock();
+  if (!pool) {
+    pool = std::make_shared<ThreadPool>(num_thread, CPU_ONLY_DEVICE_ID, false);
+    entry = pool;
+  }
+  return pool;
+}
+
+void ThreadPool::SetWeight(double weight) {
+  DALI_ENFORCE(weight > 0, make_string("The weight must be positive. Got: ", weight));
+  std::lock_guard<std::mutex> lock(mutex_);
+  weight_ = weight;
+}
+
+void ThreadPool::SetInlineSingleJob(bool enable) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  inline_single_job_ = enable;
+}
+
+void ThreadPool::AddClientWork(const ThreadPool *client, double weight, Work work,
+                               int64_t priority) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto &c = clients_[client];
+    if (c.queue.empty() && c.running == 0) {
+      // an idle pool doesn't get ahead of the others for the time it didn't use
+      double min_time = std::numeric_limits<double>::max();
+      for (auto &entry : clients_) {
+        if (!entry.second.queue.empty() || entry.second.running > 0)
+          min_time = std::min(min_time, entry.second.virtual_time);
+      }
+      if (min_time != std::numeric_limits<double>::max())
+        c.virtual_time = std::max(c.virtual_time, min_time);
+    }
+    c.weight = weight;
+    c.removed = false;
+    c.queue.push({priority, std::move(work)});
+    ++client_work_;
+    work_complete_ = false;
+    started_ = true;
+  }
+  condition_.notify_one();
+}
+
+void ThreadPool::RemoveClient(const ThreadPool *client) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = clients_.find(client);
+  if (it == clients_.end())
+    return;
+  // the thread finishing the last job of the client erases it
+  if (it->second.running > 0)
+    it->second.removed = true;
+  else
+    clients_.erase(it);
+}
+
+void ThreadPool::Forward(Work work, int64_t priority) {
+  double weight;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++pending_;
+    work_complete_ = false;
+    weight = weight_;
+  }
+  shared_->AddClientWork(this, weight, [this, work](int thread_id) {
+    auto start = std::chrono::steady_clock::now();
+    try {
+      DeviceGuard g(device_id_);
+      work(thread_id);
+    } catch (std::exception &e) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tl_errors_[thread_id].push(e.what());
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tl_errors_[thread_id].push("Caught unknown exception");
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    // Notify under the lock - the pool may be destroyed as soon as the waiting thread wakes up
+    std::lock_guard<std::mutex> lock(mutex_);
+    busy_time_ += elapsed.count();
+    if (--pending_ == 0 && work_queue_.empty()) {
+      work_complete_ = true;
+      completed_.notify_all();
+    }
+  }, priority);
+}
+
 void ThreadPool::AddWork(Work work, int64_t priority, bool start_immediately) {
+  if (shared_) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      started_ |= start_immediately;
+      if (!started_) {
+        work_queue_.push({priority, std::move(work)});
+        work_complete_ = false;
+        return;
+      }
+    }
+    Forward(std::move(work), priority);
+    return;
+  }
   bool started_before = false;
   {
     std::lock_guard<std::mutex> lock(mutex_);
@@ -81,7 +206,7 @@ void ThreadPool::WaitForWork(bool checkForErrors) {
   started_ = false;
   if (checkForErrors) {
     // Check for errors
-    for (size_t i = 0; i < threads_.size(); ++i) {
+    for (size_t i = 0; i < tl_errors_.size(); ++i) {
       if (!tl_errors_[i].empty()) {
         // Throw the first error that occurred
         string error = make_string("Error in thread ", i, ": ", tl_errors_[i].front());
@@ -92,7 +217,62 @@ void ThreadPool::WaitForWork(bool checkForErrors) {
   }
 }
 
+bool ThreadPool::RunInline() {
+  Work work;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // the workers pick up the queued jobs only after the work is started
+    if (!inline_single_job_ || started_ || work_queue_.size() != 1)
+      return false;
+    work = std::move(work_queue_.top().second);
+    work_queue_.pop();
+  }
+  auto start = std::chrono::steady_clock::now();
+  try {
+    DeviceGuard g(device_id_);
+    work(0);
+  } catch (std::exception &e) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tl_errors_[0].push(e.what());
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tl_errors_[0].push("Caught unknown exception");
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    busy_time_ += elapsed.count();
+    // the job may have queued more work
+    if (!work_queue_.empty())
+      return false;
+    work_complete_ = pending_ == 0;
+  }
+  WaitForWork();
+  return true;
+}
+
 void ThreadPool::RunAll(bool wait) {
+  if (wait && RunInline())
+    return;
+  if (shared_) {
+    std::vector<PrioritizedWork> queued;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      started_ = true;
+      queued.reserve(work_queue_.size());
+      while (!work_queue_.empty()) {
+        queued.push_back(std::move(work_queue_.top()));
+        work_queue_.pop();
+      }
+    }
+    // the queue is drained in the order of priority
+    for (auto &w : queued)
+      Forward(std::move(w.second), w.first);
+    if (wait) {
+      WaitForWork();
+    }
+    return;
+  }
   {
     std::lock_guard<std::mutex> lock(mutex_);
     started_ = true;
@@ -104,10 +284,19 @@ void ThreadPool::RunAll(bool wait) {
 }
 
 int ThreadPool::NumThreads() const {
+  if (shared_)
+    return shared_->NumThreads();
   return threads_.size();
 }
 
+double ThreadPool::BusyTime() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return busy_time_;
+}
+
 std::vector<std::thread::id> ThreadPool::GetThreadIds() const {
+  if (shared_)
+    return shared_->GetThreadIds();
   std::vector<std::thread::id> tids;
   tids.reserve(threads_.size());
   for (const auto &thread : threads_)
@@ -119,23 +308,8 @@ std::vector<std::thread::id> ThreadPool::GetThreadIds() const {
 void ThreadPool::ThreadMain(int thread_id, int device_id, bool set_affinity) {
   DeviceGuard g(device_id);
   try {
-#if NVML_ENABLED
-    if (set_affinity) {
-      const char *env_affinity = std::getenv("DALI_AFFINITY_MASK");
-      int core = -1;
-      if (env_affinity) {
-        const auto &vec = string_split(env_affinity, ',');
-        if ((size_t)thread_id < vec.size()) {
-          core = std::stoi(vec[thread_id]);
-        } else {
-          DALI_WARN("DALI_AFFINITY_MASK environment variable is set, "
-                    "but does not have enough entries: thread_id (", thread_id,
-                    ") vs #entries (", vec.size(), "). Ignoring...");
-        }
-      }
-      nvml::SetCPUAffinity(core);
-    }
-#endif
+    InitThreadAffinity(make_string("ThreadPool worker ", thread_id), device_id, set_affinity,
+                       set_affinity ? AffinityMaskCore(thread_id) : -1);
   } catch (std::exception &e) {
     tl_errors_[thread_id].push(e.what());
   } catch (...) {
@@ -145,15 +319,33 @@ void ThreadPool::ThreadMain(int thread_id, int device_id, bool set_affinity) {
   while (running_) {
     // Block on the condition to wait for work
     std::unique_lock<std::mutex> lock(mutex_);
-    condition_.wait(lock, [this] { return !running_ || (!work_queue_.empty() && started_); });
+    condition_.wait(lock, [this] {
+      return !running_ || ((!work_queue_.empty() || client_work_ > 0) && started_);
+    });
     // If we're no longer running, exit the run loop
     if (!running_) break;
 
     // Get work from the queue & mark
     // this thread as active
-    Work work = std::move(work_queue_.top().second);
-    work_queue_.pop();
+    Work work;
+    Client *client = nullptr;
+    if (!work_queue_.empty()) {
+      work = std::move(work_queue_.top().second);
+      work_queue_.pop();
+    } else {
+      // the work of the client pool, which is the furthest behind its share
+      for (auto &entry : clients_) {
+        auto &c = entry.second;
+        if (!c.queue.empty() && (!client || c.virtual_time < client->virtual_time))
+          client = &c;
+      }
+      work = std::move(client->queue.top().second);
+      client->queue.pop();
+      --client_work_;
+      ++client->running;
+    }
     ++active_threads_;
+    auto start = std::chrono::steady_clock::now();
 
     // Unlock the lock
     lock.unlock();
@@ -162,6 +354,7 @@ void ThreadPool::ThreadMain(int thread_id, int device_id, bool set_affinity) {
     // WaitForWork is called, we will check for any errors
     // in the threads and return an error if one occured.
     try {
+      TraceRange tr(kTraceThreadPool, "[DALI][ThreadPool] Task", RangeBase::kYellow);
       work(thread_id);
     } catch (std::exception &e) {
       lock.lock();
@@ -174,9 +367,23 @@ void ThreadPool::ThreadMain(int thread_id, int device_id, bool set_affinity) {
     }
 
     // Mark this thread as idle & check for complete work
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
     lock.lock();
+    if (client) {
+      client->virtual_time += elapsed.count() / client->weight;
+      if (--client->running == 0 && client->removed && client->queue.empty()) {
+        for (auto it = clients_.begin(); it != clients_.end(); ++it) {
+          if (&it->second == client) {
+            clients_.erase(it);
+            break;
+          }
+        }
+      }
+    } else {
+      busy_time_ += elapsed.count();
+    }
     --active_threads_;
-    if (work_queue_.empty() && active_threads_ == 0) {
+    if (work_queue_.empty() && client_work_ == 0 && active_threads_ == 0) {
       work_complete_ = true;
       lock.unlock();
       completed_.notify_one();
@@ -19,6 +19,8 @@
 #include <utility>
 #include <condition_variable>
 #include <functional>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <queue>
 #include <thread>
@@ -34,7 +36,17 @@ class DLL_PUBLIC ThreadPool {
   // Basic unit of work that our threads do
   typedef std::function<void(int)> Work;
 
-  DLL_PUBLIC ThreadPool(int num_thread, int device_id, bool set_affinity);
+  /**
+   * @brief Creates a thread pool
+   *
+   * @param shared If true, the pool doesn't start its own threads - the work is run by
+   *               the process-wide pool with num_thread threads (see GetShared), shared by
+   *               all pools created this way, regardless of their device.
+   *               Each pool still waits only for its own work and reports only its own errors;
+   *               the jobs are run with device_id set as the current device.
+   *               set_affinity is ignored for such pools.
+   */
+  DLL_PUBLIC ThreadPool(int num_thread, int device_id, bool set_affinity, bool shared = false);
 
   DLL_PUBLIC ~ThreadPool();
 
@@ -64,11 +76,65 @@ class DLL_PUBLIC ThreadPool {
 
   DLL_PUBLIC std::vector<std::thread::id> GetThreadIds() const;
 
+  /**
+   * @brief Returns the thread time spent running the work of this pool, in seconds
+   *
+   * For a pool using the shared threads, only the time spent on its own work is counted.
+   */
+  DLL_PUBLIC double BusyTime();
+
+  /**
+   * @brief Returns the process-wide pool with given number of threads, not bound to any device
+   *
+   * The pool is created on first use and destroyed when the last reference is released.
+   */
+  DLL_PUBLIC static std::shared_ptr<ThreadPool> GetShared(int num_thread);
+
+  /**
+   * @brief Sets the share of the shared threads this pool gets, when other pools have work too
+   *
+   * The shared threads pick the work of the pool which has used the least thread time,
+   * divided by its weight, so a pool with weight 2 gets twice as much time as one with
+   * weight 1 (the default). It has no effect on the pools with their own threads.
+   */
+  DLL_PUBLIC void SetWeight(double weight);
+
+  /**
+   * @brief Makes RunAll(true) run a single queued job on the calling thread
+   *
+   * Waking up a worker for one job adds the latency of the handoff and gives no parallelism -
+   * e.g. the per-sample work of a batch of 1. The job gets the thread index 0, as no other job
+   * of this pool runs at that time.
+   */
+  DLL_PUBLIC void SetInlineSingleJob(bool enable);
+
   DISABLE_COPY_MOVE_ASSIGN(ThreadPool);
 
  private:
   DLL_PUBLIC void ThreadMain(int thread_id, int device_id, bool set_affinity);
 
+  /**
+   * @brief Runs the only queued job on the calling thread, see SetInlineSingleJob
+   *
+   * @return false, if the work has to be run by the workers
+   */
+  bool RunInline();
+
+  /**
+   * @brief Passes the work to the shared pool, tracking its completion and errors in this pool
+   */
+  void Forward(Work work, int64_t priority);
+
+  /**
+   * @brief Called on the shared pool - queues the work of the client pool, see SetWeight
+   */
+  void AddClientWork(const ThreadPool *client, double weight, Work work, int64_t priority);
+
+  /**
+   * @brief Called on the shared pool, when the client pool, which has no work left, is destroyed
+   */
+  void RemoveClient(const ThreadPool *client);
+
   vector<std::thread> threads_;
 
   using PrioritizedWork = std::pair<int64_t, Work>;
@@ -89,6 +155,28 @@ class DLL_PUBLIC ThreadPool {
 
   //  Stored error strings for each thread
   vector<std::queue<string>> tl_errors_;
+
+  // The pool which runs the work, if the threads are shared
+  std::shared_ptr<ThreadPool> shared_;
+  int device_id_;
+  // The number of jobs forwarded to the shared pool and not finished yet
+  int pending_ = 0;
+  double weight_ = 1;
+  bool inline_single_job_ = false;
+  // see BusyTime
+  double busy_time_ = 0;
+
+  // The state of a pool using the shared threads, kept by the shared pool
+  struct Client {
+    std::priority_queue<PrioritizedWork, std::vector<PrioritizedWork>, SortByPriority> queue;
+    double weight = 1;
+    double virtual_time = 0;  // the thread time used, divided by the weight
+    int running = 0;
+    bool removed = false;
+  };
+  std::map<const ThreadPool *, Client> clients_;
+  // The number of jobs in the queues of the clients
+  int client_work_ = 0;
 };
 
 }  // namespace dali
@@ -15,6 +15,11 @@
 #include "dali/pipeline/util/thread_pool.h"
 #include <gtest/gtest.h>
 #include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
 namespace dali {
 
@@ -67,6 +72,138 @@ TEST(ThreadPool, AddWorkWithPriority) {
   ASSERT_EQ(((1+1) << 3) + 1, count);
 }
 
+TEST(ThreadPool, SharedThreads) {
+  ThreadPool tp1(4, 0, false, true);
+  ThreadPool tp2(4, 1, false, true);
+  EXPECT_EQ(tp1.NumThreads(), 4);
+  EXPECT_EQ(tp1.GetThreadIds(), tp2.GetThreadIds());
+  EXPECT_EQ(tp1.GetThreadIds(), ThreadPool::GetShared(4)->GetThreadIds());
+
+  std::atomic<int> count1{0}, count2{0};
+  for (int i = 0; i < 64; i++) {
+    tp1.AddWork([&count1](int thread_id) { count1++; });
+    tp2.AddWork([&count2](int thread_id) { count2++; }, 0, true);
+  }
+  ASSERT_EQ(count1, 0);
+  tp2.WaitForWork();
+  ASSERT_EQ(count2, 64);
+  tp1.RunAll();
+  ASSERT_EQ(count1, 64);
+}
+
+TEST(ThreadPool, SharedThreadsWithPriority) {
+  ThreadPool tp(1, 0, false, true);
+  std::atomic<int> count{0};
+  auto set_to_1 = [&count](int thread_id) {
+    count = 1;
+  };
+  auto increase_by_1 = [&count](int thread_id) {
+    count++;
+  };
+  auto mult_by_2 = [&count](int thread_id) {
+    int val = count.load();
+    while (!count.compare_exchange_weak(val, val * 2)) {}
+  };
+  tp.AddWork(increase_by_1, 2);
+  tp.AddWork(mult_by_2, 7);
+  tp.AddWork(mult_by_2, 9);
+  tp.AddWork(mult_by_2, 8);
+  tp.AddWork(increase_by_1, 100);
+  tp.AddWork(set_to_1, 1000);
+
+  tp.RunAll();
+  ASSERT_EQ(((1+1) << 3) + 1, count);
+}
+
+TEST(ThreadPool, InlineSingleJob) {
+  ThreadPool tp(4, 0, false);
+  tp.SetInlineSingleJob(true);
+  auto caller = std::this_thread::get_id();
+  std::thread::id runner;
+  tp.AddWork([&](int thread_id) {
+    EXPECT_EQ(thread_id, 0);
+    runner = std::this_thread::get_id();
+  });
+  tp.RunAll();
+  EXPECT_EQ(runner, caller);
+
+  // more jobs are still run by the workers
+  std::mutex m;
+  std::vector<std::thread::id> runners;
+  for (int i = 0; i < 2; i++) {
+    tp.AddWork([&](int) {
+      std::lock_guard<std::mutex> lock(m);
+      runners.push_back(std::this_thread::get_id());
+    });
+  }
+  tp.RunAll();
+  ASSERT_EQ(runners.size(), 2u);
+  EXPECT_NE(runners[0], caller);
+  EXPECT_NE(runners[1], caller);
+
+  tp.AddWork([](int) { throw std::runtime_error("error in the inline job"); });
+  EXPECT_THROW(tp.RunAll(), std::runtime_error);
+  // the pool is usable after the error
+  int count = 0;
+  tp.AddWork([&](int) { count++; });
+  tp.RunAll();
+  EXPECT_EQ(count, 1);
+}
+
+TEST(ThreadPool, SharedThreadsErrors) {
+  ThreadPool tp1(2, 0, false, true);
+  ThreadPool tp2(2, 1, false, true);
+  tp1.AddWork([](int thread_id) { throw std::runtime_error("error in tp1"); });
+  tp2.AddWork([](int thread_id) {});
+  tp1.RunAll(false);
+  tp2.RunAll(false);
+  EXPECT_NO_THROW(tp2.WaitForWork());
+  EXPECT_THROW(tp1.WaitForWork(), std::runtime_error);
+}
+
+TEST(ThreadPool, SharedThreadsWeights) {
+  ThreadPool blocker(1, 0, false, true);
+  ThreadPool tp1(1, 0, false, true);
+  ThreadPool tp2(1, 0, false, true);
+  tp1.SetWeight(3);
+  EXPECT_THROW(tp2.SetWeight(0), std::exception);
+
+  // keep the shared thread busy until the work of both pools is queued
+  std::atomic<bool> release{false};
+  blocker.AddWork([&](int thread_id) {
+    while (!release)
+      std::this_thread::yield();
+  }, 0, true);
+
+  std::mutex order_mutex;
+  std::vector<int> order;
+  auto job = [&](int pool) {
+    return [&, pool](int thread_id) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      std::lock_guard<std::mutex> lock(order_mutex);
+      order.push_back(pool);
+    };
+  };
+  for (int i = 0; i < 16; i++) {
+    tp1.AddWork(job(1));
+    tp2.AddWork(job(2));
+  }
+  tp1.RunAll(false);
+  tp2.RunAll(false);
+  release = true;
+  tp1.WaitForWork();
+  tp2.WaitForWork();
+  blocker.WaitForWork();
+
+  // while both pools have work, the first one gets about 3 times as much thread time
+  ASSERT_EQ(order.size(), 32u);
+  int first_pool_jobs = 0;
+  for (int i = 0; i < 16; i++)
+    first_pool_jobs += order[i] == 1;
+  EXPECT_GE(first_pool_jobs, 10);
+  EXPECT_LE(first_pool_jobs, 14);
+}
+
 }  // namespace test
 
 }  // namespace dali
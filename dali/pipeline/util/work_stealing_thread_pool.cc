@@ -0,0 +1,214 @@
+// Copyright (c) 2021, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+#include <utility>
+#include "dali/pipeline/util/work_stealing_thread_pool.h"
+#include "dali/pipeline/util/thread_affinity.h"
+#if NVML_ENABLED
+#include "dali/util/nvml.h"
+#endif
+#include "dali/core/format.h"
+#include "dali/core/cuda_utils.h"
+#include "dali/core/device_guard.h"
+
+namespace dali {
+
+namespace {
+
+// Identifies the pool (and the worker index within it) that the current thread belongs to,
+// so that work added from within a job can be pushed to the local queue.
+thread_local const WorkStealingThreadPool *tls_pool = nullptr;
+thread_local int tls_thread_idx = -1;
+
+}  // namespace
+
+WorkStealingThreadPool::WorkStealingThreadPool(int num_thread, int device_id, bool set_affinity)
+    : num_threads_(num_thread) {
+  DALI_ENFORCE(num_thread > 0, "Thread pool must have non-zero size");
+#if NVML_ENABLED
+  // only for the CPU pipeline
+  if (device_id != CPU_ONLY_DEVICE_ID) {
+    nvml::Init();
+    // the pinned buffers should be close to the CPUs processing the data
+    if (set_affinity)
+      nvml::SetMemoryAffinity(device_id);
+  }
+#endif
+  queues_.reset(new WorkQueue[num_thread]);
+  tl_errors_.resize(num_thread);
+  threads_.resize(num_thread);
+  // Start the threads in the main loop
+  for (int i = 0; i < num_thread; ++i) {
+    threads_[i] = std::thread(std::bind(&WorkStealingThreadPool::ThreadMain,
+                                        this, i, device_id, set_affinity));
+  }
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+  WaitForWork(false);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  running_ = false;
+  condition_.notify_all();
+  lock.unlock();
+
+  for (auto &thread : threads_) {
+    thread.join();
+  }
+#if NVML_ENABLED
+  nvml::Shutdown();
+#endif
+}
+
+void WorkStealingThreadPool::AddWork(Work work, int64_t priority, bool start_immediately) {
+  int queue_idx = tls_pool == this
+                ? tls_thread_idx
+                : static_cast<int>(next_queue_.fetch_add(1, std::memory_order_relaxed)
+                                   % num_threads_);
+  pending_++;
+  {
+    auto &q = queues_[queue_idx];
+    std::lock_guard<spinlock> lock(q.lock);
+    q.queue.push({priority, std::move(work)});
+    queued_++;
+  }
+  bool started_before = started_;
+  if (start_immediately && !started_before) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    started_ = true;
+  }
+  if (started_)
+    Notify(!started_before);
+}
+
+void WorkStealingThreadPool::Notify(bool all) {
+  if (all) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    condition_.notify_all();
+  } else if (sleeping_ > 0) {
+    // Taking the lock guarantees that a thread which is about to sleep either sees
+    // the new job or is already waiting and receives the notification.
+    { std::lock_guard<std::mutex> lock(mutex_); }
+    condition_.notify_one();
+  }
+}
+
+// Blocks until all work issued to the thread pool is complete
+void WorkStealingThreadPool::WaitForWork(bool checkForErrors) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  completed_.wait(lock, [this] { return pending_ == 0; });
+  started_ = false;
+  lock.unlock();
+  if (checkForErrors) {
+    std::lock_guard<spinlock> err_lock(error_lock_);
+    // Check for errors
+    for (size_t i = 0; i < threads_.size(); ++i) {
+      if (!tl_errors_[i].empty()) {
+        // Throw the first error that occurred
+        string error = make_string("Error in thread ", i, ": ", tl_errors_[i].front());
+        tl_errors_[i].pop();
+        throw std::runtime_error(error);
+      }
+    }
+  }
+}
+
+void WorkStealingThreadPool::RunAll(bool wait) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    started_ = true;
+  }
+  condition_.notify_all();  // other threads will be waken up if needed
+  if (wait) {
+    WaitForWork();
+  }
+}
+
+int WorkStealingThreadPool::NumThreads() const {
+  return num_threads_;
+}
+
+std::vector<std::thread::id> WorkStealingThreadPool::GetThreadIds() const {
+  std::vector<std::thread::id> tids;
+  tids.reserve(threads_.size());
+  for (const auto &thread : threads_)
+    tids.emplace_back(thread.get_id());
+  return tids;
+}
+
+bool WorkStealingThreadPool::TryGetWork(int thread_id, Work &work) {
+  for (int i = 0; i < num_threads_; i++) {
+    // start with own queue, then visit the neighbors
+    auto &q = queues_[(thread_id + i) % num_threads_];
+    std::lock_guard<spinlock> lock(q.lock);
+    if (!q.queue.empty()) {
+      work = std::move(q.queue.top().second);
+      q.queue.pop();
+      queued_--;
+      return true;
+    }
+  }
+  return false;
+}
+
+void WorkStealingThreadPool::PushError(int thread_id, string error) {
+  std::lock_guard<spinlock> lock(error_lock_);
+  tl_errors_[thread_id].push(std::move(error));
+}
+
+void WorkStealingThreadPool::ThreadMain(int thread_id, int device_id, bool set_affinity) {
+  tls_pool = this;
+  tls_thread_idx = thread_id;
+  DeviceGuard g(device_id);
+  try {
+    InitThreadAffinity(make_string("WorkStealingThreadPool worker ", thread_id), device_id,
+                       set_affinity, set_affinity ? AffinityMaskCore(thread_id) : -1);
+  } catch (std::exception &e) {
+    PushError(thread_id, e.what());
+  } catch (...) {
+    PushError(thread_id, "Caught unknown exception");
+  }
+
+  while (running_) {
+    Work work;
+    if (started_ && TryGetWork(thread_id, work)) {
+      // If an error occurs, we save it in tl_errors_. When
+      // WaitForWork is called, we will check for any errors
+      // in the threads and return an error if one occured.
+      try {
+        work(thread_id);
+      } catch (std::exception &e) {
+        PushError(thread_id, e.what());
+      } catch (...) {
+        PushError(thread_id, "Caught unknown exception");
+      }
+      work = {};  // release the resources captured by the job before signaling completion
+
+      if (--pending_ == 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        completed_.notify_all();
+      }
+      continue;
+    }
+
+    // No work found - block on the condition to wait for work
+    std::unique_lock<std::mutex> lock(mutex_);
+    sleeping_++;
+    condition_.wait(lock, [this] { return !running_ || (started_ && queued_ > 0); });
+    sleeping_--;
+  }
+}
+
+}  // namespace dali
@@ -0,0 +1,136 @@
+// Copyright (c) 2021, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_UTIL_WORK_STEALING_THREAD_POOL_H_
+#define DALI_PIPELINE_UTIL_WORK_STEALING_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "dali/core/common.h"
+#include "dali/core/spinlock.h"
+
+namespace dali {
+
+/**
+ * @brief A thread pool with per-thread work queues and work stealing
+ *
+ * Implements the ExecutionEngine concept (see dali/core/exec/engine.h) and follows
+ * the semantics of ThreadPool, but avoids the single global lock on the job queue.
+ *
+ * Each worker owns a priority queue guarded by its own spinlock. Work added from outside
+ * of the pool is distributed among the queues in a round-robin fashion; work added from
+ * within a job goes to the queue of the calling worker. A worker that runs out of work
+ * steals the highest-priority job from the other queues.
+ *
+ * The priority is honored within a queue only - with more than one thread, the jobs are
+ * started in an approximate priority order.
+ *
+ * The mutex is used only for putting idle threads to sleep and for signaling completion,
+ * so it's not touched on the hot path when all workers are busy.
+ */
+class DLL_PUBLIC WorkStealingThreadPool {
+ public:
+  // Basic unit of work that our threads do
+  typedef std::function<void(int)> Work;
+
+  DLL_PUBLIC WorkStealingThreadPool(int num_thread, int device_id, bool set_affinity);
+
+  DLL_PUBLIC ~WorkStealingThreadPool();
+
+  /**
+   * @brief Adds work to the queue with optional priority, and optionally starts processing
+   *
+   * The jobs are queued but the workers don't pick up the work unless they have
+   * already been started by a previous call to AddWork with start_immediately = true or RunAll.
+   * Once work is started, the threads will continue to pick up whatever work is scheduled
+   * until WaitForWork is called.
+   */
+  DLL_PUBLIC void AddWork(Work work, int64_t priority = 0, bool start_immediately = false);
+
+  /**
+   * @brief Wakes up all the threads to complete all the queued work,
+   *        optionally not waiting for the work to be finished before return
+   *        (the default wait=true is equivalent to invoking WaitForWork after RunAll).
+   */
+  DLL_PUBLIC void RunAll(bool wait = true);
+
+  /**
+   * @brief Waits until all work issued to the thread pool is complete
+   */
+  DLL_PUBLIC void WaitForWork(bool checkForErrors = true);
+
+  DLL_PUBLIC int NumThreads() const;
+
+  DLL_PUBLIC std::vector<std::thread::id> GetThreadIds() const;
+
+  DISABLE_COPY_MOVE_ASSIGN(WorkStealingThreadPool);
+
+ private:
+  DLL_PUBLIC void ThreadMain(int thread_id, int device_id, bool set_affinity);
+
+  /**
+   * @brief Takes a job from the queue of `thread_id` or, if it's empty, steals one
+   *        from another thread's queue.
+   */
+  bool TryGetWork(int thread_id, Work &work);
+
+  void Notify(bool all);
+
+  void PushError(int thread_id, string error);
+
+  using PrioritizedWork = std::pair<int64_t, Work>;
+  struct SortByPriority {
+    bool operator() (const PrioritizedWork &a, const PrioritizedWork &b) {
+      return a.first < b.first;
+    }
+  };
+
+  struct WorkQueue {
+    spinlock lock;
+    std::priority_queue<PrioritizedWork, std::vector<PrioritizedWork>, SortByPriority> queue;
+    // keep the queues of different threads in separate cache lines
+    char padding[64];
+  };
+
+  vector<std::thread> threads_;
+  std::unique_ptr<WorkQueue[]> queues_;
+  int num_threads_;
+
+  std::atomic<bool> running_{true};
+  std::atomic<bool> started_{false};
+  std::atomic<int64_t> queued_{0};      // jobs that are waiting in the queues
+  std::atomic<int64_t> pending_{0};     // jobs that are either queued or being executed
+  std::atomic<int> sleeping_{0};        // threads waiting (or about to wait) on condition_
+  std::atomic<unsigned> next_queue_{0};
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::condition_variable completed_;
+
+  //  Stored error strings for each thread
+  spinlock error_lock_;
+  vector<std::queue<string>> tl_errors_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_UTIL_WORK_STEALING_THREAD_POOL_H_
@@ -29,6 +29,7 @@
 #include "dali/util/nvml.h"
 #endif
 #include "dali/core/device_guard.h"
+#include "dali/pipeline/util/thread_affinity.h"
 
 namespace dali {
 
@@ -66,7 +67,10 @@ class WorkerThread {
  public:
   typedef std::function<void(void)> Work;
 
-  inline WorkerThread(int device_id, bool set_affinity) :
+  /**
+   * @param name  name of the thread, see GetThreadAffinityReport
+   */
+  inline WorkerThread(int device_id, bool set_affinity, std::string name = "WorkerThread") :
     running_(true), work_complete_(true), barrier_(2) {
 #if NVML_ENABLED
     if (device_id != CPU_ONLY_DEVICE_ID) {
@@ -74,7 +78,7 @@ class WorkerThread {
     }
 #endif
     thread_ = std::thread(&WorkerThread::ThreadMain,
-        this, device_id, set_affinity);
+        this, device_id, set_affinity, std::move(name));
   }
 
   inline ~WorkerThread() {
@@ -160,14 +164,10 @@ class WorkerThread {
   }
 
  private:
-  void ThreadMain(int device_id, bool set_affinity) {
+  void ThreadMain(int device_id, bool set_affinity, const std::string &name) {
     DeviceGuard g(device_id);
     try {
-      if (set_affinity) {
-#if NVML_ENABLED
-        nvml::SetCPUAffinity();
-#endif
-      }
+      InitThreadAffinity(name, device_id, set_affinity);
     } catch (std::exception &e) {
       errors_.push(e.what());
       std::lock_guard<std::mutex> lock(mutex_);
@@ -22,6 +22,7 @@
 #include <unordered_map>
 
 #include "dali/core/common.h"
+#include "dali/core/mm/polymorphic_allocator.h"
 #include "dali/pipeline/data/backend.h"
 #include "dali/pipeline/data/tensor.h"
 #include "dali/pipeline/data/tensor_vector.h"
@@ -49,6 +50,7 @@ class ArgumentWorkspace {
 
   inline void Clear() {
     argument_inputs_.clear();
+    gpu_argument_inputs_.clear();
   }
 
   void AddArgumentInput(const std::string &arg_name, shared_ptr<TensorVector<CPUBackend>> input) {
@@ -62,8 +64,31 @@ class ArgumentWorkspace {
     };
   }
 
+  void AddArgumentInput(const std::string &arg_name, shared_ptr<TensorList<GPUBackend>> input) {
+    gpu_argument_inputs_[arg_name] = std::move(input);
+  }
+
+  /**
+   * @brief Checks if the argument input is located in GPU memory.
+   *
+   * Only GPU operators, for the arguments allowed by the schema, can receive such inputs.
+   */
+  bool ArgumentInputIsGPU(const std::string &arg_name) const {
+    return gpu_argument_inputs_.count(arg_name) > 0;
+  }
+
+  const TensorList<GPUBackend>& GPUArgumentInput(const std::string &arg_name) const {
+    auto it = gpu_argument_inputs_.find(arg_name);
+    DALI_ENFORCE(it != gpu_argument_inputs_.end(),
+                 "GPU argument \"" + arg_name + "\" not found.");
+    return *it->second;
+  }
+
   const TensorVector<CPUBackend>& ArgumentInput(const std::string &arg_name) const {
     auto it = argument_inputs_.find(arg_name);
+    DALI_ENFORCE(it != argument_inputs_.end() || !ArgumentInputIsGPU(arg_name),
+                 "Argument \"" + arg_name + "\" is located in GPU memory and cannot be accessed "
+                 "on the host.");
     DALI_ENFORCE(it != argument_inputs_.end(), "Argument \"" + arg_name + "\" not found.");
     if (it->second.should_update) {
       // the underlying tensor list might have changed - update the views
@@ -85,6 +110,7 @@ class ArgumentWorkspace {
   // Argument inputs
   using argument_input_storage_t = std::unordered_map<std::string, ArgumentInputDesc>;
   argument_input_storage_t argument_inputs_;
+  std::unordered_map<std::string, shared_ptr<TensorList<GPUBackend>>> gpu_argument_inputs_;
 
  public:
   using const_iterator = argument_input_storage_t::const_iterator;
@@ -139,6 +165,7 @@ class WorkspaceBase : public ArgumentWorkspace {
     gpu_inputs_index_.clear();
     cpu_outputs_index_.clear();
     gpu_outputs_index_.clear();
+    host_scratch_ = nullptr;
   }
 
   template <typename Backend>
@@ -392,6 +419,38 @@ class WorkspaceBase : public ArgumentWorkspace {
     return gpu_outputs_[tensor_meta.index];
   }
 
+  /**
+   * @brief Returns a memory resource for the host-side metadata of the current iteration.
+   *
+   * When the operator is run by the executor, this is an arena which is reset after the
+   * operator's Run - the memory doesn't need to be freed, but it can't be kept between
+   * iterations either. Otherwise, the memory is allocated on the heap.
+   *
+   * The resource is not thread-safe - it can be used only by the thread which calls
+   * Setup and Run (e.g. not in the tasks submitted to the thread pool).
+   */
+  mm::host_memory_resource &HostScratch() const {
+    return host_scratch_ ? *host_scratch_ : mm::malloc_memory_resource::instance();
+  }
+
+  /**
+   * @brief Returns an allocator for the containers with the host-side metadata of
+   *        the current iteration.
+   *
+   * @see HostScratch
+   */
+  template <typename T = char>
+  mm::polymorphic_allocator<T> HostScratchAllocator() const {
+    return &HostScratch();
+  }
+
+  /**
+   * @brief Sets the resource returned by HostScratch; nullptr restores the default one.
+   */
+  void SetHostScratch(mm::host_memory_resource *scratch) {
+    host_scratch_ = scratch;
+  }
+
   /**
  * @brief Returns the index of the sample that this workspace stores
  * in the input/output batch.
@@ -542,6 +601,8 @@ class WorkspaceBase : public ArgumentWorkspace {
   // that tensor in the {cpu, gpu}_inputs_ vector.
   vector<InOutMeta> input_index_map_, output_index_map_;
 
+  mm::host_memory_resource *host_scratch_ = nullptr;
+
  private:
   inline const InOutMeta& FetchAtIndex(const vector<InOutMeta>& index_map, int idx) const {
     DALI_ENFORCE(idx >= 0 && idx < (int) index_map.size(),
@@ -15,6 +15,9 @@
 #include <cuda_runtime_api.h>
 #include "dali/core/cuda_utils.h"
 #include "dali/core/device_guard.h"
+#include "dali/core/mm/default_resources.h"
+#include "dali/core/mm/pool_stats.h"
+#include "dali/core/nvtx.h"
 #if SHM_WRAPPER_ENABLED
 #include "dali/core/os/shared_mem.h"
 #endif
@@ -30,6 +33,7 @@
 #include "dali/pipeline/operator/op_spec.h"
 #include "dali/pipeline/operator/operator.h"
 #include "dali/pipeline/pipeline.h"
+#include "dali/pipeline/util/thread_affinity.h"
 #include "dali/plugin/plugin_manager.h"
 #include "dali/python/python3_compat.h"
 #include "dali/util/half.hpp"
@@ -64,6 +68,30 @@ static void* ctypes_void_ptr(const py::object& object) {
   return ptr;
 }
 
+/**
+ * @brief Converts a ctypes.c_void_p (or None) holding an event handle to cudaEvent_t
+ */
+static cudaEvent_t RawCudaEvent(const py::object &event) {
+  return event.is_none() ? nullptr : static_cast<cudaEvent_t>(ctypes_void_ptr(event));
+}
+
+/**
+ * @brief Converts the `stream` argument of `__dlpack__` to a CUDA stream handle
+ *
+ * See https://data-apis.org/array-api/latest/API_specification/array_object.html#dlpack-self-stream-none
+ */
+static cudaStream_t DLPackConsumerStream(const py::object &stream) {
+  if (stream.is_none())
+    return cudaStreamLegacy;
+  int64_t handle = stream.cast<int64_t>();
+  // -1 means that no synchronization is needed, 0 is ambiguous and not allowed
+  if (handle == 1 || handle == 0 || handle == -1)
+    return cudaStreamLegacy;
+  if (handle == 2)
+    return cudaStreamPerThread;
+  return reinterpret_cast<cudaStream_t>(handle);
+}
+
 TensorShape<> shape_from_py(py::tuple tup) {
   TensorShape<> shape;
   shape.resize(tup.size());
@@ -565,6 +593,29 @@ std::unique_ptr<Tensor<Backend> > TensorListGetItemImpl(TensorList<Backend> &t,
   return ptr;
 }
 
+/**
+ * @brief Returns the samples of the TensorList as NumPy arrays sharing its memory
+ *
+ * The memory is obtained with ShareTensorListData, so the arrays stay valid, and unchanged,
+ * until the last of them is deleted.
+ */
+static py::list TensorListToArrays(TensorList<CPUBackend> &tl) {
+  py::list result;
+  if (tl.ntensor() == 0)
+    return result;
+  DALI_ENFORCE(IsValidType(tl.type()), "Cannot produce buffer info for tensor w/ invalid type.");
+  auto *data = new shared_ptr<void>(ShareTensorListData(tl));
+  py::capsule owner(data, [](void *p) { delete static_cast<shared_ptr<void> *>(p); });
+  py::dtype dtype(FormatStrFromType(tl.type()));
+  for (size_t i = 0; i < tl.ntensor(); i++) {
+    auto sample_shape = tl.tensor_shape(i);
+    std::vector<ssize_t> shape(sample_shape.begin(), sample_shape.end());
+    auto *ptr = static_cast<uint8_t *>(data->get()) + tl.tensor_offset(i) * tl.type_info().size();
+    result.append(py::array(dtype, shape, ptr, owner));
+  }
+  return result;
+}
+
 #if 0  // TODO(spanev): figure out which return_value_policy to choose
 template <typename Backend>
 py::tuple TensorListGetItemSliceImpl(TensorList<Backend> &t, py::slice slice) {
@@ -752,6 +803,15 @@ void ExposeTensorList(py::module &m) {
       R"code(
       Returns TensorList as a numpy array. TensorList must be dense.
 
+      )code")
+    .def("as_arrays", &TensorListToArrays,
+      R"code(
+      Returns the samples of the TensorList as a list of numpy arrays. The samples can have
+      different shapes.
+
+      The data is not copied - the arrays take over the memory of the TensorList, the same way
+      as ``__dlpack__`` does, and keep it alive for as long as any of them exists.
+      If the TensorList doesn't own its memory, the data is copied once for all the samples.
       )code")
     .def("__len__", [](TensorList<CPUBackend> &tl) {
           return tl.ntensor();
@@ -802,6 +862,45 @@ void ExposeTensorList(py::module &m) {
         },
       R"code(
       Returns the address of the first element of TensorList.
+      )code")
+    .def("__dlpack__",
+        [](TensorList<CPUBackend> &tl, py::object stream) {
+          return TensorListToDLPack(tl, 0);
+        },
+      "stream"_a = py::none(),
+      R"code(
+      Exports the TensorList as a single DLPack tensor of shape ``(batch_size, ...)``.
+
+      The exported tensor takes over the memory of the TensorList - the data is not copied
+      and, if the TensorList is an output of a pipeline, the pipeline writes the subsequent
+      iterations to a new buffer, so the tensor stays valid after the outputs are released.
+      If the TensorList doesn't own its memory, the data is copied.
+
+      This function can only be called if `is_dense_tensor` returns `True`.
+
+      stream : int, optional
+            Ignored for the data in the host memory.
+      )code")
+    .def("dlpack_samples",
+        [](TensorList<CPUBackend> &tl, py::object stream) {
+          return TensorListToDLPackSamples(tl, 0);
+        },
+      "stream"_a = py::none(),
+      R"code(
+      Exports the samples of the TensorList as a list of DLPack tensors. The samples can have
+      different shapes.
+
+      The memory is handed out as in ``__dlpack__`` and each of the tensors keeps it alive.
+
+      stream : int, optional
+            Ignored for the data in the host memory.
+      )code")
+    .def("__dlpack_device__",
+        [](TensorList<CPUBackend> &tl) {
+          return py::make_tuple(static_cast<int>(kDLCPU), 0);
+        },
+      R"code(
+      Returns the DLPack device type and id of the data.
       )code");
 
   py::class_<TensorList<GPUBackend>, std::shared_ptr<TensorList<GPUBackend>>>(
@@ -975,6 +1074,64 @@ void ExposeTensorList(py::module &m) {
         },
       R"code(
       Returns the address of the first element of TensorList.
+      )code")
+    .def("__dlpack__",
+        [](TensorList<GPUBackend> &tl, py::object stream) {
+          DeviceGuard g(tl.device_id());
+          cudaStream_t consumer_stream = DLPackConsumerStream(stream);
+          bool copy = tl.shares_data();
+          auto capsule = TensorListToDLPack(tl, consumer_stream);
+          // the source of the copy can be overwritten as soon as the outputs are released
+          if (copy)
+            CUDA_CALL(cudaStreamSynchronize(consumer_stream));
+          return capsule;
+        },
+      "stream"_a = py::none(),
+      R"code(
+      Exports the TensorList as a single DLPack tensor of shape ``(batch_size, ...)``.
+
+      The exported tensor takes over the memory of the TensorList - the data is not copied
+      and, if the TensorList is an output of a pipeline, the pipeline writes the subsequent
+      iterations to a new buffer, so the tensor stays valid after the outputs are released.
+      The memory is returned to DALI when the consumer deletes the tensor.
+      If the TensorList doesn't own its memory, the data is copied in `stream`.
+
+      The data of the outputs returned by ``Pipeline.share_outputs`` is ready to use in any
+      stream; with ``Pipeline.share_outputs_async``, `stream` must wait for the returned event
+      before accessing the data.
+
+      This function can only be called if `is_dense_tensor` returns `True`.
+
+      stream : int, optional
+            The consumer's CUDA stream, as defined by the DLPack protocol.
+      )code")
+    .def("dlpack_samples",
+        [](TensorList<GPUBackend> &tl, py::object stream) {
+          DeviceGuard g(tl.device_id());
+          cudaStream_t consumer_stream = DLPackConsumerStream(stream);
+          bool copy = tl.shares_data();
+          auto capsules = TensorListToDLPackSamples(tl, consumer_stream);
+          if (copy)
+            CUDA_CALL(cudaStreamSynchronize(consumer_stream));
+          return capsules;
+        },
+      "stream"_a = py::none(),
+      R"code(
+      Exports the samples of the TensorList as a list of DLPack tensors. The samples can have
+      different shapes.
+
+      The memory is handed out as in ``__dlpack__``, with the same rules for `stream`, and each
+      of the tensors keeps it alive.
+
+      stream : int, optional
+            The consumer's CUDA stream, as defined by the DLPack protocol.
+      )code")
+    .def("__dlpack_device__",
+        [](TensorList<GPUBackend> &tl) {
+          return py::make_tuple(static_cast<int>(kDLCUDA), tl.device_id());
+        },
+      R"code(
+      Returns the DLPack device type and id of the data.
       )code");
 }
 
@@ -1071,9 +1228,154 @@ void ExposeBufferPolicyFunctions(py::module &m) {
     Buffer<GPUBackend>::SetGrowthFactor(factor);
   });
 
+  m.def("SetDeviceBufferVirtualReservation", [](int64_t bytes) {
+    if (bytes < 0)
+      throw py::value_error("The size of the virtual address range cannot be negative.");
+
+    Buffer<GPUBackend>::SetVirtualReservation(bytes);
+  });
+
   m.def("GetHostBufferShrinkThreshold", Buffer<CPUBackend>::GetShrinkThreshold);
   m.def("GetHostBufferGrowthFactor", Buffer<CPUBackend>::GetGrowthFactor);
   m.def("GetDeviceBufferGrowthFactor", Buffer<GPUBackend>::GetGrowthFactor);
+  m.def("GetDeviceBufferVirtualReservation", Buffer<GPUBackend>::GetVirtualReservation);
+}
+
+template <typename Resource>
+py::object PoolStatsToDict(const Resource *resource) {
+  mm::pool_stats stats;
+  if (!mm::get_pool_stats(resource, stats))
+    return py::none();
+  py::dict d;
+  d["reserved"] = stats.reserved;
+  d["in_use"] = stats.in_use;
+  d["peak_in_use"] = stats.peak_in_use;
+  d["pending_free"] = stats.pending_free;
+  d["num_pending_frees"] = stats.num_pending_frees;
+  d["largest_free_block"] = stats.largest_free_block;
+  d["cross_stream_reclaims"] = stats.cross_stream_reclaims;
+  d["pending_free_syncs"] = stats.pending_free_syncs;
+  return d;
+}
+
+void ExposeMemoryStatsFunctions(py::module &m) {
+  m.def("GetDeviceMemoryStats", [](int device_id) {
+    return PoolStatsToDict(mm::GetDefaultDeviceResource(device_id));
+  }, "device_id"_a = -1, R"code(
+Returns the statistics of the default device memory pool as a dictionary with the following keys:
+
+* ``reserved`` - memory obtained from the CUDA driver,
+* ``in_use`` - memory currently allocated,
+* ``peak_in_use`` - the maximum of ``in_use`` since the start or the last call to
+  :meth:`ResetDeviceMemoryPeak`,
+* ``pending_free`` and ``num_pending_frees`` - memory freed in stream order, not yet available
+  to other streams,
+* ``largest_free_block`` - the largest allocation possible without reserving more memory,
+* ``cross_stream_reclaims`` - number of blocks freed on one stream and returned to the pool
+  shared by all streams,
+* ``pending_free_syncs`` - number of times an allocation waited for the pending frees.
+
+Returns ``None`` if the memory pool is disabled.
+
+`device_id` : int, optional, default = -1
+    Index of the device; the current device is used if negative.
+)code");
+
+  m.def("GetPinnedMemoryStats", []() {
+    return PoolStatsToDict(mm::GetDefaultResource<mm::memory_kind::pinned>());
+  }, R"code(
+Returns the statistics of the default pinned host memory pool.
+
+See :meth:`GetDeviceMemoryStats` for the description of the statistics.
+)code");
+
+  m.def("ResetDeviceMemoryPeak", [](int device_id) {
+    mm::reset_pool_peak(mm::GetDefaultDeviceResource(device_id));
+  }, "device_id"_a = -1, "Resets the peak memory usage of the default device memory pool.");
+
+  m.def("ResetPinnedMemoryPeak", []() {
+    mm::reset_pool_peak(mm::GetDefaultResource<mm::memory_kind::pinned>());
+  }, "Resets the peak memory usage of the default pinned host memory pool.");
+
+  m.def("ReleaseUnusedMemory", &mm::ReleaseUnusedMemory,
+        "release_caches"_a = false, py::call_guard<py::gil_scoped_release>(), R"code(
+Returns the memory kept, but not used, by the device memory pools of all devices and by
+the pinned host memory pool to the CUDA driver. It can be called when another library
+running in the same process, e.g. a deep learning framework, fails to allocate memory.
+
+`release_caches` : bool, optional, default = False
+    If True, the memory of the decoded image caches is freed as well, if no image
+    is currently in use.
+
+Returns the number of bytes released.
+)code");
+}
+
+void ExposeTracingFunctions(py::module &m) {
+  m.def("SetTraceCategories", [](const std::string &categories) {
+    SetTraceCategories(ParseTraceCategories(categories));
+  }, "categories"_a, R"code(
+Selects the categories of the trace ranges recorded with NVTX and in the Chrome trace.
+
+`categories` : str
+    Comma-separated list of the categories: ``executor`` (iterations and stages),
+    ``operator``, ``loader`` (reader prefetching and sample reads), ``thread_pool``,
+    ``other`` or ``all``. An empty string disables the tracing.
+)code");
+
+  m.def("StartChromeTrace", [](const std::string &categories) {
+    StartChromeTrace(ParseTraceCategories(categories));
+  }, "categories"_a = "all", R"code(
+Starts collecting the trace ranges in memory, to be saved in the Chrome trace format
+(``chrome://tracing`` or Perfetto) with :meth:`StopChromeTrace`. It doesn't require a profiler.
+
+`categories` : str, optional, default = "all"
+    The categories to collect, see :meth:`SetTraceCategories`.
+)code");
+
+  m.def("StopChromeTrace", &StopChromeTrace, "filename"_a,
+        py::call_guard<py::gil_scoped_release>(), R"code(
+Stops the collection started with :meth:`StartChromeTrace` and writes the trace to a file.
+)code");
+}
+
+void ExposeThreadAffinityFunctions(py::module &m) {
+  m.def("SetAffinityPolicy", [](const std::string &policy) {
+    SetAffinityPolicy(ParseAffinityPolicy(policy));
+  }, "policy"_a, R"code(
+Selects how the threads of the pipelines created with ``set_affinity=True`` are placed
+on the CPU cores. It applies to the threads started afterwards. The default can be set with
+the ``DALI_AFFINITY_POLICY`` environment variable.
+
+`policy` : str
+    ``none`` - the threads are not pinned,
+    ``socket`` (default) - each thread can run on any of the cores close to the GPU,
+    ``core`` - each thread is pinned to a single core close to the GPU, assigned in turn.
+)code");
+
+  m.def("GetAffinityPolicy", []() {
+    return std::string(AffinityPolicyName(GetAffinityPolicy()));
+  }, R"code(
+Returns the current thread affinity policy, see :meth:`SetAffinityPolicy`.
+)code");
+
+  m.def("GetThreadAffinity", []() {
+    py::list ret;
+    for (auto &info : GetThreadAffinityReport()) {
+      py::dict d;
+      d["name"] = info.name;
+      d["device_id"] = info.device_id;
+      d["tid"] = info.tid;
+      d["cpus"] = info.cpus;
+      ret.append(d);
+    }
+    return ret;
+  }, R"code(
+Lists the running threads created by DALI, with the CPU cores each of them can run on.
+
+Returns a list of dictionaries with the keys ``name``, ``device_id``, ``tid`` (the id of the
+thread in the operating system) and ``cpus``.
+)code");
 }
 
 py::dict DeprecatedArgMetaToDict(const DeprecatedArgDef & meta) {
@@ -1095,24 +1397,89 @@ py::dict ReaderMetaToDict(const ReaderMeta &meta) {
   return d;
 }
 
-py::dict ExecutorMetaToDict(const ExecutorMetaMap &meta) {
+py::dict PipelineHealthToDict(const PipelineHealth &health) {
   py::dict d;
+  d["uptime"] = health.uptime;
+  py::dict stages;
+  const std::pair<OpType, const char *> stage_names[] = {
+    { OpType::CPU, "cpu" }, { OpType::MIXED, "mixed" }, { OpType::GPU, "gpu" }
+  };
+  for (auto &stage_name : stage_names) {
+    auto &stage = health.stage(stage_name.first);
+    py::dict stage_dict;
+    stage_dict["iterations"] = stage.iterations;
+    stage_dict["wait_time"] = stage.wait_time;
+    stage_dict["stalls"] = stage.stalls;
+    stage_dict["queue_occupancy"] = stage.output_queue.occupancy;
+    stage_dict["queue_capacity"] = stage.output_queue.capacity;
+    stage_dict["queue_mean_occupancy"] = stage.output_queue.mean_occupancy;
+    stages[stage_name.second] = stage_dict;
+  }
+  d["stages"] = stages;
+  d["outputs"] = health.outputs;
+  d["consumer_wait_time"] = health.consumer_wait_time;
+  d["consumer_starved"] = health.consumer_starved;
+  py::dict readers;
+  for (auto &reader : health.readers) {
+    py::dict reader_dict;
+    reader_dict["prefetch_queue_depth"] = reader.prefetch_queue_depth;
+    reader_dict["prefetch_queue_fill"] = reader.prefetch_queue_fill;
+    reader_dict["starved"] = reader.starved;
+    reader_dict["wait_time"] = reader.wait_time;
+    readers[reader.name.c_str()] = reader_dict;
+  }
+  d["readers"] = readers;
+  d["thread_pool_threads"] = health.thread_pool_threads;
+  d["thread_pool_busy_time"] = health.thread_pool_busy_time;
+  d["thread_pool_busy_fraction"] = health.thread_pool_busy_fraction();
+  d["bottleneck"] = health.Bottleneck();
+  return d;
+}
+
+py::dict ExecutorMetaToDict(ExecutorMetaMap meta, const ExecutorTimingMetaMap &timing_meta) {
+  py::dict d;
+  // the entries that have only the timing statistics (e.g. stages) are reported without outputs
+  for (const auto &timing : timing_meta) {
+    meta.emplace(timing.first, std::vector<ExecutorMeta>{});
+  }
   for (const auto &stat : meta) {
     py::dict op_dict;
     py::list real_memory_size;
     py::list reserved_memory_size;
     py::list max_real_memory_size;
     py::list max_reserved_memory_size;
+    py::list sample_size_hint;
     for (const auto &entry : stat.second) {
       real_memory_size.append(entry.real_size);
       max_real_memory_size.append(entry.max_real_size);
       reserved_memory_size.append(entry.reserved);
       max_reserved_memory_size.append(entry.max_reserved);
+      sample_size_hint.append(entry.sample_size_hint);
     }
     op_dict["real_memory_size"] = real_memory_size;
     op_dict["max_real_memory_size"] = max_real_memory_size;
     op_dict["reserved_memory_size"] = reserved_memory_size;
     op_dict["max_reserved_memory_size"] = max_reserved_memory_size;
+    op_dict["sample_size_hint"] = sample_size_hint;
+    auto timing_it = timing_meta.find(stat.first);
+    if (timing_it != timing_meta.end()) {
+      const auto &timing = timing_it->second;
+      op_dict["iterations"] = timing.iterations;
+      op_dict["samples"] = timing.samples;
+      op_dict["total_time"] = timing.total_time;
+      op_dict["max_time"] = timing.max_time;
+      op_dict["gpu_iterations"] = timing.gpu_iterations;
+      op_dict["gpu_time"] = timing.gpu_time;
+      op_dict["wait_time"] = timing.wait_time;
+      op_dict["samples_per_second"] =
+          timing.total_time > 0 ? timing.samples / timing.total_time : 0.0;
+      if (!timing.diagnostics.empty()) {
+        py::dict diagnostics;
+        for (const auto &diag : timing.diagnostics)
+          diagnostics[diag.first.c_str()] = diag.second;
+        op_dict["diagnostics"] = diagnostics;
+      }
+    }
     d[stat.first.c_str()] = op_dict;
   }
   return d;
@@ -1120,15 +1487,90 @@ py::dict ExecutorMetaToDict(const ExecutorMetaMap &meta) {
 
 template <typename Backend>
 void FeedPipeline(Pipeline *p, const string &name, py::list list, cudaStream_t stream,
-                  bool sync = false, bool use_copy_kernel = false) {
+                  bool sync = false, bool use_copy_kernel = false,
+                  cudaEvent_t done_event = nullptr) {
   TensorVector<Backend> tv(list.size());
   for (size_t i = 0; i < list.size(); ++i) {
     auto &t = list[i].cast<Tensor<Backend>&>();
     tv[i] = std::move(t);
   }
-  p->SetExternalInput(name, tv, stream, sync, use_copy_kernel);
+  p->SetExternalInput(name, tv, stream, sync, use_copy_kernel, ExtSrcNoCopyMode::DEFAULT,
+                      done_event);
 }
 
+#if SHM_WRAPPER_ENABLED
+
+/**
+ * @brief Reads the batch description written by the parallel external source workers
+ *        (see `_multiproc/shared_batch.py`) and returns the samples as numpy arrays
+ *        that view the shared memory directly.
+ *
+ * The description is a sequence of int64 values:
+ * num_samples, then for each sample:
+ *   idx, kind (0 - array, 1 - tuple, 2 - list), num_arrays,
+ *   then for each array: offset, nbytes, dtype char, ndim, shape[ndim]
+ *
+ * @return list of (idx, sample) pairs, where the sample is an array or a tuple/list of arrays
+ */
+py::list DeserializeSharedBatch(py::object shm_obj, uint64_t meta_offset, uint64_t meta_size) {
+  auto &shm = shm_obj.cast<SharedMem &>();
+  uint8_t *base = shm.get_raw_ptr();
+  DALI_ENFORCE(base != nullptr, "Cannot deserialize the batch - no memory has been mapped.");
+  DALI_ENFORCE(meta_offset + meta_size <= shm.size() && meta_offset % sizeof(int64_t) == 0 &&
+               meta_size % sizeof(int64_t) == 0,
+               make_string("Invalid batch description range: [", meta_offset, ", ",
+                           meta_offset + meta_size, ") in a chunk of ", shm.size(), " bytes."));
+  const int64_t *meta = reinterpret_cast<const int64_t *>(base + meta_offset);
+  const int64_t *meta_end = meta + meta_size / sizeof(int64_t);
+  auto next = [&]() {
+    DALI_ENFORCE(meta < meta_end, "Truncated batch description.");
+    return *meta++;
+  };
+
+  std::map<int64_t, py::dtype> dtypes;
+  auto read_array = [&]() {
+    int64_t offset = next();
+    int64_t nbytes = next();
+    int64_t type_char = next();
+    int ndim = next();
+    DALI_ENFORCE(ndim >= 0 && meta + ndim <= meta_end, "Truncated batch description.");
+    std::vector<ssize_t> shape(meta, meta + ndim);
+    meta += ndim;
+    DALI_ENFORCE(offset >= 0 && nbytes >= 0 && static_cast<uint64_t>(offset + nbytes) <= shm.size(),
+                 make_string("Sample data range [", offset, ", ", offset + nbytes,
+                             ") exceeds the chunk of ", shm.size(), " bytes."));
+    auto it = dtypes.find(type_char);
+    if (it == dtypes.end())
+      it = dtypes.emplace(type_char, py::dtype(std::string(1, static_cast<char>(type_char)))).first;
+    DALI_ENFORCE(volume(shape) * it->second.itemsize() == nbytes,
+                 "The sample size doesn't match its shape and type.");
+    return py::array(it->second, shape, base + offset, shm_obj);
+  };
+
+  int64_t num_samples = next();
+  py::list samples;
+  for (int64_t i = 0; i < num_samples; i++) {
+    int64_t idx = next();
+    int64_t kind = next();
+    int64_t num_arrays = next();
+    py::object sample;
+    if (kind == 0) {
+      DALI_ENFORCE(num_arrays == 1, "A sample stored as a single array must have one part.");
+      sample = read_array();
+    } else {
+      DALI_ENFORCE(kind == 1 || kind == 2, make_string("Unknown sample kind: ", kind));
+      py::tuple parts(num_arrays);
+      for (int64_t j = 0; j < num_arrays; j++)
+        parts[j] = read_array();
+      sample = kind == 1 ? py::object(parts) : py::object(py::list(parts));
+    }
+    samples.append(py::make_tuple(idx, sample));
+  }
+  return samples;
+}
+
+#endif
+
 PYBIND11_MODULE(backend_impl, m) {
   dali::InitOperatorsLib();
   m.doc() = "Python bindings for the C++ portions of DALI";
@@ -1137,6 +1579,9 @@ PYBIND11_MODULE(backend_impl, m) {
   m.def("Init", &DALIInit);
 
   ExposeBufferPolicyFunctions(m);
+  ExposeMemoryStatsFunctions(m);
+  ExposeTracingFunctions(m);
+  ExposeThreadAffinityFunctions(m);
 
   m.def("LoadLibrary", &PluginManager::LoadLibrary);
 
@@ -1169,7 +1614,15 @@ PYBIND11_MODULE(backend_impl, m) {
              return py::memoryview::from_buffer(ptr, {shm->size()}, {sizeof(uint8_t)});
            })
       .def("resize", &SharedMem::resize)
-      .def("close", &SharedMem::close);
+      .def("close", &SharedMem::close)
+      .def("pin", &SharedMem::pin)
+      .def("unpin", &SharedMem::unpin)
+      .def_property_readonly("is_pinned", &SharedMem::is_pinned);
+
+  m.def("DeserializeSharedBatch", &DeserializeSharedBatch,
+        "Returns the list of (idx, sample) described at the given range of the shared memory "
+        "chunk; the samples are numpy arrays viewing the chunk.",
+        "shm"_a, "meta_offset"_a, "meta_size"_a);
 
 #endif
 
@@ -1210,6 +1663,7 @@ PYBIND11_MODULE(backend_impl, m) {
     .value("PYTHON_OBJECT", DALI_PYTHON_OBJECT)
     .value("_TENSOR_LAYOUT_VEC", DALI_TENSOR_LAYOUT_VEC)
     .value("_DATA_TYPE_VEC", DALI_DATA_TYPE_VEC)
+    .value("BFLOAT16",      DALI_BFLOAT16)
     .export_values();
 
   // DALIImageType
@@ -1219,6 +1673,7 @@ PYBIND11_MODULE(backend_impl, m) {
     .value("GRAY", DALI_GRAY)
     .value("YCbCr", DALI_YCbCr)
     .value("ANY_DATA", DALI_ANY_DATA)
+    .value("YUV420", DALI_YUV420)
     .export_values();
 
   // DALIInterpType
@@ -1320,21 +1775,95 @@ PYBIND11_MODULE(backend_impl, m) {
           p->EnableExecutorMemoryStats(enable_memory_stats);
         },
         "enable_memory_stats"_a = true)
+    .def("EnableExecutorTimingStats",
+        [](Pipeline *p, bool enable_timing_stats) {
+          p->EnableExecutorTimingStats(enable_timing_stats);
+        },
+        "enable_timing_stats"_a = true)
+    .def("EnableOperatorFusion",
+        [](Pipeline *p, bool enable_op_fusion) {
+          p->EnableOperatorFusion(enable_op_fusion);
+        },
+        "enable_op_fusion"_a = true)
+    .def("EnableCudaGraphs",
+        [](Pipeline *p, bool enable_cuda_graphs) {
+          p->EnableCudaGraphs(enable_cuda_graphs);
+        },
+        "enable_cuda_graphs"_a = true)
+    .def("EnableCPUDataflow",
+        [](Pipeline *p, bool enable_cpu_dataflow) {
+          p->EnableCPUDataflow(enable_cpu_dataflow);
+        },
+        "enable_cpu_dataflow"_a = true)
+    .def("EnableCPUDepthFirst",
+        [](Pipeline *p, bool enable_cpu_depth_first) {
+          p->EnableCPUDepthFirst(enable_cpu_depth_first);
+        },
+        "enable_cpu_depth_first"_a = true)
+    .def("EnableConcurrentCPUIterations",
+        [](Pipeline *p, bool enable) {
+          p->EnableConcurrentCPUIterations(enable);
+        },
+        "enable"_a = true)
+    .def("EnableMemoryReuse",
+        [](Pipeline *p, bool enable) {
+          p->EnableMemoryReuse(enable);
+        },
+        "enable"_a = true)
+    .def("EnableEarlyGPUSetup",
+        [](Pipeline *p, bool enable) {
+          p->EnableEarlyGPUSetup(enable);
+        },
+        "enable"_a = true)
+    .def("EnableSharedScratch",
+        [](Pipeline *p, bool enable) {
+          p->EnableSharedScratch(enable);
+        },
+        "enable"_a = true)
+    .def("EnableLowLatency",
+        [](Pipeline *p, bool enable) {
+          p->EnableLowLatency(enable);
+        },
+        "enable"_a = true)
+    .def("EnableSharedThreadPool",
+        [](Pipeline *p, bool share_thread_pool) {
+          p->EnableSharedThreadPool(share_thread_pool);
+        },
+        "share_thread_pool"_a = true)
+    .def("SetThreadPoolWeight",
+        [](Pipeline *p, double weight) {
+          p->SetThreadPoolWeight(weight);
+        },
+        "weight"_a)
     .def("executor_statistics",
         [](Pipeline *p) {
-          auto ret = p->GetExecutorMeta();
-          return ExecutorMetaToDict(ret);
+          return ExecutorMetaToDict(p->GetExecutorMeta(), p->GetExecutorTimingMeta());
         })
+    .def("health_metrics",
+        [](Pipeline *p) {
+          return PipelineHealthToDict(p->GetHealth());
+        })
+    .def("health_metrics_prometheus",
+        [](Pipeline *p, const std::string &labels) {
+          return FormatPrometheus(p->GetHealth(), labels);
+        },
+        "labels"_a = "")
     .def("SetQueueSizes",
         [](Pipeline *p, int cpu_size, int gpu_size) {
           p->SetQueueSizes(cpu_size, gpu_size);
         })
+    .def("SetAdaptiveQueueSizes",
+        [](Pipeline *p, int min_cpu_size, int min_gpu_size) {
+          p->SetAdaptiveQueueSizes(min_cpu_size, min_gpu_size);
+        })
     .def("SetOutputNames",
         [](Pipeline *p, const std::vector<std::pair<string, string>>& outputs) {
           p->SetOutputNames(outputs);
           })
     .def("RunCPU", &Pipeline::RunCPU, py::call_guard<py::gil_scoped_release>())
     .def("RunGPU", &Pipeline::RunGPU)
+    .def("Warmup", &Pipeline::Warmup, "iterations"_a = 1,
+         py::call_guard<py::gil_scoped_release>())
     .def("Outputs",
         [](Pipeline *p) {
           DeviceWorkspace ws;
@@ -1365,37 +1894,71 @@ PYBIND11_MODULE(backend_impl, m) {
           }
           return outs;
         }, py::return_value_policy::take_ownership)
-    .def("ReleaseOutputs",
+    .def("ShareOutputsAsync",
         [](Pipeline *p) {
-          p->ReleaseOutputs();
-        })
+          DeviceWorkspace ws;
+          cudaEvent_t ready = p->ShareOutputsAsync(&ws);
+
+          py::tuple outs(ws.NumOutput());
+          for (int i = 0; i < ws.NumOutput(); ++i) {
+            if (ws.OutputIsType<CPUBackend>(i)) {
+              outs[i] = ws.OutputPtr<CPUBackend>(i);
+            } else {
+              outs[i] = ws.OutputPtr<GPUBackend>(i);
+            }
+          }
+          py::object event = ready
+              ? py::object(py::reinterpret_steal<py::object>(PyLong_FromVoidPtr(ready)))
+              : py::object(py::none());
+          return py::make_tuple(outs, event);
+        }, py::return_value_policy::take_ownership)
+    .def("ReleaseOutputs",
+        [](Pipeline *p, py::object consumer_event) {
+          cudaEvent_t event = nullptr;
+          if (!consumer_event.is_none())
+            event = static_cast<cudaEvent_t>(PyLong_AsVoidPtr(consumer_event.ptr()));
+          p->ReleaseOutputs(event);
+        },
+        "consumer_event"_a = py::none())
+    .def("SetExternalOutputBuffers",
+        [](Pipeline *p, int output_idx, const std::vector<std::pair<uintptr_t, size_t>> &buffers) {
+          std::vector<ExternalOutputBuffer> external;
+          for (auto &buffer : buffers)
+            external.push_back({ reinterpret_cast<void *>(buffer.first), buffer.second });
+          p->SetExternalOutputBuffers(output_idx, std::move(external));
+        },
+        "output_idx"_a, "buffers"_a)
     .def("batch_size", &Pipeline::batch_size)
     .def("num_threads", &Pipeline::num_threads)
     .def("device_id", &Pipeline::device_id)
     .def("SetExternalTLInput",
         [](Pipeline *p, const string &name, const TensorList<CPUBackend> &tl,
-           py::object /*cuda_stream*/, bool /*use_copy_kernel*/) {
-          p->SetExternalInput(name, tl, 0, true);
+           py::object /*cuda_stream*/, bool /*use_copy_kernel*/, py::object done_event) {
+          p->SetExternalInput(name, tl, 0, true, false, ExtSrcNoCopyMode::DEFAULT,
+                              RawCudaEvent(done_event));
         },
         "name"_a,
         "list"_a,
         "cuda_stream"_a = py::none(),
-        "use_copy_kernel"_a = false)
+        "use_copy_kernel"_a = false,
+        "done_event"_a = py::none())
     .def("SetExternalTLInput",
         [](Pipeline *p, const string &name, const TensorList<GPUBackend> &tl,
-           py::object cuda_stream, bool use_copy_kernel) {
+           py::object cuda_stream, bool use_copy_kernel, py::object done_event) {
            cudaStream_t stream = cuda_stream.is_none()
                                  ? UserStream::Get()->GetStream(tl)
                                  : static_cast<cudaStream_t>(ctypes_void_ptr(cuda_stream));
-          p->SetExternalInput(name, tl, stream, cuda_stream.is_none(), use_copy_kernel);
+          p->SetExternalInput(name, tl, stream, cuda_stream.is_none(), use_copy_kernel,
+                              ExtSrcNoCopyMode::DEFAULT, RawCudaEvent(done_event));
         },
         "name"_a,
         "list"_a,
         "cuda_stream"_a = py::none(),
-        "use_copy_kernel"_a = false)
+        "use_copy_kernel"_a = false,
+        "done_event"_a = py::none())
     .def("SetExternalTensorInput",
         [](Pipeline *p, const string &name, py::list list, py::object cuda_stream,
-           bool use_copy_kernel) {
+           bool use_copy_kernel, py::object done_event) {
           // Note: This is a hack to get around weird casting
           // issues w/ pybind and a non-copyable type (dali::Tensor).
           // We cannot use pybind::cast<Tensor<CPUBackend>>
@@ -1411,18 +1974,20 @@ PYBIND11_MODULE(backend_impl, m) {
           py::detail::make_caster<Tensor<CPUBackend>&> conv;
           bool is_cpu_data = conv.load(static_cast<py::object>(list[0]), true);
           if (is_cpu_data) {
-            FeedPipeline<CPUBackend>(p, name, list, 0, true);
+            FeedPipeline<CPUBackend>(p, name, list, 0, true, false, RawCudaEvent(done_event));
           } else {
             cudaStream_t stream = cuda_stream.is_none()
                                 ? UserStream::Get()->GetStream(list[0].cast<Tensor<GPUBackend>&>())
                                 : static_cast<cudaStream_t>(ctypes_void_ptr(cuda_stream));
-            FeedPipeline<GPUBackend>(p, name, list, stream, cuda_stream.is_none(), use_copy_kernel);
+            FeedPipeline<GPUBackend>(p, name, list, stream, cuda_stream.is_none(), use_copy_kernel,
+                                     RawCudaEvent(done_event));
           }
         },
         "name"_a,
         "list"_a,
         "cuda_stream"_a = py::none(),
-        "use_copy_kernel"_a = false)
+        "use_copy_kernel"_a = false,
+        "done_event"_a = py::none())
     .def("SetPyObjDependency",
       [](Pipeline *p, py::object obj) {}, "obj"_a, py::keep_alive<1, 2>())
     .def("SerializeToProtobuf",
@@ -1430,6 +1995,13 @@ PYBIND11_MODULE(backend_impl, m) {
           string s = p->SerializeToProtobuf();
           return s;
           }, py::return_value_policy::take_ownership)
+    .def("SerializeToProtobufWithMemoryHints",
+        [](Pipeline *p) -> py::bytes {
+          string s = p->SerializeToProtobufWithMemoryHints();
+          return s;
+          }, py::return_value_policy::take_ownership)
+    .def("SaveMemoryHints", &Pipeline::SaveMemoryHints, "filename"_a)
+    .def("LoadMemoryHints", &Pipeline::LoadMemoryHints, "filename"_a)
     .def("SaveGraphToDotFile", &Pipeline::SaveGraphToDotFile,
         "path"_a,
         "show_tensors"_a = false,
@@ -1449,6 +2021,18 @@ PYBIND11_MODULE(backend_impl, m) {
           DALI_ENFORCE(meta,
               "Operator " + op_name + "  not found or does not expose valid metadata.");
           return ReaderMetaToDict(meta);
+        })
+    .def("reshard", &Pipeline::Reshard,
+        "name"_a,
+        "shard_id"_a,
+        "num_shards"_a)
+    .def("reader_checkpoints", [](Pipeline* p) {
+          std::map<std::string, Index> checkpoints = p->GetReaderCheckpoints();
+          py::dict d;
+          for (auto const& value : checkpoints) {
+            d[value.first.c_str()] = value.second;
+          }
+          return d;
         });
 
 #define DALI_OPSPEC_ADDARG(T) \
@@ -1471,6 +2055,9 @@ PYBIND11_MODULE(backend_impl, m) {
         "regular_input"_a = true,
         py::return_value_policy::reference_internal)
     .def("AddArgumentInput", &OpSpec::AddArgumentInput,
+        "arg_name"_a,
+        "inp_name"_a,
+        "device"_a = "cpu",
         py::return_value_policy::reference_internal)
     .def("AddOutput", &OpSpec::AddOutput,
         py::return_value_policy::reference_internal)
@@ -1548,6 +2135,7 @@ PYBIND11_MODULE(backend_impl, m) {
         "arg_name"_a,
         "local_only"_a = false)
     .def("IsTensorArgument", &OpSchema::IsTensorArgument)
+    .def("AllowsGPUArgumentInput", &OpSchema::AllowsGPUArgumentInput)
     .def("IsSequenceOperator", &OpSchema::IsSequenceOperator)
     .def("AllowsSequences", &OpSchema::AllowsSequences)
     .def("SupportsVolumetric", &OpSchema::SupportsVolumetric)
@@ -29,15 +29,18 @@ from nvidia.dali._multiproc import shared_mem
 class SharedBatchesConsumer:
     """Counterpart of worker.py:SharedBatchesDispatcher. Can receive and deserialize batch
     from the worker, keeps track of already received memory chunks and opens new chunks
-    or resizes exiting ones if necessary."""
+    or resizes exiting ones if necessary.
+    If `pin_memory` is set, the received chunks are page-locked, so that the data, which
+    ExternalSource wraps without copying, is transferred to the GPU at pinned memory speed."""
     class MemChunk:
         def __init__(self, shm_chunk: shared_mem.SharedMem, capacity: int):
             self.shm_chunk = shm_chunk
             self.capacity = capacity
 
-    def __init__(self):
+    def __init__(self, pin_memory=False):
         import_numpy()
         self.batch_pool = {}
+        self.pin_memory = pin_memory
 
     def get_mem_chunk(self, sock: socket.socket, batch: SharedBatchMeta) -> MemChunk:
         """Get the handle for shared memory through sock and mmap the memory based on metadata
@@ -68,6 +71,8 @@ class SharedBatchesConsumer:
             # it is. The call below probably needs to be adjusted.
             assert os.fstat(handle).st_size >= batch.capacity
             shm_chunk = shared_mem.SharedMem.open(handle, batch.capacity)
+            if self.pin_memory:
+                shm_chunk.pin()
         except:
             if shm_chunk is not None:
                 shm_chunk.close()
@@ -101,8 +106,8 @@ of what tasks has been scheduled to run in the workers and what partial results
 received so far.
 """
 
-    def __init__(self):
-        self.batch_consumer = SharedBatchesConsumer()
+    def __init__(self, pin_memory=False):
+        self.batch_consumer = SharedBatchesConsumer(pin_memory)
         self.reset()
 
     def reset(self):
@@ -339,7 +344,7 @@ class WorkerPool:
     """"Combines worker processes pool with callback contexts, can be used to schedule batches
     to be run on the workers and to receive resulting batches from the workers."""
 
-    def __init__(self, num_callbacks, queue_depths, pool):
+    def __init__(self, num_callbacks, queue_depths, pool, pin_memory=False):
         """
         Parameters
         ----------
@@ -350,8 +355,10 @@ class WorkerPool:
             Depths of per-context shared memory queues
         `pool` : ProcPool
             ProcPool instance enabling basic communication with worker processes.
+        `pin_memory` : bool
+            Whether the shared memory chunks should be page-locked in the main process.
         """
-        self.contexts = [CallbackContext() for _ in range(num_callbacks)]
+        self.contexts = [CallbackContext(pin_memory) for _ in range(num_callbacks)]
         self.pool = pool
         self.queue_depths = queue_depths
         self.rec_pipes = self.pool.get_recv_pipes()
@@ -359,7 +366,7 @@ class WorkerPool:
     @classmethod
     def from_groups(
             cls, groups, keep_alive_queue_size, start_method="fork", num_workers=1,
-            initial_chunk_size=1024 * 1024, py_callback_pickler=None):
+            initial_chunk_size=1024 * 1024, py_callback_pickler=None, pin_memory=False):
         """Creates new WorkerPool instance for given list of ExternalSource groups.
 
         Parameters
@@ -377,11 +384,14 @@ class WorkerPool:
             Number of workers to be created in ProcPool.
         `initial_chunk_size` : int
             Initial size of each shared memory chunk.
+        `pin_memory` : bool
+            Whether the shared memory chunks should be page-locked in the main process, so that
+            the batches are copied to the GPU at pinned memory speed.
         """
         callbacks = [group.callback for group in groups]
         queue_depths = [keep_alive_queue_size + group.prefetch_queue_depth for group in groups]
         pool = ProcPool(callbacks, queue_depths, num_workers, start_method, initial_chunk_size, py_callback_pickler)
-        return cls(len(callbacks), queue_depths, pool)
+        return cls(len(callbacks), queue_depths, pool, pin_memory)
 
     def schedule_batch(self, context_i, batch_i, dst_chunk_i, tasks):
         """Distribute `tasks` among workers to run them by calling `context_i`th callaback
@@ -12,6 +12,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+from nvidia.dali import backend as _b
 from nvidia.dali._multiproc import shared_mem
 from nvidia.dali._utils.external_source_impl import \
         assert_cpu_sample_data_type as _assert_cpu_sample_data_type, \
@@ -68,16 +69,47 @@ class SharedBatchMeta:
     meta data passed through shared memory (SampleMeta).
     """
 
-    def __init__(self, mem_chunk_id, capacity, meta_offset, meta_size):
+    def __init__(self, mem_chunk_id, capacity, meta_offset, meta_size, binary_meta=False):
         self.mem_chunk_id = mem_chunk_id
         self.capacity = capacity
         self.meta_offset = meta_offset
         self.meta_size = meta_size
+        # whether the meta data is in the binary format read by the backend
+        # (see `_encode_binary_meta`) or is a pickled list of SampleMeta
+        self.binary_meta = binary_meta
 
     @classmethod
     def from_writer(cls, writer):
         return cls(writer.mem_batch.mem_chunk_id, writer.mem_batch.capacity, writer.data_size,
-                   writer.meta_data_size)
+                   writer.meta_data_size, writer.binary_meta)
+
+
+def _has_binary_meta(sample_meta):
+    """Check if the sample can be described in the binary format: it must be a single array
+    or a flat tuple/list of arrays of plain numeric types."""
+    def is_plain(meta):
+        return isinstance(meta, SampleMeta) and meta.dtype.isbuiltin == 1 and \
+            meta.dtype.kind in 'biufc'
+    if isinstance(sample_meta, (tuple, list)):
+        return all(is_plain(part) for part in sample_meta)
+    return is_plain(sample_meta)
+
+
+def _encode_binary_meta(samples_meta):
+    """Encode the list of (idx, SampleMeta or tuple/list of SampleMeta) as a sequence of int64,
+    which the main process parses in the backend (``backend.DeserializeSharedBatch``),
+    without unpickling and building the arrays one by one in Python.
+    The layout is: num_samples, then for every sample: idx, kind (0 - array, 1 - tuple,
+    2 - list), num_arrays, then for every array: offset, nbytes, dtype char, ndim, shape."""
+    values = [len(samples_meta)]
+    for idx, sample in samples_meta:
+        parts = sample if isinstance(sample, (tuple, list)) else (sample,)
+        kind = 1 if isinstance(sample, tuple) else 2 if isinstance(sample, list) else 0
+        values += [idx, kind, len(parts)]
+        for meta in parts:
+            values += [meta.offset, meta.nbytes, ord(meta.dtype.char), len(meta.shape)]
+            values += meta.shape
+    return np.array(values, dtype=np.int64).tobytes()
 
 
 def deserialize_sample(buffer: shared_mem.SharedMem, sample):
@@ -117,6 +149,9 @@ def deserialize_batch(buffer: shared_mem.SharedMem, shared_batch_meta: SharedBat
     List of (idx, numpy array) or (idx, tuple of numpy arrays)
         List of indexed deserialized samples
     """
+    sbm = shared_batch_meta
+    if sbm.binary_meta:
+        return _b.DeserializeSharedBatch(buffer.shm, sbm.meta_offset, sbm.meta_size)
     samples = deserialize_sample_meta(buffer, shared_batch_meta)
     return [(idx, deserialize_sample(buffer, sample)) for (idx, sample) in samples]
 
@@ -189,6 +224,7 @@ class SharedBatchWriter:
         self.mem_batch = mem_batch
         self.data_size = 0
         self.meta_data_size = 0
+        self.binary_meta = False
         self._write_batch(batch)
 
     def _prepare_samples_meta(self, indexed_samples):
@@ -220,7 +256,8 @@ class SharedBatchWriter:
         batch = [(idx, _apply_to_sample(lambda x: _sample_to_numpy(x, _sample_error_msg), sample))
                  for idx, sample in batch]
         meta, data_size = self._prepare_samples_meta(batch)
-        serialized_meta = pickle.dumps(meta)
+        self.binary_meta = all(_has_binary_meta(sample_meta) for _, sample_meta in meta)
+        serialized_meta = _encode_binary_meta(meta) if self.binary_meta else pickle.dumps(meta)
         self.meta_data_size = len(serialized_meta)
         self.data_size = _align_up(data_size, self.SAMPLE_ALIGNMENT)
         needed_capacity = self.data_size + self.meta_data_size
@@ -92,6 +92,21 @@ class SharedMem:
             del self.__dict__['buf']
         self.shm.resize(size, trunc)
 
+    def pin(self):
+        """Page-locks the memory mapped into the current process, so that host-to-device copies
+        from the chunk run at the speed of pinned memory. The memory stays pinned across resizes
+        until `unpin` or `close` is called.
+        """
+        self.shm.pin()
+
+    def unpin(self):
+        """Releases the page-lock acquired with `pin`."""
+        self.shm.unpin()
+
+    @property
+    def is_pinned(self):
+        return self.shm.is_pinned
+
     def close(self):
         """Removes maping of the memory into process address space and closes related handle.
         If all processes sharing given chunk close it, it will be automatically released by the OS.
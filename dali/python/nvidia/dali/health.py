@@ -0,0 +1,86 @@
+# Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import collections
+import socketserver
+import threading
+from http.server import BaseHTTPRequestHandler, HTTPServer
+
+
+def prometheus_text(pipelines):
+    """Returns the health metrics of the pipelines in the Prometheus text exposition format.
+
+    Parameters
+    ----------
+    `pipelines` : dict
+        Pipelines to report, keyed with the name used as the ``pipeline`` label.
+    """
+    # the samples of a metric must form a single group, after its metadata
+    families = collections.OrderedDict()
+    for name, pipe in pipelines.items():
+        metric = None
+        for line in pipe.health_metrics_prometheus({"pipeline": name}).splitlines():
+            if line.startswith("#"):
+                metric = line.split()[2]
+                metadata = families.setdefault(metric, ([], []))[0]
+                if line not in metadata:
+                    metadata.append(line)
+            elif line:
+                families[metric][1].append(line)
+    return "".join(line + "\n" for metadata, samples in families.values()
+                   for line in metadata + samples)
+
+
+def start_prometheus_exporter(pipelines, port, addr=""):
+    """Serves the health metrics of the pipelines (see :meth:`Pipeline.health_metrics`)
+    over HTTP, to be scraped by Prometheus. The metrics are collected on each request.
+
+    The server runs in a daemon thread; call ``shutdown()`` on the returned server to stop it.
+
+    Parameters
+    ----------
+    `pipelines` : dict
+        Pipelines to report, keyed with the name used as the ``pipeline`` label.
+        The pipelines must be built.
+    `port` : int
+        The port to listen on; 0 selects a free one (see ``server_address`` of the server).
+    `addr` : str, optional, default = ""
+        The address to listen on; all the interfaces by default.
+    """
+    pipelines = dict(pipelines)
+
+    class Handler(BaseHTTPRequestHandler):
+        def do_GET(self):
+            try:
+                body = prometheus_text(pipelines).encode("utf-8")
+            except Exception as e:
+                self.send_error(500, str(e))
+                return
+            self.send_response(200)
+            self.send_header("Content-Type", "text/plain; version=0.0.4; charset=utf-8")
+            self.send_header("Content-Length", str(len(body)))
+            self.end_headers()
+            self.wfile.write(body)
+
+        def log_message(self, format, *args):
+            pass
+
+    class Server(socketserver.ThreadingMixIn, HTTPServer):
+        daemon_threads = True
+
+    server = Server((addr, port), Handler)
+    thread = threading.Thread(target=server.serve_forever, name="DALI health exporter",
+                              daemon=True)
+    thread.start()
+    return server
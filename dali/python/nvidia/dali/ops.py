@@ -431,8 +431,10 @@ class _OperatorInstance(object):
                                 .format(k, type(arg_inp).__name__)) from e
 
                 _check_arg_input(op._schema, type(self._op).__name__, k)
+                if arg_inp.device == "gpu":
+                    _check_gpu_arg_input(op._schema, type(self._op).__name__, op.device, k)
 
-                self._spec.AddArgumentInput(k, arg_inp.name)
+                self._spec.AddArgumentInput(k, arg_inp.name, arg_inp.device)
                 self._inputs = list(self._inputs) + [arg_inp]
 
         if self._op.schema.IsDeprecated():
@@ -528,6 +530,12 @@ def _check_arg_input(schema, op_name, name):
         raise TypeError("The argument `{}` for operator `{}` should not be a `DataNode` but a {}".format(
             name, op_name, _type_name_convert_to_string(schema.GetArgumentType(name), False)))
 
+def _check_gpu_arg_input(schema, op_name, op_device, name):
+    if op_device != "gpu" or not schema.AllowsGPUArgumentInput(name):
+        raise TypeError(("The argument `{}` for {} operator `{}` must be located in CPU memory. " +
+            "Argument inputs located in GPU memory are supported only by GPU operators, " +
+            "for arguments which don't affect the output shape.").format(name, op_device, op_name))
+
 def python_op_factory(name, schema_name = None, op_device = "cpu"):
     class Operator(metaclass=_DaliOperatorMeta):
         def __init__(self, **kwargs):
@@ -1047,8 +1055,20 @@ class DLTensorPythonFunction(PythonFunctionBase):
                                                               lambda x: x, lambda x: x,
                                                               *dlpack_inputs)
 
+    @staticmethod
+    def _stream_ordered_wrapper(function):
+        def wrapped(*inputs):
+            return function(*inputs, stream=PythonFunction.current_stream())
+        return wrapped
+
     def __init__(self, function, num_outputs=1, device='cpu', synchronize_stream=True,
-                 batch_processing=True, **kwargs):
+                 batch_processing=True, stream_ordered=False, **kwargs):
+        if stream_ordered:
+            if device != 'gpu':
+                raise ValueError("`stream_ordered` applies only to the GPU DLTensorPythonFunction.")
+            # the work of the function is ordered after DALI's work by the stream
+            function = DLTensorPythonFunction._stream_ordered_wrapper(function)
+            synchronize_stream = False
         func = lambda *ts: DLTensorPythonFunction._function_wrapper_dlpack(batch_processing, function, num_outputs, *ts)
         super(DLTensorPythonFunction, self).__init__(impl_name="DLTensorPythonFunctionImpl",
                                                      function=func, num_outputs=num_outputs,
@@ -1202,12 +1222,73 @@ def _generate_input_desc(categories_idx, integers, reals):
             input_desc += " "
     return input_desc
 
+# Limits of the expression trees calculated by a single ArithmeticGenericOp
+_max_arithm_expr_ops = 8
+_max_arithm_expr_leaves = 16
+
+class _ArithmExpr:
+    """Tree of arithmetic operations with DataNodes and constants as leaves."""
+    def __init__(self, name, inputs):
+        self.name = name
+        self.inputs = inputs
+
+    def num_ops(self):
+        return 1 + sum(x.num_ops() for x in self.inputs if isinstance(x, _ArithmExpr))
+
+    # Collect the leaves of the tree, in order - the DataNodes used more than once are
+    # collected once. For every occurrence of a leaf, its index is added to `leaf_idxs`.
+    def collect_leaves(self, leaves, leaf_idxs):
+        for x in self.inputs:
+            if isinstance(x, _ArithmExpr):
+                x.collect_leaves(leaves, leaf_idxs)
+                continue
+            idx = None
+            if isinstance(x, _DataNode):
+                idx = next((i for i, y in enumerate(leaves)
+                            if isinstance(y, _DataNode) and y.name == x.name), None)
+            if idx is None:
+                idx = len(leaves)
+                leaves.append(x)
+            leaf_idxs.append(idx)
+
+    # Generate the expression_desc, `leaf_descs` are the descriptions of the leaves
+    # and `leaf_idxs` is an iterator over the indices obtained from `collect_leaves`
+    def desc(self, leaf_descs, leaf_idxs):
+        args = []
+        for x in self.inputs:
+            if isinstance(x, _ArithmExpr):
+                args.append(x.desc(leaf_descs, leaf_idxs))
+            else:
+                args.append(leaf_descs[next(leaf_idxs)])
+        return "{}({})".format(self.name, " ".join(args))
+
+# The results of arithmetic operators remember the expression that produced them.
+# When such a result is an input to another arithmetic operator, the expression is inlined,
+# so that the whole tree is evaluated in one pass by a single ArithmeticGenericOp,
+# without storing the intermediate results. The operator that would calculate
+# the intermediate result alone is not a part of the pipeline, unless its output is used
+# elsewhere.
+def _arithm_expr(name, inputs):
+    def inline(x):
+        return getattr(x, "_arithm_expr", x) if isinstance(x, _DataNode) else x
+    inlined = _ArithmExpr(name, [inline(x) for x in inputs])
+    leaves, leaf_idxs = [], []
+    inlined.collect_leaves(leaves, leaf_idxs)
+    if inlined.num_ops() <= _max_arithm_expr_ops and len(leaves) <= _max_arithm_expr_leaves:
+        return inlined, leaves, leaf_idxs
+    expr = _ArithmExpr(name, list(inputs))
+    leaves, leaf_idxs = [], []
+    expr.collect_leaves(leaves, leaf_idxs)
+    return expr, leaves, leaf_idxs
+
 # Create arguments for ArithmeticGenericOp and call it with supplied inputs.
 # Select the `gpu` device if at least one of the inputs is `gpu`, otherwise `cpu`.
 def _arithm_op(name, *inputs):
-    categories_idxs, edges, integers, reals = _group_inputs(inputs)
-    input_desc = _generate_input_desc(categories_idxs, integers, reals)
-    expression_desc = "{}({})".format(name, input_desc)
+    expr, leaves, leaf_idxs = _arithm_expr(name, inputs)
+    categories_idxs, edges, integers, reals = _group_inputs(leaves)
+    leaf_descs = [_generate_input_desc([category_idx], integers, reals)
+                  for category_idx in categories_idxs]
+    expression_desc = expr.desc(leaf_descs, iter(leaf_idxs))
     dev = _choose_device(edges)
     # Create "instance" of operator
     op = ArithmeticGenericOp(device = dev, expression_desc = expression_desc,
@@ -1218,7 +1299,9 @@ def _arithm_op(name, *inputs):
     else:
         dev_inputs = edges
     # Call it immediately
-    return op(*dev_inputs)
+    result = op(*dev_inputs)
+    result._arithm_expr = expr
+    return result
 
 
 def cpu_ops():
@@ -98,6 +98,10 @@ Parameters
     Executor will buffer cpu and gpu stages separatelly,
     and will fill the buffer queues when the first :meth:`run`
     is issued.
+    Adding ``"min_cpu_size"`` and/or ``"min_gpu_size"`` to the dict makes the depth
+    adaptive: the executor starts with the minimum number of buffers for the stage and
+    grows it up to ``"cpu_size"``/``"gpu_size"`` when the outputs are not ready on time,
+    or shrinks it when they are. Adaptive depth requires `exec_async`.
 `exec_async` : bool, optional, default = True
     Whether to execute the pipeline asynchronously.
     This makes :meth:`run` method
@@ -108,17 +112,100 @@ Parameters
     A hint for DALI for how much memory to use for its tensors.
 `set_affinity` : bool, optional, default = False
     Whether to set CPU core affinity to the one closest to the
-    GPU being used.
+    GPU being used. It applies to all the threads of the pipeline: the worker threads,
+    the executor's threads and the readers' prefetch threads. The placement is selected with
+    :meth:`nvidia.dali.backend.SetAffinityPolicy` (or the ``DALI_AFFINITY_POLICY`` environment
+    variable) and the resulting mapping can be checked with
+    :meth:`nvidia.dali.backend.GetThreadAffinity`.
 `max_streams` : int, optional, default = -1
     Limit the number of CUDA streams used by the executor.
     Value of -1 does not impose a limit.
-    This parameter is currently unused (and behavior of
-    unrestricted number of streams is assumed).
+    The independent branches of the GPU operators (e.g. the processing of the images and
+    of the bounding boxes) are issued to separate streams, so that they can run concurrently -
+    up to 3 streams in addition to the ones used by the mixed and the GPU stage, or as many as
+    this limit allows. Set it to 2 to run all the GPU operators in one stream.
 `default_cuda_stream_priority` : int, optional, default = 0
     CUDA stream priority used by DALI. See `cudaStreamCreateWithPriority` in CUDA documentation
 `enable_memory_stats`: bool, optional, default = 1
     If DALI should print operator output buffer statistics.
     Usefull for `bytes_per_sample_hint` operator parameter.
+`enable_timing_stats`: bool, optional, default = False
+    If DALI should measure the time spent in each operator and pipeline stage.
+    The results are available through :meth:`executor_statistics`.
+`enable_op_fusion`: bool, optional, default = False
+    If True, chains of GPU operators that can be computed in a single pass (for example
+    ``Flip``, ``Crop``, ``noise.gaussian`` or ``Cast`` and ``Transpose`` around
+    ``CropMirrorNormalize``) are fused into one operator when the pipeline is built. This reduces
+    the number of kernel launches and the memory traffic, but the intermediate results are no
+    longer available.
+    Consecutive ``WarpAffine`` operators with constant matrices are replaced with one, which
+    resamples the image only once - its output may differ slightly near the image borders.
+    Additionally, an image decoder whose output is only resized to a fixed size gets
+    the ``downscale_hint``, so that large JPEG images can be decoded at a reduced resolution.
+`enable_cuda_graphs`: bool, optional, default = False
+    If True, the work of the GPU stage is captured into a CUDA graph and replayed in the
+    subsequent iterations, as long as the shapes, the buffers and the argument inputs don't
+    change. It reduces the CPU overhead of launching the kernels in pipelines with static shapes.
+    The graphs are used only if all the GPU operators support it (currently
+    ``CropMirrorNormalize``); otherwise the option has no effect.
+`enable_cpu_dataflow`: bool, optional, default = False
+    If True, the CPU operators which don't depend on each other run concurrently - each one
+    starts as soon as the CPU operators producing its inputs finish and, when several are ready,
+    the ones on the longest chain of the operators go first. The operators still share the
+    ``num_threads`` worker threads for their per-sample work. It helps the pipelines with
+    independent branches, e.g. decoding the images and processing the labels or the audio,
+    where the operators working on small batches can't keep all the threads busy.
+`enable_cpu_depth_first`: bool, optional, default = False
+    If True, the chains of the CPU operators implemented per sample, where each operator
+    consumes only the output of the previous one, are run depth-first: a worker thread passes
+    a sample through the whole chain before taking the next one, so the intermediate results
+    are still in the CPU cache when they are used. The operators in a chain (except the first
+    one) are set up before their inputs are computed, so their inputs don't get the default
+    layouts; the time of the whole chain is reported for its first operator.
+    It can't be combined with ``enable_cpu_dataflow``.
+`enable_concurrent_cpu_iterations`: bool, optional, default = False
+    If True, a CPU-only pipeline (``device_id=None``) runs up to ``prefetch_queue_depth``
+    iterations at once: an operator starts the next iteration as soon as it has finished
+    the current one, without waiting for the rest of the pipeline, so a slow operator doesn't
+    leave the others idle. The outputs are still returned in order. The operators share the
+    ``num_threads`` worker threads for their per-sample work.
+    It can't be combined with ``enable_cpu_dataflow`` or ``enable_cpu_depth_first``.
+`enable_memory_reuse`: bool, optional, default = False
+    If True, the intermediate GPU buffers, which are never used at the same time, are allocated
+    from shared blocks of device memory, which lowers the memory footprint of long chains of GPU
+    operators. Only the buffers produced and consumed in one CUDA stream share memory;
+    the pipeline outputs keep their own buffers.
+`enable_early_gpu_setup`: bool, optional, default = False
+    If True, the GPU operators whose output shapes don't depend on the results of the other
+    GPU operators are set up, and their outputs allocated, at the start of the GPU stage,
+    so that their kernels are issued back to back. The inputs of such operators don't get
+    the default layouts.
+`enable_shared_scratch`: bool, optional, default = False
+    If True, the GPU operators issued to the same CUDA stream take the temporary device memory
+    of their kernels from one shared arena, which is released after each operator, instead of
+    keeping their own buffers. The arena is only as large as the largest requirement of a single
+    operator. The peak usage of each operator is reported as ``max_scratch_size``
+    in the diagnostics of :meth:`executor_statistics`, when ``enable_timing_stats`` is set.
+    Not used with ``enable_cuda_graphs``.
+`enable_low_latency`: bool, optional, default = False
+    If True, the executor is tuned for the latency of a single iteration, e.g. for serving
+    requests with batches of 1: the per-sample work of a CPU operator with a single sample
+    is run on the calling thread instead of being handed to a worker thread, and the host
+    polls the CUDA events for a short while before it blocks on them.
+    It needs ``exec_pipelined=False`` and ``exec_async=False``, so that all the stages are run
+    on the thread calling :meth:`run`.
+`share_thread_pool`: bool, optional, default = False
+    If True, the CPU operators are run by a process-wide pool of ``num_threads`` worker threads,
+    shared by all the pipelines which use this option and the same ``num_threads``.
+    In a process driving several GPUs, with one pipeline per device, it reduces the number of
+    host threads (and their per-thread buffers) by the number of pipelines, at the cost of
+    the pipelines competing for the same threads. ``set_affinity`` is ignored for such pipelines.
+`thread_pool_weight`: float, optional, default = 1.0
+    The share of the shared worker threads (see ``share_thread_pool``) this pipeline gets when
+    the other pipelines have work too. The threads run the work of the pipeline which has used
+    the least thread time relative to its weight, so a latency-sensitive pipeline with weight 4
+    gets four times as much time as a batch job with the default weight. Combine it with
+    ``default_cuda_stream_priority`` to prioritize the GPU work of the pipeline too.
 `py_num_workers`: int, optional, default = 1
     The number of Python workers that will process ``ExternalSource`` callbacks.
     The pool starts only if there is at least one ExternalSource with ``parallel`` set to True.
@@ -168,8 +255,14 @@ Parameters
                  exec_async=True, bytes_per_sample=0,
                  set_affinity=False, max_streams=-1, default_cuda_stream_priority = 0,
                  *,
-                 enable_memory_stats=False, py_num_workers=1, py_start_method="fork",
-                 py_callback_pickler=None):
+                 enable_memory_stats=False, enable_timing_stats=False,
+                 enable_op_fusion=False, enable_cuda_graphs=False, enable_cpu_dataflow=False,
+                 enable_cpu_depth_first=False, enable_concurrent_cpu_iterations=False,
+                 enable_memory_reuse=False, enable_early_gpu_setup=False,
+                 enable_shared_scratch=False, enable_low_latency=False,
+                 share_thread_pool=False, thread_pool_weight=1.0,
+                 py_num_workers=1,
+                 py_start_method="fork", py_callback_pickler=None):
         self._sinks = []
         self._max_batch_size = batch_size
         self._num_threads = num_threads
@@ -186,6 +279,7 @@ Parameters
         self._py_pool_started = False
         self._backend_prepared = False
         self._built = False
+        self._external_output_buffers = {}
         self._first_iter = True
         self._last_iter = False
         self._iter = 0
@@ -215,15 +309,35 @@ Parameters
         self._parallel_input_callbacks = None
         self._seq_input_callbacks = None
         self._enable_memory_stats = enable_memory_stats
+        self._enable_timing_stats = enable_timing_stats
+        self._enable_op_fusion = enable_op_fusion
+        self._enable_cuda_graphs = enable_cuda_graphs
+        self._enable_cpu_dataflow = enable_cpu_dataflow
+        self._enable_cpu_depth_first = enable_cpu_depth_first
+        self._enable_concurrent_cpu_iterations = enable_concurrent_cpu_iterations
+        self._enable_memory_reuse = enable_memory_reuse
+        self._enable_early_gpu_setup = enable_early_gpu_setup
+        self._enable_shared_scratch = enable_shared_scratch
+        self._enable_low_latency = enable_low_latency
+        self._share_thread_pool = share_thread_pool
+        self._thread_pool_weight = thread_pool_weight
+        self._memory_hints_file = None
         self._prefetch_queue_depth = prefetch_queue_depth
         if type(prefetch_queue_depth) is dict:
             self._exec_separated = True
             self._cpu_queue_size = prefetch_queue_depth["cpu_size"]
             self._gpu_queue_size = prefetch_queue_depth["gpu_size"]
+            if "min_cpu_size" in prefetch_queue_depth or "min_gpu_size" in prefetch_queue_depth:
+                self._min_queue_sizes = (
+                    prefetch_queue_depth.get("min_cpu_size", self._cpu_queue_size),
+                    prefetch_queue_depth.get("min_gpu_size", self._gpu_queue_size))
+            else:
+                self._min_queue_sizes = None
         elif type(prefetch_queue_depth) is int:
             self._exec_separated = False
             self._cpu_queue_size = prefetch_queue_depth
             self._gpu_queue_size = prefetch_queue_depth
+            self._min_queue_sizes = None
         else:
             raise TypeError("Expected prefetch_queue_depth to be either int or Dict[int, int]")
 
@@ -288,6 +402,66 @@ Parameters
         """If True, memory usage statistics are gathered."""
         return self._enable_memory_stats
 
+    @property
+    def enable_timing_stats(self):
+        """If True, operator and stage timing statistics are gathered."""
+        return self._enable_timing_stats
+
+    @property
+    def enable_op_fusion(self):
+        """If True, operators are fused when the pipeline is built."""
+        return self._enable_op_fusion
+
+    @property
+    def enable_cuda_graphs(self):
+        """If True, the GPU stage is captured into CUDA graphs, when possible."""
+        return self._enable_cuda_graphs
+
+    @property
+    def enable_cpu_dataflow(self):
+        """If True, the independent CPU operators run concurrently."""
+        return self._enable_cpu_dataflow
+
+    @property
+    def enable_cpu_depth_first(self):
+        """If True, the chains of per-sample CPU operators run sample by sample."""
+        return self._enable_cpu_depth_first
+
+    @property
+    def enable_concurrent_cpu_iterations(self):
+        """If True, a CPU-only pipeline runs several iterations at once."""
+        return self._enable_concurrent_cpu_iterations
+
+    @property
+    def enable_memory_reuse(self):
+        """If True, the intermediate GPU buffers with disjoint lifetimes share memory."""
+        return self._enable_memory_reuse
+
+    @property
+    def enable_early_gpu_setup(self):
+        """If True, the GPU operators are set up at the start of the GPU stage."""
+        return self._enable_early_gpu_setup
+
+    @property
+    def enable_shared_scratch(self):
+        """If True, the GPU operators share the scratch memory of their kernels."""
+        return self._enable_shared_scratch
+
+    @property
+    def enable_low_latency(self):
+        """If True, the executor is tuned for the latency of a single iteration."""
+        return self._enable_low_latency
+
+    @property
+    def share_thread_pool(self):
+        """If True, the CPU operators run in the worker threads shared with other pipelines."""
+        return self._share_thread_pool
+
+    @property
+    def thread_pool_weight(self):
+        """The share of the shared worker threads this pipeline gets."""
+        return self._thread_pool_weight
+
     @property
     def py_num_workers(self):
         """The number of Python worker processes used by parallel ```external_source```."""
@@ -351,11 +525,92 @@ Parameters
 
             * ``max_reserved_memory_size`` - list of maximum memory sizes per tensor that is reserved for each of the operator outputs.
               Index in the list corresponds to the output index.
+
+            * ``sample_size_hint`` - list of sample sizes not exceeded by 95% of the samples
+              produced by each output of the operator - the hints stored by :meth:`save_memory_hints`.
+              Index in the list corresponds to the output index.
+
+        If ``enable_timing_stats`` is set, the operators (keyed as ``<STAGE>_<name>``) and the
+        pipeline stages (keyed as ``STAGE_CPU``, ``STAGE_MIXED`` and ``STAGE_GPU``) report also:
+
+            * ``iterations``, ``samples`` - number of timed runs and samples processed in them.
+
+            * ``total_time``, ``max_time`` - total and maximum host time of a run, in seconds.
+
+            * ``gpu_iterations``, ``gpu_time`` - number of runs with the device time measured
+              and the total device time of these runs, in seconds.
+
+            * ``wait_time`` - time the stage spent waiting for free queue buffers, in seconds.
+
+            * ``samples_per_second`` - throughput computed from ``samples`` and ``total_time``.
+
+            * ``diagnostics`` - the numeric diagnostics of the operator; with
+              ``enable_shared_scratch``, the GPU operators report ``max_scratch_size`` -
+              the peak device scratch memory used by a run, in bytes.
         """
         if not self._built:
             raise RuntimeError("Pipeline must be built first.")
         return self._pipe.executor_statistics()
 
+    def health_metrics(self):
+        """Returns the health metrics of the pipeline, which tell whether the pipeline or
+        its consumer is the bottleneck. They are always collected and can be polled at any time.
+
+        The counters and the times (in seconds) are cumulative since the pipeline was built,
+        so the rates can be computed from two consecutive results. Available keys:
+
+            * ``uptime`` - time since the pipeline was built.
+
+            * ``stages`` - a dictionary with the ``cpu``, ``mixed`` and ``gpu`` stages, each with:
+              ``iterations`` - batches processed, ``wait_time`` - time spent waiting for
+              the buffers (free ones, or the output of the previous stage), ``stalls`` - number
+              of such waits longer than 1 ms, ``queue_occupancy`` - batches produced by the stage
+              and not yet taken by the next one (or by the consumer), ``queue_capacity`` -
+              number of the buffers of the stage and ``queue_mean_occupancy`` - the occupancy
+              averaged over the uptime.
+
+            * ``outputs`` - batches taken by the consumer (:meth:`outputs`,
+              :meth:`share_outputs`).
+
+            * ``consumer_wait_time`` - time the consumer spent waiting for the batches.
+
+            * ``consumer_starved`` - number of batches requested when none was ready.
+
+            * ``readers`` - a dictionary with the prefetching of each reader, as seen by
+              the pipeline: ``prefetch_queue_depth``, ``prefetch_queue_fill`` - the batches ready
+              when the last one was requested, ``starved`` - number of batches the reader had to
+              wait for and ``wait_time``.
+
+            * ``thread_pool_threads``, ``thread_pool_busy_time``, ``thread_pool_busy_fraction`` -
+              the threads of the pool and the thread time (total and as a fraction of the
+              uptime) spent on the work of the pipeline.
+
+            * ``bottleneck`` - ``"pipeline"`` if the consumer waited for the batches longer than
+              the CPU stage waited for the buffers to be released, ``"consumer"`` otherwise, or
+              ``"unknown"`` before the first batch was taken.
+        """
+        if not self._built:
+            raise RuntimeError("Pipeline must be built first.")
+        return self._pipe.health_metrics()
+
+    def health_metrics_prometheus(self, labels=None):
+        """Returns the :meth:`health_metrics` in the Prometheus text exposition format.
+
+        Parameters
+        ----------
+        `labels` : dict, optional
+            Labels added to every sample, e.g. ``{"pipeline": "train"}``.
+        """
+        if not self._built:
+            raise RuntimeError("Pipeline must be built first.")
+        label_str = ""
+        if labels:
+            def escape(value):
+                value = str(value).replace("\\", "\\\\").replace('"', '\\"')
+                return value.replace("\n", "\\n")
+            label_str = ",".join('{}="{}"'.format(k, escape(v)) for k, v in labels.items())
+        return self._pipe.health_metrics_prometheus(label_str)
+
     def reader_meta(self, name = None):
         """Returns provided reader metadata as a dictionary. If no name is provided if provides
         a dictionary with data for all readers as {reader_name : meta}
@@ -385,6 +640,63 @@ Parameters
             return self._pipe.reader_meta(name)
         return self._pipe.reader_meta()
 
+    def reshard(self, name, shard_id, num_shards):
+        """Moves the reader with given name to another shard of the data set, without
+        rebuilding the pipeline, e.g. when the number of the workers of an elastic training job
+        changes.
+
+        The reader keeps the metadata it has already loaded, like the list of files or
+        the index, and discards the samples it has prefetched. The new shard is read from
+        its beginning, in the order of the next epoch, so the readers resharded after the same
+        number of iterations, e.g. at the end of an epoch, still split the data set into
+        disjoint shards.
+
+        It can be called only when no iteration is scheduled, so the outputs of the iterations
+        that were already scheduled with :meth:`schedule_run` have to be taken first,
+        for example::
+
+            while not pipe.empty():
+                pipe.outputs()
+            pipe.reshard("Reader", shard_id=new_rank, num_shards=new_world_size)
+
+        The values returned by :meth:`reader_checkpoints` don't account for the resharding.
+
+        Parameters
+        ----------
+        name : str
+            The name of the reader.
+        shard_id : int
+            The new shard id of the reader.
+        num_shards : int
+            The new number of shards.
+        """
+        if not self._built:
+            raise RuntimeError("Pipeline must be built first.")
+        if not self.empty():
+            raise RuntimeError("The readers can't be resharded while there are iterations "
+                               "scheduled. Take their outputs first.")
+        self._pipe.reshard(name, shard_id, num_shards)
+
+    def reader_checkpoints(self):
+        """Returns the number of samples consumed from each reader, as a dictionary
+        {reader_name : number_of_samples}.
+
+        Only the iterations whose outputs were already returned count, the ones in the prefetch
+        queue don't. To resume reading after the pipeline is recreated, pass the value
+        as ``skip_samples`` to the corresponding reader, for example::
+
+            checkpoints = pipe.reader_checkpoints()
+            ...
+            images, labels = fn.readers.file(file_root=root, name="Reader",
+                                             skip_samples=checkpoints["Reader"])
+
+        The readers are fast-forwarded to the same position in the same epoch, so they return
+        the same samples, in the same order, as if the pipeline had not been interrupted.
+        """
+        if not self._built:
+            raise RuntimeError("Pipeline must be built first.")
+        return self._pipe.reader_checkpoints()
+
     @staticmethod
     def current():
         """Returns the instance of the current pipeline set by :meth:`push_current`."""
@@ -596,7 +908,8 @@ Parameters
             return
         self._py_pool = WorkerPool.from_groups(
             self._parallel_input_callbacks, self._prefetch_queue_depth, self._py_start_method,
-            self._py_num_workers, py_callback_pickler=self._py_callback_pickler)
+            self._py_num_workers, py_callback_pickler=self._py_callback_pickler,
+            pin_memory=self._device_id is not None and self._device_id != types.CPU_ONLY_DEVICE_ID)
         # ensure processes started by the pool are termineted when pipeline is no longer used
         weakref.finalize(self, lambda pool : pool.close(), self._py_pool)
         self._py_pool_started = True
@@ -615,7 +928,23 @@ Parameters
                                 self._default_cuda_stream_priority)
         self._pipe.SetExecutionTypes(self._exec_pipelined, self._exec_separated, self._exec_async)
         self._pipe.SetQueueSizes(self._cpu_queue_size, self._gpu_queue_size)
+        if self._min_queue_sizes is not None:
+            self._pipe.SetAdaptiveQueueSizes(*self._min_queue_sizes)
         self._pipe.EnableExecutorMemoryStats(self._enable_memory_stats)
+        self._pipe.EnableExecutorTimingStats(self._enable_timing_stats)
+        self._pipe.EnableOperatorFusion(self._enable_op_fusion)
+        self._pipe.EnableCudaGraphs(self._enable_cuda_graphs)
+        self._pipe.EnableCPUDataflow(self._enable_cpu_dataflow)
+        self._pipe.EnableCPUDepthFirst(self._enable_cpu_depth_first)
+        self._pipe.EnableConcurrentCPUIterations(self._enable_concurrent_cpu_iterations)
+        self._pipe.EnableMemoryReuse(self._enable_memory_reuse)
+        self._pipe.EnableEarlyGPUSetup(self._enable_early_gpu_setup)
+        self._pipe.EnableSharedScratch(self._enable_shared_scratch)
+        self._pipe.EnableLowLatency(self._enable_low_latency)
+        self._pipe.EnableSharedThreadPool(self._share_thread_pool)
+        self._pipe.SetThreadPoolWeight(self._thread_pool_weight)
+        if self._memory_hints_file is not None:
+            self._pipe.LoadMemoryHints(self._memory_hints_file)
 
         # Add the ops to the graph and build the backend
         related_logical_id = {}
@@ -703,7 +1032,52 @@ Parameters
         self._pipe.Build(self._names_and_devices)
         self._built = True
 
-    def feed_input(self, data_node, data, layout = None, cuda_stream = None, use_copy_kernel = False):
+    def warmup(self, inputs=None, input_shapes=None, dtype=None, iterations=1):
+        """Runs a few iterations and discards their outputs, so that the operators create their
+        handles and plans, load their kernels and allocate their buffers before the first
+        real iteration, e.g. before serving the first request.
+
+        The ExternalSource nodes are fed for each of the iterations - either with the data
+        from `inputs` or with zeros of the shapes given in `input_shapes`. The data should be
+        representative of the real data (the shapes, the sizes of the images), since the buffers
+        grow to the largest sizes seen. Zeros are fine for the operators which don't interpret
+        the data, but not e.g. for the decoders, which need valid encoded samples.
+
+        The readers and the random operators advance as in regular iterations. It must be called
+        after :meth:`build` and before the first iteration is scheduled.
+
+        Parameters
+        ----------
+        inputs : dict, optional
+            Maps the names of the ExternalSource nodes to the batches to feed them with,
+            in any form accepted by :meth:`feed_input`.
+        input_shapes : dict, optional
+            Maps the names of the ExternalSource nodes to the shape of the samples or to a list
+            of the shapes of all the samples in the batch. The batches are filled with zeros.
+        dtype : numpy.dtype, optional
+            The type of the zero-filled batches, uint8 by default.
+        iterations : int, optional
+            The number of iterations to run.
+        """
+        if not self._built:
+            raise RuntimeError("Pipeline must be built first.")
+        if not self._first_iter or not self.empty():
+            raise RuntimeError("The pipeline can only be warmed up before the first iteration.")
+        import numpy as np
+        dtype = np.uint8 if dtype is None else dtype
+        batches = dict(inputs or {})
+        for name, shape in (input_shapes or {}).items():
+            if len(shape) > 0 and isinstance(shape[0], (list, tuple)):
+                batches[name] = [np.zeros(s, dtype=dtype) for s in shape]
+            else:
+                batches[name] = np.zeros((self._max_batch_size,) + tuple(shape), dtype=dtype)
+        for _ in range(iterations):
+            for name, batch in batches.items():
+                self.feed_input(name, batch)
+        self._pipe.Warmup(iterations)
+
+    def feed_input(self, data_node, data, layout = None, cuda_stream = None, use_copy_kernel = False,
+                   done_event = None):
         """Pass a mutlidimensional array or DLPack (or a list thereof) to an output of ExternalSource.
         In the case of the GPU input, the data must be modified on the same stream as the one
         used by feed_input. See ``cuda_stream`` parameter for details.
@@ -754,6 +1128,13 @@ Parameters
         use_copy_kernel : optional, `bool`
             If set to True, DALI will use a CUDA kernel to feed the data (only applicable when copying
             data to/from GPU memory) instead of cudaMemcpyAsync (default).
+
+        done_event : optional, `cudaEvent_t` or an object convertible to `cudaEvent_t`, e.g. `cupy.cuda.Event`, `torch.cuda.Event`
+            If set, the event is recorded once the data has been copied to DALI's internal buffer,
+            in the stream used for the copy. Waiting for it (or making another stream wait for it)
+            lets you reuse the memory without synchronizing the host.
+            It cannot be used when the data is passed without a copy (``no_copy=True``), as the
+            memory is then used until the outputs of the pipeline are consumed.
         """
         if not self._built:
             raise RuntimeError("Pipeline must be built first.")
@@ -772,6 +1153,9 @@ Parameters
             cuda_stream = None
         else:
             cuda_stream = types._raw_cuda_stream(cuda_stream)
+        done_event = types._raw_cuda_event(done_event)
+        if done_event is not None:
+            done_event = ctypes.c_void_p(done_event)
 
         def to_numpy(x):
             if types._is_mxnet_array(x):
@@ -789,7 +1173,8 @@ Parameters
                 _check_data_batch(data, self._max_batch_size, layout)
                 data = type(data)(data, layout)
 
-            self._pipe.SetExternalTLInput(name, data, ctypes.c_void_p(cuda_stream), use_copy_kernel)
+            self._pipe.SetExternalTLInput(name, data, ctypes.c_void_p(cuda_stream), use_copy_kernel,
+                                          done_event)
         elif isinstance(data, list):
             inputs = []
             checked = False
@@ -810,7 +1195,8 @@ Parameters
                 inputs.append(inp)
             assert all(isinstance(inp, type(inputs[0])) for inp in inputs), \
                    "Mixed input types are not support, all need to reside on the CPU or GPU"
-            self._pipe.SetExternalTensorInput(name, inputs, ctypes.c_void_p(cuda_stream), use_copy_kernel)
+            self._pipe.SetExternalTensorInput(name, inputs, ctypes.c_void_p(cuda_stream), use_copy_kernel,
+                                              done_event)
         else:
             info = CheckDLPackCapsule(data)
             if not info[0]:
@@ -822,7 +1208,8 @@ Parameters
             else:
                 data = to_numpy(data)
                 inp = Tensors.TensorListCPU(data, layout or "")
-            self._pipe.SetExternalTLInput(name, inp, ctypes.c_void_p(cuda_stream), use_copy_kernel)
+            self._pipe.SetExternalTLInput(name, inp, ctypes.c_void_p(cuda_stream), use_copy_kernel,
+                                          done_event)
 
     def _run_cpu(self):
         """Run CPU portion of the pipeline."""
@@ -905,13 +1292,35 @@ Parameters
             self._gpu_batches_to_consume -= 1
             return self._pipe.ShareOutputs()
 
+    def share_outputs_async(self):
+        """Returns the outputs of the pipeline without waiting for the GPU work producing them.
+
+        Works like :meth:`share_outputs`, but it blocks only until the work for the batch
+        has been issued. The GPU outputs must not be accessed before the returned event
+        completes - the consumer should wait for it in its own stream (e.g. with
+        ``cudaStreamWaitEvent``), so the handoff doesn't block the host.
+        Needs to be used together with :meth:`release_outputs`
+        and :meth:`schedule_run`
+
+        :return:
+            A tuple of a list of `TensorList` objects for respective pipeline outputs and
+            the handle (an integer) of the CUDA event to wait for, or None if there are no GPU
+            outputs
+        """
+        with self._check_api_type_scope(types.PipelineAPIType.SCHEDULED):
+            if self._batches_to_consume == 0 or self._gpu_batches_to_consume == 0:
+                raise StopIteration
+            self._batches_to_consume -= 1
+            self._gpu_batches_to_consume -= 1
+            return self._pipe.ShareOutputsAsync()
+
     # for the backward compatibility
     def _share_outputs(self):
         """Deprecated. Use :meth:`share_outputs` instead"""
         _show_deprecation_warning("_share_outputs", "share_outputs")
         self.share_outputs()
 
-    def release_outputs(self):
+    def release_outputs(self, consumer_event=None):
         """Release buffers returned by share_outputs calls.
 
         It helps in case when output call result is consumed (copied)
@@ -921,11 +1330,62 @@ Parameters
         results have been consumed.
         Needs to be used together with :meth:`schedule_run`
         and :meth:`share_outputs`
-        Should not be mixed with :meth:`run` in the same pipeline"""
+        Should not be mixed with :meth:`run` in the same pipeline
+
+        Parameters
+        ----------
+        consumer_event : int, optional, default = None
+            The handle of a CUDA event recorded after the work which uses the outputs.
+            If provided, the buffers are released immediately, but the pipeline doesn't
+            overwrite them before the event completes. The event can be recorded again
+            right after this call."""
         with self._check_api_type_scope(types.PipelineAPIType.SCHEDULED):
             if not self._built:
                 raise RuntimeError("Pipeline must be built first.")
-            return self._pipe.ReleaseOutputs()
+            return self._pipe.ReleaseOutputs(consumer_event)
+
+    def set_external_output_buffers(self, output_idx, buffers):
+        """Makes the GPU output ``output_idx`` be written directly to the given device buffers,
+        e.g. the static input tensors of a CUDA graph or the bindings of an inference engine,
+        instead of DALI's memory.
+
+        One buffer is needed for each output buffer of the stage producing the output (i.e.
+        ``prefetch_queue_depth``); each buffer is used by one of the output slots, so it's
+        not overwritten until the outputs stored in it are released. Compare the data pointer
+        of the output with the buffers to find out which one holds it. The output is written
+        to a buffer only when it fits there and its shape is known before the producing
+        operator runs - otherwise, it's returned in DALI's memory, as usual, and has to be copied.
+
+        The buffers apply to the iterations scheduled after the call. The pipeline keeps
+        the references to the buffers until they're replaced.
+
+        Parameters
+        ----------
+        output_idx : int
+            The index of the output.
+        buffers : list
+            Objects exposing ``__cuda_array_interface__`` (e.g. PyTorch or CuPy tensors),
+            which must be contiguous, or ``(pointer, size_in_bytes)`` tuples.
+            An empty list stops using the external buffers."""
+        if not self._built:
+            raise RuntimeError("Pipeline must be built first.")
+        import numpy as np
+
+        def as_raw(buf):
+            iface = getattr(buf, "__cuda_array_interface__", None)
+            if iface is None:
+                ptr, size = buf
+                return int(ptr), int(size)
+            if iface.get("strides") is not None:
+                raise ValueError("The external output buffers must be contiguous.")
+            size = np.dtype(iface["typestr"]).itemsize
+            for extent in iface["shape"]:
+                size *= extent
+            return iface["data"][0], size
+
+        raw = [as_raw(buf) for buf in buffers]
+        self._pipe.SetExternalOutputBuffers(output_idx, raw)
+        self._external_output_buffers[output_idx] = list(buffers)
 
     # for the backward compatibility
     def _release_outputs(self):
@@ -1044,7 +1504,43 @@ Parameters
         """
         return self._batches_to_consume == 0
 
-    def serialize(self, define_graph=None, filename=None):
+    def save_memory_hints(self, filename):
+        """Writes the output sizes observed so far to a file, which later runs can load with
+        :meth:`load_memory_hints`, so that they allocate the buffers up front.
+
+        The size of an output is the one not exceeded by 95% of its samples, so that a few
+        outliers don't inflate the memory usage. Requires a pipeline which was built with
+        ``enable_memory_stats=True`` and has already run some iterations.
+
+        Parameters
+        ----------
+        filename : str
+                Name of the file to which the hints are written.
+        """
+        if not self._built:
+            raise RuntimeError("Pipeline must be built first.")
+        self._pipe.SaveMemoryHints(filename)
+
+    def load_memory_hints(self, filename):
+        """Loads the memory hints saved with :meth:`save_memory_hints`. They are applied as
+        the ``bytes_per_sample_hint`` of the operators with the same names, unless the hints
+        set by the user are larger. Must be called before the pipeline is built.
+
+        The operators are matched by name, so the pipeline should be defined the same way
+        as the one which saved the hints, or have its operators named explicitly.
+
+        Parameters
+        ----------
+        filename : str
+                Name of the file with the hints.
+        """
+        if self._built:
+            raise RuntimeError("The memory hints can be loaded only before the pipeline is built.")
+        self._memory_hints_file = filename
+        if self._backend_prepared:
+            self._pipe.LoadMemoryHints(filename)
+
+    def serialize(self, define_graph=None, filename=None, memory_hints=False):
         """Serialize the pipeline to a Protobuf string.
 
         Additionally, you can pass file name, so that serialized pipeline will be written there.
@@ -1058,6 +1554,11 @@ Parameters
                 :meth:`set_outputs`.
         filename : str
                 File, from where serialized pipeline will be writeen.
+        memory_hints : bool
+                If True, the largest output sizes observed so far are stored as the
+                ``bytes_per_sample_hint`` of the operators, so the deserialized pipeline
+                allocates its buffers up front. Requires a pipeline which was built with
+                ``enable_memory_stats=True`` and has already run some iterations.
         kwargs : dict
                 Refer to Pipeline constructor for full list of arguments.
         """
@@ -1071,7 +1572,10 @@ Parameters
         if not self._backend_prepared:
             self._init_pipeline_backend()
             self._pipe.SetOutputNames(self._names_and_devices)
-        ret = self._pipe.SerializeToProtobuf()
+        if memory_hints:
+            ret = self._pipe.SerializeToProtobufWithMemoryHints()
+        else:
+            ret = self._pipe.SerializeToProtobuf()
         if filename is not None:
             with open(filename, 'wb') as pipeline_file:
                 pipeline_file.write(ret)
@@ -1130,6 +1634,19 @@ Parameters
                                          pipeline._exec_async)
         pipeline._pipe.SetQueueSizes(pipeline._cpu_queue_size, pipeline._gpu_queue_size)
         pipeline._pipe.EnableExecutorMemoryStats(pipeline._enable_memory_stats)
+        pipeline._pipe.EnableExecutorTimingStats(pipeline._enable_timing_stats)
+        pipeline._pipe.EnableOperatorFusion(kw.get("enable_op_fusion", False))
+        pipeline._pipe.EnableCudaGraphs(kw.get("enable_cuda_graphs", False))
+        pipeline._pipe.EnableCPUDataflow(kw.get("enable_cpu_dataflow", False))
+        pipeline._pipe.EnableCPUDepthFirst(kw.get("enable_cpu_depth_first", False))
+        pipeline._pipe.EnableConcurrentCPUIterations(
+            kw.get("enable_concurrent_cpu_iterations", False))
+        pipeline._pipe.EnableMemoryReuse(kw.get("enable_memory_reuse", False))
+        pipeline._pipe.EnableEarlyGPUSetup(kw.get("enable_early_gpu_setup", False))
+        pipeline._pipe.EnableSharedScratch(kw.get("enable_shared_scratch", False))
+        pipeline._pipe.EnableLowLatency(kw.get("enable_low_latency", False))
+        pipeline._pipe.EnableSharedThreadPool(kw.get("share_thread_pool", False))
+        pipeline._pipe.SetThreadPoolWeight(kw.get("thread_pool_weight", 1.0))
         pipeline._backend_prepared = True
         pipeline._pipe.Build()
         pipeline._built = True
@@ -1156,7 +1673,21 @@ Parameters
                                 self._default_cuda_stream_priority)
         self._pipe.SetExecutionTypes(self._exec_pipelined, self._exec_separated, self._exec_async)
         self._pipe.SetQueueSizes(self._cpu_queue_size, self._gpu_queue_size)
+        if self._min_queue_sizes is not None:
+            self._pipe.SetAdaptiveQueueSizes(*self._min_queue_sizes)
         self._pipe.EnableExecutorMemoryStats(self._enable_memory_stats)
+        self._pipe.EnableExecutorTimingStats(self._enable_timing_stats)
+        self._pipe.EnableOperatorFusion(self._enable_op_fusion)
+        self._pipe.EnableCudaGraphs(self._enable_cuda_graphs)
+        self._pipe.EnableCPUDataflow(self._enable_cpu_dataflow)
+        self._pipe.EnableCPUDepthFirst(self._enable_cpu_depth_first)
+        self._pipe.EnableConcurrentCPUIterations(self._enable_concurrent_cpu_iterations)
+        self._pipe.EnableMemoryReuse(self._enable_memory_reuse)
+        self._pipe.EnableEarlyGPUSetup(self._enable_early_gpu_setup)
+        self._pipe.EnableSharedScratch(self._enable_shared_scratch)
+        self._pipe.EnableLowLatency(self._enable_low_latency)
+        self._pipe.EnableSharedThreadPool(self._share_thread_pool)
+        self._pipe.SetThreadPoolWeight(self._thread_pool_weight)
         self._backend_prepared = True
         self._pipe.Build()
         self._built = True
@@ -58,8 +58,74 @@ def _get_shape_view(shapes_ptr, ndims_ptr, num_dims, num_samples):
         l.append(d)
     return l
 
+# CUDA kernels compiled for the GPU operator, keyed by the run function, the signature
+# and the device - the handles are valid only in the context of the device they were loaded in
+_cuda_kernels = {}
+
+def _cuda_kernel_sig():
+    return numba_types.void(numba_types.uint64, numba_types.uint64,
+                            numba_types.int32, numba_types.int32)
+
+def _cuda_kernel_source(types, ndims):
+    """Generates a kernel, which invokes `run_fn` for the sample given by `blockIdx.y`.
+
+    `ptrs_addr` points to the per-sample pointers of the outputs followed by the inputs and
+    `shapes_addr` to their shapes, padded to `max_ndim` dimensions - both in device memory.
+    """
+    n = len(types)
+    lines = [
+        "def kernel(ptrs_addr, shapes_addr, num_samples, max_ndim):",
+        "    sample_idx = cuda.blockIdx.y",
+        "    ptrs = carray(address_as_void_pointer(ptrs_addr), ({}, num_samples), dtype=np.uint64)".format(n),
+        "    shapes = carray(address_as_void_pointer(shapes_addr), ({}, num_samples, max_ndim), dtype=np.int64)".format(n),
+    ]
+    for slot, (dtype, ndim) in enumerate(zip(types, ndims)):
+        shape = "(" + "".join("shapes[{}, sample_idx, {}], ".format(slot, d) for d in range(ndim)) + ")"
+        lines.append("    arg{} = carray(address_as_void_pointer(ptrs[{}, sample_idx]), {}, dtype=np.{})".format(
+            slot, slot, shape, _to_numpy[dtype]))
+    lines.append("    run_fn(" + ", ".join("arg{}".format(slot) for slot in range(n)) + ")")
+    return "\n".join(lines)
+
+def _cufunc_handle(kernel, sig):
+    if hasattr(kernel, 'overloads'):
+        kernel = kernel.overloads[sig.args]
+    if hasattr(kernel, '_codelibrary'):
+        cufunc = kernel._codelibrary.get_cufunc()
+    else:
+        cufunc = kernel._func.get()
+    handle = cufunc.handle
+    return handle.value if hasattr(handle, 'value') else int(handle)
+
+def _get_cuda_kernel(run_fn, out_types, in_types, outs_ndim, ins_ndim, device_id):
+    """Compiles `run_fn` into a CUDA kernel and returns the handle of the kernel (a CUfunction).
+
+    The kernels are cached, so the pipelines using the same function with the same types and
+    numbers of dimensions don't compile it again.
+    """
+    from numba import cuda
+    key = (run_fn, tuple(out_types), tuple(in_types), tuple(outs_ndim), tuple(ins_ndim), device_id)
+    cached = _cuda_kernels.get(key)
+    if cached is not None:
+        return cached[1]
+    with cuda.gpus[device_id]:
+        scope = {
+            'cuda': cuda,
+            'carray': carray,
+            'np': np,
+            'address_as_void_pointer': address_as_void_pointer,
+            'run_fn': cuda.jit(device=True)(run_fn),
+        }
+        exec(_cuda_kernel_source(out_types + in_types, outs_ndim + ins_ndim), scope)
+        sig = _cuda_kernel_sig()
+        kernel = cuda.jit(sig)(scope['kernel'])
+        handle = _cufunc_handle(kernel, sig)
+    # the kernel object keeps the module with the function loaded
+    _cuda_kernels[key] = (kernel, handle)
+    return handle
+
 class NumbaFunction(metaclass=ops._DaliOperatorMeta):
     ops.register_cpu_op('NumbaFunction')
+    ops.register_gpu_op('NumbaFunction')
 
     @property
     def spec(self):
@@ -146,7 +212,11 @@ class NumbaFunction(metaclass=ops._DaliOperatorMeta):
                        "Python Operators do not support Multiple Input Sets.")
                       .format(type(inp).__name__))
         op_instance = ops._OperatorInstance(inputs, self, **kwargs)
-        op_instance.spec.AddArg("run_fn", self.run_fn)
+        run_fn = self.run_fn
+        if self._device == 'gpu':
+            run_fn = _get_cuda_kernel(self._cuda_run_fn, self.out_types, self.in_types,
+                                      self.outs_ndim, self.ins_ndim, pipeline.device_id)
+        op_instance.spec.AddArg("run_fn", run_fn)
         if self.setup_fn != None:
             op_instance.spec.AddArg("setup_fn", self.setup_fn)
         op_instance.spec.AddArg("out_types", self.out_types)
@@ -155,6 +225,8 @@ class NumbaFunction(metaclass=ops._DaliOperatorMeta):
         op_instance.spec.AddArg("ins_ndim", self.ins_ndim)
         op_instance.spec.AddArg("device", self.device)
         op_instance.spec.AddArg("batch_processing", self.batch_processing)
+        op_instance.spec.AddArg("threads_per_block", self.threads_per_block)
+        op_instance.spec.AddArg("blocks_per_sample", self.blocks_per_sample)
 
         if self.num_outputs == 0:
             t_name = self._impl_name + "_id_" + str(op_instance.id) + "_sink"
@@ -175,7 +247,8 @@ class NumbaFunction(metaclass=ops._DaliOperatorMeta):
             outputs.append(t)
         return outputs[0] if len(outputs) == 1 else outputs
 
-    def __init__(self, run_fn, out_types, in_types, outs_ndim, ins_ndim, setup_fn=None, device='cpu', batch_processing=False, **kwargs):
+    def __init__(self, run_fn, out_types, in_types, outs_ndim, ins_ndim, setup_fn=None, device='cpu', batch_processing=False,
+                 threads_per_block=256, blocks_per_sample=0, **kwargs):
         assert len(in_types) == len(ins_ndim), "Number of input types and input dimensions should match."
         assert len(out_types) == len(outs_ndim), "Number of output types and output dimensions should match."
         if not isinstance(outs_ndim, list):
@@ -197,6 +270,19 @@ class NumbaFunction(metaclass=ops._DaliOperatorMeta):
                 setup_fn(out_shapes_np, in_shapes_np)
             setup_fn_address = setup_cfunc.address
 
+        self.threads_per_block = threads_per_block
+        self.blocks_per_sample = blocks_per_sample
+        self._cuda_run_fn = None
+        if device == 'gpu':
+            if batch_processing:
+                raise ValueError("Batch processing is not supported by the GPU NumbaFunction.")
+            # the kernel is compiled when the operator is called - for the device of the pipeline
+            self._cuda_run_fn = run_fn
+            self._init_common(setup_fn_address, out_types, in_types, outs_ndim, ins_ndim, device,
+                              batch_processing, kwargs)
+            self.run_fn = None
+            return
+
         out0_lambda, out1_lambda, out2_lambda, out3_lambda, out4_lambda, out5_lambda = self._get_carrays_eval_lambda(out_types, outs_ndim)
         in0_lambda, in1_lambda, in2_lambda, in3_lambda, in4_lambda, in5_lambda = self._get_carrays_eval_lambda(in_types, ins_ndim)
         run_fn = njit(run_fn)
@@ -274,6 +360,12 @@ class NumbaFunction(metaclass=ops._DaliOperatorMeta):
 
                 run_fn_lambda(run_fn, out0, out1, out2, out3, out4, out5, in0, in1, in2, in3, in4, in5)
 
+        self._init_common(setup_fn_address, out_types, in_types, outs_ndim, ins_ndim, device,
+                          batch_processing, kwargs)
+        self.run_fn = run_cfunc.address
+
+    def _init_common(self, setup_fn_address, out_types, in_types, outs_ndim, ins_ndim, device,
+                     batch_processing, kwargs):
         self._impl_name = "NumbaFuncImpl"
         self._schema = _b.GetSchema(self._impl_name)
         self._spec = _b.OpSpec(self._impl_name)
@@ -284,7 +376,6 @@ class NumbaFunction(metaclass=ops._DaliOperatorMeta):
         for key, value in kwargs.items():
             self._spec.AddArg(key, value)
 
-        self.run_fn = run_cfunc.address
         self.setup_fn = setup_fn_address
         self.out_types = out_types
         self.in_types = in_types
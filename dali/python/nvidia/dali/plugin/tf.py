@@ -848,6 +848,78 @@ else:
 
     _load_experimental_dataset()
 
+_experimental_distribute_docstring = """Creates a distributed dataset with one DALIDataset
+per replica of the ``strategy``.
+
+Each replica gets its own DALI pipeline, created by ``pipeline_fn`` on the device of that
+replica, and reading its own shard of the data. The datasets are placed on the replica devices
+and their outputs are not fetched to the devices again, so the tensors produced by DALI are
+passed to the replicas as they are, without additional copies.
+
+This is a convenience wrapper for ``strategy.distribute_datasets_from_function`` with
+the ``tf.distribute.InputOptions`` required for DALI.
+
+Parameters
+----------
+strategy : tf.distribute.Strategy
+    The strategy that the dataset is distributed with, for example
+    ``tf.distribute.MirroredStrategy``.
+pipeline_fn : callable
+    Called as ``pipeline_fn(device_id, shard_id, num_shards)`` for every replica, it must
+    return the :class:`nvidia.dali.Pipeline` for that replica. ``device_id`` is the id of
+    the GPU of the replica or None for CPU replicas, while ``shard_id`` and ``num_shards``
+    should be passed to the readers of the pipeline.
+**dataset_kwargs
+    Passed to :class:`DALIDataset`. By default, ``batch_size``, ``num_threads`` and
+    ``device_id`` are taken from the pipeline returned by ``pipeline_fn``.
+
+Returns
+-------
+A ``tf.distribute.DistributedDataset`` with per-replica values.
+"""
+
+
+if dataset_distributed_compatible_tensorflow():
+    def _load_experimental_distribute():
+        def distribute_dataset(strategy, pipeline_fn, **dataset_kwargs):
+            def dataset_fn(input_context):
+                # The dataset function is called on the device of the replica
+                device_spec = _get_current_device_spec()
+                if device_spec.device_type == "GPU":
+                    device_id = device_spec.device_index or 0
+                else:
+                    device_id = None
+                pipeline = pipeline_fn(device_id, input_context.input_pipeline_id,
+                                       input_context.num_input_pipelines)
+                kwargs = {
+                    'batch_size': pipeline.max_batch_size,
+                    'num_threads': pipeline.num_threads,
+                    'device_id': pipeline.device_id,
+                }
+                kwargs.update(dataset_kwargs)
+                return DALIDataset(pipeline, **kwargs)
+
+            input_options = tf.distribute.InputOptions(
+                experimental_place_dataset_on_device=True,
+                experimental_fetch_to_device=False,
+                experimental_replication_mode=tf.distribute.InputReplicationMode.PER_REPLICA)
+            return strategy.distribute_datasets_from_function(dataset_fn, input_options)
+
+        distribute_dataset.__doc__ = _experimental_distribute_docstring
+        _insert_experimental_member(distribute_dataset, "distribute_dataset")
+
+else:
+    def _load_experimental_distribute():
+        def distribute_dataset(*args, **kwargs):
+            raise RuntimeError(
+                'experimental.distribute_dataset is not supported for detected version of '
+                'TensorFlow. It supports versions: 2.5.0 and above.')
+
+        distribute_dataset.__doc__ = _experimental_distribute_docstring
+        _insert_experimental_member(distribute_dataset, "distribute_dataset")
+
+_load_experimental_distribute()
+
 DALIDataset.__doc__ = """Creates a ``DALIDataset`` compatible with
     `tf.data.Dataset <https://www.tensorflow.org/api_docs/python/tf/data/Dataset>`_ from a DALI
     pipeline. It supports TensorFlow 1.15 and 2.x family.
@@ -303,6 +303,16 @@ def _raw_cuda_stream(stream_obj):
     else:
         return stream_obj
 
+def _raw_cuda_event(event_obj):
+    if event_obj is None:
+        return None
+    elif hasattr(event_obj, "cuda_event"):  # torch
+        return event_obj.cuda_event
+    elif hasattr(event_obj, "ptr"):  # cupy
+        return event_obj.ptr
+    else:
+        return event_obj
+
 _cupy_array_type_regex = re.compile('.*cupy\..*\.ndarray.*')
 
 def _is_cupy_array(value):
@@ -334,6 +344,7 @@ _type_name_to_dali_type = {
 
     'half'    : DALIDataType.FLOAT16,
     'float16' : DALIDataType.FLOAT16,
+    'bfloat16': DALIDataType.BFLOAT16,
     'float'   : DALIDataType.FLOAT,
     'float32' : DALIDataType.FLOAT,
     'float64' : DALIDataType.FLOAT64,
@@ -0,0 +1,89 @@
+# Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from nvidia.dali import fn, pipeline_def
+import nvidia.dali.types as types
+import numpy as np
+import io
+import os
+import tarfile
+import tempfile
+from subprocess import call
+from nose.tools import assert_equal
+
+tar2shard_script = "../../../tools/tar2shard.py"
+batch_size = 4
+num_samples = 10
+
+
+def create_archive(path):
+    rng = np.random.default_rng(42)
+    samples = []
+    with tarfile.open(path, "w") as tar:
+        for i in range(num_samples):
+            data = rng.integers(0, 255, size=rng.integers(1, 10000), dtype=np.uint8).tobytes()
+            array = rng.random((i + 1, 3), dtype=np.float32)
+            label = np.int32(i)
+            components = [("bin", data), ("npy", array)]
+            # the label is missing in the last sample
+            if i < num_samples - 1:
+                components.append(("cls", label.tobytes()))
+            for ext, value in components:
+                buffer = io.BytesIO()
+                if ext == "npy":
+                    np.save(buffer, value)
+                else:
+                    buffer.write(value)
+                info = tarfile.TarInfo(f"sample{i:03}.{ext}")
+                info.size = buffer.tell()
+                buffer.seek(0)
+                tar.addfile(info, buffer)
+            samples.append((data, array, label if i < num_samples - 1 else None))
+    return samples
+
+
+@pipeline_def(batch_size=batch_size, num_threads=3, device_id=None)
+def shard_pipe(path, use_o_direct, dont_use_mmap):
+    return fn.experimental.readers.aligned_shard(
+        paths=[path], ext=["bin", "npy", "cls"], dtypes=[types.UINT8, types.UINT8, types.INT32],
+        use_o_direct=use_o_direct, dont_use_mmap=dont_use_mmap)
+
+
+def check_reader(use_o_direct, dont_use_mmap):
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        archive = os.path.join(tmp_dir, "data.tar")
+        shard = os.path.join(tmp_dir, "data.shard")
+        samples = create_archive(archive)
+        assert_equal(call([tar2shard_script, archive, shard], stdout=open(os.devnull, "wb")), 0)
+
+        pipe = shard_pipe(shard, use_o_direct, dont_use_mmap)
+        pipe.build()
+        for it in range(2 * num_samples // batch_size):
+            data, arrays, labels = pipe.run()
+            for i in range(batch_size):
+                ref_data, ref_array, ref_label = samples[(it * batch_size + i) % num_samples]
+                np.testing.assert_array_equal(np.frombuffer(ref_data, dtype=np.uint8),
+                                              data.at(i))
+                # the arrays are stored with their type and shape
+                np.testing.assert_array_equal(ref_array, arrays.at(i))
+                if ref_label is None:
+                    assert_equal(labels.at(i).size, 0)
+                else:
+                    np.testing.assert_array_equal([ref_label], labels.at(i))
+
+
+def test_reader():
+    for use_o_direct in [False, True]:
+        for dont_use_mmap in [False, True]:
+            yield check_reader, use_o_direct, dont_use_mmap
@@ -128,3 +128,23 @@ def test_tensor_cpu_squeeze():
              (0, (1, 5, 1), "ABC", "BC"),
              (None, (3, 5, 1), "ABC", "AB")]:
         yield check_squeeze, shape, dim, in_layout, expected_out_layout
+
+def test_tensorlist_as_arrays_cpu():
+    import nvidia.dali.fn as fn
+    batches = [[np.full((i + 1, 3), 10 * it + i, dtype=np.int32) for i in range(4)]
+               for it in range(2)]
+    pipe = Pipeline(batch_size=4, num_threads=1, device_id=None)
+    with pipe:
+        pipe.set_outputs(fn.external_source(source=batches, cycle=True))
+    pipe.build()
+    out, = pipe.run()
+    arrays = out.as_arrays()
+    # the arrays keep their data when the pipeline writes the next iteration
+    pipe.run()
+    assert len(arrays) == 4
+    for arr, ref in zip(arrays, batches[0]):
+        assert_array_equal(arr, ref)
+    # a list that doesn't own its memory is copied
+    tensorlist = TensorListCPU(np.random.rand(3, 5, 6), "HWC")
+    for arr, sample in zip(tensorlist.as_arrays(), tensorlist.as_array()):
+        assert_array_equal(arr, sample)
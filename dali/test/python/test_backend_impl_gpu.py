@@ -284,4 +284,31 @@ def test_tensor_from_tensor_list_gpu():
         ts = [t for t in create_tl(i)]
         out += ts
     for i, t in enumerate(out):
-        np.testing.assert_array_equal(np.array(t.as_cpu()), np.full((4,), i // 3))
\ No newline at end of file
+        np.testing.assert_array_equal(np.array(t.as_cpu()), np.full((4,), i // 3))
+
+def test_device_memory_stats():
+    ResetDeviceMemoryPeak()
+    arr = np.random.rand(16, 1024, 256)
+    pipe = ExternalSourcePipe(arr.shape[0], arr)
+    pipe.build()
+    out, = pipe.run()
+    stats = GetDeviceMemoryStats()
+    if stats is None:
+        return  # the memory pool is disabled
+    assert stats["in_use"] >= arr.nbytes
+    assert stats["peak_in_use"] >= stats["in_use"]
+    assert stats["reserved"] >= stats["in_use"]
+
+def test_release_unused_memory():
+    arr = np.random.rand(16, 1024, 256)
+    pipe = ExternalSourcePipe(arr.shape[0], arr)
+    pipe.build()
+    out, = pipe.run()
+    del out
+    del pipe
+    ReleaseUnusedMemory(release_caches=True)
+    stats = GetDeviceMemoryStats()
+    if stats is None:
+        return  # the memory pool is disabled
+    assert stats["pending_free"] == 0
+    assert stats["reserved"] >= stats["in_use"]
@@ -1142,6 +1142,7 @@ excluded_methods = [
     "readers.video",        # not supported for CPU
     "readers.video_resize", # not supported for CPU
     "optical_flow",         # not supported for CPU
+    "log_mel_filter_bank",  # not supported for CPU
 ]
 
 def test_coverage():
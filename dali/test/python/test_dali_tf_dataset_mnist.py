@@ -95,6 +95,17 @@ def get_dataset_multi_gpu(strategy):
     return train_dataset
 
 
+def get_dataset_distributed(strategy):
+    def pipeline_fn(device_id, shard_id, num_shards):
+        return mnist_pipeline(4, data_path, 'gpu', device_id, shard_id, num_shards)
+
+    return dali_tf.experimental.distribute_dataset(
+        strategy,
+        pipeline_fn,
+        output_shapes=((BATCH_SIZE, IMAGE_SIZE, IMAGE_SIZE), (BATCH_SIZE,)),
+        output_dtypes=(tf.float32, tf.int32))
+
+
 def keras_model():
     model = tf.keras.models.Sequential([
         tf.keras.layers.Input(shape=(IMAGE_SIZE, IMAGE_SIZE), name='images'),
@@ -73,6 +73,25 @@ def test_keras_multi_gpu_mirrored_strategy():
         steps=ITERATIONS)[1] > TARGET
 
 
+@with_setup(skip_for_incompatible_tf)
+def test_keras_multi_gpu_distribute_dataset():
+    strategy = tf.distribute.MirroredStrategy(devices=available_gpus())
+
+    with strategy.scope():
+        model = keras_model()
+
+    train_dataset = get_dataset_distributed(strategy)
+
+    model.fit(
+        train_dataset,
+        epochs=EPOCHS,
+        steps_per_epoch=ITERATIONS)
+
+    assert model.evaluate(
+        train_dataset,
+        steps=ITERATIONS)[1] > TARGET
+
+
 @with_setup(clear_checkpoints, clear_checkpoints)
 def test_estimators_single_gpu():
     run_estimators_single_device('gpu', 0)
@@ -810,7 +810,7 @@ def test_nonsilent_region():
         return pipe
 
     check_pipeline(generate_data(31, 13, array_1d_shape_generator, lo=0, hi=255, dtype=np.uint8),
-                   pipe, devices=['cpu'])
+                   pipe)
 
 
 def test_mel_filter_bank():
@@ -826,6 +826,19 @@ def test_mel_filter_bank():
     check_pipeline(generate_data(31, 13, array_1d_shape_generator), pipe)
 
 
+def test_log_mel_filter_bank():
+    def pipe(max_batch_size, input_data, device):
+        pipe = Pipeline(batch_size=max_batch_size, num_threads=4, device_id=0)
+        with pipe:
+            data = fn.external_source(source=input_data, cycle=False, device=device)
+            spectrum = fn.spectrogram(data, nfft=60, window_length=50, window_step=25)
+            processed = fn.log_mel_filter_bank(spectrum, normalize_features=True)
+            pipe.set_outputs(processed)
+        return pipe
+
+    check_pipeline(generate_data(31, 13, array_1d_shape_generator), pipe, devices=['gpu'])
+
+
 def test_mfcc():
     def pipe(max_batch_size, input_data, device):
         pipe = Pipeline(batch_size=max_batch_size, num_threads=4, device_id=0)
@@ -1114,6 +1127,7 @@ tested_methods = [
     "reductions.std_dev",
     "reductions.variance",
     "mel_filter_bank",
+    "log_mel_filter_bank",
     "constant",
     "mfcc",
     "bbox_paste",
@@ -109,10 +109,11 @@ class LoadingPipeline(CommonPipeline):
 
 
 class DLTensorOpPipeline(CommonPipeline):
-    def __init__(self, function, device, synchronize=True):
+    def __init__(self, function, device, synchronize=True, stream_ordered=False):
         super(DLTensorOpPipeline, self).__init__(device)
         self.op = ops.DLTensorPythonFunction(function=function, device=device, num_outputs=2,
-                                             synchronize_stream=synchronize)
+                                             synchronize_stream=synchronize,
+                                             stream_ordered=stream_ordered)
 
     def define_graph(self):
         im = self.load()
@@ -135,9 +136,9 @@ def pytorch_wrapper(fun):
     return lambda in1, in2: pytorch_adapter(fun, in1, in2)
 
 
-def common_case(wrapped_fun, device, compare, synchronize=True):
+def common_case(wrapped_fun, device, compare, synchronize=True, stream_ordered=False):
     load_pipe = LoadingPipeline(device)
-    op_pipe = DLTensorOpPipeline(wrapped_fun, device, synchronize)
+    op_pipe = DLTensorOpPipeline(wrapped_fun, device, synchronize, stream_ordered)
 
     load_pipe.build()
     op_pipe.build()
@@ -319,3 +320,19 @@ def test_cupy():
 def test_cupy_kernel_gray_scale():
     setup_cupy()
     cupy_case(cupy_kernel_gray_scale, synchronize=False)
+
+
+def cupy_adapter_stream_ordered(fun, in1, in2, stream):
+    with cupy.cuda.ExternalStream(stream.ptr):
+        tin1 = [cupy.fromDlpack(dltensor) for dltensor in in1]
+        tin2 = [cupy.fromDlpack(dltensor) for dltensor in in2]
+        tout1, tout2 = fun(tin1, tin2)
+        return [tout.toDlpack() for tout in tout1], \
+               [tout.toDlpack() for tout in tout2]
+
+
+def test_cupy_stream_ordered():
+    setup_cupy()
+    for testcase in [cupy_simple, cupy_kernel_square_diff]:
+        wrapped = lambda in1, in2, stream, fun=testcase: cupy_adapter_stream_ordered(fun, in1, in2, stream)
+        yield common_case, wrapped, 'gpu', partial(cupy_compare, testcase), False, True
@@ -33,9 +33,11 @@ def recursive_equals(left, right, top_level=True):
     np.testing.assert_array_equal(left, right)
 
 
-def check_serialize_deserialize(indexed_batch):
+def check_serialize_deserialize(indexed_batch, binary_meta=None):
     mem_chunk = sb.SharedMemChunk("chunk_0", 100)
     shared_batch_meta = sb.write_batch(mem_chunk, indexed_batch)
+    if binary_meta is not None:
+        assert shared_batch_meta.binary_meta == binary_meta
     deserlized_indexed_batch = sb.deserialize_batch(mem_chunk.shm_chunk, shared_batch_meta)
     assert len(indexed_batch) == len(
         deserlized_indexed_batch), "Lengths before and after should be the same"
@@ -60,3 +62,13 @@ def test_serialize_deserialize_random():
                     break
                 indexed_batch = [(i, sample) for i, sample in enumerate(batch)]
                 yield check_serialize_deserialize, indexed_batch
+
+
+def test_serialize_deserialize_multiple_outputs():
+    sample = (np.full((10, 20), 42, dtype=np.uint8), np.array(3.5, dtype=np.float32), np.arange(7, dtype=np.int64))
+    yield check_serialize_deserialize, [(i, sample) for i in range(3)], True
+    # nested structures and non-native byte order use the pickled meta data
+    nested = (sample[0], (sample[1], sample[2]))
+    yield check_serialize_deserialize, [(i, nested) for i in range(3)], False
+    big_endian = np.arange(5, dtype='>i4')
+    yield check_serialize_deserialize, [(0, big_endian)], False
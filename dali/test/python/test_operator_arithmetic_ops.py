@@ -14,6 +14,7 @@
 
 from nvidia.dali.pipeline import Pipeline, DataNode
 import nvidia.dali.ops as ops
+import nvidia.dali.fn as fn
 import nvidia.dali.types as types
 import nvidia.dali.math as math
 from nvidia.dali.tensors import TensorListGPU
@@ -686,6 +687,28 @@ def test_bitwise_disallowed():
                 if types_in[0] in float_types or types_in[1] in float_types:
                     yield check_raises_re, kinds, types_in, op, shape_small, op_desc, error_msg
 
+def check_fused_expression(device):
+    np.random.seed(42)
+    data = [[np.random.randint(-100, 100, size=shape, dtype=np.int32) for shape in shape_small]
+            for _ in range(3)]
+    pipe = Pipeline(batch_size, 2, 0)
+    with pipe:
+        a, b, c = (fn.external_source(source=[d], cycle=True, device=device) for d in data)
+        pipe.set_outputs((a - b) * 0.5 + a * c)
+    pipe.build()
+    arithm_ops = [op for op in pipe._ops if isinstance(op._op, ops.ArithmeticGenericOp)]
+    assert_equals(len(arithm_ops), 1)
+    out, = pipe.run()
+    if device == "gpu":
+        out = out.as_cpu()
+    for sample in range(batch_size):
+        a_np, b_np, c_np = (d[sample] for d in data)
+        np.testing.assert_allclose(out.at(sample), (a_np - b_np) * 0.5 + a_np * c_np, rtol=1e-6)
+
+def test_fused_expression():
+    for device in ["cpu", "gpu"]:
+        yield check_fused_expression, device
+
 def test_prohibit_min_max():
     for kinds in bin_input_kinds:
         for op, op_desc in [(min, "min"), (max, "max")]:
@@ -92,6 +92,31 @@ def test_permute_batch_fixed():
     for device in ["cpu", "gpu"]:
         yield _test_permute_batch_fixed, device
 
+def _test_permute_batch_views(device, idxs):
+    # the output can be a view of the input - check that it's valid downstream and that
+    # the input isn't overwritten while it's in use
+    batch_size = 10
+    pipe = Pipeline(batch_size, 4, 0, prefetch_queue_depth=2)
+    data = fn.external_source(source=lambda: gen_data(batch_size, np.int32), device=device, layout="abc")
+    permuted = fn.permute_batch(data, indices=idxs)
+    pipe.set_outputs(data, permuted, permuted + 1)
+    pipe.build()
+
+    for i in range(10):
+        orig, permuted, plus_one = pipe.run()
+        if isinstance(orig, dali.backend.TensorListGPU):
+            orig = orig.as_cpu()
+        ref = [orig.at(idx) for idx in idxs]
+        check_batch(permuted, ref, len(ref), 0, 0, "abc")
+        check_batch(plus_one, [r + 1 for r in ref], len(ref), 0, 0, "abc")
+
+def test_permute_batch_views():
+    identity = list(range(10))
+    repeated = [3, 3, 3, 0, 0, 9, 9, 9, 1, 1]
+    for device in ["cpu", "gpu"]:
+        for idxs in [identity, repeated]:
+            yield _test_permute_batch_views, device, idxs
+
 
 @raises(RuntimeError)
 def _test_permute_batch_out_of_range(device):
@@ -0,0 +1,68 @@
+# Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from nvidia.dali import fn, pipeline_def
+import nvidia.dali.types as types
+import numpy as np
+import os
+import tempfile
+from nose_utils import assert_raises
+from test_utils import get_dali_extra_path
+
+images_dir = os.path.join(get_dali_extra_path(), 'db', 'single', 'jpeg')
+batch_size = 10
+
+
+@pipeline_def
+def resize_pipe(cache_type, cache_dir):
+    jpegs, labels = fn.readers.file(file_root=images_dir, name="Reader")
+    images = fn.decoders.image(jpegs, device="mixed", output_type=types.RGB)
+    images = fn.resize(images, resize_x=64, resize_y=48)
+    if cache_type is not None:
+        images = fn.experimental.cache(images, source=jpegs, cache_type=cache_type,
+                                       cache_dir=cache_dir)
+    return fn.flip(images, horizontal=labels % 2), labels
+
+
+def check_cache(cache_type):
+    with tempfile.TemporaryDirectory() as cache_dir:
+        pipes = [resize_pipe(cache_type=t, cache_dir=cache_dir, batch_size=batch_size,
+                             num_threads=3, device_id=0) for t in [None, cache_type]]
+        for pipe in pipes:
+            pipe.build()
+        epoch_size = pipes[0].epoch_size("Reader")
+        # the first epoch fills the cache, the next ones read from it
+        for _ in range(3 * epoch_size // batch_size):
+            (ref_images, ref_labels), (images, labels) = [pipe.run() for pipe in pipes]
+            ref_images, images = ref_images.as_cpu(), images.as_cpu()
+            for i in range(batch_size):
+                np.testing.assert_array_equal(ref_labels.at(i), labels.at(i))
+                np.testing.assert_array_equal(ref_images.at(i), images.at(i))
+
+
+def test_cache():
+    for cache_type in ["device", "host", "disk"]:
+        yield check_cache, cache_type
+
+
+def test_random_input():
+    @pipeline_def(batch_size=batch_size, num_threads=3, device_id=0)
+    def pipe():
+        jpegs, _ = fn.readers.file(file_root=images_dir)
+        images = fn.decoders.image(jpegs, device="mixed")
+        images = fn.crop(images, crop=(32, 32), crop_pos_x=fn.random.uniform(range=(0, 1)))
+        return fn.experimental.cache(images, source=jpegs)
+
+    with assert_raises(RuntimeError, glob="*but its results are not determined by its inputs*"):
+        pipe().build()
@@ -14,6 +14,7 @@
 
 from nvidia.dali.pipeline import Pipeline
 import nvidia.dali.ops as ops
+import nvidia.dali.fn as fn
 import nvidia.dali.types as types
 import numpy as np
 import os
@@ -63,3 +64,50 @@ def test_color_twist_vs_cpu():
     compare_pipelines(ColorTwistPipeline(batch_size, seed, iter(rand_it1), kind="new"),
                       ColorTwistPipeline(batch_size, seed, iter(rand_it2), kind="oldCpu"),
                       batch_size=batch_size, N_iterations=3, eps=1)
+
+
+def check_sequence_per_frame(device, batch_size, num_frames):
+    rng = np.random.default_rng(1234)
+    sequences = [rng.integers(0, 256, size=(num_frames, 40, 30, 3), dtype=np.uint8)
+                 for _ in range(batch_size)]
+    hues = [rng.uniform(-30, 30, size=num_frames).astype(np.float32) for _ in range(batch_size)]
+    sats = [rng.uniform(0, 2, size=num_frames).astype(np.float32) for _ in range(batch_size)]
+    contrast = [np.array(rng.uniform(0, 2), dtype=np.float32) for _ in range(batch_size)]
+
+    def twist(data, hue, sat, con, layout):
+        imgs = fn.external_source(source=[data], layout=layout)
+        if device == "gpu":
+            imgs = imgs.gpu()
+        return fn.color_twist(imgs, device=device,
+                              hue=fn.external_source(source=[hue]),
+                              saturation=fn.external_source(source=[sat]),
+                              contrast=fn.external_source(source=[con]))
+
+    seq_pipe = Pipeline(batch_size, 1, 0)
+    with seq_pipe:
+        seq_pipe.set_outputs(twist(sequences, hues, sats, contrast, "FHWC"))
+    frames = [frame for seq in sequences for frame in seq]
+    frame_hues = [np.array(h, dtype=np.float32) for seq in hues for h in seq]
+    frame_sats = [np.array(s, dtype=np.float32) for seq in sats for s in seq]
+    frame_cons = [c for c in contrast for _ in range(num_frames)]
+    frame_pipe = Pipeline(batch_size * num_frames, 1, 0)
+    with frame_pipe:
+        frame_pipe.set_outputs(twist(frames, frame_hues, frame_sats, frame_cons, "HWC"))
+    seq_pipe.build()
+    frame_pipe.build()
+    seq_out, = seq_pipe.run()
+    frame_out, = frame_pipe.run()
+    if device == "gpu":
+        seq_out = seq_out.as_cpu()
+        frame_out = frame_out.as_cpu()
+    for i in range(batch_size):
+        seq = np.array(seq_out[i])
+        assert seq.shape == sequences[i].shape
+        for f in range(num_frames):
+            np.testing.assert_array_equal(seq[f], np.array(frame_out[i * num_frames + f]))
+
+
+def test_color_twist_sequence_per_frame():
+    for device in ["cpu", "gpu"]:
+        for batch_size, num_frames in [(1, 1), (3, 4), (5, 7)]:
+            yield check_sequence_per_frame, device, batch_size, num_frames
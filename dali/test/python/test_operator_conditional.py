@@ -0,0 +1,95 @@
+# Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import nvidia.dali as dali
+import nvidia.dali.fn as fn
+from nvidia.dali.pipeline import Pipeline
+import numpy as np
+from test_utils import check_batch
+from nose.tools import raises
+
+def random_sample():
+    shape = np.random.randint(1, 20, [3])
+    return np.random.randint(0, 255, shape).astype(np.uint8)
+
+def gen_data(batch_size):
+    return [random_sample() for _ in range(batch_size)]
+
+def gen_predicate(batch_size, p):
+    return [np.array(np.random.random() < p) for _ in range(batch_size)]
+
+def as_cpu(batch):
+    if isinstance(batch, dali.backend.TensorListGPU):
+        batch = batch.as_cpu()
+    return [np.array(batch.at(i)) for i in range(len(batch))]
+
+def _test_split_merge(device, p):
+    batch_size = 16
+    pipe = Pipeline(batch_size, 4, 0)
+    with pipe:
+        data = fn.external_source(source=lambda: gen_data(batch_size), device=device, layout="HWC")
+        pred = fn.external_source(source=lambda: gen_predicate(batch_size, p))
+        selected, rest = fn.conditional.split(data, predicate=pred)
+        flipped = fn.flip(selected, horizontal=1)
+        merged = fn.conditional.merge(flipped, rest, predicate=pred)
+        pipe.set_outputs(data, pred, selected, rest, merged)
+    pipe.build()
+
+    for _ in range(5):
+        data, pred, selected, rest, merged = [as_cpu(out) for out in pipe.run()]
+        pred = [bool(x) for x in pred]
+        ref_selected = [x for x, c in zip(data, pred) if c]
+        ref_rest = [x for x, c in zip(data, pred) if not c]
+        assert len(selected) == len(ref_selected)
+        assert len(rest) == len(ref_rest)
+        if ref_selected:
+            check_batch(selected, ref_selected, len(ref_selected), 0, 0)
+        if ref_rest:
+            check_batch(rest, ref_rest, len(ref_rest), 0, 0)
+        ref_merged = [x[:, ::-1] if c else x for x, c in zip(data, pred)]
+        check_batch(merged, ref_merged, batch_size, 0, 0)
+
+def test_split_merge():
+    for device in ["cpu", "gpu"]:
+        for p in [0, 0.3, 1]:
+            yield _test_split_merge, device, p
+
+def test_integral_predicate():
+    batch_size = 8
+    pipe = Pipeline(batch_size, 4, 0)
+    with pipe:
+        data = fn.external_source(source=lambda: gen_data(batch_size), layout="HWC")
+        pred = fn.random.coin_flip(probability=0.5)
+        selected, rest = fn.conditional.split(data, predicate=pred)
+        merged = fn.conditional.merge(selected, rest, predicate=pred)
+        pipe.set_outputs(data, merged)
+    pipe.build()
+    for _ in range(5):
+        data, merged = pipe.run()
+        check_batch(merged, data, batch_size, 0, 0, "HWC")
+
+@raises(RuntimeError)
+def test_merge_predicate_mismatch():
+    batch_size = 8
+    pipe = Pipeline(batch_size, 4, 0)
+    with pipe:
+        data = fn.external_source(source=lambda: gen_data(batch_size), layout="HWC")
+        pred = fn.external_source(source=lambda: gen_predicate(batch_size, 0.5))
+        selected, rest = fn.conditional.split(data, predicate=pred)
+        # a constant predicate takes all the samples from the first input
+        merged = fn.conditional.merge(selected, rest, predicate=True)
+        pipe.set_outputs(merged)
+    pipe.build()
+    for _ in range(10):
+        pipe.run()
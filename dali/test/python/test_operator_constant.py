@@ -200,3 +200,23 @@ def test_constant_promotion_mixed():
     pipe.build()
     from_reader, from_constant = pipe.run()
     check_batch(from_reader, from_constant, 1)
+
+def test_invariant_outputs_across_iterations():
+    batch_size = 3
+    pipe = Pipeline(batch_size, 2, 0, prefetch_queue_depth=2)
+    val = np.float32([[1,2],[3,4]])
+    with pipe:
+        cpu = types.Constant(val, device="cpu")
+        gpu = types.Constant(val, device="gpu")
+        mt = fn.transforms.translation(offset=(1, 2))
+        pipe.set_outputs(cpu, gpu, gpu * 2, mt)
+    pipe.build()
+    for _ in range(5):
+        cpu, gpu, gpu2, mt = pipe.run()
+        gpu = gpu.as_cpu()
+        gpu2 = gpu2.as_cpu()
+        for i in range(batch_size):
+            assert np.array_equal(cpu.at(i), val)
+            assert np.array_equal(gpu.at(i), val)
+            assert np.array_equal(gpu2.at(i), val * 2)
+            assert np.array_equal(mt.at(i), np.float32([[1, 0, 1], [0, 1, 2]]))
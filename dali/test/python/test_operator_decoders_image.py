@@ -363,3 +363,134 @@ def _testimpl_image_decoder_slice_error_oob(device):
 def test_image_decoder_slice_error_oob():
     for device in ['cpu', 'mixed']:
         yield _testimpl_image_decoder_slice_error_oob, device
+
+def _testimpl_image_decoder_downscale_hint(device):
+    file_root = os.path.join(test_data_root, good_path, "jpeg")
+    hint = [64, 64]
+    @pipeline_def(batch_size=batch_size_test, device_id=0, num_threads=4, seed=1234)
+    def pipe(device):
+        encoded, _ = fn.readers.file(file_root=file_root)
+        full = fn.decoders.image(encoded, device="cpu")
+        scaled = fn.decoders.image(encoded, device=device, hw_decoder_load=0,
+                                   downscale_hint=hint)
+        return full, scaled
+    p = pipe(device)
+    p.build()
+    full, scaled = p.run()
+    if device == 'mixed':
+        scaled = scaled.as_cpu()
+    for i in range(len(full)):
+        full_shape = full.at(i).shape
+        scaled_shape = scaled.at(i).shape
+        denom = 1
+        while denom < 8 and math.ceil(full_shape[0] / (denom * 2)) >= hint[0] \
+                and math.ceil(full_shape[1] / (denom * 2)) >= hint[1]:
+            denom *= 2
+        assert scaled_shape[0] == math.ceil(full_shape[0] / denom), (full_shape, scaled_shape)
+        assert scaled_shape[1] == math.ceil(full_shape[1] / denom), (full_shape, scaled_shape)
+        assert scaled_shape[2] == full_shape[2]
+
+def test_image_decoder_downscale_hint():
+    for device in ['cpu', 'mixed']:
+        yield _testimpl_image_decoder_downscale_hint, device
+
+@pipeline_def(batch_size=batch_size_test, device_id=0, num_threads=4, seed=1234)
+def decoder_multi_crop_pipe(file_root, num_crops, size):
+    encoded, _ = fn.readers.file(file_root=file_root)
+    crops = fn.decoders.image_multi_crop(encoded, device='mixed', output_type=types.RGB,
+                                         num_crops=num_crops, size=size, seed=4321)
+    if num_crops == 1:
+        crops = [crops]
+    crop = fn.decoders.image_random_crop(encoded, device='mixed', output_type=types.RGB,
+                                         seed=4321)
+    resized = fn.resize(crop, resize_y=size[0], resize_x=size[1])
+    return (resized, *crops)
+
+def _testimpl_image_decoder_multi_crop(img_type, num_crops):
+    size = (120, 160)
+    data_path = os.path.join(test_data_root, good_path, img_type)
+    pipe = decoder_multi_crop_pipe(data_path, num_crops, size)
+    pipe.build()
+    out = pipe.run()
+    assert len(out) == num_crops + 1
+    for crops in out[1:]:
+        for i in range(len(crops)):
+            shape = crops.at(i).shape()
+            assert tuple(shape) == (*size, 3), shape
+    if num_crops == 1:
+        # a single crop is resized from exactly the decoded window, like a separate resize
+        check_batch(out[0], out[1], batch_size_test, eps=0, max_allowed_error=1)
+
+def test_image_decoder_multi_crop():
+    for img_type in ['jpeg', 'png', 'jpeg2k']:
+        for num_crops in [1, 3]:
+            yield _testimpl_image_decoder_multi_crop, img_type, num_crops
+
+@pipeline_def(batch_size=batch_size_test, device_id=0, num_threads=4, seed=1234)
+def decoder_yuv420_pipe(file_root, device):
+    encoded, _ = fn.readers.file(file_root=file_root)
+    ycbcr = fn.decoders.image(encoded, device='mixed', output_type=types.YCbCr)
+    yuv = fn.decoders.image(encoded, device='mixed', output_type=types.YUV420)
+    if device == 'cpu':
+        yuv = yuv.cpu()
+    converted = fn.color_space_conversion(yuv, device=device, image_type=types.YUV420,
+                                          output_type=types.YCbCr)
+    return ycbcr, yuv, converted
+
+def _testimpl_image_decoder_yuv420(img_type, device):
+    data_path = os.path.join(test_data_root, good_path, img_type)
+    pipe = decoder_yuv420_pipe(data_path, device)
+    pipe.build()
+    ycbcr, yuv, converted = pipe.run()
+    for i in range(len(ycbcr)):
+        ref = to_array(ycbcr[i]).astype(np.int32)
+        h, w = ref.shape[:2]
+        planes = to_array(yuv[i]).flatten()
+        ch, cw = (h + 1) // 2, (w + 1) // 2
+        assert yuv[i].shape()[1] == w
+        # the luma is kept as it is, the chroma is averaged over 2x2 blocks
+        assert np.array_equal(planes[:h * w].reshape(h, w), ref[:, :, 0])
+        cb = planes[h * w:h * w + ch * cw].reshape(ch, cw)
+        assert abs(int(cb[0, 0]) - int(np.round(ref[:2, :2, 1].mean()))) <= 1
+        out = to_array(converted[i]).astype(np.int32)
+        assert out.shape == ref.shape
+        assert np.array_equal(out[:, :, 0], ref[:, :, 0])
+
+def test_image_decoder_yuv420():
+    for img_type in ['jpeg', 'png']:
+        for device in ['cpu', 'gpu']:
+            yield _testimpl_image_decoder_yuv420, img_type, device
+
+@pipeline_def(batch_size=batch_size_test, device_id=0, num_threads=4, seed=1234)
+def decoder_jpeg2k_threads_pipe(file_root, num_threads_jpeg2k):
+    encoded, _ = fn.readers.file(file_root=file_root)
+    images = fn.decoders.image(encoded, device='mixed', output_type=types.RGB,
+                               num_threads_jpeg2k=num_threads_jpeg2k)
+    crops = fn.decoders.image_slice(encoded, (0.1, 0.2), (0.6, 0.5), device='mixed',
+                                    output_type=types.RGB, axes=(0, 1),
+                                    num_threads_jpeg2k=num_threads_jpeg2k)
+    return images, crops
+
+def test_image_decoder_jpeg2k_threads():
+    data_path = os.path.join(test_data_root, good_path, 'jpeg2k')
+    for num_threads_jpeg2k in [2, 4]:
+        # the images are decoded concurrently, but the same way as on a single thread
+        compare_pipelines(decoder_jpeg2k_threads_pipe(data_path, 1),
+                          decoder_jpeg2k_threads_pipe(data_path, num_threads_jpeg2k),
+                          batch_size=batch_size_test, N_iterations=3)
+
+@pipeline_def(batch_size=batch_size_test, device_id=0, num_threads=4, seed=1234)
+def decoder_shared_handle_pipe(file_root, preallocate_hint):
+    encoded, _ = fn.readers.file(file_root=file_root)
+    return fn.decoders.image(encoded, device='mixed', output_type=types.RGB, hw_decoder_load=0.7,
+                             preallocate_width_hint=preallocate_hint,
+                             preallocate_height_hint=preallocate_hint)
+
+def test_image_decoder_shared_handle():
+    data_path = os.path.join(test_data_root, good_path, 'jpeg')
+    # the pipelines of the process share the nvJPEG handle and the hardware decoder; the second
+    # one grows its memory pool
+    for _ in range(2):
+        compare_pipelines(decoder_shared_handle_pipe(data_path, 0),
+                          decoder_shared_handle_pipe(data_path, 2048),
+                          batch_size=batch_size_test, N_iterations=3)
@@ -0,0 +1,73 @@
+# Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from nvidia.dali import fn, pipeline_def
+import nvidia.dali.types as types
+import numpy as np
+import zlib
+from nose import SkipTest
+from nose_utils import assert_raises
+
+batch_size = 8
+
+
+def deflate(array):
+    # the raw deflate stream, without the zlib header
+    compressor = zlib.compressobj(wbits=-15)
+    data = compressor.compress(array.tobytes()) + compressor.flush()
+    return np.frombuffer(data, dtype=np.uint8)
+
+
+def check_decompress_available():
+    if not hasattr(fn.experimental, "decompress"):
+        raise SkipTest("DALI was built without nvCOMP")
+
+
+def test_deflate():
+    check_decompress_available()
+    rng = np.random.default_rng(42)
+    arrays = [rng.integers(0, 10, size=(i + 1, 5, 3)).astype(np.float32)
+              for i in range(batch_size)]
+    # an empty sample is also supported
+    arrays[3] = np.zeros((0, 5, 3), dtype=np.float32)
+
+    @pipeline_def(batch_size=batch_size, num_threads=3, device_id=0)
+    def pipe():
+        compressed = fn.external_source(source=lambda: [deflate(a) for a in arrays],
+                                        device="gpu")
+        shapes = fn.external_source(source=lambda: [np.array(a.shape, dtype=np.int32)
+                                                    for a in arrays])
+        return fn.experimental.decompress(compressed, algorithm="deflate", shape=shapes,
+                                          dtype=types.FLOAT, layout="HWC")
+
+    p = pipe()
+    p.build()
+    out, = p.run()
+    assert out.layout() == "HWC"
+    out = out.as_cpu()
+    for i in range(batch_size):
+        np.testing.assert_array_equal(arrays[i], out.at(i))
+
+
+def test_unknown_algorithm():
+    check_decompress_available()
+
+    @pipeline_def(batch_size=batch_size, num_threads=3, device_id=0)
+    def pipe():
+        data = fn.external_source(source=lambda: [np.zeros(10, dtype=np.uint8)] * batch_size,
+                                  device="gpu")
+        return fn.experimental.decompress(data, algorithm="lzma", shape=[10])
+
+    with assert_raises(RuntimeError, glob="*Unknown compression algorithm*"):
+        pipe().build()
@@ -0,0 +1,82 @@
+# Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from nvidia.dali import pipeline_def
+import nvidia.dali.fn as fn
+import nvidia.dali.types as types
+import numpy as np
+import os
+
+from test_utils import get_dali_extra_path
+
+test_data_root = get_dali_extra_path()
+images_dir = os.path.join(test_data_root, 'db', 'single', 'jpeg')
+
+batch_size = 4
+
+@pipeline_def(batch_size=batch_size, num_threads=3, device_id=0)
+def encode_pipe(output_type, quality, chroma_subsampling):
+    jpegs, _ = fn.readers.file(file_root=images_dir)
+    images = fn.decoders.image(jpegs, device="mixed", output_type=output_type)
+    images = fn.resize(images, size=(120, 160))
+    encoded = fn.encoders.image(images, quality=quality, chroma_subsampling=chroma_subsampling)
+    return images, encoded
+
+@pipeline_def(batch_size=batch_size, num_threads=3, device_id=0)
+def decode_pipe(source, output_type):
+    encoded = fn.external_source(source=source)
+    return fn.decoders.image(encoded, device="cpu", output_type=output_type)
+
+def _testimpl_encode(output_type, quality, chroma_subsampling, max_mean_error):
+    pipe = encode_pipe(output_type, quality, chroma_subsampling)
+    pipe.build()
+    images, encoded = pipe.run()
+    images = images.as_cpu()
+    encoded = encoded.as_cpu()
+    files = [np.array(encoded.at(i)) for i in range(batch_size)]
+    for f in files:
+        assert f.dtype == np.uint8 and f.ndim == 1
+        assert f[0] == 0xFF and f[1] == 0xD8  # SOI marker
+
+    dec_pipe = decode_pipe(lambda: files, output_type)
+    dec_pipe.build()
+    decoded, = dec_pipe.run()
+    for i in range(batch_size):
+        ref = np.int32(images.at(i))
+        out = np.int32(decoded.at(i))
+        assert ref.shape == out.shape, f"{ref.shape} vs {out.shape}"
+        mean_error = np.mean(np.abs(ref - out))
+        assert mean_error < max_mean_error, f"Mean error {mean_error} in sample {i}"
+
+def test_encode():
+    for chroma_subsampling in ["444", "420"]:
+        yield _testimpl_encode, types.RGB, 95, chroma_subsampling, 4
+    yield _testimpl_encode, types.GRAY, 95, "420", 4
+    yield _testimpl_encode, types.RGB, 20, "420", 12
+
+def test_encode_quality_per_sample():
+    @pipeline_def(batch_size=batch_size, num_threads=3, device_id=0)
+    def pipe_fn():
+        jpegs, _ = fn.readers.file(file_root=images_dir)
+        images = fn.decoders.image(jpegs, device="mixed")
+        images = fn.resize(images, size=(120, 160))
+        quality = fn.external_source(
+            source=lambda: [np.int32(q) for q in [10, 50, 90, 100]], batch=True)
+        return fn.encoders.image(images, quality=quality)
+    pipe = pipe_fn()
+    pipe.build()
+    encoded, = pipe.run()
+    encoded = encoded.as_cpu()
+    for i in range(batch_size):
+        assert encoded.at(i).shape[0] > 0
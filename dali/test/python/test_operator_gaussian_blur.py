@@ -162,6 +162,9 @@ def test_gaussian_blur_cpu_gpu_slow():
             if sigma is None and window_size is None:
                 continue
             yield check_gaussian_blur_cpu_gpu, 10, sigma, window_size
+    # long windows are processed with FFT on the GPU
+    for sigma, window_size in [(30.0, None), ([5.0, 50.0], None), (None, [301, 129])]:
+        yield check_gaussian_blur_cpu_gpu, 4, sigma, window_size
 
 
 def count_skip_axes(layout):
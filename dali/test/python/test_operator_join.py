@@ -206,3 +206,39 @@ def test_stack():
                 axis_names = [None] if layout is None and ndim > 0 else [None, 'C']
                 for axis_name in axis_names:
                     yield _run_test_stack, num_inputs, layout, ndim, axis, axis_name
+
+def ref_pad(batch, fill_value):
+    max_shape = np.max([x.shape for x in batch], axis=0)
+    out = []
+    for x in batch:
+        padded = np.full(max_shape, fill_value, dtype=x.dtype)
+        padded[tuple(slice(0, e) for e in x.shape)] = x
+        out.append(padded)
+    return out
+
+def _run_test_join_pad(op, ref_op, num_inputs, ndim, axis):
+    batch_size = 4
+    fill_value = -1
+    pipe = dali.pipeline.Pipeline(batch_size=batch_size, num_threads = 3, device_id = 0)
+    variable_axis = axis if op is fn.cat else None
+    with pipe:
+        inputs = fn.external_source(input_generator(num_inputs, batch_size, ndim, variable_axis),
+                                    num_outputs=num_inputs)
+        out_cpu = op(*inputs,                    axis=axis, pad=True, fill_value=fill_value)
+        out_gpu = op(*(x.gpu() for x in inputs), axis=axis, pad=True, fill_value=fill_value)
+        pipe.set_outputs(out_cpu, out_gpu, *inputs)
+    pipe.build()
+
+    for _ in range(3):
+        o_cpu, o_gpu, *inputs = pipe.run()
+        ref = ref_pad(ref_op(inputs, axis), fill_value)
+        check_batch(o_cpu, ref, batch_size, eps=0)
+        check_batch(o_gpu, ref, batch_size, eps=0)
+
+def test_join_pad():
+    for num_inputs in [1, 3]:
+        for ndim in [1, 2, 3]:
+            for axis in range(ndim):
+                yield _run_test_join_pad, fn.cat, ref_cat, num_inputs, ndim, axis
+            for axis in range(ndim + 1):
+                yield _run_test_join_pad, fn.stack, ref_stack, num_inputs, ndim, axis
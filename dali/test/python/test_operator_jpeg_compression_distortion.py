@@ -68,3 +68,36 @@ def test_jpeg_compression_distortion():
     for device in ['cpu', 'gpu']:
       for quality in [2, None, 50]:
         yield _testimpl_jpeg_compression_distortion, batch_size, device, quality
+
+def _testimpl_jpeg_compression_distortion_color_twist(batch_size, device):
+  @pipeline_def(seed=1234)
+  def color_twist_jpeg_distortion_pipe(device='cpu'):
+    encoded, _ = fn.readers.file(file_root=images_dir)
+    in_images = fn.decoders.image(encoded, device='cpu')
+    images = in_images.gpu() if device == 'gpu' else in_images
+    twist = {
+      'hue': fn.random.uniform(range=[-30, 30]),
+      'saturation': fn.random.uniform(range=[0.5, 1.5]),
+      'brightness': fn.random.uniform(range=[0.7, 1.3]),
+      'contrast': fn.random.uniform(range=[0.7, 1.3]),
+    }
+    fused = fn.jpeg_compression_distortion(images, quality=50, **twist)
+    separate = fn.jpeg_compression_distortion(fn.color_twist(images, **twist), quality=50)
+    return fused, separate
+
+  pipe = color_twist_jpeg_distortion_pipe(device=device, batch_size=batch_size, num_threads=2,
+                                          device_id=0)
+  pipe.build()
+  for _ in range(2):
+    fused, separate = pipe.run()
+    if device == 'gpu':
+      fused, separate = fused.as_cpu(), separate.as_cpu()
+    for i in range(batch_size):
+      # the color twist may be rounded differently
+      diff = cv2.absdiff(np.array(fused[i]), np.array(separate[i]))
+      assert np.average(diff) < 1, f"Fused color twist differs too much: {np.average(diff)}"
+
+def test_jpeg_compression_distortion_color_twist():
+  for batch_size in [1, 7]:
+    for device in ['cpu', 'gpu']:
+      yield _testimpl_jpeg_compression_distortion_color_twist, batch_size, device
@@ -123,3 +123,36 @@ def test_lookup_table_vs_python_op():
                  (10, (300, 300, 3), 'random', 0.9),
                  (3,  (300, 300, 3), 'small',  0.4)]:
                 yield check_lookup_table_vs_python_op, device, batch_size, layout, shape, dtype, dictionary_type, default_value
+
+def check_lookup_table_wide_keys(device, in_dtype, max_key):
+    import nvidia.dali.fn as fn
+    keys = sorted(random.sample(range(max_key + 1), min(100, max_key + 1)))
+    if keys[-1] != max_key:
+        keys.append(max_key)
+    values = [float(k % 97) for k in keys]
+    default_value = -1.0
+    def source():
+        return [np.random.randint(-5 if np.issubdtype(in_dtype, np.signedinteger) else 0,
+                                  max_key + 10, size=(61, 37), dtype=in_dtype)
+                for _ in range(4)]
+    pipe = Pipeline(4, 1, 0)
+    with pipe:
+        data = fn.external_source(source=source)
+        inp = data.gpu() if device == 'gpu' else data
+        pipe.set_outputs(fn.lookup_table(inp, keys=keys, values=values, dtype=types.FLOAT,
+                                         default_value=default_value), data)
+    pipe.build()
+    lut = {k: v for k, v in zip(keys, values)}
+    out, inp = pipe.run()
+    if device == 'gpu':
+        out = out.as_cpu()
+    for i in range(4):
+        ref = np.vectorize(lambda x: lut.get(int(x), default_value), otypes=[np.float32])
+        np.testing.assert_array_equal(np.array(out[i]), ref(np.array(inp[i])))
+
+def test_lookup_table_wide_keys():
+    # small tables are kept in shared memory by the GPU operator, large ones are not
+    for device in ['cpu', 'gpu']:
+        for in_dtype in [np.uint16, np.int32]:
+            for max_key in [10, 4095, 4096, 60000]:
+                yield check_lookup_table_wide_keys, device, in_dtype, max_key
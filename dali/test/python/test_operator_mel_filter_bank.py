@@ -144,3 +144,61 @@ def test_operator_mel_filter_bank_vs_python():
                          (128, 44100.0, 1000.0, 22050.0, (513, 100), 'tf')]:
                         yield check_operator_mel_filter_bank_vs_python, device, batch_size, shape, \
                             nfilter, sample_rate, freq_low, freq_high, normalize, mel_formula, layout
+
+class LogMelPipeline(Pipeline):
+    def __init__(self, fused, batch_size, iterator, nfilter, sample_rate, normalize_features,
+                 layout='ft', num_threads=1, device_id=0):
+        super(LogMelPipeline, self).__init__(batch_size, num_threads, device_id)
+        self.iterator = iterator
+        self.inputs = ops.ExternalSource()
+        self.fused = fused
+        self.layout = layout
+        self.normalize_features = normalize_features
+        if fused:
+            self.log_mel = ops.LogMelFilterBank(device='gpu', nfilter=nfilter,
+                                                sample_rate=sample_rate, reference=1.0,
+                                                cutoff_db=-80.0,
+                                                normalize_features=normalize_features)
+        else:
+            self.fbank = ops.MelFilterBank(device='gpu', nfilter=nfilter, sample_rate=sample_rate)
+            self.to_db = ops.ToDecibels(device='gpu', reference=1.0, cutoff_db=-80.0)
+            self.norm = ops.Normalize(device='gpu', axis_names=layout.replace('f', ''))
+
+    def define_graph(self):
+        self.data = self.inputs()
+        out = self.data.gpu()
+        if self.fused:
+            return self.log_mel(out)
+        out = self.to_db(self.fbank(out))
+        return self.norm(out) if self.normalize_features else out
+
+    def iter_setup(self):
+        data = self.iterator.next()
+        self.feed_input(self.data, data, layout=self.layout)
+
+def check_log_mel_filter_bank(batch_size, max_shape, nfilter, sample_rate, normalize_features,
+                              layout):
+    f_axis = layout.find('f')
+    min_shape = [1 for _ in max_shape]
+    min_shape[f_axis] = max_shape[f_axis]
+    min_shape[layout.find('t')] = 2
+    eii1 = RandomlyShapedDataIterator(batch_size, min_shape=min_shape, max_shape=max_shape,
+                                      dtype=np.float32)
+    eii2 = RandomlyShapedDataIterator(batch_size, min_shape=min_shape, max_shape=max_shape,
+                                      dtype=np.float32)
+    compare_pipelines(
+        LogMelPipeline(True, batch_size, iter(eii1), nfilter, sample_rate, normalize_features,
+                       layout),
+        LogMelPipeline(False, batch_size, iter(eii2), nfilter, sample_rate, normalize_features,
+                       layout),
+        batch_size=batch_size, N_iterations=3, eps=1e-03)
+
+def test_log_mel_filter_bank():
+    for batch_size in [1, 3]:
+        for normalize_features in [False, True]:
+            for nfilter, sample_rate, shape, layout in \
+                [(64, 16000.0, (257, 100), 'ft'),
+                 (80, 16000.0, (100, 257), 'tf'),
+                 (64, 48000.0, (4, 513, 50), 'Cft')]:
+                yield check_log_mel_filter_bank, batch_size, shape, nfilter, sample_rate, \
+                    normalize_features, layout
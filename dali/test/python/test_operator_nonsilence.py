@@ -1,4 +1,4 @@
-# Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+# Copyright (c) 2020-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -47,6 +47,7 @@ class NonsilencePipeline(Pipeline):
         self.decode = ops.decoders.Audio(device="cpu", dtype=types.FLOAT, downmix=True)
 
         self.nonsilence = None
+        self.nonsilence_device = "cpu"
 
     def define_graph(self):
         if self.nonsilence is None:
@@ -54,18 +55,21 @@ class NonsilencePipeline(Pipeline):
                 "Error: you need to derive from this class and define `self.nonsilence` operator")
         read, _ = self.input()
         audio, rate = self.decode(read)
+        if self.nonsilence_device == "gpu":
+            audio = audio.gpu()
         begin, len = self.nonsilence(audio)
         return begin, len
 
 
 class NonsilenceDaliPipeline(NonsilencePipeline):
     def __init__(self, batch_size, cutoff_value, window_size, reference_power,
-                 reset_interval):
+                 reset_interval, device="cpu"):
         super(NonsilenceDaliPipeline, self).__init__(batch_size, num_threads=1)
         self.nonsilence = ops.NonsilentRegion(cutoff_db=cutoff_value, window_length=window_size,
                                               reference_power=reference_power,
                                               reset_interval=reset_interval,
-                                              device="cpu")
+                                              device=device)
+        self.nonsilence_device = device
 
 
 class NonsilenceRosaPipeline(NonsilencePipeline):
@@ -101,3 +105,23 @@ def test_nonsilence_operator():
                 for cc in cutoff_coeffs:
                     yield check_nonsilence_operator, \
                           batch_size, cc, ws, rp, ri, ws
+
+
+def check_nonsilence_gpu_vs_cpu(batch_size, cutoff_value, window_size, reference_power,
+                                reset_interval, eps):
+    test_utils.compare_pipelines(
+        NonsilenceDaliPipeline(batch_size, cutoff_value, window_size, reference_power,
+                               reset_interval, device="gpu"),
+        NonsilenceDaliPipeline(batch_size, cutoff_value, window_size, reference_power,
+                               reset_interval, device="cpu"),
+        batch_size=batch_size, N_iterations=3, eps=eps)
+
+
+def test_nonsilence_gpu_vs_cpu():
+    batch_size = 3
+    for ws in [512, 1024]:
+        for rp in [None, .0003]:
+            for cc in [-10, -60, -80]:
+                # the sums of squares are accumulated in a different order, so the values
+                # close to the threshold may be classified differently
+                yield check_nonsilence_gpu_vs_cpu, batch_size, cc, ws, rp, 8192, 16
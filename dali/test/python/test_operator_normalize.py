@@ -224,7 +224,7 @@ class NormalizePipeline(Pipeline):
         self.has_axes = axes is not None or axis_names is not None
         self.scale = scale
         self.shift = shift
-        self.is_integral = out_type is not None and out_type is not np.float32
+        self.is_integral = out_type is not None and not np.issubdtype(out_type, np.floating)
 
         if axis_names is not None:
             axes = []
@@ -405,4 +405,11 @@ def test_types():
             for in_type in [None, np.uint8, np.int16, np.float32]:
                 yield _run_test, device, batch_size, dim, axes, None, False, out_type, in_type, shift, scale
 
+def test_gpu_half_output():
+    batch_size = 50
+    dim = 4
+    axes = [1, 2]
+    for in_type in [None, np.uint8, np.int16]:
+        yield _run_test, "gpu", batch_size, dim, axes, None, False, np.float16, in_type, 0.5, 0.5
+
 import nvidia.dali.fn as fn
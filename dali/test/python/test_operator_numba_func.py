@@ -207,3 +207,42 @@ def test_multiple_ins():
         outs = pipe.run()
         out_arr = np.array(outs[0][0])
         assert np.array_equal(out_arr, np.zeros((10, 10, 3), dtype=np.uint8))
+
+def reverse_col_cuda(out0, in0):
+    from numba import cuda
+    flat_out = out0.reshape(out0.size)
+    flat_in = in0.reshape(in0.size)
+    start = cuda.blockIdx.x * cuda.blockDim.x + cuda.threadIdx.x
+    step = cuda.gridDim.x * cuda.blockDim.x
+    for i in range(start, flat_out.size, step):
+        flat_out[i] = 255 - flat_in[i]
+
+@pipeline_def
+def numba_func_gpu_image_pipe(run_fn=None, setup_fn=None, blocks_per_sample=0):
+    files, _ = dali.fn.readers.caffe(path=lmdb_folder)
+    images_in = dali.fn.decoders.image(files, device="mixed")
+    images_out = numba_function(images_in, run_fn=run_fn, out_types=[dali_types.UINT8], in_types=[dali_types.UINT8],
+        outs_ndim=[3], ins_ndim=[3], setup_fn=setup_fn, device="gpu", blocks_per_sample=blocks_per_sample)
+    return images_in, images_out
+
+def _testimpl_numba_func_gpu(blocks_per_sample):
+    from nvidia.dali.plugin.numba import experimental as numba_experimental
+    pipe = numba_func_gpu_image_pipe(batch_size=8, num_threads=3, device_id=0, run_fn=reverse_col_cuda,
+        blocks_per_sample=blocks_per_sample)
+    pipe.build()
+    # the kernel is compiled once for the function, the types and the device
+    num_kernels = len(numba_experimental._cuda_kernels)
+    assert num_kernels >= 1
+    for _ in range(3):
+        images_in, images_out = pipe.run()
+        images_in = images_in.as_cpu()
+        images_out = images_out.as_cpu()
+        for i in range(len(images_in)):
+            assert np.array_equal(255 - images_in.at(i), images_out.at(i))
+    pipe2 = numba_func_gpu_image_pipe(batch_size=8, num_threads=3, device_id=0, run_fn=reverse_col_cuda)
+    pipe2.build()
+    assert len(numba_experimental._cuda_kernels) == num_kernels
+
+def test_numba_func_gpu():
+    for blocks_per_sample in [0, 1, 7]:
+        yield _testimpl_numba_func_gpu, blocks_per_sample
@@ -187,3 +187,36 @@ def test_empty_string_axis_name():
 def test_axis_name_no_initial_layout_multi_dim():
     np.random.seed(42)
     check_one_hot_operator(random_3d_tensors_batch, axis=-1, axis_name="O")
+
+
+def check_one_hot_class_map(device, dtype):
+    import nvidia.dali.fn as fn
+    # every other label is merged with its neighbor, labels divisible by 5 are ignored
+    class_map = [-1 if l % 5 == 0 else l // 2 for l in range(2 * num_classes)]
+    def source():
+        return [np.random.randint(-2, 2 * num_classes + 2, size=(7, 13, 3), dtype=np.int32)
+                for _ in range(batch_size)]
+    pipe = Pipeline(batch_size, 1, 0)
+    with pipe:
+        data = fn.external_source(source=source)
+        inp = data.gpu() if device == 'gpu' else data
+        pipe.set_outputs(fn.one_hot(inp, num_classes=num_classes, dtype=dtype,
+                                    class_map=class_map), data)
+    pipe.build()
+    for _ in range(2):
+        out, inp = pipe.run()
+        if device == 'gpu':
+            out = out.as_cpu()
+        for i in range(batch_size):
+            labels = np.array(inp[i])
+            in_range = (labels >= 0) & (labels < len(class_map))
+            classes = np.where(in_range, np.array(class_map)[np.clip(labels, 0, len(class_map) - 1)], -1)
+            ref = (classes[..., np.newaxis] == np.arange(num_classes)).astype(np.array(out[i]).dtype)
+            np.testing.assert_array_equal(np.array(out[i]), ref)
+
+
+def test_one_hot_class_map():
+    np.random.seed(42)
+    for device in ['cpu', 'gpu']:
+        for dtype in [types.UINT8, types.INT16, types.FLOAT, types.INT64]:
+            yield check_one_hot_class_map, device, dtype
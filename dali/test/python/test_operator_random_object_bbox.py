@@ -422,6 +422,37 @@ def test_random_object_bbox_ignore_class():
 
             yield _test_random_object_bbox_ignore_class, 5, ndim, dtype, format, bg, threshold, k_largest
 
+@nottest
+def _test_random_object_bbox_cpu_vs_gpu(max_batch_size, ndim, dtype, ignore_class, threshold, k_largest, cache):
+    pipe = dali.Pipeline(max_batch_size, 4, device_id=0, seed=4321)
+    with pipe:
+        inp = fn.external_source(sampled_dataset(2 * max_batch_size, max_batch_size, ndim, dtype))
+        kwargs = dict(format="box", output_class=not ignore_class, ignore_class=ignore_class,
+                      threshold=threshold, k_largest=k_largest, cache_objects=cache, seed=1234)
+        cpu_outs = fn.segmentation.random_object_bbox(inp, **kwargs)
+        gpu_outs = fn.segmentation.random_object_bbox(inp.gpu(), **kwargs)
+        if not isinstance(cpu_outs, list):
+            cpu_outs, gpu_outs = [cpu_outs], [gpu_outs]
+        pipe.set_outputs(*cpu_outs, *gpu_outs)
+    pipe.build()
+
+    nout = len(cpu_outs)
+    for _ in range(10):
+        outs = pipe.run()
+        for cpu_out, gpu_out in zip(outs[:nout], outs[nout:]):
+            check_batch(cpu_out, gpu_out.as_cpu(), max_batch_size)
+
+def test_random_object_bbox_cpu_vs_gpu():
+    np.random.seed(12345)
+    types = [np.int8, np.uint8, np.int16, np.uint16, np.int32, np.uint32]
+    for ndim in [1, 2, 3]:
+        for ignore_class in [False, True]:
+            dtype = random.choice(types)
+            threshold = random.choice([None, 3])
+            k_largest = random.choice([None, 1, 3])
+            cache = random.choice([False, True])
+            yield _test_random_object_bbox_cpu_vs_gpu, 4, ndim, dtype, ignore_class, threshold, k_largest, cache
+
 @nottest
 def _test_random_object_bbox_auto_bg(fg_labels, expected_bg):
     """Checks that a correct backgorund labels is chosen:
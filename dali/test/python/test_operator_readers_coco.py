@@ -177,6 +177,43 @@ def test_operator_coco_reader_same_images():
             np.testing.assert_array_equal(boxes1.at(0), boxes2.at(0))
             np.testing.assert_array_equal(boxes1.at(0), boxes3.at(0))
 
+def check_operator_coco_reader_preprocessed_annotations(masks, dont_use_mmap):
+    coco_pixelwise_dir = os.path.join(test_data_root, 'db', 'coco_pixelwise')
+    file_root = os.path.join(coco_pixelwise_dir, 'images')
+    annotations_file = os.path.join(coco_pixelwise_dir, 'instances.json')
+    masks_args = {masks: True} if masks else {}
+    with tempfile.TemporaryDirectory() as annotations_dir:
+        pipe1 = Pipeline(batch_size=1, num_threads=4, device_id=0)
+        with pipe1:
+            outs = fn.readers.coco(file_root=file_root, annotations_file=annotations_file,
+                                   image_ids=True, save_preprocessed_annotations=True,
+                                   save_preprocessed_annotations_dir=annotations_dir,
+                                   name="reader", **masks_args)
+            pipe1.set_outputs(*outs)
+        pipe1.build()
+        assert os.path.exists(os.path.join(annotations_dir, 'annotations.bin'))
+
+        pipe2 = Pipeline(batch_size=1, num_threads=4, device_id=0)
+        with pipe2:
+            outs = fn.readers.coco(file_root=file_root, preprocessed_annotations=annotations_dir,
+                                   image_ids=True, dont_use_mmap=dont_use_mmap,
+                                   name="reader", **masks_args)
+            pipe2.set_outputs(*outs)
+        pipe2.build()
+
+        epoch_sz = pipe1.epoch_size("reader")
+        assert epoch_sz == pipe2.epoch_size("reader")
+        for _ in range(epoch_sz):
+            out1 = pipe1.run()
+            out2 = pipe2.run()
+            for o1, o2 in zip(out1, out2):
+                np.testing.assert_array_equal(o1.at(0), o2.at(0))
+
+def test_operator_coco_reader_preprocessed_annotations():
+    for masks in [None, 'polygon_masks', 'pixelwise_masks']:
+        for dont_use_mmap in [False, True]:
+            yield check_operator_coco_reader_preprocessed_annotations, masks, dont_use_mmap
+
 @raises(
     RuntimeError,
     glob='Argument "preprocessed_annotations_dir" is not supported by operator *readers*COCO')
@@ -125,10 +125,90 @@ def test_file_reader_relpath_file_list():
             index = 10000 - label
             assert contents == ref_contents(fnames[index])
 
+def test_file_reader_resume_from_checkpoint():
+    batch_size = 3
+
+    def create_pipe(skip_samples):
+        pipe = Pipeline(batch_size, 1, 0, prefetch_queue_depth=2)
+        files, labels = fn.readers.file(file_root=g_root, files=g_files, random_shuffle=True,
+                                        shuffle_indices=True, seed=123, name="Reader",
+                                        skip_samples=skip_samples)
+        pipe.set_outputs(labels)
+        pipe.build()
+        return pipe
+
+    def labels(pipe, num_iters):
+        return [[int(l[0]) for l in pipe.run()[0].as_array()] for _ in range(num_iters)]
+
+    ref = labels(create_pipe(0), 8)
+    pipe = create_pipe(0)
+    labels(pipe, 5)
+    # the iterations waiting in the prefetch queue don't count
+    checkpoints = pipe.reader_checkpoints()
+    assert checkpoints == {"Reader": 5 * batch_size}, checkpoints
+    resumed = labels(create_pipe(checkpoints["Reader"]), 3)
+    assert resumed == ref[5:], "{} vs {}".format(resumed, ref[5:])
+
+
+def test_file_reader_reshard():
+    batch_size = 5
+
+    def create_pipe():
+        pipe = Pipeline(batch_size, 1, 0, prefetch_queue_depth=2)
+        files, labels = fn.readers.file(file_root=g_root, files=g_files,
+                                        shuffle_after_epoch=True, name="Reader")
+        pipe.set_outputs(labels)
+        pipe.build()
+        return pipe
+
+    num_shards = 2
+    shards = []
+    for shard_id in range(num_shards):
+        pipe = create_pipe()
+        # go through the first epoch
+        for _ in range(len(g_files) // batch_size):
+            pipe.schedule_run()
+            pipe.outputs()
+        try:
+            pipe.reshard("Reader", shard_id, num_shards)
+            assert False, "The scheduled iterations should prevent resharding"
+        except RuntimeError:
+            pass
+        while not pipe.empty():
+            pipe.outputs()
+        pipe.reshard("Reader", shard_id, num_shards)
+        meta = pipe.reader_meta("Reader")
+        assert meta["shard_id"] == shard_id and meta["number_of_shards"] == num_shards, meta
+        pipe.schedule_run()
+        shards.append([int(l[0]) for l in pipe.outputs()[0].as_array()])
+    # the readers resharded at the same epoch read disjoint shards
+    assert sorted(shards[0] + shards[1]) == list(range(len(g_files))), shards
+
 
 batch_size_alias_test=64
 
 @pipeline_def(batch_size=batch_size_alias_test, device_id=0, num_threads=4)
+def test_file_reader_filter():
+    batch_size = 3
+    excluded = [1, 4, 5]
+    # all the files are smaller than 1kB, so the size limits keep all of them
+    pipe = Pipeline(batch_size, 1, 0)
+    files, labels = fn.readers.file(file_root=g_root, files=g_files, exclude_labels=excluded,
+                                    min_file_size=1, max_file_size=1024, name="Reader")
+    pipe.set_outputs(files, labels)
+    pipe.build()
+    assert pipe.epoch_size("Reader") == len(g_files) - len(excluded)
+
+    seen = set()
+    for i in range(len(g_files) // batch_size + 1):
+        out_f, out_l = pipe.run()
+        for j in range(batch_size):
+            index = out_l.at(j)[0]
+            assert index not in excluded
+            assert bytes(out_f.at(j)).decode('utf-8') == ref_contents(g_files[index])
+            seen.add(index)
+    assert seen == set(range(len(g_files))) - set(excluded)
+
 def file_pipe(file_op, file_list):
     files, labels = file_op(file_list=file_list)
     return files, labels
@@ -280,3 +280,30 @@ def test_read_idxs(batch_size=10, reader_seed=12345):
       np.testing.assert_array_equal(np.array(idx1[s]), np.array(idx2[s]))
       idx = np.array(idx1[s])[0]
       assert idx >= 0 and idx < total_samples
+
+def test_nemo_asr_reader_bucketing():
+  batch_size = 4
+  repeats = 4
+  bucket_manifest = os.path.join(tmp_dir.name, "nemo_asr_bucket_manifest.json")
+  create_manifest_file(bucket_manifest, names * repeats, lengths * repeats, rates * repeats,
+                       ref_text_literal * repeats)
+  # durations are ~0.45s, ~2.46s and ~1.0s, so each of them lands in a separate bucket
+  pipe = Pipeline(batch_size=batch_size, num_threads=4, device_id=0)
+  with pipe:
+    audio = fn.readers.nemo_asr(manifest_filepaths=[bucket_manifest], dtype=types.INT16,
+                                downmix=False, read_sample_rate=False, read_text=False,
+                                bucket_boundaries=[0.6, 1.5],
+                                bucketing_window=len(names) * repeats,
+                                shuffle_after_epoch=True)
+    pipe.set_outputs(audio)
+  pipe.build()
+
+  for epoch in range(2):
+    seen = []
+    for it in range(len(names) * repeats // batch_size):
+      out = pipe.run()[0]
+      batch_lengths = [out.at(i).shape[0] for i in range(batch_size)]
+      assert len(set(batch_lengths)) == 1, \
+          "Samples from different buckets in one batch: {}".format(batch_lengths)
+      seen += batch_lengths
+    assert sorted(seen) == sorted(lengths * repeats)
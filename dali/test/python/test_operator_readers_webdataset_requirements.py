@@ -209,6 +209,51 @@ def test_wds_sharding():
     )
 
 
+def test_shuffle_after_epoch():
+    global test_batch_size
+    num_samples = 3000
+    tar_file_paths = [
+        os.path.join(get_dali_extra_path(), "db/webdataset/MNIST/devel-0.tar"),
+        os.path.join(get_dali_extra_path(), "db/webdataset/MNIST/devel-1.tar"),
+        os.path.join(get_dali_extra_path(), "db/webdataset/MNIST/devel-2.tar"),
+    ]
+    index_files = [generate_temp_index_file(tar_file_path) for tar_file_path in tar_file_paths]
+
+    extract_dirs = [generate_temp_extract(tar_file_path) for tar_file_path in tar_file_paths]
+    equivalent_files = sum(
+        list(
+            sorted(
+                glob(extract_dir.name + "/*"), key=lambda s: int(s[s.rfind("/") + 1 : s.rfind(".")])
+            )
+            for extract_dir in extract_dirs
+        ),
+        [],
+    )
+
+    # the samples are shuffled across the archives in the same way as the files
+    compare_pipelines(
+        webdataset_raw_pipeline(
+            tar_file_paths,
+            [index_file.name for index_file in index_files],
+            ["jpg", "cls"],
+            shuffle_after_epoch=True,
+            batch_size=test_batch_size,
+            device_id=0,
+            num_threads=1,
+        ),
+        file_reader_pipeline(
+            equivalent_files,
+            ["jpg", "cls"],
+            shuffle_after_epoch=True,
+            batch_size=test_batch_size,
+            device_id=0,
+            num_threads=1,
+        ),
+        test_batch_size,
+        math.ceil(num_samples / test_batch_size) * 2,
+    )
+
+
 def test_sharding():
     global test_batch_size
     num_samples = 1000
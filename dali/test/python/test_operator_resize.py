@@ -610,3 +610,31 @@ def test_very_small_output():
     for device in ["cpu", "gpu"]:
         for dim in [2, 3]:
             yield _test_very_small_output, dim, device
+
+def _test_bucket_by_size(dim):
+    batch_size = 16
+    pipe = Pipeline(batch_size=batch_size, num_threads=4, device_id=0, seed=1234)
+    if dim == 2:
+        files, labels = dali.fn.readers.caffe(path = db_2d_folder, random_shuffle = True)
+        images = dali.fn.decoders.image(files, device="mixed")
+    else:
+        images = dali.fn.external_source(source=random_3d_loader(batch_size), layout="DHWC").gpu()
+
+    # very different output sizes within the batch
+    sizes = [np.array(20 + (i * 397) % 500, dtype=np.float32) for i in range(batch_size)]
+    size_inp = fn.external_source(lambda: sizes, batch=True) if dim == 2 else 40
+    resized = fn.resize(images, resize_shorter = size_inp, minibatch_size = 4)
+    bucketed = fn.resize(images, resize_shorter = size_inp, minibatch_size = 4, bucket_by_size = True)
+    pipe.set_outputs(resized, bucketed)
+    pipe.build()
+
+    for it in range(3):
+        out, out_bucketed = pipe.run()
+        out = out.as_cpu()
+        out_bucketed = out_bucketed.as_cpu()
+        for i in range(batch_size):
+            assert np.array_equal(out.at(i), out_bucketed.at(i))
+
+def test_bucket_by_size():
+    for dim in [2, 3]:
+        yield _test_bucket_by_size, dim
@@ -0,0 +1,75 @@
+# Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from nvidia.dali import pipeline_def
+import nvidia.dali.fn as fn
+import nvidia.dali.types as types
+import os
+
+from test_utils import check_batch, get_dali_extra_path
+
+test_data_root = get_dali_extra_path()
+caffe_db_folder = os.path.join(test_data_root, 'db', 'lmdb')
+
+mean = [0.485 * 255, 0.456 * 255, 0.406 * 255]
+std = [0.229 * 255, 0.224 * 255, 0.225 * 255]
+
+@pipeline_def
+def rcmn_pipe(dtype, output_layout, interp_type, scale=1, shift=0):
+    jpegs, _ = fn.readers.caffe(path=caffe_db_folder)
+    images = fn.decoders.image(jpegs, device="mixed")
+    mirror = fn.random.coin_flip(seed=123)
+    fused = fn.resize_crop_mirror_normalize(images, resize_shorter=256, crop=(224, 224),
+                                            crop_pos_x=0.3, crop_pos_y=0.6, mirror=mirror,
+                                            mean=mean, std=std, dtype=dtype,
+                                            scale=scale, shift=shift,
+                                            output_layout=output_layout, interp_type=interp_type)
+    resized = fn.resize(images, resize_shorter=256, interp_type=interp_type, dtype=types.FLOAT)
+    ref = fn.crop_mirror_normalize(resized, crop=(224, 224), crop_pos_x=0.3, crop_pos_y=0.6,
+                                   mirror=mirror, mean=mean, std=std, dtype=dtype,
+                                   scale=scale, shift=shift, output_layout=output_layout)
+    return fused, ref
+
+def _testimpl_resize_crop_mirror_normalize(dtype, output_layout, interp_type):
+    batch_size = 8
+    pipe = rcmn_pipe(dtype, output_layout, interp_type,
+                     batch_size=batch_size, num_threads=3, device_id=0)
+    pipe.build()
+    for _ in range(3):
+        fused, ref = pipe.run()
+        assert fused.layout() == output_layout, fused.layout()
+        # the fused variant always resamples horizontally first, so the results may differ
+        # by the rounding errors
+        check_batch(fused, ref, batch_size, eps=1e-2, max_allowed_error=2e-2)
+
+def test_resize_crop_mirror_normalize():
+    for dtype in [types.FLOAT, types.FLOAT16]:
+        for output_layout in ["CHW", "HWC"]:
+            for interp_type in [types.INTERP_LINEAR, types.INTERP_TRIANGULAR]:
+                yield _testimpl_resize_crop_mirror_normalize, dtype, output_layout, interp_type
+
+def _testimpl_resize_crop_mirror_normalize_quantized(dtype, scale, shift):
+    batch_size = 8
+    pipe = rcmn_pipe(dtype, "CHW", types.INTERP_LINEAR, scale, shift,
+                     batch_size=batch_size, num_threads=3, device_id=0)
+    pipe.build()
+    for _ in range(3):
+        fused, ref = pipe.run()
+        assert fused.as_cpu().at(0).dtype == ref.as_cpu().at(0).dtype
+        # the rounding errors of the resampling may move the values to the next integer
+        check_batch(fused, ref, batch_size, eps=1, max_allowed_error=1)
+
+def test_resize_crop_mirror_normalize_quantized():
+    yield _testimpl_resize_crop_mirror_normalize_quantized, types.INT8, 32, 0
+    yield _testimpl_resize_crop_mirror_normalize_quantized, types.UINT8, 48, 128
@@ -0,0 +1,93 @@
+# Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import numpy as np
+import nvidia.dali as dali
+import nvidia.dali.fn as fn
+import random
+from nose.tools import nottest
+
+random.seed(1234)
+np.random.seed(4321)
+
+def make_polygons(nmasks, max_polygons, nvertices_range, extent):
+    polygons = []
+    vertices = []
+    for m in range(nmasks):
+        for _ in range(random.randint(1, max_polygons)):
+            nvertices = random.randint(*nvertices_range)
+            start = sum(len(v) for v in vertices)
+            polygons.append((m, start, start + nvertices))
+            center = np.random.rand(2) * extent
+            radius = np.random.rand() * extent / 3
+            angles = np.sort(np.random.rand(nvertices)) * 2 * np.pi
+            r = radius * (0.5 + np.random.rand(nvertices))
+            vertices.append(np.stack([center[0] + r * np.cos(angles),
+                                      center[1] + r * np.sin(angles)], axis=1))
+    polygons = np.int32(polygons).reshape(-1, 3)
+    vertices = np.float32(np.concatenate(vertices)) if vertices else np.zeros([0, 2], np.float32)
+    return polygons, vertices
+
+def rasterize_ref(polygons, vertices, shape, num_masks):
+    h, w = shape
+    py, px = np.meshgrid(np.arange(h, dtype=np.float32) + 0.5,
+                         np.arange(w, dtype=np.float32) + 0.5, indexing='ij')
+    out = np.zeros([num_masks, h, w], dtype=np.uint8)
+    for mask_id, start, end in polygons:
+        parity = np.zeros([h, w], dtype=bool)
+        for v in range(start, end):
+            x0, y0 = vertices[v]
+            x1, y1 = vertices[v + 1 if v + 1 < end else start]
+            if y0 == y1:
+                continue
+            dxdy = np.float32((x1 - x0) / (y1 - y0))
+            crossing = ((y0 > py) != (y1 > py)) & (px < x0 + (py - y0) * dxdy)
+            parity ^= crossing
+        out[mask_id] |= parity
+    return out
+
+@nottest
+def _test_rasterize_polygons(batch_size, relative):
+    shapes = [(random.randint(1, 300), random.randint(1, 300)) for _ in range(batch_size)]
+    data = [make_polygons(random.randint(0, 8), 3, (3, 30), 1 if relative else max(s))
+            for s in shapes]
+
+    def get_data():
+        return [d[0] for d in data], [d[1] for d in data], [np.int32(s) for s in shapes]
+
+    pipe = dali.pipeline.Pipeline(batch_size=batch_size, num_threads=4, device_id=0)
+    with pipe:
+        polygons, vertices, mask_shape = fn.external_source(source=get_data, num_outputs=3)
+        masks = fn.segmentation.rasterize_polygons(polygons, vertices, mask_shape=mask_shape,
+                                                   relative_coords=relative)
+    pipe.set_outputs(masks)
+    pipe.build()
+    masks, = pipe.run()
+    masks = masks.as_cpu()
+    for i in range(batch_size):
+        polygons, vertices = data[i]
+        h, w = shapes[i]
+        if relative:
+            vertices = vertices * np.float32([w, h])
+        num_masks = polygons[:, 0].max() + 1 if len(polygons) else 0
+        ref = rasterize_ref(polygons, vertices, shapes[i], num_masks)
+        out = np.array(masks[i])
+        assert out.shape == ref.shape, "{} vs {}".format(out.shape, ref.shape)
+        # tolerate rare differences for pixel centers lying (almost) exactly on an edge
+        assert np.count_nonzero(out != ref) <= 1e-3 * out.size
+
+def test_rasterize_polygons():
+    for batch_size in [1, 5]:
+        for relative in [False, True]:
+            yield _test_rasterize_polygons, batch_size, relative
@@ -23,7 +23,7 @@ from nose.tools import assert_raises
 random.seed(1234)
 np.random.seed(4321)
 
-def check_select_masks(batch_size, npolygons_range = (1, 10), nvertices_range = (3, 40), vertex_ndim = 2, vertex_dtype = np.float32, reindex_masks = False):
+def check_select_masks(batch_size, npolygons_range = (1, 10), nvertices_range = (3, 40), vertex_ndim = 2, vertex_dtype = np.float32, reindex_masks = False, device = 'cpu'):
     def get_data_source(*args, **kwargs):
         return lambda: make_batch_select_masks(*args, **kwargs)
     pipe = dali.pipeline.Pipeline(batch_size=batch_size, num_threads=4, device_id=0, seed=1234)
@@ -33,13 +33,20 @@ def check_select_masks(batch_size, npolygons_range = (1, 10), nvertices_range =
             nvertices_range=nvertices_range, vertex_ndim=vertex_ndim, vertex_dtype=vertex_dtype),
             num_outputs = 3, device='cpu'
         )
-        out_polygons, out_vertices = fn.segmentation.select_masks(
-            mask_ids, polygons, vertices, reindex_masks=reindex_masks
-        )
+        if device == 'gpu':
+            out_polygons, out_vertices = fn.segmentation.select_masks(
+                mask_ids.gpu(), polygons.gpu(), vertices.gpu(), reindex_masks=reindex_masks
+            )
+        else:
+            out_polygons, out_vertices = fn.segmentation.select_masks(
+                mask_ids, polygons, vertices, reindex_masks=reindex_masks
+            )
     pipe.set_outputs(polygons, vertices, mask_ids, out_polygons, out_vertices)
     pipe.build()
     for iter in range(3):
         outputs = pipe.run()
+        if device == 'gpu':
+            outputs = outputs[:3] + tuple(out.as_cpu() for out in outputs[3:])
         for idx in range(batch_size):
             in_polygons = outputs[0].at(idx)
             in_vertices = outputs[1].at(idx)
@@ -80,14 +87,19 @@ def test_select_masks():
         for vertex_ndim in [2, 3, 6]:
             for vertex_dtype in [np.float, random.choice([np.int8, np.int16, np.int32, np.int64])]:
                 reindex_masks = random.choice([False, True])
-                yield check_select_masks, batch_size, npolygons_range, nvertices_range, \
-                    vertex_ndim, vertex_dtype, reindex_masks
+                for device in ['cpu', 'gpu']:
+                    yield check_select_masks, batch_size, npolygons_range, nvertices_range, \
+                        vertex_ndim, vertex_dtype, reindex_masks, device
+
+def test_select_masks_many_polygons():
+    yield check_select_masks, 2, (1000, 2000), (3, 10), 2, np.float32, True, 'gpu'
 
-def check_select_masks_wrong_input(data_source_fn, batch_size=1, reindex_masks=False):
+def check_select_masks_wrong_input(data_source_fn, batch_size=1, reindex_masks=False,
+                                   device='cpu'):
     pipe = dali.pipeline.Pipeline(batch_size=batch_size, num_threads=4, device_id=0, seed=1234)
     with pipe:
         polygons, vertices, mask_ids = fn.external_source(
-            source = data_source_fn, num_outputs = 3, device='cpu'
+            source = data_source_fn, num_outputs = 3, device=device
         )
         out_polygons, out_vertices = fn.segmentation.select_masks(
             mask_ids, polygons, vertices, reindex_masks=reindex_masks
@@ -103,7 +115,8 @@ def test_select_masks_wrong_mask_ids():
         vertices = [np.array(np.random.rand(9, 2), dtype=np.float32)]
         mask_ids = [np.array([10, 11], dtype = np.int32)]  # out of bounds ids
         return polygons, vertices, mask_ids
-    check_select_masks_wrong_input(lambda: test_data())
+    for device in ['cpu', 'gpu']:
+        yield check_select_masks_wrong_input, lambda: test_data(), 1, False, device
 
 def test_select_masks_wrong_mask_meta_dim():
     def test_data():
@@ -112,7 +125,8 @@ def test_select_masks_wrong_mask_meta_dim():
         vertices = [np.array(np.random.rand(9, 2), dtype=np.float32)]
         mask_ids = [np.array([0], dtype=np.int32)]
         return polygons, vertices, mask_ids
-    check_select_masks_wrong_input(lambda: test_data())
+    for device in ['cpu', 'gpu']:
+        yield check_select_masks_wrong_input, lambda: test_data(), 1, False, device
 
 def test_select_masks_wrong_vertex_ids():
     def test_data():
@@ -120,4 +134,5 @@ def test_select_masks_wrong_vertex_ids():
         vertices = [np.array(np.random.rand(3, 2), dtype=np.float32)]  # Only 3 vertices
         mask_ids = [np.array([0], dtype=np.int32)]
         return polygons, vertices, mask_ids
-    check_select_masks_wrong_input(lambda: test_data())
+    for device in ['cpu', 'gpu']:
+        yield check_select_masks_wrong_input, lambda: test_data(), 1, False, device
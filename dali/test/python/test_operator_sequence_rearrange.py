@@ -74,11 +74,13 @@ def check_sequence_rearrange(batch_size, shape, reorders, persample_reorder=True
 order_0 = ([3, 2, 1, 0], False)
 order_1 = ([np.int32([3, 0]), np.int32([2, 1]), np.int32([1, 1]), np.int32([0, 1, 2]), np.int32([3])], True)
 order_2 = ([np.int32([0]), np.int32([1]), np.int32([2]), np.int32([3]), np.int32([0, 1, 2, 3])], True)
+# consecutive frames - the CPU operator returns views of the input
+order_3 = ([1, 2], False)
 
 def test_sequence_rearrange():
     for dev in ["cpu", "gpu"]:
         for shape in [[4, 3, 2], [5, 1]]:
-            for new_order, per_sample in [order_0, order_1, order_2]:
+            for new_order, per_sample in [order_0, order_1, order_2, order_3]:
                 for layout in ["FHW"[:len(shape)], ""]:
                     yield check_sequence_rearrange, 5, shape, new_order, per_sample, dev, layout
 
@@ -359,6 +359,7 @@ def test_slice_synth_data_vs_numpy():
                 ((200,400,3), "HWC", None, "HW", types.INT32, types.FLOAT),
                 ((200,400,3), "HWC", None, "HW", types.INT64, types.UINT8),
                 ((200,400,3), "HWC", None, "C", types.FLOAT, None),
+                ((200,400,3), "HWC", None, "H", types.FLOAT, None),
                 ((200,400,3), "HWC", (1,0), None, types.FLOAT, types.FLOAT16),
                 ((200,400,3), "HWC", (0,1), None, types.FLOAT16, types.FLOAT16),
                 ((200,400,3), "HWC", (2,), None, types.FLOAT, None),
@@ -369,6 +370,7 @@ def test_slice_synth_data_vs_numpy():
                 ((80, 30, 20, 3), "DHWC", (2,1,0), None, types.FLOAT, None),
                 ((80, 30, 20, 3), "DHWC", (0,1,2), None, types.FLOAT, None),
                 ((80, 30, 20, 3), "DHWC", (2,1), None, types.FLOAT, None),
+                ((80, 30, 20, 3), "DHWC", (0,), None, types.FLOAT, None),
                 ((80, 30, 20, 3), "DHWC", None, "WHD", types.FLOAT, None),
                 ((80, 30, 20, 3), "DHWC", None, "DHW", types.FLOAT, None),
                 ((80, 30, 20, 3), "DHWC", None, "WH", types.FLOAT, None),
@@ -136,6 +136,8 @@ def test_operator_spectrogram_vs_python():
                                                                 (16, 16, 8, (1, 1000)),
                                                                 (10, 10, 5, (1, 1000)),
                                                                 (None, 10, 5, (1, 1000)),
+                                                                # split into blocks of windows
+                                                                (256, 256, 64, (1, 100000)),
                                                                 ]:
                     yield check_operator_spectrogram_vs_python, device, batch_size, shape, \
                         nfft, window_length, window_step, center
@@ -247,3 +249,31 @@ def test_operator_decoder_and_spectrogram():
                     for center in [False, True] if nfft == window_length else [True]:
                         yield check_operator_decoder_and_spectrogram_vs_python, device, batch_size, \
                                 nfft, window_length, window_step, center, layout
+
+
+def check_spectrogram_preemphasis(device, batch_size, nfft, window_length, window_step,
+                                  center, coeff):
+    @dali.pipeline_def(batch_size=batch_size, num_threads=3, device_id=0)
+    def pipe(fused):
+        encoded, _ = dali.fn.readers.file(files=audio_files)
+        audio, _ = dali.fn.decoders.audio(encoded, dtype=types.FLOAT, downmix=True)
+        if device == 'gpu':
+            audio = audio.gpu()
+        if fused:
+            return dali.fn.spectrogram(audio, nfft=nfft, window_length=window_length,
+                                       window_step=window_step, center_windows=center,
+                                       preemph_coeff=coeff)
+        audio = dali.fn.preemphasis_filter(audio, preemph_coeff=coeff, border="clamp")
+        return dali.fn.spectrogram(audio, nfft=nfft, window_length=window_length,
+                                   window_step=window_step, center_windows=center)
+
+    compare_pipelines(pipe(True), pipe(False), batch_size=batch_size, N_iterations=3, eps=1e-04)
+
+
+def test_spectrogram_preemphasis():
+    for device in ['cpu', 'gpu']:
+        for nfft, window_length, window_step in [(256, 256, 128), (512, 400, 160)]:
+            for center in [False, True]:
+                for coeff in [0.97, 0.5]:
+                    yield check_spectrogram_preemphasis, device, 3, nfft, window_length, \
+                        window_step, center, coeff
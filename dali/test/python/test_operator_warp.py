@@ -26,6 +26,7 @@ import cv2
 from test_utils import check_batch
 from test_utils import compare_pipelines
 from test_utils import RandomDataIterator
+from nose_utils import assert_raises
 import random
 
 test_data_root = os.environ['DALI_EXTRA_PATH']
@@ -262,3 +263,33 @@ def _test_extremely_large_data(device):
 def test_extremely_large_data():
   for device in ["cpu", "gpu"]:
     yield _test_extremely_large_data, device
+
+def _test_gpu_matrix_arg_input(batch_size):
+  np.random.seed(1234)
+  def get_data():
+    return [np.random.randint(0, 255, [120, 160, 3], dtype=np.uint8) for _ in range(batch_size)]
+  transforms = gen_transforms(batch_size, 10)
+  def get_matrices():
+    return [transforms[i] for i in range(batch_size)]
+
+  pipe = Pipeline(batch_size, 3, 0)
+  with pipe:
+    images = fn.external_source(source=get_data, device="gpu")
+    matrix = fn.external_source(source=get_matrices)
+    cpu_arg = fn.warp_affine(images, matrix=matrix, size=[100, 100])
+    gpu_arg = fn.warp_affine(images, matrix=matrix.gpu(), size=[100, 100])
+  pipe.set_outputs(cpu_arg, gpu_arg)
+  pipe.build()
+  out_cpu_arg, out_gpu_arg = pipe.run()
+  check_batch(out_cpu_arg, out_gpu_arg, batch_size)
+
+def test_gpu_matrix_arg_input():
+  for batch_size in [1, 4]:
+    yield _test_gpu_matrix_arg_input, batch_size
+
+def test_gpu_matrix_arg_input_cpu_op():
+  pipe = Pipeline(1, 3, 0)
+  with pipe:
+    images = fn.external_source(source=lambda: [np.zeros([10, 10, 3], dtype=np.uint8)])
+    matrix = fn.external_source(source=lambda: [np.eye(2, 3, dtype=np.float32)], device="gpu")
+    assert_raises(TypeError, fn.warp_affine, images, matrix=matrix, glob="*GPU*")
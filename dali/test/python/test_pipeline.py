@@ -29,6 +29,7 @@ import random
 from PIL import Image
 from math import floor, ceil
 import sys
+import tempfile
 import warnings
 from webdataset_base import generate_temp_index_file as generate_temp_wds_index
 
@@ -1442,6 +1443,65 @@ def test_bytes_per_sample_hint():
     new_reader_meta = obtain_reader_meta(iters=1, bytes_per_sample_hint = [int(v * 1.1) for v in reader_meta['max_reserved_memory_size']])
     assert new_reader_meta['max_reserved_memory_size'] > reader_meta['max_reserved_memory_size']
 
+def test_memory_hints_file():
+    batch_size = 10
+    def caffe_pipe(**kwargs):
+        pipe = Pipeline(batch_size, 1, 0, **kwargs)
+        with pipe:
+            out, _ = fn.readers.caffe(path=caffe_db_folder, name="Reader")
+            pipe.set_outputs(out.gpu())
+        return pipe
+
+    pipe = caffe_pipe(enable_memory_stats=True)
+    pipe.build()
+    for _ in range(5):
+        pipe.run()
+    hint = pipe.executor_statistics()["CPU_Reader"]["sample_size_hint"][0]
+    assert 0 < hint <= pipe.executor_statistics()["CPU_Reader"]["max_real_memory_size"][0] * 1.25
+
+    with tempfile.NamedTemporaryFile(mode="r", suffix=".txt") as f:
+        pipe.save_memory_hints(f.name)
+        lines = [line for line in f.read().splitlines() if not line.startswith("#")]
+        assert any(line.startswith("Reader\t{} ".format(hint)) for line in lines)
+
+        new_pipe = caffe_pipe(enable_memory_stats=True)
+        new_pipe.load_memory_hints(f.name)
+        new_pipe.build()
+        new_pipe.run()
+        # the buffers are allocated up front from the hints
+        assert new_pipe.executor_statistics()["CPU_Reader"]["max_reserved_memory_size"][0] >= hint
+
+def test_health_metrics():
+    batch_size = 10
+    iters = 5
+    pipe = Pipeline(batch_size, 2, 0, prefetch_queue_depth=2)
+    with pipe:
+        out, _ = fn.readers.caffe(path=caffe_db_folder, name="Reader")
+        pipe.set_outputs(out.gpu())
+    pipe.build()
+    for _ in range(iters):
+        pipe.run()
+    health = pipe.health_metrics()
+    assert health["outputs"] == iters
+    assert health["consumer_starved"] <= iters
+    for stage in ["cpu", "mixed", "gpu"]:
+        stats = health["stages"][stage]
+        # the pipeline runs ahead by the prefetch queue depth
+        assert iters <= stats["iterations"] <= iters + 2
+        assert 0 <= stats["queue_occupancy"] <= stats["queue_capacity"] == 2
+    assert health["stages"]["gpu"]["iterations"] - health["outputs"] == \
+        health["stages"]["gpu"]["queue_occupancy"]
+    reader = health["readers"]["Reader"]
+    assert reader["prefetch_queue_depth"] == 1
+    assert 0 <= reader["prefetch_queue_fill"] <= 1
+    assert health["thread_pool_threads"] == 2
+    assert 0 <= health["thread_pool_busy_fraction"] <= 1
+    assert health["bottleneck"] in ["pipeline", "consumer"]
+
+    text = pipe.health_metrics_prometheus({"pipeline": "test"})
+    assert 'dali_outputs_total{pipeline="test"} 5\n' in text
+    assert 'dali_reader_prefetch_queue_depth{pipeline="test",reader="Reader"} 1\n' in text
+
 def trigger_output_dtype_deprecated_warning():
     batch_size = 10
     shape = (120, 60, 3)
@@ -1651,3 +1711,107 @@ def test_invoke_serialize_error_handling_string():
 @raises(TypeError, "*define_graph*callable*")
 def test_invoke_serialize_error_handling_not_string():
     _identity_pipe().serialize(42)
+
+def test_warmup():
+    batch_size = 4
+    pipe = dali.Pipeline(batch_size, 2, 0)
+    with pipe:
+        data = dali.fn.external_source(name="data", layout="HWC")
+        out = dali.fn.resize(data.gpu(), resize_x=8, resize_y=6)
+        pipe.set_outputs(out, data)
+    pipe.build()
+    pipe.warmup(input_shapes={"data": (20, 30, 3)}, iterations=2)
+    # the outputs of the warmup iterations are discarded
+    for it in range(3):
+        batch = [np.full((10 + i, 15, 3), it + 1, dtype=np.uint8) for i in range(batch_size)]
+        pipe.feed_input("data", batch)
+        out, data = pipe.run()
+        for i in range(batch_size):
+            assert_array_equal(data.at(i), batch[i])
+            assert out.as_cpu().at(i).shape == (6, 8, 3)
+            assert np.all(out.as_cpu().at(i) == it + 1)
+
+def test_external_output_buffers():
+    import cupy as cp
+    batch_size = 4
+    depth = 2
+
+    @pipeline_def(batch_size=batch_size, num_threads=2, device_id=0, prefetch_queue_depth=depth)
+    def pipe():
+        data = fn.external_source(source=lambda info: np.full((10, 15, 3), info.iteration,
+                                                                 dtype=np.uint8),
+                                  batch=False)
+        return fn.resize(data.gpu(), resize_x=8, resize_y=6)
+
+    p = pipe()
+    p.build()
+    buffers = [cp.empty((batch_size, 6, 8, 3), dtype=cp.uint8) for _ in range(depth)]
+    p.set_external_output_buffers(0, buffers)
+    by_ptr = {buf.data.ptr: buf for buf in buffers}
+    p.schedule_run()
+    for it in range(4):
+        out, = p.share_outputs()
+        # written directly to one of the buffers
+        assert out.data_ptr() in by_ptr
+        assert cp.all(by_ptr[out.data_ptr()] == it)
+        assert np.all(out.as_cpu().as_array() == it)
+        p.release_outputs()
+        p.schedule_run()
+
+def test_packed_small_transfers():
+    # the small batches moved to the GPU are uploaded together; the large one is copied alone
+    batch_size = 4
+
+    def labels(info):
+        return np.array([info.iteration, info.idx_in_batch], dtype=np.int32)
+
+    def boxes(info):
+        return np.full((info.idx_in_batch + 1, 4), info.iteration / 10, dtype=np.float32)
+
+    def large(info):
+        # every other iteration, the batch is too large to be packed
+        size = 20000 if info.iteration % 2 else 10
+        return np.full((size,), info.iteration, dtype=np.int64)
+
+    @pipeline_def(batch_size=batch_size, num_threads=2, device_id=0, prefetch_queue_depth=2)
+    def pipe():
+        outs = [fn.external_source(source=src, batch=False) for src in (labels, boxes, large)]
+        return tuple(out.gpu() for out in outs)
+
+    p = pipe()
+    p.build()
+    for it in range(6):
+        out_labels, out_boxes, out_large = p.run()
+        for i in range(batch_size):
+            assert_array_equal(out_labels.as_cpu().at(i), [it, i])
+            assert out_boxes.as_cpu().at(i).shape == (i + 1, 4)
+            assert_allclose(out_boxes.as_cpu().at(i), it / 10)
+            assert np.all(out_large.as_cpu().at(i) == it)
+
+
+def test_low_latency():
+    def data(info):
+        return np.full((16, 16, 3), info.iteration % 256, dtype=np.uint8)
+
+    @pipeline_def(batch_size=1, num_threads=4, device_id=0)
+    def pipe():
+        img = fn.external_source(source=data, batch=False)
+        flipped = fn.flip(img, horizontal=1)
+        return flipped, fn.cast(flipped.gpu(), dtype=types.FLOAT)
+
+    p = pipe(exec_pipelined=False, exec_async=False, enable_low_latency=True)
+    assert p.enable_low_latency
+    p.build()
+    for it in range(5):
+        cpu_out, gpu_out = p.run()
+        assert np.all(np.array(cpu_out[0]) == it)
+        assert np.all(np.array(gpu_out.as_cpu()[0]) == it)
+
+
+def test_low_latency_needs_sync_executor():
+    @pipeline_def(batch_size=1, num_threads=1, device_id=0, enable_low_latency=True)
+    def pipe():
+        return fn.random.uniform(shape=[4])
+
+    with assert_raises(RuntimeError, glob="neither pipelined nor async"):
+        pipe().build()
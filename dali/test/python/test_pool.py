@@ -30,11 +30,11 @@ def simple_callback(info):
     pid = os.getpid()
     return answer(pid, info)
 
-def create_pool(callbacks, queue_depth=1, num_workers=1, start_method="fork"):
+def create_pool(callbacks, queue_depth=1, num_workers=1, start_method="fork", pin_memory=False):
     queue_depths = [queue_depth for _ in callbacks]
     proc_pool = ProcPool(callbacks, queue_depths, num_workers=num_workers,
                          start_method=start_method, initial_chunk_size=1024 * 1024)
-    worker_pool = WorkerPool(len(callbacks), queue_depths, proc_pool)
+    worker_pool = WorkerPool(len(callbacks), queue_depths, proc_pool, pin_memory=pin_memory)
     return worker_pool
 
 def get_pids(worker_pool):
@@ -98,6 +98,28 @@ def test_pool_multi_task(start_method):
     pool.close()
 
 
+def growing_callback(info):
+    # the second batch doesn't fit in the initial chunk, so that the chunk is resized
+    return np.full((info.iteration + 1) * 1024 * 1024, info.idx_in_batch, dtype=np.uint8)
+
+
+@check_pool
+def test_pool_pinned_memory(start_method):
+    callbacks = [growing_callback]
+    pool = create_pool(callbacks, queue_depth=1, num_workers=1, start_method=start_method,
+                       pin_memory=True)
+    get_pids(pool)
+    for iteration in range(2):
+        tasks = [(SampleInfo(i, i, iteration),) for i in range(2)]
+        pool.schedule_batch(context_i=0, batch_i=iteration, dst_chunk_i=0, tasks=tasks)
+        batch = pool.receive_batch(context_i=0)
+        for task, sample in zip(tasks, batch):
+            np.testing.assert_array_equal(growing_callback(*task), sample)
+        for chunk in pool.contexts[0].batch_consumer.batch_pool.values():
+            assert chunk.shm_chunk.is_pinned
+    pool.close()
+
+
 # Even though we receive 1 batch, it already should be overwritten by the result
 # of calculating the second batch, just in case we wait a few seconds
 @check_pool
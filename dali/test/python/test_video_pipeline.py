@@ -419,3 +419,81 @@ def test_pad_sequence():
 
     assert sampl_idx == padded_sampl
     assert ts_index == last_sample_frame_count
+
+def test_keyframe_index():
+    index_dir = tempfile.TemporaryDirectory()
+    os.environ["DALI_VIDEO_INDEX_DIR"] = index_dir.name
+    try:
+        @pipeline_def(batch_size=BATCH_SIZE, num_threads=2, device_id=0, seed=12)
+        def pipe(keyframe_index):
+            frames, labels, frame_num = fn.readers.video(
+                device="gpu", filenames=VIDEO_FILES, sequence_length=COUNT, random_shuffle=True,
+                keyframe_index=keyframe_index, enable_frame_num=True, labels=[])
+            return frames, frame_num
+
+        # the first pipeline builds and stores the indices, the second one loads them
+        for _ in range(2):
+            ref_pipe = pipe(False)
+            ref_pipe.build()
+            index_pipe = pipe(True)
+            index_pipe.build()
+            assert len(os.listdir(index_dir.name)) == len(VIDEO_FILES)
+            for _ in range(ITER):
+                ref_frames, ref_num = ref_pipe.run()
+                frames, num = index_pipe.run()
+                for i in range(BATCH_SIZE):
+                    assert np.array(num[i]) == np.array(ref_num[i])
+                    assert np.array_equal(np.array(frames.as_cpu()[i]),
+                                          np.array(ref_frames.as_cpu()[i]))
+            del ref_pipe, index_pipe
+    finally:
+        del os.environ["DALI_VIDEO_INDEX_DIR"]
+        index_dir.cleanup()
+
+def test_multiple_decoders():
+    @pipeline_def(batch_size=BATCH_SIZE, num_threads=2, device_id=0, seed=12)
+    def pipe(num_decoders):
+        frames, labels, frame_num = fn.readers.video(
+            device="gpu", filenames=VIDEO_FILES, sequence_length=COUNT, random_shuffle=True,
+            num_decoders=num_decoders, enable_frame_num=True, labels=[])
+        return frames, labels, frame_num
+
+    ref_pipe = pipe(1)
+    ref_pipe.build()
+    multi_pipe = pipe(3)
+    multi_pipe.build()
+    for _ in range(ITER):
+        ref_out = ref_pipe.run()
+        out = multi_pipe.run()
+        for i in range(BATCH_SIZE):
+            assert np.array(out[1][i]) == np.array(ref_out[1][i])
+            assert np.array(out[2][i]) == np.array(ref_out[2][i])
+            assert np.array_equal(np.array(out[0].as_cpu()[i]), np.array(ref_out[0].as_cpu()[i]))
+
+def test_video_decoder_in_memory():
+    files = VIDEO_FILES[:BATCH_SIZE]
+
+    @pipeline_def(batch_size=len(files), num_threads=2, device_id=0)
+    def decoder_pipe(num_decoders):
+        encoded, _ = fn.readers.file(files=files)
+        return fn.decoders.video(encoded, device="mixed", num_decoders=num_decoders)
+
+    @pipeline_def(batch_size=1, num_threads=2, device_id=0)
+    def reader_pipe(filename):
+        return fn.readers.video(device="gpu", filenames=[filename], sequence_length=COUNT)
+
+    pipes = [decoder_pipe(1), decoder_pipe(3)]
+    for p in pipes:
+        p.build()
+    outs = [p.run()[0].as_cpu() for p in pipes]
+    for i, filename in enumerate(files):
+        ref_pipe = reader_pipe(filename)
+        ref_pipe.build()
+        ref = np.array(ref_pipe.run()[0].as_cpu()[0])
+        for out in outs:
+            frames = np.array(out[i])
+            assert frames.shape[0] >= COUNT
+            # the first frames of the file match the reader's first sequence
+            assert np.array_equal(frames[:COUNT], ref)
+        assert np.array_equal(np.array(outs[0][i]), np.array(outs[1][i]))
+        del ref_pipe
@@ -44,6 +44,7 @@ def webdataset_raw_pipeline(
     lazy_init=False,
     read_ahead=False,
     stick_to_shard=False,
+    shuffle_after_epoch=False,
 ):
     out = readers.webdataset(
         paths=paths,
@@ -60,6 +61,7 @@ def webdataset_raw_pipeline(
         pad_last_batch=pad_last_batch,
         lazy_init=lazy_init,
         read_ahead=read_ahead,
+        shuffle_after_epoch=shuffle_after_epoch,
     )
     return out if not isinstance(out, list) else tuple(out)
 
@@ -82,6 +84,7 @@ def file_reader_pipeline(
     lazy_init=False,
     read_ahead=False,
     stick_to_shard=False,
+    shuffle_after_epoch=False,
 ):
     if not isinstance(exts, list):
         exts = [exts]
@@ -98,6 +101,7 @@ def file_reader_pipeline(
             pad_last_batch=pad_last_batch,
             lazy_init=lazy_init,
             read_ahead=read_ahead,
+            shuffle_after_epoch=shuffle_after_epoch,
         )[0]
         if type(ext) in {str, set}
         else ext
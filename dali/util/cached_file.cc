@@ -0,0 +1,396 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "dali/core/error_handling.h"
+#include "dali/core/format.h"
+#include "dali/core/util.h"
+#include "dali/util/cached_file.h"
+
+namespace dali {
+
+namespace {
+
+/// the longest run of missing blocks fetched from the inner stream with a single read
+constexpr size_t kMaxFetchBlocks = 16;
+
+const char kDataExt[] = ".data";
+const char kBlocksExt[] = ".blocks";
+
+size_t EnvSize(const char *name, size_t default_value) {
+  const char *env = std::getenv(name);
+  return env && *env ? std::strtoull(env, nullptr, 10) : default_value;
+}
+
+bool EndsWith(const std::string &s, const char *suffix) {
+  size_t n = std::strlen(suffix);
+  return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+}
+
+/**
+ * @brief Exclusive lock of the cache directory, held while the entries are created or removed
+ */
+class DirLock {
+ public:
+  explicit DirLock(const std::string &dir) {
+    std::string path = dir + "/.lock";
+    fd_ = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0666);
+    DALI_ENFORCE(fd_ >= 0, make_string("Could not open ", path, ": ", std::strerror(errno)));
+    while (flock(fd_, LOCK_EX) != 0) {
+      DALI_ENFORCE(errno == EINTR,
+                   make_string("Could not lock ", path, ": ", std::strerror(errno)));
+    }
+  }
+
+  ~DirLock() {
+    flock(fd_, LOCK_UN);
+    close(fd_);
+  }
+
+ private:
+  int fd_ = -1;
+};
+
+bool PreadAll(int fd, uint8_t *buffer, size_t size, size_t offset) {
+  while (size > 0) {
+    ssize_t n = pread(fd, buffer, size, offset);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return false;
+    buffer += n;
+    offset += n;
+    size -= n;
+  }
+  return true;
+}
+
+bool PwriteAll(int fd, const uint8_t *buffer, size_t size, size_t offset) {
+  while (size > 0) {
+    ssize_t n = pwrite(fd, buffer, size, offset);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return false;
+    buffer += n;
+    offset += n;
+    size -= n;
+  }
+  return true;
+}
+
+/// the number of bytes added to the cache by this process since it was last trimmed
+std::atomic<size_t> g_added_bytes{0};
+
+void MaybeTrim(const FileCacheConfig &config, size_t added) {
+  if (!config.size_limit)
+    return;
+  size_t threshold = std::max(config.size_limit / 16, config.block_size);
+  if (g_added_bytes.fetch_add(added) + added < threshold)
+    return;
+  g_added_bytes = 0;
+  CachedFileStream::Trim(config);
+}
+
+}  // namespace
+
+bool FileCacheConfig::Applies(const std::string &path, bool remote) const {
+  if (!enabled())
+    return false;
+  if (remote)
+    return true;
+  if (path.compare(0, dir.size(), dir) == 0)
+    return false;
+  for (auto &prefix : local_prefixes)
+    if (path.compare(0, prefix.size(), prefix) == 0)
+      return true;
+  return false;
+}
+
+const FileCacheConfig &FileCacheConfig::FromEnv() {
+  static const FileCacheConfig config = []() {
+    FileCacheConfig c;
+    if (const char *dir = std::getenv("DALI_FILE_CACHE_DIR"))
+      c.dir = dir;
+    c.size_limit = EnvSize("DALI_FILE_CACHE_SIZE", 0);
+    c.block_size = EnvSize("DALI_FILE_CACHE_BLOCK_SIZE", c.block_size);
+    DALI_ENFORCE(c.block_size > 0, "DALI_FILE_CACHE_BLOCK_SIZE must be positive");
+    if (const char *paths = std::getenv("DALI_FILE_CACHE_PATHS")) {
+      std::string s = paths;
+      size_t start = 0;
+      while (start <= s.size()) {
+        size_t end = std::min(s.find(':', start), s.size());
+        if (end > start)
+          c.local_prefixes.push_back(s.substr(start, end - start));
+        start = end + 1;
+      }
+    }
+    return c;
+  }();
+  return config;
+}
+
+CachedFileStream::CachedFileStream(const std::string &path, std::unique_ptr<FileStream> inner,
+                                   const std::string &version, const FileCacheConfig &config)
+    : FileStream(path), inner_(std::move(inner)), config_(config) {
+  DALI_ENFORCE(config_.enabled() && config_.block_size > 0, "Invalid file cache configuration");
+  size_ = inner_->Size();
+  num_blocks_ = div_ceil(size_, config_.block_size);
+
+  if (mkdir(config_.dir.c_str(), 0777) != 0 && errno != EEXIST)
+    DALI_FAIL(make_string("Could not create the cache directory ", config_.dir, ": ",
+                          std::strerror(errno)));
+
+  static std::once_flag initial_trim;
+  if (config_.size_limit)
+    std::call_once(initial_trim, [&]() { Trim(config_); });
+
+  // the size and the block size are a part of the name, so that a mismatch of the block map
+  // and the data file is not possible
+  char name[64];
+  snprintf(name, sizeof(name), "%016zx_%zu_%zu",
+           std::hash<std::string>()(path + '\n' + version), size_, config_.block_size);
+  std::string base = config_.dir + "/" + name;
+  std::string data_path = base + kDataExt;
+  std::string blocks_path = base + kBlocksExt;
+
+  DirLock lock(config_.dir);
+  data_fd_ = open(data_path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0666);
+  DALI_ENFORCE(data_fd_ >= 0,
+               make_string("Could not open ", data_path, ": ", std::strerror(errno)));
+  blocks_fd_ = open(blocks_path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0666);
+  DALI_ENFORCE(blocks_fd_ >= 0,
+               make_string("Could not open ", blocks_path, ": ", std::strerror(errno)));
+
+  struct stat st;
+  DALI_ENFORCE(fstat(data_fd_, &st) == 0);
+  // a new entry - the data file is sparse, the blocks take space as they are fetched
+  if (static_cast<size_t>(st.st_size) != size_)
+    DALI_ENFORCE(ftruncate(data_fd_, size_) == 0,
+                 make_string("Could not resize ", data_path, ": ", std::strerror(errno)));
+  DALI_ENFORCE(fstat(blocks_fd_, &st) == 0);
+  if (static_cast<size_t>(st.st_size) != num_blocks_)
+    DALI_ENFORCE(ftruncate(blocks_fd_, num_blocks_) == 0,
+                 make_string("Could not resize ", blocks_path, ": ", std::strerror(errno)));
+  // the modification time of the block map is the time of the last use of the entry
+  futimens(blocks_fd_, nullptr);
+
+  if (num_blocks_ > 0) {
+    void *p = mmap(nullptr, num_blocks_, PROT_READ | PROT_WRITE, MAP_SHARED, blocks_fd_, 0);
+    DALI_ENFORCE(p != MAP_FAILED,
+                 make_string("Could not map ", blocks_path, ": ", std::strerror(errno)));
+    present_ = static_cast<volatile uint8_t *>(p);
+  }
+}
+
+void CachedFileStream::Close() {
+  if (present_) {
+    munmap(const_cast<uint8_t *>(present_), num_blocks_);
+    present_ = nullptr;
+  }
+  if (data_fd_ >= 0) {
+    close(data_fd_);
+    data_fd_ = -1;
+  }
+  if (blocks_fd_ >= 0) {
+    close(blocks_fd_);
+    blocks_fd_ = -1;
+  }
+  if (inner_)
+    inner_->Close();
+}
+
+bool CachedFileStream::Fetch(size_t first_block, size_t end_block) {
+  size_t begin = first_block * config_.block_size;
+  size_t end = std::min(size_, end_block * config_.block_size);
+  fetch_buf_.resize(end - begin);
+  inner_->Seek(begin);
+  size_t n = inner_->Read(fetch_buf_.data(), fetch_buf_.size());
+  DALI_ENFORCE(n == fetch_buf_.size(),
+               make_string("Could not read ", fetch_buf_.size(), " bytes at offset ", begin,
+                           " of ", path_));
+  // e.g. the cache drive is full - the blocks are not marked as present
+  if (!PwriteAll(data_fd_, fetch_buf_.data(), fetch_buf_.size(), begin))
+    return false;
+  // the data must be stored before the other processes see the block as present
+  std::atomic_thread_fence(std::memory_order_release);
+  for (size_t b = first_block; b < end_block; b++)
+    present_[b] = 1;
+  futimens(blocks_fd_, nullptr);
+  MaybeTrim(config_, fetch_buf_.size());
+  return true;
+}
+
+bool CachedFileStream::Load(size_t offset, size_t size, uint8_t *buffer) {
+  if (size == 0)
+    return true;
+  size_t bs = config_.block_size;
+  size_t end = offset + size;
+  size_t last_block = (end - 1) / bs + 1;
+  bool all_cached = true;
+  size_t pos = offset;
+  while (pos < end) {
+    size_t block = pos / bs;
+    bool present = present_[block];
+    size_t run_end = block + 1;
+    while (run_end < last_block && static_cast<bool>(present_[run_end]) == present &&
+           (present || run_end - block < kMaxFetchBlocks))
+      run_end++;
+    size_t chunk_end = std::min(end, run_end * bs);
+    if (present) {
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (buffer)
+        DALI_ENFORCE(PreadAll(data_fd_, buffer + (pos - offset), chunk_end - pos, pos),
+                     make_string("Could not read the cached data of ", path_, ": ",
+                                 std::strerror(errno)));
+    } else {
+      all_cached &= Fetch(block, run_end);
+      if (buffer)
+        std::memcpy(buffer + (pos - offset), fetch_buf_.data() + (pos - block * bs),
+                    chunk_end - pos);
+    }
+    pos = chunk_end;
+  }
+  return all_cached;
+}
+
+size_t CachedFileStream::Read(uint8_t *buffer, size_t n_bytes) {
+  n_bytes = std::min(n_bytes, size_ - std::min(pos_, size_));
+  Load(pos_, n_bytes, buffer);
+  pos_ += n_bytes;
+  return n_bytes;
+}
+
+shared_ptr<void> CachedFileStream::Get(size_t n_bytes) {
+  if (pos_ + n_bytes > size_)
+    return {};
+  size_t offset = pos_;
+  if (n_bytes > 0 && Load(offset, n_bytes, nullptr)) {
+    size_t page = sysconf(_SC_PAGESIZE);
+    size_t map_offset = offset / page * page;
+    size_t length = offset + n_bytes - map_offset;
+    void *p = mmap(nullptr, length, PROT_READ, MAP_SHARED, data_fd_, map_offset);
+    if (p != MAP_FAILED) {
+      pos_ += n_bytes;
+      return shared_ptr<void>(static_cast<uint8_t *>(p) + (offset - map_offset),
+                              [p, length](void *) { munmap(p, length); });
+    }
+  }
+  // the blocks could not be cached or mapped - return a copy
+  shared_ptr<uint8_t> data(new uint8_t[n_bytes], std::default_delete<uint8_t[]>());
+  Load(offset, n_bytes, data.get());
+  pos_ += n_bytes;
+  return data;
+}
+
+void CachedFileStream::Seek(int64 pos) {
+  DALI_ENFORCE(pos >= 0 && static_cast<size_t>(pos) <= size_,
+               make_string("Invalid seek to ", pos, " in ", path_, " of size ", size_));
+  pos_ = pos;
+}
+
+int64 CachedFileStream::Tell() const {
+  return pos_;
+}
+
+size_t CachedFileStream::Size() const {
+  return size_;
+}
+
+namespace {
+
+struct CacheEntry {
+  std::string base;
+  timespec last_use;
+  size_t size;
+};
+
+std::vector<CacheEntry> ListEntries(const std::string &dir) {
+  std::vector<CacheEntry> entries;
+  DIR *d = opendir(dir.c_str());
+  if (!d)
+    return entries;
+  while (dirent *e = readdir(d)) {
+    std::string name = e->d_name;
+    if (!EndsWith(name, kDataExt))
+      continue;
+    CacheEntry entry;
+    entry.base = dir + "/" + name.substr(0, name.size() - (sizeof(kDataExt) - 1));
+    struct stat st;
+    if (stat((entry.base + kDataExt).c_str(), &st) != 0)
+      continue;
+    // the space taken by the blocks which were actually fetched
+    entry.size = st.st_blocks * 512;
+    // an entry without the block map is not usable - it goes first
+    entry.last_use = stat((entry.base + kBlocksExt).c_str(), &st) == 0 ? st.st_mtim : timespec{};
+    entries.push_back(std::move(entry));
+  }
+  closedir(d);
+  return entries;
+}
+
+}  // namespace
+
+size_t CachedFileStream::Usage(const std::string &dir) {
+  size_t total = 0;
+  for (auto &e : ListEntries(dir))
+    total += e.size;
+  return total;
+}
+
+void CachedFileStream::Trim(const FileCacheConfig &config) {
+  if (!config.size_limit)
+    return;
+  DirLock lock(config.dir);
+  auto entries = ListEntries(config.dir);
+  size_t total = 0;
+  for (auto &e : entries)
+    total += e.size;
+  if (total <= config.size_limit)
+    return;
+  std::sort(entries.begin(), entries.end(), [](const CacheEntry &a, const CacheEntry &b) {
+    return a.last_use.tv_sec != b.last_use.tv_sec ? a.last_use.tv_sec < b.last_use.tv_sec
+                                                  : a.last_use.tv_nsec < b.last_use.tv_nsec;
+  });
+  // leave some room, so that the cache is not trimmed again right away
+  size_t target = config.size_limit - config.size_limit / 8;
+  for (auto &e : entries) {
+    if (total <= target)
+      break;
+    // the block map goes first - orphaned, it would claim that the blocks of a new data file
+    // are present
+    unlink((e.base + kBlocksExt).c_str());
+    unlink((e.base + kDataExt).c_str());
+    total -= e.size;
+  }
+}
+
+}  // namespace dali
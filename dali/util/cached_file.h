@@ -0,0 +1,138 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_UTIL_CACHED_FILE_H_
+#define DALI_UTIL_CACHED_FILE_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dali/core/common.h"
+#include "dali/util/file.h"
+
+namespace dali {
+
+/**
+ * @brief Configuration of the local block cache of the files
+ *
+ * Read from the environment variables by `FromEnv`:
+ * - DALI_FILE_CACHE_DIR - the directory of the cache, preferably on a local NVMe drive;
+ *   the cache is disabled, if it's not set
+ * - DALI_FILE_CACHE_SIZE - the limit of the size of the cache, in bytes (0 - unlimited)
+ * - DALI_FILE_CACHE_BLOCK_SIZE - the granularity of the cache, in bytes (default 1 MiB)
+ * - DALI_FILE_CACHE_PATHS - colon-separated prefixes of the local paths (e.g. NFS mounts)
+ *   to cache; the remote objects (see HttpFileStream) are always cached
+ */
+struct DLL_PUBLIC FileCacheConfig {
+  std::string dir;
+  size_t size_limit = 0;
+  size_t block_size = 1 << 20;
+  std::vector<std::string> local_prefixes;
+
+  bool enabled() const noexcept {
+    return !dir.empty();
+  }
+
+  /**
+   * @brief Checks if the file should be read through the cache
+   */
+  bool Applies(const std::string &path, bool remote) const;
+
+  static const FileCacheConfig &FromEnv();
+};
+
+/**
+ * @brief FileStream which keeps the blocks read from another (slow or remote) stream
+ *        in a local cache directory
+ *
+ * Each cached file is a sparse file of the size of the original one, accompanied with a map
+ * of the blocks present. Both are shared (through the page cache) by all the processes which
+ * use the same cache directory - e.g. the per-GPU processes on a node - so a block is fetched
+ * from the original stream once per node, by whichever reader needs it first.
+ *
+ * `Get` maps the cached blocks, so the loaders using mmap (and the MappingReserver logic)
+ * work without copying, once the data is in the cache.
+ *
+ * The cache is trimmed, in the least recently used order of the files, when it exceeds
+ * the size limit. The entries are created and evicted under a file lock of the cache
+ * directory; the evicted files remain valid for the streams which have them open.
+ */
+class DLL_PUBLIC CachedFileStream : public FileStream {
+ public:
+  /**
+   * @param path    the path or URI of the file
+   * @param inner   the stream to read the missing blocks from
+   * @param version distinguishes the versions of the file with the same path and size,
+   *                e.g. the modification time
+   */
+  CachedFileStream(const std::string &path, std::unique_ptr<FileStream> inner,
+                   const std::string &version, const FileCacheConfig &config);
+  void Close() override;
+  shared_ptr<void> Get(size_t n_bytes) override;
+  size_t Read(uint8_t *buffer, size_t n_bytes) override;
+  void Seek(int64 pos) override;
+  int64 Tell() const override;
+  size_t Size() const override;
+
+  ~CachedFileStream() override {
+    Close();
+  }
+
+  /**
+   * @brief Removes the least recently used files from the cache, until it's below the limit
+   *
+   * Called automatically, after enough data is added to the cache.
+   */
+  static void Trim(const FileCacheConfig &config);
+
+  /**
+   * @brief The size of the data stored in the cache directory, in bytes
+   */
+  static size_t Usage(const std::string &dir);
+
+ private:
+  /**
+   * @brief Makes sure that the blocks of the range are cached and copies the range to the
+   *        buffer, if it's not null.
+   *
+   * @return false, if some blocks could not be stored in the cache (the data in the buffer
+   *         is valid nonetheless)
+   */
+  bool Load(size_t offset, size_t size, uint8_t *buffer);
+
+  /**
+   * @brief Reads the blocks from the inner stream to `fetch_buf_` and stores them in the cache
+   *
+   * @return false, if the blocks could not be stored
+   */
+  bool Fetch(size_t first_block, size_t end_block);
+
+  std::unique_ptr<FileStream> inner_;
+  FileCacheConfig config_;
+  int data_fd_ = -1;
+  int blocks_fd_ = -1;
+  /// one byte per block, shared with the other processes; a non-zero value means that
+  /// the block is present in the data file
+  volatile uint8_t *present_ = nullptr;
+  size_t num_blocks_ = 0;
+  size_t size_ = 0;
+  size_t pos_ = 0;
+  std::vector<uint8_t> fetch_buf_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_UTIL_CACHED_FILE_H_
@@ -0,0 +1,183 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <dirent.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dali/util/cached_file.h"
+
+namespace dali {
+
+namespace {
+
+/**
+ * @brief In-memory stream, which counts the bytes read from it
+ */
+class CountingStream : public FileStream {
+ public:
+  CountingStream(const std::vector<uint8_t> &data, size_t *bytes_read)
+      : FileStream("memory"), data_(data), bytes_read_(bytes_read) {}
+
+  void Close() override {}
+
+  size_t Read(uint8_t *buffer, size_t n_bytes) override {
+    n_bytes = std::min(n_bytes, data_.size() - pos_);
+    std::memcpy(buffer, data_.data() + pos_, n_bytes);
+    pos_ += n_bytes;
+    *bytes_read_ += n_bytes;
+    return n_bytes;
+  }
+
+  shared_ptr<void> Get(size_t) override {
+    return {};
+  }
+
+  void Seek(int64 pos) override {
+    pos_ = pos;
+  }
+
+  int64 Tell() const override {
+    return pos_;
+  }
+
+  size_t Size() const override {
+    return data_.size();
+  }
+
+ private:
+  const std::vector<uint8_t> &data_;
+  size_t *bytes_read_;
+  size_t pos_ = 0;
+};
+
+std::vector<uint8_t> TestData(size_t size) {
+  std::vector<uint8_t> data(size);
+  for (size_t i = 0; i < size; i++)
+    data[i] = static_cast<uint8_t>(i * 13 + i / 257);
+  return data;
+}
+
+class CachedFileTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    char dir[] = "/tmp/dali_file_cache_XXXXXX";
+    ASSERT_NE(mkdtemp(dir), nullptr);
+    config_.dir = dir;
+    config_.block_size = 4096;
+  }
+
+  void TearDown() override {
+    if (DIR *d = opendir(config_.dir.c_str())) {
+      while (dirent *e = readdir(d)) {
+        if (e->d_name[0] != '.' || std::strcmp(e->d_name, ".lock") == 0)
+          unlink((config_.dir + "/" + e->d_name).c_str());
+      }
+      closedir(d);
+    }
+    rmdir(config_.dir.c_str());
+  }
+
+  std::unique_ptr<FileStream> Open(const std::string &path, const std::vector<uint8_t> &data,
+                                   size_t *bytes_read) {
+    std::unique_ptr<FileStream> inner(new CountingStream(data, bytes_read));
+    return std::unique_ptr<FileStream>(
+        new CachedFileStream(path, std::move(inner), "v1", config_));
+  }
+
+  FileCacheConfig config_;
+};
+
+}  // namespace
+
+TEST_F(CachedFileTest, ReadThrough) {
+  auto data = TestData(10 * 4096 + 123);
+  size_t bytes_read = 0;
+  auto file = Open("a", data, &bytes_read);
+  ASSERT_EQ(file->Size(), data.size());
+
+  std::vector<uint8_t> buf(5000);
+  file->Seek(3000);
+  ASSERT_EQ(file->Read(buf.data(), buf.size()), buf.size());
+  EXPECT_TRUE(std::equal(buf.begin(), buf.end(), data.begin() + 3000));
+  // the whole blocks 0 and 1 are fetched
+  EXPECT_EQ(bytes_read, 2 * 4096u);
+
+  // a second stream of the same file (e.g. in another process) uses the cached blocks
+  size_t bytes_read2 = 0;
+  auto file2 = Open("a", data, &bytes_read2);
+  file2->Seek(100);
+  ASSERT_EQ(file2->Read(buf.data(), 4000), 4000u);
+  EXPECT_TRUE(std::equal(buf.begin(), buf.begin() + 4000, data.begin() + 100));
+  EXPECT_EQ(bytes_read2, 0u);
+
+  // the tail of the file
+  file2->Seek(data.size() - 200);
+  EXPECT_EQ(file2->Read(buf.data(), buf.size()), 200u);
+  EXPECT_TRUE(std::equal(buf.begin(), buf.begin() + 200, data.end() - 200));
+  EXPECT_EQ(bytes_read2, 4096u + 123u);
+
+  // a different version of the file is a different entry
+  size_t bytes_read3 = 0;
+  std::unique_ptr<FileStream> inner(new CountingStream(data, &bytes_read3));
+  CachedFileStream file3("a", std::move(inner), "v2", config_);
+  ASSERT_EQ(file3.Read(buf.data(), 10), 10u);
+  EXPECT_EQ(bytes_read3, 4096u);
+}
+
+TEST_F(CachedFileTest, Get) {
+  auto data = TestData(5 * 4096);
+  size_t bytes_read = 0;
+  auto file = Open("b", data, &bytes_read);
+  file->Seek(5000);
+  auto p = file->Get(6000);
+  ASSERT_NE(p, nullptr);
+  EXPECT_TRUE(std::equal(data.begin() + 5000, data.begin() + 11000,
+                         static_cast<const uint8_t *>(p.get())));
+  EXPECT_EQ(file->Tell(), 11000);
+  file->Close();
+  // the mapping outlives the stream
+  EXPECT_EQ(static_cast<const uint8_t *>(p.get())[0], data[5000]);
+}
+
+TEST_F(CachedFileTest, Trim) {
+  size_t file_size = 16 * 4096;
+  config_.size_limit = 3 * file_size;
+  auto data = TestData(file_size);
+  for (int i = 0; i < 6; i++) {
+    size_t bytes_read = 0;
+    auto file = Open("file" + std::to_string(i), data, &bytes_read);
+    std::vector<uint8_t> buf(file_size);
+    ASSERT_EQ(file->Read(buf.data(), buf.size()), buf.size());
+    EXPECT_LE(CachedFileStream::Usage(config_.dir), config_.size_limit + file_size);
+  }
+  CachedFileStream::Trim(config_);
+  EXPECT_LE(CachedFileStream::Usage(config_.dir), config_.size_limit);
+  EXPECT_GT(CachedFileStream::Usage(config_.dir), 0u);
+
+  // the most recently used file is still cached
+  size_t bytes_read = 0;
+  auto file = Open("file5", data, &bytes_read);
+  std::vector<uint8_t> buf(file_size);
+  ASSERT_EQ(file->Read(buf.data(), buf.size()), buf.size());
+  EXPECT_EQ(bytes_read, 0u);
+}
+
+}  // namespace dali
@@ -12,9 +12,13 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <sys/stat.h>
 #include <string>
 
+#include "dali/core/format.h"
+#include "dali/util/cached_file.h"
 #include "dali/util/file.h"
+#include "dali/util/http_file.h"
 #include "dali/util/mmaped_file.h"
 #include "dali/util/std_file.h"
 
@@ -23,6 +27,16 @@ namespace dali {
 std::unique_ptr<FileStream> FileStream::Open(const std::string& uri, bool read_ahead,
                                              bool use_mmap) {
   std::string processed_uri;
+  const auto &cache_config = FileCacheConfig::FromEnv();
+
+  // the remote objects are read with range requests, there's nothing to map
+  if (http::IsRemoteUri(uri)) {
+    std::unique_ptr<FileStream> stream(new HttpFileStream(uri, read_ahead));
+    if (cache_config.Applies(uri, true))
+      return std::unique_ptr<FileStream>(
+          new CachedFileStream(uri, std::move(stream), "", cache_config));
+    return stream;
+  }
 
   if (uri.find("file://") == 0) {
     processed_uri = uri.substr(std::string("file://").size());
@@ -30,6 +44,17 @@ std::unique_ptr<FileStream> FileStream::Open(const std::string& uri, bool read_a
     processed_uri = uri;
   }
 
+  if (cache_config.Applies(processed_uri, false)) {
+    // the cached blocks are mapped by CachedFileStream::Get, the original file is just read
+    struct stat st;
+    std::string version;
+    if (stat(processed_uri.c_str(), &st) == 0)
+      version = make_string(st.st_mtim.tv_sec, ".", st.st_mtim.tv_nsec);
+    std::unique_ptr<FileStream> stream(new StdFileStream(processed_uri));
+    return std::unique_ptr<FileStream>(
+        new CachedFileStream(processed_uri, std::move(stream), version, cache_config));
+  }
+
   if (use_mmap) {
     return std::unique_ptr<FileStream>(new MmapedFileStream(processed_uri, read_ahead));
   } else {
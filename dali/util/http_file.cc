@@ -0,0 +1,459 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <errno.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "dali/core/error_handling.h"
+#include "dali/core/format.h"
+#include "dali/core/util.h"
+#include "dali/util/http_file.h"
+
+namespace dali {
+
+namespace http {
+
+namespace {
+
+size_t EnvSize(const char *name, size_t default_value) {
+  if (const char *env = std::getenv(name))
+    return std::strtoull(env, nullptr, 10);
+  return default_value;
+}
+
+bool StartsWith(const std::string &s, const char *prefix) {
+  return s.compare(0, std::strlen(prefix), prefix) == 0;
+}
+
+std::string HostHeader(const Url &url) {
+  return url.port == 80 ? url.host : make_string(url.host, ":", url.port);
+}
+
+/**
+ * @brief An error of the connection itself, after which the request can be retried
+ */
+struct ConnectionError : std::runtime_error {
+  explicit ConnectionError(const std::string &what) : std::runtime_error(what) {}
+};
+
+class Connection {
+ public:
+  Connection(const std::string &host, int port) {
+    addrinfo hints = {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo *addrs = nullptr;
+    int err = getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &addrs);
+    DALI_ENFORCE(err == 0, make_string("Cannot resolve host \"", host, "\": ", gai_strerror(err)));
+    for (addrinfo *a = addrs; a; a = a->ai_next) {
+      fd_ = socket(a->ai_family, a->ai_socktype | SOCK_CLOEXEC, a->ai_protocol);
+      if (fd_ < 0)
+        continue;
+      if (connect(fd_, a->ai_addr, a->ai_addrlen) == 0)
+        break;
+      close(fd_);
+      fd_ = -1;
+    }
+    freeaddrinfo(addrs);
+    DALI_ENFORCE(fd_ >= 0, make_string("Cannot connect to ", host, ":", port, ": ",
+                                       std::strerror(errno)));
+    int one = 1;
+    setsockopt(fd_, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    timeval timeout = { 60, 0 };
+    setsockopt(fd_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(fd_, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+  }
+
+  ~Connection() {
+    if (fd_ >= 0)
+      close(fd_);
+  }
+
+  Connection(const Connection &) = delete;
+  Connection &operator=(const Connection &) = delete;
+
+  void Send(const std::string &data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+      ssize_t n = send(fd_, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+      if (n < 0 && errno == EINTR)
+        continue;
+      if (n <= 0)
+        throw ConnectionError(make_string("HTTP send failed: ", std::strerror(errno)));
+      sent += n;
+    }
+  }
+
+  /**
+   * @brief Reads the status line and the headers; the data past them is kept for ReadBody
+   */
+  std::string ReadHead() {
+    size_t end;
+    while ((end = pending_.find("\r\n\r\n")) == std::string::npos) {
+      DALI_ENFORCE(pending_.size() < kMaxHeadSize, "HTTP response headers are too long");
+      char buf[4096];
+      size_t n = Recv(buf, sizeof(buf));
+      if (n == 0)
+        throw ConnectionError("HTTP connection closed by the server");
+      pending_.append(buf, n);
+    }
+    std::string head = pending_.substr(0, end);
+    pending_.erase(0, end + 4);
+    return head;
+  }
+
+  void ReadBody(uint8_t *buffer, size_t size) {
+    size_t from_pending = std::min(size, pending_.size());
+    std::memcpy(buffer, pending_.data(), from_pending);
+    pending_.erase(0, from_pending);
+    for (size_t done = from_pending; done < size; ) {
+      size_t n = Recv(buffer + done, size - done);
+      if (n == 0)
+        throw ConnectionError("HTTP connection closed before the end of the response");
+      done += n;
+    }
+  }
+
+  void Discard(size_t size) {
+    uint8_t buf[4096];
+    while (size > 0) {
+      size_t n = std::min(size, sizeof(buf));
+      ReadBody(buf, n);
+      size -= n;
+    }
+  }
+
+ private:
+  static constexpr size_t kMaxHeadSize = 1 << 16;
+
+  size_t Recv(void *buffer, size_t size) {
+    for (;;) {
+      ssize_t n = recv(fd_, buffer, size, 0);
+      if (n >= 0)
+        return n;
+      if (errno != EINTR)
+        throw ConnectionError(make_string("HTTP receive failed: ", std::strerror(errno)));
+    }
+  }
+
+  int fd_ = -1;
+  std::string pending_;
+};
+
+struct Response {
+  int status = 0;
+  size_t content_length = std::string::npos;
+  bool keep_alive = true;
+};
+
+Response ParseHead(const std::string &head) {
+  Response r;
+  size_t line_end = head.find("\r\n");
+  std::string status_line = head.substr(0, line_end);
+  DALI_ENFORCE(StartsWith(status_line, "HTTP/1.") && status_line.size() >= 12,
+               make_string("Malformed HTTP response: ", status_line));
+  r.status = std::atoi(status_line.c_str() + 9);
+  r.keep_alive = status_line[7] != '0';  // HTTP/1.0 closes by default
+
+  while (line_end != std::string::npos) {
+    size_t begin = line_end + 2;
+    line_end = head.find("\r\n", begin);
+    std::string line = head.substr(begin, line_end == std::string::npos ? std::string::npos
+                                                                        : line_end - begin);
+    size_t colon = line.find(':');
+    if (colon == std::string::npos)
+      continue;
+    std::string name = line.substr(0, colon);
+    std::transform(name.begin(), name.end(), name.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+    size_t value_begin = line.find_first_not_of(' ', colon + 1);
+    std::string value = value_begin == std::string::npos ? "" : line.substr(value_begin);
+    std::transform(value.begin(), value.end(), value.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+    if (name == "content-length") {
+      r.content_length = std::strtoull(value.c_str(), nullptr, 10);
+    } else if (name == "connection") {
+      r.keep_alive = value.find("close") == std::string::npos;
+    } else if (name == "transfer-encoding") {
+      DALI_ENFORCE(value == "identity", "Chunked HTTP responses are not supported");
+    }
+  }
+  return r;
+}
+
+/**
+ * @brief Keeps the idle connections, so that consecutive requests don't reconnect
+ */
+class ConnectionPool {
+ public:
+  std::unique_ptr<Connection> Acquire(const Url &url, bool &reused) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto &idle = idle_[HostHeader(url)];
+      if (!idle.empty()) {
+        auto conn = std::move(idle.back());
+        idle.pop_back();
+        reused = true;
+        return conn;
+      }
+    }
+    reused = false;
+    return std::make_unique<Connection>(url.host, url.port);
+  }
+
+  void Release(const Url &url, std::unique_ptr<Connection> conn) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto &idle = idle_[HostHeader(url)];
+    if (idle.size() < kMaxIdlePerHost)
+      idle.push_back(std::move(conn));
+  }
+
+ private:
+  static constexpr size_t kMaxIdlePerHost = 32;
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::vector<std::unique_ptr<Connection>>> idle_;
+};
+
+ConnectionPool &Pool() {
+  static ConnectionPool pool;
+  return pool;
+}
+
+/**
+ * @brief Sends a request and passes the response to `handle`
+ *
+ * `handle` returns true if it read the whole response and the connection can be reused.
+ * A request sent over a reused connection, which turns out to be closed by the server,
+ * is retried with a new one.
+ */
+template <typename Handler>
+void Request(const Url &url, const char *method, const std::string &headers, Handler &&handle) {
+  std::string request = make_string(method, " ", url.target, " HTTP/1.1\r\n",
+                                    "Host: ", HostHeader(url), "\r\n",
+                                    "User-Agent: DALI\r\n", headers, "\r\n");
+  for (int attempt = 0; ; attempt++) {
+    bool reused = false;
+    auto conn = Pool().Acquire(url, reused);
+    try {
+      conn->Send(request);
+      Response response = ParseHead(conn->ReadHead());
+      if (handle(*conn, response) && response.keep_alive)
+        Pool().Release(url, std::move(conn));
+      return;
+    } catch (const ConnectionError &e) {
+      if (!reused || attempt > 0)
+        DALI_FAIL(make_string("HTTP request for http://", HostHeader(url), url.target,
+                              " failed: ", e.what()));
+    }
+  }
+}
+
+}  // namespace
+
+bool IsRemoteUri(const std::string &uri) {
+  return StartsWith(uri, "http://") || StartsWith(uri, "https://") || StartsWith(uri, "s3://");
+}
+
+Url ParseUrl(const std::string &uri) {
+  std::string rest;
+  if (StartsWith(uri, "s3://")) {
+    const char *endpoint = std::getenv("DALI_S3_ENDPOINT");
+    DALI_ENFORCE(endpoint != nullptr, make_string("Cannot open \"", uri, "\": the S3 endpoint "
+                 "must be provided in DALI_S3_ENDPOINT environment variable"));
+    std::string base = endpoint;
+    while (!base.empty() && base.back() == '/')
+      base.pop_back();
+    return ParseUrl(base + "/" + uri.substr(5));
+  }
+  DALI_ENFORCE(!StartsWith(uri, "https://"), make_string("Cannot open \"", uri,
+               "\": HTTPS is not supported, use an HTTP endpoint"));
+  DALI_ENFORCE(StartsWith(uri, "http://"), make_string("Not an HTTP URL: \"", uri, "\""));
+  rest = uri.substr(7);
+
+  Url url;
+  size_t slash = rest.find('/');
+  std::string authority = rest.substr(0, slash);
+  url.target = slash == std::string::npos ? "/" : rest.substr(slash);
+  size_t colon = authority.rfind(':');
+  if (colon != std::string::npos && authority.find(']', colon) == std::string::npos) {
+    url.port = std::atoi(authority.c_str() + colon + 1);
+    authority.resize(colon);
+  }
+  // IPv6 literals are given in brackets
+  if (authority.size() > 2 && authority.front() == '[' && authority.back() == ']')
+    authority = authority.substr(1, authority.size() - 2);
+  DALI_ENFORCE(!authority.empty() && url.port > 0,
+               make_string("Malformed URL: \"", uri, "\""));
+  url.host = std::move(authority);
+  return url;
+}
+
+size_t GetSize(const Url &url) {
+  size_t size = 0;
+  Request(url, "HEAD", "", [&](Connection &, const Response &response) {
+    DALI_ENFORCE(response.status == 200,
+                 make_string("Cannot open http://", HostHeader(url), url.target,
+                             ": the server responded with status ", response.status));
+    DALI_ENFORCE(response.content_length != std::string::npos,
+                 make_string("The size of http://", HostHeader(url), url.target,
+                             " is unknown"));
+    size = response.content_length;
+    return true;
+  });
+  return size;
+}
+
+void GetRange(const Url &url, size_t offset, size_t size, uint8_t *buffer) {
+  if (size == 0)
+    return;
+  std::string range = make_string("Range: bytes=", offset, "-", offset + size - 1, "\r\n");
+  Request(url, "GET", range, [&](Connection &conn, const Response &response) {
+    if (response.status == 206) {
+      DALI_ENFORCE(response.content_length == size,
+                   make_string("Unexpected size of the range of http://", HostHeader(url),
+                               url.target, ": ", response.content_length, " instead of ", size));
+      conn.ReadBody(buffer, size);
+      return true;
+    }
+    DALI_ENFORCE(response.status == 200,
+                 make_string("Reading http://", HostHeader(url), url.target,
+                             " failed: the server responded with status ", response.status));
+    // the server ignored the range - skip the data around it
+    DALI_ENFORCE(response.content_length != std::string::npos &&
+                 response.content_length >= offset + size,
+                 make_string("Unexpected size of http://", HostHeader(url), url.target));
+    conn.Discard(offset);
+    conn.ReadBody(buffer, size);
+    size_t remaining = response.content_length - offset - size;
+    if (remaining > (1 << 16))
+      return false;  // cheaper to reconnect
+    conn.Discard(remaining);
+    return true;
+  });
+}
+
+}  // namespace http
+
+HttpFileStream::HttpFileStream(const std::string &uri, bool read_ahead)
+    : FileStream(uri), url_(http::ParseUrl(uri)) {
+  size_ = http::GetSize(url_);
+  read_ahead_size_ = http::EnvSize("DALI_HTTP_READ_AHEAD", read_ahead ? (4 << 20) : (1 << 20));
+}
+
+void HttpFileStream::Close() {
+  read_ahead_buf_.clear();
+  read_ahead_buf_.shrink_to_fit();
+  read_ahead_offset_ = 0;
+  pos_ = 0;
+}
+
+void HttpFileStream::Seek(int64 pos) {
+  DALI_ENFORCE(pos >= 0 && pos <= static_cast<int64>(size_), "Invalid seek");
+  pos_ = pos;
+}
+
+int64 HttpFileStream::Tell() const {
+  return pos_;
+}
+
+size_t HttpFileStream::Size() const {
+  return size_;
+}
+
+size_t HttpFileStream::Read(uint8_t *buffer, size_t n_bytes) {
+  n_bytes = std::min(n_bytes, size_ - pos_);
+  size_t done = 0;
+  if (pos_ >= read_ahead_offset_ && pos_ < read_ahead_offset_ + read_ahead_buf_.size()) {
+    done = std::min(n_bytes, read_ahead_offset_ + read_ahead_buf_.size() - pos_);
+    std::memcpy(buffer, read_ahead_buf_.data() + (pos_ - read_ahead_offset_), done);
+  }
+  size_t remaining = n_bytes - done;
+  if (remaining > 0) {
+    size_t offset = pos_ + done;
+    if (remaining < read_ahead_size_) {
+      // fetch the whole window and serve the rest of the read from it
+      read_ahead_buf_.resize(std::min(read_ahead_size_, size_ - offset));
+      read_ahead_offset_ = offset;
+      ReadRange(read_ahead_buf_.data(), offset, read_ahead_buf_.size());
+      std::memcpy(buffer + done, read_ahead_buf_.data(), remaining);
+    } else {
+      ReadRange(buffer + done, offset, remaining);
+    }
+  }
+  pos_ += n_bytes;
+  return n_bytes;
+}
+
+shared_ptr<void> HttpFileStream::Get(size_t n_bytes) {
+  if (pos_ + n_bytes > size_)
+    return {};
+  // there's no mapping to share - the data is read to a buffer owned by the returned pointer
+  shared_ptr<uint8_t> data(new uint8_t[n_bytes], std::default_delete<uint8_t[]>());
+  Read(data.get(), n_bytes);
+  return data;
+}
+
+void HttpFileStream::ReadRange(uint8_t *buffer, size_t offset, size_t size) {
+  static const size_t range_size =
+      std::max<size_t>(http::EnvSize("DALI_HTTP_RANGE_SIZE", 8 << 20), 1);
+  static const size_t max_parallel =
+      std::max<size_t>(http::EnvSize("DALI_HTTP_MAX_PARALLEL_REQUESTS", 8), 1);
+  if (size <= range_size) {
+    http::GetRange(url_, offset, size, buffer);
+    return;
+  }
+
+  size_t nparts = div_ceil(size, range_size);
+  size_t nthreads = std::min(nparts, max_parallel);
+  std::vector<std::exception_ptr> errors(nthreads);
+  auto read_parts = [&](size_t first) {
+    try {
+      for (size_t part = first; part < nparts; part += nthreads) {
+        size_t part_offset = part * range_size;
+        http::GetRange(url_, offset + part_offset, std::min(range_size, size - part_offset),
+                       buffer + part_offset);
+      }
+    } catch (...) {
+      errors[first] = std::current_exception();
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t t = 1; t < nthreads; t++)
+    threads.emplace_back(read_parts, t);
+  read_parts(0);
+  for (auto &t : threads)
+    t.join();
+  for (auto &e : errors)
+    if (e)
+      std::rethrow_exception(e);
+}
+
+}  // namespace dali
@@ -0,0 +1,108 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_UTIL_HTTP_FILE_H_
+#define DALI_UTIL_HTTP_FILE_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dali/core/common.h"
+#include "dali/util/file.h"
+
+namespace dali {
+
+namespace http {
+
+struct Url {
+  std::string host;
+  int port = 80;
+  /// the path and the query, starting with '/'
+  std::string target;
+};
+
+/**
+ * @brief Parses `http://host[:port][/path]`
+ *
+ * `s3://bucket/key` is translated to a path-style URL of the endpoint given in
+ * the DALI_S3_ENDPOINT environment variable (e.g. `http://localhost:9000`).
+ */
+DLL_PUBLIC Url ParseUrl(const std::string &uri);
+
+/**
+ * @brief Checks if the URI refers to a remote object, which should be read with HttpFileStream
+ */
+DLL_PUBLIC bool IsRemoteUri(const std::string &uri);
+
+/**
+ * @brief Returns the size of the remote object, based on the response to a HEAD request
+ */
+DLL_PUBLIC size_t GetSize(const Url &url);
+
+/**
+ * @brief Reads `size` bytes at `offset` of the remote object with a range request
+ *
+ * The connections are kept alive and reused by the subsequent requests to the same host.
+ */
+DLL_PUBLIC void GetRange(const Url &url, size_t offset, size_t size, uint8_t *buffer);
+
+}  // namespace http
+
+/**
+ * @brief FileStream reading remote objects with HTTP range requests
+ *
+ * The stream keeps a read-ahead window, so that sequential small reads (e.g. headers and
+ * records of an archive) don't issue a request each. Reads larger than the range size are
+ * split into several range requests, issued in parallel over separate connections.
+ *
+ * The sizes can be adjusted with environment variables:
+ * - DALI_HTTP_READ_AHEAD - size of the read-ahead window, in bytes (default 1 MiB or 4 MiB,
+ *   if the stream is opened with `read_ahead`; 0 disables it)
+ * - DALI_HTTP_RANGE_SIZE - size of a single range request of a large read (default 8 MiB)
+ * - DALI_HTTP_MAX_PARALLEL_REQUESTS - the number of concurrent range requests (default 8)
+ *
+ * Only plain HTTP is supported - TLS and request signing need a client library, which is
+ * not a dependency of DALI. Use an HTTP endpoint (e.g. of a proxy or an S3-compatible
+ * service inside the cluster) or presigned URLs.
+ */
+class DLL_PUBLIC HttpFileStream : public FileStream {
+ public:
+  HttpFileStream(const std::string &uri, bool read_ahead);
+  void Close() override;
+  shared_ptr<void> Get(size_t n_bytes) override;
+  size_t Read(uint8_t *buffer, size_t n_bytes) override;
+  void Seek(int64 pos) override;
+  int64 Tell() const override;
+  size_t Size() const override;
+
+  ~HttpFileStream() override {
+    Close();
+  }
+
+ private:
+  void ReadRange(uint8_t *buffer, size_t offset, size_t size);
+
+  http::Url url_;
+  size_t size_ = 0;
+  size_t pos_ = 0;
+  size_t read_ahead_size_ = 0;
+  std::vector<uint8_t> read_ahead_buf_;
+  size_t read_ahead_offset_ = 0;
+};
+
+}  // namespace dali
+
+#endif  // DALI_UTIL_HTTP_FILE_H_
@@ -0,0 +1,214 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dali/core/format.h"
+#include "dali/util/http_file.h"
+
+namespace dali {
+
+namespace {
+
+/**
+ * @brief A minimal HTTP server, which serves one object and supports range requests
+ */
+class TestServer {
+ public:
+  explicit TestServer(std::vector<uint8_t> data) : data_(std::move(data)) {
+    listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    bind(listen_fd_, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+    socklen_t len = sizeof(addr);
+    getsockname(listen_fd_, reinterpret_cast<sockaddr *>(&addr), &len);
+    port_ = ntohs(addr.sin_port);
+    listen(listen_fd_, 16);
+    thread_ = std::thread([this]() { Accept(); });
+  }
+
+  ~TestServer() {
+    shutdown(listen_fd_, SHUT_RDWR);
+    close(listen_fd_);
+    thread_.join();
+    // the client keeps the idle connections open
+    for (int fd : connection_fds_)
+      shutdown(fd, SHUT_RDWR);
+    for (auto &t : connections_)
+      t.join();
+  }
+
+  std::string url() const {
+    return make_string("http://127.0.0.1:", port_, "/data.bin");
+  }
+
+  int num_requests() const {
+    return num_requests_;
+  }
+
+  int num_connections() const {
+    return num_connections_;
+  }
+
+ private:
+  void Accept() {
+    for (;;) {
+      int fd = accept(listen_fd_, nullptr, nullptr);
+      if (fd < 0)
+        return;
+      num_connections_++;
+      connection_fds_.push_back(fd);
+      connections_.emplace_back([this, fd]() { Serve(fd); });
+    }
+  }
+
+  void Serve(int fd) {
+    std::string pending;
+    for (;;) {
+      size_t end;
+      while ((end = pending.find("\r\n\r\n")) == std::string::npos) {
+        char buf[1024];
+        ssize_t n = recv(fd, buf, sizeof(buf), 0);
+        if (n <= 0) {
+          close(fd);
+          return;
+        }
+        pending.append(buf, n);
+      }
+      std::string request = pending.substr(0, end);
+      pending.erase(0, end + 4);
+      num_requests_++;
+
+      std::string response;
+      size_t begin = 0, size = data_.size();
+      if (request.find("/data.bin ") == std::string::npos) {
+        response = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n\r\n";
+        size = 0;
+      } else if (request.compare(0, 5, "HEAD ") == 0) {
+        response = make_string("HTTP/1.1 200 OK\r\nContent-Length: ", data_.size(), "\r\n\r\n");
+        size = 0;
+      } else {
+        size_t range = request.find("Range: bytes=");
+        if (range != std::string::npos) {
+          unsigned long long first, last;  // NOLINT
+          sscanf(request.c_str() + range, "Range: bytes=%llu-%llu", &first, &last);
+          begin = first;
+          size = last + 1 - first;
+          response = make_string("HTTP/1.1 206 Partial Content\r\nContent-Length: ", size,
+                                 "\r\n\r\n");
+        } else {
+          response = make_string("HTTP/1.1 200 OK\r\nContent-Length: ", size, "\r\n\r\n");
+        }
+      }
+      response.append(reinterpret_cast<const char *>(data_.data()) + begin, size);
+      send(fd, response.data(), response.size(), MSG_NOSIGNAL);
+    }
+  }
+
+  std::vector<uint8_t> data_;
+  int listen_fd_ = -1;
+  int port_ = 0;
+  std::thread thread_;
+  std::vector<std::thread> connections_;
+  std::vector<int> connection_fds_;
+  std::atomic<int> num_requests_{0};
+  std::atomic<int> num_connections_{0};
+};
+
+std::vector<uint8_t> TestData(size_t size) {
+  std::vector<uint8_t> data(size);
+  for (size_t i = 0; i < size; i++)
+    data[i] = static_cast<uint8_t>(i * 7 + i / 251);
+  return data;
+}
+
+}  // namespace
+
+TEST(HttpFileTest, ParseUrl) {
+  auto url = http::ParseUrl("http://example.com:8080/a/b?c=d");
+  EXPECT_EQ(url.host, "example.com");
+  EXPECT_EQ(url.port, 8080);
+  EXPECT_EQ(url.target, "/a/b?c=d");
+
+  url = http::ParseUrl("http://example.com");
+  EXPECT_EQ(url.port, 80);
+  EXPECT_EQ(url.target, "/");
+
+  url = http::ParseUrl("http://[::1]:81/x");
+  EXPECT_EQ(url.host, "::1");
+  EXPECT_EQ(url.port, 81);
+
+  EXPECT_TRUE(http::IsRemoteUri("s3://bucket/key"));
+  EXPECT_FALSE(http::IsRemoteUri("/data/http://"));
+  EXPECT_THROW(http::ParseUrl("https://example.com/a"), std::runtime_error);
+}
+
+TEST(HttpFileTest, Read) {
+  auto data = TestData(3 << 20);
+  TestServer server(data);
+  auto file = FileStream::Open(server.url(), false, true);
+  ASSERT_EQ(file->Size(), data.size());
+
+  // small sequential reads are served from the read-ahead window
+  std::vector<uint8_t> buf(1000);
+  for (int i = 0; i < 100; i++) {
+    ASSERT_EQ(file->Read(buf.data(), buf.size()), buf.size());
+    ASSERT_TRUE(std::equal(buf.begin(), buf.end(), data.begin() + i * buf.size()));
+  }
+  EXPECT_EQ(server.num_requests(), 2);  // HEAD + one window
+
+  file->Seek(data.size() - 10);
+  EXPECT_EQ(file->Read(buf.data(), buf.size()), 10u);
+  EXPECT_TRUE(std::equal(buf.begin(), buf.begin() + 10, data.end() - 10));
+
+  file->Seek(12345);
+  auto p = file->Get(100);
+  ASSERT_NE(p, nullptr);
+  EXPECT_TRUE(std::equal(data.begin() + 12345, data.begin() + 12445,
+                         static_cast<const uint8_t *>(p.get())));
+  EXPECT_EQ(file->Tell(), 12445);
+  // the connection is kept alive
+  EXPECT_EQ(server.num_connections(), 1);
+}
+
+TEST(HttpFileTest, ParallelRangeRead) {
+  // larger than the default range size
+  auto data = TestData(20 << 20);
+  TestServer server(data);
+  auto file = FileStream::Open(server.url(), false, true);
+  std::vector<uint8_t> buf(data.size() - 100);
+  file->Seek(100);
+  ASSERT_EQ(file->Read(buf.data(), buf.size()), buf.size());
+  EXPECT_TRUE(std::equal(buf.begin(), buf.end(), data.begin() + 100));
+}
+
+TEST(HttpFileTest, NotFound) {
+  TestServer server(TestData(100));
+  EXPECT_THROW(FileStream::Open(server.url() + ".missing", false, true), std::runtime_error);
+}
+
+}  // namespace dali
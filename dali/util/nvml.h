@@ -26,6 +26,7 @@
 #include "dali/util/nvml_wrap.h"
 #include "dali/core/cuda_error.h"
 #include "dali/core/format.h"
+#include "dali/core/mm/numa_resource.h"
 
 namespace dali {
 
@@ -233,6 +234,47 @@ inline void SetCPUAffinity(int core = -1) {
   }
 }
 
+/**
+ * @brief Gets the NUMA node closest to the device, as reported by NVML.
+ *
+ * @return The node index or -1, if it can't be obtained
+ */
+inline int GetMemoryAffinityNode(int device_idx) {
+#if (CUDART_VERSION >= 11000)
+  std::lock_guard<std::mutex> lock(Mutex());
+  if (!nvmlIsInitialized() || !nvmlIsSymbolAvailable("nvmlDeviceGetMemoryAffinity"))
+    return -1;
+  // the device ordinals in CUDA and NVML differ when CUDA_VISIBLE_DEVICES is used
+  char pci_bus_id[32];
+  CUDA_CALL(cudaDeviceGetPCIBusId(pci_bus_id, sizeof(pci_bus_id), device_idx));
+  nvmlDevice_t device;
+  CUDA_CALL(nvmlDeviceGetHandleByPciBusId(pci_bus_id, &device));
+
+  const unsigned kMaxNodes = 1024;
+  const size_t n_bits = sizeof(unsigned long) * 8;  // NOLINT(runtime/int)
+  std::vector<unsigned long> node_set(kMaxNodes / n_bits);  // NOLINT(runtime/int)
+  CUDA_CALL(nvmlDeviceGetMemoryAffinity(device, node_set.size(), node_set.data(),
+                                        NVML_AFFINITY_SCOPE_NODE));
+  for (size_t i = 0; i < kMaxNodes; i++) {
+    if (node_set[i / n_bits] & (1ul << (i % n_bits)))
+      return static_cast<int>(i);
+  }
+#endif
+  return -1;
+}
+
+/**
+ * @brief Registers the NUMA node local to the device, so that the pinned memory is placed there.
+ *
+ * @see mm::numa_pinned_memory_resource
+ */
+inline void SetMemoryAffinity(int device_idx) {
+  try {
+    mm::numa::SetDeviceNode(device_idx, GetMemoryAffinityNode(device_idx));
+  } catch (const std::exception &e) {
+    DALI_WARN("Cannot obtain the NUMA node of the device ", device_idx, ": ", e.what());
+  }
+}
 
 inline void Shutdown() {
   std::lock_guard<std::mutex> lock(Mutex());
@@ -216,6 +216,23 @@ py::list TensorListToDLPackView(TensorList<Backend> &tensors) {
   return result;
 }
 
+// Export the TensorList as a single DLPack Tensor, which owns the memory (see ExportDLTensor).
+template <typename Backend>
+py::capsule TensorListToDLPack(TensorList<Backend> &tensors, cudaStream_t stream) {
+  return DLTensorToCapsule(ExportDLTensor(tensors, stream));
+}
+
+// Export the samples of the TensorList as separate DLPack Tensors, which share the ownership
+// of the memory (see ExportDLTensorSamples).
+template <typename Backend>
+py::list TensorListToDLPackSamples(TensorList<Backend> &tensors, cudaStream_t stream) {
+  py::list result;
+  for (DLMTensorPtr &dl_tensor : ExportDLTensorSamples(tensors, stream)) {
+    result.append(DLTensorToCapsule(std::move(dl_tensor)));
+  }
+  return result;
+}
+
 static DLManagedTensor* DLMTensorRawPtrFromCapsule(py::capsule &capsule, bool consume = true) {
   DALI_ENFORCE(std::string(capsule.name()) == DLTENSOR_NAME,
       "Invalid DLPack tensor capsule. Notice that a dl tensor can be consumed only once");
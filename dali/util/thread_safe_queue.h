@@ -17,6 +17,8 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <cstddef>
+#include <memory>
 #include <mutex>
 #include <queue>
 #include <utility>
@@ -75,6 +77,130 @@ class ThreadSafeQueue {
   bool interrupt_ = false;
 };
 
+/**
+ * @brief Bounded, lock-free multi-producer multi-consumer queue
+ *
+ * A ring buffer of cells, each with a sequence number telling whether the cell is ready
+ * to be written or read in the current lap. The producers and the consumers synchronize
+ * only on the cell and on their own position counter, so they don't contend with each other
+ * unless the queue is (nearly) empty or full.
+ *
+ * The operations never block - `try_push` fails if the queue is full and `try_pop` fails
+ * if it's empty. The capacity is rounded up to a power of 2.
+ */
+template <typename T>
+class BoundedLockFreeQueue {
+ public:
+  explicit BoundedLockFreeQueue(size_t capacity) {
+    size_t size = 1;
+    while (size < capacity)
+      size <<= 1;
+    cells_.reset(new Cell[size]);
+    mask_ = size - 1;
+    for (size_t i = 0; i < size; i++)
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  BoundedLockFreeQueue(const BoundedLockFreeQueue &) = delete;
+  BoundedLockFreeQueue &operator=(const BoundedLockFreeQueue &) = delete;
+
+  /**
+   * @brief Moves the item into the queue
+   *
+   * @return false, if the queue is full; the item is left intact then
+   */
+  bool try_push(T &&item) {
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    Cell *cell;
+    for (;;) {
+      cell = &cells_[pos & mask_];
+      size_t seq = cell->sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+      if (diff == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+          break;
+      } else if (diff < 0) {
+        return false;  // the cell still holds an item from the previous lap
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    cell->data = std::move(item);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Moves the oldest item out of the queue
+   *
+   * @return false, if the queue is empty
+   */
+  bool try_pop(T &item) {
+    size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    Cell *cell;
+    for (;;) {
+      cell = &cells_[pos & mask_];
+      size_t seq = cell->sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+      if (diff == 0) {
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+          break;
+      } else if (diff < 0) {
+        return false;  // the cell hasn't been written in this lap yet
+      } else {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    item = std::move(cell->data);
+    cell->data = T{};
+    cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Removes all the items from the queue
+   */
+  void clear() {
+    T item;
+    while (try_pop(item))
+      item = T{};
+  }
+
+  /**
+   * @brief Number of items in the queue; exact only when there are no concurrent operations
+   */
+  size_t size() const {
+    size_t head = dequeue_pos_.load(std::memory_order_relaxed);
+    size_t tail = enqueue_pos_.load(std::memory_order_relaxed);
+    return tail > head ? tail - head : 0;
+  }
+
+  bool empty() const {
+    return size() == 0;
+  }
+
+  size_t capacity() const {
+    return mask_ + 1;
+  }
+
+ private:
+  static constexpr size_t kCacheLineSize = 64;
+
+  struct Cell {
+    std::atomic<size_t> sequence;
+    T data;
+  };
+
+  std::unique_ptr<Cell[]> cells_;
+  size_t mask_ = 0;
+  // padding instead of alignas - the owners of the queue are allocated with plain `new`
+  char pad0_[kCacheLineSize];
+  std::atomic<size_t> enqueue_pos_{0};
+  char pad1_[kCacheLineSize - sizeof(std::atomic<size_t>)];
+  std::atomic<size_t> dequeue_pos_{0};
+  char pad2_[kCacheLineSize - sizeof(std::atomic<size_t>)];
+};
+
 }  // namespace dali
 
 #endif  // DALI_UTIL_THREAD_SAFE_QUEUE_H_
@@ -0,0 +1,101 @@
+// Copyright (c) 2021, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "dali/util/thread_safe_queue.h"
+
+namespace dali {
+
+TEST(BoundedLockFreeQueueTest, FifoAndCapacity) {
+  BoundedLockFreeQueue<int> queue(3);
+  ASSERT_EQ(queue.capacity(), 4u);
+  for (int i = 0; i < 4; i++) {
+    int item = i;
+    EXPECT_TRUE(queue.try_push(std::move(item)));
+  }
+  int extra = 42;
+  EXPECT_FALSE(queue.try_push(std::move(extra)));
+  EXPECT_EQ(queue.size(), 4u);
+
+  // wrap around a few times
+  for (int i = 4; i < 20; i++) {
+    int item = -1;
+    ASSERT_TRUE(queue.try_pop(item));
+    EXPECT_EQ(item, i - 4);
+    int next = i;
+    EXPECT_TRUE(queue.try_push(std::move(next)));
+  }
+  queue.clear();
+  EXPECT_TRUE(queue.empty());
+  int item = -1;
+  EXPECT_FALSE(queue.try_pop(item));
+  EXPECT_EQ(item, -1);
+}
+
+TEST(BoundedLockFreeQueueTest, MoveOnly) {
+  BoundedLockFreeQueue<std::unique_ptr<int>> queue(2);
+  std::unique_ptr<int> a(new int(1)), b(new int(2)), c(new int(3));
+  EXPECT_TRUE(queue.try_push(std::move(a)));
+  EXPECT_TRUE(queue.try_push(std::move(b)));
+  EXPECT_FALSE(queue.try_push(std::move(c)));
+  ASSERT_NE(c, nullptr);  // not consumed by the failed push
+  std::unique_ptr<int> out;
+  ASSERT_TRUE(queue.try_pop(out));
+  EXPECT_EQ(*out, 1);
+}
+
+TEST(BoundedLockFreeQueueTest, MultipleProducersAndConsumers) {
+  constexpr int kThreads = 4;
+  constexpr int kItemsPerThread = 100000;
+  BoundedLockFreeQueue<int> queue(64);
+  std::vector<std::thread> threads;
+  std::vector<int64_t> sums(kThreads, 0);
+  std::vector<int> counts(kThreads, 0);
+
+  for (int t = 0; t < kThreads; t++) {
+    threads.emplace_back([&, t]() {
+      for (int i = 1; i <= kItemsPerThread; i++) {
+        int item = i;
+        while (!queue.try_push(std::move(item)))
+          std::this_thread::yield();
+      }
+    });
+    threads.emplace_back([&, t]() {
+      int item;
+      while (counts[t] < kItemsPerThread) {
+        if (queue.try_pop(item)) {
+          sums[t] += item;
+          counts[t]++;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  int64_t total = 0;
+  for (auto sum : sums)
+    total += sum;
+  int64_t expected = static_cast<int64_t>(kItemsPerThread) * (kItemsPerThread + 1) / 2 * kThreads;
+  EXPECT_EQ(total, expected);
+  EXPECT_TRUE(queue.empty());
+}
+
+}  // namespace dali
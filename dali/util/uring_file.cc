@@ -0,0 +1,278 @@
+// Copyright (c) 2021, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "dali/core/error_handling.h"
+#include "dali/util/uring_file.h"
+
+namespace dali {
+
+namespace {
+
+// liburing is not a dependency - the few system calls needed are issued directly
+
+int io_uring_setup(unsigned entries, io_uring_params *params) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int io_uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+  return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags,
+                                  nullptr, 0));
+}
+
+template <typename T>
+T *RingPtr(void *ring, unsigned offset) {
+  return reinterpret_cast<T *>(static_cast<uint8_t *>(ring) + offset);
+}
+
+}  // namespace
+
+UringFileStream::UringFileStream(const std::string &path) : FileStream(path) {
+  fd_ = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  DALI_ENFORCE(fd_ >= 0, "Could not open file " + path + ": " + std::strerror(errno));
+  struct stat sb;
+  DALI_ENFORCE(fstat(fd_, &sb) == 0,
+               "Unable to stat file " + path + ": " + std::strerror(errno));
+  size_ = sb.st_size;
+}
+
+void UringFileStream::Close() {
+  if (fd_ >= 0) {
+    close(fd_);
+    fd_ = -1;
+  }
+}
+
+shared_ptr<void> UringFileStream::Get(size_t /*n_bytes*/) {
+  // the file is not mapped
+  return {};
+}
+
+size_t UringFileStream::Read(uint8_t *buffer, size_t n_bytes) {
+  size_t n_read = 0;
+  while (n_read < n_bytes) {
+    auto ret = pread(fd_, buffer + n_read, n_bytes - n_read, pos_ + n_read);
+    if (ret < 0 && errno == EINTR)
+      continue;
+    DALI_ENFORCE(ret >= 0, "Error reading from a file " + path_ + ": " + std::strerror(errno));
+    if (ret == 0)
+      break;
+    n_read += ret;
+  }
+  pos_ += n_read;
+  return n_read;
+}
+
+void UringFileStream::Seek(int64 pos) {
+  DALI_ENFORCE(pos >= 0 && pos <= static_cast<int64>(size_), "Invalid seek");
+  pos_ = pos;
+}
+
+int64 UringFileStream::Tell() const {
+  return pos_;
+}
+
+size_t UringFileStream::Size() const {
+  return size_;
+}
+
+bool UringReadQueue::IsSupported() {
+  static const bool supported = []() {
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    int fd = io_uring_setup(1, &params);
+    if (fd < 0)
+      return false;
+    close(fd);
+    return true;
+  }();
+  return supported;
+}
+
+UringReadQueue::UringReadQueue(unsigned depth) {
+  io_uring_params params;
+  std::memset(&params, 0, sizeof(params));
+  ring_fd_ = io_uring_setup(depth, &params);
+  DALI_ENFORCE(ring_fd_ >= 0, make_string("Failed to set up io_uring: ", std::strerror(errno)));
+  sq_entries_ = params.sq_entries;
+  cq_entries_ = params.cq_entries;
+
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+  if (single_mmap)
+    sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+
+  auto map = [&](size_t size, off_t offset) {
+    void *p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                   ring_fd_, offset);
+    if (p == MAP_FAILED) {
+      int err = errno;
+      Release();
+      DALI_FAIL(make_string("Failed to map io_uring: ", std::strerror(err)));
+    }
+    return p;
+  };
+  sq_ring_ = map(sq_ring_size_, IORING_OFF_SQ_RING);
+  cq_ring_ = single_mmap ? sq_ring_ : map(cq_ring_size_, IORING_OFF_CQ_RING);
+  sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+  sqes_ = map(sqes_size_, IORING_OFF_SQES);
+
+  sq_head_ = RingPtr<unsigned>(sq_ring_, params.sq_off.head);
+  sq_tail_ = RingPtr<unsigned>(sq_ring_, params.sq_off.tail);
+  sq_mask_ = RingPtr<unsigned>(sq_ring_, params.sq_off.ring_mask);
+  sq_array_ = RingPtr<unsigned>(sq_ring_, params.sq_off.array);
+  cq_head_ = RingPtr<unsigned>(cq_ring_, params.cq_off.head);
+  cq_tail_ = RingPtr<unsigned>(cq_ring_, params.cq_off.tail);
+  cq_mask_ = RingPtr<unsigned>(cq_ring_, params.cq_off.ring_mask);
+  cqes_ = RingPtr<void>(cq_ring_, params.cq_off.cqes);
+}
+
+UringReadQueue::~UringReadQueue() {
+  // the buffers of the reads still in flight must not be written after we return
+  try {
+    std::vector<UringCompletion> completions;
+    while (in_flight_ > 0) {
+      queued_.clear();
+      Reap(completions, true);
+      completions.clear();
+    }
+  } catch (...) {}
+  Release();
+}
+
+void UringReadQueue::Release() {
+  if (sqes_)
+    munmap(sqes_, sqes_size_);
+  if (cq_ring_ && cq_ring_ != sq_ring_)
+    munmap(cq_ring_, cq_ring_size_);
+  if (sq_ring_)
+    munmap(sq_ring_, sq_ring_size_);
+  sqes_ = cq_ring_ = sq_ring_ = nullptr;
+  if (ring_fd_ >= 0)
+    close(ring_fd_);
+  ring_fd_ = -1;
+}
+
+int UringReadQueue::Enter(unsigned to_submit, unsigned min_complete, unsigned flags) {
+  for (;;) {
+    int ret = io_uring_enter(ring_fd_, to_submit, min_complete, flags);
+    if (ret >= 0)
+      return ret;
+    DALI_ENFORCE(errno == EINTR, make_string("io_uring_enter failed: ", std::strerror(errno)));
+  }
+}
+
+void UringReadQueue::Enqueue(int fd, int64 offset, void *buffer, size_t n_bytes, uint64_t tag) {
+  size_t idx;
+  if (!free_requests_.empty()) {
+    idx = free_requests_.back();
+    free_requests_.pop_back();
+  } else {
+    idx = requests_.size();
+    requests_.emplace_back();
+  }
+  auto &req = requests_[idx];
+  req.fd = fd;
+  req.offset = offset;
+  req.iov.iov_base = buffer;
+  req.iov.iov_len = n_bytes;
+  req.done = 0;
+  req.tag = tag;
+  queued_.push_back(idx);
+}
+
+void UringReadQueue::Submit() {
+  auto *sqes = static_cast<io_uring_sqe *>(sqes_);
+  unsigned mask = *sq_mask_;
+  unsigned tail = *sq_tail_;
+  unsigned head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+  unsigned to_submit = 0;
+  // the number of reads in flight is limited, so that the completion queue never overflows
+  while (!queued_.empty() && tail - head < sq_entries_ &&
+         in_flight_ + to_submit < cq_entries_) {
+    size_t idx = queued_.front();
+    queued_.pop_front();
+    auto &req = requests_[idx];
+    unsigned sq_idx = tail & mask;
+    auto &sqe = sqes[sq_idx];
+    std::memset(&sqe, 0, sizeof(sqe));
+    // readv is available since the first io_uring release
+    sqe.opcode = IORING_OP_READV;
+    sqe.fd = req.fd;
+    sqe.addr = reinterpret_cast<uint64_t>(&req.iov);
+    sqe.len = 1;
+    sqe.off = req.offset + req.done;
+    sqe.user_data = idx;
+    sq_array_[sq_idx] = sq_idx;
+    tail++;
+    to_submit++;
+  }
+  if (to_submit == 0)
+    return;
+  __atomic_store_n(sq_tail_, tail, __ATOMIC_RELEASE);
+  in_flight_ += to_submit;
+  while (to_submit > 0)
+    to_submit -= Enter(to_submit, 0, 0);
+}
+
+void UringReadQueue::Reap(std::vector<UringCompletion> &completions, bool wait) {
+  auto *cqes = static_cast<io_uring_cqe *>(cqes_);
+  size_t initial_size = completions.size();
+  for (;;) {
+    Submit();
+    unsigned head = *cq_head_;
+    unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    if (head == tail) {
+      if (!wait || completions.size() > initial_size || in_flight_ == 0)
+        return;
+      Enter(0, 1, IORING_ENTER_GETEVENTS);
+      continue;
+    }
+    unsigned mask = *cq_mask_;
+    for (; head != tail; head++) {
+      auto &cqe = cqes[head & mask];
+      size_t idx = cqe.user_data;
+      auto &req = requests_[idx];
+      in_flight_--;
+      if (cqe.res > 0 && static_cast<size_t>(cqe.res) < req.iov.iov_len) {
+        // a short read - continue where it stopped
+        req.done += cqe.res;
+        req.iov.iov_base = static_cast<uint8_t *>(req.iov.iov_base) + cqe.res;
+        req.iov.iov_len -= cqe.res;
+        queued_.push_back(idx);
+        continue;
+      }
+      int64 result = cqe.res < 0 ? cqe.res : static_cast<int64>(req.done + cqe.res);
+      completions.push_back({req.tag, result});
+      free_requests_.push_back(idx);
+    }
+    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+    if (!wait)
+      return;
+  }
+}
+
+}  // namespace dali
@@ -0,0 +1,153 @@
+// Copyright (c) 2021, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_UTIL_URING_FILE_H_
+#define DALI_UTIL_URING_FILE_H_
+
+#include <sys/uio.h>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dali/core/common.h"
+#include "dali/util/file.h"
+
+namespace dali {
+
+/**
+ * @brief FileStream over a plain file descriptor, which can be read with UringReadQueue
+ *
+ * The synchronous operations of the stream use `pread`, so they don't interfere with
+ * the asynchronous reads of the same file.
+ */
+class DLL_PUBLIC UringFileStream : public FileStream {
+ public:
+  explicit UringFileStream(const std::string &path);
+  void Close() override;
+  shared_ptr<void> Get(size_t n_bytes) override;
+  size_t Read(uint8_t *buffer, size_t n_bytes) override;
+  void Seek(int64 pos) override;
+  int64 Tell() const override;
+  size_t Size() const override;
+
+  int fd() const {
+    return fd_;
+  }
+
+  ~UringFileStream() override {
+    Close();
+  }
+
+ private:
+  int fd_ = -1;
+  int64 pos_ = 0;
+  size_t size_ = 0;
+};
+
+struct UringCompletion {
+  /// the tag passed to UringReadQueue::Enqueue
+  uint64_t tag;
+  /// number of bytes read or a negated errno value
+  int64 result;
+};
+
+/**
+ * @brief Batched asynchronous reads with io_uring
+ *
+ * The reads are queued with Enqueue and submitted together with a single system call by
+ * Submit, so one thread can keep as many reads in flight as the ring allows. Short reads
+ * are continued internally - the completion is reported once the whole range was read,
+ * the end of the file was reached or an error occurred.
+ *
+ * The queue is not thread-safe; it's meant to be used by the thread that issues the reads.
+ */
+class DLL_PUBLIC UringReadQueue {
+ public:
+  /**
+   * @param depth the maximum number of reads submitted to the kernel at once
+   */
+  explicit UringReadQueue(unsigned depth = 256);
+  ~UringReadQueue();
+
+  UringReadQueue(const UringReadQueue &) = delete;
+  UringReadQueue &operator=(const UringReadQueue &) = delete;
+
+  /**
+   * @brief Checks if io_uring can be used in this process
+   *
+   * It may be missing in older kernels or blocked, e.g. by the seccomp profile of a container.
+   */
+  static bool IsSupported();
+
+  /**
+   * @brief Queues a read of `n_bytes` at `offset` of `fd` into `buffer`
+   *
+   * The read is sent to the kernel by the next call to Submit or Reap.
+   */
+  void Enqueue(int fd, int64 offset, void *buffer, size_t n_bytes, uint64_t tag);
+
+  /**
+   * @brief Submits the queued reads, as many as fit in the ring
+   */
+  void Submit();
+
+  /**
+   * @brief Appends the completed reads to `completions`
+   *
+   * @param wait if true, waits until at least one read completes, unless there are no reads
+   */
+  void Reap(std::vector<UringCompletion> &completions, bool wait);
+
+  /**
+   * @brief Number of reads that were enqueued, but not reaped yet
+   */
+  size_t Pending() const {
+    return in_flight_ + queued_.size();
+  }
+
+ private:
+  struct Request {
+    int fd;
+    int64 offset;
+    iovec iov;
+    size_t done;
+    uint64_t tag;
+  };
+
+  int Enter(unsigned to_submit, unsigned min_complete, unsigned flags);
+  void Release();
+
+  int ring_fd_ = -1;
+  unsigned sq_entries_ = 0, cq_entries_ = 0;
+  void *sq_ring_ = nullptr, *cq_ring_ = nullptr;
+  size_t sq_ring_size_ = 0, cq_ring_size_ = 0;
+  void *sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+
+  unsigned *sq_head_, *sq_tail_, *sq_mask_, *sq_array_;
+  unsigned *cq_head_, *cq_tail_, *cq_mask_;
+  void *cqes_;
+
+  // the addresses of the requests must be stable - the kernel reads their iovecs
+  std::deque<Request> requests_;
+  std::vector<size_t> free_requests_;
+  std::deque<size_t> queued_;
+  size_t in_flight_ = 0;
+};
+
+}  // namespace dali
+
+#endif  // DALI_UTIL_URING_FILE_H_
@@ -0,0 +1,99 @@
+// Copyright (c) 2021, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+
+#include "dali/util/uring_file.h"
+
+namespace dali {
+
+class UringFileTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    if (!UringReadQueue::IsSupported())
+      GTEST_SKIP() << "io_uring is not available";
+    char name[] = "/tmp/dali_uring_test_XXXXXX";
+    int fd = mkstemp(name);
+    ASSERT_GE(fd, 0);
+    path_ = name;
+    data_.resize(1 << 20);
+    for (size_t i = 0; i < data_.size(); i++)
+      data_[i] = static_cast<uint8_t>(i * 7 + i / 251);
+    ASSERT_EQ(write(fd, data_.data(), data_.size()), static_cast<ssize_t>(data_.size()));
+    close(fd);
+  }
+
+  void TearDown() override {
+    if (!path_.empty())
+      unlink(path_.c_str());
+  }
+
+  std::string path_;
+  std::vector<uint8_t> data_;
+};
+
+TEST_F(UringFileTest, SyncRead) {
+  UringFileStream file(path_);
+  EXPECT_EQ(file.Size(), data_.size());
+  std::vector<uint8_t> buf(100);
+  file.Seek(1000);
+  EXPECT_EQ(file.Read(buf.data(), buf.size()), buf.size());
+  EXPECT_EQ(file.Tell(), 1100);
+  EXPECT_TRUE(std::equal(buf.begin(), buf.end(), data_.begin() + 1000));
+  EXPECT_EQ(file.Get(10), nullptr);
+}
+
+TEST_F(UringFileTest, BatchedReads) {
+  UringFileStream file(path_);
+  // more reads than the ring can hold at once
+  UringReadQueue queue(8);
+  const int kReads = 100;
+  const size_t kChunk = 4000;
+  std::vector<std::vector<uint8_t>> buffers(kReads, std::vector<uint8_t>(kChunk));
+  for (int i = 0; i < kReads; i++)
+    queue.Enqueue(file.fd(), i * 10007, buffers[i].data(), kChunk, i);
+  queue.Submit();
+
+  std::vector<UringCompletion> completions;
+  while (queue.Pending() > 0)
+    queue.Reap(completions, true);
+  ASSERT_EQ(completions.size(), static_cast<size_t>(kReads));
+  std::vector<bool> seen(kReads, false);
+  for (auto &c : completions) {
+    ASSERT_LT(c.tag, static_cast<uint64_t>(kReads));
+    EXPECT_FALSE(seen[c.tag]);
+    seen[c.tag] = true;
+    EXPECT_EQ(c.result, static_cast<int64>(kChunk));
+    EXPECT_TRUE(std::equal(buffers[c.tag].begin(), buffers[c.tag].end(),
+                           data_.begin() + c.tag * 10007));
+  }
+}
+
+TEST_F(UringFileTest, ReadPastEnd) {
+  UringFileStream file(path_);
+  UringReadQueue queue;
+  std::vector<uint8_t> buf(100);
+  queue.Enqueue(file.fd(), data_.size() - 10, buf.data(), buf.size(), 42);
+  std::vector<UringCompletion> completions;
+  queue.Reap(completions, true);
+  ASSERT_EQ(completions.size(), 1u);
+  EXPECT_EQ(completions[0].tag, 42u);
+  EXPECT_EQ(completions[0].result, 10);
+}
+
+}  // namespace dali
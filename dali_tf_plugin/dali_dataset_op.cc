@@ -12,7 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <memory>
 #include <queue>
 #include <sstream>
 #include <vector>
@@ -30,6 +33,7 @@
 #define EIGEN_USE_GPU
 
 #include "tensorflow/core/common_runtime/input_colocation_exemption_registry.h"
+#include "tensorflow/core/framework/allocation_description.pb.h"
 #include "tensorflow/core/framework/common_shape_fns.h"
 #include "tensorflow/core/framework/dataset.h"
 #include "tensorflow/core/framework/op.h"
@@ -249,12 +253,118 @@ class DALIDatasetOp::Dataset : public DatasetBase {
 };
 
 
+namespace {
+
+/**
+ * @brief Owns the DALI Pipeline, which must outlive both the Iterator and the TF Tensors
+ * that use the memory of the pipeline outputs.
+ */
+class SharedPipeline {
+ public:
+  explicit SharedPipeline(daliPipelineHandle pipeline_handle) : handle_(pipeline_handle) {}
+
+  ~SharedPipeline() {
+    daliDeletePipeline(&handle_);
+  }
+
+  daliPipelineHandle *handle() {
+    return &handle_;
+  }
+
+  /// The number of the iterations whose outputs are still used by TF Tensors
+  std::atomic<int> borrowed_iterations{0};
+
+ private:
+  daliPipelineHandle handle_;
+};
+
+/**
+ * @brief The outputs of a single iteration of the DALI Pipeline.
+ *
+ * The outputs are released when the object is destroyed, after the work issued so far
+ * to `consumer_stream` (if not null) completes.
+ */
+class PipelineIteration {
+ public:
+  PipelineIteration(std::shared_ptr<SharedPipeline> pipeline, cudaStream_t consumer_stream)
+      : pipeline_(std::move(pipeline)), consumer_stream_(consumer_stream) {
+    daliAcquireOutput(pipeline_->handle(), &outputs_);
+  }
+
+  ~PipelineIteration() {
+    try {
+      if (consumer_stream_)
+        daliReleaseOutputHandleOnStream(&outputs_, consumer_stream_);
+      else
+        daliReleaseOutputHandle(&outputs_, nullptr);
+    } catch (std::exception &e) {
+      std::cout << "DALI daliReleaseOutputHandle failed: " << e.what() << std::endl;
+    }
+    if (borrowed_)
+      pipeline_->borrowed_iterations--;
+  }
+
+  /**
+   * @brief The handle used to access the outputs with the DALI C API functions
+   */
+  daliPipelineHandle *outputs() {
+    return &outputs_.outputs;
+  }
+
+  /**
+   * @brief Marks the outputs as used by TF Tensors
+   */
+  void Borrow() {
+    if (!borrowed_) {
+      borrowed_ = true;
+      pipeline_->borrowed_iterations++;
+    }
+  }
+
+ private:
+  std::shared_ptr<SharedPipeline> pipeline_;
+  cudaStream_t consumer_stream_;
+  daliOutputHandle outputs_;
+  bool borrowed_ = false;
+};
+
+/**
+ * @brief Exposes the memory of a DALI Pipeline output as a TF Tensor buffer,
+ * keeping the whole iteration alive for as long as the Tensor uses it.
+ */
+class PipelineOutputBuffer : public TensorBuffer {
+ public:
+  PipelineOutputBuffer(std::shared_ptr<PipelineIteration> iteration, void *data, size_t size)
+      : TensorBuffer(data), iteration_(std::move(iteration)), size_(size) {}
+
+  size_t size() const override {
+    return size_;
+  }
+
+  TensorBuffer *root_buffer() override {
+    return this;
+  }
+
+  void FillAllocationDescription(AllocationDescription *proto) const override {
+    proto->set_requested_bytes(size_);
+    proto->set_allocator_name("DALI");
+  }
+
+ private:
+  std::shared_ptr<PipelineIteration> iteration_;
+  size_t size_;
+};
+
+}  // namespace
+
+
 class DALIDatasetOp::Dataset::Iterator : public DatasetIterator<Dataset> {
  public:
   explicit Iterator(const Params &params, daliPipelineHandle pipeline_handle,
                     bool enable_memory_stats = false)
       : DatasetIterator<Dataset>(params),
         pipeline_handle_(pipeline_handle),
+        pipeline_(std::make_shared<SharedPipeline>(pipeline_handle)),
         enable_memory_stats_(enable_memory_stats) {}
 
   Status Initialize(IteratorContext *context) override {
@@ -374,7 +484,8 @@ class DALIDatasetOp::Dataset::Iterator : public DatasetIterator<Dataset> {
       }
       daliFreeExecutorMetadata(meta, N);
     }
-    daliDeletePipeline(&pipeline_handle_);
+    // The pipeline is deleted when the TF Tensors using its outputs are gone
+    pipeline_.reset();
   }
 
 #if TF_MAJOR_VERSION > 2 || (TF_MAJOR_VERSION == 2 && TF_MINOR_VERSION >= 3)
@@ -535,27 +646,73 @@ class DALIDatasetOp::Dataset::Iterator : public DatasetIterator<Dataset> {
   }
 
   /**
-   * @brief Obtain the last computed outputs from DALI Pipeline and copy them to the TF Tensors
-   * that we allocated for outputs. Release the DALI Pipeline Outputs.
+   * @brief The number of iterations that can be used by TF Tensors at the same time.
+   *
+   * One buffer is always left to the pipeline, so it can make progress even if TF holds
+   * the borrowed Tensors until it gets the next ones.
+   */
+  int MaxBorrowedIterations() const {
+    const auto &def = dataset()->pipeline_def_;
+    int depth = def.exec_separated
+                    ? std::min(def.cpu_prefetch_queue_depth, def.gpu_prefetch_queue_depth)
+                    : def.prefetch_queue_depth;
+    return depth - 1;
+  }
+
+  /**
+   * @brief Returns the pointer to the data of the output `out_id`, if it is stored as a single,
+   * dense buffer of `nbytes`, or nullptr otherwise.
+   */
+  Status GetContiguousData(daliPipelineHandle *outputs, int out_id, size_t nbytes,
+                           void *&data) {
+    data = nullptr;
+    int64_t num_samples = 0;
+    const void *first = nullptr;
+    TF_DALI_CALL(num_samples = daliNumTensors(outputs, out_id));
+    if (num_samples == 0 || nbytes == 0)
+      return Status::OK();
+    TF_DALI_CALL(first = daliOutputSampleData(outputs, out_id, 0));
+    size_t sample_bytes = nbytes / num_samples;
+    for (int64_t k = 1; k < num_samples; k++) {
+      const void *sample = nullptr;
+      TF_DALI_CALL(sample = daliOutputSampleData(outputs, out_id, k));
+      if (sample != static_cast<const uint8_t *>(first) + k * sample_bytes)
+        return Status::OK();
+    }
+    data = const_cast<void *>(first);
+    return Status::OK();
+  }
+
+  /**
+   * @brief Obtain the last computed outputs from DALI Pipeline and pass them to TF.
+   *
+   * When possible, the TF Tensors use the memory of the DALI outputs directly and keep the DALI
+   * iteration alive until they are destroyed. Otherwise, the outputs are copied to the TF
+   * Tensors that we allocated for outputs.
    */
   Status ProduceOutputs(IteratorContext *context, std::vector<Tensor> *out_tensors,
                         bool &end_of_sequence) {
-    TF_DALI_CALL(daliShareOutput(&pipeline_handle_));
+    std::shared_ptr<PipelineIteration> iteration;
+    // The TF Tensors are used in the TF compute stream, which is also used for the copies
+    cudaStream_t consumer_stream = dataset()->device_type_ == GPU ? dataset()->stream_ : 0;
+    TF_DALI_CALL(iteration = std::make_shared<PipelineIteration>(pipeline_, consumer_stream));
+    auto *outputs = iteration->outputs();
+    bool can_borrow = pipeline_->borrowed_iterations < MaxBorrowedIterations();
 
     auto num_outputs = 0;
-    TF_DALI_CALL(num_outputs = daliGetNumOutput(&pipeline_handle_));
+    TF_DALI_CALL(num_outputs = daliGetNumOutput(outputs));
 
     for (int out_id = 0; out_id < num_outputs; ++out_id) {
       TensorShape output_shape;
       bool is_uniform = false;
-      TF_DALI_CALL(is_uniform = daliOutputHasUniformShape(&pipeline_handle_, out_id));
+      TF_DALI_CALL(is_uniform = daliOutputHasUniformShape(outputs, out_id));
 
       if (!is_uniform) {
         std::stringstream shapes;
         for (int sample_id = 0; sample_id < dataset()->pipeline_def_.batch_size; sample_id++) {
           AutoCPtr<int64_t> dali_shape;
           TF_DALI_CALL(dali_shape = AutoCPtr<int64_t>(
-                           daliShapeAtSample(&pipeline_handle_, out_id, sample_id)));
+                           daliShapeAtSample(outputs, out_id, sample_id)));
 
           shapes << DaliToShape(dali_shape);
           if (sample_id < dataset()->pipeline_def_.batch_size - 1) {
@@ -570,7 +727,7 @@ class DALIDatasetOp::Dataset::Iterator : public DatasetIterator<Dataset> {
             "shape. Got shapes: ", shapes.str());
       }
       AutoCPtr<int64_t> dali_batch_shape;
-      TF_DALI_CALL(dali_batch_shape = AutoCPtr<int64_t>(daliShapeAt(&pipeline_handle_, out_id)));
+      TF_DALI_CALL(dali_batch_shape = AutoCPtr<int64_t>(daliShapeAt(outputs, out_id)));
       auto dali_shape = DaliToShape(dali_batch_shape);
       auto status = GetCompatibleShape(output_shape, dataset()->shapes_[out_id], dali_shape,
                                        dataset()->pipeline_def_.batch_size, out_id);
@@ -579,7 +736,7 @@ class DALIDatasetOp::Dataset::Iterator : public DatasetIterator<Dataset> {
       }
 
       dali_data_type_t dali_type = DALI_NO_TYPE;
-      TF_DALI_CALL(dali_type = daliTypeAt(&pipeline_handle_, out_id));
+      TF_DALI_CALL(dali_type = daliTypeAt(outputs, out_id));
       auto tf_type = DaliToTfType(dali_type);
 
       if (tf_type != dataset()->dtypes_[out_id]) {
@@ -591,6 +748,20 @@ class DALIDatasetOp::Dataset::Iterator : public DatasetIterator<Dataset> {
         return errors::InvalidArgument(ss.str());
       }
 
+      if (can_borrow) {
+        size_t nbytes = 0;
+        void *data = nullptr;
+        TF_DALI_CALL(nbytes = daliTensorSize(outputs, out_id));
+        TF_RETURN_IF_ERROR(GetContiguousData(outputs, out_id, nbytes, data));
+        if (data) {
+          auto *buffer = new PipelineOutputBuffer(iteration, data, nbytes);
+          out_tensors->emplace_back(dataset()->dtypes_[out_id], output_shape, buffer);
+          buffer->Unref();  // the Tensor holds its own reference
+          iteration->Borrow();
+          continue;
+        }
+      }
+
       out_tensors->emplace_back(context->allocator({}), dataset()->dtypes_[out_id], output_shape);
       tensorflow::Tensor &output = out_tensors->operator[](out_id);
 
@@ -638,13 +809,12 @@ class DALIDatasetOp::Dataset::Iterator : public DatasetIterator<Dataset> {
               std::to_string(out_id));
       }
 
-      TF_DALI_CALL(daliOutputCopy(&pipeline_handle_, dst, out_id, dataset()->device_type_,
+      TF_DALI_CALL(daliOutputCopy(outputs, dst, out_id, dataset()->device_type_,
                                   dataset()->stream_, false));
     }
 
     end_of_sequence = false;
-
-    TF_DALI_CALL(daliOutputRelease(&pipeline_handle_));
+    // The outputs that were not borrowed are released here, after the copies
     return Status::OK();
   }
 
@@ -852,6 +1022,7 @@ class DALIDatasetOp::Dataset::Iterator : public DatasetIterator<Dataset> {
   std::queue<ListOfBatches> alive_batches_;
   InputState iterator_state_ = InputState::in_progress;
   daliPipelineHandle pipeline_handle_;
+  std::shared_ptr<SharedPipeline> pipeline_;
   bool enable_memory_stats_;
 };
 
@@ -42,6 +42,20 @@ typedef enum {
   GPU = 1
 } device_type_t;
 
+typedef struct {
+  daliPipelineHandle *pipe_handle;
+  void *batcher;  /// @see RequestBatcher
+} daliRequestBatcherHandle;
+
+/**
+ * @brief Handle for the outputs of a single iteration, @see daliAcquireOutput.
+ */
+typedef struct {
+  /// Can be passed to the functions accessing the outputs, e.g. daliShapeAtSample
+  daliPipelineHandle outputs;
+  int output_id;
+} daliOutputHandle;
+
 typedef enum {
   DALI_BACKEND_CPU = 0,
   DALI_BACKEND_GPU = 1,
@@ -79,7 +93,7 @@ typedef struct {
 
 
 /*
- * Need to keep that in sync with ExecutorMeta from executor.h
+ * Need to keep that in sync with ExecutorMeta and ExecutorTimingMeta from executor.h
  */
 typedef struct {
   char *operator_name;         // operator name, user need to free the memory
@@ -88,8 +102,36 @@ typedef struct {
   size_t *max_real_size;       // the biggest size of the tensor in the batch
   size_t *reserved;            // reserved size of the operator output, user need to free the memory
   size_t *max_reserved;        // the biggest reserved memory size for the tensor in the batch
+  int64_t iterations;          // number of timed runs of the operator (or the stage)
+  int64_t samples;             // number of samples processed in the timed runs
+  double total_time;           // host time spent in the timed runs, in seconds
+  double max_time;             // the longest host time of a single run, in seconds
+  int64_t gpu_iterations;      // number of runs with the device time measured
+  double gpu_time;             // device time of the gpu_iterations runs, in seconds
+  double wait_time;            // time spent waiting for the queue buffers (stages only)
+  size_t *sample_size_hint;    // the size not exceeded by 95% of the samples of the output
 } daliExecutorMetadata;
 
+/*
+ * Need to keep that in sync with PipelineHealth from health_monitor.h
+ * The per-stage arrays are indexed with the stage: 0 - CPU, 1 - Mixed, 2 - GPU.
+ * The counters and the times (in seconds) are cumulative since the pipeline started.
+ */
+typedef struct {
+  double uptime;                    // time since the pipeline started
+  int64_t stage_iterations[3];      // batches processed by the stage
+  double stage_wait_time[3];        // time the stage spent waiting for the buffers
+  int64_t stage_stalls[3];          // the waits of the stage longer than 1 ms
+  int queue_occupancy[3];           // batches produced by the stage, not taken by the next one
+  int queue_capacity[3];            // the number of buffers of the stage
+  double queue_mean_occupancy[3];   // the occupancy averaged over the uptime
+  int64_t outputs;                  // batches taken by the consumer
+  double consumer_wait_time;        // time the consumer spent waiting for the batches
+  int64_t consumer_starved;         // batches requested when none was ready
+  int thread_pool_threads;          // threads of the thread pool
+  double thread_pool_busy_time;     // thread time spent on the work of the pipeline
+} daliPipelineHealth;
+
 /**
  * @brief DALI initialization
  *
@@ -209,6 +251,28 @@ daliSetExternalInputAsync(daliPipelineHandle *pipe_handle, const char *name,
                           int sample_dim, const char *layout_str,
                           cudaStream_t stream, unsigned int flags);
 
+/**
+ * @brief Same as `daliSetExternalInputAsync`, but additionally records `done_event`
+ *        once DALI no longer needs the provided memory, so that the caller can reuse it
+ *        without synchronizing the host.
+ *
+ * The event is recorded in the stream used for the copy (`stream`, or the default stream
+ * when copying from pageable host memory to the GPU). It can be NULL.
+ * The data must be copied - using the event together with `DALI_ext_force_no_copy`, or with
+ * an External Source with `no_copy` enabled, is an error, as such data is used until the
+ * outputs of the pipeline are consumed.
+ *
+ * Regardless of the event, the pipeline doesn't use the data before the work already
+ * scheduled in `stream` completes, also when it is passed without a copy.
+ */
+DLL_PUBLIC void
+daliSetExternalInputAsyncWithEvent(daliPipelineHandle *pipe_handle, const char *name,
+                                   device_type_t device, const void *data_ptr,
+                                   dali_data_type_t data_type, const int64_t *shapes,
+                                   int sample_dim, const char *layout_str,
+                                   cudaStream_t stream, cudaEvent_t done_event,
+                                   unsigned int flags);
+
 DLL_PUBLIC void
 daliSetExternalInput(daliPipelineHandle *pipe_handle, const char *name,
                      device_type_t device, const void *data_ptr,
@@ -258,6 +322,19 @@ daliSetExternalInputTensorsAsync(daliPipelineHandle *pipe_handle, const char *na
                                  int64_t sample_dim, const char *layout_str,
                                  cudaStream_t stream, unsigned int flags);
 
+/**
+ * @brief Same as `daliSetExternalInputTensorsAsync`, but additionally records `done_event`
+ *        once DALI no longer needs the provided memory.
+ * @see daliSetExternalInputAsyncWithEvent
+ */
+DLL_PUBLIC void
+daliSetExternalInputTensorsAsyncWithEvent(daliPipelineHandle *pipe_handle, const char *name,
+                                          device_type_t device, const void *const *data_ptr,
+                                          dali_data_type_t data_type, const int64_t *shapes,
+                                          int64_t sample_dim, const char *layout_str,
+                                          cudaStream_t stream, cudaEvent_t done_event,
+                                          unsigned int flags);
+
 DLL_PUBLIC void
 daliSetExternalInputTensors(daliPipelineHandle *pipe_handle, const char *name,
                             device_type_t device, const void *const *data_ptr,
@@ -265,6 +342,56 @@ daliSetExternalInputTensors(daliPipelineHandle *pipe_handle, const char *name,
                             int64_t sample_dim, const char *layout_str, unsigned int flags);
 ///@}
 
+/**
+ * @brief Feed the data to a GPU ExternalSource from the device memory of another process,
+ *        shared with CUDA IPC.
+ *
+ * The memory is mapped with `cudaIpcOpenMemHandle` on the first use of the handle and stays
+ * mapped, so that the producer can reuse its buffers, until `daliCloseIpcMemHandle` is called.
+ * The data is a contiguous batch, starting `offset` bytes into the allocation.
+ *
+ * By default, the data is passed to the pipeline without a copy. The pipeline uses it after
+ * the work recorded in `ready_event` completes and, once the pipeline no longer needs it,
+ * `release_event` is recorded in the stream of the pipeline - the producer can wait for it
+ * (e.g. with `cudaStreamWaitEvent`) before reusing the memory. With `DALI_ext_force_copy`,
+ * the data is copied in `stream` and `release_event` is recorded after the copy.
+ *
+ * Both events must be created by the producer with
+ * `cudaEventInterprocess | cudaEventDisableTiming`. They can be NULL.
+ *
+ * @param pipe_handle Pointer to pipeline handle
+ * @param name Pointer to a null-terminated byte string with the name of the External Source
+ *             to be fed
+ * @param mem_handle The IPC handle of the device allocation of the producer
+ * @param offset Offset of the data within the allocation, in bytes
+ * @param data_type Type of the provided data
+ * @param shapes Pointer to an array containing shapes of all samples concatenated one after
+ *              another. Should contain batch_size * sample_dim elements.
+ * @param sample_dim The dimensionality of a single sample.
+ * @param layout_str Optional layout provided as a pointer to null-terminated byte string.
+ *                   Can be set to NULL.
+ * @param ready_event IPC handle of the event marking that the data is ready, or NULL
+ * @param release_event IPC handle of the event recorded once the memory can be reused, or NULL
+ * @param stream CUDA stream used to wait for `ready_event` and to copy the data
+ * @param flags Extra flags, check DALI_ext_force_sync, DALI_ext_force_copy, DALI_use_copy_kernel
+ */
+DLL_PUBLIC void
+daliSetExternalInputIpc(daliPipelineHandle *pipe_handle, const char *name,
+                        const cudaIpcMemHandle_t *mem_handle, size_t offset,
+                        dali_data_type_t data_type, const int64_t *shapes,
+                        int sample_dim, const char *layout_str,
+                        const cudaIpcEventHandle_t *ready_event,
+                        const cudaIpcEventHandle_t *release_event,
+                        cudaStream_t stream, unsigned int flags);
+
+/**
+ * @brief Unmaps the memory of another process mapped by `daliSetExternalInputIpc`
+ *
+ * The memory must no longer be used by any pipeline, i.e. its release event must have completed.
+ * Does nothing if the handle is not mapped.
+ */
+DLL_PUBLIC void daliCloseIpcMemHandle(const cudaIpcMemHandle_t *mem_handle);
+
 /**
  * @brief Start the execution of the pipeline.
  */
@@ -293,11 +420,50 @@ DLL_PUBLIC void daliOutput(daliPipelineHandle *pipe_handle);
  */
 DLL_PUBLIC void daliShareOutput(daliPipelineHandle *pipe_handle);
 
+/**
+ * @brief Wait until the work producing the output of the pipeline is issued.
+ * Doesn't wait for the GPU work to complete and doesn't release previously returned buffers.
+ *
+ * @return The event which has to complete before the GPU outputs are accessed or NULL,
+ *         if there are no GPU outputs. The caller should wait on it in its own stream,
+ *         e.g. with cudaStreamWaitEvent. The event is owned by the pipeline.
+ */
+DLL_PUBLIC cudaEvent_t daliShareOutputAsync(daliPipelineHandle *pipe_handle);
+
 /**
  * @brief Releases buffer returned by last daliOutput call.
  */
 DLL_PUBLIC void daliOutputRelease(daliPipelineHandle *pipe_handle);
 
+/**
+ * @brief Releases buffer returned by last daliOutput call, which may still be in use
+ * by the work preceding `consumer_event`.
+ *
+ * The pipeline doesn't overwrite the buffer before `consumer_event` completes.
+ * The event may be recorded again as soon as this function returns.
+ */
+DLL_PUBLIC void daliOutputReleaseWithEvent(daliPipelineHandle *pipe_handle,
+                                           cudaEvent_t consumer_event);
+
+/**
+ * @brief Makes the GPU output `output_idx` be written directly to the caller's device buffers,
+ * e.g. the input bindings of an inference engine, instead of DALI's memory.
+ *
+ * `num_buffers` must be equal to the prefetch queue depth of the stage producing the output:
+ * each buffer is used by one of the pipeline's output slots, so it's not overwritten until
+ * the output stored in it is released. The output is written to a buffer only if it fits there
+ * (`buffer_sizes`, in bytes) and its shape is known before the producing operator runs;
+ * otherwise, it's stored in DALI's memory and can be copied out with daliOutputCopy.
+ * Check the pointer returned by daliOutputSampleData(pipe_handle, output_idx, 0) to find out
+ * which buffer holds the output.
+ *
+ * The buffers apply to the iterations scheduled after this call; `num_buffers == 0`
+ * stops using them. The buffers must stay valid until the outputs stored in them are released.
+ */
+DLL_PUBLIC void daliSetExternalOutputBuffers(daliPipelineHandle *pipe_handle, int output_idx,
+                                             void *const *buffers, const size_t *buffer_sizes,
+                                             int num_buffers);
+
 /**
  * @brief Returns 1 if the the output batch stored at position `n` in the pipeline can
  * be represented as dense, uniform tensor. Otherwise 0.
@@ -389,6 +555,18 @@ DLL_PUBLIC void
 daliOutputCopy(daliPipelineHandle *pipe_handle, void *dst, int output_idx, device_type_t dst_type,
                cudaStream_t stream, unsigned int flags);
 
+/**
+ * @brief Same as `daliOutputCopy`, but additionally records `done_event` in `stream`
+ *        after the copy, so that the caller can wait for the data without synchronizing
+ *        the host.
+ *
+ * The copies of CPU outputs to the host memory are done before this function returns.
+ */
+DLL_PUBLIC void
+daliOutputCopyWithEvent(daliPipelineHandle *pipe_handle, void *dst, int output_idx,
+                        device_type_t dst_type, cudaStream_t stream, cudaEvent_t done_event,
+                        unsigned int flags);
+
 /**
  * @brief Copy the samples in output stored at position `output_idx` in the pipeline
  *        to scattered memory locations.
@@ -399,11 +577,26 @@ daliOutputCopy(daliPipelineHandle *pipe_handle, void *dst, int output_idx, devic
  * @param dst_type Device type associated with the destination buffer (0 - CPU, 1 - GPU)
  * @param stream CUDA stream to use when copying the data to/from the GPU.
  * @param flags Extra flags, check DALI_ext_force_sync, DALI_use_copy_kernel
+ *
+ * The copies from/to the GPU are batched in few copies or a single kernel (DALI_use_copy_kernel),
+ * and the copies of CPU outputs to the host memory are split between multiple threads.
  */
 DLL_PUBLIC void daliOutputCopySamples(daliPipelineHandle *pipe_handle, void **dsts, int output_idx,
                                       device_type_t dst_type, cudaStream_t stream,
                                       unsigned int flags);
 
+/**
+ * @brief Same as `daliOutputCopySamples`, but additionally records `done_event` in `stream`
+ *        after the copy, so that the caller can wait for the data without synchronizing
+ *        the host.
+ *
+ * The copies of CPU outputs to the host memory are done before this function returns.
+ */
+DLL_PUBLIC void
+daliOutputCopySamplesWithEvent(daliPipelineHandle *pipe_handle, void **dsts, int output_idx,
+                               device_type_t dst_type, cudaStream_t stream,
+                               cudaEvent_t done_event, unsigned int flags);
+
 /**
  * @brief DEPRECATED API: use daliOutputCopy instead
  */
@@ -443,8 +636,18 @@ DLL_PUBLIC void daliGetReaderMetadata(daliPipelineHandle* pipe_handle, const cha
 DLL_PUBLIC dali_backend_t daliGetOperatorBackend(daliPipelineHandle* pipe_handle,
                                                  const char *operator_name);
 
+/**
+ * @brief Enables or disables the collection of the operator and stage timing statistics
+ *        returned by `daliGetExecutorMetadata`. Can be called at any time.
+ */
+DLL_PUBLIC void daliEnableExecutorTimingStats(daliPipelineHandle* pipe_handle,
+                                              int enable_timing_stats);
+
 /**
  * @brief Obtains the executor statistics
+ *
+ * Returns an entry for each operator with memory or timing statistics collected. The stages
+ * are reported as `STAGE_CPU`, `STAGE_MIXED` and `STAGE_GPU` entries, with timing only.
  *  @param operator_meta Pointer to the memory allocated by the function with operator_meta_num
  *                       number of metadata entries. To free returned metadata use
  *                       `daliFreeExecutorMetadata` function
@@ -464,6 +667,166 @@ DLL_PUBLIC void daliGetExecutorMetadata(daliPipelineHandle* pipe_handle,
 DLL_PUBLIC void daliFreeExecutorMetadata(daliExecutorMetadata *operator_meta,
                                          size_t operator_meta_num);
 
+/**
+ * @brief Obtains the health metrics of the pipeline: queue occupancy, waits of the stages
+ *        and of the consumer and the use of the thread pool. Can be called at any time.
+ */
+DLL_PUBLIC void daliGetPipelineHealth(daliPipelineHandle* pipe_handle,
+                                      daliPipelineHealth *health);
+
+/**
+ * @brief Returns the health metrics of the pipeline, including the readers' prefetching,
+ *        in the Prometheus text exposition format
+ *  @param labels Labels added to every sample, e.g. `pipeline="train"`; can be NULL
+ *  @return Null-terminated string; the user needs to free it with `free`
+ */
+DLL_PUBLIC char *daliGetPipelineHealthPrometheus(daliPipelineHandle* pipe_handle,
+                                                 const char *labels);
+
+/**
+ * @brief Returns the memory kept, but not used, by DALI memory pools to the CUDA driver
+ *
+ * This function can be called, for example, by another library running in the same process,
+ * when it fails to allocate memory.
+ *  @param release_caches If nonzero, the decoded image caches are freed as well, if they are not
+ *                        in use
+ *  @return The number of bytes released
+ */
+DLL_PUBLIC size_t daliReleaseUnusedMemory(int release_caches);
+
+/// @{
+/**
+ * @brief Request batching
+ *
+ * Aggregates samples coming from individual requests (e.g. one image per inference request)
+ * into batches. A typical serving loop looks like:
+ *
+ *   // any thread, for every request and every input:
+ *   daliAddRequestSample(&batcher, request_id, "images", CPU, data, DALI_UINT8, shape, 3, "HWC");
+ *
+ *   // serving thread:
+ *   if (daliRunRequestBatch(&batcher, stream, DALI_ext_default) > 0) {
+ *     daliShareOutput(&pipe);
+ *     int n = daliPopRequestBatch(&batcher, request_ids);
+ *     for (int k = 0; k < n; k++)
+ *       respond(request_ids[k], daliOutputSampleData(&pipe, 0, k), daliShapeAtSample(&pipe, 0, k));
+ *     daliOutputRelease(&pipe);
+ *   }
+ */
+
+/**
+ * @brief Creates a request batcher feeding the pipeline `pipe_handle`.
+ *
+ * @param input_names Names of the External Sources that every request provides a sample for
+ * @param num_inputs Number of the names in `input_names`
+ * @param max_latency_us The longest time (in microseconds) a complete request waits for other
+ *                       requests to fill the batch before a partial batch is run
+ */
+DLL_PUBLIC void daliCreateRequestBatcher(daliRequestBatcherHandle *batcher_handle,
+                                         daliPipelineHandle *pipe_handle,
+                                         const char *const *input_names, int num_inputs,
+                                         int64_t max_latency_us);
+
+/**
+ * @brief Destroys the request batcher. Doesn't affect the pipeline.
+ */
+DLL_PUBLIC void daliDeleteRequestBatcher(daliRequestBatcherHandle *batcher_handle);
+
+/**
+ * @brief Adds the sample provided by the request `request_id` for the input `name`.
+ *
+ * The request becomes complete when it has a sample for every input. The memory is not copied
+ * here - it must stay valid until the batch containing the request is fed to the pipeline
+ * (see daliRunRequestBatch). Can be called from multiple threads.
+ *
+ * @param shape Shape of the sample, `sample_dim` elements
+ * @param layout_str Optional layout, can be NULL
+ */
+DLL_PUBLIC void daliAddRequestSample(daliRequestBatcherHandle *batcher_handle, int64_t request_id,
+                                     const char *name, device_type_t device, const void *data_ptr,
+                                     dali_data_type_t data_type, const int64_t *shape,
+                                     int sample_dim, const char *layout_str);
+
+/**
+ * @brief Feeds a batch of complete requests to the pipeline and schedules a run.
+ *
+ * If there are no complete requests, returns 0 immediately. Otherwise, waits until either
+ * the batch is full (max batch size of the pipeline) or the oldest complete request has waited
+ * for `max_latency_us`, whichever comes first, and runs the batch with the requests completed
+ * so far, in the order of arrival.
+ *
+ * The samples are fed with daliSetExternalInputTensorsAsync, using `stream` and `flags`.
+ * Unless the data is copied synchronously (DALI_ext_force_sync), the memory of the requests
+ * must stay valid until the work in `stream` completes.
+ *
+ * @return The number of requests in the batch
+ */
+DLL_PUBLIC int daliRunRequestBatch(daliRequestBatcherHandle *batcher_handle, cudaStream_t stream,
+                                   unsigned int flags);
+
+/**
+ * @brief Returns the ids of the requests in the oldest batch that was run, but not popped yet.
+ *
+ * The batches are popped in the order they were run, which is the order in which their outputs
+ * are returned by daliOutput/daliShareOutput. The k-th sample of every output of the batch
+ * belongs to the request `request_ids[k]`.
+ *
+ * @param request_ids Output array, must be able to hold max batch size elements
+ * @return The number of requests in the batch
+ */
+DLL_PUBLIC int daliPopRequestBatch(daliRequestBatcherHandle *batcher_handle, int64_t *request_ids);
+/// @}
+
+/**
+ * @brief Returns the pointer to the data of the `k`-th sample of the output stored at position
+ *        `n` in the pipeline.
+ *
+ * It allows passing the samples to their consumers without copying. The pointer is valid until
+ * the output is released. The memory is located on the device returned by daliGetOutputDevice.
+ * This function may only be called after calling Output function.
+ */
+DLL_PUBLIC const void *daliOutputSampleData(daliPipelineHandle *pipe_handle, int n, int k);
+
+/// @{
+/**
+ * @brief Waits until the next output of the pipeline is ready and returns it as a handle.
+ *
+ * Unlike daliOutput/daliShareOutput, the outputs of several iterations (up to the prefetch
+ * queue depth) can be held at the same time and released in any order, e.g. by concurrent
+ * consumers. The outputs are accessed by passing `&out_handle->outputs` to the output
+ * functions (daliShapeAtSample, daliOutputSampleData, daliOutputCopy, ...) and stay valid
+ * until daliReleaseOutputHandle is called.
+ *
+ * The handles should not be mixed with daliOutputRelease, which releases the oldest output.
+ */
+DLL_PUBLIC void daliAcquireOutput(daliPipelineHandle *pipe_handle, daliOutputHandle *out_handle);
+
+/**
+ * @brief Like daliAcquireOutput, but doesn't wait for the GPU work producing the outputs.
+ *
+ * @return See daliShareOutputAsync
+ */
+DLL_PUBLIC cudaEvent_t daliAcquireOutputAsync(daliPipelineHandle *pipe_handle,
+                                              daliOutputHandle *out_handle);
+
+/**
+ * @brief Releases the outputs acquired with daliAcquireOutput(Async).
+ *
+ * @param consumer_event Can be NULL, see daliOutputReleaseWithEvent
+ */
+DLL_PUBLIC void daliReleaseOutputHandle(daliOutputHandle *out_handle, cudaEvent_t consumer_event);
+
+/**
+ * @brief Releases the outputs acquired with daliAcquireOutput(Async), which may still be in use
+ * by the work issued so far to `consumer_stream`.
+ *
+ * Equivalent to recording an event in `consumer_stream` and calling daliReleaseOutputHandle
+ * with it, for the callers which don't use the CUDA runtime directly.
+ */
+DLL_PUBLIC void daliReleaseOutputHandleOnStream(daliOutputHandle *out_handle,
+                                                cudaStream_t consumer_stream);
+/// @}
+
 #ifdef __cplusplus
 }
 #endif
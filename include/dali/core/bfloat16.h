@@ -0,0 +1,117 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_CORE_BFLOAT16_H_
+#define DALI_CORE_BFLOAT16_H_
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "dali/core/host_dev.h"
+#include "dali/core/force_inline.h"
+#include "dali/core/float16.h"
+
+namespace dali {
+
+/**
+ * @brief Brain floating point type (bfloat16) usable in host and device code
+ *
+ * bfloat16 has the same exponent range as `float` and a 7-bit mantissa - it is the upper half
+ * of an IEEE 754 single precision number. It is a storage type: the conversion from `float`
+ * rounds to nearest even (NaNs are preserved) and all arithmetic is done in `float`, via
+ * the implicit conversion operator. The type is trivial, so it can be used in shared memory
+ * and in device buffers.
+ *
+ * The result of any binary operation involving bfloat16 is `float` (or `double`).
+ */
+struct bfloat16 {
+  bfloat16() = default;
+  bfloat16(const bfloat16 &) = default;
+
+  DALI_HOST_DEV DALI_FORCEINLINE bfloat16(float x) : bits(FromFloat(x)) {}  // NOLINT
+
+  uint16_t bits;
+
+  DALI_HOST_DEV DALI_FORCEINLINE operator float() const noexcept {  // NOLINT
+    return ToFloat(bits);
+  }
+
+  DALI_HOST_DEV DALI_FORCEINLINE bfloat16 operator-() const noexcept {
+    return FromBits(bits ^ 0x8000u);
+  }
+
+  DALI_HOST_DEV DALI_FORCEINLINE bfloat16 operator+() const noexcept {
+    return *this;
+  }
+
+#define DALI_BF16_COMPOUND_ASSIGNMENT(op)                                     \
+  template <typename T>                                                       \
+  DALI_HOST_DEV DALI_FORCEINLINE bfloat16 &operator op##=(T other) noexcept { \
+    return *this = static_cast<float>(*this) op other;                        \
+  }
+
+  DALI_BF16_COMPOUND_ASSIGNMENT(+)
+  DALI_BF16_COMPOUND_ASSIGNMENT(-)
+  DALI_BF16_COMPOUND_ASSIGNMENT(*)
+  DALI_BF16_COMPOUND_ASSIGNMENT(/)
+
+#undef DALI_BF16_COMPOUND_ASSIGNMENT
+
+  DALI_HOST_DEV DALI_FORCEINLINE static bfloat16 FromBits(uint16_t bits) noexcept {
+    bfloat16 ret;
+    ret.bits = bits;
+    return ret;
+  }
+
+  /**
+   * @brief Rounds a float to the nearest bfloat16 (ties to even); NaNs are kept quiet NaNs
+   */
+  DALI_HOST_DEV DALI_FORCEINLINE static uint16_t FromFloat(float x) noexcept {
+#ifdef __CUDA_ARCH__
+    uint32_t u = __float_as_uint(x);
+#else
+    uint32_t u;
+    std::memcpy(&u, &x, sizeof(u));
+#endif
+    if ((u & 0x7fffffffu) > 0x7f800000u)
+      return static_cast<uint16_t>((u >> 16) | 0x40u);
+    u += 0x7fffu + ((u >> 16) & 1u);
+    return static_cast<uint16_t>(u >> 16);
+  }
+
+  DALI_HOST_DEV DALI_FORCEINLINE static float ToFloat(uint16_t bits) noexcept {
+    uint32_t u = static_cast<uint32_t>(bits) << 16;
+#ifdef __CUDA_ARCH__
+    return __uint_as_float(u);
+#else
+    float f;
+    std::memcpy(&f, &u, sizeof(f));
+    return f;
+#endif
+  }
+};
+
+static_assert(sizeof(bfloat16) == 2, "bfloat16 must be exactly 2 bytes long");
+static_assert(std::is_trivial<bfloat16>::value, "bfloat16 must be a trivial type");
+
+namespace detail {
+
+template <>
+struct is_half<bfloat16> : std::true_type {};
+
+}  // namespace detail
+
+}  // namespace dali
+
+#endif  // DALI_CORE_BFLOAT16_H_
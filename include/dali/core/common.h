@@ -109,7 +109,9 @@ enum DALIImageType {
   DALI_BGR          = 1,
   DALI_GRAY         = 2,
   DALI_YCbCr        = 3,
-  DALI_ANY_DATA     = 4
+  DALI_ANY_DATA     = 4,
+  /// YCbCr with the chroma subsampled 2x in both dimensions, stored as planes of a 2D tensor
+  DALI_YUV420       = 5
 };
 
 inline bool IsColor(DALIImageType type) {
@@ -183,6 +185,8 @@ inline std::string to_string(const DALIImageType& im_type) {
       return "GRAY";
     case DALI_YCbCr:
       return "YCbCr";
+    case DALI_YUV420:
+      return "YUV420";
     default:
       return "<unknown>";
   }
@@ -21,6 +21,7 @@
 #include <type_traits>
 #include "dali/core/host_dev.h"
 #include "dali/core/float16.h"
+#include "dali/core/bfloat16.h"
 
 namespace dali {
 
@@ -181,6 +182,32 @@ DALI_HOST_DEV constexpr float16 clamp(T value, ret_type<float16>) {
   return static_cast<float16>(f);
 }
 
+template <typename T>
+DALI_HOST_DEV constexpr T clamp(bfloat16 value, ret_type<T>) {
+  return clamp(static_cast<float>(value), ret_type<T>());
+}
+
+DALI_HOST_DEV inline bfloat16 clamp(bfloat16 value, ret_type<bfloat16>) {
+  return value;
+}
+
+template <typename T>
+DALI_HOST_DEV constexpr bfloat16 clamp(T value, ret_type<bfloat16>) {
+  // the largest finite bfloat16 - larger floats would be rounded to infinity
+  constexpr float bf16_min = -3.38953139e+38f, bf16_max = 3.38953139e+38f;
+  float f = clamp(value, ret_type<float>());
+  f = f < bf16_min ? bf16_min : f > bf16_max ? bf16_max : f;
+  return static_cast<bfloat16>(f);
+}
+
+DALI_HOST_DEV inline float16 clamp(bfloat16 value, ret_type<float16>) {
+  return clamp(static_cast<float>(value), ret_type<float16>());
+}
+
+DALI_HOST_DEV inline bfloat16 clamp(float16 value, ret_type<bfloat16>) {
+  return static_cast<bfloat16>(static_cast<float>(value));
+}
+
 template <typename T, typename U>
 DALI_HOST_DEV constexpr T clamp(U value) {
   return clamp(value, ret_type<T>());
@@ -294,6 +321,53 @@ struct ConverterBase<float16, In, true, false> {
   }
 };
 
+/// Converts integral to bfloat16 special case
+template <typename In>
+struct ConverterBase<bfloat16, In, true, false> {
+  DALI_HOST_DEV
+  static constexpr bfloat16 Convert(In value) {
+    auto out = ConverterBase<float, In, true, false>::Convert(value);
+    return static_cast<bfloat16>(out);
+  }
+
+  DALI_HOST_DEV
+  static constexpr bfloat16 ConvertSat(In value) {
+    auto out = ConverterBase<float, In, true, false>::ConvertSat(value);
+    return static_cast<bfloat16>(out);
+  }
+
+  DALI_HOST_DEV
+  static constexpr bfloat16 ConvertNorm(In value) {
+    auto out = ConverterBase<float, In, true, false>::ConvertNorm(value);
+    return static_cast<bfloat16>(out);
+  }
+
+  DALI_HOST_DEV
+  static constexpr bfloat16 ConvertSatNorm(In value) {
+    auto out = ConverterBase<float, In, true, false>::ConvertSatNorm(value);
+    return static_cast<bfloat16>(out);
+  }
+};
+
+/// Converts between float16 and bfloat16 - there's no direct conversion, so it goes via float
+template <typename Out, typename In>
+struct ConvertHalfHalf {
+  DALI_HOST_DEV
+  static constexpr Out Convert(In value) { return static_cast<float>(value); }
+  DALI_HOST_DEV
+  static constexpr Out ConvertNorm(In value) { return static_cast<float>(value); }
+  DALI_HOST_DEV
+  static constexpr Out ConvertSat(In value) { return static_cast<float>(value); }
+  DALI_HOST_DEV
+  static constexpr Out ConvertSatNorm(In value) { return static_cast<float>(value); }
+};
+
+template <>
+struct ConverterBase<float16, bfloat16, true, true> : ConvertHalfHalf<float16, bfloat16> {};
+
+template <>
+struct ConverterBase<bfloat16, float16, true, true> : ConvertHalfHalf<bfloat16, float16> {};
+
 /// Converts FP to integral type
 template <typename Out, typename In>
 struct ConverterBase<Out, In, false, true> {
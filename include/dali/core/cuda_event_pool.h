@@ -98,6 +98,40 @@ class DLL_PUBLIC CUDAEventPool {
   void DeleteList(EventEntry *&head);
 };
 
+/**
+ * @brief A per-thread cache of events, layered on CUDAEventPool::instance()
+ *
+ * Each thread keeps a few events per device, which it can get and put back without taking
+ * any locks. Only when the thread's cache for the device is empty (or full) the events are taken
+ * from (or returned to) the shared pool. The events cached by a thread are returned to the
+ * shared pool when the thread exits.
+ *
+ * An event can be put back by a different thread than the one which got it, as long as the
+ * device is stated correctly.
+ */
+class DLL_PUBLIC CUDAEventCache {
+ public:
+  /// The maximum number of events cached per thread and device
+  static constexpr int kMaxCachedPerDevice = 16;
+
+  /**
+   * @brief Gets an event for given device from the calling thread's cache or from the pool.
+   *
+   * @param device_id   CUDA runtime API device ordinal. If negative, calling thread's
+   *                    current device is used.
+   */
+  static CUDAEvent Get(int device_id = -1);
+
+  /**
+   * @brief Places an event for given device in the calling thread's cache or in the pool,
+   *        if the cache is full.
+   *
+   * @param device_id CUDA runtime API device ordinal of the device for which the event was
+   *                  created. If negative, calling thread's current device is used.
+   */
+  static void Put(CUDAEvent &&event, int device_id = -1);
+};
+
 }  // namespace dali
 
 #endif  // DALI_CORE_CUDA_EVENT_POOL_H_
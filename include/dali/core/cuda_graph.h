@@ -0,0 +1,56 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_CORE_CUDA_GRAPH_H_
+#define DALI_CORE_CUDA_GRAPH_H_
+
+#include <driver_types.h>
+#include "dali/core/unique_handle.h"
+
+namespace dali {
+
+/**
+ * @brief A wrapper class for CUDA graph handle (cudaGraph_t)
+ *
+ * The graph is typically obtained by capturing the work issued to a stream
+ * (see cudaStreamBeginCapture / cudaStreamEndCapture); the object may assume ownership
+ * of such a handle via constructor or @link UniqueHandle::reset(handle_type) reset @endlink.
+ */
+class DLL_PUBLIC CUDAGraph : public UniqueHandle<cudaGraph_t, CUDAGraph> {
+ public:
+  DALI_INHERIT_UNIQUE_HANDLE(cudaGraph_t, CUDAGraph)
+  constexpr CUDAGraph() = default;
+
+  /// @brief Calls cudaGraphDestroy on the handle.
+  static void DestroyHandle(cudaGraph_t);
+};
+
+/**
+ * @brief A wrapper class for executable CUDA graph handle (cudaGraphExec_t)
+ */
+class DLL_PUBLIC CUDAGraphExec : public UniqueHandle<cudaGraphExec_t, CUDAGraphExec> {
+ public:
+  DALI_INHERIT_UNIQUE_HANDLE(cudaGraphExec_t, CUDAGraphExec)
+  constexpr CUDAGraphExec() = default;
+
+  /// @brief Instantiates an executable graph from the graph
+  static CUDAGraphExec Instantiate(cudaGraph_t graph);
+
+  /// @brief Calls cudaGraphExecDestroy on the handle.
+  static void DestroyHandle(cudaGraphExec_t);
+};
+
+}  // namespace dali
+
+#endif  // DALI_CORE_CUDA_GRAPH_H_
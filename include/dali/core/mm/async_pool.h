@@ -21,6 +21,8 @@
 #include <utility>
 #include <vector>
 #include "dali/core/mm/pool_resource.h"
+#include "dali/core/mm/pool_stats.h"
+#include "dali/core/mm/releasable_resource.h"
 #include "dali/core/mm/detail/free_list.h"
 #include "dali/core/small_vector.h"
 #include "dali/core/cuda_event_pool.h"
@@ -38,7 +40,9 @@ template <typename Kind,
     typename GlobalPool = deferred_dealloc_pool<Kind, any_context, coalescing_free_tree, spinlock>,
     typename LockType = std::mutex,
     typename Upstream = memory_resource<Kind>>
-class async_pool_resource : public async_memory_resource<Kind> {
+class async_pool_resource : public async_memory_resource<Kind>,
+                            public pool_stats_provider,
+                            public releasable_resource {
  public:
   /**
    * @param upstream       Upstream resource, used by the global pool
@@ -80,6 +84,43 @@ class async_pool_resource : public async_memory_resource<Kind> {
     synchronize_impl(true);
   }
 
+  /**
+   * @brief Obtains the memory usage statistics
+   *
+   * The statistics describe the state of the pool at the time of the call - the pending
+   * deallocations are not checked for completion.
+   */
+  bool get_stats(pool_stats &stats) const override {
+    std::lock_guard<LockType> guard(lock_);
+    stats.reserved = global_pool_.reserved_bytes();
+    stats.in_use = in_use_;
+    stats.peak_in_use = peak_in_use_;
+    stats.pending_free = pending_free_bytes_;
+    stats.num_pending_frees = num_pending_frees_;
+    stats.largest_free_block = global_pool_.largest_free_block();
+    stats.cross_stream_reclaims = cross_stream_reclaims_;
+    stats.pending_free_syncs = pending_free_syncs_;
+    return true;
+  }
+
+  void reset_peak() override {
+    std::lock_guard<LockType> guard(lock_);
+    peak_in_use_ = in_use_;
+  }
+
+  /**
+   * @brief Waits for the pending frees and returns the unused memory to the upstream resource
+   *
+   * @return The number of bytes released
+   */
+  size_t release_unused() override {
+    synchronize();
+    std::lock_guard<LockType> guard(lock_);
+    for (auto &kv : stream_free_)
+      free_ready(kv.second);
+    return global_pool_.release_unused();
+  }
+
  private:
   void synchronize_impl(bool lock) {
     {
@@ -105,7 +146,9 @@ class async_pool_resource : public async_memory_resource<Kind> {
   void *do_allocate(size_t bytes, size_t alignment) override {
     adjust_size_and_alignment(bytes, alignment, true);
     std::lock_guard<LockType> guard(lock_);
-    return allocate_from_global_pool(bytes, alignment);
+    void *ptr = allocate_from_global_pool(bytes, alignment);
+    add_in_use(bytes);
+    return ptr;
   }
 
   void do_deallocate(void *mem, size_t bytes, size_t alignment) override {
@@ -120,6 +163,7 @@ class async_pool_resource : public async_memory_resource<Kind> {
       mm::detail::synchronize(sync);
     }
     std::lock_guard<LockType> guard(lock_);
+    in_use_ -= bytes;
     char *ptr = static_cast<char *>(mem);
     pop_block_padding(ptr, bytes, alignment);
     if (deferred)  // deferred - just use deallocate, it will schedule synchronization
@@ -148,10 +192,20 @@ class async_pool_resource : public async_memory_resource<Kind> {
     void *ptr;
     if (it != stream_free_.end()) {
       ptr = try_allocate(it->second, bytes, alignment);
-      if (ptr)
+      if (ptr) {
+        add_in_use(bytes);
         return ptr;
+      }
     }
-    return allocate_from_global_pool(bytes, alignment);
+    ptr = allocate_from_global_pool(bytes, alignment);
+    add_in_use(bytes);
+    return ptr;
+  }
+
+  void add_in_use(size_t bytes) {
+    in_use_ += bytes;
+    if (in_use_ > peak_in_use_)
+      peak_in_use_ = in_use_;
   }
 
   /**
@@ -170,7 +224,7 @@ class async_pool_resource : public async_memory_resource<Kind> {
       return ptr;
     // Try to reclaim some memory from completed pending frees.
     for (auto &kv : stream_free_)
-      free_ready(kv.second);
+      cross_stream_reclaims_ += free_ready(kv.second);
     if (avoid_upstream_ && num_pending_frees_ > 0) {
       // AVOIDING UPSTREAM
       // Try to allocate from the global pool again...
@@ -179,8 +233,9 @@ class async_pool_resource : public async_memory_resource<Kind> {
         return ptr;
       // Synchronize - this will wait for pending frees to complete.
       synchronize_impl(false);
+      pending_free_syncs_++;
       for (auto &kv : stream_free_)
-        free_ready(kv.second);
+        cross_stream_reclaims_ += free_ready(kv.second);
     }
     // Finally, allocate from the global pool, this time allowing fallback to the upstream.
     ptr = global_pool_.allocate(bytes, alignment);
@@ -192,6 +247,7 @@ class async_pool_resource : public async_memory_resource<Kind> {
       return;
     adjust_size_and_alignment(bytes, alignment, false);
     std::lock_guard<LockType> guard(lock_);
+    in_use_ -= bytes;
     char *ptr = static_cast<char*>(mem);
     pop_block_padding(ptr, bytes, alignment);
     deallocate_async_impl(stream_free_[stream.get()], ptr, bytes, alignment, stream.get());
@@ -335,6 +391,7 @@ class async_pool_resource : public async_memory_resource<Kind> {
           // Adjust the pending free `f` so that it contains only what remains after
           // the block was split.
           size_t remainder_size = block_end - remainder;
+          pending_free_bytes_ -= block_size - remainder_size;
           f->addr = remainder;
           f->bytes = remainder_size;
           f->alignment = remainder_alignment;
@@ -396,13 +453,18 @@ class async_pool_resource : public async_memory_resource<Kind> {
 
   /**
    * @brief Returns the memory from completed deallocations to the global pool.
+   *
+   * @return The number of blocks returned.
    */
-  void free_ready(PerStreamFreeBlocks &free) {
+  int free_ready(PerStreamFreeBlocks &free) {
+    int count = 0;
     auto *f = find_first_ready(free);
     while (f) {
       global_pool_.deallocate_no_sync(f->addr, f->bytes, f->alignment);
       f = remove_pending_free(free, f);
+      count++;
     }
+    return count;
   }
 
   void deallocate_async_impl(PerStreamFreeBlocks &free, char *ptr, size_t bytes, size_t alignment,
@@ -453,9 +515,10 @@ class async_pool_resource : public async_memory_resource<Kind> {
     if (!free.tail) free.tail = f;
     CUDA_CALL(cuStreamGetCtx(stream, &f->ctx));
     ContextScope scope(f->ctx);
-    f->event = CUDAEventPool::instance().Get();
+    f->event = CUDAEventCache::Get();
     CUDA_CALL(cudaEventRecord(f->event, stream));
     num_pending_frees_++;
+    pending_free_bytes_ += bytes;
     return f;
   }
 
@@ -468,7 +531,8 @@ class async_pool_resource : public async_memory_resource<Kind> {
 
   pending_free *remove_pending_free(PendingFreeList &free, pending_free *f) {
     ContextScope scope(f->ctx);
-    CUDAEventPool::instance().Put(std::move(f->event));
+    CUDAEventCache::Put(std::move(f->event));
+    pending_free_bytes_ -= f->bytes;
     auto *prev = f->prev;
     auto *next = f->next;
     if (free.head == f)
@@ -507,7 +571,7 @@ class async_pool_resource : public async_memory_resource<Kind> {
 
   using FreeDescAlloc = detail::object_pool_allocator<pending_free>;
 
-  LockType lock_;
+  mutable LockType lock_;
   vector<CUDAStream> sync_streams_;
   CUDAStream &GetSyncStream(int device_id) {
     int ndev = sync_streams_.size();
@@ -568,6 +632,11 @@ class async_pool_resource : public async_memory_resource<Kind> {
 
   int num_pending_frees_ = 0;
   bool avoid_upstream_ = true;
+
+  size_t in_use_ = 0, peak_in_use_ = 0;
+  size_t pending_free_bytes_ = 0;
+  size_t cross_stream_reclaims_ = 0;
+  size_t pending_free_syncs_ = 0;
 };
 
 }  // namespace mm
@@ -20,6 +20,8 @@
 #include <tuple>
 #include <utility>
 #include "dali/core/mm/memory_resource.h"
+#include "dali/core/mm/pool_stats.h"
+#include "dali/core/mm/releasable_resource.h"
 
 namespace dali {
 namespace mm {
@@ -38,7 +40,9 @@ using resource_interface_t = std::remove_reference_t<
 
 
 template <typename Interface, typename Resource, typename...Extra>
-class CompositeResourceBase : public Interface {
+class CompositeResourceBase : public Interface,
+                              public pool_stats_provider,
+                              public releasable_resource {
  public:
   using memory_kind = typename Resource::memory_kind;
   CompositeResourceBase() = default;
@@ -51,6 +55,18 @@ class CompositeResourceBase : public Interface {
     static_assert(sizeof...(ExtraArgs) == sizeof...(Extra), "Incorrect number of extra values");
   }
 
+  bool get_stats(pool_stats &stats) const override {
+    return get_pool_stats(resource.get(), stats);
+  }
+
+  void reset_peak() override {
+    reset_pool_peak(resource.get());
+  }
+
+  size_t release_unused() override {
+    return release_unused_memory(resource.get());
+  }
+
  protected:
   std::tuple<Extra... > extra;
   std::shared_ptr<Resource> resource;
@@ -0,0 +1,152 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_CORE_MM_CUDA_VM_GROWABLE_BUFFER_H_
+#define DALI_CORE_MM_CUDA_VM_GROWABLE_BUFFER_H_
+
+#include <utility>
+#include <vector>
+#include "dali/core/mm/cu_vm.h"
+
+#if DALI_USE_CUDA_VM_MAP
+
+#include "dali/core/device_guard.h"
+
+namespace dali {
+namespace mm {
+
+/**
+ * @brief A device memory buffer, which can grow in place.
+ *
+ * The buffer reserves a virtual address range once and maps physical memory to it on demand.
+ * Growing the buffer doesn't change its address nor its contents and only the memory that's
+ * actually used is backed by physical storage.
+ */
+class cuda_vm_growable_buffer {
+ public:
+  cuda_vm_growable_buffer() = default;
+
+  /**
+   * @brief Reserves a virtual address range of (at least) `max_size` bytes
+   *
+   * @param max_size        The size of the virtual address range; the buffer can't grow beyond it
+   * @param device_ordinal  The device on which the physical memory is allocated; -1 for current
+   */
+  explicit cuda_vm_growable_buffer(size_t max_size, int device_ordinal = -1) {
+    if (device_ordinal < 0)
+      CUDA_CALL(cudaGetDevice(&device_ordinal));
+    device_ = device_ordinal;
+    va_ = cuvm::CUMemAddressRange::Reserve(max_size);
+  }
+
+  cuda_vm_growable_buffer(cuda_vm_growable_buffer &&other) {
+    *this = std::move(other);
+  }
+
+  cuda_vm_growable_buffer &operator=(cuda_vm_growable_buffer &&other) {
+    if (this != &other) {
+      reset();
+      va_ = std::move(other.va_);
+      blocks_ = std::move(other.blocks_);
+      mapped_ = other.mapped_;
+      device_ = other.device_;
+      other.mapped_ = 0;
+      other.device_ = -1;
+    }
+    return *this;
+  }
+
+  ~cuda_vm_growable_buffer() {
+    reset();
+  }
+
+  /**
+   * @brief Unmaps and frees the physical memory and releases the address range.
+   *
+   * The device is synchronized before unmapping the memory, so the pending work that
+   * uses the buffer can complete - just like with synchronous deallocation in a memory pool.
+   */
+  void reset() {
+    if (!va_)
+      return;
+    if (mapped_) {
+      DeviceGuard dg(device_);
+      CUDA_DTOR_CALL(cudaDeviceSynchronize());
+      CUdeviceptr ptr = va_.ptr();
+      for (auto &block : blocks_) {
+        cuvm::Unmap(ptr, block.size());
+        ptr += block.size();
+      }
+    }
+    blocks_.clear();
+    mapped_ = 0;
+    va_.reset();
+  }
+
+  void *data() const noexcept {
+    return va_ ? reinterpret_cast<void *>(va_.ptr()) : nullptr;
+  }
+
+  /**
+   * @brief The number of bytes backed by physical memory
+   */
+  size_t capacity() const noexcept {
+    return mapped_;
+  }
+
+  /**
+   * @brief The size of the reserved virtual address range
+   */
+  size_t max_size() const noexcept {
+    return va_ ? va_.size() : 0;
+  }
+
+  int device_id() const noexcept {
+    return device_;
+  }
+
+  /**
+   * @brief Maps physical memory so that at least `bytes` are usable.
+   *
+   * The memory is mapped in multiples of the allocation granularity.
+   * The contents and the address of the memory that's already mapped don't change.
+   *
+   * @return false, if `bytes` exceeds the reserved address range; the buffer is not modified
+   */
+  bool reserve(size_t bytes) {
+    if (bytes <= mapped_)
+      return true;
+    if (bytes > max_size())
+      return false;
+    size_t new_mapped = align_up(bytes, cuvm::GetAddressGranularity());
+    cuvm::CUMem block = cuvm::CUMem::Create(new_mapped - mapped_, device_);
+    cuvm::Map(va_.ptr() + mapped_, block);
+    mapped_ += block.size();
+    blocks_.push_back(std::move(block));
+    return true;
+  }
+
+ private:
+  cuvm::CUMemAddressRange va_;
+  std::vector<cuvm::CUMem> blocks_;
+  size_t mapped_ = 0;
+  int device_ = -1;
+};
+
+}  // namespace mm
+}  // namespace dali
+
+#endif  // DALI_USE_CUDA_VM_MAP
+
+#endif  // DALI_CORE_MM_CUDA_VM_GROWABLE_BUFFER_H_
@@ -128,6 +128,52 @@ class cuda_vm_resource_base : public memory_resource<memory_kind::device> {
     return stat_;
   }
 
+  /**
+   * @brief Total size of the physical memory blocks allocated by the resource
+   */
+  size_t reserved_bytes() const {
+    lock_guard pool_guard(pool_lock_);
+    return static_cast<size_t>(stat_.allocated_blocks) * block_size_;
+  }
+
+  /**
+   * @brief Size of the largest mapped block which can be allocated without mapping more memory
+   */
+  size_t largest_free_block() const {
+    lock_guard pool_guard(pool_lock_);
+    return free_mapped_.largest_block();
+  }
+
+  /**
+   * @brief Unmaps the blocks of physical memory, which are not used, and frees them.
+   *
+   * The virtual address ranges are kept. The deferred deallocations are flushed first.
+   *
+   * @return The number of bytes released
+   */
+  size_t release_unused() {
+    flush_deferred();
+    lock_guard pool_guard(pool_lock_);
+    mem_lock_guard mem_guard(mem_lock_);
+    size_t released = 0;
+    for (va_region &r : va_regions_) {
+      if (!r.available_blocks)
+        continue;
+      for (int block_idx = r.available.find(true);
+           block_idx < r.num_blocks();
+           block_idx = r.available.find(true, block_idx + 1)) {
+        r.unmap_block(block_idx);  // the returned handle releases the memory
+        stat_.total_unmaps++;
+        char *ptr = r.block_ptr<char>(block_idx);
+        free_mapped_.get_specific_block(ptr, block_size_);
+        stat_take_free(block_size_);
+        stat_.allocated_blocks--;
+        released += block_size_;
+      }
+    }
+    return released;
+  }
+
   void clear_stat() {
     lock_guard pool_guard(pool_lock_);
     stat_ = {};
@@ -16,6 +16,7 @@
 #define DALI_CORE_MM_DEFAULT_RESOURCES_H_
 
 
+#include <functional>
 #include <memory>
 #include "dali/core/api_helper.h"
 #include "dali/core/mm/memory_resource.h"
@@ -112,6 +113,43 @@ void SetDefaultDeviceResource(int device_id, device_async_resource *resource, bo
 DLL_PUBLIC
 void SetDefaultDeviceResource(int device_id, std::shared_ptr<device_async_resource> resource);
 
+/**
+ * @brief Returns the memory kept, but not used, by the default memory resources.
+ *
+ * The pending deallocations are completed and the memory that's not allocated is returned
+ * from the device memory pools of all devices and from the pinned memory pool to the driver.
+ * The function can be called by a framework running in the same process when it fails
+ * to allocate memory.
+ *
+ * @param release_caches If true, the callbacks registered with AddMemoryReleaseCallback are
+ *                       called before the pools are flushed, so the caches built on top of the
+ *                       pools can drop their contents.
+ * @return The number of bytes released
+ */
+DLL_PUBLIC size_t ReleaseUnusedMemory(bool release_caches = false);
+
+/**
+ * @brief A function which frees some memory and returns the number of bytes freed
+ */
+using MemoryReleaseCallback = std::function<size_t()>;
+
+/**
+ * @brief Registers a function, which drops the contents of a cache to free memory.
+ *
+ * The callback is called by ReleaseUnusedMemory with `release_caches` set and it must not
+ * register or remove the callbacks.
+ *
+ * @return The identifier of the callback, to be passed to RemoveMemoryReleaseCallback
+ */
+DLL_PUBLIC int AddMemoryReleaseCallback(MemoryReleaseCallback callback);
+
+/**
+ * @brief Removes a callback registered with AddMemoryReleaseCallback
+ *
+ * When the function returns, the callback is not running and won't be called anymore.
+ */
+DLL_PUBLIC void RemoveMemoryReleaseCallback(int callback_id);
+
 
 
 }  // namespace mm
@@ -664,6 +664,13 @@ class coalescing_free_tree {
     }
   }
 
+  /**
+   * @brief Returns the size of the largest free block or 0, if the tree is empty
+   */
+  size_t largest_block() const noexcept {
+    return by_size_.empty() ? 0 : by_size_.rbegin()->first;
+  }
+
   void merge(coalescing_free_tree &&with) {
     with.by_size_.clear();
     // Erase the source list one by one - this reduces requirements on total auxiliary memory
@@ -0,0 +1,113 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_CORE_MM_HUGEPAGE_RESOURCE_H_
+#define DALI_CORE_MM_HUGEPAGE_RESOURCE_H_
+
+#include <mutex>
+#include <vector>
+#include "dali/core/api_helper.h"
+#include "dali/core/int_literals.h"
+#include "dali/core/mm/memory_resource.h"
+#include "dali/core/mm/detail/free_list.h"
+
+namespace dali {
+namespace mm {
+
+/**
+ * @brief A pinned memory resource which maps huge pages and page-locks them with
+ *        cudaHostRegister, in large chunks.
+ *
+ * Growing a pinned pool with cudaMallocHost is slow for large sizes and synchronizes the work
+ * in flight on all devices. This resource pays that cost only when it maps a new chunk -
+ * optionally, once, at startup (see `reserve`) - and then serves the allocations from the
+ * chunks it owns. The memory is returned to the OS only when the resource is destroyed,
+ * so it's intended as an upstream of a pool.
+ *
+ * The chunks are mapped with MAP_HUGETLB, which needs huge pages of the given size reserved
+ * in the system (e.g. with /proc/sys/vm/nr_hugepages); otherwise the chunks are aligned
+ * to the huge page size and transparent huge pages are requested with madvise.
+ * Huge pages reduce the TLB misses when the buffers are copied to and from the device.
+ *
+ * The pages are placed on the NUMA node local to the current device, if it's known
+ * (see numa::SetDeviceNode).
+ */
+class DLL_PUBLIC hugepage_pinned_memory_resource : public pinned_async_resource {
+ public:
+  /**
+   * @param page_size   The size of the huge pages - typically 2 MiB or 1 GiB
+   * @param chunk_size  The minimum size of the chunks mapped and registered at once; it's
+   *                    rounded up to a multiple of the page size
+   * @param reserve     The size of the chunk mapped and registered when the resource is created
+   * @param node        The NUMA node; if negative, the node registered for the current device
+   *                    is used
+   */
+  explicit hugepage_pinned_memory_resource(size_t page_size = 2_uz << 20,
+                                           size_t chunk_size = 256_uz << 20,
+                                           size_t reserve = 0,
+                                           int node = -1);
+  ~hugepage_pinned_memory_resource();
+
+  size_t page_size() const noexcept {
+    return page_size_;
+  }
+
+  /**
+   * @brief The total size of the chunks mapped so far
+   */
+  size_t mapped_size() const;
+
+  /**
+   * @brief Whether all the chunks are backed by the reserved (hugetlbfs) huge pages
+   *
+   * If false, some chunks rely on the transparent huge pages, which the kernel may not provide.
+   */
+  bool uses_hugetlb() const;
+
+ private:
+  struct chunk {
+    void *ptr;
+    size_t size;
+  };
+
+  void *do_allocate(size_t bytes, size_t alignment) override;
+  void do_deallocate(void *ptr, size_t bytes, size_t alignment) override;
+
+  void *do_allocate_async(size_t bytes, size_t alignment, stream_view) override {
+    return allocate(bytes, alignment);
+  }
+
+  void do_deallocate_async(void *mem, size_t bytes, size_t alignment, stream_view) override {
+    return deallocate(mem, bytes, alignment);
+  }
+
+  bool do_is_equal(const memory_resource<memory_kind> &other) const noexcept override {
+    return this == &other;
+  }
+
+  /// Maps and registers a chunk of at least `min_size` bytes and adds it to the free tree
+  void add_chunk(size_t min_size);
+
+  size_t page_size_, chunk_size_;
+  int node_;
+  bool hugetlb_ = true;
+  mutable std::mutex mtx_;
+  std::vector<chunk> chunks_;
+  coalescing_free_tree free_;
+};
+
+}  // namespace mm
+}  // namespace dali
+
+#endif  // DALI_CORE_MM_HUGEPAGE_RESOURCE_H_
@@ -122,17 +122,43 @@ class monotonic_memory_resource<Kind, Context, true> : public memory_resource<Ki
    * @brief Releases all memory blocks that were taken from upstream
    */
   void free_all() {
-    while (curr_block_) {
-      assert(curr_block_->sentinel == sentinel_value && "Memory corruption detected");
-      auto *prev = curr_block_->prev;
-      auto *base = reinterpret_cast<char*>(curr_block_) - curr_block_->usable_size;
-      size_t alloc_size = curr_block_->usable_size + sizeof(block_info);
-      upstream_->deallocate(base, alloc_size, curr_block_->alignment);
-      curr_block_ = prev;
-    }
+    free_blocks(curr_block_);
+    curr_block_ = nullptr;
+    curr_ = limit_ = nullptr;
+  }
+
+  /**
+   * @brief Makes all memory available for reuse, keeping only the most recent (and largest)
+   *        upstream block.
+   *
+   * All pointers allocated from this resource become invalid.
+   * Resetting the resource repeatedly when the allocation pattern is similar (e.g. in each
+   * iteration of a loop) quickly converges to using a single upstream block.
+   */
+  void reset() {
+    if (!curr_block_)
+      return;
+    assert(curr_block_->sentinel == sentinel_value && "Memory corruption detected");
+    free_blocks(curr_block_->prev);
+    curr_block_->prev = nullptr;
+    limit_ = reinterpret_cast<char*>(curr_block_);
+    curr_ = limit_ - curr_block_->usable_size;
   }
 
  private:
+  struct block_info;
+
+  void free_blocks(block_info *blk) {
+    while (blk) {
+      assert(blk->sentinel == sentinel_value && "Memory corruption detected");
+      auto *prev = blk->prev;
+      auto *base = reinterpret_cast<char*>(blk) - blk->usable_size;
+      size_t alloc_size = blk->usable_size + sizeof(block_info);
+      upstream_->deallocate(base, alloc_size, blk->alignment);
+      blk = prev;
+    }
+  }
+
   void *do_allocate(size_t bytes, size_t alignment) override {
     char *ret = detail::align_ptr(curr_, alignment);
     if (ret + bytes > limit_) {
@@ -232,8 +258,28 @@ class monotonic_memory_resource<Kind, Context, false> : public memory_resource<K
       upstream_->deallocate(blk.base, blk.size, blk.alignment);
     }
     blocks_.clear();
+    curr_ = limit_ = nullptr;
   }
 
+  /**
+   * @brief Makes all memory available for reuse, keeping only the most recent (and largest)
+   *        upstream block.
+   *
+   * All pointers allocated from this resource become invalid.
+   */
+  void reset() {
+    if (blocks_.empty())
+      return;
+    auto last = blocks_.back();
+    for (int i = blocks_.size() - 2; i >= 0; i--) {
+      auto &blk = blocks_[i];
+      upstream_->deallocate(blk.base, blk.size, blk.alignment);
+    }
+    blocks_.clear();
+    blocks_.push_back(last);
+    curr_ = static_cast<char*>(last.base);
+    limit_ = curr_ + last.size;
+  }
 
  private:
   void *do_allocate(size_t bytes, size_t alignment) override {
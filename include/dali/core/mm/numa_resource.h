@@ -0,0 +1,155 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_CORE_MM_NUMA_RESOURCE_H_
+#define DALI_CORE_MM_NUMA_RESOURCE_H_
+
+#include <mutex>
+#include <unordered_set>
+#include "dali/core/api_helper.h"
+#include "dali/core/mm/memory_resource.h"
+
+namespace dali {
+namespace mm {
+namespace numa {
+
+/**
+ * @brief Records the NUMA node that is local to the device.
+ *
+ * The node is used by the NUMA-aware resources which follow the current device.
+ * A negative `node` clears the entry.
+ */
+DLL_PUBLIC void SetDeviceNode(int device_id, int node);
+
+/**
+ * @brief Returns the NUMA node recorded for the device with SetDeviceNode, or -1 if none
+ */
+DLL_PUBLIC int GetDeviceNode(int device_id);
+
+/**
+ * @brief Sets the memory policy of the address range, so that its pages are placed on
+ *        the given NUMA node, if possible.
+ *
+ * The range must be page-aligned and the pages must not be touched yet.
+ *
+ * @return true, if the policy was set
+ */
+DLL_PUBLIC bool BindMemory(void *addr, size_t bytes, int node);
+
+}  // namespace numa
+
+namespace detail {
+
+/**
+ * @brief Allocates memory with mmap with the pages bound to a NUMA node and, optionally,
+ *        page-locked with cudaHostRegister.
+ */
+class DLL_PUBLIC numa_host_allocator {
+ public:
+  /**
+   * @param node  The NUMA node to use; if negative, the node registered for the current device
+   *              is used
+   * @param pin   If true, the memory is page-locked and registered with CUDA
+   */
+  numa_host_allocator(int node, bool pin) : node_(node), pin_(pin) {}
+
+  /**
+   * @brief The node on which the next allocation is placed; negative if unknown.
+   */
+  int current_node() const;
+
+  void *allocate(size_t bytes, size_t alignment, int node);
+  void deallocate(void *ptr, size_t bytes, size_t alignment);
+
+  int node() const noexcept {
+    return node_;
+  }
+
+ private:
+  int node_;
+  bool pin_;
+};
+
+}  // namespace detail
+
+/**
+ * @brief A host memory resource which places the memory on a specific NUMA node.
+ *
+ * The memory is allocated with mmap, so this resource is intended as an upstream of a pool.
+ */
+class DLL_PUBLIC numa_host_memory_resource : public host_memory_resource {
+ public:
+  /**
+   * @param node  The NUMA node; if negative, the node registered for the current device is used
+   *              (or the OS default placement, if there's none).
+   */
+  explicit numa_host_memory_resource(int node = -1) : alloc_(node, false) {}
+
+  int node() const noexcept {
+    return alloc_.node();
+  }
+
+ private:
+  void *do_allocate(size_t bytes, size_t alignment) override;
+  void do_deallocate(void *ptr, size_t bytes, size_t alignment) override;
+  bool do_is_equal(const memory_resource &other) const noexcept override;
+
+  detail::numa_host_allocator alloc_;
+};
+
+/**
+ * @brief A pinned memory resource which places the memory on the NUMA node local to the device.
+ *
+ * The memory is allocated with mmap, bound to the NUMA node and page-locked with
+ * cudaHostRegister. When the node is unknown, the memory is allocated with cudaMallocHost,
+ * like in pinned_malloc_memory_resource.
+ *
+ * Placing the pinned buffers on the node local to the GPU avoids the host-to-device copies
+ * crossing the CPU sockets.
+ */
+class DLL_PUBLIC numa_pinned_memory_resource : public pinned_async_resource {
+ public:
+  /**
+   * @param node  The NUMA node; if negative, the node registered for the current device is used.
+   */
+  explicit numa_pinned_memory_resource(int node = -1) : alloc_(node, true) {}
+
+  int node() const noexcept {
+    return alloc_.node();
+  }
+
+ private:
+  void *do_allocate(size_t bytes, size_t alignment) override;
+  void do_deallocate(void *ptr, size_t bytes, size_t alignment) override;
+
+  void *do_allocate_async(size_t bytes, size_t alignment, stream_view) override {
+    return allocate(bytes, alignment);
+  }
+
+  void do_deallocate_async(void *mem, size_t bytes, size_t alignment, stream_view) override {
+    return deallocate(mem, bytes, alignment);
+  }
+
+  bool do_is_equal(const memory_resource<memory_kind> &other) const noexcept override;
+
+  detail::numa_host_allocator alloc_;
+  std::mutex mtx_;
+  /// The blocks which were allocated with cudaMallocHost, because the node was unknown
+  std::unordered_set<void *> fallback_blocks_;
+};
+
+}  // namespace mm
+}  // namespace dali
+
+#endif  // DALI_CORE_MM_NUMA_RESOURCE_H_
@@ -0,0 +1,99 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_CORE_MM_POLYMORPHIC_ALLOCATOR_H_
+#define DALI_CORE_MM_POLYMORPHIC_ALLOCATOR_H_
+
+#include <cstddef>
+#include <vector>
+#include "dali/core/mm/memory_resource.h"
+#include "dali/core/mm/malloc_resource.h"
+#include "dali/core/small_vector.h"
+
+namespace dali {
+namespace mm {
+
+/**
+ * @brief A standard allocator which takes the memory from a memory resource.
+ *
+ * This is an equivalent of std::pmr::polymorphic_allocator for DALI memory resources.
+ * It can be used with standard containers and with SmallVector. The resource must outlive the
+ * containers that use it.
+ *
+ * A default-constructed allocator uses malloc_memory_resource.
+ */
+template <typename T, typename Kind = memory_kind::host>
+class polymorphic_allocator {
+  static_assert(detail::is_host_accessible<Kind>,
+                "The containers need memory accessible by the host");
+
+ public:
+  using value_type = T;
+  using resource_type = memory_resource<Kind>;
+
+  polymorphic_allocator() noexcept : resource_(&malloc_memory_resource::instance()) {}
+  polymorphic_allocator(resource_type *resource) noexcept  // NOLINT(runtime/explicit)
+  : resource_(resource) {}
+
+  template <typename U>
+  polymorphic_allocator(const polymorphic_allocator<U, Kind> &other) noexcept  // NOLINT
+  : resource_(other.resource()) {}
+
+  template <typename U>
+  struct rebind {
+    using other = polymorphic_allocator<U, Kind>;
+  };
+
+  T *allocate(size_t n) {
+    return static_cast<T *>(resource_->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T *ptr, size_t n) {
+    resource_->deallocate(ptr, n * sizeof(T), alignof(T));
+  }
+
+  resource_type *resource() const noexcept {
+    return resource_;
+  }
+
+  template <typename U>
+  bool operator==(const polymorphic_allocator<U, Kind> &other) const noexcept {
+    return resource_ == other.resource() || resource_->is_equal(*other.resource());
+  }
+
+  template <typename U>
+  bool operator!=(const polymorphic_allocator<U, Kind> &other) const noexcept {
+    return !(*this == other);
+  }
+
+ private:
+  resource_type *resource_;
+};
+
+/**
+ * @brief A vector which allocates its storage from a host memory resource
+ */
+template <typename T>
+using pmr_vector = std::vector<T, polymorphic_allocator<T>>;
+
+/**
+ * @brief A SmallVector which allocates its dynamic storage from a host memory resource
+ */
+template <typename T, size_t static_size>
+using pmr_small_vector = SmallVector<T, static_size, polymorphic_allocator<T>>;
+
+}  // namespace mm
+}  // namespace dali
+
+#endif  // DALI_CORE_MM_POLYMORPHIC_ALLOCATOR_H_
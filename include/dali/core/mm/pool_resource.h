@@ -272,6 +272,40 @@ class pool_resource_base : public memory_resource<Kind, Context> {
     return options_;
   }
 
+  /**
+   * @brief Total size of the blocks obtained from the upstream resource
+   */
+  size_t reserved_bytes() const {
+    upstream_lock_guard uguard(upstream_lock_);
+    size_t total = 0;
+    for (auto &block : blocks_)
+      total += block.bytes;
+    return total;
+  }
+
+  /**
+   * @brief Size of the largest block which can be allocated without using the upstream resource
+   *
+   * @remarks The free list must provide `largest_block` function.
+   */
+  size_t largest_free_block() const {
+    lock_guard guard(lock_);
+    return free_list_.largest_block();
+  }
+
+  /**
+   * @brief Returns the upstream blocks, which are not used at all, to the upstream resource.
+   *
+   * The deferred deallocations are flushed first.
+   *
+   * @return The number of bytes returned
+   */
+  size_t release_unused() {
+    flush_deferred();
+    upstream_lock_guard uguard(upstream_lock_);
+    return release_free_blocks();
+  }
+
  protected:
   void *do_allocate(size_t bytes, size_t alignment) override {
     if (!bytes)
@@ -338,29 +372,9 @@ class pool_resource_base : public memory_resource<Kind, Context> {
           // (the free list covers them completely), we can try to return them
           // to the upstream, with the hope that it will reorganize and succeed in
           // the subsequent allocation attempt.
-          int blocks_freed = 0;
-          SmallVector<bool, 32> removed;
-          removed.resize(blocks_.size(), false);
-          {
-            lock_guard guard(lock_);
-            for (int i = 0; i < static_cast<int>(blocks_.size()); i++) {
-              UpstreamBlock blk = blocks_[i];
-              removed[i] = free_list_.remove_if_in_list(blk.ptr, blk.bytes);
-              if (removed[i])
-                blocks_freed++;
-            }
-          }
-
-          if (!blocks_freed)
+          if (!release_free_blocks())
             throw;  // we freed nothing, so there's no point in retrying to allocate
 
-          for (int i = blocks_.size() - 1; i >= 0; i--) {
-            if (removed[i]) {
-              UpstreamBlock blk = blocks_[i];
-              upstream_->deallocate(blk.ptr, blk.bytes, blk.alignment);
-              blocks_.erase_at(i);
-            }
-          }
           // mark that we've tried, so we can fail fast the next time
           tried_return_to_upstream = true;
         }
@@ -380,6 +394,37 @@ class pool_resource_base : public memory_resource<Kind, Context> {
     return new_block;
   }
 
+  /**
+   * @brief Returns the upstream blocks, which are completely free, to the upstream resource.
+   *
+   * Must be called with `upstream_lock_` held.
+   *
+   * @return The number of bytes returned
+   */
+  size_t release_free_blocks() {
+    size_t bytes_freed = 0;
+    SmallVector<bool, 32> removed;
+    removed.resize(blocks_.size(), false);
+    {
+      lock_guard guard(lock_);
+      for (int i = 0; i < static_cast<int>(blocks_.size()); i++) {
+        UpstreamBlock blk = blocks_[i];
+        removed[i] = free_list_.remove_if_in_list(blk.ptr, blk.bytes);
+        if (removed[i])
+          bytes_freed += blk.bytes;
+      }
+    }
+
+    for (int i = blocks_.size() - 1; i >= 0; i--) {
+      if (removed[i]) {
+        UpstreamBlock blk = blocks_[i];
+        upstream_->deallocate(blk.ptr, blk.bytes, blk.alignment);
+        blocks_.erase_at(i);
+      }
+    }
+    return bytes_freed;
+  }
+
   Context do_get_context() const noexcept override {
     return upstream_->get_context();
   }
@@ -406,8 +451,8 @@ class pool_resource_base : public memory_resource<Kind, Context> {
   FreeList free_list_;
 
   // locking order: upstream_lock_, lock_
-  std::mutex upstream_lock_;
-  LockType lock_;
+  mutable std::mutex upstream_lock_;
+  mutable LockType lock_;
   pool_options options_;
   size_t next_block_size_ = 0;
   int device_ordinal_ = -1;
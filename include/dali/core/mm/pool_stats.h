@@ -0,0 +1,95 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_CORE_MM_POOL_STATS_H_
+#define DALI_CORE_MM_POOL_STATS_H_
+
+#include <cstddef>
+
+namespace dali {
+namespace mm {
+
+/**
+ * @brief Memory usage statistics of a pooling memory resource
+ *
+ * The difference between `reserved` and `in_use` is the memory kept by the pool. If it's large
+ * while `largest_free_block` is small, the allocation failures are caused by fragmentation
+ * rather than by the actual memory usage.
+ */
+struct pool_stats {
+  /// Memory obtained from the upstream resource
+  size_t reserved = 0;
+  /// Memory currently allocated from the pool
+  size_t in_use = 0;
+  /// The maximum value of `in_use` since the pool was created or `reset_peak` was called
+  size_t peak_in_use = 0;
+  /// Memory freed in stream order, which is not yet returned to the global pool
+  size_t pending_free = 0;
+  /// Number of the stream-ordered deallocations, which are not yet returned to the global pool
+  size_t num_pending_frees = 0;
+  /// The largest block that can be allocated without going to the upstream resource
+  size_t largest_free_block = 0;
+  /**
+   * @brief Number of blocks freed on a stream that were returned to the global pool to
+   *        satisfy an allocation, making them available to other streams
+   */
+  size_t cross_stream_reclaims = 0;
+  /// Number of times an allocation had to wait for pending stream-ordered deallocations
+  size_t pending_free_syncs = 0;
+};
+
+/**
+ * @brief An interface of a memory resource, which can report its statistics
+ */
+class pool_stats_provider {
+ public:
+  virtual ~pool_stats_provider() = default;
+
+  /**
+   * @brief Obtains current statistics
+   *
+   * @return false, if the statistics are not available
+   */
+  virtual bool get_stats(pool_stats &stats) const = 0;
+
+  /**
+   * @brief Resets the peak memory usage to current usage
+   */
+  virtual void reset_peak() = 0;
+};
+
+/**
+ * @brief Obtains the statistics of a memory resource, if it provides them
+ *
+ * @return false, if the resource doesn't collect any statistics
+ */
+template <typename Resource>
+bool get_pool_stats(const Resource *resource, pool_stats &stats) {
+  auto *provider = dynamic_cast<const pool_stats_provider *>(resource);
+  return provider && provider->get_stats(stats);
+}
+
+/**
+ * @brief Resets the peak memory usage of a memory resource, if it collects statistics
+ */
+template <typename Resource>
+void reset_pool_peak(Resource *resource) {
+  if (auto *provider = dynamic_cast<pool_stats_provider *>(resource))
+    provider->reset_peak();
+}
+
+}  // namespace mm
+}  // namespace dali
+
+#endif  // DALI_CORE_MM_POOL_STATS_H_
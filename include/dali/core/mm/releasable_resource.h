@@ -0,0 +1,55 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_CORE_MM_RELEASABLE_RESOURCE_H_
+#define DALI_CORE_MM_RELEASABLE_RESOURCE_H_
+
+#include <cstddef>
+
+namespace dali {
+namespace mm {
+
+/**
+ * @brief An interface of a memory resource, which can return the memory it keeps, but doesn't
+ *        use, to its upstream resource.
+ */
+class releasable_resource {
+ public:
+  virtual ~releasable_resource() = default;
+
+  /**
+   * @brief Returns the unused memory to the upstream resource
+   *
+   * The pending deallocations are completed first, so they can be released, too.
+   *
+   * @return The number of bytes released
+   */
+  virtual size_t release_unused() = 0;
+};
+
+/**
+ * @brief Releases the unused memory kept by a memory resource, if it supports it
+ *
+ * @return The number of bytes released
+ */
+template <typename Resource>
+size_t release_unused_memory(Resource *resource) {
+  auto *releasable = dynamic_cast<releasable_resource *>(resource);
+  return releasable ? releasable->release_unused() : 0;
+}
+
+}  // namespace mm
+}  // namespace dali
+
+#endif  // DALI_CORE_MM_RELEASABLE_RESOURCE_H_
@@ -0,0 +1,347 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_CORE_MM_THREAD_CACHE_RESOURCE_H_
+#define DALI_CORE_MM_THREAD_CACHE_RESOURCE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "dali/core/math_util.h"
+#include "dali/core/mm/memory_resource.h"
+#include "dali/core/mm/releasable_resource.h"
+#include "dali/core/small_vector.h"
+#include "dali/core/util.h"
+
+namespace dali {
+namespace mm {
+
+struct thread_cache_options {
+  /// The largest allocation served from the cache; larger ones go directly to the upstream
+  size_t max_cached_size = 64 << 10;
+  /// The maximum total size of the blocks of one size class kept by a single thread
+  size_t max_thread_bytes_per_class = 256 << 10;
+  /// The maximum total size of the blocks of one size class kept in the shared depot
+  size_t max_shared_bytes_per_class = 4 << 20;
+};
+
+namespace detail {
+
+/**
+ * @brief Size classes of thread_cache_resource
+ *
+ * There are 4 classes for each power of two, starting at 16 bytes, so less than 25% of memory
+ * is wasted by rounding the size up.
+ */
+struct tcache_size_classes {
+  static constexpr size_t kMinSize = 16;
+  static constexpr size_t kMaxAlignment = 256;
+
+  static int class_index(size_t bytes) {
+    if (bytes <= kMinSize)
+      return 0;
+    int group = ilog2((bytes - 1) / kMinSize);
+    size_t unit = size_t(4) << group;
+    return 4 * group + static_cast<int>(div_ceil(bytes, unit)) - 4;
+  }
+
+  static size_t class_size(int idx) {
+    return (4 + (idx & 3)) * (size_t(4) << (idx >> 2));
+  }
+
+  /**
+   * @brief The alignment of the blocks of given class, as requested from the upstream resource
+   */
+  static size_t class_alignment(int idx) {
+    return std::min(next_pow2(class_size(idx)), size_t(kMaxAlignment));
+  }
+};
+
+}  // namespace detail
+
+/**
+ * @brief Caches small blocks in thread-local free lists, in front of an upstream resource.
+ *
+ * The allocations are rounded up to a size class. Each thread keeps a bin of free blocks for
+ * each class, which it uses without any locking. When a bin is empty, it's refilled from
+ * a shared depot; when it's full, half of it is moved to the depot - in both cases, in a batch
+ * under a single lock. The upstream resource is used only when the depot is empty or full.
+ *
+ * A block may be freed by a different thread than the one which allocated it - it goes to the
+ * cache of the thread that frees it.
+ *
+ * The blocks are reused without any synchronization, so the upstream resource must not require
+ * a synchronization when deallocating (e.g. a pool with stream-ordered deallocation).
+ * The upstream resource must be thread-safe.
+ *
+ * The cached memory is returned to the upstream when a thread exits (only the part that exceeds
+ * the limit of the depot) and when the resource is destroyed. The resource must not be used
+ * while it's being destroyed.
+ */
+template <typename Kind, typename Context = any_context>
+class thread_cache_resource : public memory_resource<Kind, Context>,
+                              public releasable_resource {
+  using size_classes = detail::tcache_size_classes;
+
+ public:
+  explicit thread_cache_resource(memory_resource<Kind, Context> *upstream,
+                                 const thread_cache_options &opt = {})
+  : upstream_(upstream), options_(opt), id_(next_id()) {
+    num_classes_ = opt.max_cached_size >= size_classes::kMinSize
+                   ? size_classes::class_index(opt.max_cached_size) + 1
+                   : 0;
+    // the largest class may be larger than the limit - drop it, if it is
+    if (num_classes_ > 0 && size_classes::class_size(num_classes_ - 1) > opt.max_cached_size)
+      num_classes_--;
+    bin_capacity_.resize(num_classes_);
+    depot_capacity_.resize(num_classes_);
+    for (int c = 0; c < num_classes_; c++) {
+      size_t size = size_classes::class_size(c);
+      bin_capacity_[c] = clamp(opt.max_thread_bytes_per_class / size,
+                               size_t(kMinBinCapacity), size_t(kMaxBinCapacity));
+      depot_capacity_[c] = opt.max_shared_bytes_per_class / size;
+    }
+    depots_.reset(new depot[num_classes_]);
+    state_ = std::make_shared<shared_state>();
+    state_->owner = this;
+  }
+
+  thread_cache_resource(const thread_cache_resource &) = delete;
+  thread_cache_resource(thread_cache_resource &&) = delete;
+
+  ~thread_cache_resource() {
+    std::lock_guard<std::mutex> guard(state_->mtx);
+    for (thread_cache *cache : state_->caches) {
+      for (int c = 0; c < num_classes_; c++) {
+        for (void *ptr : cache->bins[c])
+          deallocate_upstream(ptr, c);
+        cache->bins[c].clear();
+      }
+    }
+    state_->caches.clear();
+    state_->owner = nullptr;
+    for (int c = 0; c < num_classes_; c++) {
+      for (void *ptr : depots_[c].blocks)
+        deallocate_upstream(ptr, c);
+    }
+  }
+
+  memory_resource<Kind, Context> *upstream() const noexcept {
+    return upstream_;
+  }
+
+  const thread_cache_options &options() const noexcept {
+    return options_;
+  }
+
+  /**
+   * @brief Returns the blocks kept in the shared depot to the upstream resource and releases
+   *        the unused memory of the upstream resource, if it supports it.
+   *
+   * The blocks in the bins of the threads are not released.
+   */
+  size_t release_unused() override {
+    size_t released = 0;
+    for (int c = 0; c < num_classes_; c++) {
+      std::vector<void *> blocks;
+      {
+        std::lock_guard<std::mutex> guard(depots_[c].mtx);
+        blocks.swap(depots_[c].blocks);
+      }
+      for (void *ptr : blocks)
+        deallocate_upstream(ptr, c);
+      released += blocks.size() * size_classes::class_size(c);
+    }
+    return released + release_unused_memory(upstream_);
+  }
+
+ protected:
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    if (!bytes)
+      return nullptr;
+    int c = get_class(bytes, alignment);
+    if (c < 0)
+      return upstream_->allocate(bytes, alignment);
+    auto &bin = get_thread_cache().bins[c];
+    if (bin.empty())
+      refill(bin, c);
+    if (bin.empty())
+      return upstream_->allocate(size_classes::class_size(c), size_classes::class_alignment(c));
+    void *ptr = bin.back();
+    bin.pop_back();
+    return ptr;
+  }
+
+  void do_deallocate(void *ptr, size_t bytes, size_t alignment) override {
+    if (!ptr || !bytes)
+      return;
+    int c = get_class(bytes, alignment);
+    if (c < 0) {
+      upstream_->deallocate(ptr, bytes, alignment);
+      return;
+    }
+    auto &bin = get_thread_cache().bins[c];
+    if (bin.size() >= bin_capacity_[c])
+      flush(bin, c, std::max<size_t>(bin.size() / 2, 1));
+    bin.push_back(ptr);
+  }
+
+  Context do_get_context() const noexcept override {
+    return upstream_->get_context();
+  }
+
+ private:
+  static constexpr size_t kMinBinCapacity = 2;
+  static constexpr size_t kMaxBinCapacity = 128;
+
+  struct thread_cache;
+
+  /// @brief The part of the resource that outlives it, if some threads still refer to it
+  struct shared_state {
+    std::mutex mtx;
+    thread_cache_resource *owner = nullptr;
+    std::vector<thread_cache *> caches;
+  };
+
+  struct thread_cache {
+    uint64_t id = 0;
+    std::shared_ptr<shared_state> state;
+    std::vector<std::vector<void *>> bins;
+
+    ~thread_cache() {
+      std::lock_guard<std::mutex> guard(state->mtx);
+      if (state->owner)
+        state->owner->release_thread_cache(*this);
+    }
+  };
+
+  struct depot {
+    std::mutex mtx;
+    std::vector<void *> blocks;
+  };
+
+  /**
+   * @brief Gets the size class for given allocation or -1, if it's not cached
+   */
+  int get_class(size_t bytes, size_t alignment) const {
+    if (bytes > options_.max_cached_size)
+      return -1;
+    int c = size_classes::class_index(bytes);
+    if (c >= num_classes_ || alignment > size_classes::class_alignment(c))
+      return -1;
+    return c;
+  }
+
+  static std::vector<std::unique_ptr<thread_cache>> &thread_caches() {
+    static thread_local std::vector<std::unique_ptr<thread_cache>> caches;
+    return caches;
+  }
+
+  thread_cache &get_thread_cache() {
+    auto &caches = thread_caches();
+    for (auto &cache : caches)
+      if (cache->id == id_)
+        return *cache;
+    return create_thread_cache(caches);
+  }
+
+  thread_cache &create_thread_cache(std::vector<std::unique_ptr<thread_cache>> &caches) {
+    // remove the caches of the resources that no longer exist
+    caches.erase(std::remove_if(caches.begin(), caches.end(), [](auto &cache) {
+      std::lock_guard<std::mutex> guard(cache->state->mtx);
+      return cache->state->owner == nullptr;
+    }), caches.end());
+
+    auto cache = std::make_unique<thread_cache>();
+    cache->id = id_;
+    cache->state = state_;
+    cache->bins.resize(num_classes_);
+    for (int c = 0; c < num_classes_; c++)
+      cache->bins[c].reserve(bin_capacity_[c]);
+    {
+      std::lock_guard<std::mutex> guard(state_->mtx);
+      state_->caches.push_back(cache.get());
+    }
+    caches.push_back(std::move(cache));
+    return *caches.back();
+  }
+
+  /**
+   * @brief Moves up to a half of the bin capacity from the depot to the bin.
+   */
+  void refill(std::vector<void *> &bin, int c) {
+    auto &d = depots_[c];
+    std::lock_guard<std::mutex> guard(d.mtx);
+    size_t n = std::min(std::max<size_t>(bin_capacity_[c] / 2, 1), d.blocks.size());
+    bin.insert(bin.end(), d.blocks.end() - n, d.blocks.end());
+    d.blocks.resize(d.blocks.size() - n);
+  }
+
+  /**
+   * @brief Moves `n` least recently freed blocks from the bin to the depot.
+   *
+   * The blocks that don't fit in the depot are returned to the upstream resource.
+   */
+  void flush(std::vector<void *> &bin, int c, size_t n) {
+    SmallVector<void *, 64> excess;
+    {
+      auto &d = depots_[c];
+      std::lock_guard<std::mutex> guard(d.mtx);
+      size_t to_depot = std::min(n, depot_capacity_[c] - std::min(depot_capacity_[c],
+                                                                  d.blocks.size()));
+      d.blocks.insert(d.blocks.end(), bin.begin(), bin.begin() + to_depot);
+      for (size_t i = to_depot; i < n; i++)
+        excess.push_back(bin[i]);
+    }
+    bin.erase(bin.begin(), bin.begin() + n);
+    for (void *ptr : excess)
+      deallocate_upstream(ptr, c);
+  }
+
+  /**
+   * @brief Returns the blocks of an exiting thread to the depot. Called with the state locked.
+   */
+  void release_thread_cache(thread_cache &cache) {
+    for (int c = 0; c < num_classes_; c++) {
+      if (!cache.bins[c].empty())
+        flush(cache.bins[c], c, cache.bins[c].size());
+    }
+    auto &caches = state_->caches;
+    caches.erase(std::remove(caches.begin(), caches.end(), &cache), caches.end());
+  }
+
+  void deallocate_upstream(void *ptr, int c) {
+    upstream_->deallocate(ptr, size_classes::class_size(c), size_classes::class_alignment(c));
+  }
+
+  static uint64_t next_id() {
+    static std::atomic<uint64_t> id{0};
+    return ++id;
+  }
+
+  memory_resource<Kind, Context> *upstream_;
+  thread_cache_options options_;
+  uint64_t id_;
+  int num_classes_ = 0;
+  std::vector<size_t> bin_capacity_, depot_capacity_;
+  std::unique_ptr<depot[]> depots_;
+  std::shared_ptr<shared_state> state_;
+};
+
+}  // namespace mm
+}  // namespace dali
+
+#endif  // DALI_CORE_MM_THREAD_CACHE_RESOURCE_H_
@@ -1,4 +1,4 @@
-// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2017-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -15,6 +15,7 @@
 #ifndef DALI_CORE_NVTX_H_
 #define DALI_CORE_NVTX_H_
 
+#include <atomic>
 #include <cstdint>
 #include <string>
 
@@ -88,16 +89,115 @@ struct TimeRange : RangeBase {
   bool started = false;
 };
 
-struct DomainTimeRange : RangeBase {
+/**
+ * @brief Categories of the trace ranges, used to select the ones that are recorded
+ *
+ * See SetTraceCategories and the DALI_TRACE_CATEGORIES environment variable.
+ */
+enum TraceCategory : uint32_t {
+  kTraceExecutor   = 1 << 0,  ///< iterations and executor stages
+  kTraceOperator   = 1 << 1,  ///< operator runs
+  kTraceLoader     = 1 << 2,  ///< reader prefetching and sample reads
+  kTraceThreadPool = 1 << 3,  ///< thread pool tasks
+  kTraceOther      = 1 << 4,  ///< ranges opened with DomainTimeRange
+  kTraceAll        = 0xFFFFFFFFu
+};
+
+namespace detail {
+DLL_PUBLIC extern std::atomic<uint32_t> trace_categories;
+}  // namespace detail
+
+/**
+ * @brief Checks if the ranges of the category are recorded; it's a single relaxed load
+ */
+inline bool TraceEnabled(uint32_t category) {
+  return (detail::trace_categories.load(std::memory_order_relaxed) & category) != 0;
+}
+
+/**
+ * @brief Selects the categories of the recorded ranges
+ *
+ * By default, all categories are enabled if DALI is built with NVTX and none otherwise,
+ * unless the DALI_TRACE_CATEGORIES environment variable is set.
+ */
+DLL_PUBLIC void SetTraceCategories(uint32_t categories);
+
+DLL_PUBLIC uint32_t GetTraceCategories();
+
+/**
+ * @brief Parses a comma-separated list of the category names: executor, operator, loader,
+ *        thread_pool, other or all
+ */
+DLL_PUBLIC uint32_t ParseTraceCategories(const std::string &names);
+
+/**
+ * @brief Starts collecting the ranges of the given categories in memory, to be written
+ *        in the Chrome trace format (chrome://tracing, Perfetto) by StopChromeTrace
+ *
+ * It works without NVTX, so the pipelines can be profiled without an external profiler.
+ * Setting the DALI_CHROME_TRACE environment variable to a file name starts the collection
+ * when DALI is loaded and writes the trace to the file at exit.
+ */
+DLL_PUBLIC void StartChromeTrace(uint32_t categories = kTraceAll);
+
+/**
+ * @brief Stops the collection started with StartChromeTrace, writes the trace to `filename`
+ *        and restores the previously enabled categories
+ */
+DLL_PUBLIC void StopChromeTrace(const std::string &filename);
+
+/**
+ * @brief A trace range of a category, recorded with NVTX in the DALI domain and, when
+ *        collected, in the Chrome trace
+ *
+ * If the category is disabled, the range costs a single check.
+ * Use DALI_TRACE_RANGE, so that the name is built only if it's needed.
+ */
+class DLL_PUBLIC TraceRange : public RangeBase {
+ public:
+  TraceRange(uint32_t category, const char *name, const uint32_t rgb = kBlue) {
+    if (TraceEnabled(category))
+      Start(category, name, rgb);
+  }
+
+  TraceRange(uint32_t category, const std::string &name, const uint32_t rgb = kBlue)
+    : TraceRange(category, name.c_str(), rgb) {}
+
+  ~TraceRange() {
+    if (started_)
+      Stop();
+  }
+
+  TraceRange(const TraceRange &) = delete;
+  TraceRange &operator=(const TraceRange &) = delete;
+
+ private:
+  void Start(uint32_t category, const char *name, const uint32_t rgb);
+  void Stop();
+
+  bool started_ = false;
+  uint32_t category_ = 0;
+  // only set when the range is collected for the Chrome trace
+  int64_t start_ns_ = -1;
+  std::string name_;
+};
+
+#define DALI_TRACE_RANGE_CONCAT_(a, b) a##b
+#define DALI_TRACE_RANGE_CONCAT(a, b) DALI_TRACE_RANGE_CONCAT_(a, b)
+
+/**
+ * @brief Opens a TraceRange lasting until the end of the scope; the `name` expression is
+ *        evaluated only if the category is enabled
+ */
+#define DALI_TRACE_RANGE(category, name, rgb)                                 \
+  ::dali::TraceRange DALI_TRACE_RANGE_CONCAT(dali_trace_range_, __LINE__)(  \
+      category, ::dali::TraceEnabled(category) ? std::string(name) : std::string(), rgb)
+
+struct DomainTimeRange : TraceRange {
   explicit DomainTimeRange(const std::string &name, const uint32_t rgb = kBlue)
-    : DomainTimeRange(name.c_str(), rgb) {}
-#if NVTX_ENABLED
-  explicit DomainTimeRange(const char *name, const uint32_t rgb = kBlue);
-  ~DomainTimeRange();
-#else
-  explicit DomainTimeRange(const char *name, const uint32_t rgb = kBlue) {}
-  ~DomainTimeRange() {}
-#endif
+    : TraceRange(kTraceOther, name, rgb) {}
+  explicit DomainTimeRange(const char *name, const uint32_t rgb = kBlue)
+    : TraceRange(kTraceOther, name, rgb) {}
 };
 
 }  // namespace dali
@@ -139,7 +139,7 @@ class DLL_PUBLIC SharedMem {
  public:
   DLL_PUBLIC SharedMem(shm_handle_t handle, uint64_t size);
 
-  DLL_PUBLIC ~SharedMem() = default;
+  DLL_PUBLIC ~SharedMem();
 
   DLL_PUBLIC uint64_t size() const;
 
@@ -155,8 +155,26 @@ class DLL_PUBLIC SharedMem {
 
   DLL_PUBLIC void close();
 
+  /**
+   * @brief Page-locks the mapped memory with cudaHostRegister, so that host-to-device copies
+   * from the chunk run at pinned memory speed. The registration is kept across resizes and
+   * released when the chunk is closed.
+   */
+  DLL_PUBLIC void pin();
+
+  DLL_PUBLIC void unpin();
+
+  DLL_PUBLIC bool is_pinned() const {
+    return pinned_;
+  }
+
  private:
+  void register_mapping();
+  void unregister_mapping();
+
   uint64_t size_;
+  bool pinned_ = false;      // pinning requested by the user
+  bool registered_ = false;  // current mapping registered with CUDA
   ShmHandle shm_handle_;
   MemoryMapping memory_mapping_;
 };
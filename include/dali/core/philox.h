@@ -0,0 +1,165 @@
+// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_CORE_PHILOX_H_
+#define DALI_CORE_PHILOX_H_
+
+#include <cstdint>
+#include <type_traits>
+#include "dali/core/host_dev.h"
+
+namespace dali {
+
+/**
+ * @brief Counter-based Philox4x32-10 random bit generator
+ *
+ * The generated numbers are a pure function of the key (seed), the subsequence and the position
+ * within the subsequence, so any part of the stream can be obtained without generating
+ * the preceding values. This makes it possible to generate the numbers for different elements
+ * independently and in any order (or in parallel), without storing any state in memory.
+ *
+ * The stream is identical to the one produced by cuRAND's `curandStatePhilox4_32_10_t`
+ * initialized with the same `seed`, `subsequence` and `offset`.
+ *
+ * The class satisfies the UniformRandomBitGenerator requirements and can be used with
+ * the standard library distributions.
+ */
+class Philox4x32_10 {
+ public:
+  using result_type = uint32_t;
+
+  DALI_HOST_DEV Philox4x32_10() {
+    init(0, 0, 0);
+  }
+
+  DALI_HOST_DEV explicit Philox4x32_10(uint64_t seed,
+                                       uint64_t subsequence = 0,
+                                       uint64_t offset = 0) {
+    init(seed, subsequence, offset);
+  }
+
+  /**
+   * @brief Initializes the key with values obtained from a std::seed_seq-like object
+   */
+  template <typename SeedSeq,
+            typename = std::enable_if_t<!std::is_convertible<SeedSeq, uint64_t>::value>>
+  explicit Philox4x32_10(SeedSeq &seq) {
+    uint32_t key[2];
+    seq.generate(key, key + 2);
+    init(key[0] | (static_cast<uint64_t>(key[1]) << 32), 0, 0);
+  }
+
+  DALI_HOST_DEV void init(uint64_t seed, uint64_t subsequence, uint64_t offset) {
+    key_[0] = static_cast<uint32_t>(seed);
+    key_[1] = static_cast<uint32_t>(seed >> 32);
+    ctr_[0] = ctr_[1] = 0;
+    ctr_[2] = static_cast<uint32_t>(subsequence);
+    ctr_[3] = static_cast<uint32_t>(subsequence >> 32);
+    idx_ = 0;
+    skip(offset);
+  }
+
+  /**
+   * @brief Advances the generator by n values
+   */
+  DALI_HOST_DEV void skip(uint64_t n) {
+    n += idx_;  // include the values already consumed from the current block
+    uint64_t blocks = n >> 2;
+    uint64_t lo = ctr_[0] | (static_cast<uint64_t>(ctr_[1]) << 32);
+    uint64_t new_lo = lo + blocks;
+    ctr_[0] = static_cast<uint32_t>(new_lo);
+    ctr_[1] = static_cast<uint32_t>(new_lo >> 32);
+    if (new_lo < lo) {  // carry to the subsequence part of the counter
+      if (++ctr_[2] == 0)
+        ++ctr_[3];
+    }
+    idx_ = n & 3;
+    generate_block();
+  }
+
+  DALI_HOST_DEV result_type operator()() {
+    result_type ret = out_[idx_];
+    if (++idx_ == 4) {
+      increment();
+      generate_block();
+      idx_ = 0;
+    }
+    return ret;
+  }
+
+  /**
+   * @brief Returns a 64-bit random value, composed of two consecutive 32-bit values
+   */
+  DALI_HOST_DEV uint64_t next64() {
+    uint64_t lo = (*this)();
+    return lo | (static_cast<uint64_t>((*this)()) << 32);
+  }
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return 0xffffffffu; }
+
+ private:
+  static constexpr uint32_t kMul0 = 0xD2511F53u;
+  static constexpr uint32_t kMul1 = 0xCD9E8D57u;
+  static constexpr uint32_t kWeyl0 = 0x9E3779B9u;
+  static constexpr uint32_t kWeyl1 = 0xBB67AE85u;
+
+  DALI_HOST_DEV static inline uint32_t mulhilo(uint32_t a, uint32_t b, uint32_t &hi) {
+  #ifdef __CUDA_ARCH__
+    hi = __umulhi(a, b);
+    return a * b;
+  #else
+    uint64_t product = static_cast<uint64_t>(a) * b;
+    hi = static_cast<uint32_t>(product >> 32);
+    return static_cast<uint32_t>(product);
+  #endif
+  }
+
+  DALI_HOST_DEV void increment() {
+    if (++ctr_[0]) return;
+    if (++ctr_[1]) return;
+    if (++ctr_[2]) return;
+    ++ctr_[3];
+  }
+
+  DALI_HOST_DEV void generate_block() {
+    uint32_t c[4] = { ctr_[0], ctr_[1], ctr_[2], ctr_[3] };
+    uint32_t k0 = key_[0], k1 = key_[1];
+    #ifdef __CUDA_ARCH__
+    #pragma unroll
+    #endif
+    for (int round = 0; round < 10; round++) {
+      uint32_t hi0, hi1;
+      uint32_t lo0 = mulhilo(kMul0, c[0], hi0);
+      uint32_t lo1 = mulhilo(kMul1, c[2], hi1);
+      c[0] = hi1 ^ c[1] ^ k0;
+      c[1] = lo1;
+      c[2] = hi0 ^ c[3] ^ k1;
+      c[3] = lo0;
+      k0 += kWeyl0;
+      k1 += kWeyl1;
+    }
+    for (int i = 0; i < 4; i++)
+      out_[i] = c[i];
+  }
+
+  uint32_t key_[2];
+  uint32_t ctr_[4];
+  uint32_t out_[4];
+  uint32_t idx_ = 0;
+};
+
+}  // namespace dali
+
+#endif  // DALI_CORE_PHILOX_H_
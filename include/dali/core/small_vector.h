@@ -39,6 +39,10 @@ struct SmallVectorAlloc {
   __host__ void deallocate(T *ptr, size_t count) {
     allocator_.deallocate(ptr, count);
   }
+  /// Tells whether the memory allocated by `other` can be freed with this allocator
+  __host__ bool is_same_allocator(const SmallVectorAlloc &other) const {
+    return allocator_ == other.allocator_;
+  }
 };
 
 template <typename T, typename Allocator>
@@ -49,6 +53,9 @@ struct SmallVectorAlloc<T, Allocator, true> {
   static __host__ void deallocate(T *ptr, size_t count) {
     Allocator().deallocate(ptr, count);
   }
+  DALI_HOST_DEV static constexpr bool is_same_allocator(const SmallVectorAlloc &) {
+    return true;
+  }
   // Add no-op __device__ overload for functions used in __host__ __device__ context by clang
   #if defined(__clang__) && defined(__CUDA__)
   static __device__ T *allocate(size_t count) {
@@ -66,6 +73,9 @@ struct SmallVectorAlloc<T, device_side_allocator<T>, true> {
   static __device__ void deallocate(T *ptr, size_t count) {
     device_side_allocator<T>::deallocate(ptr, count);
   }
+  DALI_HOST_DEV static constexpr bool is_same_allocator(const SmallVectorAlloc &) {
+    return true;
+  }
 };
 
 
@@ -196,9 +206,13 @@ class SmallVector : SmallVectorAlloc<T, allocator>, SmallVectorBase<T> {
     *this = other;
   }
 
+  /**
+   * @brief Moves the contents of `other`, along with its allocator
+   */
+  DALI_NO_EXEC_CHECK
   template <size_t other_static_size>
   DALI_HOST_DEV SmallVector(SmallVector<T, other_static_size, allocator> &&other) noexcept
-  : SmallVector() {
+  : Alloc(static_cast<const Alloc &>(other)), dynamic{} {
     *this = cuda_move(other);
   }
 
@@ -331,7 +345,9 @@ class SmallVector : SmallVectorAlloc<T, allocator>, SmallVectorBase<T> {
   DALI_NO_EXEC_CHECK
   template <size_t other_static_size>
   DALI_HOST_DEV SmallVector &operator=(SmallVector<T, other_static_size, allocator> &&v) {
-    if (v.is_dynamic() && v.capacity() > static_size) {
+    // the buffer can be taken over only if it can be freed with our allocator
+    if (v.is_dynamic() && v.capacity() > static_size &&
+        Alloc::is_same_allocator(static_cast<const Alloc &>(v))) {
       clear();
       if (is_dynamic()) {
         deallocate(dynamic_data(), capacity());
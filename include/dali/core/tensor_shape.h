@@ -662,6 +662,17 @@ struct TensorListShapeBase {
     shapes.resize(num_samples * sample_dim);
   }
 
+  /**
+   * @brief Preallocates the storage for `num_samples` shapes of `sample_dim` dimensions
+   *
+   * The storage is never shrunk, so a shape list which is reused (e.g. as the output of
+   * the in-place shape transformations, like collapse_dims or permute_dims) doesn't allocate
+   * once it has grown to the largest batch.
+   */
+  void reserve(int num_samples, int sample_dim) {
+    shapes.reserve(num_samples * sample_dim);
+  }
+
 
   ///@{
   /**
@@ -911,6 +922,12 @@ struct TensorListShape : TensorListShapeBase<TensorListShape<sample_ndim>, sampl
 };
 
 
+template <int out_ndim, int ndim>
+void first_dims(TensorListShape<out_ndim> &out, const TensorListShape<ndim> &in, int count);
+
+template <int out_ndim, int ndim>
+void last_dims(TensorListShape<out_ndim> &out, const TensorListShape<ndim> &in, int count);
+
 template <typename Derived, int sample_ndim>
 template <int other_ndim>
 TensorListShape<other_ndim> TensorListShapeBase<Derived, sample_ndim>::first() const {
@@ -920,12 +937,7 @@ TensorListShape<other_ndim> TensorListShapeBase<Derived, sample_ndim>::first() c
   assert(0 <= other_ndim && other_ndim <= sample_dim() &&
          "Number of dimensions in subshape must be between 0 and sample_dim()");
   TensorListShape<other_ndim> result;
-  result.resize(size());
-  for (int sample = 0; sample < size(); sample++) {
-    for (int d = 0; d < other_ndim; d++) {
-      result.shapes[sample * other_ndim + d] = shapes[sample * sample_dim() + d];
-    }
-  }
+  first_dims(result, static_cast<const Derived &>(*this), other_ndim);
   return result;
 }
 
@@ -938,13 +950,7 @@ TensorListShape<other_ndim> TensorListShapeBase<Derived, sample_ndim>::last() co
   assert(0 <= other_ndim && other_ndim <= sample_dim() &&
          "Number of dimensions in subshape must be between 0 and sample_dim()");
   TensorListShape<other_ndim> result;
-  result.resize(size());
-  int start_offset = sample_dim() - other_ndim;
-  for (int sample = 0; sample < size(); sample++) {
-    for (int d = 0; d < other_ndim; d++) {
-      result.shapes[sample * other_ndim + d] = shapes[sample * sample_dim() + start_offset + d];
-    }
-  }
+  last_dims(result, static_cast<const Derived &>(*this), other_ndim);
   return result;
 }
 
@@ -954,12 +960,7 @@ TensorListShapeBase<Derived, sample_ndim>::first(int count) const {
   assert(0 <= count && count <= sample_dim() &&
          "Number of dimensions in subshape must be between 0 and sample_dim()");
   TensorListShape<DynamicDimensions> result;
-  result.resize(size(), count);
-  for (int sample = 0; sample < size(); sample++) {
-    for (int d = 0; d < count; d++) {
-      result.shapes[sample * count + d] = shapes[sample * sample_dim() + d];
-    }
-  }
+  first_dims(result, static_cast<const Derived &>(*this), count);
   return result;
 }
 
@@ -969,13 +970,7 @@ TensorListShapeBase<Derived, sample_ndim>::last(int count) const {
   assert(0 <= count && count <= sample_dim() &&
          "Number of dimensions in subshape must be between 0 and sample_dim()");
   TensorListShape<DynamicDimensions> result;
-  result.resize(size(), count);
-  int start_offset = sample_dim() - count;
-  for (int sample = 0; sample < size(); sample++) {
-    for (int d = 0; d < count; d++) {
-      result.shapes[sample * count + d] = shapes[sample * sample_dim() + start_offset + d];
-    }
-  }
+  last_dims(result, static_cast<const Derived &>(*this), count);
   return result;
 }
 
@@ -1436,6 +1431,47 @@ auto permute_dims(const TensorListShape<in_ndim> &in, const Permutation &axis_or
   return out;
 }
 
+/**
+ * @brief Stores the first `count` extents (outer dimensions) of each sample shape in `out`
+ */
+template <int out_ndim, int ndim>
+void first_dims(TensorListShape<out_ndim> &out, const TensorListShape<ndim> &in, int count) {
+  static_assert(out_ndim <= ndim || ndim == DynamicDimensions || out_ndim == DynamicDimensions,
+                "Number of dimensions in subshape must be between 0 and sample_dim()");
+  assert(0 <= count && count <= in.sample_dim() &&
+         "Number of dimensions in subshape must be between 0 and sample_dim()");
+  assert(out_ndim == DynamicDimensions || out_ndim == count);
+  int nsamples = in.num_samples();
+  out.resize(nsamples, count);
+  for (int i = 0; i < nsamples; i++) {
+    auto in_sample = in.tensor_shape_span(i);
+    auto out_sample = out.tensor_shape_span(i);
+    for (int d = 0; d < count; d++)
+      out_sample[d] = in_sample[d];
+  }
+}
+
+/**
+ * @brief Stores the last `count` extents (inner dimensions) of each sample shape in `out`
+ */
+template <int out_ndim, int ndim>
+void last_dims(TensorListShape<out_ndim> &out, const TensorListShape<ndim> &in, int count) {
+  static_assert(out_ndim <= ndim || ndim == DynamicDimensions || out_ndim == DynamicDimensions,
+                "Number of dimensions in subshape must be between 0 and sample_dim()");
+  assert(0 <= count && count <= in.sample_dim() &&
+         "Number of dimensions in subshape must be between 0 and sample_dim()");
+  assert(out_ndim == DynamicDimensions || out_ndim == count);
+  int nsamples = in.num_samples();
+  int start_offset = in.sample_dim() - count;
+  out.resize(nsamples, count);
+  for (int i = 0; i < nsamples; i++) {
+    auto in_sample = in.tensor_shape_span(i);
+    auto out_sample = out.tensor_shape_span(i);
+    for (int d = 0; d < count; d++)
+      out_sample[d] = in_sample[start_offset + d];
+  }
+}
+
 /**
  * Stores a (strided) range of sample shapes in the output list shape.
  *
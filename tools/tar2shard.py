@@ -0,0 +1,193 @@
+#!/usr/bin/python3
+# Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import argparse
+import io
+import os
+import struct
+import tarfile
+
+
+class ShardWriter:
+    """Writes the aligned shards read by fn.experimental.readers.aligned_shard.
+
+    The data of every component starts at a multiple of `alignment`; the index of the samples
+    and the footer follow the data. See dali/operators/reader/loader/aligned_shard.h for
+    the layout.
+
+    Example usage:
+    ----------
+    >>> with ShardWriter('data/test.shard') as writer:
+    ...     writer.add_sample('0001', [('jpg', jpeg_bytes), ('cls', label_bytes)])
+    ...     writer.add_sample('0002', [('jpg', jpeg_bytes), ('npy', np.zeros((2, 3)))])
+
+    Parameters
+    ----------
+    path : str
+        Path to the shard, that will be created/overwritten.
+    alignment : int
+        The alignment of the components, a power of 2 and a multiple of the block size
+        of the drive.
+    """
+
+    magic = b"DALISHRD"
+    version = 1
+
+    def __init__(self, path, alignment=4096):
+        if alignment <= 0 or alignment & (alignment - 1):
+            raise ValueError(f"The alignment {alignment} is not a power of 2")
+        self.alignment = alignment
+        self.file = open(path, "wb")
+        self.offset = 0
+        self.types = {}
+        self.samples = []
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+
+    def _write_aligned(self, data):
+        offset = self.offset
+        self.file.write(data)
+        padding = -len(data) % self.alignment
+        self.file.write(b"\0" * padding)
+        self.offset += len(data) + padding
+        return offset
+
+    def add_sample(self, key, components):
+        """Adds a sample made of the components.
+
+        Each component is a pair of its type and the data - either the bytes, or a NumPy array,
+        which is stored with its data type and shape.
+        """
+        descs = []
+        for type_name, data in components:
+            type_idx = self.types.setdefault(type_name, len(self.types))
+            dtype, shape = "", None
+            if not isinstance(data, (bytes, bytearray, memoryview)):
+                import numpy as np
+                data = np.ascontiguousarray(data)
+                if data.dtype.byteorder == ">":
+                    data = data.astype(data.dtype.newbyteorder("<"))
+                dtype, shape = data.dtype.str, data.shape
+                data = data.tobytes()
+            offset = self._write_aligned(data)
+            descs.append((type_idx, offset, len(data), dtype, shape))
+        self.samples.append((key, descs))
+
+    def close(self):
+        """Writes the index and the footer and closes the shard."""
+        if self.file.closed:
+            return
+
+        def string(s):
+            s = s.encode()
+            return struct.pack("<I", len(s)) + s
+
+        index = io.BytesIO()
+        index.write(struct.pack("<I", len(self.types)))
+        for type_name in sorted(self.types, key=self.types.get):
+            index.write(string(type_name))
+        index.write(struct.pack("<Q", len(self.samples)))
+        for key, descs in self.samples:
+            index.write(string(key))
+            index.write(struct.pack("<I", len(descs)))
+            for type_idx, offset, size, dtype, shape in descs:
+                index.write(struct.pack("<IQQ", type_idx, offset, size))
+                index.write(string(dtype))
+                if shape is None:
+                    index.write(struct.pack("<i", -1))
+                else:
+                    index.write(struct.pack(f"<i{len(shape)}q", len(shape), *shape))
+        index = index.getvalue()
+        index_offset = self._write_aligned(index)
+        # the footer ends the file, right after the padded index
+        self.file.write(struct.pack("<QQII", index_offset, len(index), ShardWriter.version,
+                                    self.alignment) + ShardWriter.magic)
+        self.file.close()
+
+
+def split_name(name):
+    """Splits the name of a file in the archive into the sample key and the extension,
+    the same way as fn.readers.webdataset does."""
+    dot_pos = name.find(".", name.rfind("/") + 1)
+    if dot_pos < 0:
+        return name, ""
+    return name[:dot_pos], name[dot_pos + 1:]
+
+
+def convert(archive, shard, alignment=4096, parse_npy=True):
+    """Converts a webdataset archive to an aligned shard.
+
+    The samples are made of the consecutive files with the same name without the extension.
+    When `parse_npy` is set, the .npy files are stored as arrays, with their data type and shape.
+    """
+    count = 0
+    with tarfile.open(archive) as tar, ShardWriter(shard, alignment) as writer:
+        key, components = None, []
+        for member in tar:
+            if not member.isfile():
+                continue
+            basename, ext = split_name(member.name)
+            # skip the hidden files, like fn.readers.webdataset
+            if not basename or basename.endswith("/") or \
+                    os.path.basename(basename).startswith("."):
+                continue
+            if basename != key:
+                if components:
+                    writer.add_sample(key, components)
+                    count += 1
+                key, components = basename, []
+            data = tar.extractfile(member).read()
+            if parse_npy and ext.endswith("npy"):
+                import numpy as np
+                data = np.load(io.BytesIO(data), allow_pickle=False)
+            components.append((ext, data))
+        if components:
+            writer.add_sample(key, components)
+            count += 1
+    if count == 0:
+        raise ValueError("Webdataset Tar File empty")
+    return count
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        formatter_class=argparse.ArgumentDefaultsHelpFormatter,
+        description="Converts a webdataset archive to an aligned shard for the use with "
+                    "the fn.experimental.readers.aligned_shard from DALI.",
+    )
+    parser.add_argument("archive", help="path to .tar file.")
+    parser.add_argument("shard", help="path to the shard", nargs="?")
+    parser.add_argument("--alignment", type=int, default=4096,
+                        help="the alignment of the components in the shard")
+    parser.add_argument("--raw_npy", action="store_true",
+                        help="store the .npy files as they are, instead of the arrays")
+    args = parser.parse_args()
+    if args.shard is None:
+        args.shard = args.archive[: args.archive.find(".", args.archive.rfind("/") + 2)] + ".shard"
+    return args
+
+
+def main():
+    args = parse_args()
+    count = convert(args.archive, args.shard, args.alignment, not args.raw_npy)
+    print(f"{count} samples written to {args.shard}")
+
+
+if __name__ == "__main__":
+    main()